@@ -18,6 +18,10 @@
 #ifndef GZ_MATH_EIGEN3_CONVERSIONS_HH_
 #define GZ_MATH_EIGEN3_CONVERSIONS_HH_
 
+#include <array>
+#include <type_traits>
+#include <vector>
+
 #include <Eigen/Geometry>
 #include <gz/math/AxisAlignedBox.hh>
 #include <gz/math/Matrix3.hh>
@@ -25,6 +29,7 @@
 #include <gz/math/Pose3.hh>
 #include <gz/math/Quaternion.hh>
 #include <gz/math/Vector3.hh>
+#include <gz/math/Vector3Array.hh>
 
 namespace gz
 {
@@ -203,6 +208,146 @@ namespace gz
 
         return pose;
       }
+
+      /// \brief Convert a buffer of gz::math::Pose3d to Eigen::Isometry3d.
+      /// This is equivalent to calling convert on each pose, but the
+      /// rotation matrix is computed directly from each quaternion, without
+      /// Eigen::Quaterniond temporaries.
+      /// \param[in] _poses Pointer to the first pose to convert.
+      /// \param[out] _out Pointer to the first converted pose.
+      /// \param[in] _count Number of poses to convert.
+      inline void convert(const gz::math::Pose3d *_poses,
+                          Eigen::Isometry3d *_out, const std::size_t _count)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const gz::math::Vector3d &p = _poses[i].Pos();
+          const gz::math::Quaterniond &q = _poses[i].Rot();
+          const double w = q.W(), x = q.X(), y = q.Y(), z = q.Z();
+
+          Eigen::Matrix4d &m = _out[i].matrix();
+          m << 1 - 2 * (y * y + z * z), 2 * (x * y - z * w),
+               2 * (x * z + y * w), p.X(),
+               2 * (x * y + z * w), 1 - 2 * (x * x + z * z),
+               2 * (y * z - x * w), p.Y(),
+               2 * (x * z - y * w), 2 * (y * z + x * w),
+               1 - 2 * (x * x + y * y), p.Z(),
+               0, 0, 0, 1;
+        }
+      }
+
+      /// \brief Convert a vector of gz::math::Pose3d to Eigen::Isometry3d.
+      /// \param[in] _poses Poses to convert.
+      /// \return The equivalent Eigen::Isometry3d, in the same order.
+      inline std::vector<Eigen::Isometry3d> convert(
+          const std::vector<gz::math::Pose3d> &_poses)
+      {
+        std::vector<Eigen::Isometry3d> result(_poses.size());
+        convert(_poses.data(), result.data(), _poses.size());
+        return result;
+      }
+
+      /// \brief Convert a buffer of Eigen::Isometry3d to gz::math::Pose3d.
+      /// \param[in] _tfs Pointer to the first transform to convert.
+      /// \param[out] _out Pointer to the first converted pose.
+      /// \param[in] _count Number of transforms to convert.
+      inline void convert(const Eigen::Isometry3d *_tfs,
+                          gz::math::Pose3d *_out, const std::size_t _count)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const auto t = _tfs[i].translation();
+          const Eigen::Quaterniond q(_tfs[i].linear());
+          _out[i].Pos().Set(t.x(), t.y(), t.z());
+          _out[i].Rot().Set(q.w(), q.x(), q.y(), q.z());
+        }
+      }
+
+      /// \brief Convert a vector of Eigen::Isometry3d to gz::math::Pose3d.
+      /// \param[in] _tfs Transforms to convert.
+      /// \return The equivalent gz::math::Pose3d, in the same order.
+      inline std::vector<gz::math::Pose3d> convert(
+          const std::vector<Eigen::Isometry3d> &_tfs)
+      {
+        std::vector<gz::math::Pose3d> result(_tfs.size());
+        convert(_tfs.data(), result.data(), _tfs.size());
+        return result;
+      }
+
+      /// \brief Get an Eigen view of a vector of gz::math::Vector3, with one
+      /// column per vector, without copying.
+      /// The view is invalidated by any change to the size or capacity of
+      /// _v.
+      /// \param[in] _v Vectors to view.
+      /// \return A 3xN Eigen::Map over the values of _v.
+      /// \tparam Precision Precision such as float or double.
+      template<typename Precision>
+      inline Eigen::Map<const Eigen::Matrix<Precision, 3, Eigen::Dynamic>>
+      map(const std::vector<Vector3<Precision>> &_v)
+      {
+        static_assert(sizeof(Vector3<Precision>) == 3 * sizeof(Precision),
+            "Vector3 must hold exactly 3 contiguous values");
+        static_assert(std::is_standard_layout<Vector3<Precision>>::value,
+            "Vector3 must be standard layout to be viewed by Eigen");
+        return Eigen::Map<const Eigen::Matrix<Precision, 3, Eigen::Dynamic>>(
+            reinterpret_cast<const Precision *>(_v.data()), 3,
+            static_cast<Eigen::Index>(_v.size()));
+      }
+
+      /// \brief Get a mutable Eigen view of a vector of gz::math::Vector3,
+      /// with one column per vector, without copying. Writing to the view
+      /// changes the vectors.
+      /// The view is invalidated by any change to the size or capacity of
+      /// _v.
+      /// \param[in] _v Vectors to view.
+      /// \return A 3xN Eigen::Map over the values of _v.
+      /// \tparam Precision Precision such as float or double.
+      template<typename Precision>
+      inline Eigen::Map<Eigen::Matrix<Precision, 3, Eigen::Dynamic>>
+      map(std::vector<Vector3<Precision>> &_v)
+      {
+        static_assert(sizeof(Vector3<Precision>) == 3 * sizeof(Precision),
+            "Vector3 must hold exactly 3 contiguous values");
+        static_assert(std::is_standard_layout<Vector3<Precision>>::value,
+            "Vector3 must be standard layout to be viewed by Eigen");
+        return Eigen::Map<Eigen::Matrix<Precision, 3, Eigen::Dynamic>>(
+            reinterpret_cast<Precision *>(_v.data()), 3,
+            static_cast<Eigen::Index>(_v.size()));
+      }
+
+      /// \brief Get Eigen views of the x, y and z values of a
+      /// gz::math::Vector3Array, without copying. Each axis is stored
+      /// separately, so each gets its own column vector.
+      /// The views are invalidated by any change to the size of _v.
+      /// \param[in] _v Vectors to view.
+      /// \return Eigen::Map of the x, y and z values, in this order.
+      /// \tparam Precision Precision such as float or double.
+      template<typename Precision>
+      inline std::array<
+          Eigen::Map<const Eigen::Matrix<Precision, Eigen::Dynamic, 1>>, 3>
+      map(const Vector3Array<Precision> &_v)
+      {
+        using Map =
+            Eigen::Map<const Eigen::Matrix<Precision, Eigen::Dynamic, 1>>;
+        const auto size = static_cast<Eigen::Index>(_v.Size());
+        return {{Map(_v.X(), size), Map(_v.Y(), size), Map(_v.Z(), size)}};
+      }
+
+      /// \brief Get mutable Eigen views of the x, y and z values of a
+      /// gz::math::Vector3Array, without copying.
+      /// The views are invalidated by any change to the size of _v.
+      /// \param[in] _v Vectors to view.
+      /// \return Eigen::Map of the x, y and z values, in this order.
+      /// \tparam Precision Precision such as float or double.
+      template<typename Precision>
+      inline std::array<
+          Eigen::Map<Eigen::Matrix<Precision, Eigen::Dynamic, 1>>, 3>
+      map(Vector3Array<Precision> &_v)
+      {
+        using Map = Eigen::Map<Eigen::Matrix<Precision, Eigen::Dynamic, 1>>;
+        const auto size = static_cast<Eigen::Index>(_v.Size());
+        return {{Map(_v.X(), size), Map(_v.Y(), size), Map(_v.Z(), size)}};
+      }
     }
   }
 }
@@ -18,6 +18,10 @@
 #ifndef GZ_MATH_EIGEN3_UTIL_HH_
 #define GZ_MATH_EIGEN3_UTIL_HH_
 
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <thread>
 #include <vector>
 
 #include <Eigen/Geometry>
@@ -37,69 +41,239 @@ namespace gz
   {
     namespace eigen3
     {
-      /// \brief Get covariance matrix from a set of 3d vertices
-      /// https://github.com/isl-org/Open3D/blob/76c2baf9debd460900f056a9b51e9a80de9c0e64/cpp/open3d/utility/Eigen.cpp#L305
-      /// \param[in] _vertices a vector of 3d vertices
-      /// \return Covariance matrix
-      inline Eigen::Matrix3d covarianceMatrix(
-        const std::vector<math::Vector3d> &_vertices)
+      namespace detail
       {
-        if (_vertices.empty())
-          return Eigen::Matrix3d::Identity();
+        /// \brief Run _func(_begin, _end) over [0, _count) split into at most
+        /// _threads contiguous ranges. The first range runs on the calling
+        /// thread.
+        /// \param[in] _count Number of items.
+        /// \param[in] _threads Maximum number of threads to use. Zero uses
+        /// std::thread::hardware_concurrency.
+        /// \param[in] _func Function called with each range.
+        template<typename Func>
+        void parallelRanges(const std::size_t _count,
+          const unsigned int _threads, const Func &_func)
+        {
+          if (_count == 0)
+            return;
+          std::size_t threads = _threads > 0 ? _threads :
+              std::max(1u, std::thread::hardware_concurrency());
+          threads = std::min(threads, _count);
+          const std::size_t perThread = (_count + threads - 1) / threads;
+          std::vector<std::future<void>> futures;
+          for (std::size_t begin = perThread; begin < _count;
+               begin += perThread)
+          {
+            futures.push_back(std::async(std::launch::async, _func, begin,
+                std::min(begin + perThread, _count)));
+          }
+          _func(std::size_t(0), std::min(perThread, _count));
+          for (auto &future : futures)
+            future.get();
+        }
+      }  // namespace detail
+
+      /// \brief Accumulates the mean and covariance of 3d vertices that may
+      /// be fed in several chunks, without keeping a copy of them.
+      ///
+      /// The spread of the vertices is kept about their running mean and
+      /// chunks are combined with the pairwise update of Chan et al., which
+      /// avoids the cancellation of summing raw second moments when the
+      /// vertices are far from the origin. A chunk is split in blocks of
+      /// fixed size that are reduced pairwise in a fixed order, so the
+      /// result does not depend on the number of threads.
+      class CovarianceAccumulator
+      {
+        /// \brief Add a single vertex.
+        /// \param[in] _vertex Vertex to add.
+        public: void Add(const math::Vector3d &_vertex)
+        {
+          const Eigen::Vector3d point = math::eigen3::convert(_vertex);
+          ++this->count;
+          const Eigen::Vector3d delta = point - this->mean;
+          this->mean += delta / static_cast<double>(this->count);
+          this->scatter += delta * (point - this->mean).transpose();
+        }
+
+        /// \brief Add a chunk of vertices.
+        /// \param[in] _vertices Pointer to the vertices.
+        /// \param[in] _count Number of vertices.
+        /// \param[in] _threads Maximum number of threads to use. Zero uses
+        /// std::thread::hardware_concurrency.
+        public: void Add(const math::Vector3d *_vertices,
+                         const std::size_t _count,
+                         const unsigned int _threads = 1)
+        {
+          if (_vertices == nullptr || _count == 0)
+            return;
+
+          const std::size_t blockCount =
+              (_count + kBlockSize - 1) / kBlockSize;
+          std::vector<CovarianceAccumulator> blocks(blockCount);
+          detail::parallelRanges(blockCount, _threads,
+              [&](const std::size_t _begin, const std::size_t _end)
+              {
+                for (std::size_t b = _begin; b < _end; ++b)
+                {
+                  const std::size_t first = b * kBlockSize;
+                  blocks[b].AddBlock(_vertices + first,
+                      std::min(kBlockSize, _count - first));
+                }
+              });
+
+          // Pairwise reduction of the blocks
+          for (std::size_t stride = 1; stride < blockCount; stride *= 2)
+          {
+            for (std::size_t b = 0; b + stride < blockCount; b += 2 * stride)
+              blocks[b].Merge(blocks[b + stride]);
+          }
+          this->Merge(blocks[0]);
+        }
+
+        /// \brief Add the vertices accumulated by another accumulator.
+        /// \param[in] _other Accumulator to merge into this one.
+        public: void Merge(const CovarianceAccumulator &_other)
+        {
+          if (_other.count == 0)
+            return;
+          if (this->count == 0)
+          {
+            *this = _other;
+            return;
+          }
+          const double n1 = static_cast<double>(this->count);
+          const double n2 = static_cast<double>(_other.count);
+          const double n = n1 + n2;
+          const Eigen::Vector3d delta = _other.mean - this->mean;
+          this->mean += delta * (n2 / n);
+          this->scatter += _other.scatter +
+              (delta * delta.transpose()) * (n1 * n2 / n);
+          this->count += _other.count;
+        }
+
+        /// \brief Remove all accumulated vertices.
+        public: void Reset()
+        {
+          *this = CovarianceAccumulator();
+        }
+
+        /// \brief Get the number of accumulated vertices.
+        /// \return Number of vertices.
+        public: std::size_t Count() const
+        {
+          return this->count;
+        }
+
+        /// \brief Get the mean of the accumulated vertices.
+        /// \return Mean, or zero if there are no vertices.
+        public: Eigen::Vector3d Mean() const
+        {
+          return this->mean;
+        }
+
+        /// \brief Get the covariance matrix of the accumulated vertices,
+        /// normalized by the number of vertices.
+        /// \return Covariance matrix, or identity if there are no vertices.
+        public: Eigen::Matrix3d Covariance() const
+        {
+          if (this->count == 0)
+            return Eigen::Matrix3d::Identity();
+          return this->scatter / static_cast<double>(this->count);
+        }
 
-        Eigen::Matrix<double, 9, 1> cumulants;
-        cumulants.setZero();
-        for (const auto &vertex : _vertices)
+        /// \brief Accumulate a block into an empty accumulator with two
+        /// passes, first the mean and then the spread about it.
+        /// \param[in] _vertices Pointer to the vertices.
+        /// \param[in] _count Number of vertices, greater than zero.
+        private: void AddBlock(const math::Vector3d *_vertices,
+                               const std::size_t _count)
         {
-          const Eigen::Vector3d &point = math::eigen3::convert(vertex);
-          cumulants(0) += point(0);
-          cumulants(1) += point(1);
-          cumulants(2) += point(2);
-          cumulants(3) += point(0) * point(0);
-          cumulants(4) += point(0) * point(1);
-          cumulants(5) += point(0) * point(2);
-          cumulants(6) += point(1) * point(1);
-          cumulants(7) += point(1) * point(2);
-          cumulants(8) += point(2) * point(2);
+          Eigen::Vector3d sum = Eigen::Vector3d::Zero();
+          for (std::size_t i = 0; i < _count; ++i)
+            sum += math::eigen3::convert(_vertices[i]);
+          this->count = _count;
+          this->mean = sum / static_cast<double>(_count);
+
+          double xx = 0, xy = 0, xz = 0, yy = 0, yz = 0, zz = 0;
+          for (std::size_t i = 0; i < _count; ++i)
+          {
+            const double x = _vertices[i].X() - this->mean(0);
+            const double y = _vertices[i].Y() - this->mean(1);
+            const double z = _vertices[i].Z() - this->mean(2);
+            xx += x * x;
+            xy += x * y;
+            xz += x * z;
+            yy += y * y;
+            yz += y * z;
+            zz += z * z;
+          }
+          this->scatter << xx, xy, xz,
+                           xy, yy, yz,
+                           xz, yz, zz;
         }
 
-        Eigen::Matrix3d covariance;
+        /// \brief Number of vertices in a block reduced with two passes.
+        private: static constexpr std::size_t kBlockSize = 1024;
+
+        /// \brief Number of accumulated vertices.
+        private: std::size_t count = 0;
 
-        cumulants /= static_cast<double>(_vertices.size());
+        /// \brief Mean of the accumulated vertices.
+        private: Eigen::Vector3d mean = Eigen::Vector3d::Zero();
 
-        covariance(0, 0) = cumulants(3) - cumulants(0) * cumulants(0);
-        covariance(1, 1) = cumulants(6) - cumulants(1) * cumulants(1);
-        covariance(2, 2) = cumulants(8) - cumulants(2) * cumulants(2);
-        covariance(0, 1) = cumulants(4) - cumulants(0) * cumulants(1);
-        covariance(1, 0) = covariance(0, 1);
-        covariance(0, 2) = cumulants(5) - cumulants(0) * cumulants(2);
-        covariance(2, 0) = covariance(0, 2);
-        covariance(1, 2) = cumulants(7) - cumulants(1) * cumulants(2);
-        covariance(2, 1) = covariance(1, 2);
-        return covariance;
+        /// \brief Sum of the outer products of the offsets of the vertices
+        /// from their mean.
+        private: Eigen::Matrix3d scatter = Eigen::Matrix3d::Zero();
+      };
+
+      /// \brief Get covariance matrix from a set of 3d vertices
+      /// https://github.com/isl-org/Open3D/blob/76c2baf9debd460900f056a9b51e9a80de9c0e64/cpp/open3d/utility/Eigen.cpp#L305
+      /// \param[in] _vertices Pointer to the 3d vertices
+      /// \param[in] _count Number of vertices
+      /// \param[in] _threads Maximum number of threads to use. Zero uses
+      /// std::thread::hardware_concurrency.
+      /// \return Covariance matrix, or identity if there are no vertices
+      /// \sa CovarianceAccumulator
+      inline Eigen::Matrix3d covarianceMatrix(
+        const math::Vector3d *_vertices, const std::size_t _count,
+        const unsigned int _threads = 1)
+      {
+        CovarianceAccumulator accumulator;
+        accumulator.Add(_vertices, _count, _threads);
+        return accumulator.Covariance();
+      }
+
+      /// \brief Get covariance matrix from a set of 3d vertices
+      /// \param[in] _vertices a vector of 3d vertices
+      /// \return Covariance matrix
+      inline Eigen::Matrix3d covarianceMatrix(
+        const std::vector<math::Vector3d> &_vertices)
+      {
+        return covarianceMatrix(_vertices.data(), _vertices.size());
       }
 
       /// \brief Get the oriented 3d bounding box of a set of 3d
       /// vertices using PCA
       /// http://codextechnicanum.blogspot.com/2015/04/find-minimum-oriented-bounding-box-of.html
-      /// \param[in] _vertices a vector of 3d vertices
+      /// \param[in] _vertices Pointer to the 3d vertices
+      /// \param[in] _count Number of vertices
+      /// \param[in] _threads Maximum number of threads to use. Zero uses
+      /// std::thread::hardware_concurrency.
       /// \return Oriented 3D box
       inline gz::math::OrientedBoxd verticesToOrientedBox(
-        const std::vector<math::Vector3d> &_vertices)
+        const math::Vector3d *_vertices, const std::size_t _count,
+        const unsigned int _threads = 1)
       {
         math::OrientedBoxd box;
 
         // Return an empty box if there are no vertices
-        if (_vertices.empty())
+        if (_vertices == nullptr || _count == 0)
           return box;
 
-        math::Vector3d mean;
-        for (const auto &point : _vertices)
-          mean += point;
-        mean /= static_cast<double>(_vertices.size());
-
-        Eigen::Vector3d centroid = math::eigen3::convert(mean);
-        Eigen::Matrix3d covariance = covarianceMatrix(_vertices);
+        CovarianceAccumulator accumulator;
+        accumulator.Add(_vertices, _count, _threads);
+        const Eigen::Vector3d centroid = accumulator.Mean();
+        const Eigen::Matrix3d covariance = accumulator.Covariance();
 
         // Eigen Vectors
         Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d>
@@ -114,25 +288,46 @@ namespace gz
 
         // Transform the original cloud to the origin where the principal
         // components correspond to the axes.
-        Eigen::Matrix4d projectionTransform(Eigen::Matrix4d::Identity());
-        projectionTransform.block<3, 3>(0, 0) = eigenVectorsPCA.transpose();
-        projectionTransform.block<3, 1>(0, 3) =
-          -1.0f * (projectionTransform.block<3, 3>(0, 0) * centroid);
-
-        Eigen::Vector3d minPoint(INF_I32, INF_I32, INF_I32);
-        Eigen::Vector3d maxPoint(-INF_I32, -INF_I32, -INF_I32);
+        const Eigen::Matrix3d rotation = eigenVectorsPCA.transpose();
+        const Eigen::Vector3d translation = -(rotation * centroid);
 
-        // Get the minimum and maximum points of the transformed cloud.
-        for (const auto &point : _vertices)
+        // Get the minimum and maximum points of the transformed cloud,
+        // per range of vertices and then over the ranges.
+        std::size_t threads = _threads > 0 ? _threads :
+            std::max(1u, std::thread::hardware_concurrency());
+        threads = std::min(threads, _count);
+        const std::size_t perThread = (_count + threads - 1) / threads;
+        const std::size_t rangeCount = (_count + perThread - 1) / perThread;
+        std::vector<Eigen::Vector3d> minPoints(rangeCount,
+            Eigen::Vector3d::Constant(INF_I32));
+        std::vector<Eigen::Vector3d> maxPoints(rangeCount,
+            Eigen::Vector3d::Constant(-INF_I32));
+        detail::parallelRanges(rangeCount,
+            static_cast<unsigned int>(rangeCount),
+            [&](const std::size_t _begin, const std::size_t _end)
+            {
+              for (std::size_t r = _begin; r < _end; ++r)
+              {
+                const std::size_t end = std::min((r + 1) * perThread, _count);
+                for (std::size_t i = r * perThread; i < end; ++i)
+                {
+                  const Eigen::Vector3d pt =
+                    rotation * math::eigen3::convert(_vertices[i]) +
+                    translation;
+                  minPoints[r] = minPoints[r].cwiseMin(pt);
+                  maxPoints[r] = maxPoints[r].cwiseMax(pt);
+                }
+              }
+            });
+        Eigen::Vector3d minPoint = minPoints[0];
+        Eigen::Vector3d maxPoint = maxPoints[0];
+        for (std::size_t r = 1; r < rangeCount; ++r)
         {
-          Eigen::Vector4d pt(0, 0, 0, 1);
-          pt.head<3>() = math::eigen3::convert(point);
-          Eigen::Vector4d tfPoint = projectionTransform * pt;
-          minPoint = minPoint.cwiseMin(tfPoint.head<3>());
-          maxPoint = maxPoint.cwiseMax(tfPoint.head<3>());
+          minPoint = minPoint.cwiseMin(minPoints[r]);
+          maxPoint = maxPoint.cwiseMax(maxPoints[r]);
         }
 
-        const Eigen::Vector3d meanDiagonal = 0.5f * (maxPoint + minPoint);
+        const Eigen::Vector3d meanDiagonal = 0.5 * (maxPoint + minPoint);
 
         // quaternion is calculated using the eigenvectors (which determines
         // how the final box gets rotated), and the transform to put the box
@@ -154,6 +349,16 @@ namespace gz
         box.Pose(pose);
         return box;
       }
+
+      /// \brief Get the oriented 3d bounding box of a set of 3d
+      /// vertices using PCA
+      /// \param[in] _vertices a vector of 3d vertices
+      /// \return Oriented 3D box
+      inline gz::math::OrientedBoxd verticesToOrientedBox(
+        const std::vector<math::Vector3d> &_vertices)
+      {
+        return verticesToOrientedBox(_vertices.data(), _vertices.size());
+      }
     }
   }
 }
@@ -221,3 +221,79 @@ TEST(EigenConversions, ConvertPose3)
     EXPECT_EQ(iPose, iPose2);
   }
 }
+
+/////////////////////////////////////////////////
+/// Check conversions of buffers of poses
+TEST(EigenConversions, ConvertPose3Array)
+{
+  std::vector<gz::math::Pose3d> poses;
+  for (int i = 0; i < 10; ++i)
+    poses.emplace_back(i, -2.0 * i, 0.5, 0.3 * i, -0.1, 3.14 / (i + 1));
+
+  std::vector<Eigen::Isometry3d> tfs = gz::math::eigen3::convert(poses);
+  ASSERT_EQ(poses.size(), tfs.size());
+  for (std::size_t i = 0; i < poses.size(); ++i)
+  {
+    EXPECT_TRUE(gz::math::eigen3::convert(poses[i]).isApprox(tfs[i], 1e-12))
+      << i;
+  }
+
+  std::vector<gz::math::Pose3d> back = gz::math::eigen3::convert(tfs);
+  ASSERT_EQ(poses.size(), back.size());
+  for (std::size_t i = 0; i < poses.size(); ++i)
+  {
+    EXPECT_EQ(gz::math::eigen3::convert(tfs[i]), back[i]);
+    EXPECT_EQ(poses[i], back[i]);
+  }
+
+  EXPECT_TRUE(gz::math::eigen3::convert(
+      std::vector<gz::math::Pose3d>()).empty());
+}
+
+/////////////////////////////////////////////////
+/// Check Eigen views of vectors of Vector3
+TEST(EigenConversions, MapVector3)
+{
+  std::vector<gz::math::Vector3d> points = {
+    {1, 2, 3}, {4, 5, 6}, {7, 8, 9}, {-1, -2, -3}};
+
+  const auto &constPoints = points;
+  auto view = gz::math::eigen3::map(constPoints);
+  ASSERT_EQ(3, view.rows());
+  ASSERT_EQ(4, view.cols());
+  EXPECT_EQ(points.front().X(), view.data()[0]);
+  EXPECT_DOUBLE_EQ(6, view(2, 1));
+  EXPECT_DOUBLE_EQ(-2, view(1, 3));
+  EXPECT_DOUBLE_EQ(11, view.row(0).sum());
+
+  // Writing to a mutable view changes the vectors
+  gz::math::eigen3::map(points).colwise() += Eigen::Vector3d(1, 1, 1);
+  EXPECT_EQ(gz::math::Vector3d(2, 3, 4), points[0]);
+  EXPECT_EQ(gz::math::Vector3d(0, -1, -2), points[3]);
+
+  std::vector<gz::math::Vector3d> empty;
+  EXPECT_EQ(0, gz::math::eigen3::map(empty).cols());
+
+  std::vector<gz::math::Vector3f> pointsf = {{1, 2, 3}};
+  EXPECT_FLOAT_EQ(3, gz::math::eigen3::map(pointsf)(2, 0));
+}
+
+/////////////////////////////////////////////////
+/// Check Eigen views of Vector3Array
+TEST(EigenConversions, MapVector3Array)
+{
+  gz::math::Vector3Arrayd array(std::vector<gz::math::Vector3d>{
+    {1, 2, 3}, {4, 5, 6}, {7, 8, 9}});
+
+  const auto &constArray = array;
+  auto view = gz::math::eigen3::map(constArray);
+  ASSERT_EQ(3, view[0].size());
+  EXPECT_EQ(array.X(), view[0].data());
+  EXPECT_DOUBLE_EQ(12, view[0].sum());
+  EXPECT_DOUBLE_EQ(15, view[1].sum());
+  EXPECT_DOUBLE_EQ(18, view[2].sum());
+
+  auto mutableView = gz::math::eigen3::map(array);
+  mutableView[2] *= 2;
+  EXPECT_EQ(gz::math::Vector3d(4, 5, 12), array[1]);
+}
@@ -17,6 +17,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include <gz/math/eigen3/Util.hh>
 
 using namespace gz;
@@ -170,3 +174,114 @@ TEST(EigenUtil, covarianceEmptyTest)
   EXPECT_DOUBLE_EQ(covariance(7), 0);
   EXPECT_DOUBLE_EQ(covariance(8), 1);
 }
+
+/////////////////////////////////////////////////
+TEST(EigenUtil, covarianceAccumulator)
+{
+  math::eigen3::CovarianceAccumulator empty;
+  EXPECT_EQ(0u, empty.Count());
+  EXPECT_TRUE(empty.Covariance().isIdentity());
+  EXPECT_TRUE(empty.Mean().isZero());
+
+  // Far from the origin, where summing raw second moments cancels badly
+  const math::Vector3d offset(1e8, -2e8, 3e8);
+  std::vector<math::Vector3d> vertices;
+  for (int i = 0; i < 5000; ++i)
+  {
+    vertices.push_back(offset + math::Vector3d(
+        std::sin(i * 0.1), 2 * std::cos(i * 0.37), 0.5 * std::sin(i * 0.73)));
+  }
+
+  // Reference computed about the known offset
+  Eigen::Vector3d mean = Eigen::Vector3d::Zero();
+  for (const auto &v : vertices)
+    mean += math::eigen3::convert(v - offset);
+  mean /= static_cast<double>(vertices.size());
+  Eigen::Matrix3d expected = Eigen::Matrix3d::Zero();
+  for (const auto &v : vertices)
+  {
+    const Eigen::Vector3d d = math::eigen3::convert(v - offset) - mean;
+    expected += d * d.transpose();
+  }
+  expected /= static_cast<double>(vertices.size());
+
+  const Eigen::Matrix3d covariance = math::eigen3::covarianceMatrix(
+      vertices.data(), vertices.size());
+  EXPECT_TRUE(covariance.isApprox(expected, 1e-6)) << covariance;
+
+  // Any number of threads gives the same result
+  for (unsigned int threads : {0u, 2u, 3u, 7u})
+  {
+    EXPECT_EQ(covariance, math::eigen3::covarianceMatrix(
+        vertices.data(), vertices.size(), threads)) << threads;
+  }
+
+  // Streamed in uneven chunks and single vertices
+  math::eigen3::CovarianceAccumulator streamed;
+  std::size_t begin = 0;
+  for (std::size_t chunk = 1; begin < vertices.size(); chunk *= 3)
+  {
+    const std::size_t count = std::min(chunk, vertices.size() - begin);
+    if (count == 1)
+      streamed.Add(vertices[begin]);
+    else
+      streamed.Add(vertices.data() + begin, count, 2);
+    begin += count;
+  }
+  EXPECT_EQ(vertices.size(), streamed.Count());
+  EXPECT_TRUE(streamed.Covariance().isApprox(expected, 1e-6));
+  EXPECT_TRUE(streamed.Mean().isApprox(
+      math::eigen3::convert(offset) + mean, 1e-12));
+
+  // Merge two halves
+  math::eigen3::CovarianceAccumulator first;
+  math::eigen3::CovarianceAccumulator second;
+  first.Add(vertices.data(), 1234);
+  second.Add(vertices.data() + 1234, vertices.size() - 1234);
+  first.Merge(second);
+  first.Merge(empty);
+  EXPECT_EQ(vertices.size(), first.Count());
+  EXPECT_TRUE(first.Covariance().isApprox(expected, 1e-6));
+
+  first.Reset();
+  EXPECT_EQ(0u, first.Count());
+  EXPECT_TRUE(first.Covariance().isIdentity());
+}
+
+/////////////////////////////////////////////////
+TEST(EigenUtil, verticesToOrientedBoxThreads)
+{
+  // Points of a rotated box, with one corner far out on each axis
+  const math::Pose3d pose(1, 2, 3, 0.3, -0.2, 0.9);
+  std::vector<math::Vector3d> vertices;
+  for (int i = 0; i < 3000; ++i)
+  {
+    vertices.push_back(pose.CoordPositionAdd(math::Vector3d(
+        4 * std::sin(i * 0.11), 2 * std::cos(i * 0.23),
+        std::sin(i * 0.57))));
+  }
+
+  const math::OrientedBoxd box = math::eigen3::verticesToOrientedBox(
+      vertices.data(), vertices.size());
+  EXPECT_EQ(box, math::eigen3::verticesToOrientedBox(vertices));
+  for (const auto &v : vertices)
+  {
+    const math::Vector3d local = box.Pose().Rot().RotateVectorReverse(
+        v - box.Pose().Pos());
+    EXPECT_LE(std::abs(local.X()), box.Size().X() / 2 + 1e-9);
+    EXPECT_LE(std::abs(local.Y()), box.Size().Y() / 2 + 1e-9);
+    EXPECT_LE(std::abs(local.Z()), box.Size().Z() / 2 + 1e-9);
+  }
+  EXPECT_NEAR(8, box.Size().Max(), 0.1);
+
+  for (unsigned int threads : {0u, 2u, 5u})
+  {
+    const math::OrientedBoxd threaded = math::eigen3::verticesToOrientedBox(
+        vertices.data(), vertices.size(), threads);
+    EXPECT_EQ(box.Size(), threaded.Size());
+    EXPECT_EQ(box.Pose(), threaded.Pose());
+  }
+
+  EXPECT_EQ(math::OrientedBoxd(), math::eigen3::verticesToOrientedBox(
+      nullptr, 0, 2));
+}
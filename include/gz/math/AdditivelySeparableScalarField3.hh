@@ -17,8 +17,10 @@
 #ifndef GZ_MATH_SEPARABLE_SCALAR_FIELD3_HH_
 #define GZ_MATH_SEPARABLE_SCALAR_FIELD3_HH_
 
+#include <cstddef>
 #include <limits>
 #include <utility>
+#include <vector>
 
 #include <gz/math/Region3.hh>
 #include <gz/math/Vector3.hh>
@@ -83,6 +85,68 @@ namespace gz
             this->r(_point.Z()));
       }
 
+      /// \brief Evaluate the scalar field at many points. For points on
+      /// a grid, EvaluateGrid is much faster.
+      /// \param[in] _points pointer to the first scalar field argument
+      /// \param[out] _out pointer to the first of `_count` results
+      /// \param[in] _count number of arguments
+      public: void Evaluate(const Vector3<ScalarT> *_points, ScalarT *_out,
+                            const std::size_t _count) const
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          _out[i] = this->Evaluate(_points[i]);
+        }
+      }
+
+      /// \brief Evaluate the scalar field at every point of a grid. The
+      /// scalar functions are evaluated once per grid line along their
+      /// axis, then their values are added for each point.
+      /// \param[in] _xs pointer to the first of `_nx` x values
+      /// \param[in] _nx number of x values
+      /// \param[in] _ys pointer to the first of `_ny` y values
+      /// \param[in] _ny number of y values
+      /// \param[in] _zs pointer to the first of `_nz` z values
+      /// \param[in] _nz number of z values
+      /// \param[out] _out pointer to the first of `_nx * _ny * _nz`
+      ///   results, where F(_xs[i], _ys[j], _zs[k]) is at index
+      ///   `(k * _ny + j) * _nx + i`
+      public: void EvaluateGrid(const ScalarT *_xs, const std::size_t _nx,
+                                const ScalarT *_ys, const std::size_t _ny,
+                                const ScalarT *_zs, const std::size_t _nz,
+                                ScalarT *_out) const
+      {
+        std::vector<ScalarT> px(_nx);
+        std::vector<ScalarT> qy(_ny);
+        std::vector<ScalarT> rz(_nz);
+        for (std::size_t i = 0; i < _nx; ++i)
+        {
+          px[i] = this->p(_xs[i]);
+        }
+        for (std::size_t j = 0; j < _ny; ++j)
+        {
+          qy[j] = this->q(_ys[j]);
+        }
+        for (std::size_t l = 0; l < _nz; ++l)
+        {
+          rz[l] = this->r(_zs[l]);
+        }
+        const ScalarT scale = this->k;
+        for (std::size_t l = 0; l < _nz; ++l)
+        {
+          for (std::size_t j = 0; j < _ny; ++j)
+          {
+            const ScalarT qj = qy[j];
+            const ScalarT rl = rz[l];
+            ScalarT *row = _out + (l * _ny + j) * _nx;
+            for (std::size_t i = 0; i < _nx; ++i)
+            {
+              row[i] = scale * (px[i] + qj + rl);
+            }
+          }
+        }
+      }
+
       /// \brief Call operator overload
       /// \see SeparableScalarField3::Evaluate()
       /// \param[in] _point scalar field argument
@@ -0,0 +1,441 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_AXISALIGNEDBOXT_HH_
+#define GZ_MATH_AXISALIGNEDBOXT_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Line3.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class AxisAlignedBoxT AxisAlignedBoxT.hh gz/math/AxisAlignedBoxT.hh
+    /// \brief Axis aligned box of a given precision. It has the same
+    /// interface and results as AxisAlignedBox, but its corners are stored
+    /// inline as two Vector3<T>, so a box can be copied and stored in a
+    /// vector without an allocation, and AxisAlignedBoxT<float> takes 24
+    /// bytes. Use AxisAlignedBoxf to keep geometry in float end to end.
+    /// The box is trivially copyable and its geometric functions are
+    /// constexpr, so bounds can be computed at compile time.
+    /// \tparam T A floating point type.
+    template<typename T>
+    class AxisAlignedBoxT
+    {
+      static_assert(std::is_floating_point_v<T>,
+          "AxisAlignedBoxT requires a floating point type");
+
+      /// \brief Default constructor. The minimum corner is set to the
+      /// highest and the maximum corner to the lowest value of T, so the
+      /// box has no extent, see AxisAlignedBox::AxisAlignedBox().
+      public: AxisAlignedBoxT() = default;
+
+      /// \brief Constructor. This constructor will compute the box's
+      /// minimum and maximum corners based on the two arguments.
+      /// \param[in] _vec1 One corner of the box
+      /// \param[in] _vec2 Another corner of the box
+      public: constexpr AxisAlignedBoxT(const Vector3<T> &_vec1,
+                                        const Vector3<T> &_vec2)
+      : min(_vec1), max(_vec2)
+      {
+        this->min.Min(_vec2);
+        this->max.Max(_vec1);
+      }
+
+      /// \brief Constructor. This constructor will compute the box's
+      /// minimum and maximum corners based on the arguments.
+      /// \param[in] _vec1X One corner's X position
+      /// \param[in] _vec1Y One corner's Y position
+      /// \param[in] _vec1Z One corner's Z position
+      /// \param[in] _vec2X Other corner's X position
+      /// \param[in] _vec2Y Other corner's Y position
+      /// \param[in] _vec2Z Other corner's Z position
+      public: constexpr AxisAlignedBoxT(T _vec1X, T _vec1Y, T _vec1Z,
+                  T _vec2X, T _vec2Y, T _vec2Z)
+      : AxisAlignedBoxT(Vector3<T>(_vec1X, _vec1Y, _vec1Z),
+                        Vector3<T>(_vec2X, _vec2Y, _vec2Z))
+      {
+      }
+
+      /// \brief Construct from a box of another precision. The corners
+      /// are converted with static_cast, after clamping them to the range
+      /// of T.
+      /// \param[in] _box Box to convert.
+      public: template<typename U>
+              constexpr explicit AxisAlignedBoxT(
+                  const AxisAlignedBoxT<U> &_box)
+      : min(Convert(_box.Min())), max(Convert(_box.Max()))
+      {
+      }
+
+      /// \brief Construct from an AxisAlignedBox, with the same corners,
+      /// so code can switch to the inline layout one call site at a time.
+      /// \param[in] _box Box to convert.
+      public: explicit AxisAlignedBoxT(const AxisAlignedBox &_box)
+      : min(Convert(_box.Min())), max(Convert(_box.Max()))
+      {
+      }
+
+      /// \brief Get an AxisAlignedBox with the same corners. A box with no
+      /// extent stays one, rather than having its corners sorted by the
+      /// AxisAlignedBox constructor.
+      /// \return The box.
+      public: AxisAlignedBox ToAxisAlignedBox() const
+      {
+        AxisAlignedBox box;
+        box.Min().Set(this->min.X(), this->min.Y(), this->min.Z());
+        box.Max().Set(this->max.X(), this->max.Y(), this->max.Z());
+        return box;
+      }
+
+      /// \brief Get the length along the x dimension
+      /// \return Length in the x dimension, 0 if the box has no extent
+      public: constexpr T XLength() const
+      {
+        return std::max(T(0), this->max.X() - this->min.X());
+      }
+
+      /// \brief Get the length along the y dimension
+      /// \return Length in the y dimension, 0 if the box has no extent
+      public: constexpr T YLength() const
+      {
+        return std::max(T(0), this->max.Y() - this->min.Y());
+      }
+
+      /// \brief Get the length along the z dimension
+      /// \return Length in the z dimension, 0 if the box has no extent
+      public: constexpr T ZLength() const
+      {
+        return std::max(T(0), this->max.Z() - this->min.Z());
+      }
+
+      /// \brief Get the size of the box
+      /// \return Size of the box
+      public: constexpr Vector3<T> Size() const
+      {
+        return Vector3<T>(this->XLength(), this->YLength(), this->ZLength());
+      }
+
+      /// \brief Get the box center
+      /// \return The center position of the box
+      public: constexpr Vector3<T> Center() const
+      {
+        return T(0.5) * this->min + T(0.5) * this->max;
+      }
+
+      /// \brief Get the volume of the box in m^3.
+      /// \return Volume of the box in m^3.
+      public: constexpr T Volume() const
+      {
+        return this->XLength() * this->YLength() * this->ZLength();
+      }
+
+      /// \brief Merge a box with this box
+      /// \param[in] _box Box to add to this box
+      public: constexpr void Merge(const AxisAlignedBoxT &_box)
+      {
+        this->min.Min(_box.min);
+        this->max.Max(_box.max);
+      }
+
+      /// \brief Addition operator. result = this + _b
+      /// \param[in] _b Box to add
+      /// \return The new box
+      public: constexpr AxisAlignedBoxT operator+(
+                  const AxisAlignedBoxT &_b) const
+      {
+        AxisAlignedBoxT result(*this);
+        result += _b;
+        return result;
+      }
+
+      /// \brief Addition set operator. this = this + _b
+      /// \param[in] _b Box to add
+      /// \return This new box
+      public: constexpr const AxisAlignedBoxT &operator+=(
+                  const AxisAlignedBoxT &_b)
+      {
+        this->Merge(_b);
+        return *this;
+      }
+
+      /// \brief Equality test operator
+      /// \param[in] _b Box to test
+      /// \return True if the corners are equal within tolerance
+      public: bool operator==(const AxisAlignedBoxT &_b) const
+      {
+        return this->min == _b.min && this->max == _b.max;
+      }
+
+      /// \brief Inequality test operator
+      /// \param[in] _b Box to test
+      /// \return True if not equal
+      public: bool operator!=(const AxisAlignedBoxT &_b) const
+      {
+        return !(*this == _b);
+      }
+
+      /// \brief Subtract a vector from the min and max values
+      /// \param _v The vector to use during subtraction
+      /// \return The new box
+      public: constexpr AxisAlignedBoxT operator-(const Vector3<T> &_v) const
+      {
+        return AxisAlignedBoxT(this->min - _v, this->max - _v);
+      }
+
+      /// \brief Add a vector to the min and max values
+      /// \param _v The vector to use during addition
+      /// \return The new box
+      public: constexpr AxisAlignedBoxT operator+(const Vector3<T> &_v) const
+      {
+        return AxisAlignedBoxT(this->min + _v, this->max + _v);
+      }
+
+      /// \brief Output operator
+      /// \param[in] _out Output stream
+      /// \param[in] _b Box to output to the stream
+      /// \return The stream
+      public: friend std::ostream &operator<<(std::ostream &_out,
+                  const AxisAlignedBoxT &_b)
+      {
+        _out << "Min[" << _b.Min() << "] Max[" << _b.Max() << "]";
+        return _out;
+      }
+
+      /// \brief Get the minimum corner.
+      /// \return The minimum corner of the box.
+      public: constexpr const Vector3<T> &Min() const
+      {
+        return this->min;
+      }
+
+      /// \brief Get the maximum corner.
+      /// \return The maximum corner of the box.
+      public: constexpr const Vector3<T> &Max() const
+      {
+        return this->max;
+      }
+
+      /// \brief Get a mutable version of the minimum corner.
+      /// \return The minimum corner of the box.
+      public: constexpr Vector3<T> &Min()
+      {
+        return this->min;
+      }
+
+      /// \brief Get a mutable version of the maximum corner.
+      /// \return The maximum corner of the box.
+      public: constexpr Vector3<T> &Max()
+      {
+        return this->max;
+      }
+
+      /// \brief Test box intersection, see AxisAlignedBox::Intersects.
+      /// \param[in] _box Box to check for intersection with this box.
+      /// \return True if this box intersects _box.
+      public: constexpr bool Intersects(const AxisAlignedBoxT &_box) const
+      {
+        return !(this->max.X() < _box.min.X() ||
+                 this->max.Y() < _box.min.Y() ||
+                 this->max.Z() < _box.min.Z() ||
+                 this->min.X() > _box.max.X() ||
+                 this->min.Y() > _box.max.Y() ||
+                 this->min.Z() > _box.max.Z());
+      }
+
+      /// \brief Check if a point lies inside the box.
+      /// \param[in] _p Point to check.
+      /// \return True if the point is inside the box.
+      public: constexpr bool Contains(const Vector3<T> &_p) const
+      {
+        return _p.X() >= this->min.X() && _p.X() <= this->max.X() &&
+               _p.Y() >= this->min.Y() && _p.Y() <= this->max.Y() &&
+               _p.Z() >= this->min.Z() && _p.Z() <= this->max.Z();
+      }
+
+      /// \brief Check which points of an array lie inside the box. The
+      /// result of each point is the same as Contains(const Vector3<T> &).
+      /// \param[in] _points Points to check.
+      /// \param[out] _result 1 for each point inside the box, 0 otherwise.
+      /// \param[in] _count Number of points.
+      public: void Contains(const Vector3<T> *_points, std::uint8_t *_result,
+                  const std::size_t _count) const
+      {
+        const T minX = this->min.X(), minY = this->min.Y();
+        const T minZ = this->min.Z(), maxX = this->max.X();
+        const T maxY = this->max.Y(), maxZ = this->max.Z();
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const Vector3<T> &p = _points[i];
+          _result[i] = static_cast<std::uint8_t>(
+              (p.X() >= minX) & (p.X() <= maxX) &
+              (p.Y() >= minY) & (p.Y() <= maxY) &
+              (p.Z() >= minZ) & (p.Z() <= maxZ));
+        }
+      }
+
+      /// \brief Check if a ray (origin, direction) intersects the box.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \return True if the ray intersects the box.
+      /// \sa AxisAlignedBox::IntersectCheck
+      public: bool IntersectCheck(const Vector3<T> &_origin,
+                  const Vector3<T> &_dir, const T _min, const T _max) const
+      {
+        return std::get<0>(this->Intersect(_origin, _dir, _min, _max));
+      }
+
+      /// \brief Check if a ray (origin, direction) intersects the box.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \return Whether the ray intersects the box and the distance from
+      /// the ray's start, offset by _min, to the intersection point.
+      /// \sa AxisAlignedBox::IntersectDist
+      public: std::tuple<bool, T> IntersectDist(const Vector3<T> &_origin,
+                  const Vector3<T> &_dir, const T _min, const T _max) const
+      {
+        const auto result = this->Intersect(_origin, _dir, _min, _max);
+        return std::make_tuple(std::get<0>(result), std::get<1>(result));
+      }
+
+      /// \brief Check if a ray (origin, direction) intersects the box.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. This ray will be normalized.
+      /// \param[in] _min Minimum allowed distance.
+      /// \param[in] _max Maximum allowed distance.
+      /// \return Whether the ray intersects the box, the distance from
+      /// the ray's start, offset by _min, to the intersection point and the
+      /// intersection point.
+      /// \sa AxisAlignedBox::Intersect
+      public: std::tuple<bool, T, Vector3<T>> Intersect(
+                  const Vector3<T> &_origin, const Vector3<T> &_dir,
+                  const T _min, const T _max) const
+      {
+        Vector3<T> dir = _dir;
+        dir.Normalize();
+        return this->Intersect(
+            Line3<T>(_origin + dir * _min, _origin + dir * _max));
+      }
+
+      /// \brief Check if a line intersects the box.
+      /// \param[in] _line The line to check against this box.
+      /// \return Whether the line intersects the box, the distance from
+      /// the line's start to the closest intersection point and the
+      /// intersection point. The distance and point are zero if there is
+      /// no intersection.
+      public: std::tuple<bool, T, Vector3<T>> Intersect(
+                  const Line3<T> &_line) const
+      {
+        // low and high are the results from all clipping so far.
+        T low = 0;
+        T high = 1;
+
+        for (int d = 0; d < 3; ++d)
+        {
+          if (!this->ClipLine(d, _line, low, high))
+            return std::make_tuple(false, T(0), Vector3<T>::Zero);
+        }
+
+        const Vector3<T> intersection =
+            _line[0] + ((_line[1] - _line[0]) * low);
+        return std::make_tuple(true, _line[0].Distance(intersection),
+                               intersection);
+      }
+
+      /// \brief Convert a corner from another precision, clamping it to the
+      /// range of T so the corners of a box with no extent stay finite.
+      /// \param[in] _v Corner to convert.
+      /// \return The converted corner.
+      private: template<typename U>
+               static constexpr Vector3<T> Convert(const Vector3<U> &_v)
+      {
+        if constexpr (std::numeric_limits<U>::max() <=
+                      std::numeric_limits<T>::max())
+        {
+          return Vector3<T>(static_cast<T>(_v.X()), static_cast<T>(_v.Y()),
+                            static_cast<T>(_v.Z()));
+        }
+        constexpr U low = static_cast<U>(std::numeric_limits<T>::lowest());
+        constexpr U high = static_cast<U>(std::numeric_limits<T>::max());
+        return Vector3<T>(static_cast<T>(std::clamp(_v.X(), low, high)),
+                          static_cast<T>(std::clamp(_v.Y(), low, high)),
+                          static_cast<T>(std::clamp(_v.Z(), low, high)));
+      }
+
+      /// \brief Clip a line to a dimension of the box.
+      /// \param[in] _d Dimension of the box(0, 1, or 2).
+      /// \param[in] _line Line to clip
+      /// \param[in,out] _low Close distance
+      /// \param[in,out] _high Far distance
+      /// \return False if the line misses the box in this dimension.
+      private: bool ClipLine(const int _d, const Line3<T> &_line,
+                   T &_low, T &_high) const
+      {
+        T dimLow = (this->min[_d] - _line[0][_d]) /
+            (_line[1][_d] - _line[0][_d]);
+        T dimHigh = (this->max[_d] - _line[0][_d]) /
+            (_line[1][_d] - _line[0][_d]);
+
+        if (dimHigh < dimLow)
+          std::swap(dimHigh, dimLow);
+
+        if (dimHigh < _low || dimLow > _high)
+          return false;
+
+        if (std::isfinite(dimLow))
+          _low = std::max(dimLow, _low);
+        if (std::isfinite(dimHigh))
+          _high = std::min(dimHigh, _high);
+        return true;
+      }
+
+      /// \brief Minimum corner of the box
+      private: Vector3<T> min = Vector3<T>(
+          std::numeric_limits<T>::max(), std::numeric_limits<T>::max(),
+          std::numeric_limits<T>::max());
+
+      /// \brief Maximum corner of the box
+      private: Vector3<T> max = Vector3<T>(
+          std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest(),
+          std::numeric_limits<T>::lowest());
+    };
+
+    using AxisAlignedBoxf = AxisAlignedBoxT<float>;
+    using AxisAlignedBoxd = AxisAlignedBoxT<double>;
+    }
+  }
+}
+#endif
@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_AXISALIGNEDBOXTREE_HH_
+#define GZ_MATH_AXISALIGNEDBOXTREE_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Export.hh>
+#include <gz/math/Frustum.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \brief State of the frustum culling of an AxisAlignedBoxTree, kept
+    /// between calls to AxisAlignedBoxTree::Intersects, for example one
+    /// per camera. It remembers the frustum plane that last culled each
+    /// node, which is tested first on the next call since consecutive
+    /// frames are usually close, and holds buffers reused between calls.
+    /// A state may be used with any tree, it is reset when the number of
+    /// nodes changes.
+    struct AxisAlignedBoxTreeCullState
+    {
+      /// \brief Index of the plane that last culled each node.
+      std::vector<std::uint8_t> planes;
+
+      /// \brief Traversal stack of node indices and plane masks.
+      std::vector<std::pair<std::size_t, unsigned int>> stack;
+    };
+
+    /// \class AxisAlignedBoxTree AxisAlignedBoxTree.hh
+    /// gz/math/AxisAlignedBoxTree.hh
+    /// \brief A bounding volume hierarchy over a set of axis aligned boxes,
+    /// used to answer ray and overlap queries without testing every box.
+    ///
+    /// The tree is built top down with a binned surface area heuristic.
+    /// Boxes are identified by their index in the vector passed to Build().
+    /// When boxes move, Refit() and SetBox() update the bounds of the
+    /// existing tree, which is much cheaper than a rebuild but lets the
+    /// quality of the tree degrade if the boxes move far.
+    ///
+    /// # Example usage
+    ///
+    /// ```{.cpp}
+    /// gz::math::AxisAlignedBoxTree tree(boxes);
+    /// std::size_t index;
+    /// double distance;
+    /// if (tree.RayClosestHit(origin, dir, 0, 100, index, distance))
+    ///   std::cout << "Hit box " << index << " at " << distance << "\n";
+    /// ```
+    class GZ_MATH_VISIBLE AxisAlignedBoxTree
+    {
+      /// \brief Default constructor, creates an empty tree.
+      public: AxisAlignedBoxTree();
+
+      /// \brief Constructor, builds a tree over a set of boxes.
+      /// \param[in] _boxes The boxes.
+      /// \sa Build
+      public: explicit AxisAlignedBoxTree(
+                  const std::vector<AxisAlignedBox> &_boxes);
+
+      /// \brief Build the tree over a set of boxes, replacing the current
+      /// contents. The resulting tree is the same for any thread count.
+      /// \param[in] _boxes The boxes.
+      /// \param[in] _threads Maximum number of threads used to build
+      /// independent subtrees. Zero uses std::thread::hardware_concurrency.
+      public: void Build(const std::vector<AxisAlignedBox> &_boxes,
+                         const unsigned int _threads = 1);
+
+      /// \brief Get the number of boxes in the tree.
+      /// \return Number of boxes.
+      public: std::size_t Size() const;
+
+      /// \brief Get a box of the tree.
+      /// \param[in] _index Index of the box. It is not checked.
+      /// \return The box.
+      public: const AxisAlignedBox &Box(const std::size_t _index) const;
+
+      /// \brief Get the bounds of all boxes in the tree.
+      /// \return A box containing every box of the tree. It is empty if the
+      /// tree is empty.
+      public: AxisAlignedBox Bounds() const;
+
+      /// \brief Replace all boxes and update the bounds of the tree without
+      /// changing its structure.
+      /// \param[in] _boxes The new boxes, in the same order as the boxes
+      /// the tree was built with.
+      /// \return False if the number of boxes differs from Size().
+      public: bool Refit(const std::vector<AxisAlignedBox> &_boxes);
+
+      /// \brief Replace one box and update the bounds of the nodes above it.
+      /// \param[in] _index Index of the box.
+      /// \param[in] _box The new box.
+      /// \return False if _index is not less than Size().
+      public: bool SetBox(const std::size_t _index, const AxisAlignedBox &_box);
+
+      /// \brief Find the closest box hit by a ray. Boxes are tested with
+      /// AxisAlignedBox::Intersect, see it for the meaning of the parameters.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray, it does not need to be
+      /// normalized.
+      /// \param[in] _min Minimum distance along the ray.
+      /// \param[in] _max Maximum distance along the ray.
+      /// \param[out] _index Index of the closest box hit.
+      /// \param[out] _distance Distance to the hit, as returned by
+      /// AxisAlignedBox::Intersect.
+      /// \return True if any box is hit.
+      public: bool RayClosestHit(const Vector3d &_origin, const Vector3d &_dir,
+                                 const double _min, const double _max,
+                                 std::size_t &_index, double &_distance) const;
+
+      /// \brief Find the closest item hit by a ray, where each box bounds
+      /// one or more items tested by a function, such as the triangles of a
+      /// block of a Triangle3Array. Boxes are visited front to back and
+      /// those entered beyond the closest hit so far are skipped.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray, it does not need to be
+      /// normalized.
+      /// \param[in] _min Minimum distance along the ray.
+      /// \param[in] _max Maximum distance along the ray.
+      /// \param[in] _test Function called with the index of a box hit by
+      /// the ray and the distance of the closest hit so far, or _max. It
+      /// returns true and sets its last argument to the distance from
+      /// _origin to the hit if an item in the box is hit closer.
+      /// \param[out] _index Index of the box of the closest hit.
+      /// \param[out] _distance Distance to the closest hit, as set by _test.
+      /// \return True if _test reported any hit.
+      public: bool RayClosestHit(const Vector3d &_origin, const Vector3d &_dir,
+                  const double _min, const double _max,
+                  const std::function<bool(std::size_t, double, double &)>
+                      &_test,
+                  std::size_t &_index, double &_distance) const;
+
+      /// \brief Check whether a ray hits any box. This stops at the first
+      /// box found, which is not necessarily the closest one.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray, it does not need to be
+      /// normalized.
+      /// \param[in] _min Minimum distance along the ray.
+      /// \param[in] _max Maximum distance along the ray.
+      /// \return True if any box is hit.
+      public: bool RayAnyHit(const Vector3d &_origin, const Vector3d &_dir,
+                             const double _min, const double _max) const;
+
+      /// \brief Find all boxes that intersect a box, as defined by
+      /// AxisAlignedBox::Intersects.
+      /// \param[in] _box The box to test against.
+      /// \param[out] _indices Indices of the boxes that intersect _box. It
+      /// is cleared first.
+      public: void Intersects(const AxisAlignedBox &_box,
+                              std::vector<std::size_t> &_indices) const;
+
+      /// \brief Find all boxes inside a frustum, as defined by
+      /// Frustum::Contains(const AxisAlignedBox &).
+      /// \param[in] _frustum The frustum to test against.
+      /// \param[out] _indices Indices of the boxes inside _frustum. It is
+      /// cleared first.
+      public: void Intersects(const Frustum &_frustum,
+                              std::vector<std::size_t> &_indices) const;
+
+      /// \brief Find all boxes inside a frustum, as defined by
+      /// Frustum::Contains(const AxisAlignedBox &), reusing the state of
+      /// the previous calls. The result is the same as the one of the
+      /// function above, but culling is faster when the frustum moves
+      /// little between calls, and nothing is allocated once the buffers
+      /// have grown.
+      /// \param[in] _frustum The frustum to test against.
+      /// \param[in,out] _state State kept between calls.
+      /// \param[out] _indices Indices of the boxes inside _frustum. It is
+      /// cleared first.
+      public: void Intersects(const Frustum &_frustum,
+                              AxisAlignedBoxTreeCullState &_state,
+                              std::vector<std::size_t> &_indices) const;
+
+      /// \brief Check which frustums of a sensor suite contain each box,
+      /// with a single traversal of the tree for all the frustums. Each
+      /// node keeps the set of frustums it may be partly inside, so a
+      /// subtree is skipped once it is outside of all of them, and reported
+      /// without further tests once it is fully inside the rest. The
+      /// result is the same as Frustum::Visibility over the boxes.
+      /// \param[in] _frustums Frustums to check against, at most
+      /// Frustum::kMaxVisibilityFrustums are used.
+      /// \param[in] _frustumCount Number of frustums.
+      /// \param[out] _masks Size() masks, one per box in the order given to
+      /// Build(), with bit f set if the box is inside _frustums[f] as
+      /// defined by Frustum::Contains(const AxisAlignedBox &).
+      /// \param[in] _threads Maximum number of threads used to traverse
+      /// independent subtrees. Zero uses std::thread::hardware_concurrency.
+      /// \sa Frustum::Visibility
+      public: void Visibility(const Frustum *_frustums,
+                              const std::size_t _frustumCount,
+                              std::uint64_t *_masks,
+                              const unsigned int _threads = 1) const;
+
+      /// \brief Private data pointer.
+      GZ_UTILS_IMPL_PTR(dataPtr)
+    };
+    }
+  }
+}
+#endif
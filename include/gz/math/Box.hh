@@ -17,11 +17,13 @@
 #ifndef GZ_MATH_BOX_HH_
 #define GZ_MATH_BOX_HH_
 
+#include <cstddef>
 #include <optional>
 #include <gz/math/config.hh>
 #include <gz/math/MassMatrix3.hh>
 #include <gz/math/Material.hh>
 #include <gz/math/Plane.hh>
+#include <gz/math/Pose3.hh>
 #include <gz/math/Vector3.hh>
 
 #include "gz/math/detail/WellOrderedVector.hh"
@@ -149,6 +151,28 @@ namespace gz
       public: std::optional<Vector3<Precision>>
         CenterOfVolumeBelow(const Plane<Precision> &_plane) const;
 
+      /// \brief Compute the volume and center of volume below a plane of
+      /// many boxes at once, such as the hull of a floating body below the
+      /// water. Each box gives the same results as VolumeBelow and
+      /// CenterOfVolumeBelow with the plane expressed in its frame.
+      /// \param[in] _boxes Pointer to the first box.
+      /// \param[in] _poses Pointer to the pose of the first box, in the
+      /// frame of the plane.
+      /// \param[in] _count Number of boxes.
+      /// \param[in] _plane The plane which cuts the boxes. Its size is
+      /// ignored, the plane is infinite.
+      /// \param[out] _volumes Pointer to the first of `_count` volumes
+      /// below the plane, in m^3.
+      /// \param[out] _centers Pointer to the first of `_count` centers of
+      /// volume, in the frame of the plane, or nullptr. The center is NaN
+      /// for a box with no volume below the plane.
+      public: static void VolumesBelow(const Box<Precision> *_boxes,
+                                       const Pose3<Precision> *_poses,
+                                       const std::size_t _count,
+                                       const Plane<Precision> &_plane,
+                                       Precision *_volumes,
+                                       Vector3<Precision> *_centers);
+
       /// \brief All the vertices which are on or below the plane.
       /// \param[in] _plane The plane which cuts the box, expressed in the box's
       /// frame.
@@ -206,6 +230,89 @@ namespace gz
       public: IntersectionPoints<Precision> Intersections(
         const Plane<Precision> &_plane) const;
 
+      /// \brief Maximum number of intersections between a plane and the
+      /// box's edges, one per edge.
+      public: static constexpr std::size_t kMaxIntersections = 12;
+
+      /// \brief Get intersection between a plane and the box's edges into
+      /// an array, without allocating memory. The points are the same and
+      /// in the same order as in the set returned by
+      /// Intersections(const Plane<Precision> &).
+      /// \param[in] _plane The plane against which we are testing
+      /// intersection.
+      /// \param[out] _points Array of at least kMaxIntersections points.
+      /// \return Number of intersection points written to _points.
+      public: std::size_t Intersections(const Plane<Precision> &_plane,
+                                        Vector3<Precision> *_points) const;
+
+      /// \brief Get the polygon where a plane cuts the box, without
+      /// allocating memory. The vertices are the intersections between the
+      /// plane and the box's edges, as in Intersections, but they are
+      /// ordered counterclockwise around the normal of the plane, so they
+      /// can be drawn as a triangle fan. Corners closer to the plane than
+      /// the rounding errors are vertices, and the edges which end there
+      /// are ignored.
+      /// \param[in] _plane The plane which cuts the box, expressed in the
+      /// box's frame.
+      /// \param[out] _points Array of at least kMaxIntersections points.
+      /// \return Number of vertices written to _points.
+      public: std::size_t IntersectionPolygon(const Plane<Precision> &_plane,
+                                              Vector3<Precision> *_points)
+                                              const;
+
+      /// \brief Compute the polygons where a plane cuts many boxes at
+      /// once, such as the slices of a scene drawn at a water surface.
+      /// Each box gives the vertices of IntersectionPolygon with the plane
+      /// expressed in its frame, in the frame of the plane. The polygons
+      /// are written one after the other to a single buffer.
+      /// \param[in] _boxes Pointer to the first box.
+      /// \param[in] _poses Pointer to the pose of the first box, in the
+      /// frame of the plane.
+      /// \param[in] _count Number of boxes.
+      /// \param[in] _plane The plane which cuts the boxes. Its size is
+      /// ignored, the plane is infinite.
+      /// \param[out] _points Array of at least `_count * kMaxIntersections`
+      /// points, set to the vertices of the polygons, in the frame of the
+      /// plane.
+      /// \param[out] _offsets Array of `_count + 1` offsets. The vertices
+      /// of the polygon of box i are _points[_offsets[i]] to
+      /// _points[_offsets[i + 1] - 1], none if the plane misses the box.
+      /// \return Total number of vertices, _offsets[_count].
+      public: static std::size_t IntersectionPolygons(
+                  const Box<Precision> *_boxes,
+                  const Pose3<Precision> *_poses,
+                  const std::size_t _count,
+                  const Plane<Precision> &_plane,
+                  Vector3<Precision> *_points,
+                  std::size_t *_offsets);
+
+      /// \brief Maximum number of vertices of the box cut by a plane: the
+      /// 8 vertices of the box and the intersections with its 12 edges.
+      private: static constexpr std::size_t kMaxClippedVertices = 20;
+
+      /// \brief Get the vertices below a plane and the intersections of
+      /// the plane with the edges, without duplicates, in the order of
+      /// IntersectionPoints. This does not allocate memory.
+      /// \param[in] _plane The plane which cuts the box, expressed in the
+      /// box's frame.
+      /// \param[out] _vertices Array of at least kMaxClippedVertices
+      /// vertices.
+      /// \return Number of vertices, 0 if no vertex of the box is on or
+      /// below the plane.
+      private: std::size_t ClippedVertices(const Plane<Precision> &_plane,
+                                           Vector3<Precision> *_vertices) const;
+
+      /// \brief Get the volume of the box below a plane from its clipped
+      /// vertices.
+      /// \param[in] _plane The plane which cuts the box, expressed in the
+      /// box's frame.
+      /// \param[in] _vertices Vertices returned by ClippedVertices.
+      /// \param[in] _count Number of vertices, not 0.
+      /// \return Volume below the plane in m^3.
+      private: Precision ClippedVolume(const Plane<Precision> &_plane,
+                                       const Vector3<Precision> *_vertices,
+                                       const std::size_t _count) const;
+
       /// \brief Size of the box.
       private: Vector3<Precision> size = Vector3<Precision>::Zero;
 
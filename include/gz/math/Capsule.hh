@@ -17,9 +17,13 @@
 #ifndef GZ_MATH_CAPSULE_HH_
 #define GZ_MATH_CAPSULE_HH_
 
+#include <cstddef>
 #include <optional>
 #include "gz/math/MassMatrix3.hh"
 #include "gz/math/Material.hh"
+#include "gz/math/Plane.hh"
+#include "gz/math/Pose3.hh"
+#include "gz/math/Vector3.hh"
 
 namespace gz
 {
@@ -98,6 +102,45 @@ namespace gz
       /// \return Volume of the capsule in m^3.
       public: Precision Volume() const;
 
+      /// \brief Get the volume of the capsule below a plane.
+      /// The slices of the capsule are integrated along its axis with a
+      /// Gauss-Legendre rule, with a relative error below 1e-8.
+      /// \param[in] _plane The plane which cuts the capsule, expressed in the
+      /// capsule's frame.
+      /// \return Volume below the plane in m^3.
+      public: Precision VolumeBelow(const Plane<Precision> &_plane) const;
+
+      /// \brief Center of volume below the plane. This is useful when
+      /// calculating where buoyancy should be applied, for example.
+      /// \param[in] _plane The plane which cuts the capsule, expressed in the
+      /// capsule's frame.
+      /// \return Center of volume, in the capsule's frame, or std::nullopt if
+      /// the capsule is completely above the plane.
+      public: std::optional<Vector3<Precision>>
+        CenterOfVolumeBelow(const Plane<Precision> &_plane) const;
+
+      /// \brief Compute the volume and center of volume below a plane of
+      /// many capsules at once, such as the hull of a floating body below the
+      /// water. Each capsule gives the same results as VolumeBelow and
+      /// CenterOfVolumeBelow with the plane expressed in its frame.
+      /// \param[in] _capsules Pointer to the first capsule.
+      /// \param[in] _poses Pointer to the pose of the first capsule, in the
+      /// frame of the plane.
+      /// \param[in] _count Number of capsules.
+      /// \param[in] _plane The plane which cuts the capsules. Its size is
+      /// ignored, the plane is infinite.
+      /// \param[out] _volumes Pointer to the first of `_count` volumes
+      /// below the plane, in m^3.
+      /// \param[out] _centers Pointer to the first of `_count` centers of
+      /// volume, in the frame of the plane, or nullptr. The center is NaN
+      /// for a capsule with no volume below the plane.
+      public: static void VolumesBelow(const Capsule<Precision> *_capsules,
+                                       const Pose3<Precision> *_poses,
+                                       const std::size_t _count,
+                                       const Plane<Precision> &_plane,
+                                       Precision *_volumes,
+                                       Vector3<Precision> *_centers);
+
       /// \brief Compute the capsule's density given a mass value. The
       /// capsule is assumed to be solid with uniform density. This
       /// function requires the capsule's radius and length to be set to
@@ -122,6 +165,15 @@ namespace gz
       /// \sa Precision DensityFromMass(const Precision _mass) const
       public: bool SetDensityFromMass(const Precision _mass);
 
+      /// \brief Volume and center of volume below a plane.
+      /// \param[in] _plane The plane, expressed in the capsule's frame.
+      /// \param[out] _center Center of volume, or NaN if there is no volume
+      /// below the plane.
+      /// \return Volume below the plane in m^3.
+      private: Precision VolumeAndCenterBelow(const Plane<Precision> &_plane,
+                                              Vector3<Precision> &_center)
+                                              const;
+
       /// \brief Radius of the capsule.
       private: Precision radius = 0.0;
 
@@ -0,0 +1,508 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_CAPSULEARRAY_HH_
+#define GZ_MATH_CAPSULEARRAY_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <gz/math/Line3.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class CapsuleArray CapsuleArray.hh gz/math/CapsuleArray.hh
+    /// \brief A structure-of-arrays container of placed capsules for
+    /// distance and contact queries between many of them, such as the
+    /// links of a rope or the bodies of a crowd.
+    ///
+    /// Each capsule is a center, an axis and a radius, with every
+    /// component in its own contiguous buffer. The axis is the vector from
+    /// the center to the center of one of the end caps, so the core
+    /// segment goes from center - axis to center + axis, and a zero axis
+    /// gives a sphere. Capsule only describes the shape, without a
+    /// position. Distances are between the surfaces, and are negative when
+    /// the capsules overlap, by their penetration depth.
+    ///
+    /// The closest points of the core segments are exact, as in Line3Array:
+    /// both parameters are clamped to the segments, and segments of zero
+    /// length are points. Pairs are processed by blocks of kBlockSize,
+    /// which are gathered in local arrays and go through branch free loops
+    /// the compiler turns into SIMD code.
+    ///
+    /// # Example
+    ///
+    /// \code{.cpp}
+    /// gz::math::CapsuleArrayd links;
+    /// links.Assign(centers.data(), axes.data(), radii.data(), count);
+    /// // Pairs from a broadphase such as SweepAndPrune
+    /// links.Distances(first.data(), second.data(), first.size(),
+    ///                 distances.data(), normals.data());
+    /// \endcode
+    /// \tparam T Floating point type of the coordinates.
+    template<typename T>
+    class CapsuleArray
+    {
+      static_assert(std::is_floating_point_v<T>,
+          "CapsuleArray requires a floating point type");
+
+      /// \brief Number of pairs processed together by the queries.
+      public: static constexpr std::size_t kBlockSize = 8;
+
+      /// \brief Default constructor, creates an empty array.
+      public: CapsuleArray() = default;
+
+      /// \brief Replace the contents of this array.
+      /// \param[in] _centers Centers of the capsules.
+      /// \param[in] _axes Vectors from the centers to the centers of an end
+      /// cap.
+      /// \param[in] _radii Radii of the capsules.
+      /// \param[in] _count Number of capsules.
+      public: void Assign(const Vector3<T> *_centers, const Vector3<T> *_axes,
+                          const T *_radii, const std::size_t _count)
+      {
+        this->Clear();
+        for (std::size_t i = 0; i < _count; ++i)
+          this->Add(_centers[i], _axes[i], _radii[i]);
+      }
+
+      /// \brief Add a capsule at the end of this array.
+      /// \param[in] _center Center of the capsule.
+      /// \param[in] _axis Vector from the center to the center of an end
+      /// cap.
+      /// \param[in] _radius Radius of the capsule.
+      public: void Add(const Vector3<T> &_center, const Vector3<T> &_axis,
+                       const T _radius)
+      {
+        this->cx.push_back(_center.X());
+        this->cy.push_back(_center.Y());
+        this->cz.push_back(_center.Z());
+        this->ux.push_back(_axis.X());
+        this->uy.push_back(_axis.Y());
+        this->uz.push_back(_axis.Z());
+        this->radii.push_back(_radius);
+      }
+
+      /// \brief Add a capsule at the end of this array.
+      /// \param[in] _segment Core segment of the capsule, between the
+      /// centers of its end caps.
+      /// \param[in] _radius Radius of the capsule.
+      public: void Add(const Line3<T> &_segment, const T _radius)
+      {
+        this->Add((_segment[0] + _segment[1]) / 2,
+                  (_segment[1] - _segment[0]) / 2, _radius);
+      }
+
+      /// \brief Replace a capsule.
+      /// \param[in] _index Index of the capsule. It is not checked.
+      /// \param[in] _center Center of the capsule.
+      /// \param[in] _axis Vector from the center to the center of an end
+      /// cap.
+      /// \param[in] _radius Radius of the capsule.
+      public: void SetCapsule(const std::size_t _index,
+                              const Vector3<T> &_center,
+                              const Vector3<T> &_axis, const T _radius)
+      {
+        this->cx[_index] = _center.X();
+        this->cy[_index] = _center.Y();
+        this->cz[_index] = _center.Z();
+        this->ux[_index] = _axis.X();
+        this->uy[_index] = _axis.Y();
+        this->uz[_index] = _axis.Z();
+        this->radii[_index] = _radius;
+      }
+
+      /// \brief Remove all the capsules.
+      public: void Clear()
+      {
+        for (std::vector<T> *buffer : {&this->cx, &this->cy, &this->cz,
+                                       &this->ux, &this->uy, &this->uz,
+                                       &this->radii})
+        {
+          buffer->clear();
+        }
+      }
+
+      /// \brief Get the number of capsules.
+      /// \return Number of capsules.
+      public: std::size_t Size() const
+      {
+        return this->radii.size();
+      }
+
+      /// \brief Check whether the array is empty.
+      /// \return True if the array holds no capsule.
+      public: bool Empty() const
+      {
+        return this->radii.empty();
+      }
+
+      /// \brief Get the center of a capsule.
+      /// \param[in] _index Index of the capsule. It is not checked.
+      /// \return The center.
+      public: Vector3<T> Center(const std::size_t _index) const
+      {
+        return Vector3<T>(this->cx[_index], this->cy[_index],
+                          this->cz[_index]);
+      }
+
+      /// \brief Get the axis of a capsule.
+      /// \param[in] _index Index of the capsule. It is not checked.
+      /// \return Vector from the center to the center of an end cap.
+      public: Vector3<T> Axis(const std::size_t _index) const
+      {
+        return Vector3<T>(this->ux[_index], this->uy[_index],
+                          this->uz[_index]);
+      }
+
+      /// \brief Get the radius of a capsule.
+      /// \param[in] _index Index of the capsule. It is not checked.
+      /// \return The radius.
+      public: T Radius(const std::size_t _index) const
+      {
+        return this->radii[_index];
+      }
+
+      /// \brief Get the core segment of a capsule.
+      /// \param[in] _index Index of the capsule. It is not checked.
+      /// \return Segment between the centers of the end caps.
+      public: Line3<T> Segment(const std::size_t _index) const
+      {
+        const Vector3<T> center = this->Center(_index);
+        const Vector3<T> axis = this->Axis(_index);
+        return Line3<T>(center - axis, center + axis);
+      }
+
+      /// \brief Get the distance between two capsules.
+      /// \param[in] _center1 Center of the first capsule.
+      /// \param[in] _axis1 Axis of the first capsule.
+      /// \param[in] _radius1 Radius of the first capsule.
+      /// \param[in] _center2 Center of the second capsule.
+      /// \param[in] _axis2 Axis of the second capsule.
+      /// \param[in] _radius2 Radius of the second capsule.
+      /// \return Distance between the surfaces, negative if they overlap.
+      public: static T Distance(const Vector3<T> &_center1,
+                                const Vector3<T> &_axis1, const T _radius1,
+                                const Vector3<T> &_center2,
+                                const Vector3<T> &_axis2, const T _radius2)
+      {
+        Lanes<1> lanes;
+        lanes.Set(0, _center1, _axis1, _center2, _axis2);
+        Closest(lanes);
+        const Vector3<T> v = _center1 + _axis1 * lanes.s[0] - _center2 -
+                             _axis2 * lanes.t[0];
+        return v.Length() - _radius1 - _radius2;
+      }
+
+      /// \brief Get the distance from a capsule to a point.
+      /// \param[in] _center Center of the capsule.
+      /// \param[in] _axis Axis of the capsule.
+      /// \param[in] _radius Radius of the capsule.
+      /// \param[in] _point The point.
+      /// \return Distance from the surface, negative inside the capsule.
+      public: static T Distance(const Vector3<T> &_center,
+                                const Vector3<T> &_axis, const T _radius,
+                                const Vector3<T> &_point)
+      {
+        const Vector3<T> r = _point - _center;
+        const T s = Clamp(r.Dot(_axis) / (_axis.SquaredLength() + kTiny));
+        return (r - _axis * s).Length() - _radius;
+      }
+
+      /// \brief Get the distance from a point to every capsule of this
+      /// array.
+      /// \param[in] _point The point.
+      /// \param[out] _distances Distance to each capsule of this array,
+      /// negative inside the capsule. It must hold Size() values.
+      public: void Distances(const Vector3<T> &_point, T *_distances) const
+      {
+        const T *xs = this->cx.data();
+        const T *ys = this->cy.data();
+        const T *zs = this->cz.data();
+        const T *axs = this->ux.data();
+        const T *ays = this->uy.data();
+        const T *azs = this->uz.data();
+        const T *rs = this->radii.data();
+        for (std::size_t i = 0; i < this->Size(); ++i)
+        {
+          const T rx = _point.X() - xs[i];
+          const T ry = _point.Y() - ys[i];
+          const T rz = _point.Z() - zs[i];
+          const T a = axs[i] * axs[i] + ays[i] * ays[i] + azs[i] * azs[i];
+          const T s = Clamp(
+              (rx * axs[i] + ry * ays[i] + rz * azs[i]) / (a + kTiny));
+          const T vx = rx - axs[i] * s;
+          const T vy = ry - ays[i] * s;
+          const T vz = rz - azs[i] * s;
+          _distances[i] = std::sqrt(vx * vx + vy * vy + vz * vz) - rs[i];
+        }
+      }
+
+      /// \brief Get the distances and contact normals of pairs of a capsule
+      /// of this array and a point.
+      /// \param[in] _capsules Index of the capsule of each pair. It is not
+      /// checked.
+      /// \param[in] _points Point of each pair.
+      /// \param[in] _count Number of pairs.
+      /// \param[out] _distances Distance of each pair, negative if the point
+      /// is inside the capsule.
+      /// \param[out] _normals Unit vector from the closest point of the
+      /// core segment to the point for each pair, zero if the point is on
+      /// the segment, or nullptr.
+      public: void Distances(const std::size_t *_capsules,
+                             const Vector3<T> *_points,
+                             const std::size_t _count, T *_distances,
+                             Vector3<T> *_normals = nullptr) const
+      {
+        for (std::size_t k = 0; k < _count; ++k)
+        {
+          const std::size_t i = _capsules[k];
+          const Vector3<T> axis = this->Axis(i);
+          const Vector3<T> r = _points[k] - this->Center(i);
+          const T s = Clamp(r.Dot(axis) / (axis.SquaredLength() + kTiny));
+          const Vector3<T> v = r - axis * s;
+          const T length = v.Length();
+          _distances[k] = length - this->radii[i];
+          if (_normals)
+            _normals[k] = length > 0 ? v / length : Vector3<T>::Zero;
+        }
+      }
+
+      /// \brief Get the distances and contact normals of pairs of capsules
+      /// of this array, such as the pairs found by a broadphase.
+      /// \param[in] _first Index of the first capsule of each pair. It is
+      /// not checked.
+      /// \param[in] _second Index of the second capsule of each pair. It is
+      /// not checked.
+      /// \param[in] _count Number of pairs.
+      /// \param[out] _distances Distance of each pair, negative if the
+      /// capsules overlap.
+      /// \param[out] _normals Unit vector between the closest points of the
+      /// core segments, from the first capsule to the second one, for each
+      /// pair, zero if the segments intersect, or nullptr.
+      public: void Distances(const std::size_t *_first,
+                             const std::size_t *_second,
+                             const std::size_t _count, T *_distances,
+                             Vector3<T> *_normals = nullptr) const
+      {
+        Lanes<kBlockSize> lanes;
+        T dist[kBlockSize];
+        T nx[kBlockSize];
+        T ny[kBlockSize];
+        T nz[kBlockSize];
+        for (std::size_t begin = 0; begin < _count; begin += kBlockSize)
+        {
+          // Unused lanes repeat the first pair of the block
+          const std::size_t n = std::min(kBlockSize, _count - begin);
+          for (std::size_t k = 0; k < kBlockSize; ++k)
+          {
+            const std::size_t p = begin + (k < n ? k : 0);
+            lanes.Set(k, this->Center(_first[p]), this->Axis(_first[p]),
+                      this->Center(_second[p]), this->Axis(_second[p]));
+            dist[k] = this->radii[_first[p]] + this->radii[_second[p]];
+          }
+          Closest(lanes);
+
+          for (std::size_t k = 0; k < kBlockSize; ++k)
+          {
+            const T vx = lanes.c2x[k] + lanes.u2x[k] * lanes.t[k] -
+                         lanes.c1x[k] - lanes.u1x[k] * lanes.s[k];
+            const T vy = lanes.c2y[k] + lanes.u2y[k] * lanes.t[k] -
+                         lanes.c1y[k] - lanes.u1y[k] * lanes.s[k];
+            const T vz = lanes.c2z[k] + lanes.u2z[k] * lanes.t[k] -
+                         lanes.c1z[k] - lanes.u1z[k] * lanes.s[k];
+            const T length = std::sqrt(vx * vx + vy * vy + vz * vz);
+            const T scale = 1 / (length + kTiny);
+            dist[k] = length - dist[k];
+            nx[k] = vx * scale;
+            ny[k] = vy * scale;
+            nz[k] = vz * scale;
+          }
+
+          std::copy(dist, dist + n, _distances + begin);
+          if (_normals)
+          {
+            for (std::size_t k = 0; k < n; ++k)
+              _normals[begin + k].Set(nx[k], ny[k], nz[k]);
+          }
+        }
+      }
+
+      /// \brief Pairs of capsule cores, one per lane, and the parameters of
+      /// their closest points.
+      /// \tparam N Number of lanes.
+      private: template<std::size_t N>
+      struct Lanes
+      {
+        /// \brief Set a lane.
+        /// \param[in] _k Index of the lane.
+        /// \param[in] _c1 Center of the first capsule.
+        /// \param[in] _u1 Axis of the first capsule.
+        /// \param[in] _c2 Center of the second capsule.
+        /// \param[in] _u2 Axis of the second capsule.
+        void Set(const std::size_t _k, const Vector3<T> &_c1,
+                 const Vector3<T> &_u1, const Vector3<T> &_c2,
+                 const Vector3<T> &_u2)
+        {
+          this->c1x[_k] = _c1.X();
+          this->c1y[_k] = _c1.Y();
+          this->c1z[_k] = _c1.Z();
+          this->u1x[_k] = _u1.X();
+          this->u1y[_k] = _u1.Y();
+          this->u1z[_k] = _u1.Z();
+          this->c2x[_k] = _c2.X();
+          this->c2y[_k] = _c2.Y();
+          this->c2z[_k] = _c2.Z();
+          this->u2x[_k] = _u2.X();
+          this->u2y[_k] = _u2.Y();
+          this->u2z[_k] = _u2.Z();
+        }
+
+        /// \brief Centers of the first capsules.
+        T c1x[N], c1y[N], c1z[N];
+
+        /// \brief Axes of the first capsules.
+        T u1x[N], u1y[N], u1z[N];
+
+        /// \brief Centers of the second capsules.
+        T c2x[N], c2y[N], c2z[N];
+
+        /// \brief Axes of the second capsules.
+        T u2x[N], u2y[N], u2z[N];
+
+        /// \brief Parameters of the closest points on the first cores, in
+        /// [-1, 1].
+        T s[N];
+
+        /// \brief Parameters of the closest points on the second cores, in
+        /// [-1, 1].
+        T t[N];
+      };
+
+      /// \brief Clamp a value to [-1, 1].
+      /// \param[in] _x Value to clamp.
+      /// \return The clamped value.
+      private: static T Clamp(const T _x)
+      {
+        return _x < -1 ? T(-1) : (_x > 1 ? T(1) : _x);
+      }
+
+      /// \brief Closest points between the cores of each lane, with the
+      /// branch free kernel of Line3Array, where both segments vary by
+      /// lane and are parameterized from their centers.
+      ///
+      /// Every case is computed and the right one selected. The divisors
+      /// are offset by the smallest normal number instead of being tested
+      /// for zero, so a first core of zero length gets s = 0, and parallel
+      /// cores get s = -1 or 1 before t is clamped, which still gives
+      /// their distance. A second core of zero length is selected
+      /// explicitly, since its t is already right but s is not.
+      /// \param[in,out] _lanes The pairs of cores, whose s and t are set.
+      private: template<std::size_t N>
+      static void Closest(Lanes<N> &_lanes)
+      {
+        T bs[N];
+        T fs[N];
+        T es[N];
+        T sLine[N];
+        T sLow[N];
+        T sHigh[N];
+        T sPoint[N];
+        for (std::size_t k = 0; k < N; ++k)
+        {
+          const T rx = _lanes.c1x[k] - _lanes.c2x[k];
+          const T ry = _lanes.c1y[k] - _lanes.c2y[k];
+          const T rz = _lanes.c1z[k] - _lanes.c2z[k];
+          const T d1x = _lanes.u1x[k];
+          const T d1y = _lanes.u1y[k];
+          const T d1z = _lanes.u1z[k];
+          const T d2x = _lanes.u2x[k];
+          const T d2y = _lanes.u2y[k];
+          const T d2z = _lanes.u2z[k];
+          const T a = d1x * d1x + d1y * d1y + d1z * d1z;
+          const T e = d2x * d2x + d2y * d2y + d2z * d2z;
+          const T b = d1x * d2x + d1y * d2y + d1z * d2z;
+          const T c = d1x * rx + d1y * ry + d1z * rz;
+          const T f = d2x * rx + d2y * ry + d2z * rz;
+          const T denom = std::abs(a * e - b * b) + kTiny;
+          bs[k] = b;
+          fs[k] = f;
+          es[k] = e;
+          const T invA = 1 / (a + kTiny);
+          sLine[k] = Clamp((b * f - c * e) / denom);
+          sLow[k] = Clamp((-b - c) * invA);
+          sHigh[k] = Clamp((b - c) * invA);
+          sPoint[k] = Clamp(-c * invA);
+        }
+
+        // t for the closest point of the lines, and s recomputed if t has
+        // to be clamped
+        T tLine[N];
+        for (std::size_t k = 0; k < N; ++k)
+        {
+          const T t = (bs[k] * sLine[k] + fs[k]) / (es[k] + kTiny);
+          const T sClamped =
+            t < -1 ? sLow[k] : (t > 1 ? sHigh[k] : sLine[k]);
+          _lanes.s[k] = es[k] > 0 ? sClamped : sPoint[k];
+          tLine[k] = t;
+        }
+        for (std::size_t k = 0; k < N; ++k)
+          _lanes.t[k] = Clamp(tLine[k]);
+      }
+
+      /// \brief Smallest normal number, added to divisors which may be
+      /// zero.
+      private: static constexpr T kTiny = std::numeric_limits<T>::min();
+
+      /// \brief The x components of the centers.
+      private: std::vector<T> cx;
+
+      /// \brief The y components of the centers.
+      private: std::vector<T> cy;
+
+      /// \brief The z components of the centers.
+      private: std::vector<T> cz;
+
+      /// \brief The x components of the axes.
+      private: std::vector<T> ux;
+
+      /// \brief The y components of the axes.
+      private: std::vector<T> uy;
+
+      /// \brief The z components of the axes.
+      private: std::vector<T> uz;
+
+      /// \brief The radii.
+      private: std::vector<T> radii;
+    };
+
+    using CapsuleArrayd = CapsuleArray<double>;
+    using CapsuleArrayf = CapsuleArray<float>;
+    }
+  }
+}
+#endif
@@ -18,6 +18,8 @@
 #define GZ_MATH_COLOR_HH_
 
 #include <cctype>
+#include <cstddef>
+#include <cstdint>
 #include <istream>
 #include <ostream>
 
@@ -200,6 +202,90 @@ namespace gz
       /// \param[in] _v the new color
       public: void SetFromABGR(const ABGR _v);
 
+      /// \brief Convert a buffer of 8 bit RGBA pixels, such as an image, to
+      /// float RGBA values, as SetFromRGBA does for each pixel.
+      ///
+      /// The buffer conversions process blocks of pixels in loops the
+      /// compiler can vectorize, and can split the buffer in contiguous
+      /// chunks, such as groups of image rows, converted in parallel. The
+      /// source and destination buffers must not overlap.
+      /// \param[in] _rgba8 Red, green, blue and alpha bytes of each pixel,
+      /// 4 * _count values.
+      /// \param[out] _rgba Red, green, blue and alpha values of each pixel,
+      /// in the range [0, 1], 4 * _count values.
+      /// \param[in] _count Number of pixels.
+      /// \param[in] _threads Largest number of threads to use, zero for
+      /// std::thread::hardware_concurrency. Small buffers use fewer threads.
+      public: static void FromRGBA8(const uint8_t *_rgba8, float *_rgba,
+                                    size_t _count,
+                                    unsigned int _threads = 1);
+
+      /// \brief Convert a buffer of float RGBA pixels to 8 bit RGBA, as
+      /// AsRGBA does for each pixel. Values are clamped to [0, 1] first,
+      /// NaN to 0.
+      /// \param[in] _rgba Red, green, blue and alpha values of each pixel,
+      /// 4 * _count values.
+      /// \param[out] _rgba8 Red, green, blue and alpha bytes of each pixel,
+      /// 4 * _count values.
+      /// \param[in] _count Number of pixels.
+      /// \param[in] _threads Largest number of threads to use, zero for
+      /// std::thread::hardware_concurrency.
+      /// \sa FromRGBA8
+      public: static void ToRGBA8(const float *_rgba, uint8_t *_rgba8,
+                                  size_t _count, unsigned int _threads = 1);
+
+      /// \brief Convert a buffer of RGB pixels to HSV, as HSV() does for
+      /// each pixel.
+      /// \param[in] _rgb Red, green and blue values of each pixel,
+      /// 3 * _count values.
+      /// \param[out] _hsv Hue, saturation and value of each pixel,
+      /// 3 * _count values.
+      /// \param[in] _count Number of pixels.
+      /// \param[in] _threads Largest number of threads to use, zero for
+      /// std::thread::hardware_concurrency.
+      /// \sa FromRGBA8
+      public: static void RGBToHSV(const float *_rgb, float *_hsv,
+                                   size_t _count, unsigned int _threads = 1);
+
+      /// \brief Convert a buffer of HSV pixels to RGB, as SetFromHSV does
+      /// for each pixel.
+      /// \param[in] _hsv Hue, saturation and value of each pixel,
+      /// 3 * _count values.
+      /// \param[out] _rgb Red, green and blue values of each pixel,
+      /// 3 * _count values.
+      /// \param[in] _count Number of pixels.
+      /// \param[in] _threads Largest number of threads to use, zero for
+      /// std::thread::hardware_concurrency.
+      /// \sa FromRGBA8
+      public: static void HSVToRGB(const float *_hsv, float *_rgb,
+                                   size_t _count, unsigned int _threads = 1);
+
+      /// \brief Convert a buffer of RGB pixels to YUV, as YUV() does for
+      /// each pixel.
+      /// \param[in] _rgb Red, green and blue values of each pixel,
+      /// 3 * _count values.
+      /// \param[out] _yuv Y, U and V values of each pixel, 3 * _count
+      /// values.
+      /// \param[in] _count Number of pixels.
+      /// \param[in] _threads Largest number of threads to use, zero for
+      /// std::thread::hardware_concurrency.
+      /// \sa FromRGBA8
+      public: static void RGBToYUV(const float *_rgb, float *_yuv,
+                                   size_t _count, unsigned int _threads = 1);
+
+      /// \brief Convert a buffer of YUV pixels to RGB, as SetFromYUV does
+      /// for each pixel.
+      /// \param[in] _yuv Y, U and V values of each pixel, 3 * _count
+      /// values.
+      /// \param[out] _rgb Red, green and blue values of each pixel,
+      /// 3 * _count values.
+      /// \param[in] _count Number of pixels.
+      /// \param[in] _threads Largest number of threads to use, zero for
+      /// std::thread::hardware_concurrency.
+      /// \sa FromRGBA8
+      public: static void YUVToRGB(const float *_yuv, float *_rgb,
+                                   size_t _count, unsigned int _threads = 1);
+
       /// \brief Addition operator (this + _pt)
       /// \param[in] _pt Color to add
       /// \return The resulting color
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_COLORMAP_HH_
+#define GZ_MATH_COLORMAP_HH_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Color.hh>
+#include <gz/math/Export.hh>
+#include <gz/math/config.hh>
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    /// \class ColorMap ColorMap.hh gz/math/ColorMap.hh
+    /// \brief Map scalar values, such as the samples of a grid field, to
+    /// colors for visualization.
+    ///
+    /// The map is defined by control points, pairs of a value and a color,
+    /// and the colors between two points are interpolated linearly. The
+    /// colors are precomputed in a lookup table of packed RGBA values,
+    /// usually 256 or 4096 entries, over the range of values of the
+    /// points, so mapping a value is a clamped index computation and a
+    /// table read instead of Color arithmetic. Values outside of the range
+    /// get the color of the first or last point, and NaN values get the
+    /// color of the first point.
+    ///
+    /// ## Example
+    ///
+    /// \code{.cpp}
+    /// gz::math::ColorMap map({{0.0, gz::math::Color::Blue},
+    ///                         {1.0, gz::math::Color::Red}}, 4096);
+    /// std::vector<gz::math::Color::RGBA> pixels(values.size());
+    /// map.Map(values.data(), pixels.data(), values.size());
+    /// \endcode
+    class GZ_MATH_VISIBLE ColorMap
+    {
+      /// \brief Default constructor, a grayscale map from black at 0 to
+      /// white at 1 with 256 entries.
+      public: ColorMap();
+
+      /// \brief Constructor.
+      /// \param[in] _points Values and colors of the control points, in
+      /// any order. Points with equal values keep their order, so that two
+      /// of them give a sharp transition. The default grayscale map is used
+      /// if it is empty.
+      /// \param[in] _size Number of entries of the lookup table, at least 2.
+      public: explicit ColorMap(
+                  const std::vector<std::pair<double, Color>> &_points,
+                  const std::size_t _size = 256);
+
+      /// \brief Get the number of entries of the lookup table.
+      /// \return Number of entries.
+      public: std::size_t Size() const;
+
+      /// \brief Get the value mapped to the first entry of the table.
+      /// \return Smallest value of the control points.
+      public: double Min() const;
+
+      /// \brief Get the value mapped to the last entry of the table.
+      /// \return Largest value of the control points.
+      public: double Max() const;
+
+      /// \brief Get the lookup table.
+      /// \return Packed colors of the Size() entries, from Min() to Max().
+      public: const std::vector<Color::RGBA> &Table() const;
+
+      /// \brief Map a value to a color.
+      /// \param[in] _value The value.
+      /// \return The packed color of the nearest table entry.
+      public: Color::RGBA Map(const double _value) const;
+
+      /// \brief Map a buffer of values to colors, as Map(double) does for
+      /// each value. The indices are computed by blocks in loops the
+      /// compiler can vectorize, and the buffer can be split in contiguous
+      /// chunks mapped in parallel.
+      /// \param[in] _values Values, _count of them.
+      /// \param[out] _colors Packed colors, _count of them.
+      /// \param[in] _count Number of values.
+      /// \param[in] _threads Largest number of threads to use, zero for
+      /// std::thread::hardware_concurrency. Small buffers use fewer threads.
+      public: void Map(const float *_values, Color::RGBA *_colors,
+                       const std::size_t _count,
+                       const unsigned int _threads = 1) const;
+
+      /// \copydoc Map(const float*, Color::RGBA*, const std::size_t,
+      /// const unsigned int) const
+      public: void Map(const double *_values, Color::RGBA *_colors,
+                       const std::size_t _count,
+                       const unsigned int _threads = 1) const;
+
+      /// \brief Private data pointer.
+      GZ_UTILS_IMPL_PTR(dataPtr)
+    };
+    }
+  }
+}
+#endif
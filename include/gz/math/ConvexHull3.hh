@@ -0,0 +1,791 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_CONVEXHULL3_HH_
+#define GZ_MATH_CONVEXHULL3_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Matrix3.hh>
+#include <gz/math/OrientedBox.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Quaternion.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+#include <gz/math/detail/ParallelFor.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class ConvexHull3 ConvexHull3.hh gz/math/ConvexHull3.hh
+    /// \brief The convex hull of a set of 3D points, as a triangle mesh,
+    /// and the fit of a tight OrientedBox to it, such as for collision
+    /// proxies of imported meshes.
+    ///
+    /// The hull is computed with the quickhull algorithm of Barber et al.:
+    /// starting from a tetrahedron of extreme points, the point farthest
+    /// above a face is added, the faces it sees are replaced by a cone
+    /// from their horizon to the point, and the points above the removed
+    /// faces are given to the new ones. Points within a tolerance of a face
+    /// are considered inside, so nearly coplanar faces are not all kept.
+    /// With several threads, the hulls of chunks of the points are built in
+    /// parallel and the hull of their vertices is built last, which drops
+    /// most of the points early.
+    ///
+    /// The triangles are oriented counterclockwise seen from outside, and
+    /// their vertices are indices in Vertices(), as expected by
+    /// Triangle3Array.
+    ///
+    /// # Example usage
+    ///
+    /// ```{.cpp}
+    /// gz::math::ConvexHull3d hull;
+    /// hull.Build(mesh.data(), mesh.size(), 0);
+    /// gz::math::OrientedBoxd proxy = hull.MinimumVolumeBox(64);
+    /// ```
+    /// \tparam T Floating point type of the coordinates.
+    template<typename T>
+    class ConvexHull3
+    {
+      static_assert(std::is_floating_point_v<T>,
+          "ConvexHull3 requires a floating point type");
+
+      /// \brief Smallest number of points given to each thread by Build.
+      public: static constexpr std::size_t kMinPointsPerThread = 16384;
+
+      /// \brief Default constructor, an empty hull.
+      public: ConvexHull3() = default;
+
+      /// \brief Construct the hull of a set of points.
+      /// \param[in] _points The points.
+      /// \param[in] _threads Maximum number of threads, see Build.
+      public: explicit ConvexHull3(const std::vector<Vector3<T>> &_points,
+                                   const unsigned int _threads = 1)
+      {
+        this->Build(_points.data(), _points.size(), _threads);
+      }
+
+      /// \brief Build the hull of a set of points, replacing the previous
+      /// one.
+      /// \param[in] _points The points, which must be finite.
+      /// \param[in] _count Number of points.
+      /// \param[in] _threads Maximum number of threads, each one building
+      /// the hull of a chunk of at least kMinPointsPerThread points. Zero
+      /// uses std::thread::hardware_concurrency.
+      /// \return False if the hull has no volume, such as for fewer than
+      /// four points or coplanar points, in which case it is empty.
+      public: bool Build(const Vector3<T> *_points, const std::size_t _count,
+                         const unsigned int _threads = 1)
+      {
+        const std::size_t chunks =
+            detail::ChunkCount(_count, _threads, kMinPointsPerThread);
+        if (chunks == 1)
+          return this->Quickhull(_points, _count);
+
+        // Hulls of the chunks, then the hull of their vertices. The points
+        // of a flat chunk are all kept.
+        std::vector<ConvexHull3<T>> parts(chunks);
+        std::vector<char> built(chunks);
+        detail::ParallelFor(_count, chunks,
+            [&](const std::size_t _c, const std::size_t _begin,
+                const std::size_t _end)
+        {
+          built[_c] = parts[_c].Quickhull(_points + _begin, _end - _begin);
+        });
+
+        const std::size_t chunk = (_count + chunks - 1) / chunks;
+        std::vector<Vector3<T>> candidates;
+        for (std::size_t c = 0; c < chunks; ++c)
+        {
+          if (built[c])
+          {
+            candidates.insert(candidates.end(), parts[c].vertices.begin(),
+                              parts[c].vertices.end());
+          }
+          else
+          {
+            const std::size_t begin = c * chunk;
+            candidates.insert(candidates.end(), _points + begin,
+                              _points + std::min(_count, begin + chunk));
+          }
+        }
+        return this->Quickhull(candidates.data(), candidates.size());
+      }
+
+      /// \brief Remove the hull.
+      public: void Clear()
+      {
+        this->vertices.clear();
+        this->indices.clear();
+        this->normals.clear();
+        this->offsets.clear();
+      }
+
+      /// \brief Get whether the hull is empty.
+      /// \return True if there is no hull.
+      public: bool Empty() const
+      {
+        return this->indices.empty();
+      }
+
+      /// \brief Get the vertices of the hull.
+      /// \return The vertices, a subset of the points.
+      public: const std::vector<Vector3<T>> &Vertices() const
+      {
+        return this->vertices;
+      }
+
+      /// \brief Get the triangles of the hull.
+      /// \return Three indices in Vertices() per triangle, counterclockwise
+      /// seen from outside.
+      public: const std::vector<unsigned int> &Indices() const
+      {
+        return this->indices;
+      }
+
+      /// \brief Get the number of triangles of the hull.
+      /// \return Number of triangles.
+      public: std::size_t TriangleCount() const
+      {
+        return this->indices.size() / 3;
+      }
+
+      /// \brief Get the volume of the hull.
+      /// \return Volume, zero if the hull is empty.
+      public: T Volume() const
+      {
+        T volume = 0;
+        for (std::size_t t = 0; t < this->indices.size(); t += 3)
+        {
+          volume += this->vertices[this->indices[t]].Dot(
+              this->vertices[this->indices[t + 1]].Cross(
+                this->vertices[this->indices[t + 2]]));
+        }
+        return volume / 6;
+      }
+
+      /// \brief Check whether a point is inside the hull.
+      /// \param[in] _point The point.
+      /// \param[in] _tolerance Largest distance above a face of the hull.
+      /// \return True if the point is inside or within _tolerance of the
+      /// hull. False if the hull is empty.
+      public: bool Contains(const Vector3<T> &_point,
+                            const T _tolerance = 0) const
+      {
+        for (std::size_t f = 0; f < this->normals.size(); ++f)
+        {
+          if (this->normals[f].Dot(_point) - this->offsets[f] > _tolerance)
+            return false;
+        }
+        return !this->Empty();
+      }
+
+      /// \brief Fit a box of small volume around the hull.
+      ///
+      /// A box of minimum volume has a face flush with a face of the hull
+      /// in most cases, and for each distinct normal of the faces of the
+      /// hull the smallest box with a face on that plane is found with
+      /// rotating calipers on the projection of the hull. The coordinate
+      /// axes are also tried, so the box is never larger than the axis
+      /// aligned one. This takes O(n^2 log n) time for a hull of n
+      /// vertices, which _maxDirections bounds by trying only the normals
+      /// of the largest faces.
+      /// \param[in] _maxDirections Largest number of face normals tried,
+      /// from the largest faces, or zero to try all of them.
+      /// \return The box, whose axes are right handed, or a default box if
+      /// the hull is empty.
+      public: OrientedBox<T> MinimumVolumeBox(
+                  const std::size_t _maxDirections = 0) const
+      {
+        if (this->Empty())
+          return OrientedBox<T>();
+
+        // Distinct face normals, from the largest faces
+        std::vector<std::pair<T, std::size_t>> areas;
+        for (std::size_t f = 0; f < this->normals.size(); ++f)
+        {
+          const Vector3<T> &a = this->vertices[this->indices[3 * f]];
+          const Vector3<T> &b = this->vertices[this->indices[3 * f + 1]];
+          const Vector3<T> &c = this->vertices[this->indices[3 * f + 2]];
+          areas.emplace_back(-(b - a).Cross(c - a).SquaredLength(), f);
+        }
+        std::sort(areas.begin(), areas.end());
+        std::vector<Vector3<T>> directions = {
+          Vector3<T>::UnitZ, Vector3<T>::UnitX, Vector3<T>::UnitY};
+        const std::size_t maxDirections = _maxDirections > 0 ?
+          _maxDirections + 3 : std::numeric_limits<std::size_t>::max();
+        const T parallel = 1 - std::sqrt(std::numeric_limits<T>::epsilon());
+        for (const auto &area : areas)
+        {
+          if (directions.size() >= maxDirections)
+            break;
+          const Vector3<T> &normal = this->normals[area.second];
+          bool distinct = true;
+          for (std::size_t d = 3; d < directions.size() && distinct; ++d)
+            distinct = std::abs(directions[d].Dot(normal)) < parallel;
+          if (distinct)
+            directions.push_back(normal);
+        }
+
+        OrientedBox<T> best;
+        T bestVolume = std::numeric_limits<T>::infinity();
+        std::vector<Vector2<T>> projected(this->vertices.size());
+        std::vector<Vector2<T>> polygon;
+        for (const Vector3<T> &normal : directions)
+        {
+          // Orthonormal basis u, v, normal
+          const Vector3<T> other =
+            std::abs(normal.X()) < std::abs(normal.Y()) ?
+            (std::abs(normal.X()) < std::abs(normal.Z()) ?
+             Vector3<T>::UnitX : Vector3<T>::UnitZ) :
+            (std::abs(normal.Y()) < std::abs(normal.Z()) ?
+             Vector3<T>::UnitY : Vector3<T>::UnitZ);
+          const Vector3<T> u = normal.Cross(other).Normalized();
+          const Vector3<T> v = normal.Cross(u);
+
+          T low = std::numeric_limits<T>::infinity();
+          T high = -low;
+          for (std::size_t i = 0; i < this->vertices.size(); ++i)
+          {
+            const Vector3<T> &p = this->vertices[i];
+            projected[i].Set(u.Dot(p), v.Dot(p));
+            const T h = normal.Dot(p);
+            low = std::min(low, h);
+            high = std::max(high, h);
+          }
+          ConvexPolygon(projected, polygon);
+
+          Rectangle rect;
+          if (!MinimumAreaRectangle(polygon, rect))
+            continue;
+          const T volume = rect.area * (high - low);
+          if (!(volume < bestVolume))
+            continue;
+          bestVolume = volume;
+
+          const Vector3<T> axis1 = u * rect.axis.X() + v * rect.axis.Y();
+          const Vector3<T> axis2 = u * -rect.axis.Y() + v * rect.axis.X();
+          const Vector2<T> center2 = rect.axis * rect.center.X() +
+            Vector2<T>(-rect.axis.Y(), rect.axis.X()) * rect.center.Y();
+          const Vector3<T> center = u * center2.X() + v * center2.Y() +
+            normal * ((low + high) / 2);
+          const Matrix3<T> rotation(
+              axis1.X(), axis2.X(), normal.X(),
+              axis1.Y(), axis2.Y(), normal.Y(),
+              axis1.Z(), axis2.Z(), normal.Z());
+          best = OrientedBox<T>(
+              Vector3<T>(rect.size.X(), rect.size.Y(), high - low),
+              Pose3<T>(center, Quaternion<T>(rotation)));
+        }
+        return best;
+      }
+
+      /// \brief A face being built by quickhull.
+      private: struct Face
+      {
+        /// \brief Vertices, as indices of the points, counterclockwise
+        /// seen from outside.
+        std::size_t v[3] = {0, 0, 0};
+
+        /// \brief Neighbor across the edge from v[i] to v[(i + 1) % 3].
+        std::size_t neighbors[3] = {0, 0, 0};
+
+        /// \brief Unit normal, pointing outside.
+        Vector3<T> normal;
+
+        /// \brief Distance of the plane of the face from the origin.
+        T offset = 0;
+
+        /// \brief Points above the face and no earlier face.
+        std::vector<std::size_t> outside;
+
+        /// \brief Whether the face is part of the hull.
+        bool alive = true;
+
+        /// \brief Whether the face was found visible from the current
+        /// point.
+        bool visible = false;
+      };
+
+      /// \brief An edge of the horizon, with the face behind it.
+      private: struct HorizonEdge
+      {
+        /// \brief First vertex, counterclockwise.
+        std::size_t a;
+
+        /// \brief Second vertex.
+        std::size_t b;
+
+        /// \brief Face which is not visible, across the edge.
+        std::size_t face;
+      };
+
+      /// \brief A rectangle enclosing a convex polygon.
+      private: struct Rectangle
+      {
+        /// \brief Unit vector of the first side.
+        Vector2<T> axis;
+
+        /// \brief Center, along axis and its perpendicular.
+        Vector2<T> center;
+
+        /// \brief Lengths of the sides.
+        Vector2<T> size;
+
+        /// \brief Area.
+        T area;
+      };
+
+      /// \brief Build the hull of a set of points with a single thread.
+      /// \param[in] _points The points.
+      /// \param[in] _count Number of points.
+      /// \return False if the hull has no volume.
+      private: bool Quickhull(const Vector3<T> *_points,
+                              const std::size_t _count)
+      {
+        this->Clear();
+        if (_count < 4)
+          return false;
+
+        // Tolerance from the magnitude of the coordinates, as in qhull
+        Vector3<T> maxAbs;
+        std::size_t extremes[6] = {0, 0, 0, 0, 0, 0};
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          maxAbs.Max(_points[i].Abs());
+          for (int a = 0; a < 3; ++a)
+          {
+            if (_points[i][a] < _points[extremes[2 * a]][a])
+              extremes[2 * a] = i;
+            if (_points[i][a] > _points[extremes[2 * a + 1]][a])
+              extremes[2 * a + 1] = i;
+          }
+        }
+        const T eps = 3 * std::numeric_limits<T>::epsilon() * maxAbs.Sum();
+
+        // Initial tetrahedron: the farthest extreme points, the point
+        // farthest from their line, and the point farthest from the plane
+        std::size_t i0 = 0;
+        std::size_t i1 = 0;
+        T best = 0;
+        for (std::size_t a = 0; a < 6; ++a)
+        {
+          for (std::size_t b = a + 1; b < 6; ++b)
+          {
+            const T d = (_points[extremes[a]] -
+                         _points[extremes[b]]).SquaredLength();
+            if (d > best)
+            {
+              best = d;
+              i0 = extremes[a];
+              i1 = extremes[b];
+            }
+          }
+        }
+        if (!(best > eps * eps))
+          return false;
+
+        const Vector3<T> dir = (_points[i1] - _points[i0]).Normalized();
+        std::size_t i2 = 0;
+        best = 0;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const T d = (_points[i] - _points[i0]).Cross(dir).SquaredLength();
+          if (d > best)
+          {
+            best = d;
+            i2 = i;
+          }
+        }
+        if (!(best > eps * eps))
+          return false;
+
+        const Vector3<T> baseNormal = (_points[i1] - _points[i0]).Cross(
+            _points[i2] - _points[i0]).Normalized();
+        std::size_t i3 = 0;
+        best = 0;
+        T side = 0;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const T d = baseNormal.Dot(_points[i] - _points[i0]);
+          if (std::abs(d) > best)
+          {
+            best = std::abs(d);
+            side = d;
+            i3 = i;
+          }
+        }
+        if (!(best > eps))
+          return false;
+        if (side > 0)
+          std::swap(i1, i2);
+
+        // The fourth point is below the base, whose edges are shared with
+        // the other faces in reverse.
+        std::vector<Face> faces;
+        this->AddFace(faces, _points, i0, i1, i2);
+        this->AddFace(faces, _points, i1, i0, i3);
+        this->AddFace(faces, _points, i2, i1, i3);
+        this->AddFace(faces, _points, i0, i2, i3);
+        const std::size_t tetraNeighbors[4][3] = {
+          {1, 2, 3}, {0, 3, 2}, {0, 1, 3}, {0, 2, 1}};
+        for (std::size_t f = 0; f < 4; ++f)
+        {
+          for (int e = 0; e < 3; ++e)
+            faces[f].neighbors[e] = tetraNeighbors[f][e];
+        }
+
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          if (i == i0 || i == i1 || i == i2 || i == i3)
+            continue;
+          this->AssignOutside(faces, _points, 0, faces.size(), i, eps);
+        }
+
+        std::vector<HorizonEdge> horizon;
+        std::vector<std::size_t> visible;
+        for (std::size_t f = 0; f < faces.size(); ++f)
+        {
+          if (!faces[f].alive || faces[f].outside.empty())
+            continue;
+          this->AddPoint(faces, _points, f, eps, horizon, visible);
+        }
+
+        // Keep the vertices of the faces which are left
+        std::vector<unsigned int> remap(_count,
+            std::numeric_limits<unsigned int>::max());
+        for (const Face &face : faces)
+        {
+          if (!face.alive)
+            continue;
+          for (int k = 0; k < 3; ++k)
+          {
+            unsigned int &index = remap[face.v[k]];
+            if (index == std::numeric_limits<unsigned int>::max())
+            {
+              index = static_cast<unsigned int>(this->vertices.size());
+              this->vertices.push_back(_points[face.v[k]]);
+            }
+            this->indices.push_back(index);
+          }
+          this->normals.push_back(face.normal);
+          this->offsets.push_back(face.offset);
+        }
+        return true;
+      }
+
+      /// \brief Add a face, without its neighbors.
+      /// \param[in,out] _faces The faces.
+      /// \param[in] _points The points.
+      /// \param[in] _a First vertex.
+      /// \param[in] _b Second vertex.
+      /// \param[in] _c Third vertex.
+      private: static void AddFace(std::vector<Face> &_faces,
+                                   const Vector3<T> *_points,
+                                   const std::size_t _a, const std::size_t _b,
+                                   const std::size_t _c)
+      {
+        Face face;
+        face.v[0] = _a;
+        face.v[1] = _b;
+        face.v[2] = _c;
+        face.normal = (_points[_b] - _points[_a]).Cross(
+            _points[_c] - _points[_a]).Normalized();
+        face.offset = face.normal.Dot(_points[_a]);
+        _faces.push_back(std::move(face));
+      }
+
+      /// \brief Give a point to the first face it is above.
+      /// \param[in,out] _faces The faces.
+      /// \param[in] _points The points.
+      /// \param[in] _begin First face to test.
+      /// \param[in] _end End of the faces to test.
+      /// \param[in] _point Index of the point.
+      /// \param[in] _eps Distance above which a point is above a face.
+      private: static void AssignOutside(std::vector<Face> &_faces,
+                                         const Vector3<T> *_points,
+                                         const std::size_t _begin,
+                                         const std::size_t _end,
+                                         const std::size_t _point,
+                                         const T _eps)
+      {
+        for (std::size_t f = _begin; f < _end; ++f)
+        {
+          Face &face = _faces[f];
+          if (face.normal.Dot(_points[_point]) - face.offset > _eps)
+          {
+            face.outside.push_back(_point);
+            return;
+          }
+        }
+      }
+
+      /// \brief Add the farthest point above a face to the hull.
+      /// \param[in,out] _faces The faces.
+      /// \param[in] _points The points.
+      /// \param[in] _face Index of the face.
+      /// \param[in] _eps Distance above which a point is above a face.
+      /// \param[in,out] _horizon Buffer for the horizon.
+      /// \param[in,out] _visible Buffer for the visible faces.
+      private: static void AddPoint(std::vector<Face> &_faces,
+                                    const Vector3<T> *_points,
+                                    const std::size_t _face, const T _eps,
+                                    std::vector<HorizonEdge> &_horizon,
+                                    std::vector<std::size_t> &_visible)
+      {
+        std::size_t eye = _faces[_face].outside[0];
+        T farthest = -std::numeric_limits<T>::infinity();
+        for (const std::size_t i : _faces[_face].outside)
+        {
+          const T d = _faces[_face].normal.Dot(_points[i]);
+          if (d > farthest)
+          {
+            farthest = d;
+            eye = i;
+          }
+        }
+        const Vector3<T> &p = _points[eye];
+
+        // Depth first search of the faces visible from the eye. Crossing
+        // the edges of each face in counterclockwise order, starting after
+        // the edge it was entered by, gives the horizon in order.
+        _horizon.clear();
+        _visible.assign(1, _face);
+        _faces[_face].visible = true;
+        struct Frame
+        {
+          std::size_t face;
+          int edge;
+          int left;
+        };
+        std::vector<Frame> stack = {{_face, 0, 3}};
+        while (!stack.empty())
+        {
+          Frame &frame = stack.back();
+          if (frame.left == 0)
+          {
+            stack.pop_back();
+            continue;
+          }
+          const std::size_t f = frame.face;
+          const int e = frame.edge;
+          frame.edge = (frame.edge + 1) % 3;
+          frame.left--;
+
+          const std::size_t n = _faces[f].neighbors[e];
+          Face &neighbor = _faces[n];
+          if (neighbor.visible)
+            continue;
+          if (neighbor.normal.Dot(p) - neighbor.offset > _eps)
+          {
+            neighbor.visible = true;
+            _visible.push_back(n);
+            int entry = 0;
+            while (neighbor.neighbors[entry] != f)
+              ++entry;
+            stack.push_back({n, (entry + 1) % 3, 2});
+          }
+          else
+          {
+            _horizon.push_back(
+                {_faces[f].v[e], _faces[f].v[(e + 1) % 3], n});
+          }
+        }
+
+        // A cone of faces from the horizon to the eye
+        const std::size_t first = _faces.size();
+        const std::size_t count = _horizon.size();
+        for (std::size_t h = 0; h < count; ++h)
+        {
+          const HorizonEdge &edge = _horizon[h];
+          AddFace(_faces, _points, edge.a, edge.b, eye);
+          Face &face = _faces.back();
+          face.neighbors[0] = edge.face;
+          face.neighbors[1] = first + (h + 1) % count;
+          face.neighbors[2] = first + (h + count - 1) % count;
+
+          Face &behind = _faces[edge.face];
+          for (int k = 0; k < 3; ++k)
+          {
+            if (behind.v[k] == edge.b && behind.v[(k + 1) % 3] == edge.a)
+              behind.neighbors[k] = first + h;
+          }
+        }
+
+        // Points above the removed faces go to the new ones
+        for (const std::size_t f : _visible)
+        {
+          std::vector<std::size_t> outside;
+          outside.swap(_faces[f].outside);
+          for (const std::size_t i : outside)
+          {
+            if (i != eye)
+              AssignOutside(_faces, _points, first, _faces.size(), i, _eps);
+          }
+          _faces[f].alive = false;
+          _faces[f].visible = false;
+        }
+      }
+
+      /// \brief Get the convex polygon of a set of 2D points, with Andrew's
+      /// monotone chain.
+      /// \param[in] _points The points.
+      /// \param[out] _polygon Vertices of the polygon, counterclockwise,
+      /// without collinear or coincident vertices up to rounding, which
+      /// would mislead the rotating calipers.
+      private: static void ConvexPolygon(std::vector<Vector2<T>> _points,
+                                         std::vector<Vector2<T>> &_polygon)
+      {
+        std::sort(_points.begin(), _points.end(),
+            [](const Vector2<T> &_a, const Vector2<T> &_b)
+            {
+              return std::make_pair(_a.X(), _a.Y()) <
+                     std::make_pair(_b.X(), _b.Y());
+            });
+        T extent = 0;
+        if (!_points.empty())
+        {
+          const T low = std::min_element(_points.begin(), _points.end(),
+              [](const Vector2<T> &_a, const Vector2<T> &_b)
+              {
+                return _a.Y() < _b.Y();
+              })->Y();
+          const T high = std::max_element(_points.begin(), _points.end(),
+              [](const Vector2<T> &_a, const Vector2<T> &_b)
+              {
+                return _a.Y() < _b.Y();
+              })->Y();
+          extent = std::max(_points.back().X() - _points.front().X(),
+                            high - low);
+        }
+        const T tolerance =
+          16 * std::numeric_limits<T>::epsilon() * extent * extent;
+        auto turnsLeft = [tolerance](const Vector2<T> &_o,
+                                     const Vector2<T> &_a,
+                                     const Vector2<T> &_b)
+        {
+          return (_a.X() - _o.X()) * (_b.Y() - _o.Y()) -
+                 (_a.Y() - _o.Y()) * (_b.X() - _o.X()) > tolerance;
+        };
+
+        _polygon.assign(2 * _points.size(), Vector2<T>());
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < _points.size(); ++i)
+        {
+          while (k >= 2 && !turnsLeft(_polygon[k - 2], _polygon[k - 1],
+                                      _points[i]))
+          {
+            --k;
+          }
+          _polygon[k++] = _points[i];
+        }
+        const std::size_t lower = k + 1;
+        for (std::size_t i = _points.size() - 1; i-- > 0;)
+        {
+          while (k >= lower && !turnsLeft(_polygon[k - 2], _polygon[k - 1],
+                                          _points[i]))
+          {
+            --k;
+          }
+          _polygon[k++] = _points[i];
+        }
+        _polygon.resize(k > 1 ? k - 1 : k);
+      }
+
+      /// \brief Find the rectangle of smallest area enclosing a convex
+      /// polygon with rotating calipers. One of its sides is on an edge of
+      /// the polygon.
+      /// \param[in] _polygon The polygon, counterclockwise.
+      /// \param[out] _rect The rectangle.
+      /// \return False if the polygon has fewer than three vertices.
+      private: static bool MinimumAreaRectangle(
+                   const std::vector<Vector2<T>> &_polygon, Rectangle &_rect)
+      {
+        const std::size_t m = _polygon.size();
+        if (m < 3)
+          return false;
+        auto at = [&](const std::size_t _i) -> const Vector2<T> &
+        {
+          return _polygon[_i % m];
+        };
+
+        // Vertices farthest along the edge, its left normal, and against
+        // the edge. They only move forward as the edge turns.
+        std::size_t right = 1;
+        std::size_t top = 1;
+        std::size_t left = 1;
+        _rect.area = std::numeric_limits<T>::infinity();
+        for (std::size_t i = 0; i < m; ++i)
+        {
+          const Vector2<T> axis = (at(i + 1) - at(i)).Normalized();
+          const Vector2<T> normal(-axis.Y(), axis.X());
+          right = std::max(right, i + 1);
+          while (right < i + m && (at(right + 1) - at(right)).Dot(axis) > 0)
+            ++right;
+          top = std::max(top, right);
+          while (top < i + m && (at(top + 1) - at(top)).Dot(normal) > 0)
+            ++top;
+          left = std::max(left, top);
+          while (left < i + m && (at(left + 1) - at(left)).Dot(axis) < 0)
+            ++left;
+
+          const T minAxis = at(left).Dot(axis);
+          const T maxAxis = at(right).Dot(axis);
+          const T minNormal = at(i).Dot(normal);
+          const T maxNormal = at(top).Dot(normal);
+          const T area = (maxAxis - minAxis) * (maxNormal - minNormal);
+          if (area < _rect.area)
+          {
+            _rect.area = area;
+            _rect.axis = axis;
+            _rect.center.Set((minAxis + maxAxis) / 2,
+                             (minNormal + maxNormal) / 2);
+            _rect.size.Set(maxAxis - minAxis, maxNormal - minNormal);
+          }
+        }
+        return true;
+      }
+
+      /// \brief Vertices of the hull.
+      private: std::vector<Vector3<T>> vertices;
+
+      /// \brief Three vertex indices per triangle.
+      private: std::vector<unsigned int> indices;
+
+      /// \brief Unit normal of each triangle.
+      private: std::vector<Vector3<T>> normals;
+
+      /// \brief Distance of the plane of each triangle from the origin.
+      private: std::vector<T> offsets;
+    };
+
+    using ConvexHull3d = ConvexHull3<double>;
+    using ConvexHull3f = ConvexHull3<float>;
+    }
+  }
+}
+#endif
@@ -126,10 +126,19 @@ namespace gz
                       double _leftWheelRadius,
                       double _rightWheelRadius);
 
-      /// \brief Set the velocity rolling window size.
+      /// \brief Set the velocity rolling window size. This doesn't
+      /// allocate if _size is not greater than the capacity set with
+      /// ReserveVelocityRollingWindow.
       /// \param[in] _size The Velocity rolling window size.
       public: void SetVelocityRollingWindowSize(size_t _size);
 
+      /// \brief Allocate room for velocity rolling windows of up to
+      /// _capacity values. Update() never allocates, and after this call
+      /// neither does SetVelocityRollingWindowSize() for sizes up to
+      /// _capacity, so both can be called from a real-time thread.
+      /// \param[in] _capacity The largest window size to make room for.
+      public: void ReserveVelocityRollingWindow(size_t _capacity);
+
       /// \brief Private data pointer.
       GZ_UTILS_IMPL_PTR(dataPtr)
     };
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_DIFFDRIVEODOMETRYBANK_HH_
+#define GZ_MATH_DIFFDRIVEODOMETRYBANK_HH_
+
+#include <cstddef>
+#include <vector>
+#include <gz/math/DiffDriveOdometry.hh>
+#include <gz/math/Export.hh>
+#include <gz/math/config.hh>
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    /** \class DiffDriveOdometryBank DiffDriveOdometryBank.hh \
+     * gz/math/DiffDriveOdometryBank.hh
+     **/
+    /// \brief Odometry of many diff-drive vehicles, or robots, updated
+    /// together, such as a fleet simulated in one process.
+    ///
+    /// Each robot follows DiffDriveOdometry. The wheel parameters and the
+    /// state of the robots are stored in arrays, and an update advances all
+    /// of them from arrays of wheel positions, in loops the compiler can
+    /// vectorize except for the evaluation of the sines and cosines.
+    ///
+    /// The pose is integrated with the exact arc formula written as
+    /// \f$\Delta x = d \cos(\theta + \omega / 2)
+    /// \frac{\sin(\omega / 2)}{\omega / 2}\f$, and likewise for y, which
+    /// needs no branch between the arc and the straight line.
+    ///
+    /// The velocities are averaged over a rolling window, as with
+    /// RollingMean. The windows of all the robots share their size and
+    /// position, since all the robots are updated at the same time, and
+    /// are stored in ring buffers allocated when the window size or the
+    /// number of robots changes. Their sums are updated as values enter and
+    /// leave, and recomputed each time the window wraps around so that
+    /// rounding errors don't accumulate.
+    ///
+    /// **Example Usage**
+    ///
+    /// \code{.cpp}
+    /// gz::math::DiffDriveOdometryBank fleet;
+    /// for (int i = 0; i < 2000; ++i)
+    ///   fleet.Add(2.0, 0.5, 0.5);
+    /// fleet.Init(std::chrono::steady_clock::now());
+    ///
+    /// // ... Some time later, with one wheel position per robot
+    /// fleet.Update(leftPositions.data(), rightPositions.data(),
+    ///     std::chrono::steady_clock::now());
+    /// double x = fleet.X()[42];
+    /// \endcode
+    class GZ_MATH_VISIBLE DiffDriveOdometryBank
+    {
+      /// \brief Constructor, with no robots.
+      /// \param[in] _windowSize Rolling window size used to compute the
+      /// velocity mean
+      public: explicit DiffDriveOdometryBank(size_t _windowSize = 10);
+
+      /// \brief Add a robot, at the origin and with no velocity. If the
+      /// other robots were already updated, the velocity window of the new
+      /// robot starts filled with zeros.
+      /// \param[in] _wheelSeparation Distance between left and right wheels.
+      /// \param[in] _leftWheelRadius Radius of the left wheel.
+      /// \param[in] _rightWheelRadius Radius of the right wheel.
+      /// \return Index of the robot.
+      public: size_t Add(double _wheelSeparation, double _leftWheelRadius,
+                         double _rightWheelRadius);
+
+      /// \brief Set the wheel parameters of a robot.
+      /// \param[in] _index Index of the robot, less than Size().
+      /// \param[in] _wheelSeparation Distance between left and right wheels.
+      /// \param[in] _leftWheelRadius Radius of the left wheel.
+      /// \param[in] _rightWheelRadius Radius of the right wheel.
+      /// \return False if _index is out of range.
+      public: bool SetWheelParams(size_t _index, double _wheelSeparation,
+                                  double _leftWheelRadius,
+                                  double _rightWheelRadius);
+
+      /// \brief Get the number of robots.
+      /// \return The number of robots.
+      public: size_t Size() const;
+
+      /// \brief Remove all the robots.
+      public: void Clear();
+
+      /// \brief Set the velocity rolling window size. This clears the
+      /// windows of all the robots.
+      /// \param[in] _size The velocity rolling window size. Zero is
+      /// ignored.
+      public: void SetVelocityRollingWindowSize(size_t _size);
+
+      /// \brief Initialize the odometry of all the robots, moving them back
+      /// to the origin.
+      /// \param[in] _time Current time.
+      public: void Init(const clock::time_point &_time);
+
+      /// \brief Get whether Init has been called.
+      /// \return True if Init has been called, false otherwise.
+      public: bool Initialized() const;
+
+      /// \brief Update the odometry of all the robots with their latest
+      /// wheel positions.
+      /// \param[in] _leftPos Left wheel position of each robot in radians,
+      /// Size() values.
+      /// \param[in] _rightPos Right wheel position of each robot in radians,
+      /// Size() values.
+      /// \param[in] _time Current time point.
+      /// \return True if the velocities are updated, false if no time
+      /// passed since the last update, in which case only the poses are.
+      /// \sa DiffDriveOdometry::Update
+      public: bool Update(const double *_leftPos, const double *_rightPos,
+                          const clock::time_point &_time);
+
+      /// \brief Get the headings of the robots.
+      /// \return The headings in radians, which are not normalized.
+      public: const std::vector<double> &Heading() const;
+
+      /// \brief Get the X positions of the robots.
+      /// \return The X positions in meters.
+      public: const std::vector<double> &X() const;
+
+      /// \brief Get the Y positions of the robots.
+      /// \return The Y positions in meters.
+      public: const std::vector<double> &Y() const;
+
+      /// \brief Get the linear velocities of the robots.
+      /// \return The linear velocities in meter/second.
+      public: const std::vector<double> &LinearVelocity() const;
+
+      /// \brief Get the angular velocities of the robots.
+      /// \return The angular velocities in radian/second.
+      public: const std::vector<double> &AngularVelocity() const;
+
+      /// \brief Private data pointer.
+      GZ_UTILS_IMPL_PTR(dataPtr)
+    };
+    }
+  }
+}
+#endif
@@ -17,6 +17,9 @@
 #ifndef GZ_MATH_FILTER_HH_
 #define GZ_MATH_FILTER_HH_
 
+#include <algorithm>
+#include <cstddef>
+#include <vector>
 #include <gz/math/Helpers.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/math/Quaternion.hh>
@@ -245,6 +248,453 @@ namespace gz
         this->Set(math::Vector3d(0, 0, 0));
       }
     };
+
+    /// \class OnePoleBank Filter.hh gz/math/Filter.hh
+    /// \brief One-pole filters of many channels, such as the axes of
+    /// many sensors, processed together.
+    ///
+    /// Each channel behaves as a OnePole with its own cutoff frequency. The
+    /// coefficients and outputs of the channels are stored in arrays, and
+    /// Process filters a block of frames, which are samples of all the
+    /// channels, in loops across kBlockSize channels with no virtual calls,
+    /// which the compiler vectorizes.
+    /// \tparam T Scalar type of the samples, float or double.
+    template <typename T>
+    class OnePoleBank
+    {
+      /// \brief Number of channels filtered together in the loops.
+      public: static constexpr std::size_t kBlockSize = 8;
+
+      /// \brief Constructor, with no channels.
+      public: OnePoleBank() = default;
+
+      /// \brief Constructor, with all the channels as a default OnePole.
+      /// \param[in] _channels Number of channels.
+      public: explicit OnePoleBank(std::size_t _channels)
+      {
+        this->Resize(_channels);
+      }
+
+      /// \brief Set the number of channels. The new channels are as a
+      /// default OnePole.
+      /// \param[in] _channels Number of channels.
+      public: void Resize(std::size_t _channels)
+      {
+        const std::size_t padded =
+          (_channels + kBlockSize - 1) / kBlockSize * kBlockSize;
+        this->a0.resize(padded, T(0));
+        this->b1.resize(padded, T(0));
+        this->y0.resize(padded, T(0));
+        this->channels = _channels;
+      }
+
+      /// \brief Get the number of channels.
+      /// \return The number of channels.
+      public: std::size_t Channels() const
+      {
+        return this->channels;
+      }
+
+      /// \brief Set the cutoff frequency and sample rate of all the
+      /// channels.
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      public: void Fc(double _fc, double _fs)
+      {
+        for (std::size_t c = 0; c < this->channels; ++c)
+          this->Fc(c, _fc, _fs);
+      }
+
+      /// \brief Set the cutoff frequency and sample rate of a channel.
+      /// \param[in] _channel Index of the channel, less than Channels().
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      /// \sa OnePole::Fc
+      public: void Fc(std::size_t _channel, double _fc, double _fs)
+      {
+        const double b = exp(-2.0 * GZ_PI * _fc / _fs);
+        this->b1[_channel] = static_cast<T>(b);
+        this->a0[_channel] = static_cast<T>(1.0 - b);
+      }
+
+      /// \brief Set the output of all the channels.
+      /// \param[in] _val New value.
+      public: void Set(const T &_val)
+      {
+        std::fill(this->y0.begin(), this->y0.end(), _val);
+      }
+
+      /// \brief Set the output of a channel.
+      /// \param[in] _channel Index of the channel, less than Channels().
+      /// \param[in] _val New value.
+      public: void Set(std::size_t _channel, const T &_val)
+      {
+        this->y0[_channel] = _val;
+      }
+
+      /// \brief Get the output of a channel.
+      /// \param[in] _channel Index of the channel, less than Channels().
+      /// \return The channel's output.
+      public: const T &Value(std::size_t _channel) const
+      {
+        return this->y0[_channel];
+      }
+
+      /// \brief Filter a block of frames.
+      /// \param[in] _in Input, _frames frames of Channels() samples, with
+      /// the samples of each frame contiguous.
+      /// \param[out] _out Output, in the same layout as _in. It may be
+      /// _in.
+      /// \param[in] _frames Number of frames.
+      public: void Process(const T *_in, T *_out, std::size_t _frames)
+      {
+        for (std::size_t c = 0; c < this->channels; c += kBlockSize)
+        {
+          const std::size_t n = std::min(kBlockSize, this->channels - c);
+          const T *a = this->a0.data() + c;
+          const T *b = this->b1.data() + c;
+          T y[kBlockSize];
+          std::copy(this->y0.begin() + c, this->y0.begin() + c + kBlockSize,
+                    y);
+          if (n == kBlockSize)
+          {
+            for (std::size_t f = 0; f < _frames; ++f)
+            {
+              const std::size_t offset = f * this->channels + c;
+              for (std::size_t i = 0; i < kBlockSize; ++i)
+                y[i] = a[i] * _in[offset + i] + b[i] * y[i];
+              std::copy_n(y, kBlockSize, _out + offset);
+            }
+          }
+          else
+          {
+            // The last channels are copied to a full block.
+            T x[kBlockSize] = {};
+            for (std::size_t f = 0; f < _frames; ++f)
+            {
+              const std::size_t offset = f * this->channels + c;
+              std::copy(_in + offset, _in + offset + n, x);
+              for (std::size_t i = 0; i < kBlockSize; ++i)
+                y[i] = a[i] * x[i] + b[i] * y[i];
+              std::copy(y, y + n, _out + offset);
+            }
+          }
+          std::copy(y, y + kBlockSize, this->y0.begin() + c);
+        }
+      }
+
+      /// \brief Input gains, padded to a multiple of kBlockSize.
+      private: std::vector<T> a0;
+
+      /// \brief Gains of the feedback, padded to a multiple of kBlockSize.
+      private: std::vector<T> b1;
+
+      /// \brief Outputs, padded to a multiple of kBlockSize.
+      private: std::vector<T> y0;
+
+      /// \brief Number of channels.
+      private: std::size_t channels = 0;
+    };
+
+    /// \class BiQuadBank Filter.hh gz/math/Filter.hh
+    /// \brief Cascades of bi-quad filters of many channels processed
+    /// together.
+    ///
+    /// Each channel runs its input through a number of sections, each of
+    /// which behaves as a BiQuad with its own coefficients, so that for
+    /// instance two sections with suitable Q coefficients make a fourth
+    /// order Butterworth filter. The coefficients and states of the
+    /// sections are stored in arrays, and Process filters a block of
+    /// frames in loops across kBlockSize channels with no virtual calls,
+    /// which the compiler vectorizes.
+    /// \tparam T Scalar type of the samples, float or double.
+    template <typename T>
+    class BiQuadBank
+    {
+      /// \brief Number of channels filtered together in the loops.
+      public: static constexpr std::size_t kBlockSize = 8;
+
+      /// \brief Constructor, with no channels.
+      public: BiQuadBank() = default;
+
+      /// \brief Constructor, with all the states zero and all the
+      /// coefficients zero as in a default BiQuad.
+      /// \param[in] _channels Number of channels.
+      /// \param[in] _sections Number of sections of each channel.
+      public: explicit BiQuadBank(std::size_t _channels,
+                                  std::size_t _sections = 1)
+      {
+        this->Resize(_channels, _sections);
+      }
+
+      /// \brief Set the number of channels and sections, which resets all
+      /// the coefficients and states to zero.
+      /// \param[in] _channels Number of channels.
+      /// \param[in] _sections Number of sections of each channel.
+      public: void Resize(std::size_t _channels, std::size_t _sections = 1)
+      {
+        this->channels = _channels;
+        this->sections = _sections;
+        this->stride =
+          (_channels + kBlockSize - 1) / kBlockSize * kBlockSize;
+        for (std::vector<T> *values : {&this->a0, &this->a1, &this->a2,
+             &this->b1, &this->b2, &this->x1, &this->x2, &this->y1,
+             &this->y2})
+        {
+          values->assign(this->stride * _sections, T(0));
+        }
+        this->y0.assign(this->stride, T(0));
+      }
+
+      /// \brief Get the number of channels.
+      /// \return The number of channels.
+      public: std::size_t Channels() const
+      {
+        return this->channels;
+      }
+
+      /// \brief Get the number of sections of each channel.
+      /// \return The number of sections.
+      public: std::size_t Sections() const
+      {
+        return this->sections;
+      }
+
+      /// \brief Set the cutoff frequency, sample rate and Q coefficient
+      /// of all the sections of all the channels.
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      /// \param[in] _q Q coefficient.
+      public: void Fc(double _fc, double _fs, double _q = 0.5)
+      {
+        for (std::size_t s = 0; s < this->sections; ++s)
+        {
+          for (std::size_t c = 0; c < this->channels; ++c)
+            this->Fc(c, s, _fc, _fs, _q);
+        }
+      }
+
+      /// \brief Set the cutoff frequency, sample rate and Q coefficient
+      /// of a section of a channel.
+      /// \param[in] _channel Index of the channel, less than Channels().
+      /// \param[in] _section Index of the section, less than Sections().
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      /// \param[in] _q Q coefficient.
+      /// \sa BiQuad::Fc
+      public: void Fc(std::size_t _channel, std::size_t _section,
+                      double _fc, double _fs, double _q)
+      {
+        const double k = tan(GZ_PI * _fc / _fs);
+        const double kQuadDenom = k * k + k / _q + 1.0;
+        const double a = k * k / kQuadDenom;
+        this->Coefficients(_channel, _section, a, 2 * a, a,
+                           2 * (k * k - 1.0) / kQuadDenom,
+                           (k * k - k / _q + 1.0) / kQuadDenom);
+      }
+
+      /// \brief Set the coefficients of a section of a channel, whose
+      /// output is
+      /// \f$y_0 = a_0 x_0 + a_1 x_1 + a_2 x_2 - b_1 y_1 - b_2 y_2\f$.
+      /// \param[in] _channel Index of the channel, less than Channels().
+      /// \param[in] _section Index of the section, less than Sections().
+      /// \param[in] _a0 Gain of the input.
+      /// \param[in] _a1 Gain of the previous input.
+      /// \param[in] _a2 Gain of the input before the previous one.
+      /// \param[in] _b1 Gain of the previous output.
+      /// \param[in] _b2 Gain of the output before the previous one.
+      public: void Coefficients(std::size_t _channel, std::size_t _section,
+                                double _a0, double _a1, double _a2,
+                                double _b1, double _b2)
+      {
+        const std::size_t index = _section * this->stride + _channel;
+        this->a0[index] = static_cast<T>(_a0);
+        this->a1[index] = static_cast<T>(_a1);
+        this->a2[index] = static_cast<T>(_a2);
+        this->b1[index] = static_cast<T>(_b1);
+        this->b2[index] = static_cast<T>(_b2);
+      }
+
+      /// \brief Set the output and all the states of all the channels, as
+      /// if the filters had been at rest with this value for a long time
+      /// and their gains were one.
+      /// \param[in] _val New value.
+      public: void Set(const T &_val)
+      {
+        for (std::size_t c = 0; c < this->channels; ++c)
+          this->Set(c, _val);
+      }
+
+      /// \brief Set the output and all the states of a channel.
+      /// \param[in] _channel Index of the channel, less than Channels().
+      /// \param[in] _val New value.
+      /// \sa BiQuad::Set
+      public: void Set(std::size_t _channel, const T &_val)
+      {
+        for (std::size_t s = 0; s < this->sections; ++s)
+        {
+          const std::size_t index = s * this->stride + _channel;
+          this->x1[index] = this->x2[index] = _val;
+          this->y1[index] = this->y2[index] = _val;
+        }
+        this->y0[_channel] = _val;
+      }
+
+      /// \brief Get the output of a channel, which is the output of its
+      /// last section.
+      /// \param[in] _channel Index of the channel, less than Channels().
+      /// \return The channel's output.
+      public: const T &Value(std::size_t _channel) const
+      {
+        return this->y0[_channel];
+      }
+
+      /// \brief Filter a block of frames.
+      /// \param[in] _in Input, _frames frames of Channels() samples, with
+      /// the samples of each frame contiguous.
+      /// \param[out] _out Output, in the same layout as _in. It may be
+      /// _in.
+      /// \param[in] _frames Number of frames.
+      public: void Process(const T *_in, T *_out, std::size_t _frames)
+      {
+        if (_frames == 0)
+          return;
+
+        // With no sections the filters pass their input through.
+        if (this->sections == 0)
+        {
+          std::copy(_in, _in + _frames * this->channels, _out);
+          return;
+        }
+
+        // Each section filters the whole block in turn, the following
+        // ones in place in _out.
+        for (std::size_t s = 0; s < this->sections; ++s)
+        {
+          const T *in = s == 0 ? _in : _out;
+          for (std::size_t c = 0; c < this->channels; c += kBlockSize)
+            this->ProcessBlock(s * this->stride + c, c, in, _out, _frames);
+        }
+
+        for (std::size_t c = 0; c < this->channels; ++c)
+        {
+          this->y0[c] =
+            this->y1[(this->sections - 1) * this->stride + c];
+        }
+      }
+
+      /// \brief Filter kBlockSize channels of a section.
+      /// \param[in] _index Index of the first channel of the section in
+      /// the coefficient and state arrays.
+      /// \param[in] _channel Index of the first channel.
+      /// \param[in] _in Input.
+      /// \param[out] _out Output, which may be _in.
+      /// \param[in] _frames Number of frames.
+      private: void ProcessBlock(std::size_t _index, std::size_t _channel,
+                                 const T *_in, T *_out, std::size_t _frames)
+      {
+        const std::size_t n = std::min(kBlockSize, this->channels - _channel);
+        const T *a0s = this->a0.data() + _index;
+        const T *a1s = this->a1.data() + _index;
+        const T *a2s = this->a2.data() + _index;
+        const T *b1s = this->b1.data() + _index;
+        const T *b2s = this->b2.data() + _index;
+
+        // The states are kept in local arrays, which the compiler knows
+        // don't overlap the input and the output.
+        T x1s[kBlockSize];
+        T x2s[kBlockSize];
+        T y1s[kBlockSize];
+        T y2s[kBlockSize];
+        std::copy_n(this->x1.begin() + _index, kBlockSize, x1s);
+        std::copy_n(this->x2.begin() + _index, kBlockSize, x2s);
+        std::copy_n(this->y1.begin() + _index, kBlockSize, y1s);
+        std::copy_n(this->y2.begin() + _index, kBlockSize, y2s);
+
+        auto step = [&](const T *_x)
+        {
+          for (std::size_t i = 0; i < kBlockSize; ++i)
+          {
+            const T y = a0s[i] * _x[i] +
+                        a1s[i] * x1s[i] +
+                        a2s[i] * x2s[i] -
+                        b1s[i] * y1s[i] -
+                        b2s[i] * y2s[i];
+            x2s[i] = x1s[i];
+            x1s[i] = _x[i];
+            y2s[i] = y1s[i];
+            y1s[i] = y;
+          }
+        };
+
+        if (n == kBlockSize)
+        {
+          for (std::size_t f = 0; f < _frames; ++f)
+          {
+            const std::size_t offset = f * this->channels + _channel;
+            step(_in + offset);
+            std::copy_n(y1s, kBlockSize, _out + offset);
+          }
+        }
+        else
+        {
+          // The last channels are copied to a full block.
+          T x[kBlockSize] = {};
+          for (std::size_t f = 0; f < _frames; ++f)
+          {
+            const std::size_t offset = f * this->channels + _channel;
+            std::copy(_in + offset, _in + offset + n, x);
+            step(x);
+            std::copy(y1s, y1s + n, _out + offset);
+          }
+        }
+
+        std::copy_n(x1s, kBlockSize, this->x1.begin() + _index);
+        std::copy_n(x2s, kBlockSize, this->x2.begin() + _index);
+        std::copy_n(y1s, kBlockSize, this->y1.begin() + _index);
+        std::copy_n(y2s, kBlockSize, this->y2.begin() + _index);
+      }
+
+      /// \brief Gains of the inputs, one row of Channels() padded to a
+      /// multiple of kBlockSize per section.
+      private: std::vector<T> a0;
+
+      /// \brief Gains of the previous inputs.
+      private: std::vector<T> a1;
+
+      /// \brief Gains of the inputs before the previous ones.
+      private: std::vector<T> a2;
+
+      /// \brief Gains of the previous outputs.
+      private: std::vector<T> b1;
+
+      /// \brief Gains of the outputs before the previous ones.
+      private: std::vector<T> b2;
+
+      /// \brief Previous inputs.
+      private: std::vector<T> x1;
+
+      /// \brief Inputs before the previous ones.
+      private: std::vector<T> x2;
+
+      /// \brief Previous outputs.
+      private: std::vector<T> y1;
+
+      /// \brief Outputs before the previous ones.
+      private: std::vector<T> y2;
+
+      /// \brief Outputs of the last sections.
+      private: std::vector<T> y0;
+
+      /// \brief Number of channels.
+      private: std::size_t channels = 0;
+
+      /// \brief Number of sections.
+      private: std::size_t sections = 0;
+
+      /// \brief Size of the rows of the coefficient and state arrays.
+      private: std::size_t stride = 0;
+    };
     }
   }
 }
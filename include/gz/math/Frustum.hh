@@ -17,8 +17,13 @@
 #ifndef GZ_MATH_FRUSTUM_HH_
 #define GZ_MATH_FRUSTUM_HH_
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 #include <gz/math/Angle.hh>
 #include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Matrix4.hh>
 #include <gz/math/Plane.hh>
 #include <gz/math/Pose3.hh>
 #include <gz/math/config.hh>
@@ -33,6 +38,8 @@ namespace gz
 
     /// \brief Mathematical representation of a frustum and related functions.
     /// This is also known as a view frustum.
+    /// Const member functions don't modify the frustum, so they may be
+    /// called concurrently from several threads.
     class GZ_MATH_VISIBLE Frustum
     {
       /// \brief Planes that define the boundaries of the frustum.
@@ -84,6 +91,42 @@ namespace gz
                       double _aspectRatio,
                       const math::Pose3d &_pose = math::Pose3d::Zero);
 
+      /// \brief Constructor from the product of a projection matrix and a
+      /// view matrix, see Set(const Matrix4d &). If the matrix is not a
+      /// perspective projection, the frustum has the default values.
+      /// \param[in] _projectionView Projection matrix times view matrix.
+      public: explicit Frustum(const Matrix4d &_projectionView);
+
+      /// \brief Set all properties of the frustum at once. The planes are
+      /// computed once, instead of once per property as with the
+      /// individual setters.
+      /// \param[in] _near Near plane distance.
+      /// \param[in] _far Far plane distance.
+      /// \param[in] _fov Horizontal field of view.
+      /// \param[in] _aspectRatio The aspect ratio, which is the width
+      /// divided by height of the near or far planes.
+      /// \param[in] _pose Pose of the frustum, which is the vertex (top of
+      /// the pyramid).
+      /// \sa Frustum(double, double, const math::Angle &, double,
+      /// const math::Pose3d &)
+      public: void Set(double _near,
+                       double _far,
+                       const math::Angle &_fov,
+                       double _aspectRatio,
+                       const math::Pose3d &_pose);
+
+      /// \brief Set the frustum from the product of a projection matrix and
+      /// a view matrix, as used by a renderer. The matrices follow the
+      /// OpenGL conventions: the camera looks along its -Z axis with Y up,
+      /// and the clip space depth ranges from -1 at the near plane to 1 at
+      /// the far plane. The projection must be a symmetric perspective
+      /// projection, which is the only kind of frustum this class
+      /// represents.
+      /// \param[in] _projectionView Projection matrix times view matrix.
+      /// \return False if the matrix is not invertible or is not a
+      /// perspective projection, in which case the frustum is unchanged.
+      public: bool Set(const Matrix4d &_projectionView);
+
       /// \brief Get the near distance. This is the distance from the
       /// frustum's vertex to the closest plane.
       /// \return Near distance.
@@ -139,6 +182,12 @@ namespace gz
       /// \return Plane of the frustum.
       public: Planed Plane(const FrustumPlane _plane) const;
 
+      /// \brief Get the axis aligned box around the corners of the
+      /// frustum. Boxes that do not intersect it are never inside the
+      /// frustum, so it can cull them with a cheaper test than the planes.
+      /// \return Bounding box of the frustum.
+      public: AxisAlignedBox Bounds() const;
+
       /// \brief Check if a box lies inside the pyramid frustum.
       /// \param[in] _b Box to check.
       /// \return True if the box is inside the pyramid frustum.
@@ -149,12 +198,73 @@ namespace gz
       /// \return True if the point is inside the pyramid frustum.
       public: bool Contains(const Vector3d &_p) const;
 
+      /// \brief Check which boxes of an array lie inside the pyramid frustum.
+      /// The result for each box is the same as Contains(const
+      /// AxisAlignedBox &), but the plane tests run over blocks of boxes so
+      /// that they can be vectorized. Only boxes that straddle two or more
+      /// planes go through the exact per box test.
+      /// \param[in] _boxes Boxes to check.
+      /// \param[out] _results One value per box, 1 if the box is inside the
+      /// frustum and 0 otherwise.
+      /// \param[in] _count Number of boxes.
+      public: void Contains(const AxisAlignedBox *_boxes,
+                            std::uint8_t *_results,
+                            const std::size_t _count) const;
+
+      /// \brief Check which boxes of an array lie inside the pyramid frustum.
+      /// \param[in] _boxes Boxes to check.
+      /// \param[out] _results One value per box, 1 if the box is inside the
+      /// frustum and 0 otherwise. It is resized to the number of boxes.
+      /// \sa Contains(const AxisAlignedBox *, std::uint8_t *, std::size_t)
+      public: void Contains(const std::vector<AxisAlignedBox> &_boxes,
+                            std::vector<std::uint8_t> &_results) const;
+
+      /// \brief Check which boxes of an array lie inside each of several
+      /// frustums, for example the cameras of a multi-camera rig. The
+      /// boxes are read once and tested against all frustums.
+      /// \param[in] _frustums Frustums to check against.
+      /// \param[in] _boxes Boxes to check.
+      /// \param[out] _results Resized to _frustums.size() * _boxes.size().
+      /// The result of box b in frustum f is stored at
+      /// _results[f * _boxes.size() + b], 1 if the box is inside the
+      /// frustum and 0 otherwise.
+      public: static void Contains(const std::vector<Frustum> &_frustums,
+                                   const std::vector<AxisAlignedBox> &_boxes,
+                                   std::vector<std::uint8_t> &_results);
+
+      /// \brief Largest number of frustums of Visibility, one per bit of
+      /// a mask.
+      public: static constexpr std::size_t kMaxVisibilityFrustums = 64;
+
+      /// \brief Check which frustums of a sensor suite, such as the
+      /// cameras and lidar sectors of a vehicle, contain each box of a
+      /// scene. Each block of boxes is loaded once and tested against all
+      /// the frustums, and the blocks can be split in contiguous chunks
+      /// tested in parallel.
+      /// \param[in] _frustums Frustums to check against, at most
+      /// kMaxVisibilityFrustums are used.
+      /// \param[in] _frustumCount Number of frustums.
+      /// \param[in] _boxes Boxes to check.
+      /// \param[out] _masks One mask per box, with bit f set if the box is
+      /// inside _frustums[f] as defined by Contains(const AxisAlignedBox &).
+      /// \param[in] _count Number of boxes.
+      /// \param[in] _threads Largest number of threads to use, zero for
+      /// std::thread::hardware_concurrency. Small scenes use fewer threads.
+      /// \sa AxisAlignedBoxTree::Visibility
+      public: static void Visibility(const Frustum *_frustums,
+                                     const std::size_t _frustumCount,
+                                     const AxisAlignedBox *_boxes,
+                                     std::uint64_t *_masks,
+                                     const std::size_t _count,
+                                     const unsigned int _threads = 1);
+
       /// \brief Get the pose of the frustum
       /// \return Pose of the frustum
       /// \sa SetPose
       public: Pose3d Pose() const;
 
-      /// \brief Set the pose of the frustum
+      /// \brief Set the pose of the frustum. The planes are moved with the
+      /// frustum rather than computed again from its properties.
       /// \param[in] _pose Pose of the frustum, top vertex.
       /// \sa Pose
       public: void SetPose(const Pose3d &_pose);
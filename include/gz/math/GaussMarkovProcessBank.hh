@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_GAUSSMARKOVPROCESSBANK_HH_
+#define GZ_MATH_GAUSSMARKOVPROCESSBANK_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <gz/math/Export.hh>
+#include <gz/math/GaussMarkovProcess.hh>
+#include <gz/math/config.hh>
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    /** \class GaussMarkovProcessBank GaussMarkovProcessBank.hh     * gz/math/GaussMarkovProcessBank.hh
+     **/
+    /// \brief Many independent Gauss-Markov processes, or channels, updated
+    /// together, such as the bias drifts of a set of IMUs.
+    ///
+    /// Each channel follows the formula of GaussMarkovProcess::Update. The
+    /// parameters and values of the channels are stored in arrays, and an
+    /// update draws the noise of all the channels at once with
+    /// Rand::FillNormal, then advances them in one loop the compiler can
+    /// vectorize.
+    ///
+    /// A channel added with a seed draws its noise from Philox4x32 with that
+    /// seed instead, so its values only depend on its seed and the number of
+    /// updates since the last reset.
+    class GZ_MATH_VISIBLE GaussMarkovProcessBank
+    {
+      /// \brief Constructor, with no channels.
+      public: GaussMarkovProcessBank();
+
+      /// \brief Add a channel, with its noise drawn from Rand.
+      /// \param[in] _start The start value of the process.
+      /// \param[in] _theta The theta (\f$\theta\f$) parameter. A value of
+      /// zero will be used if this parameter is negative.
+      /// \param[in] _mu The mu (\f$\mu\f$) parameter.
+      /// \param[in] _sigma The sigma (\f$\sigma\f$) parameter. A value of
+      /// zero will be used if this parameter is negative.
+      /// \return Index of the channel.
+      /// \sa GaussMarkovProcess::Update(double)
+      public: size_t Add(double _start, double _theta, double _mu,
+                         double _sigma);
+
+      /// \brief Add a channel with its own seed.
+      /// \param[in] _start The start value of the process.
+      /// \param[in] _theta The theta (\f$\theta\f$) parameter. A value of
+      /// zero will be used if this parameter is negative.
+      /// \param[in] _mu The mu (\f$\mu\f$) parameter.
+      /// \param[in] _sigma The sigma (\f$\sigma\f$) parameter. A value of
+      /// zero will be used if this parameter is negative.
+      /// \param[in] _seed Seed of the noise of the channel.
+      /// \return Index of the channel.
+      public: size_t Add(double _start, double _theta, double _mu,
+                         double _sigma, uint64_t _seed);
+
+      /// \brief Set the parameters of a channel, and reset it.
+      /// \param[in] _index Index of the channel, less than Size().
+      /// \param[in] _start The start value of the process.
+      /// \param[in] _theta The theta (\f$\theta\f$) parameter.
+      /// \param[in] _mu The mu (\f$\mu\f$) parameter.
+      /// \param[in] _sigma The sigma (\f$\sigma\f$) parameter.
+      /// \return False if _index is out of range.
+      public: bool Set(size_t _index, double _start, double _theta,
+                       double _mu, double _sigma);
+
+      /// \brief Get the number of channels.
+      /// \return The number of channels.
+      public: size_t Size() const;
+
+      /// \brief Remove all the channels.
+      public: void Clear();
+
+      /// \brief Reset all the channels to their start value, and restart
+      /// the noise of the seeded channels.
+      public: void Reset();
+
+      /// \brief Get the current values of the channels.
+      /// \return The values, in the order the channels were added.
+      public: const std::vector<double> &Values() const;
+
+      /// \brief Get the start values of the channels.
+      /// \return The start values.
+      public: const std::vector<double> &Start() const;
+
+      /// \brief Get the theta (\f$\theta\f$) values of the channels.
+      /// \return The theta values.
+      public: const std::vector<double> &Theta() const;
+
+      /// \brief Get the mu (\f$\mu\f$) values of the channels.
+      /// \return The mu values.
+      public: const std::vector<double> &Mu() const;
+
+      /// \brief Get the sigma (\f$\sigma\f$) values of the channels.
+      /// \return The sigma values.
+      public: const std::vector<double> &Sigma() const;
+
+      /// \brief Update all the channels.
+      /// \param[in] _dt Length of the timestep after which a new sample
+      /// should be taken.
+      /// \return The new values of the channels.
+      /// \sa GaussMarkovProcess::Update(const clock::duration &)
+      public: const std::vector<double> &Update(const clock::duration &_dt);
+
+      /// \brief Update all the channels.
+      /// \param[in] _dt Length of the timestep in seconds.
+      /// \return The new values of the channels.
+      /// \sa GaussMarkovProcess::Update(double)
+      public: const std::vector<double> &Update(double _dt);
+
+      /// \brief Private data pointer.
+      GZ_UTILS_IMPL_PTR(dataPtr)
+    };
+    }
+  }
+}
+#endif
@@ -21,10 +21,13 @@
 #include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <ostream>
 #include <limits>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -251,7 +254,7 @@ namespace gz
     /// \param[in] _max Maximum allowed value.
     /// \return The value _v clamped to the range defined by _min and _max.
     template<typename T>
-    inline T clamp(T _v, T _min, T _max)
+    constexpr T clamp(T _v, T _min, T _max)
     {
       return std::max(std::min(_v, _max), _min);
     }
@@ -344,12 +347,91 @@ namespace gz
       return sgn(_value);
     }
 
+    /// \brief Get the mean of an array of values.
+    ///
+    /// The array statistics read the values once, by blocks which fit in
+    /// the cache: the mean and squared deviations of each block are summed
+    /// in several independent sums the compiler can vectorize, and the
+    /// blocks are merged with the formula of Chan et al. This is as
+    /// accurate as two passes over the values. Float values are summed in
+    /// double precision.
+    /// \param[in] _values The values.
+    /// \param[in] _count Number of values.
+    /// \param[in] _threads Largest number of threads to use, zero for
+    /// std::thread::hardware_concurrency. Small arrays use fewer threads.
+    /// \return The mean value, NaN if _count is zero.
+    double GZ_MATH_VISIBLE mean(const double *_values, std::size_t _count,
+                                unsigned int _threads = 1);
+
+    /// \brief Get the mean of an array of values.
+    /// \param[in] _values The values.
+    /// \param[in] _count Number of values.
+    /// \param[in] _threads Largest number of threads to use, zero for
+    /// std::thread::hardware_concurrency.
+    /// \return The mean value, NaN if _count is zero.
+    /// \sa mean(const double *, std::size_t, unsigned int)
+    float GZ_MATH_VISIBLE mean(const float *_values, std::size_t _count,
+                               unsigned int _threads = 1);
+
+    /// \brief Get the variance of an array of values, in one pass.
+    /// \param[in] _values The values.
+    /// \param[in] _count Number of values.
+    /// \param[in] _threads Largest number of threads to use, zero for
+    /// std::thread::hardware_concurrency.
+    /// \return The squared deviation of the values, NaN if _count is zero.
+    /// \sa mean(const double *, std::size_t, unsigned int)
+    double GZ_MATH_VISIBLE variance(const double *_values, std::size_t _count,
+                                    unsigned int _threads = 1);
+
+    /// \brief Get the variance of an array of values, in one pass.
+    /// \param[in] _values The values.
+    /// \param[in] _count Number of values.
+    /// \param[in] _threads Largest number of threads to use, zero for
+    /// std::thread::hardware_concurrency.
+    /// \return The squared deviation of the values, NaN if _count is zero.
+    /// \sa mean(const double *, std::size_t, unsigned int)
+    float GZ_MATH_VISIBLE variance(const float *_values, std::size_t _count,
+                                   unsigned int _threads = 1);
+
+    /// \brief Get the mean and the variance of an array of values, in one
+    /// pass.
+    /// \param[in] _values The values.
+    /// \param[in] _count Number of values.
+    /// \param[out] _mean The mean value, NaN if _count is zero.
+    /// \param[out] _variance The squared deviation of the values, NaN if
+    /// _count is zero.
+    /// \param[in] _threads Largest number of threads to use, zero for
+    /// std::thread::hardware_concurrency.
+    /// \sa mean(const double *, std::size_t, unsigned int)
+    void GZ_MATH_VISIBLE meanAndVariance(const double *_values,
+                                         std::size_t _count, double &_mean,
+                                         double &_variance,
+                                         unsigned int _threads = 1);
+
+    /// \brief Get the mean and the variance of an array of values, in one
+    /// pass.
+    /// \param[in] _values The values.
+    /// \param[in] _count Number of values.
+    /// \param[out] _mean The mean value, NaN if _count is zero.
+    /// \param[out] _variance The squared deviation of the values, NaN if
+    /// _count is zero.
+    /// \param[in] _threads Largest number of threads to use, zero for
+    /// std::thread::hardware_concurrency.
+    /// \sa mean(const double *, std::size_t, unsigned int)
+    void GZ_MATH_VISIBLE meanAndVariance(const float *_values,
+                                         std::size_t _count, float &_mean,
+                                         float &_variance,
+                                         unsigned int _threads = 1);
+
     /// \brief Get mean value in a vector of values
     /// \param[in] _values The vector of values.
     /// \return The mean value in the provided vector.
     template<typename T>
     inline T mean(const std::vector<T> &_values)
     {
+      if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>)
+        return mean(_values.data(), _values.size());
+
       T sum = 0;
       for (unsigned int i = 0; i < _values.size(); ++i)
         sum += _values[i];
@@ -362,6 +444,9 @@ namespace gz
     template<typename T>
     inline T variance(const std::vector<T> &_values)
     {
+      if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>)
+        return variance(_values.data(), _values.size());
+
       T avg = mean<T>(_values);
 
       T sum = 0;
@@ -388,6 +473,92 @@ namespace gz
       return *std::min_element(std::begin(_values), std::end(_values));
     }
 
+    /// \brief Get the minimum and the maximum of an array of values, in
+    /// one pass. NaN values are ignored.
+    /// \param[in] _values The values.
+    /// \param[in] _count Number of values.
+    /// \return The minimum and the maximum value. If there are none, the
+    /// minimum is the largest value of T, infinity if T has it, and the
+    /// maximum is the lowest value of T.
+    template<typename T>
+    inline std::pair<T, T> minmax(const T *_values, const std::size_t _count)
+    {
+      T lowest;
+      T highest;
+      if constexpr (std::numeric_limits<T>::has_infinity)
+      {
+        lowest = std::numeric_limits<T>::infinity();
+        highest = -std::numeric_limits<T>::infinity();
+      }
+      else
+      {
+        lowest = std::numeric_limits<T>::max();
+        highest = std::numeric_limits<T>::lowest();
+      }
+
+      // Independent minimums and maximums, which the compiler can vectorize
+      constexpr std::size_t kLanes = 8;
+      T lo[kLanes];
+      T hi[kLanes];
+      std::fill(lo, lo + kLanes, lowest);
+      std::fill(hi, hi + kLanes, highest);
+      std::size_t i = 0;
+      for (; i + kLanes <= _count; i += kLanes)
+      {
+        for (std::size_t k = 0; k < kLanes; ++k)
+        {
+          lo[k] = _values[i + k] < lo[k] ? _values[i + k] : lo[k];
+          hi[k] = hi[k] < _values[i + k] ? _values[i + k] : hi[k];
+        }
+      }
+      for (; i < _count; ++i)
+      {
+        lo[0] = _values[i] < lo[0] ? _values[i] : lo[0];
+        hi[0] = hi[0] < _values[i] ? _values[i] : hi[0];
+      }
+
+      std::pair<T, T> result(lo[0], hi[0]);
+      for (std::size_t k = 1; k < kLanes; ++k)
+      {
+        result.first = lo[k] < result.first ? lo[k] : result.first;
+        result.second = result.second < hi[k] ? hi[k] : result.second;
+      }
+      return result;
+    }
+
+    /// \brief Get the minimum and the maximum of a vector of values, in one
+    /// pass. NaN values are ignored.
+    /// \param[in] _values The vector of values.
+    /// \return The minimum and the maximum value.
+    /// \sa minmax(const T *, std::size_t)
+    template<typename T>
+    inline std::pair<T, T> minmax(const std::vector<T> &_values)
+    {
+      return minmax(_values.data(), _values.size());
+    }
+
+    /// \brief Get the minimum of an array of values. NaN values are
+    /// ignored.
+    /// \param[in] _values The values.
+    /// \param[in] _count Number of values.
+    /// \return The minimum value, see minmax if there are none.
+    template<typename T>
+    inline T min(const T *_values, const std::size_t _count)
+    {
+      return minmax(_values, _count).first;
+    }
+
+    /// \brief Get the maximum of an array of values. NaN values are
+    /// ignored.
+    /// \param[in] _values The values.
+    /// \param[in] _count Number of values.
+    /// \return The maximum value, see minmax if there are none.
+    template<typename T>
+    inline T max(const T *_values, const std::size_t _count)
+    {
+      return minmax(_values, _count).second;
+    }
+
     /// \brief Check if two values are equal, within a tolerance.
     /// \param[in] _a The first value.
     /// \param[in] _b The second value.
@@ -436,6 +607,186 @@ namespace gz
       return static_cast<T>(std::round(_a * p) / p);
     }
 
+    /// \brief Approximate 1 / sqrt(_v), without a square root or a
+    /// division, for the NormalizeFast functions.
+    ///
+    /// A first estimate is read from the bits of _v, and refined by Newton
+    /// iterations: two for float and three for double, for a relative
+    /// error below 5e-6 for float and 4e-11 for double. The error is
+    /// larger for subnormal values. For 0, the result is a large finite
+    /// value, so that a zero vector scaled by it stays zero.
+    /// \param[in] _v Positive or zero value.
+    /// \return Approximate 1 / sqrt(_v).
+    inline float fastInverseSqrt(const float _v)
+    {
+      std::uint32_t bits;
+      std::memcpy(&bits, &_v, sizeof(bits));
+      bits = 0x5f375a86u - (bits >> 1);
+      float y;
+      std::memcpy(&y, &bits, sizeof(y));
+      const float half = 0.5f * _v;
+      y = y * (1.5f - half * y * y);
+      y = y * (1.5f - half * y * y);
+      return y;
+    }
+
+    /// \copydoc fastInverseSqrt(const float)
+    inline double fastInverseSqrt(const double _v)
+    {
+      std::uint64_t bits;
+      std::memcpy(&bits, &_v, sizeof(bits));
+      bits = 0x5fe6eb50c7b537a9ull - (bits >> 1);
+      double y;
+      std::memcpy(&y, &bits, sizeof(y));
+      const double half = 0.5 * _v;
+      y = y * (1.5 - half * y * y);
+      y = y * (1.5 - half * y * y);
+      y = y * (1.5 - half * y * y);
+      return y;
+    }
+
+    /// \brief Clamp an array of values, as clamp does for each value.
+    ///
+    /// The array kernels, such as this one, process buffers like the
+    /// ranges of a sensor with branch free loops, which don't call
+    /// std::isnan or std::round, so that the compiler can vectorize them.
+    /// The input and output arrays can be the same array, but must not
+    /// overlap otherwise.
+    /// \param[in] _in Values to clamp.
+    /// \param[out] _out Clamped values. NaN values are unchanged.
+    /// \param[in] _count Number of values.
+    /// \param[in] _min Minimum allowed value.
+    /// \param[in] _max Maximum allowed value.
+    void GZ_MATH_VISIBLE clamp(const float *_in, float *_out,
+                               std::size_t _count, float _min, float _max);
+
+    /// \brief Clamp an array of values, as clamp does for each value.
+    /// \param[in] _in Values to clamp.
+    /// \param[out] _out Clamped values. NaN values are unchanged.
+    /// \param[in] _count Number of values.
+    /// \param[in] _min Minimum allowed value.
+    /// \param[in] _max Maximum allowed value.
+    /// \sa clamp(const float *, float *, std::size_t, float, float)
+    void GZ_MATH_VISIBLE clamp(const double *_in, double *_out,
+                               std::size_t _count, double _min,
+                               double _max);
+
+    /// \brief Fix the NaN and infinite values of an array, as fixnan does
+    /// for each value.
+    /// \param[in] _in Values to fix.
+    /// \param[out] _out 0 for NaN and infinite values, the value otherwise.
+    /// \param[in] _count Number of values.
+    /// \sa clamp(const float *, float *, std::size_t, float, float)
+    void GZ_MATH_VISIBLE fixnan(const float *_in, float *_out,
+                                std::size_t _count);
+
+    /// \brief Fix the NaN and infinite values of an array, as fixnan does
+    /// for each value.
+    /// \param[in] _in Values to fix.
+    /// \param[out] _out 0 for NaN and infinite values, the value otherwise.
+    /// \param[in] _count Number of values.
+    /// \sa clamp(const float *, float *, std::size_t, float, float)
+    void GZ_MATH_VISIBLE fixnan(const double *_in, double *_out,
+                                std::size_t _count);
+
+    /// \brief Sanitize an array of values, such as the ranges of a sensor:
+    /// clamp them to a range, which also replaces infinite values with the
+    /// nearest bound, and replace NaN values.
+    /// \param[in] _in Values to sanitize.
+    /// \param[out] _out Sanitized values.
+    /// \param[in] _count Number of values.
+    /// \param[in] _min Minimum allowed value.
+    /// \param[in] _max Maximum allowed value.
+    /// \param[in] _nanValue Value replacing NaN values.
+    /// \sa clamp(const float *, float *, std::size_t, float, float)
+    void GZ_MATH_VISIBLE sanitize(const float *_in, float *_out,
+                                  std::size_t _count, float _min, float _max,
+                                  float _nanValue);
+
+    /// \brief Sanitize an array of values, such as the ranges of a sensor:
+    /// clamp them to a range, which also replaces infinite values with the
+    /// nearest bound, and replace NaN values.
+    /// \param[in] _in Values to sanitize.
+    /// \param[out] _out Sanitized values.
+    /// \param[in] _count Number of values.
+    /// \param[in] _min Minimum allowed value.
+    /// \param[in] _max Maximum allowed value.
+    /// \param[in] _nanValue Value replacing NaN values.
+    /// \sa clamp(const float *, float *, std::size_t, float, float)
+    void GZ_MATH_VISIBLE sanitize(const double *_in, double *_out,
+                                  std::size_t _count, double _min,
+                                  double _max, double _nanValue);
+
+    /// \brief Round an array of values to a number of decimals, as
+    /// precision does for each value.
+    /// \param[in] _in Values to round.
+    /// \param[out] _out Rounded values.
+    /// \param[in] _count Number of values.
+    /// \param[in] _precision Number of decimals.
+    /// \sa clamp(const float *, float *, std::size_t, float, float)
+    void GZ_MATH_VISIBLE precision(const float *_in, float *_out,
+                                   std::size_t _count,
+                                   unsigned int _precision);
+
+    /// \brief Round an array of values to a number of decimals, as
+    /// precision does for each value.
+    /// \param[in] _in Values to round.
+    /// \param[out] _out Rounded values.
+    /// \param[in] _count Number of values.
+    /// \param[in] _precision Number of decimals.
+    /// \sa clamp(const float *, float *, std::size_t, float, float)
+    void GZ_MATH_VISIBLE precision(const double *_in, double *_out,
+                                   std::size_t _count,
+                                   unsigned int _precision);
+
+    /// \brief Compare two arrays of values, as equal does for each pair of
+    /// values.
+    /// \param[in] _a The first values.
+    /// \param[in] _b The second values.
+    /// \param[out] _equal For each pair, true if the values are within the
+    /// tolerance. Can be null to only count them.
+    /// \param[in] _count Number of values of each array.
+    /// \param[in] _epsilon The tolerance.
+    /// \return Number of pairs of values within the tolerance.
+    /// \sa clamp(const float *, float *, std::size_t, float, float)
+    std::size_t GZ_MATH_VISIBLE equal(const float *_a, const float *_b,
+                                      bool *_equal, std::size_t _count,
+                                      float _epsilon = 1e-6f);
+
+    /// \brief Compare two arrays of values, as equal does for each pair of
+    /// values.
+    /// \param[in] _a The first values.
+    /// \param[in] _b The second values.
+    /// \param[out] _equal For each pair, true if the values are within the
+    /// tolerance. Can be null to only count them.
+    /// \param[in] _count Number of values of each array.
+    /// \param[in] _epsilon The tolerance.
+    /// \return Number of pairs of values within the tolerance.
+    /// \sa clamp(const float *, float *, std::size_t, float, float)
+    std::size_t GZ_MATH_VISIBLE equal(const double *_a, const double *_b,
+                                      bool *_equal, std::size_t _count,
+                                      double _epsilon = 1e-6);
+
+    /// \brief Find the NaN values of an array.
+    /// \param[in] _values The values.
+    /// \param[out] _isnan For each value, true if it is NaN. Can be null to
+    /// only count them.
+    /// \param[in] _count Number of values.
+    /// \return Number of NaN values.
+    /// \sa clamp(const float *, float *, std::size_t, float, float)
+    std::size_t GZ_MATH_VISIBLE isnan(const float *_values, bool *_isnan,
+                                      std::size_t _count);
+
+    /// \brief Find the NaN values of an array.
+    /// \param[in] _values The values.
+    /// \param[out] _isnan For each value, true if it is NaN. Can be null to
+    /// only count them.
+    /// \param[in] _count Number of values.
+    /// \return Number of NaN values.
+    /// \sa clamp(const float *, float *, std::size_t, float, float)
+    std::size_t GZ_MATH_VISIBLE isnan(const double *_values, bool *_isnan,
+                                      std::size_t _count);
+
     /// \brief Sort two numbers, such that _a <= _b.
     /// \param[in, out] _a The first number. This variable will contain the
     /// lower of the two values after this function completes.
@@ -550,12 +901,66 @@ namespace gz
     /// \return An integer, or NAN_I if unable to parse the input.
     int GZ_MATH_VISIBLE parseInt(const std::string &_input);
 
+    /// \brief Parse a string view into an integer, as with std::stoi, but
+    /// without exceptions or memory allocation.
+    /// \param[in] _input The input string.
+    /// \return An integer, or NAN_I if unable to parse the input.
+    int GZ_MATH_VISIBLE parseInt(std::string_view _input);
+
+    /// \brief Parse a C string into an integer.
+    /// \param[in] _input The input string.
+    /// \return An integer, or NAN_I if unable to parse the input.
+    inline int parseInt(const char *_input)
+    {
+      return parseInt(std::string_view(_input));
+    }
+
     /// \brief parse string into float.
     /// \param [in] _input The string.
     /// \return A floating point number (can be NaN) or NAN_D if the
     /// _input could not be parsed.
     double GZ_MATH_VISIBLE parseFloat(const std::string &_input);
 
+    /// \brief Parse a string view into a float, as with std::stod, but
+    /// without exceptions or memory allocation, and independently of the
+    /// locale.
+    /// \param [in] _input The string.
+    /// \return A floating point number (can be NaN) or NAN_D if the
+    /// _input could not be parsed.
+    double GZ_MATH_VISIBLE parseFloat(std::string_view _input);
+
+    /// \brief Parse a C string into a float.
+    /// \param [in] _input The string.
+    /// \return A floating point number (can be NaN) or NAN_D if the
+    /// _input could not be parsed.
+    inline double parseFloat(const char *_input)
+    {
+      return parseFloat(std::string_view(_input));
+    }
+
+    /// \brief Parse white space separated numbers, such as "1 2.5 -3e2",
+    /// into doubles. Each number has the syntax accepted by parseFloat, and
+    /// must be followed by white space or the end of the string.
+    /// \param[in] _input The string to parse.
+    /// \param[out] _values The numbers, up to the first token that isn't a
+    /// number. Its previous content is replaced.
+    /// \return True if each token of _input is a number.
+    bool GZ_MATH_VISIBLE parseFloats(std::string_view _input,
+                                     std::vector<double> &_values);
+
+    template<typename T> class Vector3;
+
+    /// \brief Parse white space separated numbers into vectors, the first
+    /// three numbers making the first vector and so on.
+    /// \param[in] _input The string to parse.
+    /// \param[out] _vectors The vectors, up to the first token that isn't a
+    /// number. Its previous content is replaced.
+    /// \return True if each token of _input is a number and the number of
+    /// numbers is a multiple of three.
+    /// \sa parseFloats
+    bool GZ_MATH_VISIBLE parseVector3s(std::string_view _input,
+        std::vector<Vector3<double>> &_vectors);
+
     /// \brief Convert a std::chrono::steady_clock::time_point to a seconds and
     /// nanoseconds pair.
     /// \param[in] _time The time point to convert.
@@ -626,6 +1031,82 @@ namespace gz
     std::string GZ_MATH_VISIBLE durationToString(
         const std::chrono::steady_clock::duration &_duration);
 
+    /// \brief Write a number to a buffer with std::to_chars, without
+    /// streams or memory allocation. As with appendToStream, "-0" is written
+    /// as "0".
+    /// \param[out] _buffer The buffer. It isn't null terminated.
+    /// \param[in] _capacity Size of the buffer
+    /// \param[in] _number The number to write
+    /// \param[in] _precision Number of digits after the decimal point, or a
+    /// negative value for the shortest representation that reads back as
+    /// the same number
+    /// \return Number of characters written, 0 if they don't fit
+    std::size_t GZ_MATH_VISIBLE toChars(char *_buffer, std::size_t _capacity,
+        double _number, int _precision = -1);
+
+    /// \brief Write a float to a buffer with std::to_chars.
+    /// \param[out] _buffer The buffer. It isn't null terminated.
+    /// \param[in] _capacity Size of the buffer
+    /// \param[in] _number The number to write
+    /// \param[in] _precision Number of digits after the decimal point, or a
+    /// negative value for the shortest representation that reads back as
+    /// the same float
+    /// \return Number of characters written, 0 if they don't fit
+    std::size_t GZ_MATH_VISIBLE toChars(char *_buffer, std::size_t _capacity,
+        float _number, int _precision = -1);
+
+    /// \brief Write an integer to a buffer with std::to_chars.
+    /// \param[out] _buffer The buffer. It isn't null terminated.
+    /// \param[in] _capacity Size of the buffer
+    /// \param[in] _number The number to write
+    /// \param[in] _precision Ignored, for generic code
+    /// \return Number of characters written, 0 if they don't fit
+    std::size_t GZ_MATH_VISIBLE toChars(char *_buffer, std::size_t _capacity,
+        int _number, int _precision = -1);
+
+    /// \brief Write a duration to a buffer, in the format of
+    /// durationToString, without streams or memory allocation.
+    /// \param[out] _buffer The buffer. It isn't null terminated.
+    /// \param[in] _capacity Size of the buffer
+    /// \param[in] _duration The duration to write
+    /// \return Number of characters written, 0 if they don't fit
+    std::size_t GZ_MATH_VISIBLE toChars(char *_buffer, std::size_t _capacity,
+        const std::chrono::steady_clock::duration &_duration);
+
+    /// \brief Append a number to a string with std::to_chars. Reusing the
+    /// same string for many records avoids memory allocations.
+    /// \param[in, out] _out The string
+    /// \param[in] _number The number to append
+    /// \param[in] _precision Number of digits after the decimal point, or a
+    /// negative value for the shortest representation that reads back as
+    /// the same number
+    /// \sa toChars(char *, std::size_t, double, int)
+    void GZ_MATH_VISIBLE appendToString(std::string &_out, double _number,
+                                        int _precision = -1);
+
+    /// \brief Append a float to a string with std::to_chars.
+    /// \param[in, out] _out The string
+    /// \param[in] _number The number to append
+    /// \param[in] _precision Number of digits after the decimal point, or a
+    /// negative value for the shortest representation that reads back as
+    /// the same float
+    void GZ_MATH_VISIBLE appendToString(std::string &_out, float _number,
+                                        int _precision = -1);
+
+    /// \brief Append an integer to a string with std::to_chars.
+    /// \param[in, out] _out The string
+    /// \param[in] _number The number to append
+    /// \param[in] _precision Ignored, for generic code
+    void GZ_MATH_VISIBLE appendToString(std::string &_out, int _number,
+                                        int _precision = -1);
+
+    /// \brief Append a duration to a string, in the format of
+    /// durationToString.
+    /// \param[in, out] _out The string
+    /// \param[in] _duration The duration to append
+    void GZ_MATH_VISIBLE appendToString(std::string &_out,
+        const std::chrono::steady_clock::duration &_duration);
+
     /// \brief Split a std::chrono::steady_clock::duration to a string
     /// \param[in] _timeString The string to convert in general format
     /// \param[out] numberDays number of days in the string
@@ -633,7 +1114,7 @@ namespace gz
     /// \param[out] numberMinutes number of minutes in the string
     /// \param[out] numberSeconds number of seconds in the string
     /// \param[out] numberMilliseconds number of milliseconds in the string
-    /// \return True if the regex was able to split the string otherwise False
+    /// \return True if the string is a valid time string, otherwise False
     bool GZ_MATH_VISIBLE splitTimeBasedOnTimeRegex(
         const std::string &_timeString,
         uint64_t & numberDays, uint64_t & numberHours,
@@ -669,6 +1150,28 @@ namespace gz
     std::chrono::steady_clock::time_point
     GZ_MATH_VISIBLE stringToTimePoint(const std::string &_timeString);
 
+    /// \brief Convert a buffer of newline-separated time strings, such as
+    /// the contents of a log index file, to durations. Each line is
+    /// converted as by stringToDuration, without copying it. A carriage
+    /// return at the end of a line is ignored, and so is an empty last line.
+    /// \param[in] _buffer The time strings, one per line
+    /// \param[out] _durations One duration per line, zero if the line isn't
+    /// a time string. Its previous content is replaced.
+    /// \return The number of lines that are time strings
+    std::size_t GZ_MATH_VISIBLE stringsToDurations(std::string_view _buffer,
+        std::vector<std::chrono::steady_clock::duration> &_durations);
+
+    /// \brief Convert a buffer of newline-separated time strings to time
+    /// points. Each line is converted as by stringToTimePoint, without
+    /// copying it. A carriage return at the end of a line is ignored, and so
+    /// is an empty last line.
+    /// \param[in] _buffer The time strings, one per line
+    /// \param[out] _timePoints One time point per line, negative 1 second if
+    /// the line isn't a time string. Its previous content is replaced.
+    /// \return The number of lines converted to a time point
+    std::size_t GZ_MATH_VISIBLE stringsToTimePoints(std::string_view _buffer,
+        std::vector<std::chrono::steady_clock::time_point> &_timePoints);
+
     // Degrade precision on Windows, which cannot handle 'long double'
     // values properly. See the implementation of Unpair.
     // 32 bit ARM processors also define 'long double' to be the same
@@ -706,6 +1209,87 @@ namespace gz
     /// \sa Pair
     std::tuple<PairInput, PairInput> GZ_MATH_VISIBLE Unpair(
         const PairOutput _key);
+
+    /// \brief Szudzik's pairing function of two 32 bit values, with a 64 bit
+    /// key on every platform, unlike Pair.
+    /// \param[in] _a First value.
+    /// \param[in] _b Second value.
+    /// \return A unique key. Every 64 bit value is the key of one pair.
+    /// \sa Unpair64
+    uint64_t GZ_MATH_VISIBLE Pair64(const uint32_t _a, const uint32_t _b);
+
+    /// \brief Pair buffers of values: _keys[i] = Pair64(_a[i], _b[i]). The
+    /// loop has no branches, so that compilers can vectorize it.
+    /// \param[in] _a Pointer to the first value of the first buffer.
+    /// \param[in] _b Pointer to the first value of the second buffer.
+    /// \param[out] _keys Pointer to the first key.
+    /// \param[in] _count Number of pairs.
+    void GZ_MATH_VISIBLE Pair64(const uint32_t *_a, const uint32_t *_b,
+                                uint64_t *_keys, const std::size_t _count);
+
+    /// \brief The reverse of Pair64.
+    /// \param[in] _key A key made by Pair64.
+    /// \return The two values whose key is _key.
+    std::tuple<uint32_t, uint32_t> GZ_MATH_VISIBLE Unpair64(
+        const uint64_t _key);
+
+    /// \brief Unpair a buffer of keys made by Pair64.
+    /// \param[in] _keys Pointer to the first key.
+    /// \param[out] _a Pointer to the first value of the first buffer.
+    /// \param[out] _b Pointer to the first value of the second buffer.
+    /// \param[in] _count Number of keys.
+    void GZ_MATH_VISIBLE Unpair64(const uint64_t *_keys, uint32_t *_a,
+                                  uint32_t *_b, const std::size_t _count);
+
+    /// \brief Interleave the bits of three values into a Morton (Z-order)
+    /// key. Cells close to each other in space tend to have close keys,
+    /// which makes the keys good for sorting and hashing grid cells.
+    /// \param[in] _x First value. Only its lower 21 bits are used.
+    /// \param[in] _y Second value. Only its lower 21 bits are used.
+    /// \param[in] _z Third value. Only its lower 21 bits are used.
+    /// \return The 63 bit key.
+    /// \sa MortonDecode
+    uint64_t GZ_MATH_VISIBLE MortonEncode(const uint32_t _x,
+                                          const uint32_t _y,
+                                          const uint32_t _z);
+
+    /// \brief Make the Morton keys of buffers of values:
+    /// _keys[i] = MortonEncode(_x[i], _y[i], _z[i]).
+    /// \param[in] _x Pointer to the first x value.
+    /// \param[in] _y Pointer to the first y value.
+    /// \param[in] _z Pointer to the first z value.
+    /// \param[out] _keys Pointer to the first key.
+    /// \param[in] _count Number of keys.
+    void GZ_MATH_VISIBLE MortonEncode(const uint32_t *_x, const uint32_t *_y,
+        const uint32_t *_z, uint64_t *_keys, const std::size_t _count);
+
+    /// \brief The reverse of MortonEncode.
+    /// \param[in] _key A key made by MortonEncode.
+    /// \return The lower 21 bits of the three values of the key.
+    std::tuple<uint32_t, uint32_t, uint32_t> GZ_MATH_VISIBLE MortonDecode(
+        const uint64_t _key);
+
+    /// \brief Get the Morton key of a grid cell with signed coordinates,
+    /// each in [-2^20, 2^20). The coordinates are offset by 2^20 before
+    /// encoding them, so that neighbor cells across zero stay close.
+    /// \param[in] _cell The cell coordinates.
+    /// \return The key.
+    uint64_t GZ_MATH_VISIBLE MortonEncode(const Vector3<int> &_cell);
+
+    /// \brief Get the Morton keys of a buffer of grid cells.
+    /// \param[in] _cells Pointer to the first cell.
+    /// \param[out] _keys Pointer to the first key.
+    /// \param[in] _count Number of cells.
+    /// \sa MortonEncode(const Vector3<int> &)
+    void GZ_MATH_VISIBLE MortonEncode(const Vector3<int> *_cells,
+                                      uint64_t *_keys,
+                                      const std::size_t _count);
+
+    /// \brief The reverse of MortonEncode(const Vector3<int> &).
+    /// \param[in] _key A key made by MortonEncode(const Vector3<int> &).
+    /// \param[out] _cell The cell coordinates.
+    void GZ_MATH_VISIBLE MortonDecode(const uint64_t _key,
+                                      Vector3<int> &_cell);
     }
   }
 }
@@ -17,6 +17,7 @@
 #ifndef GZ_MATH_INERTIAL_HH_
 #define GZ_MATH_INERTIAL_HH_
 
+#include <cstddef>
 #include <optional>
 
 #include <gz/math/config.hh>
@@ -246,9 +247,10 @@ namespace gz
       public: bool SetMassMatrixRotation(const Quaternion<T> &_q,
                                          const T _tol = 1e-6)
       {
-        this->pose.Rot() *= this->MassMatrix().PrincipalAxesOffset(_tol) *
-                            _q.Inverse();
-        const auto moments = this->MassMatrix().PrincipalMoments(_tol);
+        Vector3<T> moments;
+        Quaternion<T> offset;
+        this->massMatrix.PrincipalAxes(moments, offset, _tol);
+        this->pose.Rot() *= offset * _q.Inverse();
         const auto diag = Matrix3<T>(
             moments[0], 0, 0,
             0, moments[1], 0,
@@ -418,6 +420,165 @@ namespace gz
         return Inertial<T>(*this) -= _inertial;
       }
 
+      /// \brief Sum the inertial properties of many objects in one pass.
+      /// The result is the same as adding them in order with operator+=,
+      /// but the mass, first and second moments are accumulated once and
+      /// the combined inertial is built at the end, instead of building a
+      /// new center of mass and inertia matrix for every object. The moments
+      /// are accumulated relative to the center of mass of the first object
+      /// to limit cancellation when the objects are far from the origin.
+      /// \param[in] _inertials Pointer to the inertials to sum.
+      /// \param[in] _count Number of inertials.
+      /// \return Sum of the inertials, with the fluid added mass of the
+      /// first one as with operator+=. The first inertial is returned
+      /// unchanged if it is the only one or the total mass is not
+      /// positive, and a default Inertial if _count is zero.
+      public: static Inertial<T> Sum(const Inertial<T> *_inertials,
+                                     const std::size_t _count)
+      {
+        if (_inertials == nullptr || _count == 0)
+          return Inertial<T>();
+        if (_count == 1)
+          return _inertials[0];
+
+        const Vector3<T> origin = _inertials[0].Pose().Pos();
+        T mass = 0;
+        Vector3<T> firstMoment;
+        Matrix3<T> moi = Matrix3<T>::Zero;
+        // Sum of m * d * d^T, of which only the upper triangle is needed
+        Vector3<T> dd;
+        Vector3<T> ddOff;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const T m = _inertials[i].MassMatrix().Mass();
+          const Vector3<T> d = _inertials[i].Pose().Pos() - origin;
+          mass += m;
+          firstMoment += m * d;
+          moi = moi + _inertials[i].Moi();
+          dd += m * Vector3<T>(d[0] * d[0], d[1] * d[1], d[2] * d[2]);
+          ddOff += m * Vector3<T>(d[0] * d[1], d[0] * d[2], d[1] * d[2]);
+        }
+
+        Inertial<T> result(_inertials[0]);
+        if (mass <= 0)
+          return result;
+
+        // Parallel axis theorem about the origin, then back to the
+        // combined center of mass c: I = sum(m (|d|^2 E - d d^T)) -
+        // mass (|c|^2 E - c c^T), with the outer products summed above.
+        const Vector3<T> c = firstMoment / mass;
+        dd -= mass * Vector3<T>(c[0] * c[0], c[1] * c[1], c[2] * c[2]);
+        ddOff -= mass * Vector3<T>(c[0] * c[1], c[0] * c[2], c[1] * c[2]);
+        const Vector3<T> ixxyyzz(moi(0, 0) + dd[1] + dd[2],
+                                 moi(1, 1) + dd[2] + dd[0],
+                                 moi(2, 2) + dd[0] + dd[1]);
+        const Vector3<T> ixyxzyz(moi(0, 1) - ddOff[0],
+                                 moi(0, 2) - ddOff[1],
+                                 moi(1, 2) - ddOff[2]);
+        result.massMatrix = MassMatrix3<T>(mass, ixxyyzz, ixyxzyz);
+        result.pose = Pose3<T>(origin + c, Quaternion<T>::Identity);
+        return result;
+      }
+
+      /// \brief Express the inertia of many objects in the world frame,
+      /// such as the links of a model at every step of a simulation. The
+      /// result is the same as rotating Moi() by the rotation of each pose,
+      /// but the rotation matrices are computed without normalizing the
+      /// quaternions first, and only the six distinct terms of the
+      /// symmetric R * I * R^T are computed, without Matrix3 temporaries.
+      /// \param[in] _inertials Pointer to the inertials.
+      /// \param[in] _poses World pose of the frame of each inertial.
+      /// \param[out] _moi Inertia matrix of each object about its center of
+      /// mass, expressed in the world frame.
+      /// \param[out] _com World position of the center of mass of each
+      /// object. May be null.
+      /// \param[in] _count Number of objects.
+      public: static void ToWorld(const Inertial<T> *_inertials,
+                                  const Pose3<T> *_poses,
+                                  Matrix3<T> *_moi,
+                                  Vector3<T> *_com,
+                                  const std::size_t _count)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const Inertial<T> &inertial = _inertials[i];
+          T link[3][3];
+          RotationMatrix(_poses[i].Rot(), link);
+          if (_com)
+          {
+            const Vector3<T> &p = inertial.pose.Pos();
+            _com[i].Set(
+              _poses[i].Pos()[0] +
+                link[0][0] * p[0] + link[0][1] * p[1] + link[0][2] * p[2],
+              _poses[i].Pos()[1] +
+                link[1][0] * p[0] + link[1][1] * p[1] + link[1][2] * p[2],
+              _poses[i].Pos()[2] +
+                link[2][0] * p[0] + link[2][1] * p[1] + link[2][2] * p[2]);
+          }
+
+          // R = link rotation * center of mass frame rotation
+          T com[3][3];
+          RotationMatrix(inertial.pose.Rot(), com);
+          T r[3][3];
+          for (int k = 0; k < 3; ++k)
+          {
+            for (int j = 0; j < 3; ++j)
+            {
+              r[k][j] = link[k][0] * com[0][j] + link[k][1] * com[1][j] +
+                link[k][2] * com[2][j];
+            }
+          }
+
+          // Rows of A = R * I
+          const Vector3<T> d = inertial.massMatrix.DiagonalMoments();
+          const Vector3<T> o = inertial.massMatrix.OffDiagonalMoments();
+          T a[3][3];
+          for (int k = 0; k < 3; ++k)
+          {
+            a[k][0] = r[k][0] * d[0] + r[k][1] * o[0] + r[k][2] * o[1];
+            a[k][1] = r[k][0] * o[0] + r[k][1] * d[1] + r[k][2] * o[2];
+            a[k][2] = r[k][0] * o[1] + r[k][1] * o[2] + r[k][2] * d[2];
+          }
+
+          // Upper triangle of A * R^T
+          auto term = [&](const int _row, const int _col)
+          {
+            return a[_row][0] * r[_col][0] + a[_row][1] * r[_col][1] +
+              a[_row][2] * r[_col][2];
+          };
+          const T xy = term(0, 1);
+          const T xz = term(0, 2);
+          const T yz = term(1, 2);
+          _moi[i].Set(term(0, 0), xy, xz,
+                      xy, term(1, 1), yz,
+                      xz, yz, term(2, 2));
+        }
+      }
+
+      /// \brief Rotation matrix of a quaternion, as Matrix3(_q), but scaled
+      /// by the inverse squared norm instead of normalizing the quaternion.
+      /// \param[in] _q The quaternion.
+      /// \param[out] _r The rotation matrix, identity if _q is zero.
+      private: static void RotationMatrix(const Quaternion<T> &_q,
+                                          T (&_r)[3][3])
+      {
+        const T w = _q.W();
+        const T x = _q.X();
+        const T y = _q.Y();
+        const T z = _q.Z();
+        const T n = w * w + x * x + y * y + z * z;
+        const T s = n > 0 ? 2 / n : 0;
+        _r[0][0] = 1 - s * (y * y + z * z);
+        _r[0][1] = s * (x * y - z * w);
+        _r[0][2] = s * (x * z + y * w);
+        _r[1][0] = s * (x * y + z * w);
+        _r[1][1] = 1 - s * (x * x + z * z);
+        _r[1][2] = s * (y * z - x * w);
+        _r[2][0] = s * (x * z - y * w);
+        _r[2][1] = s * (y * z + x * w);
+        _r[2][2] = 1 - s * (x * x + y * y);
+      }
+
       /// \brief Mass and inertia matrix of the object expressed in the
       /// center of mass reference frame.
       private: MassMatrix3<T> massMatrix;
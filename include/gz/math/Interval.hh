@@ -18,6 +18,7 @@
 #define GZ_MATH_INTERVAL_HH_
 
 #include <cmath>
+#include <cstddef>
 #include <limits>
 #include <ostream>
 #include <type_traits>
@@ -163,6 +164,56 @@ namespace gz
         return this->leftValue < _value && _value < this->rightValue;
       }
 
+      /// \brief Get the closed interval [min, max] that holds the same
+      /// values as this interval. For floating point types, an open bound
+      /// is replaced by the next representable value inside the interval,
+      /// and for integer types by the next integer. Testing
+      /// min <= value && value <= max then gives the result of Contains
+      /// without checking whether the bounds are closed, which is what
+      /// loops over many values need to be vectorized. If the interval
+      /// holds no value, min is greater than max, or one of them is NaN.
+      /// \return The pair of bounds [min, max].
+      public: std::pair<T, T> ClosedBounds() const
+      {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+          return {this->leftClosed ? this->leftValue :
+                    std::nextafter(this->leftValue,
+                                   std::numeric_limits<T>::infinity()),
+                  this->rightClosed ? this->rightValue :
+                    std::nextafter(this->rightValue,
+                                   -std::numeric_limits<T>::infinity())};
+        }
+        else
+        {
+          if ((!this->leftClosed &&
+               this->leftValue == std::numeric_limits<T>::max()) ||
+              (!this->rightClosed &&
+               this->rightValue == std::numeric_limits<T>::lowest()))
+          {
+            return {std::numeric_limits<T>::max(),
+                    std::numeric_limits<T>::lowest()};
+          }
+          return {this->leftClosed ? this->leftValue :
+                    static_cast<T>(this->leftValue + 1),
+                  this->rightClosed ? this->rightValue :
+                    static_cast<T>(this->rightValue - 1)};
+        }
+      }
+
+      /// \brief Check which values of an array the interval contains.
+      /// This is much faster than calling Contains for each value.
+      /// \param[in] _values Values to check for membership.
+      /// \param[out] _result Whether each value is contained.
+      /// \param[in] _count Number of values.
+      public: void Contains(const T *_values, bool *_result,
+                            const std::size_t _count) const
+      {
+        const auto [min, max] = this->ClosedBounds();
+        for (std::size_t i = 0; i < _count; ++i)
+          _result[i] = (min <= _values[i]) & (_values[i] <= max);
+      }
+
       /// \brief Check if the interval contains `_other` interval
       /// \param[in] _other interval to check for membership
       /// \return true if it is contained, false otherwise
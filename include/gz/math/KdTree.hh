@@ -0,0 +1,451 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_KDTREE_HH_
+#define GZ_MATH_KDTREE_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+#include <gz/math/detail/ParallelFor.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class KdTree KdTree.hh gz/math/KdTree.hh
+    /// \brief A static KD-tree over a set of points, to find the points
+    /// nearest to a position or within a distance of it.
+    ///
+    /// The tree has no nodes: the points are reordered so that the point in
+    /// the middle of any range of the tree splits it, with the points
+    /// before it on the low side of its split plane and the points after
+    /// it on the high side. The split axis of each range is the longest
+    /// side of its bounding box. Ranges of at most kLeafSize points are not
+    /// split and are scanned in order. So the tree takes no memory besides
+    /// the points, their indices and one axis per point, and a query walks
+    /// a contiguous array.
+    ///
+    /// Points are identified by their index in the array given to Build.
+    /// The points must be finite.
+    ///
+    /// # Example usage
+    ///
+    /// ```{.cpp}
+    /// gz::math::KdTreed tree(points);
+    /// std::vector<std::size_t> ids;
+    /// std::vector<double> distances;
+    /// tree.Nearest(gz::math::Vector3d(1, 2, 3), 5, ids, distances);
+    /// ```
+    /// \tparam T Floating point type of the coordinates.
+    template<typename T>
+    class KdTree
+    {
+      static_assert(std::is_floating_point_v<T>,
+          "KdTree requires a floating point type");
+
+      /// \brief Largest number of points in a range that is not split.
+      public: static constexpr std::size_t kLeafSize = 8;
+
+      /// \brief Default constructor, an empty tree.
+      public: KdTree() = default;
+
+      /// \brief Construct a tree over a set of points.
+      /// \param[in] _points The points.
+      public: explicit KdTree(const std::vector<Vector3<T>> &_points)
+      {
+        this->Build(_points);
+      }
+
+      /// \brief Build the tree over a set of points, replacing its previous
+      /// contents. The resulting tree is the same for any thread count.
+      /// \param[in] _points The points.
+      /// \param[in] _count Number of points.
+      /// \param[in] _threads Maximum number of threads used to build
+      /// independent subtrees. Zero uses std::thread::hardware_concurrency.
+      public: void Build(const Vector3<T> *_points, const std::size_t _count,
+                         const unsigned int _threads = 1)
+      {
+        std::vector<Item> items(_count);
+        for (std::size_t i = 0; i < _count; ++i)
+          items[i] = {_points[i], i};
+        this->axes.assign(_count, 0);
+
+        this->BuildRange(items, 0, _count,
+            static_cast<unsigned int>(detail::ThreadCount(_threads)));
+
+        this->points.resize(_count);
+        this->ids.resize(_count);
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          this->points[i] = items[i].point;
+          this->ids[i] = items[i].id;
+        }
+      }
+
+      /// \brief Build the tree over a set of points, replacing its previous
+      /// contents.
+      /// \param[in] _points The points.
+      /// \param[in] _threads Maximum number of threads, see
+      /// Build(const Vector3<T> *, std::size_t, unsigned int).
+      public: void Build(const std::vector<Vector3<T>> &_points,
+                         const unsigned int _threads = 1)
+      {
+        this->Build(_points.data(), _points.size(), _threads);
+      }
+
+      /// \brief Remove all the points.
+      public: void Clear()
+      {
+        this->points.clear();
+        this->ids.clear();
+        this->axes.clear();
+      }
+
+      /// \brief Get the number of points.
+      /// \return Number of points.
+      public: std::size_t Size() const
+      {
+        return this->points.size();
+      }
+
+      /// \brief Get whether the tree has no points.
+      /// \return True if there are no points.
+      public: bool Empty() const
+      {
+        return this->points.empty();
+      }
+
+      /// \brief Find the point closest to a position.
+      /// \param[in] _position The position.
+      /// \param[out] _id Index of the closest point, the smallest one in
+      /// case of a tie.
+      /// \param[out] _distance Distance to the closest point.
+      /// \return False if the tree is empty.
+      public: bool Nearest(const Vector3<T> &_position, std::size_t &_id,
+                           T &_distance) const
+      {
+        return this->Nearest(_position, 1, &_id, &_distance) == 1;
+      }
+
+      /// \brief Find the points closest to a position.
+      /// \param[in] _position The position.
+      /// \param[in] _k Maximum number of points to find.
+      /// \param[out] _ids Indices of the closest points, from the closest
+      /// to the farthest, with ties ordered by index. It must hold _k
+      /// values.
+      /// \param[out] _distances Distances to the points in _ids. It must
+      /// hold _k values.
+      /// \return Number of points found, the smaller of _k and Size().
+      public: std::size_t Nearest(const Vector3<T> &_position,
+                                  const std::size_t _k, std::size_t *_ids,
+                                  T *_distances) const
+      {
+        std::size_t found = 0;
+        if (_k > 0)
+        {
+          this->SearchNearest(0, this->points.size(), _position, _k, _ids,
+                              _distances, found);
+        }
+        for (std::size_t i = 0; i < found; ++i)
+          _distances[i] = std::sqrt(_distances[i]);
+        return found;
+      }
+
+      /// \brief Find the points closest to a position.
+      /// \param[in] _position The position.
+      /// \param[in] _k Maximum number of points to find.
+      /// \param[out] _ids Indices of the closest points, from the closest
+      /// to the farthest, with ties ordered by index. It is cleared first.
+      /// \param[out] _distances Distances to the points in _ids. It is
+      /// cleared first.
+      public: void Nearest(const Vector3<T> &_position, const std::size_t _k,
+                           std::vector<std::size_t> &_ids,
+                           std::vector<T> &_distances) const
+      {
+        const std::size_t k = std::min(_k, this->points.size());
+        _ids.resize(k);
+        _distances.resize(k);
+        this->Nearest(_position, k, _ids.data(), _distances.data());
+      }
+
+      /// \brief Find the points closest to each position of an array.
+      /// \param[in] _positions The positions.
+      /// \param[in] _count Number of positions.
+      /// \param[in] _k Number of points to find for each position, at most
+      /// Size().
+      /// \param[out] _ids Indices of the closest points, _k per position
+      /// ordered as in Nearest(const Vector3<T> &, std::size_t,
+      /// std::size_t *, T *). It must hold _count * _k values.
+      /// \param[out] _distances Distances to the points in _ids. It must
+      /// hold _count * _k values.
+      /// \param[in] _threads Maximum number of threads, each one handling a
+      /// contiguous chunk of the positions. Zero uses
+      /// std::thread::hardware_concurrency.
+      /// \return False if _k is larger than Size().
+      public: bool NearestBatch(const Vector3<T> *_positions,
+                                const std::size_t _count,
+                                const std::size_t _k, std::size_t *_ids,
+                                T *_distances,
+                                const unsigned int _threads = 1) const
+      {
+        if (_k > this->points.size())
+          return false;
+
+        detail::ParallelFor(_count,
+            detail::ChunkCount(_count, _threads, kMinChunkSize),
+            [&](std::size_t, const std::size_t _begin, const std::size_t _end)
+        {
+          for (std::size_t i = _begin; i < _end; ++i)
+          {
+            this->Nearest(_positions[i], _k, _ids + i * _k,
+                          _distances + i * _k);
+          }
+        });
+        return true;
+      }
+
+      /// \brief Find the points within a distance of a position.
+      /// \param[in] _position The position.
+      /// \param[in] _distance Maximum distance.
+      /// \param[out] _ids Indices of the points, in no particular order. It
+      /// is cleared first.
+      public: void WithinDistance(const Vector3<T> &_position,
+                                  const T _distance,
+                                  std::vector<std::size_t> &_ids) const
+      {
+        _ids.clear();
+        if (!(_distance >= 0))
+          return;
+        this->SearchWithin(0, this->points.size(), _position,
+                           _distance * _distance, _ids);
+      }
+
+      /// \brief A point and its index, the unit reordered by Build.
+      private: struct Item
+      {
+        /// \brief The point.
+        Vector3<T> point;
+
+        /// \brief Index of the point in the array given to Build.
+        std::size_t id;
+      };
+
+      /// \brief Build the subtree of a range of points.
+      /// \param[in,out] _items Points being ordered.
+      /// \param[in] _begin First point of the range.
+      /// \param[in] _end End of the range.
+      /// \param[in] _threads Number of threads the subtree may use.
+      private: void BuildRange(std::vector<Item> &_items,
+                               const std::size_t _begin,
+                               const std::size_t _end,
+                               const unsigned int _threads)
+      {
+        if (_end - _begin <= kLeafSize)
+          return;
+
+        Vector3<T> min = _items[_begin].point;
+        Vector3<T> max = min;
+        for (std::size_t i = _begin + 1; i < _end; ++i)
+        {
+          min.Min(_items[i].point);
+          max.Max(_items[i].point);
+        }
+        const Vector3<T> size = max - min;
+        int axis = 0;
+        if (size.Y() > size[axis])
+          axis = 1;
+        if (size.Z() > size[axis])
+          axis = 2;
+
+        // Ties are ordered by index so the tree doesn't depend on the
+        // std::nth_element implementation details of equal keys.
+        const std::size_t mid = _begin + (_end - _begin) / 2;
+        std::nth_element(_items.begin() + _begin, _items.begin() + mid,
+            _items.begin() + _end, [axis](const Item &_a, const Item &_b)
+            {
+              return std::make_pair(_a.point[axis], _a.id) <
+                     std::make_pair(_b.point[axis], _b.id);
+            });
+        this->axes[mid] = static_cast<std::uint8_t>(axis);
+
+        if (_threads > 1 && _end - _begin >= kParallelThreshold)
+        {
+          const unsigned int lowThreads = _threads / 2;
+          auto future = std::async(std::launch::async, [&, lowThreads]()
+          {
+            this->BuildRange(_items, _begin, mid, lowThreads);
+          });
+          this->BuildRange(_items, mid + 1, _end, _threads - lowThreads);
+          future.get();
+        }
+        else
+        {
+          this->BuildRange(_items, _begin, mid, 1);
+          this->BuildRange(_items, mid + 1, _end, 1);
+        }
+      }
+
+      /// \brief Consider a point for the nearest points found so far.
+      /// \param[in] _index Index of the point in the tree.
+      /// \param[in] _position The query position.
+      /// \param[in] _k Maximum number of points to find.
+      /// \param[in,out] _ids Indices of the points found, sorted.
+      /// \param[in,out] _squared Squared distances of the points found.
+      /// \param[in,out] _found Number of points found.
+      private: void Consider(const std::size_t _index,
+                             const Vector3<T> &_position,
+                             const std::size_t _k, std::size_t *_ids,
+                             T *_squared, std::size_t &_found) const
+      {
+        const T d = (_position - this->points[_index]).SquaredLength();
+        const std::size_t id = this->ids[_index];
+        if (_found == _k &&
+            std::make_pair(d, id) > std::make_pair(_squared[_k - 1],
+                                                   _ids[_k - 1]))
+        {
+          return;
+        }
+
+        // Insertion into the sorted results, dropping the farthest one
+        // when full.
+        std::size_t i = _found < _k ? _found++ : _k - 1;
+        while (i > 0 &&
+               std::make_pair(d, id) < std::make_pair(_squared[i - 1],
+                                                      _ids[i - 1]))
+        {
+          _squared[i] = _squared[i - 1];
+          _ids[i] = _ids[i - 1];
+          --i;
+        }
+        _squared[i] = d;
+        _ids[i] = id;
+      }
+
+      /// \brief Search the nearest points in the subtree of a range.
+      /// \param[in] _begin First point of the range.
+      /// \param[in] _end End of the range.
+      /// \param[in] _position The query position.
+      /// \param[in] _k Maximum number of points to find.
+      /// \param[in,out] _ids Indices of the points found, sorted.
+      /// \param[in,out] _squared Squared distances of the points found.
+      /// \param[in,out] _found Number of points found.
+      private: void SearchNearest(const std::size_t _begin,
+                                  const std::size_t _end,
+                                  const Vector3<T> &_position,
+                                  const std::size_t _k, std::size_t *_ids,
+                                  T *_squared, std::size_t &_found) const
+      {
+        if (_end - _begin <= kLeafSize)
+        {
+          for (std::size_t i = _begin; i < _end; ++i)
+            this->Consider(i, _position, _k, _ids, _squared, _found);
+          return;
+        }
+
+        const std::size_t mid = _begin + (_end - _begin) / 2;
+        const int axis = this->axes[mid];
+        const T diff = _position[axis] - this->points[mid][axis];
+        if (diff < 0)
+          this->SearchNearest(_begin, mid, _position, _k, _ids, _squared,
+                              _found);
+        else
+          this->SearchNearest(mid + 1, _end, _position, _k, _ids, _squared,
+                              _found);
+
+        this->Consider(mid, _position, _k, _ids, _squared, _found);
+
+        // Points on the far side are at least |diff| away. Equal distances
+        // are still visited for the ties ordered by index.
+        if (_found < _k || diff * diff <= _squared[_k - 1])
+        {
+          if (diff < 0)
+            this->SearchNearest(mid + 1, _end, _position, _k, _ids,
+                                _squared, _found);
+          else
+            this->SearchNearest(_begin, mid, _position, _k, _ids, _squared,
+                                _found);
+        }
+      }
+
+      /// \brief Search the points within a distance in the subtree of a
+      /// range.
+      /// \param[in] _begin First point of the range.
+      /// \param[in] _end End of the range.
+      /// \param[in] _position The query position.
+      /// \param[in] _squared Squared maximum distance.
+      /// \param[in,out] _ids Indices of the points found.
+      private: void SearchWithin(const std::size_t _begin,
+                                 const std::size_t _end,
+                                 const Vector3<T> &_position,
+                                 const T _squared,
+                                 std::vector<std::size_t> &_ids) const
+      {
+        if (_end - _begin <= kLeafSize)
+        {
+          for (std::size_t i = _begin; i < _end; ++i)
+          {
+            if ((_position - this->points[i]).SquaredLength() <= _squared)
+              _ids.push_back(this->ids[i]);
+          }
+          return;
+        }
+
+        const std::size_t mid = _begin + (_end - _begin) / 2;
+        const int axis = this->axes[mid];
+        const T diff = _position[axis] - this->points[mid][axis];
+        if ((_position - this->points[mid]).SquaredLength() <= _squared)
+          _ids.push_back(this->ids[mid]);
+        if (diff <= 0 || diff * diff <= _squared)
+          this->SearchWithin(_begin, mid, _position, _squared, _ids);
+        if (diff >= 0 || diff * diff <= _squared)
+          this->SearchWithin(mid + 1, _end, _position, _squared, _ids);
+      }
+
+      /// \brief Subtrees with fewer points than this are built on the
+      /// calling thread.
+      private: static constexpr std::size_t kParallelThreshold = 1 << 14;
+
+      /// \brief Minimum number of positions per thread in NearestBatch.
+      private: static constexpr std::size_t kMinChunkSize = 1 << 10;
+
+      /// \brief The points, in tree order.
+      private: std::vector<Vector3<T>> points;
+
+      /// \brief Index of each point in the array given to Build.
+      private: std::vector<std::size_t> ids;
+
+      /// \brief Split axis of the ranges whose middle is each point.
+      private: std::vector<std::uint8_t> axes;
+    };
+
+    using KdTreed = KdTree<double>;
+    using KdTreef = KdTree<float>;
+    }
+  }
+}
+#endif
@@ -17,6 +17,7 @@
 #ifndef GZ_MATH_KMEANS_HH_
 #define GZ_MATH_KMEANS_HH_
 
+#include <cstddef>
 #include <vector>
 #include <gz/math/Vector3.hh>
 #include <gz/math/Helpers.hh>
@@ -38,25 +39,75 @@ namespace gz
     /// Description based on http://en.wikipedia.org/wiki/K-means_clustering.
     class GZ_MATH_VISIBLE Kmeans
     {
+      /// \brief Constructor without observations. Use Observations() to set
+      /// them, or ClusterBatch() to cluster a stream of observations.
+      public: Kmeans();
+
       /// \brief constructor
       /// \param[in] _obs Set of observations to cluster.
       public: explicit Kmeans(const std::vector<Vector3d> &_obs);
 
+      /// \brief Constructor taking ownership of the observations.
+      /// \param[in] _obs Set of observations to cluster, moved.
+      public: explicit Kmeans(std::vector<Vector3d> &&_obs);
+
       /// \brief Get the observations to cluster.
       /// \return The vector of observations.
       public: std::vector<Vector3d> Observations() const;
 
+      /// \brief Get the observations to cluster without copying them.
+      /// \return Reference to the observations, valid until they change.
+      public: const std::vector<Vector3d> &ObservationsRef() const;
+
       /// \brief Set the observations to cluster.
       /// \param[in] _obs The new vector of observations.
       /// \return True if the vector is not empty or false otherwise.
       public: bool Observations(const std::vector<Vector3d> &_obs);
 
+      /// \brief Set the observations to cluster, taking ownership of them
+      /// without copying.
+      /// \param[in] _obs The new vector of observations, moved unless it is
+      /// empty.
+      /// \return True if the vector is not empty or false otherwise.
+      public: bool Observations(std::vector<Vector3d> &&_obs);
+
       /// \brief Add observations to the cluster.
       /// \param[in] _obs Vector of observations.
       /// \return True if the _obs vector is not empty or false otherwise.
       public: bool AppendObservations(const std::vector<Vector3d> &_obs);
 
-      /// \brief Executes the k-means algorithm.
+      /// \brief Add an array of observations to the cluster.
+      /// \param[in] _obs Pointer to the first observation.
+      /// \param[in] _count Number of observations.
+      /// \return True if _count is not zero or false otherwise.
+      public: bool AppendObservations(const Vector3d *_obs, size_t _count);
+
+      /// \brief Reserve storage for a number of observations, so that
+      /// appending them in several calls doesn't reallocate.
+      /// \param[in] _count Total number of observations.
+      public: void Reserve(size_t _count);
+
+      /// \brief Set the maximum number of threads used by Cluster(). Each
+      /// thread handles a contiguous chunk of the observations and keeps its
+      /// own partition sums, merged once per iteration. Small sets of
+      /// observations use fewer threads. The default is 1.
+      /// \param[in] _threads Number of threads, zero for
+      /// std::thread::hardware_concurrency.
+      public: void Threads(unsigned int _threads);
+
+      /// \brief Get the maximum number of threads used by Cluster().
+      /// \return Number of threads, zero for
+      /// std::thread::hardware_concurrency.
+      public: unsigned int Threads() const;
+
+      /// \brief Executes the k-means algorithm. The initial centroids are
+      /// chosen with k-means++ seeding, which uses Rand, so call Rand::Seed()
+      /// first for repeatable results. Each iteration keeps bounds on the
+      /// distances from every observation to the centroids, and skips the
+      /// search for the closest centroid when the bounds show that the label
+      /// can't change. The partition sums are merged in a fixed order, so
+      /// results are repeatable for a given number of threads, but may
+      /// differ in rounding between numbers of threads.
       /// \param[in] _k Number of partitions to cluster.
       /// \param[out] _centroids Vector of centroids. Each element contains the
       /// centroid of one cluster.
@@ -71,6 +122,111 @@ namespace gz
                            std::vector<Vector3d> &_centroids,
                            std::vector<unsigned int> &_labels);
 
+      /// \brief Executes the k-means algorithm on observations owned by the
+      /// caller, ignoring the observations stored in this object. Nothing is
+      /// copied: the labels are written to a buffer of the caller, and the
+      /// centroids are available from Centroids(). Only the distance bounds,
+      /// two doubles per observation, are allocated.
+      /// \param[in] _k Number of partitions to cluster.
+      /// \param[in] _obs Pointer to the first observation. It must stay
+      /// valid during the call.
+      /// \param[in] _count Number of observations.
+      /// \param[out] _labels Pointer to the first of _count labels. Each
+      /// element is set to the cluster to which the observation belongs.
+      /// \return True when the operation succeed or false otherwise. The
+      /// operation will fail if there are no observations, if _labels is
+      /// null, if the number of clusters is non positive, or if the number
+      /// of clusters is greater than the number of observations.
+      /// \sa Cluster(int, std::vector<Vector3d> &,
+      /// std::vector<unsigned int> &)
+      public: bool Cluster(int _k, const Vector3d *_obs, size_t _count,
+                           unsigned int *_labels);
+
+      /// \brief Cluster the observations for every number of partitions
+      /// in a range, to choose it with the elbow method. The first number
+      /// is seeded with k-means++, and each following one starts from the
+      /// solution of the previous one plus a centroid chosen as in
+      /// k-means++, which converges in much fewer iterations than a new
+      /// seeding. The buffers are allocated once for the whole range. Each
+      /// number of partitions uses the threads set with Threads(). After
+      /// the call, Centroids() returns the centroids for _maxK.
+      /// \param[in] _minK Smallest number of partitions.
+      /// \param[in] _maxK Largest number of partitions.
+      /// \param[out] _inertias Resized to _maxK - _minK + 1. Element i is
+      /// the sum of the squared distances from the observations to their
+      /// centroids with _minK + i partitions.
+      /// \return True when the operation succeed or false otherwise. The
+      /// operation will fail if there are no observations, if _minK is non
+      /// positive, if _maxK is less than _minK, or if _maxK is greater than
+      /// the number of observations.
+      public: bool Sweep(int _minK, int _maxK,
+                         std::vector<double> &_inertias);
+
+      /// \brief Cluster observations owned by the caller for every number
+      /// of partitions in a range, ignoring the observations stored in
+      /// this object.
+      /// \param[in] _minK Smallest number of partitions.
+      /// \param[in] _maxK Largest number of partitions.
+      /// \param[in] _obs Pointer to the first observation. It must stay
+      /// valid during the call.
+      /// \param[in] _count Number of observations.
+      /// \param[out] _inertias Pointer to the first of _maxK - _minK + 1
+      /// inertias, see the function above.
+      /// \return True when the operation succeed or false otherwise. The
+      /// operation also fails if _inertias is null.
+      /// \sa Sweep(int, int, std::vector<double> &)
+      public: bool Sweep(int _minK, int _maxK, const Vector3d *_obs,
+                         size_t _count, double *_inertias);
+
+      /// \brief Update the centroids with a batch of observations, without
+      /// storing them, for unbounded streams of observations. This is
+      /// mini-batch k-means: every observation of the batch is assigned to
+      /// its closest centroid, then each centroid moves towards its
+      /// observations by the inverse of its accumulated weight.
+      ///
+      /// If there are already _k centroids, from Cluster() or a previous
+      /// batch, they are updated. Otherwise new centroids are chosen from
+      /// this batch with k-means++ seeding.
+      /// \param[in] _k Number of partitions to cluster.
+      /// \param[in] _batch Observations to add.
+      /// \param[out] _labels Partition of each observation of the batch.
+      /// \return True when the operation succeed or false otherwise. The
+      /// operation will fail if the batch is empty, if the number of clusters
+      /// is non positive, or if centroids have to be chosen and the number
+      /// of clusters is greater than the size of the batch.
+      /// \sa Decay()
+      public: bool ClusterBatch(int _k,
+                                const std::vector<Vector3d> &_batch,
+                                std::vector<unsigned int> &_labels);
+
+      /// \brief Update the centroids with a batch of observations, without
+      /// storing them.
+      /// \param[in] _k Number of partitions to cluster.
+      /// \param[in] _batch Observations to add.
+      /// \return True when the operation succeed or false otherwise.
+      /// \sa ClusterBatch(int, const std::vector<Vector3d> &,
+      /// std::vector<unsigned int> &)
+      public: bool ClusterBatch(int _k, const std::vector<Vector3d> &_batch);
+
+      /// \brief Get the current centroids, computed by the last call to
+      /// Cluster() or ClusterBatch().
+      /// \return The centroids, empty before any clustering.
+      public: const std::vector<Vector3d> &Centroids() const;
+
+      /// \brief Set how much the observations of previous batches weigh in
+      /// ClusterBatch(). Before each batch, the weight of every centroid is
+      /// multiplied by this factor. With 1, every observation ever seen
+      /// weighs the same and the centroids settle down. Smaller values
+      /// forget old observations, so the centroids follow data that changes
+      /// over time. The default is 1.
+      /// \param[in] _decay Decay factor in [0, 1].
+      /// \return True if the decay is valid or false otherwise.
+      public: bool Decay(double _decay);
+
+      /// \brief Get the decay factor used by ClusterBatch().
+      /// \return The decay factor.
+      public: double Decay() const;
+
       /// \brief Given an observation, it returns the closest centroid to it.
       /// \param[in] _p Point to check.
       /// \return The index of the closest centroid to the point _p.
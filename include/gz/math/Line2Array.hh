@@ -0,0 +1,410 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_LINE2ARRAY_HH_
+#define GZ_MATH_LINE2ARRAY_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <gz/math/Line2.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/config.hh>
+#include <gz/math/detail/ParallelFor.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class Line2Array Line2Array.hh gz/math/Line2Array.hh
+    /// \brief An array of two dimensional line segments for finding all
+    /// pairs of intersecting segments, such as the self intersections of a
+    /// polygon or the crossings of a set of lane boundaries.
+    ///
+    /// The segments are bucketed in a uniform grid sized from their
+    /// average extent, and only segments that share a cell and whose
+    /// bounding boxes overlap are tested with Line2::Intersect. Each pair
+    /// is tested in a single cell, the one holding the lower corner of the
+    /// overlap of the bounding boxes, so cells can be processed
+    /// independently and in parallel. The pairs found are the same as
+    /// testing every pair with Line2::Intersect.
+    ///
+    /// # Example
+    ///
+    /// \code{.cpp}
+    /// gz::math::Line2Arrayd edges(polygonEdges);
+    /// std::vector<gz::math::Line2Arrayd::Pair> crossings;
+    /// // Consecutive edges share a vertex, skip them
+    /// edges.Intersections(crossings, 2);
+    /// \endcode
+    template<typename T>
+    class Line2Array
+    {
+      /// \brief Maximum number of grid cells along each axis.
+      public: static constexpr std::size_t kMaxCellsPerAxis = 4096;
+
+      /// \brief A pair of intersecting segments.
+      public: struct Pair
+      {
+        /// \brief Index of the first segment, the smaller one.
+        std::size_t first;
+
+        /// \brief Index of the second segment.
+        std::size_t second;
+
+        /// \brief Point of intersection, as returned by Line2::Intersect
+        /// called on the first segment.
+        Vector2<T> point;
+      };
+
+      /// \brief Default constructor, creates an empty array.
+      public: Line2Array() = default;
+
+      /// \brief Constructor from segments.
+      /// \param[in] _lines Segments to copy.
+      public: explicit Line2Array(const std::vector<Line2<T>> &_lines)
+      {
+        this->Assign(_lines.data(), _lines.size());
+      }
+
+      /// \brief Replace the contents of this array.
+      /// \param[in] _lines Pointer to the first segment to copy.
+      /// \param[in] _count Number of segments to copy.
+      public: void Assign(const Line2<T> *_lines, const std::size_t _count)
+      {
+        this->lines.assign(_lines, _lines + _count);
+      }
+
+      /// \brief Get the number of segments.
+      /// \return The number of segments stored in this array.
+      public: std::size_t Size() const
+      {
+        return this->lines.size();
+      }
+
+      /// \brief Check whether the array is empty.
+      /// \return True if the array holds no segment.
+      public: bool Empty() const
+      {
+        return this->lines.empty();
+      }
+
+      /// \brief Get a segment.
+      /// \param[in] _index Index of the segment. It is not checked.
+      /// \return The segment.
+      public: const Line2<T> &Line(const std::size_t _index) const
+      {
+        return this->lines[_index];
+      }
+
+      /// \brief Find all pairs of intersecting segments, as defined by
+      /// Line2::Intersect. Segments with non finite coordinates are
+      /// ignored. The grid buffers are reused between calls, so this is
+      /// not const.
+      /// \param[out] _pairs The pairs, with the smaller index first, sorted
+      /// by index. It is cleared first, and its capacity is reused.
+      /// \param[in] _minIndexGap Only pairs whose indices differ by at
+      /// least this are considered. One considers all pairs, and two skips
+      /// consecutive segments, such as the edges of a polyline which share
+      /// their end points.
+      /// \param[in] _threads Maximum number of threads, each one handling
+      /// a band of grid cells. Zero uses std::thread::hardware_concurrency.
+      /// The pairs do not depend on the number of threads.
+      /// \param[in] _epsilon Tolerance passed to Line2::Intersect.
+      public: void Intersections(std::vector<Pair> &_pairs,
+                                 const std::size_t _minIndexGap = 1,
+                                 const unsigned int _threads = 1,
+                                 const double _epsilon = 1e-6)
+      {
+        _pairs.clear();
+        if (!this->BuildGrid(_epsilon))
+          return;
+
+        const std::size_t gap = std::max<std::size_t>(_minIndexGap, 1);
+        const std::size_t threads = detail::ChunkCount(this->Size(),
+            _threads, kMinSegmentsPerThread);
+
+        if (threads == 1)
+        {
+          this->CellRows(0, this->cellsY, gap, _epsilon, _pairs);
+        }
+        else
+        {
+          // Bands of rows with about the same number of cell entries
+          std::vector<std::size_t> bands(threads + 1, this->cellsY);
+          bands[0] = 0;
+          const std::size_t total = this->entries.size();
+          std::size_t band = 1;
+          for (std::size_t y = 0; y < this->cellsY && band < threads; ++y)
+          {
+            const std::size_t end = this->cellStart[(y + 1) * this->cellsX];
+            if (end * threads >= band * total)
+              bands[band++] = y + 1;
+          }
+
+          std::vector<std::vector<Pair>> results(threads);
+          detail::ParallelFor(threads, threads,
+              [&](const std::size_t _t, std::size_t, std::size_t)
+          {
+            this->CellRows(bands[_t], bands[_t + 1], gap, _epsilon,
+                           results[_t]);
+          });
+          for (const std::vector<Pair> &result : results)
+            _pairs.insert(_pairs.end(), result.begin(), result.end());
+        }
+
+        std::sort(_pairs.begin(), _pairs.end(),
+            [](const Pair &_a, const Pair &_b)
+            {
+              if (_a.first != _b.first)
+                return _a.first < _b.first;
+              return _a.second < _b.second;
+            });
+      }
+
+      /// \brief Minimum number of segments given to each thread.
+      private: static constexpr std::size_t kMinSegmentsPerThread = 1024;
+
+      /// \brief Bounding box of a segment, padded by the tolerance.
+      private: struct Bounds
+      {
+        /// \brief Minimum X coordinate.
+        double minX;
+
+        /// \brief Minimum Y coordinate.
+        double minY;
+
+        /// \brief Maximum X coordinate.
+        double maxX;
+
+        /// \brief Maximum Y coordinate.
+        double maxY;
+      };
+
+      /// \brief Get the column or row of the cell holding a coordinate.
+      /// \param[in] _value The coordinate.
+      /// \param[in] _origin Lower bound of the grid along the axis.
+      /// \param[in] _cells Number of cells along the axis.
+      /// \return The column or row, clamped to the grid.
+      private: std::size_t Cell(const double _value, const double _origin,
+                                const std::size_t _cells) const
+      {
+        const double cell = (_value - _origin) * this->inverseCellSize;
+        if (!(cell > 0))
+          return 0;
+        return std::min(static_cast<std::size_t>(cell), _cells - 1);
+      }
+
+      /// \brief Compute the bounds of the segments and bucket them into
+      /// the grid.
+      /// \param[in] _epsilon Padding of the bounds.
+      /// \return False if no segment has finite coordinates.
+      private: bool BuildGrid(const double _epsilon)
+      {
+        const std::size_t count = this->Size();
+        this->bounds.resize(count);
+        this->valid.assign(count, 0);
+
+        double minX = 0, minY = 0, maxX = 0, maxY = 0;
+        double extent = 0;
+        std::size_t validCount = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+          const Line2<T> &line = this->lines[i];
+          Bounds &b = this->bounds[i];
+          b.minX = std::min<double>(line[0].X(), line[1].X()) - _epsilon;
+          b.minY = std::min<double>(line[0].Y(), line[1].Y()) - _epsilon;
+          b.maxX = std::max<double>(line[0].X(), line[1].X()) + _epsilon;
+          b.maxY = std::max<double>(line[0].Y(), line[1].Y()) + _epsilon;
+          if (!std::isfinite(b.minX) || !std::isfinite(b.minY) ||
+              !std::isfinite(b.maxX) || !std::isfinite(b.maxY))
+          {
+            continue;
+          }
+          this->valid[i] = 1;
+          if (validCount++ == 0)
+          {
+            minX = b.minX;
+            minY = b.minY;
+            maxX = b.maxX;
+            maxY = b.maxY;
+          }
+          minX = std::min(minX, b.minX);
+          minY = std::min(minY, b.minY);
+          maxX = std::max(maxX, b.maxX);
+          maxY = std::max(maxY, b.maxY);
+          extent += std::max(b.maxX - b.minX, b.maxY - b.minY);
+        }
+        if (validCount == 0)
+          return false;
+
+        // Cells about as large as a segment, or with about one segment
+        // each when the segments are short compared to their spread
+        const double width = maxX - minX;
+        const double height = maxY - minY;
+        double cellSize = std::max(extent / validCount,
+            std::sqrt(width * height / validCount));
+        cellSize = std::max({cellSize, width / kMaxCellsPerAxis,
+                             height / kMaxCellsPerAxis});
+        if (!(cellSize > 0))
+          cellSize = 1;
+        this->inverseCellSize = 1.0 / cellSize;
+        this->originX = minX;
+        this->originY = minY;
+        this->cellsX = std::min(kMaxCellsPerAxis,
+            static_cast<std::size_t>(width * this->inverseCellSize) + 1);
+        this->cellsY = std::min(kMaxCellsPerAxis,
+            static_cast<std::size_t>(height * this->inverseCellSize) + 1);
+
+        // Counting sort of the segments into the cells their bounds cover,
+        // in increasing index order within each cell
+        this->cellStart.assign(this->cellsX * this->cellsY + 1, 0);
+        for (int pass = 0; pass < 2; ++pass)
+        {
+          if (pass == 1)
+          {
+            for (std::size_t c = 1; c < this->cellStart.size(); ++c)
+              this->cellStart[c] += this->cellStart[c - 1];
+            this->entries.resize(this->cellStart.back());
+          }
+          for (std::size_t i = 0; i < count; ++i)
+          {
+            if (!this->valid[i])
+              continue;
+            const Bounds &b = this->bounds[i];
+            const std::size_t x0 = this->Cell(b.minX, minX, this->cellsX);
+            const std::size_t x1 = this->Cell(b.maxX, minX, this->cellsX);
+            const std::size_t y0 = this->Cell(b.minY, minY, this->cellsY);
+            const std::size_t y1 = this->Cell(b.maxY, minY, this->cellsY);
+            for (std::size_t y = y0; y <= y1; ++y)
+            {
+              for (std::size_t x = x0; x <= x1; ++x)
+              {
+                const std::size_t c = y * this->cellsX + x;
+                if (pass == 0)
+                  ++this->cellStart[c + 1];
+                else
+                  this->entries[this->cellStart[c]++] = i;
+              }
+            }
+          }
+        }
+        // The second pass moved each start to the next cell's start
+        for (std::size_t c = this->cellStart.size() - 1; c > 0; --c)
+          this->cellStart[c] = this->cellStart[c - 1];
+        this->cellStart[0] = 0;
+        return true;
+      }
+
+      /// \brief Find the intersecting pairs owned by a band of cell rows.
+      /// \param[in] _beginY First row.
+      /// \param[in] _endY One past the last row.
+      /// \param[in] _gap Minimum difference of the indices of a pair.
+      /// \param[in] _epsilon Tolerance passed to Line2::Intersect.
+      /// \param[out] _pairs Pairs found are appended to it.
+      private: void CellRows(const std::size_t _beginY,
+                             const std::size_t _endY, const std::size_t _gap,
+                             const double _epsilon,
+                             std::vector<Pair> &_pairs) const
+      {
+        Vector2<T> point;
+        for (std::size_t y = _beginY; y < _endY; ++y)
+        {
+          for (std::size_t x = 0; x < this->cellsX; ++x)
+          {
+            const std::size_t c = y * this->cellsX + x;
+            const std::size_t begin = this->cellStart[c];
+            const std::size_t end = this->cellStart[c + 1];
+            for (std::size_t a = begin; a < end; ++a)
+            {
+              const std::size_t i = this->entries[a];
+              const Bounds &bi = this->bounds[i];
+              for (std::size_t b = a + 1; b < end; ++b)
+              {
+                const std::size_t j = this->entries[b];
+                if (j - i < _gap)
+                  continue;
+                const Bounds &bj = this->bounds[j];
+                if (bi.minX > bj.maxX || bj.minX > bi.maxX ||
+                    bi.minY > bj.maxY || bj.minY > bi.maxY)
+                {
+                  continue;
+                }
+
+                // Only the cell holding the lower corner of the overlap
+                // tests the pair
+                if (this->Cell(std::max(bi.minX, bj.minX), this->originX,
+                               this->cellsX) != x ||
+                    this->Cell(std::max(bi.minY, bj.minY), this->originY,
+                               this->cellsY) != y)
+                {
+                  continue;
+                }
+
+                if (this->lines[i].Intersect(this->lines[j], point,
+                                             _epsilon))
+                {
+                  _pairs.push_back({i, j, point});
+                }
+              }
+            }
+          }
+        }
+      }
+
+      /// \brief The segments.
+      private: std::vector<Line2<T>> lines;
+
+      /// \brief Padded bounds of the segments.
+      private: std::vector<Bounds> bounds;
+
+      /// \brief 1 for segments with finite bounds, 0 otherwise.
+      private: std::vector<unsigned char> valid;
+
+      /// \brief Index of the first entry of each cell, and the number of
+      /// entries at the end. Cells are stored row by row.
+      private: std::vector<std::size_t> cellStart;
+
+      /// \brief Indices of the segments in each cell.
+      private: std::vector<std::size_t> entries;
+
+      /// \brief Lower X bound of the grid.
+      private: double originX = 0;
+
+      /// \brief Lower Y bound of the grid.
+      private: double originY = 0;
+
+      /// \brief Inverse of the size of a cell.
+      private: double inverseCellSize = 1;
+
+      /// \brief Number of cells along X.
+      private: std::size_t cellsX = 0;
+
+      /// \brief Number of cells along Y.
+      private: std::size_t cellsY = 0;
+    };
+
+    using Line2Arrayd = Line2Array<double>;
+    using Line2Arrayf = Line2Array<float>;
+    }
+  }
+}
+#endif
@@ -0,0 +1,471 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_LINE3ARRAY_HH_
+#define GZ_MATH_LINE3ARRAY_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <gz/math/Line3.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class Line3Array Line3Array.hh gz/math/Line3Array.hh
+    /// \brief A structure-of-arrays container of line segments for closest
+    /// point queries between many segments, such as the capsules of a
+    /// collision model or the links of a cable.
+    ///
+    /// Each segment is stored as its start point and the vector to its end
+    /// point, with every component in its own contiguous buffer. The
+    /// queries compute the closest points of blocks of kBlockSize segments
+    /// with a branch free loop, which the compiler turns into SIMD code for
+    /// the target architecture.
+    ///
+    /// Unlike Line3::Distance, the closest points are exact for segments:
+    /// both parameters are clamped to the segments, and a segment of zero
+    /// length is treated as a point.
+    ///
+    /// # Example
+    ///
+    /// \code{.cpp}
+    /// gz::math::Line3Arrayd links(cable);
+    /// std::vector<gz::math::Line3Arrayd::Pair> contacts;
+    /// // The 10 closest pairs of links that are not neighbours
+    /// links.ClosestPairs(10, 2, contacts);
+    /// \endcode
+    template<typename T>
+    class Line3Array
+    {
+      /// \brief Number of segments processed together by the queries.
+      public: static constexpr std::size_t kBlockSize = 8;
+
+      /// \brief A pair of segments and the distance between them.
+      public: struct Pair
+      {
+        /// \brief Index of the segment of the first array.
+        std::size_t first;
+
+        /// \brief Index of the segment of the second array.
+        std::size_t second;
+
+        /// \brief Distance between the segments.
+        T distance;
+      };
+
+      /// \brief Default constructor, creates an empty array.
+      public: Line3Array() = default;
+
+      /// \brief Constructor from segments.
+      /// \param[in] _lines Segments to copy.
+      public: explicit Line3Array(const std::vector<Line3<T>> &_lines)
+      {
+        this->Assign(_lines.data(), _lines.size());
+      }
+
+      /// \brief Replace the contents of this array.
+      /// \param[in] _lines Pointer to the first segment to copy.
+      /// \param[in] _count Number of segments to copy.
+      public: void Assign(const Line3<T> *_lines, const std::size_t _count)
+      {
+        this->count = _count;
+        const std::size_t padded = _count > 0 ? _count + kBlockSize - 1 : 0;
+        for (std::vector<T> *buffer : {&this->ax, &this->ay, &this->az,
+                                       &this->dx, &this->dy, &this->dz})
+        {
+          buffer->assign(padded, 0);
+        }
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const Vector3<T> dir = _lines[i][1] - _lines[i][0];
+          this->ax[i] = _lines[i][0].X();
+          this->ay[i] = _lines[i][0].Y();
+          this->az[i] = _lines[i][0].Z();
+          this->dx[i] = dir.X();
+          this->dy[i] = dir.Y();
+          this->dz[i] = dir.Z();
+        }
+      }
+
+      /// \brief Get the number of segments.
+      /// \return The number of segments stored in this array.
+      public: std::size_t Size() const
+      {
+        return this->count;
+      }
+
+      /// \brief Check whether the array is empty.
+      /// \return True if the array holds no segment.
+      public: bool Empty() const
+      {
+        return this->count == 0;
+      }
+
+      /// \brief Get a segment.
+      /// \param[in] _index Index of the segment. It is not checked.
+      /// \return The segment.
+      public: Line3<T> Line(const std::size_t _index) const
+      {
+        const Vector3<T> start = this->Start(_index);
+        return Line3<T>(start, start + this->Dir(_index));
+      }
+
+      /// \brief Get the distance from a segment to every segment of this
+      /// array.
+      /// \param[in] _line Segment to measure from.
+      /// \param[out] _distances Distance to each segment of this array.
+      public: void Distances(const Line3<T> &_line,
+                             std::vector<T> &_distances) const
+      {
+        _distances.resize(this->Size());
+        T s[kBlockSize];
+        T t[kBlockSize];
+        T dist2[kBlockSize];
+        for (std::size_t begin = 0; begin < this->Size(); begin += kBlockSize)
+        {
+          this->BlockClosest(_line[0], _line[1] - _line[0], begin, s, t,
+                             dist2);
+          const std::size_t n = std::min(kBlockSize, this->Size() - begin);
+          for (std::size_t k = 0; k < n; ++k)
+            _distances[begin + k] = std::sqrt(dist2[k]);
+        }
+      }
+
+      /// \brief Find the segment of this array closest to a segment.
+      /// \param[in] _line Segment to measure from.
+      /// \param[out] _index Index of the closest segment.
+      /// \param[out] _result The shortest segment from the closest segment
+      /// of this array to _line.
+      /// \return False if the array is empty.
+      public: bool Closest(const Line3<T> &_line, std::size_t &_index,
+                           Line3<T> &_result) const
+      {
+        const Vector3<T> dir = _line[1] - _line[0];
+        T s[kBlockSize];
+        T t[kBlockSize];
+        T dist2[kBlockSize];
+        T best = 0;
+        T bestS = 0;
+        T bestT = 0;
+        bool found = false;
+        for (std::size_t begin = 0; begin < this->Size(); begin += kBlockSize)
+        {
+          this->BlockClosest(_line[0], dir, begin, s, t, dist2);
+          const std::size_t n = std::min(kBlockSize, this->Size() - begin);
+          for (std::size_t k = 0; k < n; ++k)
+          {
+            if (!found || dist2[k] < best)
+            {
+              found = true;
+              best = dist2[k];
+              bestS = s[k];
+              bestT = t[k];
+              _index = begin + k;
+            }
+          }
+        }
+
+        if (found)
+        {
+          _result.Set(this->Start(_index) + this->Dir(_index) * bestS,
+                      _line[0] + dir * bestT);
+        }
+        return found;
+      }
+
+      /// \brief Find the closest pairs made of a segment of this array and
+      /// a segment of another array.
+      /// \param[in] _other Array of the second segments of the pairs.
+      /// \param[in] _k Maximum number of pairs to return.
+      /// \param[out] _pairs The _k closest pairs, sorted by increasing
+      /// distance, and then by index. It is cleared first.
+      public: void ClosestPairs(const Line3Array<T> &_other,
+                                const std::size_t _k,
+                                std::vector<Pair> &_pairs) const
+      {
+        _pairs.clear();
+        for (std::size_t j = 0; j < _other.Size(); ++j)
+          this->AddClosestPairs(_other, j, this->Size(), _k, _pairs);
+        this->SortPairs(_pairs);
+      }
+
+      /// \brief Find the closest pairs of different segments of this array.
+      /// \param[in] _k Maximum number of pairs to return.
+      /// \param[in] _minIndexGap Only pairs whose indices differ by at
+      /// least this are considered. One considers all pairs, and two skips
+      /// consecutive segments, such as the links of a cable which touch
+      /// their neighbours.
+      /// \param[out] _pairs The _k closest pairs, with the smaller index
+      /// first, sorted by increasing distance, and then by index. It is
+      /// cleared first.
+      public: void ClosestPairs(const std::size_t _k,
+                                const std::size_t _minIndexGap,
+                                std::vector<Pair> &_pairs) const
+      {
+        _pairs.clear();
+        const std::size_t gap = std::max<std::size_t>(_minIndexGap, 1);
+        for (std::size_t j = gap; j < this->Size(); ++j)
+          this->AddClosestPairs(*this, j, j - gap + 1, _k, _pairs);
+        this->SortPairs(_pairs);
+      }
+
+      /// \brief Get the start point of a segment.
+      /// \param[in] _index Index of the segment.
+      /// \return The start point.
+      private: Vector3<T> Start(const std::size_t _index) const
+      {
+        return Vector3<T>(this->ax[_index], this->ay[_index],
+                          this->az[_index]);
+      }
+
+      /// \brief Get the vector from the start to the end of a segment.
+      /// \param[in] _index Index of the segment.
+      /// \return The vector.
+      private: Vector3<T> Dir(const std::size_t _index) const
+      {
+        return Vector3<T>(this->dx[_index], this->dy[_index],
+                          this->dz[_index]);
+      }
+
+      /// \brief Order of the pairs, by distance and then by index.
+      /// \param[in] _a First pair.
+      /// \param[in] _b Second pair.
+      /// \return True if _a comes before _b.
+      private: static bool PairLess(const Pair &_a, const Pair &_b)
+      {
+        if (_a.distance < _b.distance)
+          return true;
+        if (_b.distance < _a.distance)
+          return false;
+        if (_a.first != _b.first)
+          return _a.first < _b.first;
+        return _a.second < _b.second;
+      }
+
+      /// \brief Add the pairs of a segment of another array and the
+      /// segments [0, _end) of this array to a max-heap of at most _k
+      /// pairs, with the squared distances.
+      /// \param[in] _other Array of the segment.
+      /// \param[in] _index Index of the segment in _other.
+      /// \param[in] _end One past the last segment of this array.
+      /// \param[in] _k Maximum number of pairs.
+      /// \param[in,out] _heap Heap of the closest pairs so far.
+      private: void AddClosestPairs(const Line3Array<T> &_other,
+                                    const std::size_t _index,
+                                    const std::size_t _end,
+                                    const std::size_t _k,
+                                    std::vector<Pair> &_heap) const
+      {
+        if (_k == 0)
+          return;
+        const std::size_t end = std::min(_end, this->Size());
+        const Vector3<T> start = _other.Start(_index);
+        const Vector3<T> dir = _other.Dir(_index);
+        T s[kBlockSize];
+        T t[kBlockSize];
+        T dist2[kBlockSize];
+        for (std::size_t begin = 0; begin < end; begin += kBlockSize)
+        {
+          this->BlockClosest(start, dir, begin, s, t, dist2);
+          const std::size_t n = std::min(kBlockSize, end - begin);
+          for (std::size_t k = 0; k < n; ++k)
+          {
+            const Pair pair{begin + k, _index, dist2[k]};
+            if (_heap.size() < _k)
+            {
+              _heap.push_back(pair);
+              std::push_heap(_heap.begin(), _heap.end(), PairLess);
+            }
+            else if (PairLess(pair, _heap.front()))
+            {
+              std::pop_heap(_heap.begin(), _heap.end(), PairLess);
+              _heap.back() = pair;
+              std::push_heap(_heap.begin(), _heap.end(), PairLess);
+            }
+          }
+        }
+      }
+
+      /// \brief Sort a heap of pairs and turn the squared distances into
+      /// distances.
+      /// \param[in,out] _pairs Heap of pairs.
+      private: static void SortPairs(std::vector<Pair> &_pairs)
+      {
+        std::sort_heap(_pairs.begin(), _pairs.end(), PairLess);
+        for (Pair &pair : _pairs)
+          pair.distance = std::sqrt(pair.distance);
+      }
+
+      /// \brief Clamp a value to [0, 1].
+      /// \param[in] _x Value to clamp.
+      /// \return The clamped value.
+      private: static T Clamp01(const T _x)
+      {
+        return _x < 0 ? T(0) : (_x > 1 ? T(1) : _x);
+      }
+
+      /// \brief Closest points between a segment and a block of segments
+      /// of this array, following Ericson, Real-Time Collision Detection,
+      /// section 5.1.9.
+      ///
+      /// Every case is computed and the right one selected, so that the
+      /// loops have no branch. The clamped values are only stored by the
+      /// loop that computes them and selected between by the next one, so
+      /// that the compiler does not move arithmetic into the branches of
+      /// the clamps, which would keep it from vectorizing the loops. The
+      /// divisors are offset by the smallest normal number instead of
+      /// being tested for zero. A segment of zero length then gets s = 0,
+      /// and parallel segments get s = 0 or 1 before t is clamped, which
+      /// still gives their distance. The fixed trip count and the local
+      /// arrays let the loops be vectorized without runtime checks.
+      /// \param[in] _start Start point of the segment.
+      /// \param[in] _dir Vector from the start to the end of the segment.
+      /// \param[in] _begin Index of the first segment of the block.
+      /// \param[out] _s Parameter of the closest point on each segment of
+      /// the block, in [0, 1].
+      /// \param[out] _t Parameter of the closest point on the segment, in
+      /// [0, 1].
+      /// \param[out] _dist2 Squared distance between the closest points.
+      private: void BlockClosest(const Vector3<T> &_start,
+                                 const Vector3<T> &_dir,
+                                 const std::size_t _begin,
+                                 T (&_s)[kBlockSize],
+                                 T (&_t)[kBlockSize],
+                                 T (&_dist2)[kBlockSize]) const
+      {
+        const T tiny = std::numeric_limits<T>::min();
+        const T px = _start.X();
+        const T py = _start.Y();
+        const T pz = _start.Z();
+        const T qx = _dir.X();
+        const T qy = _dir.Y();
+        const T qz = _dir.Z();
+        const T e = _dir.SquaredLength();
+        const T *axs = this->ax.data() + _begin;
+        const T *ays = this->ay.data() + _begin;
+        const T *azs = this->az.data() + _begin;
+        const T *dxs = this->dx.data() + _begin;
+        const T *dys = this->dy.data() + _begin;
+        const T *dzs = this->dz.data() + _begin;
+        T sOut[kBlockSize];
+        T tOut[kBlockSize];
+        T dist2Out[kBlockSize];
+
+        if (e > 0)
+        {
+          // Dot products and clamped candidates for s
+          T bs[kBlockSize];
+          T fs[kBlockSize];
+          T sLine[kBlockSize];
+          T sLow[kBlockSize];
+          T sHigh[kBlockSize];
+          for (std::size_t k = 0; k < kBlockSize; ++k)
+          {
+            const T rx = axs[k] - px;
+            const T ry = ays[k] - py;
+            const T rz = azs[k] - pz;
+            const T a = dxs[k] * dxs[k] + dys[k] * dys[k] + dzs[k] * dzs[k];
+            const T b = dxs[k] * qx + dys[k] * qy + dzs[k] * qz;
+            const T c = dxs[k] * rx + dys[k] * ry + dzs[k] * rz;
+            const T f = qx * rx + qy * ry + qz * rz;
+            const T denom = std::abs(a * e - b * b) + tiny;
+            bs[k] = b;
+            fs[k] = f;
+            sLine[k] = Clamp01((b * f - c * e) / denom);
+            sLow[k] = Clamp01(-c / (a + tiny));
+            sHigh[k] = Clamp01((b - c) / (a + tiny));
+          }
+
+          // t for the closest point of the lines, and s recomputed if t
+          // has to be clamped
+          T tLine[kBlockSize];
+          for (std::size_t k = 0; k < kBlockSize; ++k)
+          {
+            const T t = (bs[k] * sLine[k] + fs[k]) / e;
+            sOut[k] = t < 0 ? sLow[k] : (t > 1 ? sHigh[k] : sLine[k]);
+            tLine[k] = t;
+          }
+          for (std::size_t k = 0; k < kBlockSize; ++k)
+            tOut[k] = Clamp01(tLine[k]);
+        }
+        else
+        {
+          // The segment is a point
+          for (std::size_t k = 0; k < kBlockSize; ++k)
+          {
+            const T rx = axs[k] - px;
+            const T ry = ays[k] - py;
+            const T rz = azs[k] - pz;
+            const T a = dxs[k] * dxs[k] + dys[k] * dys[k] + dzs[k] * dzs[k];
+            const T c = dxs[k] * rx + dys[k] * ry + dzs[k] * rz;
+            sOut[k] = Clamp01(-c / (a + tiny));
+            tOut[k] = 0;
+          }
+        }
+
+        for (std::size_t k = 0; k < kBlockSize; ++k)
+        {
+          const T vx = axs[k] - px + dxs[k] * sOut[k] - qx * tOut[k];
+          const T vy = ays[k] - py + dys[k] * sOut[k] - qy * tOut[k];
+          const T vz = azs[k] - pz + dzs[k] * sOut[k] - qz * tOut[k];
+          dist2Out[k] = vx * vx + vy * vy + vz * vz;
+        }
+        std::copy(sOut, sOut + kBlockSize, _s);
+        std::copy(tOut, tOut + kBlockSize, _t);
+        std::copy(dist2Out, dist2Out + kBlockSize, _dist2);
+      }
+
+      /// \brief Number of segments, without the padding.
+      private: std::size_t count = 0;
+
+      /// \brief The x components of the start points.
+      private: std::vector<T> ax;
+
+      /// \brief The y components of the start points.
+      private: std::vector<T> ay;
+
+      /// \brief The z components of the start points.
+      private: std::vector<T> az;
+
+      /// \brief The x components of the vectors from the start to the end
+      /// points.
+      private: std::vector<T> dx;
+
+      /// \brief The y components of the vectors from the start to the end
+      /// points.
+      private: std::vector<T> dy;
+
+      /// \brief The z components of the vectors from the start to the end
+      /// points.
+      private: std::vector<T> dz;
+    };
+
+    typedef Line3Array<double> Line3Arrayd;
+    typedef Line3Array<float> Line3Arrayf;
+    }
+  }
+}
+#endif
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_LOOPTIMER_HH_
+#define GZ_MATH_LOOPTIMER_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <gz/math/Export.hh>
+#include <gz/math/Stopwatch.hh>
+#include <gz/math/config.hh>
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    /// \class LoopTimer LoopTimer.hh gz/math/LoopTimer.hh
+    /// \brief Timing statistics of a periodic loop, such as a control loop:
+    /// the period between the starts of consecutive iterations, its jitter
+    /// relative to the nominal period, the execution time of each iteration
+    /// and the number of iterations that overran their deadline.
+    ///
+    /// The times are read from the same steady clock as Stopwatch, with
+    /// nanosecond resolution. The jitter and the execution times are
+    /// summarized with SignalQuantile digests and maxima over a rolling
+    /// window of iterations, so the memory used doesn't grow with the
+    /// number of iterations. The window is kept as two halves: the statistics
+    /// cover the last window size iterations and at most as many before
+    /// them, and the older half is dropped each time the newer one fills
+    /// up.
+    ///
+    /// Recording an iteration reads the clock twice and adds two samples to
+    /// the digests, so the timer can be left on in production. The
+    /// quantiles are only computed when queried.
+    ///
+    /// **Example Usage**
+    ///
+    /// \code{.cpp}
+    /// gz::math::LoopTimer timer(std::chrono::milliseconds(1));
+    /// while (running)
+    /// {
+    ///   timer.Begin();
+    ///   // ... Control step
+    ///   timer.End();
+    ///   // ... Sleep until the next period
+    /// }
+    /// double p99 = timer.JitterQuantile(0.99);
+    /// \endcode
+    class GZ_MATH_VISIBLE LoopTimer
+    {
+      /// \brief Constructor.
+      /// \param[in] _period Nominal period of the loop. The deadline of each
+      /// iteration is initially the period.
+      /// \param[in] _windowSize Number of iterations in each half of the
+      /// rolling window. Zero is treated as one.
+      public: explicit LoopTimer(const clock::duration &_period,
+                                 std::size_t _windowSize = 1000);
+
+      /// \brief Get the nominal period.
+      /// \return The nominal period.
+      public: clock::duration Period() const;
+
+      /// \brief Set the largest execution time of an iteration before it
+      /// counts as a deadline miss.
+      /// \param[in] _deadline The deadline, relative to Begin().
+      public: void SetDeadline(const clock::duration &_deadline);
+
+      /// \brief Get the deadline of the iterations.
+      /// \return The deadline, relative to Begin().
+      public: clock::duration Deadline() const;
+
+      /// \brief Get the number of iterations in each half of the rolling
+      /// window.
+      /// \return The window size.
+      public: std::size_t WindowSize() const;
+
+      /// \brief Mark the start of an iteration at the current time.
+      public: void Begin();
+
+      /// \brief Mark the start of an iteration.
+      /// \param[in] _time Start time of the iteration.
+      public: void Begin(const clock::time_point &_time);
+
+      /// \brief Mark the end of the current iteration at the current time.
+      /// \return The execution time of the iteration, zero if Begin() wasn't
+      /// called.
+      public: clock::duration End();
+
+      /// \brief Mark the end of the current iteration.
+      /// \param[in] _time End time of the iteration.
+      /// \return The execution time of the iteration, zero if Begin() wasn't
+      /// called.
+      public: clock::duration End(const clock::time_point &_time);
+
+      /// \brief Forget all the iterations recorded so far.
+      public: void Reset();
+
+      /// \brief Get the number of iterations started since the construction
+      /// or the last Reset().
+      /// \return Number of iterations.
+      public: uint64_t Iterations() const;
+
+      /// \brief Get the number of iterations whose execution time exceeded
+      /// the deadline, since the construction or the last Reset().
+      /// \return Number of deadline misses.
+      public: uint64_t DeadlineMisses() const;
+
+      /// \brief Get the period of the last iteration, measured between the
+      /// starts of the last two iterations.
+      /// \return The last period, zero before the second iteration.
+      public: clock::duration LastPeriod() const;
+
+      /// \brief Get the mean period over the rolling window.
+      /// \return The mean period in seconds, 0 before the second iteration.
+      public: double PeriodMean() const;
+
+      /// \brief Get the largest jitter over the rolling window. The jitter
+      /// of an iteration is the absolute difference between its period and
+      /// the nominal period.
+      /// \return The largest jitter in seconds, 0 before the second
+      /// iteration.
+      public: double JitterMax() const;
+
+      /// \brief Estimate a quantile of the jitter over the rolling window.
+      /// \param[in] _quantile Quantile in [0, 1], for example 0.99.
+      /// \return The estimated jitter in seconds, 0 before the second
+      /// iteration.
+      public: double JitterQuantile(double _quantile) const;
+
+      /// \brief Get the largest execution time over the rolling window.
+      /// \return The largest execution time in seconds, 0 before the first
+      /// call to End().
+      public: double ExecutionTimeMax() const;
+
+      /// \brief Estimate a quantile of the execution time over the rolling
+      /// window.
+      /// \param[in] _quantile Quantile in [0, 1], for example 0.99.
+      /// \return The estimated execution time in seconds, 0 before the
+      /// first call to End().
+      public: double ExecutionTimeQuantile(double _quantile) const;
+
+      /// \brief Private data pointer.
+      GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+    };
+    }
+  }
+}
+#endif
@@ -18,11 +18,15 @@
 #define GZ_MATH_MASSMATRIX3_HH_
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <string>
 #include <vector>
 
 #include <gz/math/config.hh>
+#include <gz/math/Profiler.hh>
+#include <gz/math/detail/ParallelFor.hh>
 #include "gz/math/Helpers.hh"
 #include "gz/math/Material.hh"
 #include "gz/math/Quaternion.hh"
@@ -468,20 +472,102 @@ namespace gz
       /// they are returned in the existing order.
       /// Otherwise, the moments are sorted from smallest to largest.
       public: Vector3<T> PrincipalMoments(const T _tol = 1e-6) const
+      {
+        GZ_MATH_PROFILE_ZONE("MassMatrix3::PrincipalMoments");
+        return PrincipalMoments(this->Ixxyyzz, this->Ixyxzyz, _tol);
+      }
+
+      /// \brief Flag set by Validate() if IsNearPositive() is true.
+      public: static constexpr std::uint8_t kNearPositive = 1;
+
+      /// \brief Flag set by Validate() if IsPositive() is true.
+      public: static constexpr std::uint8_t kPositive = 2;
+
+      /// \brief Flag set by Validate() if ValidMoments() is true for the
+      /// principal moments.
+      public: static constexpr std::uint8_t kValidMoments = 4;
+
+      /// \brief Flags set by Validate() if IsValid() is true.
+      public: static constexpr std::uint8_t kValid =
+        kNearPositive | kValidMoments;
+
+      /// \brief Check the validity of many mass matrices given by arrays
+      /// of their components, such as all the links of a world being
+      /// loaded. The principal moments of each matrix are computed once
+      /// and the results are the same as IsNearPositive(), IsPositive(),
+      /// ValidMoments() and IsValid() called on each matrix.
+      /// \param[in] _mass Mass of each matrix.
+      /// \param[in] _ixx Ixx of each matrix.
+      /// \param[in] _iyy Iyy of each matrix.
+      /// \param[in] _izz Izz of each matrix.
+      /// \param[in] _ixy Ixy of each matrix.
+      /// \param[in] _ixz Ixz of each matrix.
+      /// \param[in] _iyz Iyz of each matrix.
+      /// \param[out] _flags kNearPositive, kPositive and kValidMoments bits
+      /// of each matrix. A matrix is valid if both kValid bits are set.
+      /// \param[in] _count Number of matrices.
+      /// \param[in] _tolerance Tolerance passed to Epsilon().
+      /// \return Number of valid matrices.
+      public: static std::size_t Validate(const T *_mass,
+                  const T *_ixx, const T *_iyy, const T *_izz,
+                  const T *_ixy, const T *_ixz, const T *_iyz,
+                  std::uint8_t *_flags, const std::size_t _count,
+                  const T _tolerance = GZ_MASSMATRIX3_DEFAULT_TOLERANCE<T>)
+      {
+        std::size_t valid = 0;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const Vector3<T> diagonal(_ixx[i], _iyy[i], _izz[i]);
+          const Vector3<T> offDiagonal(_ixy[i], _ixz[i], _iyz[i]);
+          const T epsilon = Epsilon(diagonal, _tolerance);
+          // As in IsPositive(), for the same rounding
+          const auto minor = _ixx[i] * _iyy[i] - std::pow(_ixy[i], 2);
+          const T det = Matrix3<T>(
+            _ixx[i], _ixy[i], _ixz[i],
+            _ixy[i], _iyy[i], _iyz[i],
+            _ixz[i], _iyz[i], _izz[i]).Determinant();
+
+          const bool nearPositive = (_mass[i] >= 0) &&
+            (_ixx[i] + epsilon >= 0) && (minor + epsilon >= 0) &&
+            (det + epsilon >= 0);
+          const bool positive = (_mass[i] > 0) &&
+            (_ixx[i] + epsilon > 0) && (minor + epsilon > 0) &&
+            (det + epsilon > 0);
+          const bool moments = ValidMoments(
+            PrincipalMoments(diagonal, offDiagonal, 1e-6), _tolerance);
+
+          _flags[i] = static_cast<std::uint8_t>(
+            (nearPositive ? kNearPositive : 0) |
+            (positive ? kPositive : 0) |
+            (moments ? kValidMoments : 0));
+          valid += nearPositive && moments;
+        }
+        return valid;
+      }
+
+      /// \brief Compute principal moments of inertia of a matrix given by
+      /// its components, see PrincipalMoments(const T) const.
+      /// \param[in] _diagonal Ixx, Iyy and Izz.
+      /// \param[in] _offDiagonal Ixy, Ixz and Iyz.
+      /// \param[in] _tol Relative tolerance.
+      /// \return Principal moments of inertia.
+      private: static Vector3<T> PrincipalMoments(
+                   const Vector3<T> &_diagonal,
+                   const Vector3<T> &_offDiagonal, const T _tol)
       {
         // Compute tolerance relative to maximum value of inertia diagonal
-        T tol = _tol * this->Ixxyyzz.Max();
-        if (this->Ixyxzyz.Equal(Vector3<T>::Zero, tol))
+        T tol = _tol * _diagonal.Max();
+        if (_offDiagonal.Equal(Vector3<T>::Zero, tol))
         {
           // Matrix is already diagonalized, return diagonal moments
-          return this->Ixxyyzz;
+          return _diagonal;
         }
 
         // Algorithm based on http://arxiv.org/abs/1306.6291v4
         // A Method for Fast Diagonalization of a 2x2 or 3x3 Real Symmetric
         // Matrix, by Maarten Kronenburg
-        Vector3<T> Id(this->Ixxyyzz);
-        Vector3<T> Ip(this->Ixyxzyz);
+        const Vector3<T> &Id = _diagonal;
+        const Vector3<T> &Ip = _offDiagonal;
         // b = Ixx + Iyy + Izz
         T b = Id.Sum();
         // c = Ixx*Iyy - Ixy^2  +  Ixx*Izz - Ixz^2  +  Iyy*Izz - Iyz^2
@@ -514,33 +600,509 @@ namespace gz
         // additionally clamp the argument to [-1,1]
         T delta = acos(clamp<T>(0.5 * q / std::pow(p, 1.5), -1, 1));
 
-        // sort the moments from smallest to largest
-        T moment0 = (b + 2*sqrt(p) * cos(delta / 3.0)) / 3.0;
-        T moment1 = (b + 2*sqrt(p) * cos((delta + 2*GZ_PI)/3.0)) / 3.0;
-        T moment2 = (b + 2*sqrt(p) * cos((delta - 2*GZ_PI)/3.0)) / 3.0;
-        sort3(moment0, moment1, moment2);
-        return Vector3<T>(moment0, moment1, moment2);
+        // sort the moments from smallest to largest
+        T moment0 = (b + 2*sqrt(p) * cos(delta / 3.0)) / 3.0;
+        T moment1 = (b + 2*sqrt(p) * cos((delta + 2*GZ_PI)/3.0)) / 3.0;
+        T moment2 = (b + 2*sqrt(p) * cos((delta - 2*GZ_PI)/3.0)) / 3.0;
+        sort3(moment0, moment1, moment2);
+        return Vector3<T>(moment0, moment1, moment2);
+      }
+
+      /// \brief Compute rotational offset of principal axes.
+      /// \param[in] _tol Relative tolerance given by absolute value
+      /// of _tol.
+      /// Negative values of _tol are interpreted as a flag that
+      /// causes principal moments to always be sorted from smallest
+      /// to largest.
+      /// \return Quaternion representing rotational offset of principal axes.
+      /// With a rotation matrix constructed from this quaternion R(q)
+      /// and a diagonal matrix L with principal moments on the diagonal,
+      /// the original moment of inertia matrix MOI can be reconstructed
+      /// with MOI = R(q).Transpose() * L * R(q)
+      /// \sa PrincipalAxes
+      public: Quaternion<T> PrincipalAxesOffset(const T _tol = 1e-6) const
+      {
+        return this->PrincipalAxesOffset(this->PrincipalMoments(_tol), _tol);
+      }
+
+      /// \brief Compute the principal moments and the rotational offset of
+      /// the principal axes together, which solves for the moments only
+      /// once. The results are the same as PrincipalMoments and
+      /// PrincipalAxesOffset.
+      /// \param[out] _moments Principal moments of inertia.
+      /// \param[out] _offset Rotational offset of principal axes.
+      /// \param[in] _tol Relative tolerance given by absolute value
+      /// of _tol. Negative values of _tol are interpreted as a flag that
+      /// causes principal moments to always be sorted from smallest
+      /// to largest.
+      /// \return True if the principal axes could be computed. Otherwise
+      /// _offset is set to Quaternion::Zero.
+      public: bool PrincipalAxes(Vector3<T> &_moments,
+                                 Quaternion<T> &_offset,
+                                 const T _tol = 1e-6) const
+      {
+        _moments = this->PrincipalMoments(_tol);
+        _offset = this->PrincipalAxesOffset(_moments, _tol);
+        return _offset != Quaternion<T>::Zero;
+      }
+
+      /// \brief Get dimensions and rotation offset of uniform box
+      /// with equivalent mass and moment of inertia.
+      /// To compute this, the Matrix3 is diagonalized.
+      /// The eigenvalues on the diagonal and the rotation offset
+      /// of the principal axes are returned.
+      /// \param[in] _size Dimensions of box aligned with principal axes.
+      /// \param[in] _rot Rotational offset of principal axes.
+      /// \param[in] _tol Relative tolerance.
+      /// \return True if box properties were computed successfully.
+      public: bool EquivalentBox(Vector3<T> &_size,
+                                 Quaternion<T> &_rot,
+                                 const T _tol = 1e-6) const
+      {
+        if (!this->IsPositive(0))
+        {
+          // inertia is not positive, cannot compute equivalent box
+          return false;
+        }
+
+        Vector3<T> moments;
+        const bool axes = this->PrincipalAxes(moments, _rot, _tol);
+        if (!ValidMoments(moments))
+        {
+          // principal moments don't satisfy the triangle identity
+          return false;
+        }
+
+        // The reason for checking that the principal moments satisfy
+        // the triangle inequality
+        // I1 + I2 - I3 >= 0
+        // is to ensure that the arguments to sqrt in these equations
+        // are positive and the box size is real.
+        _size.X(sqrt(6*(moments.Y() + moments.Z() - moments.X()) / this->mass));
+        _size.Y(sqrt(6*(moments.Z() + moments.X() - moments.Y()) / this->mass));
+        _size.Z(sqrt(6*(moments.X() + moments.Y() - moments.Z()) / this->mass));
+
+        if (!axes)
+        {
+          // _rot is an invalid quaternion
+          /// \todo Use a mock class to test this line
+          return false;
+        }
+
+        return true;
+      }
+
+      /// \brief Set inertial properties based on a Material and equivalent box.
+      /// \param[in] _mat Material that specifies a density. Uniform density
+      /// is used.
+      /// \param[in] _size Size of equivalent box.
+      /// \param[in] _rot Rotational offset of equivalent box.
+      /// \return True if inertial properties were set successfully.
+      public: bool SetFromBox(const Material &_mat,
+                              const Vector3<T> &_size,
+                            const Quaternion<T> &_rot = Quaternion<T>::Identity)
+     {
+        T volume = _size.X() * _size.Y() * _size.Z();
+        return this->SetFromBox(_mat.Density() * volume, _size, _rot);
+     }
+
+      /// \brief Set inertial properties based on mass and equivalent box.
+      /// \param[in] _mass Mass to set.
+      /// \param[in] _size Size of equivalent box.
+      /// \param[in] _rot Rotational offset of equivalent box.
+      /// \return True if inertial properties were set successfully.
+      public: bool SetFromBox(const T _mass,
+                              const Vector3<T> &_size,
+                            const Quaternion<T> &_rot = Quaternion<T>::Identity)
+      {
+        // Check that _mass and _size are strictly positive
+        // and that quaternion is valid
+        if (_mass <= 0 || _size.Min() <= 0 || _rot == Quaternion<T>::Zero)
+        {
+          return false;
+        }
+        this->SetMass(_mass);
+        return this->SetFromBox(_size, _rot);
+      }
+
+      /// \brief Set inertial properties based on equivalent box
+      /// using the current mass value.
+      /// \param[in] _size Size of equivalent box.
+      /// \param[in] _rot Rotational offset of equivalent box.
+      /// \return True if inertial properties were set successfully.
+      public: bool SetFromBox(const Vector3<T> &_size,
+                            const Quaternion<T> &_rot = Quaternion<T>::Identity)
+      {
+        // Check that _mass and _size are strictly positive
+        // and that quaternion is valid
+        if (this->Mass() <= 0 || _size.Min() <= 0 ||
+            _rot == Quaternion<T>::Zero)
+        {
+          return false;
+        }
+
+        // Diagonal matrix L with principal moments
+        Matrix3<T> L;
+        T x2 = std::pow(_size.X(), 2);
+        T y2 = std::pow(_size.Y(), 2);
+        T z2 = std::pow(_size.Z(), 2);
+        L(0, 0) = this->mass / 12.0 * (y2 + z2);
+        L(1, 1) = this->mass / 12.0 * (z2 + x2);
+        L(2, 2) = this->mass / 12.0 * (x2 + y2);
+        Matrix3<T> R(_rot);
+        return this->SetMoi(R * L * R.Transposed());
+      }
+
+      /// \brief Set inertial properties based on a Material and equivalent
+      /// cylinder aligned with Z axis.
+      /// \param[in] _mat Material that specifies a density. Uniform density
+      /// is used.
+      /// \param[in] _length Length of cylinder along Z axis.
+      /// \param[in] _radius Radius of cylinder.
+      /// \param[in] _rot Rotational offset of equivalent cylinder.
+      /// \return True if inertial properties were set successfully.
+      public: bool SetFromCylinderZ(const Material &_mat,
+                                    const T _length,
+                                    const T _radius,
+                            const Quaternion<T> &_rot = Quaternion<T>::Identity)
+      {
+        // Check that density, _radius and _length are strictly positive
+        // and that quaternion is valid
+        if (_mat.Density() <= 0 || _length <= 0 || _radius <= 0 ||
+            _rot == Quaternion<T>::Zero)
+        {
+          return false;
+        }
+        T volume = GZ_PI * _radius * _radius * _length;
+        return this->SetFromCylinderZ(_mat.Density() * volume,
+                                      _length, _radius, _rot);
+      }
+
+      /// \brief Set inertial properties based on mass and equivalent cylinder
+      /// aligned with Z axis.
+      /// \param[in] _mass Mass to set.
+      /// \param[in] _length Length of cylinder along Z axis.
+      /// \param[in] _radius Radius of cylinder.
+      /// \param[in] _rot Rotational offset of equivalent cylinder.
+      /// \return True if inertial properties were set successfully.
+      public: bool SetFromCylinderZ(const T _mass,
+                                    const T _length,
+                                    const T _radius,
+                            const Quaternion<T> &_rot = Quaternion<T>::Identity)
+      {
+        // Check that _mass, _radius and _length are strictly positive
+        // and that quaternion is valid
+        if (_mass <= 0 || _length <= 0 || _radius <= 0 ||
+            _rot == Quaternion<T>::Zero)
+        {
+          return false;
+        }
+        this->SetMass(_mass);
+        return this->SetFromCylinderZ(_length, _radius, _rot);
+      }
+
+      /// \brief Set inertial properties based on equivalent cylinder
+      /// aligned with Z axis using the current mass value.
+      /// \param[in] _length Length of cylinder along Z axis.
+      /// \param[in] _radius Radius of cylinder.
+      /// \param[in] _rot Rotational offset of equivalent cylinder.
+      /// \return True if inertial properties were set successfully.
+      public: bool SetFromCylinderZ(const T _length,
+                                    const T _radius,
+                                    const Quaternion<T> &_rot)
+      {
+        // Check that _mass and _size are strictly positive
+        // and that quaternion is valid
+        if (this->Mass() <= 0 || _length <= 0 || _radius <= 0 ||
+            _rot == Quaternion<T>::Zero)
+        {
+          return false;
+        }
+
+        // Diagonal matrix L with principal moments
+        T radius2 = std::pow(_radius, 2);
+        Matrix3<T> L;
+        L(0, 0) = this->mass / 12.0 * (3*radius2 + std::pow(_length, 2));
+        L(1, 1) = L(0, 0);
+        L(2, 2) = this->mass / 2.0 * radius2;
+        Matrix3<T> R(_rot);
+        return this->SetMoi(R * L * R.Transposed());
+      }
+
+      /// \brief Set inertial properties based on a material and
+      /// equivalent sphere.
+      /// \param[in] _mat Material that specifies a density. Uniform density
+      /// is used.
+      /// \param[in] _radius Radius of equivalent, uniform sphere.
+      /// \return True if inertial properties were set successfully.
+      public: bool SetFromSphere(const Material &_mat, const T _radius)
+      {
+        // Check that the density and _radius are strictly positive
+        if (_mat.Density() <= 0 || _radius <= 0)
+        {
+          return false;
+        }
+
+        T volume = (4.0/3.0) * GZ_PI * std::pow(_radius, 3);
+        return this->SetFromSphere(_mat.Density() * volume, _radius);
+      }
+
+      /// \brief Set inertial properties based on mass and equivalent sphere.
+      /// \param[in] _mass Mass to set.
+      /// \param[in] _radius Radius of equivalent, uniform sphere.
+      /// \return True if inertial properties were set successfully.
+      public: bool SetFromSphere(const T _mass, const T _radius)
+      {
+        // Check that _mass and _radius are strictly positive
+        if (_mass <= 0 || _radius <= 0)
+        {
+          return false;
+        }
+        this->SetMass(_mass);
+        return this->SetFromSphere(_radius);
+      }
+
+      /// \brief Set inertial properties based on equivalent sphere
+      /// using the current mass value.
+      /// \param[in] _radius Radius of equivalent, uniform sphere.
+      /// \return True if inertial properties were set successfully.
+      public: bool SetFromSphere(const T _radius)
+      {
+        // Check that _mass and _radius are strictly positive
+        if (this->Mass() <= 0 || _radius <= 0)
+        {
+          return false;
+        }
+
+        // Diagonal matrix L with principal moments
+        T radius2 = std::pow(_radius, 2);
+        Matrix3<T> L;
+        L(0, 0) = 0.4 * this->mass * radius2;
+        L(1, 1) = 0.4 * this->mass * radius2;
+        L(2, 2) = 0.4 * this->mass * radius2;
+        return this->SetMoi(L);
+      }
+
+      /// \brief Set inertial properties based on a Material and a closed
+      /// triangle mesh of uniform density.
+      /// \param[in] _mat Material that specifies a density. Uniform density
+      /// is used.
+      /// \param[in] _vertices Pointer to the vertices of the mesh.
+      /// \param[in] _vertexCount Number of vertices.
+      /// \param[in] _indices Pointer to three vertex indices per triangle.
+      /// \param[in] _triangleCount Number of triangles.
+      /// \param[out] _centerOfMass Center of mass in the mesh frame. The
+      /// moments of inertia are computed about it, with the axes of the
+      /// mesh frame.
+      /// \param[in] _threads Maximum number of threads to use. Zero uses
+      /// std::thread::hardware_concurrency.
+      /// \return True if inertial properties were set successfully.
+      /// \sa TriangleMeshMoments
+      public: bool SetFromTriangleMesh(const Material &_mat,
+                                       const Vector3<T> *_vertices,
+                                       const std::size_t _vertexCount,
+                                       const unsigned int *_indices,
+                                       const std::size_t _triangleCount,
+                                       Vector3<T> &_centerOfMass,
+                                       const unsigned int _threads = 1)
+      {
+        T volume;
+        Matrix3<T> unitMoi;
+        if (_mat.Density() <= 0 ||
+            !TriangleMeshMoments(_vertices, _vertexCount, _indices,
+                                 _triangleCount, volume, _centerOfMass,
+                                 unitMoi, _threads))
+        {
+          return false;
+        }
+
+        const T density = static_cast<T>(_mat.Density());
+        this->SetMass(density * volume);
+        return this->SetMoi(unitMoi * density);
+      }
+
+      /// \brief Set inertial properties based on mass and a closed
+      /// triangle mesh of uniform density.
+      /// \param[in] _mass Mass to set.
+      /// \param[in] _vertices Pointer to the vertices of the mesh.
+      /// \param[in] _vertexCount Number of vertices.
+      /// \param[in] _indices Pointer to three vertex indices per triangle.
+      /// \param[in] _triangleCount Number of triangles.
+      /// \param[out] _centerOfMass Center of mass in the mesh frame. The
+      /// moments of inertia are computed about it, with the axes of the
+      /// mesh frame.
+      /// \param[in] _threads Maximum number of threads to use. Zero uses
+      /// std::thread::hardware_concurrency.
+      /// \return True if inertial properties were set successfully.
+      /// \sa TriangleMeshMoments
+      public: bool SetFromTriangleMesh(const T _mass,
+                                       const Vector3<T> *_vertices,
+                                       const std::size_t _vertexCount,
+                                       const unsigned int *_indices,
+                                       const std::size_t _triangleCount,
+                                       Vector3<T> &_centerOfMass,
+                                       const unsigned int _threads = 1)
+      {
+        T volume;
+        Matrix3<T> unitMoi;
+        if (_mass <= 0 ||
+            !TriangleMeshMoments(_vertices, _vertexCount, _indices,
+                                 _triangleCount, volume, _centerOfMass,
+                                 unitMoi, _threads))
+        {
+          return false;
+        }
+
+        this->SetMass(_mass);
+        return this->SetMoi(unitMoi * (_mass / volume));
+      }
+
+      /// \brief Compute the volume, center of volume and moment of inertia
+      /// of a closed triangle mesh of unit density.
+      ///
+      /// The mesh is split in signed tetrahedra between each triangle and a
+      /// reference vertex, whose volume and first and second moments are
+      /// known exactly. The triangles are summed in chunks of fixed size,
+      /// which are spread over the threads, and the chunk sums are added in
+      /// order, so that the result does not depend on the number of
+      /// threads. A mesh whose triangles all face inwards gives the same
+      /// result as one whose triangles face outwards.
+      /// \param[in] _vertices Pointer to the vertices of the mesh.
+      /// \param[in] _vertexCount Number of vertices.
+      /// \param[in] _indices Pointer to three vertex indices per triangle.
+      /// \param[in] _triangleCount Number of triangles.
+      /// \param[out] _volume Volume enclosed by the mesh.
+      /// \param[out] _center Center of volume in the mesh frame.
+      /// \param[out] _unitMoi Moment of inertia about _center for a unit
+      /// density, with the axes of the mesh frame.
+      /// \param[in] _threads Maximum number of threads to use. Zero uses
+      /// std::thread::hardware_concurrency.
+      /// \return True if the mesh encloses a positive volume and all
+      /// indices are smaller than _vertexCount.
+      public: static bool TriangleMeshMoments(const Vector3<T> *_vertices,
+                                              const std::size_t _vertexCount,
+                                              const unsigned int *_indices,
+                                              const std::size_t _triangleCount,
+                                              T &_volume,
+                                              Vector3<T> &_center,
+                                              Matrix3<T> &_unitMoi,
+                                              const unsigned int _threads = 1)
+      {
+        GZ_MATH_PROFILE_ZONE("MassMatrix3::TriangleMeshMoments");
+        if (_vertices == nullptr || _indices == nullptr ||
+            _triangleCount == 0 || _indices[0] >= _vertexCount)
+        {
+          return false;
+        }
+
+        // Sums over the tetrahedra of 6 times the volume, 24 times the
+        // first moment and 120 times the second moments.
+        struct Sums
+        {
+          T volume = 0;
+          Vector3<T> first;
+          Vector3<T> diagonal;
+          Vector3<T> offDiagonal;
+          bool valid = true;
+        };
+
+        // Tetrahedra share the first vertex, which limits cancellation
+        // when the mesh is far from the origin.
+        const Vector3<T> origin = _vertices[_indices[0]];
+        const std::size_t chunkCount =
+            (_triangleCount + kTriangleMeshChunkSize - 1) /
+            kTriangleMeshChunkSize;
+        std::vector<Sums> chunkSums(chunkCount);
+        auto sumChunks = [&](const std::size_t _begin, const std::size_t _end)
+        {
+          for (std::size_t chunk = _begin; chunk < _end; ++chunk)
+          {
+            Sums sums;
+            const std::size_t end = std::min(
+                (chunk + 1) * kTriangleMeshChunkSize, _triangleCount);
+            for (std::size_t i = chunk * kTriangleMeshChunkSize; i < end;
+                 ++i)
+            {
+              const unsigned int *index = _indices + 3 * i;
+              if (index[0] >= _vertexCount || index[1] >= _vertexCount ||
+                  index[2] >= _vertexCount)
+              {
+                sums.valid = false;
+                break;
+              }
+              const Vector3<T> a = _vertices[index[0]] - origin;
+              const Vector3<T> b = _vertices[index[1]] - origin;
+              const Vector3<T> c = _vertices[index[2]] - origin;
+              const Vector3<T> sum = a + b + c;
+              const T det = a.Dot(b.Cross(c));
+              sums.volume += det;
+              sums.first += det * sum;
+              sums.diagonal += det * (a * a + b * b + c * c + sum * sum);
+              sums.offDiagonal += det * Vector3<T>(
+                  a[0] * a[1] + b[0] * b[1] + c[0] * c[1] + sum[0] * sum[1],
+                  a[0] * a[2] + b[0] * b[2] + c[0] * c[2] + sum[0] * sum[2],
+                  a[1] * a[2] + b[1] * b[2] + c[1] * c[2] + sum[1] * sum[2]);
+            }
+            chunkSums[chunk] = sums;
+          }
+        };
+
+        detail::ParallelFor(chunkCount,
+            detail::ChunkCount(chunkCount, _threads),
+            [&](const std::size_t, const std::size_t _begin,
+                const std::size_t _end)
+        {
+          sumChunks(_begin, _end);
+        });
+
+        Sums total;
+        for (const Sums &sums : chunkSums)
+        {
+          total.volume += sums.volume;
+          total.first += sums.first;
+          total.diagonal += sums.diagonal;
+          total.offDiagonal += sums.offDiagonal;
+          total.valid = total.valid && sums.valid;
+        }
+
+        // Triangles facing inwards flip the sign of every sum
+        const T sign = total.volume < 0 ? -1 : 1;
+        const T volume = sign * total.volume / 6;
+        if (!total.valid || !(volume > 0) || !std::isfinite(volume))
+          return false;
+
+        const Vector3<T> center = sign * total.first / (24 * volume);
+        // Second moments about the center of volume
+        const Vector3<T> diagonal =
+            sign * total.diagonal / 120 - volume * center * center;
+        const Vector3<T> offDiagonal = sign * total.offDiagonal / 120 -
+            volume * Vector3<T>(center[0] * center[1],
+                                center[0] * center[2],
+                                center[1] * center[2]);
+
+        _volume = volume;
+        _center = origin + center;
+        _unitMoi.Set(
+            diagonal[1] + diagonal[2], -offDiagonal[0], -offDiagonal[1],
+            -offDiagonal[0], diagonal[0] + diagonal[2], -offDiagonal[2],
+            -offDiagonal[1], -offDiagonal[2], diagonal[0] + diagonal[1]);
+        return true;
       }
 
-      /// \brief Compute rotational offset of principal axes.
-      /// \param[in] _tol Relative tolerance given by absolute value
-      /// of _tol.
-      /// Negative values of _tol are interpreted as a flag that
-      /// causes principal moments to always be sorted from smallest
-      /// to largest.
-      /// \return Quaternion representing rotational offset of principal axes.
-      /// With a rotation matrix constructed from this quaternion R(q)
-      /// and a diagonal matrix L with principal moments on the diagonal,
-      /// the original moment of inertia matrix MOI can be reconstructed
-      /// with MOI = R(q).Transpose() * L * R(q)
-      public: Quaternion<T> PrincipalAxesOffset(const T _tol = 1e-6) const
+      /// \brief Compute rotational offset of principal axes from the
+      /// principal moments.
+      /// \param[in] _moments Principal moments of inertia.
+      /// \param[in] _tol Relative tolerance, as in PrincipalAxes.
+      /// \return Rotational offset of principal axes, or Quaternion::Zero
+      /// if it could not be computed.
+      private: Quaternion<T> PrincipalAxesOffset(const Vector3<T> &_moments,
+                                                 const T _tol) const
       {
-        Vector3<T> moments = this->PrincipalMoments(_tol);
         // Compute tolerance relative to maximum value of inertia diagonal
         T tol = _tol * this->Ixxyyzz.Max();
-        if (moments.Equal(this->Ixxyyzz, tol) ||
-            (math::equal<T>(moments[0], moments[1], std::abs(tol)) &&
-             math::equal<T>(moments[0], moments[2], std::abs(tol))))
+        if (_moments.Equal(this->Ixxyyzz, tol) ||
+            (math::equal<T>(_moments[0], _moments[1], std::abs(tol)) &&
+             math::equal<T>(_moments[0], _moments[2], std::abs(tol))))
         {
           // matrix is already aligned with principal axes
           // or all three moments are approximately equal
@@ -570,8 +1132,8 @@ namespace gz
 
         // Check if two moments are equal, since different equations are used
         // The moments vector is already sorted, so just check adjacent values.
-        Vector2<T> momentsDiff(moments[0] - moments[1],
-                               moments[1] - moments[2]);
+        Vector2<T> momentsDiff(_moments[0] - _moments[1],
+                               _moments[1] - _moments[2]);
 
         // index of unequal moment
         int unequalMoment = -1;
@@ -585,11 +1147,11 @@ namespace gz
           // moments[1] is the repeated value
           // it is not equal to moments[unequalMoment]
           // momentsDiff3 = lambda - lambda3
-          T momentsDiff3 = moments[1] - moments[unequalMoment];
+          T momentsDiff3 = _moments[1] - _moments[unequalMoment];
           // eq 5.21:
           // s = cos(phi2)^2 = (A_11 - lambda3) / (lambda - lambda3)
           // s >= 0 since A_11 is in range [lambda, lambda3]
-          T s = (this->Ixxyyzz[0] - moments[unequalMoment]) / momentsDiff3;
+          T s = (this->Ixxyyzz[0] - _moments[unequalMoment]) / momentsDiff3;
           // set phi3 to zero for repeated moments (eq 5.23)
           T phi3 = 0;
           // phi2 = +- acos(sqrt(s))
@@ -681,9 +1243,9 @@ namespace gz
         // No repeated principal moments
         // eq 5.1:
         T v = (std::pow(this->Ixyxzyz[0], 2) + std::pow(this->Ixyxzyz[1], 2)
-              +(this->Ixxyyzz[0] - moments[2])
-              *(this->Ixxyyzz[0] + moments[2] - moments[0] - moments[1]))
-            / ((moments[1] - moments[2]) * (moments[2] - moments[0]));
+              +(this->Ixxyyzz[0] - _moments[2])
+              *(this->Ixxyyzz[0] + _moments[2] - _moments[0] - _moments[1]))
+            / ((_moments[1] - _moments[2]) * (_moments[2] - _moments[0]));
         // value of w depends on v
         T w;
         if (v < std::abs(tol))
@@ -695,8 +1257,8 @@ namespace gz
         else
         {
           // eq 5.2:
-          w = (this->Ixxyyzz[0] - moments[2] + (moments[2] - moments[1])*v)
-              / ((moments[0] - moments[1]) * v);
+          w = (this->Ixxyyzz[0] - _moments[2] + (_moments[2] - _moments[1])*v)
+              / ((_moments[0] - _moments[1]) * v);
         }
         // initialize values of angle phi1, phi2, phi3
         T phi1 = 0;
@@ -708,11 +1270,12 @@ namespace gz
         // compute g1, g2 for phi2,phi3 >= 0
         // equations 5.7, 5.8
         Vector2<T> g1(
-          0.5* (moments[0]-moments[1])*ClampedSqrt(v)*sin(2*phi3),
-          0.5*((moments[0]-moments[1])*w + moments[1]-moments[2])*sin(2*phi2));
+          0.5* (_moments[0]-_moments[1])*ClampedSqrt(v)*sin(2*phi3),
+          0.5*((_moments[0]-_moments[1])*w + _moments[1]-_moments[2])
+            *sin(2*phi2));
         Vector2<T> g2(
-          (moments[0]-moments[1])*(1 + (v-2)*w) + (moments[1]-moments[2])*v,
-          (moments[0]-moments[1])*sin(phi2)*sin(2*phi3));
+          (_moments[0]-_moments[1])*(1 + (v-2)*w) + (_moments[1]-_moments[2])*v,
+          (_moments[0]-_moments[1])*sin(phi2)*sin(2*phi3));
 
         // The paragraph prior to equation 5.16 describes how to choose
         // the candidate value of phi1 based on the length
@@ -822,244 +1385,6 @@ namespace gz
         return Quaternion<T>(-phi1, -phi2, -phi3).Inverse();
       }
 
-      /// \brief Get dimensions and rotation offset of uniform box
-      /// with equivalent mass and moment of inertia.
-      /// To compute this, the Matrix3 is diagonalized.
-      /// The eigenvalues on the diagonal and the rotation offset
-      /// of the principal axes are returned.
-      /// \param[in] _size Dimensions of box aligned with principal axes.
-      /// \param[in] _rot Rotational offset of principal axes.
-      /// \param[in] _tol Relative tolerance.
-      /// \return True if box properties were computed successfully.
-      public: bool EquivalentBox(Vector3<T> &_size,
-                                 Quaternion<T> &_rot,
-                                 const T _tol = 1e-6) const
-      {
-        if (!this->IsPositive(0))
-        {
-          // inertia is not positive, cannot compute equivalent box
-          return false;
-        }
-
-        Vector3<T> moments = this->PrincipalMoments(_tol);
-        if (!ValidMoments(moments))
-        {
-          // principal moments don't satisfy the triangle identity
-          return false;
-        }
-
-        // The reason for checking that the principal moments satisfy
-        // the triangle inequality
-        // I1 + I2 - I3 >= 0
-        // is to ensure that the arguments to sqrt in these equations
-        // are positive and the box size is real.
-        _size.X(sqrt(6*(moments.Y() + moments.Z() - moments.X()) / this->mass));
-        _size.Y(sqrt(6*(moments.Z() + moments.X() - moments.Y()) / this->mass));
-        _size.Z(sqrt(6*(moments.X() + moments.Y() - moments.Z()) / this->mass));
-
-        _rot = this->PrincipalAxesOffset(_tol);
-
-        if (_rot == Quaternion<T>::Zero)
-        {
-          // _rot is an invalid quaternion
-          /// \todo Use a mock class to test this line
-          return false;
-        }
-
-        return true;
-      }
-
-      /// \brief Set inertial properties based on a Material and equivalent box.
-      /// \param[in] _mat Material that specifies a density. Uniform density
-      /// is used.
-      /// \param[in] _size Size of equivalent box.
-      /// \param[in] _rot Rotational offset of equivalent box.
-      /// \return True if inertial properties were set successfully.
-      public: bool SetFromBox(const Material &_mat,
-                              const Vector3<T> &_size,
-                            const Quaternion<T> &_rot = Quaternion<T>::Identity)
-     {
-        T volume = _size.X() * _size.Y() * _size.Z();
-        return this->SetFromBox(_mat.Density() * volume, _size, _rot);
-     }
-
-      /// \brief Set inertial properties based on mass and equivalent box.
-      /// \param[in] _mass Mass to set.
-      /// \param[in] _size Size of equivalent box.
-      /// \param[in] _rot Rotational offset of equivalent box.
-      /// \return True if inertial properties were set successfully.
-      public: bool SetFromBox(const T _mass,
-                              const Vector3<T> &_size,
-                            const Quaternion<T> &_rot = Quaternion<T>::Identity)
-      {
-        // Check that _mass and _size are strictly positive
-        // and that quaternion is valid
-        if (_mass <= 0 || _size.Min() <= 0 || _rot == Quaternion<T>::Zero)
-        {
-          return false;
-        }
-        this->SetMass(_mass);
-        return this->SetFromBox(_size, _rot);
-      }
-
-      /// \brief Set inertial properties based on equivalent box
-      /// using the current mass value.
-      /// \param[in] _size Size of equivalent box.
-      /// \param[in] _rot Rotational offset of equivalent box.
-      /// \return True if inertial properties were set successfully.
-      public: bool SetFromBox(const Vector3<T> &_size,
-                            const Quaternion<T> &_rot = Quaternion<T>::Identity)
-      {
-        // Check that _mass and _size are strictly positive
-        // and that quaternion is valid
-        if (this->Mass() <= 0 || _size.Min() <= 0 ||
-            _rot == Quaternion<T>::Zero)
-        {
-          return false;
-        }
-
-        // Diagonal matrix L with principal moments
-        Matrix3<T> L;
-        T x2 = std::pow(_size.X(), 2);
-        T y2 = std::pow(_size.Y(), 2);
-        T z2 = std::pow(_size.Z(), 2);
-        L(0, 0) = this->mass / 12.0 * (y2 + z2);
-        L(1, 1) = this->mass / 12.0 * (z2 + x2);
-        L(2, 2) = this->mass / 12.0 * (x2 + y2);
-        Matrix3<T> R(_rot);
-        return this->SetMoi(R * L * R.Transposed());
-      }
-
-      /// \brief Set inertial properties based on a Material and equivalent
-      /// cylinder aligned with Z axis.
-      /// \param[in] _mat Material that specifies a density. Uniform density
-      /// is used.
-      /// \param[in] _length Length of cylinder along Z axis.
-      /// \param[in] _radius Radius of cylinder.
-      /// \param[in] _rot Rotational offset of equivalent cylinder.
-      /// \return True if inertial properties were set successfully.
-      public: bool SetFromCylinderZ(const Material &_mat,
-                                    const T _length,
-                                    const T _radius,
-                            const Quaternion<T> &_rot = Quaternion<T>::Identity)
-      {
-        // Check that density, _radius and _length are strictly positive
-        // and that quaternion is valid
-        if (_mat.Density() <= 0 || _length <= 0 || _radius <= 0 ||
-            _rot == Quaternion<T>::Zero)
-        {
-          return false;
-        }
-        T volume = GZ_PI * _radius * _radius * _length;
-        return this->SetFromCylinderZ(_mat.Density() * volume,
-                                      _length, _radius, _rot);
-      }
-
-      /// \brief Set inertial properties based on mass and equivalent cylinder
-      /// aligned with Z axis.
-      /// \param[in] _mass Mass to set.
-      /// \param[in] _length Length of cylinder along Z axis.
-      /// \param[in] _radius Radius of cylinder.
-      /// \param[in] _rot Rotational offset of equivalent cylinder.
-      /// \return True if inertial properties were set successfully.
-      public: bool SetFromCylinderZ(const T _mass,
-                                    const T _length,
-                                    const T _radius,
-                            const Quaternion<T> &_rot = Quaternion<T>::Identity)
-      {
-        // Check that _mass, _radius and _length are strictly positive
-        // and that quaternion is valid
-        if (_mass <= 0 || _length <= 0 || _radius <= 0 ||
-            _rot == Quaternion<T>::Zero)
-        {
-          return false;
-        }
-        this->SetMass(_mass);
-        return this->SetFromCylinderZ(_length, _radius, _rot);
-      }
-
-      /// \brief Set inertial properties based on equivalent cylinder
-      /// aligned with Z axis using the current mass value.
-      /// \param[in] _length Length of cylinder along Z axis.
-      /// \param[in] _radius Radius of cylinder.
-      /// \param[in] _rot Rotational offset of equivalent cylinder.
-      /// \return True if inertial properties were set successfully.
-      public: bool SetFromCylinderZ(const T _length,
-                                    const T _radius,
-                                    const Quaternion<T> &_rot)
-      {
-        // Check that _mass and _size are strictly positive
-        // and that quaternion is valid
-        if (this->Mass() <= 0 || _length <= 0 || _radius <= 0 ||
-            _rot == Quaternion<T>::Zero)
-        {
-          return false;
-        }
-
-        // Diagonal matrix L with principal moments
-        T radius2 = std::pow(_radius, 2);
-        Matrix3<T> L;
-        L(0, 0) = this->mass / 12.0 * (3*radius2 + std::pow(_length, 2));
-        L(1, 1) = L(0, 0);
-        L(2, 2) = this->mass / 2.0 * radius2;
-        Matrix3<T> R(_rot);
-        return this->SetMoi(R * L * R.Transposed());
-      }
-
-      /// \brief Set inertial properties based on a material and
-      /// equivalent sphere.
-      /// \param[in] _mat Material that specifies a density. Uniform density
-      /// is used.
-      /// \param[in] _radius Radius of equivalent, uniform sphere.
-      /// \return True if inertial properties were set successfully.
-      public: bool SetFromSphere(const Material &_mat, const T _radius)
-      {
-        // Check that the density and _radius are strictly positive
-        if (_mat.Density() <= 0 || _radius <= 0)
-        {
-          return false;
-        }
-
-        T volume = (4.0/3.0) * GZ_PI * std::pow(_radius, 3);
-        return this->SetFromSphere(_mat.Density() * volume, _radius);
-      }
-
-      /// \brief Set inertial properties based on mass and equivalent sphere.
-      /// \param[in] _mass Mass to set.
-      /// \param[in] _radius Radius of equivalent, uniform sphere.
-      /// \return True if inertial properties were set successfully.
-      public: bool SetFromSphere(const T _mass, const T _radius)
-      {
-        // Check that _mass and _radius are strictly positive
-        if (_mass <= 0 || _radius <= 0)
-        {
-          return false;
-        }
-        this->SetMass(_mass);
-        return this->SetFromSphere(_radius);
-      }
-
-      /// \brief Set inertial properties based on equivalent sphere
-      /// using the current mass value.
-      /// \param[in] _radius Radius of equivalent, uniform sphere.
-      /// \return True if inertial properties were set successfully.
-      public: bool SetFromSphere(const T _radius)
-      {
-        // Check that _mass and _radius are strictly positive
-        if (this->Mass() <= 0 || _radius <= 0)
-        {
-          return false;
-        }
-
-        // Diagonal matrix L with principal moments
-        T radius2 = std::pow(_radius, 2);
-        Matrix3<T> L;
-        L(0, 0) = 0.4 * this->mass * radius2;
-        L(1, 1) = 0.4 * this->mass * radius2;
-        L(2, 2) = 0.4 * this->mass * radius2;
-        return this->SetMoi(L);
-      }
-
       /// \brief Square root of positive numbers, otherwise zero.
       /// \param[in] _x Number to be square rooted.
       /// \return sqrt(_x) if _x > 0, otherwise 0
@@ -1094,6 +1419,10 @@ namespace gz
       /// These MOI off-diagonals are specified in the local frame.
       /// Where Ixyxzyz.x is Ixy, Ixyxzyz.y is Ixz and Ixyxzyz.z is Iyz.
       private: Vector3<T> Ixyxzyz;
+
+      /// \brief Number of triangles summed together by TriangleMeshMoments,
+      /// which is independent of the number of threads.
+      private: static constexpr std::size_t kTriangleMeshChunkSize = 1 << 14;
     };
 
     typedef MassMatrix3<double> MassMatrix3d;
@@ -84,6 +84,14 @@ namespace gz
       /// material type and the map's value is the material object.
       public: static const std::map<MaterialType, Material> &Predefined();
 
+      /// \brief Get a built-in material in constant time, without copying
+      /// it.
+      /// \param[in] _type Built-in type to get.
+      /// \return The built-in material of _type, or a material with
+      /// MaterialType::UNKNOWN_MATERIAL and a density of -1 if _type is not
+      /// a built-in type.
+      public: static const Material &Predefined(const MaterialType _type);
+
       /// \brief Set this Material to the built-in Material with
       /// the nearest density value within _epsilon. If a built-in material
       /// could not be found, then this Material is not changed.
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_MATERIALT_HH_
+#define GZ_MATH_MATERIALT_HH_
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include <gz/math/Helpers.hh>
+#include <gz/math/Material.hh>
+#include <gz/math/MaterialType.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class MaterialT MaterialT.hh gz/math/MaterialT.hh
+    /// \brief Material with a density of a given precision, with the same
+    /// interface and results as Material, but stored inline as its type
+    /// and density. Materials can be copied without an allocation and kept
+    /// in a contiguous array, such as one per voxel or per link.
+    ///
+    /// The name is not stored, and is that of the built-in type, so a
+    /// custom name can't be set. Looking up a built-in type by name goes
+    /// through Material.
+    /// \tparam T A floating point type.
+    template<typename T>
+    class MaterialT
+    {
+      static_assert(std::is_floating_point_v<T>,
+          "MaterialT requires a floating point type");
+
+      /// \brief Default constructor, an unknown material with a density
+      /// of -1, as Material::Material().
+      public: constexpr MaterialT() = default;
+
+      /// \brief Construct a material based on a built-in type.
+      /// \param[in] _type Built-in type to create.
+      public: explicit MaterialT(const MaterialType _type)
+      : MaterialT(Material::Predefined(_type))
+      {
+      }
+
+      /// \brief Construct a material based on a type name.
+      /// \param[in] _typename Name of the built-in type to create, see
+      /// Material::Material(const std::string &).
+      public: explicit MaterialT(const std::string &_typename)
+      : MaterialT(Material(_typename))
+      {
+      }
+
+      /// \brief Construct a material of unknown type based on a density.
+      /// \param[in] _density Material density.
+      public: constexpr explicit MaterialT(const T _density)
+      : density(_density)
+      {
+      }
+
+      /// \brief Construct from a Material, with its type and density.
+      /// \param[in] _material Material to convert.
+      public: explicit MaterialT(const Material &_material)
+      : type(_material.Type()),
+        density(static_cast<T>(_material.Density()))
+      {
+      }
+
+      /// \brief Get a Material with the same type and density, and the
+      /// name of the type.
+      /// \return The material.
+      public: Material ToMaterial() const
+      {
+        Material material(static_cast<double>(this->density));
+        material.SetType(this->type);
+        material.SetName(this->Name());
+        return material;
+      }
+
+      /// \brief Set this material to the built-in type with the nearest
+      /// density, see Material::SetToNearestDensity.
+      /// \param[in] _value Density value of the desired built-in type.
+      /// \param[in] _epsilon Largest difference in density. The material
+      /// is unchanged if no built-in type is that close.
+      public: void SetToNearestDensity(const T _value,
+                  const T _epsilon = std::numeric_limits<T>::max())
+      {
+        Material nearest;
+        nearest.SetToNearestDensity(_value, _epsilon);
+        if (nearest.Type() != MaterialType::UNKNOWN_MATERIAL)
+          *this = MaterialT(nearest);
+      }
+
+      /// \brief Equality operator. The type and density are compared, as
+      /// in Material::operator==.
+      /// \param[in] _material Material to compare.
+      /// \return True if the materials are equal.
+      public: bool operator==(const MaterialT &_material) const
+      {
+        return this->type == _material.type &&
+               equal(this->density, _material.density);
+      }
+
+      /// \brief Inequality operator.
+      /// \param[in] _material Material to compare.
+      /// \return True if the materials are not equal.
+      public: bool operator!=(const MaterialT &_material) const
+      {
+        return !(*this == _material);
+      }
+
+      /// \brief Get the material's type.
+      /// \return The built-in type, or UNKNOWN_MATERIAL.
+      public: constexpr MaterialType Type() const
+      {
+        return this->type;
+      }
+
+      /// \brief Set the material's type, keeping its density.
+      /// \param[in] _type The built-in type.
+      public: constexpr void SetType(const MaterialType _type)
+      {
+        this->type = _type;
+      }
+
+      /// \brief Get the name of the material's type.
+      /// \return The lowercase name of the built-in type, or an empty
+      /// string for an unknown material.
+      public: std::string Name() const
+      {
+        return Material::Predefined(this->type).Name();
+      }
+
+      /// \brief Get the density.
+      /// \return The density in kg/m^3.
+      public: constexpr T Density() const
+      {
+        return this->density;
+      }
+
+      /// \brief Set the density, keeping the type.
+      /// \param[in] _density The density in kg/m^3.
+      public: constexpr void SetDensity(const T _density)
+      {
+        this->density = _density;
+      }
+
+      /// \brief The built-in type.
+      private: MaterialType type = MaterialType::UNKNOWN_MATERIAL;
+
+      /// \brief Density in kg/m^3.
+      private: T density = -1;
+    };
+
+    using Materiald = MaterialT<double>;
+    using Materialf = MaterialT<float>;
+    }
+  }
+}
+#endif
@@ -102,9 +102,9 @@ namespace gz
       public: static const Matrix3<T> &Zero;
 
       /// \brief Default constructor that initializes the matrix3 to zero.
-      public: Matrix3()
+      public: constexpr Matrix3()
+      : data{{0, 0, 0}, {0, 0, 0}, {0, 0, 0}}
       {
-        std::memset(this->data, 0, sizeof(this->data[0][0])*9);
       }
 
       /// \brief Copy constructor.
@@ -154,7 +154,7 @@ namespace gz
       /// \param[in] _row row index. _row is clamped to the range [0,2]
       /// \param[in] _col column index. _col is clamped to the range [0,2]
       /// \param[in] _v New value.
-      public: void Set(size_t _row, size_t _col, T _v)
+      public: constexpr void Set(size_t _row, size_t _col, T _v)
       {
         this->data[clamp(_row, GZ_ZERO_SIZE_T, GZ_TWO_SIZE_T)]
                   [clamp(_col, GZ_ZERO_SIZE_T, GZ_TWO_SIZE_T)] = _v;
@@ -170,7 +170,7 @@ namespace gz
       /// \param[in] _v20 Row 2, Col 0 value
       /// \param[in] _v21 Row 2, Col 1 value
       /// \param[in] _v22 Row 2, Col 2 value
-      public: void Set(T _v00, T _v01, T _v02,
+      public: constexpr void Set(T _v00, T _v01, T _v02,
                        T _v10, T _v11, T _v12,
                        T _v20, T _v21, T _v22)
       {
@@ -329,7 +329,7 @@ namespace gz
       /// \brief Subtraction operator.
       /// \param[in] _m Matrix to subtract.
       /// \return The element wise difference of two matrices.
-      public: Matrix3<T> operator-(const Matrix3<T> &_m) const
+      public: constexpr Matrix3<T> operator-(const Matrix3<T> &_m) const
       {
         return Matrix3<T>(
             this->data[0][0] - _m(0, 0),
@@ -346,7 +346,7 @@ namespace gz
       /// \brief Addition operation.
       /// \param[in] _m Matrix to add.
       /// \return The element wise sum of two matrices
-      public: Matrix3<T> operator+(const Matrix3<T> &_m) const
+      public: constexpr Matrix3<T> operator+(const Matrix3<T> &_m) const
       {
         return Matrix3<T>(
             this->data[0][0]+_m(0, 0),
@@ -363,7 +363,7 @@ namespace gz
       /// \brief Scalar multiplication operator.
       /// \param[in] _s Value to multiply.
       /// \return The element wise scalar multiplication.
-      public: Matrix3<T> operator*(const T &_s) const
+      public: constexpr Matrix3<T> operator*(const T &_s) const
       {
         return Matrix3<T>(
           _s * this->data[0][0], _s * this->data[0][1], _s * this->data[0][2],
@@ -374,7 +374,7 @@ namespace gz
       /// \brief Matrix multiplication operator
       /// \param[in] _m Matrix3<T> to multiply
       /// \return Product of this * _m
-      public: Matrix3<T> operator*(const Matrix3<T> &_m) const
+      public: constexpr Matrix3<T> operator*(const Matrix3<T> &_m) const
       {
         return Matrix3<T>(
             // first row
@@ -421,7 +421,7 @@ namespace gz
       /// treated like a column vector.
       /// \param _vec Vector3
       /// \return Resulting vector from multiplication
-      public: Vector3<T> operator*(const Vector3<T> &_vec) const
+      public: constexpr Vector3<T> operator*(const Vector3<T> &_vec) const
       {
         return Vector3<T>(
             this->data[0][0]*_vec.X() + this->data[0][1]*_vec.Y() +
@@ -432,11 +432,28 @@ namespace gz
             this->data[2][2]*_vec.Z());
       }
 
+      /// \brief Return this * _vec + _add, computed per row without the
+      /// temporary that the expression with operators creates.
+      /// \param[in] _vec The vector to multiply.
+      /// \param[in] _add The vector to add to the product.
+      /// \return this * _vec + _add
+      public: constexpr Vector3<T> MultiplyAdd(const Vector3<T> &_vec,
+                  const Vector3<T> &_add) const
+      {
+        return Vector3<T>(
+            this->data[0][0]*_vec.X() + this->data[0][1]*_vec.Y() +
+            this->data[0][2]*_vec.Z() + _add.X(),
+            this->data[1][0]*_vec.X() + this->data[1][1]*_vec.Y() +
+            this->data[1][2]*_vec.Z() + _add.Y(),
+            this->data[2][0]*_vec.X() + this->data[2][1]*_vec.Y() +
+            this->data[2][2]*_vec.Z() + _add.Z());
+      }
+
       /// \brief Matrix multiplication operator for scaling.
       /// \param[in] _s Scaling factor.
       /// \param[in] _m Input matrix.
       /// \return A scaled matrix.
-      public: friend inline Matrix3<T> operator*(T _s, const Matrix3<T> &_m)
+      public: friend constexpr Matrix3<T> operator*(T _s, const Matrix3<T> &_m)
       {
         return _m * _s;
       }
@@ -447,7 +464,7 @@ namespace gz
       /// \param[in] _v Input vector.
       /// \param[in] _m Input matrix.
       /// \return The product vector.
-      public: friend inline Vector3<T> operator*(const Vector3<T> &_v,
+      public: friend constexpr Vector3<T> operator*(const Vector3<T> &_v,
                                                  const Matrix3<T> &_m)
       {
         return Vector3<T>(
@@ -502,7 +519,7 @@ namespace gz
       /// \param[in] _row row index. _row is clamped to the range [0,2]
       /// \param[in] _col column index. _col is clamped to the range [0,2]
       /// \return a pointer to the row
-      public: inline T operator()(size_t _row, size_t _col) const
+      public: constexpr T operator()(size_t _row, size_t _col) const
       {
         return this->data[clamp(_row, GZ_ZERO_SIZE_T, GZ_TWO_SIZE_T)]
                          [clamp(_col, GZ_ZERO_SIZE_T, GZ_TWO_SIZE_T)];
@@ -512,7 +529,7 @@ namespace gz
       /// \param[in] _row row index. _row is clamped to the range [0,2]
       /// \param[in] _col column index. _col is clamped to the range [0,2]
       /// \return a pointer to the row
-      public: inline T &operator()(size_t _row, size_t _col)
+      public: constexpr T &operator()(size_t _row, size_t _col)
       {
         return this->data[clamp(_row, GZ_ZERO_SIZE_T, GZ_TWO_SIZE_T)]
                          [clamp(_col, GZ_ZERO_SIZE_T, GZ_TWO_SIZE_T)];
@@ -520,7 +537,7 @@ namespace gz
 
       /// \brief Return the determinant of the matrix.
       /// \return Determinant of this matrix.
-      public: T Determinant() const
+      public: constexpr T Determinant() const
       {
         T t0 = this->data[2][2]*this->data[1][1]
              - this->data[2][1]*this->data[1][2];
@@ -572,16 +589,23 @@ namespace gz
       }
 
       /// \brief Transpose this matrix.
-      public: void Transpose()
+      public: constexpr void Transpose()
       {
-        std::swap(this->data[0][1], this->data[1][0]);
-        std::swap(this->data[0][2], this->data[2][0]);
-        std::swap(this->data[1][2], this->data[2][1]);
+        // std::swap is not constexpr until C++20
+        T tmp = this->data[0][1];
+        this->data[0][1] = this->data[1][0];
+        this->data[1][0] = tmp;
+        tmp = this->data[0][2];
+        this->data[0][2] = this->data[2][0];
+        this->data[2][0] = tmp;
+        tmp = this->data[1][2];
+        this->data[1][2] = this->data[2][1];
+        this->data[2][1] = tmp;
       }
 
       /// \brief Return the transpose of this matrix.
       /// \return Transpose of this matrix.
-      public: Matrix3<T> Transposed() const
+      public: constexpr Matrix3<T> Transposed() const
       {
         return Matrix3<T>(
           this->data[0][0], this->data[1][0], this->data[2][0],
@@ -589,6 +613,58 @@ namespace gz
           this->data[0][2], this->data[1][2], this->data[2][2]);
       }
 
+      /// \brief Make this matrix orthonormal again, for a rotation matrix
+      /// that drifted from orthonormality, such as one integrated over many
+      /// steps. Each Newton-Schulz iteration X = X (3 I - X^T X) / 2 moves
+      /// the matrix towards the closest orthonormal matrix (the orthogonal
+      /// factor of its polar decomposition), and squares the error
+      /// |X^T X - I|, without a division or a square root. Two iterations
+      /// bring an error of 1e-4 below the precision of double. The
+      /// iteration converges for matrices whose singular values are between
+      /// 0 and sqrt(3), which includes any rotation with a drift below 0.7.
+      /// Use SetFrom2Axes or a quaternion for matrices further away.
+      /// \param[in] _iterations Number of iterations.
+      public: constexpr void Orthonormalize(const unsigned int _iterations = 2)
+      {
+        for (unsigned int n = 0; n < _iterations; ++n)
+        {
+          // K = (3 I - X^T X) / 2 is symmetric
+          T k[3][3] = {};
+          for (int i = 0; i < 3; ++i)
+          {
+            for (int j = i; j < 3; ++j)
+            {
+              const T dot = this->data[0][i] * this->data[0][j] +
+                            this->data[1][i] * this->data[1][j] +
+                            this->data[2][i] * this->data[2][j];
+              k[i][j] = (i == j ? T(1.5) : T(0)) - T(0.5) * dot;
+              k[j][i] = k[i][j];
+            }
+          }
+
+          for (int r = 0; r < 3; ++r)
+          {
+            const T x0 = this->data[r][0];
+            const T x1 = this->data[r][1];
+            const T x2 = this->data[r][2];
+            for (int c = 0; c < 3; ++c)
+              this->data[r][c] = x0 * k[0][c] + x1 * k[1][c] + x2 * k[2][c];
+          }
+        }
+      }
+
+      /// \brief Return the orthonormalized matrix, as computed by
+      /// Orthonormalize.
+      /// \param[in] _iterations Number of iterations.
+      /// \return The orthonormalized matrix.
+      public: constexpr Matrix3<T> Orthonormalized(
+                  const unsigned int _iterations = 2) const
+      {
+        Matrix3<T> result = *this;
+        result.Orthonormalize(_iterations);
+        return result;
+      }
+
       /// \brief Stream insertion operator. This operator outputs all
       /// 9 scalar values in the matrix separated by a single space.
       /// \param[in, out] _out Output stream.
@@ -0,0 +1,315 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_MATRIX3ARRAY_HH_
+#define GZ_MATH_MATRIX3ARRAY_HH_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <gz/math/Matrix3.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class Matrix3Array Matrix3Array.hh gz/math/Matrix3Array.hh
+    /// \brief A structure-of-arrays container of 3x3 matrices.
+    ///
+    /// Each of the nine elements of the stored matrices is kept in its own
+    /// contiguous buffer, so that the batch operations below run as simple
+    /// loops the compiler can vectorize, such as the orthonormalization of
+    /// the rotation matrices of many rigid bodies after each step. Each
+    /// batch operation follows the semantics of the matching Matrix3
+    /// function, element by element.
+    ///
+    /// \sa Vector3Array, QuaternionArray
+    template<typename T>
+    class Matrix3Array
+    {
+      /// \brief Default constructor, creates an empty array.
+      public: Matrix3Array() = default;
+
+      /// \brief Constructor, creates an array of identity matrices.
+      /// \param[in] _size Number of matrices.
+      public: explicit Matrix3Array(const std::size_t _size)
+      {
+        this->Resize(_size);
+      }
+
+      /// \brief Constructor from an array of structures.
+      /// \param[in] _matrices Matrices to copy.
+      public: explicit Matrix3Array(const std::vector<Matrix3<T>> &_matrices)
+      {
+        this->Assign(_matrices.data(), _matrices.size());
+      }
+
+      /// \brief Replace the contents of this array.
+      /// \param[in] _matrices Pointer to the first matrix to copy.
+      /// \param[in] _count Number of matrices to copy.
+      public: void Assign(const Matrix3<T> *_matrices,
+                          const std::size_t _count)
+      {
+        this->Resize(_count);
+        for (std::size_t i = 0; i < _count; ++i)
+          this->Set(i, _matrices[i]);
+      }
+
+      /// \brief Copy the contents of this array to an array of structures.
+      /// \param[out] _matrices Destination buffer. It must hold at least
+      /// Size() matrices.
+      public: void CopyTo(Matrix3<T> *_matrices) const
+      {
+        for (std::size_t i = 0; i < this->Size(); ++i)
+          _matrices[i] = (*this)[i];
+      }
+
+      /// \brief Get the contents of this array as an array of structures.
+      /// \return A vector of Matrix3.
+      public: std::vector<Matrix3<T>> ToVector() const
+      {
+        std::vector<Matrix3<T>> result(this->Size());
+        this->CopyTo(result.data());
+        return result;
+      }
+
+      /// \brief Get the number of matrices.
+      /// \return The number of matrices stored in this array.
+      public: std::size_t Size() const
+      {
+        return this->elements[0].size();
+      }
+
+      /// \brief Change the number of matrices. New matrices are set to
+      /// identity.
+      /// \param[in] _size The new number of matrices.
+      public: void Resize(const std::size_t _size)
+      {
+        for (std::size_t e = 0; e < 9; ++e)
+          this->elements[e].resize(_size, e % 4 == 0 ? T(1) : T(0));
+      }
+
+      /// \brief Append a matrix to the end of the array.
+      /// \param[in] _m The matrix to append.
+      public: void PushBack(const Matrix3<T> &_m)
+      {
+        for (std::size_t e = 0; e < 9; ++e)
+          this->elements[e].push_back(_m(e / 3, e % 3));
+      }
+
+      /// \brief Get a matrix. The index is not checked.
+      /// \param[in] _index Index of the matrix.
+      /// \return A copy of the matrix at _index.
+      public: Matrix3<T> operator[](const std::size_t _index) const
+      {
+        const auto &m = this->elements;
+        return Matrix3<T>(
+            m[0][_index], m[1][_index], m[2][_index],
+            m[3][_index], m[4][_index], m[5][_index],
+            m[6][_index], m[7][_index], m[8][_index]);
+      }
+
+      /// \brief Set a matrix. The index is not checked.
+      /// \param[in] _index Index of the matrix.
+      /// \param[in] _m The new value.
+      public: void Set(const std::size_t _index, const Matrix3<T> &_m)
+      {
+        for (std::size_t e = 0; e < 9; ++e)
+          this->elements[e][_index] = _m(e / 3, e % 3);
+      }
+
+      /// \brief Get the buffer of one element of the matrices.
+      /// \param[in] _row Row of the element, from 0 to 2.
+      /// \param[in] _col Column of the element, from 0 to 2.
+      /// \return Pointer to Size() values.
+      public: T *Element(const std::size_t _row, const std::size_t _col)
+      {
+        return this->elements[_row * 3 + _col].data();
+      }
+
+      /// \brief Get the buffer of one element of the matrices.
+      /// \param[in] _row Row of the element, from 0 to 2.
+      /// \param[in] _col Column of the element, from 0 to 2.
+      /// \return Pointer to Size() values.
+      public: const T *Element(const std::size_t _row,
+                               const std::size_t _col) const
+      {
+        return this->elements[_row * 3 + _col].data();
+      }
+
+      /// \brief Compute the determinant of each matrix, as
+      /// Matrix3::Determinant does.
+      /// \param[out] _out The determinants, resized to Size().
+      public: void Determinant(std::vector<T> &_out) const
+      {
+        _out.resize(this->Size());
+        const T *m00 = this->Element(0, 0), *m01 = this->Element(0, 1),
+                *m02 = this->Element(0, 2), *m10 = this->Element(1, 0),
+                *m11 = this->Element(1, 1), *m12 = this->Element(1, 2),
+                *m20 = this->Element(2, 0), *m21 = this->Element(2, 1),
+                *m22 = this->Element(2, 2);
+        T *out = _out.data();
+        for (std::size_t i = 0; i < this->Size(); ++i)
+        {
+          const T t0 = m22[i] * m11[i] - m21[i] * m12[i];
+          const T t1 = -(m22[i] * m10[i] - m20[i] * m12[i]);
+          const T t2 = m21[i] * m10[i] - m20[i] * m11[i];
+          out[i] = t0 * m00[i] + t1 * m01[i] + t2 * m02[i];
+        }
+      }
+
+      /// \brief Replace each matrix by its inverse, as Matrix3::Inverse
+      /// computes it. As there, singular matrices give infinite or NaN
+      /// elements.
+      public: void Invert()
+      {
+        T b[9][kBlock];
+        for (std::size_t start = 0; start < this->Size(); start += kBlock)
+        {
+          const std::size_t n = std::min(kBlock, this->Size() - start);
+          const T *m00 = this->Element(0, 0) + start,
+                  *m01 = this->Element(0, 1) + start,
+                  *m02 = this->Element(0, 2) + start,
+                  *m10 = this->Element(1, 0) + start,
+                  *m11 = this->Element(1, 1) + start,
+                  *m12 = this->Element(1, 2) + start,
+                  *m20 = this->Element(2, 0) + start,
+                  *m21 = this->Element(2, 1) + start,
+                  *m22 = this->Element(2, 2) + start;
+          for (std::size_t i = 0; i < n; ++i)
+          {
+            const T t0 = m22[i] * m11[i] - m21[i] * m12[i];
+            const T t1 = -(m22[i] * m10[i] - m20[i] * m12[i]);
+            const T t2 = m21[i] * m10[i] - m20[i] * m11[i];
+            const T invDet = static_cast<T>(
+                1.0 / (t0 * m00[i] + t1 * m01[i] + t2 * m02[i]));
+            b[0][i] = invDet * t0;
+            b[1][i] = invDet * -(m22[i] * m01[i] - m21[i] * m02[i]);
+            b[2][i] = invDet * (m12[i] * m01[i] - m11[i] * m02[i]);
+            b[3][i] = invDet * t1;
+            b[4][i] = invDet * (m22[i] * m00[i] - m20[i] * m02[i]);
+            b[5][i] = invDet * -(m12[i] * m00[i] - m10[i] * m02[i]);
+            b[6][i] = invDet * t2;
+            b[7][i] = invDet * -(m21[i] * m00[i] - m20[i] * m01[i]);
+            b[8][i] = invDet * (m11[i] * m00[i] - m10[i] * m01[i]);
+          }
+          this->StoreBlock(start, n, b);
+        }
+      }
+
+      /// \brief Make each matrix orthonormal again with the Newton-Schulz
+      /// iterations of Matrix3::Orthonormalize, which gives the same
+      /// results. See there for the matrices it converges for.
+      /// \param[in] _iterations Number of iterations.
+      public: void Orthonormalize(const unsigned int _iterations = 2)
+      {
+        const T half = static_cast<T>(0.5);
+        const T threeHalves = static_cast<T>(1.5);
+        T a[9][kBlock];
+        for (std::size_t start = 0; start < this->Size(); start += kBlock)
+        {
+          const std::size_t n = std::min(kBlock, this->Size() - start);
+          this->LoadBlock(start, n, a);
+          for (unsigned int iteration = 0; iteration < _iterations;
+               ++iteration)
+          {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+              // K = (3 I - X^T X) / 2
+              const T k00 = threeHalves - half *
+                  (a[0][i] * a[0][i] + a[3][i] * a[3][i] + a[6][i] * a[6][i]);
+              const T k01 = -half *
+                  (a[0][i] * a[1][i] + a[3][i] * a[4][i] + a[6][i] * a[7][i]);
+              const T k02 = -half *
+                  (a[0][i] * a[2][i] + a[3][i] * a[5][i] + a[6][i] * a[8][i]);
+              const T k11 = threeHalves - half *
+                  (a[1][i] * a[1][i] + a[4][i] * a[4][i] + a[7][i] * a[7][i]);
+              const T k12 = -half *
+                  (a[1][i] * a[2][i] + a[4][i] * a[5][i] + a[7][i] * a[8][i]);
+              const T k22 = threeHalves - half *
+                  (a[2][i] * a[2][i] + a[5][i] * a[5][i] + a[8][i] * a[8][i]);
+
+              // X = X K, row by row
+              for (std::size_t r = 0; r < 9; r += 3)
+              {
+                const T x0 = a[r][i];
+                const T x1 = a[r + 1][i];
+                const T x2 = a[r + 2][i];
+                a[r][i] = x0 * k00 + x1 * k01 + x2 * k02;
+                a[r + 1][i] = x0 * k01 + x1 * k11 + x2 * k12;
+                a[r + 2][i] = x0 * k02 + x1 * k12 + x2 * k22;
+              }
+            }
+          }
+          this->StoreBlock(start, n, a);
+        }
+      }
+
+      /// \brief Number of matrices in the blocks of the kernels.
+      private: static constexpr std::size_t kBlock = 64;
+
+      /// \brief Copy a block of matrices to local buffers. The kernels work
+      /// on such blocks, because a loop over the nine buffers of this
+      /// array, which could alias as far as the compiler knows, isn't
+      /// vectorized.
+      /// \param[in] _start Index of the first matrix.
+      /// \param[in] _count Number of matrices, at most kBlock.
+      /// \param[out] _block The elements of the matrices.
+      private: void LoadBlock(const std::size_t _start,
+                              const std::size_t _count,
+                              T _block[9][kBlock]) const
+      {
+        for (std::size_t e = 0; e < 9; ++e)
+        {
+          const T *in = this->elements[e].data() + _start;
+          for (std::size_t i = 0; i < _count; ++i)
+            _block[e][i] = in[i];
+        }
+      }
+
+      /// \brief Copy a block of matrices from local buffers.
+      /// \param[in] _start Index of the first matrix.
+      /// \param[in] _count Number of matrices, at most kBlock.
+      /// \param[in] _block The elements of the matrices.
+      private: void StoreBlock(const std::size_t _start,
+                               const std::size_t _count,
+                               const T _block[9][kBlock])
+      {
+        for (std::size_t e = 0; e < 9; ++e)
+        {
+          T *out = this->elements[e].data() + _start;
+          for (std::size_t i = 0; i < _count; ++i)
+            out[i] = _block[e][i];
+        }
+      }
+
+      /// \brief The elements of the matrices, one buffer per element, in
+      /// row major order.
+      private: std::array<std::vector<T>, 9> elements;
+    };
+
+    typedef Matrix3Array<double> Matrix3Arrayd;
+    typedef Matrix3Array<float> Matrix3Arrayf;
+    }
+  }
+}
+#endif
@@ -18,13 +18,17 @@
 #define GZ_MATH_MATRIX4_HH_
 
 #include <algorithm>
+#include <cstddef>
 #include <utility>
+#include <vector>
 #include <gz/math/Helpers.hh>
 #include <gz/math/Matrix3.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/math/Pose3.hh>
 #include <gz/math/config.hh>
 
+#include <gz/utils/SuppressWarning.hh>
+
 namespace gz
 {
   namespace math
@@ -395,6 +399,51 @@ namespace gz
         return true;
       }
 
+      /// \brief Perform an affine transformation on a buffer of points.
+      /// Each output point is computed exactly as in
+      /// TransformAffine(const Vector3<T> &, Vector3<T> &) const, so the
+      /// results are identical to calling it in a loop.
+      /// \param[in] _in Pointer to the first point to transform.
+      /// \param[out] _out Pointer to the first transformed point. It may be
+      /// equal to _in to transform the buffer in place. _out is not changed
+      /// if this matrix is not affine.
+      /// \param[in] _count Number of points to transform.
+      /// \return True if this matrix is affine, false otherwise.
+      public: bool TransformAffine(const Vector3<T> *_in, Vector3<T> *_out,
+                                   const std::size_t _count) const
+      {
+        if (!this->IsAffine())
+          return false;
+
+        const T m00 = this->data[0][0], m01 = this->data[0][1],
+                m02 = this->data[0][2], m03 = this->data[0][3];
+        const T m10 = this->data[1][0], m11 = this->data[1][1],
+                m12 = this->data[1][2], m13 = this->data[1][3];
+        const T m20 = this->data[2][0], m21 = this->data[2][1],
+                m22 = this->data[2][2], m23 = this->data[2][3];
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const T x = _in[i].X();
+          const T y = _in[i].Y();
+          const T z = _in[i].Z();
+          _out[i].Set(m00 * x + m01 * y + m02 * z + m03,
+                      m10 * x + m11 * y + m12 * z + m13,
+                      m20 * x + m21 * y + m22 * z + m23);
+        }
+        return true;
+      }
+
+      /// \brief Perform an affine transformation on every point of a
+      /// vector, in place.
+      /// \param[in,out] _points The points to transform. They are not
+      /// changed if this matrix is not affine.
+      /// \return True if this matrix is affine, false otherwise.
+      public: bool TransformAffine(std::vector<Vector3<T>> &_points) const
+      {
+        return this->TransformAffine(
+            _points.data(), _points.data(), _points.size());
+      }
+
       /// \brief Return the determinant of the matrix
       /// \return Determinant of this matrix.
       public: T Determinant() const
@@ -426,9 +475,19 @@ namespace gz
       }
 
       /// \brief Return the inverse matrix.
-      /// This is a non-destructive operation.
+      /// This is a non-destructive operation. If the last row is exactly
+      /// [0 0 0 1], as for any product of transforms built from poses,
+      /// rotations, translations and scales, this is InverseAffine().
       /// \return Inverse of this matrix.
       public: Matrix4<T> Inverse() const
+      {
+        return this->HasAffineRow() ?
+            this->InverseAffine() : this->InverseGeneral();
+      }
+
+      /// \brief Return the inverse of any invertible matrix, with cofactors.
+      /// \return Inverse of this matrix.
+      private: Matrix4<T> InverseGeneral() const
       {
         T v0, v1, v2, v3, v4, v5, t00, t10, t20, t30;
         Matrix4<T> r;
@@ -519,6 +578,54 @@ namespace gz
         return r;
       }
 
+      /// \brief Return the inverse of an affine matrix, made of the inverse
+      /// of its upper-left 3x3 matrix and a translation, with less than half
+      /// of the operations of the general inverse. The last row is assumed
+      /// to be [0 0 0 1], without checking it.
+      /// \return Inverse of this matrix.
+      /// \sa IsAffine
+      public: Matrix4<T> InverseAffine() const
+      {
+        const T (*m)[4] = this->data;
+        const T c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+        const T c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+        const T c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+        const T invDet = 1 / (m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02);
+
+        Matrix4<T> r;
+        r.data[0][0] = c00 * invDet;
+        r.data[1][0] = c01 * invDet;
+        r.data[2][0] = c02 * invDet;
+        r.data[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * invDet;
+        r.data[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * invDet;
+        r.data[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * invDet;
+        r.data[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * invDet;
+        r.data[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * invDet;
+        r.data[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * invDet;
+        r.SetInverseTranslation(m[0][3], m[1][3], m[2][3]);
+        return r;
+      }
+
+      /// \brief Return the inverse of a rigid transform, such as a matrix
+      /// built from a Pose3, whose upper-left 3x3 matrix is a rotation: the
+      /// transpose of the rotation, and the translation rotated back and
+      /// negated. The matrix is assumed to be a rigid transform, without
+      /// checking it, otherwise the result is not its inverse.
+      /// \return Inverse of this matrix.
+      /// \sa InverseAffine
+      public: Matrix4<T> InverseRigid() const
+      {
+        Matrix4<T> r;
+        for (int i = 0; i < 3; ++i)
+        {
+          for (int j = 0; j < 3; ++j)
+            r.data[i][j] = this->data[j][i];
+        }
+        r.SetInverseTranslation(
+            this->data[0][3], this->data[1][3], this->data[2][3]);
+        return r;
+      }
+
       /// \brief Transpose this matrix.
       public: void Transpose()
       {
@@ -581,86 +688,27 @@ namespace gz
       /// \return This matrix * _mat
       public: Matrix4<T> operator*(const Matrix4<T> &_m2) const
       {
-        return Matrix4<T>(
-          this->data[0][0] * _m2(0, 0) +
-          this->data[0][1] * _m2(1, 0) +
-          this->data[0][2] * _m2(2, 0) +
-          this->data[0][3] * _m2(3, 0),
-
-          this->data[0][0] * _m2(0, 1) +
-          this->data[0][1] * _m2(1, 1) +
-          this->data[0][2] * _m2(2, 1) +
-          this->data[0][3] * _m2(3, 1),
-
-          this->data[0][0] * _m2(0, 2) +
-          this->data[0][1] * _m2(1, 2) +
-          this->data[0][2] * _m2(2, 2) +
-          this->data[0][3] * _m2(3, 2),
-
-          this->data[0][0] * _m2(0, 3) +
-          this->data[0][1] * _m2(1, 3) +
-          this->data[0][2] * _m2(2, 3) +
-          this->data[0][3] * _m2(3, 3),
-
-          this->data[1][0] * _m2(0, 0) +
-          this->data[1][1] * _m2(1, 0) +
-          this->data[1][2] * _m2(2, 0) +
-          this->data[1][3] * _m2(3, 0),
-
-          this->data[1][0] * _m2(0, 1) +
-          this->data[1][1] * _m2(1, 1) +
-          this->data[1][2] * _m2(2, 1) +
-          this->data[1][3] * _m2(3, 1),
-
-          this->data[1][0] * _m2(0, 2) +
-          this->data[1][1] * _m2(1, 2) +
-          this->data[1][2] * _m2(2, 2) +
-          this->data[1][3] * _m2(3, 2),
-
-          this->data[1][0] * _m2(0, 3) +
-          this->data[1][1] * _m2(1, 3) +
-          this->data[1][2] * _m2(2, 3) +
-          this->data[1][3] * _m2(3, 3),
-
-          this->data[2][0] * _m2(0, 0) +
-          this->data[2][1] * _m2(1, 0) +
-          this->data[2][2] * _m2(2, 0) +
-          this->data[2][3] * _m2(3, 0),
-
-          this->data[2][0] * _m2(0, 1) +
-          this->data[2][1] * _m2(1, 1) +
-          this->data[2][2] * _m2(2, 1) +
-          this->data[2][3] * _m2(3, 1),
-
-          this->data[2][0] * _m2(0, 2) +
-          this->data[2][1] * _m2(1, 2) +
-          this->data[2][2] * _m2(2, 2) +
-          this->data[2][3] * _m2(3, 2),
-
-          this->data[2][0] * _m2(0, 3) +
-          this->data[2][1] * _m2(1, 3) +
-          this->data[2][2] * _m2(2, 3) +
-          this->data[2][3] * _m2(3, 3),
-
-          this->data[3][0] * _m2(0, 0) +
-          this->data[3][1] * _m2(1, 0) +
-          this->data[3][2] * _m2(2, 0) +
-          this->data[3][3] * _m2(3, 0),
-
-          this->data[3][0] * _m2(0, 1) +
-          this->data[3][1] * _m2(1, 1) +
-          this->data[3][2] * _m2(2, 1) +
-          this->data[3][3] * _m2(3, 1),
-
-          this->data[3][0] * _m2(0, 2) +
-          this->data[3][1] * _m2(1, 2) +
-          this->data[3][2] * _m2(2, 2) +
-          this->data[3][3] * _m2(3, 2),
-
-          this->data[3][0] * _m2(0, 3) +
-          this->data[3][1] * _m2(1, 3) +
-          this->data[3][2] * _m2(2, 3) +
-          this->data[3][3] * _m2(3, 3));
+        // Each row of the result is a linear combination of the rows of _m2.
+        // Written this way the inner loop runs over contiguous memory and
+        // is vectorized by the compiler, while every element is still
+        // accumulated in the same order as the textbook formula.
+        Matrix4<T> result;
+        for (int i = 0; i < 4; ++i)
+        {
+          const T a0 = this->data[i][0];
+          const T a1 = this->data[i][1];
+          const T a2 = this->data[i][2];
+          const T a3 = this->data[i][3];
+          for (int j = 0; j < 4; ++j)
+          {
+            result.data[i][j] =
+              a0 * _m2.data[0][j] +
+              a1 * _m2.data[1][j] +
+              a2 * _m2.data[2][j] +
+              a3 * _m2.data[3][j];
+          }
+        }
+        return result;
       }
 
       /// \brief Multiplication operator
@@ -843,6 +891,40 @@ namespace gz
                   0,      0,         0,        1);
       }
 
+      /// \brief Whether the last row is exactly [0 0 0 1]. Products of
+      /// such matrices keep it exactly, so it is how affine transforms are
+      /// recognized, without a flag that element access could make stale.
+      /// The comparison is exact on purpose: a last row that is only close
+      /// to [0 0 0 1] must take the general inverse.
+      /// \return True if the last row is exactly [0 0 0 1].
+      private: bool HasAffineRow() const
+      {
+        GZ_UTILS_WARN_IGNORE__FLOAT_EQUAL
+        const bool affine = this->data[3][0] == 0 && this->data[3][1] == 0 &&
+            this->data[3][2] == 0 && this->data[3][3] == 1;
+        GZ_UTILS_WARN_RESUME__FLOAT_EQUAL
+        return affine;
+      }
+
+      /// \brief Complete the inverse of an affine matrix whose upper-left
+      /// 3x3 matrix is already the inverse: set the translation to the
+      /// inverse translation, and the last row to [0 0 0 1].
+      /// \param[in] _x X translation of the matrix being inverted.
+      /// \param[in] _y Y translation of the matrix being inverted.
+      /// \param[in] _z Z translation of the matrix being inverted.
+      private: void SetInverseTranslation(T _x, T _y, T _z)
+      {
+        for (int i = 0; i < 3; ++i)
+        {
+          this->data[i][3] = -(this->data[i][0] * _x +
+              this->data[i][1] * _y + this->data[i][2] * _z);
+        }
+        this->data[3][0] = 0;
+        this->data[3][1] = 0;
+        this->data[3][2] = 0;
+        this->data[3][3] = 1;
+      }
+
       /// \brief The 4x4 matrix
       private: T data[4][4];
     };
@@ -17,6 +17,10 @@
 #ifndef GZ_MATH_MATRIX6_HH_
 #define GZ_MATH_MATRIX6_HH_
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
 #include <utility>
 #include <gz/math/config.hh>
 #include <gz/math/Helpers.hh>
@@ -125,6 +129,22 @@ namespace gz
       {
       }
 
+      /// \brief Construct a matrix from its four 3x3 submatrices.
+      /// \param[in] _topLeft Top-left submatrix.
+      /// \param[in] _topRight Top-right submatrix.
+      /// \param[in] _bottomLeft Bottom-left submatrix.
+      /// \param[in] _bottomRight Bottom-right submatrix.
+      /// \sa SetSubmatrix
+      public: Matrix6(const Matrix3<T> &_topLeft, const Matrix3<T> &_topRight,
+                      const Matrix3<T> &_bottomLeft,
+                      const Matrix3<T> &_bottomRight)
+      {
+        this->SetSubmatrix(TOP_LEFT, _topLeft);
+        this->SetSubmatrix(TOP_RIGHT, _topRight);
+        this->SetSubmatrix(BOTTOM_LEFT, _bottomLeft);
+        this->SetSubmatrix(BOTTOM_RIGHT, _bottomRight);
+      }
+
       /// \brief Set a value in a specific row and col
       /// param[in] _row Row of the matrix
       /// param[in] _col Col of the matrix
@@ -316,20 +336,168 @@ namespace gz
       /// \return This matrix * _m2
       public: Matrix6<T> operator*(const Matrix6<T> &_m2) const
       {
-        auto el = [&](size_t _row, size_t _col) -> T
+        // Unrolled over the rows of _m2, so that consecutive values of a row
+        // of the result are computed together, with packed operations
+        Matrix6<T> result;
+        for (size_t r = 0; r < MatrixSize; ++r)
         {
-          T result = static_cast<T>(0);
-          for (size_t i = 0; i < MatrixSize; ++i)
-            result += this->data[_row][i] * _m2(i, _col);
-          return result;
-        };
-        return Matrix6<T>(
-            el(0, 0), el(0, 1), el(0, 2), el(0, 3), el(0, 4), el(0, 5),
-            el(1, 0), el(1, 1), el(1, 2), el(1, 3), el(1, 4), el(1, 5),
-            el(2, 0), el(2, 1), el(2, 2), el(2, 3), el(2, 4), el(2, 5),
-            el(3, 0), el(3, 1), el(3, 2), el(3, 3), el(3, 4), el(3, 5),
-            el(4, 0), el(4, 1), el(4, 2), el(4, 3), el(4, 4), el(4, 5),
-            el(5, 0), el(5, 1), el(5, 2), el(5, 3), el(5, 4), el(5, 5));
+          const T *a = this->data[r];
+          for (size_t c = 0; c < MatrixSize; ++c)
+          {
+            result.data[r][c] =
+                a[0] * _m2.data[0][c] + a[1] * _m2.data[1][c] +
+                a[2] * _m2.data[2][c] + a[3] * _m2.data[3][c] +
+                a[4] * _m2.data[4][c] + a[5] * _m2.data[5][c];
+          }
+        }
+        return result;
+      }
+
+      /// \brief Multiplication operator with a 6-vector, such as a spatial
+      /// velocity or force.
+      /// \param[in] _v Incoming vector.
+      /// \return This matrix * _v
+      public: std::array<T, MatrixSize> operator*(
+                  const std::array<T, MatrixSize> &_v) const
+      {
+        std::array<T, MatrixSize> result;
+        for (size_t r = 0; r < MatrixSize; ++r)
+        {
+          const T *a = this->data[r];
+          result[r] = a[0] * _v[0] + a[1] * _v[1] + a[2] * _v[2] +
+                      a[3] * _v[3] + a[4] * _v[4] + a[5] * _v[5];
+        }
+        return result;
+      }
+
+      /// \brief Multiply a 6-vector given as its top and bottom halves,
+      /// such as the linear and angular parts of a spatial velocity, one
+      /// 3x3 submatrix at a time.
+      /// \param[in] _top Top half of the vector.
+      /// \param[in] _bottom Bottom half of the vector.
+      /// \param[out] _resultTop Top half of this matrix * the vector.
+      /// \param[out] _resultBottom Bottom half of this matrix * the vector.
+      /// The results may be the same objects as the inputs.
+      /// \sa Submatrix
+      public: void Multiply(const Vector3<T> &_top, const Vector3<T> &_bottom,
+                            Vector3<T> &_resultTop,
+                            Vector3<T> &_resultBottom) const
+      {
+        const Vector3<T> top =
+            this->BlockProduct(0, 0, _top) + this->BlockProduct(0, 3, _bottom);
+        _resultBottom =
+            this->BlockProduct(3, 0, _top) + this->BlockProduct(3, 3, _bottom);
+        _resultTop = top;
+      }
+
+      /// \brief Multiply by a matrix whose off-diagonal 3x3 submatrices are
+      /// zero, such as the spatial inertia of a body at its center of mass,
+      /// with half of the operations of operator*.
+      /// \param[in] _topLeft Top-left submatrix of the incoming matrix.
+      /// \param[in] _bottomRight Bottom-right submatrix of the incoming
+      /// matrix.
+      /// \return This matrix * the block-diagonal matrix.
+      public: Matrix6<T> MultiplyBlockDiagonal(const Matrix3<T> &_topLeft,
+                  const Matrix3<T> &_bottomRight) const
+      {
+        Matrix6<T> result;
+        for (size_t r = 0; r < MatrixSize; ++r)
+        {
+          const T *a = this->data[r];
+          for (size_t c = 0; c < 3; ++c)
+          {
+            result.data[r][c] = a[0] * _topLeft(0, c) +
+                a[1] * _topLeft(1, c) + a[2] * _topLeft(2, c);
+            result.data[r][c + 3] = a[3] * _bottomRight(0, c) +
+                a[4] * _bottomRight(1, c) + a[5] * _bottomRight(2, c);
+          }
+        }
+        return result;
+      }
+
+      /// \brief Return the inverse matrix, computed with a Gauss-Jordan
+      /// elimination with partial pivoting. As with Matrix3::Inverse, the
+      /// values of the inverse of a singular matrix are not finite.
+      /// \return Inverse of this matrix.
+      /// \sa Solve for symmetric matrices.
+      public: Matrix6<T> Inverse() const
+      {
+        Matrix6<T> a(*this);
+        Matrix6<T> result(Identity);
+        for (size_t c = 0; c < MatrixSize; ++c)
+        {
+          size_t pivot = c;
+          for (size_t r = c + 1; r < MatrixSize; ++r)
+          {
+            if (std::abs(a.data[r][c]) > std::abs(a.data[pivot][c]))
+              pivot = r;
+          }
+          if (pivot != c)
+          {
+            std::swap(a.data[pivot], a.data[c]);
+            std::swap(result.data[pivot], result.data[c]);
+          }
+
+          const T invPivot = static_cast<T>(1) / a.data[c][c];
+          for (size_t k = 0; k < MatrixSize; ++k)
+          {
+            a.data[c][k] *= invPivot;
+            result.data[c][k] *= invPivot;
+          }
+          for (size_t r = 0; r < MatrixSize; ++r)
+          {
+            if (r == c)
+              continue;
+            const T factor = a.data[r][c];
+            for (size_t k = 0; k < MatrixSize; ++k)
+            {
+              a.data[r][k] -= factor * a.data[c][k];
+              result.data[r][k] -= factor * result.data[c][k];
+            }
+          }
+        }
+        return result;
+      }
+
+      /// \brief Solve this * _x = _b for a symmetric matrix, such as a
+      /// spatial inertia, with an LDLᵀ factorization. Only the lower
+      /// triangle of this matrix is read. There are no square roots, as
+      /// there would be in a Cholesky factorization, and symmetric
+      /// indefinite matrices are solved as long as their pivots are nonzero.
+      /// \param[in] _b Right-hand side.
+      /// \param[out] _x Solution, unchanged on failure. It may be _b.
+      /// \return False if a pivot is zero, relative to the diagonal, or not
+      /// finite, for instance if this matrix is singular.
+      public: bool Solve(const std::array<T, MatrixSize> &_b,
+                         std::array<T, MatrixSize> &_x) const
+      {
+        T l[MatrixSize][MatrixSize];
+        T d[MatrixSize];
+        if (!this->FactorLdlt(l, d))
+          return false;
+        _x = _b;
+        SolveLdlt(l, d, _x.data(), 1);
+        return true;
+      }
+
+      /// \brief Solve this * _x = _b for each column of _b, for a symmetric
+      /// matrix, with a single LDLᵀ factorization. Solving for the identity
+      /// gives the inverse of a symmetric matrix.
+      /// \param[in] _b Right-hand sides.
+      /// \param[out] _x Solutions, unchanged on failure. It may be _b.
+      /// \return False if a pivot is zero, relative to the diagonal, or not
+      /// finite, for instance if this matrix is singular.
+      /// \sa Solve(const std::array<T, MatrixSize> &,
+      /// std::array<T, MatrixSize> &) const
+      public: bool Solve(const Matrix6<T> &_b, Matrix6<T> &_x) const
+      {
+        T l[MatrixSize][MatrixSize];
+        T d[MatrixSize];
+        if (!this->FactorLdlt(l, d))
+          return false;
+        _x = _b;
+        SolveLdlt(l, d, &_x.data[0][0], MatrixSize);
+        return true;
       }
 
       /// \brief Addition assignment operator. This matrix will
@@ -552,6 +720,100 @@ namespace gz
         return _in;
       }
 
+      /// \brief Product of a 3x3 submatrix and a vector
+      /// \param[in] _row First row of the submatrix.
+      /// \param[in] _col First column of the submatrix.
+      /// \param[in] _v Vector.
+      /// \return Submatrix * _v
+      private: Vector3<T> BlockProduct(size_t _row, size_t _col,
+                                       const Vector3<T> &_v) const
+      {
+        const T (*a)[MatrixSize] = this->data + _row;
+        return Vector3<T>(
+            a[0][_col] * _v.X() + a[0][_col + 1] * _v.Y() +
+            a[0][_col + 2] * _v.Z(),
+            a[1][_col] * _v.X() + a[1][_col + 1] * _v.Y() +
+            a[1][_col + 2] * _v.Z(),
+            a[2][_col] * _v.X() + a[2][_col + 1] * _v.Y() +
+            a[2][_col + 2] * _v.Z());
+      }
+
+      /// \brief Factor this symmetric matrix as L * D * Lᵀ, from its lower
+      /// triangle.
+      /// \param[out] _l Unit lower triangular factor, of which only the
+      /// values below the diagonal are set.
+      /// \param[out] _d Diagonal factor.
+      /// \return False if a pivot is zero, relative to the diagonal, or not
+      /// finite.
+      private: bool FactorLdlt(T _l[MatrixSize][MatrixSize],
+                               T _d[MatrixSize]) const
+      {
+        T scale = static_cast<T>(0);
+        for (size_t i = 0; i < MatrixSize; ++i)
+          scale = std::max(scale, std::abs(this->data[i][i]));
+        const T tolerance = scale * std::numeric_limits<T>::epsilon();
+
+        for (size_t j = 0; j < MatrixSize; ++j)
+        {
+          // _l[j][k] * _d[k], reused by the whole column j
+          T ld[MatrixSize];
+          T pivot = this->data[j][j];
+          for (size_t k = 0; k < j; ++k)
+          {
+            ld[k] = _l[j][k] * _d[k];
+            pivot -= ld[k] * _l[j][k];
+          }
+          if (!(std::abs(pivot) > tolerance) || !std::isfinite(pivot))
+            return false;
+          _d[j] = pivot;
+
+          const T invPivot = static_cast<T>(1) / pivot;
+          for (size_t i = j + 1; i < MatrixSize; ++i)
+          {
+            T value = this->data[i][j];
+            for (size_t k = 0; k < j; ++k)
+              value -= _l[i][k] * ld[k];
+            _l[i][j] = value * invPivot;
+          }
+        }
+        return true;
+      }
+
+      /// \brief Solve L * D * Lᵀ * X = B in place, for a row-major B of
+      /// MatrixSize rows. The operations work on whole rows of B, so that
+      /// the columns are solved together.
+      /// \param[in] _l Unit lower triangular factor from FactorLdlt.
+      /// \param[in] _d Diagonal factor from FactorLdlt.
+      /// \param[in, out] _x B, overwritten by X.
+      /// \param[in] _cols Number of columns of B.
+      private: static void SolveLdlt(const T _l[MatrixSize][MatrixSize],
+                                     const T _d[MatrixSize], T *_x,
+                                     size_t _cols)
+      {
+        for (size_t i = 1; i < MatrixSize; ++i)
+        {
+          for (size_t k = 0; k < i; ++k)
+          {
+            for (size_t c = 0; c < _cols; ++c)
+              _x[i * _cols + c] -= _l[i][k] * _x[k * _cols + c];
+          }
+        }
+        for (size_t i = 0; i < MatrixSize; ++i)
+        {
+          const T invPivot = static_cast<T>(1) / _d[i];
+          for (size_t c = 0; c < _cols; ++c)
+            _x[i * _cols + c] *= invPivot;
+        }
+        for (size_t i = MatrixSize - 1; i-- > 0;)
+        {
+          for (size_t k = i + 1; k < MatrixSize; ++k)
+          {
+            for (size_t c = 0; c < _cols; ++c)
+              _x[i * _cols + c] -= _l[k][i] * _x[k * _cols + c];
+          }
+        }
+      }
+
       /// \brief The 6x6 matrix
       private: T data[MatrixSize][MatrixSize];
     };
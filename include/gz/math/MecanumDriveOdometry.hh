@@ -83,6 +83,43 @@ namespace gz
         const Angle &_backLeftPos, const Angle &_backRightPos,
         const clock::time_point &_time);
 
+      /// \brief Updates the odometry with a recorded log of wheel positions,
+      /// as if Update() was called for each sample in order, and writes the
+      /// pose after each sample. The velocities are left as after the last
+      /// sample.
+      ///
+      /// The log can be split in contiguous segments integrated in
+      /// parallel. Each segment after the first is integrated from the
+      /// origin, then moved to the end pose of the segment before it, so the
+      /// poses may differ from those of Update() by rounding. With one
+      /// thread they are the same.
+      /// \param[in] _times Time point of each sample.
+      /// \param[in] _frontLeftPos Front left wheel position of each sample,
+      /// in radians.
+      /// \param[in] _frontRightPos Front right wheel position of each sample,
+      /// in radians.
+      /// \param[in] _backLeftPos Back left wheel position of each sample, in
+      /// radians.
+      /// \param[in] _backRightPos Back right wheel position of each sample,
+      /// in radians.
+      /// \param[in] _count Number of samples.
+      /// \param[out] _x X position after each sample in meters, _count
+      /// values.
+      /// \param[out] _y Y position after each sample in meters, _count
+      /// values.
+      /// \param[out] _heading Heading after each sample in radians, _count
+      /// values.
+      /// \param[in] _threads Largest number of threads to use, zero for
+      /// std::thread::hardware_concurrency. Short logs use fewer threads.
+      /// \return Number of samples that updated the velocities, as those
+      /// for which Update() returns true.
+      /// \sa Update
+      public: size_t UpdateBatch(const clock::time_point *_times,
+        const double *_frontLeftPos, const double *_frontRightPos,
+        const double *_backLeftPos, const double *_backRightPos,
+        size_t _count, double *_x, double *_y, double *_heading,
+        unsigned int _threads = 1);
+
       /// \brief Get the heading.
       /// \return The heading in radians.
       public: const Angle &Heading() const;
@@ -114,10 +151,19 @@ namespace gz
       /// \param[in] _rightWheelRadius Radius of the right wheel.
       public: void SetWheelParams(double _wheelSeparation, double _wheelBase,
                       double _leftWheelRadius, double _rightWheelRadius);
-      /// \brief Set the velocity rolling window size.
+      /// \brief Set the velocity rolling window size. This doesn't
+      /// allocate if _size is not greater than the capacity set with
+      /// ReserveVelocityRollingWindow.
       /// \param[in] _size The Velocity rolling window size.
       public: void SetVelocityRollingWindowSize(size_t _size);
 
+      /// \brief Allocate room for velocity rolling windows of up to
+      /// _capacity values. Update() never allocates, and after this call
+      /// neither does SetVelocityRollingWindowSize() for sizes up to
+      /// _capacity, so both can be called from a real-time thread.
+      /// \param[in] _capacity The largest window size to make room for.
+      public: void ReserveVelocityRollingWindow(size_t _capacity);
+
       /// \brief Get the wheel separation
       /// \return Distance between left and right wheels in meters.
       public: double WheelSeparation() const;
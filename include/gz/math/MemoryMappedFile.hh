@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_MEMORYMAPPEDFILE_HH_
+#define GZ_MATH_MEMORYMAPPEDFILE_HH_
+
+#include <cstddef>
+#include <string>
+
+#include <gz/math/Export.hh>
+#include <gz/math/config.hh>
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class MemoryMappedFile MemoryMappedFile.hh gz/math/MemoryMappedFile.hh
+    /// \brief A read-only view of a whole file mapped into memory. Pages are
+    /// loaded on demand and shared between all processes mapping the same
+    /// file. The mapping is released when the object is destroyed.
+    ///
+    /// # Example usage
+    ///
+    /// ```{.cpp}
+    /// gz::math::MemoryMappedFile file;
+    /// if (file.Open("field.bin"))
+    ///   field.Load(file.Data(), file.Size());
+    /// ```
+    class GZ_MATH_VISIBLE MemoryMappedFile
+    {
+      /// \brief Default constructor, nothing is mapped.
+      public: MemoryMappedFile();
+
+      /// \brief Map a file, replacing any previous mapping.
+      /// \param[in] _path Path of the file.
+      /// \return True if the file was mapped. False if it could not be
+      /// opened or mapped, or if it is empty.
+      public: bool Open(const std::string &_path);
+
+      /// \brief Release the mapping. Pointers returned by Data() become
+      /// invalid.
+      public: void Close();
+
+      /// \brief Get whether a file is mapped.
+      /// \return True if a file is mapped.
+      public: bool IsOpen() const;
+
+      /// \brief Get the contents of the file.
+      /// \return Pointer to the first byte of the file, aligned to a page
+      /// boundary, or nullptr if no file is mapped.
+      public: const void *Data() const;
+
+      /// \brief Get the size of the file.
+      /// \return Size of the file in bytes, or zero if no file is mapped.
+      public: std::size_t Size() const;
+
+      /// \brief Private data pointer.
+      GZ_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+    };
+    }
+  }
+}
+#endif
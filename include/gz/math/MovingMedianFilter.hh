@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_MOVINGMEDIANFILTER_HH_
+#define GZ_MATH_MOVINGMEDIANFILTER_HH_
+
+#include <cstddef>
+#include <iterator>
+#include <set>
+#include <type_traits>
+#include <vector>
+
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    /// \class MovingMedianFilter MovingMedianFilter.hh
+    /// gz/math/MovingMedianFilter.hh
+    /// \brief Median of the last values of a signal. Unlike the mean of
+    /// MovingWindowFilter, the median ignores isolated spikes.
+    ///
+    /// The values of the window are kept in two sorted halves, so each
+    /// update costs O(log n) for a window of n values, and reading the
+    /// median costs O(1). NaN values are not supported.
+    ///
+    /// The default window size is 5.
+    /// \tparam T An arithmetic type.
+    template<typename T>
+    class MovingMedianFilter
+    {
+      static_assert(std::is_arithmetic_v<T>,
+          "MovingMedianFilter requires an arithmetic type");
+
+      /// \brief Constructor
+      /// \param[in] _windowSize Number of values in the window, at least 1.
+      public: explicit MovingMedianFilter(const unsigned int _windowSize = 5)
+      {
+        this->SetWindowSize(_windowSize);
+      }
+
+      /// \brief Update value of filter
+      /// \param[in] _val new raw value
+      public: void Update(const T _val)
+      {
+        if (this->WindowFilled())
+        {
+          // Remove the oldest value. If it is not greater than the largest
+          // value of the lower half, an equal value is in the lower half.
+          const T oldest = this->history[this->next];
+          if (!this->low.empty() && !(*this->low.rbegin() < oldest))
+            this->low.erase(this->low.find(oldest));
+          else
+            this->high.erase(this->high.find(oldest));
+          this->Balance();
+        }
+        else
+        {
+          ++this->samples;
+        }
+        this->history[this->next] = _val;
+        this->next = (this->next + 1) % this->history.size();
+
+        if (this->low.empty() || !(*this->low.rbegin() < _val))
+          this->low.insert(_val);
+        else
+          this->high.insert(_val);
+        this->Balance();
+      }
+
+      /// \brief Set window size. This forgets all the values.
+      /// \param[in] _n new desired window size, at least 1.
+      public: void SetWindowSize(const unsigned int _n)
+      {
+        this->history.assign(_n > 0 ? _n : 1, T());
+        this->low.clear();
+        this->high.clear();
+        this->next = 0;
+        this->samples = 0;
+      }
+
+      /// \brief Get the window size.
+      /// \return The size of the moving window.
+      public: unsigned int WindowSize() const
+      {
+        return static_cast<unsigned int>(this->history.size());
+      }
+
+      /// \brief Get whether the window has been filled.
+      /// \return True if the window has been filled.
+      public: bool WindowFilled() const
+      {
+        return this->samples == this->history.size();
+      }
+
+      /// \brief Get filtered result
+      /// \return Median of the values in the window. With an even number
+      /// of values, the mean of the two middle ones, rounded towards the
+      /// lower one for integral types. T() if there are no values.
+      public: T Value() const
+      {
+        if (this->low.empty())
+          return T();
+        const T lower = *this->low.rbegin();
+        if (this->low.size() > this->high.size())
+          return lower;
+        const T upper = *this->high.begin();
+        if constexpr (std::is_integral_v<T>)
+          return static_cast<T>(lower + (upper - lower) / 2);
+        else
+          return lower + (upper - lower) / 2;
+      }
+
+      /// \brief Move values between the halves so the lower half is as
+      /// large as the upper one, or one larger.
+      private: void Balance()
+      {
+        while (this->low.size() > this->high.size() + 1)
+        {
+          auto largest = std::prev(this->low.end());
+          this->high.insert(*largest);
+          this->low.erase(largest);
+        }
+        while (this->high.size() > this->low.size())
+        {
+          auto smallest = this->high.begin();
+          this->low.insert(*smallest);
+          this->high.erase(smallest);
+        }
+      }
+
+      /// \brief Values of the window, in insertion order from next.
+      private: std::vector<T> history;
+
+      /// \brief Index in history of the next value.
+      private: std::size_t next = 0;
+
+      /// \brief Number of values in the window.
+      private: std::size_t samples = 0;
+
+      /// \brief Smaller half of the values of the window.
+      private: std::multiset<T> low;
+
+      /// \brief Larger half of the values of the window.
+      private: std::multiset<T> high;
+    };
+
+    using MovingMedianFilteri = MovingMedianFilter<int>;
+    using MovingMedianFilterf = MovingMedianFilter<float>;
+    using MovingMedianFilterd = MovingMedianFilter<double>;
+    }
+  }
+}
+#endif
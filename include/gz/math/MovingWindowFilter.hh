@@ -22,6 +22,7 @@
 
 #include <gz/math/config.hh>
 #include <gz/math/Export.hh>
+#include <gz/math/Quaternion.hh>
 #include <gz/math/Vector3.hh>
 
 #include <gz/utils/SuppressWarning.hh>
@@ -36,6 +37,15 @@ namespace gz
     /// version of MovingWindowFilter in the Gazebo Common library.
     ///
     /// The default window size is 4.
+    ///
+    /// The filter keeps a running sum, so Update and Value cost O(1) and
+    /// don't allocate. For quaternions, each new value is negated if needed
+    /// to be in the same hemisphere as the running sum, since q and -q are
+    /// the same rotation, and Value returns the normalized sum. This is the
+    /// average rotation that minimizes the sum of the squared chordal
+    /// distances when the rotations of the window are close, which is a
+    /// good approximation of the eigenvector based average of Markley et
+    /// al. for filtering.
     template< typename T>
     class GZ_MATH_VISIBLE MovingWindowFilter
     {
@@ -89,6 +99,8 @@ namespace gz
     using MovingWindowFilterVector3i = MovingWindowFilter<Vector3i>;
     using MovingWindowFilterVector3f = MovingWindowFilter<Vector3f>;
     using MovingWindowFilterVector3d = MovingWindowFilter<Vector3d>;
+    using MovingWindowFilterQuaternionf = MovingWindowFilter<Quaternionf>;
+    using MovingWindowFilterQuaterniond = MovingWindowFilter<Quaterniond>;
   }
   }  // namespace math
 }  // namespace gz
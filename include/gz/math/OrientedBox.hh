@@ -17,10 +17,15 @@
 #ifndef GZ_MATH_ORIENTEDBOX_HH_
 #define GZ_MATH_ORIENTEDBOX_HH_
 
+#include <cmath>
+#include <cstddef>
 #include <ostream>
+#include <vector>
+#include <gz/math/AxisAlignedBox.hh>
 #include <gz/math/Helpers.hh>
 #include <gz/math/MassMatrix3.hh>
 #include <gz/math/Material.hh>
+#include <gz/math/Matrix3.hh>
 #include <gz/math/Matrix4.hh>
 #include <gz/math/Pose3.hh>
 #include <gz/math/Vector3.hh>
@@ -188,6 +193,62 @@ namespace gz
                p.Z() >= -this->size.Z()*0.5 && p.Z() <= this->size.Z()*0.5;
       }
 
+      /// \brief Check if this box intersects another one, with the
+      /// separating axis test on the 3 face normals of each box and the 9
+      /// cross products of their edges. It stops at the first separating
+      /// axis found. Boxes that touch intersect.
+      /// \param[in] _box Box to check.
+      /// \return True if the boxes intersect.
+      public: bool Intersects(const OrientedBox<T> &_box) const
+      {
+        return Overlap(Frame(*this), Frame(_box));
+      }
+
+      /// \brief Check if this box intersects an axis aligned box.
+      /// \param[in] _box Box to check.
+      /// \return True if the boxes intersect. An empty _box intersects
+      /// nothing.
+      /// \sa Intersects(const OrientedBox<T> &) const
+      public: bool Intersects(const AxisAlignedBox &_box) const
+      {
+        if (_box.Min().X() > _box.Max().X() ||
+            _box.Min().Y() > _box.Max().Y() ||
+            _box.Min().Z() > _box.Max().Z())
+        {
+          return false;
+        }
+
+        const Vector3d center = _box.Center();
+        const Vector3d boxSize = _box.Size();
+        Frame other;
+        other.center.Set(static_cast<T>(center.X()),
+            static_cast<T>(center.Y()), static_cast<T>(center.Z()));
+        other.axes = Matrix3<T>::Identity;
+        other.half.Set(static_cast<T>(boxSize.X() / 2),
+            static_cast<T>(boxSize.Y() / 2), static_cast<T>(boxSize.Z() / 2));
+        return Overlap(Frame(*this), other);
+      }
+
+      /// \brief Find the boxes of an array that intersect this box. The
+      /// rotation matrix of this box is computed once for all of them.
+      /// \param[in] _boxes Pointer to the boxes to check.
+      /// \param[in] _count Number of boxes.
+      /// \param[out] _indices Indices of the boxes that intersect this
+      /// box. It is cleared first.
+      /// \sa Intersects(const OrientedBox<T> &) const
+      public: void Intersects(const OrientedBox<T> *_boxes,
+                              const std::size_t _count,
+                              std::vector<std::size_t> &_indices) const
+      {
+        _indices.clear();
+        const Frame frame(*this);
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          if (Overlap(frame, Frame(_boxes[i])))
+            _indices.push_back(i);
+        }
+      }
+
       /// \brief Get the material associated with this box.
       /// \return The material assigned to this box.
       public: const gz::math::Material &Material() const
@@ -256,6 +317,96 @@ namespace gz
         return _massMat.SetFromBox(this->material, this->size);
       }
 
+      /// \brief Center, axes and half size of a box, as used by the
+      /// separating axis test.
+      private: struct Frame
+      {
+        /// \brief Default constructor.
+        Frame() = default;
+
+        /// \brief Constructor from a box.
+        /// \param[in] _box The box.
+        explicit Frame(const OrientedBox<T> &_box)
+          : center(_box.Pose().Pos()), axes(_box.Pose().Rot()),
+            half(_box.Size() / 2)
+        {
+        }
+
+        /// \brief Center of the box.
+        Vector3<T> center;
+
+        /// \brief Rotation matrix, whose columns are the axes of the box.
+        Matrix3<T> axes;
+
+        /// \brief Half size of the box.
+        Vector3<T> half;
+      };
+
+      /// \brief Separating axis test of two boxes, after "RAPID: OBBTree, A
+      /// Hierarchical Structure for Rapid Interference Detection" by
+      /// Gottschalk, Lin and Manocha. Everything is expressed in the frame
+      /// of the first box, so the projections are rows and columns of the
+      /// relative rotation.
+      /// \param[in] _a First box.
+      /// \param[in] _b Second box.
+      /// \return True if no separating axis is found.
+      private: static bool Overlap(const Frame &_a, const Frame &_b)
+      {
+        // Rotation of _b and offset between the centers in the frame of _a
+        const Matrix3<T> r = _a.axes.Transposed() * _b.axes;
+        const Vector3<T> t = _a.axes.Transposed() * (_b.center - _a.center);
+
+        // The epsilon keeps the cross product axes of nearly parallel edges,
+        // which are close to zero, from reporting a separation.
+        const T epsilon = static_cast<T>(1e-6);
+        Matrix3<T> absR;
+        for (int i = 0; i < 3; ++i)
+        {
+          for (int j = 0; j < 3; ++j)
+            absR(i, j) = std::abs(r(i, j)) + epsilon;
+        }
+
+        const Vector3<T> &a = _a.half;
+        const Vector3<T> &b = _b.half;
+
+        // Face normals of _a
+        for (int i = 0; i < 3; ++i)
+        {
+          const T rb = b[0] * absR(i, 0) + b[1] * absR(i, 1) +
+                       b[2] * absR(i, 2);
+          if (std::abs(t[i]) > a[i] + rb)
+            return false;
+        }
+
+        // Face normals of _b
+        for (int j = 0; j < 3; ++j)
+        {
+          const T ra = a[0] * absR(0, j) + a[1] * absR(1, j) +
+                       a[2] * absR(2, j);
+          const T tj = t[0] * r(0, j) + t[1] * r(1, j) + t[2] * r(2, j);
+          if (std::abs(tj) > ra + b[j])
+            return false;
+        }
+
+        // Cross products of edge i of _a and edge j of _b
+        for (int i = 0; i < 3; ++i)
+        {
+          const int i1 = (i + 1) % 3;
+          const int i2 = (i + 2) % 3;
+          for (int j = 0; j < 3; ++j)
+          {
+            const int j1 = (j + 1) % 3;
+            const int j2 = (j + 2) % 3;
+            const T ra = a[i1] * absR(i2, j) + a[i2] * absR(i1, j);
+            const T rb = b[j1] * absR(i, j2) + b[j2] * absR(i, j1);
+            const T tij = t[i2] * r(i1, j) - t[i1] * r(i2, j);
+            if (std::abs(tij) > ra + rb)
+              return false;
+          }
+        }
+        return true;
+      }
+
       /// \brief The size of the box in its local frame.
       private: Vector3<T> size;
 
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_PIDBANK_HH_
+#define GZ_MATH_PIDBANK_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+#include <gz/math/Export.hh>
+#include <gz/math/PID.hh>
+#include <gz/math/config.hh>
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    /// \class PIDBank PIDBank.hh gz/math/PIDBank.hh
+    /// \brief Many PID controllers updated together, such as the joint
+    /// controllers of a robot.
+    ///
+    /// Each channel behaves as a PID, with its own gains, limits and error
+    /// states, which are stored in arrays. An update advances all the
+    /// channels in one loop without branches, which the compiler can
+    /// vectorize: the integral and command limits are applied with min and
+    /// max, and selected per channel, so a disabled limit costs the same as
+    /// an enabled one.
+    ///
+    /// As with PID::Update, channels whose error or error rate is NaN or
+    /// infinite keep their state and output a command of zero, and nothing
+    /// changes if the time step is zero.
+    ///
+    /// **Example Usage**
+    ///
+    /// \code{.cpp}
+    /// gz::math::PIDBank pids;
+    /// for (int i = 0; i < 40; ++i)
+    ///   pids.Add(gz::math::PID(100.0, 1.0, 10.0, 5.0, -5.0, 50.0, -50.0));
+    ///
+    /// // In the control loop, with one error per joint
+    /// pids.Update(errors.data(), std::chrono::milliseconds(1));
+    /// double torque = pids.Cmd()[12];
+    /// \endcode
+    class GZ_MATH_VISIBLE PIDBank
+    {
+      /// \brief Constructor, with no channels.
+      public: PIDBank();
+
+      /// \brief Add a channel with the gains, limits, offset and command of
+      /// a PID controller, and no error.
+      /// \param[in] _pid The controller to copy.
+      /// \return Index of the channel.
+      public: size_t Add(const PID &_pid);
+
+      /// \brief Set the gains, limits, offset and command of a channel to
+      /// those of a PID controller, and reset its errors.
+      /// \param[in] _index Index of the channel, less than Size().
+      /// \param[in] _pid The controller to copy.
+      /// \return False if _index is out of range.
+      public: bool Set(size_t _index, const PID &_pid);
+
+      /// \brief Get a PID controller with the gains, limits, offset and
+      /// command of a channel.
+      /// \param[in] _index Index of the channel, less than Size().
+      /// \return The controller, or a default PID if _index is out of range.
+      public: PID Controller(size_t _index) const;
+
+      /// \brief Get the number of channels.
+      /// \return The number of channels.
+      public: size_t Size() const;
+
+      /// \brief Remove all the channels.
+      public: void Clear();
+
+      /// \brief Reset the errors and commands of all the channels.
+      public: void Reset();
+
+      /// \brief Update all the channels, estimating the error rates by
+      /// finite differences.
+      /// \param[in] _error Error of each channel (state - target), Size()
+      /// values.
+      /// \param[in] _dt Change in time since the last update.
+      /// \return The commands, Size() values.
+      /// \sa PID::Update(const double, const std::chrono::duration<double> &)
+      public: const std::vector<double> &Update(const double *_error,
+                  const std::chrono::duration<double> &_dt);
+
+      /// \brief Update all the channels with estimates of the error rates.
+      /// \param[in] _error Error of each channel (state - target), Size()
+      /// values.
+      /// \param[in] _errorRate Error rate of each channel, Size() values.
+      /// \param[in] _dt Change in time since the last update.
+      /// \return The commands, Size() values.
+      /// \sa PID::Update(const double, double,
+      /// const std::chrono::duration<double> &)
+      public: const std::vector<double> &Update(const double *_error,
+                  const double *_errorRate,
+                  const std::chrono::duration<double> &_dt);
+
+      /// \brief Get the commands of the last update.
+      /// \return The commands, Size() values.
+      public: const std::vector<double> &Cmd() const;
+
+      /// \brief Get the error terms of a channel.
+      /// \param[in] _index Index of the channel, less than Size().
+      /// \param[out] _pe The proportional error.
+      /// \param[out] _ie The integral of gain times error.
+      /// \param[out] _de The derivative error.
+      /// \return False if _index is out of range.
+      public: bool Errors(size_t _index, double &_pe, double &_ie,
+                          double &_de) const;
+
+      /// \brief Private data pointer.
+      GZ_UTILS_IMPL_PTR(dataPtr)
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,391 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_PIDT_HH_
+#define GZ_MATH_PIDT_HH_
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <type_traits>
+
+#include <gz/math/Helpers.hh>
+#include <gz/math/PID.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Compute the integral error of one step of a PID controller.
+      /// PID, PIDT and PIDBank all step with PIDIntegral and PIDCommand, so
+      /// they give the same commands. Neither has branches, so loops over
+      /// many controllers vectorize.
+      /// \param[in] _iErr Integral of gain times error at the last step.
+      /// \param[in] _error Error (p_state - p_target).
+      /// \param[in] _dt Time step in seconds.
+      /// \param[in] _iGain The integral gain.
+      /// \param[in] _iMax The integral upper limit.
+      /// \param[in] _iMin The integral lower limit.
+      /// \return The integral of gain times error.
+      template<typename T>
+      constexpr T PIDIntegral(const T _iErr, const T _error, const T _dt,
+                              const T _iGain, const T _iMax, const T _iMin)
+      {
+        const T integral = _iErr + _iGain * _dt * _error;
+        const T clamped = std::max(std::min(integral, _iMax), _iMin);
+        return _iMax >= _iMin ? clamped : integral;
+      }
+
+      /// \brief Compute the command of one step of a PID controller.
+      /// \param[in] _error Error (p_state - p_target).
+      /// \param[in] _errorRate Rate of change of the error.
+      /// \param[in] _iErr Integral of gain times error, see PIDIntegral.
+      /// \param[in] _pGain The proportional gain.
+      /// \param[in] _dGain The derivative gain.
+      /// \param[in] _cmdMax Output max value.
+      /// \param[in] _cmdMin Output min value.
+      /// \param[in] _cmdOffset Command offset (feed-forward term).
+      /// \return The command.
+      template<typename T>
+      constexpr T PIDCommand(const T _error, const T _errorRate,
+                             const T _iErr, const T _pGain, const T _dGain,
+                             const T _cmdMax, const T _cmdMin,
+                             const T _cmdOffset)
+      {
+        const T command =
+          _cmdOffset - _pGain * _error - _iErr - _dGain * _errorRate;
+        const T clamped = std::max(std::min(command, _cmdMax), _cmdMin);
+        return _cmdMax >= _cmdMin ? clamped : command;
+      }
+    }
+
+    /// \class PIDT PIDT.hh gz/math/PIDT.hh
+    /// \brief PID controller of a given precision, with the same interface
+    /// and results as PID, but with its gains, limits and state stored
+    /// inline. Controllers can be copied without an allocation and kept in
+    /// a contiguous array, such as one per joint of a robot. See PIDBank
+    /// to update many controllers in one vectorized loop.
+    /// \tparam T A floating point type.
+    template<typename T>
+    class PIDT
+    {
+      static_assert(std::is_floating_point_v<T>,
+          "PIDT requires a floating point type");
+
+      /// \brief Constructor, see PID::PID.
+      /// \param[in] _p The proportional gain.
+      /// \param[in] _i The integral gain.
+      /// \param[in] _d The derivative gain.
+      /// \param[in] _imax The integral upper limit.
+      /// \param[in] _imin The integral lower limit.
+      /// \param[in] _cmdMax Output max value.
+      /// \param[in] _cmdMin Output min value.
+      /// \param[in] _cmdOffset Command offset (feed-forward term).
+      public: constexpr PIDT(const T _p = 0, const T _i = 0, const T _d = 0,
+                             const T _imax = -1, const T _imin = 0,
+                             const T _cmdMax = -1, const T _cmdMin = 0,
+                             const T _cmdOffset = 0)
+      : pGain(_p), iGain(_i), dGain(_d), iMax(_imax), iMin(_imin),
+        cmdMax(_cmdMax), cmdMin(_cmdMin), cmdOffset(_cmdOffset)
+      {
+      }
+
+      /// \brief Construct from a PID, with its gains, limits and command,
+      /// and no error.
+      /// \param[in] _pid The controller to copy.
+      public: explicit PIDT(const PID &_pid)
+      : PIDT(static_cast<T>(_pid.PGain()), static_cast<T>(_pid.IGain()),
+             static_cast<T>(_pid.DGain()), static_cast<T>(_pid.IMax()),
+             static_cast<T>(_pid.IMin()), static_cast<T>(_pid.CmdMax()),
+             static_cast<T>(_pid.CmdMin()), static_cast<T>(_pid.CmdOffset()))
+      {
+        this->cmd = static_cast<T>(_pid.Cmd());
+      }
+
+      /// \brief Get a PID with the same gains, limits and command, and no
+      /// error.
+      /// \return The controller.
+      public: PID ToPID() const
+      {
+        PID pid(this->pGain, this->iGain, this->dGain, this->iMax,
+                this->iMin, this->cmdMax, this->cmdMin, this->cmdOffset);
+        pid.SetCmd(this->cmd);
+        return pid;
+      }
+
+      /// \brief Set the gains, limits and offset, and reset the errors and
+      /// command, see PID::Init.
+      /// \param[in] _p The proportional gain.
+      /// \param[in] _i The integral gain.
+      /// \param[in] _d The derivative gain.
+      /// \param[in] _imax The integral upper limit.
+      /// \param[in] _imin The integral lower limit.
+      /// \param[in] _cmdMax Output max value.
+      /// \param[in] _cmdMin Output min value.
+      /// \param[in] _cmdOffset Command offset (feed-forward term).
+      public: constexpr void Init(const T _p = 0, const T _i = 0,
+                                  const T _d = 0, const T _imax = -1,
+                                  const T _imin = 0, const T _cmdMax = -1,
+                                  const T _cmdMin = 0,
+                                  const T _cmdOffset = 0)
+      {
+        *this = PIDT(_p, _i, _d, _imax, _imin, _cmdMax, _cmdMin, _cmdOffset);
+      }
+
+      /// \brief Set the proportional gain.
+      /// \param[in] _p Proportional gain value.
+      public: constexpr void SetPGain(const T _p)
+      {
+        this->pGain = _p;
+      }
+
+      /// \brief Set the integral gain.
+      /// \param[in] _i Integral gain value.
+      public: constexpr void SetIGain(const T _i)
+      {
+        this->iGain = _i;
+      }
+
+      /// \brief Set the derivative gain.
+      /// \param[in] _d Derivative gain value.
+      public: constexpr void SetDGain(const T _d)
+      {
+        this->dGain = _d;
+      }
+
+      /// \brief Set the integral upper limit.
+      /// \param[in] _i Integral upper limit value.
+      public: constexpr void SetIMax(const T _i)
+      {
+        this->iMax = _i;
+      }
+
+      /// \brief Set the integral lower limit.
+      /// \param[in] _i Integral lower limit value.
+      public: constexpr void SetIMin(const T _i)
+      {
+        this->iMin = _i;
+      }
+
+      /// \brief Set the maximum value for the command.
+      /// \param[in] _c The maximum value.
+      public: constexpr void SetCmdMax(const T _c)
+      {
+        this->cmdMax = _c;
+      }
+
+      /// \brief Set the minimum value for the command.
+      /// \param[in] _c The minimum value.
+      public: constexpr void SetCmdMin(const T _c)
+      {
+        this->cmdMin = _c;
+      }
+
+      /// \brief Set the offset value for the command, which is added to
+      /// the result of the PID controller.
+      /// \param[in] _c The offset value.
+      public: constexpr void SetCmdOffset(const T _c)
+      {
+        this->cmdOffset = _c;
+      }
+
+      /// \brief Get the proportional gain.
+      /// \return The proportional gain value.
+      public: constexpr T PGain() const
+      {
+        return this->pGain;
+      }
+
+      /// \brief Get the integral gain.
+      /// \return The integral gain value.
+      public: constexpr T IGain() const
+      {
+        return this->iGain;
+      }
+
+      /// \brief Get the derivative gain.
+      /// \return The derivative gain value.
+      public: constexpr T DGain() const
+      {
+        return this->dGain;
+      }
+
+      /// \brief Get the integral upper limit.
+      /// \return The integral upper limit value.
+      public: constexpr T IMax() const
+      {
+        return this->iMax;
+      }
+
+      /// \brief Get the integral lower limit.
+      /// \return The integral lower limit value.
+      public: constexpr T IMin() const
+      {
+        return this->iMin;
+      }
+
+      /// \brief Get the maximum value for the command.
+      /// \return The maximum value.
+      public: constexpr T CmdMax() const
+      {
+        return this->cmdMax;
+      }
+
+      /// \brief Get the minimum value for the command.
+      /// \return The minimum value.
+      public: constexpr T CmdMin() const
+      {
+        return this->cmdMin;
+      }
+
+      /// \brief Get the offset value for the command.
+      /// \return The offset value.
+      public: constexpr T CmdOffset() const
+      {
+        return this->cmdOffset;
+      }
+
+      /// \brief Update the controller with an error rate, see PID::Update.
+      /// \param[in] _error Error since last call (p_state - p_target).
+      /// \param[in] _errorRate Rate of change of the error.
+      /// \param[in] _dt Change in time since last update call.
+      /// \return The command, or zero if the time step is zero or an error
+      /// is not finite, in which case the state is unchanged.
+      public: T Update(const T _error, const T _errorRate,
+                       const std::chrono::duration<double> &_dt)
+      {
+        if (_dt == std::chrono::duration<double>(0) ||
+            !std::isfinite(_error) || !std::isfinite(_errorRate))
+        {
+          return 0;
+        }
+
+        this->pErr = _error;
+        this->dErr = _errorRate;
+        this->pErrLast = _error;
+        this->iErr = detail::PIDIntegral(this->iErr, _error,
+            static_cast<T>(_dt.count()), this->iGain, this->iMax,
+            this->iMin);
+        this->cmd = detail::PIDCommand(_error, _errorRate, this->iErr,
+            this->pGain, this->dGain, this->cmdMax, this->cmdMin,
+            this->cmdOffset);
+        return this->cmd;
+      }
+
+      /// \brief Update the controller, with the error rate from the
+      /// previous error, see PID::Update.
+      /// \param[in] _error Error since last call (p_state - p_target).
+      /// \param[in] _dt Change in time since last update call.
+      /// \return The command, or zero if the time step is zero or the error
+      /// is not finite.
+      public: T Update(const T _error,
+                       const std::chrono::duration<double> &_dt)
+      {
+        if (_dt == std::chrono::duration<double>(0) ||
+            !std::isfinite(_error))
+        {
+          return 0;
+        }
+        return this->Update(_error, (_error - this->pErrLast) /
+                            static_cast<T>(_dt.count()), _dt);
+      }
+
+      /// \brief Set the current command.
+      /// \param[in] _cmd New command.
+      public: constexpr void SetCmd(const T _cmd)
+      {
+        this->cmd = _cmd;
+      }
+
+      /// \brief Get the current command.
+      /// \return The current command.
+      public: constexpr T Cmd() const
+      {
+        return this->cmd;
+      }
+
+      /// \brief Get the current errors.
+      /// \param[out] _pe The proportional error.
+      /// \param[out] _ie The integral of gain times error.
+      /// \param[out] _de The derivative error.
+      public: constexpr void Errors(T &_pe, T &_ie, T &_de) const
+      {
+        _pe = this->pErr;
+        _ie = this->iErr;
+        _de = this->dErr;
+      }
+
+      /// \brief Reset the errors and command.
+      public: constexpr void Reset()
+      {
+        this->pErrLast = 0;
+        this->pErr = 0;
+        this->iErr = 0;
+        this->dErr = 0;
+        this->cmd = 0;
+      }
+
+      /// \brief Gain for proportional control.
+      private: T pGain = 0;
+
+      /// \brief Gain for integral control.
+      private: T iGain = 0;
+
+      /// \brief Gain for derivative control.
+      private: T dGain = 0;
+
+      /// \brief Maximum clamping value for integral term.
+      private: T iMax = -1;
+
+      /// \brief Minimum clamping value for integral term.
+      private: T iMin = 0;
+
+      /// \brief Max command clamping value.
+      private: T cmdMax = -1;
+
+      /// \brief Min command clamping value.
+      private: T cmdMin = 0;
+
+      /// \brief Command offset.
+      private: T cmdOffset = 0;
+
+      /// \brief Error at the previous step.
+      private: T pErrLast = 0;
+
+      /// \brief Current error.
+      private: T pErr = 0;
+
+      /// \brief Integral of gain times error.
+      private: T iErr = 0;
+
+      /// \brief Derivative error.
+      private: T dErr = 0;
+
+      /// \brief Command value.
+      private: T cmd = 0;
+    };
+
+    using PIDd = PIDT<double>;
+    using PIDf = PIDT<float>;
+    }
+  }
+}
+#endif
@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_PHILOX_HH_
+#define GZ_MATH_PHILOX_HH_
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <gz/math/Helpers.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    /// \class Philox4x32 Philox.hh gz/math/Philox.hh
+    /// \brief Counter-based random number generator, Philox4x32-10 of
+    /// Salmon et al., "Parallel random numbers: as easy as 1, 2, 3" (2011).
+    ///
+    /// Each block of four 32 bit outputs is a function of a 64 bit key, the
+    /// seed, and a 128 bit counter, made of a 64 bit position and a 64 bit
+    /// stream id. Numbers can be computed in any order and on any thread,
+    /// the results only depend on the seed, stream and position. For
+    /// example, the noise of an entity at a time step can be
+    /// Uniform(seed, step, entity), whichever thread computes it.
+    ///
+    /// A Philox4x32 object is a sequential generator over the blocks of a
+    /// stream, usable with the distributions of <random>, that can skip
+    /// ahead in constant time with Discard().
+    class Philox4x32
+    {
+      /// \brief Type of the outputs.
+      public: using result_type = uint32_t;
+
+      /// \brief A block of outputs, or a counter.
+      public: using Block = std::array<uint32_t, 4>;
+
+      /// \brief Constructor
+      /// \param[in] _seed The seed.
+      /// \param[in] _stream Stream id, different for each generator that
+      /// should draw different numbers.
+      public: explicit Philox4x32(const uint64_t _seed = 0,
+                                  const uint64_t _stream = 0)
+        : seed(_seed), stream(_stream)
+      {
+      }
+
+      /// \brief Smallest output.
+      /// \return 0
+      public: static constexpr result_type min() { return 0; }
+
+      /// \brief Largest output.
+      /// \return UINT32_MAX
+      public: static constexpr result_type max() { return UINT32_MAX; }
+
+      /// \brief Get the next output.
+      /// \return The next output.
+      public: result_type operator()()
+      {
+        if (this->position / 4 != this->bufferBlock)
+        {
+          this->bufferBlock = this->position / 4;
+          this->buffer = Compute(this->seed,
+              Counter(this->bufferBlock, this->stream));
+        }
+        return this->buffer[this->position++ % 4];
+      }
+
+      /// \brief Skip outputs in constant time.
+      /// \param[in] _count Number of outputs to skip.
+      public: void Discard(const uint64_t _count)
+      {
+        this->position += _count;
+      }
+
+      /// \brief Get the number of outputs drawn so far.
+      /// \return The position in the stream.
+      public: uint64_t Position() const
+      {
+        return this->position;
+      }
+
+      /// \brief Get the seed.
+      /// \return The seed.
+      public: uint64_t Seed() const
+      {
+        return this->seed;
+      }
+
+      /// \brief Get the stream id.
+      /// \return The stream id.
+      public: uint64_t Stream() const
+      {
+        return this->stream;
+      }
+
+      /// \brief Get a double from a uniform distribution in [0, 1), a
+      /// function of its arguments only. This uses the first two outputs of
+      /// block _counter of stream _stream.
+      /// \param[in] _seed The seed.
+      /// \param[in] _counter Position of the number, such as a time step.
+      /// \param[in] _stream Stream id, such as an entity id.
+      /// \return The random number.
+      public: static double Uniform(const uint64_t _seed,
+                                    const uint64_t _counter,
+                                    const uint64_t _stream = 0)
+      {
+        const Block block = Compute(_seed, Counter(_counter, _stream));
+        return ToUnit(block[0], block[1]);
+      }
+
+      /// \brief Get a double from a standard normal distribution, a
+      /// function of its arguments only. This uses the Box-Muller transform
+      /// of block _counter of stream _stream.
+      /// \param[in] _seed The seed.
+      /// \param[in] _counter Position of the number, such as a time step.
+      /// \param[in] _stream Stream id, such as an entity id.
+      /// \return The random number.
+      public: static double Normal(const uint64_t _seed,
+                                   const uint64_t _counter,
+                                   const uint64_t _stream = 0)
+      {
+        const Block block = Compute(_seed, Counter(_counter, _stream));
+        return BoxMuller(block);
+      }
+
+      /// \brief Fill an array with Uniform(_seed, _counter + i, _stream).
+      /// The blocks are independent, so the compiler can vectorize the loop
+      /// over them.
+      /// \param[in] _seed The seed.
+      /// \param[in] _counter Position of the first number.
+      /// \param[in] _stream Stream id.
+      /// \param[out] _out Pointer to the first number.
+      /// \param[in] _count Number of numbers.
+      public: static void Uniform(const uint64_t _seed,
+                                  const uint64_t _counter,
+                                  const uint64_t _stream,
+                                  double *_out, const size_t _count)
+      {
+        for (size_t i = 0; i < _count; ++i)
+          _out[i] = Uniform(_seed, _counter + i, _stream);
+      }
+
+      /// \brief Fill an array with Normal(_seed, _counter + i, _stream).
+      /// \param[in] _seed The seed.
+      /// \param[in] _counter Position of the first number.
+      /// \param[in] _stream Stream id.
+      /// \param[out] _out Pointer to the first number.
+      /// \param[in] _count Number of numbers.
+      public: static void Normal(const uint64_t _seed,
+                                 const uint64_t _counter,
+                                 const uint64_t _stream,
+                                 double *_out, const size_t _count)
+      {
+        for (size_t i = 0; i < _count; ++i)
+          _out[i] = Normal(_seed, _counter + i, _stream);
+      }
+
+      /// \brief Compute the block of a counter.
+      /// \param[in] _seed The seed, used as key.
+      /// \param[in] _counter The counter.
+      /// \return The block of outputs.
+      public: static Block Compute(const uint64_t _seed,
+                                   const Block &_counter)
+      {
+        uint32_t k0 = static_cast<uint32_t>(_seed);
+        uint32_t k1 = static_cast<uint32_t>(_seed >> 32);
+        uint32_t c0 = _counter[0];
+        uint32_t c1 = _counter[1];
+        uint32_t c2 = _counter[2];
+        uint32_t c3 = _counter[3];
+        for (int round = 0; round < 10; ++round)
+        {
+          const uint64_t p0 = uint64_t{0xD2511F53u} * c0;
+          const uint64_t p1 = uint64_t{0xCD9E8D57u} * c2;
+          c0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+          c2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+          c1 = static_cast<uint32_t>(p1);
+          c3 = static_cast<uint32_t>(p0);
+          k0 += 0x9E3779B9u;
+          k1 += 0xBB67AE85u;
+        }
+        return {c0, c1, c2, c3};
+      }
+
+      /// \brief Get the counter of a block.
+      /// \param[in] _block Index of the block in the stream.
+      /// \param[in] _stream Stream id.
+      /// \return The counter.
+      public: static Block Counter(const uint64_t _block,
+                                   const uint64_t _stream)
+      {
+        return {static_cast<uint32_t>(_block),
+                static_cast<uint32_t>(_block >> 32),
+                static_cast<uint32_t>(_stream),
+                static_cast<uint32_t>(_stream >> 32)};
+      }
+
+      /// \brief Convert two outputs to a double in [0, 1) with 53 bits.
+      /// \param[in] _lo Low output.
+      /// \param[in] _hi High output.
+      /// \return The double.
+      private: static double ToUnit(const uint32_t _lo, const uint32_t _hi)
+      {
+        const uint64_t bits = (uint64_t{_hi} << 32) | _lo;
+        return static_cast<double>(bits >> 11) * 0x1.0p-53;
+      }
+
+      /// \brief Box-Muller transform of a block.
+      /// \param[in] _block The block.
+      /// \return A double from a standard normal distribution.
+      private: static double BoxMuller(const Block &_block)
+      {
+        // u1 in (0, 1] so the logarithm is finite.
+        const double u1 = 1.0 - ToUnit(_block[0], _block[1]);
+        const double u2 = ToUnit(_block[2], _block[3]);
+        return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * GZ_PI * u2);
+      }
+
+      /// \brief The seed.
+      private: uint64_t seed;
+
+      /// \brief The stream id.
+      private: uint64_t stream;
+
+      /// \brief Number of outputs drawn.
+      private: uint64_t position = 0;
+
+      /// \brief Index of the block in buffer.
+      private: uint64_t bufferBlock = UINT64_MAX;
+
+      /// \brief Outputs of the current block.
+      private: Block buffer{};
+    };
+    }
+  }
+}
+#endif
@@ -18,6 +18,7 @@
 #define GZ_MATH_PIECEWISE_SCALAR_FIELD3_HH_
 
 #include <algorithm>
+#include <cstddef>
 #include <iostream>
 #include <limits>
 #include <utility>
@@ -26,6 +27,9 @@
 #include <gz/math/Region3.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/math/config.hh>
+#include <gz/math/detail/ParallelFor.hh>
+
+#include <gz/utils/SuppressWarning.hh>
 
 namespace gz
 {
@@ -53,6 +57,16 @@ namespace gz
     /// \tparam ScalarT a numeric type for which std::numeric_limits<> traits
     ///   have been specialized.
     ///
+    /// The regions are kept in a bounding volume hierarchy built on
+    /// construction, so evaluating the field costs O(log n) for n
+    /// non-overlapping regions instead of checking every region.
+    ///
+    /// The field is immutable, so the minimum of each piece can be computed
+    /// once with CacheMinima. Minimum then returns the cached global
+    /// minimum, and the minimum over a region only computes the minimum of
+    /// the pieces that intersect it and may be lower than the best one
+    /// found so far.
+    ///
     /// ## Example
     ///
     /// \snippet examples/piecewise_scalar_field3_example.cc complete
@@ -75,6 +89,8 @@ namespace gz
       public: explicit PiecewiseScalarField3(const std::vector<Piece> &_pieces)
       : pieces(_pieces)
       {
+        this->BuildTree();
+        std::vector<std::size_t> overlaps;
         for (size_t i = 0; i < pieces.size(); ++i)
         {
           if (pieces[i].region.Empty())
@@ -82,19 +98,24 @@ namespace gz
             std::cerr << "Region #" << i << " (" << pieces[i].region
                       << ") in piecewise scalar field definition is empty."
                       << std::endl;
+            continue;
           }
-          for (size_t j = i + 1; j < pieces.size(); ++j)
+          this->FindIntersecting(pieces[i].region, overlaps);
+          std::sort(overlaps.begin(), overlaps.end());
+          for (const size_t j : overlaps)
           {
-            if (pieces[i].region.Intersects(pieces[j].region))
+            if (j <= i)
             {
-              std::cerr << "Detected overlap between regions in "
-                        << "piecewise scalar field definition: "
-                        << "region #" << i << " (" << pieces[i].region
-                        << ") overlaps with region #" << j << " ("
-                        << pieces[j].region << "). Region #" << i
-                        << " will take precedence when overlapping."
-                        << std::endl;
+              continue;
             }
+            this->overlapping = true;
+            std::cerr << "Detected overlap between regions in "
+                      << "piecewise scalar field definition: "
+                      << "region #" << i << " (" << pieces[i].region
+                      << ") overlaps with region #" << j << " ("
+                      << pieces[j].region << "). Region #" << i
+                      << " will take precedence when overlapping."
+                      << std::endl;
           }
         }
       }
@@ -114,17 +135,36 @@ namespace gz
       ///   if the scalar field is not defined at `_p`
       public: ScalarT Evaluate(const Vector3<ScalarT> &_p) const
       {
-        auto it = std::find_if(
-            this->pieces.begin(), this->pieces.end(),
-            [&](const Piece &piece)
-            {
-              return piece.region.Contains(_p);
-            });
-        if (it == this->pieces.end())
+        const std::size_t index = this->FindPiece(_p);
+        if (index == this->pieces.size())
         {
           return std::numeric_limits<ScalarT>::quiet_NaN();
         }
-        return it->field(_p);
+        return this->pieces[index].field(_p);
+      }
+
+      /// \brief Evaluate the piecewise scalar field at many points. Nearby
+      /// consecutive points are faster, since the region of the previous
+      /// point is checked first when regions do not overlap.
+      /// \param[in] _p pointer to the first piecewise scalar field argument
+      /// \param[out] _out pointer to the first of `_count` results, NaN
+      ///   where the scalar field is not defined
+      /// \param[in] _count number of arguments
+      public: void Evaluate(const Vector3<ScalarT> *_p, ScalarT *_out,
+                            const std::size_t _count) const
+      {
+        std::size_t index = this->pieces.size();
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          if (this->overlapping || index == this->pieces.size() ||
+              !this->pieces[index].region.Contains(_p[i]))
+          {
+            index = this->FindPiece(_p[i]);
+          }
+          _out[i] = index == this->pieces.size() ?
+              std::numeric_limits<ScalarT>::quiet_NaN() :
+              this->pieces[index].field(_p[i]);
+        }
       }
 
       /// \brief Call operator overload
@@ -137,10 +177,76 @@ namespace gz
         return this->Evaluate(_p);
       }
 
+      /// \brief Compute the minimum of each piece over its region, in
+      /// parallel, and keep them for the next calls to Minimum.
+      /// \param[in] _threads number of threads, 0 to use the hardware
+      ///   concurrency
+      public: void CacheMinima(const unsigned int _threads = 1)
+      {
+        const std::size_t count = this->pieces.size();
+        std::vector<CachedMinimum> minima(count);
+        detail::ParallelFor(count, detail::ChunkCount(count, _threads),
+            [&](std::size_t, const std::size_t _begin, const std::size_t _end)
+        {
+          for (std::size_t i = _begin; i < _end; ++i)
+          {
+            minima[i].value = std::numeric_limits<ScalarT>::infinity();
+            minima[i].point = Vector3<ScalarT>::NaN;
+            if (!this->pieces[i].region.Empty())
+            {
+              minima[i].value = this->pieces[i].field.Minimum(
+                  this->pieces[i].region, minima[i].point);
+            }
+          }
+        });
+
+        // Children come after their parent, so the nodes are reduced in
+        // reverse order
+        std::vector<ScalarT> subtreeMinima(this->nodes.size());
+        for (std::size_t n = this->nodes.size(); n-- > 0;)
+        {
+          const Node &node = this->nodes[n];
+          ScalarT value = std::numeric_limits<ScalarT>::infinity();
+          if (node.count > 0)
+          {
+            for (std::size_t i = node.begin; i < node.begin + node.count; ++i)
+            {
+              value = std::min(value, minima[this->pieceOrder[i]].value);
+            }
+          }
+          else
+          {
+            value = std::min(subtreeMinima[n + 1], subtreeMinima[node.begin]);
+          }
+          subtreeMinima[n] = value;
+        }
+        this->minimumPiece = count;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+          if (minima[i].value < std::numeric_limits<ScalarT>::infinity() &&
+              (this->minimumPiece == count ||
+               minima[i].value < minima[this->minimumPiece].value))
+          {
+            this->minimumPiece = i;
+          }
+        }
+        this->pieceMinima = std::move(minima);
+        this->nodeMinima = std::move(subtreeMinima);
+      }
+
+      /// \brief Whether the minima of the pieces are cached.
+      /// \return true if CacheMinima was called
+      public: bool MinimaCached() const
+      {
+        return this->pieceMinima.size() == this->pieces.size() &&
+            !this->pieces.empty();
+      }
+
       /// \brief Compute the piecewise scalar field minimum
       /// Note that, since this method computes the minimum
       /// for each region independently, it implicitly assumes
       /// continuity in the boundaries between regions, if any.
+      /// The cached minimum is returned once CacheMinima was called.
       /// \param[out] _pMin scalar field argument that yields
       ///   the minimum, or NaN if the scalar field is not
       ///   defined anywhere (i.e. default constructed)
@@ -154,6 +260,15 @@ namespace gz
           _pMin = Vector3<ScalarT>::NaN;
           return std::numeric_limits<ScalarT>::quiet_NaN();
         }
+        if (this->MinimaCached())
+        {
+          if (this->minimumPiece == this->pieces.size())
+          {
+            return std::numeric_limits<ScalarT>::infinity();
+          }
+          _pMin = this->pieceMinima[this->minimumPiece].point;
+          return this->pieceMinima[this->minimumPiece].value;
+        }
         ScalarT yMin = std::numeric_limits<ScalarT>::infinity();
         for (const Piece &piece : this->pieces)
         {
@@ -181,6 +296,111 @@ namespace gz
         return this->Minimum(pMin);
       }
 
+      /// \brief Compute the piecewise scalar field minimum within a region.
+      /// The pieces whose regions intersect `_region` are found with the
+      /// hierarchy of the regions. Once CacheMinima was called, the pieces
+      /// whose cached minimum is not lower than the best one found so far
+      /// are skipped, and the cached minimum of a piece is used as is when
+      /// its argument lies within `_region`.
+      /// \param[in] _region region to look for the minimum in
+      /// \param[out] _pMin scalar field argument that yields
+      ///   the minimum, or NaN if the scalar field is not
+      ///   defined anywhere in `_region`
+      /// \return the scalar field minimum in `_region`, or NaN if
+      ///   the scalar field is not defined anywhere in `_region`
+      public: ScalarT Minimum(const Region3<ScalarT> &_region,
+                              Vector3<ScalarT> &_pMin) const
+      {
+        _pMin = Vector3<ScalarT>::NaN;
+        if (this->nodes.empty() || _region.Empty())
+        {
+          return std::numeric_limits<ScalarT>::quiet_NaN();
+        }
+        const bool cached = this->MinimaCached();
+        const Vector3<ScalarT> lower(_region.Ix().LeftValue(),
+            _region.Iy().LeftValue(), _region.Iz().LeftValue());
+        const Vector3<ScalarT> upper(_region.Ix().RightValue(),
+            _region.Iy().RightValue(), _region.Iz().RightValue());
+
+        bool found = false;
+        ScalarT yMin = std::numeric_limits<ScalarT>::infinity();
+        // The tree is balanced, so its depth is at most 64
+        std::size_t stack[64];
+        std::size_t size = 0;
+        stack[size++] = 0;
+        while (size > 0)
+        {
+          const std::size_t index = stack[--size];
+          const Node &node = this->nodes[index];
+          if (!(node.min.X() <= upper.X() && lower.X() <= node.max.X() &&
+                node.min.Y() <= upper.Y() && lower.Y() <= node.max.Y() &&
+                node.min.Z() <= upper.Z() && lower.Z() <= node.max.Z()))
+          {
+            continue;
+          }
+          if (cached && found && !(this->nodeMinima[index] < yMin))
+          {
+            continue;
+          }
+          if (node.count == 0)
+          {
+            // Visit first the child with the lowest minimum
+            std::size_t first = index + 1;
+            std::size_t second = node.begin;
+            if (cached &&
+                this->nodeMinima[second] < this->nodeMinima[first])
+            {
+              std::swap(first, second);
+            }
+            stack[size++] = second;
+            stack[size++] = first;
+            continue;
+          }
+          for (std::size_t i = node.begin; i < node.begin + node.count; ++i)
+          {
+            const std::size_t piece = this->pieceOrder[i];
+            const Piece &candidate = this->pieces[piece];
+            if (!candidate.region.Intersects(_region))
+            {
+              continue;
+            }
+            if (cached && found && !(this->pieceMinima[piece].value < yMin))
+            {
+              continue;
+            }
+            Vector3<ScalarT> p;
+            ScalarT y;
+            if (cached && _region.Contains(this->pieceMinima[piece].point))
+            {
+              p = this->pieceMinima[piece].point;
+              y = this->pieceMinima[piece].value;
+            }
+            else
+            {
+              y = candidate.field.Minimum(
+                  Intersection(candidate.region, _region), p);
+            }
+            if (!found || y < yMin)
+            {
+              _pMin = p;
+              yMin = y;
+              found = true;
+            }
+          }
+        }
+        return found ? yMin : std::numeric_limits<ScalarT>::quiet_NaN();
+      }
+
+      /// \brief Compute the piecewise scalar field minimum within a region.
+      /// \param[in] _region region to look for the minimum in
+      /// \return the scalar field minimum in `_region`, or NaN if
+      ///   the scalar field is not defined anywhere in `_region`
+      public: ScalarT Minimum(const Region3<ScalarT> &_region) const
+      {
+        Vector3<ScalarT> pMin;
+        return this->Minimum(_region, pMin);
+      }
+
       /// \brief Stream insertion operator
       /// \param _out output stream
       /// \param _field SeparableScalarField3 to output
@@ -204,8 +424,342 @@ namespace gz
                     << _field.pieces.back().region;
       }
 
+      /// \brief Node of the bounding volume hierarchy of the regions.
+      private: struct Node
+      {
+        /// \brief Lower corner of the closed bounds of the regions.
+        Vector3<ScalarT> min;
+
+        /// \brief Upper corner of the closed bounds of the regions.
+        Vector3<ScalarT> max;
+
+        /// \brief Smallest index of the pieces below the node, which
+        /// takes precedence over the others.
+        std::size_t minPiece;
+
+        /// \brief For a leaf, the first of its pieces in pieceOrder. For
+        /// an inner node, the index of its second child, the first child
+        /// being the next node.
+        std::size_t begin;
+
+        /// \brief Number of pieces of a leaf, 0 for an inner node.
+        std::size_t count;
+
+        /// \brief Check whether the bounds contain a point.
+        /// \param[in] _p point to check
+        /// \return true if `_p` is within the bounds
+        bool Contains(const Vector3<ScalarT> &_p) const
+        {
+          return this->min.X() <= _p.X() && _p.X() <= this->max.X() &&
+                 this->min.Y() <= _p.Y() && _p.Y() <= this->max.Y() &&
+                 this->min.Z() <= _p.Z() && _p.Z() <= this->max.Z();
+        }
+      };
+
+      /// \brief Minimum of a piece over its region.
+      private: struct CachedMinimum
+      {
+        /// \brief The minimum, infinity if the region is empty.
+        ScalarT value;
+
+        /// \brief Argument that yields the minimum.
+        Vector3<ScalarT> point;
+      };
+
+      /// \brief Get the intersection of two intervals.
+      /// \param[in] _a first interval
+      /// \param[in] _b second interval
+      /// \return the intersection, which may be empty
+      private: static Interval<ScalarT> Intersection(
+          const Interval<ScalarT> &_a, const Interval<ScalarT> &_b)
+      {
+        // The open end wins on ties, which are exactly equal bounds
+        GZ_UTILS_WARN_IGNORE__FLOAT_EQUAL
+        const bool leftA = _a.LeftValue() > _b.LeftValue() ||
+            (_a.LeftValue() == _b.LeftValue() && !_a.IsLeftClosed());
+        const bool rightA = _a.RightValue() < _b.RightValue() ||
+            (_a.RightValue() == _b.RightValue() && !_a.IsRightClosed());
+        GZ_UTILS_WARN_RESUME__FLOAT_EQUAL
+        const Interval<ScalarT> &left = leftA ? _a : _b;
+        const Interval<ScalarT> &right = rightA ? _a : _b;
+        return Interval<ScalarT>(left.LeftValue(), left.IsLeftClosed(),
+                                 right.RightValue(), right.IsRightClosed());
+      }
+
+      /// \brief Get the intersection of two regions.
+      /// \param[in] _a first region
+      /// \param[in] _b second region
+      /// \return the intersection, which may be empty
+      private: static Region3<ScalarT> Intersection(
+          const Region3<ScalarT> &_a, const Region3<ScalarT> &_b)
+      {
+        return Region3<ScalarT>(Intersection(_a.Ix(), _b.Ix()),
+                                Intersection(_a.Iy(), _b.Iy()),
+                                Intersection(_a.Iz(), _b.Iz()));
+      }
+
+      /// \brief Build the hierarchy over the regions that are not empty.
+      private: void BuildTree()
+      {
+        this->nodes.clear();
+        this->pieceOrder.clear();
+        for (std::size_t i = 0; i < this->pieces.size(); ++i)
+        {
+          if (!this->pieces[i].region.Empty())
+          {
+            this->pieceOrder.push_back(i);
+          }
+        }
+        if (!this->pieceOrder.empty())
+        {
+          this->BuildNode(0, this->pieceOrder.size());
+        }
+      }
+
+      /// \brief Get the center of an interval, or its finite end if it
+      /// is unbounded on one side, or 0.
+      /// \param[in] _interval interval of a region
+      /// \return the center
+      private: static ScalarT Center(const Interval<ScalarT> &_interval)
+      {
+        using std::isfinite;
+        const ScalarT left = _interval.LeftValue();
+        const ScalarT right = _interval.RightValue();
+        if (isfinite(left) && isfinite(right))
+        {
+          return left + (right - left) / ScalarT(2);
+        }
+        if (isfinite(left))
+        {
+          return left;
+        }
+        return isfinite(right) ? right : ScalarT(0);
+      }
+
+      /// \brief Build a node and the nodes below it, splitting its pieces
+      /// at the median center along the axis where centers spread most.
+      /// \param[in] _begin first piece of the node in pieceOrder
+      /// \param[in] _end end of the pieces of the node in pieceOrder
+      private: void BuildNode(const std::size_t _begin,
+                              const std::size_t _end)
+      {
+        constexpr std::size_t kMaxLeafSize = 4;
+        const std::size_t nodeIndex = this->nodes.size();
+        this->nodes.emplace_back();
+        Node node;
+        node.min = Vector3<ScalarT>(
+            std::numeric_limits<ScalarT>::infinity(),
+            std::numeric_limits<ScalarT>::infinity(),
+            std::numeric_limits<ScalarT>::infinity());
+        node.max = -node.min;
+        node.minPiece = this->pieces.size();
+        Vector3<ScalarT> centerMin = node.min;
+        Vector3<ScalarT> centerMax = node.max;
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          const std::size_t piece = this->pieceOrder[i];
+          const Region3<ScalarT> &region = this->pieces[piece].region;
+          const Vector3<ScalarT> lower(region.Ix().LeftValue(),
+              region.Iy().LeftValue(), region.Iz().LeftValue());
+          const Vector3<ScalarT> upper(region.Ix().RightValue(),
+              region.Iy().RightValue(), region.Iz().RightValue());
+          const Vector3<ScalarT> center(Center(region.Ix()),
+              Center(region.Iy()), Center(region.Iz()));
+          node.min.Min(lower);
+          node.max.Max(upper);
+          centerMin.Min(center);
+          centerMax.Max(center);
+          node.minPiece = std::min(node.minPiece, piece);
+        }
+
+        if (_end - _begin <= kMaxLeafSize)
+        {
+          std::sort(this->pieceOrder.begin() + _begin,
+                    this->pieceOrder.begin() + _end);
+          node.begin = _begin;
+          node.count = _end - _begin;
+          this->nodes[nodeIndex] = node;
+          return;
+        }
+
+        const Vector3<ScalarT> spread = centerMax - centerMin;
+        int axis = 0;
+        if (spread[1] > spread[axis])
+        {
+          axis = 1;
+        }
+        if (spread[2] > spread[axis])
+        {
+          axis = 2;
+        }
+        const std::size_t middle = _begin + (_end - _begin) / 2;
+        std::nth_element(
+            this->pieceOrder.begin() + _begin,
+            this->pieceOrder.begin() + middle,
+            this->pieceOrder.begin() + _end,
+            [&](const std::size_t _a, const std::size_t _b)
+            {
+              // Break ties on the other axes, so that regions aligned on
+              // a grid are split into compact halves
+              const Region3<ScalarT> &a = this->pieces[_a].region;
+              const Region3<ScalarT> &b = this->pieces[_b].region;
+              const ScalarT ca[3] = {
+                  Center(a.Ix()), Center(a.Iy()), Center(a.Iz())};
+              const ScalarT cb[3] = {
+                  Center(b.Ix()), Center(b.Iy()), Center(b.Iz())};
+              for (int i = 0; i < 3; ++i)
+              {
+                const int k = (axis + i) % 3;
+                if (ca[k] < cb[k])
+                {
+                  return true;
+                }
+                if (cb[k] < ca[k])
+                {
+                  return false;
+                }
+              }
+              return false;
+            });
+
+        this->BuildNode(_begin, middle);
+        node.begin = this->nodes.size();
+        node.count = 0;
+        this->BuildNode(middle, _end);
+        this->nodes[nodeIndex] = node;
+      }
+
+      /// \brief Find the piece whose region contains a point, the one
+      /// with the smallest index if regions overlap.
+      /// \param[in] _p point to look up
+      /// \return index of the piece, or the number of pieces if no region
+      ///   contains `_p`
+      private: std::size_t FindPiece(const Vector3<ScalarT> &_p) const
+      {
+        std::size_t best = this->pieces.size();
+        if (this->nodes.empty())
+        {
+          return best;
+        }
+        // The tree is balanced, so its depth is at most 64
+        if (!this->nodes[0].Contains(_p))
+        {
+          return best;
+        }
+        std::size_t stack[64];
+        std::size_t size = 0;
+        stack[size++] = 0;
+        while (size > 0)
+        {
+          const std::size_t index = stack[--size];
+          const Node &node = this->nodes[index];
+          if (node.minPiece >= best)
+          {
+            continue;
+          }
+          if (node.count > 0)
+          {
+            for (std::size_t i = node.begin; i < node.begin + node.count; ++i)
+            {
+              const std::size_t piece = this->pieceOrder[i];
+              if (piece < best && this->pieces[piece].region.Contains(_p))
+              {
+                if (!this->overlapping)
+                {
+                  // No other region can contain the point
+                  return piece;
+                }
+                best = piece;
+              }
+            }
+            continue;
+          }
+          // Visit first the child with the piece of highest precedence
+          std::size_t first = index + 1;
+          std::size_t second = node.begin;
+          if (this->nodes[second].minPiece < this->nodes[first].minPiece)
+          {
+            std::swap(first, second);
+          }
+          if (this->nodes[second].Contains(_p))
+          {
+            stack[size++] = second;
+          }
+          if (this->nodes[first].Contains(_p))
+          {
+            stack[size++] = first;
+          }
+        }
+        return best;
+      }
+
+      /// \brief Find the pieces whose regions intersect a region.
+      /// \param[in] _region region to check for intersection
+      /// \param[out] _indices indices of the pieces, in no particular
+      ///   order. It is cleared first.
+      private: void FindIntersecting(const Region3<ScalarT> &_region,
+                                     std::vector<std::size_t> &_indices) const
+      {
+        _indices.clear();
+        if (this->nodes.empty())
+        {
+          return;
+        }
+        const Vector3<ScalarT> lower(_region.Ix().LeftValue(),
+            _region.Iy().LeftValue(), _region.Iz().LeftValue());
+        const Vector3<ScalarT> upper(_region.Ix().RightValue(),
+            _region.Iy().RightValue(), _region.Iz().RightValue());
+        std::vector<std::size_t> stack{0};
+        while (!stack.empty())
+        {
+          const std::size_t index = stack.back();
+          stack.pop_back();
+          const Node &node = this->nodes[index];
+          if (!(node.min.X() <= upper.X() && lower.X() <= node.max.X() &&
+                node.min.Y() <= upper.Y() && lower.Y() <= node.max.Y() &&
+                node.min.Z() <= upper.Z() && lower.Z() <= node.max.Z()))
+          {
+            continue;
+          }
+          if (node.count > 0)
+          {
+            for (std::size_t i = node.begin; i < node.begin + node.count; ++i)
+            {
+              const std::size_t piece = this->pieceOrder[i];
+              if (this->pieces[piece].region.Intersects(_region))
+              {
+                _indices.push_back(piece);
+              }
+            }
+            continue;
+          }
+          stack.push_back(index + 1);
+          stack.push_back(node.begin);
+        }
+      }
+
       /// \brief Scalar fields Pn and the regions Rn in which these are defined
       private: std::vector<Piece> pieces;
+
+      /// \brief Nodes of the hierarchy of the regions, the root first.
+      private: std::vector<Node> nodes;
+
+      /// \brief Indices of the pieces with non-empty regions, in the
+      /// order of the leaves of the hierarchy.
+      private: std::vector<std::size_t> pieceOrder;
+
+      /// \brief Whether any two regions overlap.
+      private: bool overlapping = false;
+
+      /// \brief Minimum of each piece, filled by CacheMinima.
+      private: std::vector<CachedMinimum> pieceMinima;
+
+      /// \brief Lowest cached minimum of the pieces below each node.
+      private: std::vector<ScalarT> nodeMinima;
+
+      /// \brief Index of the piece with the lowest cached minimum, the
+      /// number of pieces if every region is empty.
+      private: std::size_t minimumPiece = 0;
     };
 
     template<typename ScalarField3T>
@@ -23,7 +23,12 @@
 #include <gz/math/config.hh>
 #include <gz/math/Line2.hh>
 #include <gz/math/Quaternion.hh>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
+#include <type_traits>
 
 namespace gz
 {
@@ -205,6 +210,143 @@ namespace gz
         return BOTH_SIDE;
       }
 
+      /// \brief The distance to the plane from each point of an array, see
+      /// Distance(const Vector3<T> &).
+      /// \param[in] _points Points to calculate the distance from.
+      /// \param[out] _out Distance from each point to the plane.
+      /// \param[in] _count Number of points.
+      public: void Distance(const Vector3<T> *_points, T *_out,
+                            const std::size_t _count) const
+      {
+        const T nx = this->normal.X();
+        const T ny = this->normal.Y();
+        const T nz = this->normal.Z();
+        const T offset = this->d;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          _out[i] = nx * _points[i].X() + ny * _points[i].Y() +
+              nz * _points[i].Z() - offset;
+        }
+      }
+
+      /// \brief The distance to the plane from each point of an array
+      /// stored as separate x, y and z buffers, such as the ones of a
+      /// Vector3Array. See Distance(const Vector3<T> &).
+      /// \param[in] _x X coordinates of the points.
+      /// \param[in] _y Y coordinates of the points.
+      /// \param[in] _z Z coordinates of the points.
+      /// \param[out] _out Distance from each point to the plane.
+      /// \param[in] _count Number of points.
+      public: void Distance(const T *_x, const T *_y, const T *_z, T *_out,
+                            const std::size_t _count) const
+      {
+        const T nx = this->normal.X();
+        const T ny = this->normal.Y();
+        const T nz = this->normal.Z();
+        const T offset = this->d;
+        for (std::size_t i = 0; i < _count; ++i)
+          _out[i] = nx * _x[i] + ny * _y[i] + nz * _z[i] - offset;
+      }
+
+      /// \brief The side of the plane each point of an array is on, see
+      /// Side(const Vector3<T> &).
+      /// \param[in] _points The 3D points to check.
+      /// \param[out] _out Side of each point.
+      /// \param[in] _count Number of points.
+      public: void Side(const Vector3<T> *_points, PlaneSide *_out,
+                        const std::size_t _count) const
+      {
+        T dist[kBlock];
+        for (std::size_t start = 0; start < _count; start += kBlock)
+        {
+          const std::size_t n = std::min(kBlock, _count - start);
+          this->Distance(_points + start, dist, n);
+          SideBlock(dist, _out + start, n);
+        }
+      }
+
+      /// \brief The side of the plane each point of an array stored as
+      /// separate x, y and z buffers is on, see Side(const Vector3<T> &).
+      /// \param[in] _x X coordinates of the points.
+      /// \param[in] _y Y coordinates of the points.
+      /// \param[in] _z Z coordinates of the points.
+      /// \param[out] _out Side of each point.
+      /// \param[in] _count Number of points.
+      public: void Side(const T *_x, const T *_y, const T *_z,
+                        PlaneSide *_out, const std::size_t _count) const
+      {
+        T dist[kBlock];
+        for (std::size_t start = 0; start < _count; start += kBlock)
+        {
+          const std::size_t n = std::min(kBlock, _count - start);
+          this->Distance(_x + start, _y + start, _z + start, dist, n);
+          SideBlock(dist, _out + start, n);
+        }
+      }
+
+      /// \brief Count the inliers of several planes, for example the
+      /// candidate planes of a RANSAC fit. A point is an inlier of a plane
+      /// if the absolute value of its distance to the plane is at most
+      /// _threshold.
+      ///
+      /// The points are processed in blocks that stay in cache while every
+      /// plane is tested against them.
+      /// \param[in] _planes Planes to score.
+      /// \param[in] _planeCount Number of planes.
+      /// \param[in] _x X coordinates of the points.
+      /// \param[in] _y Y coordinates of the points.
+      /// \param[in] _z Z coordinates of the points.
+      /// \param[in] _pointCount Number of points.
+      /// \param[in] _threshold Maximum absolute distance of an inlier.
+      /// \param[out] _counts Number of inliers of each plane, _planeCount
+      /// values.
+      public: static void CountInliers(const Plane<T> *_planes,
+                  const std::size_t _planeCount, const T *_x, const T *_y,
+                  const T *_z, const std::size_t _pointCount,
+                  const T _threshold, std::size_t *_counts)
+      {
+        std::fill(_counts, _counts + _planeCount, 0);
+        for (std::size_t start = 0; start < _pointCount; start += kBlock)
+        {
+          const std::size_t n = std::min(kBlock, _pointCount - start);
+          CountInliersBlock(_planes, _planeCount, _x + start, _y + start,
+              _z + start, n, _threshold, _counts);
+        }
+      }
+
+      /// \brief Count the inliers of several planes in an array of points,
+      /// see CountInliers(const Plane<T> *, std::size_t, const T *,
+      /// const T *, const T *, std::size_t, T, std::size_t *).
+      /// \param[in] _planes Planes to score.
+      /// \param[in] _planeCount Number of planes.
+      /// \param[in] _points Points to test.
+      /// \param[in] _pointCount Number of points.
+      /// \param[in] _threshold Maximum absolute distance of an inlier.
+      /// \param[out] _counts Number of inliers of each plane, _planeCount
+      /// values.
+      public: static void CountInliers(const Plane<T> *_planes,
+                  const std::size_t _planeCount, const Vector3<T> *_points,
+                  const std::size_t _pointCount, const T _threshold,
+                  std::size_t *_counts)
+      {
+        std::fill(_counts, _counts + _planeCount, 0);
+        T x[kBlock];
+        T y[kBlock];
+        T z[kBlock];
+        for (std::size_t start = 0; start < _pointCount; start += kBlock)
+        {
+          const std::size_t n = std::min(kBlock, _pointCount - start);
+          for (std::size_t i = 0; i < n; ++i)
+          {
+            x[i] = _points[start + i].X();
+            y[i] = _points[start + i].Y();
+            z[i] = _points[start + i].Z();
+          }
+          CountInliersBlock(_planes, _planeCount, x, y, z, n, _threshold,
+              _counts);
+        }
+      }
+
       /// \brief Get distance to the plane give an origin and direction
       /// \param[in] _origin the origin
       /// \param[in] _dir a direction
@@ -262,6 +404,62 @@ namespace gz
       /// \return itself
       public: Plane<T> &operator=(const Plane<T> &_p) = default;
 
+      /// \brief Number of points processed at a time by the array
+      /// functions.
+      private: static constexpr std::size_t kBlock = 256;
+
+      /// \brief Classify a block of distances, see Side.
+      /// \param[in] _dist Distances to the plane.
+      /// \param[out] _out Side of each distance.
+      /// \param[in] _count Number of distances, at most kBlock.
+      private: static void SideBlock(const T *_dist, PlaneSide *_out,
+                                     const std::size_t _count)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          // NEGATIVE_SIDE = 0, POSITIVE_SIDE = 1 and NO_SIDE = 2, which is
+          // also the result for NaN, as in Side(const Vector3<T> &).
+          const int positive = _dist[i] > 0;
+          const int negative = _dist[i] < 0;
+          _out[i] = static_cast<PlaneSide>(2 - positive - 2 * negative);
+        }
+      }
+
+      /// \brief Add the inliers of a block of points to the counts of
+      /// several planes, see CountInliers.
+      /// \param[in] _planes Planes to score.
+      /// \param[in] _planeCount Number of planes.
+      /// \param[in] _x X coordinates of the points.
+      /// \param[in] _y Y coordinates of the points.
+      /// \param[in] _z Z coordinates of the points.
+      /// \param[in] _count Number of points, at most kBlock.
+      /// \param[in] _threshold Maximum absolute distance of an inlier.
+      /// \param[in,out] _counts Number of inliers of each plane.
+      private: static void CountInliersBlock(const Plane<T> *_planes,
+                   const std::size_t _planeCount, const T *_x, const T *_y,
+                   const T *_z, const std::size_t _count, const T _threshold,
+                   std::size_t *_counts)
+      {
+        for (std::size_t p = 0; p < _planeCount; ++p)
+        {
+          const T nx = _planes[p].normal.X();
+          const T ny = _planes[p].normal.Y();
+          const T nz = _planes[p].normal.Z();
+          const T offset = _planes[p].d;
+          // An integer sum of the width of T vectorizes with the
+          // comparisons, a sum in T would need reassociation.
+          using Count = std::conditional_t<sizeof(T) == sizeof(std::int64_t),
+              std::int64_t, std::int32_t>;
+          Count inliers = 0;
+          for (std::size_t i = 0; i < _count; ++i)
+          {
+            const T dist = nx * _x[i] + ny * _y[i] + nz * _z[i] - offset;
+            inliers += static_cast<Count>(std::abs(dist) <= _threshold);
+          }
+          _counts[p] += static_cast<std::size_t>(inliers);
+        }
+      }
+
       /// \brief Plane normal
       private: Vector3<T> normal;
 
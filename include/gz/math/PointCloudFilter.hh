@@ -0,0 +1,337 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_POINTCLOUDFILTER_HH_
+#define GZ_MATH_POINTCLOUDFILTER_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gz/math/KdTree.hh>
+#include <gz/math/SparseOctree.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+#include <gz/math/detail/ParallelFor.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Smallest number of points handled by each thread of the
+      /// point cloud filters.
+      constexpr std::size_t kMinPointsPerThread = 4096;
+
+      /// \brief Remove the points which fail a per point test, keeping the
+      /// order of the others.
+      /// \param[in] _points The points.
+      /// \param[in] _count Number of points.
+      /// \param[in] _keep 1 for each point to keep.
+      /// \param[out] _output Points kept.
+      /// \return Number of points kept.
+      template<typename T>
+      std::size_t compactPoints(const Vector3<T> *_points,
+                                const std::size_t _count,
+                                const std::vector<std::uint8_t> &_keep,
+                                Vector3<T> *_output)
+      {
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          if (_keep[i])
+            _output[kept++] = _points[i];
+        }
+        return kept;
+      }
+    }
+
+    /// \brief Downsample a point cloud on a voxel grid, replacing the
+    /// points of each voxel by their centroid.
+    ///
+    /// The voxels are those of SparseOctree: the voxel of a point is
+    /// floor(_point / _voxelSize). Each point is given the Morton key of
+    /// its voxel, the keys are sorted, and the points of each run of equal
+    /// keys are averaged. The centroids are written in key order, and are
+    /// the same as those of a SparseOctree holding the points, for any
+    /// number of threads. Computing the keys, sorting them and averaging
+    /// each run are split between the threads.
+    ///
+    /// # Example usage
+    ///
+    /// ```{.cpp}
+    /// std::vector<gz::math::Vector3d> downsampled(cloud.size());
+    /// downsampled.resize(gz::math::voxelDownsample(cloud.data(),
+    ///     cloud.size(), 0.05, downsampled.data(), 0));
+    /// ```
+    /// \param[in] _points The points. Points which are not finite or whose
+    /// voxel is further than SparseOctree<T>::kMaxVoxel from the origin are
+    /// ignored.
+    /// \param[in] _count Number of points.
+    /// \param[in] _voxelSize Size of the voxels, which must be positive.
+    /// \param[out] _output Centroid of each voxel. It must hold one value
+    /// per voxel, at most _count values, and must not overlap _points.
+    /// \param[in] _threads Largest number of threads to use, zero for
+    /// std::thread::hardware_concurrency. Small clouds use fewer threads.
+    /// \return Number of voxels, the number of values written to _output.
+    template<typename T>
+    std::size_t voxelDownsample(const Vector3<T> *_points,
+                                const std::size_t _count,
+                                const T _voxelSize, Vector3<T> *_output,
+                                const unsigned int _threads = 1)
+    {
+      static_assert(std::is_floating_point_v<T>,
+          "voxelDownsample requires a floating point type");
+      using Octree = SparseOctree<T>;
+      using Key = std::pair<std::uint64_t, std::size_t>;
+
+      const std::size_t threads =
+        detail::ChunkCount(_count, _threads, detail::kMinPointsPerThread);
+
+      // Compute the keys of each chunk of points and sort them.
+      std::vector<std::vector<Key>> sorted(threads);
+      const double size = static_cast<double>(_voxelSize);
+      detail::ParallelFor(_count, threads,
+          [&](const std::size_t _c, const std::size_t _begin,
+              const std::size_t _end)
+      {
+        std::vector<Key> &keys = sorted[_c];
+        keys.reserve(_end - _begin);
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          int c[3];
+          bool inRange = true;
+          for (int j = 0; j < 3; ++j)
+          {
+            const double v = std::floor(
+                static_cast<double>(_points[i][j]) / size);
+            inRange &= v >= -Octree::kMaxVoxel && v <= Octree::kMaxVoxel;
+            c[j] = inRange ? static_cast<int>(v) : 0;
+          }
+          if (inRange)
+            keys.emplace_back(Octree::MortonKey(Vector3i(c[0], c[1], c[2])), i);
+        }
+        Octree::SortKeys(keys);
+      });
+
+      // Merge the sorted chunks pairwise. The chunks hold increasing
+      // ranges of points, so equal keys stay ordered by point.
+      while (sorted.size() > 1)
+      {
+        std::vector<std::vector<Key>> merged((sorted.size() + 1) / 2);
+        detail::ParallelFor(merged.size(), merged.size(),
+            [&](const std::size_t _m, std::size_t, std::size_t)
+        {
+          if (2 * _m + 1 == sorted.size())
+          {
+            merged[_m].swap(sorted[2 * _m]);
+            return;
+          }
+          const std::vector<Key> &low = sorted[2 * _m];
+          const std::vector<Key> &high = sorted[2 * _m + 1];
+          merged[_m].resize(low.size() + high.size());
+          std::merge(low.begin(), low.end(), high.begin(), high.end(),
+              merged[_m].begin(), [](const Key &_a, const Key &_b)
+              {
+                return _a.first < _b.first;
+              });
+        });
+        sorted.swap(merged);
+      }
+      const std::vector<Key> &keys = sorted[0];
+      const std::size_t valid = keys.size();
+      const std::size_t chunk = (valid + threads - 1) / threads;
+
+      // Split the runs of equal keys between the threads, count the voxels
+      // of each thread to find where its centroids go, then average them.
+      std::vector<std::size_t> starts(threads + 1, valid);
+      for (std::size_t c = 0; c < threads; ++c)
+      {
+        std::size_t start = std::min(valid, c * chunk);
+        while (start > 0 && start < valid &&
+               keys[start].first == keys[start - 1].first)
+        {
+          ++start;
+        }
+        starts[c] = start;
+      }
+      std::vector<std::size_t> offsets(threads + 1, 0);
+      detail::ParallelFor(threads, threads,
+          [&](std::size_t _c, std::size_t, std::size_t)
+      {
+        std::size_t voxels = 0;
+        for (std::size_t i = starts[_c]; i < starts[_c + 1]; ++i)
+          voxels += i == starts[_c] || keys[i].first != keys[i - 1].first;
+        offsets[_c + 1] = voxels;
+      });
+      for (std::size_t c = 0; c < threads; ++c)
+        offsets[c + 1] += offsets[c];
+
+      detail::ParallelFor(threads, threads,
+          [&](std::size_t _c, std::size_t, std::size_t)
+      {
+        std::size_t out = offsets[_c];
+        for (std::size_t i = starts[_c]; i < starts[_c + 1];)
+        {
+          const std::uint64_t key = keys[i].first;
+          const Vector3i voxel = Octree::MortonVoxel(key);
+          const Vector3<T> corner(static_cast<T>(voxel.X() * _voxelSize),
+                                  static_cast<T>(voxel.Y() * _voxelSize),
+                                  static_cast<T>(voxel.Z() * _voxelSize));
+          Vector3<T> sum;
+          std::size_t n = 0;
+          for (; i < starts[_c + 1] && keys[i].first == key; ++i, ++n)
+            sum += _points[keys[i].second] - corner;
+          _output[out++] = corner + sum / static_cast<T>(n);
+        }
+      });
+      return offsets[threads];
+    }
+
+    /// \brief Remove the points which have fewer than a number of other
+    /// points within a radius, such as isolated returns of a lidar scan.
+    ///
+    /// The points are put in a KdTree, and each point is kept if its
+    /// (_minNeighbors + 1)-th nearest point, itself included, is within
+    /// the radius, so each query stops after _minNeighbors + 1 points.
+    /// \param[in] _points The points, which must be finite.
+    /// \param[in] _count Number of points.
+    /// \param[in] _radius Radius of the neighborhood.
+    /// \param[in] _minNeighbors Smallest number of other points within
+    /// _radius of a point that is kept.
+    /// \param[out] _output Points kept, in order. It must hold _count
+    /// values, and may be _points.
+    /// \param[in] _threads Largest number of threads to use, zero for
+    /// std::thread::hardware_concurrency. Small clouds use fewer threads.
+    /// \return Number of points kept, the number of values written to
+    /// _output.
+    template<typename T>
+    std::size_t radiusOutlierFilter(const Vector3<T> *_points,
+                                    const std::size_t _count,
+                                    const T _radius,
+                                    const std::size_t _minNeighbors,
+                                    Vector3<T> *_output,
+                                    const unsigned int _threads = 1)
+    {
+      const std::size_t threads =
+        detail::ChunkCount(_count, _threads, detail::kMinPointsPerThread);
+      KdTree<T> tree;
+      tree.Build(_points, _count, static_cast<unsigned int>(threads));
+
+      const std::size_t k = _minNeighbors + 1;
+      std::vector<std::uint8_t> keep(_count, 0);
+      if (k <= _count)
+      {
+        detail::ParallelFor(_count, threads,
+            [&](std::size_t, const std::size_t _begin,
+                const std::size_t _end)
+        {
+          std::vector<std::size_t> ids(k);
+          std::vector<T> distances(k);
+          for (std::size_t i = _begin; i < _end; ++i)
+          {
+            tree.Nearest(_points[i], k, ids.data(), distances.data());
+            keep[i] = distances[k - 1] <= _radius;
+          }
+        });
+      }
+      return detail::compactPoints(_points, _count, keep, _output);
+    }
+
+    /// \brief Remove the points whose mean distance to their nearest
+    /// neighbors is large compared to the rest of the cloud.
+    ///
+    /// The points are put in a KdTree and the mean distance d of each point
+    /// to its _neighbors nearest other points is computed. A point is kept
+    /// if d is at most the mean of d over all points plus _stddevMultiplier
+    /// times its standard deviation.
+    /// \param[in] _points The points, which must be finite.
+    /// \param[in] _count Number of points.
+    /// \param[in] _neighbors Number of neighbors of each point, at least 1.
+    /// \param[in] _stddevMultiplier Number of standard deviations above the
+    /// mean distance at which points are removed.
+    /// \param[out] _output Points kept, in order. It must hold _count
+    /// values, and may be _points.
+    /// \param[in] _threads Largest number of threads to use, zero for
+    /// std::thread::hardware_concurrency. Small clouds use fewer threads.
+    /// \return Number of points kept, the number of values written to
+    /// _output. If the cloud has no more than _neighbors points, they are
+    /// all kept.
+    template<typename T>
+    std::size_t statisticalOutlierFilter(const Vector3<T> *_points,
+                                         const std::size_t _count,
+                                         const std::size_t _neighbors,
+                                         const T _stddevMultiplier,
+                                         Vector3<T> *_output,
+                                         const unsigned int _threads = 1)
+    {
+      std::vector<std::uint8_t> keep(_count, 1);
+      if (_neighbors == 0 || _count <= _neighbors)
+        return detail::compactPoints(_points, _count, keep, _output);
+
+      const std::size_t threads =
+        detail::ChunkCount(_count, _threads, detail::kMinPointsPerThread);
+      KdTree<T> tree;
+      tree.Build(_points, _count, static_cast<unsigned int>(threads));
+
+      // The nearest point is the point itself, or a copy of it.
+      const std::size_t k = _neighbors + 1;
+      std::vector<double> meanDistances(_count);
+      std::vector<double> sums(threads, 0);
+      detail::ParallelFor(_count, threads,
+          [&](const std::size_t _c, const std::size_t _begin,
+              const std::size_t _end)
+      {
+        std::vector<std::size_t> ids(k);
+        std::vector<T> distances(k);
+        double sum = 0;
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          tree.Nearest(_points[i], k, ids.data(), distances.data());
+          double d = 0;
+          for (std::size_t j = 1; j < k; ++j)
+            d += distances[j];
+          meanDistances[i] = d / static_cast<double>(_neighbors);
+          sum += meanDistances[i];
+        }
+        sums[_c] = sum;
+      });
+
+      double sum = 0;
+      for (const double s : sums)
+        sum += s;
+      const double mean = sum / static_cast<double>(_count);
+      double squares = 0;
+      for (const double d : meanDistances)
+        squares += (d - mean) * (d - mean);
+      const double threshold = mean + static_cast<double>(_stddevMultiplier) *
+        std::sqrt(squares / static_cast<double>(_count));
+
+      for (std::size_t i = 0; i < _count; ++i)
+        keep[i] = meanDistances[i] <= threshold;
+      return detail::compactPoints(_points, _count, keep, _output);
+    }
+    }
+  }
+}
+#endif
@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <limits>
 #include <string>
 #include <utility>
@@ -27,6 +28,8 @@
 #include <gz/math/Vector4.hh>
 #include <gz/math/config.hh>
 
+#include <gz/utils/SuppressWarning.hh>
+
 namespace gz
 {
   namespace math
@@ -49,7 +52,8 @@ namespace gz
       /// \brief Constructor
       /// \param[in] _coeffs coefficients c0 through c3, left to right
       public: explicit Polynomial3(Vector4<T> _coeffs)
-      : coeffs(std::move(_coeffs))
+      : coeffs(std::move(_coeffs)),
+        stationaryMinimum(StationaryMinimum(this->coeffs))
       {
       }
 
@@ -95,11 +99,47 @@ namespace gz
           }
           return this->coeffs[3];
         }
-        const T _x2 = _x * _x;
-        const T _x3 = _x2 * _x;
+        return ((this->coeffs[0] * _x + this->coeffs[1]) * _x +
+                this->coeffs[2]) * _x + this->coeffs[3];
+      }
+
+      /// \brief Evaluate the polynomial at many arguments. The finite
+      /// arguments are evaluated in a loop the compiler can vectorize,
+      /// with the same result as Evaluate(const T &).
+      /// \param[in] _x Pointer to the first polynomial argument.
+      /// \param[out] _out Pointer to the first of `_count` results.
+      /// \param[in] _count Number of arguments.
+      public: void Evaluate(const T *_x, T *_out,
+                            const std::size_t _count) const
+      {
+        const T c0 = this->coeffs[0];
+        const T c1 = this->coeffs[1];
+        const T c2 = this->coeffs[2];
+        const T c3 = this->coeffs[3];
+        for (std::size_t i = 0; i < _count; ++i)
+          _out[i] = ((c0 * _x[i] + c1) * _x[i] + c2) * _x[i] + c3;
 
-        return (this->coeffs[0] * _x3 + this->coeffs[1] * _x2 +
-                this->coeffs[2] * _x + this->coeffs[3]);
+        // The result is not finite if the argument is not finite. The
+        // magnitude is compared with the largest finite value, which is
+        // the same as std::isfinite. A select, unlike a branch, keeps this
+        // vectorized.
+        using std::abs;  // enable ADL
+        const T finiteMax = std::numeric_limits<T>::max();
+        T nonFinite = T(0);
+        for (std::size_t i = 0; i < _count; ++i)
+          nonFinite = abs(_out[i]) <= finiteMax ? nonFinite : T(1);
+        GZ_UTILS_WARN_IGNORE__FLOAT_EQUAL
+        const bool allFinite = nonFinite == T(0);
+        GZ_UTILS_WARN_RESUME__FLOAT_EQUAL
+        if (allFinite)
+          return;
+
+        using std::isfinite;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          if (!isfinite(_x[i]))
+            _out[i] = this->Evaluate(_x[i]);
+        }
       }
 
       /// \brief Call operator overload
@@ -138,53 +178,16 @@ namespace gz
           yMin = yRight;
           _xMin = xRight;
         }
-        using std::abs, std::sqrt;  // enable ADL
-        constexpr T epsilon = std::numeric_limits<T>::epsilon();
-        if (abs(this->coeffs[0]) >= epsilon)
+        // The local minimum of p(x), if any, does not depend on the
+        // interval and is found when the polynomial is built
+        const T x = this->stationaryMinimum;
+        if (_interval.Contains(x))
         {
-          // Polynomial function p(x) is cubic, look
-          // for local minima within the given interval
-
-          // Find local extrema by computing the roots
-          // of p'(x), a quadratic polynomial function
-          const T a = this->coeffs[0] * T(3.);
-          const T b = this->coeffs[1] * T(2.);
-          const T c = this->coeffs[2];
-
-          const T discriminant = b * b - T(4.) * a * c;
-          if (discriminant >= T(0.))
+          const T y = this->Evaluate(x);
+          if (y < yMin)
           {
-            // Roots of p'(x) are real, check local minima
-            const T x = (-b + sqrt(discriminant)) / (T(2.) * a);
-            if (_interval.Contains(x))
-            {
-              const T y = this->Evaluate(x);
-              if (y < yMin)
-              {
-                _xMin = x;
-                yMin = y;
-              }
-            }
-          }
-        }
-        else if (abs(this->coeffs[1]) >= epsilon)
-        {
-          // Polynomial function p(x) is quadratic,
-          // look for global minima if concave
-          const T a = this->coeffs[1];
-          const T b = this->coeffs[2];
-          if (a > T(0.))
-          {
-            const T x = -b / (T(2.) * a);
-            if (_interval.Contains(x))
-            {
-              const T y = this->Evaluate(x);
-              if (y < yMin)
-              {
-                _xMin = x;
-                yMin = y;
-              }
-            }
+            _xMin = x;
+            yMin = y;
           }
         }
         return yMin;
@@ -283,8 +286,52 @@ namespace gz
         return _out;
       }
 
+      /// \brief Find the local minimum of a polynomial.
+      /// \param[in] _coeffs polynomial coefficients
+      /// \return the argument of the local minimum, or NaN if there is
+      ///   none
+      private: static T StationaryMinimum(const Vector4<T> &_coeffs)
+      {
+        using std::abs, std::sqrt;  // enable ADL
+        constexpr T epsilon = std::numeric_limits<T>::epsilon();
+        if (abs(_coeffs[0]) >= epsilon)
+        {
+          // Polynomial function p(x) is cubic, look
+          // for local minima
+
+          // Find local extrema by computing the roots
+          // of p'(x), a quadratic polynomial function
+          const T a = _coeffs[0] * T(3.);
+          const T b = _coeffs[1] * T(2.);
+          const T c = _coeffs[2];
+
+          const T discriminant = b * b - T(4.) * a * c;
+          if (discriminant >= T(0.))
+          {
+            // Roots of p'(x) are real, the local minimum is where
+            // p''(x) > 0
+            return (-b + sqrt(discriminant)) / (T(2.) * a);
+          }
+        }
+        else if (abs(_coeffs[1]) >= epsilon)
+        {
+          // Polynomial function p(x) is quadratic,
+          // look for global minima if concave
+          const T a = _coeffs[1];
+          const T b = _coeffs[2];
+          if (a > T(0.))
+          {
+            return -b / (T(2.) * a);
+          }
+        }
+        return std::numeric_limits<T>::quiet_NaN();
+      }
+
       /// \brief Polynomial coefficients
       private: Vector4<T> coeffs;
+
+      /// \brief Argument of the local minimum, or NaN if there is none
+      private: T stationaryMinimum = std::numeric_limits<T>::quiet_NaN();
     };
     using Polynomial3f = Polynomial3<float>;
     using Polynomial3d = Polynomial3<double>;
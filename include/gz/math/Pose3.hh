@@ -17,6 +17,13 @@
 #ifndef GZ_MATH_POSE_HH_
 #define GZ_MATH_POSE_HH_
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gz/math/Matrix3.hh>
 #include <gz/math/Quaternion.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/math/config.hh>
@@ -27,6 +34,20 @@ namespace gz
   {
     // Inline bracket to help doxygen filtering.
     inline namespace GZ_MATH_VERSION_NAMESPACE {
+    /// \brief A pose packed in 12 bytes by Pose3::Pack, for example to
+    /// store or send many poses. The position is quantized to 16 bits per
+    /// axis within a box given by the caller, and the rotation is encoded
+    /// with Quaternion::PackSmallestThree48.
+    struct PackedPose3
+    {
+      /// \brief Position, 0 is the minimum corner of the box and 65535 the
+      /// maximum corner.
+      std::uint16_t position[3];
+
+      /// \brief Rotation code, from the low to the high 16 bits.
+      std::uint16_t rotation[3];
+    };
+
     //
     /// \class Pose3 Pose3.hh gz/math/Pose3.hh
     /// \brief The Pose3 class represents a 3D position and rotation. The
@@ -277,6 +298,76 @@ namespace gz
         return *this;
       }
 
+      /// \brief Multiply two buffers of poses: _out[i] = _a[i] * _b[i].
+      /// This is equivalent to operator* on each pair, but the position is
+      /// rotated directly, without the intermediate quaternions of
+      /// CoordPositionAdd. The results match operator* up to floating point
+      /// rounding (a few ulp).
+      /// \param[in] _a Pointer to the first left-hand pose.
+      /// \param[in] _b Pointer to the first right-hand pose.
+      /// \param[out] _out Pointer to the first resulting pose. It may be
+      /// equal to _a or _b to multiply in place.
+      /// \param[in] _count Number of poses to multiply.
+      public: static void Multiply(const Pose3<T> *_a, const Pose3<T> *_b,
+                                   Pose3<T> *_out, const std::size_t _count)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+          Compose(_a[i], _b[i], _out[i]);
+      }
+
+      /// \brief Compose the poses of a chain of frames, where _local[i] is
+      /// the pose of frame i relative to frame i - 1:
+      /// _out[0] = _local[0] and _out[i] = _out[i - 1] * _local[i].
+      /// \param[in] _local Pointer to the first pose relative to the
+      /// previous frame.
+      /// \param[out] _out Pointer to the first pose relative to the base of
+      /// the chain. It may be equal to _local to compose in place.
+      /// \param[in] _count Number of frames.
+      public: static void ComposeChain(const Pose3<T> *_local,
+                                       Pose3<T> *_out,
+                                       const std::size_t _count)
+      {
+        if (_count == 0)
+          return;
+        _out[0] = _local[0];
+        for (std::size_t i = 1; i < _count; ++i)
+          Compose(_out[i - 1], _local[i], _out[i]);
+      }
+
+      /// \brief Compose the poses of the frames of a kinematic tree, where
+      /// _local[i] is the pose of frame i relative to its parent frame
+      /// _parents[i]: _out[i] = _out[_parents[i]] * _local[i], or
+      /// _out[i] = _local[i] for a root frame, whose parent is negative.
+      /// Parents must come before their children.
+      /// \param[in] _local Pointer to the first pose relative to its parent.
+      /// \param[in] _parents Pointer to the parent index of the first frame.
+      /// \param[out] _out Pointer to the first pose relative to the root of
+      /// its tree. It may be equal to _local to compose in place.
+      /// \param[in] _count Number of frames.
+      /// \return False if a frame has a parent index that isn't less than its
+      /// own index. The frames from that one on are then left unchanged.
+      public: static bool ComposeTree(const Pose3<T> *_local,
+                                      const int *_parents, Pose3<T> *_out,
+                                      const std::size_t _count)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          if (_parents[i] < 0)
+          {
+            _out[i] = _local[i];
+          }
+          else if (static_cast<std::size_t>(_parents[i]) < i)
+          {
+            Compose(_out[_parents[i]], _local[i], _out[i]);
+          }
+          else
+          {
+            return false;
+          }
+        }
+        return true;
+      }
+
       /// \brief Assignment operator
       /// \param[in] _pose Pose3<T> to copy
       public: Pose3<T> &operator=(const Pose3<T> &_pose) = default;
@@ -296,6 +387,46 @@ namespace gz
                           this->p.Z() + tmp.Z());
       }
 
+      /// \brief Add this pose to a buffer of points: result[i] = this + pos[i].
+      /// This is equivalent to calling CoordPositionAdd on each element, but
+      /// the rotation matrix is computed once for the whole buffer and each
+      /// point is transformed with a single multiply-add. The results match
+      /// CoordPositionAdd up to floating point rounding (a few ulp).
+      /// \param[in] _in Pointer to the first point to transform.
+      /// \param[out] _out Pointer to the first transformed point. It may be
+      /// equal to _in to transform the buffer in place.
+      /// \param[in] _count Number of points to transform.
+      /// \sa Quaternion::RotateVector(const Vector3<T> *, Vector3<T> *,
+      /// std::size_t) to transform directions.
+      public: void CoordPositionAdd(const Vector3<T> *_in, Vector3<T> *_out,
+                                    const std::size_t _count) const
+      {
+        const Matrix3<T> m(this->q);
+        const T m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2);
+        const T m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2);
+        const T m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2);
+        const T px = this->p.X();
+        const T py = this->p.Y();
+        const T pz = this->p.Z();
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const T x = _in[i].X();
+          const T y = _in[i].Y();
+          const T z = _in[i].Z();
+          _out[i].Set(px + m00 * x + m01 * y + m02 * z,
+                      py + m10 * x + m11 * y + m12 * z,
+                      pz + m20 * x + m21 * y + m22 * z);
+        }
+      }
+
+      /// \brief Add this pose to every point of a vector, in place.
+      /// \param[in,out] _points The points to transform.
+      /// \sa CoordPositionAdd(const Vector3<T> *, Vector3<T> *, std::size_t)
+      public: void CoordPositionAdd(std::vector<Vector3<T>> &_points) const
+      {
+        this->CoordPositionAdd(_points.data(), _points.data(), _points.size());
+      }
+
       /// \brief Add one pose to another: result = this + pose.
       /// \param[in] _pose The Pose3<T> to add.
       /// \return The resulting position.
@@ -508,6 +639,21 @@ namespace gz
         return _out;
       }
 
+      /// \brief Append the pose to a string, in the format of operator<<
+      /// but with std::to_chars, which is faster than a stream.
+      /// \param[in, out] _out The string
+      /// \param[in] _pose Pose to append
+      /// \param[in] _precision Number of digits after the decimal point, or
+      /// a negative value for the shortest representation that reads back as
+      /// the same number
+      public: friend void appendToString(std::string &_out,
+                  const Pose3<T> &_pose, int _precision = -1)
+      {
+        appendToString(_out, _pose.Pos(), _precision);
+        _out += ' ';
+        appendToString(_out, _pose.Rot(), _precision);
+      }
+
       /// \brief Stream extraction operator
       /// \param[in] _in the input stream
       /// \param[in] _pose the pose
@@ -535,6 +681,129 @@ namespace gz
         return this->p.Equal(_p.p, _tol) && this->q.Equal(_p.q, _tol);
       }
 
+      /// \brief Pack the pose in 12 bytes. The position is clamped to the
+      /// box from _min to _max, for example the corners of an
+      /// AxisAlignedBox, and quantized to (_max - _min) / 65535 per axis.
+      /// The rotation is within 1.5e-4 radians of this one once unpacked, see
+      /// Quaternion::PackSmallestThree48.
+      /// \param[in] _min Minimum corner of the box of the positions.
+      /// \param[in] _max Maximum corner of the box of the positions.
+      /// \return The packed pose.
+      public: PackedPose3 Pack(const Vector3<T> &_min,
+                               const Vector3<T> &_max) const
+      {
+        PackedPose3 result;
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+          const T size = _max[i] - _min[i];
+          T u = 0;
+          if (size > 0)
+          {
+            u = (this->p[i] - _min[i]) / size * kPackedPositionMax;
+            // Also maps NaN to 0
+            u = (u > 0) ? std::min(u, kPackedPositionMax) : T(0);
+          }
+          result.position[i] = static_cast<std::uint16_t>(std::lround(u));
+        }
+
+        const std::uint64_t code = this->q.PackSmallestThree48();
+        for (unsigned int i = 0; i < 3; ++i)
+          result.rotation[i] = static_cast<std::uint16_t>(code >> (16 * i));
+        return result;
+      }
+
+      /// \brief Unpack a pose packed by Pack.
+      /// \param[in] _packed The packed pose.
+      /// \param[in] _min Minimum corner of the box given to Pack.
+      /// \param[in] _max Maximum corner of the box given to Pack.
+      /// \return The pose, positions on an axis where the box is empty are
+      /// set to _min.
+      public: static Pose3<T> Unpack(const PackedPose3 &_packed,
+                                     const Vector3<T> &_min,
+                                     const Vector3<T> &_max)
+      {
+        Pose3<T> result;
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+          const T size = std::max(_max[i] - _min[i], T(0));
+          result.p[i] = _min[i] +
+              static_cast<T>(_packed.position[i]) * size / kPackedPositionMax;
+        }
+
+        std::uint64_t code = 0;
+        for (unsigned int i = 0; i < 3; ++i)
+          code |= static_cast<std::uint64_t>(_packed.rotation[i]) << (16 * i);
+        result.q = Quaternion<T>::UnpackSmallestThree48(code);
+        return result;
+      }
+
+      /// \brief Pack an array of poses, see Pack.
+      /// \param[in] _in Pointer to the first pose.
+      /// \param[out] _out Pointer to the first of _count packed poses.
+      /// \param[in] _count Number of poses.
+      /// \param[in] _min Minimum corner of the box of the positions.
+      /// \param[in] _max Maximum corner of the box of the positions.
+      public: static void Pack(const Pose3<T> *_in, PackedPose3 *_out,
+                               const std::size_t _count,
+                               const Vector3<T> &_min, const Vector3<T> &_max)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+          _out[i] = _in[i].Pack(_min, _max);
+      }
+
+      /// \brief Unpack an array of poses, see Unpack.
+      /// \param[in] _in Pointer to the first packed pose.
+      /// \param[out] _out Pointer to the first of _count poses.
+      /// \param[in] _count Number of poses.
+      /// \param[in] _min Minimum corner of the box given to Pack.
+      /// \param[in] _max Maximum corner of the box given to Pack.
+      public: static void Unpack(const PackedPose3 *_in, Pose3<T> *_out,
+                                 const std::size_t _count,
+                                 const Vector3<T> &_min,
+                                 const Vector3<T> &_max)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+          _out[i] = Unpack(_in[i], _min, _max);
+      }
+
+      /// \brief Set _out to _a * _b. _out may be equal to _a or _b.
+      /// \param[in] _a Left-hand pose.
+      /// \param[in] _b Right-hand pose.
+      /// \param[out] _out The resulting pose.
+      private: static void Compose(const Pose3<T> &_a, const Pose3<T> &_b,
+                                   Pose3<T> &_out)
+      {
+        // Rotate _b.p by _a.q, which is _a.q * _b.p * _a.q.Inverse() written
+        // with cross products: v + 2 / |q|^2 * (w * (u x v) + u x (u x v))
+        const T w = _a.q.W();
+        const T ux = _a.q.X();
+        const T uy = _a.q.Y();
+        const T uz = _a.q.Z();
+        const T vx = _b.p.X();
+        const T vy = _b.p.Y();
+        const T vz = _b.p.Z();
+        const T norm = w * w + ux * ux + uy * uy + uz * uz;
+
+        T rx = 0, ry = 0, rz = 0;
+        if (!equal<T>(norm, static_cast<T>(0)))
+        {
+          const T s = static_cast<T>(2) / norm;
+          const T cx = uy * vz - uz * vy;
+          const T cy = uz * vx - ux * vz;
+          const T cz = ux * vy - uy * vx;
+          rx = vx + s * (w * cx + uy * cz - uz * cy);
+          ry = vy + s * (w * cy + uz * cx - ux * cz);
+          rz = vz + s * (w * cz + ux * cy - uy * cx);
+        }
+
+        const Quaternion<T> rot = _a.q * _b.q;
+        _out.p.Set(_a.p.X() + rx, _a.p.Y() + ry, _a.p.Z() + rz);
+        _out.q = rot;
+      }
+
+      /// \brief Largest quantized position of PackedPose3.
+      private: static constexpr T kPackedPositionMax = T(65535);
+
       /// \brief The position
       private: Vector3<T> p;
 
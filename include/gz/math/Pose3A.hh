@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_POSE3A_HH_
+#define GZ_MATH_POSE3A_HH_
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+
+#include <gz/math/Pose3.hh>
+#include <gz/math/Quaternion.hh>
+#include <gz/math/Vector3A.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class Pose3A Pose3A.hh gz/math/Pose3A.hh
+    /// \brief A pose made of a padded, aligned position (Vector3A) and a
+    /// rotation (Quaternion). Both members start on a 4 * sizeof(T)
+    /// boundary, so each can be loaded with aligned four lane loads.
+    ///
+    /// Pose3A converts implicitly to and from Pose3 and follows the
+    /// semantics of the matching Pose3 functions.
+    template<typename T>
+    class alignas(4 * sizeof(T)) Pose3A
+    {
+      /// \brief Default constructor, initializes to zero position and
+      /// identity rotation.
+      public: Pose3A() = default;
+
+      /// \brief Constructor from a position and a rotation.
+      /// \param[in] _pos The position.
+      /// \param[in] _rot The rotation.
+      public: Pose3A(const Vector3A<T> &_pos, const Quaternion<T> &_rot)
+      : p(_pos), q(_rot)
+      {
+      }
+
+      /// \brief Construct from a Pose3.
+      /// \param[in] _pose Pose to copy.
+      // cppcheck-suppress noExplicitConstructor
+      public: Pose3A(const Pose3<T> &_pose)
+      : p(_pose.Pos()), q(_pose.Rot())
+      {
+      }
+
+      /// \brief Convert to a Pose3.
+      /// \return A Pose3 with the same position and rotation.
+      public: operator Pose3<T>() const
+      {
+        return this->ToPose3();
+      }
+
+      /// \brief Convert to a Pose3.
+      /// \return A Pose3 with the same position and rotation.
+      public: Pose3<T> ToPose3() const
+      {
+        return Pose3<T>(this->p.ToVector3(), this->q);
+      }
+
+      /// \brief Set the pose from a position and a rotation.
+      /// \param[in] _pos The position.
+      /// \param[in] _rot The rotation.
+      public: void Set(const Vector3A<T> &_pos, const Quaternion<T> &_rot)
+      {
+        this->p = _pos;
+        this->q = _rot;
+      }
+
+      /// \brief See if a pose is finite (e.g., not nan).
+      /// \return True if finite, false otherwise.
+      public: bool IsFinite() const
+      {
+        return this->p.IsFinite() && this->q.IsFinite();
+      }
+
+      /// \brief Get the inverse of this pose.
+      /// \return The inverse pose.
+      public: Pose3A<T> Inverse() const
+      {
+        const Quaternion<T> inv = this->q.Inverse();
+        return Pose3A<T>(inv * (-this->p.ToVector3()), inv);
+      }
+
+      /// \brief Multiplication operator.
+      /// Given X_OP (frame P relative to O) and X_PQ (frame Q relative to P)
+      /// then X_OQ = X_OP * X_PQ (frame Q relative to O).
+      /// \param[in] _pose The pose to multiply by.
+      /// \return The resulting pose.
+      public: Pose3A<T> operator*(const Pose3A<T> &_pose) const
+      {
+        return Pose3A<T>(this->CoordPositionAdd(_pose.p), this->q * _pose.q);
+      }
+
+      /// \brief Multiplication assignment operator. This pose will become
+      /// equal to this * _pose.
+      /// \param[in] _pose The pose to multiply by.
+      /// \return The resulting pose.
+      public: const Pose3A<T> &operator*=(const Pose3A<T> &_pose)
+      {
+        *this = *this * _pose;
+        return *this;
+      }
+
+      /// \brief Transform a point from the frame of this pose into the
+      /// parent frame: result = this->Pos() + this->Rot() * _pos. As in
+      /// Pose3::CoordPositionAdd, the rotation does not need to be
+      /// normalized.
+      /// \param[in] _pos The point to transform.
+      /// \return The transformed point.
+      public: Vector3A<T> CoordPositionAdd(const Vector3A<T> &_pos) const
+      {
+        // q * v * q^-1 = ((w^2 - u.u) v + 2 (u.v) u + 2 w (u x v)) / |q|^2
+        const Vector3A<T> u(this->q.X(), this->q.Y(), this->q.Z());
+        const T w = this->q.W();
+        const T uu = u.SquaredLength();
+        const T n2 = w * w + uu;
+        const T inv = n2 > static_cast<T>(1e-6) ? T(1) / n2 : T(0);
+        return this->p +
+          (_pos * (w * w - uu) + u * (2 * u.Dot(_pos)) +
+           u.Cross(_pos) * (2 * w)) * inv;
+      }
+
+      /// \brief Transform points from the frame of this pose into the
+      /// parent frame. See CoordPositionAdd(const Vector3A<T> &).
+      /// \param[in] _in The points to transform.
+      /// \param[out] _out Destination of the transformed points. It may be
+      /// the same as _in.
+      /// \param[in] _count Number of points.
+      public: void CoordPositionAdd(const Vector3A<T> *_in, Vector3A<T> *_out,
+                                    const std::size_t _count) const
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+          _out[i] = this->CoordPositionAdd(_in[i]);
+      }
+
+      /// \brief Get the position.
+      /// \return The position.
+      public: const Vector3A<T> &Pos() const
+      {
+        return this->p;
+      }
+
+      /// \brief Get a mutable reference to the position.
+      /// \return The position.
+      public: Vector3A<T> &Pos()
+      {
+        return this->p;
+      }
+
+      /// \brief Get the rotation.
+      /// \return The rotation.
+      public: const Quaternion<T> &Rot() const
+      {
+        return this->q;
+      }
+
+      /// \brief Get a mutable reference to the rotation.
+      /// \return The rotation.
+      public: Quaternion<T> &Rot()
+      {
+        return this->q;
+      }
+
+      /// \brief Equality test with tolerance.
+      /// \param[in] _p The pose to compare against.
+      /// \param[in] _tol Equality tolerance.
+      /// \return True if the position and rotation of the poses are equal
+      /// within _tol.
+      public: bool Equal(const Pose3A &_p, const T &_tol) const
+      {
+        return this->p.Equal(_p.p, _tol) && this->q.Equal(_p.q, _tol);
+      }
+
+      /// \brief Equality operator, see Pose3::operator==.
+      /// \param[in] _pose The pose to compare against.
+      /// \return True if the poses are equal.
+      public: bool operator==(const Pose3A<T> &_pose) const
+      {
+        return this->p == _pose.p && this->q == _pose.q;
+      }
+
+      /// \brief Inequality operator.
+      /// \param[in] _pose The pose to compare against.
+      /// \return True if the poses are not equal.
+      public: bool operator!=(const Pose3A<T> &_pose) const
+      {
+        return !(*this == _pose);
+      }
+
+      /// \brief Stream insertion operator.
+      /// \param[in, out] _out Output stream.
+      /// \param[in] _pose Pose to output.
+      /// \return The stream.
+      public: friend std::ostream &operator<<(
+                  std::ostream &_out, const Pose3A<T> &_pose)
+      {
+        return _out << _pose.ToPose3();
+      }
+
+      /// \brief Stream extraction operator.
+      /// \param[in, out] _in Input stream.
+      /// \param[out] _pose Pose to read values into.
+      /// \return The stream.
+      public: friend std::istream &operator>>(
+                  std::istream &_in, Pose3A<T> &_pose)
+      {
+        Pose3<T> pose;
+        _in >> pose;
+        _pose = pose;
+        return _in;
+      }
+
+      /// \brief The position.
+      private: Vector3A<T> p;
+
+      /// \brief The rotation.
+      private: Quaternion<T> q;
+    };
+
+    typedef Pose3A<double> Pose3Ad;
+    typedef Pose3A<float> Pose3Af;
+
+    static_assert(sizeof(Pose3Af) == 32, "Pose3Af must be 32 bytes");
+    static_assert(alignof(Pose3Af) == 16, "Pose3Af must be 16-aligned");
+    }
+  }
+}
+#endif
@@ -0,0 +1,611 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_POSE3TRAJECTORY_HH_
+#define GZ_MATH_POSE3TRAJECTORY_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Angle.hh>
+#include <gz/math/Helpers.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Quaternion.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+#include <gz/math/detail/ParallelFor.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class Pose3Trajectory Pose3Trajectory.hh gz/math/Pose3Trajectory.hh
+    /// \brief A buffer of timestamped poses, such as the pose history of a
+    /// sensor, that interpolates poses at many times in one pass.
+    ///
+    /// Between two poses, the position is interpolated linearly and the
+    /// rotation as Quaternion::Slerp(t, q0, q1, true) does. The parts of
+    /// the slerp of each segment that don't depend on the time, such as its
+    /// angle, are computed once when the pose is appended. The batch
+    /// functions walk the poses and the sorted query times together, and
+    /// compute the sines and cosines of the slerp for blocks of times with
+    /// Angle::FastSinCos, so that interpolating a million times, for
+    /// example to deskew a lidar sweep, doesn't call std::atan2 and
+    /// std::sin for each of them.
+    ///
+    /// Times before the first pose and after the last one either get the
+    /// first or last pose, or are extrapolated from the first or last
+    /// segment, at constant linear and angular velocity.
+    template<typename T>
+    class Pose3Trajectory
+    {
+      /// \brief Default constructor, creates an empty trajectory.
+      public: Pose3Trajectory() = default;
+
+      /// \brief Append a pose to the end of the trajectory.
+      /// \param[in] _time Time of the pose. It must not be before the time
+      /// of the last pose.
+      /// \param[in] _pose The pose.
+      /// \return False if _time is before the time of the last pose, or NaN,
+      /// in which case the pose isn't appended.
+      public: bool Append(const double _time, const Pose3<T> &_pose)
+      {
+        if (std::isnan(_time) ||
+            (!this->times.empty() && _time < this->times.back()))
+        {
+          return false;
+        }
+
+        if (!this->poses.empty())
+        {
+          this->segments.push_back(MakeSegment(_time - this->times.back(),
+              this->poses.back().Rot(), _pose.Rot()));
+        }
+        this->times.push_back(_time);
+        this->poses.push_back(_pose);
+        return true;
+      }
+
+      /// \brief Remove all the poses.
+      public: void Clear()
+      {
+        this->times.clear();
+        this->poses.clear();
+        this->segments.clear();
+      }
+
+      /// \brief Get the number of poses.
+      /// \return The number of poses.
+      public: std::size_t Size() const
+      {
+        return this->poses.size();
+      }
+
+      /// \brief Get the time of a pose. The index is not checked.
+      /// \param[in] _index Index of the pose.
+      /// \return The time of the pose.
+      public: double Time(const std::size_t _index) const
+      {
+        return this->times[_index];
+      }
+
+      /// \brief Get a pose. The index is not checked.
+      /// \param[in] _index Index of the pose.
+      /// \return The pose.
+      public: const Pose3<T> &Pose(const std::size_t _index) const
+      {
+        return this->poses[_index];
+      }
+
+      /// \brief Interpolate the pose at one time.
+      /// \param[in] _time The time.
+      /// \param[out] _pose The interpolated pose.
+      /// \param[in] _extrapolate When true, times outside of the trajectory
+      /// are extrapolated from the first or last segment. Otherwise they get
+      /// the first or last pose.
+      /// \return False if the trajectory is empty.
+      public: bool Interpolate(const double _time, Pose3<T> &_pose,
+                               const bool _extrapolate = false) const
+      {
+        return this->Interpolate(&_time, &_pose, 1, _extrapolate);
+      }
+
+      /// \brief Interpolate the poses at many times, the same as calling
+      /// Interpolate(double, Pose3<T> &, bool) for each of them, but faster.
+      /// The times should be sorted in increasing order, for which the
+      /// poses and the times are walked together. Other times are
+      /// interpolated correctly, but need a binary search.
+      /// \param[in] _times Pointer to the first time.
+      /// \param[out] _out Pointer to the first of _count poses.
+      /// \param[in] _count Number of times.
+      /// \param[in] _extrapolate When true, times outside of the trajectory
+      /// are extrapolated from the first or last segment. Otherwise they get
+      /// the first or last pose.
+      /// \return False if the trajectory is empty.
+      public: bool Interpolate(const double *_times, Pose3<T> *_out,
+                               const std::size_t _count,
+                               const bool _extrapolate = false) const
+      {
+        if (this->poses.empty())
+          return false;
+
+        Block block;
+        std::size_t segment = 0;
+        for (std::size_t start = 0; start < _count; start += kBlock)
+        {
+          const std::size_t n = std::min(kBlock, _count - start);
+          this->Coefficients(_times + start, n, _extrapolate, segment, block);
+          for (std::size_t i = 0; i < n; ++i)
+            _out[start + i] = this->Blend(block, i);
+        }
+        return true;
+      }
+
+      /// \brief Transform points by the poses interpolated at their times:
+      /// _out[i] = pose(_times[i]).CoordPositionAdd(_points[i]). This
+      /// deskews the points of a sweep taken while the sensor moved. The
+      /// same rules as for Interpolate apply to the times.
+      /// \param[in] _times Pointer to the time of the first point.
+      /// \param[in] _points Pointer to the first point.
+      /// \param[out] _out Pointer to the first of _count transformed points.
+      /// It may be equal to _points to transform them in place.
+      /// \param[in] _count Number of points.
+      /// \param[in] _extrapolate When true, times outside of the trajectory
+      /// are extrapolated from the first or last segment. Otherwise they get
+      /// the first or last pose.
+      /// \return False if the trajectory is empty.
+      public: bool TransformPoints(const double *_times,
+                                   const Vector3<T> *_points,
+                                   Vector3<T> *_out, const std::size_t _count,
+                                   const bool _extrapolate = false) const
+      {
+        if (this->poses.empty())
+          return false;
+
+        Block block;
+        std::size_t segment = 0;
+        for (std::size_t start = 0; start < _count; start += kBlock)
+        {
+          const std::size_t n = std::min(kBlock, _count - start);
+          this->Coefficients(_times + start, n, _extrapolate, segment, block);
+          for (std::size_t i = 0; i < n; ++i)
+          {
+            const Pose3<T> pose = this->Blend(block, i);
+            const Quaternion<T> &q = pose.Rot();
+            const Vector3<T> &v = _points[start + i];
+
+            // v + 2 w (u x v) + 2 u x (u x v), for the unit quaternion
+            // (w, u)
+            const Vector3<T> u(q.X(), q.Y(), q.Z());
+            const Vector3<T> uv = u.Cross(v) * T(2);
+            _out[start + i] = pose.Pos() + v + uv * q.W() + u.Cross(uv);
+          }
+        }
+        return true;
+      }
+
+      /// \brief Select the poses of a trajectory to keep so that
+      /// interpolating between them, as Interpolate does, reproduces every
+      /// other pose within tolerances. This compresses densely sampled
+      /// logs, where most poses lie on smooth motion.
+      ///
+      /// The poses are walked from the first one. From each kept pose, the
+      /// longest segment that fits is found by doubling its length and then
+      /// bisecting, which takes O(n log n) time, instead of the quadratic
+      /// worst case of Douglas-Peucker. The angle between two rotations is
+      /// measured as 2 acos(|q0.q1|). The first and last poses are always
+      /// kept.
+      ///
+      /// With several threads, the poses are split into contiguous chunks
+      /// that are simplified independently, and the ends of the chunks are
+      /// kept, so a few more poses may be kept than with one thread.
+      /// \param[in] _times Time of each pose, in increasing order.
+      /// \param[in] _poses The poses, with unit quaternions.
+      /// \param[in] _count Number of poses.
+      /// \param[in] _positionTolerance Largest distance between a pose and
+      /// the interpolated one.
+      /// \param[in] _angleTolerance Largest angle in radians between the
+      /// rotation of a pose and the interpolated one.
+      /// \param[out] _indices Indices of the poses kept, in increasing
+      /// order. It is cleared first.
+      /// \param[in] _threads Largest number of threads to use, zero for
+      /// std::thread::hardware_concurrency. Short trajectories use fewer
+      /// threads.
+      public: static void Simplify(const double *_times,
+                                   const Pose3<T> *_poses,
+                                   const std::size_t _count,
+                                   const T _positionTolerance,
+                                   const T _angleTolerance,
+                                   std::vector<std::size_t> &_indices,
+                                   const unsigned int _threads = 1)
+      {
+        _indices.clear();
+        if (_count == 0)
+          return;
+
+        const T squaredTolerance = _positionTolerance * _positionTolerance;
+        const T cosHalfAngle = _angleTolerance < 0 ? T(2) :
+            static_cast<T>(std::cos(std::min(_angleTolerance, T(GZ_PI)) / 2));
+        const std::size_t last = _count - 1;
+        const std::size_t chunkCount =
+            detail::ChunkCount(last, _threads, kMinSimplifyChunk);
+        if (chunkCount == 1)
+        {
+          SimplifyRange(_times, _poses, 0, last, squaredTolerance,
+              cosHalfAngle, _indices);
+          return;
+        }
+
+        // Chunks of segments, which share their end poses
+        std::vector<std::vector<std::size_t>> chunks(chunkCount);
+        detail::ParallelFor(last, chunkCount,
+            [&](const std::size_t _c, const std::size_t _begin,
+                const std::size_t _end)
+        {
+          SimplifyRange(_times, _poses, _begin, _end, squaredTolerance,
+              cosHalfAngle, chunks[_c]);
+        });
+
+        _indices = std::move(chunks[0]);
+        for (std::size_t c = 1; c < chunkCount; ++c)
+        {
+          _indices.insert(_indices.end(), chunks[c].begin() + 1,
+              chunks[c].end());
+        }
+      }
+
+      /// \brief Simplify this trajectory, see
+      /// Simplify(const double *, const Pose3<T> *, std::size_t, T, T,
+      /// std::vector<std::size_t> &, unsigned int).
+      /// \param[in] _positionTolerance Largest distance between a pose and
+      /// the one interpolated from the simplified trajectory.
+      /// \param[in] _angleTolerance Largest angle in radians between the
+      /// rotation of a pose and the one interpolated from the simplified
+      /// trajectory.
+      /// \param[out] _out The simplified trajectory. It may be this one.
+      /// \param[in] _threads Largest number of threads to use, zero for
+      /// std::thread::hardware_concurrency.
+      public: void Simplify(const T _positionTolerance,
+                            const T _angleTolerance,
+                            Pose3Trajectory<T> &_out,
+                            const unsigned int _threads = 1) const
+      {
+        std::vector<std::size_t> indices;
+        Simplify(this->times.data(), this->poses.data(), this->poses.size(),
+            _positionTolerance, _angleTolerance, indices, _threads);
+
+        Pose3Trajectory<T> result;
+        result.times.reserve(indices.size());
+        result.poses.reserve(indices.size());
+        for (const std::size_t i : indices)
+          result.Append(this->times[i], this->poses[i]);
+        _out = std::move(result);
+      }
+
+      /// \brief Number of times in the blocks of the batch functions.
+      private: static constexpr std::size_t kBlock = 128;
+
+      /// \brief Smallest number of poses simplified by each thread.
+      private: static constexpr std::size_t kMinSimplifyChunk = 4096;
+
+      /// \brief The parts of the slerp of a segment that don't depend on
+      /// the interpolation parameter.
+      private: struct Segment
+      {
+        /// \brief 1 / duration of the segment, or 0 for a duration of 0.
+        double invDuration = 0;
+
+        /// \brief -1 to invert the end rotation for the shortest path, or 1.
+        T sign = T(1);
+
+        /// \brief 1 for a linear interpolation of the rotations, 0 for a
+        /// slerp.
+        T linear = T(1);
+
+        /// \brief Angle of the slerp.
+        T angle = T(0);
+
+        /// \brief 1 / sin(angle), or 0 for a linear interpolation.
+        T invSin = T(0);
+
+        /// \brief cos(angle) / sin(angle), or 0 for a linear interpolation.
+        T cot = T(0);
+      };
+
+      /// \brief Compute the parts of the slerp of a segment that don't
+      /// depend on the interpolation parameter.
+      /// \param[in] _duration Duration of the segment.
+      /// \param[in] _q0 Rotation at the start of the segment.
+      /// \param[in] _q1 Rotation at the end of the segment.
+      /// \return The segment.
+      private: static Segment MakeSegment(const double _duration,
+                                          const Quaternion<T> &_q0,
+                                          const Quaternion<T> &_q1)
+      {
+        Segment segment;
+        segment.invDuration = _duration > 0 ? 1.0 / _duration : 0.0;
+
+        // The parts of Quaternion::Slerp that don't depend on t
+        T fCos = _q0.Dot(_q1);
+        segment.sign = fCos < 0 ? T(-1) : T(1);
+        fCos *= segment.sign;
+        if (std::abs(fCos) < 1 - 1e-03)
+        {
+          const T fSin = static_cast<T>(std::sqrt(1 - fCos * fCos));
+          segment.angle = static_cast<T>(std::atan2(fSin, fCos));
+          segment.invSin = T(1) / fSin;
+          segment.cot = fCos * segment.invSin;
+          segment.linear = T(0);
+        }
+        return segment;
+      }
+
+      /// \brief The interpolation parameters and slerp coefficients of a
+      /// block of times.
+      private: struct Block
+      {
+        /// \brief Index of the first pose of the segment of each time.
+        std::size_t segment[kBlock];
+
+        /// \brief Interpolation parameter of each time.
+        T t[kBlock];
+
+        /// \brief Angles t * angle, then their sines.
+        double sines[kBlock];
+
+        /// \brief Cosines of the angles.
+        double cosines[kBlock];
+      };
+
+      /// \brief Find the segment and interpolation parameter of a block of
+      /// times, and compute the sines and cosines of their slerp.
+      /// \param[in] _times Pointer to the first time.
+      /// \param[in] _count Number of times, at most kBlock.
+      /// \param[in] _extrapolate Whether to extrapolate outside of the
+      /// trajectory.
+      /// \param[in,out] _segment Segment of the last time, where the walk
+      /// starts.
+      /// \param[out] _block The parameters, sines and cosines.
+      private: void Coefficients(const double *_times,
+                                 const std::size_t _count,
+                                 const bool _extrapolate,
+                                 std::size_t &_segment, Block &_block) const
+      {
+        const std::size_t last = this->segments.size();
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const double time = _times[i];
+          T t = T(0);
+          if (last > 0)
+          {
+            if (_segment > 0 && time < this->times[_segment])
+            {
+              // Unsorted time
+              _segment = static_cast<std::size_t>(std::upper_bound(
+                  this->times.begin(), this->times.end(), time) -
+                  this->times.begin());
+              _segment = _segment > 0 ? _segment - 1 : 0;
+            }
+            while (_segment + 1 < last && this->times[_segment + 1] <= time)
+              ++_segment;
+            _segment = std::min(_segment, last - 1);
+
+            t = static_cast<T>((time - this->times[_segment]) *
+                this->segments[_segment].invDuration);
+            if (!_extrapolate)
+              t = std::min(std::max(t, T(0)), T(1));
+          }
+          _block.segment[i] = _segment;
+          _block.t[i] = t;
+        }
+
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const T angle = last > 0 ?
+              this->segments[_block.segment[i]].angle : T(0);
+          _block.sines[i] = static_cast<double>(_block.t[i] * angle);
+        }
+        Angle::FastSinCos(_block.sines, _block.sines, _block.cosines, _count);
+      }
+
+      /// \brief Interpolate the pose of one time of a block.
+      /// \param[in] _block The parameters, sines and cosines of the block.
+      /// \param[in] _i Index of the time in the block.
+      /// \return The interpolated pose.
+      private: Pose3<T> Blend(const Block &_block, const std::size_t _i) const
+      {
+        const std::size_t k = _block.segment[_i];
+        if (this->segments.empty())
+          return this->poses[k];
+
+        const Pose3<T> &p0 = this->poses[k];
+        const Pose3<T> &p1 = this->poses[k + 1];
+        const T t = _block.t[_i];
+        return Pose3<T>(p0.Pos() + (p1.Pos() - p0.Pos()) * t,
+            BlendRotation(this->segments[k], p0.Rot(), p1.Rot(), t,
+                static_cast<T>(_block.sines[_i]),
+                static_cast<T>(_block.cosines[_i])));
+      }
+
+      /// \brief Interpolate the rotation of a segment.
+      /// \param[in] _segment The segment.
+      /// \param[in] _q0 Rotation at the start of the segment.
+      /// \param[in] _q1 Rotation at the end of the segment.
+      /// \param[in] _t Interpolation parameter.
+      /// \param[in] _sinT Sine of _t * _segment.angle.
+      /// \param[in] _cosT Cosine of _t * _segment.angle.
+      /// \return The interpolated rotation.
+      private: static Quaternion<T> BlendRotation(const Segment &_segment,
+                                                  const Quaternion<T> &_q0,
+                                                  const Quaternion<T> &_q1,
+                                                  const T _t, const T _sinT,
+                                                  const T _cosT)
+      {
+        // The slerp coefficients are sin((1 - t) angle) / sin(angle) and
+        // sin(t angle) / sin(angle), where the first one is expanded to
+        // cos(t angle) - cot(angle) sin(t angle), so that only the sine and
+        // cosine of t angle are needed.
+        const T lin = _segment.linear;
+        const T c0 = lin * (1 - _t) +
+            (1 - lin) * (_cosT - _segment.cot * _sinT);
+        const T c1 = (lin * _t + (1 - lin) * _segment.invSin * _sinT) *
+            _segment.sign;
+
+        T qw = _q0.W() * c0 + _q1.W() * c1;
+        T qx = _q0.X() * c0 + _q1.X() * c1;
+        T qy = _q0.Y() * c0 + _q1.Y() * c1;
+        T qz = _q0.Z() * c0 + _q1.Z() * c1;
+
+        // Linear interpolation requires renormalization
+        if (lin > 0)
+        {
+          const T s = static_cast<T>(std::sqrt(
+              qw * qw + qx * qx + qy * qy + qz * qz));
+          if (s > static_cast<T>(1e-6))
+          {
+            qw /= s;
+            qx /= s;
+            qy /= s;
+            qz /= s;
+          }
+          else
+          {
+            qw = T(1);
+            qx = qy = qz = T(0);
+          }
+        }
+        return Quaternion<T>(qw, qx, qy, qz);
+      }
+
+      /// \brief Check that the segment between two poses interpolates the
+      /// poses between them within tolerances.
+      /// \param[in] _times Time of each pose.
+      /// \param[in] _poses The poses.
+      /// \param[in] _first Index of the first pose of the segment.
+      /// \param[in] _last Index of the last pose of the segment.
+      /// \param[in] _squaredTolerance Square of the position tolerance.
+      /// \param[in] _cosHalfAngle Cosine of half the angle tolerance.
+      /// \return True if every pose is within the tolerances.
+      private: static bool SegmentFits(const double *_times,
+                                       const Pose3<T> *_poses,
+                                       const std::size_t _first,
+                                       const std::size_t _last,
+                                       const T _squaredTolerance,
+                                       const T _cosHalfAngle)
+      {
+        const Pose3<T> &p0 = _poses[_first];
+        const Pose3<T> &p1 = _poses[_last];
+        const Segment segment = MakeSegment(_times[_last] - _times[_first],
+            p0.Rot(), p1.Rot());
+        const Vector3<T> delta = p1.Pos() - p0.Pos();
+        for (std::size_t k = _first + 1; k < _last; ++k)
+        {
+          T t = static_cast<T>((_times[k] - _times[_first]) *
+              segment.invDuration);
+          t = std::min(std::max(t, T(0)), T(1));
+          const Vector3<T> position = p0.Pos() + delta * t;
+          if ((position - _poses[k].Pos()).SquaredLength() >
+              _squaredTolerance)
+          {
+            return false;
+          }
+
+          // The angle between two rotations is 2 acos(|q0.q1|)
+          const T angle = t * segment.angle;
+          const Quaternion<T> rotation = BlendRotation(segment, p0.Rot(),
+              p1.Rot(), t, std::sin(angle), std::cos(angle));
+          if (std::abs(rotation.Dot(_poses[k].Rot())) < _cosHalfAngle)
+            return false;
+        }
+        return true;
+      }
+
+      /// \brief Simplify a range of poses, see Simplify.
+      /// \param[in] _times Time of each pose.
+      /// \param[in] _poses The poses.
+      /// \param[in] _first Index of the first pose of the range.
+      /// \param[in] _last Index of the last pose of the range.
+      /// \param[in] _squaredTolerance Square of the position tolerance.
+      /// \param[in] _cosHalfAngle Cosine of half the angle tolerance.
+      /// \param[out] _indices Indices of the poses kept are appended,
+      /// including _first and _last.
+      private: static void SimplifyRange(const double *_times,
+                                         const Pose3<T> *_poses,
+                                         const std::size_t _first,
+                                         const std::size_t _last,
+                                         const T _squaredTolerance,
+                                         const T _cosHalfAngle,
+                                         std::vector<std::size_t> &_indices)
+      {
+        _indices.push_back(_first);
+        std::size_t anchor = _first;
+        while (anchor < _last)
+        {
+          // Find a far segment that fits, by doubling its length until
+          // one doesn't, then bisecting.
+          std::size_t good = anchor + 1;
+          std::size_t bad = _last + 1;
+          for (std::size_t step = 2; good < _last; step *= 2)
+          {
+            const std::size_t end = std::min(anchor + step, _last);
+            if (!SegmentFits(_times, _poses, anchor, end,
+                             _squaredTolerance, _cosHalfAngle))
+            {
+              bad = end;
+              break;
+            }
+            good = end;
+          }
+          while (bad - good > 1)
+          {
+            const std::size_t mid = good + (bad - good) / 2;
+            if (SegmentFits(_times, _poses, anchor, mid,
+                            _squaredTolerance, _cosHalfAngle))
+            {
+              good = mid;
+            }
+            else
+            {
+              bad = mid;
+            }
+          }
+          _indices.push_back(good);
+          anchor = good;
+        }
+      }
+
+      /// \brief Time of each pose.
+      private: std::vector<double> times;
+
+      /// \brief The poses.
+      private: std::vector<Pose3<T>> poses;
+
+      /// \brief The segments between consecutive poses.
+      private: std::vector<Segment> segments;
+    };
+
+    typedef Pose3Trajectory<double> Pose3Trajectoryd;
+    typedef Pose3Trajectory<float> Pose3Trajectoryf;
+    }
+  }
+}
+#endif
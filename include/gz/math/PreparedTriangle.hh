@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_PREPAREDTRIANGLE_HH_
+#define GZ_MATH_PREPAREDTRIANGLE_HH_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include <gz/math/Triangle.hh>
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class PreparedTriangle PreparedTriangle.hh
+    /// gz/math/PreparedTriangle.hh
+    /// \brief A two dimensional triangle prepared for testing many points,
+    /// such as locating points in a navigation mesh.
+    ///
+    /// The first vertex and two edge normals scaled by the inverse of twice
+    /// the area are computed once, so the barycentric coordinates of a
+    /// point take two dot products, and the batch functions are branch
+    /// free loops the compiler can vectorize, best with the coordinate
+    /// array overloads. A point is contained if all its barycentric
+    /// coordinates are non negative, as in
+    /// Triangle::Contains(const Vector2<T> &), up to rounding. A degenerate
+    /// triangle contains no point and its barycentric coordinates are NaN.
+    /// \tparam T A floating point type.
+    template<typename T>
+    class PreparedTriangle
+    {
+      static_assert(std::is_floating_point_v<T>,
+          "PreparedTriangle requires a floating point type");
+
+      /// \brief Default constructor, creates a degenerate triangle.
+      public: PreparedTriangle() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _triangle The triangle.
+      public: explicit PreparedTriangle(const Triangle<T> &_triangle)
+      {
+        this->Set(_triangle);
+      }
+
+      /// \brief Prepare a triangle, replacing the current one.
+      /// \param[in] _triangle The triangle.
+      public: void Set(const Triangle<T> &_triangle)
+      {
+        const Vector2<T> origin = _triangle[0];
+        const Vector2<T> e1 = _triangle[1] - origin;
+        const Vector2<T> e2 = _triangle[2] - origin;
+        const T det = e1.X() * e2.Y() - e1.Y() * e2.X();
+
+        this->ox = origin.X();
+        this->oy = origin.Y();
+        if (std::fpclassify(det) == FP_ZERO || !std::isfinite(det))
+        {
+          this->ux = this->uy = this->vx = this->vy = kNaN;
+          return;
+        }
+
+        // Point = origin + u * e1 + v * e2, solved with Cramer's rule
+        const T inv = 1 / det;
+        this->ux = e2.Y() * inv;
+        this->uy = -e2.X() * inv;
+        this->vx = -e1.Y() * inv;
+        this->vy = e1.X() * inv;
+      }
+
+      /// \brief Check whether the triangle is not degenerate.
+      /// \return True if the vertices are finite and not collinear.
+      public: bool Valid() const
+      {
+        return !std::isnan(this->ux);
+      }
+
+      /// \brief Get the barycentric coordinates of a point.
+      /// \param[in] _pt The point.
+      /// \return The weights of the three vertices, in order. They sum to
+      /// one, and interpolate the vertices to _pt.
+      public: Vector3<T> Barycentric(const Vector2<T> &_pt) const
+      {
+        T w0, w1, w2;
+        this->Weights(_pt.X(), _pt.Y(), w0, w1, w2);
+        return Vector3<T>(w0, w1, w2);
+      }
+
+      /// \brief Check whether the triangle contains a point.
+      /// \param[in] _pt The point.
+      /// \return True if the point is inside or on the triangle.
+      public: bool Contains(const Vector2<T> &_pt) const
+      {
+        T w0, w1, w2;
+        this->Weights(_pt.X(), _pt.Y(), w0, w1, w2);
+        return (w0 >= 0) & (w1 >= 0) & (w2 >= 0);
+      }
+
+      /// \brief Check which points of an array are in the triangle.
+      /// \param[in] _points The points.
+      /// \param[out] _results 1 for each point inside or on the triangle, 0
+      /// otherwise.
+      /// \param[in] _count Number of points.
+      /// \return Number of points in the triangle.
+      public: std::size_t Contains(const Vector2<T> *_points,
+                                   std::uint8_t *_results,
+                                   const std::size_t _count) const
+      {
+        std::size_t inside = 0;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          T w0, w1, w2;
+          this->Weights(_points[i].X(), _points[i].Y(), w0, w1, w2);
+          const bool in = (w0 >= 0) & (w1 >= 0) & (w2 >= 0);
+          _results[i] = static_cast<std::uint8_t>(in);
+          inside += in;
+        }
+        return inside;
+      }
+
+      /// \brief Check which points given by coordinate arrays are in the
+      /// triangle.
+      /// \param[in] _x X coordinates of the points.
+      /// \param[in] _y Y coordinates of the points.
+      /// \param[out] _results 1 for each point inside or on the triangle, 0
+      /// otherwise.
+      /// \param[in] _count Number of points.
+      /// \return Number of points in the triangle.
+      public: std::size_t Contains(const T *_x, const T *_y,
+                                   std::uint8_t *_results,
+                                   const std::size_t _count) const
+      {
+        std::size_t inside = 0;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          T w0, w1, w2;
+          this->Weights(_x[i], _y[i], w0, w1, w2);
+          const bool in = (w0 >= 0) & (w1 >= 0) & (w2 >= 0);
+          _results[i] = static_cast<std::uint8_t>(in);
+          inside += in;
+        }
+        return inside;
+      }
+
+      /// \brief Get the barycentric coordinates of an array of points.
+      /// \param[in] _points The points.
+      /// \param[out] _weights The weights of the three vertices for each
+      /// point, see Barycentric(const Vector2<T> &).
+      /// \param[in] _count Number of points.
+      public: void Barycentric(const Vector2<T> *_points,
+                               Vector3<T> *_weights,
+                               const std::size_t _count) const
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          T w0, w1, w2;
+          this->Weights(_points[i].X(), _points[i].Y(), w0, w1, w2);
+          _weights[i].Set(w0, w1, w2);
+        }
+      }
+
+      /// \brief Get the barycentric coordinates of points given by
+      /// coordinate arrays.
+      /// \param[in] _x X coordinates of the points.
+      /// \param[in] _y Y coordinates of the points.
+      /// \param[out] _w0 Weight of the first vertex for each point.
+      /// \param[out] _w1 Weight of the second vertex for each point.
+      /// \param[out] _w2 Weight of the third vertex for each point.
+      /// \param[in] _count Number of points.
+      public: void Barycentric(const T *_x, const T *_y, T *_w0, T *_w1,
+                               T *_w2, const std::size_t _count) const
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+          this->Weights(_x[i], _y[i], _w0[i], _w1[i], _w2[i]);
+      }
+
+      /// \brief Compute the barycentric coordinates of a point.
+      /// \param[in] _x X coordinate of the point.
+      /// \param[in] _y Y coordinate of the point.
+      /// \param[out] _w0 Weight of the first vertex.
+      /// \param[out] _w1 Weight of the second vertex.
+      /// \param[out] _w2 Weight of the third vertex.
+      private: void Weights(const T _x, const T _y, T &_w0, T &_w1,
+                            T &_w2) const
+      {
+        const T dx = _x - this->ox;
+        const T dy = _y - this->oy;
+        _w1 = this->ux * dx + this->uy * dy;
+        _w2 = this->vx * dx + this->vy * dy;
+        _w0 = 1 - _w1 - _w2;
+      }
+
+      /// \brief Not a number, used for degenerate triangles.
+      private: static constexpr T kNaN = std::numeric_limits<T>::quiet_NaN();
+
+      /// \brief X coordinate of the first vertex.
+      private: T ox = 0;
+
+      /// \brief Y coordinate of the first vertex.
+      private: T oy = 0;
+
+      /// \brief X component of the gradient of the second weight.
+      private: T ux = kNaN;
+
+      /// \brief Y component of the gradient of the second weight.
+      private: T uy = kNaN;
+
+      /// \brief X component of the gradient of the third weight.
+      private: T vx = kNaN;
+
+      /// \brief Y component of the gradient of the third weight.
+      private: T vy = kNaN;
+    };
+
+    using PreparedTriangled = PreparedTriangle<double>;
+    using PreparedTrianglef = PreparedTriangle<float>;
+    }
+  }
+}
+#endif
@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_PREPAREDTRIANGLE3_HH_
+#define GZ_MATH_PREPAREDTRIANGLE3_HH_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include <gz/math/Triangle3.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class PreparedTriangle3 PreparedTriangle3.hh
+    /// gz/math/PreparedTriangle3.hh
+    /// \brief A three dimensional triangle prepared for testing many
+    /// points, such as sampling a triangle mesh.
+    ///
+    /// The unit normal and the gradients of two barycentric coordinates in
+    /// the plane of the triangle are computed once, so each point takes
+    /// three dot products and the batch functions are branch free loops
+    /// the compiler can vectorize. Barycentric coordinates are those of
+    /// the projection of the point on the plane of the triangle.
+    ///
+    /// A point is contained if its distance to the plane of the triangle is
+    /// at most a tolerance and all its barycentric coordinates are non
+    /// negative. Unlike Triangle3::Contains(const Vector3<T> &), which
+    /// tests the distance to a plane through the origin, the distance is
+    /// measured to the plane of the triangle. A degenerate triangle
+    /// contains no point and its barycentric coordinates are NaN.
+    /// \tparam T A floating point type.
+    template<typename T>
+    class PreparedTriangle3
+    {
+      static_assert(std::is_floating_point_v<T>,
+          "PreparedTriangle3 requires a floating point type");
+
+      /// \brief Default constructor, creates a degenerate triangle.
+      public: PreparedTriangle3() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _triangle The triangle.
+      public: explicit PreparedTriangle3(const Triangle3<T> &_triangle)
+      {
+        this->Set(_triangle);
+      }
+
+      /// \brief Prepare a triangle, replacing the current one.
+      /// \param[in] _triangle The triangle.
+      public: void Set(const Triangle3<T> &_triangle)
+      {
+        this->origin = _triangle[0];
+        const Vector3<T> e1 = _triangle[1] - this->origin;
+        const Vector3<T> e2 = _triangle[2] - this->origin;
+        const Vector3<T> cross = e1.Cross(e2);
+        const T area2 = cross.SquaredLength();
+        if (std::fpclassify(area2) == FP_ZERO || !std::isfinite(area2))
+        {
+          this->gradient1.Set(kNaN, kNaN, kNaN);
+          this->gradient2.Set(kNaN, kNaN, kNaN);
+          this->normal.Set(kNaN, kNaN, kNaN);
+          return;
+        }
+
+        // The gradients are the dual basis of the edges in the plane:
+        // gradient1 . e1 = 1, gradient1 . e2 = 0 and the reverse.
+        this->gradient1 = e2.Cross(cross) / area2;
+        this->gradient2 = cross.Cross(e1) / area2;
+        this->normal = cross / std::sqrt(area2);
+      }
+
+      /// \brief Check whether the triangle is not degenerate.
+      /// \return True if the vertices are finite and not collinear.
+      public: bool Valid() const
+      {
+        return !std::isnan(this->normal.X());
+      }
+
+      /// \brief Get the unit normal of the triangle, following the right
+      /// hand rule on the vertex order.
+      /// \return The normal, NaN if the triangle is degenerate.
+      public: const Vector3<T> &Normal() const
+      {
+        return this->normal;
+      }
+
+      /// \brief Get the signed distance from the plane of the triangle.
+      /// \param[in] _pt The point.
+      /// \return Distance, positive on the side of the normal.
+      public: T Distance(const Vector3<T> &_pt) const
+      {
+        return this->normal.Dot(_pt - this->origin);
+      }
+
+      /// \brief Get the barycentric coordinates of a point projected on the
+      /// plane of the triangle.
+      /// \param[in] _pt The point.
+      /// \return The weights of the three vertices, in order. They sum to
+      /// one, and interpolate the vertices to the projection of _pt.
+      public: Vector3<T> Barycentric(const Vector3<T> &_pt) const
+      {
+        T w0, w1, w2, dist;
+        this->Weights(_pt, w0, w1, w2, dist);
+        return Vector3<T>(w0, w1, w2);
+      }
+
+      /// \brief Check whether the triangle contains a point.
+      /// \param[in] _pt The point.
+      /// \param[in] _tolerance Largest distance from the plane of the
+      /// triangle.
+      /// \return True if the point is inside or on the triangle.
+      public: bool Contains(const Vector3<T> &_pt,
+                            const T _tolerance = 0) const
+      {
+        T w0, w1, w2, dist;
+        this->Weights(_pt, w0, w1, w2, dist);
+        return (w0 >= 0) & (w1 >= 0) & (w2 >= 0) &
+               (std::abs(dist) <= _tolerance);
+      }
+
+      /// \brief Check which points of an array are in the triangle.
+      /// \param[in] _points The points.
+      /// \param[out] _results 1 for each point inside or on the triangle, 0
+      /// otherwise.
+      /// \param[in] _count Number of points.
+      /// \param[in] _tolerance Largest distance from the plane of the
+      /// triangle.
+      /// \return Number of points in the triangle.
+      public: std::size_t Contains(const Vector3<T> *_points,
+                                   std::uint8_t *_results,
+                                   const std::size_t _count,
+                                   const T _tolerance = 0) const
+      {
+        std::size_t inside = 0;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          T w0, w1, w2, dist;
+          this->Weights(_points[i], w0, w1, w2, dist);
+          const bool in = (w0 >= 0) & (w1 >= 0) & (w2 >= 0) &
+                          (std::abs(dist) <= _tolerance);
+          _results[i] = static_cast<std::uint8_t>(in);
+          inside += in;
+        }
+        return inside;
+      }
+
+      /// \brief Get the barycentric coordinates of an array of points.
+      /// \param[in] _points The points.
+      /// \param[out] _weights The weights of the three vertices for each
+      /// point, see Barycentric(const Vector3<T> &).
+      /// \param[in] _count Number of points.
+      public: void Barycentric(const Vector3<T> *_points,
+                               Vector3<T> *_weights,
+                               const std::size_t _count) const
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          T w0, w1, w2, dist;
+          this->Weights(_points[i], w0, w1, w2, dist);
+          _weights[i].Set(w0, w1, w2);
+        }
+      }
+
+      /// \brief Compute the barycentric coordinates and plane distance of a
+      /// point.
+      /// \param[in] _pt The point.
+      /// \param[out] _w0 Weight of the first vertex.
+      /// \param[out] _w1 Weight of the second vertex.
+      /// \param[out] _w2 Weight of the third vertex.
+      /// \param[out] _dist Signed distance from the plane.
+      private: void Weights(const Vector3<T> &_pt, T &_w0, T &_w1, T &_w2,
+                            T &_dist) const
+      {
+        const T dx = _pt.X() - this->origin.X();
+        const T dy = _pt.Y() - this->origin.Y();
+        const T dz = _pt.Z() - this->origin.Z();
+        _w1 = this->gradient1.X() * dx + this->gradient1.Y() * dy +
+              this->gradient1.Z() * dz;
+        _w2 = this->gradient2.X() * dx + this->gradient2.Y() * dy +
+              this->gradient2.Z() * dz;
+        _w0 = 1 - _w1 - _w2;
+        _dist = this->normal.X() * dx + this->normal.Y() * dy +
+                this->normal.Z() * dz;
+      }
+
+      /// \brief Not a number, used for degenerate triangles.
+      private: static constexpr T kNaN = std::numeric_limits<T>::quiet_NaN();
+
+      /// \brief First vertex.
+      private: Vector3<T> origin;
+
+      /// \brief Gradient of the weight of the second vertex.
+      private: Vector3<T> gradient1{kNaN, kNaN, kNaN};
+
+      /// \brief Gradient of the weight of the third vertex.
+      private: Vector3<T> gradient2{kNaN, kNaN, kNaN};
+
+      /// \brief Unit normal.
+      private: Vector3<T> normal{kNaN, kNaN, kNaN};
+    };
+
+    using PreparedTriangle3d = PreparedTriangle3<double>;
+    using PreparedTriangle3f = PreparedTriangle3<float>;
+    }
+  }
+}
+#endif
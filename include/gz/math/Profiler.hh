@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_PROFILER_HH_
+#define GZ_MATH_PROFILER_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <gz/math/Export.hh>
+#include <gz/math/Stopwatch.hh>
+#include <gz/math/config.hh>
+
+/// \def GZ_MATH_PROFILE_ZONE(_name)
+/// \brief Time the rest of the enclosing scope as a profiling zone called
+/// _name. Expands to nothing unless GZ_MATH_PROFILING is defined, so
+/// annotated code carries no cost in regular builds. gz-math itself is
+/// built with its entry points annotated when the GZ_MATH_PROFILING CMake
+/// option is enabled.
+#ifdef GZ_MATH_PROFILING
+#define GZ_MATH_PROFILE_CONCAT_IMPL(_a, _b) _a##_b
+#define GZ_MATH_PROFILE_CONCAT(_a, _b) GZ_MATH_PROFILE_CONCAT_IMPL(_a, _b)
+#define GZ_MATH_PROFILE_ZONE(_name) \
+  static const std::size_t GZ_MATH_PROFILE_CONCAT(gzMathZoneId, __LINE__) = \
+    gz::math::Profiler::RegisterZone(_name); \
+  const gz::math::ProfileZone GZ_MATH_PROFILE_CONCAT(gzMathZone, __LINE__)( \
+    GZ_MATH_PROFILE_CONCAT(gzMathZoneId, __LINE__))
+#else
+#define GZ_MATH_PROFILE_ZONE(_name)
+#endif
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class ProfileStatistics Profiler.hh gz/math/Profiler.hh
+    /// \brief Timing statistics of a profiling zone, as returned by
+    /// Profiler::Statistics. All durations are in nanoseconds.
+    class ProfileStatistics
+    {
+      /// \brief Number of histogram buckets. Durations are binned in four
+      /// buckets per power of two, which bounds the relative error of
+      /// Percentile() to 12.5%.
+      public: static constexpr std::size_t kBuckets = 252;
+
+      /// \brief Get the histogram bucket of a duration.
+      /// \param[in] _ns Duration in nanoseconds.
+      /// \return Index of the bucket in the range [0, kBuckets).
+      public: static std::size_t Bucket(const std::uint64_t _ns)
+      {
+        if (_ns < 4)
+          return static_cast<std::size_t>(_ns);
+        // e is the index of the highest set bit
+        std::size_t e = 0;
+        for (std::uint64_t v = _ns >> 1; v != 0; v >>= 1)
+          ++e;
+        return 4 * (e - 1) + static_cast<std::size_t>((_ns >> (e - 2)) & 3u);
+      }
+
+      /// \brief Get the smallest duration of a histogram bucket.
+      /// \param[in] _bucket Index of the bucket.
+      /// \return Lower bound of the bucket in nanoseconds.
+      public: static std::uint64_t BucketLowerBound(const std::size_t _bucket)
+      {
+        if (_bucket < 4)
+          return _bucket;
+        const std::size_t e = _bucket / 4 + 1;
+        return static_cast<std::uint64_t>(4 + _bucket % 4) << (e - 2);
+      }
+
+      /// \brief Number of times the zone was entered.
+      public: std::uint64_t count = 0;
+
+      /// \brief Total time spent in the zone.
+      public: std::uint64_t total = 0;
+
+      /// \brief Shortest time spent in the zone, or zero if count is zero.
+      public: std::uint64_t min = 0;
+
+      /// \brief Longest time spent in the zone.
+      public: std::uint64_t max = 0;
+
+      /// \brief Number of samples in each histogram bucket, see Bucket().
+      public: std::vector<std::uint64_t> histogram =
+                std::vector<std::uint64_t>(kBuckets, 0);
+
+      /// \brief Get the mean time spent in the zone.
+      /// \return The mean duration, or zero if count is zero.
+      public: double Mean() const
+      {
+        return this->count == 0 ? 0.0 :
+          static_cast<double>(this->total) / static_cast<double>(this->count);
+      }
+
+      /// \brief Estimate a percentile of the time spent in the zone from the
+      /// histogram.
+      /// \param[in] _p The percentile, in the range [0, 100].
+      /// \return The estimated duration, clamped to [min, max]. Zero if
+      /// count is zero.
+      public: double Percentile(const double _p) const
+      {
+        if (this->count == 0)
+          return 0.0;
+        const double p = _p < 0 ? 0.0 : (_p > 100 ? 100.0 : _p);
+        const double rank = p / 100.0 * static_cast<double>(this->count);
+        std::uint64_t seen = 0;
+        std::size_t bucket = 0;
+        for (; bucket + 1 < this->histogram.size(); ++bucket)
+        {
+          seen += this->histogram[bucket];
+          if (seen > 0 && static_cast<double>(seen) >= rank)
+            break;
+        }
+        const double mid = 0.5 * (static_cast<double>(
+            BucketLowerBound(bucket)) + static_cast<double>(
+            BucketLowerBound(bucket + 1)));
+        const double lo = static_cast<double>(this->min);
+        const double hi = static_cast<double>(this->max);
+        return mid < lo ? lo : (mid > hi ? hi : mid);
+      }
+    };
+
+    /// \class Profiler Profiler.hh gz/math/Profiler.hh
+    /// \brief Collects timing samples of named profiling zones.
+    ///
+    /// Samples are accumulated in per-thread buffers without locks; a
+    /// thread only takes a lock the first time it records a sample. The
+    /// statistics of all threads are combined when they are read. Zones are
+    /// usually timed with the ProfileZone class or the GZ_MATH_PROFILE_ZONE
+    /// macro.
+    ///
+    /// # Example usage
+    ///
+    /// ```{.cpp}
+    /// void Step()
+    /// {
+    ///   GZ_MATH_PROFILE_ZONE("Step");
+    ///   // do something...
+    /// }
+    ///
+    /// gz::math::Profiler::Dump(std::cout);
+    /// ```
+    class GZ_MATH_VISIBLE Profiler
+    {
+      /// \brief Maximum number of distinct zones.
+      public: static constexpr std::size_t kMaxZones = 256;
+
+      /// \brief Identifier returned by RegisterZone when kMaxZones zones
+      /// already exist. Samples recorded for it are dropped.
+      public: static constexpr std::size_t kInvalidZone =
+                std::numeric_limits<std::size_t>::max();
+
+      /// \brief Get the identifier of a zone, registering the zone if
+      /// needed. This takes a lock, so store the result rather than calling
+      /// it on every sample.
+      /// \param[in] _name Name of the zone.
+      /// \return Identifier of the zone. Calls with the same name return the
+      /// same identifier. kInvalidZone if kMaxZones zones already exist.
+      public: static std::size_t RegisterZone(const std::string &_name);
+
+      /// \brief Record one sample of a zone for the calling thread.
+      /// \param[in] _zone Identifier returned by RegisterZone.
+      /// \param[in] _duration Time spent in the zone.
+      public: static void Record(const std::size_t _zone,
+                                 const clock::duration &_duration);
+
+      /// \brief Get the names of all registered zones.
+      /// \return Names of the zones in registration order.
+      public: static std::vector<std::string> Zones();
+
+      /// \brief Get the statistics of a zone, combined over all threads.
+      /// \param[in] _name Name of the zone.
+      /// \param[out] _stats The statistics of the zone.
+      /// \return False if no zone named _name is registered.
+      public: static bool Statistics(const std::string &_name,
+                                     ProfileStatistics &_stats);
+
+      /// \brief Clear the samples of all zones. Zones stay registered.
+      /// Samples recorded by other threads while this runs may be partially
+      /// cleared.
+      public: static void Reset();
+
+      /// \brief Write a table with the count, mean, minimum, median, 99th
+      /// percentile and maximum duration of each zone that has samples.
+      /// \param[in, out] _out Output stream.
+      public: static void Dump(std::ostream &_out);
+    };
+
+    /// \class ProfileZone Profiler.hh gz/math/Profiler.hh
+    /// \brief Records the time between its construction and destruction as
+    /// one sample of a profiling zone.
+    class ProfileZone
+    {
+      /// \brief Constructor, starts timing.
+      /// \param[in] _zone Identifier returned by Profiler::RegisterZone.
+      public: explicit ProfileZone(const std::size_t _zone)
+      : zone(_zone), start(clock::now())
+      {
+      }
+
+      /// \brief Destructor, records the elapsed time.
+      public: ~ProfileZone()
+      {
+        Profiler::Record(this->zone, clock::now() - this->start);
+      }
+
+      /// \brief Not copyable.
+      public: ProfileZone(const ProfileZone &) = delete;
+
+      /// \brief Not copyable.
+      public: ProfileZone &operator=(const ProfileZone &) = delete;
+
+      /// \brief Identifier of the zone.
+      private: const std::size_t zone;
+
+      /// \brief Time at which the zone was entered.
+      private: const clock::time_point start;
+    };
+    }
+  }
+}
+#endif
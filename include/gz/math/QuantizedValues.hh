@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_QUANTIZEDVALUES_HH_
+#define GZ_MATH_QUANTIZEDVALUES_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class QuantizedValues QuantizedValues.hh gz/math/QuantizedValues.hh
+    /// \brief A compact array of values stored as integers with a common
+    /// offset and scale. A value v is stored as round((v - offset) / scale)
+    /// and read back as offset + q * scale, so every value read differs from
+    /// the original by at most MaxError().
+    ///
+    /// It can be passed to VolumetricGridLookupField and
+    /// TimeVaryingVolumetricGridLookupField estimation functions in place of
+    /// a std::vector of values. Values are dequantized while interpolating,
+    /// and since interpolation inside a cell is a weighted average, the
+    /// estimates are also within MaxError() of the estimates with the
+    /// original values.
+    ///
+    /// \tparam Q Integer type of the stored values, such as std::int16_t.
+    /// \tparam V Floating point type of the values.
+    ///
+    /// # Example usage
+    ///
+    /// ```{.cpp}
+    /// gz::math::QuantizedValues<std::int16_t, double> quantized(values);
+    /// auto estimate = field.EstimateValueUsingTrilinear(pos, quantized);
+    /// ```
+    template<typename Q = std::int16_t, typename V = double>
+    class QuantizedValues
+    {
+      static_assert(std::is_integral_v<Q> && sizeof(Q) <= 4,
+        "Q must be an integer type of at most 32 bits");
+      static_assert(std::is_floating_point_v<V>,
+        "V must be a floating point type");
+
+      /// \brief Type of the values read back.
+      public: using value_type = V;
+
+      /// \brief Default constructor, holds no values.
+      public: QuantizedValues() = default;
+
+      /// \brief Constructor, quantizes values using the full range of Q
+      /// between the smallest and largest of them.
+      /// \param[in] _values The values. Values that are not finite are
+      /// stored as the smallest finite value.
+      public: explicit QuantizedValues(const std::vector<V> &_values)
+      {
+        V minValue = std::numeric_limits<V>::max();
+        V maxValue = std::numeric_limits<V>::lowest();
+        for (const V &value : _values)
+        {
+          if (std::isfinite(value))
+          {
+            minValue = std::min(minValue, value);
+            maxValue = std::max(maxValue, value);
+          }
+        }
+        if (minValue > maxValue)
+        {
+          minValue = maxValue = V(0);
+        }
+
+        // Signed types use a symmetric range so that zero is exact when
+        // the values are centered on it
+        const V qMin = std::is_signed_v<Q> ?
+          -static_cast<V>(std::numeric_limits<Q>::max()) : V(0);
+        const V qMax = static_cast<V>(std::numeric_limits<Q>::max());
+        this->scale = (maxValue - minValue) / (qMax - qMin);
+        this->offset = minValue - qMin * this->scale;
+
+        this->data.resize(_values.size());
+        for (std::size_t i = 0; i < _values.size(); ++i)
+        {
+          V q = qMin;
+          if (this->scale > 0 && std::isfinite(_values[i]))
+          {
+            q = std::round((_values[i] - this->offset) / this->scale);
+            q = std::min(std::max(q, qMin), qMax);
+          }
+          this->data[i] = static_cast<Q>(q);
+        }
+      }
+
+      /// \brief Get a value.
+      /// \param[in] _index Index of the value. It is not checked.
+      /// \return The dequantized value.
+      public: V operator[](const std::size_t _index) const
+      {
+        return this->offset + static_cast<V>(this->data[_index]) * this->scale;
+      }
+
+      /// \brief Get the number of values.
+      /// \return Number of values.
+      public: std::size_t Size() const
+      {
+        return this->data.size();
+      }
+
+      /// \brief Get the offset added to every stored value.
+      /// \return The offset.
+      public: V Offset() const
+      {
+        return this->offset;
+      }
+
+      /// \brief Get the difference between consecutive representable
+      /// values.
+      /// \return The scale, zero if all values are equal.
+      public: V Scale() const
+      {
+        return this->scale;
+      }
+
+      /// \brief Get the largest difference between a finite value passed to
+      /// the constructor and the value read back, ignoring floating point
+      /// rounding.
+      /// \return Half of Scale().
+      public: V MaxError() const
+      {
+        return this->scale / 2;
+      }
+
+      /// \brief Get the stored integers.
+      /// \return Pointer to the first stored integer.
+      public: const Q *Data() const
+      {
+        return this->data.data();
+      }
+
+      /// \brief The stored integers.
+      private: std::vector<Q> data;
+
+      /// \brief Value of a stored zero.
+      private: V offset{0};
+
+      /// \brief Value of one step of a stored integer.
+      private: V scale{0};
+    };
+    }
+  }
+}
+#endif
@@ -17,6 +17,11 @@
 #ifndef GZ_MATH_QUATERNION_HH_
 #define GZ_MATH_QUATERNION_HH_
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
 #include <gz/math/Helpers.hh>
 #include <gz/math/Angle.hh>
 #include <gz/math/Vector3.hh>
@@ -286,6 +291,32 @@ namespace gz
         }
       }
 
+      /// \brief Normalize the quaternion with fastInverseSqrt instead of a
+      /// square root and divisions. The relative error of the norm is
+      /// below 5e-6 for float and 4e-11 for double, which is enough to
+      /// renormalize a quaternion after a small update. As in Normalize, a
+      /// quaternion with a norm of zero (within 1e-6) becomes identity.
+      public: void NormalizeFast()
+      {
+        const T squared = this->qw * this->qw + this->qx * this->qx +
+            this->qy * this->qy + this->qz * this->qz;
+        if (squared <= static_cast<T>(1e-12))
+        {
+          this->qw = T(1.0);
+          this->qx = T(0.0);
+          this->qy = T(0.0);
+          this->qz = T(0.0);
+        }
+        else
+        {
+          const T inv = static_cast<T>(fastInverseSqrt(squared));
+          this->qw *= inv;
+          this->qx *= inv;
+          this->qy *= inv;
+          this->qz *= inv;
+        }
+      }
+
       /// \brief Gets a normalized version of this quaternion
       /// \return a normalized quaternion
       public: Quaternion<T> Normalized() const
@@ -359,7 +390,7 @@ namespace gz
       /// \param[in] _x x
       /// \param[in] _y y
       /// \param[in] _z z
-      public: void Set(T _w, T _x, T _y, T _z)
+      public: constexpr void Set(T _w, T _x, T _y, T _z)
       {
         this->qw = _w;
         this->qx = _x;
@@ -729,7 +760,7 @@ namespace gz
       /// \brief Addition operator.
       /// \param[in] _qt Quaternion for addition.
       /// \return This quaternion + _qt.
-      public: Quaternion<T> operator+(const Quaternion<T> &_qt) const
+      public: constexpr Quaternion<T> operator+(const Quaternion<T> &_qt) const
       {
         Quaternion<T> result(this->qw + _qt.qw, this->qx + _qt.qx,
                              this->qy + _qt.qy, this->qz + _qt.qz);
@@ -739,7 +770,7 @@ namespace gz
       /// \brief Addition set operator.
       /// \param[in] _qt Quaternion for addition.
       /// \return This quaternion + qt.
-      public: Quaternion<T> operator+=(const Quaternion<T> &_qt)
+      public: constexpr Quaternion<T> operator+=(const Quaternion<T> &_qt)
       {
         *this = *this + _qt;
 
@@ -749,7 +780,7 @@ namespace gz
       /// \brief Subtraction operator.
       /// \param[in] _qt Quaternion to subtract.
       /// \return This quaternion - _qt
-      public: Quaternion<T> operator-(const Quaternion<T> &_qt) const
+      public: constexpr Quaternion<T> operator-(const Quaternion<T> &_qt) const
       {
         Quaternion<T> result(this->qw - _qt.qw, this->qx - _qt.qx,
                        this->qy - _qt.qy, this->qz - _qt.qz);
@@ -759,7 +790,7 @@ namespace gz
       /// \brief Subtraction set operator.
       /// \param[in] _qt Quaternion for subtraction.
       /// \return This quaternion - qt.
-      public: Quaternion<T> operator-=(const Quaternion<T> &_qt)
+      public: constexpr Quaternion<T> operator-=(const Quaternion<T> &_qt)
       {
         *this = *this - _qt;
         return *this;
@@ -768,7 +799,7 @@ namespace gz
       /// \brief Multiplication operator.
       /// \param[in] _q Quaternion for multiplication.
       /// \return This quaternion multiplied by the parameter.
-      public: inline Quaternion<T> operator*(const Quaternion<T> &_q) const
+      public: constexpr Quaternion<T> operator*(const Quaternion<T> &_q) const
               {
                 return Quaternion<T>(
                   this->qw*_q.qw-this->qx*_q.qx-this->qy*_q.qy-this->qz*_q.qz,
@@ -780,7 +811,7 @@ namespace gz
       /// \brief Multiplication operator by a scalar.
       /// \param[in] _f Factor.
       /// \return Quaternion multiplied by the scalar.
-      public: Quaternion<T> operator*(const T &_f) const
+      public: constexpr Quaternion<T> operator*(const T &_f) const
       {
         return Quaternion<T>(this->qw*_f, this->qx*_f,
                              this->qy*_f, this->qz*_f);
@@ -789,7 +820,7 @@ namespace gz
       /// \brief Multiplication set operator.
       /// \param[in] _qt Quaternion<T> for multiplication.
       /// \return This quaternion multiplied by the parameter.
-      public: Quaternion<T> operator*=(const Quaternion<T> &_qt)
+      public: constexpr Quaternion<T> operator*=(const Quaternion<T> &_qt)
       {
         *this = *this * _qt;
         return *this;
@@ -798,7 +829,7 @@ namespace gz
       /// \brief Vector3 multiplication operator.
       /// \param[in] _v vector to multiply.
       /// \return The result of the vector multiplication.
-      public: Vector3<T> operator*(const Vector3<T> &_v) const
+      public: constexpr Vector3<T> operator*(const Vector3<T> &_v) const
       {
         Vector3<T> uv, uuv;
         Vector3<T> qvec(this->qx, this->qy, this->qz);
@@ -834,7 +865,7 @@ namespace gz
 
       /// \brief Unary minus operator.
       /// \return Negation of each component of this quaternion.
-      public: Quaternion<T> operator-() const
+      public: constexpr Quaternion<T> operator-() const
       {
         return Quaternion<T>(-this->qw, -this->qx, -this->qy, -this->qz);
       }
@@ -850,6 +881,33 @@ namespace gz
         return Vector3<T>(tmp.qx, tmp.qy, tmp.qz);
       }
 
+      /// \brief Rotate a buffer of vectors by this quaternion.
+      /// This is equivalent to calling RotateVector on each element, but the
+      /// rotation matrix is computed once for the whole buffer and each
+      /// vector is rotated with a single matrix multiplication. The results
+      /// match RotateVector up to floating point rounding (a few ulp).
+      /// \param[in] _in Pointer to the first vector to rotate.
+      /// \param[out] _out Pointer to the first rotated vector. It may be
+      /// equal to _in to rotate the buffer in place.
+      /// \param[in] _count Number of vectors to rotate.
+      public: void RotateVector(const Vector3<T> *_in, Vector3<T> *_out,
+                                const std::size_t _count) const
+      {
+        const Matrix3<T> m(*this);
+        const T m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2);
+        const T m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2);
+        const T m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2);
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const T x = _in[i].X();
+          const T y = _in[i].Y();
+          const T z = _in[i].Z();
+          _out[i].Set(m00 * x + m01 * y + m02 * z,
+                      m10 * x + m11 * y + m12 * z,
+                      m20 * x + m21 * y + m22 * z);
+        }
+      }
+
       /// \brief Get the reverse rotation of a vector by this quaternion.
       /// \param[in] _vec The vector.
       /// \return The reversed vector.
@@ -962,7 +1020,7 @@ namespace gz
       /// quaternion.
       /// \param[in] _q The other quaternion.
       /// \return The dot product.
-      public: T Dot(const Quaternion<T> &_q) const
+      public: constexpr T Dot(const Quaternion<T> &_q) const
       {
         return this->qw*_q.qw + this->qx * _q.qx +
                this->qy*_q.qy + this->qz*_q.qz;
@@ -1075,58 +1133,147 @@ namespace gz
         return deltaQ * (*this);
       }
 
+      /// \brief Encode the rotation in 32 bits with the smallest three
+      /// method. The sign is chosen so that the largest component is
+      /// positive, which gives the same rotation, then the index of that
+      /// component is stored in 2 bits and the three others, which are
+      /// within +-1/sqrt(2), in 10 bits each. The quaternion is normalized
+      /// first. The rotation decoded by UnpackSmallestThree32 is within
+      /// 0.005 radians of this one.
+      /// \return The code.
+      public: std::uint32_t PackSmallestThree32() const
+      {
+        return static_cast<std::uint32_t>(this->PackSmallestThree(10));
+      }
+
+      /// \brief Decode a rotation encoded by PackSmallestThree32.
+      /// \param[in] _code The code.
+      /// \return The unit quaternion.
+      public: static Quaternion<T> UnpackSmallestThree32(
+                  const std::uint32_t _code)
+      {
+        return UnpackSmallestThree(_code, 10);
+      }
+
+      /// \brief Encode the rotation in the low 48 bits of an integer, as
+      /// PackSmallestThree32 does with 15 bits per component. The rotation
+      /// decoded by UnpackSmallestThree48 is within 1.5e-4 radians of this
+      /// one.
+      /// \return The code.
+      public: std::uint64_t PackSmallestThree48() const
+      {
+        return this->PackSmallestThree(15);
+      }
+
+      /// \brief Decode a rotation encoded by PackSmallestThree48.
+      /// \param[in] _code The code, only its low 48 bits are used.
+      /// \return The unit quaternion.
+      public: static Quaternion<T> UnpackSmallestThree48(
+                  const std::uint64_t _code)
+      {
+        return UnpackSmallestThree(_code, 15);
+      }
+
+      /// \brief Encode an array of rotations, see PackSmallestThree32().
+      /// \param[in] _in Pointer to the first rotation.
+      /// \param[out] _out Pointer to the first of _count codes.
+      /// \param[in] _count Number of rotations.
+      public: static void PackSmallestThree32(const Quaternion<T> *_in,
+                                              std::uint32_t *_out,
+                                              const std::size_t _count)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+          _out[i] = static_cast<std::uint32_t>(_in[i].PackSmallestThree(10));
+      }
+
+      /// \brief Decode an array of rotations, see UnpackSmallestThree32().
+      /// \param[in] _in Pointer to the first code.
+      /// \param[out] _out Pointer to the first of _count rotations.
+      /// \param[in] _count Number of codes.
+      public: static void UnpackSmallestThree32(const std::uint32_t *_in,
+                                                Quaternion<T> *_out,
+                                                const std::size_t _count)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+          _out[i] = UnpackSmallestThree(_in[i], 10);
+      }
+
+      /// \brief Encode an array of rotations, see PackSmallestThree48().
+      /// \param[in] _in Pointer to the first rotation.
+      /// \param[out] _out Pointer to the first of _count codes.
+      /// \param[in] _count Number of rotations.
+      public: static void PackSmallestThree48(const Quaternion<T> *_in,
+                                              std::uint64_t *_out,
+                                              const std::size_t _count)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+          _out[i] = _in[i].PackSmallestThree(15);
+      }
+
+      /// \brief Decode an array of rotations, see UnpackSmallestThree48().
+      /// \param[in] _in Pointer to the first code.
+      /// \param[out] _out Pointer to the first of _count rotations.
+      /// \param[in] _count Number of codes.
+      public: static void UnpackSmallestThree48(const std::uint64_t *_in,
+                                                Quaternion<T> *_out,
+                                                const std::size_t _count)
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+          _out[i] = UnpackSmallestThree(_in[i], 15);
+      }
+
       /// \brief Get the w component.
       /// \return The w quaternion component.
-      public: inline T W() const
+      public: constexpr T W() const
       {
         return this->qw;
       }
 
       /// \brief Get the x component.
       /// \return The x quaternion component.
-      public: inline T X() const
+      public: constexpr T X() const
       {
         return this->qx;
       }
 
       /// \brief Get the y component.
       /// \return The y quaternion component.
-      public: inline T Y() const
+      public: constexpr T Y() const
       {
         return this->qy;
       }
 
       /// \brief Get the z component.
       /// \return The z quaternion component.
-      public: inline T Z() const
+      public: constexpr T Z() const
       {
         return this->qz;
       }
 
       /// \brief Get a mutable w component.
       /// \return The w quaternion component.
-      public: inline T &W()
+      public: constexpr T &W()
       {
         return this->qw;
       }
 
       /// \brief Get a mutable x component.
       /// \return The x quaternion component.
-      public: inline T &X()
+      public: constexpr T &X()
       {
         return this->qx;
       }
 
       /// \brief Get a mutable y component.
       /// \return The y quaternion component.
-      public: inline T &Y()
+      public: constexpr T &Y()
       {
         return this->qy;
       }
 
       /// \brief Get a mutable z component.
       /// \return The z quaternion component.
-      public: inline T &Z()
+      public: constexpr T &Z()
       {
         return this->qz;
       }
@@ -1141,7 +1288,7 @@ namespace gz
 
       /// \brief Set the x component.
       /// \param[in] _v The new value for the x quaternion component.
-      public: inline void SetX(T _v)
+      public: constexpr void SetX(T _v)
       {
         this->qx = _v;
       }
@@ -1156,7 +1303,7 @@ namespace gz
 
       /// \brief Set the y component.
       /// \param[in] _v The new value for the y quaternion component.
-      public: inline void SetY(T _v)
+      public: constexpr void SetY(T _v)
       {
         this->qy = _v;
       }
@@ -1172,7 +1319,7 @@ namespace gz
 
       /// \brief Set the z component.
       /// \param[in] _v The new value for the z quaternion component.
-      public: inline void SetZ(T _v)
+      public: constexpr void SetZ(T _v)
       {
         this->qz = _v;
       }
@@ -1187,7 +1334,7 @@ namespace gz
 
       /// \brief Set the w component.
       /// \param[in] _v The new value for the w quaternion component.
-      public: inline void SetW(T _v)
+      public: constexpr void SetW(T _v)
       {
         this->qw = _v;
       }
@@ -1204,6 +1351,19 @@ namespace gz
         return _out;
       }
 
+      /// \brief Append the Euler angles of the quaternion to a string, in
+      /// the format of operator<< but with std::to_chars.
+      /// \param[in, out] _out The string
+      /// \param[in] _q Quaternion to append
+      /// \param[in] _precision Number of digits after the decimal point, or
+      /// a negative value for the shortest representation that reads back as
+      /// the same number
+      public: friend void appendToString(std::string &_out,
+                  const Quaternion<T> &_q, int _precision = -1)
+      {
+        appendToString(_out, _q.Euler(), _precision);
+      }
+
       /// \brief Stream extraction operator
       /// \param[in, out] _in input stream
       /// \param[out] _q Quaternion<T> to read values into
@@ -1240,6 +1400,90 @@ namespace gz
                equal(this->qw, _q.qw, _tol);
       }
 
+      /// \brief Encode the rotation with the smallest three method.
+      /// \param[in] _bits Number of bits of each of the three smallest
+      /// components, at most 20.
+      /// \return The index of the largest component in bits 3 * _bits and
+      /// 3 * _bits + 1, and the other components, from w to z, in the low
+      /// bits.
+      private: std::uint64_t PackSmallestThree(const unsigned int _bits) const
+      {
+        const T c[4] = {this->qw, this->qx, this->qy, this->qz};
+        unsigned int largest = 0;
+        T squared = c[0] * c[0];
+        T best = std::abs(c[0]);
+        for (unsigned int i = 1; i < 4; ++i)
+        {
+          squared += c[i] * c[i];
+          if (std::abs(c[i]) > best)
+          {
+            best = std::abs(c[i]);
+            largest = i;
+          }
+        }
+        if (!(squared > 0) || !std::isfinite(squared))
+          return PackedIdentity(_bits);
+
+        // Levels 0 to 2 * half, so that 0 is exact
+        const T half = static_cast<T>((1u << (_bits - 1)) - 1);
+        const T scale = static_cast<T>(GZ_SQRT2) * half /
+            static_cast<T>(std::sqrt(squared)) * (c[largest] < 0 ? -1 : 1);
+        std::uint64_t code = static_cast<std::uint64_t>(largest) <<
+            (3 * _bits);
+        unsigned int shift = 0;
+        for (unsigned int i = 0; i < 4; ++i)
+        {
+          if (i == largest)
+            continue;
+          const T v = std::min(std::max(c[i] * scale, -half), half);
+          code |= static_cast<std::uint64_t>(std::lround(v + half)) << shift;
+          shift += _bits;
+        }
+        return code;
+      }
+
+      /// \brief Code of the identity rotation.
+      /// \param[in] _bits Number of bits of each of the three smallest
+      /// components.
+      /// \return The code.
+      private: static std::uint64_t PackedIdentity(const unsigned int _bits)
+      {
+        const std::uint64_t half = (1u << (_bits - 1)) - 1;
+        return half | (half << _bits) | (half << (2 * _bits));
+      }
+
+      /// \brief Decode a rotation encoded by PackSmallestThree.
+      /// \param[in] _code The code.
+      /// \param[in] _bits Number of bits of each of the three smallest
+      /// components.
+      /// \return The unit quaternion.
+      private: static Quaternion<T> UnpackSmallestThree(
+                   const std::uint64_t _code, const unsigned int _bits)
+      {
+        const std::uint64_t mask = (std::uint64_t(1) << _bits) - 1;
+        const T half = static_cast<T>((1u << (_bits - 1)) - 1);
+        const T scale = T(1) / (half * static_cast<T>(GZ_SQRT2));
+        const unsigned int largest =
+            static_cast<unsigned int>((_code >> (3 * _bits)) & 3);
+
+        T c[4];
+        T squared = 0;
+        unsigned int shift = 0;
+        for (unsigned int i = 0; i < 4; ++i)
+        {
+          if (i == largest)
+            continue;
+          c[i] = (static_cast<T>((_code >> shift) & mask) - half) * scale;
+          squared += c[i] * c[i];
+          shift += _bits;
+        }
+        c[largest] = static_cast<T>(std::sqrt(std::max(T(0), 1 - squared)));
+
+        Quaternion<T> result(c[0], c[1], c[2], c[3]);
+        result.Normalize();
+        return result;
+      }
+
       /// \brief w value of the quaternion
       private: T qw;
 
@@ -0,0 +1,541 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_QUATERNIONARRAY_HH_
+#define GZ_MATH_QUATERNIONARRAY_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <gz/math/Angle.hh>
+#include <gz/math/Helpers.hh>
+#include <gz/math/Matrix3.hh>
+#include <gz/math/Quaternion.hh>
+#include <gz/math/Vector3Array.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class QuaternionArray QuaternionArray.hh gz/math/QuaternionArray.hh
+    /// \brief A structure-of-arrays container of quaternions.
+    ///
+    /// The w, x, y and z components of the stored quaternions are kept in
+    /// four separate contiguous buffers so that the batch operations below
+    /// run as simple loops the compiler can vectorize. Each batch operation
+    /// follows the semantics of the matching Quaternion function, element by
+    /// element. Operations that take a second array fail and return false if
+    /// the sizes of the arrays differ.
+    ///
+    /// \sa Vector3Array
+    template<typename T>
+    class QuaternionArray
+    {
+      /// \brief Default constructor, creates an empty array.
+      public: QuaternionArray() = default;
+
+      /// \brief Constructor, creates an array of identity quaternions.
+      /// \param[in] _size Number of quaternions.
+      public: explicit QuaternionArray(const std::size_t _size)
+      : w(_size, T(1)), x(_size, T(0)), y(_size, T(0)), z(_size, T(0))
+      {
+      }
+
+      /// \brief Constructor from an array of structures.
+      /// \param[in] _quaternions Quaternions to copy.
+      public: explicit QuaternionArray(
+                  const std::vector<Quaternion<T>> &_quaternions)
+      {
+        this->Assign(_quaternions.data(), _quaternions.size());
+      }
+
+      /// \brief Replace the contents of this array.
+      /// \param[in] _quaternions Pointer to the first quaternion to copy.
+      /// \param[in] _count Number of quaternions to copy.
+      public: void Assign(const Quaternion<T> *_quaternions,
+                          const std::size_t _count)
+      {
+        this->Resize(_count);
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          this->w[i] = _quaternions[i].W();
+          this->x[i] = _quaternions[i].X();
+          this->y[i] = _quaternions[i].Y();
+          this->z[i] = _quaternions[i].Z();
+        }
+      }
+
+      /// \brief Copy the contents of this array to an array of structures.
+      /// \param[out] _quaternions Destination buffer. It must hold at least
+      /// Size() quaternions.
+      public: void CopyTo(Quaternion<T> *_quaternions) const
+      {
+        for (std::size_t i = 0; i < this->Size(); ++i)
+          _quaternions[i].Set(this->w[i], this->x[i], this->y[i], this->z[i]);
+      }
+
+      /// \brief Get the contents of this array as an array of structures.
+      /// \return A vector of Quaternion.
+      public: std::vector<Quaternion<T>> ToVector() const
+      {
+        std::vector<Quaternion<T>> result(this->Size());
+        this->CopyTo(result.data());
+        return result;
+      }
+
+      /// \brief Get the number of quaternions.
+      /// \return The number of quaternions stored in this array.
+      public: std::size_t Size() const
+      {
+        return this->w.size();
+      }
+
+      /// \brief Change the number of quaternions. New quaternions are set to
+      /// identity.
+      /// \param[in] _size The new number of quaternions.
+      public: void Resize(const std::size_t _size)
+      {
+        this->w.resize(_size, T(1));
+        this->x.resize(_size, T(0));
+        this->y.resize(_size, T(0));
+        this->z.resize(_size, T(0));
+      }
+
+      /// \brief Append a quaternion to the end of the array.
+      /// \param[in] _q The quaternion to append.
+      public: void PushBack(const Quaternion<T> &_q)
+      {
+        this->w.push_back(_q.W());
+        this->x.push_back(_q.X());
+        this->y.push_back(_q.Y());
+        this->z.push_back(_q.Z());
+      }
+
+      /// \brief Get a quaternion. The index is not checked.
+      /// \param[in] _index Index of the quaternion.
+      /// \return A copy of the quaternion at _index.
+      public: Quaternion<T> operator[](const std::size_t _index) const
+      {
+        return Quaternion<T>(this->w[_index], this->x[_index],
+                             this->y[_index], this->z[_index]);
+      }
+
+      /// \brief Set a quaternion. The index is not checked.
+      /// \param[in] _index Index of the quaternion.
+      /// \param[in] _q The new value.
+      public: void Set(const std::size_t _index, const Quaternion<T> &_q)
+      {
+        this->w[_index] = _q.W();
+        this->x[_index] = _q.X();
+        this->y[_index] = _q.Y();
+        this->z[_index] = _q.Z();
+      }
+
+      /// \brief Normalize each quaternion. As in Quaternion::Normalize,
+      /// quaternions with a norm of zero (within 1e-6) become identity.
+      public: void Normalize()
+      {
+        const T tol = static_cast<T>(1e-6);
+        for (std::size_t i = 0; i < this->Size(); ++i)
+        {
+          const T s = static_cast<T>(std::sqrt(
+              this->w[i] * this->w[i] + this->x[i] * this->x[i] +
+              this->y[i] * this->y[i] + this->z[i] * this->z[i]));
+          const bool valid = s > tol;
+          const T inv = valid ? T(1) / s : T(0);
+          this->w[i] = valid ? this->w[i] * inv : T(1);
+          this->x[i] *= inv;
+          this->y[i] *= inv;
+          this->z[i] *= inv;
+        }
+      }
+
+      /// \brief Normalize each quaternion as Quaternion::NormalizeFast does,
+      /// with a relative error of the norms below 5e-6 for float and 4e-11
+      /// for double.
+      public: void NormalizeFast()
+      {
+        const T tol = static_cast<T>(1e-12);
+        T *ws = this->w.data();
+        T *xs = this->x.data();
+        T *ys = this->y.data();
+        T *zs = this->z.data();
+        for (std::size_t i = 0; i < this->Size(); ++i)
+        {
+          const T squared = ws[i] * ws[i] + xs[i] * xs[i] +
+              ys[i] * ys[i] + zs[i] * zs[i];
+          // 1 for the quaternions that become identity, 0 for the others
+          const T zero = static_cast<T>(squared <= tol);
+          const T inv = static_cast<T>(fastInverseSqrt(squared)) *
+              (T(1) - zero);
+          ws[i] = ws[i] * inv + zero;
+          xs[i] *= inv;
+          ys[i] *= inv;
+          zs[i] *= inv;
+        }
+      }
+
+      /// \brief Multiply each quaternion of this array by the matching
+      /// quaternion of another array: this[i] = this[i] * other[i].
+      /// \param[in] _other The right hand side quaternions.
+      /// \return False if the sizes of the arrays differ.
+      public: bool Multiply(const QuaternionArray<T> &_other)
+      {
+        if (_other.Size() != this->Size())
+          return false;
+        for (std::size_t i = 0; i < this->Size(); ++i)
+        {
+          const T aw = this->w[i], ax = this->x[i],
+                  ay = this->y[i], az = this->z[i];
+          const T bw = _other.w[i], bx = _other.x[i],
+                  by = _other.y[i], bz = _other.z[i];
+          this->w[i] = aw*bw - ax*bx - ay*by - az*bz;
+          this->x[i] = aw*bx + ax*bw + ay*bz - az*by;
+          this->y[i] = aw*by - ax*bz + ay*bw + az*bx;
+          this->z[i] = aw*bz + ax*by - ay*bx + az*bw;
+        }
+        return true;
+      }
+
+      /// \brief Spherical linear interpolation between the quaternions of
+      /// this array and the matching quaternions of another array, with a
+      /// separate interpolation parameter for each element. This follows
+      /// Quaternion::Slerp(_t[i], this[i], _to[i], _shortestPath).
+      /// \param[in] _t Interpolation parameters, one per quaternion.
+      /// \param[in] _to The quaternions to interpolate towards.
+      /// \param[out] _out The interpolated quaternions, resized to Size().
+      /// \param[in] _shortestPath When true, the rotation may be inverted
+      /// to take the shortest path.
+      /// \return False if the sizes of _t, _to and this array differ.
+      public: bool Slerp(const std::vector<T> &_t,
+                         const QuaternionArray<T> &_to,
+                         QuaternionArray<T> &_out,
+                         const bool _shortestPath = false) const
+      {
+        if (_to.Size() != this->Size() || _t.size() != this->Size())
+          return false;
+        _out.Resize(this->Size());
+        const T tol = static_cast<T>(1e-6);
+        for (std::size_t i = 0; i < this->Size(); ++i)
+        {
+          const T t = _t[i];
+          T fCos = this->w[i] * _to.w[i] + this->x[i] * _to.x[i] +
+                   this->y[i] * _to.y[i] + this->z[i] * _to.z[i];
+
+          // Invert the second rotation to take the shortest path
+          const T sign = (fCos < 0 && _shortestPath) ? T(-1) : T(1);
+          fCos *= sign;
+
+          T c0, c1;
+          const bool linear = !(std::abs(fCos) < 1 - 1e-03);
+          if (!linear)
+          {
+            const T fSin = static_cast<T>(std::sqrt(1 - fCos * fCos));
+            const T fAngle = static_cast<T>(std::atan2(fSin, fCos));
+            const T fInvSin = T(1) / fSin;
+            c0 = static_cast<T>(std::sin((1 - t) * fAngle)) * fInvSin;
+            c1 = static_cast<T>(std::sin(t * fAngle)) * fInvSin;
+          }
+          else
+          {
+            c0 = 1 - t;
+            c1 = t;
+          }
+          c1 *= sign;
+
+          T qw = this->w[i] * c0 + _to.w[i] * c1;
+          T qx = this->x[i] * c0 + _to.x[i] * c1;
+          T qy = this->y[i] * c0 + _to.y[i] * c1;
+          T qz = this->z[i] * c0 + _to.z[i] * c1;
+
+          // Linear interpolation requires renormalization
+          if (linear)
+          {
+            const T s = static_cast<T>(std::sqrt(
+                qw * qw + qx * qx + qy * qy + qz * qz));
+            if (s > tol)
+            {
+              qw /= s;
+              qx /= s;
+              qy /= s;
+              qz /= s;
+            }
+            else
+            {
+              qw = T(1);
+              qx = qy = qz = T(0);
+            }
+          }
+
+          _out.w[i] = qw;
+          _out.x[i] = qx;
+          _out.y[i] = qy;
+          _out.z[i] = qz;
+        }
+        return true;
+      }
+
+      /// \brief Rotate each vector of an array by the matching quaternion of
+      /// this array. This follows Quaternion::RotateVector and also handles
+      /// quaternions that are not normalized.
+      /// \param[in] _in The vectors to rotate.
+      /// \param[out] _out The rotated vectors, resized to Size(). It may be
+      /// the same object as _in.
+      /// \return False if the sizes of _in and this array differ.
+      public: bool RotateVector(const Vector3Array<T> &_in,
+                                Vector3Array<T> &_out) const
+      {
+        if (_in.Size() != this->Size())
+          return false;
+        _out.Resize(this->Size());
+        const T *vxIn = _in.X();
+        const T *vyIn = _in.Y();
+        const T *vzIn = _in.Z();
+        T *vxOut = _out.X();
+        T *vyOut = _out.Y();
+        T *vzOut = _out.Z();
+        const T tol = static_cast<T>(1e-6);
+        for (std::size_t i = 0; i < this->Size(); ++i)
+        {
+          const T qw = this->w[i], qx = this->x[i],
+                  qy = this->y[i], qz = this->z[i];
+          const T vx = vxIn[i], vy = vyIn[i], vz = vzIn[i];
+
+          // q * v * q^-1 = ((w^2 - u.u) v + 2 (u.v) u + 2 w (u x v)) / |q|^2
+          const T uu = qx * qx + qy * qy + qz * qz;
+          const T n2 = qw * qw + uu;
+          const T inv = n2 > tol ? T(1) / n2 : T(0);
+          const T a = (qw * qw - uu) * inv;
+          const T b = 2 * (qx * vx + qy * vy + qz * vz) * inv;
+          const T c = 2 * qw * inv;
+          vxOut[i] = a * vx + b * qx + c * (qy * vz - qz * vy);
+          vyOut[i] = a * vy + b * qy + c * (qz * vx - qx * vz);
+          vzOut[i] = a * vz + b * qz + c * (qx * vy - qy * vx);
+        }
+        return true;
+      }
+
+      /// \brief Set the quaternions from Euler angles, resizing this array
+      /// to the number of angles. This follows Quaternion::SetFromEuler,
+      /// with the sines and cosines of a block of angles computed together
+      /// by Angle::FastSinCos. The results match Quaternion::SetFromEuler
+      /// to about 1e-15 for angles up to Angle::kFastSinCosLimit.
+      /// \param[in] _euler Roll, pitch and yaw angles in radians.
+      public: void SetFromEuler(const Vector3Array<T> &_euler)
+      {
+        const std::size_t count = _euler.Size();
+        this->Resize(count);
+
+        // Sine and cosine of the half angles of a block of rotations, for
+        // roll, pitch and yaw in turn
+        constexpr std::size_t kBlock = 128;
+        double sines[3][kBlock];
+        double cosines[3][kBlock];
+        const T *angles[3] = {_euler.X(), _euler.Y(), _euler.Z()};
+        for (std::size_t start = 0; start < count; start += kBlock)
+        {
+          const std::size_t n = std::min(kBlock, count - start);
+          for (int a = 0; a < 3; ++a)
+          {
+            for (std::size_t i = 0; i < n; ++i)
+              sines[a][i] = static_cast<double>(angles[a][start + i] / T(2));
+            Angle::FastSinCos(sines[a], sines[a], cosines[a], n);
+          }
+
+          for (std::size_t i = 0; i < n; ++i)
+          {
+            const double sr = sines[0][i], cr = cosines[0][i];
+            const double sp = sines[1][i], cp = cosines[1][i];
+            const double sy = sines[2][i], cy = cosines[2][i];
+            const T qw = T(cr * cp * cy + sr * sp * sy);
+            const T qx = T(sr * cp * cy - cr * sp * sy);
+            const T qy = T(cr * sp * cy + sr * cp * sy);
+            const T qz = T(cr * cp * sy - sr * sp * cy);
+            this->SetNormalized(start + i, qw, qx, qy, qz);
+          }
+        }
+      }
+
+      /// \brief Get the Euler angles of each quaternion, as
+      /// Quaternion::Euler. Near gimbal lock, where the pitch is +-Pi/2 and
+      /// only the sum of roll and yaw is known, the yaw is 0 as in
+      /// Quaternion::Euler, but the choice is made with selects instead of
+      /// branches.
+      /// \param[out] _euler Roll, pitch and yaw angles in radians, resized
+      /// to Size().
+      public: void Euler(Vector3Array<T> &_euler) const
+      {
+        _euler.Resize(this->Size());
+        T *roll = _euler.X();
+        T *pitch = _euler.Y();
+        T *yaw = _euler.Z();
+        const T tol = static_cast<T>(1e-15);
+        for (std::size_t i = 0; i < this->Size(); ++i)
+        {
+          T qw, qx, qy, qz;
+          this->Normalized(i, qw, qx, qy, qz);
+          const T squ = qw * qw;
+          const T sqx = qx * qx;
+          const T sqy = qy * qy;
+          const T sqz = qz * qz;
+
+          const T sarg = -2 * (qx * qz - qw * qy);
+          pitch[i] = T(std::asin(clamp(sarg, T(-1), T(1))));
+
+          const bool up = std::abs(sarg - 1) < tol;
+          const bool lock = up || std::abs(sarg + 1) < tol;
+          const T rollY = lock ? (up ? 2 : -2) * (qx * qy - qz * qw) :
+                                 2 * (qy * qz + qw * qx);
+          const T rollX = lock ? squ - sqx + sqy - sqz :
+                                 squ - sqx - sqy + sqz;
+          const T yawValue = T(std::atan2(2 * (qx * qy + qw * qz),
+                                          squ + sqx - sqy - sqz));
+          roll[i] = T(std::atan2(rollY, rollX));
+          yaw[i] = lock ? T(0) : yawValue;
+        }
+      }
+
+      /// \brief Set the quaternions from rotation matrices, resizing this
+      /// array to _count. This follows Quaternion::SetFromMatrix, which
+      /// picks one of four formulas, but computes the inputs of all four
+      /// and selects among them, so the loop has no branches. The results
+      /// are the same as Quaternion::SetFromMatrix.
+      /// \param[in] _matrices Pointer to the first rotation matrix.
+      /// \param[in] _count Number of matrices.
+      public: void SetFromMatrix(const Matrix3<T> *_matrices,
+                                 const std::size_t _count)
+      {
+        this->Resize(_count);
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const Matrix3<T> &m = _matrices[i];
+          const T m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2);
+          const T m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2);
+          const T m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2);
+          const T trace = m00 + m11 + m22;
+
+          // The component with the largest magnitude: w, x, y or z
+          const int largest = trace > 0.0000001 ? 0 :
+              (m00 > m11 && m00 > m22) ? 1 : m11 > m22 ? 2 : 3;
+          const T d = largest == 0 ? T(1 + trace) :
+                      largest == 1 ? T(1.0 + m00 - m11 - m22) :
+                      largest == 2 ? T(1.0 - m00 + m11 - m22) :
+                                     T(1.0 - m00 - m11 + m22);
+          const T r = T(std::sqrt(d) / 2);
+          const T s = T(1.0 / (4 * r));
+
+          const T wx = (m21 - m12) * s;
+          const T wy = (m02 - m20) * s;
+          const T wz = (m10 - m01) * s;
+          const T xy = (m10 + m01) * s;
+          const T xz = (m02 + m20) * s;
+          const T yz = (m12 + m21) * s;
+          this->w[i] = largest == 0 ? r : largest == 1 ? wx :
+                       largest == 2 ? wy : wz;
+          this->x[i] = largest == 0 ? wx : largest == 1 ? r :
+                       largest == 2 ? xy : xz;
+          this->y[i] = largest == 0 ? wy : largest == 1 ? xy :
+                       largest == 2 ? r : yz;
+          this->z[i] = largest == 0 ? wz : largest == 1 ? xz :
+                       largest == 2 ? yz : r;
+        }
+      }
+
+      /// \brief Get the rotation matrix of each quaternion, as
+      /// Matrix3(const Quaternion<T> &), which normalizes the quaternion.
+      /// \param[out] _matrices Destination buffer. It must hold at least
+      /// Size() matrices.
+      public: void ToMatrix(Matrix3<T> *_matrices) const
+      {
+        for (std::size_t i = 0; i < this->Size(); ++i)
+        {
+          T qw, qx, qy, qz;
+          this->Normalized(i, qw, qx, qy, qz);
+          _matrices[i].Set(1 - 2 * qy * qy - 2 * qz * qz,
+                           2 * qx * qy - 2 * qz * qw,
+                           2 * qx * qz + 2 * qy * qw,
+                           2 * qx * qy + 2 * qz * qw,
+                           1 - 2 * qx * qx - 2 * qz * qz,
+                           2 * qy * qz - 2 * qx * qw,
+                           2 * qx * qz - 2 * qy * qw,
+                           2 * qy * qz + 2 * qx * qw,
+                           1 - 2 * qx * qx - 2 * qy * qy);
+        }
+      }
+
+      /// \brief Get a quaternion, normalized as in Quaternion::Normalize.
+      /// \param[in] _index Index of the quaternion.
+      /// \param[out] _w W component.
+      /// \param[out] _x X component.
+      /// \param[out] _y Y component.
+      /// \param[out] _z Z component.
+      private: void Normalized(const std::size_t _index,
+                               T &_w, T &_x, T &_y, T &_z) const
+      {
+        const T qw = this->w[_index], qx = this->x[_index],
+                qy = this->y[_index], qz = this->z[_index];
+        const T s = static_cast<T>(std::sqrt(
+            qw * qw + qx * qx + qy * qy + qz * qz));
+        const bool zero = s <= static_cast<T>(1e-6);
+        _w = zero ? T(1) : qw / s;
+        _x = zero ? T(0) : qx / s;
+        _y = zero ? T(0) : qy / s;
+        _z = zero ? T(0) : qz / s;
+      }
+
+      /// \brief Set a quaternion, normalized as in Quaternion::Normalize.
+      /// \param[in] _index Index of the quaternion.
+      /// \param[in] _w W component.
+      /// \param[in] _x X component.
+      /// \param[in] _y Y component.
+      /// \param[in] _z Z component.
+      private: void SetNormalized(const std::size_t _index,
+                                  T _w, T _x, T _y, T _z)
+      {
+        const T s = static_cast<T>(std::sqrt(
+            _w * _w + _x * _x + _y * _y + _z * _z));
+        const bool zero = s <= static_cast<T>(1e-6);
+        this->w[_index] = zero ? T(1) : _w / s;
+        this->x[_index] = zero ? T(0) : _x / s;
+        this->y[_index] = zero ? T(0) : _y / s;
+        this->z[_index] = zero ? T(0) : _z / s;
+      }
+
+      /// \brief The w components.
+      private: std::vector<T> w;
+
+      /// \brief The x components.
+      private: std::vector<T> x;
+
+      /// \brief The y components.
+      private: std::vector<T> y;
+
+      /// \brief The z components.
+      private: std::vector<T> z;
+    };
+
+    typedef QuaternionArray<double> QuaternionArrayd;
+    typedef QuaternionArray<float> QuaternionArrayf;
+    }
+  }
+}
+#endif
@@ -17,10 +17,14 @@
 #ifndef GZ_MATH_RAND_HH_
 #define GZ_MATH_RAND_HH_
 
+#include <algorithm>
 #include <random>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <utility>
 #include <gz/math/Helpers.hh>
+#include <gz/math/Philox.hh>
 #include <gz/math/config.hh>
 
 namespace gz
@@ -45,9 +49,22 @@ namespace gz
 
     /// \class Rand Rand.hh gz/math/Rand.hh
     /// \brief Random number generator class
+    ///
+    /// Each thread has its own generator, so threads can draw numbers
+    /// concurrently without locks. The generator of a thread is seeded with
+    /// the global seed and the stream id of the thread. Seed(unsigned int)
+    /// gives stream 0 to the calling thread, unless it chose another one,
+    /// so a thread that seeds Rand draws the same numbers as a single
+    /// generator seeded with the same seed. Other threads get stream ids
+    /// from 1 in the order they first use Rand, so set the stream id of
+    /// worker threads with Stream(unsigned int) for repeatable results. See
+    /// RandStream for generators that aren't tied to a thread.
     class GZ_MATH_VISIBLE Rand
     {
-      /// \brief Set the seed value.
+      /// \brief Set the seed value. The calling thread gets stream 0 if it
+      /// didn't call Stream(unsigned int), and its generator is reseeded
+      /// now, the generators of other threads before they draw their next
+      /// number.
       /// \param[in] _seed The seed used to initialize the randon number
       /// generator.
       public: static void Seed(unsigned int _seed);
@@ -57,6 +74,16 @@ namespace gz
       /// generator.
       public: static unsigned int Seed();
 
+      /// \brief Set the stream id of the calling thread, and reseed its
+      /// generator with the seed and this id. Seed(unsigned int) keeps it.
+      /// \param[in] _stream Stream id, different for each thread that
+      /// should draw different numbers.
+      public: static void Stream(unsigned int _stream);
+
+      /// \brief Get the stream id of the calling thread.
+      /// \return The stream id of the calling thread.
+      public: static unsigned int Stream();
+
       /// \brief Get a double from a uniform distribution
       /// \param[in] _min Minimum bound for the random number
       /// \param[in] _max Maximum bound for the random number
@@ -77,12 +104,107 @@ namespace gz
       /// \param[in] _sigma Sigma value for the distribution
       public: static int32_t IntNormal(int _mean, int _sigma);
 
-      /// \brief Get a mutable reference to the seed (create the static
-      /// member if it hasn't been created yet).
+      /// \brief Fill an array with doubles from a uniform distribution.
+      /// This is much faster than calling DblUniform for each number, but
+      /// draws a different sequence.
+      /// \param[out] _out Pointer to the first number.
+      /// \param[in] _count Number of numbers.
+      /// \param[in] _min Minimum bound for the random numbers
+      /// \param[in] _max Maximum bound for the random numbers
+      public: static void FillUniform(double *_out, size_t _count,
+                                      double _min = 0, double _max = 1);
+
+      /// \brief Fill an array with floats from a uniform distribution.
+      /// \param[out] _out Pointer to the first number.
+      /// \param[in] _count Number of numbers.
+      /// \param[in] _min Minimum bound for the random numbers
+      /// \param[in] _max Maximum bound for the random numbers
+      public: static void FillUniform(float *_out, size_t _count,
+                                      float _min = 0, float _max = 1);
+
+      /// \brief Fill an array with doubles from a normal distribution,
+      /// drawn with the ziggurat method. This is much faster than calling
+      /// DblNormal for each number, but draws a different sequence.
+      /// \param[out] _out Pointer to the first number.
+      /// \param[in] _count Number of numbers.
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      public: static void FillNormal(double *_out, size_t _count,
+                                     double _mean = 0, double _sigma = 1);
+
+      /// \brief Fill an array with floats from a normal distribution,
+      /// drawn with the ziggurat method.
+      /// \param[out] _out Pointer to the first number.
+      /// \param[in] _count Number of numbers.
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      public: static void FillNormal(float *_out, size_t _count,
+                                     float _mean = 0, float _sigma = 1);
+
+      /// \brief Get an integer in [0, _range) from a uniform distribution,
+      /// with Lemire's nearly divisionless method. This is faster than
+      /// IntUniform, but draws a different sequence.
+      /// \param[in] _range Number of possible integers, 0 for all the 2^32
+      /// values.
+      /// \return The random number.
+      public: static uint32_t Bounded(uint32_t _range);
+
+      /// \brief Fill an array with integers from a uniform distribution,
+      /// drawn as by Bounded. This is much faster than calling IntUniform
+      /// for each number, but draws a different sequence.
+      /// \param[out] _out Pointer to the first number.
+      /// \param[in] _count Number of numbers.
+      /// \param[in] _min Minimum bound for the random numbers, included
+      /// \param[in] _max Maximum bound for the random numbers, included,
+      /// not less than _min
+      public: static void FillIntUniform(int32_t *_out, size_t _count,
+                                         int32_t _min, int32_t _max);
+
+      /// \brief Shuffle an array, with the Fisher-Yates method. Each
+      /// permutation is equally likely. The swap positions are drawn in
+      /// chunks, two from a word when they fit.
+      /// \param[in,out] _data Pointer to the first element.
+      /// \param[in] _count Number of elements, less than 2^32.
+      public: template<typename T>
+              static void Shuffle(T *_data, size_t _count)
+      {
+        using std::swap;
+        uint32_t swaps[256];
+        for (size_t i = _count; i > 1;)
+        {
+          const size_t n = std::min<size_t>(256, i - 1);
+          ShuffleSwaps(i, swaps, n);
+          for (size_t j = 0; j < n; ++j)
+            swap(_data[i - 1 - j], _data[swaps[j]]);
+          i -= n;
+        }
+      }
+
+      /// \brief Pick integers in [0, _n) without replacement, such as the
+      /// indices of a random subset of a collection. Each subset is equally
+      /// likely. Small subsets are picked with Floyd's algorithm, in time
+      /// proportional to their size, large ones by scanning [0, _n).
+      /// \param[in] _n Number of integers to pick from.
+      /// \param[out] _out Pointer to the first picked integer. They are
+      /// sorted in increasing order, use Shuffle for a random order.
+      /// \param[in] _k Number of integers to pick, at most _n.
+      public: static void Sample(uint32_t _n, uint32_t *_out, size_t _k);
+
+      /// \brief Draw the swap positions of a chunk of Shuffle.
+      /// \param[in] _size Number of elements not shuffled yet.
+      /// \param[out] _swaps Position in [0, _size - i) to swap with the
+      /// element at _size - i - 1, for each i.
+      /// \param[in] _count Number of positions, less than _size.
+      private: static void ShuffleSwaps(size_t _size, uint32_t *_swaps,
+                                        size_t _count);
+
+      /// \brief Get a mutable reference to a copy of the seed. Kept for ABI
+      /// compatibility, writing to it doesn't change the seed.
+      /// \return A copy of the seed.
       private: static uint32_t &SeedMutable();
 
-      /// \brief Get a mutable reference to the random generator (create the
-      /// static member if it hasn't been created yet).
+      /// \brief Get a mutable reference to the random generator of the
+      /// calling thread, seeded with the current seed.
       private: static GeneratorType &RandGenerator();
     };
     }
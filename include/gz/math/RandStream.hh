@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_RANDSTREAM_HH_
+#define GZ_MATH_RANDSTREAM_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <gz/math/Export.hh>
+#include <gz/math/Rand.hh>
+#include <gz/math/config.hh>
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    /// \class RandStream RandStream.hh gz/math/RandStream.hh
+    /// \brief Random number generator owned by its user, such as a sensor
+    /// that adds noise to its measurements. Unlike Rand, the numbers don't
+    /// depend on which thread draws them or on other users, so each object
+    /// draws a repeatable sequence for a seed and stream id. A RandStream
+    /// must not be used by several threads at once.
+    ///
+    /// A stream with the id of a thread of Rand draws the same numbers as
+    /// that thread.
+    class GZ_MATH_VISIBLE RandStream
+    {
+      /// \brief Constructor, seeded with the global seed of Rand.
+      /// \param[in] _stream Stream id, different for each object that
+      /// should draw different numbers.
+      public: explicit RandStream(unsigned int _stream);
+
+      /// \brief Constructor
+      /// \param[in] _seed The seed.
+      /// \param[in] _stream Stream id, different for each object that
+      /// should draw different numbers.
+      public: RandStream(unsigned int _seed, unsigned int _stream);
+
+      /// \brief Restart the stream with a seed.
+      /// \param[in] _seed The seed.
+      public: void Seed(unsigned int _seed);
+
+      /// \brief Get the seed value.
+      /// \return The seed of the stream.
+      public: unsigned int Seed() const;
+
+      /// \brief Get the stream id.
+      /// \return The stream id.
+      public: unsigned int Stream() const;
+
+      /// \brief Get a double from a uniform distribution
+      /// \param[in] _min Minimum bound for the random number
+      /// \param[in] _max Maximum bound for the random number
+      /// \return The random number.
+      public: double DblUniform(double _min = 0, double _max = 1);
+
+      /// \brief Get a double from a normal distribution
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      /// \return The random number.
+      public: double DblNormal(double _mean = 0, double _sigma = 1);
+
+      /// \brief Get an integer from a uniform distribution
+      /// \param[in] _min Minimum bound for the random number
+      /// \param[in] _max Maximum bound for the random number
+      /// \return The random number.
+      public: int32_t IntUniform(int _min, int _max);
+
+      /// \brief Get an integer from a normal distribution
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      /// \return The random number.
+      public: int32_t IntNormal(int _mean, int _sigma);
+
+      /// \brief Fill an array with doubles from a uniform distribution.
+      /// This is much faster than calling DblUniform for each number, but
+      /// draws a different sequence.
+      /// \param[out] _out Pointer to the first number.
+      /// \param[in] _count Number of numbers.
+      /// \param[in] _min Minimum bound for the random numbers
+      /// \param[in] _max Maximum bound for the random numbers
+      public: void FillUniform(double *_out, size_t _count,
+                               double _min = 0, double _max = 1);
+
+      /// \brief Fill an array with floats from a uniform distribution.
+      /// \param[out] _out Pointer to the first number.
+      /// \param[in] _count Number of numbers.
+      /// \param[in] _min Minimum bound for the random numbers
+      /// \param[in] _max Maximum bound for the random numbers
+      public: void FillUniform(float *_out, size_t _count,
+                               float _min = 0, float _max = 1);
+
+      /// \brief Fill an array with doubles from a normal distribution,
+      /// drawn with the ziggurat method. This is much faster than calling
+      /// DblNormal for each number, but draws a different sequence.
+      /// \param[out] _out Pointer to the first number.
+      /// \param[in] _count Number of numbers.
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      public: void FillNormal(double *_out, size_t _count,
+                              double _mean = 0, double _sigma = 1);
+
+      /// \brief Fill an array with floats from a normal distribution,
+      /// drawn with the ziggurat method.
+      /// \param[out] _out Pointer to the first number.
+      /// \param[in] _count Number of numbers.
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      public: void FillNormal(float *_out, size_t _count,
+                              float _mean = 0, float _sigma = 1);
+
+      /// \brief Get an integer in [0, _range) from a uniform distribution,
+      /// as drawn by Rand::Bounded.
+      /// \param[in] _range Number of possible integers, 0 for all the 2^32
+      /// values.
+      /// \return The random number.
+      public: uint32_t Bounded(uint32_t _range);
+
+      /// \brief Fill an array with integers from a uniform distribution,
+      /// as drawn by Rand::FillIntUniform.
+      /// \param[out] _out Pointer to the first number.
+      /// \param[in] _count Number of numbers.
+      /// \param[in] _min Minimum bound for the random numbers, included
+      /// \param[in] _max Maximum bound for the random numbers, included,
+      /// not less than _min
+      public: void FillIntUniform(int32_t *_out, size_t _count,
+                                  int32_t _min, int32_t _max);
+
+      /// \brief Shuffle an array, as Rand::Shuffle.
+      /// \param[in,out] _data Pointer to the first element.
+      /// \param[in] _count Number of elements, less than 2^32.
+      public: template<typename T>
+              void Shuffle(T *_data, size_t _count)
+      {
+        using std::swap;
+        uint32_t swaps[256];
+        for (size_t i = _count; i > 1;)
+        {
+          const size_t n = std::min<size_t>(256, i - 1);
+          this->ShuffleSwaps(i, swaps, n);
+          for (size_t j = 0; j < n; ++j)
+            swap(_data[i - 1 - j], _data[swaps[j]]);
+          i -= n;
+        }
+      }
+
+      /// \brief Pick integers in [0, _n) without replacement, as
+      /// Rand::Sample.
+      /// \param[in] _n Number of integers to pick from.
+      /// \param[out] _out Pointer to the first picked integer, sorted in
+      /// increasing order.
+      /// \param[in] _k Number of integers to pick, at most _n.
+      public: void Sample(uint32_t _n, uint32_t *_out, size_t _k);
+
+      /// \brief Get the generator, to draw from other distributions.
+      /// \return The generator of the stream.
+      public: GeneratorType &Generator();
+
+      /// \brief Draw the swap positions of a chunk of Shuffle.
+      /// \param[in] _size Number of elements not shuffled yet.
+      /// \param[out] _swaps Position in [0, _size - i) to swap with the
+      /// element at _size - i - 1, for each i.
+      /// \param[in] _count Number of positions, less than _size.
+      private: void ShuffleSwaps(size_t _size, uint32_t *_swaps,
+                                 size_t _count);
+
+      /// \brief Pointer to private data.
+      GZ_UTILS_IMPL_PTR(dataPtr)
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,385 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_RAYPACKET_HH_
+#define GZ_MATH_RAYPACKET_HH_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <gz/math/AxisAlignedBoxT.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class RayPacket RayPacket.hh gz/math/RayPacket.hh
+    /// \brief A structure-of-arrays container of rays for testing many rays
+    /// against axis aligned boxes, such as the beams of a lidar scan.
+    ///
+    /// Each ray is stored as its origin, the inverse of its normalized
+    /// direction, the sign of each direction component and the range of
+    /// distances along the ray, every component in its own contiguous
+    /// buffer. The inverse direction is computed once when the ray is set,
+    /// so the slab tests only multiply, and they are written as branch
+    /// free loops that the compiler turns into SIMD code for the target
+    /// architecture.
+    ///
+    /// A ray hits a box if the part of the ray between its minimum and
+    /// maximum distance touches the box, boundary included. The entry
+    /// distance is measured from the origin of the ray, and is the minimum
+    /// distance if that point is already inside the box. Unlike
+    /// AxisAlignedBox::IntersectDist, it is not offset by the minimum
+    /// distance.
+    ///
+    /// # Example
+    ///
+    /// \code{.cpp}
+    /// gz::math::RayPacketd rays;
+    /// rays.Assign(origins.data(), directions.data(), origins.size(),
+    ///             0.1, 100.0);
+    /// std::vector<std::uint8_t> hits(rays.Size());
+    /// std::vector<double> distances(rays.Size());
+    /// rays.Intersect(box, hits.data(), distances.data());
+    /// \endcode
+    /// \tparam T A floating point type.
+    template<typename T>
+    class RayPacket
+    {
+      static_assert(std::is_floating_point_v<T>,
+          "RayPacket requires a floating point type");
+
+      /// \brief Bit of Signs() set when the X direction is negative.
+      public: static constexpr std::uint8_t kNegativeX = 1;
+
+      /// \brief Bit of Signs() set when the Y direction is negative.
+      public: static constexpr std::uint8_t kNegativeY = 2;
+
+      /// \brief Bit of Signs() set when the Z direction is negative.
+      public: static constexpr std::uint8_t kNegativeZ = 4;
+
+      /// \brief Default constructor, creates an empty packet.
+      public: RayPacket() = default;
+
+      /// \brief Replace the contents of this packet with rays sharing the
+      /// same range of distances.
+      /// \param[in] _origins Origin of each ray.
+      /// \param[in] _dirs Direction of each ray. It is normalized.
+      /// \param[in] _count Number of rays.
+      /// \param[in] _min Minimum distance along each ray.
+      /// \param[in] _max Maximum distance along each ray.
+      public: void Assign(const Vector3<T> *_origins, const Vector3<T> *_dirs,
+                  const std::size_t _count, const T _min, const T _max)
+      {
+        this->Resize(_count);
+        for (std::size_t i = 0; i < _count; ++i)
+          this->SetRay(i, _origins[i], _dirs[i], _min, _max);
+      }
+
+      /// \brief Add a ray at the end of this packet.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. It is normalized.
+      /// \param[in] _min Minimum distance along the ray.
+      /// \param[in] _max Maximum distance along the ray.
+      public: void Add(const Vector3<T> &_origin, const Vector3<T> &_dir,
+                  const T _min, const T _max)
+      {
+        for (std::vector<T> *buffer : {&this->ox, &this->oy, &this->oz,
+                                       &this->ix, &this->iy, &this->iz,
+                                       &this->tMin, &this->tMax})
+        {
+          buffer->push_back(0);
+        }
+        this->signs.push_back(0);
+        this->SetRay(this->Size() - 1, _origin, _dir, _min, _max);
+      }
+
+      /// \brief Replace a ray of this packet.
+      /// \param[in] _index Index of the ray. It is not checked.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. It is normalized.
+      /// \param[in] _min Minimum distance along the ray.
+      /// \param[in] _max Maximum distance along the ray.
+      public: void SetRay(const std::size_t _index, const Vector3<T> &_origin,
+                  const Vector3<T> &_dir, const T _min, const T _max)
+      {
+        const Vector3<T> dir = _dir.Normalized();
+        std::uint8_t mask = 0;
+        T inv[3];
+        for (int a = 0; a < 3; ++a)
+        {
+          // A zero component gives +inf, whatever the sign of the zero, so
+          // that the sign bits agree with the inverse direction
+          inv[a] = std::fpclassify(dir[a]) == FP_ZERO ?
+              std::numeric_limits<T>::infinity() : 1 / dir[a];
+          if (inv[a] < 0)
+            mask |= static_cast<std::uint8_t>(1 << a);
+        }
+        this->ox[_index] = _origin.X();
+        this->oy[_index] = _origin.Y();
+        this->oz[_index] = _origin.Z();
+        this->ix[_index] = inv[0];
+        this->iy[_index] = inv[1];
+        this->iz[_index] = inv[2];
+        this->tMin[_index] = _min;
+        this->tMax[_index] = _max;
+        this->signs[_index] = mask;
+      }
+
+      /// \brief Remove all rays.
+      public: void Clear()
+      {
+        this->Resize(0);
+      }
+
+      /// \brief Get the number of rays.
+      /// \return The number of rays stored in this packet.
+      public: std::size_t Size() const
+      {
+        return this->ox.size();
+      }
+
+      /// \brief Check whether the packet is empty.
+      /// \return True if the packet holds no ray.
+      public: bool Empty() const
+      {
+        return this->ox.empty();
+      }
+
+      /// \brief Get the origin of a ray.
+      /// \param[in] _index Index of the ray. It is not checked.
+      /// \return The origin.
+      public: Vector3<T> Origin(const std::size_t _index) const
+      {
+        return Vector3<T>(this->ox[_index], this->oy[_index],
+                          this->oz[_index]);
+      }
+
+      /// \brief Get the inverse of the normalized direction of a ray. Zero
+      /// direction components give positive infinity.
+      /// \param[in] _index Index of the ray. It is not checked.
+      /// \return The inverse direction.
+      public: Vector3<T> InverseDirection(const std::size_t _index) const
+      {
+        return Vector3<T>(this->ix[_index], this->iy[_index],
+                          this->iz[_index]);
+      }
+
+      /// \brief Get the sign mask of a ray, made of kNegativeX, kNegativeY
+      /// and kNegativeZ. It tells which box corner is entered first on each
+      /// axis, and which child of a split is closer to the origin.
+      /// \param[in] _index Index of the ray. It is not checked.
+      /// \return The sign mask.
+      public: std::uint8_t Signs(const std::size_t _index) const
+      {
+        return this->signs[_index];
+      }
+
+      /// \brief Get the minimum distance along a ray.
+      /// \param[in] _index Index of the ray. It is not checked.
+      /// \return The minimum distance.
+      public: T Min(const std::size_t _index) const
+      {
+        return this->tMin[_index];
+      }
+
+      /// \brief Get the maximum distance along a ray.
+      /// \param[in] _index Index of the ray. It is not checked.
+      /// \return The maximum distance.
+      public: T Max(const std::size_t _index) const
+      {
+        return this->tMax[_index];
+      }
+
+      /// \brief Test every ray of this packet against a box.
+      /// \param[in] _box The box.
+      /// \param[out] _hits 1 for each ray that hits the box, 0 otherwise.
+      /// \param[out] _distances Entry distance of each ray, zero for rays
+      /// that miss. It may be null.
+      /// \return Number of rays that hit the box.
+      public: std::size_t Intersect(const AxisAlignedBoxT<T> &_box,
+                  std::uint8_t *_hits, T *_distances = nullptr) const
+      {
+        if (_distances)
+          return this->IntersectRays<true>(_box, _hits, _distances);
+        return this->IntersectRays<false>(_box, _hits, nullptr);
+      }
+
+      /// \brief Test one ray of this packet against an array of boxes.
+      /// \param[in] _ray Index of the ray. It is not checked.
+      /// \param[in] _boxes The boxes.
+      /// \param[in] _count Number of boxes.
+      /// \param[out] _hits 1 for each box hit by the ray, 0 otherwise.
+      /// \param[out] _distances Entry distance of the ray into each box,
+      /// zero for boxes that are missed. It may be null.
+      /// \return Number of boxes hit by the ray.
+      public: std::size_t Intersect(const std::size_t _ray,
+                  const AxisAlignedBoxT<T> *_boxes, const std::size_t _count,
+                  std::uint8_t *_hits, T *_distances = nullptr) const
+      {
+        if (_distances)
+        {
+          return this->IntersectBoxes<true>(_ray, _boxes, _count, _hits,
+                                            _distances);
+        }
+        return this->IntersectBoxes<false>(_ray, _boxes, _count, _hits,
+                                           nullptr);
+      }
+
+      /// \brief Test every ray against a box, see Intersect.
+      /// \tparam kDistances Whether to write the entry distances.
+      private: template<bool kDistances>
+      std::size_t IntersectRays(const AxisAlignedBoxT<T> &_box,
+                                std::uint8_t *_hits, T *_distances) const
+      {
+        const T minX = _box.Min().X(), minY = _box.Min().Y();
+        const T minZ = _box.Min().Z(), maxX = _box.Max().X();
+        const T maxY = _box.Max().Y(), maxZ = _box.Max().Z();
+        const T *oX = this->ox.data(), *oY = this->oy.data();
+        const T *oZ = this->oz.data(), *iX = this->ix.data();
+        const T *iY = this->iy.data(), *iZ = this->iz.data();
+        const T *lo = this->tMin.data(), *hi = this->tMax.data();
+
+        std::size_t count = 0;
+        const std::size_t n = this->Size();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          T near = lo[i];
+          T far = hi[i];
+          Slab(minX, maxX, oX[i], iX[i], near, far);
+          Slab(minY, maxY, oY[i], iY[i], near, far);
+          Slab(minZ, maxZ, oZ[i], iZ[i], near, far);
+          const bool hit = near <= far;
+          _hits[i] = static_cast<std::uint8_t>(hit);
+          if constexpr (kDistances)
+            _distances[i] = hit ? near : T(0);
+          count += hit;
+        }
+        return count;
+      }
+
+      /// \brief Test one ray against an array of boxes, see Intersect.
+      /// \tparam kDistances Whether to write the entry distances.
+      private: template<bool kDistances>
+      std::size_t IntersectBoxes(const std::size_t _ray,
+                                 const AxisAlignedBoxT<T> *_boxes,
+                                 const std::size_t _count,
+                                 std::uint8_t *_hits, T *_distances) const
+      {
+        const T oX = this->ox[_ray], oY = this->oy[_ray];
+        const T oZ = this->oz[_ray], iX = this->ix[_ray];
+        const T iY = this->iy[_ray], iZ = this->iz[_ray];
+        const T lo = this->tMin[_ray], hi = this->tMax[_ray];
+
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const Vector3<T> &boxMin = _boxes[i].Min();
+          const Vector3<T> &boxMax = _boxes[i].Max();
+          T near = lo;
+          T far = hi;
+          Slab(boxMin.X(), boxMax.X(), oX, iX, near, far);
+          Slab(boxMin.Y(), boxMax.Y(), oY, iY, near, far);
+          Slab(boxMin.Z(), boxMax.Z(), oZ, iZ, near, far);
+          const bool hit = near <= far;
+          _hits[i] = static_cast<std::uint8_t>(hit);
+          if constexpr (kDistances)
+            _distances[i] = hit ? near : T(0);
+          count += hit;
+        }
+        return count;
+      }
+
+      /// \brief Clip the range of a ray to the slab of a box along one
+      /// axis. The near bound is the plane the ray enters, chosen by the
+      /// sign of the inverse direction. A ray parallel to a slab plane and
+      /// lying in it gives a NaN, which leaves the range unchanged so the
+      /// boundary counts as inside.
+      /// \param[in] _lo Lower bound of the box along the axis.
+      /// \param[in] _hi Upper bound of the box along the axis.
+      /// \param[in] _origin Origin of the ray along the axis.
+      /// \param[in] _inv Inverse direction of the ray along the axis.
+      /// \param[in,out] _near Distance where the ray enters the box.
+      /// \param[in,out] _far Distance where the ray leaves the box.
+      private: static void Slab(const T _lo, const T _hi, const T _origin,
+                   const T _inv, T &_near, T &_far)
+      {
+        // Both planes are computed before the selection so the loops stay
+        // free of branches that the vectorizer cannot convert
+        const T tLo = (_lo - _origin) * _inv;
+        const T tHi = (_hi - _origin) * _inv;
+        const T t1 = _inv < 0 ? tHi : tLo;
+        const T t2 = _inv < 0 ? tLo : tHi;
+        _near = t1 > _near ? t1 : _near;
+        _far = t2 < _far ? t2 : _far;
+      }
+
+      /// \brief Resize every buffer.
+      /// \param[in] _count New number of rays.
+      private: void Resize(const std::size_t _count)
+      {
+        for (std::vector<T> *buffer : {&this->ox, &this->oy, &this->oz,
+                                       &this->ix, &this->iy, &this->iz,
+                                       &this->tMin, &this->tMax})
+        {
+          buffer->resize(_count);
+        }
+        this->signs.resize(_count);
+      }
+
+      /// \brief X coordinates of the origins.
+      private: std::vector<T> ox;
+
+      /// \brief Y coordinates of the origins.
+      private: std::vector<T> oy;
+
+      /// \brief Z coordinates of the origins.
+      private: std::vector<T> oz;
+
+      /// \brief X components of the inverse directions.
+      private: std::vector<T> ix;
+
+      /// \brief Y components of the inverse directions.
+      private: std::vector<T> iy;
+
+      /// \brief Z components of the inverse directions.
+      private: std::vector<T> iz;
+
+      /// \brief Minimum distances along the rays.
+      private: std::vector<T> tMin;
+
+      /// \brief Maximum distances along the rays.
+      private: std::vector<T> tMax;
+
+      /// \brief Sign masks of the directions.
+      private: std::vector<std::uint8_t> signs;
+    };
+
+    using RayPacketd = RayPacket<double>;
+    using RayPacketf = RayPacket<float>;
+    }
+  }
+}
+#endif
@@ -0,0 +1,358 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_REGION3ARRAY_HH_
+#define GZ_MATH_REGION3ARRAY_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <gz/math/Interval.hh>
+#include <gz/math/Region3.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class Region3Array Region3Array.hh gz/math/Region3Array.hh
+    /// \brief A container of regions for testing many points against many
+    /// regions, such as geofences or the volumes a sensor filters its
+    /// points with.
+    ///
+    /// Each region is stored as its closed bounds (see
+    /// Region3::ClosedBounds), with every bound in its own contiguous
+    /// buffer, so that whether the bounds are open or closed isn't checked
+    /// for every point. For the batch queries, the bounds along each axis
+    /// are also sorted into edges, between which the same regions contain
+    /// the coordinate, with the bitmask of those regions. The mask of a
+    /// point is then the AND of the masks of its coordinates, found with
+    /// three branch free binary searches, however many regions there are.
+    ///
+    /// The mask of a point has MaskWords() 64 bit words: region r is bit
+    /// r % 64 of word r / 64.
+    ///
+    /// # Example
+    ///
+    /// \code{.cpp}
+    /// gz::math::Region3Arrayd fences(regions);
+    /// std::vector<std::uint64_t> masks(points.size() * fences.MaskWords());
+    /// fences.Contains(points.data(), points.size(), masks.data());
+    /// \endcode
+    template<typename T>
+    class Region3Array
+    {
+      /// \brief Default constructor, creates an empty array.
+      public: Region3Array() = default;
+
+      /// \brief Constructor from regions.
+      /// \param[in] _regions Regions to copy.
+      public: explicit Region3Array(const std::vector<Region3<T>> &_regions)
+      {
+        this->Assign(_regions.data(), _regions.size());
+      }
+
+      /// \brief Replace the contents of this array.
+      /// \param[in] _regions Pointer to the first region to copy.
+      /// \param[in] _count Number of regions to copy.
+      public: void Assign(const Region3<T> *_regions,
+                          const std::size_t _count)
+      {
+        for (std::vector<T> *buffer : {&this->xMin, &this->yMin, &this->zMin,
+                                       &this->xMax, &this->yMax, &this->zMax})
+        {
+          buffer->resize(_count);
+        }
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const auto [min, max] = _regions[i].ClosedBounds();
+          this->xMin[i] = min.X();
+          this->yMin[i] = min.Y();
+          this->zMin[i] = min.Z();
+          this->xMax[i] = max.X();
+          this->yMax[i] = max.Y();
+          this->zMax[i] = max.Z();
+        }
+
+        // A region that is empty along one axis is left out of the masks
+        // of every axis
+        std::vector<bool> empty(_count);
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          empty[i] = !(this->xMin[i] <= this->xMax[i]) ||
+                     !(this->yMin[i] <= this->yMax[i]) ||
+                     !(this->zMin[i] <= this->zMax[i]);
+        }
+        this->BuildAxis(this->xMin, this->xMax, empty, this->xAxis);
+        this->BuildAxis(this->yMin, this->yMax, empty, this->yAxis);
+        this->BuildAxis(this->zMin, this->zMax, empty, this->zAxis);
+      }
+
+      /// \brief Get the number of regions.
+      /// \return The number of regions stored in this array.
+      public: std::size_t Size() const
+      {
+        return this->xMin.size();
+      }
+
+      /// \brief Check whether the array is empty.
+      /// \return True if the array holds no region.
+      public: bool Empty() const
+      {
+        return this->xMin.empty();
+      }
+
+      /// \brief Get the number of 64 bit words of the mask of a point.
+      /// \return The number of words, at least 1.
+      public: std::size_t MaskWords() const
+      {
+        return std::max<std::size_t>(1, (this->Size() + 63) / 64);
+      }
+
+      /// \brief Get a region, as the closed region holding the same points
+      /// as the region it was assigned from.
+      /// \param[in] _index Index of the region. It is not checked.
+      /// \return The region.
+      public: Region3<T> Region(const std::size_t _index) const
+      {
+        return Region3<T>(
+            Interval<T>::Closed(this->xMin[_index], this->xMax[_index]),
+            Interval<T>::Closed(this->yMin[_index], this->yMax[_index]),
+            Interval<T>::Closed(this->zMin[_index], this->zMax[_index]));
+      }
+
+      /// \brief Check if a region contains a point.
+      /// \param[in] _index Index of the region. It is not checked.
+      /// \param[in] _point Point to check for membership.
+      /// \return True if the region contains the point.
+      public: bool Contains(const std::size_t _index,
+                            const Vector3<T> &_point) const
+      {
+        return (this->xMin[_index] <= _point.X()) &
+               (_point.X() <= this->xMax[_index]) &
+               (this->yMin[_index] <= _point.Y()) &
+               (_point.Y() <= this->yMax[_index]) &
+               (this->zMin[_index] <= _point.Z()) &
+               (_point.Z() <= this->zMax[_index]);
+      }
+
+      /// \brief Find the regions that contain each point of an array.
+      /// \param[in] _points Points to check for membership.
+      /// \param[in] _count Number of points.
+      /// \param[out] _masks Bitmasks of the regions that contain each
+      /// point, _count * MaskWords() words: the mask of point i starts at
+      /// word i * MaskWords().
+      public: void Contains(const Vector3<T> *_points,
+                            const std::size_t _count,
+                            std::uint64_t *_masks) const
+      {
+        const std::size_t words = this->MaskWords();
+        if (this->Empty())
+        {
+          std::fill(_masks, _masks + _count * words, 0);
+          return;
+        }
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const std::uint64_t *x = this->xAxis.Mask(_points[i].X(), words);
+          const std::uint64_t *y = this->yAxis.Mask(_points[i].Y(), words);
+          const std::uint64_t *z = this->zAxis.Mask(_points[i].Z(), words);
+          for (std::size_t w = 0; w < words; ++w)
+            _masks[i * words + w] = x[w] & y[w] & z[w];
+        }
+      }
+
+      /// \brief Check which points of an array are in at least one region.
+      /// \param[in] _points Points to check for membership.
+      /// \param[in] _count Number of points.
+      /// \param[out] _result Whether each point is in a region.
+      public: void ContainsAny(const Vector3<T> *_points,
+                               const std::size_t _count,
+                               bool *_result) const
+      {
+        const std::size_t words = this->MaskWords();
+        if (this->Empty())
+        {
+          std::fill(_result, _result + _count, false);
+          return;
+        }
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          const std::uint64_t *x = this->xAxis.Mask(_points[i].X(), words);
+          const std::uint64_t *y = this->yAxis.Mask(_points[i].Y(), words);
+          const std::uint64_t *z = this->zAxis.Mask(_points[i].Z(), words);
+          std::uint64_t any = 0;
+          for (std::size_t w = 0; w < words; ++w)
+            any |= x[w] & y[w] & z[w];
+          _result[i] = any != 0;
+        }
+      }
+
+      /// \brief The edges of the regions along an axis, and the regions
+      /// that contain the values between them.
+      private: struct Axis
+      {
+        /// \brief Get the mask of the regions that contain a value along
+        /// this axis.
+        /// \param[in] _value The value.
+        /// \param[in] _words Number of words of a mask.
+        /// \return Pointer to the first word of the mask.
+        const std::uint64_t *Mask(const T _value,
+                                  const std::size_t _words) const
+        {
+          // Number of edges <= _value, by a binary search whose only
+          // branch is the loop, which runs the same number of times for
+          // every value. NaN is before every edge, where no region is.
+          const T *first = this->edges.data();
+          std::size_t n = this->edges.size();
+          while (n > 1)
+          {
+            const std::size_t half = n / 2;
+            first = first[half] <= _value ? first + half : first;
+            n -= half;
+          }
+          const std::size_t bin =
+              static_cast<std::size_t>(first - this->edges.data()) +
+              (*first <= _value ? 1 : 0);
+          return this->masks.data() + bin * _words;
+        }
+
+        /// \brief Sorted values where the regions that contain a value
+        /// change: the lower bounds, and the values right after the upper
+        /// bounds.
+        std::vector<T> edges;
+
+        /// \brief Masks of the regions that contain the values before the
+        /// first edge, between each edge and the next, and after the last
+        /// edge.
+        std::vector<std::uint64_t> masks;
+      };
+
+      /// \brief Get the value right after an upper bound.
+      /// \param[in] _max The upper bound.
+      /// \param[out] _end The value right after it.
+      /// \return False if there is none, when _max is the largest value.
+      private: static bool End(const T _max, T &_end)
+      {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+          if (std::isinf(_max) && _max > 0)
+            return false;
+          _end = std::nextafter(_max, std::numeric_limits<T>::infinity());
+        }
+        else
+        {
+          if (_max == std::numeric_limits<T>::max())
+            return false;
+          _end = static_cast<T>(_max + 1);
+        }
+        return true;
+      }
+
+      /// \brief Sort the bounds of the regions along an axis into edges,
+      /// and find the regions between them.
+      /// \param[in] _min Lower bounds of the regions.
+      /// \param[in] _max Upper bounds of the regions.
+      /// \param[in] _empty Whether each region is empty.
+      /// \param[out] _axis The edges and masks.
+      private: void BuildAxis(const std::vector<T> &_min,
+                              const std::vector<T> &_max,
+                              const std::vector<bool> &_empty,
+                              Axis &_axis) const
+      {
+        _axis.edges.clear();
+        for (std::size_t r = 0; r < _min.size(); ++r)
+        {
+          if (_empty[r])
+            continue;
+          _axis.edges.push_back(_min[r]);
+          T end;
+          if (End(_max[r], end))
+            _axis.edges.push_back(end);
+        }
+        std::sort(_axis.edges.begin(), _axis.edges.end());
+        _axis.edges.erase(std::unique(_axis.edges.begin(), _axis.edges.end()),
+                          _axis.edges.end());
+        // The search reads the first edge, which must then exist
+        if (_axis.edges.empty())
+          _axis.edges.push_back(std::numeric_limits<T>::max());
+
+        // Bin b holds the values with b edges <= them
+        const std::size_t words = this->MaskWords();
+        const std::size_t bins = _axis.edges.size() + 1;
+        _axis.masks.assign(bins * words, 0);
+        const auto edge = [&_axis](const T _value)
+        {
+          return static_cast<std::size_t>(std::lower_bound(
+              _axis.edges.begin(), _axis.edges.end(), _value) -
+              _axis.edges.begin());
+        };
+        for (std::size_t r = 0; r < _min.size(); ++r)
+        {
+          if (_empty[r])
+            continue;
+          const std::size_t first = edge(_min[r]) + 1;
+          T end;
+          const std::size_t last = End(_max[r], end) ? edge(end) + 1 : bins;
+          const std::uint64_t bit = std::uint64_t{1} << (r % 64);
+          for (std::size_t b = first; b < last; ++b)
+            _axis.masks[b * words + r / 64] |= bit;
+        }
+      }
+
+      /// \brief Closed lower bound of the regions along x.
+      private: std::vector<T> xMin;
+
+      /// \brief Closed lower bound of the regions along y.
+      private: std::vector<T> yMin;
+
+      /// \brief Closed lower bound of the regions along z.
+      private: std::vector<T> zMin;
+
+      /// \brief Closed upper bound of the regions along x.
+      private: std::vector<T> xMax;
+
+      /// \brief Closed upper bound of the regions along y.
+      private: std::vector<T> yMax;
+
+      /// \brief Closed upper bound of the regions along z.
+      private: std::vector<T> zMax;
+
+      /// \brief Edges and masks along x.
+      private: Axis xAxis;
+
+      /// \brief Edges and masks along y.
+      private: Axis yAxis;
+
+      /// \brief Edges and masks along z.
+      private: Axis zAxis;
+    };
+
+    using Region3Arrayf = Region3Array<float>;
+    using Region3Arrayd = Region3Array<double>;
+    }
+  }
+}
+#endif
@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_RIGIDTRANSFORM3_HH_
+#define GZ_MATH_RIGIDTRANSFORM3_HH_
+
+#include <cstddef>
+#include <ostream>
+
+#include <gz/math/Matrix3.hh>
+#include <gz/math/Pose3.hh>
+#include <gz/math/Quaternion.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class RigidTransform3 RigidTransform3.hh gz/math/RigidTransform3.hh
+    /// \brief A rigid transform stored as a rotation matrix and a
+    /// translation, for poses that transform many points or directions.
+    ///
+    /// A Pose3 rotates every point with quaternion products. A
+    /// RigidTransform3 is built once from a Pose3, after which each point
+    /// costs one 3x3 product and an addition. Composition and inversion work
+    /// on the matrix directly, without converting back to a quaternion.
+    /// The results match the matching Pose3 functions up to floating point
+    /// rounding.
+    template<typename T>
+    class RigidTransform3
+    {
+      /// \brief Default constructor, the identity transform.
+      public: RigidTransform3() = default;
+
+      /// \brief Constructor from a rotation matrix and a translation.
+      /// \param[in] _rot Rotation matrix, which should be orthonormal.
+      /// \param[in] _pos Translation.
+      public: RigidTransform3(const Matrix3<T> &_rot, const Vector3<T> &_pos)
+      : rot(_rot), pos(_pos)
+      {
+      }
+
+      /// \brief Construct from a Pose3. The rotation of the pose is
+      /// normalized, as in Matrix3(const Quaternion<T> &).
+      /// \param[in] _pose Pose to convert.
+      public: explicit RigidTransform3(const Pose3<T> &_pose)
+      : rot(_pose.Rot()), pos(_pose.Pos())
+      {
+      }
+
+      /// \brief Convert to a Pose3.
+      /// \return A Pose3 with the same rotation and translation.
+      public: Pose3<T> Pose() const
+      {
+        return Pose3<T>(this->pos, Quaternion<T>(this->rot));
+      }
+
+      /// \brief Get the rotation matrix.
+      /// \return The rotation matrix.
+      public: const Matrix3<T> &Rotation() const
+      {
+        return this->rot;
+      }
+
+      /// \brief Get the translation.
+      /// \return The translation.
+      public: const Vector3<T> &Translation() const
+      {
+        return this->pos;
+      }
+
+      /// \brief Transform a point, as Pose3::CoordPositionAdd.
+      /// \param[in] _point Point to transform.
+      /// \return Rotation * _point + translation.
+      public: Vector3<T> TransformPoint(const Vector3<T> &_point) const
+      {
+        return this->rot * _point + this->pos;
+      }
+
+      /// \brief Transform a direction, which is only rotated, as
+      /// Quaternion::RotateVector with the rotation of the pose.
+      /// \param[in] _dir Direction to transform.
+      /// \return Rotation * _dir.
+      public: Vector3<T> TransformDirection(const Vector3<T> &_dir) const
+      {
+        return this->rot * _dir;
+      }
+
+      /// \brief Transform a point by the inverse of this transform, without
+      /// computing the inverse.
+      /// \param[in] _point Point to transform.
+      /// \return Rotationᵀ * (_point - translation).
+      public: Vector3<T> InverseTransformPoint(const Vector3<T> &_point) const
+      {
+        return (_point - this->pos) * this->rot;
+      }
+
+      /// \brief Transform a direction by the inverse of this transform,
+      /// without computing the inverse.
+      /// \param[in] _dir Direction to transform.
+      /// \return Rotationᵀ * _dir.
+      public: Vector3<T> InverseTransformDirection(const Vector3<T> &_dir) const
+      {
+        return _dir * this->rot;
+      }
+
+      /// \brief Transform a buffer of points.
+      /// \param[in] _in Pointer to the first point to transform.
+      /// \param[out] _out Pointer to the first transformed point. It may be
+      /// equal to _in to transform the buffer in place.
+      /// \param[in] _count Number of points to transform.
+      public: void TransformPoints(const Vector3<T> *_in, Vector3<T> *_out,
+                                   const std::size_t _count) const
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+          _out[i] = this->rot * _in[i] + this->pos;
+      }
+
+      /// \brief Transform a buffer of directions, which are only rotated.
+      /// \param[in] _in Pointer to the first direction to transform.
+      /// \param[out] _out Pointer to the first transformed direction. It may
+      /// be equal to _in to transform the buffer in place.
+      /// \param[in] _count Number of directions to transform.
+      public: void TransformDirections(const Vector3<T> *_in,
+                                       Vector3<T> *_out,
+                                       const std::size_t _count) const
+      {
+        for (std::size_t i = 0; i < _count; ++i)
+          _out[i] = this->rot * _in[i];
+      }
+
+      /// \brief Get the inverse transform, with the transpose of the
+      /// rotation.
+      /// \return The inverse transform.
+      public: RigidTransform3<T> Inverse() const
+      {
+        const Matrix3<T> inv = this->rot.Transposed();
+        return RigidTransform3<T>(inv, -(inv * this->pos));
+      }
+
+      /// \brief Multiplication operator, with the convention of
+      /// Pose3::operator*: given X_OP (frame P relative to O) and X_PQ
+      /// (frame Q relative to P), X_OQ = X_OP * X_PQ.
+      /// \param[in] _t The transform to multiply by.
+      /// \return The resulting transform.
+      public: RigidTransform3<T> operator*(const RigidTransform3<T> &_t) const
+      {
+        return RigidTransform3<T>(this->rot * _t.rot,
+                                  this->rot * _t.pos + this->pos);
+      }
+
+      /// \brief Multiplication assignment operator. This transform will
+      /// become equal to this * _t.
+      /// \param[in] _t The transform to multiply by.
+      /// \return Reference to this transform.
+      public: RigidTransform3<T> &operator*=(const RigidTransform3<T> &_t)
+      {
+        *this = *this * _t;
+        return *this;
+      }
+
+      /// \brief Equality test with tolerance.
+      /// \param[in] _t The transform to compare against.
+      /// \param[in] _tol Equality tolerance.
+      /// \return True if the rotations and translations are equal within
+      /// _tol.
+      public: bool Equal(const RigidTransform3<T> &_t, const T &_tol) const
+      {
+        return this->rot.Equal(_t.rot, _tol) && this->pos.Equal(_t.pos, _tol);
+      }
+
+      /// \brief Equality operator, with the tolerances of Matrix3::operator==
+      /// and Vector3::operator==.
+      /// \param[in] _t The transform to compare against.
+      /// \return True if the transforms are equal.
+      public: bool operator==(const RigidTransform3<T> &_t) const
+      {
+        return this->rot == _t.rot && this->pos == _t.pos;
+      }
+
+      /// \brief Inequality operator.
+      /// \param[in] _t The transform to compare against.
+      /// \return True if the transforms are not equal.
+      public: bool operator!=(const RigidTransform3<T> &_t) const
+      {
+        return !(*this == _t);
+      }
+
+      /// \brief Stream insertion operator, in the format of Pose3.
+      /// \param[in, out] _out Output stream.
+      /// \param[in] _t Transform to output.
+      /// \return The stream.
+      public: friend std::ostream &operator<<(
+                  std::ostream &_out, const RigidTransform3<T> &_t)
+      {
+        return _out << _t.Pose();
+      }
+
+      /// \brief The rotation matrix.
+      private: Matrix3<T> rot = Matrix3<T>::Identity;
+
+      /// \brief The translation.
+      private: Vector3<T> pos = Vector3<T>::Zero;
+    };
+
+    typedef RigidTransform3<double> RigidTransform3d;
+    typedef RigidTransform3<float> RigidTransform3f;
+    }
+  }
+}
+#endif
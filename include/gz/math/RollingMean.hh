@@ -31,6 +31,12 @@ namespace gz
     /// The window size determines the maximum number of data points. The
     /// oldest value is popped off when the window size is reached and
     /// a new value is pushed in.
+    ///
+    /// The values are kept in a ring buffer allocated when the window size
+    /// is set, along with a compensated running sum, so Push() and Mean()
+    /// take constant time and don't allocate. Reserve() sets aside room for
+    /// larger windows, so that SetWindowSize() doesn't allocate either, for
+    /// instance in a real-time thread.
     class GZ_MATH_VISIBLE RollingMean
     {
       /// \brief Constructor
@@ -56,7 +62,8 @@ namespace gz
       public: void Clear();
 
       /// \brief Set the new window size. This will also clear the data.
-      /// Nothing happens if the _windowSize is zero.
+      /// Nothing happens if the _windowSize is zero. This doesn't allocate
+      /// if _windowSize is not greater than Capacity().
       /// \param[in] _windowSize The window size to use.
       public: void SetWindowSize(size_t _windowSize);
 
@@ -64,6 +71,17 @@ namespace gz
       /// \return The window size.
       public: size_t WindowSize() const;
 
+      /// \brief Allocate room for windows of up to _capacity values, which
+      /// keeps the current window and its data.
+      /// \param[in] _capacity The largest window size to make room for.
+      /// \sa SetWindowSize
+      public: void Reserve(size_t _capacity);
+
+      /// \brief Get the largest window size that can be set without
+      /// allocating.
+      /// \return The capacity, at least WindowSize().
+      public: size_t Capacity() const;
+
       /// \brief Private data pointer.
       GZ_UTILS_IMPL_PTR(dataPtr)
     };
@@ -17,6 +17,8 @@
 #ifndef GZ_MATH_ROTATIONSPLINE_HH_
 #define GZ_MATH_ROTATIONSPLINE_HH_
 
+#include <cstddef>
+
 #include <gz/math/Quaternion.hh>
 #include <gz/math/config.hh>
 #include <gz/utils/ImplPtr.hh>
@@ -38,6 +40,19 @@ namespace gz
       /// \param[in] _p control point
       public: void AddPoint(const Quaterniond &_p);
 
+      /// \brief Adds control points to the end of the spline. This
+      /// recalculates the spline once, which is faster than adding the
+      /// points one by one, with the same result.
+      /// \param[in] _points pointer to the first control point.
+      /// \param[in] _count number of control points.
+      public: void AddPoints(const Quaterniond *_points,
+                             const size_t _count);
+
+      /// \brief Reserves storage for a number of control points, so that
+      /// adding them one by one or in several batches doesn't reallocate.
+      /// \param[in] _count total number of control points.
+      public: void Reserve(const size_t _count);
+
       /// \brief Gets the detail of one of the control points of the spline.
       /// \param[in] _index the index of the control point. _index is
       /// clamped to [0, PointCount()-1].
@@ -88,6 +103,21 @@ namespace gz
       public: Quaterniond Interpolate(const unsigned int _fromIndex,
                   const double _t, const bool _useShortestPath = true);
 
+      /// \brief Interpolates the spline at many parametric values, the
+      /// same as calling Interpolate(double, bool) for each of them, but
+      /// faster. The parts of the interpolation of each segment that do not
+      /// depend on the parametric value are cached when points change.
+      /// \param[in] _t Pointer to the first parametric value.
+      /// \param[out] _out Pointer to the first of _count rotations, or
+      /// [INF, INF, INF, INF] on error, as for Interpolate(double, bool),
+      /// and for negative or NaN values.
+      /// \param[in] _count Number of values.
+      /// \param[in] _useShortestPath Defines if rotation should take the
+      ///        shortest possible path
+      public: void Interpolate(const double *_t, Quaterniond *_out,
+                               const size_t _count,
+                               const bool _useShortestPath = true) const;
+
       /// \brief Tells the spline whether it should automatically calculate
       ///        tangents on demand as points are added.
       /// \remarks The spline calculates tangents at each point automatically
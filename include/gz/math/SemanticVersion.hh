@@ -18,8 +18,10 @@
 #ifndef GZ_MATH_SEMANTICVERSION_HH_
 #define GZ_MATH_SEMANTICVERSION_HH_
 
+#include <cstdint>
 #include <iosfwd>
 #include <string>
+#include <string_view>
 #include <gz/math/Helpers.hh>
 #include <gz/math/config.hh>
 #include <gz/utils/ImplPtr.hh>
@@ -63,6 +65,51 @@ namespace gz
       /// \return True on success.
       public: bool Parse(const std::string &_versionStr);
 
+      /// \brief Parse a version string and set the major, minor, patch
+      /// numbers, and prerelease and build strings, without a stream or a
+      /// temporary string.
+      ///
+      /// The numeric part is one to three dot separated decimal numbers,
+      /// the missing ones are 0. It is followed by an optional prerelease
+      /// string, after "-", and optional build metadata, after "+".
+      /// \param[in] _versionStr The version string, such as "1.2.3-pr+123"
+      /// \return True on success. On failure, such as for a number which
+      /// isn't made of digits or doesn't fit in an unsigned int, the
+      /// version is unchanged.
+      public: bool Parse(std::string_view _versionStr);
+
+      /// \brief Parse a version string, see Parse(std::string_view).
+      /// \param[in] _versionStr The version string, such as "1.2.3-pr+123"
+      /// \return True on success.
+      public: bool Parse(const char *_versionStr)
+      {
+        return this->Parse(std::string_view(_versionStr));
+      }
+
+      /// \brief Largest major, minor or patch number stored exactly in a
+      /// key.
+      public: static constexpr unsigned int kMaxKeyNumber = (1u << 21) - 1;
+
+      /// \brief Get a key of the version, whose integer order is the order
+      /// of operator<, so that sorting and comparing versions are integer
+      /// operations.
+      ///
+      /// The major, minor and patch numbers take 21 bits each, from the
+      /// most significant bits, and the last bit is set if there is no
+      /// prerelease string, since a prerelease is lower than the release.
+      /// Numbers larger than kMaxKeyNumber are clamped to it, so versions
+      /// which differ only past it have the same key.
+      /// \return The key.
+      public: std::uint64_t Key() const;
+
+      /// \brief Get the key of a version string without building a
+      /// SemanticVersion, see Key().
+      /// \param[in] _versionStr The version string, such as "1.2.3-pr+123"
+      /// \param[out] _key The key of the version, unchanged on failure.
+      /// \return True if the string is a valid version, as for Parse.
+      public: static bool ParseKey(std::string_view _versionStr,
+                                   std::uint64_t &_key);
+
       /// \brief Returns the version as a string
       /// \return The semantic version string
       public: std::string Version() const;
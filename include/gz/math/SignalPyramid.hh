@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_SIGNALPYRAMID_HH_
+#define GZ_MATH_SIGNALPYRAMID_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <gz/math/Export.hh>
+#include <gz/math/config.hh>
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    /// \brief Summary of consecutive samples of a signal, see SignalPyramid.
+    /// It is a plain struct so arrays of buckets can be written as is.
+    struct SignalBucket
+    {
+      /// \brief Smallest sample, NaN samples are never selected.
+      double min;
+
+      /// \brief Largest sample, NaN samples are never selected.
+      double max;
+
+      /// \brief Mean of the samples.
+      double mean;
+
+      /// \brief Number of samples.
+      uint64_t count;
+    };
+
+    /// \class SignalPyramid SignalPyramid.hh gz/math/SignalPyramid.hh
+    /// \brief Downsample a long discretely sampled signal at several
+    /// resolutions, such as telemetry plotted over the last seconds, minutes
+    /// and hours, in constant memory.
+    ///
+    /// The samples are summarized in buckets of fixed width by their
+    /// minimum, maximum and mean. The buckets of the first level hold
+    /// BucketSize(0) samples each, and the buckets of each next level merge
+    /// a number of buckets of the previous level given by the factor. Each
+    /// level keeps its last Capacity() complete buckets in a ring buffer,
+    /// dropping the oldest ones, so the coarser levels cover longer
+    /// histories with the same memory.
+    ///
+    /// Block insertion summarizes the samples of each first level bucket in
+    /// a single loop the compiler can vectorize, so the cost per sample
+    /// doesn't depend on the number of levels. Use Export() to copy the
+    /// buckets of a level to a contiguous array, from the oldest to the
+    /// newest.
+    ///
+    /// **Example Usage**
+    ///
+    /// \code{.cpp}
+    /// // 1 kHz samples, in buckets of 10 ms, 1 s and 100 s, 1000 each.
+    /// gz::math::SignalPyramid pyramid(10, 100, 3, 1000);
+    /// pyramid.InsertData(samples.data(), samples.size());
+    /// std::vector<gz::math::SignalBucket> seconds(pyramid.Size(1));
+    /// pyramid.Export(1, seconds.data());
+    /// \endcode
+    class GZ_MATH_VISIBLE SignalPyramid
+    {
+      /// \brief Constructor.
+      /// \param[in] _bucketSize Number of samples in each bucket of the first
+      /// level. Zero is treated as one.
+      /// \param[in] _factor Number of buckets of a level merged in each
+      /// bucket of the next level. Zero is treated as one.
+      /// \param[in] _levels Number of levels. Zero is treated as one.
+      /// \param[in] _capacity Number of complete buckets kept for each
+      /// level. Zero is treated as one.
+      public: SignalPyramid(const std::size_t _bucketSize,
+                            const std::size_t _factor,
+                            const std::size_t _levels,
+                            const std::size_t _capacity);
+
+      /// \brief Get the number of levels.
+      /// \return Number of levels.
+      public: std::size_t Levels() const;
+
+      /// \brief Get the number of complete buckets kept for each level.
+      /// \return The capacity of the levels.
+      public: std::size_t Capacity() const;
+
+      /// \brief Get the number of samples in each bucket of a level.
+      /// \param[in] _level The level, from 0.
+      /// \return Number of samples per bucket, 0 if _level is out of range.
+      public: uint64_t BucketSize(const std::size_t _level) const;
+
+      /// \brief Get the number of samples inserted since the construction or
+      /// the last Reset().
+      /// \return Number of samples.
+      public: uint64_t Count() const;
+
+      /// \brief Add a new sample.
+      /// \param[in] _data New signal data point.
+      public: void InsertData(const double _data);
+
+      /// \brief Add a block of samples, as if each one had been inserted in
+      /// order. The means may differ from single insertions by rounding.
+      /// \param[in] _data Pointer to the first sample.
+      /// \param[in] _count Number of samples.
+      public: void InsertData(const double *_data, const std::size_t _count);
+
+      /// \brief Forget all previous data.
+      public: void Reset();
+
+      /// \brief Get the number of complete buckets kept for a level.
+      /// \param[in] _level The level, from 0.
+      /// \return Number of buckets, at most Capacity(), 0 if _level is out
+      /// of range.
+      public: std::size_t Size(const std::size_t _level) const;
+
+      /// \brief Get a complete bucket of a level.
+      /// \param[in] _level The level, from 0.
+      /// \param[in] _index Index of the bucket, from 0 for the oldest to
+      /// Size(_level) - 1 for the newest.
+      /// \return The bucket, with a zero count if an argument is out of
+      /// range.
+      public: SignalBucket Bucket(const std::size_t _level,
+                                  const std::size_t _index) const;
+
+      /// \brief Get the bucket of a level that is being filled.
+      /// \param[in] _level The level, from 0.
+      /// \return The bucket, with the samples inserted since the last
+      /// complete bucket of the level. Its fields are zero if there are none
+      /// or if _level is out of range.
+      public: SignalBucket Current(const std::size_t _level) const;
+
+      /// \brief Copy the complete buckets of a level to an array.
+      /// \param[in] _level The level, from 0.
+      /// \param[out] _buckets Array of at least Size(_level) buckets, set
+      /// from the oldest to the newest.
+      /// \return Number of buckets copied.
+      public: std::size_t Export(const std::size_t _level,
+                                 SignalBucket *_buckets) const;
+
+      /// \brief Private data pointer.
+      GZ_UTILS_IMPL_PTR(dataPtr)
+    };
+    }
+  }
+}
+#endif
@@ -17,9 +17,11 @@
 #ifndef GZ_MATH_SIGNALSTATS_HH_
 #define GZ_MATH_SIGNALSTATS_HH_
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 #include <gz/math/Helpers.hh>
 #include <gz/math/config.hh>
 
@@ -63,9 +65,47 @@ namespace gz
       /// \param[in] _data New signal data point.
       public: virtual void InsertData(const double _data) = 0;
 
+      /// \brief Add a block of samples to the statistical measure, inserting
+      /// each one in order. SignalStats::InsertData(const double *,
+      /// const size_t) inserts blocks faster in the statistics it holds.
+      /// \param[in] _data Pointer to the first sample.
+      /// \param[in] _count Number of samples.
+      public: void InsertData(const double *_data, const size_t _count);
+
       /// \brief Forget all previous data.
       public: virtual void Reset();
 
+      /// \brief Add the data of another statistic of the same type, as if
+      /// its samples had been inserted in this one. This lets statistics be
+      /// computed in parallel over parts of a signal and then combined.
+      /// Only the statistics of this header can be merged, and only with
+      /// one of exactly the same class. Merged SignalQuantile digests may
+      /// report slightly different quantiles, and SignalHistogram objects
+      /// must have the same bins.
+      /// \param[in] _other Statistic to merge into this one.
+      /// \return True if the statistics were merged, false if _other is not
+      /// of the same type or can't be merged, in which case this statistic
+      /// is unchanged.
+      public: bool Merge(const SignalStatistic &_other);
+
+      /// \brief Append the accumulator state of the statistic to a binary
+      /// snapshot, in the byte order of this machine. The state can be
+      /// merged into a statistic of the same type with MergeSnapshot, for
+      /// example in another process. See SignalStats::Snapshot.
+      /// \param[in,out] _buffer Buffer the state is appended to.
+      public: void AppendSnapshot(std::vector<uint8_t> &_buffer) const;
+
+      /// \brief Add the data of a statistic of the same type saved by
+      /// AppendSnapshot, as Merge does.
+      /// \param[in] _data Pointer to the saved state.
+      /// \param[in] _size Number of bytes of the saved state.
+      /// \return True if the state was merged, false if it is malformed or
+      /// can't be merged, in which case this statistic is unchanged.
+      public: bool MergeSnapshot(const uint8_t *_data, const size_t _size);
+
+      /// \brief SignalStats inserts blocks of samples in the data.
+      private: friend class SignalStats;
+
 #ifdef _WIN32
 // Disable warning C4251 which is triggered by
 // std::unique_ptr
@@ -92,6 +132,9 @@ namespace gz
 
       // Documentation inherited.
       public: virtual void InsertData(const double _data) override;
+
+      // Documentation inherited.
+      public: using SignalStatistic::InsertData;
     };
 
     /// \class SignalMean SignalStats.hh gz/math/SignalStats.hh
@@ -107,6 +150,9 @@ namespace gz
 
       // Documentation inherited.
       public: virtual void InsertData(const double _data) override;
+
+      // Documentation inherited.
+      public: using SignalStatistic::InsertData;
     };
 
     /// \class SignalMinimum SignalStats.hh gz/math/SignalStats.hh
@@ -122,6 +168,9 @@ namespace gz
 
       // Documentation inherited.
       public: virtual void InsertData(const double _data) override;
+
+      // Documentation inherited.
+      public: using SignalStatistic::InsertData;
     };
 
     /// \class SignalRootMeanSquare SignalStats.hh gz/math/SignalStats.hh
@@ -138,6 +187,9 @@ namespace gz
 
       // Documentation inherited.
       public: virtual void InsertData(const double _data) override;
+
+      // Documentation inherited.
+      public: using SignalStatistic::InsertData;
     };
 
     /// \class SignalMaxAbsoluteValue SignalStats.hh
@@ -156,6 +208,9 @@ namespace gz
 
       // Documentation inherited.
       public: virtual void InsertData(const double _data) override;
+
+      // Documentation inherited.
+      public: using SignalStatistic::InsertData;
     };
 
     /// \class SignalVariance SignalStats.hh gz/math/SignalStats.hh
@@ -172,6 +227,156 @@ namespace gz
 
       // Documentation inherited.
       public: virtual void InsertData(const double _data) override;
+
+      // Documentation inherited.
+      public: using SignalStatistic::InsertData;
+    };
+
+    /// \brief Forward declare private data class.
+    class SignalQuantilePrivate;
+
+    /// \class SignalQuantile SignalStats.hh gz/math/SignalStats.hh
+    /// \brief Estimate a quantile of a discretely sampled signal, such as the
+    /// median or the 99th percentile, without storing the samples.
+    ///
+    /// The samples are summarized with a t-digest (Dunning and Ertl,
+    /// "Computing Extremely Accurate Quantiles Using t-Digests"): a sorted
+    /// list of weighted centroids that are kept small near the extreme
+    /// quantiles, so tail quantiles are the most accurate. The memory used
+    /// is bounded by the compression, independently of the number of
+    /// samples. Digests of different signals can be merged.
+    class GZ_MATH_VISIBLE SignalQuantile : public SignalStatistic
+    {
+      /// \brief Constructor.
+      /// \param[in] _quantile Quantile to estimate, in [0, 1], for example
+      /// 0.95 for the 95th percentile. Values outside are clamped.
+      /// \param[in] _compression Size of the digest. Higher values keep more
+      /// centroids, up to about twice this number, for more accuracy.
+      public: explicit SignalQuantile(const double _quantile = 0.5,
+                                      const double _compression = 100);
+
+      /// \brief Copy constructor
+      /// \param[in] _sq SignalQuantile to copy
+      public: SignalQuantile(const SignalQuantile &_sq);
+
+      /// \brief Destructor
+      public: virtual ~SignalQuantile();
+
+      /// \brief Get the estimate of the quantile given to the constructor.
+      /// \return The estimated quantile, 0 if there are no samples.
+      public: virtual double Value() const override;
+
+      /// \brief Get a short version of the name of this statistical measure.
+      /// \return "p" followed by the quantile in percent, for example "p50"
+      /// or "p99.9".
+      public: virtual std::string ShortName() const override;
+
+      // Documentation inherited.
+      public: virtual void InsertData(const double _data) override;
+
+      // Documentation inherited.
+      public: using SignalStatistic::InsertData;
+
+      // Documentation inherited.
+      public: virtual void Reset() override;
+
+      /// \brief Estimate any quantile of the samples.
+      /// \param[in] _quantile Quantile in [0, 1]. Values outside are
+      /// clamped.
+      /// \return The estimated quantile, 0 if there are no samples.
+      public: double Quantile(const double _quantile) const;
+
+      /// \brief SignalStatistic merges and saves the digests.
+      private: friend class SignalStatistic;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Pointer to the digest.
+      private: std::unique_ptr<SignalQuantilePrivate> quantilePtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+
+    /// \brief Forward declare private data class.
+    class SignalHistogramPrivate;
+
+    /// \class SignalHistogram SignalStats.hh gz/math/SignalStats.hh
+    /// \brief Histogram of a discretely sampled signal with fixed, evenly
+    /// spaced bins. Samples below the range are counted in Underflow() and
+    /// samples above it, or NaN, in Overflow().
+    class GZ_MATH_VISIBLE SignalHistogram : public SignalStatistic
+    {
+      /// \brief Constructor.
+      /// \param[in] _min Lower bound of the first bin.
+      /// \param[in] _max Upper bound of the last bin, included in it. If it
+      /// is not greater than _min, the range is [_min, _min + 1].
+      /// \param[in] _bins Number of bins, at least 1.
+      public: SignalHistogram(const double _min, const double _max,
+                              const size_t _bins);
+
+      /// \brief Copy constructor
+      /// \param[in] _sh SignalHistogram to copy
+      public: SignalHistogram(const SignalHistogram &_sh);
+
+      /// \brief Destructor
+      public: virtual ~SignalHistogram();
+
+      /// \brief Get the median estimated from the bins.
+      /// \return The estimated median, 0 if there are no samples.
+      public: virtual double Value() const override;
+
+      /// \brief Get a short version of the name of this statistical measure.
+      /// \return "hist"
+      public: virtual std::string ShortName() const override;
+
+      // Documentation inherited.
+      public: virtual void InsertData(const double _data) override;
+
+      // Documentation inherited.
+      public: using SignalStatistic::InsertData;
+
+      // Documentation inherited.
+      public: virtual void Reset() override;
+
+      /// \brief Get the number of samples in each bin.
+      /// \return The bin counts, from the lowest to the highest bin.
+      public: const std::vector<uint64_t> &Bins() const;
+
+      /// \brief Get the number of samples below the range of the bins.
+      /// \return Number of samples.
+      public: uint64_t Underflow() const;
+
+      /// \brief Get the number of samples above the range of the bins, or
+      /// NaN.
+      /// \return Number of samples.
+      public: uint64_t Overflow() const;
+
+      /// \brief Estimate a quantile by linear interpolation in the bins.
+      /// Samples out of the range count as being at its bounds.
+      /// \param[in] _quantile Quantile in [0, 1]. Values outside are
+      /// clamped.
+      /// \return The estimated quantile, 0 if there are no samples.
+      public: double Quantile(const double _quantile) const;
+
+      /// \brief SignalStatistic merges and saves the histograms.
+      private: friend class SignalStatistic;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Pointer to the histogram.
+      private: std::unique_ptr<SignalHistogramPrivate> histogramPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
     };
 
     /// \brief Forward declare private data class.
@@ -208,12 +413,24 @@ namespace gz
       /// \param[in] _data New signal data point.
       public: void InsertData(const double _data);
 
+      /// \brief Add a block of samples to the statistical measures. Each
+      /// statistic processes the whole block at once, which is faster than
+      /// inserting the samples one by one.
+      /// \param[in] _data Pointer to the first sample.
+      /// \param[in] _count Number of samples.
+      public: void InsertData(const double *_data, const size_t _count);
+
       /// \brief Add a new type of statistic.
       /// \param[in] _name Short name of new statistic.
       /// Valid values include:
+      ///  "max"
       ///  "maxAbs"
       ///  "mean"
+      ///  "min"
       ///  "rms"
+      ///  "var"
+      ///  "p" followed by a percentile in (0, 100], such as "p50", "p95",
+      ///  "p99" or "p99.9", for a SignalQuantile.
       /// \return True if statistic was successfully added,
       /// false if name was not recognized or had already
       /// been inserted.
@@ -231,6 +448,42 @@ namespace gz
       /// \brief Forget all previous data.
       public: void Reset();
 
+      /// \brief Add the data of another collection with the same
+      /// statistics, as if its samples had been inserted in this one.
+      /// \param[in] _other Collection to merge into this one.
+      /// \return True if the statistics were merged, false if the
+      /// collections don't have the same statistics, in which case this
+      /// collection is unchanged.
+      public: bool Merge(const SignalStats &_other);
+
+      /// \brief Append a compact binary snapshot of the accumulator state
+      /// of the statistics to a buffer, in the byte order of this machine.
+      /// The buffer can be sent to another process and merged there with
+      /// MergeSnapshot, which is much cheaper than building and parsing the
+      /// text of Map(). Several snapshots may be appended to one buffer.
+      /// \param[in,out] _buffer Buffer the snapshot is appended to.
+      /// \return Number of bytes appended.
+      public: size_t Snapshot(std::vector<uint8_t> &_buffer) const;
+
+      /// \brief Add the data of a snapshot taken by Snapshot from a
+      /// collection with the same statistics, as Merge does.
+      /// \param[in] _data Pointer to the snapshot.
+      /// \param[in] _size Number of bytes of the snapshot.
+      /// \return True if the statistics were merged, false if the snapshot
+      /// is malformed or the collections don't have the same statistics. As
+      /// for Merge, the statistics are matched by name before merging any,
+      /// so this collection is unchanged if they don't match.
+      public: bool MergeSnapshot(const uint8_t *_data, const size_t _size);
+
+      /// \brief Replace the statistics and their data by those of a
+      /// snapshot taken by Snapshot.
+      /// \param[in] _data Pointer to the snapshot.
+      /// \param[in] _size Number of bytes of the snapshot.
+      /// \return True if the snapshot was restored, false if it is malformed
+      /// or holds statistics that can't be inserted by name, in which case
+      /// this collection is unchanged.
+      public: bool RestoreSnapshot(const uint8_t *_data, const size_t _size);
+
       /// \brief Assignment operator
       /// \param[in] _s A SignalStats to copy
       /// \return this
@@ -246,6 +499,87 @@ namespace gz
       private: std::unique_ptr<SignalStatsPrivate> dataPtr;
 #ifdef _WIN32
 #pragma warning(pop)
+#endif
+    };
+
+    /// \brief Forward declare private data class.
+    class ShardedSignalStatsPrivate;
+
+    /// \class ShardedSignalStats SignalStats.hh gz/math/SignalStats.hh
+    /// \brief Collection of statistics for a scalar signal whose samples are
+    /// inserted by several threads at once.
+    ///
+    /// Each thread inserts samples in its own shard, a SignalStats with a
+    /// lock that only readers take, so producers don't contend with each
+    /// other. The shards are merged when the statistics are read. If there
+    /// are more producer threads than shards, some threads share a shard.
+    class GZ_MATH_VISIBLE ShardedSignalStats
+    {
+      /// \brief Constructor
+      /// \param[in] _shards Number of shards, zero for
+      /// std::thread::hardware_concurrency.
+      public: explicit ShardedSignalStats(const size_t _shards = 0);
+
+      /// \brief Destructor
+      public: ~ShardedSignalStats();
+
+      /// \brief Copying is not supported.
+      public: ShardedSignalStats(const ShardedSignalStats &) = delete;
+
+      /// \brief Copying is not supported.
+      /// \return this
+      public: ShardedSignalStats &operator=(
+                  const ShardedSignalStats &) = delete;
+
+      /// \brief Add a new type of statistic to every shard.
+      /// \param[in] _name Short name of new statistic, see
+      /// SignalStats::InsertStatistic.
+      /// \return True if statistic was successfully added,
+      /// false if name was not recognized or had already
+      /// been inserted.
+      public: bool InsertStatistic(const std::string &_name);
+
+      /// \brief Add multiple statistics to every shard.
+      /// \param[in] _names Comma-separated list of new statistics, see
+      /// SignalStats::InsertStatistics.
+      /// \return True if all statistics were successfully added,
+      /// false if any names were not recognized or had already
+      /// been inserted.
+      public: bool InsertStatistics(const std::string &_names);
+
+      /// \brief Add a new sample to the statistical measures. This can be
+      /// called from any number of threads at once.
+      /// \param[in] _data New signal data point.
+      public: void InsertData(const double _data);
+
+      /// \brief Get the statistics of all the samples inserted so far, by
+      /// merging the shards.
+      /// \return A collection with the merged statistics.
+      public: SignalStats Merged() const;
+
+      /// \brief Get number of data points inserted in all the shards.
+      /// \return Number of data points.
+      public: size_t Count() const;
+
+      /// \brief Get the current values of each statistical measure,
+      /// stored in a map using the short name as the key.
+      /// \return Map with short name of each statistic as key
+      /// and value of statistic as the value.
+      public: std::map<std::string, double> Map() const;
+
+      /// \brief Forget all previous data.
+      public: void Reset();
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<ShardedSignalStatsPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
 #endif
     };
     }
@@ -0,0 +1,475 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_SIGNALSTATST_HH_
+#define GZ_MATH_SIGNALSTATST_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    /// \brief Accumulators for SignalStatsT.
+    ///
+    /// Each accumulator keeps kLanes independent partial results. Sample i
+    /// of a signal goes to lane i % kLanes, so a block of kLanes samples
+    /// updates every lane once with no dependency between the lanes, which
+    /// lets the compiler vectorize the update. The lanes are combined when
+    /// the value is read.
+    ///
+    /// An accumulator has:
+    ///  - `static constexpr const char *kShortName`, the name used by
+    ///    SignalStats::InsertStatistic for the same statistic.
+    ///  - `void Insert(std::size_t _lane, double _data, double _n)`, which
+    ///    adds a sample to a lane that holds _n samples afterwards.
+    ///  - `void InsertLanes(const double *_data, double _n)`, which adds
+    ///    kLanes samples, one per lane. Every lane holds _n samples
+    ///    afterwards.
+    ///  - `double Value(std::size_t _count) const`, the value of the
+    ///    statistic after _count samples in total.
+    ///  - `void Reset()`.
+    namespace stats
+    {
+      /// \brief Number of lanes of the accumulators.
+      constexpr std::size_t kLanes = 4;
+
+      /// \brief Get the number of samples in a lane.
+      /// \param[in] _count Total number of samples.
+      /// \param[in] _lane Index of the lane.
+      /// \return Number of samples in the lane.
+      constexpr std::size_t LaneCount(const std::size_t _count,
+                                      const std::size_t _lane)
+      {
+        return _count / kLanes + (_lane < _count % kLanes ? 1 : 0);
+      }
+
+      /// \brief Mean value, same as SignalMean.
+      struct Mean
+      {
+        /// \brief Short name of the statistic.
+        static constexpr const char *kShortName = "mean";
+
+        /// \brief Sum of the samples of each lane.
+        double sum[kLanes] = {};
+
+        /// \brief Add a sample to a lane.
+        /// \param[in] _lane Index of the lane.
+        /// \param[in] _data The sample.
+        void Insert(const std::size_t _lane, const double _data, double)
+        {
+          this->sum[_lane] += _data;
+        }
+
+        /// \brief Add one sample to every lane.
+        /// \param[in] _data Pointer to kLanes samples.
+        void InsertLanes(const double *_data, double)
+        {
+          for (std::size_t l = 0; l < kLanes; ++l)
+            this->sum[l] += _data[l];
+        }
+
+        /// \brief Get the mean.
+        /// \param[in] _count Number of samples.
+        /// \return The mean, 0 if there are no samples.
+        double Value(const std::size_t _count) const
+        {
+          if (_count == 0)
+            return 0;
+          double total = 0;
+          for (std::size_t l = 0; l < kLanes; ++l)
+            total += this->sum[l];
+          return total / _count;
+        }
+
+        /// \brief Forget all previous samples.
+        void Reset()
+        {
+          *this = Mean();
+        }
+      };
+
+      /// \brief Root mean square, same as SignalRootMeanSquare.
+      struct Rms
+      {
+        /// \brief Short name of the statistic.
+        static constexpr const char *kShortName = "rms";
+
+        /// \brief Sum of the squared samples of each lane.
+        double sum[kLanes] = {};
+
+        /// \brief Add a sample to a lane.
+        /// \param[in] _lane Index of the lane.
+        /// \param[in] _data The sample.
+        void Insert(const std::size_t _lane, const double _data, double)
+        {
+          this->sum[_lane] += _data * _data;
+        }
+
+        /// \brief Add one sample to every lane.
+        /// \param[in] _data Pointer to kLanes samples.
+        void InsertLanes(const double *_data, double)
+        {
+          for (std::size_t l = 0; l < kLanes; ++l)
+            this->sum[l] += _data[l] * _data[l];
+        }
+
+        /// \brief Get the root mean square.
+        /// \param[in] _count Number of samples.
+        /// \return The root mean square, 0 if there are no samples.
+        double Value(const std::size_t _count) const
+        {
+          if (_count == 0)
+            return 0;
+          double total = 0;
+          for (std::size_t l = 0; l < kLanes; ++l)
+            total += this->sum[l];
+          return std::sqrt(total / _count);
+        }
+
+        /// \brief Forget all previous samples.
+        void Reset()
+        {
+          *this = Rms();
+        }
+      };
+
+      /// \brief Maximum value, same as SignalMaximum.
+      struct Max
+      {
+        /// \brief Short name of the statistic.
+        static constexpr const char *kShortName = "max";
+
+        /// \brief Maximum of each lane.
+        double max[kLanes] = {-std::numeric_limits<double>::infinity(),
+          -std::numeric_limits<double>::infinity(),
+          -std::numeric_limits<double>::infinity(),
+          -std::numeric_limits<double>::infinity()};
+
+        /// \brief Add a sample to a lane.
+        /// \param[in] _lane Index of the lane.
+        /// \param[in] _data The sample.
+        void Insert(const std::size_t _lane, const double _data, double)
+        {
+          this->max[_lane] = std::max(this->max[_lane], _data);
+        }
+
+        /// \brief Add one sample to every lane.
+        /// \param[in] _data Pointer to kLanes samples.
+        void InsertLanes(const double *_data, double)
+        {
+          for (std::size_t l = 0; l < kLanes; ++l)
+            this->max[l] = _data[l] > this->max[l] ? _data[l] : this->max[l];
+        }
+
+        /// \brief Get the maximum.
+        /// \param[in] _count Number of samples.
+        /// \return The maximum, 0 if there are no samples.
+        double Value(const std::size_t _count) const
+        {
+          if (_count == 0)
+            return 0;
+          return *std::max_element(this->max, this->max + kLanes);
+        }
+
+        /// \brief Forget all previous samples.
+        void Reset()
+        {
+          *this = Max();
+        }
+      };
+
+      /// \brief Minimum value, same as SignalMinimum.
+      struct Min
+      {
+        /// \brief Short name of the statistic.
+        static constexpr const char *kShortName = "min";
+
+        /// \brief Minimum of each lane.
+        double min[kLanes] = {std::numeric_limits<double>::infinity(),
+          std::numeric_limits<double>::infinity(),
+          std::numeric_limits<double>::infinity(),
+          std::numeric_limits<double>::infinity()};
+
+        /// \brief Add a sample to a lane.
+        /// \param[in] _lane Index of the lane.
+        /// \param[in] _data The sample.
+        void Insert(const std::size_t _lane, const double _data, double)
+        {
+          this->min[_lane] = std::min(this->min[_lane], _data);
+        }
+
+        /// \brief Add one sample to every lane.
+        /// \param[in] _data Pointer to kLanes samples.
+        void InsertLanes(const double *_data, double)
+        {
+          for (std::size_t l = 0; l < kLanes; ++l)
+            this->min[l] = _data[l] < this->min[l] ? _data[l] : this->min[l];
+        }
+
+        /// \brief Get the minimum.
+        /// \param[in] _count Number of samples.
+        /// \return The minimum, 0 if there are no samples.
+        double Value(const std::size_t _count) const
+        {
+          if (_count == 0)
+            return 0;
+          return *std::min_element(this->min, this->min + kLanes);
+        }
+
+        /// \brief Forget all previous samples.
+        void Reset()
+        {
+          *this = Min();
+        }
+      };
+
+      /// \brief Maximum absolute value, same as SignalMaxAbsoluteValue.
+      struct MaxAbs
+      {
+        /// \brief Short name of the statistic.
+        static constexpr const char *kShortName = "maxAbs";
+
+        /// \brief Maximum absolute value of each lane.
+        double max[kLanes] = {};
+
+        /// \brief Add a sample to a lane.
+        /// \param[in] _lane Index of the lane.
+        /// \param[in] _data The sample.
+        void Insert(const std::size_t _lane, const double _data, double)
+        {
+          const double a = std::abs(_data);
+          this->max[_lane] = a > this->max[_lane] ? a : this->max[_lane];
+        }
+
+        /// \brief Add one sample to every lane.
+        /// \param[in] _data Pointer to kLanes samples.
+        void InsertLanes(const double *_data, double)
+        {
+          for (std::size_t l = 0; l < kLanes; ++l)
+          {
+            const double a = std::abs(_data[l]);
+            this->max[l] = a > this->max[l] ? a : this->max[l];
+          }
+        }
+
+        /// \brief Get the maximum absolute value.
+        /// \param[in] _count Number of samples.
+        /// \return The maximum absolute value, 0 if there are no samples.
+        double Value(const std::size_t) const
+        {
+          return *std::max_element(this->max, this->max + kLanes);
+        }
+
+        /// \brief Forget all previous samples.
+        void Reset()
+        {
+          *this = MaxAbs();
+        }
+      };
+
+      /// \brief Sample variance, same as SignalVariance. Each lane runs
+      /// Welford's algorithm, and the lanes are combined with the parallel
+      /// algorithm of Chan et al.
+      struct Var
+      {
+        /// \brief Short name of the statistic.
+        static constexpr const char *kShortName = "var";
+
+        /// \brief Mean of each lane.
+        double mean[kLanes] = {};
+
+        /// \brief Sum of squared differences from the mean of each lane.
+        double m2[kLanes] = {};
+
+        /// \brief Add a sample to a lane.
+        /// \param[in] _lane Index of the lane.
+        /// \param[in] _data The sample.
+        /// \param[in] _n Number of samples of the lane, including this one.
+        void Insert(const std::size_t _lane, const double _data,
+                    const double _n)
+        {
+          const double delta = _data - this->mean[_lane];
+          this->mean[_lane] += delta / _n;
+          this->m2[_lane] += delta * (_data - this->mean[_lane]);
+        }
+
+        /// \brief Add one sample to every lane.
+        /// \param[in] _data Pointer to kLanes samples.
+        /// \param[in] _n Number of samples of each lane, including these.
+        void InsertLanes(const double *_data, const double _n)
+        {
+          const double inv = 1.0 / _n;
+          for (std::size_t l = 0; l < kLanes; ++l)
+          {
+            const double delta = _data[l] - this->mean[l];
+            this->mean[l] += delta * inv;
+            this->m2[l] += delta * (_data[l] - this->mean[l]);
+          }
+        }
+
+        /// \brief Get the sample variance.
+        /// \param[in] _count Number of samples.
+        /// \return The variance, 0 if there are less than 2 samples.
+        double Value(const std::size_t _count) const
+        {
+          if (_count < 2)
+            return 0;
+
+          double n = 0;
+          double totalMean = 0;
+          double totalM2 = 0;
+          for (std::size_t l = 0; l < kLanes; ++l)
+          {
+            const std::size_t laneCount = LaneCount(_count, l);
+            if (laneCount == 0)
+              continue;
+            const double laneN = static_cast<double>(laneCount);
+            const double total = n + laneN;
+            const double delta = this->mean[l] - totalMean;
+            totalMean += delta * laneN / total;
+            totalM2 += this->m2[l] + delta * delta * n * laneN / total;
+            n = total;
+          }
+          return totalM2 / (n - 1);
+        }
+
+        /// \brief Forget all previous samples.
+        void Reset()
+        {
+          *this = Var();
+        }
+      };
+    }
+
+    /// \class SignalStatsT SignalStatsT.hh gz/math/SignalStatsT.hh
+    /// \brief Collection of statistics for a scalar signal, chosen at
+    /// compile time. This computes the same statistics as SignalStats, but
+    /// without a virtual call per statistic and sample: all the statistics
+    /// are updated in one loop that the compiler can inline and vectorize.
+    /// Results may differ from SignalStats in rounding, since the samples
+    /// are accumulated in stats::kLanes interleaved partial results.
+    ///
+    /// ## Example
+    ///
+    /// \code{.cpp}
+    /// gz::math::SignalStatsT<gz::math::stats::Mean, gz::math::stats::Rms,
+    ///   gz::math::stats::MaxAbs, gz::math::stats::Var> imuStats;
+    /// imuStats.InsertData(samples.data(), samples.size());
+    /// double rms = imuStats.Value<gz::math::stats::Rms>();
+    /// \endcode
+    ///
+    /// \tparam Stats Accumulators from the stats namespace, each at most
+    /// once.
+    template<typename... Stats>
+    class SignalStatsT
+    {
+      /// \brief Get number of data points.
+      /// \return Number of data points.
+      public: std::size_t Count() const
+      {
+        return this->count;
+      }
+
+      /// \brief Get the current value of one statistic.
+      /// \tparam Stat Accumulator of the statistic, one of Stats.
+      /// \return The value of the statistic.
+      public: template<typename Stat>
+      double Value() const
+      {
+        return std::get<Stat>(this->stats).Value(this->count);
+      }
+
+      /// \brief Get the current values of each statistical measure,
+      /// stored in a map using the short name as the key, like
+      /// SignalStats::Map().
+      /// \return Map with short name of each statistic as key
+      /// and value of statistic as the value.
+      public: std::map<std::string, double> Map() const
+      {
+        return {{Stats::kShortName, this->Value<Stats>()}...};
+      }
+
+      /// \brief Add a new sample to the statistical measures.
+      /// \param[in] _data New signal data point.
+      public: void InsertData(const double _data)
+      {
+        const std::size_t lane = this->count % stats::kLanes;
+        const double n = static_cast<double>(this->count / stats::kLanes + 1);
+        (std::get<Stats>(this->stats).Insert(lane, _data, n), ...);
+        ++this->count;
+      }
+
+      /// \brief Add a batch of samples to the statistical measures.
+      /// \param[in] _data Pointer to the first sample.
+      /// \param[in] _count Number of samples.
+      public: void InsertData(const double *_data, const std::size_t _count)
+      {
+        std::size_t i = 0;
+        for (; i < _count && this->count % stats::kLanes != 0; ++i)
+          this->InsertData(_data[i]);
+
+        for (; i + stats::kLanes <= _count; i += stats::kLanes)
+        {
+          // Copy the block so the compiler knows it doesn't alias the
+          // accumulators.
+          double block[stats::kLanes];
+          std::copy(_data + i, _data + i + stats::kLanes, block);
+          const double n =
+            static_cast<double>(this->count / stats::kLanes + 1);
+          (std::get<Stats>(this->stats).InsertLanes(block, n), ...);
+          this->count += stats::kLanes;
+        }
+
+        for (; i < _count; ++i)
+          this->InsertData(_data[i]);
+      }
+
+      /// \brief Add a batch of samples to the statistical measures.
+      /// \param[in] _data New signal data points.
+      public: void InsertData(const std::vector<double> &_data)
+      {
+        this->InsertData(_data.data(), _data.size());
+      }
+
+      /// \brief Forget all previous data.
+      public: void Reset()
+      {
+        (std::get<Stats>(this->stats).Reset(), ...);
+        this->count = 0;
+      }
+
+      /// \brief Number of data points.
+      private: std::size_t count = 0;
+
+      /// \brief The accumulators.
+      private: std::tuple<Stats...> stats;
+    };
+    }
+  }
+}
+#endif
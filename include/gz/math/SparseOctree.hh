@@ -0,0 +1,546 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_SPARSEOCTREE_HH_
+#define GZ_MATH_SPARSEOCTREE_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class SparseOctree SparseOctree.hh gz/math/SparseOctree.hh
+    /// \brief A sparse octree of cubic voxels holding points, for occupancy
+    /// checks and voxel grid downsampling. Each voxel keeps the number of
+    /// points inserted in it and their centroid, not the points.
+    ///
+    /// The voxel of a point is floor(_point / voxel size), like the cells
+    /// of SpatialHashGrid, and must be within kMaxVoxel of the origin on
+    /// each axis. Its key is the Morton code of its coordinates offset by
+    /// kMaxVoxel + 1, which interleaves their bits so that the key of a
+    /// node of the tree is a prefix of the keys of the voxels under it.
+    ///
+    /// The nodes and the voxels are stored in two arrays, with indices
+    /// instead of pointers. Voxels keep their index as points are added,
+    /// so they can be iterated in order of creation with VoxelCount and
+    /// the per-voxel accessors.
+    ///
+    /// # Example usage
+    ///
+    /// ```{.cpp}
+    /// gz::math::SparseOctree<float> octree(0.05f);
+    /// octree.Insert(scan.data(), scan.size());
+    /// std::vector<gz::math::Vector3f> downsampled;
+    /// octree.Centroids(downsampled);
+    /// ```
+    /// \tparam T Floating point type of the coordinates.
+    template<typename T>
+    class SparseOctree
+    {
+      static_assert(std::is_floating_point_v<T>,
+          "SparseOctree requires a floating point type");
+
+      /// \brief Number of bits of each voxel coordinate in a key.
+      public: static constexpr int kBits = 21;
+
+      /// \brief Largest absolute value of a voxel coordinate.
+      public: static constexpr int kMaxVoxel = (1 << (kBits - 1)) - 1;
+
+      /// \brief Constructor.
+      /// \param[in] _voxelSize Size of the voxels, which must be positive.
+      public: explicit SparseOctree(const T _voxelSize = 1)
+        : voxelSize(_voxelSize)
+      {
+        this->Clear();
+      }
+
+      /// \brief Get the size of the voxels.
+      /// \return Size of the voxels.
+      public: T VoxelSize() const
+      {
+        return this->voxelSize;
+      }
+
+      /// \brief Remove all the voxels.
+      public: void Clear()
+      {
+        this->nodes.assign(1, Node());
+        this->voxels.clear();
+      }
+
+      /// \brief Get the number of voxels holding points.
+      /// \return Number of voxels.
+      public: std::size_t VoxelCount() const
+      {
+        return this->voxels.size();
+      }
+
+      /// \brief Get the number of nodes of the tree, the root included.
+      /// \return Number of nodes.
+      public: std::size_t NodeCount() const
+      {
+        return this->nodes.size();
+      }
+
+      /// \brief Get the coordinates of the voxel that contains a point.
+      /// \param[in] _point The point.
+      /// \param[out] _voxel Coordinates of the voxel.
+      /// \return False if the point is not finite or its voxel is further
+      /// than kMaxVoxel from the origin.
+      public: bool VoxelCoordinates(const Vector3<T> &_point,
+                                    Vector3i &_voxel) const
+      {
+        int c[3];
+        for (int i = 0; i < 3; ++i)
+        {
+          const double v = std::floor(static_cast<double>(_point[i]) /
+                                      static_cast<double>(this->voxelSize));
+          if (!(v >= -kMaxVoxel && v <= kMaxVoxel))
+            return false;
+          c[i] = static_cast<int>(v);
+        }
+        _voxel.Set(c[0], c[1], c[2]);
+        return true;
+      }
+
+      /// \brief Get the Morton key of a voxel.
+      /// \param[in] _voxel Coordinates of the voxel, each one within
+      /// kMaxVoxel of 0.
+      /// \return The key, with the bits of x, y and z interleaved from the
+      /// least significant bit.
+      public: static std::uint64_t MortonKey(const Vector3i &_voxel)
+      {
+        return Spread(static_cast<std::uint32_t>(_voxel.X() + kMaxVoxel + 1))
+            | (Spread(static_cast<std::uint32_t>(_voxel.Y() + kMaxVoxel + 1))
+               << 1)
+            | (Spread(static_cast<std::uint32_t>(_voxel.Z() + kMaxVoxel + 1))
+               << 2);
+      }
+
+      /// \brief Get the voxel of a Morton key.
+      /// \param[in] _key The key.
+      /// \return Coordinates of the voxel.
+      /// \sa MortonKey
+      public: static Vector3i MortonVoxel(const std::uint64_t _key)
+      {
+        return Vector3i(
+            static_cast<int>(Compact(_key)) - kMaxVoxel - 1,
+            static_cast<int>(Compact(_key >> 1)) - kMaxVoxel - 1,
+            static_cast<int>(Compact(_key >> 2)) - kMaxVoxel - 1);
+      }
+
+      /// \brief Sort Morton keys and point indices by key with a radix sort,
+      /// which is several times faster than std::sort for the sizes of
+      /// scans. The order of points with equal keys is kept.
+      /// \param[in,out] _keys Keys and point indices.
+      public: static void SortKeys(
+                   std::vector<std::pair<std::uint64_t, std::size_t>> &_keys)
+      {
+        constexpr int kDigitBits = 11;
+        constexpr std::size_t kBuckets = std::size_t{1} << kDigitBits;
+        std::vector<std::pair<std::uint64_t, std::size_t>> buffer(
+            _keys.size());
+        std::vector<std::size_t> offsets(kBuckets);
+        for (int shift = 0; shift < 3 * kBits; shift += kDigitBits)
+        {
+          std::fill(offsets.begin(), offsets.end(), 0);
+          for (const auto &key : _keys)
+            offsets[(key.first >> shift) & (kBuckets - 1)]++;
+
+          // Skip the digits that are the same for every key, such as the
+          // high bits of the keys of a scan of a small area.
+          if (_keys.empty() ||
+              offsets[(_keys[0].first >> shift) & (kBuckets - 1)] ==
+              _keys.size())
+          {
+            continue;
+          }
+
+          std::size_t total = 0;
+          for (std::size_t &offset : offsets)
+          {
+            const std::size_t count = offset;
+            offset = total;
+            total += count;
+          }
+          for (const auto &key : _keys)
+            buffer[offsets[(key.first >> shift) & (kBuckets - 1)]++] = key;
+          _keys.swap(buffer);
+        }
+      }
+
+      /// \brief Insert a point.
+      /// \param[in] _point The point.
+      /// \return False if the point can't be stored, see VoxelCoordinates.
+      public: bool Insert(const Vector3<T> &_point)
+      {
+        Vector3i voxel;
+        if (!this->VoxelCoordinates(_point, voxel))
+          return false;
+        const std::uint64_t key = MortonKey(voxel);
+        std::uint32_t path[kBits];
+        path[0] = 0;
+        Voxel &v = this->voxels[this->FindOrAdd(key, path, 0)];
+        v.sum += _point - this->Corner(voxel);
+        v.count++;
+        return true;
+      }
+
+      /// \brief Insert an array of points. The points are sorted by key
+      /// first, so each voxel is looked up once and consecutive lookups
+      /// share the top of their path in the tree. The points of a voxel
+      /// are added in array order.
+      /// \param[in] _points The points.
+      /// \param[in] _count Number of points.
+      /// \return Number of points inserted, see Insert(const Vector3<T> &).
+      public: std::size_t Insert(const Vector3<T> *_points,
+                                 const std::size_t _count)
+      {
+        std::vector<std::pair<std::uint64_t, std::size_t>> keys;
+        keys.reserve(_count);
+        Vector3i voxel;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          if (this->VoxelCoordinates(_points[i], voxel))
+            keys.emplace_back(MortonKey(voxel), i);
+        }
+        SortKeys(keys);
+
+        std::uint32_t path[kBits];
+        path[0] = 0;
+        std::uint64_t previous = 0;
+        for (std::size_t i = 0; i < keys.size();)
+        {
+          const std::uint64_t key = keys[i].first;
+
+          // The nodes above the first level where the keys differ are the
+          // same as for the previous voxel.
+          int depth = 0;
+          if (i > 0)
+          {
+            const std::uint64_t diff = key ^ previous;
+            int bit = 63;
+            while (!(diff >> bit))
+              --bit;
+            depth = kBits - 1 - bit / 3;
+          }
+          Voxel &v = this->voxels[this->FindOrAdd(key, path, depth)];
+          const Vector3<T> corner = this->Corner(MortonVoxel(key));
+          for (; i < keys.size() && keys[i].first == key; ++i)
+          {
+            v.sum += _points[keys[i].second] - corner;
+            v.count++;
+          }
+          previous = key;
+        }
+        return keys.size();
+      }
+
+      /// \brief Find the voxel that contains a point.
+      /// \param[in] _point The point.
+      /// \param[out] _voxel Index of the voxel.
+      /// \return False if no point was inserted in the voxel.
+      public: bool Find(const Vector3<T> &_point, std::size_t &_voxel) const
+      {
+        Vector3i voxel;
+        if (!this->VoxelCoordinates(_point, voxel))
+          return false;
+        const std::uint64_t key = MortonKey(voxel);
+        std::uint32_t node = 0;
+        for (int depth = 0; depth < kBits; ++depth)
+        {
+          node = this->nodes[node].children[Slot(key, depth)];
+          if (node == kNone)
+            return false;
+        }
+        _voxel = node;
+        return true;
+      }
+
+      /// \brief Check whether a point was inserted in the voxel that
+      /// contains a position.
+      /// \param[in] _point The position.
+      /// \return True if the voxel holds points.
+      public: bool Occupied(const Vector3<T> &_point) const
+      {
+        std::size_t voxel;
+        return this->Find(_point, voxel);
+      }
+
+      /// \brief Get the coordinates of a voxel.
+      /// \param[in] _voxel Index of the voxel, less than VoxelCount().
+      /// \return Coordinates of the voxel.
+      public: Vector3i VoxelCoordinates(const std::size_t _voxel) const
+      {
+        return MortonVoxel(this->voxels[_voxel].key);
+      }
+
+      /// \brief Get the Morton key of a voxel.
+      /// \param[in] _voxel Index of the voxel, less than VoxelCount().
+      /// \return Key of the voxel.
+      public: std::uint64_t Key(const std::size_t _voxel) const
+      {
+        return this->voxels[_voxel].key;
+      }
+
+      /// \brief Get the number of points inserted in a voxel.
+      /// \param[in] _voxel Index of the voxel, less than VoxelCount().
+      /// \return Number of points.
+      public: std::size_t PointCount(const std::size_t _voxel) const
+      {
+        return this->voxels[_voxel].count;
+      }
+
+      /// \brief Get the centroid of the points inserted in a voxel.
+      /// \param[in] _voxel Index of the voxel, less than VoxelCount().
+      /// \return Centroid of the points.
+      public: Vector3<T> Centroid(const std::size_t _voxel) const
+      {
+        const Voxel &v = this->voxels[_voxel];
+        return this->Corner(MortonVoxel(v.key)) +
+            v.sum / static_cast<T>(v.count);
+      }
+
+      /// \brief Get the centroids of all the voxels, the usual output of
+      /// voxel grid downsampling.
+      /// \param[out] _centroids Centroid of each voxel, in voxel order.
+      public: void Centroids(std::vector<Vector3<T>> &_centroids) const
+      {
+        _centroids.resize(this->voxels.size());
+        for (std::size_t i = 0; i < this->voxels.size(); ++i)
+          _centroids[i] = this->Centroid(i);
+      }
+
+      /// \brief Get the box covered by a voxel.
+      /// \param[in] _voxel Index of the voxel, less than VoxelCount().
+      /// \return The box of the voxel.
+      public: AxisAlignedBox VoxelBox(const std::size_t _voxel) const
+      {
+        const Vector3i c = this->VoxelCoordinates(_voxel);
+        const double size = this->voxelSize;
+        return AxisAlignedBox(c.X() * size, c.Y() * size, c.Z() * size,
+            (c.X() + 1) * size, (c.Y() + 1) * size, (c.Z() + 1) * size);
+      }
+
+      /// \brief Find the voxels that overlap a box.
+      /// \param[in] _box The box.
+      /// \param[out] _voxels Indices of the voxels, in Morton order. It is
+      /// cleared first.
+      public: void Intersects(const AxisAlignedBox &_box,
+                              std::vector<std::size_t> &_voxels) const
+      {
+        _voxels.clear();
+        std::uint32_t lo[3];
+        std::uint32_t hi[3];
+        for (int i = 0; i < 3; ++i)
+        {
+          // Voxel coordinates of the box, offset as in the keys.
+          const double offset = kMaxVoxel + 1;
+          const double size = this->voxelSize;
+          const double a = std::floor(_box.Min()[i] / size) + offset;
+          const double b = std::floor(_box.Max()[i] / size) + offset;
+          if (!(a <= b) || b < 0 || a > 2.0 * kMaxVoxel + 1)
+            return;
+          lo[i] = static_cast<std::uint32_t>(std::max(a, 0.0));
+          hi[i] = static_cast<std::uint32_t>(
+              std::min(b, 2.0 * kMaxVoxel + 1));
+        }
+        this->CollectVoxels(0, 0, 0, 0, 0, lo, hi, _voxels);
+      }
+
+      /// \brief A node of the tree. A child of a node of depth kBits - 1 is
+      /// the index of a voxel, others are indices of nodes.
+      private: struct Node
+      {
+        /// \brief Children indexed by the three key bits of their level,
+        /// kNone for no child.
+        std::uint32_t children[8] = {kNone, kNone, kNone, kNone,
+                                     kNone, kNone, kNone, kNone};
+      };
+
+      /// \brief A voxel holding points.
+      private: struct Voxel
+      {
+        /// \brief Morton key of the voxel.
+        std::uint64_t key = 0;
+
+        /// \brief Sum of the points relative to the low corner of the
+        /// voxel, which keeps the sum precise far from the origin.
+        Vector3<T> sum = Vector3<T>::Zero;
+
+        /// \brief Number of points.
+        std::size_t count = 0;
+      };
+
+      /// \brief Marks a missing child.
+      private: static constexpr std::uint32_t kNone =
+          std::numeric_limits<std::uint32_t>::max();
+
+      /// \brief Spread the 21 low bits of a value to every third bit.
+      /// \param[in] _v The value.
+      /// \return The spread bits.
+      private: static std::uint64_t Spread(const std::uint32_t _v)
+      {
+        std::uint64_t x = _v & 0x1fffff;
+        x = (x | x << 32) & 0x1f00000000ffffull;
+        x = (x | x << 16) & 0x1f0000ff0000ffull;
+        x = (x | x << 8) & 0x100f00f00f00f00full;
+        x = (x | x << 4) & 0x10c30c30c30c30c3ull;
+        x = (x | x << 2) & 0x1249249249249249ull;
+        return x;
+      }
+
+      /// \brief Gather every third bit of a value, the inverse of Spread.
+      /// \param[in] _v The value.
+      /// \return The gathered bits.
+      private: static std::uint32_t Compact(const std::uint64_t _v)
+      {
+        std::uint64_t x = _v & 0x1249249249249249ull;
+        x = (x | x >> 2) & 0x10c30c30c30c30c3ull;
+        x = (x | x >> 4) & 0x100f00f00f00f00full;
+        x = (x | x >> 8) & 0x1f0000ff0000ffull;
+        x = (x | x >> 16) & 0x1f00000000ffffull;
+        x = (x | x >> 32) & 0x1fffff;
+        return static_cast<std::uint32_t>(x);
+      }
+
+      /// \brief Get the child slot of a key at a depth of the tree.
+      /// \param[in] _key The key.
+      /// \param[in] _depth Depth of the parent node, the root being 0.
+      /// \return Slot of the child, in [0, 8).
+      private: static unsigned int Slot(const std::uint64_t _key,
+                                        const int _depth)
+      {
+        return static_cast<unsigned int>(
+            (_key >> (3 * (kBits - 1 - _depth))) & 7);
+      }
+
+      /// \brief Get the low corner of a voxel.
+      /// \param[in] _voxel Coordinates of the voxel.
+      /// \return The corner.
+      private: Vector3<T> Corner(const Vector3i &_voxel) const
+      {
+        return Vector3<T>(static_cast<T>(_voxel.X() * this->voxelSize),
+                          static_cast<T>(_voxel.Y() * this->voxelSize),
+                          static_cast<T>(_voxel.Z() * this->voxelSize));
+      }
+
+      /// \brief Find the voxel of a key, adding it and the nodes above it
+      /// if needed.
+      /// \param[in] _key Key of the voxel.
+      /// \param[in,out] _path Node at each depth on the way to the voxel,
+      /// valid up to _depth on input.
+      /// \param[in] _depth Depth to start from.
+      /// \return Index of the voxel.
+      private: std::size_t FindOrAdd(const std::uint64_t _key,
+                                     std::uint32_t *_path, const int _depth)
+      {
+        // Children are read and written by index since adding a node may
+        // move the array.
+        for (int depth = _depth; depth < kBits - 1; ++depth)
+        {
+          const unsigned int slot = Slot(_key, depth);
+          std::uint32_t child = this->nodes[_path[depth]].children[slot];
+          if (child == kNone)
+          {
+            child = static_cast<std::uint32_t>(this->nodes.size());
+            this->nodes.emplace_back();
+            this->nodes[_path[depth]].children[slot] = child;
+          }
+          _path[depth + 1] = child;
+        }
+
+        std::uint32_t &child =
+            this->nodes[_path[kBits - 1]].children[Slot(_key, kBits - 1)];
+        if (child == kNone)
+        {
+          child = static_cast<std::uint32_t>(this->voxels.size());
+          this->voxels.emplace_back();
+          this->voxels.back().key = _key;
+        }
+        return child;
+      }
+
+      /// \brief Collect the voxels under a node that overlap a range of
+      /// voxel coordinates.
+      /// \param[in] _node Index of the node.
+      /// \param[in] _depth Depth of the node.
+      /// \param[in] _x Offset x coordinate of the first voxel of the node.
+      /// \param[in] _y Offset y coordinate of the first voxel of the node.
+      /// \param[in] _z Offset z coordinate of the first voxel of the node.
+      /// \param[in] _lo Lowest offset coordinates of the range.
+      /// \param[in] _hi Highest offset coordinates of the range.
+      /// \param[in,out] _voxels Indices of the voxels found.
+      private: void CollectVoxels(const std::uint32_t _node, const int _depth,
+                                  const std::uint32_t _x,
+                                  const std::uint32_t _y,
+                                  const std::uint32_t _z,
+                                  const std::uint32_t *_lo,
+                                  const std::uint32_t *_hi,
+                                  std::vector<std::size_t> &_voxels) const
+      {
+        // Side of the cubes of the children, in voxels.
+        const std::uint32_t side = 1u << (kBits - 1 - _depth);
+        for (unsigned int slot = 0; slot < 8; ++slot)
+        {
+          const std::uint32_t child = this->nodes[_node].children[slot];
+          if (child == kNone)
+            continue;
+          const std::uint32_t x = _x + ((slot & 1) ? side : 0);
+          const std::uint32_t y = _y + ((slot & 2) ? side : 0);
+          const std::uint32_t z = _z + ((slot & 4) ? side : 0);
+          if (x > _hi[0] || x + side - 1 < _lo[0] ||
+              y > _hi[1] || y + side - 1 < _lo[1] ||
+              z > _hi[2] || z + side - 1 < _lo[2])
+          {
+            continue;
+          }
+          if (_depth == kBits - 1)
+            _voxels.push_back(child);
+          else
+            this->CollectVoxels(child, _depth + 1, x, y, z, _lo, _hi,
+                                _voxels);
+        }
+      }
+
+      /// \brief Size of the voxels.
+      private: T voxelSize;
+
+      /// \brief Nodes of the tree, the root first.
+      private: std::vector<Node> nodes;
+
+      /// \brief Voxels holding points, in order of creation.
+      private: std::vector<Voxel> voxels;
+    };
+    }
+  }
+}
+#endif
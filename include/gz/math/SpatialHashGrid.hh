@@ -0,0 +1,443 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_SPATIALHASHGRID_HH_
+#define GZ_MATH_SPATIALHASHGRID_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+#include <gz/math/VectorHash.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class SpatialHashGrid SpatialHashGrid.hh gz/math/SpatialHashGrid.hh
+    /// \brief A grid of cubic cells holding points, stored in a hash map of
+    /// the non-empty cells, to find the points near a position without
+    /// computing the distance to every point. This is the usual broadphase
+    /// of particle and collision code.
+    ///
+    /// Inserting, moving and removing a point take constant time. Finding
+    /// the points within a distance of a position visits the cells that
+    /// overlap the box around the position, which are the 27 cells around
+    /// it when the distance is at most the size of a cell. So the cell size
+    /// is best set to the usual query distance, such as the diameter of
+    /// the particles.
+    ///
+    /// Points are identified by the index returned by Insert. The index of
+    /// a removed point is reused by the next insertion.
+    ///
+    /// # Example usage
+    ///
+    /// ```{.cpp}
+    /// gz::math::SpatialHashGrid<double> grid(0.1);
+    /// for (const auto &p : particles)
+    ///   grid.Insert(p);
+    /// std::vector<std::pair<std::size_t, std::size_t>> contacts;
+    /// grid.Pairs(0.1, contacts);
+    /// ```
+    /// \tparam T Floating point type of the coordinates.
+    template<typename T>
+    class SpatialHashGrid
+    {
+      /// \brief Constructor.
+      /// \param[in] _cellSize Size of the cells, which must be positive.
+      public: explicit SpatialHashGrid(const T _cellSize = 1)
+        : cellSize(_cellSize)
+      {
+      }
+
+      /// \brief Get the size of the cells.
+      /// \return Size of the cells.
+      public: T CellSize() const
+      {
+        return this->cellSize;
+      }
+
+      /// \brief Get the cell that contains a position, floor(_position /
+      /// cell size), clamped to the range of int.
+      /// \param[in] _position The position.
+      /// \return Coordinates of the cell.
+      public: Vector3i Cell(const Vector3<T> &_position) const
+      {
+        return Vector3i(this->CellIndex(_position.X()),
+                        this->CellIndex(_position.Y()),
+                        this->CellIndex(_position.Z()));
+      }
+
+      /// \brief Insert a point.
+      /// \param[in] _position Position of the point.
+      /// \return Index of the point.
+      public: std::size_t Insert(const Vector3<T> &_position)
+      {
+        std::size_t id;
+        if (this->free.empty())
+        {
+          id = this->points.size();
+          this->points.emplace_back();
+        }
+        else
+        {
+          id = this->free.back();
+          this->free.pop_back();
+        }
+
+        Point &point = this->points[id];
+        point.position = _position;
+        point.cell = this->Cell(_position);
+        point.used = true;
+        this->Link(id);
+        ++this->size;
+        return id;
+      }
+
+      /// \brief Move a point. This only updates the cells when the point
+      /// moves to another cell.
+      /// \param[in] _id Index of the point.
+      /// \param[in] _position New position of the point.
+      /// \return False if there is no point with this index.
+      public: bool Update(const std::size_t _id, const Vector3<T> &_position)
+      {
+        if (!this->Contains(_id))
+          return false;
+
+        Point &point = this->points[_id];
+        point.position = _position;
+        const Vector3i cell = this->Cell(_position);
+        if (cell != point.cell)
+        {
+          this->Unlink(_id);
+          point.cell = cell;
+          this->Link(_id);
+        }
+        return true;
+      }
+
+      /// \brief Remove a point.
+      /// \param[in] _id Index of the point.
+      /// \return False if there is no point with this index.
+      public: bool Remove(const std::size_t _id)
+      {
+        if (!this->Contains(_id))
+          return false;
+
+        this->Unlink(_id);
+        this->points[_id].used = false;
+        this->free.push_back(_id);
+        --this->size;
+        return true;
+      }
+
+      /// \brief Remove all the points.
+      public: void Clear()
+      {
+        this->points.clear();
+        this->free.clear();
+        this->cells.clear();
+        this->size = 0;
+      }
+
+      /// \brief Get the number of points.
+      /// \return Number of points in the grid.
+      public: std::size_t Size() const
+      {
+        return this->size;
+      }
+
+      /// \brief Get the number of non-empty cells.
+      /// \return Number of cells holding points.
+      public: std::size_t CellCount() const
+      {
+        return this->cells.size();
+      }
+
+      /// \brief Get the position of a point.
+      /// \param[in] _id Index of the point.
+      /// \param[out] _position Position of the point.
+      /// \return False if there is no point with this index.
+      public: bool Position(const std::size_t _id, Vector3<T> &_position) const
+      {
+        if (!this->Contains(_id))
+          return false;
+        _position = this->points[_id].position;
+        return true;
+      }
+
+      /// \brief Call a function with the index of every point in the cells
+      /// that overlap the cube of half side _distance around a position.
+      /// These are the candidates of a query, some can be farther than
+      /// _distance.
+      /// \param[in] _position The position.
+      /// \param[in] _distance Half side of the cube.
+      /// \param[in] _func Called with the index of each point.
+      public: template<typename Func>
+      void ForEachCandidate(const Vector3<T> &_position, const T _distance,
+                            Func _func) const
+      {
+        const Vector3i lo = this->Cell(_position - Vector3<T>(
+            _distance, _distance, _distance));
+        const Vector3i hi = this->Cell(_position + Vector3<T>(
+            _distance, _distance, _distance));
+
+        // Visit the non-empty cells rather than the cells of the cube when
+        // they are fewer
+        const double cubeCells =
+            (static_cast<double>(hi.X()) - lo.X() + 1) *
+            (static_cast<double>(hi.Y()) - lo.Y() + 1) *
+            (static_cast<double>(hi.Z()) - lo.Z() + 1);
+        if (cubeCells > static_cast<double>(this->cells.size()))
+        {
+          for (const auto &[cell, ids] : this->cells)
+          {
+            if (cell.X() >= lo.X() && cell.X() <= hi.X() &&
+                cell.Y() >= lo.Y() && cell.Y() <= hi.Y() &&
+                cell.Z() >= lo.Z() && cell.Z() <= hi.Z())
+            {
+              for (const std::size_t id : ids)
+                _func(id);
+            }
+          }
+          return;
+        }
+
+        // 64 bit counters, which don't overflow past cells clamped to the
+        // range of int
+        for (std::int64_t x = lo.X(); x <= hi.X(); ++x)
+        {
+          for (std::int64_t y = lo.Y(); y <= hi.Y(); ++y)
+          {
+            for (std::int64_t z = lo.Z(); z <= hi.Z(); ++z)
+            {
+              const auto it = this->cells.find(Vector3i(
+                  static_cast<int>(x), static_cast<int>(y),
+                  static_cast<int>(z)));
+              if (it == this->cells.end())
+                continue;
+              for (const std::size_t id : it->second)
+                _func(id);
+            }
+          }
+        }
+      }
+
+      /// \brief Find the points within a distance of a position.
+      /// \param[in] _position The position.
+      /// \param[in] _distance Maximum distance.
+      /// \param[out] _ids Indices of the points, in no particular order. It
+      /// is cleared first.
+      public: void WithinDistance(const Vector3<T> &_position,
+                                  const T _distance,
+                                  std::vector<std::size_t> &_ids) const
+      {
+        _ids.clear();
+        const T distance2 = _distance * _distance;
+        this->ForEachCandidate(_position, _distance,
+            [&](const std::size_t _id)
+            {
+              if ((this->points[_id].position - _position).SquaredLength() <=
+                  distance2)
+              {
+                _ids.push_back(_id);
+              }
+            });
+      }
+
+      /// \brief Find all the pairs of points within a distance of each
+      /// other.
+      /// \param[in] _distance Maximum distance.
+      /// \param[out] _pairs Pairs of indices, with the smaller index first,
+      /// in no particular order. It is cleared first.
+      public: void Pairs(const T _distance,
+                  std::vector<std::pair<std::size_t, std::size_t>> &_pairs)
+                  const
+      {
+        _pairs.clear();
+        const T distance2 = _distance * _distance;
+        auto addPair = [&](const std::size_t _a, const std::size_t _b)
+        {
+          if ((this->points[_a].position -
+               this->points[_b].position).SquaredLength() <= distance2)
+          {
+            _pairs.emplace_back(std::min(_a, _b), std::max(_a, _b));
+          }
+        };
+
+        // When the distance is at most the size of a cell, pair each cell
+        // with itself and half of its 26 neighbors, so that each pair of
+        // cells is looked up once.
+        if (_distance <= this->cellSize)
+        {
+          for (const auto &[cell, ids] : this->cells)
+          {
+            for (std::size_t i = 0; i < ids.size(); ++i)
+            {
+              for (std::size_t j = i + 1; j < ids.size(); ++j)
+                addPair(ids[i], ids[j]);
+            }
+
+            for (const auto &offset : kHalfNeighbors)
+            {
+              // Cells clamped to the range of int have no neighbor past it
+              if ((offset[0] > 0 && cell.X() == kMaxCell) ||
+                  (offset[0] < 0 && cell.X() == kMinCell) ||
+                  (offset[1] > 0 && cell.Y() == kMaxCell) ||
+                  (offset[1] < 0 && cell.Y() == kMinCell) ||
+                  (offset[2] > 0 && cell.Z() == kMaxCell))
+              {
+                continue;
+              }
+              const auto it = this->cells.find(Vector3i(
+                  cell.X() + offset[0], cell.Y() + offset[1],
+                  cell.Z() + offset[2]));
+              if (it == this->cells.end())
+                continue;
+              for (const std::size_t a : ids)
+              {
+                for (const std::size_t b : it->second)
+                  addPair(a, b);
+              }
+            }
+          }
+          return;
+        }
+
+        for (std::size_t i = 0; i < this->points.size(); ++i)
+        {
+          if (!this->points[i].used)
+            continue;
+          const Vector3<T> &position = this->points[i].position;
+          this->ForEachCandidate(position, _distance,
+              [&](const std::size_t _id)
+              {
+                if (_id > i &&
+                    (this->points[_id].position - position).SquaredLength() <=
+                    distance2)
+                {
+                  _pairs.emplace_back(i, _id);
+                }
+              });
+        }
+      }
+
+      /// \brief Get the index of the cell of a coordinate, clamped to the
+      /// range of int.
+      /// \param[in] _value The coordinate.
+      /// \return Index of the cell.
+      private: int CellIndex(const T _value) const
+      {
+        return static_cast<int>(std::clamp<std::int64_t>(
+            detail::CellIndex(_value, this->cellSize), kMinCell, kMaxCell));
+      }
+
+      /// \brief Tell whether there is a point with an index.
+      /// \param[in] _id Index of the point.
+      /// \return True if there is a point with this index.
+      private: bool Contains(const std::size_t _id) const
+      {
+        return _id < this->points.size() && this->points[_id].used;
+      }
+
+      /// \brief Add a point to the list of its cell.
+      /// \param[in] _id Index of the point.
+      private: void Link(const std::size_t _id)
+      {
+        std::vector<std::size_t> &ids = this->cells[this->points[_id].cell];
+        this->points[_id].slot = ids.size();
+        ids.push_back(_id);
+      }
+
+      /// \brief Remove a point from the list of its cell, replacing it with
+      /// the last point of the list.
+      /// \param[in] _id Index of the point.
+      private: void Unlink(const std::size_t _id)
+      {
+        const auto it = this->cells.find(this->points[_id].cell);
+        std::vector<std::size_t> &ids = it->second;
+        const std::size_t slot = this->points[_id].slot;
+        ids[slot] = ids.back();
+        this->points[ids[slot]].slot = slot;
+        ids.pop_back();
+        if (ids.empty())
+          this->cells.erase(it);
+      }
+
+      /// \brief Smallest cell index.
+      private: static constexpr int kMinCell = std::numeric_limits<int>::min();
+
+      /// \brief Largest cell index.
+      private: static constexpr int kMaxCell = std::numeric_limits<int>::max();
+
+      /// \brief Offsets of the 13 neighbors of a cell that come after it in
+      /// lexicographic order. With the opposite offsets, they make the 26
+      /// neighbors.
+      private: static constexpr int kHalfNeighbors[13][3] = {
+        {1, -1, -1}, {1, -1, 0}, {1, -1, 1},
+        {1, 0, -1}, {1, 0, 0}, {1, 0, 1},
+        {1, 1, -1}, {1, 1, 0}, {1, 1, 1},
+        {0, 1, -1}, {0, 1, 0}, {0, 1, 1},
+        {0, 0, 1}};
+
+      /// \brief A point of the grid.
+      private: struct Point
+      {
+        /// \brief Position of the point.
+        Vector3<T> position;
+
+        /// \brief Cell of the point.
+        Vector3i cell;
+
+        /// \brief Position of the point in the list of its cell.
+        std::size_t slot = 0;
+
+        /// \brief False if the index of the point is free.
+        bool used = false;
+      };
+
+      /// \brief Size of the cells.
+      private: T cellSize;
+
+      /// \brief Points, indexed by their index.
+      private: std::vector<Point> points;
+
+      /// \brief Free indices, reused by Insert.
+      private: std::vector<std::size_t> free;
+
+      /// \brief Indices of the points of each non-empty cell.
+      private: std::unordered_map<Vector3i, std::vector<std::size_t>> cells;
+
+      /// \brief Number of points.
+      private: std::size_t size = 0;
+    };
+
+    typedef SpatialHashGrid<double> SpatialHashGridd;
+    typedef SpatialHashGrid<float> SpatialHashGridf;
+    }
+  }
+}
+#endif
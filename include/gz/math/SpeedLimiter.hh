@@ -19,6 +19,8 @@
 #define GZ_MATH_SYSTEMS_SPEEDLIMITER_HH_
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <gz/math/config.hh>
 #include "gz/math/Helpers.hh"
@@ -130,6 +132,41 @@ inline namespace GZ_MATH_VERSION_NAMESPACE {
         double _prevPrevVel,
         std::chrono::steady_clock::duration _dt) const;
 
+    /// \brief Flag of LimitBatch for an element whose velocity limit was
+    /// engaged.
+    public: static constexpr uint8_t kVelocityLimited = 1;
+
+    /// \brief Flag of LimitBatch for an element whose acceleration limit
+    /// was engaged.
+    public: static constexpr uint8_t kAccelerationLimited = 2;
+
+    /// \brief Flag of LimitBatch for an element whose jerk limit was
+    /// engaged.
+    public: static constexpr uint8_t kJerkLimited = 4;
+
+    /// \brief Limit velocity, acceleration and jerk of many elements, such
+    /// as the axes of many vehicles, with the same limits. This gives the
+    /// same velocities as calling Limit for each element, in loops the
+    /// compiler can vectorize.
+    /// \param [in, out] _vel Velocities to limit [m/s], _count values.
+    /// \param [in] _prevVel Previous velocities to _vel [m/s], _count
+    /// values.
+    /// \param [in] _prevPrevVel Previous velocities to _prevVel [m/s],
+    /// _count values.
+    /// \param [in] _count Number of elements.
+    /// \param [in] _dt Time step.
+    /// \param [out] _limited If not null, _count values set to the
+    /// combination of kVelocityLimited, kAccelerationLimited and
+    /// kJerkLimited of the limits that were engaged for each element, that
+    /// is the limits the element's velocity, acceleration or jerk was
+    /// outside of.
+    public: void LimitBatch(double *_vel,
+                            const double *_prevVel,
+                            const double *_prevPrevVel,
+                            size_t _count,
+                            std::chrono::steady_clock::duration _dt,
+                            uint8_t *_limited = nullptr) const;
+
 #ifdef _WIN32
 // Disable warning C4251 which is triggered by
 // std::unique_ptr
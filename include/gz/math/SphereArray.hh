@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_SPHEREARRAY_HH_
+#define GZ_MATH_SPHEREARRAY_HH_
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class SphereArray SphereArray.hh gz/math/SphereArray.hh
+    /// \brief A structure-of-arrays container of placed spheres for
+    /// distance and contact queries between many of them, such as the
+    /// agents of a crowd simulation.
+    ///
+    /// Each sphere is a center and a radius, with every component in its
+    /// own contiguous buffer. Distances are between the surfaces, and are
+    /// negative when the spheres overlap, by their penetration depth.
+    /// Sphere only describes the shape, without a position.
+    ///
+    /// # Example
+    ///
+    /// \code{.cpp}
+    /// gz::math::SphereArrayd agents;
+    /// agents.Assign(positions.data(), radii.data(), positions.size());
+    /// // Pairs from a broadphase such as SweepAndPrune
+    /// agents.Distances(first.data(), second.data(), first.size(),
+    ///                  distances.data(), normals.data());
+    /// \endcode
+    /// \tparam T Floating point type of the coordinates.
+    template<typename T>
+    class SphereArray
+    {
+      static_assert(std::is_floating_point_v<T>,
+          "SphereArray requires a floating point type");
+
+      /// \brief Default constructor, creates an empty array.
+      public: SphereArray() = default;
+
+      /// \brief Replace the contents of this array.
+      /// \param[in] _centers Centers of the spheres.
+      /// \param[in] _radii Radii of the spheres.
+      /// \param[in] _count Number of spheres.
+      public: void Assign(const Vector3<T> *_centers, const T *_radii,
+                          const std::size_t _count)
+      {
+        this->Clear();
+        for (std::size_t i = 0; i < _count; ++i)
+          this->Add(_centers[i], _radii[i]);
+      }
+
+      /// \brief Add a sphere at the end of this array.
+      /// \param[in] _center Center of the sphere.
+      /// \param[in] _radius Radius of the sphere.
+      public: void Add(const Vector3<T> &_center, const T _radius)
+      {
+        this->x.push_back(_center.X());
+        this->y.push_back(_center.Y());
+        this->z.push_back(_center.Z());
+        this->radii.push_back(_radius);
+      }
+
+      /// \brief Replace a sphere.
+      /// \param[in] _index Index of the sphere. It is not checked.
+      /// \param[in] _center Center of the sphere.
+      /// \param[in] _radius Radius of the sphere.
+      public: void SetSphere(const std::size_t _index,
+                             const Vector3<T> &_center, const T _radius)
+      {
+        this->x[_index] = _center.X();
+        this->y[_index] = _center.Y();
+        this->z[_index] = _center.Z();
+        this->radii[_index] = _radius;
+      }
+
+      /// \brief Remove all the spheres.
+      public: void Clear()
+      {
+        this->x.clear();
+        this->y.clear();
+        this->z.clear();
+        this->radii.clear();
+      }
+
+      /// \brief Get the number of spheres.
+      /// \return Number of spheres.
+      public: std::size_t Size() const
+      {
+        return this->radii.size();
+      }
+
+      /// \brief Check whether the array is empty.
+      /// \return True if the array holds no sphere.
+      public: bool Empty() const
+      {
+        return this->radii.empty();
+      }
+
+      /// \brief Get the center of a sphere.
+      /// \param[in] _index Index of the sphere. It is not checked.
+      /// \return The center.
+      public: Vector3<T> Center(const std::size_t _index) const
+      {
+        return Vector3<T>(this->x[_index], this->y[_index], this->z[_index]);
+      }
+
+      /// \brief Get the radius of a sphere.
+      /// \param[in] _index Index of the sphere. It is not checked.
+      /// \return The radius.
+      public: T Radius(const std::size_t _index) const
+      {
+        return this->radii[_index];
+      }
+
+      /// \brief Get the distance between two spheres.
+      /// \param[in] _center1 Center of the first sphere.
+      /// \param[in] _radius1 Radius of the first sphere.
+      /// \param[in] _center2 Center of the second sphere.
+      /// \param[in] _radius2 Radius of the second sphere.
+      /// \return Distance between the surfaces, negative if they overlap.
+      public: static T Distance(const Vector3<T> &_center1, const T _radius1,
+                                const Vector3<T> &_center2, const T _radius2)
+      {
+        return _center1.Distance(_center2) - _radius1 - _radius2;
+      }
+
+      /// \brief Get the distance from a sphere to every sphere of this
+      /// array.
+      /// \param[in] _center Center of the sphere.
+      /// \param[in] _radius Radius of the sphere.
+      /// \param[out] _distances Distance to each sphere of this array. It
+      /// must hold Size() values.
+      public: void Distances(const Vector3<T> &_center, const T _radius,
+                             T *_distances) const
+      {
+        const T *xs = this->x.data();
+        const T *ys = this->y.data();
+        const T *zs = this->z.data();
+        const T *rs = this->radii.data();
+        for (std::size_t i = 0; i < this->Size(); ++i)
+        {
+          const T dx = xs[i] - _center.X();
+          const T dy = ys[i] - _center.Y();
+          const T dz = zs[i] - _center.Z();
+          _distances[i] = std::sqrt(dx * dx + dy * dy + dz * dz) - rs[i] -
+                          _radius;
+        }
+      }
+
+      /// \brief Get the distances and contact normals of pairs of spheres
+      /// of this array, such as the pairs found by a broadphase.
+      /// \param[in] _first Index of the first sphere of each pair. It is
+      /// not checked.
+      /// \param[in] _second Index of the second sphere of each pair. It is
+      /// not checked.
+      /// \param[in] _count Number of pairs.
+      /// \param[out] _distances Distance of each pair, negative if the
+      /// spheres overlap.
+      /// \param[out] _normals Unit vector from the center of the first
+      /// sphere to the center of the second one for each pair, zero if the
+      /// centers are the same, or nullptr.
+      public: void Distances(const std::size_t *_first,
+                             const std::size_t *_second,
+                             const std::size_t _count, T *_distances,
+                             Vector3<T> *_normals = nullptr) const
+      {
+        for (std::size_t k = 0; k < _count; ++k)
+        {
+          const std::size_t i = _first[k];
+          const std::size_t j = _second[k];
+          const T dx = this->x[j] - this->x[i];
+          const T dy = this->y[j] - this->y[i];
+          const T dz = this->z[j] - this->z[i];
+          const T length = std::sqrt(dx * dx + dy * dy + dz * dz);
+          _distances[k] = length - this->radii[i] - this->radii[j];
+          if (_normals)
+          {
+            const T scale = length > 0 ? 1 / length : T(0);
+            _normals[k].Set(dx * scale, dy * scale, dz * scale);
+          }
+        }
+      }
+
+      /// \brief The x components of the centers.
+      private: std::vector<T> x;
+
+      /// \brief The y components of the centers.
+      private: std::vector<T> y;
+
+      /// \brief The z components of the centers.
+      private: std::vector<T> z;
+
+      /// \brief The radii.
+      private: std::vector<T> radii;
+    };
+
+    using SphereArrayd = SphereArray<double>;
+    using SphereArrayf = SphereArray<float>;
+    }
+  }
+}
+#endif
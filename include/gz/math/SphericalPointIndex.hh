@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_SPHERICALPOINTINDEX_HH_
+#define GZ_MATH_SPHERICALPOINTINDEX_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gz/math/Angle.hh>
+#include <gz/math/Export.hh>
+#include <gz/math/SphericalCoordinates.hh>
+#include <gz/math/config.hh>
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class SphericalPointIndex SphericalPointIndex.hh
+    /// gz/math/SphericalPointIndex.hh
+    /// \brief A spatial index of points given by latitude and longitude,
+    /// used to find the points near a position without computing the
+    /// distance to every point.
+    ///
+    /// The points are stored in a quadtree of tiles. The root tile covers
+    /// the whole surface, and each tile is split into four tiles at its
+    /// middle latitude and longitude when it holds too many points, so the
+    /// tiles follow the density of the points. A tile is identified by a
+    /// key, like a geohash, see TileKey.
+    ///
+    /// Distances are great circle distances on the sphere of the surface
+    /// radius of a SphericalCoordinates, as computed by
+    /// SphericalCoordinates::DistanceBetweenPoints. Queries skip every tile
+    /// whose closest point is too far from the query position.
+    ///
+    /// Points are identified by the index returned by Insert, or by their
+    /// position in the arrays passed to Build. The index of a removed point
+    /// is reused by the next insertion.
+    ///
+    /// # Example usage
+    ///
+    /// ```{.cpp}
+    /// gz::math::SphericalPointIndex index;
+    /// index.Build(lat.data(), lon.data(), lat.size());
+    /// std::vector<std::size_t> ids;
+    /// std::vector<double> distances;
+    /// index.Nearest(gz::math::Angle(0.8), gz::math::Angle(0.1), 5,
+    ///     ids, distances);
+    /// ```
+    class GZ_MATH_VISIBLE SphericalPointIndex
+    {
+      /// \brief Constructor, creates an empty index on the surface of the
+      /// Earth.
+      public: SphericalPointIndex();
+
+      /// \brief Constructor, creates an empty index on a surface.
+      /// \param[in] _sc Spherical coordinates whose surface radius is used
+      /// for the distances.
+      public: explicit SphericalPointIndex(const SphericalCoordinates &_sc);
+
+      /// \brief Get the radius of the sphere of the distances.
+      /// \return Radius in meters.
+      public: double SurfaceRadius() const;
+
+      /// \brief Replace the contents of the index with a set of points. This
+      /// builds the tiles top down, which is faster than inserting the
+      /// points one by one.
+      /// \param[in] _lat Pointer to the first latitude in radians.
+      /// \param[in] _lon Pointer to the first longitude in radians.
+      /// \param[in] _count Number of points. The index of each point is its
+      /// position in the arrays.
+      public: void Build(const double *_lat, const double *_lon,
+                         const std::size_t _count);
+
+      /// \brief Add a point.
+      /// \param[in] _lat Latitude of the point.
+      /// \param[in] _lon Longitude of the point.
+      /// \return Index of the point.
+      public: std::size_t Insert(const Angle &_lat, const Angle &_lon);
+
+      /// \brief Remove a point.
+      /// \param[in] _id Index of the point.
+      /// \return False if there is no point with this index.
+      public: bool Remove(const std::size_t _id);
+
+      /// \brief Remove all the points.
+      public: void Clear();
+
+      /// \brief Get the number of points.
+      /// \return Number of points in the index.
+      public: std::size_t Size() const;
+
+      /// \brief Get the position of a point.
+      /// \param[in] _id Index of the point.
+      /// \param[out] _lat Latitude of the point.
+      /// \param[out] _lon Longitude of the point, in [-pi, pi].
+      /// \return False if there is no point with this index.
+      public: bool Point(const std::size_t _id, Angle &_lat, Angle &_lon) const;
+
+      /// \brief Find the points within a distance of a position.
+      /// \param[in] _lat Latitude of the position.
+      /// \param[in] _lon Longitude of the position.
+      /// \param[in] _distance Maximum distance in meters.
+      /// \param[out] _ids Indices of the points, in no particular order. It
+      /// is cleared first.
+      public: void WithinDistance(const Angle &_lat, const Angle &_lon,
+                                  const double _distance,
+                                  std::vector<std::size_t> &_ids) const;
+
+      /// \brief Find the points closest to a position.
+      /// \param[in] _lat Latitude of the position.
+      /// \param[in] _lon Longitude of the position.
+      /// \param[in] _k Maximum number of points to find.
+      /// \param[out] _ids Indices of the closest points, from the closest
+      /// to the farthest, with ties ordered by index. It is cleared first.
+      /// \param[out] _distances Distances in meters to the points in _ids.
+      /// It is cleared first.
+      public: void Nearest(const Angle &_lat, const Angle &_lon,
+                           const std::size_t _k,
+                           std::vector<std::size_t> &_ids,
+                           std::vector<double> &_distances) const;
+
+      /// \brief Get the key of the tile of a given level that contains a
+      /// position. The key of a tile of level L is in [0, 4^L), with two
+      /// bits per level, the first level in the most significant bits. In
+      /// each pair, the high bit is set for the northern half of the parent
+      /// tile and the low bit for its eastern half. So the key of the
+      /// parent of a tile is the key of the tile shifted right by two bits,
+      /// and nearby positions share the leading bits of their keys.
+      /// \param[in] _lat Latitude of the position.
+      /// \param[in] _lon Longitude of the position.
+      /// \param[in] _level Level of the tile, up to 32. Level 0 is the
+      /// whole surface.
+      /// \return Key of the tile.
+      public: static std::uint64_t TileKey(const Angle &_lat,
+                                           const Angle &_lon,
+                                           const unsigned int _level);
+
+      /// \brief Private data pointer.
+      GZ_UTILS_IMPL_PTR(dataPtr)
+    };
+    }
+  }
+}
+#endif
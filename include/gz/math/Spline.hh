@@ -19,6 +19,8 @@
 #ifndef GZ_MATH_SPLINE_HH_
 #define GZ_MATH_SPLINE_HH_
 
+#include <vector>
+
 #include <gz/math/Helpers.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/math/config.hh>
@@ -34,8 +36,41 @@ namespace gz
     // Forward declare private classes
     class ControlPoint;
 
+    /// \brief Position, derivatives, curvature and Frenet frame of a
+    /// spline at a parameter value, see Spline::InterpolateFrames.
+    struct SplineFrame
+    {
+      /// \brief Point on the spline.
+      Vector3d position;
+
+      /// \brief First derivative, as InterpolateTangent.
+      Vector3d firstDerivative;
+
+      /// \brief Second derivative of the segment.
+      Vector3d secondDerivative;
+
+      /// \brief Curvature, the inverse of the radius of the osculating
+      /// circle. It doesn't depend on how the curve is parameterized.
+      double curvature;
+
+      /// \brief Unit tangent, the direction of motion along the spline.
+      Vector3d tangent;
+
+      /// \brief Unit normal, towards the center of the osculating circle,
+      /// or zero where the curvature is zero.
+      Vector3d normal;
+
+      /// \brief Unit binormal, the cross product of tangent and normal, or
+      /// zero where the curvature is zero.
+      Vector3d binormal;
+    };
+
     /// \class Spline Spline.hh gz/math/Spline.hh
     /// \brief Splines
+    ///
+    /// Const member functions may be called concurrently from several
+    /// threads. The bounds used by ClosestParameter() are built by the
+    /// first call after the control points change, under a lock.
     class GZ_MATH_VISIBLE Spline
     {
       /// \brief constructor
@@ -80,6 +115,23 @@ namespace gz
       /// \param[in] _t tangent at \p _p.
       public: void AddPoint(const Vector3d &_p, const Vector3d &_t);
 
+      /// \brief Adds control points to the end of the spline. This
+      /// recalculates the spline once, which is faster than adding the
+      /// points one by one.
+      /// \param[in] _points control point values to add.
+      public: void AddPoints(const std::vector<Vector3d> &_points);
+
+      /// \brief Adds an array of control points to the end of the spline,
+      /// see AddPoints(const std::vector<Vector3d> &).
+      /// \param[in] _points pointer to the first control point value.
+      /// \param[in] _count number of control points.
+      public: void AddPoints(const Vector3d *_points, const size_t _count);
+
+      /// \brief Reserves storage for a number of control points, so that
+      /// adding them one by one or in several batches doesn't reallocate.
+      /// \param[in] _count total number of control points.
+      public: void Reserve(const size_t _count);
+
       /// \brief Adds a single control point to the end
       /// of the spline.
       /// \param[in] _cp control point to add.
@@ -215,6 +267,144 @@ namespace gz
                                                 const unsigned int _mth,
                                                 const double _s) const;
 
+      /// \brief Interpolates points on the spline at many parameter
+      /// values. This gives the same points as Interpolate(double), but
+      /// when the parameter values are sorted, it walks along the
+      /// segments instead of searching for the segment of each value.
+      /// \param[in] _t Pointer to the first parameter value (range 0 to 1).
+      /// Values in increasing order are fastest, but any order works.
+      /// \param[out] _out Pointer to the first interpolated point, with
+      /// [INF, INF, INF] for errors.
+      /// \param[in] _count Number of parameter values.
+      /// \sa Interpolate(const double) const
+      public: void Interpolate(const double *_t, Vector3d *_out,
+                               const size_t _count) const;
+
+      /// \brief Interpolates tangents on the spline at many parameter
+      /// values. This gives the same tangents as InterpolateTangent(double).
+      /// \param[in] _t Pointer to the first parameter value (range 0 to 1).
+      /// Values in increasing order are fastest, but any order works.
+      /// \param[out] _out Pointer to the first interpolated tangent, with
+      /// [INF, INF, INF] for errors.
+      /// \param[in] _count Number of parameter values.
+      /// \sa Interpolate(const double *, Vector3d *, const size_t) const
+      public: void InterpolateTangent(const double *_t, Vector3d *_out,
+                                      const size_t _count) const;
+
+      /// \brief Interpolates the mth derivative of the spline at many
+      /// parameter values. This gives the same values as
+      /// InterpolateMthDerivative(unsigned int, double).
+      /// \param[in] _mth order of curve derivative to interpolate.
+      /// \param[in] _t Pointer to the first parameter value (range 0 to 1).
+      /// Values in increasing order are fastest, but any order works.
+      /// \param[out] _out Pointer to the first interpolated derivative,
+      /// with [INF, INF, INF] for errors.
+      /// \param[in] _count Number of parameter values.
+      /// \sa Interpolate(const double *, Vector3d *, const size_t) const
+      public: void InterpolateMthDerivative(const unsigned int _mth,
+                                            const double *_t,
+                                            Vector3d *_out,
+                                            const size_t _count) const;
+
+      /// \brief Interpolates the position, first two derivatives,
+      /// curvature and Frenet frame of the spline at many parameter values,
+      /// evaluating each segment polynomial once per value instead of once
+      /// per derivative. The position and first derivative are those of
+      /// Interpolate and InterpolateTangent. The second derivative is the
+      /// one of the segment, also at the control points, where
+      /// InterpolateMthDerivative gives the one stored in the control point.
+      /// \param[in] _t Pointer to the first parameter value (range 0 to 1).
+      /// Values in increasing order are fastest, but any order works.
+      /// \param[out] _out Pointer to the first frame, with INF in all its
+      /// fields for errors.
+      /// \param[in] _count Number of parameter values.
+      /// \sa Interpolate(const double *, Vector3d *, const size_t) const
+      public: void InterpolateFrames(const double *_t, SplineFrame *_out,
+                                     const size_t _count) const;
+
+      /// \brief Interpolates a point on the spline at a distance along
+      /// it, so that evenly spaced distances give evenly spaced points,
+      /// unlike evenly spaced values of the parameter of Interpolate.
+      /// \remarks Each segment spans its share of ArcLength(), and the
+      /// distances within a segment follow its path length, integrated more
+      /// finely than ArcLength(const double).
+      /// \remarks Without arc length tables, see ArcLengthTableSamples,
+      /// this solves for the parameter value at the distance, which takes
+      /// several evaluations of the arc length.
+      /// \param[in] _distance distance from the start of the spline
+      /// (range 0 to ArcLength()).
+      /// \return the interpolated point, or [INF, INF, INF] on error. Use
+      /// Vector3d::IsFinite() to check for an error.
+      public: Vector3d InterpolateAtDistance(const double _distance) const;
+
+      /// \brief Interpolates a tangent on the spline at a distance along it.
+      /// \param[in] _distance distance from the start of the spline
+      /// (range 0 to ArcLength()).
+      /// \return the interpolated tangent, or [INF, INF, INF] on error. Use
+      /// Vector3d::IsFinite() to check for an error.
+      /// \sa InterpolateAtDistance
+      public: Vector3d InterpolateTangentAtDistance(
+                  const double _distance) const;
+
+      /// \brief Interpolates the mth derivative of the spline at a distance
+      /// along it.
+      /// \param[in] _mth order of curve derivative to interpolate.
+      /// \param[in] _distance distance from the start of the spline
+      /// (range 0 to ArcLength()).
+      /// \return the interpolated mth derivative, or [INF, INF, INF] on
+      /// error. Use Vector3d::IsFinite() to check for an error.
+      /// \sa InterpolateAtDistance
+      public: Vector3d InterpolateMthDerivativeAtDistance(
+                  const unsigned int _mth, const double _distance) const;
+
+      /// \brief Sets the number of samples of the arc length tables of the
+      /// segments. With tables, InterpolateAtDistance maps a distance to
+      /// a parameter value with a cubic interpolation of the table of its
+      /// segment instead of solving for it. The tables are built when the
+      /// segments are, which makes changes to the spline slower.
+      /// \param[in] _samples number of intervals of each table, or 0, the
+      /// default, for no tables. With 16, the distances of the interpolated
+      /// points are within about 1e-3 of the segment length on smooth
+      /// segments. The error is larger near a cusp, where the speed of the
+      /// segment almost vanishes.
+      public: void ArcLengthTableSamples(const unsigned int _samples);
+
+      /// \brief Gets the number of samples of the arc length tables.
+      /// \return number of intervals of each table, 0 for no tables.
+      /// \sa ArcLengthTableSamples(const unsigned int)
+      public: unsigned int ArcLengthTableSamples() const;
+
+      /// \brief Finds the parameter value of the point of the spline
+      /// closest to a point, for instance to project a position on a path.
+      /// The bounds of the segments are kept in a tree, and segments are
+      /// skipped when their bounds are farther than the closest point found
+      /// so far, so a query costs about the same whatever the number of
+      /// segments. The closest point of the other segments is refined with
+      /// Newton's method. Passing the previous result of a tracked position
+      /// as \p _hint searches its segment first.
+      /// \param[in] _point point to project on the spline.
+      /// \param[in] _hint parameter value to start from, such as the
+      /// result for a previous nearby point. Values out of the range 0 to 1,
+      /// like the default, are ignored.
+      /// \return the parameter value (range 0 to 1) of the closest point,
+      /// to use with Interpolate, or INF if the spline has no points.
+      public: double ClosestParameter(const Vector3d &_point,
+                                      const double _hint = -1.0) const;
+
+      /// \brief Approximates the spline with a polyline, for rendering or
+      /// collision checking. Each segment is subdivided where it curves,
+      /// until the curve is within \p _maxChordError of the polyline, so
+      /// straight parts take few points. The subdivision of a segment is
+      /// limited to 2^16 intervals.
+      /// \param[in] _maxChordError maximum distance from the spline to the
+      /// polyline, positive.
+      /// \param[out] _points the vertices of the polyline, from the first
+      /// control point to the last one. It is cleared first.
+      /// \return False if \p _maxChordError is not positive, in which case
+      /// \p _points is left empty.
+      public: bool Tessellate(const double _maxChordError,
+                              std::vector<Vector3d> &_points) const;
+
       /// \brief Tells the spline whether it should automatically
       ///        calculate tangents on demand as points are added.
       /// \remarks The spline calculates tangents at each point
@@ -240,6 +430,15 @@ namespace gz
       /// \brief Rebuilds spline segments.
       private: void Rebuild();
 
+      /// \brief Updates the tangents and segments that depend on a range of
+      /// control points that were just changed or added. This costs the same
+      /// for any number of other points, unlike RecalcTangents.
+      /// \param[in] _first index of the first control point.
+      /// \param[in] _last index of the last control point.
+      /// \param[in] _wasClosed whether the spline was closed before.
+      private: void UpdateAround(const size_t _first, const size_t _last,
+                                 const bool _wasClosed);
+
       /// \internal
       /// \brief Maps \p _t parameter value over the whole spline
       /// to the right segment (starting at point \p _index) with
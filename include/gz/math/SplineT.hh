@@ -0,0 +1,533 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_SPLINET_HH_
+#define GZ_MATH_SPLINET_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <gz/math/Helpers.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class SplineT SplineT.hh gz/math/SplineT.hh
+    /// \brief Compact spline of a given precision. It is the same curve as
+    /// Spline: a Catmull-Rom, or Cardinal, spline through the control
+    /// points, parameterized over its whole length by arc length, but its
+    /// data is stored in flat arrays of T. SplineT<float> takes half the
+    /// memory of SplineT<double>, and its coefficients can be uploaded to a
+    /// GPU as they are, see Coefficients.
+    ///
+    /// Adding or updating a control point only updates the tangents and
+    /// segments around it.
+    /// \tparam T A floating point type.
+    template<typename T>
+    class SplineT
+    {
+      static_assert(std::is_floating_point_v<T>,
+          "SplineT requires a floating point type");
+
+      /// \brief Number of coefficients of each segment in Coefficients.
+      public: static constexpr std::size_t kCoefficientsPerSegment = 12;
+
+      /// \brief Sets the tension parameter, which recalculates the
+      /// tangents that are not fixed.
+      /// \param[in] _t the tension parameter, 0 for a Catmull-Rom spline.
+      /// \sa Spline::Tension(double)
+      public: void Tension(const T _t)
+      {
+        this->tension = _t;
+        const std::size_t numPoints = this->points.size();
+        if (numPoints < 2)
+          return;
+        const bool closed = this->IsClosed();
+        for (std::size_t i = 0; i < numPoints; ++i)
+          this->RecalcTangent(i, closed);
+        for (std::size_t i = 0; i + 1 < numPoints; ++i)
+          this->SetSegment(i);
+        this->UpdateArcLengths(0);
+      }
+
+      /// \brief Gets the tension value.
+      /// \return the value of the tension, between 0.0 and 1.0.
+      public: T Tension() const
+      {
+        return this->tension;
+      }
+
+      /// \brief Adds a control point to the end of the spline. Its tangent
+      /// is calculated from its neighbours.
+      /// \param[in] _p control point value to add.
+      public: void AddPoint(const Vector3<T> &_p)
+      {
+        this->AddPoint(_p, Vector3<T>::Zero, false);
+      }
+
+      /// \brief Adds a control point with a fixed tangent to the end of the
+      /// spline.
+      /// \param[in] _p control point value to add.
+      /// \param[in] _t tangent at the control point.
+      public: void AddPoint(const Vector3<T> &_p, const Vector3<T> &_t)
+      {
+        this->AddPoint(_p, _t, true);
+      }
+
+      /// \brief Updates a control point. Its tangent is calculated from
+      /// its neighbours.
+      /// \param[in] _index index of the control point.
+      /// \param[in] _p new control point value.
+      /// \return False if _index is not less than PointCount().
+      public: bool UpdatePoint(const unsigned int _index,
+                               const Vector3<T> &_p)
+      {
+        return this->UpdatePoint(_index, _p, Vector3<T>::Zero, false);
+      }
+
+      /// \brief Updates a control point and fixes its tangent.
+      /// \param[in] _index index of the control point.
+      /// \param[in] _p new control point value.
+      /// \param[in] _t new tangent at the control point.
+      /// \return False if _index is not less than PointCount().
+      public: bool UpdatePoint(const unsigned int _index,
+                               const Vector3<T> &_p, const Vector3<T> &_t)
+      {
+        return this->UpdatePoint(_index, _p, _t, true);
+      }
+
+      /// \brief Gets a control point.
+      /// \param[in] _index index of the control point.
+      /// \return the control point, or [INF, INF, INF] if _index is not
+      /// less than PointCount().
+      public: Vector3<T> Point(const unsigned int _index) const
+      {
+        if (_index >= this->points.size())
+          return Vector3<T>(Inf(), Inf(), Inf());
+        return this->points[_index];
+      }
+
+      /// \brief Gets the tangent at a control point.
+      /// \param[in] _index index of the control point.
+      /// \return the tangent, or [INF, INF, INF] if _index is not less
+      /// than PointCount().
+      public: Vector3<T> Tangent(const unsigned int _index) const
+      {
+        if (_index >= this->tangents.size())
+          return Vector3<T>(Inf(), Inf(), Inf());
+        return this->tangents[_index];
+      }
+
+      /// \brief Gets the number of control points.
+      /// \return the number of control points.
+      public: unsigned int PointCount() const
+      {
+        return static_cast<unsigned int>(this->points.size());
+      }
+
+      /// \brief Gets the number of segments, one less than the number of
+      /// control points, or 0.
+      /// \return the number of segments.
+      public: std::size_t SegmentCount() const
+      {
+        return this->arcLengths.empty() ? 0 : this->arcLengths.size() - 1;
+      }
+
+      /// \brief Removes all the control points.
+      public: void Clear()
+      {
+        this->points.clear();
+        this->tangents.clear();
+        this->fixings.clear();
+        this->coefficients.clear();
+        this->arcLengths.clear();
+      }
+
+      /// \brief Gets the arc length of the spline.
+      /// \return the arc length, or INF if there are less than two control
+      /// points.
+      public: T ArcLength() const
+      {
+        return this->arcLengths.empty() ? Inf() : this->arcLengths.back();
+      }
+
+      /// \brief Interpolates a point on the spline at a parameter value.
+      /// \param[in] _t parameter value over the whole spline (range 0 to
+      /// 1), proportional to the arc length, as for Spline::Interpolate.
+      /// \return the interpolated point, or [INF, INF, INF] on error.
+      public: Vector3<T> Interpolate(const T _t) const
+      {
+        return this->InterpolateMthDerivative(0, _t);
+      }
+
+      /// \brief Interpolates a point on a segment of the spline.
+      /// \param[in] _fromIndex index of the control point at which the
+      /// segment starts.
+      /// \param[in] _t parameter value in the segment (range 0 to 1).
+      /// \return the interpolated point, or [INF, INF, INF] on error.
+      public: Vector3<T> Interpolate(const unsigned int _fromIndex,
+                                     const T _t) const
+      {
+        return this->InterpolateMthDerivative(_fromIndex, 0, _t);
+      }
+
+      /// \brief Interpolates the tangent of the spline at a parameter
+      /// value.
+      /// \param[in] _t parameter value over the whole spline (range 0 to
+      /// 1).
+      /// \return the interpolated tangent, or [INF, INF, INF] on error.
+      public: Vector3<T> InterpolateTangent(const T _t) const
+      {
+        return this->InterpolateMthDerivative(1, _t);
+      }
+
+      /// \brief Interpolates the tangent of a segment of the spline.
+      /// \param[in] _fromIndex index of the control point at which the
+      /// segment starts.
+      /// \param[in] _t parameter value in the segment (range 0 to 1).
+      /// \return the interpolated tangent, or [INF, INF, INF] on error.
+      public: Vector3<T> InterpolateTangent(const unsigned int _fromIndex,
+                                            const T _t) const
+      {
+        return this->InterpolateMthDerivative(_fromIndex, 1, _t);
+      }
+
+      /// \brief Gets the polynomial coefficients of the segments, in one
+      /// flat array of kCoefficientsPerSegment values per segment, ready to
+      /// upload to a GPU. Segment i is
+      ///
+      /// P(u) = a * u^3 + b * u^2 + c * u + d, u in [0, 1]
+      ///
+      /// where a, b, c and d are the 3D vectors at offsets 12 * i,
+      /// 12 * i + 3, 12 * i + 6 and 12 * i + 9.
+      /// \return pointer to the 12 * SegmentCount() coefficients, which is
+      /// valid until the spline changes.
+      public: const T *Coefficients() const
+      {
+        return this->coefficients.data();
+      }
+
+      /// \brief Gets the arc lengths from the start of the spline to the
+      /// start of each segment, followed by the arc length of the spline.
+      /// With the coefficients, they map a parameter value over the whole
+      /// spline to a segment and a parameter value in the segment.
+      /// \return pointer to the SegmentCount() + 1 arc lengths, or nullptr
+      /// if there are no segments. It is valid until the spline changes.
+      public: const T *CumulativeArcLengths() const
+      {
+        return this->arcLengths.empty() ? nullptr : this->arcLengths.data();
+      }
+
+      /// \brief Gets infinity in T.
+      /// \return infinity.
+      private: static constexpr T Inf()
+      {
+        return std::numeric_limits<T>::infinity();
+      }
+
+      /// \brief Adds a control point.
+      /// \param[in] _p control point value.
+      /// \param[in] _t tangent, used if _fixed.
+      /// \param[in] _fixed whether the tangent is fixed.
+      private: void AddPoint(const Vector3<T> &_p, const Vector3<T> &_t,
+                             const bool _fixed)
+      {
+        const bool wasClosed = this->IsClosed();
+        this->points.push_back(_p);
+        this->tangents.push_back(_t);
+        this->fixings.push_back(_fixed);
+        if (this->points.size() > 1)
+        {
+          this->coefficients.resize(
+              (this->points.size() - 1) * kCoefficientsPerSegment);
+          this->arcLengths.resize(this->points.size());
+        }
+        this->UpdateAround(this->points.size() - 1, wasClosed);
+      }
+
+      /// \brief Updates a control point.
+      /// \param[in] _index index of the control point.
+      /// \param[in] _p control point value.
+      /// \param[in] _t tangent, used if _fixed.
+      /// \param[in] _fixed whether the tangent is fixed.
+      /// \return False if _index is not less than PointCount().
+      private: bool UpdatePoint(const unsigned int _index,
+                                const Vector3<T> &_p, const Vector3<T> &_t,
+                                const bool _fixed)
+      {
+        if (_index >= this->points.size())
+          return false;
+        const bool wasClosed = this->IsClosed();
+        this->points[_index] = _p;
+        this->tangents[_index] = _t;
+        this->fixings[_index] = _fixed;
+        this->UpdateAround(_index, wasClosed);
+        return true;
+      }
+
+      /// \brief Checks whether the spline is closed.
+      /// \return True if the first and last control points are equal.
+      private: bool IsClosed() const
+      {
+        return this->points.size() > 1 &&
+            this->points.front() == this->points.back();
+      }
+
+      /// \brief Recalculates the tangent of a control point that is not
+      /// fixed, as Spline does.
+      /// \param[in] _index control point index, less than the number of
+      /// control points, which is at least 2.
+      /// \param[in] _closed whether the spline is closed.
+      private: void RecalcTangent(const std::size_t _index,
+                                  const bool _closed)
+      {
+        if (this->fixings[_index])
+          return;
+
+        const std::size_t numPoints = this->points.size();
+        const T t = 1 - this->tension;
+        if (_index == 0)
+        {
+          const std::size_t previous = _closed ? numPoints - 2 : 0;
+          this->tangents[_index] =
+              ((this->points[1] - this->points[previous]) * T(0.5)) * t;
+        }
+        else if (_index == numPoints - 1)
+        {
+          if (_closed)
+          {
+            this->tangents[_index] = this->tangents[0];
+          }
+          else
+          {
+            this->tangents[_index] =
+                ((this->points[_index] - this->points[_index - 1]) *
+                 T(0.5)) * t;
+          }
+        }
+        else
+        {
+          this->tangents[_index] =
+              ((this->points[_index + 1] - this->points[_index - 1]) *
+               T(0.5)) * t;
+        }
+      }
+
+      /// \brief Updates the tangents and segments that depend on a control
+      /// point that was just changed or added.
+      /// \param[in] _index index of the control point.
+      /// \param[in] _wasClosed whether the spline was closed before.
+      private: void UpdateAround(const std::size_t _index,
+                                 const bool _wasClosed)
+      {
+        const std::size_t numPoints = this->points.size();
+        if (numPoints < 2)
+          return;
+
+        // The tangents of the point and its neighbours depend on it, and
+        // the tangents of the ends on whether the spline is closed. The
+        // last tangent of a closed spline is the first one, so it comes
+        // last.
+        std::vector<std::size_t> changed;
+        for (std::size_t i = _index > 0 ? _index - 1 : 0;
+             i <= std::min(_index + 1, numPoints - 1); ++i)
+        {
+          changed.push_back(i);
+        }
+        const bool closed = this->IsClosed();
+        if (closed || _wasClosed)
+        {
+          changed.push_back(0);
+          changed.push_back(numPoints - 1);
+        }
+        std::sort(changed.begin(), changed.end());
+        changed.erase(std::unique(changed.begin(), changed.end()),
+                      changed.end());
+        for (const std::size_t i : changed)
+          this->RecalcTangent(i, closed);
+
+        for (const std::size_t i : changed)
+        {
+          if (i > 0)
+            this->SetSegment(i - 1);
+          if (i + 1 < numPoints)
+            this->SetSegment(i);
+        }
+        this->UpdateArcLengths(changed.front() > 0 ? changed.front() - 1 : 0);
+      }
+
+      /// \brief Computes the coefficients of a segment from its control
+      /// points and tangents, with the Hermite basis.
+      /// \param[in] _index segment index.
+      private: void SetSegment(const std::size_t _index)
+      {
+        const Vector3<T> &point0 = this->points[_index];
+        const Vector3<T> &point1 = this->points[_index + 1];
+        const Vector3<T> &tan0 = this->tangents[_index];
+        const Vector3<T> &tan1 = this->tangents[_index + 1];
+        const Vector3<T> rows[4] = {
+            point0 * T(2) - point1 * T(2) + tan0 + tan1,
+            point1 * T(3) - point0 * T(3) - tan0 * T(2) - tan1,
+            tan0,
+            point0};
+        T *coeffs = &this->coefficients[_index * kCoefficientsPerSegment];
+        for (int i = 0; i < 4; ++i)
+        {
+          coeffs[3 * i] = rows[i].X();
+          coeffs[3 * i + 1] = rows[i].Y();
+          coeffs[3 * i + 2] = rows[i].Z();
+        }
+      }
+
+      /// \brief Recomputes the cumulative arc lengths from a segment on.
+      /// \param[in] _first index of the first segment whose arc length
+      /// changed.
+      private: void UpdateArcLengths(const std::size_t _first)
+      {
+        this->arcLengths[0] = 0;
+        for (std::size_t i = _first; i + 1 < this->arcLengths.size(); ++i)
+        {
+          this->arcLengths[i + 1] =
+              this->arcLengths[i] + this->SegmentArcLength(i);
+        }
+      }
+
+      /// \brief Gets the arc length of a segment, with the 5 point
+      /// Gauss-Legendre quadrature rule of Spline.
+      /// \param[in] _index segment index.
+      /// \return the arc length.
+      private: T SegmentArcLength(const std::size_t _index) const
+      {
+        constexpr T weights[5] = {
+            T(0.28444444444444444), T(0.23931433524968326),
+            T(0.23931433524968326), T(0.11846344252809456),
+            T(0.11846344252809456)};
+        constexpr T nodes[5] = {
+            T(0.5), T(0.23076534494715845), T(0.7692346550528415),
+            T(0.0469100770306680), T(0.9530899229693319)};
+        T length = 0;
+        for (int i = 0; i < 5; ++i)
+          length += weights[i] * this->Evaluate(_index, 1, nodes[i]).Length();
+        return length;
+      }
+
+      /// \brief Evaluates a derivative of a segment polynomial.
+      /// \param[in] _index segment index.
+      /// \param[in] _mth order of the derivative, 0 or 1.
+      /// \param[in] _u parameter value in the segment.
+      /// \return the derivative.
+      private: Vector3<T> Evaluate(const std::size_t _index,
+                                   const unsigned int _mth, const T _u) const
+      {
+        const T *c = &this->coefficients[_index * kCoefficientsPerSegment];
+        Vector3<T> result;
+        for (int k = 0; k < 3; ++k)
+        {
+          result[k] = _mth == 0 ?
+              ((c[k] * _u + c[3 + k]) * _u + c[6 + k]) * _u + c[9 + k] :
+              (T(3) * c[k] * _u + T(2) * c[3 + k]) * _u + c[6 + k];
+        }
+        return result;
+      }
+
+      /// \brief Interpolates a derivative at a parameter value over the
+      /// whole spline.
+      /// \param[in] _mth order of the derivative, 0 or 1.
+      /// \param[in] _t parameter value (range 0 to 1).
+      /// \return the derivative, or [INF, INF, INF] on error.
+      private: Vector3<T> InterpolateMthDerivative(const unsigned int _mth,
+                                                   const T _t) const
+      {
+        // Map to a segment as Spline does
+        const std::size_t segments = this->SegmentCount();
+        if (segments == 0)
+          return this->InterpolateMthDerivative(0, _mth, 0);
+        if (equal(_t, T(0)))
+          return this->InterpolateMthDerivative(0, _mth, 0);
+        if (equal(_t, T(1)))
+        {
+          return this->InterpolateMthDerivative(
+              static_cast<unsigned int>(segments - 1), _mth, 1);
+        }
+
+        const T tArc = _t * this->arcLengths.back();
+        const auto begin = this->arcLengths.begin();
+        const auto it = std::lower_bound(begin, begin + segments, tArc);
+        const std::size_t index =
+            it != begin ? static_cast<std::size_t>(it - begin) - 1 : 0;
+        const T length = this->arcLengths[index + 1] - this->arcLengths[index];
+        return this->InterpolateMthDerivative(
+            static_cast<unsigned int>(index), _mth,
+            (tArc - this->arcLengths[index]) / length);
+      }
+
+      /// \brief Interpolates a derivative of a segment.
+      /// \param[in] _fromIndex index of the control point at which the
+      /// segment starts.
+      /// \param[in] _mth order of the derivative, 0 or 1.
+      /// \param[in] _t parameter value in the segment (range 0 to 1).
+      /// \return the derivative, or [INF, INF, INF] on error.
+      private: Vector3<T> InterpolateMthDerivative(
+                   const unsigned int _fromIndex, const unsigned int _mth,
+                   const T _t) const
+      {
+        const Vector3<T> inf(Inf(), Inf(), Inf());
+        if (_fromIndex >= this->points.size())
+          return inf;
+        if (_fromIndex == this->SegmentCount())
+          return _mth == 0 ? this->points[_fromIndex] :
+              this->tangents[_fromIndex];
+        if (!(_t >= 0 && _t <= 1))
+          return inf;
+        return this->Evaluate(_fromIndex, _mth, _t);
+      }
+
+      /// \brief Tension of 0 = Catmull-Rom spline, otherwise a Cardinal
+      /// spline.
+      private: T tension = 0;
+
+      /// \brief Control points.
+      private: std::vector<Vector3<T>> points;
+
+      /// \brief Tangents at the control points.
+      private: std::vector<Vector3<T>> tangents;
+
+      /// \brief Whether the tangent of each control point is fixed.
+      private: std::vector<bool> fixings;
+
+      /// \brief Polynomial coefficients of the segments, see Coefficients.
+      private: std::vector<T> coefficients;
+
+      /// \brief Cumulative arc lengths, see CumulativeArcLengths.
+      private: std::vector<T> arcLengths;
+    };
+
+    using Splinef = SplineT<float>;
+    using Splined = SplineT<double>;
+    }
+  }
+}
+#endif
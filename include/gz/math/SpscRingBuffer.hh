@@ -0,0 +1,307 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_SPSCRINGBUFFER_HH_
+#define GZ_MATH_SPSCRINGBUFFER_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <gz/math/Filter.hh>
+#include <gz/math/MovingWindowFilter.hh>
+#include <gz/math/SignalStats.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    /// \class SpscRingBuffer SpscRingBuffer.hh gz/math/SpscRingBuffer.hh
+    /// \brief A wait-free ring buffer of samples passed from one producer
+    /// thread to one consumer thread, such as from a sensor driver to a
+    /// control loop.
+    ///
+    /// The storage is allocated by the constructor, and no call allocates
+    /// or locks afterwards. Each push or pop completes in a bounded number
+    /// of steps: it moves as many samples as fit, or as are available, and
+    /// returns how many it moved.
+    ///
+    /// The producer and the consumer each own one index, which the other
+    /// only reads, and each keeps a copy of the other's index which it
+    /// refreshes only when the buffer looks full, or empty. The indices are
+    /// on separate cache lines, so the two threads don't write to the same
+    /// line.
+    ///
+    /// The Drain functions pop the available samples straight into the
+    /// batch interfaces of the statistics and filters, without an
+    /// intermediate copy.
+    ///
+    /// **Example Usage**
+    ///
+    /// \code{.cpp}
+    /// gz::math::SpscRingBuffer<double> ring(1024);
+    ///
+    /// // Producer thread
+    /// ring.Push(samples.data(), samples.size());
+    ///
+    /// // Consumer thread
+    /// gz::math::SignalStats stats;
+    /// stats.InsertStatistics("mean,rms");
+    /// ring.Drain(stats);
+    /// \endcode
+    /// \tparam T Type of the samples, which must be default constructible
+    /// and copy assignable.
+    template <typename T>
+    class SpscRingBuffer
+    {
+      /// \brief Size of the cache lines the indices are aligned to.
+      public: static constexpr std::size_t kCacheLineSize = 64;
+
+      /// \brief Constructor.
+      /// \param[in] _capacity Number of samples the buffer holds at least,
+      /// rounded up to a power of two.
+      public: explicit SpscRingBuffer(std::size_t _capacity)
+      {
+        std::size_t size = 1;
+        while (size < _capacity)
+          size *= 2;
+        this->data.resize(size);
+        this->mask = size - 1;
+      }
+
+      /// \brief Copying a buffer shared by two threads is not supported.
+      public: SpscRingBuffer(const SpscRingBuffer &) = delete;
+
+      /// \brief Copying a buffer shared by two threads is not supported.
+      public: SpscRingBuffer &operator=(const SpscRingBuffer &) = delete;
+
+      /// \brief Get the number of samples the buffer holds.
+      /// \return The capacity, a power of two.
+      public: std::size_t Capacity() const
+      {
+        return this->data.size();
+      }
+
+      /// \brief Get the number of samples in the buffer. Since the other
+      /// thread may push or pop at the same time, this is a lower bound
+      /// for the consumer and an upper bound for the producer.
+      /// \return The number of samples.
+      public: std::size_t Size() const
+      {
+        const std::size_t tail =
+          this->consumer.index.load(std::memory_order_acquire);
+        const std::size_t head =
+          this->producer.index.load(std::memory_order_acquire);
+        return head - tail;
+      }
+
+      /// \brief Get whether the buffer is empty.
+      /// \return True if Size() is zero.
+      public: bool Empty() const
+      {
+        return this->Size() == 0;
+      }
+
+      /// \brief Push a sample. Only call this from the producer thread.
+      /// \param[in] _value The sample.
+      /// \return False if the buffer is full.
+      public: bool Push(const T &_value)
+      {
+        return this->Push(&_value, 1) == 1;
+      }
+
+      /// \brief Push as many samples as fit. Only call this from the
+      /// producer thread.
+      /// \param[in] _values Pointer to the first sample.
+      /// \param[in] _count Number of samples.
+      /// \return Number of samples pushed, the first ones of _values.
+      public: std::size_t Push(const T *_values, std::size_t _count)
+      {
+        const std::size_t head =
+          this->producer.index.load(std::memory_order_relaxed);
+        std::size_t free =
+          this->Capacity() - (head - this->producer.otherIndex);
+        if (free < _count)
+        {
+          this->producer.otherIndex =
+            this->consumer.index.load(std::memory_order_acquire);
+          free = this->Capacity() - (head - this->producer.otherIndex);
+        }
+
+        const std::size_t count = std::min(free, _count);
+        const std::size_t start = head & this->mask;
+        const std::size_t first = std::min(count, this->Capacity() - start);
+        std::copy(_values, _values + first, this->data.begin() + start);
+        std::copy(_values + first, _values + count, this->data.begin());
+        this->producer.index.store(head + count, std::memory_order_release);
+        return count;
+      }
+
+      /// \brief Pop a sample. Only call this from the consumer thread.
+      /// \param[out] _value The sample, unchanged if the buffer is empty.
+      /// \return False if the buffer is empty.
+      public: bool Pop(T &_value)
+      {
+        return this->Pop(&_value, 1) == 1;
+      }
+
+      /// \brief Pop as many samples as are available. Only call this from
+      /// the consumer thread.
+      /// \param[out] _values Pointer to room for _count samples.
+      /// \param[in] _count Largest number of samples to pop.
+      /// \return Number of samples popped into the first ones of _values.
+      public: std::size_t Pop(T *_values, std::size_t _count)
+      {
+        return this->Consume([&](const T *_data, std::size_t _n)
+        {
+          _values = std::copy(_data, _data + _n, _values);
+        }, _count);
+      }
+
+      /// \brief Pass the available samples to a function, without copying
+      /// them, then pop them. Only call this from the consumer thread.
+      /// \param[in] _func Function called with a pointer to contiguous
+      /// samples and their number, once, or twice when the samples wrap
+      /// around the end of the storage.
+      /// \param[in] _max Largest number of samples to pop.
+      /// \return Number of samples popped.
+      public: template <typename Func>
+              std::size_t Consume(Func &&_func,
+                  std::size_t _max = std::numeric_limits<std::size_t>::max())
+      {
+        const std::size_t tail =
+          this->consumer.index.load(std::memory_order_relaxed);
+        std::size_t available = this->consumer.otherIndex - tail;
+        if (available < _max)
+        {
+          this->consumer.otherIndex =
+            this->producer.index.load(std::memory_order_acquire);
+          available = this->consumer.otherIndex - tail;
+        }
+
+        const std::size_t count = std::min(available, _max);
+        const std::size_t start = tail & this->mask;
+        const std::size_t first = std::min(count, this->Capacity() - start);
+        if (first > 0)
+          _func(this->data.data() + start, first);
+        if (count > first)
+          _func(this->data.data(), count - first);
+        this->consumer.index.store(tail + count, std::memory_order_release);
+        return count;
+      }
+
+      /// \brief Pop the available samples into signal statistics.
+      /// \param[in, out] _stats The statistics.
+      /// \param[in] _max Largest number of samples to pop.
+      /// \return Number of samples popped.
+      /// \sa SignalStats::InsertData(const double *, const size_t)
+      public: std::size_t Drain(SignalStats &_stats,
+                  std::size_t _max = std::numeric_limits<std::size_t>::max())
+      {
+        return this->Consume([&](const T *_data, std::size_t _n)
+        {
+          _stats.InsertData(_data, _n);
+        }, _max);
+      }
+
+      /// \brief Pop the available samples into a signal statistic.
+      /// \param[in, out] _stat The statistic.
+      /// \param[in] _max Largest number of samples to pop.
+      /// \return Number of samples popped.
+      /// \sa SignalStatistic::InsertData(const double *, const size_t)
+      public: std::size_t Drain(SignalStatistic &_stat,
+                  std::size_t _max = std::numeric_limits<std::size_t>::max())
+      {
+        return this->Consume([&](const T *_data, std::size_t _n)
+        {
+          _stat.InsertData(_data, _n);
+        }, _max);
+      }
+
+      /// \brief Pop the available samples into a moving window filter.
+      /// \param[in, out] _filter The filter.
+      /// \param[in] _max Largest number of samples to pop.
+      /// \return Number of samples popped.
+      public: std::size_t Drain(MovingWindowFilter<T> &_filter,
+                  std::size_t _max = std::numeric_limits<std::size_t>::max())
+      {
+        return this->Consume([&](const T *_data, std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+            _filter.Update(_data[i]);
+        }, _max);
+      }
+
+      /// \brief Pop the available samples into a one-pole filter.
+      /// \param[in, out] _filter The filter.
+      /// \param[in] _max Largest number of samples to pop.
+      /// \return Number of samples popped.
+      public: std::size_t Drain(OnePole<T> &_filter,
+                  std::size_t _max = std::numeric_limits<std::size_t>::max())
+      {
+        return this->Consume([&](const T *_data, std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+            _filter.Process(_data[i]);
+        }, _max);
+      }
+
+      /// \brief Pop the available samples into a bi-quad filter.
+      /// \param[in, out] _filter The filter.
+      /// \param[in] _max Largest number of samples to pop.
+      /// \return Number of samples popped.
+      public: std::size_t Drain(BiQuad<T> &_filter,
+                  std::size_t _max = std::numeric_limits<std::size_t>::max())
+      {
+        return this->Consume([&](const T *_data, std::size_t _n)
+        {
+          for (std::size_t i = 0; i < _n; ++i)
+            _filter.Process(_data[i]);
+        }, _max);
+      }
+
+      /// \brief Index owned by one thread, on its own cache line, with the
+      /// thread's copy of the other thread's index.
+      private: struct alignas(kCacheLineSize) Index
+      {
+        /// \brief Number of samples pushed, or popped, so far.
+        std::atomic<std::size_t> index{0};
+
+        /// \brief Last value read of the other thread's index.
+        std::size_t otherIndex{0};
+      };
+
+      /// \brief Index of the producer, the number of samples pushed.
+      private: Index producer;
+
+      /// \brief Index of the consumer, the number of samples popped.
+      private: Index consumer;
+
+      /// \brief Capacity minus one, to wrap the indices around.
+      private: std::size_t mask = 0;
+
+      /// \brief Storage of the samples.
+      private: std::vector<T> data;
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_SWEEPANDPRUNE_HH_
+#define GZ_MATH_SWEEPANDPRUNE_HH_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Export.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+#include <gz/utils/ImplPtr.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class SweepAndPrune SweepAndPrune.hh gz/math/SweepAndPrune.hh
+    /// \brief Sort and sweep broadphase over a set of axis aligned boxes
+    /// that all move every step, which finds the overlapping pairs without
+    /// testing every pair and without building a tree.
+    ///
+    /// The boxes are kept sorted by their minimum along one axis, the one
+    /// with the largest variance of the box centers. Between steps the
+    /// boxes move little, so the previous order is almost sorted and an
+    /// insertion sort restores it in about linear time. A sweep then tests
+    /// each box against the following boxes that start before it ends.
+    ///
+    /// Boxes are identified by their index in the arrays passed to
+    /// Update().
+    ///
+    /// # Example usage
+    ///
+    /// ```{.cpp}
+    /// gz::math::SweepAndPrune broadphase;
+    /// std::vector<std::pair<std::size_t, std::size_t>> pairs;
+    /// while (running)
+    /// {
+    ///   broadphase.Update(mins.data(), maxs.data(), mins.size());
+    ///   broadphase.Pairs(pairs);
+    /// }
+    /// ```
+    class GZ_MATH_VISIBLE SweepAndPrune
+    {
+      /// \brief Default constructor, with no boxes.
+      public: SweepAndPrune();
+
+      /// \brief Constructor.
+      /// \param[in] _boxes The boxes.
+      public: explicit SweepAndPrune(const std::vector<AxisAlignedBox> &_boxes);
+
+      /// \brief Replace the boxes. Boxes keep their place in the sorted
+      /// order of the previous update, boxes past the previous count are
+      /// added and boxes past _count are removed.
+      /// \param[in] _boxes The boxes.
+      public: void Update(const std::vector<AxisAlignedBox> &_boxes);
+
+      /// \brief Replace the boxes, see
+      /// Update(const std::vector<AxisAlignedBox> &).
+      /// \param[in] _boxes The boxes.
+      /// \param[in] _count Number of boxes.
+      public: void Update(const AxisAlignedBox *_boxes,
+                          const std::size_t _count);
+
+      /// \brief Replace the boxes, given by their corners, see
+      /// Update(const std::vector<AxisAlignedBox> &). This avoids building
+      /// an AxisAlignedBox per box.
+      /// \param[in] _min Minimum corner of each box.
+      /// \param[in] _max Maximum corner of each box.
+      /// \param[in] _count Number of boxes.
+      public: void Update(const Vector3d *_min, const Vector3d *_max,
+                          const std::size_t _count);
+
+      /// \brief Move one box.
+      /// \param[in] _index Index of the box.
+      /// \param[in] _box New box.
+      /// \return False if _index is out of range.
+      public: bool SetBox(const std::size_t _index,
+                          const AxisAlignedBox &_box);
+
+      /// \brief Get the number of boxes.
+      /// \return Number of boxes.
+      public: std::size_t Size() const;
+
+      /// \brief Get a box.
+      /// \param[in] _index Index of the box, less than Size().
+      /// \return The box.
+      public: AxisAlignedBox Box(const std::size_t _index) const;
+
+      /// \brief Get the axis the boxes are sorted on.
+      /// \return 0, 1 or 2 for x, y or z.
+      public: int Axis() const;
+
+      /// \brief Find all the pairs of boxes that intersect, as defined by
+      /// AxisAlignedBox::Intersects. The boxes must not have NaN corners.
+      /// \param[out] _pairs Pairs of indices, with the smaller index first,
+      /// in no particular order. It is cleared first, so reusing it across
+      /// steps keeps its memory.
+      public: void Pairs(std::vector<std::pair<std::size_t, std::size_t>>
+                  &_pairs);
+
+      /// \brief Private data pointer.
+      GZ_UTILS_IMPL_PTR(dataPtr)
+    };
+    }
+  }
+}
+#endif
@@ -17,6 +17,7 @@
 #ifndef GZ_MATH_TEMPERATURE_HH_
 #define GZ_MATH_TEMPERATURE_HH_
 
+#include <cstddef>
 #include <istream>
 #include <ostream>
 
@@ -114,6 +115,83 @@ namespace gz
       /// \return Temperature in Kelvin
       public: static double FahrenheitToKelvin(double _temp);
 
+      /// \brief Convert an array of Kelvin values to Celsius, such as the
+      /// pixels of a thermal camera frame.
+      ///
+      /// The array conversions give the same results as the conversions of
+      /// single values. They process the values by blocks in loops the
+      /// compiler can vectorize. _in and _out can be the same array, to
+      /// convert in place, but must not partially overlap.
+      /// \param[in] _in Temperatures in Kelvin, _count values.
+      /// \param[out] _out Temperatures in Celsius, _count values.
+      /// \param[in] _count Number of values.
+      public: static void KelvinToCelsius(const double *_in, double *_out,
+                                          size_t _count);
+
+      /// \brief Convert an array of Kelvin values to Fahrenheit.
+      /// \param[in] _in Temperatures in Kelvin, _count values.
+      /// \param[out] _out Temperatures in Fahrenheit, _count values.
+      /// \param[in] _count Number of values.
+      /// \sa KelvinToCelsius(const double *, double *, size_t)
+      public: static void KelvinToFahrenheit(const double *_in,
+                                             double *_out, size_t _count);
+
+      /// \brief Convert an array of Celsius values to Fahrenheit.
+      /// \param[in] _in Temperatures in Celsius, _count values.
+      /// \param[out] _out Temperatures in Fahrenheit, _count values.
+      /// \param[in] _count Number of values.
+      /// \sa KelvinToCelsius(const double *, double *, size_t)
+      public: static void CelsiusToFahrenheit(const double *_in,
+                                              double *_out, size_t _count);
+
+      /// \brief Convert an array of Celsius values to Kelvin.
+      /// \param[in] _in Temperatures in Celsius, _count values.
+      /// \param[out] _out Temperatures in Kelvin, _count values.
+      /// \param[in] _count Number of values.
+      /// \sa KelvinToCelsius(const double *, double *, size_t)
+      public: static void CelsiusToKelvin(const double *_in, double *_out,
+                                          size_t _count);
+
+      /// \brief Convert an array of Fahrenheit values to Celsius.
+      /// \param[in] _in Temperatures in Fahrenheit, _count values.
+      /// \param[out] _out Temperatures in Celsius, _count values.
+      /// \param[in] _count Number of values.
+      /// \sa KelvinToCelsius(const double *, double *, size_t)
+      public: static void FahrenheitToCelsius(const double *_in,
+                                              double *_out, size_t _count);
+
+      /// \brief Convert an array of Fahrenheit values to Kelvin.
+      /// \param[in] _in Temperatures in Fahrenheit, _count values.
+      /// \param[out] _out Temperatures in Kelvin, _count values.
+      /// \param[in] _count Number of values.
+      /// \sa KelvinToCelsius(const double *, double *, size_t)
+      public: static void FahrenheitToKelvin(const double *_in,
+                                             double *_out, size_t _count);
+
+      /// \brief Compute _in * _scale + _offset for an array of values, in a
+      /// single pass. Since every unit conversion is a scale and an offset,
+      /// this can, for example, turn the raw counts of a radiometric sensor
+      /// into Celsius at once, rather than into Kelvin and then Celsius.
+      /// \param[in] _in Input values, _count values.
+      /// \param[out] _out Output values, _count values. Can be _in.
+      /// \param[in] _count Number of values.
+      /// \param[in] _scale Factor applied to the values.
+      /// \param[in] _offset Offset added after scaling.
+      /// \sa KelvinToCelsius(const double *, double *, size_t)
+      public: static void ScaleOffset(const double *_in, double *_out,
+                                      size_t _count, double _scale,
+                                      double _offset);
+
+      /// \brief Clamp an array of temperatures in place. NaN values are
+      /// left unchanged.
+      /// \param[in, out] _temps Temperatures, _count values.
+      /// \param[in] _count Number of values.
+      /// \param[in] _min Lowest temperature, in the unit of the values.
+      /// \param[in] _max Highest temperature, in the unit of the values.
+      /// \sa KelvinToCelsius(const double *, double *, size_t)
+      public: static void Clamp(double *_temps, size_t _count, double _min,
+                                double _max);
+
       /// \brief Set the temperature from a Kelvin value.
       /// \param[in] _temp Temperature in Kelvin.
       public: void SetKelvin(double _temp);
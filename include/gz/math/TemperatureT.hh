@@ -0,0 +1,358 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_TEMPERATURET_HH_
+#define GZ_MATH_TEMPERATURET_HH_
+
+#include <istream>
+#include <ostream>
+#include <type_traits>
+
+#include <gz/math/Helpers.hh>
+#include <gz/math/Temperature.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class TemperatureT TemperatureT.hh gz/math/TemperatureT.hh
+    /// \brief Temperature of a given precision, with the same interface and
+    /// results as Temperature, but stored inline as a single T in Kelvin.
+    /// A temperature can be copied without an allocation, an array of them
+    /// is an array of T, such as the pixels of a thermal image, and the
+    /// functions are constexpr.
+    /// \tparam T A floating point type.
+    template<typename T>
+    class TemperatureT
+    {
+      static_assert(std::is_floating_point_v<T>,
+          "TemperatureT requires a floating point type");
+
+      /// \brief Default constructor, zero Kelvin.
+      public: constexpr TemperatureT() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _temp Temperature in Kelvin.
+      // cppcheck-suppress noExplicitConstructor
+      public: constexpr TemperatureT(const T _temp)
+      : kelvin(_temp)
+      {
+      }
+
+      /// \brief Construct from a Temperature.
+      /// \param[in] _temp Temperature to convert.
+      public: explicit TemperatureT(const Temperature &_temp)
+      : kelvin(static_cast<T>(_temp.Kelvin()))
+      {
+      }
+
+      /// \brief Get a Temperature with the same value.
+      /// \return The temperature.
+      public: Temperature ToTemperature() const
+      {
+        return Temperature(static_cast<double>(this->kelvin));
+      }
+
+      /// \brief Convert Kelvin to Celsius.
+      /// \param[in] _temp Temperature in Kelvin.
+      /// \return Temperature in Celsius.
+      public: static constexpr T KelvinToCelsius(const T _temp)
+      {
+        return _temp - T(273.15);
+      }
+
+      /// \brief Convert Kelvin to Fahrenheit.
+      /// \param[in] _temp Temperature in Kelvin.
+      /// \return Temperature in Fahrenheit.
+      public: static constexpr T KelvinToFahrenheit(const T _temp)
+      {
+        return _temp * T(1.8) - T(459.67);
+      }
+
+      /// \brief Convert Celsius to Fahrenheit.
+      /// \param[in] _temp Temperature in Celsius.
+      /// \return Temperature in Fahrenheit.
+      public: static constexpr T CelsiusToFahrenheit(const T _temp)
+      {
+        return _temp * T(1.8) + T(32.0);
+      }
+
+      /// \brief Convert Celsius to Kelvin.
+      /// \param[in] _temp Temperature in Celsius.
+      /// \return Temperature in Kelvin.
+      public: static constexpr T CelsiusToKelvin(const T _temp)
+      {
+        return _temp + T(273.15);
+      }
+
+      /// \brief Convert Fahrenheit to Celsius.
+      /// \param[in] _temp Temperature in Fahrenheit.
+      /// \return Temperature in Celsius.
+      public: static constexpr T FahrenheitToCelsius(const T _temp)
+      {
+        return (_temp - T(32.0)) / T(1.8);
+      }
+
+      /// \brief Convert Fahrenheit to Kelvin.
+      /// \param[in] _temp Temperature in Fahrenheit.
+      /// \return Temperature in Kelvin.
+      public: static constexpr T FahrenheitToKelvin(const T _temp)
+      {
+        return (_temp + T(459.67)) / T(1.8);
+      }
+
+      /// \brief Set the temperature from a Kelvin value.
+      /// \param[in] _temp Temperature in Kelvin.
+      public: constexpr void SetKelvin(const T _temp)
+      {
+        this->kelvin = _temp;
+      }
+
+      /// \brief Set the temperature from a Celsius value.
+      /// \param[in] _temp Temperature in Celsius.
+      public: constexpr void SetCelsius(const T _temp)
+      {
+        this->kelvin = CelsiusToKelvin(_temp);
+      }
+
+      /// \brief Set the temperature from a Fahrenheit value.
+      /// \param[in] _temp Temperature in Fahrenheit.
+      public: constexpr void SetFahrenheit(const T _temp)
+      {
+        this->kelvin = FahrenheitToKelvin(_temp);
+      }
+
+      /// \brief Get the temperature in Kelvin.
+      /// \return Temperature in Kelvin.
+      public: constexpr T Kelvin() const
+      {
+        return this->kelvin;
+      }
+
+      /// \brief Get the temperature in Celsius.
+      /// \return Temperature in Celsius.
+      public: constexpr T Celsius() const
+      {
+        return KelvinToCelsius(this->kelvin);
+      }
+
+      /// \brief Get the temperature in Fahrenheit.
+      /// \return Temperature in Fahrenheit.
+      public: constexpr T Fahrenheit() const
+      {
+        return KelvinToFahrenheit(this->kelvin);
+      }
+
+      /// \brief Accessor operator.
+      /// \return Temperature in Kelvin.
+      public: constexpr T operator()() const
+      {
+        return this->kelvin;
+      }
+
+      /// \brief Addition operator.
+      /// \param[in] _temp Temperature in Kelvin.
+      /// \return Resulting temperature.
+      public: constexpr TemperatureT operator+(const T _temp) const
+      {
+        return this->kelvin + _temp;
+      }
+
+      /// \brief Addition operator.
+      /// \param[in] _temp Temperature to add.
+      /// \return Resulting temperature.
+      public: constexpr TemperatureT operator+(const TemperatureT &_temp) const
+      {
+        return this->kelvin + _temp.kelvin;
+      }
+
+      /// \brief Addition assignment operator.
+      /// \param[in] _temp Temperature in Kelvin.
+      /// \return Reference to this instance.
+      public: constexpr const TemperatureT &operator+=(const T _temp)
+      {
+        this->kelvin += _temp;
+        return *this;
+      }
+
+      /// \brief Addition assignment operator.
+      /// \param[in] _temp Temperature to add.
+      /// \return Reference to this instance.
+      public: constexpr const TemperatureT &operator+=(
+                  const TemperatureT &_temp)
+      {
+        this->kelvin += _temp.kelvin;
+        return *this;
+      }
+
+      /// \brief Subtraction operator.
+      /// \param[in] _temp Temperature in Kelvin.
+      /// \return Resulting temperature.
+      public: constexpr TemperatureT operator-(const T _temp) const
+      {
+        return this->kelvin - _temp;
+      }
+
+      /// \brief Subtraction operator.
+      /// \param[in] _temp Temperature to subtract.
+      /// \return Resulting temperature.
+      public: constexpr TemperatureT operator-(const TemperatureT &_temp) const
+      {
+        return this->kelvin - _temp.kelvin;
+      }
+
+      /// \brief Subtraction assignment operator.
+      /// \param[in] _temp Temperature in Kelvin.
+      /// \return Reference to this instance.
+      public: constexpr const TemperatureT &operator-=(const T _temp)
+      {
+        this->kelvin -= _temp;
+        return *this;
+      }
+
+      /// \brief Subtraction assignment operator.
+      /// \param[in] _temp Temperature to subtract.
+      /// \return Reference to this instance.
+      public: constexpr const TemperatureT &operator-=(
+                  const TemperatureT &_temp)
+      {
+        this->kelvin -= _temp.kelvin;
+        return *this;
+      }
+
+      /// \brief Multiplication operator.
+      /// \param[in] _temp Scale factor.
+      /// \return Resulting temperature.
+      public: constexpr TemperatureT operator*(const T _temp) const
+      {
+        return this->kelvin * _temp;
+      }
+
+      /// \brief Multiplication assignment operator.
+      /// \param[in] _temp Scale factor.
+      /// \return Reference to this instance.
+      public: constexpr const TemperatureT &operator*=(const T _temp)
+      {
+        this->kelvin *= _temp;
+        return *this;
+      }
+
+      /// \brief Division operator.
+      /// \param[in] _temp Divisor.
+      /// \return Resulting temperature.
+      public: constexpr TemperatureT operator/(const T _temp) const
+      {
+        return this->kelvin / _temp;
+      }
+
+      /// \brief Division assignment operator.
+      /// \param[in] _temp Divisor.
+      /// \return Reference to this instance.
+      public: constexpr const TemperatureT &operator/=(const T _temp)
+      {
+        this->kelvin /= _temp;
+        return *this;
+      }
+
+      /// \brief Equality operator, see Temperature::operator==.
+      /// \param[in] _temp The temperature to compare.
+      /// \return True if the temperatures are within 1e-6 Kelvin.
+      public: bool operator==(const TemperatureT &_temp) const
+      {
+        return equal(this->kelvin, _temp.kelvin);
+      }
+
+      /// \brief Inequality operator.
+      /// \param[in] _temp The temperature to compare.
+      /// \return True if the temperatures are not equal.
+      public: bool operator!=(const TemperatureT &_temp) const
+      {
+        return !(*this == _temp);
+      }
+
+      /// \brief Less than operator.
+      /// \param[in] _temp The temperature to compare.
+      /// \return True if this temperature is lower.
+      public: constexpr bool operator<(const TemperatureT &_temp) const
+      {
+        return this->kelvin < _temp.kelvin;
+      }
+
+      /// \brief Less than or equal operator.
+      /// \param[in] _temp The temperature to compare.
+      /// \return True if this temperature is lower or equal.
+      public: constexpr bool operator<=(const TemperatureT &_temp) const
+      {
+        return this->kelvin <= _temp.kelvin;
+      }
+
+      /// \brief Greater than operator.
+      /// \param[in] _temp The temperature to compare.
+      /// \return True if this temperature is higher.
+      public: constexpr bool operator>(const TemperatureT &_temp) const
+      {
+        return this->kelvin > _temp.kelvin;
+      }
+
+      /// \brief Greater than or equal operator.
+      /// \param[in] _temp The temperature to compare.
+      /// \return True if this temperature is higher or equal.
+      public: constexpr bool operator>=(const TemperatureT &_temp) const
+      {
+        return this->kelvin >= _temp.kelvin;
+      }
+
+      /// \brief Stream insertion operator.
+      /// \param[in] _out The output stream.
+      /// \param[in] _temp Temperature to write, in Kelvin.
+      /// \return The output stream.
+      public: friend std::ostream &operator<<(std::ostream &_out,
+                  const TemperatureT &_temp)
+      {
+        _out << _temp.kelvin;
+        return _out;
+      }
+
+      /// \brief Stream extraction operator.
+      /// \param[in] _in The input stream.
+      /// \param[out] _temp Temperature to read, in Kelvin. Unchanged if the
+      /// read fails.
+      /// \return The input stream.
+      public: friend std::istream &operator>>(std::istream &_in,
+                  TemperatureT &_temp)
+      {
+        _in.setf(std::ios_base::skipws);
+        T kelvin;
+        _in >> kelvin;
+        if (!_in.fail())
+          _temp.kelvin = kelvin;
+        return _in;
+      }
+
+      /// \brief Temperature in Kelvin.
+      private: T kelvin = 0;
+    };
+
+    using Temperatured = TemperatureT<double>;
+    using Temperaturef = TemperatureT<float>;
+    }
+  }
+}
+#endif
@@ -18,10 +18,24 @@
 #ifndef GZ_MATH_TIME_VARYING_VOLUMETRIC_GRID_HH_
 #define GZ_MATH_TIME_VARYING_VOLUMETRIC_GRID_HH_
 
+#include <gz/math/MemoryMappedFile.hh>
 #include <gz/math/TimeVaryingVolumetricGridLookupField.hh>
 #include <gz/math/Vector3.hh>
+#include <gz/math/detail/ParallelFor.hh>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -98,6 +112,20 @@ class TimeVaryingVolumetricGrid<T, V, InMemorySession<T, P>, P>
     return indices.StepTo(_session, _time);
   }
 
+  /// \brief Step several sessions to the same time, searching for the time
+  /// slice once.
+  /// \sa TimeVaryingVolumetricGridLookupField::StepTo(
+  /// InMemorySession<T, V> *, std::size_t, const T &)
+  /// \param[in,out] _sessions - The sessions, stepped in place
+  /// \param[in] _count - Number of sessions
+  /// \param[in] _time - Time to step to
+  /// \return Number of sessions that were stepped.
+  public: std::size_t StepTo(InMemorySession<T, P> *_sessions,
+    const std::size_t _count, const T &_time) const
+  {
+    return indices.StepTo(_sessions, _count, _time);
+  }
+
   /// \brief Looks up a given point. If the point lies in between two time
   /// frames then it performs spatio-temporal linear interpolation.
   /// \return nullopt if the data is out of range.
@@ -107,14 +135,25 @@ class TimeVaryingVolumetricGrid<T, V, InMemorySession<T, P>, P>
       const Vector3<V> &_tol = Vector3<V>{1e-6, 1e-6, 1e-6})
     const
   {
-    auto points = indices.LookUp(_session, _pos, _tol);
-    std::optional<V> result = indices.EstimateQuadrilinear(
-      _session,
-      points,
-      values,
-      values,
-      _pos);
-    return result;
+    return indices.EstimateQuadrilinear(_session, _pos, values, values, _tol);
+  }
+
+  /// \brief Looks up a given point, starting the spatial searches from
+  /// where the previous query with the same cursors fell.
+  /// \sa TimeVaryingVolumetricGridLookupField::EstimateQuadrilinear(
+  /// const InMemorySession<T, V> &, const Vector3<V> &,
+  /// const std::vector<X> &, const std::vector<X> &,
+  /// std::array<VolumetricGridCursor, 2> &, const Vector3<V> &, const X)
+  /// \return nullopt if the data is out of range.
+  public: std::optional<V>
+    LookUp(const InMemorySession<T, P> &_session,
+      const Vector3<P> &_pos,
+      std::array<VolumetricGridCursor, 2> &_cursors,
+      const Vector3<V> &_tol = Vector3<V>{1e-6, 1e-6, 1e-6})
+    const
+  {
+    return indices.EstimateQuadrilinear(
+      _session, _pos, values, values, _cursors, _tol);
   }
 
   /// \brief Get the bounds of this grid field at given time.
@@ -156,30 +195,988 @@ class InMemoryTimeVaryingVolumetricGridFactory
     _points[_time].emplace_back(_position, _value);
   }
 
+  /// \brief Adds all the points of a time slice at once.
+  /// \param[in] _time - Time of the slice
+  /// \param[in] _cloud - Positions of the points
+  /// \param[in] _values - Value of each point
+  /// \param[in] _count - Number of points
+  public: void AddSlice(const T &_time, const Vector3<P> *_cloud,
+    const V *_values, const std::size_t _count)
+  {
+    auto &pts = _points[_time];
+    pts.reserve(pts.size() + _count);
+    for (std::size_t i = 0; i < _count; ++i)
+      pts.emplace_back(_cloud[i], _values[i]);
+  }
+
   /// \brief Builds the `InMemoryTimeVaryingVolumetricGrid<T, V, P>` object.
-  public: InMemoryTimeVaryingVolumetricGrid<T, V, P> Build() const
+  /// Time slices are built concurrently, and slices with the same points
+  /// as the slice before them, in the same order, share its index table
+  /// instead of building their own. The grid is the same for any thread
+  /// count.
+  /// \param[in] _threads - Maximum number of threads used to build the
+  /// slices. Zero uses std::thread::hardware_concurrency.
+  public: InMemoryTimeVaryingVolumetricGrid<T, V, P> Build(
+    const unsigned int _threads = 1) const
   {
+    using Field = VolumetricGridLookupField<V>;
+    using Slice = typename decltype(_points)::const_iterator;
+
+    std::vector<Slice> slices;
+    std::vector<std::size_t> offsets;
+    std::size_t total = 0;
+    for (auto it = _points.begin(); it != _points.end(); ++it)
+    {
+      slices.push_back(it);
+      offsets.push_back(total);
+      total += it->second.size();
+    }
+
+    const std::size_t threads = detail::ThreadCount(_threads);
+
+    // Values are stored one slice after the other, and slices are
+    // compared with the previous one
     InMemoryTimeVaryingVolumetricGrid<T, V, P> grid;
-    for (auto &[time, pts] : _points)
+    grid.values.resize(total);
+    std::vector<char> shared(slices.size(), 0);
+    ForEach(slices.size(), threads, [&](const std::size_t _i)
     {
-      std::vector<Vector3d> cloud;
-      std::vector<std::size_t> indices;
-      for (auto &[pt, val] : pts)
-      {
-        grid.values.push_back(val);
-        cloud.push_back(pt);
-        indices.push_back(grid.values.size() - 1);
-      }
-      VolumetricGridLookupField<V> field(cloud, indices);
-      grid.indices.AddVolumetricGridField(time, field);
+      const auto &pts = slices[_i]->second;
+      for (std::size_t j = 0; j < pts.size(); ++j)
+        grid.values[offsets[_i] + j] = pts[j].second;
+      if (_i == 0)
+        return;
+      const auto &prev = slices[_i - 1]->second;
+      shared[_i] = std::equal(pts.begin(), pts.end(), prev.begin(),
+        prev.end(), [](const auto &_a, const auto &_b)
+        {
+          return _a.first == _b.first;
+        });
+    });
+
+    // Only the first slice of each run of identical slices is built
+    std::vector<std::size_t> built;
+    for (std::size_t i = 0; i < slices.size(); ++i)
+    {
+      if (!shared[i])
+        built.push_back(i);
+    }
+    std::vector<Field> fields(built.size());
+    ForEach(built.size(), threads, [&](const std::size_t _i)
+    {
+      const auto &pts = slices[built[_i]]->second;
+      std::vector<Vector3d> cloud(pts.size());
+      for (std::size_t j = 0; j < pts.size(); ++j)
+        cloud[j] = pts[j].first;
+      fields[_i] = Field(cloud);
+    });
+
+    std::size_t field = 0;
+    for (std::size_t i = 0; i < slices.size(); ++i)
+    {
+      if (i > 0 && !shared[i])
+        ++field;
+      grid.indices.AddVolumetricGridField(slices[i]->first,
+        fields[field].WithIndexOffset(offsets[i]));
     }
     return grid;
   }
 
+  /// \brief Call a function for each number of a range, distributing the
+  /// numbers over several threads as they finish.
+  /// \param[in] _count - Size of the range
+  /// \param[in] _threads - Number of threads
+  /// \param[in] _fn - Function called with each number
+  private: template<typename F>
+  static void ForEach(const std::size_t _count, const std::size_t _threads,
+    const F &_fn)
+  {
+    std::atomic<std::size_t> next{0};
+    const std::size_t workers = std::min(_threads, _count);
+    detail::ParallelFor(workers, workers,
+      [&](std::size_t, std::size_t, std::size_t)
+      {
+        for (std::size_t i = next++; i < _count; i = next++)
+          _fn(i);
+      });
+  }
+
   /// Temporary datastore
   private: std::map<T, std::vector<std::pair<Vector3d, V>>> _points;
 };
 
+/// \brief One time slice of a StreamingTimeVaryingVolumetricGrid, or one
+/// brick of a tiled time slice, filled in by the loader registered with
+/// StreamingTimeVaryingVolumetricGridFactory.
+template<typename V, typename P>
+struct StreamingTimeSlice
+{
+  /// \brief Index of the grid points of the slice.
+  VolumetricGridLookupField<P> field;
+
+  /// \brief Values indexed by field. Unused if data is set.
+  std::vector<V> values;
+
+  /// \brief Values indexed by field when they are stored outside of the
+  /// slice, for instance in a memory mapped file.
+  const V *data{nullptr};
+
+  /// \brief Keeps alive the storage that field and data refer to, if any.
+  std::shared_ptr<const void> storage;
+
+  /// \brief Memory used by the slice, counted against the memory budget of
+  /// the grid. If zero the size of values is used.
+  std::size_t bytes{0};
+
+  /// \brief Get the values indexed by field.
+  /// \return Pointer to the first value.
+  const V *Values() const
+  {
+    return this->data ? this->data : this->values.data();
+  }
+};
+
+/// \brief Splits a time slice of a StreamingTimeVaryingVolumetricGrid into
+/// bricks, so that only the bricks that are queried are loaded. Along each
+/// axis the bricks are separated at split positions, which should be grid
+/// positions. The grid points on a split belong to the bricks on both sides
+/// of it, so any point can be interpolated within a single brick. A default
+/// constructed tiling has a single brick.
+template<typename P>
+class VolumetricGridTiling
+{
+  /// \brief Default constructor, a single brick.
+  public: VolumetricGridTiling() = default;
+
+  /// \brief Constructor.
+  /// \param[in] _x Split positions along the x axis, sorted, including the
+  /// first and last grid positions.
+  /// \param[in] _y Split positions along the y axis, as for _x.
+  /// \param[in] _z Split positions along the z axis, as for _x.
+  public: VolumetricGridTiling(std::vector<P> _x, std::vector<P> _y,
+    std::vector<P> _z)
+    : splits{std::move(_x), std::move(_y), std::move(_z)}
+  {
+  }
+
+  /// \brief Create a tiling with the same number of grid cells per brick.
+  /// \param[in] _x Grid positions along the x axis, sorted and unique.
+  /// \param[in] _y Grid positions along the y axis, sorted and unique.
+  /// \param[in] _z Grid positions along the z axis, sorted and unique.
+  /// \param[in] _cells Number of grid cells along each axis of a brick.
+  /// The last brick along an axis may have fewer.
+  /// \return The tiling.
+  public: static VolumetricGridTiling Uniform(const std::vector<P> &_x,
+    const std::vector<P> &_y, const std::vector<P> &_z,
+    const std::size_t _cells)
+  {
+    auto axis = [_cells](const std::vector<P> &_positions)
+    {
+      std::vector<P> result;
+      const std::size_t step = std::max<std::size_t>(1, _cells);
+      for (std::size_t i = 0; i + 1 < _positions.size(); i += step)
+        result.push_back(_positions[i]);
+      if (!_positions.empty())
+        result.push_back(_positions.back());
+      return result;
+    };
+    return VolumetricGridTiling(axis(_x), axis(_y), axis(_z));
+  }
+
+  /// \brief Get the number of bricks.
+  /// \return Number of bricks, at least one.
+  public: std::size_t BrickCount() const
+  {
+    return AxisCount(0) * AxisCount(1) * AxisCount(2);
+  }
+
+  /// \brief Get the brick to query for a position.
+  /// \param[in] _pos The position.
+  /// \return Index of the brick containing _pos, or of the closest brick
+  /// if no brick contains it.
+  public: std::size_t Brick(const Vector3<P> &_pos) const
+  {
+    return (this->AxisBrick(2, _pos.Z()) * AxisCount(1) +
+            this->AxisBrick(1, _pos.Y())) * AxisCount(0) +
+           this->AxisBrick(0, _pos.X());
+  }
+
+  /// \brief Check whether a grid point belongs to a brick, for instance to
+  /// split a time slice into bricks.
+  /// \param[in] _brick Index of the brick.
+  /// \param[in] _pt The grid point.
+  /// \return True if _pt is within the splits around the brick.
+  public: bool BrickContains(const std::size_t _brick,
+    const Vector3<P> &_pt) const
+  {
+    const std::size_t x = _brick % AxisCount(0);
+    const std::size_t y = _brick / AxisCount(0) % AxisCount(1);
+    const std::size_t z = _brick / AxisCount(0) / AxisCount(1);
+    return this->AxisContains(0, x, _pt.X()) &&
+           this->AxisContains(1, y, _pt.Y()) &&
+           this->AxisContains(2, z, _pt.Z());
+  }
+
+  /// \brief Get the bounds of the tiling.
+  /// \return The first and last split positions along each axis, zero
+  /// along axes without splits.
+  public: std::pair<Vector3<P>, Vector3<P>> Bounds() const
+  {
+    auto first = [this](const int _axis)
+    {
+      return this->splits[_axis].empty() ? P(0) : this->splits[_axis].front();
+    };
+    auto last = [this](const int _axis)
+    {
+      return this->splits[_axis].empty() ? P(0) : this->splits[_axis].back();
+    };
+    return std::pair<Vector3<P>, Vector3<P>>(
+      Vector3<P>{first(0), first(1), first(2)},
+      Vector3<P>{last(0), last(1), last(2)});
+  }
+
+  /// \brief Get the number of bricks along an axis.
+  /// \param[in] _axis The axis.
+  /// \return Number of bricks, at least one.
+  private: std::size_t AxisCount(const int _axis) const
+  {
+    const std::size_t n = this->splits[_axis].size();
+    return n < 2 ? 1 : n - 1;
+  }
+
+  /// \brief Get the brick containing a position along an axis.
+  /// \param[in] _axis The axis.
+  /// \param[in] _value The position along the axis.
+  /// \return Index of the brick along the axis. A position on a split
+  /// belongs to the brick after it, which contains it too.
+  private: std::size_t AxisBrick(const int _axis, const P _value) const
+  {
+    const std::vector<P> &s = this->splits[_axis];
+    if (s.size() < 3)
+      return 0;
+    return static_cast<std::size_t>(
+      std::upper_bound(s.begin() + 1, s.end() - 1, _value) - (s.begin() + 1));
+  }
+
+  /// \brief Check whether a position is within a brick along an axis.
+  /// \param[in] _axis The axis.
+  /// \param[in] _brick Index of the brick along the axis.
+  /// \param[in] _value The position along the axis.
+  /// \return True if _value is between the splits around the brick.
+  private: bool AxisContains(const int _axis, const std::size_t _brick,
+    const P _value) const
+  {
+    const std::vector<P> &s = this->splits[_axis];
+    if (s.size() < 2)
+      return true;
+    return s[_brick] <= _value && _value <= s[_brick + 1];
+  }
+
+  /// \brief Split positions along each axis.
+  private: std::array<std::vector<P>, 3> splits;
+};
+
+/// \brief A session of a StreamingTimeVaryingVolumetricGrid. It keeps the
+/// two time slices it interpolates between loaded for as long as it exists,
+/// or for tiled time slices the brick of each that was queried last.
+/// Queries of a tiled time slice may switch the brick the session holds, so
+/// such a session must not be used from several threads at once. Otherwise
+/// queries don't modify the session.
+template<typename T, typename V, typename P>
+class StreamingSession
+{
+  /// \brief Index of the current time slice.
+  private: std::size_t index{0};
+
+  /// \brief False if the current time slice does not exist, or if it is
+  /// not tiled and could not be loaded.
+  private: bool valid{false};
+
+  /// \brief Brick of the current and next time slices, nullptr if it is not
+  /// loaded or could not be loaded. Time slices that are not tiled have a
+  /// single brick, which is loaded with the session.
+  private: mutable std::array<
+    std::shared_ptr<const StreamingTimeSlice<V, P>>, 2> bricks;
+
+  /// \brief Index of each brick in its time slice, see
+  /// VolumetricGridTiling::Brick().
+  private: mutable std::array<std::size_t, 2> brickIndices{};
+
+  /// \brief Time of last query
+  public: T time;
+
+  friend class
+    TimeVaryingVolumetricGrid<T, V, StreamingSession<T, V, P>, P>;
+};
+
+/// \brief Specialization of TimeVaryingVolumetricGrid which loads time slices
+/// on demand, so the whole dataset does not need to fit in memory. Stepping a
+/// session prefetches the following slice in the background, and slices no
+/// session uses are evicted, least recently used first, when the memory
+/// budget is exceeded. Slices in use are never evicted, so a budget smaller
+/// than three slices per session is exceeded rather than enforced. Copies of
+/// the grid share the same cache.
+///
+/// Time slices larger than memory can be split into bricks, see
+/// VolumetricGridTiling. Bricks are loaded when LookUp() first queries them
+/// and are cached and evicted like whole slices, so a session only holds
+/// two bricks. To construct this class use
+/// `StreamingTimeVaryingVolumetricGridFactory`
+template<typename T, typename V, typename P>
+class TimeVaryingVolumetricGrid<T, V, StreamingSession<T, V, P>, P>
+{
+  /// \brief Pointer to a loaded time slice or brick.
+  private: using SlicePtr = std::shared_ptr<const StreamingTimeSlice<V, P>>;
+
+  /// \brief Function filling in a brick of a time slice, returning false on
+  /// failure.
+  private: using Loader =
+    std::function<bool(std::size_t, StreamingTimeSlice<V, P> &)>;
+
+  /// \brief Index of a time slice and of one of its bricks.
+  private: using BrickKey = std::pair<std::size_t, std::size_t>;
+
+  /// \brief Brick index of a session that has not queried a tiled slice.
+  private: static constexpr std::size_t kNoBrick =
+    std::numeric_limits<std::size_t>::max();
+
+  /// \brief A brick in the cache.
+  private: struct CacheEntry;
+
+  /// \brief Documentation Inherited
+  public: StreamingSession<T, V, P> CreateSession() const
+  {
+    StreamingSession<T, V, P> sess;
+    sess.time = T(0);
+    sess.brickIndices = {kNoBrick, kNoBrick};
+    this->Pin(sess);
+    return sess;
+  }
+
+  /// \brief Documentation Inherited
+  public: StreamingSession<T, V, P> CreateSession(const T &_time) const
+  {
+    StreamingSession<T, V, P> sess;
+    sess.index = static_cast<std::size_t>(
+      std::lower_bound(this->times.begin(), this->times.end(), _time) -
+      this->times.begin());
+    sess.time = _time;
+    sess.brickIndices = {kNoBrick, kNoBrick};
+    this->Pin(sess);
+    return sess;
+  }
+
+  /// \brief Documentation Inherited. A session is also invalid if its time
+  /// slice is not tiled and could not be loaded.
+  public: bool IsValid(const StreamingSession<T, V, P> &_session) const
+  {
+    return _session.valid;
+  }
+
+  /// \brief Documentation Inherited
+  public: std::optional<StreamingSession<T, V, P>>
+    StepTo(const StreamingSession<T, V, P> &_session, const T &_time) const
+  {
+    if (!this->IsValid(_session))
+    {
+      return std::nullopt;
+    }
+
+    std::size_t index = _session.index;
+    if (index + 1 >= this->times.size() || _time < this->times[index])
+    {
+      return std::nullopt;
+    }
+
+    while (index + 1 < this->times.size() && this->times[index + 1] <= _time)
+    {
+      ++index;
+    }
+
+    StreamingSession<T, V, P> newSess(_session);
+    newSess.time = _time;
+    if (index != _session.index)
+    {
+      if (index == _session.index + 1)
+      {
+        newSess.brickIndices[0] = newSess.brickIndices[1];
+      }
+      newSess.index = index;
+      this->Pin(newSess);
+    }
+    return newSess;
+  }
+
+  /// \brief Step several sessions to the same time, such as the sessions of
+  /// vehicles sharing a simulation clock. The time slice is searched for
+  /// once, and sessions that move to the same time slice and brick as a
+  /// previous one share its pins instead of looking them up in the cache.
+  /// Each session is stepped as
+  /// StepTo(const StreamingSession<T, V, P> &, const T &) would.
+  /// \param[in,out] _sessions - The sessions, stepped in place. Sessions for
+  /// which StepTo would return nullopt are left unchanged.
+  /// \param[in] _count - Number of sessions.
+  /// \param[in] _time - Time to step to.
+  /// \return Number of sessions that were stepped.
+  public: std::size_t StepTo(StreamingSession<T, V, P> *_sessions,
+    const std::size_t _count, const T &_time) const
+  {
+    // Last time slice at or before _time, which is where every session
+    // that can be stepped ends up
+    const std::size_t target = static_cast<std::size_t>(
+      std::upper_bound(this->times.begin(), this->times.end(), _time) -
+      this->times.begin());
+    if (target == 0)
+    {
+      return 0;
+    }
+
+    const StreamingSession<T, V, P> *pinned = nullptr;
+    std::size_t pinnedHint = kNoBrick;
+    std::size_t stepped = 0;
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+      StreamingSession<T, V, P> &sess = _sessions[i];
+      if (!sess.valid || sess.index + 1 >= this->times.size() ||
+          _time < this->times[sess.index])
+      {
+        continue;
+      }
+      ++stepped;
+      sess.time = _time;
+      if (sess.index == target - 1)
+      {
+        continue;
+      }
+
+      if (sess.index + 1 == target - 1)
+      {
+        sess.brickIndices[0] = sess.brickIndices[1];
+      }
+      sess.index = target - 1;
+
+      // Pin() only depends on the index and the first brick index
+      const std::size_t hint = sess.brickIndices[0];
+      if (pinned && hint == pinnedHint)
+      {
+        sess.valid = pinned->valid;
+        sess.bricks = pinned->bricks;
+        sess.brickIndices = pinned->brickIndices;
+        continue;
+      }
+      this->Pin(sess);
+      pinned = &sess;
+      pinnedHint = hint;
+    }
+    return stepped;
+  }
+
+  /// \brief Looks up a given point. If the point lies in between two time
+  /// frames then it performs spatio-temporal linear interpolation. Loads
+  /// the bricks of tiled time slices that contain the point if the session
+  /// does not hold them yet.
+  /// \return nullopt if the data is out of range.
+  public: std::optional<V>
+    LookUp(const StreamingSession<T, V, P> &_session,
+      const Vector3<P> &_pos,
+      const Vector3<P> &_tol = Vector3<P>{1e-6, 1e-6, 1e-6})
+    const
+  {
+    std::array<VolumetricGridCursor, 2> cursors;
+    return this->LookUp(_session, _pos, cursors, _tol);
+  }
+
+  /// \brief Looks up a given point, starting the spatial searches from
+  /// where the previous query with the same cursors fell. Queries along a
+  /// trajectory are faster this way. The result doesn't depend on the
+  /// cursors.
+  /// \param[in] _session - The session
+  /// \param[in] _pos - The point to query
+  /// \param[in,out] _cursors - Search hints for the current and next time
+  /// slices of the session, owned by the caller. They may be default
+  /// constructed and kept across StepTo().
+  /// \param[in] _tol - Tolerance
+  /// \return nullopt if the data is out of range.
+  public: std::optional<V>
+    LookUp(const StreamingSession<T, V, P> &_session,
+      const Vector3<P> &_pos,
+      std::array<VolumetricGridCursor, 2> &_cursors,
+      const Vector3<P> &_tol = Vector3<P>{1e-6, 1e-6, 1e-6})
+    const
+  {
+    if (!_session.valid)
+    {
+      return std::nullopt;
+    }
+
+    auto res1 = this->LookUpSlice(_session, 0, _pos, _cursors[0], _tol);
+    if (_session.index + 1 >= this->times.size())
+    {
+      // This happens we reach the end of time
+      return res1;
+    }
+    auto res2 = this->LookUpSlice(_session, 1, _pos, _cursors[1], _tol);
+
+    /// Only one of the two time-slices has data. Use that slice to guess.
+    if (!res2.has_value())
+    {
+      return res1;
+    }
+    if (!res1.has_value())
+    {
+      return res2;
+    }
+
+    /// Default case where both time-slices has interpolation
+    const T &time1 = this->times[_session.index];
+    const T &time2 = this->times[_session.index + 1];
+    auto t = (_session.time - time2) / (time1 - time2);
+    return (1 - t) * res2.value() + t * res1.value();
+  }
+
+  /// \brief Get the bounds of this grid field at given time. For a tiled
+  /// time slice these are the bounds of its tiling.
+  /// \return A pair of vectors. All zeros if session is invalid.
+  public: std::pair<Vector3<P>, Vector3<P>> Bounds(
+    const StreamingSession<T, V, P> &_session) const
+  {
+    if (!_session.valid)
+    {
+      return std::pair<Vector3<P>, Vector3<P>>(
+        Vector3<P>{0, 0, 0}, Vector3<P>{0, 0, 0});
+    }
+    if (this->Tiled(_session.index))
+    {
+      return this->tilings[_session.index].Bounds();
+    }
+    return _session.bricks[0]->field.Bounds();
+  }
+
+  /// \brief Get the memory held by the cache of loaded time slices.
+  /// Bricks that sessions released since the cache last went over the
+  /// memory budget are evicted first.
+  /// \return Sum of StreamingTimeSlice::bytes over the cached slices and
+  /// bricks, including the prefetched ones.
+  public: std::size_t MemoryUsage() const
+  {
+    std::lock_guard<std::mutex> lock(this->cache->mutex);
+    this->Settle(BrickKey(kNoBrick, kNoBrick));
+    return this->cache->bytes;
+  }
+
+  /// \brief Check whether a time slice is split into several bricks.
+  /// \param[in] _index Index of the time slice.
+  /// \return True if the slice has more than one brick.
+  private: bool Tiled(const std::size_t _index) const
+  {
+    return this->tilings[_index].BrickCount() > 1;
+  }
+
+  /// \brief Interpolate a point in the current or next time slice of a
+  /// session, switching the brick the session holds for that slice if the
+  /// point is in another one.
+  /// \param[in] _session The session.
+  /// \param[in] _slot 0 for the current time slice, 1 for the next one.
+  /// \param[in] _pos The point.
+  /// \param[in,out] _cursor Search hint in the time slice.
+  /// \param[in] _tol Tolerance along each axis.
+  /// \return The interpolated value, nullopt if the point is out of range
+  /// or its brick could not be loaded.
+  private: std::optional<V> LookUpSlice(
+    const StreamingSession<T, V, P> &_session, const std::size_t _slot,
+    const Vector3<P> &_pos, VolumetricGridCursor &_cursor,
+    const Vector3<P> &_tol) const
+  {
+    const std::size_t index = _session.index + _slot;
+    if (this->Tiled(index))
+    {
+      const std::size_t brick = this->tilings[index].Brick(_pos);
+      if (brick != _session.brickIndices[_slot])
+      {
+        _session.bricks[_slot] = this->Acquire(BrickKey(index, brick));
+        _session.brickIndices[_slot] = brick;
+      }
+    }
+    if (!_session.bricks[_slot])
+    {
+      return std::nullopt;
+    }
+
+    const auto &slice = *_session.bricks[_slot];
+    InterpolationPoints3D<P> points;
+    slice.field.GetInterpolators(
+      _pos, points, _cursor, _tol.X(), _tol.Y(), _tol.Z());
+    return slice.field.EstimateValueUsingTrilinear(
+      points, _pos, slice.Values(), V(0));
+  }
+
+  /// \brief Load the current and next time slices of a session, and start
+  /// loading the one after them. For tiled time slices, only the brick the
+  /// session queried last is loaded, if any.
+  /// \param[in,out] _session The session.
+  private: void Pin(StreamingSession<T, V, P> &_session) const
+  {
+    const std::size_t hint = _session.brickIndices[0];
+    for (std::size_t slot = 0; slot < 2; ++slot)
+    {
+      const std::size_t index = _session.index + slot;
+      _session.bricks[slot] = nullptr;
+      _session.brickIndices[slot] = kNoBrick;
+      if (index >= this->times.size())
+      {
+        continue;
+      }
+      const std::size_t brick = this->Tiled(index) ? hint : 0;
+      if (brick < this->tilings[index].BrickCount())
+      {
+        _session.bricks[slot] = this->Acquire(BrickKey(index, brick));
+        _session.brickIndices[slot] = brick;
+      }
+    }
+    _session.valid = _session.index < this->times.size() &&
+      (_session.bricks[0] || this->Tiled(_session.index));
+
+    const std::size_t after = _session.index + 2;
+    if (after < this->times.size())
+    {
+      const std::size_t brick = this->Tiled(after) ? hint : 0;
+      if (brick < this->tilings[after].BrickCount())
+      {
+        this->Fetch(BrickKey(after, brick), std::launch::async);
+      }
+    }
+  }
+
+  /// \brief Get a brick, loading it on the calling thread unless it is
+  /// already loaded or being loaded.
+  /// \param[in] _key Index of the time slice and of the brick.
+  /// \return The brick, nullptr if it does not exist or failed to load.
+  private: SlicePtr Acquire(const BrickKey &_key) const
+  {
+    std::shared_future<SlicePtr> future =
+      this->Fetch(_key, std::launch::deferred);
+    if (!future.valid())
+    {
+      return nullptr;
+    }
+    SlicePtr slice = future.get();
+
+    std::lock_guard<std::mutex> lock(this->cache->mutex);
+    auto it = this->cache->entries.find(_key);
+    if (it != this->cache->entries.end())
+    {
+      if (slice)
+      {
+        this->Charge(it->second, *slice);
+        it->second.lastUse = ++this->cache->clock;
+      }
+      else
+      {
+        // Failed loads are not cached, so that they are retried
+        this->cache->entries.erase(it);
+      }
+    }
+    this->Settle(_key);
+    return slice;
+  }
+
+  /// \brief Start loading a brick unless it is already cached.
+  /// \param[in] _key Index of the time slice and of the brick.
+  /// \param[in] _policy How to run the loader.
+  /// \return Future of the brick, invalid if it does not exist.
+  private: std::shared_future<SlicePtr> Fetch(
+    const BrickKey &_key, const std::launch _policy) const
+  {
+    if (_key.first >= this->times.size() ||
+        _key.second >= this->tilings[_key.first].BrickCount())
+    {
+      return std::shared_future<SlicePtr>();
+    }
+
+    std::lock_guard<std::mutex> lock(this->cache->mutex);
+    this->Settle(_key);
+    auto &entry = this->cache->entries[_key];
+    if (!entry.slice.valid())
+    {
+      // Only capture the loader so that the task does not keep the cache
+      // alive
+      const Loader &loader = this->loaders[_key.first];
+      const std::size_t brick = _key.second;
+      entry.slice = std::async(_policy, [loader, brick]() -> SlicePtr
+      {
+        auto slice = std::make_shared<StreamingTimeSlice<V, P>>();
+        if (!loader(brick, *slice))
+        {
+          return nullptr;
+        }
+        return slice;
+      }).share();
+    }
+    return entry.slice;
+  }
+
+  /// \brief Count the bytes of a loaded brick, unless they are counted
+  /// already. The cache mutex must be held.
+  /// \param[in,out] _entry The entry of the brick.
+  /// \param[in] _slice The loaded brick.
+  private: void Charge(CacheEntry &_entry,
+    const StreamingTimeSlice<V, P> &_slice) const
+  {
+    if (_entry.bytes > 0)
+    {
+      return;
+    }
+    _entry.bytes = _slice.bytes > 0 ? _slice.bytes :
+      std::max<std::size_t>(1, _slice.values.size() * sizeof(V));
+    _entry.lastUse = ++this->cache->clock;
+    this->cache->bytes += _entry.bytes;
+  }
+
+  /// \brief Count the bytes of the bricks that finished loading, such as
+  /// prefetched ones, and drop the ones that failed to load so that they
+  /// are loaded again. Then evict bricks until the cache fits in the
+  /// memory budget. The cache mutex must be held.
+  /// \param[in] _keep Key of a brick that must not be evicted.
+  private: void Settle(const BrickKey &_keep) const
+  {
+    auto &entries = this->cache->entries;
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+      auto &entry = it->second;
+      if (entry.bytes > 0 || !entry.slice.valid() ||
+          entry.slice.wait_for(std::chrono::seconds(0)) !=
+            std::future_status::ready)
+      {
+        ++it;
+      }
+      else if (const SlicePtr &slice = entry.slice.get())
+      {
+        this->Charge(entry, *slice);
+        ++it;
+      }
+      else
+      {
+        it = entries.erase(it);
+      }
+    }
+    this->Evict(_keep);
+  }
+
+  /// \brief Evict least recently used bricks that no session holds until
+  /// the cache fits in the memory budget. The cache mutex must be held.
+  /// \param[in] _keep Key of a brick that must not be evicted.
+  private: void Evict(const BrickKey &_keep) const
+  {
+    auto &entries = this->cache->entries;
+    while (this->cache->bytes > this->memoryBudget)
+    {
+      auto oldest = entries.end();
+      for (auto it = entries.begin(); it != entries.end(); ++it)
+      {
+        // Only the cache holds the brick if its use count is one
+        if (it->first == _keep || it->second.bytes == 0 ||
+            it->second.slice.get().use_count() > 1)
+        {
+          continue;
+        }
+        if (oldest == entries.end() ||
+            it->second.lastUse < oldest->second.lastUse)
+        {
+          oldest = it;
+        }
+      }
+      if (oldest == entries.end())
+      {
+        return;
+      }
+      this->cache->bytes -= oldest->second.bytes;
+      entries.erase(oldest);
+    }
+  }
+
+  /// \brief A brick in the cache.
+  private: struct CacheEntry
+  {
+    /// \brief The brick, possibly still loading.
+    std::shared_future<SlicePtr> slice;
+
+    /// \brief Bytes counted for the brick, zero until it is loaded.
+    std::size_t bytes{0};
+
+    /// \brief Value of the cache clock when the brick was last used.
+    std::uint64_t lastUse{0};
+  };
+
+  /// \brief Loaded bricks, shared by copies of the grid.
+  private: struct Cache
+  {
+    /// \brief Protects the other members.
+    std::mutex mutex;
+
+    /// \brief Cached bricks by time slice and brick index.
+    std::map<BrickKey, CacheEntry> entries;
+
+    /// \brief Sum of the bytes of the entries.
+    std::size_t bytes{0};
+
+    /// \brief Incremented every time a brick is used.
+    std::uint64_t clock{0};
+  };
+
+  /// \brief Time of each slice, sorted.
+  private: std::vector<T> times;
+
+  /// \brief Loader of each slice.
+  private: std::vector<Loader> loaders;
+
+  /// \brief Bricks of each slice.
+  private: std::vector<VolumetricGridTiling<P>> tilings;
+
+  /// \brief Maximum bytes of bricks kept when no session uses them.
+  private: std::size_t memoryBudget{std::numeric_limits<std::size_t>::max()};
+
+  /// \brief Cache of loaded bricks.
+  private: std::shared_ptr<Cache> cache{std::make_shared<Cache>()};
+
+  template<typename U, typename S, typename X>
+  friend class StreamingTimeVaryingVolumetricGridFactory;
+};
+
+/// \brief Alias for Specialization of TimeVaryingVolumetricGrid which loads
+/// time slices on demand.
+template<typename T, typename V = T, typename P = T>
+using StreamingTimeVaryingVolumetricGrid =
+  TimeVaryingVolumetricGrid<T, V, StreamingSession<T, V, P>, P>;
+
+/// \brief Factory class for constructing a
+/// StreamingTimeVaryingVolumetricGrid.
+template<typename T, typename V, typename P = double>
+class StreamingTimeVaryingVolumetricGridFactory
+{
+  /// \brief Adds a time slice loaded by a callback. The callback may be
+  /// called on a background thread, and again if the slice was evicted.
+  /// \param[in] _time - Time of the slice
+  /// \param[in] _loader - Function filling in the slice, returning false if
+  /// it could not be loaded.
+  public: void AddTimeSlice(const T &_time,
+    std::function<bool(StreamingTimeSlice<V, P> &)> _loader)
+  {
+    this->AddTiledTimeSlice(_time, VolumetricGridTiling<P>(),
+      [_loader = std::move(_loader)](std::size_t,
+                                     StreamingTimeSlice<V, P> &_slice)
+      {
+        return _loader(_slice);
+      });
+  }
+
+  /// \brief Adds a time slice memory mapped from a file written by
+  /// VolumetricGridLookupField::Save(std::ostream &, const std::vector<V> &).
+  /// \param[in] _time - Time of the slice
+  /// \param[in] _path - Path of the file
+  public: void AddTimeSliceFile(const T &_time, const std::string &_path)
+  {
+    this->AddTimeSlice(_time, [_path](StreamingTimeSlice<V, P> &_slice)
+    {
+      return LoadFile(_path, _slice);
+    });
+  }
+
+  /// \brief Adds a time slice split into bricks, each loaded by a callback
+  /// when it is first queried. The callback may be called on a background
+  /// thread, and again if the brick was evicted.
+  /// \param[in] _time - Time of the slice
+  /// \param[in] _tiling - How the slice is split into bricks
+  /// \param[in] _loader - Function filling in the brick with the given
+  /// index, see VolumetricGridTiling::Brick(). The brick must hold the grid
+  /// points for which VolumetricGridTiling::BrickContains() is true. It
+  /// returns false if the brick could not be loaded.
+  public: void AddTiledTimeSlice(const T &_time,
+    VolumetricGridTiling<P> _tiling,
+    std::function<bool(std::size_t, StreamingTimeSlice<V, P> &)> _loader)
+  {
+    this->slices[_time] = Slice{std::move(_tiling), std::move(_loader)};
+  }
+
+  /// \brief Adds a time slice split into bricks, each memory mapped from a
+  /// file written by
+  /// VolumetricGridLookupField::Save(std::ostream &, const std::vector<V> &).
+  /// \param[in] _time - Time of the slice
+  /// \param[in] _tiling - How the slice is split into bricks
+  /// \param[in] _paths - Path of the file of each brick, in brick order
+  public: void AddTiledTimeSliceFiles(const T &_time,
+    VolumetricGridTiling<P> _tiling, std::vector<std::string> _paths)
+  {
+    this->AddTiledTimeSlice(_time, std::move(_tiling),
+      [_paths = std::move(_paths)](std::size_t _brick,
+                                   StreamingTimeSlice<V, P> &_slice)
+      {
+        return _brick < _paths.size() && LoadFile(_paths[_brick], _slice);
+      });
+  }
+
+  /// \brief Sets the memory budget of the grid.
+  /// \param[in] _bytes - Maximum bytes of time slices and bricks to keep
+  /// loaded when no session uses them. Unlimited by default.
+  public: void SetMemoryBudget(const std::size_t _bytes)
+  {
+    this->memoryBudget = _bytes;
+  }
+
+  /// \brief Builds the `StreamingTimeVaryingVolumetricGrid<T, V, P>` object.
+  /// No slice is loaded until a session is created.
+  public: StreamingTimeVaryingVolumetricGrid<T, V, P> Build() const
+  {
+    StreamingTimeVaryingVolumetricGrid<T, V, P> grid;
+    for (const auto &[time, slice] : this->slices)
+    {
+      grid.times.push_back(time);
+      grid.tilings.push_back(slice.tiling);
+      grid.loaders.push_back(slice.loader);
+    }
+    grid.memoryBudget = this->memoryBudget;
+    return grid;
+  }
+
+  /// \brief Memory map a slice or brick from a file.
+  /// \param[in] _path - Path of the file
+  /// \param[out] _slice - The slice
+  /// \return True if the file holds a field with values of type V.
+  private: static bool LoadFile(const std::string &_path,
+    StreamingTimeSlice<V, P> &_slice)
+  {
+    auto file = std::make_shared<MemoryMappedFile>();
+    if (!file->Open(_path) ||
+        !_slice.field.Load(file->Data(), file->Size()))
+    {
+      return false;
+    }
+    _slice.data = _slice.field.template Values<V>();
+    if (!_slice.data)
+    {
+      return false;
+    }
+    _slice.bytes = file->Size();
+    _slice.storage = file;
+    return true;
+  }
+
+  /// A registered time slice
+  private: struct Slice
+  {
+    /// How the slice is split into bricks
+    VolumetricGridTiling<P> tiling;
+
+    /// Loader of each brick
+    std::function<bool(std::size_t, StreamingTimeSlice<V, P> &)> loader;
+  };
+
+  /// Each time slice
+  private: std::map<T, Slice> slices;
+
+  /// Memory budget of the grid
+  private: std::size_t memoryBudget{std::numeric_limits<std::size_t>::max()};
+};
+
 }
 }
 
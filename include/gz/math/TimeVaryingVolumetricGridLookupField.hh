@@ -17,9 +17,16 @@
 
 #ifndef GZ_MATH_TIME_VARYING_VOLUMETRIC_GRID_LOOKUP_FIELD_HH_
 #define GZ_MATH_TIME_VARYING_VOLUMETRIC_GRID_LOOKUP_FIELD_HH_
+#include <gz/math/QuantizedValues.hh>
 #include <gz/math/VolumetricGridLookupField.hh>
 #include <gz/math/detail/InterpolationPoint.hh>
 
+#include <gz/utils/SuppressWarning.hh>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <optional>
 #include <utility>
@@ -94,7 +101,10 @@ namespace gz
     };
 
     /// \brief An in-memory session. Loads the whole dataset in memory and
-    /// performs queries.
+    /// performs queries. Queries don't modify the session, so a session may
+    /// be shared by several threads. To speed up nearby queries, keep a
+    /// pair of VolumetricGridCursor and pass it to the queries that take
+    /// one.
     template<typename T, typename V>
     class InMemorySession
     {
@@ -111,6 +121,88 @@ namespace gz
         TimeVaryingVolumetricGridLookupField<T, V, InMemorySession<T, V>>;
     };
 
+    /// \brief Values of the two time slices of an InMemorySession blended
+    /// at the time of the session, for the optional cached mode of
+    /// TimeVaryingVolumetricGridLookupField::EstimateQuadrilinear. Each
+    /// blended value is computed the first time a query touches it and
+    /// reused until the cache is invalidated, so repeated queries in the
+    /// same cells at the same time interpolate once instead of twice.
+    ///
+    /// The cache is invalidated automatically when it is used with a
+    /// session on other time slices or at another time, or with other value
+    /// arrays. Call Invalidate() after changing the contents of the value
+    /// arrays it was used with. A cache must not be shared between threads.
+    /// \tparam T Type of the time.
+    /// \tparam V Type of the positions.
+    /// \tparam X Type of the values.
+    template<typename T, typename V, typename X>
+    class InMemoryBlendCache
+    {
+      /// \brief Discard all blended values.
+      public: void Invalidate()
+      {
+        this->slice = nullptr;
+      }
+
+      /// \brief Start a new set of blended values, marking the current ones
+      /// as stale without clearing them.
+      private: void NextGeneration()
+      {
+        if (++this->generation == 0)
+        {
+          std::fill(this->stamps.begin(), this->stamps.end(), 0u);
+          this->generation = 1;
+        }
+      }
+
+      /// \brief Compute a blended value unless it is current.
+      /// \param[in] _index Index of the value.
+      /// \param[in] _t Weight of the value at the first time slice.
+      private: void Blend(const std::size_t _index, const T &_t)
+      {
+        if (_index >= this->blended.size())
+        {
+          this->blended.resize(_index + 1);
+          this->stamps.resize(_index + 1, 0u);
+        }
+        if (this->stamps[_index] != this->generation)
+        {
+          this->blended[_index] = (1 - _t) * this->values2[_index] +
+            _t * this->values1[_index];
+          this->stamps[_index] = this->generation;
+        }
+      }
+
+      /// \brief First time slice of the blended values, nullptr if the cache
+      /// is invalid.
+      private: const VolumetricGridLookupField<V> *slice{nullptr};
+
+      /// \brief Time of the blended values.
+      private: T time{};
+
+      /// \brief Values at the first time slice.
+      private: const X *values1{nullptr};
+
+      /// \brief Values at the second time slice.
+      private: const X *values2{nullptr};
+
+      /// \brief Whether the two time slices share their indices. If not,
+      /// queries are not cached.
+      private: bool sameIndices{false};
+
+      /// \brief Blended values, by index.
+      private: std::vector<X> blended;
+
+      /// \brief Generation in which each blended value was computed.
+      private: std::vector<std::uint32_t> stamps;
+
+      /// \brief Current generation, zero marks values never computed.
+      private: std::uint32_t generation{1};
+
+      friend class
+        TimeVaryingVolumetricGridLookupField<T, V, InMemorySession<T, V>>;
+    };
+
     /// \brief Specialized version of `TimeVaryingVolumetricGridLookupField`
     /// for in-memory lookup. It loads the whole dataset into memory.
     template<typename T, typename V>
@@ -173,6 +265,44 @@ namespace gz
         return newSess;
       }
 
+      /// \brief Step several sessions to the same time, such as the
+      /// sessions of vehicles sharing a simulation clock. The time slice is
+      /// searched for once for all of them. Each session is stepped as
+      /// StepTo(const InMemorySession<T, V> &, const T &) would.
+      /// \param[in,out] _sessions - The sessions, stepped in place. Sessions
+      /// for which StepTo would return nullopt are left unchanged.
+      /// \param[in] _count - Number of sessions.
+      /// \param[in] _time - Time to step to.
+      /// \return Number of sessions that were stepped.
+      public: std::size_t StepTo(InMemorySession<T, V> *_sessions,
+        const std::size_t _count, const T &_time) const
+      {
+        // Last time slice at or before _time, which is where every session
+        // that can be stepped ends up
+        auto target = this->gridFields.upper_bound(_time);
+        if (target == this->gridFields.begin())
+        {
+          return 0;
+        }
+        --target;
+
+        std::size_t stepped = 0;
+        for (std::size_t i = 0; i < _count; ++i)
+        {
+          InMemorySession<T, V> &sess = _sessions[i];
+          if (sess.iter == this->gridFields.end() ||
+              std::next(sess.iter) == this->gridFields.end() ||
+              _time < sess.iter->first)
+          {
+            continue;
+          }
+          sess.iter = target;
+          sess.time = _time;
+          ++stepped;
+        }
+        return stepped;
+      }
+
       /// \brief Documentation inherited
       public: std::vector<InterpolationPoint4D<T, V>>
         LookUp(const InMemorySession<T, V> &_session,
@@ -295,6 +425,355 @@ namespace gz
         return std::nullopt;
       }
 
+      /// \brief Uses quadrilinear interpolation to estimate value of a point
+      /// without allocating. This is equivalent to calling `LookUp()`
+      /// followed by `EstimateQuadrilinear()` with its result.
+      /// \param[in] _session - The session
+      /// \param[in] _position - The position to be queried.
+      /// \param[in] _values1 - Value array at timestep 1.
+      /// \param[in] _values2 - Value array at timestep 2.
+      /// \param[in] _tol - Tolerance of the spatial lookup.
+      /// \param[in] _default - Value used if there is a hole in the data.
+      /// \returns The estimated value for the point. Nullopt if we are
+      /// outside the field. Default value if in the field but no value is
+      /// in the index.
+      public: template<typename X>
+      std::optional<X> EstimateQuadrilinear(
+        const InMemorySession<T, V> &_session,
+        const Vector3<V> &_position,
+        const std::vector<X> &_values1,
+        const std::vector<X> &_values2,
+        const Vector3<V> &_tol = Vector3<V>{1e-6, 1e-6, 1e-6},
+        const X _default = X(0)
+      ) const
+      {
+        std::array<VolumetricGridCursor, 2> cursors;
+        return this->EstimateQuadrilinearImpl(_session, _position,
+          _values1.data(), _values2.data(), cursors, _tol, _default);
+      }
+
+      /// \brief Uses quadrilinear interpolation to estimate value of a point
+      /// without allocating, starting the spatial searches from where the
+      /// previous query with the same cursors fell. Queries along a
+      /// trajectory are faster this way. The result doesn't depend on the
+      /// cursors.
+      /// \param[in] _session - The session
+      /// \param[in] _position - The position to be queried.
+      /// \param[in] _values1 - Value array at timestep 1.
+      /// \param[in] _values2 - Value array at timestep 2.
+      /// \param[in,out] _cursors - Search hints for the current and next
+      /// time slices of the session, owned by the caller. They may be
+      /// default constructed and kept across StepTo().
+      /// \param[in] _tol - Tolerance of the spatial lookup.
+      /// \param[in] _default - Value used if there is a hole in the data.
+      /// \returns The estimated value for the point. Nullopt if we are
+      /// outside the field. Default value if in the field but no value is
+      /// in the index.
+      public: template<typename X>
+      std::optional<X> EstimateQuadrilinear(
+        const InMemorySession<T, V> &_session,
+        const Vector3<V> &_position,
+        const std::vector<X> &_values1,
+        const std::vector<X> &_values2,
+        std::array<VolumetricGridCursor, 2> &_cursors,
+        const Vector3<V> &_tol = Vector3<V>{1e-6, 1e-6, 1e-6},
+        const X _default = X(0)
+      ) const
+      {
+        return this->EstimateQuadrilinearImpl(_session, _position,
+          _values1.data(), _values2.data(), _cursors, _tol, _default);
+      }
+
+      /// \brief Uses quadrilinear interpolation to estimate value of a point,
+      /// caching the values of the two time slices blended at the time of
+      /// the session. If both time slices have the same indices, see
+      /// VolumetricGridLookupField::SameIndices(), a query interpolates in
+      /// one time slice instead of two, and the blended values it uses are
+      /// kept for the next queries at the same time. Either way the result
+      /// is the same as without a cache, up to rounding.
+      /// \param[in] _session - The session
+      /// \param[in] _position - The position to be queried.
+      /// \param[in] _values1 - Value array at timestep 1.
+      /// \param[in] _values2 - Value array at timestep 2.
+      /// \param[in,out] _cache - Blended values, see InMemoryBlendCache.
+      /// \param[in] _tol - Tolerance of the spatial lookup.
+      /// \param[in] _default - Value used if there is a hole in the data.
+      /// \returns The estimated value for the point. Nullopt if we are
+      /// outside the field. Default value if in the field but no value is
+      /// in the index.
+      public: template<typename X>
+      std::optional<X> EstimateQuadrilinear(
+        const InMemorySession<T, V> &_session,
+        const Vector3<V> &_position,
+        const std::vector<X> &_values1,
+        const std::vector<X> &_values2,
+        InMemoryBlendCache<T, V, X> &_cache,
+        const Vector3<V> &_tol = Vector3<V>{1e-6, 1e-6, 1e-6},
+        const X _default = X(0)
+      ) const
+      {
+        if (_session.iter == this->gridFields.end() ||
+            std::next(_session.iter) == this->gridFields.end())
+        {
+          std::array<VolumetricGridCursor, 2> cursors;
+          return this->EstimateQuadrilinearImpl(_session, _position,
+            _values1.data(), _values2.data(), cursors, _tol, _default);
+        }
+
+        const auto &slice1 = _session.iter->second;
+        auto next = std::next(_session.iter);
+        // Only the exact time the weights were computed for can reuse them
+        GZ_UTILS_WARN_IGNORE__FLOAT_EQUAL
+        const bool timeChanged = _cache.time != _session.time;
+        GZ_UTILS_WARN_RESUME__FLOAT_EQUAL
+        if (_cache.slice != &slice1 ||
+            _cache.values1 != _values1.data() ||
+            _cache.values2 != _values2.data())
+        {
+          _cache.slice = &slice1;
+          _cache.values1 = _values1.data();
+          _cache.values2 = _values2.data();
+          _cache.sameIndices = slice1.SameIndices(next->second);
+          _cache.time = _session.time;
+          _cache.NextGeneration();
+        }
+        else if (timeChanged)
+        {
+          _cache.time = _session.time;
+          _cache.NextGeneration();
+        }
+        if (!_cache.sameIndices)
+        {
+          std::array<VolumetricGridCursor, 2> cursors;
+          return this->EstimateQuadrilinearImpl(_session, _position,
+            _values1.data(), _values2.data(), cursors, _tol, _default);
+        }
+
+        InterpolationPoints3D<V> points;
+        slice1.GetInterpolators(
+          _position, points, _tol.X(), _tol.Y(), _tol.Z());
+        const T t = (_session.time - next->first) /
+          (_session.iter->first - next->first);
+        for (std::size_t i = 0; i < points.count; ++i)
+        {
+          if (points.points[i].index)
+            _cache.Blend(points.points[i].index.value(), t);
+        }
+        return slice1.EstimateValueUsingTrilinear(
+          points, _position, _cache.blended.data(), _default);
+      }
+
+      /// \brief Uses quadrilinear interpolation to estimate value of a point
+      /// from quantized values without allocating. The estimate is within
+      /// the largest MaxError() of the two value arrays of the estimate with
+      /// the original values.
+      /// \param[in] _session - The session
+      /// \param[in] _position - The position to be queried.
+      /// \param[in] _values1 - Value array at timestep 1.
+      /// \param[in] _values2 - Value array at timestep 2.
+      /// \param[in] _tol - Tolerance of the spatial lookup.
+      /// \param[in] _default - Value used if there is a hole in the data.
+      /// \returns The estimated value for the point. Nullopt if we are
+      /// outside the field. Default value if in the field but no value is
+      /// in the index.
+      public: template<typename Q, typename X>
+      std::optional<X> EstimateQuadrilinear(
+        const InMemorySession<T, V> &_session,
+        const Vector3<V> &_position,
+        const QuantizedValues<Q, X> &_values1,
+        const QuantizedValues<Q, X> &_values2,
+        const Vector3<V> &_tol = Vector3<V>{1e-6, 1e-6, 1e-6},
+        const X _default = X(0)
+      ) const
+      {
+        std::array<VolumetricGridCursor, 2> cursors;
+        return this->EstimateQuadrilinearImpl(_session, _position,
+          _values1, _values2, cursors, _tol, _default);
+      }
+
+      /// \brief Uses quadrilinear interpolation to estimate several values
+      /// of a point at once given interleaved values, such as the components
+      /// of a vector field. The interpolation weights are computed once for
+      /// all channels and each channel gives the same result as
+      /// EstimateQuadrilinear with the values of that channel.
+      /// \param[in] _session - The session
+      /// \param[in] _position - The position to be queried.
+      /// \param[in] _values1 - Values at timestep 1, with the _channels
+      /// values of each index stored next to each other.
+      /// \param[in] _values2 - Values at timestep 2, stored in the same way.
+      /// \param[in] _channels - Number of values per index.
+      /// \param[out] _out - Pointer to the _channels estimates. Not modified
+      /// if the point is outside the field.
+      /// \param[in] _tol - Tolerance of the spatial lookup.
+      /// \param[in] _default - Value of every channel used if there is a
+      /// hole in the data.
+      /// \returns False if we are outside the field.
+      public: template<typename X>
+      bool EstimateQuadrilinearChannels(
+        const InMemorySession<T, V> &_session,
+        const Vector3<V> &_position,
+        const X *_values1,
+        const X *_values2,
+        const std::size_t _channels,
+        X *_out,
+        const Vector3<V> &_tol = Vector3<V>{1e-6, 1e-6, 1e-6},
+        const X _default = X(0)
+      ) const
+      {
+        if (_session.iter == this->gridFields.end())
+        {
+          // Out of bounds
+          return false;
+        }
+
+        InterpolationPoints3D<V> points1;
+        std::array<V, 8> weights1;
+        _session.iter->second.GetInterpolators(
+          _position, points1, _tol.X(), _tol.Y(), _tol.Z());
+        const bool valid1 = InterpolationWeights(points1, _position, weights1);
+
+        auto next = std::next(_session.iter);
+        if (next == this->gridFields.end())
+        {
+          // This happens we reach the end of time
+          if (!valid1)
+            return false;
+          std::fill(_out, _out + _channels, X(0));
+          AccumulateInterpolatedChannels(points1, weights1, _values2,
+            _channels, _default, _out);
+          return true;
+        }
+
+        InterpolationPoints3D<V> points2;
+        std::array<V, 8> weights2;
+        next->second.GetInterpolators(
+          _position, points2, _tol.X(), _tol.Y(), _tol.Z());
+        const bool valid2 = InterpolationWeights(points2, _position, weights2);
+
+        if (!valid1 && !valid2)
+          return false;
+
+        /// Fold the time interpolation into the spatial weights. If only one
+        /// of the two time-slices has data, use that slice to guess.
+        if (valid1 && valid2)
+        {
+          const auto t = (_session.time - next->first) /
+            (_session.iter->first - next->first);
+          for (std::size_t i = 0; i < points1.count; ++i)
+            weights1[i] *= static_cast<V>(t);
+          for (std::size_t i = 0; i < points2.count; ++i)
+            weights2[i] *= static_cast<V>(1 - t);
+        }
+
+        std::fill(_out, _out + _channels, X(0));
+        if (valid1)
+        {
+          AccumulateInterpolatedChannels(points1, weights1, _values1,
+            _channels, _default, _out);
+        }
+        if (valid2)
+        {
+          AccumulateInterpolatedChannels(points2, weights2, _values2,
+            _channels, _default, _out);
+        }
+        return true;
+      }
+
+      /// \brief Uses quadrilinear interpolation to estimate a vector at a
+      /// point given the interleaved X, Y and Z components, see
+      /// EstimateQuadrilinearChannels.
+      /// \param[in] _session - The session
+      /// \param[in] _position - The position to be queried.
+      /// \param[in] _values1 - Components at timestep 1, three per index.
+      /// \param[in] _values2 - Components at timestep 2, three per index.
+      /// \param[in] _tol - Tolerance of the spatial lookup.
+      /// \param[in] _default - Value of every component used if there is a
+      /// hole in the data.
+      /// \returns The estimated vector for the point. Nullopt if we are
+      /// outside the field.
+      public: template<typename X>
+      std::optional<Vector3<X>> EstimateQuadrilinearVector3(
+        const InMemorySession<T, V> &_session,
+        const Vector3<V> &_position,
+        const std::vector<X> &_values1,
+        const std::vector<X> &_values2,
+        const Vector3<V> &_tol = Vector3<V>{1e-6, 1e-6, 1e-6},
+        const X _default = X(0)
+      ) const
+      {
+        X out[3];
+        if (!this->EstimateQuadrilinearChannels(_session, _position,
+              _values1.data(), _values2.data(), 3, out, _tol, _default))
+        {
+          return std::nullopt;
+        }
+        return Vector3<X>(out[0], out[1], out[2]);
+      }
+
+      /// \brief Quadrilinear interpolation of values read from any array
+      /// type, see EstimateQuadrilinear.
+      /// \param[in] _session - The session
+      /// \param[in] _position - The position to be queried.
+      /// \param[in] _values1 - Values at timestep 1, a pointer or any type
+      /// with an operator[].
+      /// \param[in] _values2 - Values at timestep 2.
+      /// \param[in,out] _cursors - Search hints of the two time slices.
+      /// \param[in] _tol - Tolerance of the spatial lookup.
+      /// \param[in] _default - Value used if there is a hole in the data.
+      /// \returns The estimated value for the point.
+      private: template<typename L, typename X>
+      std::optional<X> EstimateQuadrilinearImpl(
+        const InMemorySession<T, V> &_session,
+        const Vector3<V> &_position,
+        const L &_values1,
+        const L &_values2,
+        std::array<VolumetricGridCursor, 2> &_cursors,
+        const Vector3<V> &_tol,
+        const X _default
+      ) const
+      {
+        if (_session.iter == this->gridFields.end())
+        {
+          // Out of bounds
+          return std::nullopt;
+        }
+
+        InterpolationPoints3D<V> points;
+        _session.iter->second.GetInterpolators(_position, points,
+          _cursors[0], _tol.X(), _tol.Y(), _tol.Z());
+
+        auto next = std::next(_session.iter);
+        if (next == this->gridFields.end())
+        {
+          // This happens we reach the end of time
+          return _session.iter->second.EstimateValueUsingTrilinear(
+            points, _position, _values2, _default);
+        }
+
+        auto res1 = _session.iter->second.EstimateValueUsingTrilinear(
+          points, _position, _values1, _default);
+
+        next->second.GetInterpolators(_position, points,
+          _cursors[1], _tol.X(), _tol.Y(), _tol.Z());
+        auto res2 = next->second.EstimateValueUsingTrilinear(
+          points, _position, _values2, _default);
+
+        /// Only one of the two time-slices has data. Use that slice to guess.
+        if (!res2.has_value())
+        {
+          return res1;
+        }
+        if (!res1.has_value())
+        {
+          return res2;
+        }
+
+        /// Default case where both time-slices has interpolation
+        auto t = (_session.time - next->first) /
+          (_session.iter->first - next->first);
+        return (1 - t) * res2.value() + t * res1.value();
+      }
+
       /// \brief Get the bounds of this grid field.
       /// \return A pair of vectors. All zeros if session is invalid.
       public: std::pair<Vector3<V>, Vector3<V>> Bounds(
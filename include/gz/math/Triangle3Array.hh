@@ -0,0 +1,464 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_TRIANGLE3ARRAY_HH_
+#define GZ_MATH_TRIANGLE3ARRAY_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <gz/math/AxisAlignedBox.hh>
+#include <gz/math/Helpers.hh>
+#include <gz/math/Triangle3.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class Triangle3Array Triangle3Array.hh gz/math/Triangle3Array.hh
+    /// \brief A structure-of-arrays container of triangles for ray casting.
+    ///
+    /// Each triangle is stored as its first vertex and the two edges
+    /// leaving it, with every component in its own contiguous buffer. The
+    /// ray queries use the Moller-Trumbore test in blocks of
+    /// kBlockSize triangles: the hit distances of a block are computed by a
+    /// branch free loop, which the compiler turns into SIMD code for the
+    /// target architecture, and the closest one is picked afterwards.
+    ///
+    /// Triangles are hit from both sides. Ray queries take a range of
+    /// triangles, so that a bounding volume hierarchy such as
+    /// AxisAlignedBoxTree can be built over the bounds of consecutive
+    /// blocks of triangles and test only the blocks its leaves reach.
+    ///
+    /// # Example
+    ///
+    /// \code{.cpp}
+    /// gz::math::Triangle3Arrayd triangles(vertices.data(), vertices.size(),
+    ///     indices.data(), indices.size() / 3);
+    /// std::vector<gz::math::AxisAlignedBox> blocks;
+    /// triangles.BlockBounds(blocks);
+    /// gz::math::AxisAlignedBoxTree tree(blocks);
+    /// std::size_t block, triangle;
+    /// double distance;
+    /// tree.RayClosestHit(origin, dir, 0, 100,
+    ///     [&](std::size_t _block, double _max, double &_distance)
+    ///     {
+    ///       return triangles.RayClosestHit(origin, dir, 0, _max,
+    ///           _block * triangles.kBlockSize,
+    ///           (_block + 1) * triangles.kBlockSize, triangle, _distance);
+    ///     }, block, distance);
+    /// \endcode
+    template<typename T>
+    class Triangle3Array
+    {
+      /// \brief Number of triangles tested together by the ray queries,
+      /// and covered by each box of BlockBounds.
+      public: static constexpr std::size_t kBlockSize = 8;
+
+      /// \brief Default constructor, creates an empty array.
+      public: Triangle3Array() = default;
+
+      /// \brief Constructor from triangles.
+      /// \param[in] _triangles Triangles to copy.
+      public: explicit Triangle3Array(
+                  const std::vector<Triangle3<T>> &_triangles)
+      {
+        this->Assign(_triangles.data(), _triangles.size());
+      }
+
+      /// \brief Constructor from an indexed triangle mesh.
+      /// \param[in] _vertices Pointer to the vertices of the mesh.
+      /// \param[in] _vertexCount Number of vertices.
+      /// \param[in] _indices Pointer to three vertex indices per triangle.
+      /// \param[in] _triangleCount Number of triangles.
+      /// \sa Assign
+      public: Triangle3Array(const Vector3<T> *_vertices,
+                             const std::size_t _vertexCount,
+                             const unsigned int *_indices,
+                             const std::size_t _triangleCount)
+      {
+        this->Assign(_vertices, _vertexCount, _indices, _triangleCount);
+      }
+
+      /// \brief Replace the contents of this array.
+      /// \param[in] _triangles Pointer to the first triangle to copy.
+      /// \param[in] _count Number of triangles to copy.
+      public: void Assign(const Triangle3<T> *_triangles,
+                          const std::size_t _count)
+      {
+        this->Resize(_count);
+        for (std::size_t i = 0; i < _count; ++i)
+          this->SetTriangle(i, _triangles[i][0], _triangles[i][1],
+                            _triangles[i][2]);
+      }
+
+      /// \brief Replace the contents of this array with the triangles of
+      /// an indexed mesh.
+      /// \param[in] _vertices Pointer to the vertices of the mesh.
+      /// \param[in] _vertexCount Number of vertices.
+      /// \param[in] _indices Pointer to three vertex indices per triangle.
+      /// \param[in] _triangleCount Number of triangles.
+      /// \return False if an index is not smaller than _vertexCount, in
+      /// which case the array is left empty.
+      public: bool Assign(const Vector3<T> *_vertices,
+                          const std::size_t _vertexCount,
+                          const unsigned int *_indices,
+                          const std::size_t _triangleCount)
+      {
+        this->Resize(_triangleCount);
+        for (std::size_t i = 0; i < _triangleCount; ++i)
+        {
+          const unsigned int *index = _indices + 3 * i;
+          if (index[0] >= _vertexCount || index[1] >= _vertexCount ||
+              index[2] >= _vertexCount)
+          {
+            this->Resize(0);
+            return false;
+          }
+          this->SetTriangle(i, _vertices[index[0]], _vertices[index[1]],
+                            _vertices[index[2]]);
+        }
+        return true;
+      }
+
+      /// \brief Get the number of triangles.
+      /// \return The number of triangles stored in this array.
+      public: std::size_t Size() const
+      {
+        return this->count;
+      }
+
+      /// \brief Check whether the array is empty.
+      /// \return True if the array holds no triangle.
+      public: bool Empty() const
+      {
+        return this->count == 0;
+      }
+
+      /// \brief Get a triangle.
+      /// \param[in] _index Index of the triangle. It is not checked.
+      /// \return The triangle.
+      public: Triangle3<T> Triangle(const std::size_t _index) const
+      {
+        const Vector3<T> v(this->vx[_index], this->vy[_index],
+                           this->vz[_index]);
+        return Triangle3<T>(v,
+            v + Vector3<T>(this->e1x[_index], this->e1y[_index],
+                           this->e1z[_index]),
+            v + Vector3<T>(this->e2x[_index], this->e2y[_index],
+                           this->e2z[_index]));
+      }
+
+      /// \brief Get the bounds of each block of kBlockSize consecutive
+      /// triangles, the last block holding the remaining triangles.
+      /// \param[out] _bounds One box per block. It is cleared first.
+      public: void BlockBounds(std::vector<AxisAlignedBox> &_bounds) const
+      {
+        _bounds.clear();
+        for (std::size_t begin = 0; begin < this->Size();
+             begin += kBlockSize)
+        {
+          const std::size_t end = std::min(begin + kBlockSize, this->Size());
+          Vector3d min(MAX_D, MAX_D, MAX_D);
+          Vector3d max(LOW_D, LOW_D, LOW_D);
+          for (std::size_t i = begin; i < end; ++i)
+          {
+            const Triangle3<T> tri = this->Triangle(i);
+            for (unsigned int k = 0; k < 3; ++k)
+            {
+              const Vector3d pt(tri[k].X(), tri[k].Y(), tri[k].Z());
+              min.Min(pt);
+              max.Max(pt);
+            }
+          }
+          _bounds.push_back(AxisAlignedBox(min, max));
+        }
+      }
+
+      /// \brief Find the closest triangle of a range hit by a ray.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray, it does not need to be
+      /// normalized.
+      /// \param[in] _min Minimum distance along the ray.
+      /// \param[in] _max Maximum distance along the ray.
+      /// \param[in] _begin Index of the first triangle of the range.
+      /// \param[in] _end One past the index of the last triangle of the
+      /// range. It is clamped to Size().
+      /// \param[out] _index Index of the closest triangle hit.
+      /// \param[out] _distance Distance from _origin to the hit.
+      /// \return True if any triangle of the range is hit at a distance in
+      /// [_min, _max].
+      public: bool RayClosestHit(const Vector3<T> &_origin,
+                                 const Vector3<T> &_dir,
+                                 const T _min, const T _max,
+                                 const std::size_t _begin,
+                                 const std::size_t _end,
+                                 std::size_t &_index, T &_distance) const
+      {
+        const T length = _dir.Length();
+        if (!(length > 0))
+          return false;
+        const Vector3<T> dir = _dir / length;
+
+        bool hit = false;
+        T best = _max;
+        T numerators[kBlockSize];
+        T dets[kBlockSize];
+        const std::size_t end = std::min(_end, this->Size());
+        for (std::size_t begin = _begin; begin < end; begin += kBlockSize)
+        {
+          this->BlockHits(_origin, dir, _min, best, begin, numerators, dets);
+          const std::size_t blockCount = std::min(kBlockSize, end - begin);
+          for (std::size_t k = 0; k < blockCount; ++k)
+          {
+            if (dets[k] > 0)
+            {
+              const T distance = numerators[k] / dets[k];
+              if (distance >= _min && distance <= best)
+              {
+                hit = true;
+                best = distance;
+                _index = begin + k;
+              }
+            }
+          }
+        }
+
+        if (hit)
+          _distance = best;
+        return hit;
+      }
+
+      /// \brief Find the closest triangle hit by a ray.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray, it does not need to be
+      /// normalized.
+      /// \param[in] _min Minimum distance along the ray.
+      /// \param[in] _max Maximum distance along the ray.
+      /// \param[out] _index Index of the closest triangle hit.
+      /// \param[out] _distance Distance from _origin to the hit.
+      /// \return True if any triangle is hit at a distance in [_min, _max].
+      public: bool RayClosestHit(const Vector3<T> &_origin,
+                                 const Vector3<T> &_dir,
+                                 const T _min, const T _max,
+                                 std::size_t &_index, T &_distance) const
+      {
+        return this->RayClosestHit(_origin, _dir, _min, _max, 0,
+                                   this->Size(), _index, _distance);
+      }
+
+      /// \brief Check whether a ray hits any triangle of a range. This
+      /// stops at the first block with a hit.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray, it does not need to be
+      /// normalized.
+      /// \param[in] _min Minimum distance along the ray.
+      /// \param[in] _max Maximum distance along the ray.
+      /// \param[in] _begin Index of the first triangle of the range.
+      /// \param[in] _end One past the index of the last triangle of the
+      /// range. It is clamped to Size().
+      /// \return True if any triangle of the range is hit at a distance in
+      /// [_min, _max].
+      public: bool RayAnyHit(const Vector3<T> &_origin,
+                             const Vector3<T> &_dir,
+                             const T _min, const T _max,
+                             const std::size_t _begin = 0,
+                             const std::size_t _end =
+                                 std::numeric_limits<std::size_t>::max())
+                             const
+      {
+        const T length = _dir.Length();
+        if (!(length > 0))
+          return false;
+        const Vector3<T> dir = _dir / length;
+
+        T numerators[kBlockSize];
+        T dets[kBlockSize];
+        const std::size_t end = std::min(_end, this->Size());
+        for (std::size_t begin = _begin; begin < end; begin += kBlockSize)
+        {
+          this->BlockHits(_origin, dir, _min, _max, begin, numerators, dets);
+          const std::size_t blockCount = std::min(kBlockSize, end - begin);
+          for (std::size_t k = 0; k < blockCount; ++k)
+          {
+            if (dets[k] > 0)
+              return true;
+          }
+        }
+        return false;
+      }
+
+      /// \brief Resize all buffers. They are padded with degenerate
+      /// triangles, which are never hit, so that a block starting at any
+      /// triangle can be read whole.
+      /// \param[in] _size Number of triangles.
+      private: void Resize(const std::size_t _size)
+      {
+        this->count = _size;
+        const std::size_t padded = _size > 0 ? _size + kBlockSize - 1 : 0;
+        for (std::vector<T> *buffer : {&this->vx, &this->vy, &this->vz,
+                                       &this->e1x, &this->e1y, &this->e1z,
+                                       &this->e2x, &this->e2y, &this->e2z})
+        {
+          buffer->assign(padded, 0);
+        }
+      }
+
+      /// \brief Store a triangle.
+      /// \param[in] _index Index of the triangle.
+      /// \param[in] _pt1 First vertex.
+      /// \param[in] _pt2 Second vertex.
+      /// \param[in] _pt3 Third vertex.
+      private: void SetTriangle(const std::size_t _index,
+                                const Vector3<T> &_pt1,
+                                const Vector3<T> &_pt2,
+                                const Vector3<T> &_pt3)
+      {
+        const Vector3<T> e1 = _pt2 - _pt1;
+        const Vector3<T> e2 = _pt3 - _pt1;
+        this->vx[_index] = _pt1.X();
+        this->vy[_index] = _pt1.Y();
+        this->vz[_index] = _pt1.Z();
+        this->e1x[_index] = e1.X();
+        this->e1y[_index] = e1.Y();
+        this->e1z[_index] = e1.Z();
+        this->e2x[_index] = e2.X();
+        this->e2y[_index] = e2.Y();
+        this->e2z[_index] = e2.Z();
+      }
+
+      /// \brief Moller-Trumbore test of a ray against a block of triangles.
+      /// The barycentric coordinates and the distance are compared scaled
+      /// by the determinant, so that the loop has no division and no
+      /// branch, and only the hits are divided by the caller. The fixed
+      /// trip count and the local outputs let the compiler vectorize the
+      /// loop without runtime checks.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Normalized direction of the ray.
+      /// \param[in] _min Minimum distance along the ray.
+      /// \param[in] _max Maximum distance along the ray.
+      /// \param[in] _begin Index of the first triangle.
+      /// \param[out] _numerators Distance to each triangle times _dets.
+      /// \param[out] _dets Absolute value of the determinant of each
+      /// triangle, or zero if it is missed.
+      private: void BlockHits(const Vector3<T> &_origin,
+                              const Vector3<T> &_dir,
+                              const T _min, const T _max,
+                              const std::size_t _begin,
+                              T (&_numerators)[kBlockSize],
+                              T (&_dets)[kBlockSize]) const
+      {
+        const T ox = _origin.X();
+        const T oy = _origin.Y();
+        const T oz = _origin.Z();
+        const T dx = _dir.X();
+        const T dy = _dir.Y();
+        const T dz = _dir.Z();
+        const T *vxs = this->vx.data() + _begin;
+        const T *vys = this->vy.data() + _begin;
+        const T *vzs = this->vz.data() + _begin;
+        const T *e1xs = this->e1x.data() + _begin;
+        const T *e1ys = this->e1y.data() + _begin;
+        const T *e1zs = this->e1z.data() + _begin;
+        const T *e2xs = this->e2x.data() + _begin;
+        const T *e2ys = this->e2y.data() + _begin;
+        const T *e2zs = this->e2z.data() + _begin;
+        T numerators[kBlockSize];
+        T dets[kBlockSize];
+        for (std::size_t k = 0; k < kBlockSize; ++k)
+        {
+          // p = dir x e2
+          const T px = dy * e2zs[k] - dz * e2ys[k];
+          const T py = dz * e2xs[k] - dx * e2zs[k];
+          const T pz = dx * e2ys[k] - dy * e2xs[k];
+          const T det = e1xs[k] * px + e1ys[k] * py + e1zs[k] * pz;
+          const T sign = det < 0 ? -1 : 1;
+          const T absDet = det * sign;
+
+          // s = origin - v, q = s x e1
+          const T sx = ox - vxs[k];
+          const T sy = oy - vys[k];
+          const T sz = oz - vzs[k];
+          const T qx = sy * e1zs[k] - sz * e1ys[k];
+          const T qy = sz * e1xs[k] - sx * e1zs[k];
+          const T qz = sx * e1ys[k] - sy * e1xs[k];
+
+          // Barycentric coordinates and distance times absDet
+          const T u = (sx * px + sy * py + sz * pz) * sign;
+          const T v = (dx * qx + dy * qy + dz * qz) * sign;
+          const T t = (e2xs[k] * qx + e2ys[k] * qy + e2zs[k] * qz) * sign;
+
+          // Bitwise operators so that the loop has no branch
+          const bool inside = (absDet > 0) & (u >= 0) & (v >= 0) &
+                              (u + v <= absDet) & (t >= _min * absDet) &
+                              (t <= _max * absDet);
+          numerators[k] = t;
+          dets[k] = inside ? absDet : 0;
+        }
+        std::copy(numerators, numerators + kBlockSize, _numerators);
+        std::copy(dets, dets + kBlockSize, _dets);
+      }
+
+      /// \brief Number of triangles, without the padding.
+      private: std::size_t count = 0;
+
+      /// \brief The x components of the first vertices.
+      private: std::vector<T> vx;
+
+      /// \brief The y components of the first vertices.
+      private: std::vector<T> vy;
+
+      /// \brief The z components of the first vertices.
+      private: std::vector<T> vz;
+
+      /// \brief The x components of the edges from the first to the second
+      /// vertices.
+      private: std::vector<T> e1x;
+
+      /// \brief The y components of the edges from the first to the second
+      /// vertices.
+      private: std::vector<T> e1y;
+
+      /// \brief The z components of the edges from the first to the second
+      /// vertices.
+      private: std::vector<T> e1z;
+
+      /// \brief The x components of the edges from the first to the third
+      /// vertices.
+      private: std::vector<T> e2x;
+
+      /// \brief The y components of the edges from the first to the third
+      /// vertices.
+      private: std::vector<T> e2y;
+
+      /// \brief The z components of the edges from the first to the third
+      /// vertices.
+      private: std::vector<T> e2z;
+    };
+
+    typedef Triangle3Array<double> Triangle3Arrayd;
+    typedef Triangle3Array<float> Triangle3Arrayf;
+    }
+  }
+}
+#endif
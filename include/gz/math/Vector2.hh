@@ -22,9 +22,11 @@
 #include <istream>
 #include <limits>
 #include <ostream>
+#include <string>
 
 #include <gz/math/Helpers.hh>
 #include <gz/math/config.hh>
+#include <gz/math/detail/VectorN.hh>
 
 namespace gz
 {
@@ -70,9 +72,9 @@ namespace gz
 
       /// \brief Return the sum of the values
       /// \return the sum
-      public: T Sum() const
+      public: constexpr T Sum() const
       {
-        return this->data[0] + this->data[1];
+        return Kernels::Sum(this->data);
       }
 
       /// \brief Calc distance to the given point
@@ -80,8 +82,7 @@ namespace gz
       /// \return the distance
       public: double Distance(const Vector2 &_pt) const
       {
-        return sqrt((this->data[0]-_pt[0])*(this->data[0]-_pt[0]) +
-                    (this->data[1]-_pt[1])*(this->data[1]-_pt[1]));
+        return sqrt(Kernels::SquaredDistance(this->data, _pt.data));
       }
 
       /// \brief Returns the length (magnitude) of the vector
@@ -93,11 +94,9 @@ namespace gz
 
       /// \brief Returns the square of the length (magnitude) of the vector
       /// \return The squared length
-      public: T SquaredLength() const
+      public: constexpr T SquaredLength() const
       {
-        return
-          this->data[0] * this->data[0] +
-          this->data[1] * this->data[1];
+        return Kernels::Dot(this->data, this->data);
       }
 
       /// \brief Normalize the vector length
@@ -106,10 +105,7 @@ namespace gz
         T d = this->Length();
 
         if (!equal<T>(d, static_cast<T>(0.0)))
-        {
-          this->data[0] /= d;
-          this->data[1] /= d;
-        }
+          Kernels::DivScalar(this->data, this->data, d);
       }
 
       /// \brief Returns a normalized vector
@@ -125,8 +121,7 @@ namespace gz
       /// \return the result
       public: Vector2 Round()
       {
-        this->data[0] = static_cast<T>(std::nearbyint(this->data[0]));
-        this->data[1] = static_cast<T>(std::nearbyint(this->data[1]));
+        Kernels::Round(this->data);
         return *this;
       }
 
@@ -142,7 +137,7 @@ namespace gz
       /// \brief Set the contents of the vector
       /// \param[in] _x value along x
       /// \param[in] _y value along y
-      public: void Set(T _x, T _y)
+      public: constexpr void Set(T _x, T _y)
       {
         this->data[0] = _x;
         this->data[1] = _y;
@@ -151,17 +146,18 @@ namespace gz
       /// \brief Get the dot product of this vector and _v
       /// \param[in] _v the vector
       /// \return The dot product
-      public: T Dot(const Vector2<T> &_v) const
+      public: constexpr T Dot(const Vector2<T> &_v) const
       {
-        return (this->data[0] * _v[0]) + (this->data[1] * _v[1]);
+        return Kernels::Dot(this->data, _v.data);
       }
 
       /// \brief Get the absolute value of the vector
       /// \return a vector with positive elements
       public: Vector2 Abs() const
       {
-        return Vector2(std::abs(this->data[0]),
-                       std::abs(this->data[1]));
+        Vector2<T> result;
+        Kernels::Abs(result.data, this->data);
+        return result;
       }
 
       /// \brief Return the absolute dot product of this vector and
@@ -174,51 +170,43 @@ namespace gz
       /// \return The absolute dot product
       public: T AbsDot(const Vector2<T> &_v) const
       {
-        return std::abs(this->data[0] * _v[0]) +
-               std::abs(this->data[1] * _v[1]);
+        return Kernels::AbsDot(this->data, _v.data);
       }
 
        /// \brief Corrects any nan values
       public: inline void Correct()
       {
-        // std::isfinite works with floating point values,
-        // need to explicit cast to avoid ambiguity in vc++.
-        if (!std::isfinite(static_cast<double>(this->data[0])))
-          this->data[0] = 0;
-        if (!std::isfinite(static_cast<double>(this->data[1])))
-          this->data[1] = 0;
+        Kernels::Correct(this->data);
       }
 
       /// \brief Set this vector's components to the maximum of itself and the
       ///        passed in vector
       /// \param[in] _v the maximum clamping vector
-      public: void Max(const Vector2<T> &_v)
+      public: constexpr void Max(const Vector2<T> &_v)
       {
-        this->data[0] = std::max(_v[0], this->data[0]);
-        this->data[1] = std::max(_v[1], this->data[1]);
+        Kernels::Max(this->data, _v.data);
       }
 
       /// \brief Set this vector's components to the minimum of itself and the
       ///        passed in vector
       /// \param[in] _v the minimum clamping vector
-      public: void Min(const Vector2<T> &_v)
+      public: constexpr void Min(const Vector2<T> &_v)
       {
-        this->data[0] = std::min(_v[0], this->data[0]);
-        this->data[1] = std::min(_v[1], this->data[1]);
+        Kernels::Min(this->data, _v.data);
       }
 
       /// \brief Get the maximum value in the vector
       /// \return the maximum element
-      public: T Max() const
+      public: constexpr T Max() const
       {
-        return std::max(this->data[0], this->data[1]);
+        return Kernels::MaxElement(this->data);
       }
 
       /// \brief Get the minimum value in the vector
       /// \return the minimum element
-      public: T Min() const
+      public: constexpr T Min() const
       {
-        return std::min(this->data[0], this->data[1]);
+        return Kernels::MinElement(this->data);
       }
 
       /// \brief Assignment operator
@@ -229,47 +217,46 @@ namespace gz
       /// \brief Assignment operator
       /// \param[in] _v the value for x and y element
       /// \return this
-      public: const Vector2 &operator=(T _v)
+      public: constexpr const Vector2 &operator=(T _v)
       {
-        this->data[0] = _v;
-        this->data[1] = _v;
-
+        Kernels::Fill(this->data, _v);
         return *this;
       }
 
       /// \brief Addition operator
       /// \param[in] _v vector to add
       /// \return sum vector
-      public: Vector2 operator+(const Vector2 &_v) const
+      public: constexpr Vector2 operator+(const Vector2 &_v) const
       {
-        return Vector2(this->data[0] + _v[0], this->data[1] + _v[1]);
+        Vector2<T> result;
+        Kernels::Add(result.data, this->data, _v.data);
+        return result;
       }
 
       /// \brief Addition assignment operator
       /// \param[in] _v the vector to add
       // \return this
-      public: const Vector2 &operator+=(const Vector2 &_v)
+      public: constexpr const Vector2 &operator+=(const Vector2 &_v)
       {
-        this->data[0] += _v[0];
-        this->data[1] += _v[1];
-
+        Kernels::Add(this->data, this->data, _v.data);
         return *this;
       }
 
       /// \brief Addition operators
       /// \param[in] _s the scalar addend
       /// \return sum vector
-      public: inline Vector2<T> operator+(const T _s) const
+      public: constexpr Vector2<T> operator+(const T _s) const
       {
-        return Vector2<T>(this->data[0] + _s,
-                          this->data[1] + _s);
+        Vector2<T> result;
+        Kernels::AddScalar(result.data, this->data, _s);
+        return result;
       }
 
       /// \brief Addition operators
       /// \param[in] _s the scalar addend
       /// \param[in] _v input vector
       /// \return sum vector
-      public: friend inline Vector2<T> operator+(const T _s,
+      public: friend constexpr Vector2<T> operator+(const T _s,
                                                  const Vector2<T> &_v)
       {
         return _v + _s;
@@ -278,67 +265,68 @@ namespace gz
       /// \brief Addition assignment operator
       /// \param[in] _s scalar addend
       /// \return this
-      public: const Vector2<T> &operator+=(const T _s)
+      public: constexpr const Vector2<T> &operator+=(const T _s)
       {
-        this->data[0] += _s;
-        this->data[1] += _s;
-
+        Kernels::AddScalar(this->data, this->data, _s);
         return *this;
       }
 
       /// \brief Negation operator
       /// \return negative of this vector
-      public: inline Vector2 operator-() const
+      public: constexpr Vector2 operator-() const
       {
-        return Vector2(-this->data[0], -this->data[1]);
+        Vector2<T> result;
+        Kernels::Negate(result.data, this->data);
+        return result;
       }
 
       /// \brief Subtraction operator
       /// \param[in] _v the vector to substract
       /// \return the subtracted vector
-      public: Vector2 operator-(const Vector2 &_v) const
+      public: constexpr Vector2 operator-(const Vector2 &_v) const
       {
-        return Vector2(this->data[0] - _v[0], this->data[1] - _v[1]);
+        Vector2<T> result;
+        Kernels::Sub(result.data, this->data, _v.data);
+        return result;
       }
 
       /// \brief Subtraction assignment operator
       /// \param[in] _v the vector to substract
       /// \return this
-      public: const Vector2 &operator-=(const Vector2 &_v)
+      public: constexpr const Vector2 &operator-=(const Vector2 &_v)
       {
-        this->data[0] -= _v[0];
-        this->data[1] -= _v[1];
-
+        Kernels::Sub(this->data, this->data, _v.data);
         return *this;
       }
 
       /// \brief Subtraction operators
       /// \param[in] _s the scalar subtrahend
       /// \return difference vector
-      public: inline Vector2<T> operator-(const T _s) const
+      public: constexpr Vector2<T> operator-(const T _s) const
       {
-        return Vector2<T>(this->data[0] - _s,
-                          this->data[1] - _s);
+        Vector2<T> result;
+        Kernels::SubScalar(result.data, this->data, _s);
+        return result;
       }
 
       /// \brief Subtraction operators
       /// \param[in] _s the scalar minuend
       /// \param[in] _v vector subtrahend
       /// \return difference vector
-      public: friend inline Vector2<T> operator-(const T _s,
+      public: friend constexpr Vector2<T> operator-(const T _s,
                                                  const Vector2<T> &_v)
       {
-        return {_s - _v.X(), _s - _v.Y()};
+        Vector2<T> result;
+        Kernels::ScalarSub(result.data, _s, _v.data);
+        return result;
       }
 
       /// \brief Subtraction assignment operator
       /// \param[in] _s scalar subtrahend
       /// \return this
-      public: const Vector2<T> &operator-=(T _s)
+      public: constexpr const Vector2<T> &operator-=(T _s)
       {
-        this->data[0] -= _s;
-        this->data[1] -= _s;
-
+        Kernels::SubScalar(this->data, this->data, _s);
         return *this;
       }
 
@@ -346,75 +334,77 @@ namespace gz
       /// \remarks this is an element wise division
       /// \param[in] _v a vector
       /// \result a result
-      public: const Vector2 operator/(const Vector2 &_v) const
+      public: constexpr const Vector2 operator/(const Vector2 &_v) const
       {
-        return Vector2(this->data[0] / _v[0], this->data[1] / _v[1]);
+        Vector2<T> result;
+        Kernels::Div(result.data, this->data, _v.data);
+        return result;
       }
 
       /// \brief Division operator
       /// \remarks this is an element wise division
       /// \param[in] _v a vector
       /// \return this
-      public: const Vector2 &operator/=(const Vector2 &_v)
+      public: constexpr const Vector2 &operator/=(const Vector2 &_v)
       {
-        this->data[0] /= _v[0];
-        this->data[1] /= _v[1];
-
+        Kernels::Div(this->data, this->data, _v.data);
         return *this;
       }
 
       /// \brief Division operator
       /// \param[in] _v the value
       /// \return a vector
-      public: const Vector2 operator/(T _v) const
+      public: constexpr const Vector2 operator/(T _v) const
       {
-        return Vector2(this->data[0] / _v, this->data[1] / _v);
+        Vector2<T> result;
+        Kernels::DivScalar(result.data, this->data, _v);
+        return result;
       }
 
       /// \brief Division operator
       /// \param[in] _v the divisor
       /// \return a vector
-      public: const Vector2 &operator/=(T _v)
+      public: constexpr const Vector2 &operator/=(T _v)
       {
-        this->data[0] /= _v;
-        this->data[1] /= _v;
-
+        Kernels::DivScalar(this->data, this->data, _v);
         return *this;
       }
 
       /// \brief Multiplication operators
       /// \param[in] _v the vector
       /// \return the result
-      public: const Vector2 operator*(const Vector2 &_v) const
+      public: constexpr const Vector2 operator*(const Vector2 &_v) const
       {
-        return Vector2(this->data[0] * _v[0], this->data[1] * _v[1]);
+        Vector2<T> result;
+        Kernels::Mul(result.data, this->data, _v.data);
+        return result;
       }
 
       /// \brief Multiplication assignment operator
       /// \remarks this is an element wise multiplication
       /// \param[in] _v the vector
       /// \return this
-      public: const Vector2 &operator*=(const Vector2 &_v)
+      public: constexpr const Vector2 &operator*=(const Vector2 &_v)
       {
-        this->data[0] *= _v[0];
-        this->data[1] *= _v[1];
-
+        Kernels::Mul(this->data, this->data, _v.data);
         return *this;
       }
 
       /// \brief Multiplication operators
       /// \param[in] _v the scaling factor
       /// \return a scaled vector
-      public: const Vector2 operator*(T _v) const
+      public: constexpr const Vector2 operator*(T _v) const
       {
-        return Vector2(this->data[0] * _v, this->data[1] * _v);
+        Vector2<T> result;
+        Kernels::MulScalar(result.data, this->data, _v);
+        return result;
       }
 
       /// \brief Scalar left multiplication operators
       /// \param[in] _s the scaling factor
       /// \param[in] _v the vector to scale
       /// \return a scaled vector
-      public: friend inline const Vector2 operator*(const T _s,
+      public: friend constexpr const Vector2 operator*(const T _s,
                                                     const Vector2 &_v)
       {
         return Vector2(_v * _s);
@@ -423,11 +413,9 @@ namespace gz
       /// \brief Multiplication assignment operator
       /// \param[in] _v the scaling factor
       /// \return a scaled vector
-      public: const Vector2 &operator*=(T _v)
+      public: constexpr const Vector2 &operator*=(T _v)
       {
-        this->data[0] *= _v;
-        this->data[1] *= _v;
-
+        Kernels::MulScalar(this->data, this->data, _v);
         return *this;
       }
 
@@ -438,8 +426,7 @@ namespace gz
       /// the tolerence specified by _tol.
       public: bool Equal(const Vector2 &_v, const T &_tol) const
       {
-        return equal<T>(this->data[0], _v[0], _tol)
-            && equal<T>(this->data[1], _v[1], _tol);
+        return Kernels::Equal(this->data, _v.data, _tol);
       }
 
       /// \brief Equal to operator
@@ -462,16 +449,13 @@ namespace gz
       /// \return true if finite, false otherwise
       public: bool IsFinite() const
       {
-        // std::isfinite works with floating point values,
-        // need to explicit cast to avoid ambiguity in vc++.
-        return std::isfinite(static_cast<double>(this->data[0])) &&
-               std::isfinite(static_cast<double>(this->data[1]));
+        return Kernels::IsFinite(this->data);
       }
 
       /// \brief Array subscript operator
       /// \param[in] _index The index, where 0 == x and 1 == y.
       /// The index is clamped to the range [0,1].
-      public: T &operator[](const std::size_t _index)
+      public: constexpr T &operator[](const std::size_t _index)
       {
         return this->data[clamp(_index, GZ_ZERO_SIZE_T, GZ_ONE_SIZE_T)];
       }
@@ -479,49 +463,49 @@ namespace gz
       /// \brief Const-qualified array subscript operator
       /// \param[in] _index The index, where 0 == x and 1 == y.
       /// The index is clamped to the range [0,1].
-      public: T operator[](const std::size_t _index) const
+      public: constexpr T operator[](const std::size_t _index) const
       {
         return this->data[clamp(_index, GZ_ZERO_SIZE_T, GZ_ONE_SIZE_T)];
       }
 
       /// \brief Return the x value.
       /// \return Value of the X component.
-      public: inline T X() const
+      public: constexpr T X() const
       {
         return this->data[0];
       }
 
       /// \brief Return the y value.
       /// \return Value of the Y component.
-      public: inline T Y() const
+      public: constexpr T Y() const
       {
         return this->data[1];
       }
 
       /// \brief Return a mutable x value.
       /// \return Value of the X component.
-      public: inline T &X()
+      public: constexpr T &X()
       {
         return this->data[0];
       }
 
       /// \brief Return a mutable y value.
       /// \return Value of the Y component.
-      public: inline T &Y()
+      public: constexpr T &Y()
       {
         return this->data[1];
       }
 
       /// \brief Set the x value.
       /// \param[in] _v Value for the x component.
-      public: inline void X(const T &_v)
+      public: constexpr void X(const T &_v)
       {
         this->data[0] = _v;
       }
 
       /// \brief Set the y value.
       /// \param[in] _v Value for the y component.
-      public: inline void Y(const T &_v)
+      public: constexpr void Y(const T &_v)
       {
         this->data[1] = _v;
       }
@@ -543,11 +527,30 @@ namespace gz
         return _out;
       }
 
+      /// \brief Append the vector to a string, in the format of operator<<
+      /// but with std::to_chars, which is faster than a stream.
+      /// \param[in, out] _out The string
+      /// \param[in] _pt Vector to append
+      /// \param[in] _precision Number of digits after the decimal point, or
+      /// a negative value for the shortest representation that reads back as
+      /// the same number
+      public: friend void appendToString(std::string &_out,
+                  const Vector2<T> &_pt, int _precision = -1)
+      {
+        for (auto i : {0, 1})
+        {
+          if (i > 0)
+            _out += ' ';
+
+          appendToString(_out, _pt[i], _precision);
+        }
+      }
+
       /// \brief Less than operator.
       /// \param[in] _pt Vector to compare.
       /// \return True if this vector's first or second value is less than
       /// the given vector's first or second value.
-      public: bool operator<(const Vector2<T> &_pt) const
+      public: constexpr bool operator<(const Vector2<T> &_pt) const
       {
         return this->data[0] < _pt[0] || this->data[1] < _pt[1];
       }
@@ -570,6 +573,9 @@ namespace gz
         return _in;
       }
 
+      /// \brief Per component kernels shared with Vector3 and Vector4.
+      private: using Kernels = detail::VectorN<T, 2>;
+
       /// \brief The x and y values.
       private: T data[2];
     };
@@ -22,9 +22,11 @@
 #include <istream>
 #include <limits>
 #include <ostream>
+#include <string>
 
 #include <gz/math/Helpers.hh>
 #include <gz/math/config.hh>
+#include <gz/math/detail/VectorN.hh>
 
 namespace gz
 {
@@ -82,9 +84,9 @@ namespace gz
 
       /// \brief Return the sum of the values
       /// \return the sum
-      public: T Sum() const
+      public: constexpr T Sum() const
       {
-        return this->data[0] + this->data[1] + this->data[2];
+        return Kernels::Sum(this->data);
       }
 
       /// \brief Calc distance to the given point
@@ -93,9 +95,7 @@ namespace gz
       public: T Distance(const Vector3<T> &_pt) const
       {
         return static_cast<T>(sqrt(
-                    (this->data[0]-_pt[0])*(this->data[0]-_pt[0]) +
-                    (this->data[1]-_pt[1])*(this->data[1]-_pt[1]) +
-                    (this->data[2]-_pt[2])*(this->data[2]-_pt[2])));
+            Kernels::SquaredDistance(this->data, _pt.data)));
       }
 
       /// \brief Calc distance to the given point
@@ -117,12 +117,9 @@ namespace gz
 
       /// \brief Return the square of the length (magnitude) of the vector
       /// \return the squared length
-      public: T SquaredLength() const
+      public: constexpr T SquaredLength() const
       {
-        return
-          this->data[0] * this->data[0] +
-          this->data[1] * this->data[1] +
-          this->data[2] * this->data[2];
+        return Kernels::Dot(this->data, this->data);
       }
 
       /// \brief Normalize the vector length
@@ -132,12 +129,25 @@ namespace gz
         T d = this->Length();
 
         if (!equal<T>(d, static_cast<T>(0.0)))
+          Kernels::DivScalar(this->data, this->data, d);
+
+        return *this;
+      }
+
+      /// \brief Normalize the vector length with fastInverseSqrt instead of
+      /// a square root and divisions. The relative error of the length is
+      /// below 5e-6 for float and 4e-11 for double, which is enough to
+      /// renormalize a vector after a small update. As in Normalize,
+      /// vectors with a length of zero (within 1e-6) are left unchanged.
+      /// \return unit length vector
+      public: Vector3 NormalizeFast()
+      {
+        const T squared = this->SquaredLength();
+        if (squared > static_cast<T>(1e-12))
         {
-          this->data[0] /= d;
-          this->data[1] /= d;
-          this->data[2] /= d;
+          Kernels::MulScalar(this->data, this->data,
+                             static_cast<T>(fastInverseSqrt(squared)));
         }
-
         return *this;
       }
 
@@ -154,9 +164,7 @@ namespace gz
       /// \return the result
       public: Vector3 Round()
       {
-        this->data[0] = static_cast<T>(std::nearbyint(this->data[0]));
-        this->data[1] = static_cast<T>(std::nearbyint(this->data[1]));
-        this->data[2] = static_cast<T>(std::nearbyint(this->data[2]));
+        Kernels::Round(this->data);
         return *this;
       }
 
@@ -173,7 +181,7 @@ namespace gz
       /// \param[in] _x value along x
       /// \param[in] _y value along y
       /// \param[in] _z value aling z
-      public: inline void Set(T _x = 0, T _y = 0, T _z = 0)
+      public: constexpr void Set(T _x = 0, T _y = 0, T _z = 0)
       {
         this->data[0] = _x;
         this->data[1] = _y;
@@ -183,7 +191,7 @@ namespace gz
       /// \brief Return the cross product of this vector with another vector.
       /// \param[in] _v a vector
       /// \return the cross product
-      public: Vector3 Cross(const Vector3<T> &_v) const
+      public: constexpr Vector3 Cross(const Vector3<T> &_v) const
       {
         return Vector3(this->data[1] * _v[2] - this->data[2] * _v[1],
                        this->data[2] * _v[0] - this->data[0] * _v[2],
@@ -193,11 +201,9 @@ namespace gz
       /// \brief Return the dot product of this vector and another vector
       /// \param[in] _v the vector
       /// \return the dot product
-      public: T Dot(const Vector3<T> &_v) const
+      public: constexpr T Dot(const Vector3<T> &_v) const
       {
-        return this->data[0] * _v[0] +
-               this->data[1] * _v[1] +
-               this->data[2] * _v[2];
+        return Kernels::Dot(this->data, _v.data);
       }
 
       /// \brief Return the absolute dot product of this vector and
@@ -210,18 +216,16 @@ namespace gz
       /// \return The absolute dot product
       public: T AbsDot(const Vector3<T> &_v) const
       {
-        return std::abs(this->data[0] * _v[0]) +
-               std::abs(this->data[1] * _v[1]) +
-               std::abs(this->data[2] * _v[2]);
+        return Kernels::AbsDot(this->data, _v.data);
       }
 
       /// \brief Get the absolute value of the vector
       /// \return a vector with positive elements
       public: Vector3 Abs() const
       {
-        return Vector3(std::abs(this->data[0]),
-                       std::abs(this->data[1]),
-                       std::abs(this->data[2]));
+        Vector3<T> result;
+        Kernels::Abs(result.data, this->data);
+        return result;
       }
 
       /// \brief Return a vector that is perpendicular to this one.
@@ -255,6 +259,50 @@ namespace gz
         return n.Normalize();
       }
 
+      /// \brief Return _a * _s + _b, computed per component without the
+      /// temporary that the expression with operators creates.
+      /// \param[in] _a The vector to scale.
+      /// \param[in] _s The scaling factor.
+      /// \param[in] _b The vector to add.
+      /// \return _a * _s + _b
+      public: static constexpr Vector3 MultiplyAdd(const Vector3<T> &_a,
+                  const T _s, const Vector3<T> &_b)
+      {
+        Vector3<T> result;
+        Kernels::MultiplyAdd(result.data, _a.data, _s, _b.data);
+        return result;
+      }
+
+      /// \brief Return _a * _b + _c, where _a * _b is the per component
+      /// product.
+      /// \param[in] _a The first factor.
+      /// \param[in] _b The second factor.
+      /// \param[in] _c The vector to add.
+      /// \return _a * _b + _c
+      public: static constexpr Vector3 MultiplyAdd(const Vector3<T> &_a,
+                  const Vector3<T> &_b, const Vector3<T> &_c)
+      {
+        Vector3<T> result;
+        Kernels::MultiplyAdd(result.data, _a.data, _b.data, _c.data);
+        return result;
+      }
+
+      /// \brief Return _a.Cross(_b) + _c, computed per component.
+      /// \param[in] _a The first vector of the cross product.
+      /// \param[in] _b The second vector of the cross product.
+      /// \param[in] _c The vector to add.
+      /// \return _a.Cross(_b) + _c
+      public: static constexpr Vector3 CrossAdd(const Vector3<T> &_a,
+                  const Vector3<T> &_b, const Vector3<T> &_c)
+      {
+        return Vector3(_a.data[1] * _b.data[2] - _a.data[2] * _b.data[1] +
+                         _c.data[0],
+                       _a.data[2] * _b.data[0] - _a.data[0] * _b.data[2] +
+                         _c.data[1],
+                       _a.data[0] * _b.data[1] - _a.data[1] * _b.data[0] +
+                         _c.data[2]);
+      }
+
       /// \brief Get distance to an infinite line defined by 2 points.
       /// \param[in] _pt1 first point on the line
       /// \param[in] _pt2 second point on the line
@@ -269,7 +317,7 @@ namespace gz
       /// \brief Set this vector's components to the maximum of itself and the
       ///        passed in vector
       /// \param[in] _v the maximum clamping vector
-      public: void Max(const Vector3<T> &_v)
+      public: constexpr void Max(const Vector3<T> &_v)
       {
         if (_v[0] > this->data[0])
           this->data[0] = _v[0];
@@ -282,7 +330,7 @@ namespace gz
       /// \brief Set this vector's components to the minimum of itself and the
       ///        passed in vector
       /// \param[in] _v the minimum clamping vector
-      public: void Min(const Vector3<T> &_v)
+      public: constexpr void Min(const Vector3<T> &_v)
       {
         if (_v[0] < this->data[0])
           this->data[0] = _v[0];
@@ -294,34 +342,30 @@ namespace gz
 
       /// \brief Get the maximum value in the vector
       /// \return the maximum element
-      public: T Max() const
+      public: constexpr T Max() const
       {
-        return std::max(std::max(this->data[0], this->data[1]), this->data[2]);
+        return Kernels::MaxElement(this->data);
       }
 
       /// \brief Get the minimum value in the vector
       /// \return the minimum element
-      public: T Min() const
+      public: constexpr T Min() const
       {
-        return std::min(std::min(this->data[0], this->data[1]), this->data[2]);
+        return Kernels::MinElement(this->data);
       }
 
       /// \brief Get the number with the maximum absolute value in the vector
       /// \return the element with maximum absolute value
       public: T MaxAbs() const
       {
-        T max = std::max(std::abs(this->data[0]), std::abs(this->data[1]));
-        max = std::max(max, std::abs(this->data[2]));
-        return max;
+        return Kernels::MaxAbs(this->data);
       }
 
       /// \brief Get the number with the maximum absolute value in the vector
       /// \return the element with minimum absolute value
       public: T MinAbs() const
       {
-        T min = std::min(std::abs(this->data[0]), std::abs(this->data[1]));
-        min = std::min(min, std::abs(this->data[2]));
-        return min;
+        return Kernels::MinAbs(this->data);
       }
 
       /// \brief Assignment operator
@@ -332,127 +376,116 @@ namespace gz
       /// \brief Assignment operator
       /// \param[in] _v assigned to all elements
       /// \return this
-      public: Vector3 &operator=(T _v)
+      public: constexpr Vector3 &operator=(T _v)
       {
-        this->data[0] = _v;
-        this->data[1] = _v;
-        this->data[2] = _v;
-
+        Kernels::Fill(this->data, _v);
         return *this;
       }
 
       /// \brief Addition operator
       /// \param[in] _v vector to add
       /// \return the sum vector
-      public: Vector3 operator+(const Vector3<T> &_v) const
+      public: constexpr Vector3 operator+(const Vector3<T> &_v) const
       {
-        return Vector3(this->data[0] + _v[0],
-                       this->data[1] + _v[1],
-                       this->data[2] + _v[2]);
+        Vector3<T> result;
+        Kernels::Add(result.data, this->data, _v.data);
+        return result;
       }
 
       /// \brief Addition assignment operator
       /// \param[in] _v vector to add
       /// \return the sum vector
-      public: const Vector3 &operator+=(const Vector3<T> &_v)
+      public: constexpr const Vector3 &operator+=(const Vector3<T> &_v)
       {
-        this->data[0] += _v[0];
-        this->data[1] += _v[1];
-        this->data[2] += _v[2];
-
+        Kernels::Add(this->data, this->data, _v.data);
         return *this;
       }
 
       /// \brief Addition operators
       /// \param[in] _s the scalar addend
       /// \return sum vector
-      public: inline Vector3<T> operator+(const T _s) const
+      public: constexpr Vector3<T> operator+(const T _s) const
       {
-        return Vector3<T>(this->data[0] + _s,
-                          this->data[1] + _s,
-                          this->data[2] + _s);
+        Vector3<T> result;
+        Kernels::AddScalar(result.data, this->data, _s);
+        return result;
       }
 
       /// \brief Addition operators
       /// \param[in] _s the scalar addend
       /// \param[in] _v input vector
       /// \return sum vector
-      public: friend inline Vector3<T> operator+(const T _s,
+      public: friend constexpr Vector3<T> operator+(const T _s,
                                                  const Vector3<T> &_v)
       {
-        return {_v.X() + _s, _v.Y() + _s, _v.Z() + _s};
+        return _v + _s;
       }
 
       /// \brief Addition assignment operator
       /// \param[in] _s scalar addend
       /// \return this
-      public: const Vector3<T> &operator+=(const T _s)
+      public: constexpr const Vector3<T> &operator+=(const T _s)
       {
-        this->data[0] += _s;
-        this->data[1] += _s;
-        this->data[2] += _s;
-
+        Kernels::AddScalar(this->data, this->data, _s);
         return *this;
       }
 
       /// \brief Negation operator
       /// \return negative of this vector
-      public: inline Vector3 operator-() const
+      public: constexpr Vector3 operator-() const
       {
-        return Vector3(-this->data[0], -this->data[1], -this->data[2]);
+        Vector3<T> result;
+        Kernels::Negate(result.data, this->data);
+        return result;
       }
 
       /// \brief Subtraction operators
       /// \param[in] _pt a vector to substract
       /// \return a vector after the substraction
-      public: inline Vector3<T> operator-(const Vector3<T> &_pt) const
+      public: constexpr Vector3<T> operator-(const Vector3<T> &_pt) const
       {
-        return Vector3(this->data[0] - _pt[0],
-                       this->data[1] - _pt[1],
-                       this->data[2] - _pt[2]);
+        Vector3<T> result;
+        Kernels::Sub(result.data, this->data, _pt.data);
+        return result;
       }
 
       /// \brief Subtraction assignment operators
       /// \param[in] _pt subtrahend
       /// \return a vector after the substraction
-      public: const Vector3<T> &operator-=(const Vector3<T> &_pt)
+      public: constexpr const Vector3<T> &operator-=(const Vector3<T> &_pt)
       {
-        this->data[0] -= _pt[0];
-        this->data[1] -= _pt[1];
-        this->data[2] -= _pt[2];
-
+        Kernels::Sub(this->data, this->data, _pt.data);
         return *this;
       }
 
       /// \brief Subtraction operators
       /// \param[in] _s the scalar subtrahend
       /// \return difference vector
-      public: inline Vector3<T> operator-(const T _s) const
+      public: constexpr Vector3<T> operator-(const T _s) const
       {
-        return Vector3<T>(this->data[0] - _s,
-                          this->data[1] - _s,
-                          this->data[2] - _s);
+        Vector3<T> result;
+        Kernels::SubScalar(result.data, this->data, _s);
+        return result;
       }
 
       /// \brief Subtraction operators
       /// \param[in] _s the scalar minuend
       /// \param[in] _v vector subtrahend
       /// \return difference vector
-      public: friend inline Vector3<T> operator-(const T _s,
+      public: friend constexpr Vector3<T> operator-(const T _s,
                                                  const Vector3<T> &_v)
       {
-        return {_s - _v.X(), _s - _v.Y(), _s - _v.Z()};
+        Vector3<T> result;
+        Kernels::ScalarSub(result.data, _s, _v.data);
+        return result;
       }
 
       /// \brief Subtraction assignment operator
       /// \param[in] _s scalar subtrahend
       /// \return this
-      public: const Vector3<T> &operator-=(const T _s)
+      public: constexpr const Vector3<T> &operator-=(const T _s)
       {
-        this->data[0] -= _s;
-        this->data[1] -= _s;
-        this->data[2] -= _s;
-
+        Kernels::SubScalar(this->data, this->data, _s);
         return *this;
       }
 
@@ -460,23 +493,20 @@ namespace gz
       /// \remarks this is an element wise division
       /// \param[in] _pt the vector divisor
       /// \return a vector
-      public: const Vector3<T> operator/(const Vector3<T> &_pt) const
+      public: constexpr const Vector3<T> operator/(const Vector3<T> &_pt) const
       {
-        return Vector3(this->data[0] / _pt[0],
-                       this->data[1] / _pt[1],
-                       this->data[2] / _pt[2]);
+        Vector3<T> result;
+        Kernels::Div(result.data, this->data, _pt.data);
+        return result;
       }
 
       /// \brief Division assignment operator
       /// \remarks this is an element wise division
       /// \param[in] _pt the vector divisor
       /// \return a vector
-      public: const Vector3<T> &operator/=(const Vector3<T> &_pt)
+      public: constexpr const Vector3<T> &operator/=(const Vector3<T> &_pt)
       {
-        this->data[0] /= _pt[0];
-        this->data[1] /= _pt[1];
-        this->data[2] /= _pt[2];
-
+        Kernels::Div(this->data, this->data, _pt.data);
         return *this;
       }
 
@@ -484,23 +514,20 @@ namespace gz
       /// \remarks this is an element wise division
       /// \param[in] _v the divisor
       /// \return a vector
-      public: const Vector3<T> operator/(T _v) const
+      public: constexpr const Vector3<T> operator/(T _v) const
       {
-        return Vector3(this->data[0] / _v,
-                       this->data[1] / _v,
-                       this->data[2] / _v);
+        Vector3<T> result;
+        Kernels::DivScalar(result.data, this->data, _v);
+        return result;
       }
 
       /// \brief Division assignment operator
       /// \remarks this is an element wise division
       /// \param[in] _v the divisor
       /// \return this
-      public: const Vector3<T> &operator/=(T _v)
+      public: constexpr const Vector3<T> &operator/=(T _v)
       {
-        this->data[0] /= _v;
-        this->data[1] /= _v;
-        this->data[2] /= _v;
-
+        Kernels::DivScalar(this->data, this->data, _v);
         return *this;
       }
 
@@ -508,54 +535,48 @@ namespace gz
       /// \remarks this is an element wise multiplication, not a cross product
       /// \param[in] _p multiplier operator
       /// \return a vector
-      public: Vector3<T> operator*(const Vector3<T> &_p) const
+      public: constexpr Vector3<T> operator*(const Vector3<T> &_p) const
       {
-        return Vector3(this->data[0] * _p[0],
-                       this->data[1] * _p[1],
-                       this->data[2] * _p[2]);
+        Vector3<T> result;
+        Kernels::Mul(result.data, this->data, _p.data);
+        return result;
       }
 
       /// \brief Multiplication assignment operators
       /// \remarks this is an element wise multiplication, not a cross product
       /// \param[in] _v a vector
       /// \return this
-      public: const Vector3<T> &operator*=(const Vector3<T> &_v)
+      public: constexpr const Vector3<T> &operator*=(const Vector3<T> &_v)
       {
-        this->data[0] *= _v[0];
-        this->data[1] *= _v[1];
-        this->data[2] *= _v[2];
-
+        Kernels::Mul(this->data, this->data, _v.data);
         return *this;
       }
 
       /// \brief Multiplication operators
       /// \param[in] _s the scaling factor
       /// \return a scaled vector
-      public: inline Vector3<T> operator*(T _s) const
+      public: constexpr Vector3<T> operator*(T _s) const
       {
-        return Vector3<T>(this->data[0] * _s,
-                          this->data[1] * _s,
-                          this->data[2] * _s);
+        Vector3<T> result;
+        Kernels::MulScalar(result.data, this->data, _s);
+        return result;
       }
 
       /// \brief Multiplication operators
       /// \param[in] _s the scaling factor
       /// \param[in] _v input vector
       /// \return a scaled vector
-      public: friend inline Vector3<T> operator*(T _s, const Vector3<T> &_v)
+      public: friend constexpr Vector3<T> operator*(T _s, const Vector3<T> &_v)
       {
-        return {_v.X() * _s, _v.Y() * _s, _v.Z() * _s};
+        return _v * _s;
       }
 
       /// \brief Multiplication operator
       /// \param[in] _v scaling factor
       /// \return this
-      public: const Vector3<T> &operator*=(T _v)
+      public: constexpr const Vector3<T> &operator*=(T _v)
       {
-        this->data[0] *= _v;
-        this->data[1] *= _v;
-        this->data[2] *= _v;
-
+        Kernels::MulScalar(this->data, this->data, _v);
         return *this;
       }
 
@@ -566,9 +587,7 @@ namespace gz
       /// the tolerence specified by _tol.
       public: bool Equal(const Vector3 &_v, const T &_tol) const
       {
-        return equal<T>(this->data[0], _v[0], _tol)
-            && equal<T>(this->data[1], _v[1], _tol)
-            && equal<T>(this->data[2], _v[2], _tol);
+        return Kernels::Equal(this->data, _v.data, _tol);
       }
 
       /// \brief Equal to operator
@@ -593,31 +612,20 @@ namespace gz
       /// \return true if is finite or false otherwise
       public: bool IsFinite() const
       {
-        // std::isfinite works with floating point values,
-        // need to explicit cast to avoid ambiguity in vc++.
-        return std::isfinite(static_cast<double>(this->data[0])) &&
-               std::isfinite(static_cast<double>(this->data[1])) &&
-               std::isfinite(static_cast<double>(this->data[2]));
+        return Kernels::IsFinite(this->data);
       }
 
       /// \brief Corrects any nan values
       public: inline void Correct()
       {
-        // std::isfinite works with floating point values,
-        // need to explicit cast to avoid ambiguity in vc++.
-        if (!std::isfinite(static_cast<double>(this->data[0])))
-          this->data[0] = 0;
-        if (!std::isfinite(static_cast<double>(this->data[1])))
-          this->data[1] = 0;
-        if (!std::isfinite(static_cast<double>(this->data[2])))
-          this->data[2] = 0;
+        Kernels::Correct(this->data);
       }
 
       /// \brief Array subscript operator
       /// \param[in] _index The index, where 0 == x, 1 == y, 2 == z.
       /// The index is clamped to the range [0,2].
       /// \return The value.
-      public: T &operator[](const std::size_t _index)
+      public: constexpr T &operator[](const std::size_t _index)
       {
         return this->data[clamp(_index, GZ_ZERO_SIZE_T, GZ_TWO_SIZE_T)];
       }
@@ -626,7 +634,7 @@ namespace gz
       /// \param[in] _index The index, where 0 == x, 1 == y, 2 == z.
       /// The index is clamped to the range [0,2].
       /// \return The value.
-      public: T operator[](const std::size_t _index) const
+      public: constexpr T operator[](const std::size_t _index) const
       {
         return this->data[clamp(_index, GZ_ZERO_SIZE_T, GZ_TWO_SIZE_T)];
       }
@@ -635,9 +643,7 @@ namespace gz
       /// \param[in] _precision the decimal places
       public: void Round(int _precision)
       {
-        this->data[0] = precision(this->data[0], _precision);
-        this->data[1] = precision(this->data[1], _precision);
-        this->data[2] = precision(this->data[2], _precision);
+        Kernels::Round(this->data, _precision);
       }
 
       /// \brief Equality test
@@ -646,70 +652,68 @@ namespace gz
       /// \return true if the 2 vectors have the same values, false otherwise
       public: bool Equal(const Vector3<T> &_v) const
       {
-        return equal<T>(this->data[0], _v[0]) &&
-               equal<T>(this->data[1], _v[1]) &&
-               equal<T>(this->data[2], _v[2]);
+        return Kernels::Equal(this->data, _v.data, static_cast<T>(1e-6));
       }
 
       /// \brief Get the x value.
       /// \return The x component of the vector
-      public: inline T X() const
+      public: constexpr T X() const
       {
         return this->data[0];
       }
 
       /// \brief Get the y value.
       /// \return The y component of the vector
-      public: inline T Y() const
+      public: constexpr T Y() const
       {
         return this->data[1];
       }
 
       /// \brief Get the z value.
       /// \return The z component of the vector
-      public: inline T Z() const
+      public: constexpr T Z() const
       {
         return this->data[2];
       }
 
       /// \brief Get a mutable reference to the x value.
       /// \return The x component of the vector
-      public: inline T &X()
+      public: constexpr T &X()
       {
         return this->data[0];
       }
 
       /// \brief Get a mutable reference to the y value.
       /// \return The y component of the vector
-      public: inline T &Y()
+      public: constexpr T &Y()
       {
         return this->data[1];
       }
 
       /// \brief Get a mutable reference to the z value.
       /// \return The z component of the vector
-      public: inline T &Z()
+      public: constexpr T &Z()
       {
         return this->data[2];
       }
 
       /// \brief Set the x value.
       /// \param[in] _v Value for the x component.
-      public: inline void X(const T &_v)
+      public: constexpr void X(const T &_v)
       {
         this->data[0] = _v;
       }
 
       /// \brief Set the y value.
       /// \param[in] _v Value for the y component.
-      public: inline void Y(const T &_v)
+      public: constexpr void Y(const T &_v)
       {
         this->data[1] = _v;
       }
 
       /// \brief Set the z value.
       /// \param[in] _v Value for the z component.
-      public: inline void Z(const T &_v)
+      public: constexpr void Z(const T &_v)
       {
         this->data[2] = _v;
       }
@@ -718,7 +722,7 @@ namespace gz
       /// \param[in] _pt Vector to compare.
       /// \return True if this vector's X(), Y(), or Z() value is less
       /// than the given vector's corresponding values.
-      public: bool operator<(const Vector3<T> &_pt) const
+      public: constexpr bool operator<(const Vector3<T> &_pt) const
       {
         return this->data[0] < _pt[0] || this->data[1] < _pt[1] ||
                this->data[2] < _pt[2];
@@ -742,6 +746,25 @@ namespace gz
         return _out;
       }
 
+      /// \brief Append the vector to a string, in the format of operator<<
+      /// but with std::to_chars, which is faster than a stream.
+      /// \param[in, out] _out The string
+      /// \param[in] _pt Vector to append
+      /// \param[in] _precision Number of digits after the decimal point, or
+      /// a negative value for the shortest representation that reads back as
+      /// the same number
+      public: friend void appendToString(std::string &_out,
+                  const Vector3<T> &_pt, int _precision = -1)
+      {
+        for (auto i : {0, 1, 2})
+        {
+          if (i > 0)
+            _out += ' ';
+
+          appendToString(_out, _pt[i], _precision);
+        }
+      }
+
       /// \brief Stream extraction operator
       /// \param _in input stream
       /// \param _pt vector3 to read values into
@@ -760,6 +783,9 @@ namespace gz
         return _in;
       }
 
+      /// \brief Per component kernels shared with Vector2 and Vector4.
+      private: using Kernels = detail::VectorN<T, 3>;
+
       /// \brief The x, y, and z values
       private: T data[3];
     };
@@ -0,0 +1,505 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_VECTOR3A_HH_
+#define GZ_MATH_VECTOR3A_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <istream>
+#include <ostream>
+
+#include <gz/math/Helpers.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    //
+    /// \class Vector3A Vector3A.hh gz/math/Vector3A.hh
+    /// \brief A three dimensional vector padded to four elements and aligned
+    /// to the size of those four elements (16 bytes for float, 32 bytes for
+    /// double).
+    ///
+    /// Vector3A offers the arithmetic subset of the Vector3 API and converts
+    /// implicitly to and from Vector3, so it can be used as a drop-in storage
+    /// type in hot loops where aligned, padded loads matter. The fourth
+    /// element is padding: it is always zero and is not part of the value of
+    /// the vector.
+    ///
+    /// Vector3 itself is unchanged, so its size and layout stay the same.
+    template<typename T>
+    class alignas(4 * sizeof(T)) Vector3A
+    {
+      /// \brief Default constructor, initializes to (0, 0, 0).
+      public: constexpr Vector3A()
+      : data{0, 0, 0, 0}
+      {
+      }
+
+      /// \brief Constructor.
+      /// \param[in] _x Value along x.
+      /// \param[in] _y Value along y.
+      /// \param[in] _z Value along z.
+      public: constexpr Vector3A(const T &_x, const T &_y, const T &_z)
+      : data{_x, _y, _z, 0}
+      {
+      }
+
+      /// \brief Construct from a Vector3.
+      /// \param[in] _v Vector to copy.
+      // cppcheck-suppress noExplicitConstructor
+      public: constexpr Vector3A(const Vector3<T> &_v)
+      : data{_v.X(), _v.Y(), _v.Z(), 0}
+      {
+      }
+
+      /// \brief Convert to a Vector3.
+      /// \return A Vector3 with the same x, y and z values.
+      public: constexpr operator Vector3<T>() const
+      {
+        return Vector3<T>(this->data[0], this->data[1], this->data[2]);
+      }
+
+      /// \brief Convert to a Vector3.
+      /// \return A Vector3 with the same x, y and z values.
+      public: constexpr Vector3<T> ToVector3() const
+      {
+        return Vector3<T>(this->data[0], this->data[1], this->data[2]);
+      }
+
+      /// \brief Set the contents of the vector.
+      /// \param[in] _x Value along x.
+      /// \param[in] _y Value along y.
+      /// \param[in] _z Value along z.
+      public: constexpr void Set(T _x = 0, T _y = 0, T _z = 0)
+      {
+        this->data[0] = _x;
+        this->data[1] = _y;
+        this->data[2] = _z;
+      }
+
+      /// \brief Return the sum of the values.
+      /// \return The sum.
+      public: constexpr T Sum() const
+      {
+        return this->data[0] + this->data[1] + this->data[2];
+      }
+
+      /// \brief Return the dot product of this vector and another vector.
+      /// \param[in] _v The vector.
+      /// \return The dot product.
+      public: constexpr T Dot(const Vector3A<T> &_v) const
+      {
+        return this->data[0] * _v[0] +
+               this->data[1] * _v[1] +
+               this->data[2] * _v[2];
+      }
+
+      /// \brief Return the cross product of this vector with another vector.
+      /// \param[in] _v The vector.
+      /// \return The cross product.
+      public: constexpr Vector3A Cross(const Vector3A<T> &_v) const
+      {
+        return Vector3A(this->data[1] * _v[2] - this->data[2] * _v[1],
+                        this->data[2] * _v[0] - this->data[0] * _v[2],
+                        this->data[0] * _v[1] - this->data[1] * _v[0]);
+      }
+
+      /// \brief Return the square of the length (magnitude) of the vector.
+      /// \return The squared length.
+      public: constexpr T SquaredLength() const
+      {
+        return this->Dot(*this);
+      }
+
+      /// \brief Return the length (magnitude) of the vector.
+      /// \return The length.
+      public: T Length() const
+      {
+        return static_cast<T>(sqrt(this->SquaredLength()));
+      }
+
+      /// \brief Calculate the distance to a point.
+      /// \param[in] _pt The point.
+      /// \return The distance.
+      public: T Distance(const Vector3A<T> &_pt) const
+      {
+        return (*this - _pt).Length();
+      }
+
+      /// \brief Normalize the vector length. A vector of length zero is left
+      /// unchanged.
+      /// \return This vector.
+      public: Vector3A Normalize()
+      {
+        const T d = this->Length();
+        if (!equal<T>(d, static_cast<T>(0.0)))
+        {
+          this->data[0] /= d;
+          this->data[1] /= d;
+          this->data[2] /= d;
+        }
+        return *this;
+      }
+
+      /// \brief Return a normalized vector.
+      /// \return A unit length vector, or a zero vector if this vector has
+      /// a length of zero.
+      public: Vector3A Normalized() const
+      {
+        Vector3A<T> result = *this;
+        result.Normalize();
+        return result;
+      }
+
+      /// \brief Get the absolute value of the vector.
+      /// \return A vector with the absolute value of each element.
+      public: Vector3A Abs() const
+      {
+        return Vector3A(std::abs(this->data[0]),
+                        std::abs(this->data[1]),
+                        std::abs(this->data[2]));
+      }
+
+      /// \brief Set this vector's elements to the maximum of itself and
+      /// another vector.
+      /// \param[in] _v The maximum clamping vector.
+      public: constexpr void Max(const Vector3A<T> &_v)
+      {
+        for (std::size_t i = 0; i < 3; ++i)
+          this->data[i] = std::max(this->data[i], _v.data[i]);
+      }
+
+      /// \brief Set this vector's elements to the minimum of itself and
+      /// another vector.
+      /// \param[in] _v The minimum clamping vector.
+      public: constexpr void Min(const Vector3A<T> &_v)
+      {
+        for (std::size_t i = 0; i < 3; ++i)
+          this->data[i] = std::min(this->data[i], _v.data[i]);
+      }
+
+      /// \brief Get the maximum value in the vector.
+      /// \return The maximum element.
+      public: constexpr T Max() const
+      {
+        return std::max(std::max(this->data[0], this->data[1]), this->data[2]);
+      }
+
+      /// \brief Get the minimum value in the vector.
+      /// \return The minimum element.
+      public: constexpr T Min() const
+      {
+        return std::min(std::min(this->data[0], this->data[1]), this->data[2]);
+      }
+
+      /// \brief Addition operator.
+      /// \param[in] _v Vector to add.
+      /// \return The sum vector.
+      public: constexpr Vector3A operator+(const Vector3A<T> &_v) const
+      {
+        Vector3A<T> result(*this);
+        result += _v;
+        return result;
+      }
+
+      /// \brief Addition assignment operator.
+      /// \param[in] _v Vector to add.
+      /// \return This vector.
+      public: constexpr const Vector3A &operator+=(const Vector3A<T> &_v)
+      {
+        // All four lanes, the padding of both vectors is zero.
+        for (std::size_t i = 0; i < 4; ++i)
+          this->data[i] += _v.data[i];
+        return *this;
+      }
+
+      /// \brief Subtraction operator.
+      /// \param[in] _v Vector to subtract.
+      /// \return The difference vector.
+      public: constexpr Vector3A operator-(const Vector3A<T> &_v) const
+      {
+        Vector3A<T> result(*this);
+        result -= _v;
+        return result;
+      }
+
+      /// \brief Subtraction assignment operator.
+      /// \param[in] _v Vector to subtract.
+      /// \return This vector.
+      public: constexpr const Vector3A &operator-=(const Vector3A<T> &_v)
+      {
+        for (std::size_t i = 0; i < 4; ++i)
+          this->data[i] -= _v.data[i];
+        return *this;
+      }
+
+      /// \brief Negation operator.
+      /// \return The negated vector.
+      public: constexpr Vector3A operator-() const
+      {
+        return Vector3A(-this->data[0], -this->data[1], -this->data[2]);
+      }
+
+      /// \brief Element-wise multiplication operator.
+      /// \param[in] _v Vector to multiply by.
+      /// \return The product vector.
+      public: constexpr Vector3A operator*(const Vector3A<T> &_v) const
+      {
+        Vector3A<T> result(*this);
+        result *= _v;
+        return result;
+      }
+
+      /// \brief Element-wise multiplication assignment operator.
+      /// \param[in] _v Vector to multiply by.
+      /// \return This vector.
+      public: constexpr const Vector3A &operator*=(const Vector3A<T> &_v)
+      {
+        for (std::size_t i = 0; i < 4; ++i)
+          this->data[i] *= _v.data[i];
+        return *this;
+      }
+
+      /// \brief Scalar multiplication operator.
+      /// \param[in] _s Scale factor.
+      /// \return The scaled vector.
+      public: constexpr Vector3A operator*(T _s) const
+      {
+        Vector3A<T> result(*this);
+        result *= _s;
+        return result;
+      }
+
+      /// \brief Scalar left multiplication operator.
+      /// \param[in] _s Scale factor.
+      /// \param[in] _v Vector to scale.
+      /// \return The scaled vector.
+      public: friend constexpr Vector3A<T> operator*(T _s,
+                                                     const Vector3A<T> &_v)
+      {
+        return _v * _s;
+      }
+
+      /// \brief Scalar multiplication assignment operator.
+      /// \param[in] _s Scale factor.
+      /// \return This vector.
+      public: constexpr const Vector3A &operator*=(T _s)
+      {
+        for (std::size_t i = 0; i < 4; ++i)
+          this->data[i] *= _s;
+        return *this;
+      }
+
+      /// \brief Element-wise division operator.
+      /// \param[in] _v Vector to divide by.
+      /// \return The quotient vector.
+      public: constexpr Vector3A operator/(const Vector3A<T> &_v) const
+      {
+        return Vector3A(this->data[0] / _v[0],
+                        this->data[1] / _v[1],
+                        this->data[2] / _v[2]);
+      }
+
+      /// \brief Scalar division operator.
+      /// \param[in] _s Divisor.
+      /// \return The quotient vector.
+      public: constexpr Vector3A operator/(T _s) const
+      {
+        return Vector3A(this->data[0] / _s,
+                        this->data[1] / _s,
+                        this->data[2] / _s);
+      }
+
+      /// \brief Scalar division assignment operator.
+      /// \param[in] _s Divisor.
+      /// \return This vector.
+      public: constexpr const Vector3A &operator/=(T _s)
+      {
+        *this = *this / _s;
+        return *this;
+      }
+
+      /// \brief Equality test with tolerance.
+      /// \param[in] _v The vector to compare against.
+      /// \param[in] _tol Equality tolerance.
+      /// \return True if each element of both vectors are equal within _tol.
+      public: bool Equal(const Vector3A &_v, const T &_tol) const
+      {
+        return equal<T>(this->data[0], _v[0], _tol)
+            && equal<T>(this->data[1], _v[1], _tol)
+            && equal<T>(this->data[2], _v[2], _tol);
+      }
+
+      /// \brief Equal to operator. As in Vector3, a tolerance of 1e-6 is
+      /// used.
+      /// \param[in] _v The vector to compare against.
+      /// \return True if each element of both vectors are equal.
+      public: bool operator==(const Vector3A<T> &_v) const
+      {
+        return this->Equal(_v, static_cast<T>(1e-6));
+      }
+
+      /// \brief Not equal to operator.
+      /// \param[in] _v The vector to compare against.
+      /// \return False if each element of both vectors are equal.
+      public: bool operator!=(const Vector3A<T> &_v) const
+      {
+        return !(*this == _v);
+      }
+
+      /// \brief See if a point is finite (e.g., not nan).
+      /// \return True if is finite or false otherwise.
+      public: bool IsFinite() const
+      {
+        return std::isfinite(static_cast<double>(this->data[0])) &&
+               std::isfinite(static_cast<double>(this->data[1])) &&
+               std::isfinite(static_cast<double>(this->data[2]));
+      }
+
+      /// \brief Array subscript operator.
+      /// \param[in] _index The index, where 0 == x, 1 == y, 2 == z.
+      /// The index is clamped to the range [0,2].
+      /// \return The value.
+      public: constexpr T &operator[](const std::size_t _index)
+      {
+        return this->data[clamp(_index, GZ_ZERO_SIZE_T, GZ_TWO_SIZE_T)];
+      }
+
+      /// \brief Const-qualified array subscript operator.
+      /// \param[in] _index The index, where 0 == x, 1 == y, 2 == z.
+      /// The index is clamped to the range [0,2].
+      /// \return The value.
+      public: constexpr T operator[](const std::size_t _index) const
+      {
+        return this->data[clamp(_index, GZ_ZERO_SIZE_T, GZ_TWO_SIZE_T)];
+      }
+
+      /// \brief Get the x value.
+      /// \return The x component of the vector.
+      public: constexpr T X() const
+      {
+        return this->data[0];
+      }
+
+      /// \brief Get the y value.
+      /// \return The y component of the vector.
+      public: constexpr T Y() const
+      {
+        return this->data[1];
+      }
+
+      /// \brief Get the z value.
+      /// \return The z component of the vector.
+      public: constexpr T Z() const
+      {
+        return this->data[2];
+      }
+
+      /// \brief Get a mutable reference to the x value.
+      /// \return The x component of the vector.
+      public: constexpr T &X()
+      {
+        return this->data[0];
+      }
+
+      /// \brief Get a mutable reference to the y value.
+      /// \return The y component of the vector.
+      public: constexpr T &Y()
+      {
+        return this->data[1];
+      }
+
+      /// \brief Get a mutable reference to the z value.
+      /// \return The z component of the vector.
+      public: constexpr T &Z()
+      {
+        return this->data[2];
+      }
+
+      /// \brief Set the x value.
+      /// \param[in] _v Value for the x component.
+      public: constexpr void X(const T &_v)
+      {
+        this->data[0] = _v;
+      }
+
+      /// \brief Set the y value.
+      /// \param[in] _v Value for the y component.
+      public: constexpr void Y(const T &_v)
+      {
+        this->data[1] = _v;
+      }
+
+      /// \brief Set the z value.
+      /// \param[in] _v Value for the z component.
+      public: constexpr void Z(const T &_v)
+      {
+        this->data[2] = _v;
+      }
+
+      /// \brief Get a pointer to the four padded elements, x, y, z and a
+      /// zero. The pointer is aligned to 4 * sizeof(T).
+      /// \return Pointer to the first element.
+      public: const T *Data() const
+      {
+        return this->data;
+      }
+
+      /// \brief Stream insertion operator.
+      /// \param[in, out] _out Output stream.
+      /// \param[in] _pt Vector3A to output.
+      /// \return The stream.
+      public: friend std::ostream &operator<<(
+                  std::ostream &_out, const Vector3A<T> &_pt)
+      {
+        return _out << _pt.ToVector3();
+      }
+
+      /// \brief Stream extraction operator.
+      /// \param[in, out] _in Input stream.
+      /// \param[out] _pt Vector3A to read values into.
+      /// \return The stream.
+      public: friend std::istream &operator>>(
+                  std::istream &_in, Vector3A<T> &_pt)
+      {
+        Vector3<T> v;
+        _in >> v;
+        _pt = v;
+        return _in;
+      }
+
+      /// \brief The x, y and z values, followed by a padding element that
+      /// is always zero.
+      private: T data[4];
+    };
+
+    typedef Vector3A<double> Vector3Ad;
+    typedef Vector3A<float> Vector3Af;
+
+    static_assert(sizeof(Vector3Af) == 16, "Vector3Af must be 16 bytes");
+    static_assert(alignof(Vector3Af) == 16, "Vector3Af must be 16-aligned");
+    static_assert(sizeof(Vector3Ad) == 32, "Vector3Ad must be 32 bytes");
+    }
+  }
+}
+#endif
@@ -17,7 +17,10 @@
 #ifndef GZ_MATH_VECTOR3STATS_HH_
 #define GZ_MATH_VECTOR3STATS_HH_
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
 #include <gz/math/Helpers.hh>
 #include <gz/math/SignalStats.hh>
 #include <gz/math/Vector3.hh>
@@ -41,6 +44,14 @@ namespace gz
       /// \param[in] _data New signal data point.
       public: void InsertData(const Vector3d &_data);
 
+      /// \brief Add a block of samples to the statistical measures. The
+      /// samples are split into components and magnitudes in small chunks
+      /// that stay in cache, and each statistic processes a whole chunk at
+      /// once, which is much faster than inserting the samples one by one.
+      /// \param[in] _data Pointer to the first sample.
+      /// \param[in] _count Number of samples.
+      public: void InsertData(const Vector3d *_data, const size_t _count);
+
       /// \brief Add a new type of statistic.
       /// \param[in] _name Short name of new statistic.
       /// Valid values include:
@@ -64,6 +75,31 @@ namespace gz
       /// \brief Forget all previous data.
       public: void Reset();
 
+      /// \brief Append a compact binary snapshot of the accumulator state
+      /// of the statistics of the components and magnitude to a buffer,
+      /// see SignalStats::Snapshot.
+      /// \param[in,out] _buffer Buffer the snapshot is appended to.
+      /// \return Number of bytes appended.
+      public: size_t Snapshot(std::vector<uint8_t> &_buffer) const;
+
+      /// \brief Add the data of a snapshot taken by Snapshot from a
+      /// collection with the same statistics, see
+      /// SignalStats::MergeSnapshot.
+      /// \param[in] _data Pointer to the snapshot.
+      /// \param[in] _size Number of bytes of the snapshot.
+      /// \return True if the statistics were merged, false if the snapshot
+      /// is malformed or the statistics of a component could not be
+      /// merged.
+      public: bool MergeSnapshot(const uint8_t *_data, const size_t _size);
+
+      /// \brief Replace the statistics and their data by those of a
+      /// snapshot taken by Snapshot.
+      /// \param[in] _data Pointer to the snapshot.
+      /// \param[in] _size Number of bytes of the snapshot.
+      /// \return True if the snapshot was restored, false if it is
+      /// malformed, in which case this collection is unchanged.
+      public: bool RestoreSnapshot(const uint8_t *_data, const size_t _size);
+
       /// \brief Get statistics for x component of signal.
       /// \return Statistics for x component of signal.
       public: const SignalStats &X() const;
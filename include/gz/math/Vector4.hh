@@ -20,10 +20,12 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <string>
 
 #include <gz/math/Matrix4.hh>
 #include <gz/math/Helpers.hh>
 #include <gz/math/config.hh>
+#include <gz/math/detail/VectorN.hh>
 
 namespace gz
 {
@@ -76,10 +78,7 @@ namespace gz
       public: T Distance(const Vector4<T> &_pt) const
       {
         return static_cast<T>(sqrt(
-                    (this->data[0]-_pt[0])*(this->data[0]-_pt[0]) +
-                    (this->data[1]-_pt[1])*(this->data[1]-_pt[1]) +
-                    (this->data[2]-_pt[2])*(this->data[2]-_pt[2]) +
-                    (this->data[3]-_pt[3])*(this->data[3]-_pt[3])));
+            Kernels::SquaredDistance(this->data, _pt.data)));
       }
 
       /// \brief Calc distance to the given point
@@ -102,22 +101,15 @@ namespace gz
 
       /// \brief Return the square of the length (magnitude) of the vector
       /// \return the length
-      public: T SquaredLength() const
+      public: constexpr T SquaredLength() const
       {
-        return
-          this->data[0] * this->data[0] +
-          this->data[1] * this->data[1] +
-          this->data[2] * this->data[2] +
-          this->data[3] * this->data[3];
+        return Kernels::Dot(this->data, this->data);
       }
 
       /// \brief Round to near whole number.
       public: void Round()
       {
-        this->data[0] = static_cast<T>(std::nearbyint(this->data[0]));
-        this->data[1] = static_cast<T>(std::nearbyint(this->data[1]));
-        this->data[2] = static_cast<T>(std::nearbyint(this->data[2]));
-        this->data[3] = static_cast<T>(std::nearbyint(this->data[3]));
+        Kernels::Round(this->data);
       }
 
       /// \brief Get a rounded version of this vector
@@ -132,16 +124,7 @@ namespace gz
       /// \brief Corrects any nan values
       public: inline void Correct()
       {
-        // std::isfinite works with floating point values,
-        // need to explicit cast to avoid ambiguity in vc++.
-        if (!std::isfinite(static_cast<double>(this->data[0])))
-          this->data[0] = 0;
-        if (!std::isfinite(static_cast<double>(this->data[1])))
-          this->data[1] = 0;
-        if (!std::isfinite(static_cast<double>(this->data[2])))
-          this->data[2] = 0;
-        if (!std::isfinite(static_cast<double>(this->data[3])))
-          this->data[3] = 0;
+        Kernels::Correct(this->data);
       }
 
       /// \brief Normalize the vector length
@@ -150,12 +133,7 @@ namespace gz
         T d = this->Length();
 
         if (!equal<T>(d, static_cast<T>(0.0)))
-        {
-          this->data[0] /= d;
-          this->data[1] /= d;
-          this->data[2] /= d;
-          this->data[3] /= d;
-        }
+          Kernels::DivScalar(this->data, this->data, d);
       }
 
       /// \brief Return a normalized vector
@@ -170,12 +148,9 @@ namespace gz
       /// \brief Return the dot product of this vector and another vector
       /// \param[in] _v the vector
       /// \return the dot product
-      public: T Dot(const Vector4<T> &_v) const
+      public: constexpr T Dot(const Vector4<T> &_v) const
       {
-        return this->data[0] * _v[0] +
-               this->data[1] * _v[1] +
-               this->data[2] * _v[2] +
-               this->data[3] * _v[3];
+        return Kernels::Dot(this->data, _v.data);
       }
 
       /// \brief Return the absolute dot product of this vector and
@@ -188,20 +163,16 @@ namespace gz
       /// \return The absolute dot product
       public: T AbsDot(const Vector4<T> &_v) const
       {
-        return std::abs(this->data[0] * _v[0]) +
-               std::abs(this->data[1] * _v[1]) +
-               std::abs(this->data[2] * _v[2]) +
-               std::abs(this->data[3] * _v[3]);
+        return Kernels::AbsDot(this->data, _v.data);
       }
 
       /// \brief Get the absolute value of the vector
       /// \return a vector with positive elements
       public: Vector4 Abs() const
       {
-        return Vector4(std::abs(this->data[0]),
-                       std::abs(this->data[1]),
-                       std::abs(this->data[2]),
-                       std::abs(this->data[3]));
+        Vector4<T> result;
+        Kernels::Abs(result.data, this->data);
+        return result;
       }
 
       /// \brief Set the contents of the vector
@@ -209,7 +180,7 @@ namespace gz
       /// \param[in] _y value along y axis
       /// \param[in] _z value along z axis
       /// \param[in] _w value along w axis
-      public: void Set(T _x = 0, T _y = 0, T _z = 0, T _w = 0)
+      public: constexpr void Set(T _x = 0, T _y = 0, T _z = 0, T _w = 0)
       {
         this->data[0] = _x;
         this->data[1] = _y;
@@ -220,44 +191,38 @@ namespace gz
       /// \brief Set this vector's components to the maximum of itself and the
       ///        passed in vector
       /// \param[in] _v the maximum clamping vector
-      public: void Max(const Vector4<T> &_v)
+      public: constexpr void Max(const Vector4<T> &_v)
       {
-        this->data[0] = std::max(_v[0], this->data[0]);
-        this->data[1] = std::max(_v[1], this->data[1]);
-        this->data[2] = std::max(_v[2], this->data[2]);
-        this->data[3] = std::max(_v[3], this->data[3]);
+        Kernels::Max(this->data, _v.data);
       }
 
       /// \brief Set this vector's components to the minimum of itself and the
       ///        passed in vector
       /// \param[in] _v the minimum clamping vector
-      public: void Min(const Vector4<T> &_v)
+      public: constexpr void Min(const Vector4<T> &_v)
       {
-        this->data[0] = std::min(_v[0], this->data[0]);
-        this->data[1] = std::min(_v[1], this->data[1]);
-        this->data[2] = std::min(_v[2], this->data[2]);
-        this->data[3] = std::min(_v[3], this->data[3]);
+        Kernels::Min(this->data, _v.data);
       }
 
       /// \brief Get the maximum value in the vector
       /// \return the maximum element
-      public: T Max() const
+      public: constexpr T Max() const
       {
-        return *std::max_element(this->data, this->data+4);
+        return Kernels::MaxElement(this->data);
       }
 
       /// \brief Get the minimum value in the vector
       /// \return the minimum element
-      public: T Min() const
+      public: constexpr T Min() const
       {
-        return *std::min_element(this->data, this->data+4);
+        return Kernels::MinElement(this->data);
       }
 
       /// \brief Return the sum of the values
       /// \return the sum
-      public: T Sum() const
+      public: constexpr T Sum() const
       {
-        return this->data[0] + this->data[1] + this->data[2] + this->data[3];
+        return Kernels::Sum(this->data);
       }
 
       /// \brief Assignment operator
@@ -267,56 +232,46 @@ namespace gz
 
       /// \brief Assignment operator
       /// \param[in] _value
-      public: Vector4<T> &operator=(T _value)
+      public: constexpr Vector4<T> &operator=(T _value)
       {
-        this->data[0] = _value;
-        this->data[1] = _value;
-        this->data[2] = _value;
-        this->data[3] = _value;
-
+        Kernels::Fill(this->data, _value);
         return *this;
       }
 
       /// \brief Addition operator
       /// \param[in] _v the vector to add
       /// \result a sum vector
-      public: Vector4<T> operator+(const Vector4<T> &_v) const
+      public: constexpr Vector4<T> operator+(const Vector4<T> &_v) const
       {
-        return Vector4<T>(this->data[0] + _v[0],
-                          this->data[1] + _v[1],
-                          this->data[2] + _v[2],
-                          this->data[3] + _v[3]);
+        Vector4<T> result;
+        Kernels::Add(result.data, this->data, _v.data);
+        return result;
       }
 
       /// \brief Addition operator
       /// \param[in] _v the vector to add
       /// \return this vector
-      public: const Vector4<T> &operator+=(const Vector4<T> &_v)
+      public: constexpr const Vector4<T> &operator+=(const Vector4<T> &_v)
       {
-        this->data[0] += _v[0];
-        this->data[1] += _v[1];
-        this->data[2] += _v[2];
-        this->data[3] += _v[3];
-
+        Kernels::Add(this->data, this->data, _v.data);
         return *this;
       }
 
       /// \brief Addition operators
       /// \param[in] _s the scalar addend
       /// \return sum vector
-      public: inline Vector4<T> operator+(const T _s) const
+      public: constexpr Vector4<T> operator+(const T _s) const
       {
-        return Vector4<T>(this->data[0] + _s,
-                          this->data[1] + _s,
-                          this->data[2] + _s,
-                          this->data[3] + _s);
+        Vector4<T> result;
+        Kernels::AddScalar(result.data, this->data, _s);
+        return result;
       }
 
       /// \brief Addition operators
       /// \param[in] _s the scalar addend
       /// \param[in] _v input vector
       /// \return sum vector
-      public: friend inline Vector4<T> operator+(const T _s,
+      public: friend constexpr Vector4<T> operator+(const T _s,
                                                  const Vector4<T> &_v)
       {
         return _v + _s;
@@ -325,79 +280,68 @@ namespace gz
       /// \brief Addition assignment operator
       /// \param[in] _s scalar addend
       /// \return this
-      public: const Vector4<T> &operator+=(const T _s)
+      public: constexpr const Vector4<T> &operator+=(const T _s)
       {
-        this->data[0] += _s;
-        this->data[1] += _s;
-        this->data[2] += _s;
-        this->data[3] += _s;
-
+        Kernels::AddScalar(this->data, this->data, _s);
         return *this;
       }
 
       /// \brief Negation operator
       /// \return negative of this vector
-      public: inline Vector4 operator-() const
+      public: constexpr Vector4 operator-() const
       {
-        return Vector4(-this->data[0], -this->data[1],
-                       -this->data[2], -this->data[3]);
+        Vector4<T> result;
+        Kernels::Negate(result.data, this->data);
+        return result;
       }
 
       /// \brief Subtraction operator
       /// \param[in] _v the vector to substract
       /// \return a vector
-      public: Vector4<T> operator-(const Vector4<T> &_v) const
+      public: constexpr Vector4<T> operator-(const Vector4<T> &_v) const
       {
-        return Vector4<T>(this->data[0] - _v[0],
-                          this->data[1] - _v[1],
-                          this->data[2] - _v[2],
-                          this->data[3] - _v[3]);
+        Vector4<T> result;
+        Kernels::Sub(result.data, this->data, _v.data);
+        return result;
       }
 
       /// \brief Subtraction assigment operators
       /// \param[in] _v the vector to substract
       /// \return this vector
-      public: const Vector4<T> &operator-=(const Vector4<T> &_v)
+      public: constexpr const Vector4<T> &operator-=(const Vector4<T> &_v)
       {
-        this->data[0] -= _v[0];
-        this->data[1] -= _v[1];
-        this->data[2] -= _v[2];
-        this->data[3] -= _v[3];
-
+        Kernels::Sub(this->data, this->data, _v.data);
         return *this;
       }
 
       /// \brief Subtraction operators
       /// \param[in] _s the scalar subtrahend
       /// \return difference vector
-      public: inline Vector4<T> operator-(const T _s) const
+      public: constexpr Vector4<T> operator-(const T _s) const
       {
-        return Vector4<T>(this->data[0] - _s,
-                          this->data[1] - _s,
-                          this->data[2] - _s,
-                          this->data[3] - _s);
+        Vector4<T> result;
+        Kernels::SubScalar(result.data, this->data, _s);
+        return result;
       }
 
       /// \brief Subtraction operators
       /// \param[in] _s the scalar minuend
       /// \param[in] _v vector subtrahend
       /// \return difference vector
-      public: friend inline Vector4<T> operator-(const T _s,
+      public: friend constexpr Vector4<T> operator-(const T _s,
                                                  const Vector4<T> &_v)
       {
-        return {_s - _v.X(), _s - _v.Y(), _s - _v.Z(), _s - _v.W()};
+        Vector4<T> result;
+        Kernels::ScalarSub(result.data, _s, _v.data);
+        return result;
       }
 
       /// \brief Subtraction assignment operator
       /// \param[in] _s scalar subtrahend
       /// \return this
-      public: const Vector4<T> &operator-=(const T _s)
+      public: constexpr const Vector4<T> &operator-=(const T _s)
       {
-        this->data[0] -= _s;
-        this->data[1] -= _s;
-        this->data[2] -= _s;
-        this->data[3] -= _s;
-
+        Kernels::SubScalar(this->data, this->data, _s);
         return *this;
       }
 
@@ -406,12 +350,11 @@ namespace gz
       /// which has limited use.
       /// \param[in] _v the vector to perform element wise division with
       /// \return a result vector
-      public: const Vector4<T> operator/(const Vector4<T> &_v) const
+      public: constexpr const Vector4<T> operator/(const Vector4<T> &_v) const
       {
-        return Vector4<T>(this->data[0] / _v[0],
-                          this->data[1] / _v[1],
-                          this->data[2] / _v[2],
-                          this->data[3] / _v[3]);
+        Vector4<T> result;
+        Kernels::Div(result.data, this->data, _v.data);
+        return result;
       }
 
       /// \brief Division assignment operator
@@ -419,13 +362,9 @@ namespace gz
       /// which has limited use.
       /// \param[in] _v the vector to perform element wise division with
       /// \return this
-      public: const Vector4<T> &operator/=(const Vector4<T> &_v)
+      public: constexpr const Vector4<T> &operator/=(const Vector4<T> &_v)
       {
-        this->data[0] /= _v[0];
-        this->data[1] /= _v[1];
-        this->data[2] /= _v[2];
-        this->data[3] /= _v[3];
-
+        Kernels::Div(this->data, this->data, _v.data);
         return *this;
       }
 
@@ -434,22 +373,19 @@ namespace gz
       /// which has limited use.
       /// \param[in] _v another vector
       /// \return a result vector
-      public: const Vector4<T> operator/(T _v) const
+      public: constexpr const Vector4<T> operator/(T _v) const
       {
-        return Vector4<T>(this->data[0] / _v, this->data[1] / _v,
-            this->data[2] / _v, this->data[3] / _v);
+        Vector4<T> result;
+        Kernels::DivScalar(result.data, this->data, _v);
+        return result;
       }
 
       /// \brief Division operator
       /// \param[in] _v scaling factor
       /// \return a vector
-      public: const Vector4<T> &operator/=(T _v)
+      public: constexpr const Vector4<T> &operator/=(T _v)
       {
-        this->data[0] /= _v;
-        this->data[1] /= _v;
-        this->data[2] /= _v;
-        this->data[3] /= _v;
-
+        Kernels::DivScalar(this->data, this->data, _v);
         return *this;
       }
 
@@ -458,12 +394,11 @@ namespace gz
       /// which has limited use.
       /// \param[in] _pt another vector
       /// \return result vector
-      public: const Vector4<T> operator*(const Vector4<T> &_pt) const
+      public: constexpr const Vector4<T> operator*(const Vector4<T> &_pt) const
       {
-        return Vector4<T>(this->data[0] * _pt[0],
-                          this->data[1] * _pt[1],
-                          this->data[2] * _pt[2],
-                          this->data[3] * _pt[3]);
+        Vector4<T> result;
+        Kernels::Mul(result.data, this->data, _pt.data);
+        return result;
       }
 
       /// \brief Matrix multiplication operator.
@@ -487,30 +422,27 @@ namespace gz
       /// which has limited use.
       /// \param[in] _pt a vector
       /// \return this
-      public: const Vector4<T> &operator*=(const Vector4<T> &_pt)
+      public: constexpr const Vector4<T> &operator*=(const Vector4<T> &_pt)
       {
-        this->data[0] *= _pt[0];
-        this->data[1] *= _pt[1];
-        this->data[2] *= _pt[2];
-        this->data[3] *= _pt[3];
-
+        Kernels::Mul(this->data, this->data, _pt.data);
         return *this;
       }
 
       /// \brief Multiplication operators
       /// \param[in] _v scaling factor
       /// \return a  scaled vector
-      public: const Vector4<T> operator*(T _v) const
+      public: constexpr const Vector4<T> operator*(T _v) const
       {
-        return Vector4<T>(this->data[0] * _v, this->data[1] * _v,
-            this->data[2] * _v, this->data[3] * _v);
+        Vector4<T> result;
+        Kernels::MulScalar(result.data, this->data, _v);
+        return result;
       }
 
       /// \brief Scalar left multiplication operators
       /// \param[in] _s the scaling factor
       /// \param[in] _v the vector to scale
       /// \return a scaled vector
-      public: friend inline const Vector4 operator*(const T _s,
+      public: friend constexpr const Vector4 operator*(const T _s,
                                                     const Vector4 &_v)
       {
         return Vector4(_v * _s);
@@ -519,13 +451,9 @@ namespace gz
       /// \brief Multiplication assignment operator
       /// \param[in] _v scaling factor
       /// \return this
-      public: const Vector4<T> &operator*=(T _v)
+      public: constexpr const Vector4<T> &operator*=(T _v)
       {
-        this->data[0] *= _v;
-        this->data[1] *= _v;
-        this->data[2] *= _v;
-        this->data[3] *= _v;
-
+        Kernels::MulScalar(this->data, this->data, _v);
         return *this;
       }
 
@@ -536,10 +464,7 @@ namespace gz
       /// the tolerence specified by _tol.
       public: bool Equal(const Vector4 &_v, const T &_tol) const
       {
-        return equal<T>(this->data[0], _v[0], _tol)
-            && equal<T>(this->data[1], _v[1], _tol)
-            && equal<T>(this->data[2], _v[2], _tol)
-            && equal<T>(this->data[3], _v[3], _tol);
+        return Kernels::Equal(this->data, _v.data, _tol);
       }
 
       /// \brief Equal to operator
@@ -564,19 +489,14 @@ namespace gz
       /// \return true if finite, false otherwise
       public: bool IsFinite() const
       {
-        // std::isfinite works with floating point values,
-        // need to explicit cast to avoid ambiguity in vc++.
-        return std::isfinite(static_cast<double>(this->data[0])) &&
-               std::isfinite(static_cast<double>(this->data[1])) &&
-               std::isfinite(static_cast<double>(this->data[2])) &&
-               std::isfinite(static_cast<double>(this->data[3]));
+        return Kernels::IsFinite(this->data);
       }
 
       /// \brief Array subscript operator
       /// \param[in] _index The index, where 0 == x, 1 == y, 2 == z, 3 == w.
       /// The index is clamped to the range (0,3).
       /// \return The value.
-      public: T &operator[](const std::size_t _index)
+      public: constexpr T &operator[](const std::size_t _index)
       {
         return this->data[clamp(_index, GZ_ZERO_SIZE_T, GZ_THREE_SIZE_T)];
       }
@@ -585,91 +505,91 @@ namespace gz
       /// \param[in] _index The index, where 0 == x, 1 == y, 2 == z, 3 == w.
       /// The index is clamped to the range (0,3).
       /// \return The value.
-      public: T operator[](const std::size_t _index) const
+      public: constexpr T operator[](const std::size_t _index) const
       {
         return this->data[clamp(_index, GZ_ZERO_SIZE_T, GZ_THREE_SIZE_T)];
       }
 
       /// \brief Return a mutable x value.
       /// \return The x component of the vector
-      public: T &X()
+      public: constexpr T &X()
       {
         return this->data[0];
       }
 
       /// \brief Return a mutable y value.
       /// \return The y component of the vector
-      public: T &Y()
+      public: constexpr T &Y()
       {
         return this->data[1];
       }
 
       /// \brief Return a mutable z value.
       /// \return The z component of the vector
-      public: T &Z()
+      public: constexpr T &Z()
       {
         return this->data[2];
       }
 
       /// \brief Return a mutable w value.
       /// \return The w component of the vector
-      public: T &W()
+      public: constexpr T &W()
       {
         return this->data[3];
       }
 
       /// \brief Get the x value.
       /// \return The x component of the vector
-      public: T X() const
+      public: constexpr T X() const
       {
         return this->data[0];
       }
 
       /// \brief Get the y value.
       /// \return The y component of the vector
-      public: T Y() const
+      public: constexpr T Y() const
       {
         return this->data[1];
       }
 
       /// \brief Get the z value.
       /// \return The z component of the vector
-      public: T Z() const
+      public: constexpr T Z() const
       {
         return this->data[2];
       }
 
       /// \brief Get the w value.
       /// \return The w component of the vector
-      public: T W() const
+      public: constexpr T W() const
       {
         return this->data[3];
       }
 
       /// \brief Set the x value.
       /// \param[in] _v Value for the x component.
-      public: inline void X(const T &_v)
+      public: constexpr void X(const T &_v)
       {
         this->data[0] = _v;
       }
 
       /// \brief Set the y value.
       /// \param[in] _v Value for the y component.
-      public: inline void Y(const T &_v)
+      public: constexpr void Y(const T &_v)
       {
         this->data[1] = _v;
       }
 
       /// \brief Set the z value.
       /// \param[in] _v Value for the z component.
-      public: inline void Z(const T &_v)
+      public: constexpr void Z(const T &_v)
       {
         this->data[2] = _v;
       }
 
       /// \brief Set the w value.
       /// \param[in] _v Value for the w component.
-      public: inline void W(const T &_v)
+      public: constexpr void W(const T &_v)
       {
         this->data[3] = _v;
       }
@@ -678,7 +598,7 @@ namespace gz
       /// \param[in] _pt Vector to compare.
       /// \return True if this vector's X(), Y(), Z() or W() value is less
       /// than the given vector's corresponding values.
-      public: bool operator<(const Vector4<T> &_pt) const
+      public: constexpr bool operator<(const Vector4<T> &_pt) const
       {
         return this->data[0] < _pt[0] || this->data[1] < _pt[1] ||
                this->data[2] < _pt[2] || this->data[3] < _pt[3];
@@ -701,6 +621,25 @@ namespace gz
         return _out;
       }
 
+      /// \brief Append the vector to a string, in the format of operator<<
+      /// but with std::to_chars, which is faster than a stream.
+      /// \param[in, out] _out The string
+      /// \param[in] _pt Vector to append
+      /// \param[in] _precision Number of digits after the decimal point, or
+      /// a negative value for the shortest representation that reads back as
+      /// the same number
+      public: friend void appendToString(std::string &_out,
+                  const Vector4<T> &_pt, int _precision = -1)
+      {
+        for (auto i : {0, 1, 2, 3})
+        {
+          if (i > 0)
+            _out += ' ';
+
+          appendToString(_out, _pt[i], _precision);
+        }
+      }
+
       /// \brief Stream extraction operator
       /// \param[in] _in input stream
       /// \param[in] _pt Vector4 to read values into
@@ -720,6 +659,9 @@ namespace gz
         return _in;
       }
 
+      /// \brief Per component kernels shared with Vector2 and Vector3.
+      private: using Kernels = detail::VectorN<T, 4>;
+
       /// \brief Data values, 0==x, 1==y, 2==z, 3==w
       private: T data[4];
     };
@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_VECTORHASH_HH_
+#define GZ_MATH_VECTORHASH_HH_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+#include <gz/math/Vector2.hh>
+#include <gz/math/Vector3.hh>
+#include <gz/math/Vector4.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Number of components of the vector types.
+      template<typename V> struct VectorSize;
+      template<typename T> struct VectorSize<Vector2<T>>
+      {
+        using Scalar = T;
+        static constexpr std::size_t kValue = 2;
+      };
+      template<typename T> struct VectorSize<Vector3<T>>
+      {
+        using Scalar = T;
+        static constexpr std::size_t kValue = 3;
+      };
+      template<typename T> struct VectorSize<Vector4<T>>
+      {
+        using Scalar = T;
+        static constexpr std::size_t kValue = 4;
+      };
+
+      /// \brief Finalizer of splitmix64, every bit of the result depends
+      /// on every bit of the value.
+      /// \param[in] _value Value to mix.
+      /// \return Mixed value.
+      constexpr std::uint64_t HashMix(std::uint64_t _value)
+      {
+        _value ^= _value >> 30;
+        _value *= 0xbf58476d1ce4e5b9ULL;
+        _value ^= _value >> 27;
+        _value *= 0x94d049bb133111ebULL;
+        return _value ^ (_value >> 31);
+      }
+
+      /// \brief Add a value to a hash.
+      /// \param[in] _hash Hash of the previous values.
+      /// \param[in] _value Value to add.
+      /// \return Hash of the previous values and _value.
+      constexpr std::uint64_t HashCombine(const std::uint64_t _hash,
+                                          const std::uint64_t _value)
+      {
+        return HashMix(_hash + 0x9e3779b97f4a7c15ULL + _value);
+      }
+
+      /// \brief Get the bits a component is hashed and compared with. For
+      /// floating point values, -0 and 0 have the same bits, and so do all
+      /// the NaNs.
+      /// \param[in] _value The component.
+      /// \return Its bits.
+      template<typename T>
+      std::uint64_t HashBits(const T _value)
+      {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+          if (std::isnan(_value))
+            return 0x7ff8000000000000ULL;
+          // Widen, so that float and double vectors of the same values
+          // have the same hash, and add 0 to turn -0 into 0.
+          const double value = static_cast<double>(_value) + 0.0;
+          std::uint64_t bits;
+          std::memcpy(&bits, &value, sizeof(bits));
+          return bits;
+        }
+        else
+        {
+          return static_cast<std::uint64_t>(_value);
+        }
+      }
+
+      /// \brief Get the index of the cell of a value, floor(_value /
+      /// _cellSize), clamped to the range of std::int64_t. NaN is in cell 0.
+      /// \param[in] _value The value.
+      /// \param[in] _cellSize Size of the cells.
+      /// \return Index of the cell.
+      template<typename T>
+      std::int64_t CellIndex(const T _value, const T _cellSize)
+      {
+        const double cell = std::floor(static_cast<double>(_value) /
+                                       static_cast<double>(_cellSize));
+        if (std::isnan(cell))
+          return 0;
+        // 2^63 is the first double past the range of std::int64_t
+        if (cell >= 9223372036854775808.0)
+          return std::numeric_limits<std::int64_t>::max();
+        if (cell < -9223372036854775808.0)
+          return std::numeric_limits<std::int64_t>::min();
+        return static_cast<std::int64_t>(cell);
+      }
+    }
+
+    /// \class VectorHash VectorHash.hh gz/math/VectorHash.hh
+    /// \brief Hash function of Vector2, Vector3 and Vector4, to use them as
+    /// keys of std::unordered_map and std::unordered_set.
+    ///
+    /// The components are mixed with the splitmix64 finalizer, so nearby
+    /// vectors, such as the cells of a grid, spread over all the buckets.
+    ///
+    /// For integer vectors, std::hash is specialized with this function,
+    /// see below. Floating point vectors compare equal with a tolerance,
+    /// which no hash function can match, so they have no std::hash: use
+    /// VectorHash with VectorEqual, which compares the exact values, or
+    /// VectorCellHash with VectorCellEqual, which compares the cells of a
+    /// grid the values are in.
+    ///
+    /// # Example usage
+    ///
+    /// ```{.cpp}
+    /// std::unordered_map<gz::math::Vector3d, int,
+    ///     gz::math::VectorHash<gz::math::Vector3d>,
+    ///     gz::math::VectorEqual<gz::math::Vector3d>> ids;
+    /// ```
+    /// \tparam V Type of the vectors, such as Vector3d.
+    template<typename V>
+    struct VectorHash
+    {
+      /// \brief Hash a vector.
+      /// \param[in] _v The vector.
+      /// \return Its hash.
+      std::size_t operator()(const V &_v) const
+      {
+        std::uint64_t hash = detail::VectorSize<V>::kValue;
+        for (std::size_t i = 0; i < detail::VectorSize<V>::kValue; ++i)
+          hash = detail::HashCombine(hash, detail::HashBits(_v[i]));
+        return static_cast<std::size_t>(hash);
+      }
+    };
+
+    /// \class VectorEqual VectorHash.hh gz/math/VectorHash.hh
+    /// \brief Exact comparison of vectors, consistent with VectorHash.
+    /// Unlike operator==, there is no tolerance. -0 equals 0, and NaN
+    /// equals NaN, so that a vector with NaN components can be found in a
+    /// map.
+    /// \tparam V Type of the vectors, such as Vector3d.
+    template<typename V>
+    struct VectorEqual
+    {
+      /// \brief Compare two vectors.
+      /// \param[in] _a The first vector.
+      /// \param[in] _b The second vector.
+      /// \return True if every component of _a equals that of _b.
+      bool operator()(const V &_a, const V &_b) const
+      {
+        for (std::size_t i = 0; i < detail::VectorSize<V>::kValue; ++i)
+        {
+          if (detail::HashBits(_a[i]) != detail::HashBits(_b[i]))
+            return false;
+        }
+        return true;
+      }
+    };
+
+    /// \class VectorCellHash VectorHash.hh gz/math/VectorHash.hh
+    /// \brief Hash function of the cell of a grid a vector is in, for maps
+    /// whose keys are positions known up to the size of a cell. The cell
+    /// of a value x is floor(x / cell size).
+    ///
+    /// Use it with a VectorCellEqual of the same cell size:
+    ///
+    /// ```{.cpp}
+    /// using Vector3d = gz::math::Vector3d;
+    /// std::unordered_map<Vector3d, int,
+    ///     gz::math::VectorCellHash<Vector3d>,
+    ///     gz::math::VectorCellEqual<Vector3d>> cells(16,
+    ///     gz::math::VectorCellHash<Vector3d>(0.1),
+    ///     gz::math::VectorCellEqual<Vector3d>(0.1));
+    /// ```
+    /// \tparam V Type of the vectors, such as Vector3d.
+    template<typename V>
+    class VectorCellHash
+    {
+      /// \brief Type of the components of the vectors.
+      public: using Scalar = typename detail::VectorSize<V>::Scalar;
+
+      /// \brief Constructor.
+      /// \param[in] _cellSize Size of the cells, which must be positive.
+      public: explicit VectorCellHash(const Scalar _cellSize = 1)
+        : cellSize(_cellSize)
+      {
+      }
+
+      /// \brief Get the size of the cells.
+      /// \return Size of the cells.
+      public: Scalar CellSize() const
+      {
+        return this->cellSize;
+      }
+
+      /// \brief Hash the cell of a vector.
+      /// \param[in] _v The vector.
+      /// \return Hash of its cell.
+      public: std::size_t operator()(const V &_v) const
+      {
+        std::uint64_t hash = detail::VectorSize<V>::kValue;
+        for (std::size_t i = 0; i < detail::VectorSize<V>::kValue; ++i)
+        {
+          hash = detail::HashCombine(hash, static_cast<std::uint64_t>(
+              detail::CellIndex(_v[i], this->cellSize)));
+        }
+        return static_cast<std::size_t>(hash);
+      }
+
+      /// \brief Size of the cells.
+      private: Scalar cellSize;
+    };
+
+    /// \class VectorCellEqual VectorHash.hh gz/math/VectorHash.hh
+    /// \brief Comparison of the cells of a grid vectors are in, consistent
+    /// with VectorCellHash.
+    /// \tparam V Type of the vectors, such as Vector3d.
+    template<typename V>
+    class VectorCellEqual
+    {
+      /// \brief Type of the components of the vectors.
+      public: using Scalar = typename detail::VectorSize<V>::Scalar;
+
+      /// \brief Constructor.
+      /// \param[in] _cellSize Size of the cells, which must be positive.
+      public: explicit VectorCellEqual(const Scalar _cellSize = 1)
+        : cellSize(_cellSize)
+      {
+      }
+
+      /// \brief Get the size of the cells.
+      /// \return Size of the cells.
+      public: Scalar CellSize() const
+      {
+        return this->cellSize;
+      }
+
+      /// \brief Compare the cells of two vectors.
+      /// \param[in] _a The first vector.
+      /// \param[in] _b The second vector.
+      /// \return True if _a and _b are in the same cell.
+      public: bool operator()(const V &_a, const V &_b) const
+      {
+        for (std::size_t i = 0; i < detail::VectorSize<V>::kValue; ++i)
+        {
+          if (detail::CellIndex(_a[i], this->cellSize) !=
+              detail::CellIndex(_b[i], this->cellSize))
+          {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      /// \brief Size of the cells.
+      private: Scalar cellSize;
+    };
+    }
+  }
+}
+
+namespace std
+{
+  /// \brief Hash of Vector2i, whose operator== is exact.
+  template<>
+  struct hash<gz::math::Vector2i>
+    : gz::math::VectorHash<gz::math::Vector2i>
+  {
+  };
+
+  /// \brief Hash of Vector3i, whose operator== is exact.
+  template<>
+  struct hash<gz::math::Vector3i>
+    : gz::math::VectorHash<gz::math::Vector3i>
+  {
+  };
+
+  /// \brief Hash of Vector4i, whose operator== is exact.
+  template<>
+  struct hash<gz::math::Vector4i>
+    : gz::math::VectorHash<gz::math::Vector4i>
+  {
+  };
+}
+#endif
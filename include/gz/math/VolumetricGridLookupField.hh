@@ -18,14 +18,29 @@
 #ifndef GZ_MATH_VOLUMETRIC_GRID_LOOKUP_FIELD_HH_
 #define GZ_MATH_VOLUMETRIC_GRID_LOOKUP_FIELD_HH_
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
 #include <optional>
+#include <ostream>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include <gz/math/Profiler.hh>
+#include <gz/math/QuantizedValues.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/math/detail/InterpolationPoint.hh>
 
 #include <gz/math/detail/AxisIndex.hh>
+#include <gz/math/detail/ParallelFor.hh>
+
+#include <gz/utils/SuppressWarning.hh>
 
 namespace gz
 {
@@ -33,11 +48,31 @@ namespace gz
   {
     // Inline bracket to help doxygen filtering.
     inline namespace GZ_MATH_VERSION_NAMESPACE {
+      /// \brief Remembers where the previous query of a caller fell in a
+      /// VolumetricGridLookupField, so that a query close to it skips the
+      /// search along each axis. A cursor is valid with any field, but it is
+      /// only useful when successive queries use the same field. It must not
+      /// be shared between threads.
+      struct VolumetricGridCursor
+      {
+        /// \brief Search hint along the x axis.
+        std::size_t x{0};
+
+        /// \brief Search hint along the y axis.
+        std::size_t y{0};
+
+        /// \brief Search hint along the z axis.
+        std::size_t z{0};
+      };
+
       template<typename T, typename I = std::size_t>
       /// \brief Lookup table for a volumetric dataset. This class is used to
       /// lookup indices for a large dataset that's organized in a grid. This
       /// class is not meant to be used with non-grid like data sets. The grid
-      /// may be sparse or non uniform and missing data points.
+      /// may be sparse or non uniform and missing data points. Const member
+      /// functions don't modify the field, so they may be called
+      /// concurrently from several threads, each with its own
+      /// VolumetricGridCursor.
       class VolumetricGridLookupField
       {
         /// Get the index along the given axis
@@ -47,39 +82,243 @@ namespace gz
 
         private: AxisIndex<T> y_indices_by_lon;
 
-        private: std::vector<
-          std::vector<std::vector<std::optional<I>>>> index_table;
+        /// \brief Number of unique positions along the x axis.
+        private: std::size_t num_x{0};
 
-        /// \brief Constructor
+        /// \brief Number of unique positions along the y axis.
+        private: std::size_t num_y{0};
+
+        /// \brief Number of unique positions along the z axis.
+        private: std::size_t num_z{0};
+
+        /// \brief Marks grid points without data in the index table.
+        private: static constexpr I kNoIndex = std::numeric_limits<I>::max();
+
+        /// \brief Index of each grid point, kNoIndex where the grid has no
+        /// data. Stored row-major in one contiguous buffer, see CellIndex().
+        /// Shared by copies of the field, since it is not modified once
+        /// built. Null if the field was loaded in place, see Load().
+        private: std::shared_ptr<const std::vector<I>> index_table;
+
+        /// \brief Added to every index of the table, see WithIndexOffset().
+        private: I index_offset{0};
+
+        /// \brief Index table of a field loaded in place, nullptr otherwise.
+        private: const I *mapped_table{nullptr};
+
+        /// \brief Values stored alongside a field loaded in place.
+        private: const void *mapped_values{nullptr};
+
+        /// \brief Number of values pointed to by mapped_values.
+        private: std::size_t num_mapped_values{0};
+
+        /// \brief Size in bytes of each value pointed to by mapped_values.
+        private: std::size_t mapped_value_size{0};
+
+        /// \brief Get the index table.
+        /// \return Pointer to the first entry of the index table.
+        private: const I *Table() const
+        {
+          if (this->mapped_table)
+            return this->mapped_table;
+          return this->index_table ? this->index_table->data() : nullptr;
+        }
+
+        /// \brief Get the number of entries in the index table.
+        /// \return Number of grid points.
+        private: std::size_t TableSize() const
+        {
+          return this->num_x * this->num_y * this->num_z;
+        }
+
+        /// \brief Get the offset of a grid point in index_table.
+        /// \param[in] _x Index along the x axis.
+        /// \param[in] _y Index along the y axis.
+        /// \param[in] _z Index along the z axis.
+        /// \return The offset, x varies the fastest.
+        private: std::size_t CellIndex(
+          const std::size_t _x,
+          const std::size_t _y,
+          const std::size_t _z) const
+        {
+          return (_z * this->num_y + _y) * this->num_x + _x;
+        }
+
+        /// \brief Batches smaller than this are processed in input order on
+        /// the calling thread. Also the minimum number of points per thread.
+        private: static constexpr std::size_t kBatchSortThreshold = 1024;
+
+        /// \brief Batches are only reordered for locality when the index
+        /// table is at least this large.
+        private: static constexpr std::size_t kBatchSortTableBytes = 1 << 22;
+
+        /// \brief Header of the binary format written by Save(). All fields
+        /// are in native byte order.
+        private: struct FileHeader
+        {
+          /// \brief Identifies the format, see kFileMagic.
+          char magic[8];
+
+          /// \brief kFileByteOrder as written by the saving machine.
+          std::uint32_t byteOrder;
+
+          /// \brief Version of the format, see kFileVersion.
+          std::uint32_t version;
+
+          /// \brief sizeof(T) of the saved field.
+          std::uint32_t keySize;
+
+          /// \brief sizeof(I) of the saved field.
+          std::uint32_t indexSize;
+
+          /// \brief Size of each saved value, zero if there are none.
+          std::uint32_t valueSize;
+
+          /// \brief Unused, written as zero.
+          std::uint32_t reserved;
+
+          /// \brief Number of positions along each axis.
+          std::uint64_t numX;
+          std::uint64_t numY;
+          std::uint64_t numZ;
+
+          /// \brief Number of saved values.
+          std::uint64_t numValues;
+        };
+        static_assert(sizeof(FileHeader) == 64, "Unexpected header padding");
+
+        /// \brief First bytes of the binary format.
+        private: static constexpr char kFileMagic[8] =
+          {'G', 'Z', 'V', 'G', 'R', 'I', 'D', '\0'};
+
+        /// \brief Written in native order to detect byte order mismatches.
+        private: static constexpr std::uint32_t kFileByteOrder = 0x01020304;
+
+        /// \brief Current version of the binary format.
+        private: static constexpr std::uint32_t kFileVersion = 1;
+
+        /// \brief Every section of the binary format starts at a multiple of
+        /// this offset.
+        private: static constexpr std::size_t kFileAlignment = 16;
+
+        /// \brief Round a section size up to kFileAlignment.
+        /// \param[in] _size Size in bytes.
+        /// \return The padded size.
+        private: static std::size_t Padded(const std::size_t _size)
+        {
+          return (_size + kFileAlignment - 1) / kFileAlignment * kFileAlignment;
+        }
+
+        /// \brief Write the field in the binary format.
+        /// \param[out] _out Stream to write to.
+        /// \param[in] _values Values to store with the field, may be nullptr.
+        /// \param[in] _numValues Number of values.
+        /// \param[in] _valueSize Size in bytes of each value.
+        /// \return True if the stream is still good after writing.
+        private: bool SaveImpl(
+          std::ostream &_out,
+          const void *_values,
+          const std::size_t _numValues,
+          const std::size_t _valueSize) const
+        {
+          FileHeader header{};
+          std::memcpy(header.magic, kFileMagic, sizeof(header.magic));
+          header.byteOrder = kFileByteOrder;
+          header.version = kFileVersion;
+          header.keySize = sizeof(T);
+          header.indexSize = sizeof(I);
+          header.valueSize = static_cast<std::uint32_t>(
+            _numValues > 0 ? _valueSize : 0);
+          header.numX = this->num_x;
+          header.numY = this->num_y;
+          header.numZ = this->num_z;
+          header.numValues = _numValues;
+
+          const char padding[kFileAlignment] = {};
+          auto write = [&](const void *_data, const std::size_t _size)
+          {
+            _out.write(static_cast<const char *>(_data),
+              static_cast<std::streamsize>(_size));
+            _out.write(padding,
+              static_cast<std::streamsize>(Padded(_size) - _size));
+          };
+
+          write(&header, sizeof(header));
+          for (const auto *axis :
+            {&x_indices_by_lat, &y_indices_by_lon, &z_indices_by_depth})
+          {
+            const std::vector<T> keys = axis->GetKeysByIndex();
+            write(keys.data(), keys.size() * sizeof(T));
+          }
+          if (this->index_offset == 0)
+          {
+            write(this->Table(), this->TableSize() * sizeof(I));
+          }
+          else
+          {
+            std::vector<I> table(this->Table(),
+              this->Table() + this->TableSize());
+            for (I &index : table)
+            {
+              if (index != kNoIndex)
+                index += this->index_offset;
+            }
+            write(table.data(), table.size() * sizeof(I));
+          }
+          write(_values, _numValues * header.valueSize);
+          return _out.good();
+        }
+
+        /// \brief Get a key that orders points by the part of the grid they
+        /// fall in, assuming roughly even spacing.
+        /// \param[in] _pt The point.
+        /// \return The key.
+        private: std::size_t CellKey(const Vector3<T> &_pt) const
+        {
+          auto cell = [](const AxisIndex<T> &_axis, const T _value)
+          {
+            const std::size_t n = _axis.GetNumUniqueIndices();
+            const T range = _axis.MaxKey() - _axis.MinKey();
+            if (n < 2 || !(range > 0))
+              return std::size_t{0};
+            const T c = (_value - _axis.MinKey()) / range *
+              static_cast<T>(n - 1);
+            if (!(c > 0))
+              return std::size_t{0};
+            return std::min(static_cast<std::size_t>(c), n - 1);
+          };
+          return this->CellIndex(
+            cell(x_indices_by_lat, _pt.X()),
+            cell(y_indices_by_lon, _pt.Y()),
+            cell(z_indices_by_depth, _pt.Z()));
+        }
+
+        /// \brief Build the axis indices and the index table.
         /// \param[in] _cloud The cloud of points to use to construct the grid.
-        public: VolumetricGridLookupField(
-          const std::vector<Vector3<T>> &_cloud)
+        /// \param[in] _index Function returning the index stored for the
+        /// i-th point of _cloud.
+        private: template<typename F>
+        void BuildIndexTable(
+          const std::vector<Vector3<T>> &_cloud,
+          const F &_index)
         {
           // NOTE: This part of the code assumes an exact grid of points.
           // The grid may be distorted or the stride between different points
-          // may not be the same, but fundamentally the data is structured still
-          // forms a grid-like structure. It keeps track of the axis indices for
+          // may not be the same, but fundamentally the data is structured in
+          // a grid-like structure. It keeps track of the axis indices for
           // each point in the grid.
-          for(auto pt : _cloud)
+          for(const auto &pt : _cloud)
           {
             x_indices_by_lat.AddIndexIfNotFound(pt.X());
             y_indices_by_lon.AddIndexIfNotFound(pt.Y());
             z_indices_by_depth.AddIndexIfNotFound(pt.Z());
           }
 
-          int num_x = x_indices_by_lat.GetNumUniqueIndices();
-          int num_y = y_indices_by_lon.GetNumUniqueIndices();
-          int num_z = z_indices_by_depth.GetNumUniqueIndices();
+          this->num_x = x_indices_by_lat.GetNumUniqueIndices();
+          this->num_y = y_indices_by_lon.GetNumUniqueIndices();
+          this->num_z = z_indices_by_depth.GetNumUniqueIndices();
 
-          index_table.resize(num_z);
-          for(int i = 0; i < num_z; ++i)
-          {
-            index_table[i].resize(num_y);
-            for(int j = 0; j < num_y; ++j)
-            {
-              index_table[i][j].resize(num_x);
-            }
-          }
+          std::vector<I> table(this->TableSize(), kNoIndex);
 
           for(std::size_t i = 0; i < _cloud.size(); ++i)
           {
@@ -90,8 +329,194 @@ namespace gz
               y_indices_by_lon.GetIndex(pt.Y()).value();
             const std::size_t z_index =
               z_indices_by_depth.GetIndex(pt.Z()).value();
-            index_table[z_index][y_index][x_index] = i;
+            table[this->CellIndex(x_index, y_index, z_index)] =
+              static_cast<I>(_index(i));
+          }
+          this->index_table =
+            std::make_shared<const std::vector<I>>(std::move(table));
+        }
+
+        /// \brief Default constructor, creates an empty field. Use Load() to
+        /// fill it.
+        public: VolumetricGridLookupField() = default;
+
+        /// \brief Minimum number of points per thread when building the
+        /// field in parallel.
+        private: static constexpr std::size_t kBuildChunkSize = 1 << 16;
+
+        /// \brief Build the same axis indices and index table as
+        /// BuildIndexTable using several threads. The unique positions of
+        /// each chunk of points are found in parallel and merged with a
+        /// sort, and the index of each position is the rank of its first
+        /// occurrence.
+        /// \param[in] _cloud The cloud of points to use to construct the grid.
+        /// \param[in] _index Function returning the index stored for the
+        /// i-th point of _cloud. It must be safe to call concurrently.
+        /// \param[in] _threads Number of threads.
+        private: template<typename F>
+        void BuildIndexTableParallel(
+          const std::vector<Vector3<T>> &_cloud,
+          const F &_index,
+          const std::size_t _threads)
+        {
+          // Unique positions along each axis with their first occurrence.
+          // Each chunk registers its points in a local axis, so the order of
+          // registration is the order of first occurrence in the chunk.
+          using Occurrence = std::pair<T, std::size_t>;
+          std::vector<std::array<std::vector<Occurrence>, 3>> partial(
+            _threads);
+          detail::ParallelFor(_cloud.size(), _threads,
+            [&](const std::size_t _chunk, const std::size_t _begin,
+                const std::size_t _end)
+            {
+              for (std::size_t axis = 0; axis < 3; ++axis)
+              {
+                AxisIndex<T> local;
+                std::vector<std::size_t> first;
+                for (std::size_t i = _begin; i < _end; ++i)
+                {
+                  local.AddIndexIfNotFound(_cloud[i][axis]);
+                  if (local.GetNumUniqueIndices() > first.size())
+                    first.push_back(i);
+                }
+                const std::vector<T> keys = local.GetKeysByIndex();
+                auto &occurrences = partial[_chunk][axis];
+                for (std::size_t k = 0; k < keys.size(); ++k)
+                  occurrences.emplace_back(keys[k], first[k]);
+              }
+            });
+
+          // One axis per thread
+          AxisIndex<T> *axes[3] =
+            {&x_indices_by_lat, &y_indices_by_lon, &z_indices_by_depth};
+          detail::ParallelFor(3, 3,
+            [&](std::size_t, const std::size_t _axis, std::size_t)
+            {
+              // Sorting by position then occurrence keeps the first
+              // occurrence of each position
+              std::vector<Occurrence> unique;
+              for (const auto &chunk : partial)
+              {
+                unique.insert(unique.end(),
+                  chunk[_axis].begin(), chunk[_axis].end());
+              }
+              std::sort(unique.begin(), unique.end());
+              unique.erase(std::unique(unique.begin(), unique.end(),
+                [](const Occurrence &_a, const Occurrence &_b)
+                {
+                  GZ_UTILS_WARN_IGNORE__FLOAT_EQUAL
+                  return _a.first == _b.first;
+                  GZ_UTILS_WARN_RESUME__FLOAT_EQUAL
+                }), unique.end());
+
+              // Positions are indexed in order of first occurrence
+              std::vector<std::size_t> order(unique.size());
+              for (std::size_t i = 0; i < order.size(); ++i)
+                order[i] = i;
+              std::sort(order.begin(), order.end(),
+                [&unique](const std::size_t _a, const std::size_t _b)
+                {
+                  return unique[_a].second < unique[_b].second;
+                });
+              std::vector<std::size_t> indices(unique.size());
+              for (std::size_t rank = 0; rank < order.size(); ++rank)
+                indices[order[rank]] = rank;
+
+              std::vector<T> keys(unique.size());
+              for (std::size_t i = 0; i < unique.size(); ++i)
+                keys[i] = unique[i].first;
+              axes[_axis]->AssignSorted(std::move(keys), std::move(indices));
+            });
+
+          this->num_x = x_indices_by_lat.GetNumUniqueIndices();
+          this->num_y = y_indices_by_lon.GetNumUniqueIndices();
+          this->num_z = z_indices_by_depth.GetNumUniqueIndices();
+
+          // Each thread owns a range of the table. The points are counted
+          // per chunk of points and range of the table, so that they can be
+          // bucketed by range while keeping their order.
+          const std::size_t tableSize = this->TableSize();
+          const std::size_t rangeSize = (tableSize + _threads - 1) / _threads;
+          std::vector<std::size_t> cells(_cloud.size());
+          std::vector<std::size_t> counts(_threads * _threads, 0);
+          detail::ParallelFor(_cloud.size(), _threads,
+            [&](const std::size_t _chunk, const std::size_t _begin,
+                const std::size_t _end)
+            {
+              std::size_t *chunkCounts = counts.data() + _chunk * _threads;
+              for (std::size_t i = _begin; i < _end; ++i)
+              {
+                const auto &pt = _cloud[i];
+                cells[i] = this->CellIndex(
+                  x_indices_by_lat.GetIndex(pt.X()).value(),
+                  y_indices_by_lon.GetIndex(pt.Y()).value(),
+                  z_indices_by_depth.GetIndex(pt.Z()).value());
+                chunkCounts[cells[i] / rangeSize]++;
+              }
+            });
+
+          // Buckets are ordered by range then chunk of points
+          std::vector<std::size_t> offsets(_threads * _threads);
+          std::vector<std::size_t> rangeBegin(_threads + 1, 0);
+          std::size_t total = 0;
+          for (std::size_t r = 0; r < _threads; ++r)
+          {
+            rangeBegin[r] = total;
+            for (std::size_t c = 0; c < _threads; ++c)
+            {
+              offsets[c * _threads + r] = total;
+              total += counts[c * _threads + r];
+            }
+          }
+          rangeBegin[_threads] = total;
+
+          std::vector<std::size_t> buckets(_cloud.size());
+          detail::ParallelFor(_cloud.size(), _threads,
+            [&](const std::size_t _chunk, const std::size_t _begin,
+                const std::size_t _end)
+            {
+              std::size_t *chunkOffsets = offsets.data() + _chunk * _threads;
+              for (std::size_t i = _begin; i < _end; ++i)
+                buckets[chunkOffsets[cells[i] / rangeSize]++] = i;
+            });
+
+          // Each range visits its points in order, so the last of several
+          // points in a cell wins as in BuildIndexTable
+          std::vector<I> table(tableSize);
+          detail::ParallelFor(tableSize, _threads,
+            [&](const std::size_t _range, const std::size_t _begin,
+                const std::size_t _end)
+            {
+              std::fill(table.begin() + _begin, table.begin() + _end,
+                kNoIndex);
+              for (std::size_t b = rangeBegin[_range];
+                   b < rangeBegin[_range + 1]; ++b)
+              {
+                const std::size_t i = buckets[b];
+                table[cells[i]] = static_cast<I>(_index(i));
+              }
+            });
+          this->index_table =
+            std::make_shared<const std::vector<I>>(std::move(table));
+        }
+
+        /// \brief Constructor
+        /// \param[in] _cloud The cloud of points to use to construct the grid.
+        /// The field is left empty if the index of a point does not fit in
+        /// I, which keeps its largest value to mark missing points.
+        public: VolumetricGridLookupField(
+          const std::vector<Vector3<T>> &_cloud)
+        {
+          if (!_cloud.empty() &&
+              _cloud.size() - 1 >= static_cast<std::size_t>(kNoIndex))
+          {
+            std::cerr << "VolumetricGridLookupField: the indices of ["
+                      << _cloud.size() << "] points don't fit the index type"
+                      << std::endl;
+            return;
           }
+          this->BuildIndexTable(_cloud,
+            [](const std::size_t _i) { return static_cast<I>(_i); });
         }
 
         /// \brief Retrieves the indices of the points that are to be used for
@@ -114,80 +539,162 @@ namespace gz
             const double _yTol = 1e-6,
             const double _zTol = 1e-6) const
         {
-          std::vector<InterpolationPoint3D<T>> interpolators;
+          InterpolationPoints3D<T> interpolators;
+          this->GetInterpolators(_pt, interpolators, _xTol, _yTol, _zTol);
+          return std::vector<InterpolationPoint3D<T>>(
+            interpolators.points.begin(),
+            interpolators.points.begin() + interpolators.count);
+        }
+
+        /// \brief Retrieves the indices of the points that are to be used for
+        /// interpolation without allocating. See
+        /// GetInterpolators(const Vector3<T> &, double, double, double).
+        /// \param[in] _pt The point to get the interpolators for.
+        /// \param[out] _interpolators The points which are to be used for
+        /// interpolation, in the same order as the std::vector overload.
+        /// \param[in] _xTol The tolerance for the x axis.
+        /// \param[in] _yTol The tolerance for the y axis.
+        /// \param[in] _zTol The tolerance for the z axis.
+        public: void GetInterpolators(
+            const Vector3<T> &_pt,
+            InterpolationPoints3D<T> &_interpolators,
+            const double _xTol = 1e-6,
+            const double _yTol = 1e-6,
+            const double _zTol = 1e-6) const
+        {
+          GZ_MATH_PROFILE_ZONE("VolumetricGridLookupField::GetInterpolators");
+          std::array<InterpolationPoint1D<T>, 2> x_indices;
+          std::array<InterpolationPoint1D<T>, 2> y_indices;
+          std::array<InterpolationPoint1D<T>, 2> z_indices;
+          const std::size_t num_x_indices =
+            x_indices_by_lat.GetInterpolators(_pt.X(), x_indices, _xTol);
+          const std::size_t num_y_indices =
+            y_indices_by_lon.GetInterpolators(_pt.Y(), y_indices, _yTol);
+          const std::size_t num_z_indices =
+            z_indices_by_depth.GetInterpolators(_pt.Z(), z_indices, _zTol);
+          this->CombineInterpolators(x_indices, num_x_indices,
+            y_indices, num_y_indices, z_indices, num_z_indices,
+            _interpolators);
+        }
+
+        /// \brief Retrieves the indices of the points that are to be used for
+        /// interpolation, starting the search along each axis from where the
+        /// previous query with the same cursor fell. This is constant time
+        /// when successive points are close to each other. See
+        /// GetInterpolators(const Vector3<T> &, double, double, double).
+        /// \param[in] _pt The point to get the interpolators for.
+        /// \param[out] _interpolators The points which are to be used for
+        /// interpolation, in the same order as the std::vector overload.
+        /// \param[in,out] _cursor The previous query of the caller, updated
+        /// for the next one. A default constructed cursor is valid.
+        /// \param[in] _xTol The tolerance for the x axis.
+        /// \param[in] _yTol The tolerance for the y axis.
+        /// \param[in] _zTol The tolerance for the z axis.
+        public: void GetInterpolators(
+            const Vector3<T> &_pt,
+            InterpolationPoints3D<T> &_interpolators,
+            VolumetricGridCursor &_cursor,
+            const double _xTol = 1e-6,
+            const double _yTol = 1e-6,
+            const double _zTol = 1e-6) const
+        {
+          GZ_MATH_PROFILE_ZONE("VolumetricGridLookupField::GetInterpolators");
+          std::array<InterpolationPoint1D<T>, 2> x_indices;
+          std::array<InterpolationPoint1D<T>, 2> y_indices;
+          std::array<InterpolationPoint1D<T>, 2> z_indices;
+          const std::size_t num_x_indices = x_indices_by_lat.GetInterpolators(
+            _pt.X(), x_indices, _cursor.x, _xTol);
+          const std::size_t num_y_indices = y_indices_by_lon.GetInterpolators(
+            _pt.Y(), y_indices, _cursor.y, _yTol);
+          const std::size_t num_z_indices = z_indices_by_depth.GetInterpolators(
+            _pt.Z(), z_indices, _cursor.z, _zTol);
+          this->CombineInterpolators(x_indices, num_x_indices,
+            y_indices, num_y_indices, z_indices, num_z_indices,
+            _interpolators);
+        }
 
-          auto x_indices = x_indices_by_lat.GetInterpolators(_pt.X(), _xTol);
-          auto y_indices = y_indices_by_lon.GetInterpolators(_pt.Y(), _yTol);
-          auto z_indices = z_indices_by_depth.GetInterpolators(_pt.Z(), _zTol);
+        /// \brief Build the interpolators of a point from the interpolators
+        /// along each axis.
+        /// \param[in] _x Interpolators along the x axis.
+        /// \param[in] _numX Number of interpolators along the x axis.
+        /// \param[in] _y Interpolators along the y axis.
+        /// \param[in] _numY Number of interpolators along the y axis.
+        /// \param[in] _z Interpolators along the z axis.
+        /// \param[in] _numZ Number of interpolators along the z axis.
+        /// \param[out] _interpolators The interpolators of the point.
+        private: void CombineInterpolators(
+            const std::array<InterpolationPoint1D<T>, 2> &_x,
+            const std::size_t _numX,
+            const std::array<InterpolationPoint1D<T>, 2> &_y,
+            const std::size_t _numY,
+            const std::array<InterpolationPoint1D<T>, 2> &_z,
+            const std::size_t _numZ,
+            InterpolationPoints3D<T> &_interpolators) const
+        {
+          _interpolators.count = 0;
 
-          for(const auto &x_index : x_indices)
+          const I *table = this->Table();
+          for(std::size_t i = 0; i < _numX; ++i)
           {
-            for(const auto &y_index : y_indices)
+            const auto &x_index = _x[i];
+            for(std::size_t j = 0; j < _numY; ++j)
             {
-              for(const auto &z_index : z_indices)
+              const auto &y_index = _y[j];
+              for(std::size_t k = 0; k < _numZ; ++k)
               {
-                auto index =
-                  index_table[z_index.index][y_index.index][x_index.index];
-                interpolators.push_back(
+                const auto &z_index = _z[k];
+                const I index = table[this->CellIndex(
+                  x_index.index, y_index.index, z_index.index)];
+                _interpolators.points[_interpolators.count++] =
                   InterpolationPoint3D<T>{
                     Vector3<T>(
                       x_index.position,
                       y_index.position,
                       z_index.position
                     ),
-                    std::optional{index}
-                  });
+                    index == kNoIndex ? std::nullopt :
+                      std::optional<std::size_t>{index + this->index_offset}
+                  };
               }
             }
           }
-
-          return interpolators;
         }
 
         /// \brief Constructor
         /// \param[in] _cloud The cloud of points to use to construct the grid.
         /// \param[in] _indices A series of indices these points correspond to.
+        /// The field is left empty if one of them is the largest value of I,
+        /// which marks missing points.
+        /// \param[in] _threads Maximum number of threads used to build the
+        /// field. Zero uses std::thread::hardware_concurrency. The field is
+        /// the same for any thread count.
         public: VolumetricGridLookupField(
           const std::vector<Vector3<T>> &_cloud,
-          const std::vector<I> &_indices)
+          const std::vector<I> &_indices,
+          const unsigned int _threads = 1)
         {
           assert(_indices.size() == _cloud.size());
-          // NOTE: This part of the code assumes an exact grid of points.
-          // The grid may be distorted or the stride between different points
-          // may not be the same, but fundamentally the data is structured in
-          // a grid-like structure. It keeps track of the axis indices for
-          // each point in the grid.
-          for(auto pt : _cloud)
+          if (std::find(_indices.begin(), _indices.end(), kNoIndex) !=
+              _indices.end())
           {
-            x_indices_by_lat.AddIndexIfNotFound(pt.X());
-            y_indices_by_lon.AddIndexIfNotFound(pt.Y());
-            z_indices_by_depth.AddIndexIfNotFound(pt.Z());
+            std::cerr << "VolumetricGridLookupField: index ["
+                      << static_cast<std::uint64_t>(kNoIndex)
+                      << "] is reserved for missing points" << std::endl;
+            return;
           }
-
-          int num_x = x_indices_by_lat.GetNumUniqueIndices();
-          int num_y = y_indices_by_lon.GetNumUniqueIndices();
-          int num_z = z_indices_by_depth.GetNumUniqueIndices();
-
-          index_table.resize(num_z);
-          for(int i = 0; i < num_z; ++i)
+          auto index = [&_indices](const std::size_t _i)
           {
-            index_table[i].resize(num_y);
-            for(int j = 0; j < num_y; ++j)
-            {
-              index_table[i][j].resize(num_x);
-            }
+            return _indices[_i];
+          };
+          const std::size_t threads =
+            detail::ChunkCount(_cloud.size(), _threads, kBuildChunkSize);
+          if (threads > 1)
+          {
+            this->BuildIndexTableParallel(_cloud, index, threads);
           }
-
-          for(std::size_t i = 0; i < _cloud.size(); ++i)
+          else
           {
-            const auto &pt = _cloud[i];
-            const std::size_t x_index =
-              x_indices_by_lat.GetIndex(pt.X()).value();
-            const std::size_t y_index =
-              y_indices_by_lon.GetIndex(pt.Y()).value();
-            const std::size_t z_index =
-              z_indices_by_depth.GetIndex(pt.Z()).value();
-            index_table[z_index][y_index][x_index] = _indices[i];
+            this->BuildIndexTable(_cloud, index);
           }
         }
 
@@ -204,7 +711,26 @@ namespace gz
           const std::vector<V> &_values,
           const V &_default = V(0)) const
         {
-          auto interpolators = GetInterpolators(_pt);
+          return this->EstimateValueUsingTrilinear(
+            _pt, _values.data(), _default);
+        }
+
+        /// \brief Estimates the values for a grid given an array of values to
+        /// interpolate. This method uses Trilinear interpolation.
+        /// \param[in] _pt The point to estimate for.
+        /// \param[in] _values Pointer to the values to interpolate, such as
+        /// the ones returned by Values().
+        /// \param[in] _default If a value is not found at a specific point then
+        /// this value will be used.
+        /// \returns The estimated value for the point.
+        public: template<typename V>
+        std::optional<V> EstimateValueUsingTrilinear(
+          const Vector3<T> &_pt,
+          const V *_values,
+          const V &_default = V(0)) const
+        {
+          InterpolationPoints3D<T> interpolators;
+          this->GetInterpolators(_pt, interpolators);
           return EstimateValueUsingTrilinear(
             interpolators,
             _pt,
@@ -212,6 +738,232 @@ namespace gz
             _default);
         }
 
+        /// \brief Estimates the values for a grid given a list of values to
+        /// interpolate. This method uses Trilinear interpolation and does
+        /// not allocate.
+        /// \param[in] _interpolators The interpolators to use, retrieved by
+        /// calling GetInterpolators(const Vector3<T> &,
+        /// InterpolationPoints3D<T> &, double, double, double).
+        /// \param[in] _pt The point to estimate for.
+        /// \param[in] _values The values to interpolate.
+        /// \param[in] _default If a value is not found at a specific point then
+        /// this value will be used.
+        /// \returns The estimated value for the point. Nullopt if we are
+        /// outside the field. Default value if in the field but no value is
+        /// in the index.
+        public: template<typename V>
+        std::optional<V> EstimateValueUsingTrilinear(
+          const InterpolationPoints3D<T> &_interpolators,
+          const Vector3<T> &_pt,
+          const std::vector<V> &_values,
+          const V &_default = V(0)) const
+        {
+          return this->EstimateValueUsingTrilinear(
+            _interpolators, _pt, _values.data(), _default);
+        }
+
+        /// \brief Estimates the values for a grid given an array of values to
+        /// interpolate. This method uses Trilinear interpolation and does
+        /// not allocate.
+        /// \param[in] _interpolators The interpolators to use, retrieved by
+        /// calling GetInterpolators(const Vector3<T> &,
+        /// InterpolationPoints3D<T> &, double, double, double).
+        /// \param[in] _pt The point to estimate for.
+        /// \param[in] _values Pointer to the values to interpolate, such as
+        /// the ones returned by Values().
+        /// \param[in] _default If a value is not found at a specific point then
+        /// this value will be used.
+        /// \returns The estimated value for the point. Nullopt if we are
+        /// outside the field. Default value if in the field but no value is
+        /// in the index.
+        public: template<typename V>
+        std::optional<V> EstimateValueUsingTrilinear(
+          const InterpolationPoints3D<T> &_interpolators,
+          const Vector3<T> &_pt,
+          const V *_values,
+          const V &_default = V(0)) const
+        {
+          return this->EstimateTrilinear(
+            _interpolators, _pt, _values, _default);
+        }
+
+        /// \brief Estimates the values for a grid given quantized values to
+        /// interpolate. This method uses Trilinear interpolation. The
+        /// estimate is within _values.MaxError() of the estimate with the
+        /// original values.
+        /// \param[in] _pt The point to estimate for.
+        /// \param[in] _values The values to interpolate.
+        /// \param[in] _default If a value is not found at a specific point then
+        /// this value will be used.
+        /// \returns The estimated value for the point.
+        public: template<typename Q, typename V>
+        std::optional<V> EstimateValueUsingTrilinear(
+          const Vector3<T> &_pt,
+          const QuantizedValues<Q, V> &_values,
+          const V &_default = V(0)) const
+        {
+          InterpolationPoints3D<T> interpolators;
+          this->GetInterpolators(_pt, interpolators);
+          return this->EstimateTrilinear(
+            interpolators, _pt, _values, _default);
+        }
+
+        /// \brief Estimates the values for a grid given quantized values to
+        /// interpolate. This method uses Trilinear interpolation and does
+        /// not allocate.
+        /// \param[in] _interpolators The interpolators to use, retrieved by
+        /// calling GetInterpolators(const Vector3<T> &,
+        /// InterpolationPoints3D<T> &, double, double, double).
+        /// \param[in] _pt The point to estimate for.
+        /// \param[in] _values The values to interpolate.
+        /// \param[in] _default If a value is not found at a specific point then
+        /// this value will be used.
+        /// \returns The estimated value for the point. Nullopt if we are
+        /// outside the field. Default value if in the field but no value is
+        /// in the index.
+        public: template<typename Q, typename V>
+        std::optional<V> EstimateValueUsingTrilinear(
+          const InterpolationPoints3D<T> &_interpolators,
+          const Vector3<T> &_pt,
+          const QuantizedValues<Q, V> &_values,
+          const V &_default = V(0)) const
+        {
+          return this->EstimateTrilinear(
+            _interpolators, _pt, _values, _default);
+        }
+
+        /// \brief Interpolate values read from any array type.
+        /// \param[in] _interpolators The interpolators to use.
+        /// \param[in] _pt The point to estimate for.
+        /// \param[in] _values A pointer to the values or any type with an
+        /// operator[] returning them.
+        /// \param[in] _default If a value is not found at a specific point then
+        /// this value will be used.
+        /// \returns The estimated value for the point.
+        private: template<typename L, typename V>
+        std::optional<V> EstimateTrilinear(
+          const InterpolationPoints3D<T> &_interpolators,
+          const Vector3<T> &_pt,
+          const L &_values,
+          const V &_default) const
+        {
+          GZ_MATH_PROFILE_ZONE(
+            "VolumetricGridLookupField::EstimateValueUsingTrilinear");
+          const auto &points = _interpolators.points;
+          switch (_interpolators.count)
+          {
+            case 1:
+              if (!points[0].index.has_value())
+              {
+                return _default;
+              }
+              return _values[points[0].index.value()];
+            case 2:
+              return LinearInterpolate(points[0], points[1],
+                _values, _pt, _default);
+            case 4:
+              return BiLinearInterpolate(
+                points.data(), _values, _pt, _default);
+            case 8:
+              return TrilinearInterpolate(
+                points.data(), _values, _pt, _default);
+            default:
+              // Outside the field
+              return std::nullopt;
+          }
+        }
+
+        /// \brief Estimates several values at once for a grid given
+        /// interleaved values to interpolate, such as the components of a
+        /// vector field. This method uses Trilinear interpolation. The
+        /// interpolation weights are computed once for all channels and
+        /// each channel gives the same result as
+        /// EstimateValueUsingTrilinear with the values of that channel.
+        /// \param[in] _pt The point to estimate for.
+        /// \param[in] _values Pointer to the values to interpolate, with the
+        /// _channels values of each index stored next to each other.
+        /// \param[in] _channels Number of values per index.
+        /// \param[out] _out Pointer to the _channels estimates. Not modified
+        /// if the point is outside the field.
+        /// \param[in] _default If a value is not found at a specific point then
+        /// this value will be used for every channel.
+        /// \returns False if we are outside the field.
+        public: template<typename X>
+        bool EstimateChannelsUsingTrilinear(
+          const Vector3<T> &_pt,
+          const X *_values,
+          const std::size_t _channels,
+          X *_out,
+          const X &_default = X(0)) const
+        {
+          InterpolationPoints3D<T> interpolators;
+          this->GetInterpolators(_pt, interpolators);
+          return this->EstimateChannelsUsingTrilinear(
+            interpolators, _pt, _values, _channels, _out, _default);
+        }
+
+        /// \brief Estimates several values at once for a grid given
+        /// interleaved values to interpolate. This method uses Trilinear
+        /// interpolation and does not allocate.
+        /// \param[in] _interpolators The interpolators to use, retrieved by
+        /// calling GetInterpolators(const Vector3<T> &,
+        /// InterpolationPoints3D<T> &, double, double, double).
+        /// \param[in] _pt The point to estimate for.
+        /// \param[in] _values Pointer to the values to interpolate, with the
+        /// _channels values of each index stored next to each other.
+        /// \param[in] _channels Number of values per index.
+        /// \param[out] _out Pointer to the _channels estimates. Not modified
+        /// if the point is outside the field.
+        /// \param[in] _default If a value is not found at a specific point then
+        /// this value will be used for every channel.
+        /// \returns False if we are outside the field.
+        public: template<typename X>
+        bool EstimateChannelsUsingTrilinear(
+          const InterpolationPoints3D<T> &_interpolators,
+          const Vector3<T> &_pt,
+          const X *_values,
+          const std::size_t _channels,
+          X *_out,
+          const X &_default = X(0)) const
+        {
+          GZ_MATH_PROFILE_ZONE(
+            "VolumetricGridLookupField::EstimateChannelsUsingTrilinear");
+          std::array<T, 8> weights;
+          if (!InterpolationWeights(_interpolators, _pt, weights))
+          {
+            // Outside the field
+            return false;
+          }
+          std::fill(_out, _out + _channels, X(0));
+          AccumulateInterpolatedChannels(_interpolators, weights, _values,
+            _channels, _default, _out);
+          return true;
+        }
+
+        /// \brief Estimates a vector for a grid given the interleaved X, Y
+        /// and Z components to interpolate. This method uses Trilinear
+        /// interpolation, see EstimateChannelsUsingTrilinear.
+        /// \param[in] _pt The point to estimate for.
+        /// \param[in] _values The components to interpolate, three per index.
+        /// \param[in] _default If a value is not found at a specific point then
+        /// this value will be used for every component.
+        /// \returns The estimated vector for the point. Nullopt if we are
+        /// outside the field.
+        public: template<typename X>
+        std::optional<Vector3<X>> EstimateVector3UsingTrilinear(
+          const Vector3<T> &_pt,
+          const std::vector<X> &_values,
+          const X &_default = X(0)) const
+        {
+          X out[3];
+          if (!this->EstimateChannelsUsingTrilinear(
+                _pt, _values.data(), 3, out, _default))
+          {
+            return std::nullopt;
+          }
+          return Vector3<X>(out[0], out[1], out[2]);
+        }
+
         /// \brief Estimates the values for a grid given a list of values to
         /// interpolate. This method uses Trilinear interpolation.
         /// \param[in] _interpolators The list of interpolators to use.
@@ -225,11 +977,13 @@ namespace gz
         /// in the index.
         public: template<typename V>
         std::optional<V> EstimateValueUsingTrilinear(
-          const std::vector<InterpolationPoint3D<T>> _interpolators,
+          const std::vector<InterpolationPoint3D<T>> &_interpolators,
           const Vector3<T> &_pt,
           const std::vector<V> &_values,
           const V &_default = V(0)) const
         {
+          GZ_MATH_PROFILE_ZONE(
+            "VolumetricGridLookupField::EstimateValueUsingTrilinear");
           if (_interpolators.size() == 0)
           {
             return std::nullopt;
@@ -263,6 +1017,326 @@ namespace gz
           }
         }
 
+        /// \brief Estimates the values at many points using Trilinear
+        /// interpolation. This gives the same results as calling
+        /// EstimateValueUsingTrilinear(const Vector3<T> &,
+        /// const std::vector<V> &, const V &) on each point. The points are
+        /// split in contiguous chunks across threads, and on grids too large
+        /// for the cache each chunk is processed grouped by grid cell.
+        /// \param[in] _pts Pointer to the points to estimate for.
+        /// \param[out] _out Pointer to the estimates, one per point. Set to
+        /// nullopt for points outside the field.
+        /// \param[in] _count Number of points.
+        /// \param[in] _values Pointer to the values to interpolate.
+        /// \param[in] _default If a value is not found at a specific point then
+        /// this value will be used.
+        /// \param[in] _threads Maximum number of threads to use. Zero uses
+        /// std::thread::hardware_concurrency.
+        public: template<typename V>
+        void EstimateValuesUsingTrilinear(
+          const Vector3<T> *_pts,
+          std::optional<V> *_out,
+          const std::size_t _count,
+          const V *_values,
+          const V &_default = V(0),
+          const unsigned int _threads = 1) const
+        {
+          GZ_MATH_PROFILE_ZONE(
+            "VolumetricGridLookupField::EstimateValuesUsingTrilinear");
+          // Large tables do not fit in cache, so visit the points of large
+          // batches grouped by the part of the grid they fall in
+          const bool sort =
+            this->TableSize() * sizeof(I) >= kBatchSortTableBytes;
+
+          auto estimate = [&](const std::size_t _begin, const std::size_t _end)
+          {
+            const std::size_t count = _end - _begin;
+            std::vector<std::size_t> order;
+            if (sort && count >= kBatchSortThreshold)
+            {
+              // Counting sort by bucket of grid cells
+              const std::size_t cells = this->TableSize();
+              const std::size_t buckets = std::min(cells, count);
+              std::vector<std::size_t> bucketOf(count);
+              std::vector<std::size_t> offsets(buckets + 1, 0);
+              for (std::size_t i = 0; i < count; ++i)
+              {
+                bucketOf[i] = this->CellKey(_pts[_begin + i]) * buckets / cells;
+                ++offsets[bucketOf[i] + 1];
+              }
+              for (std::size_t b = 0; b < buckets; ++b)
+                offsets[b + 1] += offsets[b];
+              order.resize(count);
+              for (std::size_t i = 0; i < count; ++i)
+                order[offsets[bucketOf[i]]++] = _begin + i;
+            }
+
+            // Consecutive points are often in the same cell, more so when
+            // sorted
+            InterpolationPoints3D<T> interpolators;
+            VolumetricGridCursor cursor;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+              const std::size_t n = order.empty() ? _begin + i : order[i];
+              this->GetInterpolators(_pts[n], interpolators, cursor);
+              _out[n] = this->EstimateValueUsingTrilinear(
+                interpolators, _pts[n], _values, _default);
+            }
+          };
+
+          detail::ParallelFor(_count,
+            detail::ChunkCount(_count, _threads, kBatchSortThreshold),
+            [&](std::size_t, const std::size_t _begin, const std::size_t _end)
+            {
+              estimate(_begin, _end);
+            });
+        }
+
+        /// \brief Estimates the values at many points using Trilinear
+        /// interpolation. See EstimateValuesUsingTrilinear(const Vector3<T> *,
+        /// std::optional<V> *, std::size_t, const V *, const V &,
+        /// unsigned int).
+        /// \param[in] _pts The points to estimate for.
+        /// \param[out] _out The estimates, resized to the number of points.
+        /// \param[in] _values The values to interpolate.
+        /// \param[in] _default If a value is not found at a specific point then
+        /// this value will be used.
+        /// \param[in] _threads Maximum number of threads to use. Zero uses
+        /// std::thread::hardware_concurrency.
+        public: template<typename V>
+        void EstimateValuesUsingTrilinear(
+          const std::vector<Vector3<T>> &_pts,
+          std::vector<std::optional<V>> &_out,
+          const std::vector<V> &_values,
+          const V &_default = V(0),
+          const unsigned int _threads = 1) const
+        {
+          _out.resize(_pts.size());
+          this->EstimateValuesUsingTrilinear(_pts.data(), _out.data(),
+            _pts.size(), _values.data(), _default, _threads);
+        }
+
+        /// \brief Write the field in a binary format that Load() can use in
+        /// place, for instance from a MemoryMappedFile. The format stores
+        /// the axes, the index table and the values in native byte order, so
+        /// it may only be loaded on a machine with the same byte order and
+        /// with the same T and I types.
+        /// \param[out] _out Stream to write to. It should be opened in
+        /// binary mode.
+        /// \return True if the field was written.
+        public: bool Save(std::ostream &_out) const
+        {
+          return this->SaveImpl(_out, nullptr, 0, 0);
+        }
+
+        /// \brief Write the field and the values it indexes in a binary
+        /// format. See Save(std::ostream &). V must be trivially copyable.
+        /// \param[out] _out Stream to write to. It should be opened in
+        /// binary mode.
+        /// \param[in] _values The values indexed by the field.
+        /// \return True if the field was written.
+        public: template<typename V>
+        bool Save(std::ostream &_out, const std::vector<V> &_values) const
+        {
+          static_assert(std::is_trivially_copyable_v<V>,
+            "Values must be trivially copyable");
+          return this->SaveImpl(_out, _values.data(), _values.size(),
+            sizeof(V));
+        }
+
+        /// \brief Replace this field with one written by Save(). The axes
+        /// are copied, while the index table and the values are used in
+        /// place, so _data must outlive this field and any copy of it. The
+        /// table is copied instead if _data is not aligned for I. If values
+        /// were saved, every index of the table must point to one of them.
+        /// \param[in] _data Start of the saved field.
+        /// \param[in] _size Size of _data in bytes.
+        /// \return False if _data does not hold a field saved with the same
+        /// T and I types on a machine with the same byte order, or if an
+        /// index is out of the saved values. The field is left empty in
+        /// that case.
+        public: bool Load(const void *_data, const std::size_t _size)
+        {
+          *this = VolumetricGridLookupField();
+
+          const char *data = static_cast<const char *>(_data);
+          FileHeader header;
+          if (!data || _size < sizeof(header))
+            return false;
+          std::memcpy(&header, data, sizeof(header));
+          if (std::memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) != 0 ||
+              header.byteOrder != kFileByteOrder ||
+              header.version != kFileVersion ||
+              header.keySize != sizeof(T) ||
+              header.indexSize != sizeof(I))
+          {
+            return false;
+          }
+
+          // Check each section fits before computing the next offset so that
+          // corrupt counts cannot overflow
+          std::size_t offset = sizeof(header);
+          auto section = [&](const std::uint64_t _count,
+                             const std::size_t _elementSize,
+                             const char *&_start)
+          {
+            const std::size_t remaining = _size - offset;
+            if (_elementSize > 0 && _count > remaining / _elementSize)
+              return false;
+            const std::size_t bytes =
+              static_cast<std::size_t>(_count) * _elementSize;
+            _start = data + offset;
+            offset = std::min(_size, offset + Padded(bytes));
+            return true;
+          };
+
+          const char *keys[3];
+          const std::uint64_t counts[3] =
+            {header.numX, header.numY, header.numZ};
+          for (int i = 0; i < 3; ++i)
+          {
+            if (!section(counts[i], sizeof(T), keys[i]))
+              return false;
+          }
+          const std::uint64_t remaining = _size - offset;
+          if ((header.numY > 0 && header.numX > remaining / header.numY) ||
+              (header.numZ > 0 &&
+               header.numX * header.numY > remaining / header.numZ))
+          {
+            return false;
+          }
+          const char *table = nullptr;
+          const char *values = nullptr;
+          if (!section(header.numX * header.numY * header.numZ, sizeof(I),
+                       table) ||
+              !section(header.numValues, header.valueSize, values))
+          {
+            return false;
+          }
+
+          AxisIndex<T> *axes[3] =
+            {&x_indices_by_lat, &y_indices_by_lon, &z_indices_by_depth};
+          for (int i = 0; i < 3; ++i)
+          {
+            for (std::uint64_t k = 0; k < counts[i]; ++k)
+            {
+              T key;
+              std::memcpy(&key, keys[i] + k * sizeof(T), sizeof(T));
+              axes[i]->AddIndexIfNotFound(key);
+            }
+            if (axes[i]->GetNumUniqueIndices() != counts[i])
+            {
+              *this = VolumetricGridLookupField();
+              return false;
+            }
+          }
+
+          this->num_x = static_cast<std::size_t>(header.numX);
+          this->num_y = static_cast<std::size_t>(header.numY);
+          this->num_z = static_cast<std::size_t>(header.numZ);
+          if (reinterpret_cast<std::uintptr_t>(table) % alignof(I) == 0)
+          {
+            this->mapped_table = reinterpret_cast<const I *>(table);
+          }
+          else
+          {
+            std::vector<I> copy(this->TableSize());
+            std::memcpy(copy.data(), table, this->TableSize() * sizeof(I));
+            this->index_table =
+              std::make_shared<const std::vector<I>>(std::move(copy));
+          }
+          if (header.numValues > 0)
+          {
+            const I *entries = this->Table();
+            for (std::size_t i = 0; i < this->TableSize(); ++i)
+            {
+              if (entries[i] != kNoIndex &&
+                  static_cast<std::uint64_t>(entries[i]) >= header.numValues)
+              {
+                *this = VolumetricGridLookupField();
+                return false;
+              }
+            }
+            this->mapped_values = values;
+            this->num_mapped_values =
+              static_cast<std::size_t>(header.numValues);
+            this->mapped_value_size = header.valueSize;
+          }
+          return true;
+        }
+
+        /// \brief Get the values stored with a field loaded by Load(). They
+        /// can be passed to the estimation functions that take a pointer to
+        /// the values.
+        /// \return Pointer to the values, or nullptr if the field has no
+        /// stored values, if their size is not sizeof(V) or if they are not
+        /// aligned for V.
+        public: template<typename V>
+        const V *Values() const
+        {
+          if (!this->mapped_values || this->mapped_value_size != sizeof(V) ||
+              reinterpret_cast<std::uintptr_t>(this->mapped_values) %
+                alignof(V) != 0)
+          {
+            return nullptr;
+          }
+          return static_cast<const V *>(this->mapped_values);
+        }
+
+        /// \brief Get the number of values stored with a field loaded by
+        /// Load().
+        /// \return Number of values, zero if there are none.
+        public: std::size_t NumValues() const
+        {
+          return this->num_mapped_values;
+        }
+
+        /// \brief Check whether another field has the same grid positions
+        /// and stores the same index at each of them, so that the two
+        /// fields can share value arrays. This compares the whole index
+        /// table.
+        /// \param[in] _other The other field.
+        /// \return True if the fields give the same interpolators for any
+        /// point.
+        public: bool SameIndices(const VolumetricGridLookupField &_other) const
+        {
+          if (this == &_other)
+            return true;
+          if (this->num_x != _other.num_x || this->num_y != _other.num_y ||
+              this->num_z != _other.num_z ||
+              x_indices_by_lat.GetKeysByIndex() !=
+                _other.x_indices_by_lat.GetKeysByIndex() ||
+              y_indices_by_lon.GetKeysByIndex() !=
+                _other.y_indices_by_lon.GetKeysByIndex() ||
+              z_indices_by_depth.GetKeysByIndex() !=
+                _other.z_indices_by_depth.GetKeysByIndex())
+          {
+            return false;
+          }
+          if (this->index_offset != _other.index_offset)
+            return false;
+          return this->Table() == _other.Table() ||
+            std::equal(this->Table(), this->Table() + this->TableSize(),
+              _other.Table());
+        }
+
+        /// \brief Get a field with the same grid whose indices are offset,
+        /// for instance for the next time slice of a dataset whose values
+        /// are stored one slice after the other. The index table is shared
+        /// with this field rather than copied, and if this field was loaded
+        /// in place the data it was loaded from must outlive the new field.
+        /// \param[in] _offset Added to every index of this field.
+        /// \return The offset field. It has no stored values, see Values().
+        public: VolumetricGridLookupField WithIndexOffset(const I _offset) const
+        {
+          VolumetricGridLookupField field(*this);
+          field.index_offset = static_cast<I>(this->index_offset + _offset);
+          field.mapped_values = nullptr;
+          field.num_mapped_values = 0;
+          field.mapped_value_size = 0;
+          return field;
+        }
+
         /// \brief Get the bounds of this grid field.
         /// \return A pair of vectors.
         public: std::pair<Vector3<T>, Vector3<T>> Bounds() const
@@ -19,8 +19,11 @@
 #define GZ_MATH_DETAIL_AXIS_INDEX_LOOKUP_FIELD_HH_
 
 #include <algorithm>
-#include <map>
+#include <array>
+#include <cmath>
+#include <cstddef>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include <cassert>
@@ -36,55 +39,123 @@ namespace gz
 
       /// \brief Represents a sparse number line which can be searched via
       /// search for indices.
+      ///
+      /// Positions are kept sorted in a contiguous vector. When they are
+      /// uniformly spaced, which is the common case for gridded data, the
+      /// neighbours of a value are found with O(1) arithmetic, otherwise
+      /// with a binary search.
       template <typename T>
       class AxisIndex
       {
-        /// \brief Binary tree with indices
-        private: std::map<T, std::size_t> axisIndex;
+        /// \brief Sorted positions of the measurements.
+        private: std::vector<T> keys;
 
-        /// \brief Number of indices
-        private: int numIndices{0};
+        /// \brief Index of each entry of keys, in order of registration.
+        private: std::vector<std::size_t> indices;
+
+        /// \brief True if the keys are uniformly spaced.
+        private: bool uniform{true};
+
+        /// \brief Distance between consecutive keys when uniform is true.
+        private: T step{0};
 
         /// \brief Minimum key
         /// \return the minimum key or zero if the axis is empty.
         public: T MinKey() const
         {
-          auto key = axisIndex.begin();
-          if (key == axisIndex.end())
+          if (keys.empty())
           {
             return T(0);
           }
-          return key->first;
+          return keys.front();
         }
 
         /// \brief Maximum key
         /// \return the maximum key or zero if the axis is empty.
         public: T MaxKey() const
         {
-          auto key = axisIndex.rbegin();
-          if (key == axisIndex.rend())
+          if (keys.empty())
           {
             return T(0);
           }
-          return key->first;
+          return keys.back();
         }
 
         /// \brief Register the existance of a measurement at _value.
         /// \param[in] _value The position of the measurement.
         public: void AddIndexIfNotFound(T _value)
         {
-          if (axisIndex.find(_value) == axisIndex.end())
+          // Measurements usually arrive in order, so check the end first
+          std::size_t pos = keys.size();
+          if (!keys.empty() && !(_value > keys.back()))
+          {
+            // keys[pos] is not less than _value, so they are equivalent
+            // unless _value is less, as in std::map
+            pos = this->LowerBound(_value);
+            if (!(_value < keys[pos]))
+            {
+              return;
+            }
+          }
+
+          const bool append = pos == keys.size();
+          keys.insert(keys.begin() + pos, _value);
+          indices.insert(indices.begin() + pos, indices.size());
+
+          if (!append || keys.size() <= 2)
+          {
+            this->UpdateSpacing();
+          }
+          else if (this->uniform)
           {
-            axisIndex[_value] = numIndices;
-            numIndices++;
+            // Only the new gap needs checking
+            this->uniform = this->IsUniformGap(keys.size() - 2);
           }
         }
 
+        /// \brief Replace all measurements at once. This gives the same axis
+        /// as registering the keys with AddIndexIfNotFound in index order.
+        /// \param[in] _keys Positions of the measurements, sorted and unique.
+        /// \param[in] _indices Index of each key, a permutation of
+        /// 0 to _keys.size() - 1.
+        public: void AssignSorted(
+          std::vector<T> _keys,
+          std::vector<std::size_t> _indices)
+        {
+          assert(_keys.size() == _indices.size());
+          assert(std::is_sorted(_keys.begin(), _keys.end()));
+          keys = std::move(_keys);
+          indices = std::move(_indices);
+          this->UpdateSpacing();
+        }
+
         /// \brief Get the number of unique indices.
         /// \return The number of unique indices.
         public: std::size_t GetNumUniqueIndices() const
         {
-          return axisIndex.size();
+          return keys.size();
+        }
+
+        /// \brief Get the positions of the measurements in order of
+        /// registration. Registering them again in this order into an empty
+        /// axis gives each the same index.
+        /// \return The position of each index.
+        public: std::vector<T> GetKeysByIndex() const
+        {
+          std::vector<T> result(keys.size());
+          for (std::size_t i = 0; i < keys.size(); ++i)
+          {
+            result[indices[i]] = keys[i];
+          }
+          return result;
+        }
+
+        /// \brief Get whether the measurements are uniformly spaced, which
+        /// makes lookups O(1).
+        /// \return True if the measurements are uniformly spaced.
+        public: bool IsUniform() const
+        {
+          return this->uniform;
         }
 
         /// \brief Get the index of a measurement
@@ -92,14 +163,118 @@ namespace gz
         /// \return The index of the measurement if found else return nullopt.
         public: std::optional<std::size_t> GetIndex(T _value) const
         {
-          auto res = axisIndex.find(_value);
-          if (res == axisIndex.end())
+          const std::size_t pos = this->LowerBound(_value);
+          if (pos == keys.size() || _value < keys[pos])
           {
             return std::nullopt;
           }
           else
           {
-            return res->second;
+            return indices[pos];
+          }
+        }
+
+        /// \brief Get interpolators for a measurement without allocating.
+        /// \param[in] _value The position of the measurement.
+        /// \param[out] _out The measurements that should be used for
+        /// interpolation, only the first entries up to the returned count are
+        /// set.
+        /// \param[in] _tol The tolerance for the search. Cannot be zero.
+        /// \return The number of interpolators: zero if the value is out of
+        /// range, one if the value is exact, otherwise two.
+        public: std::size_t GetInterpolators(
+          const T &_value,
+          std::array<InterpolationPoint1D<T>, 2> &_out,
+          double _tol = 1e-6) const
+        {
+          return this->InterpolatorsAt(
+            this->LowerBound(_value), _value, _out, _tol);
+        }
+
+        /// \brief Get interpolators for a measurement without allocating,
+        /// starting the search from the result of a previous query. This is
+        /// constant time when successive values are close to each other.
+        /// \param[in] _value The position of the measurement.
+        /// \param[out] _out The measurements that should be used for
+        /// interpolation, only the first entries up to the returned count are
+        /// set.
+        /// \param[in,out] _hint Where to start the search, updated for the
+        /// next query. Any value is valid, use zero for the first query.
+        /// \param[in] _tol The tolerance for the search. Cannot be zero.
+        /// \return The number of interpolators: zero if the value is out of
+        /// range, one if the value is exact, otherwise two.
+        public: std::size_t GetInterpolators(
+          const T &_value,
+          std::array<InterpolationPoint1D<T>, 2> &_out,
+          std::size_t &_hint,
+          double _tol = 1e-6) const
+        {
+          const std::size_t n = keys.size();
+          auto isLowerBound = [&](const std::size_t _pos)
+          {
+            return (_pos == 0 || keys[_pos - 1] < _value) &&
+              (_pos == n || !(keys[_pos] < _value));
+          };
+
+          // Check the previous position and its neighbours first
+          std::size_t pos = std::min(_hint, n);
+          if (!isLowerBound(pos))
+          {
+            if (pos < n && isLowerBound(pos + 1))
+            {
+              ++pos;
+            }
+            else if (pos > 0 && isLowerBound(pos - 1))
+            {
+              --pos;
+            }
+            else
+            {
+              pos = this->LowerBound(_value);
+            }
+          }
+          _hint = pos;
+          return this->InterpolatorsAt(pos, _value, _out, _tol);
+        }
+
+        /// \brief Get interpolators for a measurement given the position of
+        /// the first key that is not less than it.
+        /// \param[in] _pos The result of LowerBound(_value).
+        /// \param[in] _value The position of the measurement.
+        /// \param[out] _out The measurements that should be used for
+        /// interpolation.
+        /// \param[in] _tol The tolerance for the search. Cannot be zero.
+        /// \return The number of interpolators.
+        private: std::size_t InterpolatorsAt(
+          const std::size_t _pos,
+          const T &_value,
+          std::array<InterpolationPoint1D<T>, 2> &_out,
+          double _tol) const
+        {
+          assert(_tol > 0);
+          const std::size_t pos = _pos;
+          if (pos == keys.size())
+          {
+            // Out of range
+            return 0;
+          }
+          else if (fabs(keys[pos] - _value) < _tol)
+          {
+            // Exact match
+            _out[0] = InterpolationPoint1D<T>{keys[pos], indices[pos]};
+            return 1;
+          }
+          else if (pos == 0)
+          {
+            // Below range
+            return 0;
+          }
+          else
+          {
+            // Interpolate
+            _out[0] = InterpolationPoint1D<T>{keys[pos - 1], indices[pos - 1]};
+            _out[1] = InterpolationPoint1D<T>{keys[pos], indices[pos]};
+            return 2;
           }
         }
 
@@ -115,32 +290,73 @@ namespace gz
           const T &_value,
           double _tol = 1e-6) const
         {
-          assert(_tol > 0);
-          // Performs a BST to find the first element that is greater than or
-          // equal to the value.
-          auto it = axisIndex.lower_bound(_value);
-          if (it == axisIndex.end())
+          std::array<InterpolationPoint1D<T>, 2> points;
+          const std::size_t count =
+            this->GetInterpolators(_value, points, _tol);
+          return std::vector<InterpolationPoint1D<T>>(
+            points.begin(), points.begin() + count);
+        }
+
+        /// \brief Find the first key that is not less than a value.
+        /// \param[in] _value The value.
+        /// \return Position of the key in keys, or keys.size() if every key
+        /// is less than _value.
+        private: std::size_t LowerBound(const T &_value) const
+        {
+          if (keys.empty() || !(_value > keys.front()))
           {
-            // Out of range
-            return {};
+            return 0;
           }
-          else if (fabs(it->first - _value) < _tol)
+          if (_value > keys.back())
           {
-            // Exact match
-            return {InterpolationPoint1D<T>{it->first, it->second}};
+            return keys.size();
           }
-          else if (it == axisIndex.begin())
+
+          if (this->uniform && this->step > 0)
           {
-            // Below range
-            return {};
+            // Guess from the spacing, then correct for rounding. The keys
+            // around the guess decide, so the result is always exact.
+            const T offset = std::ceil((_value - keys.front()) / this->step);
+            std::size_t pos = std::min(
+              static_cast<std::size_t>(std::max(offset, T(0))),
+              keys.size() - 1);
+            if (pos > 0 && !(keys[pos - 1] < _value))
+            {
+              --pos;
+            }
+            else if (keys[pos] < _value)
+            {
+              ++pos;
+            }
+            if ((pos == 0 || keys[pos - 1] < _value) &&
+                (pos < keys.size() && !(keys[pos] < _value)))
+            {
+              return pos;
+            }
           }
-          else
+
+          return static_cast<std::size_t>(
+            std::lower_bound(keys.begin(), keys.end(), _value) - keys.begin());
+        }
+
+        /// \brief Check whether the gap after a key matches the step.
+        /// \param[in] _pos Position of the key in keys.
+        /// \return True if keys[_pos + 1] - keys[_pos] is close to step.
+        private: bool IsUniformGap(const std::size_t _pos) const
+        {
+          const T gap = keys[_pos + 1] - keys[_pos];
+          return std::abs(gap - this->step) <=
+            std::abs(this->step) * static_cast<T>(1e-6);
+        }
+
+        /// \brief Recompute step and uniform from all keys.
+        private: void UpdateSpacing()
+        {
+          this->uniform = true;
+          this->step = keys.size() > 1 ? keys[1] - keys[0] : T(0);
+          for (std::size_t i = 1; this->uniform && i + 1 < keys.size(); ++i)
           {
-            // Interpolate
-            auto itPrev = it;
-            itPrev--;
-            return {InterpolationPoint1D<T>{itPrev->first, itPrev->second},
-              InterpolationPoint1D<T>{it->first, it->second}};
+            this->uniform = this->IsUniformGap(i);
           }
         }
       };
@@ -21,6 +21,9 @@
 
 #include <optional>
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
 #include <set>
 #include <utility>
 #include <vector>
@@ -186,22 +189,72 @@ std::vector<std::pair<Triangle3<T>, T>> TrianglesInPlane(
 }
 
 /////////////////////////////////////////////////
+/// \brief Insert a point in a sorted array of points unless an equivalent
+/// point is there, as IntersectionPoints<T>::insert does.
+/// \param[in] _point The point to insert.
+/// \param[in,out] _points The sorted array of points, with room for one
+/// more point.
+/// \param[in,out] _count The number of points in the array.
 template<typename T>
-T Box<T>::VolumeBelow(const Plane<T> &_plane) const
+void InsertWellOrdered(const Vector3<T> &_point, Vector3<T> *_points,
+    std::size_t &_count)
+{
+  const WellOrderedVectors<T> less;
+  Vector3<T> *end = _points + _count;
+  Vector3<T> *it = std::upper_bound(_points, end, _point, less);
+  if (it != _points && !less(*(it - 1), _point))
+    return;
+  std::copy_backward(it, end, end + 1);
+  *it = _point;
+  ++_count;
+}
+
+/////////////////////////////////////////////////
+template<typename T>
+std::size_t Box<T>::ClippedVertices(const Plane<T> &_plane,
+    Vector3<T> *_vertices) const
 {
-  auto verticesBelow = this->VerticesBelow(_plane);
-  if (verticesBelow.empty())
+  // Same vertices as VerticesBelow
+  const Vector3<T> half = this->size / 2;
+  const Vector3<T> corners[8] =
+  {
+    Vector3<T>{half.X(), half.Y(), half.Z()},
+    Vector3<T>{-half.X(), half.Y(), half.Z()},
+    Vector3<T>{half.X(), -half.Y(), half.Z()},
+    Vector3<T>{-half.X(), -half.Y(), half.Z()},
+    Vector3<T>{half.X(), half.Y(), -half.Z()},
+    Vector3<T>{-half.X(), half.Y(), -half.Z()},
+    Vector3<T>{half.X(), -half.Y(), -half.Z()},
+    Vector3<T>{-half.X(), -half.Y(), -half.Z()}
+  };
+  std::size_t count = 0;
+  for (const auto &v : corners)
+    InsertWellOrdered(v, _vertices, count);
+  const auto below = std::remove_if(_vertices, _vertices + count,
+    [&_plane](const Vector3<T> &_v)
+    {
+      return !(_plane.Distance(_v) <= 0);
+    });
+  count = static_cast<std::size_t>(below - _vertices);
+  if (count == 0)
     return 0;
 
-  auto intersections = this->Intersections(_plane);
-  // TODO(arjo): investigate the use of _epsilon tolerance as this method
-  // implicitly uses Vector3<T>::operator==()
-  verticesBelow.merge(intersections);
+  Vector3<T> intersections[kMaxIntersections];
+  const std::size_t intersectionCount =
+    this->Intersections(_plane, intersections);
+  for (std::size_t i = 0; i < intersectionCount; ++i)
+    InsertWellOrdered(intersections[i], _vertices, count);
 
-  // Reconstruct the cut-box as a triangle mesh by attempting to fit planes.
-  std::vector<std::pair<Triangle3<T>, T>> triangles;
+  return count;
+}
 
-  std::vector<Plane<T>> planes
+/////////////////////////////////////////////////
+template<typename T>
+T Box<T>::ClippedVolume(const Plane<T> &_plane, const Vector3<T> *_vertices,
+    const std::size_t _count) const
+{
+  // Reconstruct the cut-box as a triangle mesh by attempting to fit planes.
+  const Plane<T> planes[7] =
   {
     Plane<T>{Vector3<T>{0, 0, 1}, this->Size().Z()/2},
     Plane<T>{Vector3<T>{0, 0, -1}, this->Size().Z()/2},
@@ -212,46 +265,123 @@ T Box<T>::VolumeBelow(const Plane<T> &_plane) const
     _plane
   };
 
-  for (const auto &p : planes)
-  {
-    auto newTriangles = TrianglesInPlane(p, verticesBelow);
-    triangles.insert(triangles.end(),
-      newTriangles.begin(),
-      newTriangles.end());
-  }
-
-  // Calculate the volume of the triangles
+  // Calculate the volume of the triangles, with the fans of TrianglesInPlane
   // https://n-e-r-v-o-u-s.com/blog/?p=4415
   T volume = 0;
-  for (const auto &triangle : triangles)
+  std::pair<T, Vector3<T>> pointsInPlane[kMaxClippedVertices];
+  for (const auto &p : planes)
   {
-    auto crossProduct = (triangle.first[2]).Cross(triangle.first[1]);
-    auto meshVolume = std::abs(crossProduct.Dot(triangle.first[0]));
-    volume += triangle.second * meshVolume;
+    std::size_t count = 0;
+    Vector3<T> centroid;
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+      if (p.Side(_vertices[i]) == Plane<T>::NO_SIDE)
+      {
+        pointsInPlane[count++].second = _vertices[i];
+        centroid += _vertices[i];
+      }
+    }
+    if (count < 3)
+      continue;
+    centroid /= T(count);
+
+    // Sort the points by their angle in the plane basis, computing each
+    // angle once.
+    auto axis1 = (pointsInPlane[0].second - centroid).Normalize();
+    auto axis2 = axis1.Cross(p.Normal()).Normalize();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      auto displacement = pointsInPlane[i].second - centroid;
+      auto x = axis1.Dot(displacement) / axis1.Length();
+      auto y = axis2.Dot(displacement) / axis2.Length();
+      pointsInPlane[i].first = atan2(y, x);
+    }
+    std::sort(pointsInPlane, pointsInPlane + count,
+      [] (const std::pair<T, Vector3<T>> &_a,
+          const std::pair<T, Vector3<T>> &_b)
+      {
+        return _a.first < _b.first;
+      });
+
+    const T sign = (p.Side({0, 0, 0}) == Plane<T>::POSITIVE_SIDE) ? -1 : 1;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      auto crossProduct =
+          centroid.Cross(pointsInPlane[(i + 1) % count].second);
+      auto meshVolume = std::abs(crossProduct.Dot(pointsInPlane[i].second));
+      volume += sign * meshVolume;
+    }
   }
 
   return std::abs(volume)/6;
 }
 
+/////////////////////////////////////////////////
+template<typename T>
+T Box<T>::VolumeBelow(const Plane<T> &_plane) const
+{
+  Vector3<T> vertices[kMaxClippedVertices];
+  const std::size_t count = this->ClippedVertices(_plane, vertices);
+  if (count == 0)
+    return 0;
+
+  // TODO(arjo): investigate the use of _epsilon tolerance as this method
+  // implicitly uses Vector3<T>::operator==()
+  return this->ClippedVolume(_plane, vertices, count);
+}
+
 /////////////////////////////////////////////////
 template<typename T>
 std::optional<Vector3<T>>
   Box<T>::CenterOfVolumeBelow(const Plane<T> &_plane) const
 {
-  auto verticesBelow = this->VerticesBelow(_plane);
-  if (verticesBelow.empty())
+  Vector3<T> vertices[kMaxClippedVertices];
+  const std::size_t count = this->ClippedVertices(_plane, vertices);
+  if (count == 0)
     return std::nullopt;
 
-  auto intersections = this->Intersections(_plane);
-  verticesBelow.merge(intersections);
-
   Vector3<T> centroid;
-  for (const auto &v : verticesBelow)
+  for (std::size_t i = 0; i < count; ++i)
   {
-    centroid += v;
+    centroid += vertices[i];
   }
 
-  return centroid / static_cast<T>(verticesBelow.size());
+  return centroid / static_cast<T>(count);
+}
+
+/////////////////////////////////////////////////
+template<typename T>
+void Box<T>::VolumesBelow(const Box<T> *_boxes, const Pose3<T> *_poses,
+    const std::size_t _count, const Plane<T> &_plane, T *_volumes,
+    Vector3<T> *_centers)
+{
+  Vector3<T> vertices[kMaxClippedVertices];
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    // Express the plane in the frame of the box
+    const Quaternion<T> &rot = _poses[i].Rot();
+    const Plane<T> plane(rot.RotateVectorReverse(_plane.Normal()),
+        _plane.Offset() - _plane.Normal().Dot(_poses[i].Pos()));
+
+    const std::size_t count = _boxes[i].ClippedVertices(plane, vertices);
+    if (count == 0)
+    {
+      _volumes[i] = 0;
+      if (_centers)
+        _centers[i] = Vector3<T>::NaN;
+      continue;
+    }
+
+    _volumes[i] = _boxes[i].ClippedVolume(plane, vertices, count);
+    if (_centers)
+    {
+      Vector3<T> centroid;
+      for (std::size_t j = 0; j < count; ++j)
+        centroid += vertices[j];
+      _centers[i] = rot.RotateVector(centroid / static_cast<T>(count)) +
+          _poses[i].Pos();
+    }
+  }
 }
 
 /////////////////////////////////////////////////
@@ -332,10 +462,19 @@ template<typename T>
 IntersectionPoints<T> Box<T>::Intersections(
         const Plane<T> &_plane) const
 {
-  IntersectionPoints<T> intersections;
+  Vector3<T> points[kMaxIntersections];
+  const std::size_t count = this->Intersections(_plane, points);
+  return IntersectionPoints<T>(points, points + count);
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+std::size_t Box<T>::Intersections(const Plane<T> &_plane,
+    Vector3<T> *_points) const
+{
   // These are vertices via which we can describe edges. We only need 4 such
   // vertices
-  std::vector<Vector3<T> > vertices
+  const Vector3<T> vertices[4] =
   {
     Vector3<T>{-this->size.X()/2, -this->size.Y()/2, -this->size.Z()/2},
     Vector3<T>{this->size.X()/2, this->size.Y()/2, -this->size.Z()/2},
@@ -344,7 +483,7 @@ IntersectionPoints<T> Box<T>::Intersections(
   };
 
   // Axes
-  std::vector<Vector3<T>> axes
+  const Vector3<T> axes[3] =
   {
     Vector3<T>{1, 0, 0},
     Vector3<T>{0, 1, 0},
@@ -353,9 +492,10 @@ IntersectionPoints<T> Box<T>::Intersections(
 
   // There are 12 edges, which are checked along 3 axes from 4 box corner
   // points.
-  for (auto &v : vertices)
+  std::size_t count = 0;
+  for (const auto &v : vertices)
   {
-    for (auto &a : axes)
+    for (const auto &a : axes)
     {
       auto intersection = _plane.Intersection(v, a);
       if (intersection.has_value() &&
@@ -366,12 +506,134 @@ IntersectionPoints<T> Box<T>::Intersections(
           intersection->Z() >= -this->size.Z()/2 &&
           intersection->Z() <= this->size.Z()/2)
       {
-        intersections.insert(intersection.value());
+        InsertWellOrdered(*intersection, _points, count);
       }
     }
   }
 
-  return intersections;
+  return count;
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+std::size_t Box<T>::IntersectionPolygon(const Plane<T> &_plane,
+    Vector3<T> *_points) const
+{
+  // Signed distances of the corners to the plane, from the distance of the
+  // center and the extents of the box along the normal. Bit k of the index
+  // of a corner is set for the positive side along axis k.
+  const Vector3<T> half = this->size / 2;
+  const Vector3<T> &normal = _plane.Normal();
+  const Vector3<T> extent = normal * half;
+  const T center = -_plane.Offset();
+  T distances[8];
+  for (int i = 0; i < 8; ++i)
+  {
+    distances[i] = center + ((i & 1) ? extent.X() : -extent.X()) +
+      ((i & 2) ? extent.Y() : -extent.Y()) +
+      ((i & 4) ? extent.Z() : -extent.Z());
+  }
+  const auto corner = [&half](const int _i)
+  {
+    return Vector3<T>((_i & 1) ? half.X() : -half.X(),
+                      (_i & 2) ? half.Y() : -half.Y(),
+                      (_i & 4) ? half.Z() : -half.Z());
+  };
+
+  // Corners closer than the rounding errors are on the plane.
+  const T tolerance = 16 * std::numeric_limits<T>::epsilon() *
+    (std::abs(extent.X()) + std::abs(extent.Y()) + std::abs(extent.Z()) +
+     std::abs(center));
+  int sides[8];
+  std::size_t count = 0;
+  for (int i = 0; i < 8; ++i)
+  {
+    sides[i] = distances[i] > tolerance ? 1 :
+      (distances[i] < -tolerance ? -1 : 0);
+    if (sides[i] != 0)
+      continue;
+    const Vector3<T> point = corner(i);
+    if (std::find(_points, _points + count, point) == _points + count)
+      _points[count++] = point;
+  }
+
+  // Edges with their corners on opposite sides, at most 12 points with
+  // the corners since each corner on the plane excludes its 3 edges.
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    const int bit = 1 << axis;
+    for (int i = 0; i < 8; ++i)
+    {
+      const int j = i | bit;
+      if ((i & bit) || sides[i] * sides[j] >= 0)
+        continue;
+      const T t = distances[i] / (distances[i] - distances[j]);
+      Vector3<T> point = corner(i);
+      point[axis] += t * this->size[axis];
+      _points[count++] = point;
+    }
+  }
+  if (count < 3)
+    return count;
+
+  Vector3<T> centroid;
+  for (std::size_t i = 0; i < count; ++i)
+    centroid += _points[i];
+  centroid /= T(count);
+
+  // Sort the points by a pseudo angle around the normal, which increases
+  // with the angle, from the first point. Any basis of the plane with the
+  // same orientation gives the same order.
+  const Vector3<T> axis1 = _points[0] - centroid;
+  const Vector3<T> axis2 = normal.Cross(axis1);
+  std::pair<T, Vector3<T>> sorted[kMaxIntersections];
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const Vector3<T> displacement = _points[i] - centroid;
+    const T x = axis1.Dot(displacement);
+    const T y = axis2.Dot(displacement);
+    const T sum = std::abs(x) + std::abs(y);
+    const T p = sum > 0 ? y / sum : 0;
+    sorted[i] = {x < 0 ? 2 - p : (y < 0 ? 4 + p : p), _points[i]};
+  }
+  std::sort(sorted, sorted + count,
+    [] (const std::pair<T, Vector3<T>> &_a,
+        const std::pair<T, Vector3<T>> &_b)
+    {
+      return _a.first < _b.first;
+    });
+  for (std::size_t i = 0; i < count; ++i)
+    _points[i] = sorted[i].second;
+
+  return count;
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+std::size_t Box<T>::IntersectionPolygons(const Box<T> *_boxes,
+    const Pose3<T> *_poses, const std::size_t _count, const Plane<T> &_plane,
+    Vector3<T> *_points, std::size_t *_offsets)
+{
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    _offsets[i] = total;
+
+    // Express the plane in the frame of the box, with the rotation matrix
+    // used for the vertices too.
+    const Matrix3<T> rot(_poses[i].Rot());
+    const Vector3<T> &pos = _poses[i].Pos();
+    const Plane<T> plane(rot.Transposed() * _plane.Normal(),
+        _plane.Offset() - _plane.Normal().Dot(pos));
+
+    Vector3<T> *points = _points + total;
+    const std::size_t count = _boxes[i].IntersectionPolygon(plane, points);
+    for (std::size_t j = 0; j < count; ++j)
+      points[j] = rot * points[j] + pos;
+    total += count;
+  }
+  _offsets[_count] = total;
+  return total;
 }
 
 }
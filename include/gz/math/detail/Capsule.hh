@@ -17,10 +17,12 @@
 #ifndef GZ_MATH_DETAIL_CAPSULE_HH_
 #define GZ_MATH_DETAIL_CAPSULE_HH_
 
+#include <cmath>
 #include <limits>
 #include <optional>
 #include <gz/math/Helpers.hh>
 #include <gz/math/Inertial.hh>
+#include <gz/math/detail/RevolvedVolumeBelow.hh>
 
 namespace gz
 {
@@ -161,6 +163,99 @@ T Capsule<T>::DensityFromMass(const T _mass) const
   return _mass / this->Volume();
 }
 
+//////////////////////////////////////////////////
+template<typename T>
+T Capsule<T>::VolumeBelow(const Plane<T> &_plane) const
+{
+  Vector3<T> center;
+  return this->VolumeAndCenterBelow(_plane, center);
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+std::optional<Vector3<T>>
+  Capsule<T>::CenterOfVolumeBelow(const Plane<T> &_plane) const
+{
+  Vector3<T> center;
+  if (this->VolumeAndCenterBelow(_plane, center) <= 0)
+    return std::nullopt;
+  return center;
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+void Capsule<T>::VolumesBelow(const Capsule<T> *_capsules,
+    const Pose3<T> *_poses, const std::size_t _count, const Plane<T> &_plane,
+    T *_volumes, Vector3<T> *_centers)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    // Express the plane in the frame of the capsule
+    const Quaternion<T> &rot = _poses[i].Rot();
+    const Plane<T> plane(rot.RotateVectorReverse(_plane.Normal()),
+        _plane.Offset() - _plane.Normal().Dot(_poses[i].Pos()));
+
+    Vector3<T> center;
+    _volumes[i] = _capsules[i].VolumeAndCenterBelow(plane, center);
+    if (_centers)
+      _centers[i] = rot.RotateVector(center) + _poses[i].Pos();
+  }
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+T Capsule<T>::VolumeAndCenterBelow(const Plane<T> &_plane,
+    Vector3<T> &_center) const
+{
+  // Express the plane with a unit normal
+  Vector3<T> normal = _plane.Normal();
+  T offset = _plane.Offset();
+  const T normalLength = normal.Length();
+  if (normalLength > 0)
+  {
+    normal /= normalLength;
+    offset /= normalLength;
+  }
+
+  // Distance from the center to the furthest point along the normal
+  const T halfLength = this->length / 2;
+  const T extent = std::abs(normal.Z()) * halfLength + this->radius;
+  if (offset >= extent)
+  {
+    // capsule is completely below plane
+    _center = Vector3<T>::Zero;
+    return this->Volume();
+  }
+  else if (offset <= -extent)
+  {
+    // capsule is completely above plane
+    _center = Vector3<T>::NaN;
+    return 0;
+  }
+
+  // The cylinder, then the hemispheres whose squared radius is
+  // radius^2 - (z -/+ halfLength)^2.
+  const T radiusSq = this->radius * this->radius;
+  const T capSq = radiusSq - halfLength * halfLength;
+  T volume = 0;
+  Vector3<T> moment;
+  detail::RevolvedVolumeBelow<T>(radiusSq, 0, 0, -halfLength, halfLength,
+      normal, offset, volume, moment);
+  detail::RevolvedVolumeBelow<T>(capSq, this->length, -1, halfLength,
+      halfLength + this->radius, normal, offset, volume, moment);
+  detail::RevolvedVolumeBelow<T>(capSq, -this->length, -1,
+      -halfLength - this->radius, -halfLength, normal, offset, volume,
+      moment);
+  if (volume <= 0)
+  {
+    _center = Vector3<T>::NaN;
+    return 0;
+  }
+
+  _center = moment / volume;
+  return volume;
+}
+
 }
 }
 #endif
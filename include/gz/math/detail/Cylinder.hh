@@ -17,7 +17,9 @@
 #ifndef GZ_MATH_DETAIL_CYLINDER_HH_
 #define GZ_MATH_DETAIL_CYLINDER_HH_
 
+#include <cmath>
 #include <optional>
+#include <gz/math/detail/RevolvedVolumeBelow.hh>
 
 namespace gz
 {
@@ -165,6 +167,91 @@ T Cylinder<T>::DensityFromMass(const T _mass) const
   return _mass / this->Volume();
 }
 
+//////////////////////////////////////////////////
+template<typename T>
+T Cylinder<T>::VolumeBelow(const Plane<T> &_plane) const
+{
+  Vector3<T> center;
+  return this->VolumeAndCenterBelow(_plane, center);
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+std::optional<Vector3<T>>
+  Cylinder<T>::CenterOfVolumeBelow(const Plane<T> &_plane) const
+{
+  Vector3<T> center;
+  if (this->VolumeAndCenterBelow(_plane, center) <= 0)
+    return std::nullopt;
+  return center;
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+void Cylinder<T>::VolumesBelow(const Cylinder<T> *_cylinders,
+    const Pose3<T> *_poses, const std::size_t _count, const Plane<T> &_plane,
+    T *_volumes, Vector3<T> *_centers)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    // Express the plane in the frame of the cylinder
+    const Quaternion<T> &rot = _poses[i].Rot();
+    const Plane<T> plane(rot.RotateVectorReverse(_plane.Normal()),
+        _plane.Offset() - _plane.Normal().Dot(_poses[i].Pos()));
+
+    Vector3<T> center;
+    _volumes[i] = _cylinders[i].VolumeAndCenterBelow(plane, center);
+    if (_centers)
+      _centers[i] = rot.RotateVector(center) + _poses[i].Pos();
+  }
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+T Cylinder<T>::VolumeAndCenterBelow(const Plane<T> &_plane,
+    Vector3<T> &_center) const
+{
+  // Express the plane with a unit normal in the frame of the axis
+  Vector3<T> normal = this->rotOffset.RotateVectorReverse(_plane.Normal());
+  T offset = _plane.Offset();
+  const T normalLength = normal.Length();
+  if (normalLength > 0)
+  {
+    normal /= normalLength;
+    offset /= normalLength;
+  }
+
+  // Distance from the center to the furthest point along the normal
+  const T halfLength = this->length / 2;
+  const T extent = std::abs(normal.Z()) * halfLength + this->radius *
+      std::sqrt(normal.X() * normal.X() + normal.Y() * normal.Y());
+  if (offset >= extent)
+  {
+    // cylinder is completely below plane
+    _center = Vector3<T>::Zero;
+    return this->Volume();
+  }
+  else if (offset <= -extent)
+  {
+    // cylinder is completely above plane
+    _center = Vector3<T>::NaN;
+    return 0;
+  }
+
+  T volume = 0;
+  Vector3<T> moment;
+  detail::RevolvedVolumeBelow<T>(this->radius * this->radius, 0, 0,
+      -halfLength, halfLength, normal, offset, volume, moment);
+  if (volume <= 0)
+  {
+    _center = Vector3<T>::NaN;
+    return 0;
+  }
+
+  _center = this->rotOffset.RotateVector(moment / volume);
+  return volume;
+}
+
 }
 }
 #endif
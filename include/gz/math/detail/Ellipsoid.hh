@@ -123,6 +123,83 @@ T Ellipsoid<T>::DensityFromMass(const T _mass) const
   return _mass / this->Volume();
 }
 
+//////////////////////////////////////////////////
+template<typename T>
+T Ellipsoid<T>::VolumeBelow(const Plane<T> &_plane) const
+{
+  Vector3<T> center;
+  return this->VolumeAndCenterBelow(_plane, center);
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+std::optional<Vector3<T>>
+  Ellipsoid<T>::CenterOfVolumeBelow(const Plane<T> &_plane) const
+{
+  Vector3<T> center;
+  if (this->VolumeAndCenterBelow(_plane, center) <= 0)
+    return std::nullopt;
+  return center;
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+void Ellipsoid<T>::VolumesBelow(const Ellipsoid<T> *_ellipsoids,
+    const Pose3<T> *_poses, const std::size_t _count, const Plane<T> &_plane,
+    T *_volumes, Vector3<T> *_centers)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    // Express the plane in the frame of the ellipsoid
+    const Quaternion<T> &rot = _poses[i].Rot();
+    const Plane<T> plane(rot.RotateVectorReverse(_plane.Normal()),
+        _plane.Offset() - _plane.Normal().Dot(_poses[i].Pos()));
+
+    Vector3<T> center;
+    _volumes[i] = _ellipsoids[i].VolumeAndCenterBelow(plane, center);
+    if (_centers)
+      _centers[i] = rot.RotateVector(center) + _poses[i].Pos();
+  }
+}
+
+//////////////////////////////////////////////////
+template<typename T>
+T Ellipsoid<T>::VolumeAndCenterBelow(const Plane<T> &_plane,
+    Vector3<T> &_center) const
+{
+  // Scaling the unit sphere by the radii gives the ellipsoid, and maps a
+  // spherical cap to the part of the ellipsoid below the plane. The plane
+  // n.x = d becomes (radii * n).y = d for the unit sphere.
+  const Vector3<T> normal = this->radii * _plane.Normal();
+  const T normalLength = normal.Length();
+  T dist;
+  if (normalLength > 0)
+    dist = _plane.Offset() / normalLength;
+  else
+    dist = _plane.Offset() >= 0 ? 1 : -1;
+
+  if (dist >= 1)
+  {
+    // ellipsoid is completely below plane
+    _center = Vector3<T>::Zero;
+    return this->Volume();
+  }
+  else if (dist <= -1)
+  {
+    // ellipsoid is completely above plane
+    _center = Vector3<T>::NaN;
+    return 0;
+  }
+
+  // Volume and centroid of a cap of height 1 + dist of the unit sphere
+  // https://mathworld.wolfram.com/SphericalCap.html
+  const T volume = static_cast<T>(GZ_PI) * (1 + dist) * (1 + dist) *
+      (2 - dist) / 3;
+  const T centroid = -3 * (1 - dist) * (1 - dist) / (4 * (2 - dist));
+  _center = this->radii * (normal / normalLength) * centroid;
+  return volume * this->radii.X() * this->radii.Y() * this->radii.Z();
+}
+
 }
 }
 #endif
@@ -21,7 +21,11 @@
 #include <gz/math/Vector3.hh>
 #include <gz/math/Vector2.hh>
 
+#include <array>
+#include <cstddef>
 #include <optional>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <cassert>
@@ -42,6 +46,19 @@ namespace gz
       std::optional<std::size_t> index;
     };
 
+    /// \brief A fixed capacity list of up to eight interpolation points, as
+    /// returned by VolumetricGridLookupField::GetInterpolators. Unlike a
+    /// std::vector it never allocates, so it can be reused across lookups.
+    template<typename T>
+    struct InterpolationPoints3D
+    {
+      /// \brief The points, only the first count entries are valid.
+      std::array<InterpolationPoint3D<T>, 8> points;
+
+      /// \brief Number of valid points: 0, 1, 2, 4 or 8.
+      std::size_t count{0};
+    };
+
     /// \brief Describes a 4D interpolation point.
     template<typename T, typename V>
     struct InterpolationPoint4D
@@ -92,6 +109,61 @@ namespace gz
       return (1 - t) * _lst[_b.index] + t * _lst[_a.index];
     }
 
+    /// \brief Linear Interpolation of two values given at two positions in
+    /// 3D space.
+    /// \param[in] _aPos The position of the first value.
+    /// \param[in] _aVal The first value.
+    /// \param[in] _bPos The position of the second value.
+    /// \param[in] _bVal The second value.
+    /// \param[in] _pos The position to interpolate.
+    /// Warning: This function assumes that _aPos and _bPos are not the same.
+    template<typename T, typename V>
+    V LinearInterpolate(
+      const Vector3<T> &_aPos,
+      const V &_aVal,
+      const Vector3<T> &_bPos,
+      const V &_bVal,
+      const Vector3<T> &_pos)
+    {
+      assert((_aPos - _bPos).Length() > 0);
+      auto t = (_pos - _bPos).Length() / (_aPos - _bPos).Length();
+      return (1 - t) * _bVal + t * _aVal;
+    }
+
+    /// \brief Type of the values read from an array of values, which may be
+    /// a pointer or any type with an operator[] such as QuantizedValues.
+    template<typename L>
+    using InterpolationValue =
+      std::decay_t<decltype(std::declval<const L &>()[0])>;
+
+    /// \brief Linear Interpolation of two points in 3D space
+    /// \param[in] _a The first point.
+    /// \param[in] _b The second point.
+    /// \param[in] _lst An array of values that are to be used by the
+    /// interpolator, a pointer or any type with an operator[].
+    /// _lst[a.index] and _lst[b.index] are the values
+    /// to be interpolated. If a.index or b.index is std::nullopt then use the
+    /// default value.
+    /// \param[in] _pos The position to interpolate.
+    /// \param[in] _default The default value to use if a.index or b.index is
+    /// std::nullopt.
+    /// Warning: This function assumes that the indices of _a and _b correspond
+    /// to values in _lst. It performs no bounds checking whatsoever and if you
+    /// pass it invalid data, it will crash.
+    template<typename T, typename L, typename V = InterpolationValue<L>>
+    V LinearInterpolate(
+      const InterpolationPoint3D<T> &_a,
+      const InterpolationPoint3D<T> &_b,
+      const L &_lst,
+      const Vector3<T> &_pos,
+      const V &_default = V(0)
+      )
+    {
+      auto b_val = (_b.index.has_value()) ? _lst[_b.index.value()]: _default;
+      auto a_val = (_a.index.has_value()) ? _lst[_a.index.value()]: _default;
+      return LinearInterpolate(_a.position, a_val, _b.position, b_val, _pos);
+    }
+
     /// \brief Linear Interpolation of two points in 3D space
     /// \param[in] _a The first point.
     /// \param[in] _b The second point.
@@ -117,24 +189,18 @@ namespace gz
       assert((_a.position - _b.position).Length() > 0);
       assert((_a.index.has_value()) ? _a.index.value() < _lst.size(): true);
       assert((_b.index.has_value()) ? _b.index.value() < _lst.size(): true);
-
-      auto t =
-        (_pos - _b.position).Length() / (_a.position - _b.position).Length();
-
-      auto b_val = (_b.index.has_value()) ? _lst[_b.index.value()]: _default;
-      auto a_val = (_a.index.has_value()) ? _lst[_a.index.value()]: _default;
-      return (1 - t) * b_val + t * a_val;
+      return LinearInterpolate(_a, _b, _lst.data(), _pos, _default);
     }
 
     /// \brief Bilinear interpolation of four points in 3D space. It assumes
     /// these 4 points form a plane.
-    /// \param[in] _a The list of points to interpolate. The list must have at
-    /// least 4 entries. Furthermore the order of the indices should be such
-    /// that every consecutive pair of indices lie on the same edge. Furthermore
-    /// the 4 points must be coplanar and corners of a rectangular patch.
-    /// \param[in] _start_index The starting index of points to interpolate.
+    /// \param[in] _a Pointer to the 4 points to interpolate. The order of the
+    /// points should be such that every consecutive pair of points lie on the
+    /// same edge. Furthermore the 4 points must be coplanar and corners of a
+    /// rectangular patch.
     /// \param[in] _lst An array of values that are to be used by the
-    /// interpolator. _lst[a.index] and _lst[b.index] are the values
+    /// interpolator, a pointer or any type with an operator[].
+    /// _lst[a.index] and _lst[b.index] are the values
     /// to be interpolated. If a.index or b.index is std::nullopt then use the
     /// default value.
     /// \param[in] _pos The position to interpolate.
@@ -143,57 +209,87 @@ namespace gz
     /// Warning: This function assumes that the indices of _a and _b correspond
     /// to values in _lst. It performs no bounds checking whatsoever and if you
     /// pass it invalid data, it will crash.
-    template<typename T, typename V>
+    template<typename T, typename L, typename V = InterpolationValue<L>>
     V BiLinearInterpolate(
-      const std::vector<InterpolationPoint3D<T>> &_a,
-      const std::size_t &_start_index,
-      const std::vector<V>  &_lst,
+      const InterpolationPoint3D<T> *_a,
+      const L &_lst,
       const Vector3<T> &_pos,
       const V &_default = V(0))
     {
       /// Assertions
       #ifndef NDEBUG
-      assert(_a.size() >= _start_index + 4);
       /// Check if all points co planar.
-      auto planeNormal = (_a[_start_index + 1].position -
-        _a[_start_index].position).Cross(_a[_start_index + 2].position -
-        _a[_start_index].position);
-      auto planeScalar = planeNormal.Dot(_a[_start_index].position);
+      auto planeNormal = (_a[1].position - _a[0].position).Cross(
+        _a[2].position - _a[0].position);
+      auto planeScalar = planeNormal.Dot(_a[0].position);
       assert(
-        !(std::abs(
-            planeNormal.Dot(_a[_start_index + 3].position) - planeScalar) > 0)
+        !(std::abs(planeNormal.Dot(_a[3].position) - planeScalar) > 0)
         );
       #endif
 
       // Project point onto line
-      std::vector<V> linres;
-      auto n0 = _a[_start_index];
-      auto n1 = _a[_start_index + 1];
+      const auto &n0 = _a[0];
+      const auto &n1 = _a[1];
       auto proj1 = n1.position-n0.position;
       auto unitProj1 = proj1.Normalized();
       auto pos1 =
         (_pos - n0.position).Dot(unitProj1) * unitProj1 + n0.position;
       // Apply normal linear interpolation
-      linres.push_back(LinearInterpolate(n0, n1, _lst, pos1, _default));
+      auto val1 = LinearInterpolate(n0, n1, _lst, pos1, _default);
 
       // Project point onto second line
-      auto n2 = _a[_start_index + 2];
-      auto n3 = _a[_start_index + 3];
+      const auto &n2 = _a[2];
+      const auto &n3 = _a[3];
       auto pos2 =
         (_pos - n2.position).Dot(unitProj1) * unitProj1 + n2.position;
-      linres.push_back(LinearInterpolate(n2, n3, _lst, pos2, _default));
+      auto val2 = LinearInterpolate(n2, n3, _lst, pos2, _default);
 
       // Perform final linear interpolation
-      InterpolationPoint3D<T> p1 {
-        pos1,
-        0
-      };
-
-      InterpolationPoint3D<T> p2 {
-        pos2,
-        1
-      };
-      return LinearInterpolate(p1, p2, linres, _pos, _default);
+      return LinearInterpolate(pos1, val1, pos2, val2, _pos);
+    }
+
+    /// \brief Bilinear interpolation of four points in 3D space. It assumes
+    /// these 4 points form a plane.
+    /// \param[in] _a The list of points to interpolate. The list must have at
+    /// least 4 entries. Furthermore the order of the indices should be such
+    /// that every consecutive pair of indices lie on the same edge. Furthermore
+    /// the 4 points must be coplanar and corners of a rectangular patch.
+    /// \param[in] _start_index The starting index of points to interpolate.
+    /// \param[in] _lst An array of values that are to be used by the
+    /// interpolator. _lst[a.index] and _lst[b.index] are the values
+    /// to be interpolated. If a.index or b.index is std::nullopt then use the
+    /// default value.
+    /// \param[in] _pos The position to interpolate.
+    /// \param[in] _default The default value to use if a.index or b.index is
+    /// std::nullopt.
+    /// Warning: This function assumes that the indices of _a and _b correspond
+    /// to values in _lst. It performs no bounds checking whatsoever and if you
+    /// pass it invalid data, it will crash.
+    template<typename T, typename V>
+    V BiLinearInterpolate(
+      const std::vector<InterpolationPoint3D<T>> &_a,
+      const std::size_t &_start_index,
+      const std::vector<V>  &_lst,
+      const Vector3<T> &_pos,
+      const V &_default = V(0))
+    {
+      assert(_a.size() >= _start_index + 4);
+      return BiLinearInterpolate(
+        _a.data() + _start_index, _lst.data(), _pos, _default);
+    }
+
+    /// \brief Project Point onto a plane.
+    /// \param[in] _points Pointer to at least 3 points, the first 3 points
+    /// define the plane.
+    /// \param[in] _pos The position to project onto the plane
+    template<typename T>
+    gz::math::Vector3<T> ProjectPointToPlane(
+      const InterpolationPoint3D<T> *_points,
+      const Vector3<T> &_pos)
+    {
+      auto n = (_points[1].position - _points[0].position).Cross(
+        _points[2].position - _points[0].position);
+      return _pos - n.Dot(_pos - _points[0].position) * n.Normalized();
     }
 
     /// \brief Project Point onto a plane.
@@ -204,16 +300,41 @@ namespace gz
     /// \param[in] _pos The position to project onto the plane
     template<typename T>
     gz::math::Vector3<T> ProjectPointToPlane(
-      const std::vector<InterpolationPoint3D<T>> _points,
+      const std::vector<InterpolationPoint3D<T>> &_points,
       const std::size_t &_start_index,
       const Vector3<T> &_pos)
     {
-      auto n =
-        (_points[_start_index + 1].position - _points[_start_index].position)
-        .Cross(
-        _points[_start_index + 2].position - _points[_start_index].position);
-      return
-        _pos - n.Dot(_pos - _points[_start_index].position) * n.Normalized();
+      return ProjectPointToPlane(_points.data() + _start_index, _pos);
+    }
+
+    /// \brief Trilinear interpolation of eight points in 3D space. It assumes
+    /// these eight points form a rectangular prism.
+    /// \param[in] _a Pointer to the 8 points to interpolate. The first 4
+    /// points must form a plane as must the last 4. The order of the points
+    /// within a plane should be such that consecutive pairs of indices lie on
+    /// the same edge.
+    /// \param[in] _lst An array of values that are to be used for
+    /// interpolation, a pointer or any type with an operator[].
+    /// \param[in] _pos The position to interpolate.
+    /// \param[in] _default The default value to use if a.index or b.index is
+    /// std::nullopt.
+    template<typename T, typename L, typename V = InterpolationValue<L>>
+    V TrilinearInterpolate(
+      const InterpolationPoint3D<T> *_a,
+      const L &_lst,
+      const Vector3<T> &_pos,
+      const V &_default = V(0))
+    {
+      // First plane
+      auto pos1 = ProjectPointToPlane<T>(_a, _pos);
+      auto val1 = BiLinearInterpolate(_a, _lst, pos1, _default);
+
+      // Second plane
+      auto pos2 = ProjectPointToPlane<T>(_a + 4, _pos);
+      auto val2 = BiLinearInterpolate(_a + 4, _lst, pos2, _default);
+
+      // Perform final linear interpolation
+      return LinearInterpolate(pos1, val1, pos2, val2, _pos);
     }
 
     /// \brief Trilinear interpolation of eight points in 3D space. It assumes
@@ -234,27 +355,163 @@ namespace gz
       const V &_default = V(0))
     {
       assert(_a.size() == 8);
+      return TrilinearInterpolate(_a.data(), _lst.data(), _pos, _default);
+    }
 
-      std::vector<V> linres;
-      // First plane
-      auto pos1 = ProjectPointToPlane<T>(_a, 0, _pos);
-      linres.push_back(BiLinearInterpolate(_a, 0, _lst, pos1, _default));
+    /// \brief Compute the weights of linear interpolation between two
+    /// points in 3D space. Interpolating with these weights gives the same
+    /// result as LinearInterpolate.
+    /// \param[in] _a Pointer to the 2 points to interpolate.
+    /// \param[in] _pos The position to interpolate.
+    /// \param[out] _weights Pointer to the 2 weights, one per point.
+    /// Warning: This function assumes that the points are not in the same
+    /// position.
+    template<typename T>
+    void LinearInterpolationWeights(
+      const InterpolationPoint3D<T> *_a,
+      const Vector3<T> &_pos,
+      T *_weights)
+    {
+      assert((_a[0].position - _a[1].position).Length() > 0);
+      const T t = (_pos - _a[1].position).Length() /
+        (_a[0].position - _a[1].position).Length();
+      _weights[0] = t;
+      _weights[1] = 1 - t;
+    }
 
-      // Second plane
-      auto pos2 = ProjectPointToPlane<T>(_a, 4, _pos);
-      linres.push_back(BiLinearInterpolate(_a, 4, _lst, pos2, _default));
+    /// \brief Compute the weights of bilinear interpolation of four points
+    /// in 3D space. Interpolating with these weights gives the same result
+    /// as BiLinearInterpolate.
+    /// \param[in] _a Pointer to the 4 points to interpolate, ordered as for
+    /// BiLinearInterpolate.
+    /// \param[in] _pos The position to interpolate.
+    /// \param[out] _weights Pointer to the 4 weights, one per point.
+    template<typename T>
+    void BiLinearInterpolationWeights(
+      const InterpolationPoint3D<T> *_a,
+      const Vector3<T> &_pos,
+      T *_weights)
+    {
+      // Project the point onto both edges
+      auto unitProj1 = (_a[1].position - _a[0].position).Normalized();
+      auto pos1 = (_pos - _a[0].position).Dot(unitProj1) * unitProj1 +
+        _a[0].position;
+      auto pos2 = (_pos - _a[2].position).Dot(unitProj1) * unitProj1 +
+        _a[2].position;
+      LinearInterpolationWeights(_a, pos1, _weights);
+      LinearInterpolationWeights(_a + 2, pos2, _weights + 2);
 
-      // Perform final linear interpolation
-      InterpolationPoint3D<T> p1 {
-        pos1,
-        0
-      };
-
-      InterpolationPoint3D<T> p2 {
-        pos2,
-        1
-      };
-      return LinearInterpolate(p1, p2, linres, _pos, _default);
+      // Then between the edges
+      assert((pos1 - pos2).Length() > 0);
+      const T t = (_pos - pos2).Length() / (pos1 - pos2).Length();
+      _weights[0] *= t;
+      _weights[1] *= t;
+      _weights[2] *= 1 - t;
+      _weights[3] *= 1 - t;
+    }
+
+    /// \brief Compute the weights of trilinear interpolation of eight
+    /// points in 3D space. Interpolating with these weights gives the same
+    /// result as TrilinearInterpolate.
+    /// \param[in] _a Pointer to the 8 points to interpolate, ordered as for
+    /// TrilinearInterpolate.
+    /// \param[in] _pos The position to interpolate.
+    /// \param[out] _weights Pointer to the 8 weights, one per point.
+    template<typename T>
+    void TrilinearInterpolationWeights(
+      const InterpolationPoint3D<T> *_a,
+      const Vector3<T> &_pos,
+      T *_weights)
+    {
+      auto pos1 = ProjectPointToPlane<T>(_a, _pos);
+      BiLinearInterpolationWeights(_a, pos1, _weights);
+      auto pos2 = ProjectPointToPlane<T>(_a + 4, _pos);
+      BiLinearInterpolationWeights(_a + 4, pos2, _weights + 4);
+
+      assert((pos1 - pos2).Length() > 0);
+      const T t = (_pos - pos2).Length() / (pos1 - pos2).Length();
+      for (std::size_t i = 0; i < 4; ++i)
+      {
+        _weights[i] *= t;
+        _weights[i + 4] *= 1 - t;
+      }
+    }
+
+    /// \brief Compute the weights of interpolation between the points
+    /// returned by VolumetricGridLookupField::GetInterpolators. The
+    /// weights only depend on the positions, so they can be reused to
+    /// interpolate any number of values at the same position.
+    /// \param[in] _points The interpolation points.
+    /// \param[in] _pos The position to interpolate.
+    /// \param[out] _weights The weights, only the first _points.count
+    /// entries are set.
+    /// \return False if there are no points to interpolate.
+    template<typename T>
+    bool InterpolationWeights(
+      const InterpolationPoints3D<T> &_points,
+      const Vector3<T> &_pos,
+      std::array<T, 8> &_weights)
+    {
+      switch (_points.count)
+      {
+        case 1:
+          _weights[0] = 1;
+          return true;
+        case 2:
+          LinearInterpolationWeights(_points.points.data(), _pos,
+            _weights.data());
+          return true;
+        case 4:
+          BiLinearInterpolationWeights(_points.points.data(), _pos,
+            _weights.data());
+          return true;
+        case 8:
+          TrilinearInterpolationWeights(_points.points.data(), _pos,
+            _weights.data());
+          return true;
+        default:
+          return false;
+      }
+    }
+
+    /// \brief Add the weighted sum of interleaved values to an output.
+    /// For each channel c, _out[c] is incremented by the sum over the
+    /// points of _weights[k] * _values[index_k * _channels + c], using
+    /// _default for points without an index.
+    /// \param[in] _points The interpolation points.
+    /// \param[in] _weights The weight of each point, from
+    /// InterpolationWeights.
+    /// \param[in] _values Pointer to the values, with the _channels values
+    /// of each index stored next to each other.
+    /// \param[in] _channels Number of values per index.
+    /// \param[in] _default The value of every channel for points without an
+    /// index.
+    /// \param[in,out] _out Pointer to the _channels sums.
+    /// Warning: This function performs no bounds checking on _values.
+    template<typename T, typename X>
+    void AccumulateInterpolatedChannels(
+      const InterpolationPoints3D<T> &_points,
+      const std::array<T, 8> &_weights,
+      const X *_values,
+      const std::size_t _channels,
+      const X &_default,
+      X *_out)
+    {
+      for (std::size_t k = 0; k < _points.count; ++k)
+      {
+        const X weight = static_cast<X>(_weights[k]);
+        const auto &index = _points.points[k].index;
+        if (!index.has_value())
+        {
+          for (std::size_t c = 0; c < _channels; ++c)
+            _out[c] += weight * _default;
+          continue;
+        }
+        // Channels are contiguous, so this loop vectorizes
+        const X *values = _values + index.value() * _channels;
+        for (std::size_t c = 0; c < _channels; ++c)
+          _out[c] += weight * values[c];
+      }
     }
   }
 }
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_MATH_DETAIL_PARALLELFOR_HH_
+#define GZ_MATH_DETAIL_PARALLELFOR_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Get the number of threads meant by a _threads parameter of
+      /// the public API.
+      /// \param[in] _threads Requested number of threads, zero for
+      /// std::thread::hardware_concurrency.
+      /// \return Number of threads, at least one.
+      inline std::size_t ThreadCount(const unsigned int _threads)
+      {
+        if (_threads > 0)
+          return _threads;
+        return std::max(1u, std::thread::hardware_concurrency());
+      }
+
+      /// \brief Get the number of chunks ParallelFor splits a range in,
+      /// given a number of threads and the smallest chunk worth a thread.
+      /// \param[in] _count Size of the range.
+      /// \param[in] _threads Requested number of threads, zero for
+      /// std::thread::hardware_concurrency.
+      /// \param[in] _minChunk Smallest number of items per thread.
+      /// \return Number of chunks, at least one. ParallelFor called with it
+      /// runs exactly that many chunks.
+      inline std::size_t ChunkCount(const std::size_t _count,
+                                    const unsigned int _threads,
+                                    const std::size_t _minChunk = 1)
+      {
+        const std::size_t minChunk = std::max<std::size_t>(1, _minChunk);
+        const std::size_t threads = std::max<std::size_t>(1,
+            std::min(ThreadCount(_threads), _count / minChunk));
+        const std::size_t chunk = (_count + threads - 1) / threads;
+        return chunk > 0 ? (_count + chunk - 1) / chunk : 1;
+      }
+
+      /// \brief Split a range in contiguous chunks of equal size, except
+      /// for the last one, and process them in parallel. The first chunk
+      /// runs on the calling thread and the others with std::async. The
+      /// function returns once all the chunks are done.
+      /// \param[in] _count Size of the range.
+      /// \param[in] _chunks Largest number of chunks, see ChunkCount.
+      /// \param[in] _fn Function called with the number, start and end of
+      /// each chunk. The first chunk is always processed, even if empty.
+      template<typename F>
+      void ParallelFor(const std::size_t _count, const std::size_t _chunks,
+                       const F &_fn)
+      {
+        if (_chunks <= 1 || _count <= 1)
+        {
+          _fn(std::size_t{0}, std::size_t{0}, _count);
+          return;
+        }
+
+        const std::size_t chunk = (_count + _chunks - 1) / _chunks;
+        std::vector<std::future<void>> futures;
+        for (std::size_t begin = chunk; begin < _count; begin += chunk)
+        {
+          futures.push_back(std::async(std::launch::async, [&_fn, begin,
+              chunk, _count]()
+          {
+            _fn(begin / chunk, begin, std::min(begin + chunk, _count));
+          }));
+        }
+        _fn(std::size_t{0}, std::size_t{0}, chunk);
+        for (auto &future : futures)
+          future.get();
+      }
+    }
+    }
+  }
+}
+
+#endif
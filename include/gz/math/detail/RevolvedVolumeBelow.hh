@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_DETAIL_REVOLVEDVOLUMEBELOW_HH_
+#define GZ_MATH_DETAIL_REVOLVEDVOLUMEBELOW_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include <gz/math/Helpers.hh>
+#include <gz/math/Vector3.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    namespace detail
+    {
+      /// \brief Area and first moment of the part of a disk on the negative
+      /// side of a line.
+      /// \param[in] _radiusSq Squared radius of the disk.
+      /// \param[in] _h Signed distance from the center of the disk to the
+      /// line, positive when the center is on the negative side.
+      /// \param[out] _area Area of the part of the disk.
+      /// \param[out] _moment First moment of the part of the disk along the
+      /// normal of the line, relative to the center of the disk.
+      template<typename T>
+      void DiskSegmentBelow(const T _radiusSq, const T _h, T &_area,
+                            T &_moment)
+      {
+        if (_radiusSq <= 0 || _h * _h >= _radiusSq)
+        {
+          _area = (_radiusSq > 0 && _h > 0) ?
+              static_cast<T>(GZ_PI) * _radiusSq : 0;
+          _moment = 0;
+          return;
+        }
+
+        const T r = std::sqrt(_radiusSq);
+        const T halfChord = std::sqrt(_radiusSq - _h * _h);
+        _area = _radiusSq * std::acos(-_h / r) + _h * halfChord;
+        _moment = -2 * halfChord * halfChord * halfChord / 3;
+      }
+
+      /// \brief Volume and first moment of the part of a solid of revolution
+      /// about the Z axis below a plane. The squared radius of the solid is
+      /// the quadratic _radiusSq0 + _radiusSq1 * z + _radiusSq2 * z^2 for
+      /// z in [_z0, _z1], which covers cylinders, cones and spherical caps.
+      ///
+      /// Each slice of the solid is a disk cut by a line, whose area is
+      /// known exactly. The slices are integrated along the axis with a
+      /// Gauss-Legendre rule, split where the plane is tangent to a slice
+      /// so that each piece is smooth, and with a cosine change of variable
+      /// which removes the square root behaviour at those tangencies.
+      /// \param[in] _radiusSq0 Constant term of the squared radius.
+      /// \param[in] _radiusSq1 Linear term of the squared radius.
+      /// \param[in] _radiusSq2 Quadratic term of the squared radius.
+      /// \param[in] _z0 Lower end of the solid along the axis.
+      /// \param[in] _z1 Upper end of the solid along the axis.
+      /// \param[in] _normal Unit normal of the plane.
+      /// \param[in] _offset Offset of the plane, so that points below the
+      /// plane have _normal.Dot(p) <= _offset.
+      /// \param[in,out] _volume Volume below the plane, added to.
+      /// \param[in,out] _moment First moment of the volume below the plane
+      /// about the origin, added to.
+      template<typename T>
+      void RevolvedVolumeBelow(const T _radiusSq0, const T _radiusSq1,
+                               const T _radiusSq2, const T _z0, const T _z1,
+                               const Vector3<T> &_normal, const T _offset,
+                               T &_volume, Vector3<T> &_moment)
+      {
+        // 16 point Gauss-Legendre rule for theta in [0, pi], with
+        // z = -cos(theta) in [-1, 1] and the weights scaled by dz/dtheta.
+        struct Rule
+        {
+          Rule()
+          {
+            const double nodes[8] = {
+              0.0950125098376374, 0.2816035507792589, 0.4580167776572274,
+              0.6178762444026438, 0.7554044083550030, 0.8656312023878318,
+              0.9445750230732326, 0.9894009349916499};
+            const double weights[8] = {
+              0.1894506104550685, 0.1826034150449236, 0.1691565193950025,
+              0.1495959888165767, 0.1246289712555339, 0.0951585116824928,
+              0.0622535239386479, 0.0271524594117541};
+            for (int i = 0; i < 16; ++i)
+            {
+              const double x = (i < 8) ? -nodes[7 - i] : nodes[i - 8];
+              const double theta = GZ_PI / 2 * (1 + x);
+              this->z[i] = static_cast<T>(-std::cos(theta));
+              this->w[i] = static_cast<T>(GZ_PI / 2 *
+                  weights[(i < 8) ? 7 - i : i - 8] * std::sin(theta));
+            }
+          }
+          T z[16];
+          T w[16];
+        };
+        static const Rule rule;
+
+        if (!(_z1 > _z0))
+          return;
+
+        // Direction of the plane normal in the slices.
+        const T k = std::sqrt(_normal.X() * _normal.X() +
+                              _normal.Y() * _normal.Y());
+        const T nz = _normal.Z();
+
+        // Split where the line is tangent to the slice, which is where
+        // (_offset - nz * z)^2 = k^2 * radiusSq(z). When the plane is
+        // perpendicular to the axis that is where it crosses the axis.
+        T splits[4] = {_z0, _z1, _z1, _z1};
+        int splitCount = 1;
+        const T a = nz * nz - k * k * _radiusSq2;
+        const T b = -2 * _offset * nz - k * k * _radiusSq1;
+        const T c = _offset * _offset - k * k * _radiusSq0;
+        T roots[2];
+        int rootCount = 0;
+        if (std::abs(a) > std::numeric_limits<T>::epsilon())
+        {
+          // A negative discriminant only adds a harmless split, while
+          // rounding must not hide a tangency.
+          const T disc = std::max(b * b - 4 * a * c, static_cast<T>(0));
+          // Numerically stable form of the quadratic formula
+          const T q = -(b + std::copysign(std::sqrt(disc), b)) / 2;
+          roots[rootCount++] = q / a;
+          if (!equal<T>(q, 0))
+            roots[rootCount++] = c / q;
+        }
+        else if (!equal<T>(b, 0))
+        {
+          roots[rootCount++] = -c / b;
+        }
+        if (rootCount == 2 && roots[1] < roots[0])
+          std::swap(roots[0], roots[1]);
+        for (int i = 0; i < rootCount; ++i)
+        {
+          if (roots[i] > _z0 && roots[i] < _z1)
+            splits[splitCount++] = roots[i];
+        }
+        splits[splitCount] = _z1;
+
+        T volume = 0;
+        T momentZ = 0;
+        T momentU = 0;
+        for (int s = 0; s < splitCount; ++s)
+        {
+          const T mid = (splits[s] + splits[s + 1]) / 2;
+          const T half = (splits[s + 1] - splits[s]) / 2;
+          if (half <= 0)
+            continue;
+
+          for (int i = 0; i < 16; ++i)
+          {
+            const T z = mid + half * rule.z[i];
+            const T dz = half * rule.w[i];
+
+            const T radiusSq =
+                _radiusSq0 + (_radiusSq1 + _radiusSq2 * z) * z;
+            const T signedDist = _offset - nz * z;
+            T h;
+            if (k > 0)
+              h = signedDist / k;
+            else
+              h = signedDist >= 0 ? std::numeric_limits<T>::infinity() :
+                  -std::numeric_limits<T>::infinity();
+
+            T area, moment;
+            DiskSegmentBelow(radiusSq, h, area, moment);
+            volume += area * dz;
+            momentZ += z * area * dz;
+            momentU += moment * dz;
+          }
+        }
+
+        _volume += volume;
+        _moment.Z() += momentZ;
+        if (k > 0)
+        {
+          _moment.X() += momentU * _normal.X() / k;
+          _moment.Y() += momentU * _normal.Y() / k;
+        }
+      }
+    }  // namespace detail
+  }
+}
+
+#endif
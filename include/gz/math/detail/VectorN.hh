@@ -0,0 +1,375 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_DETAIL_VECTORN_HH_
+#define GZ_MATH_DETAIL_VECTORN_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include <gz/math/Helpers.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_MATH_VERSION_NAMESPACE {
+    namespace detail
+    {
+      /// \brief Per component kernels shared by Vector2, Vector3 and
+      /// Vector4, which keep their own storage and delegate to these
+      /// functions. The loops have a constant trip count, so they are
+      /// unrolled and vectorized by the compiler. A faster version for a
+      /// given type and size, for example with intrinsics, can be added as
+      /// a specialization and is then used by the matching vector class.
+      ///
+      /// Reductions accumulate from the first to the last component, as
+      /// the expressions they replace, so the results are unchanged.
+      /// \tparam T Type of the components.
+      /// \tparam N Number of components.
+      template<typename T, std::size_t N>
+      struct VectorN
+      {
+        /// \brief Array of components.
+        using Array = T[N];
+
+        /// \brief Set all the components to a value.
+        /// \param[out] _out The components.
+        /// \param[in] _s The value.
+        static constexpr void Fill(Array &_out, const T _s)
+        {
+          for (std::size_t i = 0; i < N; ++i)
+            _out[i] = _s;
+        }
+
+        /// \brief Sum of the components.
+        /// \param[in] _a The components.
+        /// \return _a[0] + ... + _a[N-1]
+        static constexpr T Sum(const Array &_a)
+        {
+          T result = _a[0];
+          for (std::size_t i = 1; i < N; ++i)
+            result += _a[i];
+          return result;
+        }
+
+        /// \brief Dot product.
+        /// \param[in] _a The first vector.
+        /// \param[in] _b The second vector.
+        /// \return _a[0] * _b[0] + ... + _a[N-1] * _b[N-1]
+        static constexpr T Dot(const Array &_a, const Array &_b)
+        {
+          T result = _a[0] * _b[0];
+          for (std::size_t i = 1; i < N; ++i)
+            result += _a[i] * _b[i];
+          return result;
+        }
+
+        /// \brief Sum of the absolute values of the component products.
+        /// \param[in] _a The first vector.
+        /// \param[in] _b The second vector.
+        /// \return |_a[0] * _b[0]| + ... + |_a[N-1] * _b[N-1]|
+        static T AbsDot(const Array &_a, const Array &_b)
+        {
+          T result = std::abs(_a[0] * _b[0]);
+          for (std::size_t i = 1; i < N; ++i)
+            result += std::abs(_a[i] * _b[i]);
+          return result;
+        }
+
+        /// \brief Squared distance between two points.
+        /// \param[in] _a The first point.
+        /// \param[in] _b The second point.
+        /// \return The squared length of _a - _b.
+        static constexpr T SquaredDistance(const Array &_a, const Array &_b)
+        {
+          T result = (_a[0] - _b[0]) * (_a[0] - _b[0]);
+          for (std::size_t i = 1; i < N; ++i)
+            result += (_a[i] - _b[i]) * (_a[i] - _b[i]);
+          return result;
+        }
+
+        /// \brief Per component sum, _out may alias the inputs.
+        /// \param[out] _out _a + _b
+        /// \param[in] _a The first vector.
+        /// \param[in] _b The second vector.
+        static constexpr void Add(Array &_out, const Array &_a,
+                                  const Array &_b)
+        {
+          for (std::size_t i = 0; i < N; ++i)
+            _out[i] = _a[i] + _b[i];
+        }
+
+        /// \brief Per component difference, _out may alias the inputs.
+        /// \param[out] _out _a - _b
+        /// \param[in] _a The first vector.
+        /// \param[in] _b The second vector.
+        static constexpr void Sub(Array &_out, const Array &_a,
+                                  const Array &_b)
+        {
+          for (std::size_t i = 0; i < N; ++i)
+            _out[i] = _a[i] - _b[i];
+        }
+
+        /// \brief Per component product, _out may alias the inputs.
+        /// \param[out] _out _a * _b
+        /// \param[in] _a The first vector.
+        /// \param[in] _b The second vector.
+        static constexpr void Mul(Array &_out, const Array &_a,
+                                  const Array &_b)
+        {
+          for (std::size_t i = 0; i < N; ++i)
+            _out[i] = _a[i] * _b[i];
+        }
+
+        /// \brief Per component quotient, _out may alias the inputs.
+        /// \param[out] _out _a / _b
+        /// \param[in] _a The dividend.
+        /// \param[in] _b The divisor.
+        static constexpr void Div(Array &_out, const Array &_a,
+                                  const Array &_b)
+        {
+          for (std::size_t i = 0; i < N; ++i)
+            _out[i] = _a[i] / _b[i];
+        }
+
+        /// \brief Add a scalar to each component.
+        /// \param[out] _out _a + _s
+        /// \param[in] _a The vector.
+        /// \param[in] _s The scalar.
+        static constexpr void AddScalar(Array &_out, const Array &_a,
+                                        const T _s)
+        {
+          for (std::size_t i = 0; i < N; ++i)
+            _out[i] = _a[i] + _s;
+        }
+
+        /// \brief Subtract a scalar from each component.
+        /// \param[out] _out _a - _s
+        /// \param[in] _a The vector.
+        /// \param[in] _s The scalar.
+        static constexpr void SubScalar(Array &_out, const Array &_a,
+                                        const T _s)
+        {
+          for (std::size_t i = 0; i < N; ++i)
+            _out[i] = _a[i] - _s;
+        }
+
+        /// \brief Subtract each component from a scalar.
+        /// \param[out] _out _s - _a
+        /// \param[in] _s The scalar.
+        /// \param[in] _a The vector.
+        static constexpr void ScalarSub(Array &_out, const T _s,
+                                        const Array &_a)
+        {
+          for (std::size_t i = 0; i < N; ++i)
+            _out[i] = _s - _a[i];
+        }
+
+        /// \brief Multiply each component by a scalar.
+        /// \param[out] _out _a * _s
+        /// \param[in] _a The vector.
+        /// \param[in] _s The scalar.
+        static constexpr void MulScalar(Array &_out, const Array &_a,
+                                        const T _s)
+        {
+          for (std::size_t i = 0; i < N; ++i)
+            _out[i] = _a[i] * _s;
+        }
+
+        /// \brief Divide each component by a scalar.
+        /// \param[out] _out _a / _s
+        /// \param[in] _a The vector.
+        /// \param[in] _s The scalar.
+        static constexpr void DivScalar(Array &_out, const Array &_a,
+                                        const T _s)
+        {
+          for (std::size_t i = 0; i < N; ++i)
+            _out[i] = _a[i] / _s;
+        }
+
+        /// \brief Negate each component.
+        /// \param[out] _out -_a
+        /// \param[in] _a The vector.
+        static constexpr void Negate(Array &_out, const Array &_a)
+        {
+          for (std::size_t i = 0; i < N; ++i)
+            _out[i] = -_a[i];
+        }
+
+        /// \brief Absolute value of each component.
+        /// \param[out] _out |_a|
+        /// \param[in] _a The vector.
+        static void Abs(Array &_out, const Array &_a)
+        {
+          for (std::size_t i = 0; i < N; ++i)
+            _out[i] = std::abs(_a[i]);
+        }
+
+        /// \brief Scale a vector and add another one.
+        /// \param[out] _out _a * _s + _b
+        /// \param[in] _a The vector to scale.
+        /// \param[in] _s The scaling factor.
+        /// \param[in] _b The vector to add.
+        static constexpr void MultiplyAdd(Array &_out, const Array &_a,
+                                          const T _s, const Array &_b)
+        {
+          for (std::size_t i = 0; i < N; ++i)
+            _out[i] = _a[i] * _s + _b[i];
+        }
+
+        /// \brief Per component product plus a vector.
+        /// \param[out] _out _a * _b + _c
+        /// \param[in] _a The first factor.
+        /// \param[in] _b The second factor.
+        /// \param[in] _c The vector to add.
+        static constexpr void MultiplyAdd(Array &_out, const Array &_a,
+                                          const Array &_b, const Array &_c)
+        {
+          for (std::size_t i = 0; i < N; ++i)
+            _out[i] = _a[i] * _b[i] + _c[i];
+        }
+
+        /// \brief Per component maximum, as std::max(_v[i], _a[i]).
+        /// \param[in,out] _a The vector to update.
+        /// \param[in] _v The other vector.
+        static constexpr void Max(Array &_a, const Array &_v)
+        {
+          for (std::size_t i = 0; i < N; ++i)
+            _a[i] = std::max(_v[i], _a[i]);
+        }
+
+        /// \brief Per component minimum, as std::min(_v[i], _a[i]).
+        /// \param[in,out] _a The vector to update.
+        /// \param[in] _v The other vector.
+        static constexpr void Min(Array &_a, const Array &_v)
+        {
+          for (std::size_t i = 0; i < N; ++i)
+            _a[i] = std::min(_v[i], _a[i]);
+        }
+
+        /// \brief Largest component.
+        /// \param[in] _a The vector.
+        /// \return The first of the largest components.
+        static constexpr T MaxElement(const Array &_a)
+        {
+          T result = _a[0];
+          for (std::size_t i = 1; i < N; ++i)
+            result = std::max(result, _a[i]);
+          return result;
+        }
+
+        /// \brief Smallest component.
+        /// \param[in] _a The vector.
+        /// \return The first of the smallest components.
+        static constexpr T MinElement(const Array &_a)
+        {
+          T result = _a[0];
+          for (std::size_t i = 1; i < N; ++i)
+            result = std::min(result, _a[i]);
+          return result;
+        }
+
+        /// \brief Largest absolute value of the components.
+        /// \param[in] _a The vector.
+        /// \return The largest absolute value.
+        static T MaxAbs(const Array &_a)
+        {
+          T result = std::abs(_a[0]);
+          for (std::size_t i = 1; i < N; ++i)
+            result = std::max(result, std::abs(_a[i]));
+          return result;
+        }
+
+        /// \brief Smallest absolute value of the components.
+        /// \param[in] _a The vector.
+        /// \return The smallest absolute value.
+        static T MinAbs(const Array &_a)
+        {
+          T result = std::abs(_a[0]);
+          for (std::size_t i = 1; i < N; ++i)
+            result = std::min(result, std::abs(_a[i]));
+          return result;
+        }
+
+        /// \brief Round each component to the nearest integer, with the
+        /// current rounding mode.
+        /// \param[in,out] _a The vector.
+        static void Round(Array &_a)
+        {
+          for (std::size_t i = 0; i < N; ++i)
+            _a[i] = static_cast<T>(std::nearbyint(_a[i]));
+        }
+
+        /// \brief Round each component to a number of decimal places.
+        /// \param[in,out] _a The vector.
+        /// \param[in] _precision The number of decimal places.
+        static void Round(Array &_a, const int _precision)
+        {
+          for (std::size_t i = 0; i < N; ++i)
+            _a[i] = precision(_a[i], _precision);
+        }
+
+        /// \brief Check that the components are equal within a tolerance.
+        /// \param[in] _a The first vector.
+        /// \param[in] _b The second vector.
+        /// \param[in] _tol The tolerance.
+        /// \return True if equal<T>(_a[i], _b[i], _tol) for each component.
+        static bool Equal(const Array &_a, const Array &_b, const T &_tol)
+        {
+          for (std::size_t i = 0; i < N; ++i)
+          {
+            if (!equal<T>(_a[i], _b[i], _tol))
+              return false;
+          }
+          return true;
+        }
+
+        /// \brief Check that the components are finite.
+        /// \param[in] _a The vector.
+        /// \return True if no component is infinite or NaN.
+        static bool IsFinite(const Array &_a)
+        {
+          // std::isfinite works with floating point values,
+          // need to explicit cast to avoid ambiguity in vc++.
+          for (std::size_t i = 0; i < N; ++i)
+          {
+            if (!std::isfinite(static_cast<double>(_a[i])))
+              return false;
+          }
+          return true;
+        }
+
+        /// \brief Set the components that are not finite to zero.
+        /// \param[in,out] _a The vector.
+        static void Correct(Array &_a)
+        {
+          for (std::size_t i = 0; i < N; ++i)
+          {
+            if (!std::isfinite(static_cast<double>(_a[i])))
+              _a[i] = 0;
+          }
+        }
+      };
+    }  // namespace detail
+    }
+  }
+}
+
+#endif
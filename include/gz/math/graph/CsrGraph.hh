@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_GRAPH_CSRGRAPH_HH_
+#define GZ_MATH_GRAPH_CSRGRAPH_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+#include <gz/math/config.hh>
+#include "gz/math/graph/Graph.hh"
+
+namespace gz
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_MATH_VERSION_NAMESPACE {
+namespace graph
+{
+  /// \brief A read-only snapshot of the topology and edge weights of a
+  /// Graph, stored in compressed sparse row (CSR) form.
+  ///
+  /// Vertices are relabeled to dense indices from 0 to VertexCount() - 1,
+  /// in increasing order of their Ids. The outgoing edges of the vertex
+  /// with index i are the entries Offsets()[i] to Offsets()[i + 1] - 1 of
+  /// Neighbors() and Weights(), sorted by neighbor index. The incoming
+  /// edges are stored in the same way in InOffsets(), InNeighbors() and
+  /// InWeights(). Undirected edges are stored once in each direction.
+  /// Traversals over this layout read contiguous arrays instead of
+  /// following tree nodes, so graphs that are queried often but rarely
+  /// modified should be frozen once with Freeze() and queried with the
+  /// CsrGraph overloads of the functions in GraphAlgorithms.hh.
+  ///
+  /// A CsrGraph does not follow changes made to the graph afterwards.
+  ///
+  /// <b> Example</b>
+  ///
+  /// \code{.cpp}
+  /// auto frozen = gz::math::graph::Freeze(graph);
+  /// auto costs = gz::math::graph::Dijkstra(frozen, 0);
+  /// \endcode
+  class CsrGraph
+  {
+    /// \brief Index returned for Ids that are not in the graph.
+    public: static constexpr std::size_t kNullIndex =
+      std::numeric_limits<std::size_t>::max();
+
+    /// \brief Default constructor, an empty graph.
+    public: CsrGraph() = default;
+
+    /// \brief Constructor, takes a snapshot of a graph.
+    /// \param[in] _graph The graph.
+    public: template<typename V, typename E, typename EdgeType,
+                     typename Storage>
+    explicit CsrGraph(const Graph<V, E, EdgeType, Storage> &_graph)
+    {
+      const auto vertices = _graph.Vertices();
+      this->ids.reserve(vertices.size());
+      for (auto const &v : vertices)
+        this->ids.push_back(v.first);
+
+      // Gather the outgoing edges of each vertex, then sort them by
+      // neighbor so that traversals visit neighbors in Id order, as the
+      // Graph versions do.
+      std::vector<std::tuple<std::size_t, double>> arcs;
+      this->offsets.reserve(this->ids.size() + 1);
+      for (const VertexId &id : this->ids)
+      {
+        arcs.clear();
+        for (auto const &edgePair : _graph.IncidentsFrom(id))
+        {
+          const auto &edge = edgePair.second.get();
+          arcs.emplace_back(this->Index(edge.From(id)), edge.Weight());
+        }
+        std::stable_sort(arcs.begin(), arcs.end(),
+          [](const auto &_a, const auto &_b)
+          {
+            return std::get<0>(_a) < std::get<0>(_b);
+          });
+        for (auto const &arc : arcs)
+        {
+          this->neighbors.push_back(std::get<0>(arc));
+          this->weights.push_back(std::get<1>(arc));
+        }
+        this->offsets.push_back(this->neighbors.size());
+      }
+
+      // The incoming edges are the outgoing ones grouped by destination
+      this->inOffsets.assign(this->ids.size() + 1, 0);
+      for (const std::size_t v : this->neighbors)
+        ++this->inOffsets[v + 1];
+      for (std::size_t v = 0; v < this->ids.size(); ++v)
+        this->inOffsets[v + 1] += this->inOffsets[v];
+      this->inNeighbors.resize(this->neighbors.size());
+      this->inWeights.resize(this->neighbors.size());
+      std::vector<std::size_t> next(this->inOffsets.begin(),
+        this->inOffsets.end() - 1);
+      for (std::size_t u = 0; u < this->ids.size(); ++u)
+      {
+        for (std::size_t e = this->offsets[u]; e < this->offsets[u + 1]; ++e)
+        {
+          const std::size_t pos = next[this->neighbors[e]]++;
+          this->inNeighbors[pos] = u;
+          this->inWeights[pos] = this->weights[e];
+        }
+      }
+    }
+
+    /// \brief Get the number of vertices.
+    /// \return Number of vertices.
+    public: std::size_t VertexCount() const
+    {
+      return this->ids.size();
+    }
+
+    /// \brief Get the number of stored edges. Undirected edges count twice,
+    /// once in each direction.
+    /// \return Number of entries of Neighbors().
+    public: std::size_t EdgeCount() const
+    {
+      return this->neighbors.size();
+    }
+
+    /// \brief Get the dense index of a vertex.
+    /// \param[in] _id Id of the vertex.
+    /// \return The index of the vertex, or kNullIndex if it is not in the
+    /// graph.
+    public: std::size_t Index(const VertexId &_id) const
+    {
+      auto it = std::lower_bound(this->ids.begin(), this->ids.end(), _id);
+      if (it == this->ids.end() || *it != _id)
+        return kNullIndex;
+      return static_cast<std::size_t>(it - this->ids.begin());
+    }
+
+    /// \brief Get the Id of a vertex.
+    /// \param[in] _index Dense index of the vertex, less than VertexCount().
+    /// \return The Id of the vertex in the original graph.
+    public: VertexId Id(const std::size_t _index) const
+    {
+      return this->ids[_index];
+    }
+
+    /// \brief Get the number of outgoing edges of a vertex.
+    /// \param[in] _index Dense index of the vertex, less than VertexCount().
+    /// \return Number of outgoing edges.
+    public: std::size_t OutDegree(const std::size_t _index) const
+    {
+      return this->offsets[_index + 1] - this->offsets[_index];
+    }
+
+    /// \brief Get the Ids of all vertices, indexed by dense index.
+    /// \return The sorted Ids.
+    public: const std::vector<VertexId> &Ids() const
+    {
+      return this->ids;
+    }
+
+    /// \brief Get the start of the outgoing edges of each vertex.
+    /// \return VertexCount() + 1 offsets into Neighbors() and Weights().
+    public: const std::vector<std::size_t> &Offsets() const
+    {
+      return this->offsets;
+    }
+
+    /// \brief Get the destination of each edge.
+    /// \return Dense index of the vertex each edge leads to.
+    public: const std::vector<std::size_t> &Neighbors() const
+    {
+      return this->neighbors;
+    }
+
+    /// \brief Get the weight of each edge.
+    /// \return Weight of each edge.
+    public: const std::vector<double> &Weights() const
+    {
+      return this->weights;
+    }
+
+    /// \brief Get the start of the incoming edges of each vertex.
+    /// \return VertexCount() + 1 offsets into InNeighbors() and
+    /// InWeights().
+    public: const std::vector<std::size_t> &InOffsets() const
+    {
+      return this->inOffsets;
+    }
+
+    /// \brief Get the source of each incoming edge, grouped by destination
+    /// and sorted by source index.
+    /// \return Dense index of the vertex each incoming edge comes from.
+    public: const std::vector<std::size_t> &InNeighbors() const
+    {
+      return this->inNeighbors;
+    }
+
+    /// \brief Get the weight of each incoming edge.
+    /// \return Weight of each incoming edge.
+    public: const std::vector<double> &InWeights() const
+    {
+      return this->inWeights;
+    }
+
+    /// \brief Vertex Ids, sorted, indexed by dense index.
+    private: std::vector<VertexId> ids;
+
+    /// \brief Start of the edges of each vertex, plus one past the end.
+    private: std::vector<std::size_t> offsets{0};
+
+    /// \brief Destination of each edge.
+    private: std::vector<std::size_t> neighbors;
+
+    /// \brief Weight of each edge.
+    private: std::vector<double> weights;
+
+    /// \brief Start of the incoming edges of each vertex, plus one past the
+    /// end.
+    private: std::vector<std::size_t> inOffsets{0};
+
+    /// \brief Source of each incoming edge.
+    private: std::vector<std::size_t> inNeighbors;
+
+    /// \brief Weight of each incoming edge.
+    private: std::vector<double> inWeights;
+  };
+
+  /// \brief Take a compressed sparse row snapshot of a graph for fast
+  /// traversals.
+  /// \param[in] _graph A graph.
+  /// \return The snapshot.
+  template<typename V, typename E, typename EdgeType, typename Storage>
+  CsrGraph Freeze(const Graph<V, E, EdgeType, Storage> &_graph)
+  {
+    return CsrGraph(_graph);
+  }
+}
+}
+}
+}
+#endif
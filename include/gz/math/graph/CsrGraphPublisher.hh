@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_GRAPH_CSRGRAPHPUBLISHER_HH_
+#define GZ_MATH_GRAPH_CSRGRAPHPUBLISHER_HH_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include <gz/math/config.hh>
+#include "gz/math/graph/CsrGraph.hh"
+#include "gz/math/graph/Graph.hh"
+
+namespace gz
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_MATH_VERSION_NAMESPACE {
+namespace graph
+{
+  /// \brief Shares the latest snapshot of a graph that is being edited
+  /// with threads that query it.
+  ///
+  /// The writer edits its Graph as usual, a batch of changes at a time,
+  /// and publishes a new CsrGraph snapshot after each batch. Readers get
+  /// the latest snapshot with Snapshot() and query it with the CsrGraph
+  /// overloads of GraphAlgorithms.hh, without taking any lock around the
+  /// graph. A snapshot is never modified once published, so a reader sees
+  /// a consistent graph for as long as it keeps the pointer, and the
+  /// memory of a snapshot is released when its last reader drops it.
+  /// Publishing only swaps a pointer, so writers never wait for readers.
+  ///
+  /// Publish() and Snapshot() can be called from any thread. Edits of the
+  /// Graph itself must still be serialized by the writers.
+  ///
+  /// <b> Example</b>
+  ///
+  /// \code{.cpp}
+  /// gz::math::graph::CsrGraphPublisher roads(graph);
+  /// // Writer thread, after a batch of traffic updates
+  /// graph.RemoveEdge(edgeId);
+  /// graph.AddEdge({from, to}, data, newWeight);
+  /// roads.Publish(graph);
+  /// // Query threads
+  /// auto snapshot = roads.Snapshot();
+  /// auto costs = gz::math::graph::Dijkstra(*snapshot, from);
+  /// \endcode
+  class CsrGraphPublisher
+  {
+    /// \brief Default constructor, publishes an empty graph.
+    public: CsrGraphPublisher()
+      : snapshot(std::make_shared<const CsrGraph>())
+    {
+    }
+
+    /// \brief Constructor, publishes a first snapshot of a graph.
+    /// \param[in] _graph The graph.
+    public: template<typename V, typename E, typename EdgeType,
+                     typename Storage>
+    explicit CsrGraphPublisher(const Graph<V, E, EdgeType, Storage> &_graph)
+      : snapshot(std::make_shared<const CsrGraph>(_graph))
+    {
+    }
+
+    /// \brief Get the latest published snapshot.
+    /// \return The snapshot. It stays valid and unchanged while it is
+    /// held, whatever is published afterwards.
+    public: std::shared_ptr<const CsrGraph> Snapshot() const
+    {
+      return std::atomic_load(&this->snapshot);
+    }
+
+    /// \brief Publish a snapshot of a graph, replacing the previous one
+    /// for the next calls to Snapshot().
+    /// \param[in] _graph The graph.
+    /// \return Number of snapshots published so far, see Epoch().
+    public: template<typename V, typename E, typename EdgeType,
+                     typename Storage>
+    std::uint64_t Publish(const Graph<V, E, EdgeType, Storage> &_graph)
+    {
+      return this->Publish(CsrGraph(_graph));
+    }
+
+    /// \brief Publish a snapshot taken earlier, such as one built by
+    /// another thread.
+    /// \param[in] _snapshot The snapshot.
+    /// \return Number of snapshots published so far, see Epoch().
+    public: std::uint64_t Publish(CsrGraph &&_snapshot)
+    {
+      std::atomic_store(&this->snapshot,
+        std::shared_ptr<const CsrGraph>(
+          std::make_shared<const CsrGraph>(std::move(_snapshot))));
+      return ++this->epoch;
+    }
+
+    /// \brief Get the number of snapshots published since construction,
+    /// not counting the first one. It can be polled to find out whether
+    /// a held snapshot is out of date.
+    /// \return The number of calls to Publish().
+    public: std::uint64_t Epoch() const
+    {
+      return this->epoch.load();
+    }
+
+    /// \brief Latest snapshot, only accessed with the atomic shared_ptr
+    /// functions.
+    private: std::shared_ptr<const CsrGraph> snapshot;
+
+    /// \brief Number of calls to Publish().
+    private: std::atomic<std::uint64_t> epoch{0};
+  };
+}
+}
+}
+}
+#endif
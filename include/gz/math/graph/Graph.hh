@@ -17,16 +17,25 @@
 #ifndef GZ_MATH_GRAPH_GRAPH_HH_
 #define GZ_MATH_GRAPH_GRAPH_HH_
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <map>
+#include <memory_resource>
 #include <set>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include <gz/math/config.hh>
 #include "gz/math/graph/Edge.hh"
+#include "gz/math/graph/GraphStorage.hh"
 #include "gz/math/graph/Vertex.hh"
 
 namespace gz
@@ -97,35 +106,73 @@ namespace graph
   ///   {
   ///     {{2, 3}, 6.3, 1.1}, {{3, 4}, 4.2, 2.3}
   ///   });
+  ///
+  /// // Ids handed out by the graph are small, so a SlotMapStorage graph
+  /// // finds vertices and edges by Id in constant time.
+  /// gz::math::graph::DirectedGraph<int, double,
+  ///   gz::math::graph::SlotMapStorage> graph5;
+  ///
+  /// // A PmrStorage graph allocates from a memory resource, here an arena
+  /// // that is released at once when it goes out of scope.
+  /// std::pmr::monotonic_buffer_resource arena;
+  /// gz::math::graph::DirectedGraph<int, double,
+  ///   gz::math::graph::PmrStorage> graph6(&arena);
   /// \endcode
-  template<typename V, typename E, typename EdgeType>
+  ///
+  /// \tparam V Type of the data stored in the vertices.
+  /// \tparam E Type of the data stored in the edges.
+  /// \tparam EdgeType Type of the edges, DirectedEdge or UndirectedEdge.
+  /// \tparam Storage Containers of the vertices, edges and adjacency lists,
+  /// MapStorage (the default), SlotMapStorage or PmrStorage.
+  template<typename V, typename E, typename EdgeType,
+           typename Storage = MapStorage>
   class Graph
   {
+    /// \brief A set of edge Ids, the adjacency list of a vertex.
+    private: using AdjacencySet = typename Storage::template Set<EdgeId>;
+
     /// \brief Default constructor.
     public: Graph() = default;
 
     /// \brief Constructor.
+    /// The graph is the same as adding each vertex with AddVertex() and
+    /// then each edge with AddEdge(), but when all the vertices have an Id
+    /// they are sorted once and every element is appended at the end of
+    /// the containers, which is much faster for large graphs.
     /// \param[in] _vertices Collection of vertices.
     /// \param[in] _edges Collection of edges.
     public: Graph(const std::vector<Vertex<V>> &_vertices,
                   const std::vector<EdgeInitializer<E>> &_edges)
     {
-      // Add all vertices.
-      for (auto const &v : _vertices)
-      {
-        if (!this->AddVertex(v.Name(), v.Data(), v.Id()).Valid())
-        {
-          std::cerr << "Invalid vertex with Id [" << v.Id() << "]. Ignoring."
-                    << std::endl;
-        }
-      }
+      this->Build(_vertices, _edges);
+    }
 
-      // Add all edges.
-      for (auto const &e : _edges)
-      {
-        if (!this->AddEdge(e.vertices, e.data, e.weight).Valid())
-          std::cerr << "Ignoring edge" << std::endl;
-      }
+    /// \brief Constructor of an empty graph whose containers allocate from
+    /// a memory resource. Only available with PmrStorage.
+    /// \param[in] _resource The memory resource. It must outlive the graph.
+    public: template<typename S = Storage,
+                     typename = std::enable_if_t<S::kMemoryResource>>
+    explicit Graph(std::pmr::memory_resource *_resource)
+      : vertices(_resource), edges(_resource), adjList(_resource),
+        names(_resource)
+    {
+    }
+
+    /// \brief Constructor whose containers allocate from a memory
+    /// resource, see Graph(const std::vector<Vertex<V>> &,
+    /// const std::vector<EdgeInitializer<E>> &). Only available with
+    /// PmrStorage.
+    /// \param[in] _vertices Collection of vertices.
+    /// \param[in] _edges Collection of edges.
+    /// \param[in] _resource The memory resource. It must outlive the graph.
+    public: template<typename S = Storage,
+                     typename = std::enable_if_t<S::kMemoryResource>>
+    Graph(const std::vector<Vertex<V>> &_vertices,
+          const std::vector<EdgeInitializer<E>> &_edges,
+          std::pmr::memory_resource *_resource)
+      : Graph(_resource)
+    {
+      this->Build(_vertices, _edges);
     }
 
     /// \brief Add a new vertex to the graph.
@@ -167,7 +214,7 @@ namespace graph
       }
 
       // Link the vertex with an empty list of edges.
-      this->adjList[id] = EdgeId_S();
+      this->adjList[id] = AdjacencySet();
 
       // Update the map of names.
       this->names.insert(std::make_pair(_name, id));
@@ -187,6 +234,16 @@ namespace graph
       return res;
     }
 
+    /// \brief Call a function for each vertex of the graph, in Id order.
+    /// Unlike Vertices(), this doesn't build a map.
+    /// \param[in] _fn Function called with a reference to each vertex.
+    public: template<typename F>
+    void ForEachVertex(F _fn) const
+    {
+      for (auto const &v : this->vertices)
+        _fn(v.second);
+    }
+
     /// \brief The collection of all vertices in the graph with name == _name.
     /// \return A map of vertices, where keys are Ids and values are
     /// references to the vertices.
@@ -274,6 +331,240 @@ namespace graph
       return res;
     }
 
+    /// \brief A view of the edges connected to a vertex in one direction,
+    /// or of the vertices at their other end, that reads the graph's
+    /// adjacency list without allocating. Elements are pairs of an Id and a
+    /// reference, like the entries of the maps returned by IncidentsFrom,
+    /// IncidentsTo, AdjacentsFrom and AdjacentsTo. Unlike those maps,
+    /// elements are visited in order of edge Id, and a vertex connected by
+    /// several edges is visited once per edge.
+    ///
+    /// A view is invalidated by any change to the graph.
+    /// \tparam VertexElements True to visit the vertices at the other end
+    /// of the edges, false to visit the edges.
+    public: template<bool VertexElements>
+    class NeighborView
+    {
+      /// \brief Type of the elements.
+      public: using value_type = std::conditional_t<VertexElements,
+        std::pair<VertexId, std::reference_wrapper<const Vertex<V>>>,
+        std::pair<EdgeId, std::reference_wrapper<const EdgeType>>>;
+
+      /// \brief Forward iterator over the elements.
+      public: class Iterator
+      {
+        /// \brief Iterator category.
+        public: using iterator_category = std::forward_iterator_tag;
+
+        /// \brief Type of the elements.
+        public: using value_type = NeighborView::value_type;
+
+        /// \brief Type of the distance between iterators.
+        public: using difference_type = std::ptrdiff_t;
+
+        /// \brief Elements are returned by value.
+        public: using pointer = void;
+
+        /// \brief Elements are returned by value.
+        public: using reference = value_type;
+
+        /// \brief Constructor.
+        /// \param[in] _view The view iterated.
+        /// \param[in] _it Position in the adjacency list of the vertex.
+        public: Iterator(const NeighborView *_view,
+                         typename AdjacencySet::const_iterator _it)
+          : view(_view), it(_it)
+        {
+          this->Skip();
+        }
+
+        /// \brief Get the current element.
+        /// \return A pair of an Id and a reference.
+        public: value_type operator*() const
+        {
+          if constexpr (VertexElements)
+          {
+            const VertexId id = this->view->Neighbor(*this->edge);
+            return value_type(id, std::cref(
+              this->view->graph->vertices.find(id)->second));
+          }
+          else
+          {
+            return value_type(this->edge->Id(), std::cref(*this->edge));
+          }
+        }
+
+        /// \brief Move to the next element.
+        /// \return This iterator.
+        public: Iterator &operator++()
+        {
+          ++this->it;
+          this->Skip();
+          return *this;
+        }
+
+        /// \brief Equality operator.
+        /// \param[in] _other Iterator to compare to.
+        /// \return True if both iterators are at the same position.
+        public: bool operator==(const Iterator &_other) const
+        {
+          return this->it == _other.it;
+        }
+
+        /// \brief Inequality operator.
+        /// \param[in] _other Iterator to compare to.
+        /// \return True if the iterators are at different positions.
+        public: bool operator!=(const Iterator &_other) const
+        {
+          return this->it != _other.it;
+        }
+
+        /// \brief Skip edges that do not go in the direction of the view.
+        /// Removing a directed edge leaves its Id in the adjacency list of
+        /// its head, so those are skipped too.
+        private: void Skip()
+        {
+          const auto &edges = this->view->graph->edges;
+          for (; this->it != this->view->edgeIds->end(); ++this->it)
+          {
+            auto edgeIt = edges.find(*this->it);
+            if (edgeIt != edges.end() &&
+                this->view->Neighbor(edgeIt->second) != kNullId)
+            {
+              this->edge = &edgeIt->second;
+              return;
+            }
+          }
+        }
+
+        /// \brief The view iterated.
+        private: const NeighborView *view;
+
+        /// \brief Position in the adjacency list of the vertex.
+        private: typename AdjacencySet::const_iterator it;
+
+        /// \brief The edge at the current position.
+        private: const EdgeType *edge{nullptr};
+      };
+
+      /// \brief Constructor.
+      /// \param[in] _graph The graph.
+      /// \param[in] _vertex Id of the vertex.
+      /// \param[in] _outgoing True for edges from the vertex, false for
+      /// edges to the vertex.
+      public: NeighborView(const Graph *_graph, const VertexId &_vertex,
+                           const bool _outgoing)
+        : graph(_graph), vertex(_vertex), outgoing(_outgoing)
+      {
+        static const AdjacencySet kEmpty;
+        auto adjIt = this->graph->adjList.find(_vertex);
+        this->edgeIds =
+          adjIt == this->graph->adjList.end() ? &kEmpty : &adjIt->second;
+      }
+
+      /// \brief Get an iterator to the first element.
+      /// \return The iterator.
+      public: Iterator begin() const
+      {
+        return Iterator(this, this->edgeIds->begin());
+      }
+
+      /// \brief Get an iterator past the last element.
+      /// \return The iterator.
+      public: Iterator end() const
+      {
+        return Iterator(this, this->edgeIds->end());
+      }
+
+      /// \brief Get whether there are no elements.
+      /// \return True if there are no elements.
+      public: bool Empty() const
+      {
+        return this->begin() == this->end();
+      }
+
+      /// \brief Count the elements, in linear time.
+      /// \return Number of elements.
+      public: std::size_t Size() const
+      {
+        std::size_t count = 0;
+        for (auto it = this->begin(); it != this->end(); ++it)
+          ++count;
+        return count;
+      }
+
+      /// \brief Get the vertex at the other end of an edge.
+      /// \param[in] _edge An edge of the vertex.
+      /// \return Id of the other vertex, or kNullId if the edge does not go
+      /// in the direction of the view.
+      private: VertexId Neighbor(const EdgeType &_edge) const
+      {
+        return this->outgoing ?
+          _edge.From(this->vertex) : _edge.To(this->vertex);
+      }
+
+      /// \brief The graph.
+      private: const Graph *graph;
+
+      /// \brief Id of the vertex.
+      private: VertexId vertex;
+
+      /// \brief True for edges from the vertex.
+      private: bool outgoing;
+
+      /// \brief Ids of the edges of the vertex.
+      private: const AdjacencySet *edgeIds;
+    };
+
+    /// \brief A view of the edges connected to a vertex, see NeighborView.
+    public: using EdgeView = NeighborView<false>;
+
+    /// \brief A view of the vertices connected to a vertex, see
+    /// NeighborView.
+    public: using VertexView = NeighborView<true>;
+
+    /// \brief Get the vertices that are directly connected with one edge
+    /// from a given vertex, without allocating. This visits the same
+    /// vertices as AdjacentsFrom, once per edge.
+    /// \param[in] _vertex The Id of the vertex.
+    /// \return A view of the adjacent vertices. It is empty when the
+    /// _vertex is not found in the graph.
+    public: VertexView AdjacentsFromView(const VertexId &_vertex) const
+    {
+      return VertexView(this, _vertex, true);
+    }
+
+    /// \brief Get the vertices that are directly connected with one edge
+    /// to a given vertex, without allocating. This visits the same vertices
+    /// as AdjacentsTo, once per edge.
+    /// \param[in] _vertex The Id of the vertex.
+    /// \return A view of the adjacent vertices. It is empty when the
+    /// _vertex is not found in the graph.
+    public: VertexView AdjacentsToView(const VertexId &_vertex) const
+    {
+      return VertexView(this, _vertex, false);
+    }
+
+    /// \brief Get the outgoing edges from a given vertex, without
+    /// allocating. This visits the same edges as IncidentsFrom.
+    /// \param[in] _vertex The Id of the vertex.
+    /// \return A view of the edges. It is empty when the _vertex is not
+    /// found in the graph.
+    public: EdgeView IncidentsFromView(const VertexId &_vertex) const
+    {
+      return EdgeView(this, _vertex, true);
+    }
+
+    /// \brief Get the incoming edges to a given vertex, without
+    /// allocating. This visits the same edges as IncidentsTo.
+    /// \param[in] _vertex The Id of the vertex.
+    /// \return A view of the edges. It is empty when the _vertex is not
+    /// found in the graph.
+    public: EdgeView IncidentsToView(const VertexId &_vertex) const
+    {
+      return EdgeView(this, _vertex, false);
+    }
+
     /// \brief Get all vertices that are directly connected with one edge
     /// from a given vertex. In other words, this function will return
     /// child vertices of the given vertex (all vertices from the given
@@ -292,23 +583,8 @@ namespace graph
     public: VertexRef_M<V> AdjacentsFrom(const VertexId &_vertex) const
     {
       VertexRef_M<V> res;
-
-      // Make sure the vertex exists
-      auto vertexIt = this->adjList.find(_vertex);
-      if (vertexIt == this->adjList.end())
-        return res;
-
-      for (auto const &edgeId : vertexIt->second)
-      {
-        const auto &edge = this->EdgeFromId(edgeId);
-        auto neighborVertexId = edge.From(_vertex);
-        if (neighborVertexId != kNullId)
-        {
-          const auto &neighborVertex = this->VertexFromId(neighborVertexId);
-          res.emplace(
-            std::make_pair(neighborVertexId, std::cref(neighborVertex)));
-        }
-      }
+      for (auto const &adj : this->AdjacentsFromView(_vertex))
+        res.emplace(adj);
 
       return res;
     }
@@ -350,18 +626,9 @@ namespace graph
     /// adjacent vertices.
     public: VertexRef_M<V> AdjacentsTo(const VertexId &_vertex) const
     {
-      auto incidentEdges = this->IncidentsTo(_vertex);
-
       VertexRef_M<V> res;
-      for (auto const &incidentEdgeRef : incidentEdges)
-      {
-        const auto &incidentEdgeId = incidentEdgeRef.first;
-        const auto &incidentEdge = this->EdgeFromId(incidentEdgeId);
-        const auto &neighborVertexId = incidentEdge.To(_vertex);
-        const auto &neighborVertex = this->VertexFromId(neighborVertexId);
-        res.emplace(
-            std::make_pair(neighborVertexId, std::cref(neighborVertex)));
-      }
+      for (auto const &adj : this->AdjacentsToView(_vertex))
+        res.emplace(adj);
 
       return res;
     }
@@ -391,7 +658,7 @@ namespace graph
     /// \return The number of edges incidents to a vertex.
     public: size_t InDegree(const VertexId &_vertex) const
     {
-      return this->IncidentsTo(_vertex).size();
+      return this->IncidentsToView(_vertex).Size();
     }
 
     /// \brief Get the number of edges incident to a vertex.
@@ -399,7 +666,7 @@ namespace graph
     /// \return The number of edges incidents to a vertex.
     public: size_t InDegree(const Vertex<V> &_vertex) const
     {
-      return this->IncidentsTo(this->VertexFromId(_vertex.Id())).size();
+      return this->IncidentsToView(_vertex.Id()).Size();
     }
 
     /// \brief Get the number of edges incident from a vertex.
@@ -407,7 +674,7 @@ namespace graph
     /// \return The number of edges incidents from a vertex.
     public: size_t OutDegree(const VertexId &_vertex) const
     {
-      return this->IncidentsFrom(_vertex).size();
+      return this->IncidentsFromView(_vertex).Size();
     }
 
     /// \brief Get the number of edges incident from a vertex.
@@ -415,7 +682,7 @@ namespace graph
     /// \return The number of edges incidents from a vertex.
     public: size_t OutDegree(const Vertex<V> &_vertex) const
     {
-      return this->IncidentsFrom(this->VertexFromId(_vertex.Id())).size();
+      return this->IncidentsFromView(_vertex.Id()).Size();
     }
 
     /// \brief Get the set of outgoing edges from a given vertex.
@@ -427,18 +694,8 @@ namespace graph
       const
     {
       EdgeRef_M<EdgeType> res;
-
-      const auto &adjIt = this->adjList.find(_vertex);
-      if (adjIt == this->adjList.end())
-        return res;
-
-      const auto &edgeIds = adjIt->second;
-      for (auto const &edgeId : edgeIds)
-      {
-        const auto &edge = this->EdgeFromId(edgeId);
-        if (edge.From(_vertex) != kNullId)
-          res.emplace(std::make_pair(edge.Id(), std::cref(edge)));
-      }
+      for (auto const &incident : this->IncidentsFromView(_vertex))
+        res.emplace(incident);
 
       return res;
     }
@@ -463,18 +720,8 @@ namespace graph
                 const VertexId &_vertex) const
     {
       EdgeRef_M<EdgeType> res;
-
-      const auto &adjIt = this->adjList.find(_vertex);
-      if (adjIt == this->adjList.end())
-        return res;
-
-      const auto &edgeIds = adjIt->second;
-      for (auto const &edgeId : edgeIds)
-      {
-        const auto &edge = this->EdgeFromId(edgeId);
-        if (edge.To(_vertex) != kNullId)
-          res.emplace(std::make_pair(edge.Id(), std::cref(edge)));
-      }
+      for (auto const &incident : this->IncidentsToView(_vertex))
+        res.emplace(incident);
 
       return res;
     }
@@ -641,8 +888,7 @@ namespace graph
                 const VertexId _sourceId, const VertexId _destId) const
     {
       // Get the adjacency iterator for the source vertex.
-      const typename std::map<VertexId, EdgeId_S>::const_iterator &adjIt =
-        this->adjList.find(_sourceId);
+      const auto adjIt = this->adjList.find(_sourceId);
 
       // Quit early if there is no adjacency entry
       if (adjIt == this->adjList.end())
@@ -653,8 +899,7 @@ namespace graph
            edgIt != adjIt->second.end(); ++edgIt)
       {
         // Get an iterator to the actual edge
-        const typename std::map<EdgeId, EdgeType>::const_iterator edgeIter =
-          this->edges.find(*edgIt);
+        const auto edgeIter = this->edges.find(*edgIt);
 
         // Check if the edge has the correct source and destination.
         if (edgeIter != this->edges.end() &&
@@ -681,14 +926,410 @@ namespace graph
       return iter->second;
     }
 
+    /// \brief Write the graph in a compact binary format that Load() can
+    /// read back, for instance from a MemoryMappedFile. Vertex and edge
+    /// data are stored as raw bytes, so V and E must be trivially copyable.
+    /// The format uses native byte order, so it may only be loaded on a
+    /// machine with the same byte order and with the same V, E and
+    /// EdgeType.
+    /// \param[out] _out Stream to write to. It should be opened in binary
+    /// mode.
+    /// \return True if the graph was written.
+    public: bool Save(std::ostream &_out) const
+    {
+      static_assert(std::is_trivially_copyable_v<V>,
+        "Vertex data must be trivially copyable");
+      static_assert(std::is_trivially_copyable_v<E>,
+        "Edge data must be trivially copyable");
+
+      FileHeader header{};
+      std::memcpy(header.magic, kFileMagic, sizeof(header.magic));
+      header.byteOrder = kFileByteOrder;
+      header.version = kFileVersion;
+      header.vertexDataSize = sizeof(V);
+      header.edgeDataSize = sizeof(E);
+      header.directed = kDirected;
+      header.numVertices = this->vertices.size();
+      header.numEdges = this->edges.size();
+      header.nextVertexId = this->nextVertexId;
+      header.nextEdgeId = this->nextEdgeId;
+
+      std::vector<std::uint64_t> ids;
+      std::vector<std::uint64_t> nameOffsets{0};
+      std::vector<V> vertexData;
+      std::string nameBuffer;
+      ids.reserve(this->vertices.size());
+      nameOffsets.reserve(this->vertices.size() + 1);
+      vertexData.reserve(this->vertices.size());
+      for (auto const &v : this->vertices)
+      {
+        ids.push_back(v.first);
+        vertexData.push_back(v.second.Data());
+        nameBuffer += v.second.Name();
+        nameOffsets.push_back(nameBuffer.size());
+      }
+      header.namesSize = nameBuffer.size();
+
+      std::vector<FileEdge> edgeRecords;
+      std::vector<E> edgeData;
+      edgeRecords.reserve(this->edges.size());
+      edgeData.reserve(this->edges.size());
+      for (auto const &e : this->edges)
+      {
+        const VertexId_P ends = e.second.Vertices();
+        edgeRecords.push_back({e.first, ends.first, ends.second,
+          e.second.Weight()});
+        edgeData.push_back(e.second.Data());
+      }
+
+      const char padding[kFileAlignment] = {};
+      auto write = [&](const void *_data, const std::size_t _size)
+      {
+        _out.write(static_cast<const char *>(_data),
+          static_cast<std::streamsize>(_size));
+        _out.write(padding,
+          static_cast<std::streamsize>(Padded(_size) - _size));
+      };
+
+      write(&header, sizeof(header));
+      write(ids.data(), ids.size() * sizeof(std::uint64_t));
+      write(nameOffsets.data(), nameOffsets.size() * sizeof(std::uint64_t));
+      write(vertexData.data(), vertexData.size() * sizeof(V));
+      write(edgeRecords.data(), edgeRecords.size() * sizeof(FileEdge));
+      write(edgeData.data(), edgeData.size() * sizeof(E));
+      write(nameBuffer.data(), nameBuffer.size());
+      return _out.good();
+    }
+
+    /// \brief Replace this graph with one written by Save(). Vertices and
+    /// edges keep their Ids, and Ids handed out afterwards are the same as
+    /// in the saved graph. The elements are appended in Id order, as in the
+    /// bulk constructor.
+    /// \param[in] _data Start of the saved graph. It is only read during
+    /// the call.
+    /// \param[in] _size Size of _data in bytes.
+    /// \return False if _data does not hold a graph saved with the same V,
+    /// E and EdgeType on a machine with the same byte order, or if it is
+    /// inconsistent. The graph is left empty in that case.
+    public: bool Load(const void *_data, const std::size_t _size)
+    {
+      static_assert(std::is_trivially_copyable_v<V>,
+        "Vertex data must be trivially copyable");
+      static_assert(std::is_trivially_copyable_v<E>,
+        "Edge data must be trivially copyable");
+
+      this->Clear();
+
+      const char *data = static_cast<const char *>(_data);
+      FileHeader header;
+      if (!data || _size < Padded(sizeof(header)))
+        return false;
+      std::memcpy(&header, data, sizeof(header));
+      if (std::memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) != 0 ||
+          header.byteOrder != kFileByteOrder ||
+          header.version != kFileVersion ||
+          header.vertexDataSize != sizeof(V) ||
+          header.edgeDataSize != sizeof(E) ||
+          header.directed != kDirected ||
+          header.numVertices == MAX_UI64)
+      {
+        return false;
+      }
+
+      // Check each section fits before computing the next offset so that
+      // corrupt counts cannot overflow
+      std::size_t offset = Padded(sizeof(header));
+      auto section = [&](const std::uint64_t _count,
+                         const std::size_t _elementSize,
+                         const char *&_start)
+      {
+        const std::size_t remaining = _size - offset;
+        if (_elementSize > 0 && _count > remaining / _elementSize)
+          return false;
+        const std::size_t bytes =
+          static_cast<std::size_t>(_count) * _elementSize;
+        _start = data + offset;
+        offset = std::min(_size, offset + Padded(bytes));
+        return true;
+      };
+
+      const char *ids = nullptr;
+      const char *nameOffsets = nullptr;
+      const char *vertexData = nullptr;
+      const char *edgeRecords = nullptr;
+      const char *edgeData = nullptr;
+      const char *nameBuffer = nullptr;
+      if (!section(header.numVertices, sizeof(std::uint64_t), ids) ||
+          !section(header.numVertices + 1, sizeof(std::uint64_t),
+                   nameOffsets) ||
+          !section(header.numVertices, sizeof(V), vertexData) ||
+          !section(header.numEdges, sizeof(FileEdge), edgeRecords) ||
+          !section(header.numEdges, sizeof(E), edgeData) ||
+          !section(header.namesSize, 1, nameBuffer))
+      {
+        return false;
+      }
+
+      // Ids must be increasing, so that every element is appended.
+      std::uint64_t nameBegin = 0;
+      std::uint64_t lastId = 0;
+      for (std::uint64_t i = 0; i < header.numVertices; ++i)
+      {
+        std::uint64_t id;
+        std::uint64_t nameEnd;
+        V vertexValue;
+        std::memcpy(&id, ids + i * sizeof(id), sizeof(id));
+        std::memcpy(&nameEnd, nameOffsets + (i + 1) * sizeof(nameEnd),
+          sizeof(nameEnd));
+        std::memcpy(&vertexValue, vertexData + i * sizeof(V), sizeof(V));
+        if (id == kNullId || (i > 0 && id <= lastId) ||
+            nameEnd < nameBegin || nameEnd > header.namesSize)
+        {
+          this->Clear();
+          return false;
+        }
+        this->AppendVertex(Vertex<V>(
+          std::string(nameBuffer + nameBegin, nameBuffer + nameEnd),
+          vertexValue, id));
+        nameBegin = nameEnd;
+        lastId = id;
+      }
+      this->IndexNames();
+
+      for (std::uint64_t i = 0; i < header.numEdges; ++i)
+      {
+        FileEdge record;
+        E edgeValue;
+        std::memcpy(&record, edgeRecords + i * sizeof(FileEdge),
+          sizeof(FileEdge));
+        std::memcpy(&edgeValue, edgeData + i * sizeof(E), sizeof(E));
+        if (record.id == kNullId || (i > 0 && record.id <= lastId) ||
+            !this->AppendEdge(EdgeType({record.tail, record.head}, edgeValue,
+                                       record.weight, record.id)))
+        {
+          this->Clear();
+          return false;
+        }
+        lastId = record.id;
+      }
+
+      this->nextVertexId = header.nextVertexId;
+      this->nextEdgeId = header.nextEdgeId;
+      return true;
+    }
+
     /// \brief Stream insertion operator. The output uses DOT graph
     /// description language.
     /// \param[out] _out The output stream.
     /// \param[in] _g Graph to write to the stream.
     /// \sa https://en.wikipedia.org/wiki/DOT_(graph_description_language).
-    public: template<typename VV, typename EE, typename EEdgeType>
+    public: template<typename VV, typename EE, typename EEdgeType,
+                     typename SS>
     friend std::ostream &operator<<(std::ostream &_out,
-                                    const Graph<VV, EE, EEdgeType> &_g);
+                                    const Graph<VV, EE, EEdgeType, SS> &_g);
+
+    /// \brief Remove all vertices and edges and reset the Ids handed out.
+    /// The containers keep their memory resource, if any.
+    private: void Clear()
+    {
+      this->vertices.clear();
+      this->edges.clear();
+      this->adjList.clear();
+      this->names.clear();
+      this->nextVertexId = 0u;
+      this->nextEdgeId = 0u;
+    }
+
+    /// \brief Add a set of vertices and edges to an empty graph.
+    /// \param[in] _vertices Collection of vertices.
+    /// \param[in] _edges Collection of edges.
+    private: void Build(const std::vector<Vertex<V>> &_vertices,
+                        const std::vector<EdgeInitializer<E>> &_edges)
+    {
+      // Vertices without an Id take the next free Id as they are added, so
+      // they can only be added one at a time.
+      const bool allIds = std::none_of(_vertices.begin(), _vertices.end(),
+        [](const Vertex<V> &_v) { return _v.Id() == kNullId; });
+
+      if (allIds)
+      {
+        std::vector<const Vertex<V> *> sorted;
+        sorted.reserve(_vertices.size());
+        for (auto const &v : _vertices)
+          sorted.push_back(&v);
+        std::stable_sort(sorted.begin(), sorted.end(),
+          [](const Vertex<V> *_a, const Vertex<V> *_b)
+          {
+            return _a->Id() < _b->Id();
+          });
+
+        // The first vertex with each Id is kept, as with AddVertex().
+        for (std::size_t i = 0; i < sorted.size(); ++i)
+        {
+          const Vertex<V> &v = *sorted[i];
+          if (i > 0 && sorted[i - 1]->Id() == v.Id())
+          {
+            std::cerr << "Invalid vertex with Id [" << v.Id()
+                      << "]. Ignoring." << std::endl;
+            continue;
+          }
+          this->AppendVertex(Vertex<V>(v.Name(), v.Data(), v.Id()));
+        }
+        this->IndexNames();
+      }
+      else
+      {
+        for (auto const &v : _vertices)
+        {
+          if (!this->AddVertex(v.Name(), v.Data(), v.Id()).Valid())
+          {
+            std::cerr << "Invalid vertex with Id [" << v.Id()
+                      << "]. Ignoring." << std::endl;
+          }
+        }
+      }
+
+      // Edges get consecutive Ids, as AddEdge() would give them.
+      for (auto const &e : _edges)
+      {
+        if (!this->AppendEdge(
+              EdgeType(e.vertices, e.data, e.weight, this->nextEdgeId)))
+        {
+          std::cerr << "Ignoring edge" << std::endl;
+          continue;
+        }
+        ++this->nextEdgeId;
+      }
+    }
+
+    /// \brief Add a vertex whose Id is larger than the Id of every vertex
+    /// in the graph, at the end of the containers. The name is not indexed,
+    /// see IndexNames().
+    /// \param[in] _vertex The vertex.
+    private: void AppendVertex(Vertex<V> &&_vertex)
+    {
+      const VertexId id = _vertex.Id();
+      this->vertices.insert(this->vertices.end(),
+        {id, std::move(_vertex)});
+      this->adjList.insert(this->adjList.end(), {id, AdjacencySet()});
+    }
+
+    /// \brief Rebuild the association between names and vertices from
+    /// scratch, sorting the names once.
+    private: void IndexNames()
+    {
+      std::vector<std::pair<std::string, VertexId>> sorted;
+      sorted.reserve(this->vertices.size());
+      for (auto const &v : this->vertices)
+        sorted.emplace_back(v.second.Name(), v.first);
+      std::stable_sort(sorted.begin(), sorted.end(),
+        [](const auto &_a, const auto &_b) { return _a.first < _b.first; });
+      this->names.clear();
+      for (auto &name : sorted)
+        this->names.emplace_hint(this->names.end(), std::move(name));
+    }
+
+    /// \brief Link an edge whose Id is larger than the Id of every edge in
+    /// the graph, at the end of the containers. This does the same as
+    /// LinkEdge() in constant time per container.
+    /// \param[in] _edge The edge.
+    /// \return False if a vertex of the edge does not exist.
+    private: bool AppendEdge(EdgeType &&_edge)
+    {
+      const VertexId_P edgeVertices = _edge.Vertices();
+      auto first = this->adjList.find(edgeVertices.first);
+      auto second = this->adjList.find(edgeVertices.second);
+      if (first == this->adjList.end() || second == this->adjList.end())
+        return false;
+
+      const EdgeId id = _edge.Id();
+      first->second.insert(first->second.end(), id);
+      second->second.insert(second->second.end(), id);
+      this->edges.insert(this->edges.end(), {id, std::move(_edge)});
+      return true;
+    }
+
+    /// \brief Header of the binary format written by Save(). All fields
+    /// are in native byte order.
+    private: struct FileHeader
+    {
+      /// \brief Identifies the format, see kFileMagic.
+      char magic[8];
+
+      /// \brief kFileByteOrder as written by the saving machine.
+      std::uint32_t byteOrder;
+
+      /// \brief Version of the format, see kFileVersion.
+      std::uint32_t version;
+
+      /// \brief sizeof(V) of the saved graph.
+      std::uint32_t vertexDataSize;
+
+      /// \brief sizeof(E) of the saved graph.
+      std::uint32_t edgeDataSize;
+
+      /// \brief 1 for directed edges, 0 for undirected edges.
+      std::uint32_t directed;
+
+      /// \brief Unused, written as zero.
+      std::uint32_t reserved;
+
+      /// \brief Number of vertices.
+      std::uint64_t numVertices;
+
+      /// \brief Number of edges.
+      std::uint64_t numEdges;
+
+      /// \brief Total size of the vertex names in bytes.
+      std::uint64_t namesSize;
+
+      /// \brief Next Ids to be handed out by the saved graph.
+      std::uint64_t nextVertexId;
+      std::uint64_t nextEdgeId;
+    };
+    static_assert(sizeof(FileHeader) == 72, "Unexpected header padding");
+
+    /// \brief An edge in the binary format. Its data is stored separately.
+    private: struct FileEdge
+    {
+      /// \brief Id of the edge.
+      std::uint64_t id;
+
+      /// \brief Ids of the vertices of the edge, as returned by
+      /// Edge::Vertices().
+      std::uint64_t tail;
+      std::uint64_t head;
+
+      /// \brief Weight of the edge.
+      double weight;
+    };
+    static_assert(sizeof(FileEdge) == 32, "Unexpected edge padding");
+
+    /// \brief First bytes of the binary format.
+    private: static constexpr char kFileMagic[8] =
+      {'G', 'Z', 'G', 'R', 'A', 'P', 'H', '\0'};
+
+    /// \brief Written in native order to detect byte order mismatches.
+    private: static constexpr std::uint32_t kFileByteOrder = 0x01020304;
+
+    /// \brief Current version of the binary format.
+    private: static constexpr std::uint32_t kFileVersion = 1;
+
+    /// \brief Every section of the binary format starts at a multiple of
+    /// this offset.
+    private: static constexpr std::size_t kFileAlignment = 16;
+
+    /// \brief Value of FileHeader::directed for this graph.
+    private: static constexpr std::uint32_t kDirected =
+      std::is_same_v<EdgeType, DirectedEdge<E>> ? 1u : 0u;
+
+    /// \brief Round a section size up to kFileAlignment.
+    /// \param[in] _size Size in bytes.
+    /// \return The padded size.
+    private: static std::size_t Padded(const std::size_t _size)
+    {
+      return (_size + kFileAlignment - 1) / kFileAlignment * kFileAlignment;
+    }
 
     /// \brief Get an available Id to be assigned to a new vertex.
     /// \return The next available Id or kNullId if there aren't ids available.
@@ -723,27 +1364,27 @@ namespace graph
     protected: VertexId nextEdgeId = 0u;
 
     /// \brief The set of vertices.
-    private: std::map<VertexId, Vertex<V>> vertices;
+    private: typename Storage::template Map<VertexId, Vertex<V>> vertices;
 
     /// \brief The set of edges.
-    private: std::map<EdgeId, EdgeType> edges;
+    private: typename Storage::template Map<EdgeId, EdgeType> edges;
 
     /// \brief The adjacency list.
     /// A map where the keys are vertex Ids. For each vertex (v)
     /// with id (vId), the map value contains a set of edge Ids. Each of
     /// the edges (e) with Id (eId) represents a connected path from (v) to
     /// another vertex via (e).
-    private: std::map<VertexId, EdgeId_S> adjList;
+    private: typename Storage::template Map<VertexId, AdjacencySet> adjList;
 
     /// \brief Association between names and vertices curently used.
-    private: std::multimap<std::string, VertexId> names;
+    private: typename Storage::template MultiMap<std::string, VertexId> names;
   };
 
   /////////////////////////////////////////////////
   /// Partial template specification for undirected edges.
-  template<typename VV, typename EE>
+  template<typename VV, typename EE, typename SS>
   std::ostream &operator<<(std::ostream &_out,
-                           const Graph<VV, EE, UndirectedEdge<EE>> &_g)
+                           const Graph<VV, EE, UndirectedEdge<EE>, SS> &_g)
   {
     _out << "graph {" << std::endl;
 
@@ -768,9 +1409,9 @@ namespace graph
 
   /////////////////////////////////////////////////
   /// Partial template specification for directed edges.
-  template<typename VV, typename EE>
+  template<typename VV, typename EE, typename SS>
   std::ostream &operator<<(std::ostream &_out,
-                           const Graph<VV, EE, DirectedEdge<EE>> &_g)
+                           const Graph<VV, EE, DirectedEdge<EE>, SS> &_g)
   {
     _out << "digraph {" << std::endl;
 
@@ -795,13 +1436,13 @@ namespace graph
 
   /// \def UndirectedGraph
   /// \brief An undirected graph.
-  template<typename V, typename E>
-  using UndirectedGraph = Graph<V, E, UndirectedEdge<E>>;
+  template<typename V, typename E, typename Storage = MapStorage>
+  using UndirectedGraph = Graph<V, E, UndirectedEdge<E>, Storage>;
 
   /// \def DirectedGraph
   /// \brief A directed graph.
-  template<typename V, typename E>
-  using DirectedGraph = Graph<V, E, DirectedEdge<E>>;
+  template<typename V, typename E, typename Storage = MapStorage>
+  using DirectedGraph = Graph<V, E, DirectedEdge<E>, Storage>;
 }
 }
 }
@@ -17,18 +17,35 @@
 #ifndef GZ_MATH_GRAPH_GRAPHALGORITHMS_HH_
 #define GZ_MATH_GRAPH_GRAPHALGORITHMS_HH_
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <deque>
 #include <functional>
-#include <list>
+#include <iostream>
+#include <limits>
 #include <map>
+#include <memory>
+#include <memory_resource>
+#include <optional>
 #include <queue>
+#include <set>
 #include <stack>
+#include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include <gz/math/config.hh>
+#include <gz/math/Profiler.hh>
+#include <gz/math/detail/ParallelFor.hh>
+#include "gz/math/graph/CsrGraph.hh"
 #include "gz/math/graph/Graph.hh"
 #include "gz/math/Helpers.hh"
 
+#include <gz/utils/SuppressWarning.hh>
+
 namespace gz
 {
 namespace math
@@ -42,56 +59,321 @@ namespace graph
   /// the cost (first element) to reach a destination vertex (second element).
   using CostInfo = std::pair<double, VertexId>;
 
+  namespace detail
+  {
+    /// \brief Get the vertices adjacent from a vertex that have not been
+    /// visited yet, see UnvisitedAdjacentsFrom(), for any set and vector
+    /// types.
+    /// \param[in] _graph A graph.
+    /// \param[in] _vertex The vertex.
+    /// \param[in] _visited The vertices visited.
+    /// \param[out] _adjacents The adjacent vertices.
+    template<typename V, typename E, typename EdgeType, typename Storage,
+             typename Visited, typename Adjacents>
+    void UnvisitedAdjacents(const Graph<V, E, EdgeType, Storage> &_graph,
+                            const VertexId &_vertex,
+                            const Visited &_visited,
+                            Adjacents &_adjacents)
+    {
+      _adjacents.clear();
+      for (auto const &adj : _graph.AdjacentsFromView(_vertex))
+      {
+        if (_visited.find(adj.first) == _visited.end())
+          _adjacents.push_back(adj.first);
+      }
+      std::sort(_adjacents.begin(), _adjacents.end());
+      _adjacents.erase(std::unique(_adjacents.begin(), _adjacents.end()),
+        _adjacents.end());
+    }
+  }
+
+  /// \brief Get the vertices adjacent from a vertex that have not been
+  /// visited yet, in increasing Id order and without repetitions, as the
+  /// traversals expect them.
+  /// \param[in] _graph A graph.
+  /// \param[in] _vertex The vertex.
+  /// \param[in] _visited The vertices visited.
+  /// \param[out] _adjacents The adjacent vertices. Its storage is reused
+  /// across calls.
+  template<typename V, typename E, typename EdgeType, typename Storage>
+  void UnvisitedAdjacentsFrom(const Graph<V, E, EdgeType, Storage> &_graph,
+                              const VertexId &_vertex,
+                              const std::set<VertexId> &_visited,
+                              std::vector<VertexId> &_adjacents)
+  {
+    detail::UnvisitedAdjacents(_graph, _vertex, _visited, _adjacents);
+  }
+
+  namespace detail
+  {
+    /// \brief Breadth first sort of a graph into a vector, with its
+    /// temporary containers allocated from a memory resource.
+    /// \param[in] _graph A graph.
+    /// \param[in] _from The starting vertex.
+    /// \param[in] _scratch Memory resource of the temporary containers.
+    /// \param[out] _visited The vertices in visiting order. It must be
+    /// empty.
+    template<typename V, typename E, typename EdgeType, typename Storage,
+             typename Result>
+    void BreadthFirstSort(const Graph<V, E, EdgeType, Storage> &_graph,
+                          const VertexId &_from,
+                          std::pmr::memory_resource *_scratch,
+                          Result &_visited)
+    {
+      if (!_graph.VertexFromId(_from).Valid())
+        return;
+
+      std::pmr::set<VertexId> done(_scratch);
+      std::pmr::vector<VertexId> adjacents(_scratch);
+      std::queue<VertexId, std::pmr::deque<VertexId>> pending(
+        std::pmr::deque<VertexId>{_scratch});
+      pending.push(_from);
+
+      while (!pending.empty())
+      {
+        auto vId = pending.front();
+        pending.pop();
+
+        // If the vertex has been visited, skip.
+        if (!done.insert(vId).second)
+          continue;
+
+        _visited.push_back(vId);
+
+        // Add more vertices to visit if they haven't been visited yet.
+        UnvisitedAdjacents(_graph, vId, done, adjacents);
+        for (auto const &adj : adjacents)
+          pending.push(adj);
+      }
+    }
+  }
+
   /// \brief Breadth first sort (BFS).
   /// Starting from the vertex == _from, it traverses the graph exploring the
   /// neighbors first, before moving to the next level neighbors.
   /// \param[in] _graph A graph.
   /// \param[in] _from The starting vertex.
   /// \return The vector of vertices Ids traversed in a breadth first manner.
-  template<typename V, typename E, typename EdgeType>
-  std::vector<VertexId> BreadthFirstSort(const Graph<V, E, EdgeType> &_graph,
-                                         const VertexId &_from)
+  template<typename V, typename E, typename EdgeType, typename Storage>
+  std::vector<VertexId> BreadthFirstSort(
+    const Graph<V, E, EdgeType, Storage> &_graph,
+    const VertexId &_from)
   {
-    // Create an auxiliary graph, where the data is just a boolean value that
-    // stores whether the vertex has been visited or not.
-    Graph<bool, E, EdgeType> visitorGraph;
+    std::vector<VertexId> visited;
+    detail::BreadthFirstSort(_graph, _from, std::pmr::new_delete_resource(),
+      visited);
+    return visited;
+  }
 
-    // Copy the vertices (just the Id).
-    for (auto const &v : _graph.Vertices())
-      visitorGraph.AddVertex("", false, v.first);
+  /// \brief Breadth first sort (BFS) allocating from a memory resource,
+  /// such as an arena released once per frame. The result and every
+  /// temporary container are allocated from _resource.
+  /// \param[in] _graph A graph.
+  /// \param[in] _from The starting vertex.
+  /// \param[in] _resource The memory resource.
+  /// \return The vector of vertices Ids traversed in a breadth first manner,
+  /// see BreadthFirstSort(const Graph<V, E, EdgeType, Storage> &,
+  /// const VertexId &).
+  template<typename V, typename E, typename EdgeType, typename Storage>
+  std::pmr::vector<VertexId> BreadthFirstSort(
+    const Graph<V, E, EdgeType, Storage> &_graph,
+    const VertexId &_from,
+    std::pmr::memory_resource *_resource)
+  {
+    std::pmr::vector<VertexId> visited(_resource);
+    detail::BreadthFirstSort(_graph, _from, _resource, visited);
+    return visited;
+  }
+
+  namespace detail
+  {
+    /// \brief Level synchronous breadth first search on a compressed sparse
+    /// row snapshot. Each level is expanded completely before the next one.
+    /// The unvisited neighbors of each chunk of a level are gathered in
+    /// parallel and then merged in chunk order, so vertices are visited in
+    /// the same order as with a queue, whatever the number of threads.
+    /// \param[in] _graph A snapshot of a graph.
+    /// \param[in] _sources Dense indices of the starting vertices, all at
+    /// level 0. Repeated indices are visited once.
+    /// \param[in] _sourceCount Number of starting vertices.
+    /// \param[in] _threads Number of threads, 0 to use one per core.
+    /// \param[in] _scratch Memory resource of the per thread buffers.
+    /// \param[out] _levels Number of edges from the nearest source to each
+    /// vertex, CsrGraph::kNullIndex if it is not reached.
+    /// \param[out] _order Dense indices of the vertices in visiting order.
+    template<typename Levels, typename Order>
+    void LevelSynchronousSearch(const CsrGraph &_graph,
+      const std::size_t *_sources,
+      const std::size_t _sourceCount,
+      const unsigned int _threads,
+      std::pmr::memory_resource *_scratch,
+      Levels &_levels,
+      Order &_order)
+    {
+      const auto &offsets = _graph.Offsets();
+      const auto &neighbors = _graph.Neighbors();
+      _levels.assign(_graph.VertexCount(), CsrGraph::kNullIndex);
+      _order.clear();
+      for (std::size_t i = 0; i < _sourceCount; ++i)
+      {
+        const std::size_t s = _sources[i];
+        if (_levels[s] == CsrGraph::kNullIndex)
+        {
+          _levels[s] = 0;
+          _order.push_back(s);
+        }
+      }
+
+      // Smaller levels are not worth the cost of starting a thread
+      constexpr std::size_t kMinChunk = 1024;
+      std::pmr::vector<std::pmr::vector<std::size_t>> found(
+        math::detail::ThreadCount(_threads), _scratch);
+
+      // Levels are only written between expansions, so chunks can read
+      // them concurrently. Parallel edges are next to each other, gather
+      // their end once.
+      auto gather = [&](const std::size_t _chunk, const std::size_t _begin,
+                        const std::size_t _end)
+      {
+        auto &out = found[_chunk];
+        out.clear();
+        for (std::size_t i = _begin; i < _end; ++i)
+        {
+          const std::size_t u = _order[i];
+          for (std::size_t e = offsets[u]; e < offsets[u + 1]; ++e)
+          {
+            const std::size_t v = neighbors[e];
+            if (_levels[v] == CsrGraph::kNullIndex &&
+                (e == offsets[u] || neighbors[e - 1] != v))
+            {
+              out.push_back(v);
+            }
+          }
+        }
+      };
+
+      std::size_t begin = 0;
+      for (std::size_t level = 1; begin < _order.size(); ++level)
+      {
+        const std::size_t end = _order.size();
+        const std::size_t size = end - begin;
+        const std::size_t chunks =
+          math::detail::ChunkCount(size, _threads, kMinChunk);
+        math::detail::ParallelFor(size, chunks,
+          [&](const std::size_t _chunk, const std::size_t _begin,
+              const std::size_t _end)
+          {
+            gather(_chunk, begin + _begin, begin + _end);
+          });
 
-    // Copy the edges (without data).
-    for (auto const &e : _graph.Edges())
-      visitorGraph.AddEdge(e.second.get().Vertices(), E());
+        for (std::size_t c = 0; c < chunks; ++c)
+        {
+          for (const std::size_t v : found[c])
+          {
+            if (_levels[v] == CsrGraph::kNullIndex)
+            {
+              _levels[v] = level;
+              _order.push_back(v);
+            }
+          }
+        }
+        begin = end;
+      }
+    }
+  }
 
+  /// \brief Breadth first sort (BFS) on a compressed sparse row snapshot.
+  /// This gives the same result as BreadthFirstSort on the graph the
+  /// snapshot was taken from. The visited vertices are kept in dense arrays
+  /// and each level can be expanded by several threads, which pays off
+  /// when levels have thousands of vertices.
+  /// \param[in] _graph A snapshot of a graph, see Freeze().
+  /// \param[in] _from The starting vertex.
+  /// \param[in] _threads Number of threads, 0 to use one per core. The
+  /// result does not depend on it.
+  /// \return The vector of vertices Ids traversed in a breadth first manner.
+  inline std::vector<VertexId> BreadthFirstSort(const CsrGraph &_graph,
+                                                const VertexId &_from,
+                                                const unsigned int _threads = 1)
+  {
     std::vector<VertexId> visited;
-    std::list<VertexId> pending = {_from};
+    const std::size_t from = _graph.Index(_from);
+    if (from == CsrGraph::kNullIndex)
+      return visited;
 
-    while (!pending.empty())
-    {
-      auto vId = pending.front();
-      pending.pop_front();
+    std::vector<std::size_t> levels;
+    std::vector<std::size_t> order;
+    detail::LevelSynchronousSearch(_graph, &from, 1, _threads,
+      std::pmr::new_delete_resource(), levels, order);
+    visited.reserve(order.size());
+    for (const std::size_t u : order)
+      visited.push_back(_graph.Id(u));
+    return visited;
+  }
 
-      // If the vertex has been visited, skip.
-      auto &vertex = visitorGraph.VertexFromId(vId);
-      if (vertex.Data())
-        continue;
+  /// \brief Breadth first sort (BFS) on a compressed sparse row snapshot,
+  /// allocating the result and every temporary buffer from a memory
+  /// resource, see BreadthFirstSort(const CsrGraph &, const VertexId &,
+  /// const unsigned int).
+  /// \param[in] _graph A snapshot of a graph, see Freeze().
+  /// \param[in] _from The starting vertex.
+  /// \param[in] _threads Number of threads, 0 to use one per core.
+  /// \param[in] _resource The memory resource.
+  /// \return The vector of vertices Ids traversed in a breadth first manner.
+  inline std::pmr::vector<VertexId> BreadthFirstSort(const CsrGraph &_graph,
+    const VertexId &_from,
+    const unsigned int _threads,
+    std::pmr::memory_resource *_resource)
+  {
+    std::pmr::vector<VertexId> visited(_resource);
+    const std::size_t from = _graph.Index(_from);
+    if (from == CsrGraph::kNullIndex)
+      return visited;
 
-      visited.push_back(vId);
-      vertex.Data() = true;
+    std::pmr::vector<std::size_t> levels(_resource);
+    std::pmr::vector<std::size_t> order(_resource);
+    detail::LevelSynchronousSearch(_graph, &from, 1, _threads, _resource,
+      levels, order);
+    visited.reserve(order.size());
+    for (const std::size_t u : order)
+      visited.push_back(_graph.Id(u));
+    return visited;
+  }
 
-      // Add more vertices to visit if they haven't been visited yet.
-      auto adjacents = visitorGraph.AdjacentsFrom(vId);
-      for (auto const &adj : adjacents)
+  /// \brief Multi-source breadth first search on a compressed sparse row
+  /// snapshot. It computes, in a single traversal, the number of edges
+  /// from each vertex to the nearest of several sources, as used for
+  /// coverage maps.
+  /// \param[in] _graph A snapshot of a graph, see Freeze().
+  /// \param[in] _sources The starting vertices.
+  /// \param[in] _threads Number of threads, 0 to use one per core. The
+  /// result does not depend on it.
+  /// \return The number of edges from the nearest source to each vertex,
+  /// indexed by dense index (see CsrGraph::Index()), or CsrGraph::kNullIndex
+  /// for the vertices that cannot be reached. If a source vertex doesn't
+  /// exist, the function will return an empty vector.
+  inline std::vector<std::size_t> BreadthFirstLevels(
+    const CsrGraph &_graph,
+    const std::vector<VertexId> &_sources,
+    const unsigned int _threads = 1)
+  {
+    std::vector<std::size_t> sources;
+    sources.reserve(_sources.size());
+    for (const VertexId &id : _sources)
+    {
+      sources.push_back(_graph.Index(id));
+      if (sources.back() == CsrGraph::kNullIndex)
       {
-        vId = adj.first;
-        auto &v = adj.second.get();
-        if (!v.Data())
-          pending.push_back(vId);
+        std::cerr << "Vertex [" << id << "] Not found" << std::endl;
+        return {};
       }
     }
 
-    return visited;
+    std::vector<std::size_t> levels;
+    std::vector<std::size_t> order;
+    detail::LevelSynchronousSearch(_graph, sources.data(), sources.size(),
+      _threads, std::pmr::new_delete_resource(), levels, order);
+    return levels;
   }
 
   /// \brief Depth first sort (DFS).
@@ -100,23 +382,17 @@ namespace graph
   /// \param[in] _graph A graph.
   /// \param[in] _from The starting vertex.
   /// \return The vector of vertices Ids visited in a depth first manner.
-  template<typename V, typename E, typename EdgeType>
-  std::vector<VertexId> DepthFirstSort(const Graph<V, E, EdgeType> &_graph,
-                                       const VertexId &_from)
+  template<typename V, typename E, typename EdgeType, typename Storage>
+  std::vector<VertexId> DepthFirstSort(
+    const Graph<V, E, EdgeType, Storage> &_graph,
+    const VertexId &_from)
   {
-    // Create an auxiliary graph, where the data is just a boolean value that
-    // stores whether the vertex has been visited or not.
-    Graph<bool, E, EdgeType> visitorGraph;
-
-    // Copy the vertices (just the Id).
-    for (auto const &v : _graph.Vertices())
-      visitorGraph.AddVertex("", false, v.first);
-
-    // Copy the edges (without data).
-    for (auto const &e : _graph.Edges())
-      visitorGraph.AddEdge(e.second.get().Vertices(), E());
-
     std::vector<VertexId> visited;
+    if (!_graph.VertexFromId(_from).Valid())
+      return visited;
+
+    std::set<VertexId> done;
+    std::vector<VertexId> adjacents;
     std::stack<VertexId> pending({_from});
 
     while (!pending.empty())
@@ -125,27 +401,143 @@ namespace graph
       pending.pop();
 
       // If the vertex has been visited, skip.
-      auto &vertex = visitorGraph.VertexFromId(vId);
-      if (vertex.Data())
+      if (!done.insert(vId).second)
         continue;
 
       visited.push_back(vId);
-      vertex.Data() = true;
 
       // Add more vertices to visit if they haven't been visited yet.
-      auto adjacents = visitorGraph.AdjacentsFrom(vId);
+      UnvisitedAdjacentsFrom(_graph, vId, done, adjacents);
       for (auto const &adj : adjacents)
+        pending.push(adj);
+    }
+
+    return visited;
+  }
+
+  /// \brief Depth first sort (DFS) on a compressed sparse row snapshot.
+  /// This gives the same result as DepthFirstSort on the graph the snapshot
+  /// was taken from.
+  /// \param[in] _graph A snapshot of a graph, see Freeze().
+  /// \param[in] _from The starting vertex.
+  /// \return The vector of vertices Ids visited in a depth first manner.
+  inline std::vector<VertexId> DepthFirstSort(const CsrGraph &_graph,
+                                              const VertexId &_from)
+  {
+    std::vector<VertexId> visited;
+    const std::size_t from = _graph.Index(_from);
+    if (from == CsrGraph::kNullIndex)
+      return visited;
+
+    const auto &offsets = _graph.Offsets();
+    const auto &neighbors = _graph.Neighbors();
+    std::vector<bool> done(_graph.VertexCount(), false);
+    std::vector<std::size_t> pending = {from};
+
+    while (!pending.empty())
+    {
+      const std::size_t u = pending.back();
+      pending.pop_back();
+
+      // If the vertex has been visited, skip.
+      if (done[u])
+        continue;
+
+      visited.push_back(_graph.Id(u));
+      done[u] = true;
+
+      // Add more vertices to visit if they haven't been visited yet.
+      for (std::size_t e = offsets[u]; e < offsets[u + 1]; ++e)
       {
-        vId = adj.first;
-        auto &v = adj.second.get();
-        if (!v.Data())
-          pending.push(vId);
+        const std::size_t v = neighbors[e];
+        if (!done[v] && (e == offsets[u] || neighbors[e - 1] != v))
+          pending.push_back(v);
       }
     }
 
     return visited;
   }
 
+  namespace detail
+  {
+    /// \brief Dijkstra algorithm into any map type, see
+    /// Dijkstra(const Graph<V, E, EdgeType, Storage> &, const VertexId &,
+    /// const VertexId &).
+    /// \param[in] _graph A graph.
+    /// \param[in] _from The starting vertex.
+    /// \param[in] _to Destination vertex, or kNullId for all vertices.
+    /// \param[in] _scratch Memory resource of the priority queue.
+    /// \param[out] _dist The map of costs and previous vertices. It must be
+    /// empty, and it stays empty if a vertex doesn't exist.
+    template<typename V, typename E, typename EdgeType, typename Storage,
+             typename Result>
+    void Dijkstra(const Graph<V, E, EdgeType, Storage> &_graph,
+                  const VertexId &_from,
+                  const VertexId &_to,
+                  std::pmr::memory_resource *_scratch,
+                  Result &_dist)
+    {
+      // Sanity check: The source vertex should exist.
+      if (!_graph.VertexFromId(_from).Valid())
+      {
+        std::cerr << "Vertex [" << _from << "] Not found" << std::endl;
+        return;
+      }
+
+      // Sanity check: The destination vertex should exist (if used).
+      if (_to != kNullId && !_graph.VertexFromId(_to).Valid())
+      {
+        std::cerr << "Vertex [" << _from << "] Not found" << std::endl;
+        return;
+      }
+
+      // Store vertices that are being preprocessed.
+      std::priority_queue<CostInfo, std::pmr::vector<CostInfo>,
+        std::greater<CostInfo>> pq{std::greater<CostInfo>(),
+          std::pmr::vector<CostInfo>(_scratch)};
+
+      // Create a map for distances and next neightbor and initialize all
+      // distances as infinite. Vertices are visited in Id order, so each
+      // insertion is O(1).
+      _graph.ForEachVertex([&_dist](const auto &_v)
+      {
+        _dist.emplace_hint(_dist.end(), _v.Id(),
+          std::make_pair(MAX_D, kNullId));
+      });
+
+      // Insert _from in the priority queue and initialize its distance as 0.
+      pq.push(std::make_pair(0.0, _from));
+      _dist[_from] = std::make_pair(0.0, _from);
+
+      while (!pq.empty())
+      {
+        // This is the minimum distance vertex.
+        VertexId u = pq.top().second;
+
+        // Shortcut: Destination vertex found, exiting.
+        if (_to != kNullId && _to == u)
+          break;
+
+        pq.pop();
+
+        for (auto const &edgePair : _graph.IncidentsFromView(u))
+        {
+          const auto &edge = edgePair.second.get();
+          const auto &v = edge.From(u);
+          double weight = edge.Weight();
+
+          //  If there is shorted path to v through u.
+          if (_dist[v].first > _dist[u].first + weight)
+          {
+            // Updating distance of v.
+            _dist[v] = std::make_pair(_dist[u].first + weight, u);
+            pq.push(std::make_pair(_dist[v].first, v));
+          }
+        }
+      }
+    }
+  }
+
   /// \brief Dijkstra algorithm.
   /// Find the shortest path between the vertices in a graph.
   /// If only a graph and a source vertex is provided, the algorithm will
@@ -209,86 +601,1306 @@ namespace graph
   /// ================================
   /// \endcode
   ///
-  template<typename V, typename E, typename EdgeType>
-  std::map<VertexId, CostInfo> Dijkstra(const Graph<V, E, EdgeType> &_graph,
-                                        const VertexId &_from,
-                                        const VertexId &_to = kNullId)
+  template<typename V, typename E, typename EdgeType, typename Storage>
+  std::map<VertexId, CostInfo> Dijkstra(
+    const Graph<V, E, EdgeType, Storage> &_graph,
+    const VertexId &_from,
+    const VertexId &_to = kNullId)
   {
-    auto allVertices = _graph.Vertices();
+    GZ_MATH_PROFILE_ZONE("graph::Dijkstra");
+
+    std::map<VertexId, CostInfo> dist;
+    detail::Dijkstra(_graph, _from, _to, std::pmr::new_delete_resource(),
+      dist);
+    return dist;
+  }
+
+  /// \brief Dijkstra algorithm allocating from a memory resource, such as
+  /// an arena released once per frame. The result and the priority queue
+  /// are allocated from _resource, see
+  /// Dijkstra(const Graph<V, E, EdgeType, Storage> &, const VertexId &,
+  /// const VertexId &).
+  /// \param[in] _graph A graph.
+  /// \param[in] _from The starting vertex.
+  /// \param[in] _to Destination vertex, or kNullId for all vertices.
+  /// \param[in] _resource The memory resource.
+  /// \return The map of costs and previous vertices by destination.
+  template<typename V, typename E, typename EdgeType, typename Storage>
+  std::pmr::map<VertexId, CostInfo> Dijkstra(
+    const Graph<V, E, EdgeType, Storage> &_graph,
+    const VertexId &_from,
+    const VertexId &_to,
+    std::pmr::memory_resource *_resource)
+  {
+    GZ_MATH_PROFILE_ZONE("graph::Dijkstra");
+
+    std::pmr::map<VertexId, CostInfo> dist(_resource);
+    detail::Dijkstra(_graph, _from, _to, _resource, dist);
+    return dist;
+  }
+
+  namespace detail
+  {
+    /// \brief Dijkstra algorithm on a compressed sparse row snapshot,
+    /// starting from one or more sources at cost 0.
+    /// \param[in] _graph A snapshot of a graph.
+    /// \param[in] _sources Dense indices of the starting vertices.
+    /// \param[in] _sourceCount Number of starting vertices.
+    /// \param[in] _to Dense index of the destination vertex, or
+    /// CsrGraph::kNullIndex to find the shortest paths to all vertices.
+    /// \param[in] _scratch Memory resource of the priority queue.
+    /// \param[out] _cost Cost of each vertex by dense index.
+    /// \param[out] _previous Previous vertex of each vertex in its shortest
+    /// path by dense index. Sources are their own previous vertex.
+    template<typename Cost, typename Previous>
+    void DijkstraSearch(const CsrGraph &_graph,
+                        const std::size_t *_sources,
+                        const std::size_t _sourceCount,
+                        const std::size_t _to,
+                        std::pmr::memory_resource *_scratch,
+                        Cost &_cost,
+                        Previous &_previous)
+    {
+      const auto &offsets = _graph.Offsets();
+      const auto &neighbors = _graph.Neighbors();
+      const auto &weights = _graph.Weights();
+
+      // Indices are in Id order, so ties in the queue are broken as in the
+      // Graph version.
+      _cost.assign(_graph.VertexCount(), MAX_D);
+      _previous.assign(_graph.VertexCount(), CsrGraph::kNullIndex);
+      using IndexCost = std::pair<double, std::size_t>;
+      std::priority_queue<IndexCost, std::pmr::vector<IndexCost>,
+        std::greater<IndexCost>> pq{std::greater<IndexCost>(),
+          std::pmr::vector<IndexCost>(_scratch)};
+
+      for (std::size_t i = 0; i < _sourceCount; ++i)
+      {
+        const std::size_t s = _sources[i];
+        pq.push(std::make_pair(0.0, s));
+        _cost[s] = 0.0;
+        _previous[s] = s;
+      }
+
+      while (!pq.empty())
+      {
+        // This is the minimum distance vertex.
+        const std::size_t u = pq.top().second;
+
+        // Shortcut: Destination vertex found, exiting.
+        if (u == _to)
+          break;
+
+        pq.pop();
+
+        for (std::size_t e = offsets[u]; e < offsets[u + 1]; ++e)
+        {
+          const std::size_t v = neighbors[e];
+
+          //  If there is shorted path to v through u.
+          if (_cost[v] > _cost[u] + weights[e])
+          {
+            _cost[v] = _cost[u] + weights[e];
+            _previous[v] = u;
+            pq.push(std::make_pair(_cost[v], v));
+          }
+        }
+      }
+    }
+
+    /// \brief Convert the result of DijkstraSearch to the map returned by
+    /// Dijkstra.
+    /// \param[in] _graph A snapshot of a graph.
+    /// \param[in] _cost Cost of each vertex by dense index.
+    /// \param[in] _previous Previous vertex of each vertex by dense index.
+    /// \param[out] _dist The map of costs and previous vertices by Id. It
+    /// must be empty.
+    template<typename Cost, typename Previous, typename Result>
+    void CostMap(const CsrGraph &_graph,
+                 const Cost &_cost,
+                 const Previous &_previous,
+                 Result &_dist)
+    {
+      // Vertices are inserted in key order, so each insertion is O(1)
+      for (std::size_t i = 0; i < _cost.size(); ++i)
+      {
+        _dist.emplace_hint(_dist.end(), _graph.Id(i), std::make_pair(
+          _cost[i], _previous[i] == CsrGraph::kNullIndex ?
+            kNullId : _graph.Id(_previous[i])));
+      }
+    }
+  }
+
+  /// \brief Dijkstra algorithm on a compressed sparse row snapshot.
+  /// This gives the same result as Dijkstra on the graph the snapshot was
+  /// taken from, see Dijkstra(const Graph<V, E, EdgeType, Storage> &,
+  /// const VertexId &, const VertexId &).
+  /// \param[in] _graph A snapshot of a graph, see Freeze().
+  /// \param[in] _from The starting vertex.
+  /// \param[in] _to Optional destination vertex.
+  /// \return A map where the keys are the destination vertices. For each
+  /// destination, the value is another pair, where the key is the shortest
+  /// cost from the origin vertex. The value is the previous neighbor Id in the
+  /// shortest path. If the source or destination vertex don't exist, the
+  /// function will return an empty map.
+  inline std::map<VertexId, CostInfo> Dijkstra(const CsrGraph &_graph,
+                                               const VertexId &_from,
+                                               const VertexId &_to = kNullId)
+  {
+    GZ_MATH_PROFILE_ZONE("graph::Dijkstra");
 
     // Sanity check: The source vertex should exist.
-    if (allVertices.find(_from) == allVertices.end())
+    const std::size_t from = _graph.Index(_from);
+    if (from == CsrGraph::kNullIndex)
     {
       std::cerr << "Vertex [" << _from << "] Not found" << std::endl;
       return {};
     }
 
     // Sanity check: The destination vertex should exist (if used).
-    if (_to != kNullId &&
-        allVertices.find(_to) == allVertices.end())
+    const std::size_t to =
+      _to != kNullId ? _graph.Index(_to) : CsrGraph::kNullIndex;
+    if (_to != kNullId && to == CsrGraph::kNullIndex)
+    {
+      std::cerr << "Vertex [" << _to << "] Not found" << std::endl;
+      return {};
+    }
+
+    std::vector<double> cost;
+    std::vector<std::size_t> previous;
+    detail::DijkstraSearch(_graph, &from, 1, to,
+      std::pmr::new_delete_resource(), cost, previous);
+    std::map<VertexId, CostInfo> dist;
+    detail::CostMap(_graph, cost, previous, dist);
+    return dist;
+  }
+
+  /// \brief Dijkstra algorithm on a compressed sparse row snapshot,
+  /// allocating the result and every temporary buffer from a memory
+  /// resource, see Dijkstra(const CsrGraph &, const VertexId &,
+  /// const VertexId &).
+  /// \param[in] _graph A snapshot of a graph, see Freeze().
+  /// \param[in] _from The starting vertex.
+  /// \param[in] _to Destination vertex, or kNullId for all vertices.
+  /// \param[in] _resource The memory resource.
+  /// \return The map of costs and previous vertices by destination.
+  inline std::pmr::map<VertexId, CostInfo> Dijkstra(const CsrGraph &_graph,
+    const VertexId &_from,
+    const VertexId &_to,
+    std::pmr::memory_resource *_resource)
+  {
+    GZ_MATH_PROFILE_ZONE("graph::Dijkstra");
+
+    std::pmr::map<VertexId, CostInfo> dist(_resource);
+
+    // Sanity check: The source vertex should exist.
+    const std::size_t from = _graph.Index(_from);
+    if (from == CsrGraph::kNullIndex)
+    {
+      std::cerr << "Vertex [" << _from << "] Not found" << std::endl;
+      return dist;
+    }
+
+    // Sanity check: The destination vertex should exist (if used).
+    const std::size_t to =
+      _to != kNullId ? _graph.Index(_to) : CsrGraph::kNullIndex;
+    if (_to != kNullId && to == CsrGraph::kNullIndex)
+    {
+      std::cerr << "Vertex [" << _to << "] Not found" << std::endl;
+      return dist;
+    }
+
+    std::pmr::vector<double> cost(_resource);
+    std::pmr::vector<std::size_t> previous(_resource);
+    detail::DijkstraSearch(_graph, &from, 1, to, _resource, cost, previous);
+    detail::CostMap(_graph, cost, previous, dist);
+    return dist;
+  }
+
+  namespace detail
+  {
+    /// \brief Delta-stepping single source shortest paths on a compressed
+    /// sparse row snapshot, see DeltaStepping().
+    ///
+    /// Vertices are kept in buckets of costs of width _delta. The lowest
+    /// bucket is emptied by relaxing the edges of its vertices not heavier
+    /// than _delta in parallel, which may add vertices back to it, then the
+    /// heavier edges of every vertex settled in the bucket are relaxed once.
+    /// Costs are lowered with atomic compare and swap, so they end at the
+    /// same fixed point as Dijkstra whatever the order of the relaxations.
+    /// The previous vertex of each vertex is then chosen among the vertices
+    /// of its shortest paths as Dijkstra would, the one with the lowest cost
+    /// and then the lowest index.
+    /// \param[in] _graph A snapshot of a graph, without negative weights.
+    /// \param[in] _from Dense index of the starting vertex.
+    /// \param[in] _delta Width of the buckets, positive.
+    /// \param[in] _threads Number of threads, 0 to use one per core.
+    /// \param[out] _cost Cost of each vertex by dense index.
+    /// \param[out] _previous Previous vertex of each vertex in its shortest
+    /// path by dense index. The source is its own previous vertex.
+    inline void DeltaSteppingSearch(const CsrGraph &_graph,
+                                    const std::size_t _from,
+                                    const double _delta,
+                                    const unsigned int _threads,
+                                    std::vector<double> &_cost,
+                                    std::vector<std::size_t> &_previous)
+    {
+      const auto &offsets = _graph.Offsets();
+      const auto &neighbors = _graph.Neighbors();
+      const auto &weights = _graph.Weights();
+      const std::size_t n = _graph.VertexCount();
+
+      // Smaller frontiers are not worth the cost of starting a thread
+      constexpr std::size_t kMinChunk = 1024;
+
+      std::unique_ptr<std::atomic<double>[]> cost(
+        new std::atomic<double>[n]);
+      for (std::size_t v = 0; v < n; ++v)
+        cost[v].store(MAX_D, std::memory_order_relaxed);
+      cost[_from].store(0.0, std::memory_order_relaxed);
+
+      const double maxBucket =
+        static_cast<double>(std::numeric_limits<std::size_t>::max() / 2);
+      auto bucketOf = [&](const double _value)
+      {
+        return static_cast<std::size_t>(
+          std::min(std::floor(_value / _delta), maxBucket));
+      };
+
+      // Buckets may hold stale or repeated entries, which are skipped
+      std::map<std::size_t, std::vector<std::size_t>> buckets;
+      buckets[0].push_back(_from);
+      std::vector<std::vector<std::size_t>> improved(
+        math::detail::ThreadCount(_threads));
+      std::vector<std::size_t> frontier;
+      std::vector<std::size_t> settled;
+      // Last phase each vertex was added to the frontier, and last bucket
+      // it was settled in, plus one
+      std::vector<std::size_t> phaseOf(n, 0);
+      std::vector<std::size_t> settledIn(n, 0);
+      std::size_t phase = 0;
+
+      // Relax the light or heavy edges of a list of vertices
+      auto relax = [&](const std::vector<std::size_t> &_vertices,
+                       const bool _light)
+      {
+        const std::size_t count = _vertices.size();
+        math::detail::ParallelFor(count,
+          math::detail::ChunkCount(count, _threads, kMinChunk),
+          [&](const std::size_t _chunk, const std::size_t _begin,
+              const std::size_t _end)
+          {
+            auto &out = improved[_chunk];
+            for (std::size_t i = _begin; i < _end; ++i)
+            {
+              const std::size_t u = _vertices[i];
+              const double costU = cost[u].load(std::memory_order_relaxed);
+              for (std::size_t e = offsets[u]; e < offsets[u + 1]; ++e)
+              {
+                if ((weights[e] <= _delta) != _light)
+                  continue;
+                const std::size_t v = neighbors[e];
+                const double candidate = costU + weights[e];
+                double old = cost[v].load(std::memory_order_relaxed);
+                while (candidate < old)
+                {
+                  if (cost[v].compare_exchange_weak(old, candidate,
+                        std::memory_order_relaxed))
+                  {
+                    out.push_back(v);
+                    break;
+                  }
+                }
+              }
+            }
+          });
+        for (auto &out : improved)
+        {
+          for (const std::size_t v : out)
+          {
+            buckets[bucketOf(cost[v].load(std::memory_order_relaxed))]
+              .push_back(v);
+          }
+          out.clear();
+        }
+      };
+
+      while (!buckets.empty())
+      {
+        const std::size_t current = buckets.begin()->first;
+        settled.clear();
+        while (!buckets.empty() && buckets.begin()->first == current)
+        {
+          ++phase;
+          frontier.clear();
+          for (const std::size_t v : buckets.begin()->second)
+          {
+            if (phaseOf[v] != phase &&
+                bucketOf(cost[v].load(std::memory_order_relaxed)) == current)
+            {
+              phaseOf[v] = phase;
+              frontier.push_back(v);
+              if (settledIn[v] != current + 1)
+              {
+                settledIn[v] = current + 1;
+                settled.push_back(v);
+              }
+            }
+          }
+          buckets.erase(buckets.begin());
+          relax(frontier, true);
+        }
+        relax(settled, false);
+      }
+
+      _cost.resize(n);
+      for (std::size_t v = 0; v < n; ++v)
+        _cost[v] = cost[v].load(std::memory_order_relaxed);
+
+      const auto &inOffsets = _graph.InOffsets();
+      const auto &inNeighbors = _graph.InNeighbors();
+      const auto &inWeights = _graph.InWeights();
+      // Dijkstra pops vertices by increasing cost, then index, and only
+      // replaces the previous vertex for a strictly lower cost. At the
+      // fixed point no edge can lower a cost, so an edge is on a shortest
+      // path when it doesn't raise it either.
+      _previous.assign(n, CsrGraph::kNullIndex);
+      math::detail::ParallelFor(n,
+        math::detail::ChunkCount(n, _threads, kMinChunk),
+        [&](const std::size_t, const std::size_t _begin,
+            const std::size_t _end)
+        {
+          for (std::size_t v = _begin; v < _end; ++v)
+          {
+            GZ_UTILS_WARN_IGNORE__FLOAT_EQUAL
+            if (v == _from || _cost[v] == MAX_D)
+              continue;
+            GZ_UTILS_WARN_RESUME__FLOAT_EQUAL
+            for (std::size_t e = inOffsets[v]; e < inOffsets[v + 1]; ++e)
+            {
+              const std::size_t u = inNeighbors[e];
+              if (u == v || !(_cost[u] + inWeights[e] <= _cost[v]))
+                continue;
+              const std::size_t best = _previous[v];
+              if (best == CsrGraph::kNullIndex ||
+                  std::make_pair(_cost[u], u) <
+                  std::make_pair(_cost[best], best))
+              {
+                _previous[v] = u;
+              }
+            }
+          }
+        });
+      _previous[_from] = _from;
+    }
+  }
+
+  /// \brief Single source shortest paths on a compressed sparse row
+  /// snapshot with the delta-stepping algorithm, which relaxes the edges
+  /// of many vertices in parallel and suits very large graphs. The costs
+  /// are the same as with Dijkstra(const CsrGraph &, const VertexId &,
+  /// const VertexId &) for non negative weights, and so are the previous
+  /// vertices unless several shortest paths to a vertex tie through zero
+  /// weight edges.
+  /// \param[in] _graph A snapshot of a graph, see Freeze(). Its weights
+  /// must not be negative.
+  /// \param[in] _from The starting vertex.
+  /// \param[in] _delta Width of the cost buckets. Vertices whose costs
+  /// fall in the same bucket are expanded together, so a larger width
+  /// gives more parallelism but more edges relaxed more than once. Zero
+  /// or negative uses the mean edge weight.
+  /// \param[in] _threads Number of threads, 0 to use one per core. The
+  /// result does not depend on it.
+  /// \return A map where the keys are the destination vertices. For each
+  /// destination, the value is a pair with the shortest cost from the
+  /// origin vertex and the previous neighbor Id in the shortest path.
+  /// Vertices that cannot be reached have a cost of MAX_D and kNullId as
+  /// previous vertex. If the source vertex doesn't exist or a weight is
+  /// negative, the function will return an empty map.
+  inline std::map<VertexId, CostInfo> DeltaStepping(const CsrGraph &_graph,
+    const VertexId &_from,
+    const double _delta = 0,
+    const unsigned int _threads = 1)
+  {
+    GZ_MATH_PROFILE_ZONE("graph::DeltaStepping");
+
+    // Sanity check: The source vertex should exist.
+    const std::size_t from = _graph.Index(_from);
+    if (from == CsrGraph::kNullIndex)
     {
       std::cerr << "Vertex [" << _from << "] Not found" << std::endl;
       return {};
     }
 
-    // Store vertices that are being preprocessed.
+    // Sanity check: Costs can't decrease along a path.
+    const auto &weights = _graph.Weights();
+    double sum = 0;
+    for (const double w : weights)
+    {
+      if (w < 0)
+      {
+        std::cerr << "Negative edge weight [" << w << "] not supported"
+                  << std::endl;
+        return {};
+      }
+      sum += w;
+    }
+
+    double delta = _delta;
+    if (!(delta > 0))
+    {
+      delta = weights.empty() ? 1.0 : sum / weights.size();
+      if (!(delta > 0))
+        delta = 1.0;
+    }
+
+    std::vector<double> cost;
+    std::vector<std::size_t> previous;
+    detail::DeltaSteppingSearch(_graph, from, delta, _threads, cost,
+      previous);
+    std::map<VertexId, CostInfo> dist;
+    detail::CostMap(_graph, cost, previous, dist);
+    return dist;
+  }
+
+  /// \brief Multi-source Dijkstra algorithm.
+  /// Find, in a single pass, the shortest path from the nearest of several
+  /// source vertices to every vertex of a graph. This is the distance field
+  /// used for coverage maps, and it is cheaper than running Dijkstra from
+  /// each source and keeping the minimum.
+  /// \param[in] _graph A graph.
+  /// \param[in] _sources The starting vertices, all at cost 0.
+  /// \return A map where the keys are the destination vertices. For each
+  /// destination, the value is a pair with the shortest cost from the
+  /// nearest source and the previous neighbor Id in that path. Sources are
+  /// their own previous vertex, so following the previous vertices leads to
+  /// the nearest source. Vertices that cannot be reached have a cost of
+  /// MAX_D and kNullId as previous vertex. If a source vertex doesn't exist,
+  /// the function will return an empty map.
+  template<typename V, typename E, typename EdgeType, typename Storage>
+  std::map<VertexId, CostInfo> MultiSourceDijkstra(
+    const Graph<V, E, EdgeType, Storage> &_graph,
+    const std::vector<VertexId> &_sources)
+  {
+    GZ_MATH_PROFILE_ZONE("graph::MultiSourceDijkstra");
+
+    auto allVertices = _graph.Vertices();
+
+    // Sanity check: The source vertices should exist.
+    for (const VertexId &id : _sources)
+    {
+      if (allVertices.find(id) == allVertices.end())
+      {
+        std::cerr << "Vertex [" << id << "] Not found" << std::endl;
+        return {};
+      }
+    }
+
     std::priority_queue<CostInfo,
       std::vector<CostInfo>, std::greater<CostInfo>> pq;
-
-    // Create a map for distances and next neightbor and initialize all
-    // distances as infinite.
     std::map<VertexId, CostInfo> dist;
     for (auto const &v : allVertices)
+      dist.emplace_hint(dist.end(), v.first, std::make_pair(MAX_D, kNullId));
+
+    for (const VertexId &id : _sources)
     {
-      auto id = v.first;
-      dist[id] = std::make_pair(MAX_D, kNullId);
+      pq.push(std::make_pair(0.0, id));
+      dist[id] = std::make_pair(0.0, id);
     }
 
-    // Insert _from in the priority queue and initialize its distance as 0.
-    pq.push(std::make_pair(0.0, _from));
-    dist[_from] = std::make_pair(0.0, _from);
-
     while (!pq.empty())
     {
-      // This is the minimum distance vertex.
-      VertexId u = pq.top().second;
-
-      // Shortcut: Destination vertex found, exiting.
-      if (_to != kNullId && _to == u)
-        break;
-
+      const auto [cost, u] = pq.top();
       pq.pop();
 
-      for (auto const &edgePair : _graph.IncidentsFrom(u))
+      // Skip entries superseded by a cheaper path.
+      const double costU = dist[u].first;
+      if (cost > costU)
+        continue;
+
+      for (auto const &edgePair : _graph.IncidentsFromView(u))
       {
         const auto &edge = edgePair.second.get();
         const auto &v = edge.From(u);
-        double weight = edge.Weight();
+        auto &costV = dist[v];
+        if (costV.first > costU + edge.Weight())
+        {
+          costV = std::make_pair(costU + edge.Weight(), u);
+          pq.push(std::make_pair(costV.first, v));
+        }
+      }
+    }
+
+    return dist;
+  }
+
+  /// \brief Multi-source Dijkstra algorithm on a compressed sparse row
+  /// snapshot. This gives the same result as MultiSourceDijkstra on the
+  /// graph the snapshot was taken from.
+  /// \param[in] _graph A snapshot of a graph, see Freeze().
+  /// \param[in] _sources The starting vertices, all at cost 0.
+  /// \return A map where the keys are the destination vertices, see
+  /// MultiSourceDijkstra(const Graph<V, E, EdgeType, Storage> &,
+  /// const std::vector<VertexId> &).
+  inline std::map<VertexId, CostInfo> MultiSourceDijkstra(
+    const CsrGraph &_graph,
+    const std::vector<VertexId> &_sources)
+  {
+    GZ_MATH_PROFILE_ZONE("graph::MultiSourceDijkstra");
 
-        //  If there is shorted path to v through u.
-        if (dist[v].first > dist[u].first + weight)
+    std::vector<std::size_t> sources;
+    sources.reserve(_sources.size());
+    for (const VertexId &id : _sources)
+    {
+      sources.push_back(_graph.Index(id));
+      if (sources.back() == CsrGraph::kNullIndex)
+      {
+        std::cerr << "Vertex [" << id << "] Not found" << std::endl;
+        return {};
+      }
+    }
+
+    std::vector<double> cost;
+    std::vector<std::size_t> previous;
+    detail::DijkstraSearch(_graph, sources.data(), sources.size(),
+      CsrGraph::kNullIndex, std::pmr::new_delete_resource(), cost, previous);
+    std::map<VertexId, CostInfo> dist;
+    detail::CostMap(_graph, cost, previous, dist);
+    return dist;
+  }
+
+  namespace detail
+  {
+    /// \brief Search state of a vertex in AStarSearch and
+    /// BidirectionalSearch.
+    template<typename Key>
+    struct SearchEntry
+    {
+      /// \brief Cost of the best path found so far.
+      double cost;
+
+      /// \brief Previous vertex in that path.
+      Key previous;
+    };
+
+    /// \brief Search states stored in a hash map, for graphs without dense
+    /// vertex indices. Memory is proportional to the vertices reached.
+    template<typename Key>
+    class HashSearchStore
+    {
+      /// \brief Get the state of a vertex.
+      /// \param[in] _key The vertex.
+      /// \return The state, or nullptr if the vertex was not reached.
+      public: SearchEntry<Key> *Find(const Key &_key)
+      {
+        auto it = this->entries.find(_key);
+        return it == this->entries.end() ? nullptr : &it->second;
+      }
+
+      /// \brief Set the state of a vertex.
+      /// \param[in] _key The vertex.
+      /// \param[in] _entry The state.
+      public: void Set(const Key &_key, const SearchEntry<Key> &_entry)
+      {
+        this->entries[_key] = _entry;
+      }
+
+      /// \brief Call a function with each vertex reached and its state.
+      /// \param[in] _fn The function.
+      public: template<typename F>
+      void ForEach(F _fn) const
+      {
+        for (auto const &entry : this->entries)
+          _fn(entry.first, entry.second);
+      }
+
+      /// \brief The states.
+      private: std::unordered_map<Key, SearchEntry<Key>> entries;
+    };
+
+    /// \brief Search states stored in an array indexed by dense vertex
+    /// index, for CsrGraph.
+    class DenseSearchStore
+    {
+      /// \brief Constructor.
+      /// \param[in] _count Number of vertices.
+      public: explicit DenseSearchStore(const std::size_t _count)
+        : entries(_count, SearchEntry<std::size_t>{MAX_D, 0})
+      {
+      }
+
+      /// \brief Get the state of a vertex.
+      /// \param[in] _key The vertex.
+      /// \return The state, or nullptr if the vertex was not reached.
+      public: SearchEntry<std::size_t> *Find(const std::size_t _key)
+      {
+        // Unreached vertices keep exactly the initial cost
+        GZ_UTILS_WARN_IGNORE__FLOAT_EQUAL
+        return this->entries[_key].cost == MAX_D ?
+          nullptr : &this->entries[_key];
+        GZ_UTILS_WARN_RESUME__FLOAT_EQUAL
+      }
+
+      /// \brief Set the state of a vertex.
+      /// \param[in] _key The vertex.
+      /// \param[in] _entry The state.
+      public: void Set(const std::size_t _key,
+                       const SearchEntry<std::size_t> &_entry)
+      {
+        GZ_UTILS_WARN_IGNORE__FLOAT_EQUAL
+        if (this->entries[_key].cost == MAX_D)
+          this->reached.push_back(_key);
+        GZ_UTILS_WARN_RESUME__FLOAT_EQUAL
+        this->entries[_key] = _entry;
+      }
+
+      /// \brief Call a function with each vertex reached and its state.
+      /// \param[in] _fn The function.
+      public: template<typename F>
+      void ForEach(F _fn) const
+      {
+        for (const std::size_t key : this->reached)
+          _fn(key, this->entries[key]);
+      }
+
+      /// \brief The states, with a cost of MAX_D for vertices not reached.
+      private: std::vector<SearchEntry<std::size_t>> entries;
+
+      /// \brief The vertices reached.
+      private: std::vector<std::size_t> reached;
+    };
+
+    /// \brief A* search from one vertex to another, only visiting the
+    /// vertices it reaches.
+    /// \param[in] _from The starting vertex.
+    /// \param[in] _to The destination vertex.
+    /// \param[in] _expand Callable taking a vertex and a callable, which it
+    /// calls with the neighbor and weight of each outgoing edge.
+    /// \param[in] _heuristic Callable returning a lower bound of the cost
+    /// from a vertex to _to.
+    /// \param[in,out] _reached Empty store, filled with the state of each
+    /// vertex reached.
+    template<typename Key, typename Expand, typename Heuristic,
+             typename Store>
+    void AStarSearch(const Key &_from, const Key &_to, Expand _expand,
+                     Heuristic _heuristic, Store &_reached)
+    {
+      // Entries are the estimated total cost, the negated cost so far and
+      // the vertex. Among equal estimates the deepest vertex is expanded
+      // first, which avoids expanding every vertex on a plateau.
+      using QueueEntry = std::tuple<double, double, Key>;
+      std::priority_queue<QueueEntry,
+        std::vector<QueueEntry>, std::greater<QueueEntry>> pq;
+
+      _reached.Set(_from, SearchEntry<Key>{0.0, _from});
+      pq.push(QueueEntry(_heuristic(_from), -0.0, _from));
+      while (!pq.empty())
+      {
+        const double cost = -std::get<1>(pq.top());
+        const Key u = std::get<2>(pq.top());
+        pq.pop();
+
+        // Skip entries superseded by a cheaper path.
+        if (cost > _reached.Find(u)->cost)
+          continue;
+
+        // Shortcut: Destination vertex settled, exiting.
+        if (u == _to)
+          break;
+
+        _expand(u, [&](const Key &_v, const double _weight)
+        {
+          const double newCost = cost + _weight;
+          auto *entry = _reached.Find(_v);
+          if (!entry || entry->cost > newCost)
+          {
+            _reached.Set(_v, SearchEntry<Key>{newCost, u});
+            pq.push(QueueEntry(newCost + _heuristic(_v), -newCost, _v));
+          }
+        });
+      }
+    }
+
+    /// \brief Bidirectional Dijkstra search between two vertices. Searches
+    /// forward from _from and backward from _to at the same time and stops
+    /// when they meet on a shortest path.
+    /// \param[in] _from The starting vertex.
+    /// \param[in] _to The destination vertex.
+    /// \param[in] _expandForward Callable taking a vertex and a callable,
+    /// which it calls with the neighbor and weight of each outgoing edge.
+    /// \param[in] _expandBackward Same for the incoming edges.
+    /// \param[in,out] _reached Two empty stores, for the forward and
+    /// backward searches.
+    /// \param[out] _path The vertices of a shortest path from _from to _to,
+    /// empty if there is none.
+    template<typename Key, typename ExpandForward, typename ExpandBackward,
+             typename Store>
+    void BidirectionalSearch(
+      const Key &_from, const Key &_to, ExpandForward _expandForward,
+      ExpandBackward _expandBackward, Store (&_reached)[2],
+      std::vector<Key> &_path)
+    {
+      _path.clear();
+      if (_from == _to)
+      {
+        _path.push_back(_from);
+        return;
+      }
+
+      using QueueEntry = std::pair<double, Key>;
+      using Queue = std::priority_queue<QueueEntry,
+        std::vector<QueueEntry>, std::greater<QueueEntry>>;
+      Queue pq[2];
+      _reached[0].Set(_from, SearchEntry<Key>{0.0, _from});
+      _reached[1].Set(_to, SearchEntry<Key>{0.0, _to});
+      pq[0].push(QueueEntry(0.0, _from));
+      pq[1].push(QueueEntry(0.0, _to));
+
+      double best = MAX_D;
+      Key meeting = _from;
+      while (!pq[0].empty() && !pq[1].empty())
+      {
+        // No path through unsettled vertices can be shorter than
+        // the best one found.
+        if (pq[0].top().first + pq[1].top().first >= best)
+          break;
+
+        // Advance the side with the closest frontier.
+        const int side = pq[0].top().first <= pq[1].top().first ? 0 : 1;
+        const double cost = pq[side].top().first;
+        const Key u = pq[side].top().second;
+        pq[side].pop();
+        if (cost > _reached[side].Find(u)->cost)
+          continue;
+
+        auto relax = [&](const Key &_v, const double _weight)
+        {
+          const double newCost = cost + _weight;
+          auto *entry = _reached[side].Find(_v);
+          if (entry && entry->cost <= newCost)
+            return;
+          _reached[side].Set(_v, SearchEntry<Key>{newCost, u});
+          pq[side].push(QueueEntry(newCost, _v));
+
+          // Check whether the searches meet at _v.
+          auto *other = _reached[1 - side].Find(_v);
+          if (other && newCost + other->cost < best)
+          {
+            best = newCost + other->cost;
+            meeting = _v;
+          }
+        };
+        if (side == 0)
+          _expandForward(u, relax);
+        else
+          _expandBackward(u, relax);
+      }
+
+      GZ_UTILS_WARN_IGNORE__FLOAT_EQUAL
+      if (best == MAX_D)
+        return;
+      GZ_UTILS_WARN_RESUME__FLOAT_EQUAL
+
+      // Walk back to _from, then forward to _to.
+      for (Key v = meeting; v != _from; v = _reached[0].Find(v)->previous)
+        _path.push_back(v);
+      _path.push_back(_from);
+      std::reverse(_path.begin(), _path.end());
+      for (Key v = meeting; v != _to;)
+      {
+        v = _reached[1].Find(v)->previous;
+        _path.push_back(v);
+      }
+    }
+  }
+
+  /// \brief A* algorithm.
+  /// Find the shortest path between two vertices of a graph, guided by a
+  /// heuristic. The search stops as soon as the shortest path to _to is
+  /// known, and only visits vertices that may be on it, which on large
+  /// graphs is much faster than Dijkstra. With a heuristic that always
+  /// returns zero it is a Dijkstra search that stops at _to.
+  /// \param[in] _graph A graph.
+  /// \param[in] _from The starting vertex.
+  /// \param[in] _to The destination vertex.
+  /// \param[in] _heuristic Callable taking a VertexId and returning an
+  /// estimate of the cost from that vertex to _to, such as the straight
+  /// line distance. The path found is a shortest path if the estimates
+  /// never exceed the actual costs.
+  /// \return A map with the same meaning as the result of
+  /// Dijkstra(const Graph<V, E, EdgeType, Storage> &, const VertexId &,
+  /// const VertexId &) with a destination vertex: following the previous
+  /// neighbors from the entry with key = _to gives the path back to _from.
+  /// Only the vertices reached by the search have an entry. If _to can't be
+  /// reached, its cost is MAX_D and its previous vertex kNullId. If the
+  /// source or destination vertex don't exist, the function will return an
+  /// empty map.
+  template<typename V, typename E, typename EdgeType, typename Storage,
+           typename Heuristic>
+  std::map<VertexId, CostInfo> AStar(
+    const Graph<V, E, EdgeType, Storage> &_graph,
+    const VertexId &_from,
+    const VertexId &_to,
+    Heuristic _heuristic)
+  {
+    GZ_MATH_PROFILE_ZONE("graph::AStar");
+
+    for (const VertexId &id : {_from, _to})
+    {
+      if (!_graph.VertexFromId(id).Valid())
+      {
+        std::cerr << "Vertex [" << id << "] Not found" << std::endl;
+        return {};
+      }
+    }
+
+    detail::HashSearchStore<VertexId> reached;
+    detail::AStarSearch(_from, _to,
+      [&](const VertexId &_u, const auto &_visit)
+      {
+        for (auto const &edgePair : _graph.IncidentsFromView(_u))
         {
-          // Updating distance of v.
-          dist[v] = std::make_pair(dist[u].first + weight, u);
-          pq.push(std::make_pair(dist[v].first, v));
+          const auto &edge = edgePair.second.get();
+          _visit(edge.From(_u), edge.Weight());
         }
+      }, _heuristic, reached);
+
+    std::map<VertexId, CostInfo> dist;
+    reached.ForEach([&](const VertexId &_v, const auto &_entry)
+    {
+      dist.emplace(_v, std::make_pair(_entry.cost, _entry.previous));
+    });
+    dist.emplace(_to, std::make_pair(MAX_D, kNullId));
+    return dist;
+  }
+
+  /// \brief A* algorithm on a compressed sparse row snapshot, see
+  /// AStar(const Graph<V, E, EdgeType, Storage> &, const VertexId &,
+  /// const VertexId &, Heuristic).
+  /// \param[in] _graph A snapshot of a graph, see Freeze().
+  /// \param[in] _from The starting vertex.
+  /// \param[in] _to The destination vertex.
+  /// \param[in] _heuristic Callable taking a VertexId and returning an
+  /// estimate of the cost from that vertex to _to.
+  /// \return A map where following the previous neighbors from the entry
+  /// with key = _to gives the path back to _from.
+  template<typename Heuristic>
+  std::map<VertexId, CostInfo> AStar(const CsrGraph &_graph,
+                                     const VertexId &_from,
+                                     const VertexId &_to,
+                                     Heuristic _heuristic)
+  {
+    GZ_MATH_PROFILE_ZONE("graph::AStar");
+
+    const std::size_t from = _graph.Index(_from);
+    const std::size_t to = _graph.Index(_to);
+    for (const VertexId &id : {_from, _to})
+    {
+      if (_graph.Index(id) == CsrGraph::kNullIndex)
+      {
+        std::cerr << "Vertex [" << id << "] Not found" << std::endl;
+        return {};
       }
     }
 
+    const auto &offsets = _graph.Offsets();
+    const auto &neighbors = _graph.Neighbors();
+    const auto &weights = _graph.Weights();
+    detail::DenseSearchStore reached(_graph.VertexCount());
+    detail::AStarSearch(from, to,
+      [&](const std::size_t _u, const auto &_visit)
+      {
+        for (std::size_t e = offsets[_u]; e < offsets[_u + 1]; ++e)
+          _visit(neighbors[e], weights[e]);
+      },
+      [&](const std::size_t _u)
+      {
+        return _heuristic(_graph.Id(_u));
+      }, reached);
+
+    // Insert the vertices in key order, so each insertion is O(1)
+    std::vector<std::size_t> keys;
+    reached.ForEach([&](const std::size_t _v, const auto &)
+    {
+      keys.push_back(_v);
+    });
+    std::sort(keys.begin(), keys.end());
+    std::map<VertexId, CostInfo> dist;
+    for (const std::size_t v : keys)
+    {
+      const auto *entry = reached.Find(v);
+      dist.emplace_hint(dist.end(), _graph.Id(v),
+        std::make_pair(entry->cost, _graph.Id(entry->previous)));
+    }
+    dist.emplace(_to, std::make_pair(MAX_D, kNullId));
+    return dist;
+  }
+
+  /// \brief Bidirectional Dijkstra algorithm.
+  /// Find the shortest path between two vertices of a graph by searching
+  /// from both ends at once, which visits far fewer vertices than Dijkstra
+  /// on large graphs.
+  /// \param[in] _graph A graph.
+  /// \param[in] _from The starting vertex.
+  /// \param[in] _to The destination vertex.
+  /// \return A map with one entry per vertex of the shortest path, where
+  /// the key is the vertex and the value is the pair of the cost from
+  /// _from and the previous vertex in the path. As in Dijkstra, the
+  /// previous vertex of _from is _from. If _to can't be reached, the map
+  /// only has an entry for _to, with cost MAX_D and previous vertex kNullId.
+  /// If the source or destination vertex don't exist, the function will
+  /// return an empty map.
+  template<typename V, typename E, typename EdgeType, typename Storage>
+  std::map<VertexId, CostInfo> BidirectionalDijkstra(
+    const Graph<V, E, EdgeType, Storage> &_graph,
+    const VertexId &_from,
+    const VertexId &_to)
+  {
+    GZ_MATH_PROFILE_ZONE("graph::BidirectionalDijkstra");
+
+    for (const VertexId &id : {_from, _to})
+    {
+      if (!_graph.VertexFromId(id).Valid())
+      {
+        std::cerr << "Vertex [" << id << "] Not found" << std::endl;
+        return {};
+      }
+    }
+
+    std::vector<VertexId> path;
+    detail::HashSearchStore<VertexId> reached[2];
+    detail::BidirectionalSearch(_from, _to,
+      [&](const VertexId &_u, const auto &_visit)
+      {
+        for (auto const &edgePair : _graph.IncidentsFromView(_u))
+        {
+          const auto &edge = edgePair.second.get();
+          _visit(edge.From(_u), edge.Weight());
+        }
+      },
+      [&](const VertexId &_u, const auto &_visit)
+      {
+        for (auto const &edgePair : _graph.IncidentsToView(_u))
+        {
+          const auto &edge = edgePair.second.get();
+          _visit(edge.To(_u), edge.Weight());
+        }
+      }, reached, path);
+
+    std::map<VertexId, CostInfo> dist;
+    if (path.empty())
+    {
+      dist.emplace(_to, std::make_pair(MAX_D, kNullId));
+      return dist;
+    }
+
+    // Parallel edges may join consecutive vertices, use the cheapest.
+    double cost = 0.0;
+    dist.emplace(_from, std::make_pair(0.0, _from));
+    for (std::size_t i = 1; i < path.size(); ++i)
+    {
+      double weight = MAX_D;
+      for (auto const &edgePair : _graph.IncidentsFromView(path[i - 1]))
+      {
+        const auto &edge = edgePair.second.get();
+        if (edge.From(path[i - 1]) == path[i])
+          weight = std::min(weight, edge.Weight());
+      }
+      cost += weight;
+      dist.emplace(path[i], std::make_pair(cost, path[i - 1]));
+    }
+    return dist;
+  }
+
+  /// \brief Bidirectional Dijkstra algorithm on a compressed sparse row
+  /// snapshot, see
+  /// BidirectionalDijkstra(const Graph<V, E, EdgeType, Storage> &,
+  /// const VertexId &, const VertexId &).
+  /// \param[in] _graph A snapshot of a graph, see Freeze().
+  /// \param[in] _from The starting vertex.
+  /// \param[in] _to The destination vertex.
+  /// \return A map with one entry per vertex of the shortest path.
+  inline std::map<VertexId, CostInfo> BidirectionalDijkstra(
+    const CsrGraph &_graph,
+    const VertexId &_from,
+    const VertexId &_to)
+  {
+    GZ_MATH_PROFILE_ZONE("graph::BidirectionalDijkstra");
+
+    const std::size_t from = _graph.Index(_from);
+    const std::size_t to = _graph.Index(_to);
+    for (const VertexId &id : {_from, _to})
+    {
+      if (_graph.Index(id) == CsrGraph::kNullIndex)
+      {
+        std::cerr << "Vertex [" << id << "] Not found" << std::endl;
+        return {};
+      }
+    }
+
+    const auto &offsets = _graph.Offsets();
+    const auto &neighbors = _graph.Neighbors();
+    const auto &weights = _graph.Weights();
+    const auto &inOffsets = _graph.InOffsets();
+    const auto &inNeighbors = _graph.InNeighbors();
+    const auto &inWeights = _graph.InWeights();
+    std::vector<std::size_t> path;
+    detail::DenseSearchStore reached[2] = {
+      detail::DenseSearchStore(_graph.VertexCount()),
+      detail::DenseSearchStore(_graph.VertexCount())};
+    detail::BidirectionalSearch(from, to,
+      [&](const std::size_t _u, const auto &_visit)
+      {
+        for (std::size_t e = offsets[_u]; e < offsets[_u + 1]; ++e)
+          _visit(neighbors[e], weights[e]);
+      },
+      [&](const std::size_t _u, const auto &_visit)
+      {
+        for (std::size_t e = inOffsets[_u]; e < inOffsets[_u + 1]; ++e)
+          _visit(inNeighbors[e], inWeights[e]);
+      }, reached, path);
+
+    std::map<VertexId, CostInfo> dist;
+    if (path.empty())
+    {
+      dist.emplace(_to, std::make_pair(MAX_D, kNullId));
+      return dist;
+    }
+
+    // Parallel edges may join consecutive vertices, use the cheapest.
+    double cost = 0.0;
+    dist.emplace(_from, std::make_pair(0.0, _from));
+    for (std::size_t i = 1; i < path.size(); ++i)
+    {
+      double weight = MAX_D;
+      for (std::size_t e = offsets[path[i - 1]]; e < offsets[path[i - 1] + 1];
+           ++e)
+      {
+        if (neighbors[e] == path[i])
+          weight = std::min(weight, weights[e]);
+      }
+      cost += weight;
+      dist.emplace(_graph.Id(path[i]),
+        std::make_pair(cost, _graph.Id(path[i - 1])));
+    }
     return dist;
   }
 
+  namespace detail
+  {
+    /// \brief Kahn's algorithm, reading the adjacency lists of the graph in
+    /// place. The first level has the vertices without incoming edges, and
+    /// each following level has the vertices whose incoming edges all come
+    /// from earlier levels. Vertices in a level are sorted by Id.
+    /// \param[in] _graph A directed graph.
+    /// \param[out] _levels The levels. When the graph has a cycle, the
+    /// vertices on or after the cycle are missing.
+    /// \return True if every vertex was placed in a level, false if the
+    /// graph has a cycle.
+    template<typename V, typename E, typename Storage>
+    bool KahnLevels(const DirectedGraph<V, E, Storage> &_graph,
+                    std::vector<std::vector<VertexId>> &_levels)
+    {
+      _levels.clear();
+
+      // Number of incoming edges from vertices not placed yet.
+      std::unordered_map<VertexId, std::size_t> inDegree;
+      std::vector<VertexId> level;
+      for (auto const &v : _graph.Vertices())
+      {
+        const std::size_t degree = _graph.IncidentsToView(v.first).Size();
+        inDegree.emplace(v.first, degree);
+        if (degree == 0)
+          level.push_back(v.first);
+      }
+
+      std::size_t placed = 0;
+      std::vector<VertexId> next;
+      while (!level.empty())
+      {
+        placed += level.size();
+        next.clear();
+        for (const VertexId id : level)
+        {
+          for (auto const &adj : _graph.AdjacentsFromView(id))
+          {
+            if (--inDegree.find(adj.first)->second == 0)
+              next.push_back(adj.first);
+          }
+        }
+        std::sort(next.begin(), next.end());
+        _levels.push_back(std::move(level));
+        level = next;
+      }
+
+      return placed == inDegree.size();
+    }
+  }
+
+  /// \brief Group the vertices of a directed acyclic graph in levels of
+  /// independent vertices, using Kahn's algorithm. The first level has the
+  /// vertices without incoming edges, and each following level has the
+  /// vertices whose incoming edges all come from earlier levels, so the
+  /// vertices of a level can be processed in parallel once the previous
+  /// levels are done. The graph is read in place, without copies.
+  /// \sa https://en.wikipedia.org/wiki/Topological_sorting
+  /// \param[in] _graph A directed graph.
+  /// \return The levels, each sorted by vertex Id. It is empty if the graph
+  /// has a cycle, see HasCycle().
+  template<typename V, typename E, typename Storage>
+  std::vector<std::vector<VertexId>> TopologicalLevels(
+    const DirectedGraph<V, E, Storage> &_graph)
+  {
+    std::vector<std::vector<VertexId>> levels;
+    if (!detail::KahnLevels(_graph, levels))
+      levels.clear();
+    return levels;
+  }
+
+  /// \brief Topological sort of a directed acyclic graph: every vertex
+  /// comes after all the vertices with an edge to it. This is the
+  /// concatenation of the TopologicalLevels().
+  /// \param[in] _graph A directed graph.
+  /// \return The sorted vertex Ids. It is empty if the graph has a cycle.
+  template<typename V, typename E, typename Storage>
+  std::vector<VertexId> TopologicalSort(
+    const DirectedGraph<V, E, Storage> &_graph)
+  {
+    std::vector<VertexId> sorted;
+    for (auto const &level : TopologicalLevels(_graph))
+      sorted.insert(sorted.end(), level.begin(), level.end());
+    return sorted;
+  }
+
+  /// \brief Get whether a directed graph has a cycle. An edge from a
+  /// vertex to itself is a cycle.
+  /// \param[in] _graph A directed graph.
+  /// \return True if the graph has a cycle.
+  template<typename V, typename E, typename Storage>
+  bool HasCycle(const DirectedGraph<V, E, Storage> &_graph)
+  {
+    std::vector<std::vector<VertexId>> levels;
+    return !detail::KahnLevels(_graph, levels);
+  }
+
+  /// \brief Calculate the strongly connected components of a directed
+  /// graph with Tarjan's algorithm. In a strongly connected component,
+  /// every vertex can be reached from every other vertex. The search is
+  /// iterative, so deep graphs do not overflow the stack, and it reads the
+  /// adjacency lists of the graph in place.
+  /// \param[in] _graph A directed graph.
+  /// \return The components, each sorted by vertex Id. A component comes
+  /// before every component with an edge to it, which is a reverse
+  /// topological order of the components.
+  template<typename V, typename E, typename Storage>
+  std::vector<std::vector<VertexId>> StronglyConnectedComponents(
+    const DirectedGraph<V, E, Storage> &_graph)
+  {
+    using VertexView = typename DirectedGraph<V, E, Storage>::VertexView;
+    using ViewIterator = typename VertexView::Iterator;
+    constexpr std::size_t kUnvisited =
+      std::numeric_limits<std::size_t>::max();
+
+    // Dense index of each vertex, in Id order.
+    std::vector<VertexId> ids;
+    std::unordered_map<VertexId, std::size_t> index;
+    for (auto const &v : _graph.Vertices())
+    {
+      index.emplace(v.first, ids.size());
+      ids.push_back(v.first);
+    }
+
+    const std::size_t n = ids.size();
+    std::vector<std::size_t> order(n, kUnvisited);
+    std::vector<std::size_t> low(n);
+    std::vector<bool> onStack(n, false);
+    std::vector<std::size_t> stack;
+
+    // A vertex being explored and its next adjacent vertex. The iterator
+    // points into the view, which stays in place because the frames are
+    // reserved for the deepest possible search.
+    struct Frame
+    {
+      std::size_t vertex;
+      VertexView view;
+      std::optional<ViewIterator> next;
+    };
+    std::vector<Frame> frames;
+    frames.reserve(n);
+
+    std::vector<std::vector<VertexId>> components;
+    std::size_t counter = 0;
+    auto visit = [&](const std::size_t _v)
+    {
+      order[_v] = low[_v] = counter++;
+      stack.push_back(_v);
+      onStack[_v] = true;
+      frames.push_back({_v, _graph.AdjacentsFromView(ids[_v]), std::nullopt});
+      frames.back().next.emplace(frames.back().view.begin());
+    };
+
+    for (std::size_t root = 0; root < n; ++root)
+    {
+      if (order[root] != kUnvisited)
+        continue;
+
+      visit(root);
+      while (!frames.empty())
+      {
+        Frame &frame = frames.back();
+        const std::size_t v = frame.vertex;
+        if (*frame.next != frame.view.end())
+        {
+          const std::size_t w = index.find((**frame.next).first)->second;
+          ++*frame.next;
+          if (order[w] == kUnvisited)
+            visit(w);
+          else if (onStack[w])
+            low[v] = std::min(low[v], order[w]);
+          continue;
+        }
+
+        frames.pop_back();
+        if (!frames.empty())
+        {
+          const std::size_t parent = frames.back().vertex;
+          low[parent] = std::min(low[parent], low[v]);
+        }
+
+        // v is the root of a component, which is on top of the stack.
+        if (low[v] == order[v])
+        {
+          std::vector<VertexId> component;
+          std::size_t w;
+          do
+          {
+            w = stack.back();
+            stack.pop_back();
+            onStack[w] = false;
+            component.push_back(ids[w]);
+          } while (w != v);
+          std::sort(component.begin(), component.end());
+          components.push_back(std::move(component));
+        }
+      }
+    }
+
+    return components;
+  }
+
   /// \brief Calculate the connected components of an undirected graph.
   /// A connected component of an undirected graph is a subgraph in which any
   /// two vertices are connected to each other by paths, and which is connected
   /// to no additional vertices in the supergraph.
+  /// To follow the components of a graph that changes often, see
+  /// IncrementalComponents.
   /// \sa https://en.wikipedia.org/wiki/Connected_component_(graph_theory)
   /// \param[in] _graph A graph.
   /// \return A vector of graphs. Each element of the graph is a component
   /// (subgraph) of the original graph.
-  template<typename V, typename E>
-  std::vector<UndirectedGraph<V, E>> ConnectedComponents(
-    const UndirectedGraph<V, E> &_graph)
+  template<typename V, typename E, typename Storage>
+  std::vector<UndirectedGraph<V, E, Storage>> ConnectedComponents(
+    const UndirectedGraph<V, E, Storage> &_graph)
   {
     std::map<VertexId, unsigned int> visited;
     unsigned int componentCount = 0;
@@ -304,7 +1916,7 @@ namespace graph
       }
     }
 
-    std::vector<UndirectedGraph<V, E>> res(componentCount);
+    std::vector<UndirectedGraph<V, E, Storage>> res(componentCount);
 
     // Create the vertices.
     for (auto const &vPair : _graph.Vertices())
@@ -331,8 +1943,9 @@ namespace graph
   /// \param[in] _graph A directed graph.
   /// \return An undirected graph with the same vertices and edges as the
   /// original graph.
-  template<typename V, typename E>
-  UndirectedGraph<V, E> ToUndirectedGraph(const DirectedGraph<V, E> &_graph)
+  template<typename V, typename E, typename Storage>
+  UndirectedGraph<V, E, Storage> ToUndirectedGraph(
+    const DirectedGraph<V, E, Storage> &_graph)
   {
     std::vector<Vertex<V>> vertices;
     std::vector<EdgeInitializer<E>> edges;
@@ -351,7 +1964,7 @@ namespace graph
       edges.push_back({e.Vertices(), e.Data(), e.Weight()});
     }
 
-    return UndirectedGraph<V, E>(vertices, edges);
+    return UndirectedGraph<V, E, Storage>(vertices, edges);
   }
 }
 }
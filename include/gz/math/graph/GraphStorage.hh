@@ -0,0 +1,487 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_GRAPH_GRAPHSTORAGE_HH_
+#define GZ_MATH_GRAPH_GRAPHSTORAGE_HH_
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gz/math/config.hh>
+
+namespace gz
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_MATH_VERSION_NAMESPACE {
+namespace graph
+{
+  /// \brief An associative container for small integer keys with constant
+  /// time lookup.
+  ///
+  /// Elements live in fixed size pages indexed by key, so finding an
+  /// element is two array accesses and elements never move: references
+  /// and pointers stay valid until the element is erased, as with
+  /// std::map. Iteration visits the elements in increasing key order.
+  ///
+  /// Memory grows with the largest key, not with the number of elements,
+  /// so keys should be dense, such as the Ids handed out by Graph.
+  ///
+  /// It offers the subset of the std::map interface used by Graph.
+  /// \tparam K Unsigned integer key type.
+  /// \tparam T Element type.
+  template<typename K, typename T>
+  class SlotMap
+  {
+    static_assert(std::is_integral_v<K> && std::is_unsigned_v<K>,
+      "K must be an unsigned integer type");
+
+    /// \brief Key type.
+    public: using key_type = K;
+
+    /// \brief Element type.
+    public: using mapped_type = T;
+
+    /// \brief Type of the stored pairs of key and element.
+    public: using value_type = std::pair<const K, T>;
+
+    /// \brief Number of slots in a page.
+    private: static constexpr std::size_t kPageSize = 64;
+
+    /// \brief A page of slots.
+    private: using Page = std::array<std::optional<value_type>, kPageSize>;
+
+    /// \brief Forward iterator over the elements in key order.
+    /// \tparam Const True for read only iterators.
+    private: template<bool Const>
+    class IteratorType
+    {
+      /// \brief The container iterated.
+      private: using Owner = std::conditional_t<Const,
+        const SlotMap, SlotMap>;
+
+      /// \brief Forward iterator.
+      public: using iterator_category = std::forward_iterator_tag;
+
+      /// \brief Type of the elements.
+      public: using value_type = SlotMap::value_type;
+
+      /// \brief Type of the distance between iterators.
+      public: using difference_type = std::ptrdiff_t;
+
+      /// \brief Pointer to an element.
+      public: using pointer = std::conditional_t<Const,
+        const value_type *, value_type *>;
+
+      /// \brief Reference to an element.
+      public: using reference = std::conditional_t<Const,
+        const value_type &, value_type &>;
+
+      /// \brief Default constructor.
+      public: IteratorType() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _owner The container.
+      /// \param[in] _slot Index of the slot, skipped forward to the next
+      /// element.
+      public: IteratorType(Owner *_owner, const std::size_t _slot)
+        : owner(_owner), slot(_slot)
+      {
+        this->Skip();
+      }
+
+      /// \brief Conversion to a read only iterator.
+      /// \return The read only iterator.
+      public: template<bool C = Const, typename = std::enable_if_t<!C>>
+      operator IteratorType<true>() const
+      {
+        return IteratorType<true>(this->owner, this->slot);
+      }
+
+      /// \brief Get the current element.
+      /// \return Reference to the pair of key and element.
+      public: reference operator*() const
+      {
+        return *this->owner->Slot(this->slot);
+      }
+
+      /// \brief Access the current element.
+      /// \return Pointer to the pair of key and element.
+      public: pointer operator->() const
+      {
+        return &*this->owner->Slot(this->slot);
+      }
+
+      /// \brief Move to the next element.
+      /// \return This iterator.
+      public: IteratorType &operator++()
+      {
+        ++this->slot;
+        this->Skip();
+        return *this;
+      }
+
+      /// \brief Equality operator.
+      /// \param[in] _other Iterator to compare to.
+      /// \return True if both iterators are at the same position.
+      public: bool operator==(const IteratorType &_other) const
+      {
+        return this->slot == _other.slot;
+      }
+
+      /// \brief Inequality operator.
+      /// \param[in] _other Iterator to compare to.
+      /// \return True if the iterators are at different positions.
+      public: bool operator!=(const IteratorType &_other) const
+      {
+        return this->slot != _other.slot;
+      }
+
+      /// \brief Move forward to the next slot with an element, skipping
+      /// missing pages at once.
+      private: void Skip()
+      {
+        const std::size_t end = this->owner->SlotCount();
+        while (this->slot < end)
+        {
+          const auto &page = this->owner->pages[this->slot / kPageSize];
+          if (!page)
+            this->slot = (this->slot / kPageSize + 1) * kPageSize;
+          else if (!(*page)[this->slot % kPageSize])
+            ++this->slot;
+          else
+            return;
+        }
+        this->slot = end;
+      }
+
+      /// \brief The container iterated.
+      private: Owner *owner{nullptr};
+
+      /// \brief Index of the current slot.
+      private: std::size_t slot{0};
+    };
+
+    /// \brief Iterator.
+    public: using iterator = IteratorType<false>;
+
+    /// \brief Read only iterator.
+    public: using const_iterator = IteratorType<true>;
+
+    /// \brief Default constructor, an empty container.
+    public: SlotMap() = default;
+
+    /// \brief Copy constructor.
+    /// \param[in] _other Container to copy.
+    public: SlotMap(const SlotMap &_other)
+    {
+      *this = _other;
+    }
+
+    /// \brief Move constructor.
+    /// \param[in] _other Container to move from.
+    public: SlotMap(SlotMap &&_other) noexcept = default;
+
+    /// \brief Copy assignment.
+    /// \param[in] _other Container to copy.
+    /// \return This container.
+    public: SlotMap &operator=(const SlotMap &_other)
+    {
+      if (this == &_other)
+        return *this;
+      this->pages.clear();
+      this->pages.resize(_other.pages.size());
+      for (std::size_t i = 0; i < _other.pages.size(); ++i)
+      {
+        if (_other.pages[i])
+          this->pages[i] = std::make_unique<Page>(*_other.pages[i]);
+      }
+      this->elementCount = _other.elementCount;
+      return *this;
+    }
+
+    /// \brief Move assignment.
+    /// \param[in] _other Container to move from.
+    /// \return This container.
+    public: SlotMap &operator=(SlotMap &&_other) noexcept = default;
+
+    /// \brief Get an iterator to the element with the smallest key.
+    /// \return The iterator.
+    public: iterator begin()
+    {
+      return iterator(this, 0);
+    }
+
+    /// \brief Get an iterator past the element with the largest key.
+    /// \return The iterator.
+    public: iterator end()
+    {
+      return iterator(this, this->SlotCount());
+    }
+
+    /// \brief Get an iterator to the element with the smallest key.
+    /// \return The iterator.
+    public: const_iterator begin() const
+    {
+      return const_iterator(this, 0);
+    }
+
+    /// \brief Get an iterator past the element with the largest key.
+    /// \return The iterator.
+    public: const_iterator end() const
+    {
+      return const_iterator(this, this->SlotCount());
+    }
+
+    /// \brief Get whether there are no elements.
+    /// \return True if there are no elements.
+    public: bool empty() const
+    {
+      return this->elementCount == 0;
+    }
+
+    /// \brief Get the number of elements.
+    /// \return Number of elements.
+    public: std::size_t size() const
+    {
+      return this->elementCount;
+    }
+
+    /// \brief Find an element.
+    /// \param[in] _key Key of the element.
+    /// \return Iterator to the element, or end() if not found.
+    public: iterator find(const K &_key)
+    {
+      return this->Contains(_key) ?
+        iterator(this, static_cast<std::size_t>(_key)) : this->end();
+    }
+
+    /// \brief Find an element.
+    /// \param[in] _key Key of the element.
+    /// \return Iterator to the element, or end() if not found.
+    public: const_iterator find(const K &_key) const
+    {
+      return this->Contains(_key) ?
+        const_iterator(this, static_cast<std::size_t>(_key)) : this->end();
+    }
+
+    /// \brief Count the elements with a key.
+    /// \param[in] _key The key.
+    /// \return 1 if there is an element with the key, 0 otherwise.
+    public: std::size_t count(const K &_key) const
+    {
+      return this->Contains(_key) ? 1u : 0u;
+    }
+
+    /// \brief Insert an element if its key is not used.
+    /// \param[in] _value Pair of key and element.
+    /// \return Iterator to the element with the key, and true if the element
+    /// was inserted.
+    public: std::pair<iterator, bool> insert(value_type _value)
+    {
+      const std::size_t key = static_cast<std::size_t>(_value.first);
+      auto &slot = this->Reserve(key);
+      if (slot)
+        return {iterator(this, key), false};
+      slot.emplace(std::move(_value));
+      ++this->elementCount;
+      return {iterator(this, key), true};
+    }
+
+    /// \brief Insert an element if its key is not used. Lookups are
+    /// constant time, so the hint is only accepted for compatibility with
+    /// std::map.
+    /// \param[in] _hint Unused.
+    /// \param[in] _value Pair of key and element.
+    /// \return Iterator to the element with the key.
+    public: iterator insert(const_iterator /*_hint*/, value_type _value)
+    {
+      return this->insert(std::move(_value)).first;
+    }
+
+    /// \brief Access an element, inserting a default one if its key is not
+    /// used.
+    /// \param[in] _key Key of the element.
+    /// \return Reference to the element.
+    public: T &operator[](const K &_key)
+    {
+      auto &slot = this->Reserve(static_cast<std::size_t>(_key));
+      if (!slot)
+      {
+        slot.emplace(_key, T());
+        ++this->elementCount;
+      }
+      return slot->second;
+    }
+
+    /// \brief Remove an element.
+    /// \param[in] _key Key of the element.
+    /// \return Number of elements removed, 0 or 1.
+    public: std::size_t erase(const K &_key)
+    {
+      if (!this->Contains(_key))
+        return 0;
+      this->Slot(static_cast<std::size_t>(_key)).reset();
+      --this->elementCount;
+      return 1;
+    }
+
+    /// \brief Remove all elements.
+    public: void clear()
+    {
+      this->pages.clear();
+      this->elementCount = 0;
+    }
+
+    /// \brief Get whether a key is used.
+    /// \param[in] _key The key.
+    /// \return True if there is an element with the key.
+    private: bool Contains(const K &_key) const
+    {
+      const std::size_t key = static_cast<std::size_t>(_key);
+      const std::size_t page = key / kPageSize;
+      return page < this->pages.size() && this->pages[page] &&
+        (*this->pages[page])[key % kPageSize].has_value();
+    }
+
+    /// \brief Get the number of slots covered by the pages.
+    /// \return Number of pages times the page size.
+    private: std::size_t SlotCount() const
+    {
+      return this->pages.size() * kPageSize;
+    }
+
+    /// \brief Get a slot whose page exists.
+    /// \param[in] _slot Index of the slot.
+    /// \return Reference to the slot.
+    private: std::optional<value_type> &Slot(const std::size_t _slot)
+    {
+      return (*this->pages[_slot / kPageSize])[_slot % kPageSize];
+    }
+
+    /// \brief Get a slot whose page exists.
+    /// \param[in] _slot Index of the slot.
+    /// \return Reference to the slot.
+    private: const std::optional<value_type> &Slot(
+      const std::size_t _slot) const
+    {
+      return (*this->pages[_slot / kPageSize])[_slot % kPageSize];
+    }
+
+    /// \brief Get a slot, creating its page if needed.
+    /// \param[in] _slot Index of the slot.
+    /// \return Reference to the slot.
+    private: std::optional<value_type> &Reserve(const std::size_t _slot)
+    {
+      const std::size_t page = _slot / kPageSize;
+      if (page >= this->pages.size())
+        this->pages.resize(page + 1);
+      if (!this->pages[page])
+        this->pages[page] = std::make_unique<Page>();
+      return this->Slot(_slot);
+    }
+
+    /// \brief Pages of slots, missing pages have no elements.
+    private: std::vector<std::unique_ptr<Page>> pages;
+
+    /// \brief Number of elements.
+    private: std::size_t elementCount{0};
+  };
+
+  /// \brief Graph storage that keeps vertices, edges and adjacency lists
+  /// in std::map. Lookups by Id are O(log n), and Ids can take any value.
+  /// This is the default.
+  struct MapStorage
+  {
+    /// \brief Container from Ids to elements.
+    template<typename K, typename T>
+    using Map = std::map<K, T>;
+
+    /// \brief Container of the edge Ids of a vertex.
+    template<typename K>
+    using Set = std::set<K>;
+
+    /// \brief Container from names to vertex Ids.
+    template<typename K, typename T>
+    using MultiMap = std::multimap<K, T>;
+
+    /// \brief Whether the containers take a std::pmr::memory_resource.
+    static constexpr bool kMemoryResource = false;
+  };
+
+  /// \brief Graph storage that keeps vertices, edges and adjacency lists
+  /// in SlotMap. Lookups by Id are O(1) and elements are stored in
+  /// contiguous pages, which suits graphs whose Ids are handed out by the
+  /// graph itself, or are otherwise small and dense.
+  struct SlotMapStorage
+  {
+    /// \brief Container from Ids to elements.
+    template<typename K, typename T>
+    using Map = SlotMap<K, T>;
+
+    /// \brief Container of the edge Ids of a vertex.
+    template<typename K>
+    using Set = std::set<K>;
+
+    /// \brief Container from names to vertex Ids.
+    template<typename K, typename T>
+    using MultiMap = std::multimap<K, T>;
+
+    /// \brief Whether the containers take a std::pmr::memory_resource.
+    static constexpr bool kMemoryResource = false;
+  };
+
+  /// \brief Graph storage that keeps vertices, edges, adjacency lists and
+  /// the name index in std::pmr containers, which allocate every node from
+  /// the std::pmr::memory_resource given to the Graph constructor. Backing
+  /// a short lived graph with a std::pmr::monotonic_buffer_resource makes
+  /// building it cheap and releases it at once. Lookups by Id are
+  /// O(log n) as with MapStorage.
+  ///
+  /// Vertex names are regular strings, so names too long for the small
+  /// string buffer of the standard library still use the global heap.
+  struct PmrStorage
+  {
+    /// \brief Container from Ids to elements.
+    template<typename K, typename T>
+    using Map = std::pmr::map<K, T>;
+
+    /// \brief Container of the edge Ids of a vertex.
+    template<typename K>
+    using Set = std::pmr::set<K>;
+
+    /// \brief Container from names to vertex Ids.
+    template<typename K, typename T>
+    using MultiMap = std::pmr::multimap<K, T>;
+
+    /// \brief Whether the containers take a std::pmr::memory_resource.
+    static constexpr bool kMemoryResource = true;
+  };
+}
+}
+}
+}
+#endif
@@ -0,0 +1,287 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_GRAPH_INCREMENTALCOMPONENTS_HH_
+#define GZ_MATH_GRAPH_INCREMENTALCOMPONENTS_HH_
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <gz/math/config.hh>
+#include "gz/math/graph/Graph.hh"
+
+namespace gz
+{
+namespace math
+{
+// Inline bracket to help doxygen filtering.
+inline namespace GZ_MATH_VERSION_NAMESPACE {
+namespace graph
+{
+  /// \brief Connected components of a graph that are kept up to date while
+  /// the graph changes.
+  ///
+  /// Vertices and edges are added and removed through this class, which
+  /// forwards the changes to the graph. Additions are merged into a
+  /// union-find structure with path compression and union by size, so a
+  /// stream of insertions costs almost constant time per change. A
+  /// union-find can't split components, so removals only mark the
+  /// components as stale, and they are rebuilt from the graph in a single
+  /// pass on the next query. Several removals in a row therefore cost a
+  /// single rebuild.
+  ///
+  /// In directed graphs the direction of the edges is ignored, which gives
+  /// the weakly connected components. Changes made to the graph without
+  /// going through this class are not seen until Rebuild() is called.
+  ///
+  /// <b> Example</b>
+  ///
+  /// \code{.cpp}
+  /// gz::math::graph::UndirectedGraph<int, double> graph;
+  /// gz::math::graph::IncrementalComponents components(graph);
+  /// components.AddVertex("A", 0, 0);
+  /// components.AddVertex("B", 0, 1);
+  /// components.AddEdge({0, 1}, 1.0);
+  /// bool connected = components.Connected(0, 1);
+  /// \endcode
+  template<typename V, typename E, typename EdgeType,
+           typename Storage = MapStorage>
+  class IncrementalComponents
+  {
+    /// \brief Constructor, computes the components of a graph.
+    /// \param[in] _graph The graph. It must outlive this object.
+    public: explicit IncrementalComponents(
+      Graph<V, E, EdgeType, Storage> &_graph)
+      : graph(_graph)
+    {
+      this->Rebuild();
+    }
+
+    /// \brief Add a new vertex to the graph, in its own component.
+    /// \param[in] _name Name of the vertex. It doesn't have to be unique.
+    /// \param[in] _data Data to be stored in the vertex.
+    /// \param[in] _id Optional Id to be used for this vertex. This Id must
+    /// be unique.
+    /// \return A reference to the new vertex, see Graph::AddVertex().
+    public: Vertex<V> &AddVertex(const std::string &_name,
+                                 const V &_data,
+                                 const VertexId &_id = kNullId)
+    {
+      auto &vertex = this->graph.AddVertex(_name, _data, _id);
+      if (vertex.Valid() && !this->stale)
+        this->Insert(vertex.Id());
+      return vertex;
+    }
+
+    /// \brief Add a new edge to the graph, merging the components of its
+    /// vertices.
+    /// \param[in] _vertices The set of Ids of the two vertices.
+    /// \param[in] _data User data.
+    /// \param[in] _weight Edge weight.
+    /// \return Reference to the new edge, see Graph::AddEdge().
+    public: EdgeType &AddEdge(const VertexId_P &_vertices,
+                              const E &_data,
+                              const double _weight = 1.0)
+    {
+      auto &edge = this->graph.AddEdge(_vertices, _data, _weight);
+      if (edge.Valid() && !this->stale)
+      {
+        this->Union(this->index.at(_vertices.first),
+                    this->index.at(_vertices.second));
+      }
+      return edge;
+    }
+
+    /// \brief Remove an existing edge from the graph. The components are
+    /// rebuilt on the next query.
+    /// \param[in] _edge Id of the edge to be removed.
+    /// \return True when the edge was removed or false otherwise.
+    public: bool RemoveEdge(const EdgeId &_edge)
+    {
+      if (!this->graph.RemoveEdge(_edge))
+        return false;
+      this->stale = true;
+      return true;
+    }
+
+    /// \brief Remove an existing vertex and its edges from the graph. The
+    /// components are rebuilt on the next query.
+    /// \param[in] _vertex Id of the vertex to be removed.
+    /// \return True when the vertex was removed or false otherwise.
+    public: bool RemoveVertex(const VertexId &_vertex)
+    {
+      if (!this->graph.RemoveVertex(_vertex))
+        return false;
+      this->stale = true;
+      return true;
+    }
+
+    /// \brief Recompute the components from the graph. This is done
+    /// automatically after removals, and is only needed after changing the
+    /// graph directly.
+    public: void Rebuild()
+    {
+      this->index.clear();
+      this->ids.clear();
+      this->parent.clear();
+      this->size.clear();
+      this->components = 0;
+      this->stale = false;
+
+      for (auto const &vertexPair : this->graph.Vertices())
+        this->Insert(vertexPair.first);
+      for (auto const &edgePair : this->graph.Edges())
+      {
+        const auto vertices = edgePair.second.get().Vertices();
+        this->Union(this->index.at(vertices.first),
+                    this->index.at(vertices.second));
+      }
+    }
+
+    /// \brief Get whether removals are waiting for a rebuild.
+    /// \return True if the next query rebuilds the components.
+    public: bool Stale() const
+    {
+      return this->stale;
+    }
+
+    /// \brief Get the vertex that represents the component of a vertex.
+    /// Two vertices are in the same component if they have the same
+    /// representative. Representatives may change after any change to the
+    /// graph.
+    /// \param[in] _vertex Id of the vertex.
+    /// \return The Id of the representative, or kNullId if the vertex is not
+    /// in the graph.
+    public: VertexId Representative(const VertexId &_vertex)
+    {
+      this->Update();
+      auto it = this->index.find(_vertex);
+      if (it == this->index.end())
+        return kNullId;
+      return this->ids[this->Find(it->second)];
+    }
+
+    /// \brief Get whether two vertices are in the same component.
+    /// \param[in] _a Id of a vertex.
+    /// \param[in] _b Id of another vertex.
+    /// \return True if a path joins both vertices, ignoring the direction
+    /// of the edges. False if either vertex is not in the graph.
+    public: bool Connected(const VertexId &_a, const VertexId &_b)
+    {
+      const VertexId a = this->Representative(_a);
+      return a != kNullId && a == this->Representative(_b);
+    }
+
+    /// \brief Get the number of vertices in the component of a vertex.
+    /// \param[in] _vertex Id of the vertex.
+    /// \return The size of the component, or 0 if the vertex is not in the
+    /// graph.
+    public: std::size_t ComponentSize(const VertexId &_vertex)
+    {
+      this->Update();
+      auto it = this->index.find(_vertex);
+      if (it == this->index.end())
+        return 0;
+      return this->size[this->Find(it->second)];
+    }
+
+    /// \brief Get the number of components.
+    /// \return The number of components, 0 for an empty graph.
+    public: std::size_t ComponentCount()
+    {
+      this->Update();
+      return this->components;
+    }
+
+    /// \brief Rebuild the components if there were removals.
+    private: void Update()
+    {
+      if (this->stale)
+        this->Rebuild();
+    }
+
+    /// \brief Add a vertex in its own component.
+    /// \param[in] _vertex Id of the vertex.
+    private: void Insert(const VertexId &_vertex)
+    {
+      this->index.emplace(_vertex, this->ids.size());
+      this->parent.push_back(this->ids.size());
+      this->size.push_back(1);
+      this->ids.push_back(_vertex);
+      ++this->components;
+    }
+
+    /// \brief Find the root of the tree of an element, halving the path to
+    /// it along the way.
+    /// \param[in] _i Index of the element.
+    /// \return Index of the root.
+    private: std::size_t Find(std::size_t _i)
+    {
+      while (this->parent[_i] != _i)
+      {
+        this->parent[_i] = this->parent[this->parent[_i]];
+        _i = this->parent[_i];
+      }
+      return _i;
+    }
+
+    /// \brief Merge the components of two elements, attaching the smaller
+    /// tree to the larger one.
+    /// \param[in] _a Index of an element.
+    /// \param[in] _b Index of another element.
+    private: void Union(const std::size_t _a, const std::size_t _b)
+    {
+      std::size_t a = this->Find(_a);
+      std::size_t b = this->Find(_b);
+      if (a == b)
+        return;
+      if (this->size[a] < this->size[b])
+        std::swap(a, b);
+      this->parent[b] = a;
+      this->size[a] += this->size[b];
+      --this->components;
+    }
+
+    /// \brief The graph.
+    private: Graph<V, E, EdgeType, Storage> &graph;
+
+    /// \brief Index of each vertex in the union-find arrays.
+    private: std::unordered_map<VertexId, std::size_t> index;
+
+    /// \brief Id of the vertex of each index.
+    private: std::vector<VertexId> ids;
+
+    /// \brief Parent of each index in its tree, roots are their own parent.
+    private: std::vector<std::size_t> parent;
+
+    /// \brief Number of vertices in the tree of each root.
+    private: std::vector<std::size_t> size;
+
+    /// \brief Number of components.
+    private: std::size_t components{0};
+
+    /// \brief True if vertices or edges were removed since the last
+    /// rebuild.
+    private: bool stale{false};
+  };
+}
+}
+}
+}
+#endif
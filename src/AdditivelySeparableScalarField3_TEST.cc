@@ -15,8 +15,10 @@
  *
 */
 #include <gtest/gtest.h>
+#include <cmath>
 #include <functional>
 #include <ostream>
+#include <vector>
 
 #include "gz/math/AdditivelySeparableScalarField3.hh"
 #include "gz/math/Polynomial3.hh"
@@ -43,6 +45,76 @@ TEST(AdditivelySeparableScalarField3Test, Evaluate)
   EXPECT_DOUBLE_EQ(scalarField(INF_V), math::INF_D);
 }
 
+/////////////////////////////////////////////////
+TEST(AdditivelySeparableScalarField3Test, EvaluateMany)
+{
+  // The same functions, called directly and through std::function
+  const math::Polynomial3d xPoly(math::Vector4d(1., -2., 0.5, 1.));
+  const math::Polynomial3d yPoly(math::Vector4d(0., 1., -1., 0.));
+  const math::Polynomial3d zPoly(math::Vector4d(-0.5, 0., 2., 3.));
+  const math::AdditivelySeparableScalarField3d<math::Polynomial3d>
+      polyField(0.5, xPoly, yPoly, zPoly);
+  using ScalarFunctionT = std::function<double(double)>;
+  const math::AdditivelySeparableScalarField3d<ScalarFunctionT>
+      funcField(0.5, xPoly, yPoly, zPoly);
+
+  std::vector<double> xs, ys, zs;
+  for (int i = 0; i < 37; ++i)
+    xs.push_back(-2. + 0.1 * i);
+  for (int i = 0; i < 11; ++i)
+    ys.push_back(1. - 0.3 * i);
+  for (int i = 0; i < 5; ++i)
+    zs.push_back(0.7 * i);
+  zs.push_back(math::INF_D);
+
+  std::vector<double> grid(xs.size() * ys.size() * zs.size());
+  std::vector<math::Vector3d> points;
+  for (size_t k = 0; k < zs.size(); ++k)
+  {
+    for (size_t j = 0; j < ys.size(); ++j)
+    {
+      for (size_t i = 0; i < xs.size(); ++i)
+      {
+        points.push_back(math::Vector3d(xs[i], ys[j], zs[k]));
+      }
+    }
+  }
+
+  for (const auto &evaluate : {
+      std::function<void(const math::Vector3d *, double *, size_t)>(
+          [&](const math::Vector3d *_p, double *_out, size_t _count)
+          { polyField.Evaluate(_p, _out, _count); }),
+      std::function<void(const math::Vector3d *, double *, size_t)>(
+          [&](const math::Vector3d *_p, double *_out, size_t _count)
+          { funcField.Evaluate(_p, _out, _count); })})
+  {
+    std::vector<double> values(points.size());
+    evaluate(points.data(), values.data(), points.size());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      EXPECT_EQ(polyField(points[i]), values[i]) << points[i];
+    }
+  }
+
+  polyField.EvaluateGrid(xs.data(), xs.size(), ys.data(), ys.size(),
+                         zs.data(), zs.size(), grid.data());
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    EXPECT_EQ(polyField(points[i]), grid[i]) << points[i];
+  }
+  funcField.EvaluateGrid(xs.data(), xs.size(), ys.data(), ys.size(),
+                         zs.data(), zs.size(), grid.data());
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    EXPECT_EQ(polyField(points[i]), grid[i]) << points[i];
+  }
+
+  // Nothing to evaluate
+  polyField.Evaluate(nullptr, nullptr, 0);
+  polyField.EvaluateGrid(xs.data(), xs.size(), nullptr, 0,
+                         zs.data(), zs.size(), nullptr);
+}
+
 /////////////////////////////////////////////////
 TEST(AdditivelySeparableScalarField3Test, Minimum)
 {
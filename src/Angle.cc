@@ -14,6 +14,9 @@
  * limitations under the License.
  *
 */
+#include <cmath>
+#include <cstddef>
+
 #include "gz/math/Helpers.hh"
 #include "gz/math/Angle.hh"
 
@@ -28,6 +31,45 @@ constexpr Angle gPi(GZ_PI);
 constexpr Angle gHalfPi(GZ_PI_2);
 constexpr Angle gTwoPi(GZ_PI * 2.0);
 
+// Adding and subtracting 1.5 * 2^52 rounds a double of magnitude below
+// 2^51 to the nearest integer, without a branch or a call to nearbyint
+// that would keep the loops below from being vectorized.
+constexpr double kRoundShift = 6755399441055744.0;
+
+// 2 Pi and 1 / (2 Pi). kTwoPiLo is the part of 2 Pi that doesn't fit in
+// kTwoPiHi, so that angle - k * 2 Pi isn't less accurate than the angle.
+constexpr double kTwoPiHi = 6.28318530717958623200e+00;
+constexpr double kTwoPiLo = 2.44929359829470635445e-16;
+constexpr double kInvTwoPi = 1.59154943091895335769e-01;
+constexpr double kPiHi = 3.14159265358979311600e+00;
+
+// 2 / Pi, and Pi / 2 in three parts of 33 bits (from fdlibm), so that
+// products by quadrants below 2^20 are exact.
+constexpr double kTwoOverPi = 6.36619772367581382433e-01;
+constexpr double kHalfPi1 = 1.57079632673412561417e+00;
+constexpr double kHalfPi2 = 6.07710050630396597660e-11;
+constexpr double kHalfPi3 = 2.02226624871116645580e-21;
+
+// Minimax polynomials of sin(x) and cos(x) on [-Pi/4, Pi/4] (from fdlibm)
+constexpr double kSin1 = -1.66666666666666324348e-01;
+constexpr double kSin2 = 8.33333333332248946124e-03;
+constexpr double kSin3 = -1.98412698298579493134e-04;
+constexpr double kSin4 = 2.75573137070700676789e-06;
+constexpr double kSin5 = -2.50507602534068634195e-08;
+constexpr double kSin6 = 1.58969099521155010221e-10;
+constexpr double kCos1 = 4.16666666666666019037e-02;
+constexpr double kCos2 = -1.38888888888741095749e-03;
+constexpr double kCos3 = 2.48015872894767294178e-05;
+constexpr double kCos4 = -2.75573143513906633035e-07;
+constexpr double kCos5 = 2.08757232129817482790e-09;
+constexpr double kCos6 = -1.13596475577881948265e-11;
+
+//////////////////////////////////////////////////
+double roundToInteger(const double _value)
+{
+  return (_value + kRoundShift) - kRoundShift;
+}
+
 }  // namespace
 
 const Angle &Angle::Zero = gZero;
@@ -83,6 +125,87 @@ Angle Angle::Normalized() const
   return atan2(sin(this->value), cos(this->value));
 }
 
+//////////////////////////////////////////////////
+void Angle::Wrap(const double *_in, double *_out, std::size_t _count)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const double value = _in[i];
+    const double turns = roundToInteger(value * kInvTwoPi);
+    double wrapped = (value - turns * kTwoPiHi) - turns * kTwoPiLo;
+    // The rounding of value * kInvTwoPi may leave the result just past
+    // -Pi or Pi. The comparisons are converted to 0 or 1, rather than
+    // branched on, so that the loop is vectorized.
+    wrapped += kTwoPiHi * (static_cast<double>(wrapped <= -kPiHi) -
+                           static_cast<double>(wrapped > kPiHi));
+    _out[i] = wrapped;
+  }
+}
+
+//////////////////////////////////////////////////
+void Angle::Unwrap(const double *_in, double *_out, std::size_t _count)
+{
+  double previous = 0.0;
+  bool hasPrevious = false;
+  double turns = 0.0;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const double value = _in[i];
+    if (std::isfinite(value))
+    {
+      if (hasPrevious)
+        turns -= roundToInteger((value - previous) * kInvTwoPi);
+      previous = value;
+      hasPrevious = true;
+    }
+    _out[i] = value + turns * kTwoPiHi;
+  }
+}
+
+//////////////////////////////////////////////////
+void Angle::SinCos(const double *_in, double *_sin, double *_cos,
+                   std::size_t _count)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const double value = _in[i];
+    _sin[i] = std::sin(value);
+    _cos[i] = std::cos(value);
+  }
+}
+
+//////////////////////////////////////////////////
+void Angle::FastSinCos(const double *_in, double *_sin, double *_cos,
+                       std::size_t _count)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const double value = _in[i];
+
+    // Reduce the angle to r in [-Pi/4, Pi/4], in quadrant k
+    const double k = roundToInteger(value * kTwoOverPi);
+    const double r = ((value - k * kHalfPi1) - k * kHalfPi2) -
+      k * kHalfPi3;
+    const double r2 = r * r;
+    const double s = r + r * r2 * (kSin1 + r2 * (kSin2 + r2 * (kSin3 +
+      r2 * (kSin4 + r2 * (kSin5 + r2 * kSin6)))));
+    const double c = 1.0 - 0.5 * r2 + r2 * r2 * (kCos1 + r2 * (kCos2 +
+      r2 * (kCos3 + r2 * (kCos4 + r2 * (kCos5 + r2 * kCos6)))));
+
+    // k modulo 4 is q = 2 * high + odd. The sine is s, c, -s, -c and the
+    // cosine c, -s, -c, s in quadrants 0 to 3. Those are computed with
+    // roundings and products by 0 and 1, which are exact, because
+    // comparisons would be turned into branches that stop the loop from
+    // being vectorized.
+    const double q = k - 4.0 * roundToInteger(k * 0.25 - 0.375);
+    const double high = roundToInteger(q * 0.5 - 0.25);
+    const double odd = q - 2.0 * high;
+    const double even = 1.0 - odd;
+    _sin[i] = (s * even + c * odd) * (1.0 - 2.0 * high);
+    _cos[i] = (c * even + s * odd) * (1.0 - 2.0 * std::abs(odd - high));
+  }
+}
+
 //////////////////////////////////////////////////
 Angle Angle::operator-(const Angle &_angle) const
 {
@@ -17,7 +17,10 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <iosfwd>
+#include <limits>
+#include <vector>
 
 #include "gz/math/Angle.hh"
 #include "gz/math/Helpers.hh"
@@ -130,3 +133,133 @@ TEST(AngleTest, OperatorStreamOut)
   stream << a;
   EXPECT_EQ(stream.str(), "0.1");
 }
+
+/////////////////////////////////////////////////
+TEST(AngleTest, Wrap)
+{
+  std::vector<double> angles;
+  for (int i = -20000; i <= 20000; ++i)
+    angles.push_back(i * 0.0123);
+  angles.push_back(1e9 + 0.5);
+  angles.push_back(-1e12 - 0.25);
+  std::vector<double> wrapped(angles.size());
+  math::Angle::Wrap(angles.data(), wrapped.data(), angles.size());
+  for (std::size_t i = 0; i < angles.size(); ++i)
+  {
+    EXPECT_GT(wrapped[i], -GZ_PI);
+    EXPECT_LE(wrapped[i], GZ_PI);
+    // Away from +-Pi, where atan2 may give either, it's Normalized()
+    if (std::abs(wrapped[i]) < GZ_PI - 1e-6)
+    {
+      EXPECT_NEAR(math::Angle(angles[i]).Normalized().Radian(), wrapped[i],
+                  1e-12 * std::max(1.0, std::abs(angles[i])));
+    }
+  }
+
+  // The limits of the range, in place
+  std::vector<double> limits = {GZ_PI, -GZ_PI, 3 * GZ_PI, -3 * GZ_PI, 0.0};
+  math::Angle::Wrap(limits.data(), limits.data(), limits.size());
+  EXPECT_DOUBLE_EQ(GZ_PI, limits[0]);
+  EXPECT_DOUBLE_EQ(GZ_PI, limits[1]);
+  EXPECT_NEAR(GZ_PI, std::abs(limits[2]), 1e-12);
+  EXPECT_NEAR(GZ_PI, std::abs(limits[3]), 1e-12);
+  EXPECT_DOUBLE_EQ(0.0, limits[4]);
+
+  std::vector<double> special = {std::numeric_limits<double>::infinity(),
+                                 std::numeric_limits<double>::quiet_NaN()};
+  math::Angle::Wrap(special.data(), special.data(), special.size());
+  EXPECT_TRUE(std::isnan(special[0]));
+  EXPECT_TRUE(std::isnan(special[1]));
+
+  math::Angle::Wrap(nullptr, nullptr, 0);
+}
+
+/////////////////////////////////////////////////
+TEST(AngleTest, Unwrap)
+{
+  // A heading turning at a constant rate, wrapped
+  std::vector<double> heading;
+  for (int i = 0; i < 1000; ++i)
+    heading.push_back(-3.0 + i * 0.05);
+  std::vector<double> wrapped(heading.size());
+  math::Angle::Wrap(heading.data(), wrapped.data(), heading.size());
+  std::vector<double> unwrapped(heading.size());
+  math::Angle::Unwrap(wrapped.data(), unwrapped.data(), wrapped.size());
+  for (std::size_t i = 0; i < heading.size(); ++i)
+    EXPECT_NEAR(heading[i], unwrapped[i], 1e-12);
+
+  // Turning the other way, in place
+  for (int i = 0; i < 1000; ++i)
+    heading[i] = 100.0 - i * 0.3;
+  math::Angle::Wrap(heading.data(), wrapped.data(), heading.size());
+  math::Angle::Unwrap(wrapped.data(), wrapped.data(), wrapped.size());
+  for (std::size_t i = 0; i < heading.size(); ++i)
+  {
+    EXPECT_NEAR(heading[i] - heading[0] + wrapped[0], wrapped[i], 1e-10);
+  }
+
+  // Jumps of up to Pi are kept, NaN is skipped over
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  std::vector<double> jumps = {7.0, 7.0 + GZ_PI - 1e-9, nan, 7.0, 7.0 + 4.0};
+  math::Angle::Unwrap(jumps.data(), jumps.data(), jumps.size());
+  EXPECT_DOUBLE_EQ(7.0, jumps[0]);
+  EXPECT_DOUBLE_EQ(7.0 + GZ_PI - 1e-9, jumps[1]);
+  EXPECT_TRUE(std::isnan(jumps[2]));
+  EXPECT_DOUBLE_EQ(7.0, jumps[3]);
+  EXPECT_NEAR(7.0 + 4.0 - 2 * GZ_PI, jumps[4], 1e-12);
+
+  math::Angle::Unwrap(nullptr, nullptr, 0);
+}
+
+/////////////////////////////////////////////////
+TEST(AngleTest, SinCos)
+{
+  std::vector<double> angles;
+  for (int i = -100000; i <= 100000; ++i)
+    angles.push_back(i * 0.01234567);
+  for (int i = 0; i < 1000; ++i)
+    angles.push_back(math::Angle::kFastSinCosLimit - i * 0.731);
+  angles.push_back(-math::Angle::kFastSinCosLimit);
+  angles.push_back(GZ_PI);
+  angles.push_back(-GZ_PI_2);
+  angles.push_back(-0.0);
+
+  std::vector<double> sin(angles.size());
+  std::vector<double> cos(angles.size());
+  math::Angle::SinCos(angles.data(), sin.data(), cos.data(), angles.size());
+  std::vector<double> fastSin(angles.size());
+  std::vector<double> fastCos(angles.size());
+  math::Angle::FastSinCos(angles.data(), fastSin.data(), fastCos.data(),
+                          angles.size());
+  for (std::size_t i = 0; i < angles.size(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(std::sin(angles[i]), sin[i]);
+    EXPECT_DOUBLE_EQ(std::cos(angles[i]), cos[i]);
+    EXPECT_NEAR(sin[i], fastSin[i], 1e-15);
+    EXPECT_NEAR(cos[i], fastCos[i], 1e-15);
+  }
+
+  // Past the limit, the error grows
+  std::vector<double> large = {1e9 + 0.1, -1e9 - 0.2};
+  std::vector<double> largeSin(large.size());
+  std::vector<double> largeCos(large.size());
+  math::Angle::FastSinCos(large.data(), largeSin.data(), largeCos.data(),
+                          large.size());
+  for (std::size_t i = 0; i < large.size(); ++i)
+  {
+    EXPECT_NEAR(std::sin(large[i]), largeSin[i], 1e-6);
+    EXPECT_NEAR(std::cos(large[i]), largeCos[i], 1e-6);
+  }
+
+  // In place, and special values
+  std::vector<double> special = {std::numeric_limits<double>::infinity(),
+                                 std::numeric_limits<double>::quiet_NaN()};
+  std::vector<double> specialCos(special.size());
+  math::Angle::FastSinCos(special.data(), special.data(), specialCos.data(),
+                          special.size());
+  for (std::size_t i = 0; i < special.size(); ++i)
+  {
+    EXPECT_TRUE(std::isnan(special[i]));
+    EXPECT_TRUE(std::isnan(specialCos[i]));
+  }
+}
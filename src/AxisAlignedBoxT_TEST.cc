@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "gz/math/AxisAlignedBox.hh"
+#include "gz/math/AxisAlignedBoxT.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/Vector3.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+/// \brief Convert a double vector to another precision.
+template<typename T>
+Vector3<T> Convert(const Vector3d &_v)
+{
+  return Vector3<T>(static_cast<T>(_v.X()), static_cast<T>(_v.Y()),
+                    static_cast<T>(_v.Z()));
+}
+
+/// \brief Check that an AxisAlignedBoxT gives the same results as an
+/// AxisAlignedBox for random points and rays.
+template<typename T>
+void ExpectSameResults(const double _tol)
+{
+  for (int n = 0; n < 200; ++n)
+  {
+    const Vector3d a(Rand::DblUniform(-5, 5), Rand::DblUniform(-5, 5),
+                     Rand::DblUniform(-5, 5));
+    const Vector3d b(Rand::DblUniform(-5, 5), Rand::DblUniform(-5, 5),
+                     Rand::DblUniform(-5, 5));
+    const AxisAlignedBox expected(a, b);
+    const AxisAlignedBoxT<T> box(Convert<T>(a), Convert<T>(b));
+
+    EXPECT_NEAR(expected.XLength(), box.XLength(), _tol);
+    EXPECT_NEAR(expected.Volume(), box.Volume(), 1000 * _tol);
+    EXPECT_NEAR(expected.Center().X(), box.Center().X(), _tol);
+
+    const Vector3d p(Rand::DblUniform(-6, 6), Rand::DblUniform(-6, 6),
+                     Rand::DblUniform(-6, 6));
+    EXPECT_EQ(expected.Contains(p), box.Contains(Convert<T>(p)));
+
+    const AxisAlignedBox other(p, p + Vector3d(1, 1, 1));
+    const AxisAlignedBoxT<T> otherT(Convert<T>(p),
+                                    Convert<T>(p + Vector3d(1, 1, 1)));
+    EXPECT_EQ(expected.Intersects(other), box.Intersects(otherT));
+
+    const Vector3d dir = (expected.Center() - p) +
+        Vector3d(Rand::DblUniform(-2, 2), Rand::DblUniform(-2, 2),
+                 Rand::DblUniform(-2, 2));
+    const auto ray = expected.Intersect(p, dir, 0.5, 20);
+    const auto rayT = box.Intersect(Convert<T>(p), Convert<T>(dir),
+                                    T(0.5), T(20));
+    ASSERT_EQ(std::get<0>(ray), std::get<0>(rayT));
+    EXPECT_NEAR(std::get<1>(ray), std::get<1>(rayT), 10 * _tol);
+    EXPECT_NEAR(std::get<2>(ray).X(), std::get<2>(rayT).X(), 10 * _tol);
+    EXPECT_NEAR(std::get<2>(ray).Y(), std::get<2>(rayT).Y(), 10 * _tol);
+    EXPECT_NEAR(std::get<2>(ray).Z(), std::get<2>(rayT).Z(), 10 * _tol);
+  }
+}
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTTest, Default)
+{
+  AxisAlignedBoxf box;
+  EXPECT_EQ(Vector3f(MAX_F, MAX_F, MAX_F), box.Min());
+  EXPECT_EQ(Vector3f(LOW_F, LOW_F, LOW_F), box.Max());
+  EXPECT_FLOAT_EQ(0.0f, box.XLength());
+  EXPECT_FLOAT_EQ(0.0f, box.Volume());
+  EXPECT_FALSE(box.Contains(Vector3f::Zero));
+  EXPECT_FALSE(box.Intersects(AxisAlignedBoxf(-1, -1, -1, 1, 1, 1)));
+
+  static_assert(std::is_trivially_copyable_v<AxisAlignedBoxf>,
+                "AxisAlignedBoxf should be trivially copyable");
+  static_assert(sizeof(AxisAlignedBoxf) == 6 * sizeof(float),
+                "AxisAlignedBoxf should only store its corners");
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTTest, Construct)
+{
+  AxisAlignedBoxf box(1, 2, 3, -1, -2, -3);
+  EXPECT_EQ(Vector3f(-1, -2, -3), box.Min());
+  EXPECT_EQ(Vector3f(1, 2, 3), box.Max());
+  EXPECT_EQ(Vector3f(2, 4, 6), box.Size());
+  EXPECT_EQ(Vector3f::Zero, box.Center());
+  EXPECT_FLOAT_EQ(48.0f, box.Volume());
+
+  const AxisAlignedBoxd boxd(box);
+  EXPECT_EQ(Vector3d(-1, -2, -3), boxd.Min());
+  EXPECT_EQ(Vector3d(1, 2, 3), boxd.Max());
+  EXPECT_EQ(box, AxisAlignedBoxf(boxd));
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTTest, Operators)
+{
+  AxisAlignedBoxf box(0, 0, 0, 1, 1, 1);
+  const AxisAlignedBoxf other(2, 2, 2, 3, 3, 3);
+  EXPECT_NE(box, other);
+
+  const AxisAlignedBoxf sum = box + other;
+  EXPECT_EQ(AxisAlignedBoxf(0, 0, 0, 3, 3, 3), sum);
+
+  box += other;
+  EXPECT_EQ(sum, box);
+
+  EXPECT_EQ(AxisAlignedBoxf(1, 1, 1, 4, 4, 4), box + Vector3f(1, 1, 1));
+  EXPECT_EQ(AxisAlignedBoxf(-1, -1, -1, 2, 2, 2), box - Vector3f(1, 1, 1));
+
+  box.Min() = Vector3f(-1, 0, 0);
+  EXPECT_FLOAT_EQ(4.0f, box.XLength());
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTTest, ContainsArray)
+{
+  const AxisAlignedBoxf box(-1, -1, -1, 1, 1, 1);
+  std::vector<Vector3f> points;
+  for (int i = 0; i < 100; ++i)
+  {
+    points.emplace_back(static_cast<float>(Rand::DblUniform(-2, 2)),
+                        static_cast<float>(Rand::DblUniform(-2, 2)),
+                        static_cast<float>(Rand::DblUniform(-2, 2)));
+  }
+  points.push_back(Vector3f(1, 1, 1));
+  points.push_back(Vector3f(NAN_F, 0, 0));
+
+  std::vector<std::uint8_t> result(points.size(), 2);
+  box.Contains(points.data(), result.data(), points.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_EQ(box.Contains(points[i]), result[i] == 1) << i;
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTTest, SameAsAxisAlignedBox)
+{
+  Rand::Seed(42);
+  ExpectSameResults<double>(1e-12);
+  ExpectSameResults<float>(1e-5);
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTTest, Constexpr)
+{
+  constexpr AxisAlignedBoxd box(1, 2, 3, -1, -2, -3);
+  constexpr AxisAlignedBoxd moved = box + Vector3d(1, 0, 0);
+  constexpr AxisAlignedBoxd merged = box + AxisAlignedBoxd(0, 0, 0, 4, 4, 4);
+  constexpr double volume = box.Volume();
+  constexpr Vector3d center = box.Center();
+  constexpr Vector3d movedMin = moved.Min();
+  constexpr Vector3d mergedSize = merged.Size();
+  EXPECT_DOUBLE_EQ(48, volume);
+  EXPECT_EQ(Vector3d::Zero, center);
+  EXPECT_EQ(Vector3d(0, -2, -3), movedMin);
+  EXPECT_EQ(Vector3d(5, 6, 7), mergedSize);
+  static_assert(box.Contains(Vector3d(0.5, 1, -2)),
+                "Contains should be constexpr");
+  static_assert(!box.Intersects(AxisAlignedBoxd(2, 2, 2, 3, 3, 3)),
+                "Intersects should be constexpr");
+
+  constexpr AxisAlignedBoxd empty;
+  constexpr AxisAlignedBoxf emptyf(empty);
+  constexpr float emptyMinX = emptyf.Min().X();
+  // Converting an empty box clamps its corners
+  EXPECT_FLOAT_EQ(std::numeric_limits<float>::max(), emptyMinX);
+  static_assert(std::is_trivially_copyable_v<AxisAlignedBoxd>,
+                "AxisAlignedBoxd should be trivially copyable");
+  EXPECT_EQ(AxisAlignedBoxf(), emptyf);
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTTest, AxisAlignedBoxConversion)
+{
+  const AxisAlignedBox box(Vector3d(1, 2, 3), Vector3d(-1, 0.5, 4));
+  const AxisAlignedBoxd boxd(box);
+  EXPECT_EQ(box.Min(), boxd.Min());
+  EXPECT_EQ(box.Max(), boxd.Max());
+  EXPECT_EQ(box, boxd.ToAxisAlignedBox());
+
+  const AxisAlignedBoxf boxf(box);
+  EXPECT_EQ(Vector3f(-1, 0.5f, 3), boxf.Min());
+  EXPECT_EQ(box, boxf.ToAxisAlignedBox());
+
+  // Boxes with no extent keep their corners
+  const AxisAlignedBox empty;
+  const AxisAlignedBoxd emptyd(empty);
+  EXPECT_DOUBLE_EQ(0, emptyd.Volume());
+  EXPECT_EQ(AxisAlignedBoxd(), emptyd);
+  EXPECT_EQ(empty, emptyd.ToAxisAlignedBox());
+  EXPECT_EQ(AxisAlignedBoxf(), AxisAlignedBoxf(empty));
+  EXPECT_DOUBLE_EQ(0, AxisAlignedBoxf().ToAxisAlignedBox().Volume());
+  EXPECT_FALSE(AxisAlignedBoxf().ToAxisAlignedBox().Contains(
+      Vector3d::Zero));
+}
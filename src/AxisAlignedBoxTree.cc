@@ -0,0 +1,958 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "gz/math/AxisAlignedBoxTree.hh"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+#include "gz/math/Helpers.hh"
+#include "gz/math/Plane.hh"
+#include "gz/math/detail/ParallelFor.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Marks internal nodes in Node::item.
+  constexpr std::size_t kNoItem = std::numeric_limits<std::size_t>::max();
+
+  /// \brief Number of bins used to evaluate the surface area heuristic.
+  constexpr int kBins = 16;
+
+  /// \brief Subtrees with fewer boxes than this are built on the calling
+  /// thread.
+  constexpr std::size_t kParallelThreshold = 4096;
+
+  /// \brief Tolerance of the conservative node tests, so that rounding never
+  /// culls a box that the exact box test would accept.
+  constexpr double kNodeTolerance = 1e-9;
+
+  /// \brief Number of planes of a frustum.
+  constexpr int kFrustumPlanes = 6;
+
+  /// \brief Plane mask with a bit set for each plane of a frustum.
+  constexpr unsigned int kAllPlanes = (1u << kFrustumPlanes) - 1;
+
+  /// \brief A node of the tree. The left child of an internal node is
+  /// stored right after it and the right child after the whole left
+  /// subtree, so a tree of N boxes uses exactly 2N - 1 nodes.
+  struct Node
+  {
+    Vector3d min;
+    Vector3d max;
+    std::size_t right = 0;
+    std::size_t parent = kNoItem;
+    std::size_t item = kNoItem;
+  };
+
+  /// \brief Surface area of a box given by its corners.
+  /// \param[in] _min Minimum corner.
+  /// \param[in] _max Maximum corner.
+  /// \return Surface area, or zero for empty boxes.
+  double SurfaceArea(const Vector3d &_min, const Vector3d &_max)
+  {
+    const Vector3d size = _max - _min;
+    if (size.X() < 0 || size.Y() < 0 || size.Z() < 0)
+      return 0;
+    return 2.0 * (size.X() * size.Y() + size.Y() * size.Z() +
+                  size.Z() * size.X());
+  }
+
+  /// \brief Grow a box given by its corners to contain another one.
+  void Grow(Vector3d &_min, Vector3d &_max,
+            const Vector3d &_otherMin, const Vector3d &_otherMax)
+  {
+    _min.Min(_otherMin);
+    _max.Max(_otherMax);
+  }
+
+  /// \brief Conservative test of a ray segment against node bounds.
+  /// \param[in] _node The node.
+  /// \param[in] _origin Origin of the ray.
+  /// \param[in] _dir Normalized direction of the ray.
+  /// \param[in] _min Minimum distance along the ray.
+  /// \param[in] _max Maximum distance along the ray.
+  /// \param[out] _near Distance along the ray where it enters the node.
+  /// \return True if the segment may touch the node.
+  bool RayNode(const Node &_node, const Vector3d &_origin,
+               const Vector3d &_dir, const double _min, const double _max,
+               double &_near)
+  {
+    double tNear = _min;
+    double tFar = _max;
+    for (int a = 0; a < 3; ++a)
+    {
+      const double lo = _node.min[a] - kNodeTolerance;
+      const double hi = _node.max[a] + kNodeTolerance;
+      if (std::abs(_dir[a]) < 1e-12)
+      {
+        if (_origin[a] < lo || _origin[a] > hi)
+          return false;
+        continue;
+      }
+      double t1 = (lo - _origin[a]) / _dir[a];
+      double t2 = (hi - _origin[a]) / _dir[a];
+      if (t1 > t2)
+        std::swap(t1, t2);
+      tNear = std::max(tNear, t1);
+      tFar = std::min(tFar, t2);
+      if (tNear > tFar + kNodeTolerance)
+        return false;
+    }
+    _near = tNear;
+    return true;
+  }
+}
+
+/// \brief Private data for the AxisAlignedBoxTree class
+class gz::math::AxisAlignedBoxTree::Implementation
+{
+  /// \brief Build the subtree of a range of boxes.
+  /// \param[in] _node Index of the root node of the subtree.
+  /// \param[in] _parent Index of the parent node.
+  /// \param[in] _begin First entry of order in the range.
+  /// \param[in] _end One past the last entry of order in the range.
+  /// \param[in] _threads Number of threads the subtree may use.
+  public: void BuildNode(std::size_t _node, std::size_t _parent,
+                         std::size_t _begin, std::size_t _end,
+                         unsigned int _threads);
+
+  /// \brief Find the closest item hit by a ray, visiting the boxes hit by
+  /// the ray front to back.
+  /// \param[in] _origin Origin of the ray.
+  /// \param[in] _dir Direction of the ray.
+  /// \param[in] _min Minimum distance along the ray.
+  /// \param[in] _max Maximum distance along the ray.
+  /// \param[in] _offset Distance along the ray from which the distances
+  /// returned by _test are measured.
+  /// \param[in] _test Test of the items of a box, see
+  /// AxisAlignedBoxTree::RayClosestHit.
+  /// \param[out] _index Index of the box of the closest hit.
+  /// \param[out] _distance Distance to the closest hit.
+  /// \return True if _test reported any hit.
+  public: template<typename F>
+  bool RayClosestHit(const Vector3d &_origin, const Vector3d &_dir,
+                     const double _min, const double _max,
+                     const double _offset, const F &_test,
+                     std::size_t &_index, double &_distance) const;
+
+  /// \brief Find all boxes inside a frustum. Each node is tested against
+  /// the planes that its parent straddles, so subtrees fully inside the
+  /// frustum are reported without any test.
+  /// \param[in] _frustum The frustum to test against.
+  /// \param[in,out] _planes Plane that last culled each node, tested
+  /// first, or nullptr.
+  /// \param[in,out] _stack Traversal stack, cleared first.
+  /// \param[out] _indices Indices of the boxes inside _frustum, cleared
+  /// first.
+  public: void Intersects(const Frustum &_frustum, std::uint8_t *_planes,
+              std::vector<std::pair<std::size_t, unsigned int>> &_stack,
+              std::vector<std::size_t> &_indices) const;
+
+  /// \brief Check which frustums contain the boxes of a subtree. Each
+  /// node is tested against the frustums that its parent is partly inside.
+  /// \param[in] _frustums The frustums, for the exact box test.
+  /// \param[in] _planes Planes of each frustum.
+  /// \param[in] _bounds Minimum and maximum corners of the bounds of each
+  /// frustum, grown by kNodeTolerance, followed by their union.
+  /// \param[in] _frustumCount Number of frustums.
+  /// \param[in] _node Root of the subtree.
+  /// \param[out] _masks Masks of the boxes, the ones of the boxes outside
+  /// of all the frustums are not written.
+  public: void Visibility(const Frustum *_frustums,
+              const std::array<Planed, kFrustumPlanes> *_planes,
+              const std::pair<Vector3d, Vector3d> *_bounds,
+              const std::size_t _frustumCount, const std::size_t _node,
+              std::uint64_t *_masks) const;
+
+  /// \brief Copies of the boxes, in the order they were given.
+  public: std::vector<AxisAlignedBox> boxes;
+
+  /// \brief Centers of the boxes, used while building.
+  public: std::vector<Vector3d> centers;
+
+  /// \brief Box indices, partitioned while building.
+  public: std::vector<std::size_t> order;
+
+  /// \brief The nodes, the root is the first one.
+  public: std::vector<Node> nodes;
+
+  /// \brief Leaf node of each box.
+  public: std::vector<std::size_t> leaves;
+};
+
+//////////////////////////////////////////////////
+void AxisAlignedBoxTree::Implementation::BuildNode(std::size_t _node,
+    std::size_t _parent, std::size_t _begin, std::size_t _end,
+    unsigned int _threads)
+{
+  Node &node = this->nodes[_node];
+  node.parent = _parent;
+  node.min = Vector3d(MAX_D, MAX_D, MAX_D);
+  node.max = Vector3d(LOW_D, LOW_D, LOW_D);
+
+  const std::size_t count = _end - _begin;
+  if (count == 1)
+  {
+    const std::size_t item = this->order[_begin];
+    node.item = item;
+    node.min = this->boxes[item].Min();
+    node.max = this->boxes[item].Max();
+    this->leaves[item] = _node;
+    return;
+  }
+
+  // Split along the axis where the box centers spread the most
+  Vector3d centerMin(MAX_D, MAX_D, MAX_D);
+  Vector3d centerMax(LOW_D, LOW_D, LOW_D);
+  for (std::size_t i = _begin; i < _end; ++i)
+  {
+    const std::size_t item = this->order[i];
+    Grow(node.min, node.max, this->boxes[item].Min(), this->boxes[item].Max());
+    Grow(centerMin, centerMax, this->centers[item], this->centers[item]);
+  }
+  const Vector3d spread = centerMax - centerMin;
+  int axis = 0;
+  if (spread.Y() > spread[axis])
+    axis = 1;
+  if (spread.Z() > spread[axis])
+    axis = 2;
+
+  std::size_t mid = _begin + count / 2;
+  if (spread[axis] > 0)
+  {
+    // Binned surface area heuristic
+    const double scale = kBins / spread[axis];
+    auto binOf = [&](const std::size_t _item)
+    {
+      const int bin = static_cast<int>(
+          (this->centers[_item][axis] - centerMin[axis]) * scale);
+      return std::min(bin, kBins - 1);
+    };
+
+    std::size_t binCount[kBins] = {};
+    Vector3d binMin[kBins];
+    Vector3d binMax[kBins];
+    for (int b = 0; b < kBins; ++b)
+    {
+      binMin[b] = Vector3d(MAX_D, MAX_D, MAX_D);
+      binMax[b] = Vector3d(LOW_D, LOW_D, LOW_D);
+    }
+    for (std::size_t i = _begin; i < _end; ++i)
+    {
+      const std::size_t item = this->order[i];
+      const int b = binOf(item);
+      ++binCount[b];
+      Grow(binMin[b], binMax[b],
+           this->boxes[item].Min(), this->boxes[item].Max());
+    }
+
+    // Cost of splitting after each bin, sweeping from the right
+    double rightCost[kBins] = {};
+    Vector3d accMin(MAX_D, MAX_D, MAX_D);
+    Vector3d accMax(LOW_D, LOW_D, LOW_D);
+    std::size_t accCount = 0;
+    for (int b = kBins - 1; b > 0; --b)
+    {
+      Grow(accMin, accMax, binMin[b], binMax[b]);
+      accCount += binCount[b];
+      rightCost[b - 1] = static_cast<double>(accCount) *
+        SurfaceArea(accMin, accMax);
+    }
+
+    int bestBin = -1;
+    double bestCost = MAX_D;
+    accMin = Vector3d(MAX_D, MAX_D, MAX_D);
+    accMax = Vector3d(LOW_D, LOW_D, LOW_D);
+    accCount = 0;
+    for (int b = 0; b < kBins - 1; ++b)
+    {
+      Grow(accMin, accMax, binMin[b], binMax[b]);
+      accCount += binCount[b];
+      if (accCount == 0 || accCount == count)
+        continue;
+      const double cost = static_cast<double>(accCount) *
+        SurfaceArea(accMin, accMax) + rightCost[b];
+      if (cost < bestCost)
+      {
+        bestCost = cost;
+        bestBin = b;
+      }
+    }
+
+    if (bestBin >= 0)
+    {
+      auto iter = std::partition(
+          this->order.begin() + _begin, this->order.begin() + _end,
+          [&](const std::size_t _item) { return binOf(_item) <= bestBin; });
+      mid = static_cast<std::size_t>(iter - this->order.begin());
+    }
+    else
+    {
+      std::nth_element(this->order.begin() + _begin,
+          this->order.begin() + mid, this->order.begin() + _end,
+          [&](const std::size_t _a, const std::size_t _b)
+          {
+            return this->centers[_a][axis] < this->centers[_b][axis];
+          });
+    }
+  }
+
+  const std::size_t leftCount = mid - _begin;
+  const std::size_t left = _node + 1;
+  const std::size_t right = _node + 2 * leftCount;
+  node.right = right;
+  node.item = kNoItem;
+
+  if (_threads > 1 && count >= kParallelThreshold)
+  {
+    const unsigned int leftThreads = _threads / 2;
+    auto future = std::async(std::launch::async, [=]()
+    {
+      this->BuildNode(left, _node, _begin, mid, leftThreads);
+    });
+    this->BuildNode(right, _node, mid, _end, _threads - leftThreads);
+    future.get();
+  }
+  else
+  {
+    this->BuildNode(left, _node, _begin, mid, 1);
+    this->BuildNode(right, _node, mid, _end, 1);
+  }
+}
+
+//////////////////////////////////////////////////
+AxisAlignedBoxTree::AxisAlignedBoxTree()
+: dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+AxisAlignedBoxTree::AxisAlignedBoxTree(
+    const std::vector<AxisAlignedBox> &_boxes)
+: AxisAlignedBoxTree()
+{
+  this->Build(_boxes);
+}
+
+//////////////////////////////////////////////////
+void AxisAlignedBoxTree::Build(const std::vector<AxisAlignedBox> &_boxes,
+    const unsigned int _threads)
+{
+  this->dataPtr->boxes = _boxes;
+  const std::size_t count = _boxes.size();
+  this->dataPtr->nodes.assign(count > 0 ? 2 * count - 1 : 0, Node());
+  this->dataPtr->leaves.assign(count, 0);
+  this->dataPtr->centers.resize(count);
+  this->dataPtr->order.resize(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    this->dataPtr->centers[i] =
+      (_boxes[i].Min() + _boxes[i].Max()) * 0.5;
+    this->dataPtr->order[i] = i;
+  }
+
+  if (count > 0)
+  {
+    this->dataPtr->BuildNode(0, kNoItem, 0, count,
+        static_cast<unsigned int>(detail::ThreadCount(_threads)));
+  }
+
+  // Only needed while building
+  this->dataPtr->centers = std::vector<Vector3d>();
+  this->dataPtr->order = std::vector<std::size_t>();
+}
+
+//////////////////////////////////////////////////
+std::size_t AxisAlignedBoxTree::Size() const
+{
+  return this->dataPtr->boxes.size();
+}
+
+//////////////////////////////////////////////////
+const AxisAlignedBox &AxisAlignedBoxTree::Box(const std::size_t _index) const
+{
+  return this->dataPtr->boxes[_index];
+}
+
+//////////////////////////////////////////////////
+AxisAlignedBox AxisAlignedBoxTree::Bounds() const
+{
+  AxisAlignedBox bounds;
+  if (!this->dataPtr->nodes.empty())
+  {
+    bounds.Min() = this->dataPtr->nodes[0].min;
+    bounds.Max() = this->dataPtr->nodes[0].max;
+  }
+  return bounds;
+}
+
+//////////////////////////////////////////////////
+bool AxisAlignedBoxTree::Refit(const std::vector<AxisAlignedBox> &_boxes)
+{
+  if (_boxes.size() != this->Size())
+    return false;
+
+  this->dataPtr->boxes = _boxes;
+
+  // Children are always stored after their parent, so a reverse sweep
+  // visits every child before its parent.
+  auto &nodes = this->dataPtr->nodes;
+  for (std::size_t i = nodes.size(); i-- > 0;)
+  {
+    Node &node = nodes[i];
+    if (node.item != kNoItem)
+    {
+      node.min = _boxes[node.item].Min();
+      node.max = _boxes[node.item].Max();
+    }
+    else
+    {
+      node.min = nodes[i + 1].min;
+      node.max = nodes[i + 1].max;
+      Grow(node.min, node.max, nodes[node.right].min, nodes[node.right].max);
+    }
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool AxisAlignedBoxTree::SetBox(const std::size_t _index,
+    const AxisAlignedBox &_box)
+{
+  if (_index >= this->Size())
+    return false;
+
+  this->dataPtr->boxes[_index] = _box;
+  auto &nodes = this->dataPtr->nodes;
+  std::size_t n = this->dataPtr->leaves[_index];
+  nodes[n].min = _box.Min();
+  nodes[n].max = _box.Max();
+  for (n = nodes[n].parent; n != kNoItem; n = nodes[n].parent)
+  {
+    Node &node = nodes[n];
+    node.min = nodes[n + 1].min;
+    node.max = nodes[n + 1].max;
+    Grow(node.min, node.max, nodes[node.right].min, nodes[node.right].max);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+template<typename F>
+bool AxisAlignedBoxTree::Implementation::RayClosestHit(
+    const Vector3d &_origin, const Vector3d &_dir, const double _min,
+    const double _max, const double _offset, const F &_test,
+    std::size_t &_index, double &_distance) const
+{
+  if (this->nodes.empty())
+    return false;
+
+  const Vector3d dir = _dir.Normalized();
+  bool hit = false;
+  double best = MAX_D;
+
+  std::vector<std::pair<std::size_t, double>> stack;
+  double near = 0;
+  if (RayNode(this->nodes[0], _origin, dir, _min, _max, near))
+    stack.emplace_back(0, near);
+
+  while (!stack.empty())
+  {
+    const std::size_t n = stack.back().first;
+    const double entry = stack.back().second;
+    stack.pop_back();
+
+    // Hit distances start at _offset
+    if (hit && entry - _offset > best + kNodeTolerance)
+      continue;
+
+    const Node &node = this->nodes[n];
+    if (node.item != kNoItem)
+    {
+      double dist;
+      if (_test(node.item, hit ? best : _max - _offset, dist) &&
+          (!hit || dist < best))
+      {
+        hit = true;
+        best = dist;
+        _index = node.item;
+      }
+      continue;
+    }
+
+    // Push the farther child first so the nearer one is visited first
+    double nearLeft = 0;
+    double nearRight = 0;
+    const bool left = RayNode(this->nodes[n + 1], _origin, dir, _min,
+                              _max, nearLeft);
+    const bool right = RayNode(this->nodes[node.right], _origin, dir, _min,
+                               _max, nearRight);
+    if (left && right)
+    {
+      if (nearLeft <= nearRight)
+      {
+        stack.emplace_back(node.right, nearRight);
+        stack.emplace_back(n + 1, nearLeft);
+      }
+      else
+      {
+        stack.emplace_back(n + 1, nearLeft);
+        stack.emplace_back(node.right, nearRight);
+      }
+    }
+    else if (left)
+    {
+      stack.emplace_back(n + 1, nearLeft);
+    }
+    else if (right)
+    {
+      stack.emplace_back(node.right, nearRight);
+    }
+  }
+
+  if (hit)
+    _distance = best;
+  return hit;
+}
+
+
+//////////////////////////////////////////////////
+bool AxisAlignedBoxTree::RayClosestHit(const Vector3d &_origin,
+    const Vector3d &_dir, const double _min, const double _max,
+    std::size_t &_index, double &_distance) const
+{
+  // Distances reported by AxisAlignedBox::Intersect start at _min
+  return this->dataPtr->RayClosestHit(_origin, _dir, _min, _max, _min,
+      [&](const std::size_t _item, double, double &_dist)
+      {
+        bool intersect;
+        std::tie(intersect, _dist, std::ignore) =
+          this->dataPtr->boxes[_item].Intersect(_origin, _dir, _min, _max);
+        return intersect;
+      }, _index, _distance);
+}
+
+//////////////////////////////////////////////////
+bool AxisAlignedBoxTree::RayClosestHit(const Vector3d &_origin,
+    const Vector3d &_dir, const double _min, const double _max,
+    const std::function<bool(std::size_t, double, double &)> &_test,
+    std::size_t &_index, double &_distance) const
+{
+  return this->dataPtr->RayClosestHit(_origin, _dir, _min, _max, 0.0,
+      _test, _index, _distance);
+}
+
+//////////////////////////////////////////////////
+bool AxisAlignedBoxTree::RayAnyHit(const Vector3d &_origin,
+    const Vector3d &_dir, const double _min, const double _max) const
+{
+  const auto &nodes = this->dataPtr->nodes;
+  if (nodes.empty())
+    return false;
+
+  const Vector3d dir = _dir.Normalized();
+  std::vector<std::size_t> stack;
+  stack.push_back(0);
+  while (!stack.empty())
+  {
+    const std::size_t n = stack.back();
+    stack.pop_back();
+
+    const Node &node = nodes[n];
+    double near;
+    if (!RayNode(node, _origin, dir, _min, _max, near))
+      continue;
+
+    if (node.item != kNoItem)
+    {
+      if (this->dataPtr->boxes[node.item].IntersectCheck(
+            _origin, _dir, _min, _max))
+      {
+        return true;
+      }
+      continue;
+    }
+
+    stack.push_back(node.right);
+    stack.push_back(n + 1);
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+void AxisAlignedBoxTree::Intersects(const AxisAlignedBox &_box,
+    std::vector<std::size_t> &_indices) const
+{
+  _indices.clear();
+  const auto &nodes = this->dataPtr->nodes;
+  if (nodes.empty())
+    return;
+
+  const Vector3d &boxMin = _box.Min();
+  const Vector3d &boxMax = _box.Max();
+  std::vector<std::size_t> stack;
+  stack.push_back(0);
+  while (!stack.empty())
+  {
+    const std::size_t n = stack.back();
+    stack.pop_back();
+
+    const Node &node = nodes[n];
+    if (node.max.X() < boxMin.X() || node.max.Y() < boxMin.Y() ||
+        node.max.Z() < boxMin.Z() || node.min.X() > boxMax.X() ||
+        node.min.Y() > boxMax.Y() || node.min.Z() > boxMax.Z())
+    {
+      continue;
+    }
+
+    if (node.item != kNoItem)
+    {
+      if (this->dataPtr->boxes[node.item].Intersects(_box))
+        _indices.push_back(node.item);
+      continue;
+    }
+
+    stack.push_back(node.right);
+    stack.push_back(n + 1);
+  }
+}
+
+//////////////////////////////////////////////////
+void AxisAlignedBoxTree::Implementation::Intersects(const Frustum &_frustum,
+    std::uint8_t *_planes,
+    std::vector<std::pair<std::size_t, unsigned int>> &_stack,
+    std::vector<std::size_t> &_indices) const
+{
+  _indices.clear();
+  _stack.clear();
+  if (this->nodes.empty())
+    return;
+
+  Planed planes[kFrustumPlanes];
+  for (int p = Frustum::FRUSTUM_PLANE_NEAR;
+       p <= Frustum::FRUSTUM_PLANE_BOTTOM; ++p)
+  {
+    planes[p] = _frustum.Plane(static_cast<Frustum::FrustumPlane>(p));
+  }
+
+  _stack.emplace_back(0, kAllPlanes);
+  while (!_stack.empty())
+  {
+    const std::size_t n = _stack.back().first;
+    unsigned int mask = _stack.back().second;
+    _stack.pop_back();
+
+    // The subtree is inside every plane, report all its boxes. Its nodes
+    // are contiguous and end with its rightmost leaf.
+    if (mask == 0)
+    {
+      std::size_t last = n;
+      while (this->nodes[last].item == kNoItem)
+        last = this->nodes[last].right;
+      for (std::size_t i = n; i <= last; ++i)
+      {
+        if (this->nodes[i].item != kNoItem)
+          _indices.push_back(this->nodes[i].item);
+      }
+      continue;
+    }
+
+    // Start with the plane that culled the node last time
+    const Node &node = this->nodes[n];
+    const int first = _planes ? _planes[n] : 0;
+    if (node.item != kNoItem)
+    {
+      // The planes removed from the mask are on the positive side of the
+      // box, so this is Frustum::Contains
+      const AxisAlignedBox &box = this->boxes[node.item];
+      bool outside = false;
+      int overlapping = 0;
+      for (int i = -1; i < kFrustumPlanes; ++i)
+      {
+        const int p = i < 0 ? first : i;
+        if ((i >= 0 && p == first) || !(mask & (1u << p)))
+          continue;
+        const auto side = planes[p].Side(box);
+        if (side == Planed::NEGATIVE_SIDE)
+        {
+          outside = true;
+          if (_planes)
+            _planes[n] = static_cast<std::uint8_t>(p);
+          break;
+        }
+        if (side == Planed::BOTH_SIDE)
+          ++overlapping;
+      }
+      if (!outside && (overlapping < 2 || _frustum.Contains(box)))
+        _indices.push_back(node.item);
+      continue;
+    }
+
+    // Cull the subtree if its bounds are on the negative side of a plane,
+    // and stop testing the planes they are on the positive side of.
+    const Vector3d center = (node.min + node.max) * 0.5;
+    const Vector3d half = (node.max - node.min) * 0.5;
+    bool outside = false;
+    for (int i = -1; i < kFrustumPlanes; ++i)
+    {
+      const int p = i < 0 ? first : i;
+      if ((i >= 0 && p == first) || !(mask & (1u << p)))
+        continue;
+      const double dist = planes[p].Distance(center);
+      const double radius = planes[p].Normal().AbsDot(half);
+      if (dist < -radius - kNodeTolerance)
+      {
+        outside = true;
+        if (_planes)
+          _planes[n] = static_cast<std::uint8_t>(p);
+        break;
+      }
+      if (dist > radius + kNodeTolerance)
+        mask &= ~(1u << p);
+    }
+    if (outside)
+      continue;
+
+    _stack.emplace_back(node.right, mask);
+    _stack.emplace_back(n + 1, mask);
+  }
+}
+
+//////////////////////////////////////////////////
+void AxisAlignedBoxTree::Intersects(const Frustum &_frustum,
+    std::vector<std::size_t> &_indices) const
+{
+  std::vector<std::pair<std::size_t, unsigned int>> stack;
+  this->dataPtr->Intersects(_frustum, nullptr, stack, _indices);
+}
+
+//////////////////////////////////////////////////
+void AxisAlignedBoxTree::Intersects(const Frustum &_frustum,
+    AxisAlignedBoxTreeCullState &_state,
+    std::vector<std::size_t> &_indices) const
+{
+  if (_state.planes.size() != this->dataPtr->nodes.size())
+    _state.planes.assign(this->dataPtr->nodes.size(), 0);
+  this->dataPtr->Intersects(_frustum, _state.planes.data(), _state.stack,
+      _indices);
+}
+
+//////////////////////////////////////////////////
+void AxisAlignedBoxTree::Implementation::Visibility(const Frustum *_frustums,
+    const std::array<Planed, kFrustumPlanes> *_planes,
+    const std::pair<Vector3d, Vector3d> *_bounds,
+    const std::size_t _frustumCount, const std::size_t _node,
+    std::uint64_t *_masks) const
+{
+  // Nodes with the frustums they may be partly inside, and the planes of
+  // each frustum they straddle, 0 for the frustums they are fully inside.
+  struct Entry
+  {
+    std::size_t node;
+    std::uint64_t active;
+    std::uint8_t planes[Frustum::kMaxVisibilityFrustums];
+  };
+  std::vector<Entry> stack(1);
+  stack[0].node = _node;
+  stack[0].active = _frustumCount == 64 ? ~std::uint64_t(0) :
+    (std::uint64_t(1) << _frustumCount) - 1;
+  std::fill(stack[0].planes, stack[0].planes + _frustumCount, kAllPlanes);
+  while (!stack.empty())
+  {
+    Entry entry = stack.back();
+    stack.pop_back();
+    const std::size_t n = entry.node;
+    std::uint64_t &active = entry.active;
+    std::uint8_t *planes = entry.planes;
+
+    const Node &node = this->nodes[n];
+    if (node.item != kNoItem)
+    {
+      // The planes removed from a mask are on the positive side of the
+      // box, so this is Frustum::Contains. The center and half size are
+      // the ones of Plane::Side, computed once.
+      const AxisAlignedBox &box = this->boxes[node.item];
+      const Vector3d center = box.Center();
+      const Vector3d half = box.Size() / 2.0;
+      std::uint64_t visible = 0;
+      for (std::size_t f = 0; f < _frustumCount; ++f)
+      {
+        const std::uint64_t bit = std::uint64_t(1) << f;
+        if (!(active & bit))
+          continue;
+        bool outside = false;
+        int overlapping = 0;
+        for (int p = 0; p < kFrustumPlanes && !outside; ++p)
+        {
+          if (!(planes[f] & (1u << p)))
+            continue;
+          const double dist = _planes[f][p].Distance(center);
+          const double radius = _planes[f][p].Normal().AbsDot(half);
+          outside = dist < -radius;
+          overlapping += !outside && !(dist > radius);
+        }
+        if (!outside && (overlapping < 2 || _frustums[f].Contains(box)))
+          visible |= bit;
+      }
+      _masks[node.item] = visible;
+      continue;
+    }
+
+    // Drop the frustums the bounds are outside of, first the ones whose
+    // boxes they miss, and stop testing the planes they are on the
+    // positive side of.
+    const auto misses = [&node](const std::pair<Vector3d, Vector3d> &_box)
+    {
+      return node.max.X() < _box.first.X() ||
+        node.max.Y() < _box.first.Y() || node.max.Z() < _box.first.Z() ||
+        node.min.X() > _box.second.X() || node.min.Y() > _box.second.Y() ||
+        node.min.Z() > _box.second.Z();
+    };
+    if (misses(_bounds[_frustumCount]))
+      continue;
+    const Vector3d center = (node.min + node.max) * 0.5;
+    const Vector3d half = (node.max - node.min) * 0.5;
+    std::uint64_t inside = 0;
+    for (std::size_t f = 0; f < _frustumCount; ++f)
+    {
+      const std::uint64_t bit = std::uint64_t(1) << f;
+      if (!(active & bit))
+        continue;
+      if (misses(_bounds[f]))
+      {
+        active &= ~bit;
+        continue;
+      }
+      for (int p = 0; p < kFrustumPlanes; ++p)
+      {
+        if (!(planes[f] & (1u << p)))
+          continue;
+        const double dist = _planes[f][p].Distance(center);
+        const double radius = _planes[f][p].Normal().AbsDot(half);
+        if (dist < -radius - kNodeTolerance)
+        {
+          active &= ~bit;
+          break;
+        }
+        if (dist > radius + kNodeTolerance)
+          planes[f] &= static_cast<std::uint8_t>(~(1u << p));
+      }
+      if (planes[f] == 0)
+        inside |= bit;
+    }
+    if (active == 0)
+      continue;
+
+    // The subtree is fully inside the remaining frustums. Its nodes are
+    // contiguous and end with its rightmost leaf.
+    if (active == inside)
+    {
+      std::size_t last = n;
+      while (this->nodes[last].item == kNoItem)
+        last = this->nodes[last].right;
+      for (std::size_t i = n; i <= last; ++i)
+      {
+        if (this->nodes[i].item != kNoItem)
+          _masks[this->nodes[i].item] = inside;
+      }
+      continue;
+    }
+
+    entry.node = node.right;
+    stack.push_back(entry);
+    entry.node = n + 1;
+    stack.push_back(entry);
+  }
+}
+
+//////////////////////////////////////////////////
+void AxisAlignedBoxTree::Visibility(const Frustum *_frustums,
+    const std::size_t _frustumCount, std::uint64_t *_masks,
+    const unsigned int _threads) const
+{
+  const auto &nodes = this->dataPtr->nodes;
+  std::fill(_masks, _masks + this->dataPtr->boxes.size(), 0);
+  const std::size_t frustumCount =
+    std::min(_frustumCount, Frustum::kMaxVisibilityFrustums);
+  if (nodes.empty() || frustumCount == 0)
+    return;
+
+  std::vector<std::array<Planed, kFrustumPlanes>> planes(frustumCount);
+  std::vector<std::pair<Vector3d, Vector3d>> bounds(frustumCount + 1,
+      {Vector3d(MAX_D, MAX_D, MAX_D), Vector3d(LOW_D, LOW_D, LOW_D)});
+  const Vector3d tolerance(kNodeTolerance, kNodeTolerance, kNodeTolerance);
+  for (std::size_t f = 0; f < frustumCount; ++f)
+  {
+    const AxisAlignedBox box = _frustums[f].Bounds();
+    bounds[f] = {box.Min() - tolerance, box.Max() + tolerance};
+    Grow(bounds[frustumCount].first, bounds[frustumCount].second,
+        bounds[f].first, bounds[f].second);
+    for (int p = Frustum::FRUSTUM_PLANE_NEAR;
+         p <= Frustum::FRUSTUM_PLANE_BOTTOM; ++p)
+    {
+      planes[f][p] =
+        _frustums[f].Plane(static_cast<Frustum::FrustumPlane>(p));
+    }
+  }
+
+  const std::size_t threads = detail::ThreadCount(_threads);
+  if (threads == 1 || this->dataPtr->boxes.size() < kParallelThreshold)
+  {
+    this->dataPtr->Visibility(_frustums, planes.data(), bounds.data(),
+        frustumCount, 0, _masks);
+    return;
+  }
+
+  // Split the top of the tree in a few subtrees per thread, each thread
+  // traverses every threads-th subtree. The subtrees write the masks of
+  // disjoint sets of boxes.
+  std::vector<std::size_t> roots{0};
+  while (roots.size() < 4 * threads)
+  {
+    std::vector<std::size_t> next;
+    for (const std::size_t n : roots)
+    {
+      if (nodes[n].item != kNoItem)
+      {
+        next.push_back(n);
+        continue;
+      }
+      next.push_back(n + 1);
+      next.push_back(nodes[n].right);
+    }
+    if (next.size() == roots.size())
+      break;
+    roots.swap(next);
+  }
+
+  detail::ParallelFor(threads, threads,
+      [&](const std::size_t _first, std::size_t, std::size_t)
+  {
+    for (std::size_t i = _first; i < roots.size(); i += threads)
+    {
+      this->dataPtr->Visibility(_frustums, planes.data(), bounds.data(),
+          frustumCount, roots[i], _masks);
+    }
+  });
+}
@@ -0,0 +1,477 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+#include "gz/math/AxisAlignedBoxTree.hh"
+#include "gz/math/Helpers.hh"
+#include "gz/math/Rand.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+/// \brief Random boxes scattered in a cube of side 20 centered at the origin.
+std::vector<AxisAlignedBox> RandomBoxes(const std::size_t _count)
+{
+  Rand::Seed(1234);
+  std::vector<AxisAlignedBox> boxes;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const Vector3d center(Rand::DblUniform(-10, 10),
+        Rand::DblUniform(-10, 10), Rand::DblUniform(-10, 10));
+    const Vector3d half(Rand::DblUniform(0.05, 0.5),
+        Rand::DblUniform(0.05, 0.5), Rand::DblUniform(0.05, 0.5));
+    boxes.push_back(AxisAlignedBox(center - half, center + half));
+  }
+  return boxes;
+}
+
+/////////////////////////////////////////////////
+/// \brief Closest hit found by testing every box.
+bool BruteClosestHit(const std::vector<AxisAlignedBox> &_boxes,
+    const Vector3d &_origin, const Vector3d &_dir, const double _min,
+    const double _max, std::size_t &_index, double &_distance)
+{
+  bool hit = false;
+  for (std::size_t i = 0; i < _boxes.size(); ++i)
+  {
+    bool intersect;
+    double dist;
+    std::tie(intersect, dist, std::ignore) =
+      _boxes[i].Intersect(_origin, _dir, _min, _max);
+    if (intersect && (!hit || dist < _distance))
+    {
+      hit = true;
+      _distance = dist;
+      _index = i;
+    }
+  }
+  return hit;
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTreeTest, Empty)
+{
+  AxisAlignedBoxTree tree;
+  EXPECT_EQ(0u, tree.Size());
+  EXPECT_EQ(AxisAlignedBox(), tree.Bounds());
+
+  std::size_t index;
+  double distance;
+  EXPECT_FALSE(tree.RayClosestHit(Vector3d::Zero, Vector3d::UnitX, 0, 100,
+        index, distance));
+  EXPECT_FALSE(tree.RayAnyHit(Vector3d::Zero, Vector3d::UnitX, 0, 100));
+
+  std::vector<std::size_t> indices{1, 2};
+  tree.Intersects(AxisAlignedBox(-1, -1, -1, 1, 1, 1), indices);
+  EXPECT_TRUE(indices.empty());
+
+  EXPECT_TRUE(tree.Refit({}));
+  EXPECT_FALSE(tree.Refit({AxisAlignedBox()}));
+  EXPECT_FALSE(tree.SetBox(0, AxisAlignedBox()));
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTreeTest, SingleBox)
+{
+  const AxisAlignedBox box(1, -1, -1, 2, 1, 1);
+  AxisAlignedBoxTree tree({box});
+  EXPECT_EQ(1u, tree.Size());
+  EXPECT_EQ(box, tree.Box(0));
+  EXPECT_EQ(box, tree.Bounds());
+
+  std::size_t index = 5;
+  double distance = 0;
+  EXPECT_TRUE(tree.RayClosestHit(Vector3d::Zero, Vector3d(2, 0, 0), 0, 100,
+        index, distance));
+  EXPECT_EQ(0u, index);
+  EXPECT_DOUBLE_EQ(1.0, distance);
+
+  // Distances are measured from _min, as in AxisAlignedBox::Intersect
+  EXPECT_TRUE(tree.RayClosestHit(Vector3d::Zero, Vector3d::UnitX, 0.5, 100,
+        index, distance));
+  EXPECT_DOUBLE_EQ(0.5, distance);
+
+  EXPECT_TRUE(tree.RayAnyHit(Vector3d::Zero, Vector3d::UnitX, 0, 100));
+  EXPECT_FALSE(tree.RayAnyHit(Vector3d::Zero, Vector3d::UnitX, 0, 0.5));
+  EXPECT_FALSE(tree.RayAnyHit(Vector3d::Zero, -Vector3d::UnitX, 0, 100));
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTreeTest, Rays)
+{
+  const std::vector<AxisAlignedBox> boxes = RandomBoxes(2000);
+  AxisAlignedBoxTree tree(boxes);
+  ASSERT_EQ(boxes.size(), tree.Size());
+
+  AxisAlignedBox bounds;
+  for (const auto &box : boxes)
+    bounds.Merge(box);
+  EXPECT_EQ(bounds, tree.Bounds());
+
+  int hits = 0;
+  for (int i = 0; i < 200; ++i)
+  {
+    const Vector3d origin(Rand::DblUniform(-12, 12),
+        Rand::DblUniform(-12, 12), Rand::DblUniform(-12, 12));
+    Vector3d dir(Rand::DblUniform(-1, 1), Rand::DblUniform(-1, 1),
+        Rand::DblUniform(-1, 1));
+    // Exercise rays parallel to the axes
+    if (i % 10 == 0)
+      dir.Set(0, 0, 1);
+    const double min = (i % 3 == 0) ? 0.5 : 0.0;
+    const double max = (i % 4 == 0) ? 5.0 : 50.0;
+
+    std::size_t expectedIndex = 0;
+    double expectedDistance = 0;
+    const bool expected = BruteClosestHit(boxes, origin, dir, min, max,
+        expectedIndex, expectedDistance);
+
+    std::size_t index = 0;
+    double distance = 0;
+    ASSERT_EQ(expected,
+        tree.RayClosestHit(origin, dir, min, max, index, distance)) << i;
+    EXPECT_EQ(expected, tree.RayAnyHit(origin, dir, min, max)) << i;
+    if (expected)
+    {
+      ++hits;
+      EXPECT_DOUBLE_EQ(expectedDistance, distance) << i;
+    }
+  }
+  // Make sure both outcomes are exercised
+  EXPECT_GT(hits, 0);
+  EXPECT_LT(hits, 200);
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTreeTest, RayClosestHitTest)
+{
+  // Spheres inside the boxes, hit only by some of the rays that hit a box
+  const std::vector<AxisAlignedBox> boxes = RandomBoxes(2000);
+  AxisAlignedBoxTree tree(boxes);
+  auto sphereHit = [&](const std::size_t _index, const Vector3d &_origin,
+                       const Vector3d &_dir, const double _max,
+                       double &_distance)
+  {
+    const Vector3d center = boxes[_index].Center();
+    const double radius = boxes[_index].Size().Min() / 2;
+    const double b = _dir.Dot(_origin - center);
+    const double disc =
+        b * b - (_origin - center).SquaredLength() + radius * radius;
+    if (disc < 0)
+      return false;
+    _distance = -b - std::sqrt(disc);
+    return _distance >= 0 && _distance <= _max;
+  };
+
+  int hits = 0;
+  int tests = 0;
+  for (int i = 0; i < 200; ++i)
+  {
+    const Vector3d origin(Rand::DblUniform(-12, 12),
+        Rand::DblUniform(-12, 12), Rand::DblUniform(-12, 12));
+    const Vector3d dir = Vector3d(Rand::DblUniform(-1, 1),
+        Rand::DblUniform(-1, 1), Rand::DblUniform(-1, 1)).Normalized();
+
+    bool expected = false;
+    std::size_t expectedIndex = 0;
+    double expectedDistance = 0;
+    for (std::size_t j = 0; j < boxes.size(); ++j)
+    {
+      double dist;
+      if (sphereHit(j, origin, dir, 50, dist) &&
+          (!expected || dist < expectedDistance))
+      {
+        expected = true;
+        expectedIndex = j;
+        expectedDistance = dist;
+      }
+    }
+
+    std::size_t index = 0;
+    double distance = 0;
+    ASSERT_EQ(expected, tree.RayClosestHit(origin, dir, 0, 50,
+        [&](const std::size_t _index, const double _max, double &_distance)
+        {
+          ++tests;
+          EXPECT_LE(_max, 50);
+          return sphereHit(_index, origin, dir, _max, _distance);
+        }, index, distance)) << i;
+    if (expected)
+    {
+      ++hits;
+      EXPECT_EQ(expectedIndex, index) << i;
+      EXPECT_DOUBLE_EQ(expectedDistance, distance) << i;
+    }
+  }
+  EXPECT_GT(hits, 0);
+  EXPECT_LT(hits, 200);
+  // Far fewer tests than brute force
+  EXPECT_LT(tests, 200 * 100);
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTreeTest, IntersectsBox)
+{
+  const std::vector<AxisAlignedBox> boxes = RandomBoxes(1000);
+  AxisAlignedBoxTree tree(boxes);
+
+  for (int i = 0; i < 50; ++i)
+  {
+    const Vector3d center(Rand::DblUniform(-10, 10),
+        Rand::DblUniform(-10, 10), Rand::DblUniform(-10, 10));
+    const AxisAlignedBox query(center - Vector3d(2, 2, 2),
+        center + Vector3d(2, 2, 2));
+
+    std::vector<std::size_t> expected;
+    for (std::size_t b = 0; b < boxes.size(); ++b)
+    {
+      if (boxes[b].Intersects(query))
+        expected.push_back(b);
+    }
+
+    std::vector<std::size_t> indices;
+    tree.Intersects(query, indices);
+    std::sort(indices.begin(), indices.end());
+    EXPECT_EQ(expected, indices) << i;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTreeTest, IntersectsFrustum)
+{
+  const std::vector<AxisAlignedBox> boxes = RandomBoxes(1000);
+  AxisAlignedBoxTree tree(boxes);
+
+  for (int i = 0; i < 8; ++i)
+  {
+    const Frustum frustum(0.5, 12, Angle(GZ_DTOR(40 + 5 * i)), 4.0 / 3,
+        Pose3d(0, 0, 0, 0, 0.2 * i, GZ_DTOR(45 * i)));
+
+    std::vector<std::size_t> expected;
+    for (std::size_t b = 0; b < boxes.size(); ++b)
+    {
+      if (frustum.Contains(boxes[b]))
+        expected.push_back(b);
+    }
+    EXPECT_FALSE(expected.empty());
+
+    std::vector<std::size_t> indices;
+    tree.Intersects(frustum, indices);
+    std::sort(indices.begin(), indices.end());
+    EXPECT_EQ(expected, indices) << i;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTreeTest, IntersectsFrustumState)
+{
+  std::vector<AxisAlignedBox> boxes = RandomBoxes(1000);
+  AxisAlignedBoxTree tree(boxes);
+  AxisAlignedBoxTreeCullState state;
+  std::vector<std::size_t> indices;
+  std::vector<std::size_t> expected;
+
+  // A camera turning slowly, the state is reused from frame to frame
+  for (int i = 0; i < 40; ++i)
+  {
+    const Frustum frustum(0.5, 12, Angle(GZ_DTOR(60)), 4.0 / 3,
+        Pose3d(1, -2, 0.5, 0, 0.1, GZ_DTOR(9 * i)));
+    tree.Intersects(frustum, expected);
+    EXPECT_FALSE(expected.empty());
+    tree.Intersects(frustum, state, indices);
+    EXPECT_EQ(expected, indices) << i;
+  }
+  EXPECT_EQ(2 * boxes.size() - 1, state.planes.size());
+
+  // A frustum around every box, whole subtrees are reported at once
+  const Frustum wide(0.1, 100, Angle(GZ_DTOR(120)), 1.0,
+      Pose3d(-40, 0, 0, 0, 0, 0));
+  tree.Intersects(wide, state, indices);
+  EXPECT_EQ(boxes.size(), indices.size());
+  std::sort(indices.begin(), indices.end());
+  for (std::size_t b = 0; b < indices.size(); ++b)
+    EXPECT_EQ(b, indices[b]);
+
+  // The state is reset for a tree of another size
+  boxes.resize(100);
+  tree.Build(boxes);
+  const Frustum frustum(0.5, 12, Angle(GZ_DTOR(60)), 4.0 / 3,
+      Pose3d(0, 0, 0, 0, 0, GZ_DTOR(30)));
+  tree.Intersects(frustum, expected);
+  tree.Intersects(frustum, state, indices);
+  EXPECT_EQ(expected, indices);
+  EXPECT_EQ(2 * boxes.size() - 1, state.planes.size());
+
+  AxisAlignedBoxTree empty;
+  empty.Intersects(frustum, state, indices);
+  EXPECT_TRUE(indices.empty());
+  EXPECT_TRUE(state.planes.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTreeTest, Visibility)
+{
+  const std::vector<AxisAlignedBox> boxes = RandomBoxes(6000);
+  AxisAlignedBoxTree tree(boxes);
+
+  // A ring of 12 cameras, and a wide frustum around every box
+  std::vector<Frustum> frustums;
+  for (int i = 0; i < 12; ++i)
+  {
+    frustums.push_back(Frustum(0.5, 12, Angle(GZ_DTOR(50)), 4.0 / 3,
+        Pose3d(1, -2, 0.5, 0, 0.1, GZ_DTOR(30 * i))));
+  }
+  frustums.push_back(Frustum(0.1, 100, Angle(GZ_DTOR(120)), 1.0,
+      Pose3d(-40, 0, 0, 0, 0, 0)));
+
+  std::vector<std::uint64_t> expected(boxes.size());
+  Frustum::Visibility(frustums.data(), frustums.size(), boxes.data(),
+      expected.data(), boxes.size());
+  for (unsigned int threads : {1u, 3u, 0u})
+  {
+    std::vector<std::uint64_t> masks(boxes.size(), ~std::uint64_t(0));
+    tree.Visibility(frustums.data(), frustums.size(), masks.data(),
+        threads);
+    EXPECT_EQ(expected, masks) << threads;
+  }
+
+  // Without the wide frustum, some boxes are outside of all frustums
+  std::vector<std::uint64_t> masks(boxes.size(), ~std::uint64_t(0));
+  tree.Visibility(frustums.data(), 12, masks.data());
+  std::size_t hidden = 0;
+  for (std::size_t b = 0; b < boxes.size(); ++b)
+  {
+    ASSERT_EQ(expected[b] & 0xfff, masks[b]) << b;
+    hidden += masks[b] == 0;
+  }
+  EXPECT_GT(hidden, 0u);
+
+  // Empty tree
+  AxisAlignedBoxTree empty;
+  empty.Visibility(frustums.data(), frustums.size(), nullptr);
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTreeTest, Refit)
+{
+  std::vector<AxisAlignedBox> boxes = RandomBoxes(500);
+  AxisAlignedBoxTree tree(boxes);
+
+  // Move every box
+  for (auto &box : boxes)
+  {
+    const Vector3d offset(Rand::DblUniform(-3, 3),
+        Rand::DblUniform(-3, 3), Rand::DblUniform(-3, 3));
+    box = AxisAlignedBox(box.Min() + offset, box.Max() + offset);
+  }
+  EXPECT_FALSE(tree.Refit(std::vector<AxisAlignedBox>(3)));
+  ASSERT_TRUE(tree.Refit(boxes));
+  EXPECT_EQ(boxes[7], tree.Box(7));
+
+  // Move one box far away
+  const AxisAlignedBox far(100, 100, 100, 101, 101, 101);
+  ASSERT_TRUE(tree.SetBox(42, far));
+  boxes[42] = far;
+  EXPECT_FALSE(tree.SetBox(500, far));
+  EXPECT_EQ(far.Max(), tree.Bounds().Max());
+
+  std::vector<std::size_t> indices;
+  tree.Intersects(AxisAlignedBox(99, 99, 99, 102, 102, 102), indices);
+  ASSERT_EQ(1u, indices.size());
+  EXPECT_EQ(42u, indices[0]);
+
+  std::size_t index;
+  double distance;
+  EXPECT_TRUE(tree.RayClosestHit(Vector3d(0, 100.5, 100.5), Vector3d::UnitX,
+        0, 200, index, distance));
+  EXPECT_EQ(42u, index);
+  EXPECT_DOUBLE_EQ(100.0, distance);
+
+  for (int i = 0; i < 50; ++i)
+  {
+    const Vector3d origin(Rand::DblUniform(-12, 12),
+        Rand::DblUniform(-12, 12), Rand::DblUniform(-12, 12));
+    const Vector3d dir(Rand::DblUniform(-1, 1), Rand::DblUniform(-1, 1),
+        Rand::DblUniform(-1, 1));
+    std::size_t expectedIndex = 0;
+    double expectedDistance = 0;
+    const bool expected = BruteClosestHit(boxes, origin, dir, 0, 50,
+        expectedIndex, expectedDistance);
+    EXPECT_EQ(expected,
+        tree.RayClosestHit(origin, dir, 0, 50, index, distance)) << i;
+    if (expected)
+    {
+      EXPECT_DOUBLE_EQ(expectedDistance, distance) << i;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTreeTest, ParallelBuild)
+{
+  const std::vector<AxisAlignedBox> boxes = RandomBoxes(20000);
+  AxisAlignedBoxTree serial;
+  serial.Build(boxes, 1);
+  AxisAlignedBoxTree parallel;
+  parallel.Build(boxes, 4);
+  AxisAlignedBoxTree automatic;
+  automatic.Build(boxes, 0);
+
+  EXPECT_EQ(serial.Bounds(), parallel.Bounds());
+  EXPECT_EQ(serial.Bounds(), automatic.Bounds());
+
+  for (int i = 0; i < 20; ++i)
+  {
+    const Vector3d center(Rand::DblUniform(-10, 10),
+        Rand::DblUniform(-10, 10), Rand::DblUniform(-10, 10));
+    const AxisAlignedBox query(center - Vector3d(1, 1, 1),
+        center + Vector3d(1, 1, 1));
+    std::vector<std::size_t> expected;
+    std::vector<std::size_t> indices;
+    serial.Intersects(query, expected);
+    parallel.Intersects(query, indices);
+    // Same tree, so the same traversal order
+    EXPECT_EQ(expected, indices) << i;
+    automatic.Intersects(query, indices);
+    EXPECT_EQ(expected, indices) << i;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(AxisAlignedBoxTreeTest, CoincidentBoxes)
+{
+  // Boxes with the same center use the median split
+  std::vector<AxisAlignedBox> boxes(64, AxisAlignedBox(0, 0, 0, 1, 1, 1));
+  AxisAlignedBoxTree tree(boxes);
+
+  std::vector<std::size_t> indices;
+  tree.Intersects(AxisAlignedBox(0.5, 0.5, 0.5, 2, 2, 2), indices);
+  EXPECT_EQ(64u, indices.size());
+
+  std::size_t index;
+  double distance;
+  EXPECT_TRUE(tree.RayClosestHit(Vector3d(-1, 0.5, 0.5), Vector3d::UnitX,
+        0, 10, index, distance));
+  EXPECT_DOUBLE_EQ(1.0, distance);
+}
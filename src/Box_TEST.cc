@@ -17,6 +17,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include "gz/math/Box.hh"
 
 using namespace gz;
@@ -210,6 +214,150 @@ TEST(BoxTest, Intersections)
   }
 }
 
+//////////////////////////////////////////////////
+TEST(BoxTest, IntersectionsArray)
+{
+  math::Boxd box(2.0, 3.0, 4.0);
+  math::Vector3d points[math::Boxd::kMaxIntersections];
+
+  // No intersections
+  EXPECT_EQ(0u, box.Intersections(
+    math::Planed(math::Vector3d(0.0, 0.0, 1.0), -5.0), points));
+
+  // Same points in the same order as the set
+  const math::Planed planes[] =
+  {
+    math::Planed(math::Vector3d(0.0, 0.0, 1.0), 0),
+    math::Planed(math::Vector3d(0.0, 0.0, 1.0), 2.0),
+    math::Planed(math::Vector3d(1.0, 1.0, 1.0), 1.0),
+    math::Planed(math::Vector3d(1.0, 1.0, 1.0), 0.5),
+    math::Planed(math::Vector3d(1.0, 1.0, 2.0), 0.5),
+    math::Planed(math::Vector3d(-0.3, 0.7, 0.2), -0.4)
+  };
+  for (const auto &plane : planes)
+  {
+    const auto expected = box.Intersections(plane);
+    const std::size_t count = box.Intersections(plane, points);
+    ASSERT_EQ(expected.size(), count);
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), points));
+    for (std::size_t i = 0; i < count; ++i)
+      EXPECT_NEAR(0.0, plane.Distance(points[i]), 1e-12);
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(BoxTest, IntersectionPolygon)
+{
+  math::Boxd box(2.0, 3.0, 4.0);
+  math::Vector3d points[math::Boxd::kMaxIntersections];
+
+  // No intersections
+  EXPECT_EQ(0u, box.IntersectionPolygon(
+    math::Planed(math::Vector3d(0.0, 0.0, 1.0), -5.0), points));
+
+  // Square cut, counterclockwise around the normal
+  const math::Planed flat(math::Vector3d(0.0, 0.0, 1.0), 1.0);
+  ASSERT_EQ(4u, box.IntersectionPolygon(flat, points));
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    const auto &a = points[i];
+    const auto &b = points[(i + 1) % 4];
+    EXPECT_DOUBLE_EQ(1.0, a.Z());
+    EXPECT_DOUBLE_EQ(a.Cross(b).Z(), std::abs(a.Cross(b).Z()));
+    // Consecutive vertices are on the same face of the box
+    EXPECT_TRUE(math::equal(a.X(), b.X()) || math::equal(a.Y(), b.Y()));
+  }
+
+  // Corners on the plane are vertices, once
+  EXPECT_EQ(4u, box.IntersectionPolygon(
+    math::Planed(math::Vector3d(0.0, 0.0, 1.0), 2.0), points));
+  EXPECT_EQ(1u, box.IntersectionPolygon(
+    math::Planed(math::Vector3d(1.0, 1.0, 1.0), 4.5), points));
+  EXPECT_EQ(math::Vector3d(1.0, 1.5, 2.0), points[0]);
+  EXPECT_EQ(4u, box.IntersectionPolygon(
+    math::Planed(math::Vector3d(1.5, -1.0, 0.0), 0.0), points));
+  EXPECT_EQ(1u, math::Boxd().IntersectionPolygon(
+    math::Planed(math::Vector3d(1.0, 1.0, 1.0), 0.0), points));
+
+  // Same points as the set, forming a convex polygon
+  const math::Planed planes[] =
+  {
+    math::Planed(math::Vector3d(1.0, 1.0, 1.0), 0.0),
+    math::Planed(math::Vector3d(1.0, 1.0, 1.0), 1.0),
+    math::Planed(math::Vector3d(1.0, 1.0, 2.0), 0.5),
+    math::Planed(math::Vector3d(-0.3, 0.7, 0.2), -0.4)
+  };
+  for (const auto &plane : planes)
+  {
+    const auto expected = box.Intersections(plane);
+    const std::size_t count = box.IntersectionPolygon(plane, points);
+    ASSERT_EQ(expected.size(), count);
+    ASSERT_GE(count, 3u);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      EXPECT_TRUE(std::any_of(expected.begin(), expected.end(),
+          [&](const math::Vector3d &_p)
+          {
+            return _p.Equal(points[i], 1e-12);
+          })) << points[i];
+      const auto &a = points[i];
+      const auto &b = points[(i + 1) % count];
+      const auto &c = points[(i + 2) % count];
+      EXPECT_GT((b - a).Cross(c - b).Dot(plane.Normal()), 0.0);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(BoxTest, IntersectionPolygons)
+{
+  const math::Planed water(math::Vector3d(0.0, 0.0, 1.0), 0.5);
+  const std::vector<math::Boxd> boxes{
+      math::Boxd(2.0, 2.0, 2.0),
+      math::Boxd(2.0, 1.0, 1.0),
+      math::Boxd(1.0, 3.0, 0.5),
+      math::Boxd(0.5, 0.5, 0.5)};
+  const std::vector<math::Pose3d> poses{
+      math::Pose3d(0, 0, 0, 0, 0, 0),
+      math::Pose3d(-3, 0, -10, 0, 0, 0),
+      math::Pose3d(1, -2, 0.6, 0.3, -0.2, 1.0),
+      math::Pose3d(0, 4, 0.4, 0.1, 0.2, 0.3)};
+  std::vector<math::Vector3d> points(
+      boxes.size() * math::Boxd::kMaxIntersections);
+  std::vector<std::size_t> offsets(boxes.size() + 1);
+  const std::size_t total = math::Boxd::IntersectionPolygons(boxes.data(),
+      poses.data(), boxes.size(), water, points.data(), offsets.data());
+
+  EXPECT_EQ(offsets.back(), total);
+  EXPECT_EQ(0u, offsets[0]);
+  EXPECT_EQ(4u, offsets[1]);
+  EXPECT_EQ(4u, offsets[2]);
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    EXPECT_DOUBLE_EQ(0.5, points[i].Z());
+    EXPECT_DOUBLE_EQ(1.0, std::abs(points[i].X()));
+    EXPECT_DOUBLE_EQ(1.0, std::abs(points[i].Y()));
+  }
+
+  for (std::size_t i = 0; i < boxes.size(); ++i)
+  {
+    // Same as the plane in the frame of the box
+    const math::Vector3d normal =
+        poses[i].Rot().RotateVectorReverse(water.Normal());
+    const math::Planed plane(normal,
+        water.Offset() - water.Normal().Dot(poses[i].Pos()));
+    math::Vector3d expected[math::Boxd::kMaxIntersections];
+    const std::size_t count = boxes[i].IntersectionPolygon(plane, expected);
+    ASSERT_EQ(count, offsets[i + 1] - offsets[i]);
+    for (std::size_t j = 0; j < count; ++j)
+    {
+      const auto &point = points[offsets[i] + j];
+      EXPECT_EQ(poses[i].CoordPositionAdd(expected[j]), point);
+      EXPECT_NEAR(0.0, water.Distance(point), 1e-12);
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 TEST(BoxTest, VolumeBelow)
 {
@@ -338,6 +486,54 @@ TEST(BoxTest, CenterOfVolumeBelow)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(BoxTest, VolumesBelow)
+{
+  const math::Planed water(math::Vector3d(0.0, 0.0, 1.0), 0.5);
+  const std::vector<math::Boxd> boxes{
+      math::Boxd(2.0, 2.0, 2.0),
+      math::Boxd(1.0, 3.0, 0.5),
+      math::Boxd(2.0, 1.0, 1.0),
+      math::Boxd(0.5, 0.5, 0.5)};
+  const std::vector<math::Pose3d> poses{
+      math::Pose3d(0, 0, 0, 0, 0, 0),
+      math::Pose3d(1, -2, 0.6, 0.3, -0.2, 1.0),
+      math::Pose3d(-3, 0, -10, 0, 0, 0),
+      math::Pose3d(0, 4, 5, 0.1, 0.2, 0.3)};
+  std::vector<double> volumes(boxes.size());
+  std::vector<math::Vector3d> centers(boxes.size());
+  math::Boxd::VolumesBelow(boxes.data(), poses.data(), boxes.size(), water,
+      volumes.data(), centers.data());
+
+  EXPECT_DOUBLE_EQ(3 * boxes[0].Volume() / 4, volumes[0]);
+  EXPECT_EQ(math::Vector3d(0, 0, -0.25), centers[0]);
+  EXPECT_DOUBLE_EQ(boxes[2].Volume(), volumes[2]);
+  EXPECT_EQ(math::Vector3d(-3, 0, -10), centers[2]);
+  EXPECT_DOUBLE_EQ(0.0, volumes[3]);
+  EXPECT_TRUE(std::isnan(centers[3].X()));
+
+  for (size_t i = 0; i < boxes.size(); ++i)
+  {
+    // Same as the plane in the frame of the box
+    const math::Vector3d normal =
+        poses[i].Rot().RotateVectorReverse(water.Normal());
+    const math::Planed plane(normal,
+        water.Offset() - water.Normal().Dot(poses[i].Pos()));
+    EXPECT_DOUBLE_EQ(boxes[i].VolumeBelow(plane), volumes[i]);
+    const auto center = boxes[i].CenterOfVolumeBelow(plane);
+    if (center)
+    {
+      EXPECT_EQ(poses[i].CoordPositionAdd(*center), centers[i]);
+    }
+  }
+
+  // Centers are optional
+  volumes.assign(volumes.size(), -1.0);
+  math::Boxd::VolumesBelow(boxes.data(), poses.data(), boxes.size(), water,
+      volumes.data(), nullptr);
+  EXPECT_DOUBLE_EQ(3 * boxes[0].Volume() / 4, volumes[0]);
+}
+
 //////////////////////////////////////////////////
 TEST(BoxTest, VerticesBelow)
 {
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "gz/math/CapsuleArray.hh"
+#include "gz/math/Line3.hh"
+#include "gz/math/Line3Array.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/Vector3.hh"
+
+#include "test/helpers/RandomVector.hh"
+
+using namespace gz;
+using namespace math;
+using test::RandomVector;
+
+/////////////////////////////////////////////////
+TEST(CapsuleArrayTest, Capsules)
+{
+  CapsuleArrayd capsules;
+  EXPECT_TRUE(capsules.Empty());
+  capsules.Distances(Vector3d::Zero, nullptr);
+  const std::size_t *noIds = nullptr;
+  capsules.Distances(noIds, noIds, 0, nullptr);
+
+  const std::vector<Vector3d> centers = {Vector3d(1, 2, 3), Vector3d::Zero};
+  const std::vector<Vector3d> axes = {Vector3d(0, 0, 1), Vector3d(2, 0, 0)};
+  const std::vector<double> radii = {0.5, 0.25};
+  capsules.Assign(centers.data(), axes.data(), radii.data(), centers.size());
+  ASSERT_EQ(2u, capsules.Size());
+  EXPECT_EQ(Vector3d(1, 2, 3), capsules.Center(0));
+  EXPECT_EQ(Vector3d(0, 0, 1), capsules.Axis(0));
+  EXPECT_DOUBLE_EQ(0.5, capsules.Radius(0));
+  EXPECT_EQ(Line3d(Vector3d(1, 2, 2), Vector3d(1, 2, 4)),
+            capsules.Segment(0));
+
+  capsules.Add(Line3d(Vector3d(0, 0, 0), Vector3d(0, 4, 0)), 1);
+  ASSERT_EQ(3u, capsules.Size());
+  EXPECT_EQ(Vector3d(0, 2, 0), capsules.Center(2));
+  EXPECT_EQ(Vector3d(0, 2, 0), capsules.Axis(2));
+
+  capsules.SetCapsule(2, Vector3d(5, 5, 5), Vector3d::Zero, 2);
+  EXPECT_EQ(Vector3d(5, 5, 5), capsules.Center(2));
+  EXPECT_EQ(Vector3d::Zero, capsules.Axis(2));
+  EXPECT_DOUBLE_EQ(2, capsules.Radius(2));
+
+  capsules.Clear();
+  EXPECT_TRUE(capsules.Empty());
+}
+
+/////////////////////////////////////////////////
+TEST(CapsuleArrayTest, PointDistance)
+{
+  const Vector3d axis(0, 0, 2);
+  EXPECT_DOUBLE_EQ(2, CapsuleArrayd::Distance(Vector3d::Zero, axis, 1,
+                                              Vector3d(3, 0, 1)));
+  EXPECT_DOUBLE_EQ(1, CapsuleArrayd::Distance(Vector3d::Zero, axis, 1,
+                                              Vector3d(0, 0, 4)));
+  EXPECT_DOUBLE_EQ(-0.5, CapsuleArrayd::Distance(Vector3d::Zero, axis, 1,
+                                                 Vector3d(0, 0.5, -1)));
+  // A sphere
+  EXPECT_DOUBLE_EQ(4, CapsuleArrayd::Distance(Vector3d::Zero,
+      Vector3d::Zero, 1, Vector3d(3, 4, 0)));
+
+  CapsuleArrayf capsules;
+  capsules.Add(Vector3f::Zero, Vector3f(0, 0, 2), 1);
+  capsules.Add(Vector3f(4, 0, 0), Vector3f::Zero, 0.5f);
+  std::vector<float> distances(capsules.Size());
+  capsules.Distances(Vector3f(2, 0, 1.5f), distances.data());
+  EXPECT_FLOAT_EQ(1, distances[0]);
+  EXPECT_FLOAT_EQ(2, distances[1]);
+
+  const std::vector<std::size_t> ids = {0, 1, 0};
+  const std::vector<Vector3f> points = {
+    Vector3f(2, 0, 1.5f), Vector3f(4, 1, 0), Vector3f(0, 0, 1)};
+  std::vector<Vector3f> normals(ids.size());
+  distances.resize(ids.size());
+  capsules.Distances(ids.data(), points.data(), ids.size(),
+                     distances.data(), normals.data());
+  EXPECT_FLOAT_EQ(1, distances[0]);
+  EXPECT_FLOAT_EQ(0.5f, distances[1]);
+  EXPECT_FLOAT_EQ(-1, distances[2]);
+  EXPECT_EQ(Vector3f(1, 0, 0), normals[0]);
+  EXPECT_EQ(Vector3f(0, 1, 0), normals[1]);
+  EXPECT_EQ(Vector3f::Zero, normals[2]);
+}
+
+/////////////////////////////////////////////////
+TEST(CapsuleArrayTest, CapsuleDistance)
+{
+  // Crossing
+  EXPECT_DOUBLE_EQ(1, CapsuleArrayd::Distance(
+      Vector3d::Zero, Vector3d(1, 0, 0), 0.5,
+      Vector3d(0, 0, 2), Vector3d(0, 1, 0), 0.5));
+  // Parallel and overlapping
+  EXPECT_DOUBLE_EQ(-0.5, CapsuleArrayd::Distance(
+      Vector3d::Zero, Vector3d(1, 0, 0), 1,
+      Vector3d(1.5, 1.5, 0), Vector3d(2, 0, 0), 1));
+  // End to end
+  EXPECT_DOUBLE_EQ(1, CapsuleArrayd::Distance(
+      Vector3d::Zero, Vector3d(1, 0, 0), 0.5,
+      Vector3d(4, 0, 0), Vector3d(-1, 0, 0), 0.5));
+  // Spheres
+  EXPECT_DOUBLE_EQ(2, CapsuleArrayd::Distance(
+      Vector3d::Zero, Vector3d::Zero, 1,
+      Vector3d(0, 4, 0), Vector3d::Zero, 1));
+  EXPECT_DOUBLE_EQ(1, CapsuleArrayd::Distance(
+      Vector3d::Zero, Vector3d(0, 2, 0), 0.5,
+      Vector3d(2, 1, 0), Vector3d::Zero, 0.5));
+  EXPECT_DOUBLE_EQ(1, CapsuleArrayd::Distance(
+      Vector3d(2, 1, 0), Vector3d::Zero, 0.5,
+      Vector3d::Zero, Vector3d(0, 2, 0), 0.5));
+}
+
+/////////////////////////////////////////////////
+TEST(CapsuleArrayTest, MatchesLine3Array)
+{
+  Rand::Seed(13);
+  const std::size_t count = 203;
+  CapsuleArrayd capsules;
+  std::vector<Line3d> segments;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    // Some capsules are spheres
+    const Vector3d axis = i % 10 == 0 ? Vector3d::Zero : RandomVector(-2, 2);
+    const Vector3d center = RandomVector(-5, 5);
+    capsules.Add(center, axis, Rand::DblUniform(0.1, 1));
+    segments.push_back(capsules.Segment(i));
+  }
+  // Parallel capsules
+  capsules.Add(Vector3d::Zero, Vector3d(1, 1, 0), 0.5);
+  segments.push_back(capsules.Segment(count));
+  capsules.Add(Vector3d(3, 2, 1), Vector3d(-2, -2, 0), 0.5);
+  segments.push_back(capsules.Segment(count + 1));
+
+  std::vector<std::size_t> first;
+  std::vector<std::size_t> second;
+  for (std::size_t i = 0; i < capsules.Size(); ++i)
+  {
+    for (std::size_t j = 0; j < capsules.Size(); j += 3)
+    {
+      first.push_back(i);
+      second.push_back(j);
+    }
+  }
+  std::vector<double> distances(first.size());
+  std::vector<Vector3d> normals(first.size());
+  capsules.Distances(first.data(), second.data(), first.size(),
+                     distances.data(), normals.data());
+
+  const Line3Arrayd lines(segments);
+  std::vector<double> lineDistances;
+  for (std::size_t k = 0; k < first.size(); ++k)
+  {
+    const std::size_t i = first[k];
+    const std::size_t j = second[k];
+    lines.Distances(segments[j], lineDistances);
+    const double expected =
+      lineDistances[i] - capsules.Radius(i) - capsules.Radius(j);
+    EXPECT_NEAR(expected, distances[k], 1e-9) << i << " " << j;
+    EXPECT_NEAR(expected, CapsuleArrayd::Distance(
+        capsules.Center(i), capsules.Axis(i), capsules.Radius(i),
+        capsules.Center(j), capsules.Axis(j), capsules.Radius(j)), 1e-9);
+
+    // The normal goes from the first core to the second
+    if (i != j)
+    {
+      EXPECT_NEAR(1.0, normals[k].Length(), 1e-9) << i << " " << j;
+      const double moved = CapsuleArrayd::Distance(
+          capsules.Center(i), capsules.Axis(i), capsules.Radius(i),
+          capsules.Center(j) + normals[k] * 0.01, capsules.Axis(j),
+          capsules.Radius(j));
+      EXPECT_NEAR(distances[k] + 0.01, moved, 1e-6) << i << " " << j;
+    }
+    else
+    {
+      EXPECT_EQ(Vector3d::Zero, normals[k]);
+    }
+  }
+}
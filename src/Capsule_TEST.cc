@@ -16,9 +16,13 @@
 */
 #include <gtest/gtest.h>
 #include <cmath>
+#include <vector>
 
 #include "gz/math/Capsule.hh"
 #include "gz/math/Helpers.hh"
+#include "gz/math/Plane.hh"
+#include "gz/math/Pose3.hh"
+#include "gz/math/Sphere.hh"
 
 using namespace gz;
 
@@ -127,3 +131,109 @@ TEST(CapsuleTest, Mass)
   EXPECT_EQ(expectedMassMat.DiagonalMoments(), massMat->DiagonalMoments());
   EXPECT_DOUBLE_EQ(expectedMassMat.Mass(), massMat->Mass());
 }
+
+//////////////////////////////////////////////////
+TEST(CapsuleTest, VolumeBelow)
+{
+  const double l = 2.0;
+  const double r = 0.5;
+  const math::Capsuled capsule(l, r);
+  const math::Sphered sphere(r);
+
+  // Fully below and fully above
+  math::Planed plane(math::Vector3d(0, 0, 1), 1.6);
+  EXPECT_DOUBLE_EQ(capsule.Volume(), capsule.VolumeBelow(plane));
+  EXPECT_EQ(math::Vector3d::Zero, capsule.CenterOfVolumeBelow(plane));
+  plane = math::Planed(math::Vector3d(0, 0, 1), -1.6);
+  EXPECT_DOUBLE_EQ(0.0, capsule.VolumeBelow(plane));
+  EXPECT_EQ(std::nullopt, capsule.CenterOfVolumeBelow(plane));
+
+  // Plane perpendicular to the axis, through the top hemisphere
+  plane = math::Planed(math::Vector3d(0, 0, 1), 1.2);
+  const double cap = sphere.VolumeBelow(math::Planed(plane.Normal(), 0.2)) -
+      sphere.Volume() / 2;
+  EXPECT_NEAR(GZ_PI * r * r * l + sphere.Volume() / 2 + cap,
+              capsule.VolumeBelow(plane), 1e-9);
+
+  // Plane perpendicular to the axis, through the bottom hemisphere
+  plane = math::Planed(math::Vector3d(0, 0, 1), -1.2);
+  auto center = capsule.CenterOfVolumeBelow(plane);
+  ASSERT_NE(std::nullopt, center);
+  const auto sphereCenter =
+      sphere.CenterOfVolumeBelow(math::Planed(plane.Normal(), -0.2));
+  ASSERT_NE(std::nullopt, sphereCenter);
+  EXPECT_NEAR(sphere.VolumeBelow(math::Planed(plane.Normal(), -0.2)),
+              capsule.VolumeBelow(plane), 1e-9);
+  EXPECT_NEAR(0.0, center->X(), 1e-9);
+  EXPECT_NEAR(0.0, center->Y(), 1e-9);
+  EXPECT_NEAR(sphereCenter->Z() - 1.0, center->Z(), 1e-9);
+
+  // Plane parallel to the axis cuts a cylinder and a sphere
+  const double h = 0.2;
+  const double area = r * r * std::acos(-h / r) + h * std::sqrt(r * r - h * h);
+  plane = math::Planed(math::Vector3d(1, 0, 0), h);
+  const double volume = area * l + sphere.VolumeBelow(plane);
+  EXPECT_NEAR(volume, capsule.VolumeBelow(plane), 1e-9);
+  center = capsule.CenterOfVolumeBelow(plane);
+  ASSERT_NE(std::nullopt, center);
+  EXPECT_NEAR((-2 * std::pow(r * r - h * h, 1.5) / 3 * l +
+               sphere.CenterOfVolumeBelow(plane)->X() *
+               sphere.VolumeBelow(plane)) / volume, center->X(), 1e-9);
+  EXPECT_NEAR(0.0, center->Y(), 1e-9);
+  EXPECT_NEAR(0.0, center->Z(), 1e-9);
+
+  // Any plane through the center cuts the capsule in halves
+  plane = math::Planed(math::Vector3d(0.3, -0.5, 0.8), 0.0);
+  EXPECT_NEAR(capsule.Volume() / 2, capsule.VolumeBelow(plane), 1e-9);
+  center = capsule.CenterOfVolumeBelow(plane);
+  ASSERT_NE(std::nullopt, center);
+  EXPECT_GT(0.0, plane.Distance(*center));
+
+  // Without length it is a sphere
+  const math::Capsuled ball(0.0, r);
+  plane = math::Planed(math::Vector3d(0.3, -0.5, 0.8).Normalize(), 0.2);
+  EXPECT_NEAR(sphere.VolumeBelow(plane), ball.VolumeBelow(plane), 1e-9);
+  center = ball.CenterOfVolumeBelow(plane);
+  ASSERT_NE(std::nullopt, center);
+  EXPECT_LT((*sphere.CenterOfVolumeBelow(plane) - *center).Length(), 1e-9);
+}
+
+//////////////////////////////////////////////////
+TEST(CapsuleTest, VolumesBelow)
+{
+  std::vector<math::Capsuled> capsules;
+  std::vector<math::Pose3d> poses;
+  for (int i = 0; i < 20; ++i)
+  {
+    capsules.push_back(math::Capsuled(1.0 + 0.1 * i, 0.2 + 0.05 * i));
+    poses.push_back(math::Pose3d(0.1 * i, -0.2 * i, 0.05 * i - 0.5,
+                                 0.3 * i, 0.2 - 0.1 * i, 0.7 * i));
+  }
+  const math::Planed water(math::Vector3d(0, 0, 1), 0.1);
+
+  std::vector<double> volumes(capsules.size());
+  std::vector<math::Vector3d> centers(capsules.size());
+  math::Capsuled::VolumesBelow(capsules.data(), poses.data(),
+      capsules.size(), water, volumes.data(), centers.data());
+
+  for (std::size_t i = 0; i < capsules.size(); ++i)
+  {
+    const math::Pose3d &pose = poses[i];
+    const math::Planed plane(pose.Rot().RotateVectorReverse(water.Normal()),
+        water.Offset() - water.Normal().Dot(pose.Pos()));
+    EXPECT_DOUBLE_EQ(capsules[i].VolumeBelow(plane), volumes[i]) << i;
+    const auto center = capsules[i].CenterOfVolumeBelow(plane);
+    if (center)
+    {
+      EXPECT_EQ(pose.Rot().RotateVector(*center) + pose.Pos(), centers[i]);
+    }
+    else
+    {
+      EXPECT_TRUE(std::isnan(centers[i].X())) << i;
+    }
+  }
+
+  // Centers are optional
+  math::Capsuled::VolumesBelow(capsules.data(), poses.data(),
+      capsules.size(), water, volumes.data(), nullptr);
+}
@@ -16,8 +16,10 @@
  */
 #include <cmath>
 #include <algorithm>
+#include <vector>
 
 #include "gz/math/Color.hh"
+#include "gz/math/detail/ParallelFor.hh"
 
 using namespace gz;
 using namespace math;
@@ -35,6 +37,130 @@ constexpr Color gYellow = Color(1, 1, 0, 1);
 constexpr Color gMagenta = Color(1, 0, 1, 1);
 constexpr Color gCyan = Color(0, 1, 1, 1);
 
+/// \brief Number of pixels the buffer conversions process at once.
+constexpr size_t kBlockSize = 64;
+
+/// \brief Smallest number of pixels converted by each thread.
+constexpr size_t kMinChunkSize = 16384;
+
+/// \brief Run a function over contiguous chunks of a buffer, in parallel.
+/// \param[in] _count Number of pixels.
+/// \param[in] _threads Largest number of threads, zero for
+/// std::thread::hardware_concurrency.
+/// \param[in] _fn Function called with the first pixel of a chunk and the
+/// pixel after its last one.
+template <typename F>
+void ForEachChunk(const size_t _count, const unsigned int _threads, F &&_fn)
+{
+  if (_count == 0)
+    return;
+
+  detail::ParallelFor(_count,
+      detail::ChunkCount(_count, _threads, kMinChunkSize),
+      [&_fn](size_t, size_t _begin, size_t _end)
+  {
+    _fn(_begin, _end);
+  });
+}
+
+/// \brief Convert the pixels of a chunk of a buffer by blocks. Each block
+/// is copied to and from local arrays, which the compiler knows don't
+/// overlap, so that the kernel can be vectorized.
+/// \param[in] _in Input buffer.
+/// \param[out] _out Output buffer.
+/// \param[in] _begin First pixel of the chunk.
+/// \param[in] _end Pixel after the last one of the chunk.
+/// \param[in] _kernel Function converting a block of kBlockSize pixels
+/// from an array of In to an array of Out.
+template <size_t InChannels, size_t OutChannels, typename In, typename Out,
+          typename Kernel>
+void ConvertBlocks(const In *_in, Out *_out, const size_t _begin,
+                   const size_t _end, const Kernel &_kernel)
+{
+  constexpr size_t kIn = kBlockSize * InChannels;
+  constexpr size_t kOut = kBlockSize * OutChannels;
+  size_t i = _begin;
+  for (; i + kBlockSize <= _end; i += kBlockSize)
+  {
+    In in[kIn];
+    Out out[kOut];
+    std::copy_n(_in + i * InChannels, kIn, in);
+    _kernel(in, out);
+    std::copy_n(out, kOut, _out + i * OutChannels);
+  }
+
+  // The last pixels, with the rest of the block filled with zeros.
+  if (i < _end)
+  {
+    In in[kIn] = {};
+    Out out[kOut];
+    std::copy_n(_in + i * InChannels, (_end - i) * InChannels, in);
+    _kernel(in, out);
+    std::copy_n(out, (_end - i) * OutChannels, _out + i * OutChannels);
+  }
+}
+
+/// \brief Convert the pixels of a chunk of a buffer of three channels by
+/// blocks, as ConvertBlocks does, with the channels of each block stored
+/// in separate arrays.
+/// \param[in] _in Input buffer.
+/// \param[out] _out Output buffer.
+/// \param[in] _begin First pixel of the chunk.
+/// \param[in] _end Pixel after the last one of the chunk.
+/// \param[in] _kernel Function converting the three arrays of kBlockSize
+/// input values to three arrays of output values.
+template <typename Kernel>
+void ConvertPlanarBlocks(const float *_in, float *_out, const size_t _begin,
+                         const size_t _end, const Kernel &_kernel)
+{
+  ConvertBlocks<3, 3>(_in, _out, _begin, _end,
+      [&](const float *_pixels, float *_result)
+  {
+    float in[3][kBlockSize];
+    for (size_t k = 0; k < kBlockSize; ++k)
+    {
+      const float x = _pixels[3 * k];
+      const float y = _pixels[3 * k + 1];
+      const float z = _pixels[3 * k + 2];
+      in[0][k] = x;
+      in[1][k] = y;
+      in[2][k] = z;
+    }
+
+    float out[3][kBlockSize];
+    _kernel(in, out);
+
+    for (size_t k = 0; k < kBlockSize; ++k)
+    {
+      _result[3 * k] = out[0][k];
+      _result[3 * k + 1] = out[1][k];
+      _result[3 * k + 2] = out[2][k];
+    }
+  });
+}
+
+/// \brief Clamp red, green or blue values as Color::Clamp does.
+///
+/// The kernels of the buffer conversions are written as sequences of
+/// loops that either compute values or select between them. Floating
+/// point operations can trap, so the compiler doesn't vectorize a loop in
+/// which it has moved an operation into a branch of a selection.
+/// \param[in, out] _values The values.
+inline void ClampChannels(float (&_values)[kBlockSize])
+{
+  float scaled[kBlockSize];
+  for (size_t k = 0; k < kBlockSize; ++k)
+    _values[k] = std::max(0.0f, _values[k]);
+  for (size_t k = 0; k < kBlockSize; ++k)
+    scaled[k] = _values[k] / 255.0f;
+  for (size_t k = 0; k < kBlockSize; ++k)
+  {
+    const float value = _values[k];
+    const float divided = scaled[k];
+    _values[k] = value > 1 ? divided : value;
+  }
+}
+
 }  // namespace
 
 const Color &Color::White = gWhite;
@@ -364,6 +490,231 @@ void Color::SetFromABGR(const Color::ABGR _v)
   this->r = (val32 & 0xFF) / 255.0f;
 }
 
+//////////////////////////////////////////////////
+void Color::FromRGBA8(const uint8_t *_rgba8, float *_rgba, size_t _count,
+    unsigned int _threads)
+{
+  ForEachChunk(_count, _threads, [&](size_t _begin, size_t _end)
+  {
+    ConvertBlocks<4, 4>(_rgba8, _rgba, _begin, _end,
+        [](const uint8_t *_in, float *_out)
+    {
+      for (size_t k = 0; k < kBlockSize * 4; ++k)
+        _out[k] = _in[k] / 255.0f;
+    });
+  });
+}
+
+//////////////////////////////////////////////////
+void Color::ToRGBA8(const float *_rgba, uint8_t *_rgba8, size_t _count,
+    unsigned int _threads)
+{
+  ForEachChunk(_count, _threads, [&](size_t _begin, size_t _end)
+  {
+    ConvertBlocks<4, 4>(_rgba, _rgba8, _begin, _end,
+        [](const float *_in, uint8_t *_out)
+    {
+      // Scaling before clamping gives the same values, and keeps the
+      // compiler from moving the product into the branches of the clamp.
+      for (size_t k = 0; k < kBlockSize * 4; ++k)
+      {
+        const float value = std::min(std::max(0.0f, _in[k] * 255), 255.0f);
+        _out[k] = static_cast<uint8_t>(static_cast<int>(value));
+      }
+    });
+  });
+}
+
+//////////////////////////////////////////////////
+void Color::RGBToHSV(const float *_rgb, float *_hsv, size_t _count,
+    unsigned int _threads)
+{
+  ForEachChunk(_count, _threads, [&](size_t _begin, size_t _end)
+  {
+    ConvertPlanarBlocks(_rgb, _hsv, _begin, _end,
+        [](const float (&_in)[3][kBlockSize], float (&_out)[3][kBlockSize])
+    {
+      // Same as HSV(), with the branches replaced by selections of the
+      // operands of the divisions.
+      const float (&r)[kBlockSize] = _in[0];
+      const float (&g)[kBlockSize] = _in[1];
+      const float (&b)[kBlockSize] = _in[2];
+      float min[kBlockSize], max[kBlockSize], delta[kBlockSize];
+      float redMin[kBlockSize], greenMin[kBlockSize];
+      float gb[kBlockSize], br[kBlockSize], rg[kBlockSize];
+      for (size_t k = 0; k < kBlockSize; ++k)
+      {
+        const float red = r[k];
+        const float green = g[k];
+        const float blue = b[k];
+        min[k] = std::min(red, std::min(green, blue));
+        max[k] = std::max(red, std::max(green, blue));
+      }
+      for (size_t k = 0; k < kBlockSize; ++k)
+      {
+        delta[k] = max[k] - min[k];
+        redMin[k] = std::abs(r[k] - min[k]);
+        greenMin[k] = std::abs(g[k] - min[k]);
+        gb[k] = g[k] - b[k];
+        br[k] = b[k] - r[k];
+        rg[k] = r[k] - g[k];
+      }
+
+      float offset[kBlockSize], numerator[kBlockSize], divisor[kBlockSize];
+      float saturation[kBlockSize], value[kBlockSize];
+      for (size_t k = 0; k < kBlockSize; ++k)
+      {
+        const bool grey = std::abs(delta[k]) <= 1e-6f;
+        const bool isRedMin = redMin[k] <= 1e-6f;
+        const bool isGreenMin = greenMin[k] <= 1e-6f;
+        offset[k] = grey ? 0.0f : isRedMin ? 3.0f : isGreenMin ? 5.0f : 1.0f;
+        numerator[k] = grey ? 0.0f : isRedMin ? gb[k] :
+                       isGreenMin ? br[k] : rg[k];
+        divisor[k] = grey ? 1.0f : delta[k];
+        saturation[k] = grey ? 0.0f : delta[k];
+        value[k] = grey ? 1.0f : max[k];
+      }
+      for (size_t k = 0; k < kBlockSize; ++k)
+      {
+        _out[0][k] = (offset[k] - numerator[k] / divisor[k]) * 60.0f;
+        _out[1][k] = saturation[k] / value[k];
+        _out[2][k] = max[k];
+      }
+    });
+  });
+}
+
+//////////////////////////////////////////////////
+void Color::HSVToRGB(const float *_hsv, float *_rgb, size_t _count,
+    unsigned int _threads)
+{
+  ForEachChunk(_count, _threads, [&](size_t _begin, size_t _end)
+  {
+    ConvertPlanarBlocks(_hsv, _rgb, _begin, _end,
+        [](const float (&_in)[3][kBlockSize], float (&_out)[3][kBlockSize])
+    {
+      // Same as SetFromHSV(), with the sector selected per channel.
+      const float (&s)[kBlockSize] = _in[1];
+      const float (&v)[kBlockSize] = _in[2];
+      float hue[kBlockSize];
+      for (size_t k = 0; k < kBlockSize; ++k)
+        hue[k] = std::max(0.0f, _in[0][k]);
+
+      float sector[kBlockSize], saturation[kBlockSize], value[kBlockSize];
+      float p[kBlockSize], q[kBlockSize], t[kBlockSize];
+      for (size_t k = 0; k < kBlockSize; ++k)
+      {
+        saturation[k] = std::abs(s[k]);
+        value[k] = v[k];
+        const int degrees = static_cast<int>(hue[k]) % 360;
+        const float h = static_cast<float>(degrees) / 60;
+        sector[k] = static_cast<float>(static_cast<int>(h));
+        const float f = h - sector[k];
+        p[k] = v[k] * (1 - s[k]);
+        q[k] = v[k] * (1 - s[k] * f);
+        t[k] = v[k] * (1 - s[k] * (1 - f));
+      }
+
+      // The red, green and blue of each sector, from 0 to 5, are
+      // (v, t, p), (q, v, p), (p, v, t), (p, q, v), (t, p, v) and (v, p, q).
+      float red[kBlockSize], green[kBlockSize], blue[kBlockSize];
+      for (size_t k = 0; k < kBlockSize; ++k)
+      {
+        const float i = sector[k];
+        const float pk = p[k];
+        const float qk = q[k];
+        const float tk = t[k];
+        const float vk = v[k];
+        // The sector is a whole number, so each channel is selected from
+        // the last sector down with ordered comparisons.
+        float rk = vk;
+        rk = i < 5 ? tk : rk;
+        rk = i < 4 ? pk : rk;
+        rk = i < 2 ? qk : rk;
+        rk = i < 1 ? vk : rk;
+        float gk = pk;
+        gk = i < 4 ? qk : gk;
+        gk = i < 3 ? vk : gk;
+        gk = i < 1 ? tk : gk;
+        float bk = qk;
+        bk = i < 5 ? vk : bk;
+        bk = i < 3 ? tk : bk;
+        bk = i < 2 ? pk : bk;
+        red[k] = rk;
+        green[k] = gk;
+        blue[k] = bk;
+      }
+      ClampChannels(red);
+      ClampChannels(green);
+      ClampChannels(blue);
+
+      // Greys are set to the value, which SetFromHSV doesn't clamp.
+      for (size_t k = 0; k < kBlockSize; ++k)
+      {
+        const bool grey = saturation[k] <= 1e-6f;
+        const float vk = value[k];
+        _out[0][k] = grey ? vk : red[k];
+        _out[1][k] = grey ? vk : green[k];
+        _out[2][k] = grey ? vk : blue[k];
+      }
+    });
+  });
+}
+
+//////////////////////////////////////////////////
+void Color::RGBToYUV(const float *_rgb, float *_yuv, size_t _count,
+    unsigned int _threads)
+{
+  ForEachChunk(_count, _threads, [&](size_t _begin, size_t _end)
+  {
+    ConvertPlanarBlocks(_rgb, _yuv, _begin, _end,
+        [](const float (&_in)[3][kBlockSize], float (&_out)[3][kBlockSize])
+    {
+      for (size_t k = 0; k < kBlockSize; ++k)
+      {
+        const float r = _in[0][k];
+        const float g = _in[1][k];
+        const float b = _in[2][k];
+        _out[0][k] = 0.299f*r + 0.587f*g + 0.114f*b;
+        _out[1][k] = -0.1679f*r - 0.332f*g + 0.5f*b + 0.5f;
+        _out[2][k] = 0.5f*r - 0.4189f*g - 0.08105f*b + 0.5f;
+      }
+      for (int c = 0; c < 3; ++c)
+      {
+        for (size_t k = 0; k < kBlockSize; ++k)
+        {
+          const float value = _out[c][k] < 0 ? 0.0f : _out[c][k];
+          _out[c][k] = value > 255 ? 255.0f : value;
+        }
+      }
+    });
+  });
+}
+
+//////////////////////////////////////////////////
+void Color::YUVToRGB(const float *_yuv, float *_rgb, size_t _count,
+    unsigned int _threads)
+{
+  ForEachChunk(_count, _threads, [&](size_t _begin, size_t _end)
+  {
+    ConvertPlanarBlocks(_yuv, _rgb, _begin, _end,
+        [](const float (&_in)[3][kBlockSize], float (&_out)[3][kBlockSize])
+    {
+      for (size_t k = 0; k < kBlockSize; ++k)
+      {
+        const float y = _in[0][k];
+        const float u = _in[1][k];
+        const float v = _in[2][k];
+        _out[0][k] = y + 1.140f*v;
+        _out[1][k] = y - 0.395f*u - 0.581f*v;
+        _out[2][k] = y + 2.032f*u;
+      }
+      for (int c = 0; c < 3; ++c)
+        ClampChannels(_out[c]);
+    });
+  });
+}
+
 //////////////////////////////////////////////////
 Color Color::operator+(const Color &_pt) const
 {
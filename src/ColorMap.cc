@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "gz/math/ColorMap.hh"
+#include "gz/math/detail/ParallelFor.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+/// \brief Number of values the buffer mappings process at once.
+constexpr std::size_t kBlockSize = 64;
+
+/// \brief Smallest number of values mapped by each thread.
+constexpr std::size_t kMinChunkSize = 16384;
+
+/// \brief Run a function over contiguous chunks of a buffer, in parallel,
+/// as in Color.cc.
+/// \param[in] _count Number of values.
+/// \param[in] _threads Largest number of threads, zero for
+/// std::thread::hardware_concurrency.
+/// \param[in] _fn Function called with the first value of a chunk and the
+/// value after its last one.
+template <typename F>
+void ForEachChunk(const std::size_t _count, const unsigned int _threads,
+                  F &&_fn)
+{
+  if (_count == 0)
+    return;
+
+  detail::ParallelFor(_count,
+      detail::ChunkCount(_count, _threads, kMinChunkSize),
+      [&_fn](std::size_t, std::size_t _begin, std::size_t _end)
+  {
+    _fn(_begin, _end);
+  });
+}
+}
+
+/////////////////////////////////////////////////
+class gz::math::ColorMap::Implementation
+{
+  /// \brief Precompute the table from control points.
+  /// \param[in] _points Control points, sorted by value.
+  /// \param[in] _size Number of entries.
+  public: void Build(const std::vector<std::pair<double, Color>> &_points,
+                     const std::size_t _size)
+  {
+    this->min = _points.front().first;
+    this->max = _points.back().first;
+    this->table.resize(_size);
+    const double range = this->max - this->min;
+    const double lastIndex = static_cast<double>(_size - 1);
+    this->scale = range > 0 ? lastIndex / range : 0.0;
+    this->last = lastIndex;
+
+    for (std::size_t i = 0; i < _size; ++i)
+    {
+      const double value = i + 1 == _size ? this->max :
+        this->min + range * (static_cast<double>(i) / lastIndex);
+
+      // The last point at or before the value, and the next one.
+      auto next = std::upper_bound(_points.begin(), _points.end(), value,
+          [](const double _v, const std::pair<double, Color> &_p)
+          {
+            return _v < _p.first;
+          });
+      if (next == _points.end())
+      {
+        this->table[i] = _points.back().second.AsRGBA();
+        continue;
+      }
+      const auto &p0 = *(next == _points.begin() ? next : next - 1);
+      const auto &p1 = *next;
+      const double width = p1.first - p0.first;
+      const float t = width > 0 ?
+        static_cast<float>((value - p0.first) / width) : 0.0f;
+      const Color &c0 = p0.second;
+      const Color &c1 = p1.second;
+      this->table[i] = Color(
+          c0.R() + (c1.R() - c0.R()) * t,
+          c0.G() + (c1.G() - c0.G()) * t,
+          c0.B() + (c1.B() - c0.B()) * t,
+          c0.A() + (c1.A() - c0.A()) * t).AsRGBA();
+    }
+  }
+
+  /// \brief Index of the table entry of a value, clamped to the table.
+  /// \param[in] _value The value.
+  /// \return The index.
+  public: std::uint32_t Index(const double _value) const
+  {
+    // std::max is first so that NaN values give 0.
+    const double x = std::max(0.0, (_value - this->min) * this->scale + 0.5);
+    return static_cast<std::uint32_t>(std::min(x, this->last));
+  }
+
+  /// \brief Map a chunk of a buffer by blocks. The indices of a block are
+  /// computed in a local array, in a loop the compiler can vectorize, then
+  /// the colors are read from the table.
+  /// \param[in] _values Values.
+  /// \param[out] _colors Packed colors.
+  /// \param[in] _begin First value of the chunk.
+  /// \param[in] _end Value after the last one of the chunk.
+  public: template <typename T>
+  void MapBlocks(const T *_values, Color::RGBA *_colors,
+                 const std::size_t _begin, const std::size_t _end) const
+  {
+    const double offset = this->min;
+    const double factor = this->scale;
+    const double lastIndex = this->last;
+    const Color::RGBA *lookup = this->table.data();
+    for (std::size_t i = _begin; i < _end; i += kBlockSize)
+    {
+      const std::size_t n = std::min(kBlockSize, _end - i);
+      std::uint32_t indices[kBlockSize];
+      for (std::size_t k = 0; k < n; ++k)
+      {
+        const double x = std::max(0.0,
+            (static_cast<double>(_values[i + k]) - offset) * factor + 0.5);
+        indices[k] = static_cast<std::uint32_t>(std::min(x, lastIndex));
+      }
+      for (std::size_t k = 0; k < n; ++k)
+        _colors[i + k] = lookup[indices[k]];
+    }
+  }
+
+  /// \brief Map a buffer, in parallel.
+  /// \param[in] _values Values.
+  /// \param[out] _colors Packed colors.
+  /// \param[in] _count Number of values.
+  /// \param[in] _threads Largest number of threads.
+  public: template <typename T>
+  void MapBuffer(const T *_values, Color::RGBA *_colors,
+                 const std::size_t _count, const unsigned int _threads) const
+  {
+    ForEachChunk(_count, _threads,
+        [&](const std::size_t _begin, const std::size_t _end)
+        {
+          this->MapBlocks(_values, _colors, _begin, _end);
+        });
+  }
+
+  /// \brief Packed colors of the entries.
+  public: std::vector<Color::RGBA> table;
+
+  /// \brief Value of the first entry.
+  public: double min = 0.0;
+
+  /// \brief Value of the last entry.
+  public: double max = 1.0;
+
+  /// \brief Number of entries per unit of value.
+  public: double scale = 0.0;
+
+  /// \brief Index of the last entry.
+  public: double last = 0.0;
+};
+
+/////////////////////////////////////////////////
+ColorMap::ColorMap()
+  : ColorMap({{0.0, Color::Black}, {1.0, Color::White}})
+{
+}
+
+/////////////////////////////////////////////////
+ColorMap::ColorMap(const std::vector<std::pair<double, Color>> &_points,
+                   const std::size_t _size)
+  : dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+  std::vector<std::pair<double, Color>> points = _points;
+  if (points.empty())
+    points = {{0.0, Color::Black}, {1.0, Color::White}};
+  std::stable_sort(points.begin(), points.end(),
+      [](const std::pair<double, Color> &_a,
+         const std::pair<double, Color> &_b)
+      {
+        return _a.first < _b.first;
+      });
+  this->dataPtr->Build(points, std::max<std::size_t>(_size, 2));
+}
+
+/////////////////////////////////////////////////
+std::size_t ColorMap::Size() const
+{
+  return this->dataPtr->table.size();
+}
+
+/////////////////////////////////////////////////
+double ColorMap::Min() const
+{
+  return this->dataPtr->min;
+}
+
+/////////////////////////////////////////////////
+double ColorMap::Max() const
+{
+  return this->dataPtr->max;
+}
+
+/////////////////////////////////////////////////
+const std::vector<Color::RGBA> &ColorMap::Table() const
+{
+  return this->dataPtr->table;
+}
+
+/////////////////////////////////////////////////
+Color::RGBA ColorMap::Map(const double _value) const
+{
+  return this->dataPtr->table[this->dataPtr->Index(_value)];
+}
+
+/////////////////////////////////////////////////
+void ColorMap::Map(const float *_values, Color::RGBA *_colors,
+                   const std::size_t _count,
+                   const unsigned int _threads) const
+{
+  this->dataPtr->MapBuffer(_values, _colors, _count, _threads);
+}
+
+/////////////////////////////////////////////////
+void ColorMap::Map(const double *_values, Color::RGBA *_colors,
+                   const std::size_t _count,
+                   const unsigned int _threads) const
+{
+  this->dataPtr->MapBuffer(_values, _colors, _count, _threads);
+}
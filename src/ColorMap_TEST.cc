@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <vector>
+
+#include "gz/math/ColorMap.hh"
+#include "gz/math/Rand.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(ColorMapTest, Grayscale)
+{
+  const ColorMap map;
+  EXPECT_EQ(256u, map.Size());
+  EXPECT_DOUBLE_EQ(0.0, map.Min());
+  EXPECT_DOUBLE_EQ(1.0, map.Max());
+  ASSERT_EQ(256u, map.Table().size());
+  EXPECT_EQ(Color::Black.AsRGBA(), map.Table().front());
+  EXPECT_EQ(Color::White.AsRGBA(), map.Table().back());
+
+  EXPECT_EQ(Color::Black.AsRGBA(), map.Map(0.0));
+  EXPECT_EQ(Color::White.AsRGBA(), map.Map(1.0));
+  EXPECT_EQ(map.Table()[128], map.Map(0.5));
+
+  // Values out of the range are clamped, NaN gives the first color
+  EXPECT_EQ(Color::Black.AsRGBA(), map.Map(-3.0));
+  EXPECT_EQ(Color::White.AsRGBA(), map.Map(42.0));
+  EXPECT_EQ(Color::White.AsRGBA(),
+            map.Map(std::numeric_limits<double>::infinity()));
+  EXPECT_EQ(Color::Black.AsRGBA(),
+            map.Map(-std::numeric_limits<double>::infinity()));
+  EXPECT_EQ(Color::Black.AsRGBA(),
+            map.Map(std::numeric_limits<double>::quiet_NaN()));
+
+  // An empty list of points gives the default map
+  const ColorMap empty({}, 16);
+  EXPECT_EQ(16u, empty.Size());
+  EXPECT_EQ(Color::White.AsRGBA(), empty.Map(1.0));
+}
+
+/////////////////////////////////////////////////
+TEST(ColorMapTest, ControlPoints)
+{
+  // Unsorted points, interpolated linearly
+  const ColorMap map({{10.0, Color::Red}, {-10.0, Color::Blue},
+                      {0.0, Color(0, 1, 0, 0.5f)}}, 4096);
+  EXPECT_EQ(4096u, map.Size());
+  EXPECT_DOUBLE_EQ(-10.0, map.Min());
+  EXPECT_DOUBLE_EQ(10.0, map.Max());
+  EXPECT_EQ(Color::Blue.AsRGBA(), map.Map(-10.0));
+  EXPECT_EQ(Color::Red.AsRGBA(), map.Map(10.0));
+
+  for (double value = -10.0; value <= 10.0; value += 0.37)
+  {
+    const double t = value < 0 ? (value + 10.0) / 10.0 : value / 10.0;
+    const Color expected = value < 0 ?
+      Color(0, t, 1 - t, 1 - 0.5 * t) :
+      Color(t, 1 - t, 0, 0.5 + 0.5 * t);
+    Color mapped;
+    mapped.SetFromRGBA(map.Map(value));
+    EXPECT_NEAR(expected.R(), mapped.R(), 2.0 / 255) << value;
+    EXPECT_NEAR(expected.G(), mapped.G(), 2.0 / 255) << value;
+    EXPECT_NEAR(expected.B(), mapped.B(), 2.0 / 255) << value;
+    EXPECT_NEAR(expected.A(), mapped.A(), 2.0 / 255) << value;
+  }
+
+  // Two points with the same value give a sharp transition
+  const ColorMap steps({{0.0, Color::Black}, {0.5, Color::Black},
+                        {0.5, Color::White}, {1.0, Color::White}}, 101);
+  EXPECT_EQ(Color::Black.AsRGBA(), steps.Map(0.49));
+  EXPECT_EQ(Color::White.AsRGBA(), steps.Map(0.5));
+  EXPECT_EQ(Color::White.AsRGBA(), steps.Map(0.51));
+
+  // A single point, and a table of at least two entries
+  const ColorMap single({{3.0, Color::Yellow}}, 0);
+  EXPECT_EQ(2u, single.Size());
+  EXPECT_EQ(Color::Yellow.AsRGBA(), single.Map(-1.0));
+  EXPECT_EQ(Color::Yellow.AsRGBA(), single.Map(3.0));
+  EXPECT_EQ(Color::Yellow.AsRGBA(), single.Map(5.0));
+}
+
+/////////////////////////////////////////////////
+TEST(ColorMapTest, Buffers)
+{
+  const ColorMap map({{-2.0, Color::Blue}, {0.0, Color::White},
+                      {2.0, Color::Red}}, 4096);
+
+  Rand::Seed(42);
+  const std::size_t count = 40000 + 13;
+  std::vector<double> values(count);
+  Rand::FillNormal(values.data(), count);
+  values[5] = std::numeric_limits<double>::quiet_NaN();
+  values[6] = std::numeric_limits<double>::infinity();
+  values[7] = -1e300;
+  std::vector<float> floats(values.begin(), values.end());
+
+  for (unsigned int threads : {1u, 3u, 0u})
+  {
+    std::vector<Color::RGBA> colors(count, 0);
+    map.Map(values.data(), colors.data(), count, threads);
+    std::vector<Color::RGBA> floatColors(count, 0);
+    map.Map(floats.data(), floatColors.data(), count, threads);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      ASSERT_EQ(map.Map(values[i]), colors[i]) << i;
+      ASSERT_EQ(map.Map(static_cast<double>(floats[i])), floatColors[i])
+        << i;
+    }
+  }
+
+  // Empty buffers are accepted
+  map.Map(values.data(), nullptr, 0);
+}
@@ -17,6 +17,8 @@
 
 #include <gtest/gtest.h>
 #include <cmath>
+#include <cstdint>
+#include <vector>
 #include <gz/math/Color.hh>
 
 using namespace gz;
@@ -433,3 +435,91 @@ TEST(Color, HSV)
   EXPECT_NEAR(clr.B(), 0.3f, 1e-3);
   EXPECT_NEAR(clr.A(), 1.0, 1e-3);
 }
+
+/////////////////////////////////////////////////
+TEST(Color, BufferConversions)
+{
+  // Not a multiple of the block size, and large enough to use several
+  // threads.
+  for (size_t count : {0u, 5u, 37u, 40000u})
+  {
+    std::vector<uint8_t> rgba8(4 * count);
+    std::vector<float> rgb(3 * count);
+    std::vector<float> hsv(3 * count);
+    std::vector<float> yuv(3 * count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      for (size_t c = 0; c < 4; ++c)
+        rgba8[4 * i + c] = static_cast<uint8_t>((i * 7 + c * 61) % 256);
+
+      // Every tenth pixel is grey, and some values are out of range.
+      const float x = static_cast<float>(i % 97) / 96.0f;
+      hsv[3 * i] = static_cast<float>(i % 400) - 20.0f;
+      hsv[3 * i + 1] = i % 10 == 0 ? 0.0f : x;
+      hsv[3 * i + 2] = i % 13 == 0 ? 3.0f : 1.0f - x;
+      yuv[3 * i] = x;
+      yuv[3 * i + 1] = 1.0f - x;
+      yuv[3 * i + 2] = i % 7 == 0 ? -0.5f : 0.5f * x;
+    }
+
+    for (unsigned int threads : {1u, 0u, 3u})
+    {
+      std::vector<float> rgba(4 * count);
+      std::vector<uint8_t> bytes(4 * count);
+      math::Color::FromRGBA8(rgba8.data(), rgba.data(), count, threads);
+      math::Color::ToRGBA8(rgba.data(), bytes.data(), count, threads);
+      EXPECT_EQ(rgba8, bytes);
+
+      std::vector<float> fromHsv(3 * count);
+      std::vector<float> toHsv(3 * count);
+      std::vector<float> fromYuv(3 * count);
+      std::vector<float> toYuv(3 * count);
+      math::Color::HSVToRGB(hsv.data(), fromHsv.data(), count, threads);
+      math::Color::RGBToHSV(fromHsv.data(), toHsv.data(), count, threads);
+      math::Color::YUVToRGB(yuv.data(), fromYuv.data(), count, threads);
+      math::Color::RGBToYUV(fromYuv.data(), toYuv.data(), count, threads);
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        const uint8_t *p = &rgba8[4 * i];
+        math::Color clr;
+        clr.SetFromRGBA((static_cast<uint32_t>(p[0]) << 24) |
+                        (static_cast<uint32_t>(p[1]) << 16) |
+                        (static_cast<uint32_t>(p[2]) << 8) | p[3]);
+        EXPECT_FLOAT_EQ(clr.R(), rgba[4 * i]);
+        EXPECT_FLOAT_EQ(clr.G(), rgba[4 * i + 1]);
+        EXPECT_FLOAT_EQ(clr.B(), rgba[4 * i + 2]);
+        EXPECT_FLOAT_EQ(clr.A(), rgba[4 * i + 3]);
+
+        clr.SetFromHSV(hsv[3 * i], hsv[3 * i + 1], hsv[3 * i + 2]);
+        EXPECT_FLOAT_EQ(clr.R(), fromHsv[3 * i]);
+        EXPECT_FLOAT_EQ(clr.G(), fromHsv[3 * i + 1]);
+        EXPECT_FLOAT_EQ(clr.B(), fromHsv[3 * i + 2]);
+
+        const math::Vector3f h = clr.HSV();
+        EXPECT_FLOAT_EQ(h.X(), toHsv[3 * i]);
+        EXPECT_FLOAT_EQ(h.Y(), toHsv[3 * i + 1]);
+        EXPECT_FLOAT_EQ(h.Z(), toHsv[3 * i + 2]);
+
+        clr.SetFromYUV(yuv[3 * i], yuv[3 * i + 1], yuv[3 * i + 2]);
+        EXPECT_FLOAT_EQ(clr.R(), fromYuv[3 * i]);
+        EXPECT_FLOAT_EQ(clr.G(), fromYuv[3 * i + 1]);
+        EXPECT_FLOAT_EQ(clr.B(), fromYuv[3 * i + 2]);
+
+        const math::Vector3f y = clr.YUV();
+        EXPECT_FLOAT_EQ(y.X(), toYuv[3 * i]);
+        EXPECT_FLOAT_EQ(y.Y(), toYuv[3 * i + 1]);
+        EXPECT_FLOAT_EQ(y.Z(), toYuv[3 * i + 2]);
+      }
+    }
+  }
+
+  // Out of range values are clamped when converted to bytes
+  const float rgba[4] = {-1.0f, 2.0f, 0.5f, std::nanf("")};
+  uint8_t bytes[4];
+  math::Color::ToRGBA8(rgba, bytes, 1);
+  EXPECT_EQ(0u, bytes[0]);
+  EXPECT_EQ(255u, bytes[1]);
+  EXPECT_EQ(127u, bytes[2]);
+  EXPECT_EQ(0u, bytes[3]);
+}
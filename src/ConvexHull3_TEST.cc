@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "gz/math/ConvexHull3.hh"
+#include "gz/math/OrientedBox.hh"
+#include "gz/math/Pose3.hh"
+#include "gz/math/Quaternion.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/Vector3.hh"
+
+#include "test/helpers/RandomVector.hh"
+
+using namespace gz;
+using namespace math;
+using test::RandomVector;
+
+namespace
+{
+/// \brief Check that the hull is closed and its triangles face outside.
+void ExpectClosed(const ConvexHull3d &_hull)
+{
+  const auto &vertices = _hull.Vertices();
+  const auto &indices = _hull.Indices();
+  // Euler's formula for a triangulated sphere
+  EXPECT_EQ(2 * vertices.size() - 4, _hull.TriangleCount());
+  for (std::size_t t = 0; t < indices.size(); t += 3)
+  {
+    const Vector3d &a = vertices[indices[t]];
+    const Vector3d normal =
+      (vertices[indices[t + 1]] - a).Cross(vertices[indices[t + 2]] - a);
+    for (const Vector3d &v : vertices)
+      EXPECT_LE(normal.Dot(v - a), 1e-9) << t;
+  }
+}
+
+/// \brief Check that a box contains points, with a tolerance.
+void ExpectBoxContains(const OrientedBoxd &_box,
+                       const std::vector<Vector3d> &_points)
+{
+  const Vector3d half = _box.Size() / 2;
+  for (const Vector3d &p : _points)
+  {
+    const Vector3d local = _box.Pose().Rot().RotateVectorReverse(
+        p - _box.Pose().Pos());
+    for (int a = 0; a < 3; ++a)
+      EXPECT_LE(std::abs(local[a]), half[a] + 1e-9) << p;
+  }
+}
+}
+
+/////////////////////////////////////////////////
+TEST(ConvexHull3Test, Empty)
+{
+  ConvexHull3d hull;
+  EXPECT_TRUE(hull.Empty());
+  EXPECT_DOUBLE_EQ(0, hull.Volume());
+  EXPECT_FALSE(hull.Contains(Vector3d::Zero));
+  EXPECT_EQ(OrientedBoxd(), hull.MinimumVolumeBox());
+
+  // Too few points, and flat point sets
+  std::vector<Vector3d> points = {
+    Vector3d(0, 0, 0), Vector3d(1, 0, 0), Vector3d(0, 1, 0)};
+  EXPECT_FALSE(hull.Build(points.data(), points.size()));
+  points.push_back(Vector3d(1, 1, 0));
+  points.push_back(Vector3d(0.5, 0.2, 0));
+  EXPECT_FALSE(hull.Build(points.data(), points.size()));
+  EXPECT_TRUE(hull.Empty());
+  const std::vector<Vector3d> same(10, Vector3d(1, 2, 3));
+  EXPECT_FALSE(hull.Build(same.data(), same.size()));
+  const std::vector<Vector3d> line = {
+    Vector3d(0, 0, 0), Vector3d(1, 1, 1), Vector3d(2, 2, 2),
+    Vector3d(3, 3, 3)};
+  EXPECT_FALSE(hull.Build(line.data(), line.size()));
+}
+
+/////////////////////////////////////////////////
+TEST(ConvexHull3Test, Tetrahedron)
+{
+  const std::vector<Vector3d> points = {
+    Vector3d(0, 0, 0), Vector3d(1, 0, 0), Vector3d(0, 1, 0),
+    Vector3d(0, 0, 1), Vector3d(0.1, 0.1, 0.1)};
+  ConvexHull3d hull(points);
+  ASSERT_FALSE(hull.Empty());
+  EXPECT_EQ(4u, hull.Vertices().size());
+  EXPECT_EQ(4u, hull.TriangleCount());
+  EXPECT_DOUBLE_EQ(1.0 / 6, hull.Volume());
+  ExpectClosed(hull);
+
+  EXPECT_TRUE(hull.Contains(Vector3d(0.2, 0.2, 0.2)));
+  EXPECT_TRUE(hull.Contains(Vector3d(0, 0, 0)));
+  EXPECT_FALSE(hull.Contains(Vector3d(0.5, 0.5, 0.5)));
+  EXPECT_TRUE(hull.Contains(Vector3d(0.5, 0.5, 0.5), 0.3));
+
+  hull.Clear();
+  EXPECT_TRUE(hull.Empty());
+}
+
+/////////////////////////////////////////////////
+TEST(ConvexHull3Test, Cube)
+{
+  // Corners, face centers, and inner points of a cube, whose coplanar
+  // points are not vertices of the hull
+  std::vector<Vector3d> points;
+  for (int x = -1; x <= 1; ++x)
+  {
+    for (int y = -1; y <= 1; ++y)
+    {
+      for (int z = -1; z <= 1; ++z)
+        points.push_back(Vector3d(x, y, z));
+    }
+  }
+  ConvexHull3d hull(points);
+  EXPECT_EQ(8u, hull.Vertices().size());
+  EXPECT_EQ(12u, hull.TriangleCount());
+  EXPECT_DOUBLE_EQ(8, hull.Volume());
+  ExpectClosed(hull);
+  for (const Vector3d &p : points)
+    EXPECT_TRUE(hull.Contains(p, 1e-12)) << p;
+
+  const OrientedBoxd box = hull.MinimumVolumeBox();
+  EXPECT_NEAR(8, box.Volume(), 1e-9);
+  EXPECT_EQ(Vector3d::Zero, box.Pose().Pos());
+}
+
+/////////////////////////////////////////////////
+TEST(ConvexHull3Test, RandomPoints)
+{
+  Rand::Seed(3);
+  std::vector<Vector3d> points;
+  for (int i = 0; i < 2000; ++i)
+    points.push_back(RandomVector(-1, 1));
+  // Points on a sphere are all vertices
+  for (int i = 0; i < 200; ++i)
+    points.push_back(RandomVector(-1, 1).Normalized() * 3);
+
+  ConvexHull3d hull(points);
+  ASSERT_FALSE(hull.Empty());
+  EXPECT_EQ(200u, hull.Vertices().size());
+  ExpectClosed(hull);
+  for (const Vector3d &p : points)
+    EXPECT_TRUE(hull.Contains(p, 1e-9));
+  EXPECT_LT(hull.Volume(), 4.0 / 3 * GZ_PI * 27);
+  EXPECT_GT(hull.Volume(), 0.8 * 4.0 / 3 * GZ_PI * 27);
+}
+
+/////////////////////////////////////////////////
+TEST(ConvexHull3Test, Threads)
+{
+  Rand::Seed(5);
+  std::vector<Vector3d> points;
+  const std::size_t count = 4 * ConvexHull3d::kMinPointsPerThread;
+  for (std::size_t i = 0; i < count; ++i)
+    points.push_back(RandomVector(-1, 1) * Vector3d(1, 2, 3));
+
+  ConvexHull3d single;
+  ASSERT_TRUE(single.Build(points.data(), points.size(), 1));
+  ExpectClosed(single);
+  for (const unsigned int threads : {2u, 4u, 0u})
+  {
+    ConvexHull3d hull;
+    ASSERT_TRUE(hull.Build(points.data(), points.size(), threads));
+    EXPECT_EQ(single.Vertices().size(), hull.Vertices().size());
+    EXPECT_EQ(single.TriangleCount(), hull.TriangleCount());
+    EXPECT_NEAR(single.Volume(), hull.Volume(), 1e-9);
+  }
+
+  // A flat chunk keeps all its points
+  std::vector<Vector3d> flat(count, Vector3d::Zero);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    flat[i].Set(Rand::DblUniform(0, 1), Rand::DblUniform(0, 1),
+                i < count / 2 ? 0 : Rand::DblUniform(0, 1));
+  }
+  ConvexHull3d flatSingle;
+  ConvexHull3d flatThreads;
+  ASSERT_TRUE(flatSingle.Build(flat.data(), flat.size(), 1));
+  ASSERT_TRUE(flatThreads.Build(flat.data(), flat.size(), 2));
+  EXPECT_NEAR(flatSingle.Volume(), flatThreads.Volume(), 1e-9);
+}
+
+/////////////////////////////////////////////////
+TEST(ConvexHull3Test, MinimumVolumeBox)
+{
+  // Points in a rotated box, whose axis aligned box is larger
+  Rand::Seed(7);
+  const Pose3d pose(Vector3d(1, -2, 3), Quaterniond(0.3, -0.5, 0.9));
+  const Vector3d size(4, 1, 0.5);
+  std::vector<Vector3d> points;
+  for (int i = 0; i < 1000; ++i)
+  {
+    const Vector3d local = RandomVector(-0.5, 0.5) * size;
+    points.push_back(pose.Pos() + pose.Rot().RotateVector(local));
+  }
+  for (int x = -1; x <= 1; x += 2)
+  {
+    for (int y = -1; y <= 1; y += 2)
+    {
+      for (int z = -1; z <= 1; z += 2)
+      {
+        const Vector3d local = Vector3d(x, y, z) * size / 2;
+        points.push_back(pose.Pos() + pose.Rot().RotateVector(local));
+      }
+    }
+  }
+
+  ConvexHull3d hull(points);
+  EXPECT_NEAR(size.X() * size.Y() * size.Z(), hull.Volume(), 1e-9);
+
+  const OrientedBoxd box = hull.MinimumVolumeBox();
+  EXPECT_NEAR(2, box.Volume(), 1e-9);
+  EXPECT_TRUE(box.Pose().Pos().Equal(pose.Pos(), 1e-9));
+  ExpectBoxContains(box, points);
+
+  // Limiting the directions still tries the largest faces
+  const OrientedBoxd limited = hull.MinimumVolumeBox(2);
+  EXPECT_NEAR(2, limited.Volume(), 1e-9);
+
+  // Never larger than the axis aligned box
+  Rand::Seed(9);
+  points.clear();
+  for (int i = 0; i < 500; ++i)
+    points.push_back(RandomVector(-1, 1) * Vector3d(3, 2, 1));
+  hull.Build(points.data(), points.size());
+  Vector3d min = points[0];
+  Vector3d max = points[0];
+  for (const Vector3d &p : points)
+  {
+    min.Min(p);
+    max.Max(p);
+  }
+  const Vector3d extent = max - min;
+  const OrientedBoxd fitted = hull.MinimumVolumeBox(10);
+  EXPECT_LE(fitted.Volume(),
+            extent.X() * extent.Y() * extent.Z() * (1 + 1e-12));
+  EXPECT_GE(fitted.Volume(), hull.Volume());
+  ExpectBoxContains(fitted, points);
+}
+
+/////////////////////////////////////////////////
+TEST(ConvexHull3Test, Float)
+{
+  const std::vector<Vector3f> points = {
+    Vector3f(0, 0, 0), Vector3f(2, 0, 0), Vector3f(0, 2, 0),
+    Vector3f(2, 2, 0), Vector3f(0, 0, 2), Vector3f(2, 0, 2),
+    Vector3f(0, 2, 2), Vector3f(2, 2, 2), Vector3f(1, 1, 1)};
+  ConvexHull3f hull(points);
+  EXPECT_EQ(8u, hull.Vertices().size());
+  EXPECT_FLOAT_EQ(8, hull.Volume());
+  EXPECT_NEAR(8, hull.MinimumVolumeBox().Volume(), 1e-5);
+}
@@ -16,8 +16,11 @@
 */
 #include <gtest/gtest.h>
 #include <cmath>
+#include <vector>
 
 #include "gz/math/Cylinder.hh"
+#include "gz/math/Plane.hh"
+#include "gz/math/Pose3.hh"
 
 using namespace gz;
 
@@ -143,3 +146,98 @@ TEST(CylinderTest, Mass)
   EXPECT_EQ(expectedMassMat.DiagonalMoments(), massMatOpt->DiagonalMoments());
   EXPECT_DOUBLE_EQ(expectedMassMat.Mass(), massMatOpt->Mass());
 }
+
+//////////////////////////////////////////////////
+TEST(CylinderTest, VolumeBelow)
+{
+  const double l = 2.0;
+  const double r = 0.5;
+  math::Cylinderd cylinder(l, r);
+
+  // Fully below and fully above
+  math::Planed plane(math::Vector3d(0, 0, 1), 1.1);
+  EXPECT_DOUBLE_EQ(cylinder.Volume(), cylinder.VolumeBelow(plane));
+  EXPECT_EQ(math::Vector3d::Zero, cylinder.CenterOfVolumeBelow(plane));
+  plane = math::Planed(math::Vector3d(0, 0, 1), -1.1);
+  EXPECT_DOUBLE_EQ(0.0, cylinder.VolumeBelow(plane));
+  EXPECT_EQ(std::nullopt, cylinder.CenterOfVolumeBelow(plane));
+
+  // Plane perpendicular to the axis
+  plane = math::Planed(math::Vector3d(0, 0, 2), 1.0);
+  EXPECT_NEAR(GZ_PI * r * r * 1.5, cylinder.VolumeBelow(plane), 1e-9);
+  auto center = cylinder.CenterOfVolumeBelow(plane);
+  ASSERT_NE(std::nullopt, center);
+  EXPECT_NEAR(0.0, center->X(), 1e-9);
+  EXPECT_NEAR(0.0, center->Y(), 1e-9);
+  EXPECT_NEAR(-0.25, center->Z(), 1e-9);
+
+  // Plane parallel to the axis cuts a circular segment
+  const double h = 0.2;
+  const double area = r * r * std::acos(-h / r) + h * std::sqrt(r * r - h * h);
+  plane = math::Planed(math::Vector3d(1, 0, 0), h);
+  EXPECT_NEAR(area * l, cylinder.VolumeBelow(plane), 1e-9);
+  center = cylinder.CenterOfVolumeBelow(plane);
+  ASSERT_NE(std::nullopt, center);
+  EXPECT_NEAR(-2 * std::pow(r * r - h * h, 1.5) / (3 * area), center->X(),
+              1e-9);
+  EXPECT_NEAR(0.0, center->Y(), 1e-9);
+  EXPECT_NEAR(0.0, center->Z(), 1e-9);
+
+  // Any plane through the center cuts the cylinder in halves
+  plane = math::Planed(math::Vector3d(0.3, -0.5, 0.8), 0.0);
+  EXPECT_NEAR(cylinder.Volume() / 2, cylinder.VolumeBelow(plane), 1e-9);
+  center = cylinder.CenterOfVolumeBelow(plane);
+  ASSERT_NE(std::nullopt, center);
+  EXPECT_GT(0.0, plane.Distance(*center));
+
+  // The axis follows the rotational offset
+  cylinder.SetRotationalOffset(math::Quaterniond(0, GZ_PI_2, 0));
+  plane = math::Planed(math::Vector3d(1, 0, 0), 0.5);
+  EXPECT_NEAR(GZ_PI * r * r * 1.5, cylinder.VolumeBelow(plane), 1e-9);
+  center = cylinder.CenterOfVolumeBelow(plane);
+  ASSERT_NE(std::nullopt, center);
+  EXPECT_NEAR(-0.25, center->X(), 1e-9);
+  plane = math::Planed(math::Vector3d(0, 0, 1), 0.2);
+  EXPECT_NEAR(area * l, cylinder.VolumeBelow(plane), 1e-9);
+}
+
+//////////////////////////////////////////////////
+TEST(CylinderTest, VolumesBelow)
+{
+  std::vector<math::Cylinderd> cylinders;
+  std::vector<math::Pose3d> poses;
+  for (int i = 0; i < 20; ++i)
+  {
+    cylinders.push_back(math::Cylinderd(1.0 + 0.1 * i, 0.2 + 0.05 * i,
+        math::Quaterniond(0.1 * i, 0, 0)));
+    poses.push_back(math::Pose3d(0.1 * i, -0.2 * i, 0.05 * i - 0.5,
+                                 0.3 * i, 0.2 - 0.1 * i, 0.7 * i));
+  }
+  const math::Planed water(math::Vector3d(0, 0, 1), 0.1);
+
+  std::vector<double> volumes(cylinders.size());
+  std::vector<math::Vector3d> centers(cylinders.size());
+  math::Cylinderd::VolumesBelow(cylinders.data(), poses.data(),
+      cylinders.size(), water, volumes.data(), centers.data());
+
+  for (std::size_t i = 0; i < cylinders.size(); ++i)
+  {
+    const math::Pose3d &pose = poses[i];
+    const math::Planed plane(pose.Rot().RotateVectorReverse(water.Normal()),
+        water.Offset() - water.Normal().Dot(pose.Pos()));
+    EXPECT_DOUBLE_EQ(cylinders[i].VolumeBelow(plane), volumes[i]) << i;
+    const auto center = cylinders[i].CenterOfVolumeBelow(plane);
+    if (center)
+    {
+      EXPECT_EQ(pose.Rot().RotateVector(*center) + pose.Pos(), centers[i]);
+    }
+    else
+    {
+      EXPECT_TRUE(std::isnan(centers[i].X())) << i;
+    }
+  }
+
+  // Centers are optional
+  math::Cylinderd::VolumesBelow(cylinders.data(), poses.data(),
+      cylinders.size(), water, volumes.data(), nullptr);
+}
@@ -175,6 +175,13 @@ void DiffDriveOdometry::SetVelocityRollingWindowSize(size_t _size)
   this->dataPtr->angularMean.SetWindowSize(_size);
 }
 
+//////////////////////////////////////////////////
+void DiffDriveOdometry::ReserveVelocityRollingWindow(size_t _capacity)
+{
+  this->dataPtr->linearMean.Reserve(_capacity);
+  this->dataPtr->angularMean.Reserve(_capacity);
+}
+
 //////////////////////////////////////////////////
 const Angle &DiffDriveOdometry::Heading() const
 {
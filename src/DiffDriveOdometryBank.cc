@@ -0,0 +1,362 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <gz/math/DiffDriveOdometryBank.hh>
+#include <gz/math/Helpers.hh>
+
+using namespace gz::math;
+
+//////////////////////////////////////////////////
+class gz::math::DiffDriveOdometryBank::Implementation
+{
+  /// \brief Make the velocity windows hold the current number of robots,
+  /// keeping the values of the robots they already hold. The windows of
+  /// new robots are filled with zeros.
+  public: void ResizeWindows()
+  {
+    const size_t robots = this->x.size();
+    if (robots == this->windowRobots)
+      return;
+
+    std::vector<double> linear(this->windowSize * robots, 0.0);
+    std::vector<double> angular(this->windowSize * robots, 0.0);
+    const size_t kept = std::min(robots, this->windowRobots);
+    for (size_t slot = 0; slot < this->windowSize; ++slot)
+    {
+      std::copy_n(this->linearWindow.begin() + slot * this->windowRobots,
+                  kept, linear.begin() + slot * robots);
+      std::copy_n(this->angularWindow.begin() + slot * this->windowRobots,
+                  kept, angular.begin() + slot * robots);
+    }
+    this->linearWindow.swap(linear);
+    this->angularWindow.swap(angular);
+    this->linearSum.resize(robots, 0.0);
+    this->angularSum.resize(robots, 0.0);
+    this->windowRobots = robots;
+  }
+
+  /// \brief Clear the velocity windows.
+  public: void ClearWindows()
+  {
+    this->linearWindow.assign(this->windowSize * this->x.size(), 0.0);
+    this->angularWindow.assign(this->windowSize * this->x.size(), 0.0);
+    this->linearSum.assign(this->x.size(), 0.0);
+    this->angularSum.assign(this->x.size(), 0.0);
+    this->windowRobots = this->x.size();
+    this->head = 0;
+    this->count = 0;
+  }
+
+  /// \brief Push the velocities of all the robots into their windows and
+  /// update the means.
+  public: void PushVelocities(double _invDt)
+  {
+    this->ResizeWindows();
+    const size_t robots = this->x.size();
+    size_t slot = this->head + this->count;
+    const bool full = this->count == this->windowSize;
+    if (full)
+    {
+      slot = this->head;
+      this->head = (this->head + 1) % this->windowSize;
+    }
+    else
+    {
+      ++this->count;
+    }
+
+    // Values entering and leaving the windows, which are zero while the
+    // windows are filling up.
+    double *linearSlot = this->linearWindow.data() + slot * robots;
+    double *angularSlot = this->angularWindow.data() + slot * robots;
+    double *linearSums = this->linearSum.data();
+    double *angularSums = this->angularSum.data();
+    const double *linear = this->linearStep.data();
+    const double *angular = this->angularStep.data();
+    for (size_t i = 0; i < robots; ++i)
+    {
+      const double linearValue = linear[i] * _invDt;
+      const double angularValue = angular[i] * _invDt;
+      linearSums[i] += linearValue - linearSlot[i];
+      angularSums[i] += angularValue - angularSlot[i];
+      linearSlot[i] = linearValue;
+      angularSlot[i] = angularValue;
+    }
+
+    // Recompute the sums once per turn of the windows.
+    if (slot == this->windowSize - 1)
+    {
+      std::fill(this->linearSum.begin(), this->linearSum.end(), 0.0);
+      std::fill(this->angularSum.begin(), this->angularSum.end(), 0.0);
+      for (size_t s = 0; s < this->windowSize; ++s)
+      {
+        const double *linearRow = this->linearWindow.data() + s * robots;
+        const double *angularRow = this->angularWindow.data() + s * robots;
+        for (size_t i = 0; i < robots; ++i)
+        {
+          linearSums[i] += linearRow[i];
+          angularSums[i] += angularRow[i];
+        }
+      }
+    }
+
+    const double invCount = 1.0 / static_cast<double>(this->count);
+    double *linearMeans = this->linearVel.data();
+    double *angularMeans = this->angularVel.data();
+    for (size_t i = 0; i < robots; ++i)
+    {
+      linearMeans[i] = linearSums[i] * invCount;
+      angularMeans[i] = angularSums[i] * invCount;
+    }
+  }
+
+  /// \brief Current timestamp.
+  public: clock::time_point lastUpdateTime;
+
+  /// \brief Current x positions in meters.
+  public: std::vector<double> x;
+
+  /// \brief Current y positions in meters.
+  public: std::vector<double> y;
+
+  /// \brief Current headings in radians.
+  public: std::vector<double> heading;
+
+  /// \brief Current velocities in meter/second.
+  public: std::vector<double> linearVel;
+
+  /// \brief Current angular velocities in radians/second.
+  public: std::vector<double> angularVel;
+
+  /// \brief Left wheel radii in meters.
+  public: std::vector<double> leftWheelRadius;
+
+  /// \brief Right wheel radii in meters.
+  public: std::vector<double> rightWheelRadius;
+
+  /// \brief Wheel separations in meters.
+  public: std::vector<double> wheelSeparation;
+
+  /// \brief Previous left wheel positions in meters.
+  public: std::vector<double> leftWheelOldPos;
+
+  /// \brief Previous right wheel positions in meters.
+  public: std::vector<double> rightWheelOldPos;
+
+  /// \brief Distance travelled during the current update.
+  public: std::vector<double> linearStep;
+
+  /// \brief Heading change during the current update.
+  public: std::vector<double> angularStep;
+
+  /// \brief Linear velocity windows, one row of all the robots per slot.
+  public: std::vector<double> linearWindow;
+
+  /// \brief Angular velocity windows, one row of all the robots per slot.
+  public: std::vector<double> angularWindow;
+
+  /// \brief Sums of the linear velocity windows.
+  public: std::vector<double> linearSum;
+
+  /// \brief Sums of the angular velocity windows.
+  public: std::vector<double> angularSum;
+
+  /// \brief Number of slots of the windows.
+  public: size_t windowSize{10};
+
+  /// \brief Number of robots the windows hold.
+  public: size_t windowRobots{0};
+
+  /// \brief Slot of the oldest values of the windows.
+  public: size_t head{0};
+
+  /// \brief Number of values in the windows.
+  public: size_t count{0};
+
+  /// \brief Initialized flag.
+  public: bool initialized{false};
+};
+
+//////////////////////////////////////////////////
+DiffDriveOdometryBank::DiffDriveOdometryBank(size_t _windowSize)
+  : dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+  this->SetVelocityRollingWindowSize(_windowSize);
+}
+
+//////////////////////////////////////////////////
+size_t DiffDriveOdometryBank::Add(double _wheelSeparation,
+    double _leftWheelRadius, double _rightWheelRadius)
+{
+  auto &d = *this->dataPtr;
+  for (std::vector<double> *state : {&d.x, &d.y, &d.heading, &d.linearVel,
+       &d.angularVel, &d.leftWheelOldPos, &d.rightWheelOldPos,
+       &d.linearStep, &d.angularStep})
+  {
+    state->push_back(0.0);
+  }
+  d.wheelSeparation.push_back(_wheelSeparation);
+  d.leftWheelRadius.push_back(_leftWheelRadius);
+  d.rightWheelRadius.push_back(_rightWheelRadius);
+  return d.x.size() - 1;
+}
+
+//////////////////////////////////////////////////
+bool DiffDriveOdometryBank::SetWheelParams(size_t _index,
+    double _wheelSeparation, double _leftWheelRadius,
+    double _rightWheelRadius)
+{
+  auto &d = *this->dataPtr;
+  if (_index >= d.x.size())
+    return false;
+
+  d.wheelSeparation[_index] = _wheelSeparation;
+  d.leftWheelRadius[_index] = _leftWheelRadius;
+  d.rightWheelRadius[_index] = _rightWheelRadius;
+  return true;
+}
+
+//////////////////////////////////////////////////
+size_t DiffDriveOdometryBank::Size() const
+{
+  return this->dataPtr->x.size();
+}
+
+//////////////////////////////////////////////////
+void DiffDriveOdometryBank::Clear()
+{
+  const size_t windowSize = this->dataPtr->windowSize;
+  *this->dataPtr = Implementation();
+  this->dataPtr->windowSize = windowSize;
+}
+
+//////////////////////////////////////////////////
+void DiffDriveOdometryBank::SetVelocityRollingWindowSize(size_t _size)
+{
+  if (_size == 0)
+    return;
+  this->dataPtr->windowSize = _size;
+  this->dataPtr->ClearWindows();
+}
+
+//////////////////////////////////////////////////
+void DiffDriveOdometryBank::Init(const clock::time_point &_time)
+{
+  auto &d = *this->dataPtr;
+  for (std::vector<double> *state : {&d.x, &d.y, &d.heading, &d.linearVel,
+       &d.angularVel, &d.leftWheelOldPos, &d.rightWheelOldPos})
+  {
+    std::fill(state->begin(), state->end(), 0.0);
+  }
+  d.ClearWindows();
+  d.lastUpdateTime = _time;
+  d.initialized = true;
+}
+
+//////////////////////////////////////////////////
+bool DiffDriveOdometryBank::Initialized() const
+{
+  return this->dataPtr->initialized;
+}
+
+//////////////////////////////////////////////////
+bool DiffDriveOdometryBank::Update(const double *_leftPos,
+    const double *_rightPos, const clock::time_point &_time)
+{
+  auto &d = *this->dataPtr;
+  const size_t robots = d.x.size();
+  const std::chrono::duration<double> dt = _time - d.lastUpdateTime;
+
+  // Distance travelled and heading change of each robot.
+  const double *leftRadius = d.leftWheelRadius.data();
+  const double *rightRadius = d.rightWheelRadius.data();
+  const double *separation = d.wheelSeparation.data();
+  double *leftOld = d.leftWheelOldPos.data();
+  double *rightOld = d.rightWheelOldPos.data();
+  double *linear = d.linearStep.data();
+  double *angular = d.angularStep.data();
+  for (size_t i = 0; i < robots; ++i)
+  {
+    const double left = _leftPos[i] * leftRadius[i];
+    const double right = _rightPos[i] * rightRadius[i];
+    const double leftVel = left - leftOld[i];
+    const double rightVel = right - rightOld[i];
+    leftOld[i] = left;
+    rightOld[i] = right;
+    linear[i] = (rightVel + leftVel) * 0.5;
+    angular[i] = (rightVel - leftVel) / separation[i];
+  }
+
+  // Exact integration along an arc, which tends to the second order
+  // Runge-Kutta step of DiffDriveOdometry when the heading change is
+  // small.
+  double *x = d.x.data();
+  double *y = d.y.data();
+  double *heading = d.heading.data();
+  for (size_t i = 0; i < robots; ++i)
+  {
+    const double half = angular[i] * 0.5;
+    const double direction = heading[i] + half;
+    const double scale = std::fabs(angular[i]) < 1e-6 ?
+        linear[i] : linear[i] * std::sin(half) / half;
+    x[i] += scale * std::cos(direction);
+    y[i] += scale * std::sin(direction);
+    heading[i] += angular[i];
+  }
+
+  // We cannot estimate the speed if the time interval is zero (or near
+  // zero).
+  if (equal(0.0, dt.count()))
+    return false;
+
+  d.lastUpdateTime = _time;
+  d.PushVelocities(1.0 / dt.count());
+  return true;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &DiffDriveOdometryBank::Heading() const
+{
+  return this->dataPtr->heading;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &DiffDriveOdometryBank::X() const
+{
+  return this->dataPtr->x;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &DiffDriveOdometryBank::Y() const
+{
+  return this->dataPtr->y;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &DiffDriveOdometryBank::LinearVelocity() const
+{
+  return this->dataPtr->linearVel;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &DiffDriveOdometryBank::AngularVelocity() const
+{
+  return this->dataPtr->angularVel;
+}
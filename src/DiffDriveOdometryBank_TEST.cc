@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+#include "gz/math/DiffDriveOdometry.hh"
+#include "gz/math/DiffDriveOdometryBank.hh"
+#include "gz/math/Helpers.hh"
+#include "gz/math/Rand.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(DiffDriveOdometryBankTest, Robots)
+{
+  DiffDriveOdometryBank bank;
+  EXPECT_EQ(0u, bank.Size());
+  EXPECT_FALSE(bank.Initialized());
+
+  EXPECT_EQ(0u, bank.Add(2.0, 0.5, 0.5));
+  EXPECT_EQ(1u, bank.Add(1.0, 0.1, 0.2));
+  EXPECT_EQ(2u, bank.Size());
+  EXPECT_TRUE(bank.SetWheelParams(1, 2.0, 0.5, 0.5));
+  EXPECT_FALSE(bank.SetWheelParams(2, 2.0, 0.5, 0.5));
+
+  const auto startTime = std::chrono::steady_clock::now();
+  bank.Init(startTime);
+  EXPECT_TRUE(bank.Initialized());
+
+  // Same steps as DiffDriveOdometryTest
+  const double distPerDegree = 2 * GZ_PI * 0.5 / 360.0;
+  const std::vector<double> zero = {0.0, 0.0};
+  EXPECT_FALSE(bank.Update(zero.data(), zero.data(), startTime));
+
+  const std::vector<double> one = {GZ_DTOR(1.0), GZ_DTOR(1.0)};
+  EXPECT_TRUE(bank.Update(one.data(), one.data(),
+      startTime + std::chrono::milliseconds(100)));
+  for (size_t i = 0; i < 2; ++i)
+  {
+    EXPECT_DOUBLE_EQ(0.0, bank.Heading()[i]);
+    EXPECT_DOUBLE_EQ(distPerDegree, bank.X()[i]);
+    EXPECT_DOUBLE_EQ(0.0, bank.Y()[i]);
+    EXPECT_NEAR(distPerDegree / 0.1, bank.LinearVelocity()[i], 1e-3);
+    EXPECT_NEAR(0.0, bank.AngularVelocity()[i], 1e-3);
+  }
+
+  // Robot 0 keeps going straight, robot 1 turns left
+  const std::vector<double> left = {GZ_DTOR(2.0), GZ_DTOR(1.0)};
+  const std::vector<double> right = {GZ_DTOR(2.0), GZ_DTOR(2.0)};
+  EXPECT_TRUE(bank.Update(left.data(), right.data(),
+      startTime + std::chrono::milliseconds(200)));
+  EXPECT_DOUBLE_EQ(0.0, bank.Heading()[0]);
+  EXPECT_DOUBLE_EQ(distPerDegree * 2, bank.X()[0]);
+  EXPECT_GT(bank.Heading()[1], 0.0);
+  EXPECT_GT(bank.Y()[1], 0.0);
+
+  bank.Init(startTime);
+  EXPECT_DOUBLE_EQ(0.0, bank.X()[0]);
+  EXPECT_DOUBLE_EQ(0.0, bank.Heading()[1]);
+  EXPECT_DOUBLE_EQ(0.0, bank.LinearVelocity()[0]);
+
+  bank.Clear();
+  EXPECT_EQ(0u, bank.Size());
+  EXPECT_FALSE(bank.Initialized());
+}
+
+/////////////////////////////////////////////////
+TEST(DiffDriveOdometryBankTest, MatchesDiffDriveOdometry)
+{
+  Rand::Seed(7);
+  const size_t robots = 37;
+  const size_t windowSize = 4;
+  DiffDriveOdometryBank bank(windowSize);
+  std::vector<DiffDriveOdometry> odoms(robots,
+      DiffDriveOdometry(windowSize));
+  for (size_t i = 0; i < robots; ++i)
+  {
+    const double separation = Rand::DblUniform(0.3, 2.0);
+    const double leftRadius = Rand::DblUniform(0.05, 0.5);
+    const double rightRadius = Rand::DblUniform(0.05, 0.5);
+    bank.Add(separation, leftRadius, rightRadius);
+    odoms[i].SetWheelParams(separation, leftRadius, rightRadius);
+  }
+
+  auto time = std::chrono::steady_clock::now();
+  bank.Init(time);
+  for (auto &odom : odoms)
+    odom.Init(time);
+
+  std::vector<double> left(robots, 0.0);
+  std::vector<double> right(robots, 0.0);
+  for (int step = 0; step < 50; ++step)
+  {
+    // Some robots drive straight, and some steps take no time
+    for (size_t i = 0; i < robots; ++i)
+    {
+      left[i] += Rand::DblUniform(-0.2, 0.5);
+      right[i] = (i % 5 == 0) ? left[i] : right[i] +
+          Rand::DblUniform(-0.2, 0.5);
+    }
+    if (step % 9 != 4)
+      time += std::chrono::milliseconds(10 + step % 3);
+
+    const bool updated = bank.Update(left.data(), right.data(), time);
+    for (size_t i = 0; i < robots; ++i)
+    {
+      EXPECT_EQ(odoms[i].Update(left[i], right[i], time), updated);
+      EXPECT_NEAR(odoms[i].X(), bank.X()[i], 1e-9) << i;
+      EXPECT_NEAR(odoms[i].Y(), bank.Y()[i], 1e-9) << i;
+      EXPECT_NEAR(*odoms[i].Heading(), bank.Heading()[i], 1e-9) << i;
+      EXPECT_NEAR(odoms[i].LinearVelocity(), bank.LinearVelocity()[i],
+                  1e-9) << i;
+      EXPECT_NEAR(*odoms[i].AngularVelocity(), bank.AngularVelocity()[i],
+                  1e-9) << i;
+    }
+  }
+
+  // Changing the window size clears the windows
+  bank.SetVelocityRollingWindowSize(2);
+  time += std::chrono::milliseconds(10);
+  EXPECT_TRUE(bank.Update(left.data(), right.data(), time));
+  for (size_t i = 0; i < robots; ++i)
+  {
+    EXPECT_DOUBLE_EQ(0.0, bank.LinearVelocity()[i]);
+    EXPECT_DOUBLE_EQ(0.0, bank.AngularVelocity()[i]);
+  }
+
+  // A robot added later keeps the others' windows
+  const double linear = bank.LinearVelocity()[3];
+  bank.Add(1.0, 0.5, 0.5);
+  left.push_back(GZ_DTOR(10));
+  right.push_back(GZ_DTOR(10));
+  time += std::chrono::milliseconds(10);
+  EXPECT_TRUE(bank.Update(left.data(), right.data(), time));
+  EXPECT_DOUBLE_EQ(linear / 2, bank.LinearVelocity()[3]);
+  EXPECT_NEAR(GZ_DTOR(10) * 0.5 / 0.01 / 2, bank.LinearVelocity()[robots],
+              1e-9);
+}
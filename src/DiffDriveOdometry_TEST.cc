@@ -17,10 +17,13 @@
 
 #include <gtest/gtest.h>
 
+
 #include "gz/math/Angle.hh"
 #include "gz/math/Helpers.hh"
 #include "gz/math/DiffDriveOdometry.hh"
 
+#include "test/performance/AllocationCounter.hh"
+
 using namespace gz;
 
 /////////////////////////////////////////////////
@@ -128,3 +131,28 @@ TEST(DiffDriveOdometryTest, DiffDriveOdometry)
       ((xDistTraveled - yDistTraveled) / wheelSeparation) / 0.1,
       *odom.AngularVelocity(), 1e-3);
 }
+
+/////////////////////////////////////////////////
+TEST(DiffDriveOdometryTest, NoAllocation)
+{
+  math::DiffDriveOdometry odom(4);
+  odom.SetWheelParams(2.0, 0.5, 0.5);
+  odom.ReserveVelocityRollingWindow(100);
+  auto time = std::chrono::steady_clock::now();
+  odom.Init(time);
+
+  const benchmark::AllocationCounter counter;
+  for (int i = 1; i <= 1000; ++i)
+  {
+    time += std::chrono::milliseconds(1);
+    EXPECT_TRUE(odom.Update(GZ_DTOR(i), GZ_DTOR(2 * i), time));
+    if (i % 100 == 0)
+      odom.SetVelocityRollingWindowSize(i / 10);
+  }
+  odom.Init(time);
+  EXPECT_EQ(0u, counter.Count());
+
+  // Windows larger than the capacity are allocated
+  odom.SetVelocityRollingWindowSize(101);
+  EXPECT_LT(0u, counter.Count());
+}
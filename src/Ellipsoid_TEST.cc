@@ -16,9 +16,13 @@
 */
 #include <gtest/gtest.h>
 #include <cmath>
+#include <vector>
 
 #include "gz/math/Ellipsoid.hh"
 #include "gz/math/Helpers.hh"
+#include "gz/math/Plane.hh"
+#include "gz/math/Pose3.hh"
+#include "gz/math/Sphere.hh"
 #include "gz/math/Vector3.hh"
 
 using namespace gz;
@@ -144,3 +148,84 @@ TEST(EllipsoidTest, Mass)
   const math::Ellipsoidd ellipsoid5(math::Vector3d(-1, -1, 1));
   EXPECT_EQ(std::nullopt, ellipsoid5.MassMatrix());
 }
+
+//////////////////////////////////////////////////
+TEST(EllipsoidTest, VolumeBelow)
+{
+  const math::Ellipsoidd ellipsoid(math::Vector3d(1, 2, 3));
+
+  // Fully below and fully above
+  math::Planed plane(math::Vector3d(0, 0, 1), 3.1);
+  EXPECT_DOUBLE_EQ(ellipsoid.Volume(), ellipsoid.VolumeBelow(plane));
+  EXPECT_EQ(math::Vector3d::Zero, ellipsoid.CenterOfVolumeBelow(plane));
+  plane = math::Planed(math::Vector3d(0, 0, 1), -3.1);
+  EXPECT_DOUBLE_EQ(0.0, ellipsoid.VolumeBelow(plane));
+  EXPECT_EQ(std::nullopt, ellipsoid.CenterOfVolumeBelow(plane));
+
+  // Any plane through the center cuts the ellipsoid in halves
+  plane = math::Planed(math::Vector3d(0.3, -0.5, 0.8), 0.0);
+  EXPECT_NEAR(ellipsoid.Volume() / 2, ellipsoid.VolumeBelow(plane), 1e-9);
+  auto center = ellipsoid.CenterOfVolumeBelow(plane);
+  ASSERT_NE(std::nullopt, center);
+  EXPECT_GT(0.0, plane.Distance(*center));
+
+  // Plane perpendicular to an axis cuts a cap of height 1.5, which is the
+  // cap of height 0.5 of a unit sphere scaled by the radii.
+  plane = math::Planed(math::Vector3d(0, 0, -2), -3.0);
+  EXPECT_NEAR(GZ_PI * 0.5 * 0.5 * 2.5 / 3 * 6,
+              ellipsoid.VolumeBelow(plane), 1e-9);
+  center = ellipsoid.CenterOfVolumeBelow(plane);
+  ASSERT_NE(std::nullopt, center);
+  EXPECT_NEAR(0.0, center->X(), 1e-9);
+  EXPECT_NEAR(0.0, center->Y(), 1e-9);
+  EXPECT_NEAR(3 * 1.5 * 1.5 / (4 * 2.5) * 3, center->Z(), 1e-9);
+
+  // With equal radii it is a sphere
+  const math::Ellipsoidd ball(math::Vector3d(2, 2, 2));
+  const math::Sphered sphere(2);
+  for (const double offset : {-1.5, -0.2, 0.7, 1.9})
+  {
+    plane = math::Planed(math::Vector3d(0.3, -0.5, 0.8).Normalize(), offset);
+    EXPECT_NEAR(sphere.VolumeBelow(plane), ball.VolumeBelow(plane), 1e-9);
+    center = ball.CenterOfVolumeBelow(plane);
+    ASSERT_NE(std::nullopt, center);
+    EXPECT_LT((*sphere.CenterOfVolumeBelow(plane) - *center).Length(), 1e-9);
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(EllipsoidTest, VolumesBelow)
+{
+  std::vector<math::Ellipsoidd> ellipsoids;
+  std::vector<math::Pose3d> poses;
+  for (int i = 0; i < 20; ++i)
+  {
+    ellipsoids.push_back(math::Ellipsoidd(
+        math::Vector3d(0.5 + 0.1 * i, 0.2 + 0.05 * i, 1.0)));
+    poses.push_back(math::Pose3d(0.1 * i, -0.2 * i, 0.05 * i - 0.5,
+                                 0.3 * i, 0.2 - 0.1 * i, 0.7 * i));
+  }
+  const math::Planed water(math::Vector3d(0, 0, 1), 0.1);
+
+  std::vector<double> volumes(ellipsoids.size());
+  std::vector<math::Vector3d> centers(ellipsoids.size());
+  math::Ellipsoidd::VolumesBelow(ellipsoids.data(), poses.data(),
+      ellipsoids.size(), water, volumes.data(), centers.data());
+
+  for (std::size_t i = 0; i < ellipsoids.size(); ++i)
+  {
+    const math::Pose3d &pose = poses[i];
+    const math::Planed plane(pose.Rot().RotateVectorReverse(water.Normal()),
+        water.Offset() - water.Normal().Dot(pose.Pos()));
+    EXPECT_DOUBLE_EQ(ellipsoids[i].VolumeBelow(plane), volumes[i]) << i;
+    const auto center = ellipsoids[i].CenterOfVolumeBelow(plane);
+    if (center)
+    {
+      EXPECT_EQ(pose.Rot().RotateVector(*center) + pose.Pos(), centers[i]);
+    }
+    else
+    {
+      EXPECT_TRUE(std::isnan(centers[i].X())) << i;
+    }
+  }
+}
@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <vector>
+
 #include "gz/math/Filter.hh"
 
 using namespace gz;
@@ -103,3 +106,120 @@ TEST(FilterTest, BiquadVector3)
   EXPECT_EQ(filterB.Process(math::Vector3d(0.1, 20.3, 33.45)),
             math::Vector3d(0.031748, 6.44475, 10.6196));
 }
+
+/////////////////////////////////////////////////
+TEST(FilterTest, OnePoleBank)
+{
+  math::OnePoleBank<double> empty;
+  EXPECT_EQ(0u, empty.Channels());
+  empty.Process(nullptr, nullptr, 10);
+
+  // A number of channels that is not a multiple of the block size
+  const size_t channels = 11;
+  const size_t frames = 50;
+  math::OnePoleBank<double> bank(channels);
+  EXPECT_EQ(channels, bank.Channels());
+  std::vector<math::OnePole<double>> filters(channels);
+  for (size_t c = 0; c < channels; ++c)
+  {
+    bank.Fc(c, 0.05 + 0.02 * c, 1.0);
+    filters[c].Fc(0.05 + 0.02 * c, 1.0);
+  }
+  bank.Set(2, 1.5);
+  filters[2].Set(1.5);
+  EXPECT_DOUBLE_EQ(1.5, bank.Value(2));
+
+  std::vector<double> in(channels * frames);
+  for (size_t i = 0; i < in.size(); ++i)
+    in[i] = std::sin(0.1 * i);
+  std::vector<double> out(in.size());
+
+  // Two blocks, the second in place
+  bank.Process(in.data(), out.data(), frames / 2);
+  std::copy(in.begin() + channels * frames / 2, in.end(),
+            out.begin() + channels * frames / 2);
+  bank.Process(out.data() + channels * frames / 2,
+               out.data() + channels * frames / 2, frames - frames / 2);
+  for (size_t f = 0; f < frames; ++f)
+  {
+    for (size_t c = 0; c < channels; ++c)
+    {
+      EXPECT_DOUBLE_EQ(filters[c].Process(in[f * channels + c]),
+                       out[f * channels + c]) << f << " " << c;
+    }
+  }
+  for (size_t c = 0; c < channels; ++c)
+    EXPECT_DOUBLE_EQ(filters[c].Value(), bank.Value(c));
+
+  bank.Set(0.0);
+  EXPECT_DOUBLE_EQ(0.0, bank.Value(2));
+}
+
+/////////////////////////////////////////////////
+TEST(FilterTest, BiQuadBank)
+{
+  math::BiQuadBank<double> empty;
+  EXPECT_EQ(0u, empty.Channels());
+  EXPECT_EQ(0u, empty.Sections());
+  empty.Process(nullptr, nullptr, 10);
+
+  // Two sections, matching two bi-quad filters in series
+  const size_t channels = 19;
+  const size_t frames = 40;
+  math::BiQuadBank<double> bank(channels, 2);
+  EXPECT_EQ(channels, bank.Channels());
+  EXPECT_EQ(2u, bank.Sections());
+  std::vector<math::BiQuad<double>> first(channels);
+  std::vector<math::BiQuad<double>> second(channels);
+  bank.Fc(0.1, 1.0);
+  for (size_t c = 0; c < channels; ++c)
+  {
+    first[c].Fc(0.1, 1.0);
+    second[c].Fc(0.1, 1.0);
+  }
+  bank.Fc(3, 1, 0.2, 1.0, 0.54);
+  second[3].Fc(0.2, 1.0, 0.54);
+  bank.Set(4, 2.0);
+  first[4].Set(2.0);
+  second[4].Set(2.0);
+  EXPECT_DOUBLE_EQ(2.0, bank.Value(4));
+
+  std::vector<double> in(channels * frames);
+  for (size_t i = 0; i < in.size(); ++i)
+    in[i] = std::cos(0.37 * i) + 0.1 * (i % 3);
+  std::vector<double> out(in.size());
+  bank.Process(in.data(), out.data(), frames);
+  for (size_t f = 0; f < frames; ++f)
+  {
+    for (size_t c = 0; c < channels; ++c)
+    {
+      const double expected =
+        second[c].Process(first[c].Process(in[f * channels + c]));
+      EXPECT_DOUBLE_EQ(expected, out[f * channels + c]) << f << " " << c;
+    }
+  }
+  for (size_t c = 0; c < channels; ++c)
+    EXPECT_DOUBLE_EQ(second[c].Value(), bank.Value(c));
+
+  // Single precision, in place
+  math::BiQuadBank<float> floatBank(channels);
+  floatBank.Fc(0.1, 1.0);
+  math::BiQuad<double> filter(0.1, 1.0);
+  std::vector<float> samples(channels * frames);
+  for (size_t i = 0; i < samples.size(); ++i)
+    samples[i] = static_cast<float>(in[i]);
+  floatBank.Process(samples.data(), samples.data(), frames);
+  for (size_t f = 0; f < frames; ++f)
+  {
+    EXPECT_NEAR(filter.Process(static_cast<float>(in[f * channels])),
+                samples[f * channels], 1e-5);
+  }
+
+  // Direct coefficients
+  math::BiQuadBank<double> gain(1);
+  gain.Coefficients(0, 0, 2.0, 0.0, 0.0, 0.0, 0.0);
+  double sample = 1.5;
+  gain.Process(&sample, &sample, 1);
+  EXPECT_DOUBLE_EQ(3.0, sample);
+  EXPECT_DOUBLE_EQ(3.0, gain.Value(0));
+}
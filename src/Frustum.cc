@@ -16,15 +16,19 @@
 */
 #include <cmath>
 
+#include <algorithm>
 #include <array>
 #include <utility>
+#include <vector>
 
 #include "gz/math/Angle.hh"
 #include "gz/math/AxisAlignedBox.hh"
 #include "gz/math/Frustum.hh"
+#include "gz/math/Matrix3.hh"
 #include "gz/math/Matrix4.hh"
 #include "gz/math/Plane.hh"
 #include "gz/math/Pose3.hh"
+#include "gz/math/detail/ParallelFor.hh"
 
 using namespace gz;
 using namespace math;
@@ -55,17 +59,53 @@ class Frustum::Implementation
   /// Pose of the frustum, which is the vertex (top of the pyramid).
   public: math::Pose3d pose {Pose3d::Zero};
 
+  /// \brief Move the planes and corners computed in the frame of
+  /// the frustum to the world frame.
+  public: void UpdatePose();
+
+  /// \brief Each plane of the frustum in the frame of the frustum.
+  /// \sa Frustum::FrustumPlane
+  public: std::array<Planed, 6> localPlanes;
+
+  /// \brief Each corner of the frustum in the frame of the frustum.
+  public: std::array<Vector3d, 8> localPoints;
+
   /// \brief Each plane of the frustum.
   /// \sa Frustum::FrustumPlane
   public: std::array<Planed, 6> planes;
 
   /// \brief Each corner of the frustum.
   public: std::array<Vector3d, 8> points;
-
-  /// \brief each edge of the frustum.
-  public: std::array<std::pair<Vector3d, Vector3d>, 12> edges;
 };
 
+namespace
+{
+  /// \brief Each edge of the frustum, as the indices of its corners in
+  /// Frustum::Implementation::points.
+  constexpr std::array<std::pair<int, int>, 12> kEdges = {{
+    {0, 1}, {0, 2}, {0, 4}, {1, 3}, {1, 5}, {2, 3},
+    {2, 6}, {4, 5}, {4, 6}, {5, 7}, {6, 7}, {7, 3}}};
+}
+
+/////////////////////////////////////////////////
+void Frustum::Implementation::UpdatePose()
+{
+  // One rotation matrix is cheaper than rotating 14 vectors by the
+  // quaternion
+  const Matrix3d rot(this->pose.Rot());
+  const Vector3d &pos = this->pose.Pos();
+
+  for (std::size_t i = 0; i < this->planes.size(); ++i)
+  {
+    const Vector3d normal = rot * this->localPlanes[i].Normal();
+    this->planes[i].Set(normal,
+        this->localPlanes[i].Offset() + normal.Dot(pos));
+  }
+
+  for (std::size_t i = 0; i < this->points.size(); ++i)
+    this->points[i] = rot * this->localPoints[i] + pos;
+}
+
 /////////////////////////////////////////////////
 Frustum::Frustum()
   : dataPtr(gz::utils::MakeImpl<Implementation>())
@@ -92,12 +132,108 @@ Frustum::Frustum(double _near,
   this->ComputePlanes();
 }
 
+/////////////////////////////////////////////////
+Frustum::Frustum(const Matrix4d &_projectionView)
+  : Frustum()
+{
+  this->Set(_projectionView);
+}
+
+/////////////////////////////////////////////////
+void Frustum::Set(double _near,
+                  double _far,
+                  const Angle &_fov,
+                  double _aspectRatio,
+                  const Pose3d &_pose)
+{
+  this->dataPtr->near = _near;
+  this->dataPtr->far = _far;
+  this->dataPtr->fov = _fov;
+  this->dataPtr->aspectRatio = _aspectRatio;
+  this->dataPtr->pose = _pose;
+  this->ComputePlanes();
+}
+
+/////////////////////////////////////////////////
+bool Frustum::Set(const Matrix4d &_projectionView)
+{
+  const double det = _projectionView.Determinant();
+  if (!std::isfinite(det) || std::abs(det) < 1e-12)
+    return false;
+
+  // Corners of the frustum, from the corners of the clip space cube. Index
+  // bit 2 selects the far plane, bit 1 the top and bit 0 the right side.
+  const Matrix4d inv = _projectionView.Inverse();
+  std::array<Vector3d, 8> corners;
+  for (int c = 0; c < 8; ++c)
+  {
+    const double ndc[3] = {(c & 1) ? 1.0 : -1.0, (c & 2) ? 1.0 : -1.0,
+                           (c & 4) ? 1.0 : -1.0};
+    double v[4];
+    for (int r = 0; r < 4; ++r)
+    {
+      v[r] = inv(r, 0) * ndc[0] + inv(r, 1) * ndc[1] + inv(r, 2) * ndc[2] +
+             inv(r, 3);
+    }
+    if (!(std::abs(v[3]) > 1e-12))
+      return false;
+    corners[c].Set(v[0] / v[3], v[1] / v[3], v[2] / v[3]);
+  }
+
+  const Vector3d nearCenter =
+    (corners[0] + corners[1] + corners[2] + corners[3]) / 4.0;
+  const Vector3d farCenter =
+    (corners[4] + corners[5] + corners[6] + corners[7]) / 4.0;
+  const double nearWidth = corners[0].Distance(corners[1]);
+  const double nearHeight = corners[0].Distance(corners[2]);
+  const double farWidth = corners[4].Distance(corners[5]);
+  const double depth = nearCenter.Distance(farCenter);
+
+  // The near and far planes of a perspective projection are similar
+  // rectangles, whose sizes give the distance to the vertex
+  if (!(nearWidth > 0) || !(nearHeight > 0) || !(depth > 0) ||
+      !(farWidth > nearWidth) || !std::isfinite(farWidth))
+  {
+    return false;
+  }
+  const double nearDist = depth * nearWidth / (farWidth - nearWidth);
+
+  // Frame of the frustum: X forward, Y left and Z up
+  const Vector3d forward = (farCenter - nearCenter) / depth;
+  Vector3d right = corners[1] - corners[0];
+  right = (right - forward * forward.Dot(right)).Normalized();
+  const Vector3d up = right.Cross(forward);
+  const Vector3d left = up.Cross(forward);
+  const Matrix3d rot(forward.X(), left.X(), up.X(),
+                     forward.Y(), left.Y(), up.Y(),
+                     forward.Z(), left.Z(), up.Z());
+
+  this->Set(nearDist, nearDist + depth,
+            Angle(2.0 * std::atan(nearWidth * 0.5 / nearDist)),
+            nearWidth / nearHeight,
+            Pose3d(nearCenter - forward * nearDist, Quaterniond(rot)));
+  return true;
+}
+
 /////////////////////////////////////////////////
 Planed Frustum::Plane(const FrustumPlane _plane) const
 {
   return this->dataPtr->planes[_plane];
 }
 
+/////////////////////////////////////////////////
+AxisAlignedBox Frustum::Bounds() const
+{
+  Vector3d min = this->dataPtr->points[0];
+  Vector3d max = min;
+  for (const auto &pt : this->dataPtr->points)
+  {
+    min.Min(pt);
+    max.Max(pt);
+  }
+  return AxisAlignedBox(min, max);
+}
+
 /////////////////////////////////////////////////
 bool Frustum::Contains(const AxisAlignedBox &_b) const
 {
@@ -136,36 +272,39 @@ bool Frustum::Contains(const AxisAlignedBox &_b) const
     }
 
     // Return true if any edge of the frustum passes through the AABB
-    for (const auto &edge : this->dataPtr->edges)
+    for (const auto &indices : kEdges)
     {
+      const Vector3d &first = this->dataPtr->points[indices.first];
+      const Vector3d &second = this->dataPtr->points[indices.second];
+
       // If the edge projected onto a world axis does not overlapp with the AABB
       // then the edge could not be passing through the AABB.
-      if (edge.first.X() < min.X() && edge.second.X() < min.X())
+      if (first.X() < min.X() && second.X() < min.X())
       {
         // both frustum edge points are below AABB on x axis
         continue;
       }
-      else if (edge.first.X() > max.X() && edge.second.X() > max.X())
+      else if (first.X() > max.X() && second.X() > max.X())
       {
         // both frustum edge points are above AABB on x axis
         continue;
       }
-      else if (edge.first.Y() < min.Y() && edge.second.Y() < min.Y())
+      else if (first.Y() < min.Y() && second.Y() < min.Y())
       {
         // both frustum edge points are below AABB on y axis
         continue;
       }
-      else if (edge.first.Y() > max.Y() && edge.second.Y() > max.Y())
+      else if (first.Y() > max.Y() && second.Y() > max.Y())
       {
         // both frustum edge points are above AABB on y axis
         continue;
       }
-      else if (edge.first.Z() < min.Z() && edge.second.Z() < min.Z())
+      else if (first.Z() < min.Z() && second.Z() < min.Z())
       {
         // both frustum edge points are below AABB on z axis
         continue;
       }
-      else if (edge.first.Z() > max.Z() && edge.second.Z() > max.Z())
+      else if (first.Z() > max.Z() && second.Z() > max.Z())
       {
         // both frustum edge points are above AABB on z axis
         continue;
@@ -182,6 +321,182 @@ bool Frustum::Contains(const AxisAlignedBox &_b) const
   return true;
 }
 
+namespace
+{
+  /// \brief Number of boxes tested together by the batch Contains
+  /// functions.
+  constexpr std::size_t kBoxBlockSize = 256;
+
+  /// \brief Smallest number of blocks of boxes tested by each thread of
+  /// Visibility.
+  constexpr std::size_t kMinChunkBlocks = 16;
+
+  /// \brief Centers and half sizes of a block of boxes, one array per
+  /// component.
+  struct BoxBlock
+  {
+    /// \brief Load a block of boxes.
+    /// \param[in] _boxes First box of the block.
+    /// \param[in] _count Number of boxes, at most kBoxBlockSize.
+    void Load(const AxisAlignedBox *_boxes, const std::size_t _count)
+    {
+      this->count = _count;
+      for (std::size_t i = 0; i < _count; ++i)
+      {
+        // Same quantities as Plane::Side(const AxisAlignedBox &)
+        const Vector3d center = _boxes[i].Center();
+        const Vector3d half = _boxes[i].Size() / 2.0;
+        this->cx[i] = center.X();
+        this->cy[i] = center.Y();
+        this->cz[i] = center.Z();
+        this->ex[i] = half.X();
+        this->ey[i] = half.Y();
+        this->ez[i] = half.Z();
+      }
+    }
+
+    std::size_t count = 0;
+    double cx[kBoxBlockSize];
+    double cy[kBoxBlockSize];
+    double cz[kBoxBlockSize];
+    double ex[kBoxBlockSize];
+    double ey[kBoxBlockSize];
+    double ez[kBoxBlockSize];
+  };
+
+  /// \brief Test a block of boxes against a frustum.
+  /// \param[in] _frustum The frustum.
+  /// \param[in] _block Centers and half sizes of the boxes.
+  /// \param[in] _boxes The boxes, used for the exact test of boxes that
+  /// straddle several planes.
+  /// \param[out] _results One value per box.
+  void ContainsBlock(const Frustum &_frustum, const BoxBlock &_block,
+                     const AxisAlignedBox *_boxes, std::uint8_t *_results)
+  {
+    std::uint8_t outside[kBoxBlockSize];
+    std::uint8_t overlapping[kBoxBlockSize];
+    std::fill(outside, outside + _block.count, 0);
+    std::fill(overlapping, overlapping + _block.count, 0);
+
+    for (int p = Frustum::FRUSTUM_PLANE_NEAR;
+         p <= Frustum::FRUSTUM_PLANE_BOTTOM; ++p)
+    {
+      const Planed plane =
+        _frustum.Plane(static_cast<Frustum::FrustumPlane>(p));
+      const double nx = plane.Normal().X();
+      const double ny = plane.Normal().Y();
+      const double nz = plane.Normal().Z();
+      const double d = plane.Offset();
+
+      // Center/extent test, the box is on the negative side of the plane
+      // if its center is further than its projected radius.
+      for (std::size_t i = 0; i < _block.count; ++i)
+      {
+        const double dist =
+          nx * _block.cx[i] + ny * _block.cy[i] + nz * _block.cz[i] - d;
+        const double radius = std::abs(nx * _block.ex[i]) +
+          std::abs(ny * _block.ey[i]) + std::abs(nz * _block.ez[i]);
+        outside[i] |= static_cast<std::uint8_t>(dist < -radius);
+        overlapping[i] += static_cast<std::uint8_t>(!(dist > radius));
+      }
+    }
+
+    for (std::size_t i = 0; i < _block.count; ++i)
+    {
+      if (outside[i])
+        _results[i] = 0;
+      else if (overlapping[i] >= 2)
+        _results[i] = _frustum.Contains(_boxes[i]) ? 1 : 0;
+      else
+        _results[i] = 1;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void Frustum::Contains(const AxisAlignedBox *_boxes,
+                       std::uint8_t *_results,
+                       const std::size_t _count) const
+{
+  BoxBlock block;
+  for (std::size_t start = 0; start < _count; start += kBoxBlockSize)
+  {
+    block.Load(_boxes + start, std::min(kBoxBlockSize, _count - start));
+    ContainsBlock(*this, block, _boxes + start, _results + start);
+  }
+}
+
+/////////////////////////////////////////////////
+void Frustum::Contains(const std::vector<AxisAlignedBox> &_boxes,
+                       std::vector<std::uint8_t> &_results) const
+{
+  _results.resize(_boxes.size());
+  this->Contains(_boxes.data(), _results.data(), _boxes.size());
+}
+
+/////////////////////////////////////////////////
+void Frustum::Contains(const std::vector<Frustum> &_frustums,
+                       const std::vector<AxisAlignedBox> &_boxes,
+                       std::vector<std::uint8_t> &_results)
+{
+  const std::size_t count = _boxes.size();
+  _results.resize(_frustums.size() * count);
+
+  BoxBlock block;
+  for (std::size_t start = 0; start < count; start += kBoxBlockSize)
+  {
+    block.Load(_boxes.data() + start, std::min(kBoxBlockSize, count - start));
+    for (std::size_t f = 0; f < _frustums.size(); ++f)
+    {
+      ContainsBlock(_frustums[f], block, _boxes.data() + start,
+          _results.data() + f * count + start);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void Frustum::Visibility(const Frustum *_frustums,
+                         const std::size_t _frustumCount,
+                         const AxisAlignedBox *_boxes,
+                         std::uint64_t *_masks,
+                         const std::size_t _count,
+                         const unsigned int _threads)
+{
+  const std::size_t frustums =
+    std::min(_frustumCount, kMaxVisibilityFrustums);
+
+  // Test a range of blocks of boxes against all the frustums
+  const auto run = [&](const std::size_t _begin, const std::size_t _end)
+  {
+    BoxBlock block;
+    std::uint8_t results[kBoxBlockSize];
+    for (std::size_t b = _begin; b < _end; ++b)
+    {
+      const std::size_t start = b * kBoxBlockSize;
+      const std::size_t count = std::min(kBoxBlockSize, _count - start);
+      block.Load(_boxes + start, count);
+      std::uint64_t *masks = _masks + start;
+      std::fill(masks, masks + count, 0);
+      for (std::size_t f = 0; f < frustums; ++f)
+      {
+        ContainsBlock(_frustums[f], block, _boxes + start, results);
+        for (std::size_t i = 0; i < count; ++i)
+          masks[i] |= static_cast<std::uint64_t>(results[i]) << f;
+      }
+    }
+  };
+
+  const std::size_t blocks = (_count + kBoxBlockSize - 1) / kBoxBlockSize;
+  if (blocks == 0)
+    return;
+  detail::ParallelFor(blocks,
+      detail::ChunkCount(blocks, _threads, kMinChunkBlocks),
+      [&run](std::size_t, std::size_t _begin, std::size_t _end)
+  {
+    run(_begin, _end);
+  });
+}
+
 /////////////////////////////////////////////////
 bool Frustum::Contains(const Vector3d &_p) const
 {
@@ -246,7 +561,7 @@ Pose3d Frustum::Pose() const
 void Frustum::SetPose(const Pose3d &_pose)
 {
   this->dataPtr->pose = _pose;
-  this->ComputePlanes();
+  this->dataPtr->UpdatePose();
 }
 
 /////////////////////////////////////////////////
@@ -280,18 +595,17 @@ void Frustum::ComputePlanes()
   // Height of far plane
   double farHeight = farWidth / this->dataPtr->aspectRatio;
 
-  // Up, right, and forward unit vectors.
-  Vector3d forward = this->dataPtr->pose.Rot().RotateVector(Vector3d::UnitX);
-  Vector3d up = this->dataPtr->pose.Rot().RotateVector(Vector3d::UnitZ);
-  Vector3d right = this->dataPtr->pose.Rot().RotateVector(-Vector3d::UnitY);
+  // Up, right, and forward unit vectors. The planes are computed in the
+  // frame of the frustum and then moved to its pose.
+  const Vector3d forward = Vector3d::UnitX;
+  const Vector3d up = Vector3d::UnitZ;
+  const Vector3d right = -Vector3d::UnitY;
 
   // Near plane center
-  Vector3d nearCenter = this->dataPtr->pose.Pos() + forward *
-    this->dataPtr->near;
+  Vector3d nearCenter = forward * this->dataPtr->near;
 
   // Far plane center
-  Vector3d farCenter = this->dataPtr->pose.Pos() + forward *
-    this->dataPtr->far;
+  Vector3d farCenter = forward * this->dataPtr->far;
 
   // These four variables are here for convenience.
   Vector3d upNearHeight2 = up * (nearHeight * 0.5);
@@ -312,28 +626,14 @@ void Frustum::ComputePlanes()
   Vector3d farBottomRight = farCenter - upFarHeight2 + rightFarWidth2;
 
   // Save these vertices
-  this->dataPtr->points[0] = nearTopLeft;
-  this->dataPtr->points[1] = nearTopRight;
-  this->dataPtr->points[2] = nearBottomLeft;
-  this->dataPtr->points[3] = nearBottomRight;
-  this->dataPtr->points[4] = farTopLeft;
-  this->dataPtr->points[5] = farTopRight;
-  this->dataPtr->points[6] = farBottomLeft;
-  this->dataPtr->points[7] = farBottomRight;
-
-  // Save the edges
-  this->dataPtr->edges[0] = {nearTopLeft, nearTopRight};
-  this->dataPtr->edges[1] = {nearTopLeft, nearBottomLeft};
-  this->dataPtr->edges[2] = {nearTopLeft, farTopLeft};
-  this->dataPtr->edges[3] = {nearTopRight, nearBottomRight};
-  this->dataPtr->edges[4] = {nearTopRight, farTopRight};
-  this->dataPtr->edges[5] = {nearBottomLeft, nearBottomRight};
-  this->dataPtr->edges[6] = {nearBottomLeft, farBottomLeft};
-  this->dataPtr->edges[7] = {farTopLeft, farTopRight};
-  this->dataPtr->edges[8] = {farTopLeft, farBottomLeft};
-  this->dataPtr->edges[9] = {farTopRight, farBottomRight};
-  this->dataPtr->edges[10] = {farBottomLeft, farBottomRight};
-  this->dataPtr->edges[11] = {farBottomRight, nearBottomRight};
+  this->dataPtr->localPoints[0] = nearTopLeft;
+  this->dataPtr->localPoints[1] = nearTopRight;
+  this->dataPtr->localPoints[2] = nearBottomLeft;
+  this->dataPtr->localPoints[3] = nearBottomRight;
+  this->dataPtr->localPoints[4] = farTopLeft;
+  this->dataPtr->localPoints[5] = farTopRight;
+  this->dataPtr->localPoints[6] = farBottomLeft;
+  this->dataPtr->localPoints[7] = farBottomRight;
 
   Vector3d leftCenter =
     (farTopLeft + nearTopLeft + farBottomLeft + nearBottomLeft) / 4.0;
@@ -350,21 +650,24 @@ void Frustum::ComputePlanes()
   // Compute plane offsets
   // Set the planes, where the first value is the plane normal and the
   // second the plane offset
+  auto &planes = this->dataPtr->localPlanes;
   Vector3d norm = Vector3d::Normal(nearTopLeft, nearTopRight, nearBottomLeft);
-  this->dataPtr->planes[FRUSTUM_PLANE_NEAR].Set(norm, nearCenter.Dot(norm));
+  planes[FRUSTUM_PLANE_NEAR].Set(norm, nearCenter.Dot(norm));
 
   norm = Vector3d::Normal(farTopRight, farTopLeft, farBottomLeft);
-  this->dataPtr->planes[FRUSTUM_PLANE_FAR].Set(norm, farCenter.Dot(norm));
+  planes[FRUSTUM_PLANE_FAR].Set(norm, farCenter.Dot(norm));
 
   norm = Vector3d::Normal(farTopLeft, nearTopLeft, nearBottomLeft);
-  this->dataPtr->planes[FRUSTUM_PLANE_LEFT].Set(norm, leftCenter.Dot(norm));
+  planes[FRUSTUM_PLANE_LEFT].Set(norm, leftCenter.Dot(norm));
 
   norm = Vector3d::Normal(nearTopRight, farTopRight, farBottomRight);
-  this->dataPtr->planes[FRUSTUM_PLANE_RIGHT].Set(norm, rightCenter.Dot(norm));
+  planes[FRUSTUM_PLANE_RIGHT].Set(norm, rightCenter.Dot(norm));
 
   norm = Vector3d::Normal(nearTopLeft, farTopLeft, nearTopRight);
-  this->dataPtr->planes[FRUSTUM_PLANE_TOP].Set(norm, topCenter.Dot(norm));
+  planes[FRUSTUM_PLANE_TOP].Set(norm, topCenter.Dot(norm));
 
   norm = Vector3d::Normal(nearBottomLeft, nearBottomRight, farBottomRight);
-  this->dataPtr->planes[FRUSTUM_PLANE_BOTTOM].Set(norm, bottomCenter.Dot(norm));
+  planes[FRUSTUM_PLANE_BOTTOM].Set(norm, bottomCenter.Dot(norm));
+
+  this->dataPtr->UpdatePose();
 }
@@ -17,8 +17,14 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <vector>
+
 #include "gz/math/Helpers.hh"
 #include "gz/math/Frustum.hh"
+#include "gz/math/Matrix3.hh"
+#include "gz/math/Matrix4.hh"
+#include "gz/math/Rand.hh"
 
 using namespace gz;
 using namespace math;
@@ -659,3 +665,269 @@ TEST(FrustumTest, AABBBFWall)
   EXPECT_TRUE(frustum.Contains(
         AxisAlignedBox(Vector3d(-10, -10, 1.95), Vector3d(10, 10, 2.05))));
 }
+
+/////////////////////////////////////////////////
+std::vector<AxisAlignedBox> BatchTestBoxes()
+{
+  std::vector<AxisAlignedBox> boxes;
+  for (int i = -3; i <= 12; ++i)
+  {
+    for (int j = -8; j <= 8; ++j)
+    {
+      for (int k = -8; k <= 8; k += 2)
+      {
+        const Vector3d center(i * 1.0, j * 0.75, k * 0.5);
+        const Vector3d half(0.05 + 0.1 * ((i + j + 20) % 7),
+            0.1 + 0.2 * ((j + 9) % 3), 0.3);
+        boxes.push_back(AxisAlignedBox(center - half, center + half));
+      }
+    }
+  }
+  // A box that is larger than the frustum and an empty box
+  boxes.push_back(AxisAlignedBox(Vector3d(-100, -100, -100),
+      Vector3d(100, 100, 100)));
+  boxes.push_back(AxisAlignedBox());
+  return boxes;
+}
+
+/////////////////////////////////////////////////
+TEST(FrustumTest, ContainsBatch)
+{
+  Frustum frustum(1, 10, Angle(GZ_DTOR(60)), 1.5,
+      Pose3d(0, 0, 0, 0, 0.1, -0.2));
+  const std::vector<AxisAlignedBox> boxes = BatchTestBoxes();
+  ASSERT_GT(boxes.size(), 256u);
+
+  std::vector<std::uint8_t> results;
+  frustum.Contains(boxes, results);
+  ASSERT_EQ(boxes.size(), results.size());
+
+  std::size_t inside = 0;
+  for (std::size_t i = 0; i < boxes.size(); ++i)
+  {
+    EXPECT_EQ(frustum.Contains(boxes[i]), results[i] == 1) << i;
+    inside += results[i];
+  }
+  // Make sure both outcomes are exercised
+  EXPECT_GT(inside, 0u);
+  EXPECT_LT(inside, boxes.size());
+
+  // Partial blocks through the pointer interface
+  std::vector<std::uint8_t> partial(5, 7);
+  frustum.Contains(boxes.data() + 300, partial.data(), partial.size());
+  for (std::size_t i = 0; i < partial.size(); ++i)
+    EXPECT_EQ(results[300 + i], partial[i]);
+
+  std::vector<AxisAlignedBox> empty;
+  frustum.Contains(empty, results);
+  EXPECT_TRUE(results.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(FrustumTest, ContainsBatchMultipleFrustums)
+{
+  std::vector<Frustum> frustums;
+  for (int i = 0; i < 4; ++i)
+  {
+    frustums.push_back(Frustum(0.5, 8, Angle(GZ_DTOR(45 + 10 * i)), 4.0 / 3,
+        Pose3d(0, 0, 0, 0, 0, GZ_DTOR(90 * i))));
+  }
+  const std::vector<AxisAlignedBox> boxes = BatchTestBoxes();
+
+  std::vector<std::uint8_t> results;
+  Frustum::Contains(frustums, boxes, results);
+  ASSERT_EQ(frustums.size() * boxes.size(), results.size());
+  for (std::size_t f = 0; f < frustums.size(); ++f)
+  {
+    for (std::size_t b = 0; b < boxes.size(); ++b)
+    {
+      EXPECT_EQ(frustums[f].Contains(boxes[b]),
+          results[f * boxes.size() + b] == 1) << f << " " << b;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(FrustumTest, Visibility)
+{
+  // A ring of 12 cameras
+  std::vector<Frustum> frustums;
+  for (int i = 0; i < 12; ++i)
+  {
+    frustums.push_back(Frustum(0.5, 8, Angle(GZ_DTOR(50)), 4.0 / 3,
+        Pose3d(0, 0, 0.5, 0, 0.05 * i, GZ_DTOR(30 * i))));
+  }
+
+  // Enough boxes to be split between threads
+  std::vector<AxisAlignedBox> boxes;
+  for (int copy = 0; copy < 8; ++copy)
+  {
+    for (const auto &box : BatchTestBoxes())
+      boxes.push_back(box + Vector3d(0, 0, 0.01 * copy));
+  }
+
+  std::vector<std::uint8_t> results;
+  Frustum::Contains(frustums, boxes, results);
+  for (unsigned int threads : {1u, 3u, 0u})
+  {
+    std::vector<std::uint64_t> masks(boxes.size(), ~std::uint64_t(0));
+    Frustum::Visibility(frustums.data(), frustums.size(), boxes.data(),
+        masks.data(), boxes.size(), threads);
+    std::size_t visible = 0;
+    for (std::size_t b = 0; b < boxes.size(); ++b)
+    {
+      std::uint64_t expected = 0;
+      for (std::size_t f = 0; f < frustums.size(); ++f)
+      {
+        if (results[f * boxes.size() + b])
+          expected |= std::uint64_t(1) << f;
+      }
+      ASSERT_EQ(expected, masks[b]) << b;
+      visible += masks[b] != 0;
+    }
+    EXPECT_GT(visible, 0u);
+    EXPECT_LT(visible, boxes.size());
+  }
+
+  // Only the first 64 frustums are used
+  std::vector<Frustum> many(70, frustums[0]);
+  many[63] = frustums[6];
+  std::vector<std::uint64_t> masks(boxes.size());
+  Frustum::Visibility(many.data(), many.size(), boxes.data(),
+      masks.data(), boxes.size());
+  for (std::size_t b = 0; b < boxes.size(); ++b)
+  {
+    const std::uint64_t first = results[b] ?
+      (std::uint64_t(1) << 63) - 1 : 0;
+    const std::uint64_t last = results[6 * boxes.size() + b] ?
+      std::uint64_t(1) << 63 : 0;
+    ASSERT_EQ(first | last, masks[b]) << b;
+  }
+
+  // No boxes and no frustums
+  Frustum::Visibility(frustums.data(), frustums.size(), boxes.data(),
+      nullptr, 0);
+  Frustum::Visibility(nullptr, 0, boxes.data(), masks.data(), 10);
+  for (std::size_t b = 0; b < 10; ++b)
+    EXPECT_EQ(0u, masks[b]);
+}
+
+/////////////////////////////////////////////////
+TEST(FrustumTest, Set)
+{
+  const Pose3d pose(1, -2, 3, 0.1, -0.4, 2.0);
+  const Frustum expected(0.5, 20, Angle(GZ_DTOR(70)), 1.6, pose);
+
+  Frustum frustum;
+  frustum.Set(0.5, 20, Angle(GZ_DTOR(70)), 1.6, pose);
+  EXPECT_DOUBLE_EQ(0.5, frustum.Near());
+  EXPECT_DOUBLE_EQ(20, frustum.Far());
+  EXPECT_EQ(Angle(GZ_DTOR(70)), frustum.FOV());
+  EXPECT_DOUBLE_EQ(1.6, frustum.AspectRatio());
+  EXPECT_EQ(pose, frustum.Pose());
+  for (int p = Frustum::FRUSTUM_PLANE_NEAR;
+       p <= Frustum::FRUSTUM_PLANE_BOTTOM; ++p)
+  {
+    const auto plane = static_cast<Frustum::FrustumPlane>(p);
+    EXPECT_EQ(expected.Plane(plane).Normal(), frustum.Plane(plane).Normal());
+    EXPECT_DOUBLE_EQ(expected.Plane(plane).Offset(),
+                     frustum.Plane(plane).Offset());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(FrustumTest, SetPoseMovesPlanes)
+{
+  Rand::Seed(3);
+  const Frustum local(0.5, 6, Angle(GZ_DTOR(60)), 1.5);
+  const std::vector<AxisAlignedBox> boxes = BatchTestBoxes();
+  Frustum frustum(0.5, 6, Angle(GZ_DTOR(60)), 1.5);
+  for (int n = 0; n < 20; ++n)
+  {
+    const Pose3d pose(Rand::DblUniform(-2, 2), Rand::DblUniform(-2, 2),
+        Rand::DblUniform(-2, 2), Rand::DblUniform(-GZ_PI, GZ_PI),
+        Rand::DblUniform(-GZ_PI, GZ_PI), Rand::DblUniform(-GZ_PI, GZ_PI));
+    frustum.SetPose(pose);
+    EXPECT_EQ(pose, frustum.Pose());
+
+    // The planes move with the frustum
+    for (int p = Frustum::FRUSTUM_PLANE_NEAR;
+         p <= Frustum::FRUSTUM_PLANE_BOTTOM; ++p)
+    {
+      const auto plane = static_cast<Frustum::FrustumPlane>(p);
+      for (int i = 0; i < 10; ++i)
+      {
+        const Vector3d point(Rand::DblUniform(-8, 8),
+            Rand::DblUniform(-8, 8), Rand::DblUniform(-8, 8));
+        EXPECT_NEAR(local.Plane(plane).Distance(point),
+            frustum.Plane(plane).Distance(pose.CoordPositionAdd(point)),
+            1e-9);
+      }
+    }
+
+    // Same results as a frustum built at that pose
+    const Frustum expected(0.5, 6, Angle(GZ_DTOR(60)), 1.5, pose);
+    for (const AxisAlignedBox &box : boxes)
+      EXPECT_EQ(expected.Contains(box), frustum.Contains(box));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(FrustumTest, ProjectionViewMatrix)
+{
+  const double near = 0.3;
+  const double far = 40;
+  const Angle fov(GZ_DTOR(75));
+  const double aspect = 16.0 / 9.0;
+  const Pose3d pose(2, -1, 1.5, 0.2, 0.3, -2.5);
+
+  // OpenGL projection, from the horizontal field of view
+  const double fx = 1.0 / std::tan(fov.Radian() * 0.5);
+  const Matrix4d projection(
+      fx, 0, 0, 0,
+      0, fx * aspect, 0, 0,
+      0, 0, (far + near) / (near - far), 2 * far * near / (near - far),
+      0, 0, -1, 0);
+
+  // OpenGL cameras look along -Z with Y up, frustums along X with Z up
+  const Matrix4d axes(
+      0, -1, 0, 0,
+      0, 0, 1, 0,
+      -1, 0, 0, 0,
+      0, 0, 0, 1);
+  const Matrix4d view = axes * Matrix4d(pose).Inverse();
+
+  const Frustum frustum(projection * view);
+  EXPECT_NEAR(near, frustum.Near(), 1e-9);
+  EXPECT_NEAR(far, frustum.Far(), 1e-9);
+  EXPECT_NEAR(fov.Radian(), frustum.FOV().Radian(), 1e-9);
+  EXPECT_NEAR(aspect, frustum.AspectRatio(), 1e-9);
+  EXPECT_TRUE(pose.Pos().Equal(frustum.Pose().Pos(), 1e-9));
+  EXPECT_TRUE(Matrix3d(pose.Rot()).Equal(Matrix3d(frustum.Pose().Rot()),
+                                         1e-9));
+
+  const Frustum expected(near, far, fov, aspect, pose);
+  for (int p = Frustum::FRUSTUM_PLANE_NEAR;
+       p <= Frustum::FRUSTUM_PLANE_BOTTOM; ++p)
+  {
+    const auto plane = static_cast<Frustum::FrustumPlane>(p);
+    EXPECT_EQ(expected.Plane(plane).Normal(), frustum.Plane(plane).Normal());
+    EXPECT_NEAR(expected.Plane(plane).Offset(),
+                frustum.Plane(plane).Offset(), 1e-9);
+  }
+
+  // Matrices that are not perspective projections are rejected
+  Frustum other(1, 2, Angle(GZ_DTOR(45)), 1.0);
+  EXPECT_FALSE(other.Set(Matrix4d::Zero));
+  const Matrix4d ortho(
+      0.1, 0, 0, 0,
+      0, 0.1, 0, 0,
+      0, 0, -0.05, -1,
+      0, 0, 0, 1);
+  EXPECT_FALSE(other.Set(ortho * view));
+  EXPECT_DOUBLE_EQ(1, other.Near());
+  EXPECT_DOUBLE_EQ(2, other.Far());
+
+  EXPECT_TRUE(other.Set(projection * view));
+  EXPECT_NEAR(far, other.Far(), 1e-9);
+}
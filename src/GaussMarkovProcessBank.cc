@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <vector>
+
+#include <gz/math/GaussMarkovProcessBank.hh>
+#include <gz/math/Rand.hh>
+
+using namespace gz::math;
+
+//////////////////////////////////////////////////
+class gz::math::GaussMarkovProcessBank::Implementation
+{
+  /// \brief Current values of the channels.
+  public: std::vector<double> value;
+
+  /// \brief Start values of the channels.
+  public: std::vector<double> start;
+
+  /// \brief Theta values of the channels.
+  public: std::vector<double> theta;
+
+  /// \brief Mu values of the channels.
+  public: std::vector<double> mu;
+
+  /// \brief Sigma values of the channels.
+  public: std::vector<double> sigma;
+
+  /// \brief Noise of the current update.
+  public: std::vector<double> noise;
+
+  /// \brief Indices of the channels with their own seed.
+  public: std::vector<size_t> seeded;
+
+  /// \brief Seeds of the seeded channels.
+  public: std::vector<uint64_t> seeds;
+
+  /// \brief Number of updates since the last reset, the counter of the
+  /// noise of the seeded channels.
+  public: uint64_t step{0};
+};
+
+//////////////////////////////////////////////////
+GaussMarkovProcessBank::GaussMarkovProcessBank()
+  : dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+size_t GaussMarkovProcessBank::Add(double _start, double _theta, double _mu,
+    double _sigma)
+{
+  auto &d = *this->dataPtr;
+  d.value.push_back(_start);
+  d.start.push_back(_start);
+  d.theta.push_back(std::max(0.0, _theta));
+  d.mu.push_back(_mu);
+  d.sigma.push_back(std::max(0.0, _sigma));
+  d.noise.push_back(0.0);
+  return d.value.size() - 1;
+}
+
+//////////////////////////////////////////////////
+size_t GaussMarkovProcessBank::Add(double _start, double _theta, double _mu,
+    double _sigma, uint64_t _seed)
+{
+  const size_t index = this->Add(_start, _theta, _mu, _sigma);
+  this->dataPtr->seeded.push_back(index);
+  this->dataPtr->seeds.push_back(_seed);
+  return index;
+}
+
+//////////////////////////////////////////////////
+bool GaussMarkovProcessBank::Set(size_t _index, double _start, double _theta,
+    double _mu, double _sigma)
+{
+  auto &d = *this->dataPtr;
+  if (_index >= d.value.size())
+    return false;
+
+  d.start[_index] = _start;
+  d.value[_index] = _start;
+  d.theta[_index] = std::max(0.0, _theta);
+  d.mu[_index] = _mu;
+  d.sigma[_index] = std::max(0.0, _sigma);
+  return true;
+}
+
+//////////////////////////////////////////////////
+size_t GaussMarkovProcessBank::Size() const
+{
+  return this->dataPtr->value.size();
+}
+
+//////////////////////////////////////////////////
+void GaussMarkovProcessBank::Clear()
+{
+  *this->dataPtr = Implementation();
+}
+
+//////////////////////////////////////////////////
+void GaussMarkovProcessBank::Reset()
+{
+  this->dataPtr->value = this->dataPtr->start;
+  this->dataPtr->step = 0;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &GaussMarkovProcessBank::Values() const
+{
+  return this->dataPtr->value;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &GaussMarkovProcessBank::Start() const
+{
+  return this->dataPtr->start;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &GaussMarkovProcessBank::Theta() const
+{
+  return this->dataPtr->theta;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &GaussMarkovProcessBank::Mu() const
+{
+  return this->dataPtr->mu;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &GaussMarkovProcessBank::Sigma() const
+{
+  return this->dataPtr->sigma;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &GaussMarkovProcessBank::Update(
+    const clock::duration &_dt)
+{
+  // Time difference in seconds
+  return this->Update(std::chrono::duration<double>(_dt).count());
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &GaussMarkovProcessBank::Update(double _dt)
+{
+  auto &d = *this->dataPtr;
+  const size_t count = d.value.size();
+
+  // Noise of all the channels, then of the seeded ones.
+  if (d.seeded.size() < count)
+    Rand::FillNormal(d.noise.data(), count);
+  for (size_t i = 0; i < d.seeded.size(); ++i)
+    d.noise[d.seeded[i]] = Philox4x32::Normal(d.seeds[i], d.step);
+  ++d.step;
+
+  double *value = d.value.data();
+  const double *theta = d.theta.data();
+  const double *mu = d.mu.data();
+  const double *sigma = d.sigma.data();
+  const double *noise = d.noise.data();
+  for (size_t i = 0; i < count; ++i)
+    value[i] += theta[i] * (mu[i] - value[i]) * _dt + sigma[i] * noise[i];
+
+  return d.value;
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "gz/math/GaussMarkovProcessBank.hh"
+#include "gz/math/Rand.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(GaussMarkovProcessBankTest, Channels)
+{
+  GaussMarkovProcessBank bank;
+  EXPECT_EQ(0u, bank.Size());
+  EXPECT_TRUE(bank.Update(0.1).empty());
+
+  EXPECT_EQ(0u, bank.Add(1.0, 0.5, 2.0, 0.0));
+  EXPECT_EQ(1u, bank.Add(3.0, -1.0, 0.0, -1.0));
+  EXPECT_EQ(2u, bank.Size());
+  EXPECT_DOUBLE_EQ(1.0, bank.Values()[0]);
+  EXPECT_DOUBLE_EQ(0.5, bank.Theta()[0]);
+  EXPECT_DOUBLE_EQ(2.0, bank.Mu()[0]);
+  EXPECT_DOUBLE_EQ(0.0, bank.Sigma()[0]);
+  EXPECT_DOUBLE_EQ(3.0, bank.Start()[1]);
+
+  // Negative theta and sigma are clamped to zero.
+  EXPECT_DOUBLE_EQ(0.0, bank.Theta()[1]);
+  EXPECT_DOUBLE_EQ(0.0, bank.Sigma()[1]);
+
+  // Without noise, the same values as GaussMarkovProcess.
+  GaussMarkovProcess gmp(1.0, 0.5, 2.0, 0.0);
+  for (int i = 0; i < 100; ++i)
+  {
+    const auto &values = bank.Update(std::chrono::milliseconds(100));
+    EXPECT_DOUBLE_EQ(gmp.Update(0.1), values[0]);
+    EXPECT_DOUBLE_EQ(3.0, values[1]);
+  }
+
+  EXPECT_TRUE(bank.Set(1, 0.0, 1.0, 5.0, 0.0));
+  EXPECT_FALSE(bank.Set(2, 0.0, 1.0, 5.0, 0.0));
+  EXPECT_DOUBLE_EQ(0.0, bank.Values()[1]);
+  bank.Update(0.5);
+  EXPECT_DOUBLE_EQ(2.5, bank.Values()[1]);
+
+  bank.Reset();
+  EXPECT_DOUBLE_EQ(1.0, bank.Values()[0]);
+  EXPECT_DOUBLE_EQ(0.0, bank.Values()[1]);
+
+  bank.Clear();
+  EXPECT_EQ(0u, bank.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(GaussMarkovProcessBankTest, Noise)
+{
+  // Stationary variance of the discrete process with mu = 0:
+  // sigma^2 / (1 - (1 - theta dt)^2).
+  const double theta = 0.5;
+  const double sigma = 0.1;
+  const double dt = 0.1;
+  const double variance = sigma * sigma /
+    (1.0 - (1.0 - theta * dt) * (1.0 - theta * dt));
+
+  Rand::Seed(3);
+  GaussMarkovProcessBank bank;
+  const size_t channels = 2000;
+  for (size_t i = 0; i < channels; ++i)
+    bank.Add(0.0, theta, 0.0, sigma);
+  for (int step = 0; step < 200; ++step)
+    bank.Update(dt);
+
+  double sum = 0;
+  double sumSquares = 0;
+  for (const double value : bank.Values())
+  {
+    sum += value;
+    sumSquares += value * value;
+  }
+  EXPECT_NEAR(0.0, sum / channels, 0.05);
+  EXPECT_NEAR(variance, sumSquares / channels, 0.1 * variance);
+}
+
+/////////////////////////////////////////////////
+TEST(GaussMarkovProcessBankTest, Seeds)
+{
+  // Seeded channels don't depend on the other channels nor on Rand.
+  GaussMarkovProcessBank first;
+  first.Add(0.0, 0.5, 1.0, 0.2, 42);
+
+  GaussMarkovProcessBank second;
+  second.Add(0.0, 0.5, 1.0, 0.2);
+  second.Add(0.0, 0.5, 1.0, 0.2, 42);
+  second.Add(0.0, 0.5, 1.0, 0.2, 43);
+
+  Rand::Seed(1);
+  std::vector<double> values;
+  for (int i = 0; i < 50; ++i)
+    values.push_back(first.Update(0.1)[0]);
+
+  Rand::Seed(2);
+  for (int i = 0; i < 50; ++i)
+  {
+    const auto &current = second.Update(0.1);
+    EXPECT_DOUBLE_EQ(values[i], current[1]);
+    EXPECT_NE(current[1], current[2]);
+  }
+
+  // Reset restarts the noise.
+  first.Reset();
+  EXPECT_DOUBLE_EQ(values[0], first.Update(0.1)[0]);
+}
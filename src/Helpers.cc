@@ -16,11 +16,697 @@
 */
 #include "gz/math/Helpers.hh"
 
-#include <iomanip>
-#include <regex>
-#include <sstream>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <vector>
 
-#include <gz/utils/NeverDestroyed.hh>
+#include "gz/math/Vector3.hh"
+#include "gz/math/detail/ParallelFor.hh"
+
+#include <gz/utils/SuppressWarning.hh>
+
+namespace
+{
+/// \brief Check whether a character is white space, as std::isspace in the
+/// "C" locale
+/// \param[in] _c The character
+/// \return True if _c is a space, tab, newline, vertical tab, form feed or
+/// carriage return
+bool isSpace(const char _c)
+{
+  return _c == ' ' || (_c >= '\t' && _c <= '\r');
+}
+
+/// \brief Skip the white space at the start of a string
+/// \param[in] _first Start of the string
+/// \param[in] _last End of the string
+/// \return Pointer to the first character that isn't white space
+const char *skipSpace(const char *_first, const char *_last)
+{
+  while (_first != _last && isSpace(*_first))
+    ++_first;
+  return _first;
+}
+
+/// \brief Parse an integer at the start of a string, with the syntax of
+/// std::stoi but without exceptions
+/// \param[in] _first Start of the string, without leading white space
+/// \param[in] _last End of the string
+/// \param[out] _value The integer
+/// \return Pointer past the integer, or nullptr if there is no integer or
+/// it is out of range
+const char *parseNumber(const char *_first, const char *_last, int &_value)
+{
+  // std::from_chars doesn't accept a plus sign
+  if (_first != _last && *_first == '+')
+  {
+    ++_first;
+    if (_first != _last && *_first == '-')
+      return nullptr;
+  }
+  const auto result = std::from_chars(_first, _last, _value);
+  return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+/// \brief Parse a floating point number at the start of a string, with the
+/// syntax of std::stod (decimal, hexadecimal, infinity or NaN) but without
+/// exceptions, and independently of the locale
+/// \param[in] _first Start of the string, without leading white space
+/// \param[in] _last End of the string
+/// \param[out] _value The number
+/// \return Pointer past the number, or nullptr if there is no number or it
+/// is out of range
+const char *parseNumber(const char *_first, const char *_last,
+                        double &_value)
+{
+  // std::from_chars doesn't accept a plus sign or a hexadecimal prefix
+  bool negative = false;
+  if (_first != _last && (*_first == '+' || *_first == '-'))
+  {
+    negative = *_first == '-';
+    ++_first;
+  }
+  if (_first == _last || *_first == '+' || *_first == '-')
+    return nullptr;
+
+  auto isHexDigit = [](const char _c)
+  {
+    return (_c >= '0' && _c <= '9') || (_c >= 'a' && _c <= 'f') ||
+           (_c >= 'A' && _c <= 'F');
+  };
+  const char *digits = _last - _first > 2 ? _first + 2 : _last;
+  std::from_chars_result result{nullptr, std::errc::invalid_argument};
+  if (_last - _first > 2 && _first[0] == '0' &&
+      (_first[1] == 'x' || _first[1] == 'X') &&
+      (isHexDigit(*digits) ||
+       (*digits == '.' && _last - digits > 1 && isHexDigit(digits[1]))))
+  {
+    result = std::from_chars(digits, _last, _value, std::chars_format::hex);
+  }
+  // Without hexadecimal digits, "0x" is parsed as 0
+  if (result.ec == std::errc::invalid_argument)
+    result = std::from_chars(_first, _last, _value);
+
+  // As std::stod, reject values too small to be normal numbers
+  if (result.ec != std::errc() ||
+      std::fpclassify(_value) == FP_SUBNORMAL)
+  {
+    return nullptr;
+  }
+
+  if (negative)
+    _value = -_value;
+  return result.ptr;
+}
+
+/// \brief Parse a string into a number the way parseInt and parseFloat do
+/// \param[in] _input The string
+/// \param[in] _invalid Value returned if the string can't be parsed
+/// \return The number
+template<typename T>
+T parseString(std::string_view _input, const T _invalid)
+{
+  // Return _invalid if it is empty
+  if (_input.empty())
+    return _invalid;
+  // Return 0 if it is all spaces
+  if (_input.find_first_not_of(' ') == std::string_view::npos)
+    return 0;
+
+  // Anything can follow the number
+  T value;
+  const char *last = _input.data() + _input.size();
+  if (!parseNumber(skipSpace(_input.data(), last), last, value))
+    return _invalid;
+  return value;
+}
+
+/// \brief Parse the white space separated numbers of a string
+/// \param[in] _input The string
+/// \param[in] _func Called with each number
+/// \return True if each token of the string is a number
+template<typename Func>
+bool parseTokens(std::string_view _input, Func _func)
+{
+  const char *first = _input.data();
+  const char *last = first + _input.size();
+  while ((first = skipSpace(first, last)) != last)
+  {
+    double value;
+    const char *end = parseNumber(first, last, value);
+    if (!end || (end != last && !isSpace(*end)))
+      return false;
+    _func(value);
+    first = end;
+  }
+  return true;
+}
+
+/// \brief Write a number with std::to_chars. "-0" is written as "0", as
+/// with appendToStream.
+/// \param[in] _first Start of the buffer
+/// \param[in] _last End of the buffer
+/// \param[in] _number The number
+/// \param[in] _precision Number of digits after the decimal point, or a
+/// negative value for the shortest representation that reads back exactly
+/// \return Pointer past the number, or nullptr if it doesn't fit
+template<typename T>
+char *writeNumber(char *_first, char *_last, T _number, const int _precision)
+{
+  if (std::fpclassify(_number) == FP_ZERO)
+    _number = 0;
+  const std::to_chars_result result = _precision < 0 ?
+      std::to_chars(_first, _last, _number) :
+      std::to_chars(_first, _last, _number, std::chars_format::fixed,
+                    _precision);
+  return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+/// \brief Write an integer with std::to_chars, padded with zeros to at
+/// least two characters, as with std::setw(2) and std::setfill('0')
+/// \param[in] _first Start of the buffer
+/// \param[in] _last End of the buffer
+/// \param[in] _number The integer
+/// \return Pointer past the integer, or nullptr if it doesn't fit
+template<typename T>
+char *writeTwoDigits(char *_first, char *_last, const T _number)
+{
+  if (_number >= 0 && _number < 10)
+  {
+    if (_last - _first < 2)
+      return nullptr;
+    *_first++ = '0';
+  }
+  const std::to_chars_result result = std::to_chars(_first, _last, _number);
+  return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+/// \brief Append to a string with a function writing to a buffer, growing
+/// the string until the result fits
+/// \param[in, out] _out The string
+/// \param[in] _size Initial number of characters to reserve
+/// \param[in] _write Called with the start and end of the buffer, returns
+/// the number of characters written or 0 if they don't fit
+template<typename Write>
+void appendWith(std::string &_out, std::size_t _size, Write _write)
+{
+  const std::size_t start = _out.size();
+  while (true)
+  {
+    _out.resize(start + _size);
+    const std::size_t written = _write(&_out[start], _size);
+    if (written > 0)
+    {
+      _out.resize(start + written);
+      return;
+    }
+    _size *= 4;
+  }
+}
+
+/// \brief Spread the lower 21 bits of a value, so that bit i moves to bit
+/// 3 * i
+/// \param[in] _v The value
+/// \return The spread bits
+uint64_t spreadBits(const uint32_t _v)
+{
+  uint64_t x = _v & 0x1fffffu;
+  x = (x | x << 32) & 0x1f00000000ffffull;
+  x = (x | x << 16) & 0x1f0000ff0000ffull;
+  x = (x | x << 8) & 0x100f00f00f00f00full;
+  x = (x | x << 4) & 0x10c30c30c30c30c3ull;
+  x = (x | x << 2) & 0x1249249249249249ull;
+  return x;
+}
+
+/// \brief The reverse of spreadBits
+/// \param[in] _x Value whose bits 3 * i are gathered
+/// \return The gathered bits
+uint32_t gatherBits(uint64_t _x)
+{
+  _x &= 0x1249249249249249ull;
+  _x = (_x ^ (_x >> 2)) & 0x10c30c30c30c30c3ull;
+  _x = (_x ^ (_x >> 4)) & 0x100f00f00f00f00full;
+  _x = (_x ^ (_x >> 8)) & 0x1f0000ff0000ffull;
+  _x = (_x ^ (_x >> 16)) & 0x1f00000000ffffull;
+  _x = (_x ^ (_x >> 32)) & 0x1fffffull;
+  return static_cast<uint32_t>(_x);
+}
+
+/// \brief Offset of the signed cell coordinates of Morton keys
+constexpr int kMortonOffset = 1 << 20;
+
+/// \brief Check whether a character is a decimal digit
+/// \param[in] _c The character
+/// \return True if _c is in [0-9]
+bool isDigit(const char _c)
+{
+  return _c >= '0' && _c <= '9';
+}
+
+/// \brief Parse a time string in the general format "dd hh:mm:ss.nnn".
+/// This accepts exactly the strings matched by the regular expression
+/// ^([0-9]+ )?(?:([1-9]:|[0-1][0-9]:|2[0-3]:)?([0-9]:|[0-5][0-9]:))?
+/// (?:([0-9]|[0-5][0-9])?(\.[0-9]{1,3})?)$
+/// that was used before, without allocating memory. The number of days
+/// must also fit in an int.
+/// \param[in] _time The time string
+/// \param[out] _days Number of days, only set if the string has days
+/// \param[out] _hours Number of hours, only set if the string has hours
+/// \param[out] _minutes Number of minutes, only set if the string has
+/// minutes
+/// \param[out] _seconds Number of seconds, only set if the string has
+/// seconds
+/// \param[out] _milliseconds Number of milliseconds, only set if the
+/// string has milliseconds
+/// \return True if _time is a valid time string
+bool parseTimeString(std::string_view _time, uint64_t &_days,
+    uint64_t &_hours, uint64_t &_minutes, uint64_t &_seconds,
+    uint64_t &_milliseconds)
+{
+  // Days: any number of digits followed by a space. Nothing after the days
+  // accepts a space, so digits followed by a space must be the days.
+  std::size_t digits = 0;
+  while (digits < _time.size() && isDigit(_time[digits]))
+    ++digits;
+  bool hasDays = false;
+  uint64_t days = 0;
+  if (digits > 0 && digits < _time.size() && _time[digits] == ' ')
+  {
+    for (std::size_t i = 0; i < digits; ++i)
+    {
+      days = days * 10 + static_cast<uint64_t>(_time[i] - '0');
+      if (days > static_cast<uint64_t>(std::numeric_limits<int>::max()))
+        return false;
+    }
+    hasDays = true;
+    _time.remove_prefix(digits + 1);
+  }
+
+  // Hours and minutes end with a colon, so the number of colons tells
+  // which of them are present
+  std::string_view fields[3];
+  std::size_t fieldCount = 0;
+  while (true)
+  {
+    const std::size_t colon = _time.find(':');
+    if (colon == std::string_view::npos)
+      break;
+    if (fieldCount == 2)
+      return false;
+    fields[fieldCount++] = _time.substr(0, colon);
+    _time.remove_prefix(colon + 1);
+  }
+
+  // Hours: 1-9, 00-19 or 20-23
+  std::string_view hours = fieldCount == 2 ? fields[0] : std::string_view();
+  if (fieldCount == 2 &&
+      !(hours.size() == 1 && hours[0] >= '1' && hours[0] <= '9') &&
+      !(hours.size() == 2 && (hours[0] == '0' || hours[0] == '1') &&
+        isDigit(hours[1])) &&
+      !(hours.size() == 2 && hours[0] == '2' &&
+        hours[1] >= '0' && hours[1] <= '3'))
+  {
+    return false;
+  }
+
+  // Minutes and seconds: 0-9 or 00-59
+  auto isSixty = [](std::string_view _field)
+  {
+    return (_field.size() == 1 && isDigit(_field[0])) ||
+           (_field.size() == 2 && _field[0] >= '0' && _field[0] <= '5' &&
+            isDigit(_field[1]));
+  };
+  std::string_view minutes =
+      fieldCount > 0 ? fields[fieldCount - 1] : std::string_view();
+  if (fieldCount > 0 && !isSixty(minutes))
+    return false;
+
+  digits = 0;
+  while (digits < _time.size() && isDigit(_time[digits]))
+    ++digits;
+  const std::string_view seconds = _time.substr(0, digits);
+  if (!seconds.empty() && !isSixty(seconds))
+    return false;
+  _time.remove_prefix(digits);
+
+  // Milliseconds: a period followed by 1 to 3 digits
+  std::string_view milliseconds;
+  if (!_time.empty())
+  {
+    if (_time[0] != '.' || _time.size() < 2 || _time.size() > 4)
+      return false;
+    milliseconds = _time.substr(1);
+    for (const char c : milliseconds)
+    {
+      if (!isDigit(c))
+        return false;
+    }
+  }
+
+  auto value = [](std::string_view _field)
+  {
+    uint64_t result = 0;
+    for (const char c : _field)
+      result = result * 10 + static_cast<uint64_t>(c - '0');
+    return result;
+  };
+
+  if (hasDays)
+    _days = days;
+  if (!hours.empty())
+    _hours = value(hours);
+  if (!minutes.empty())
+    _minutes = value(minutes);
+  if (!seconds.empty())
+    _seconds = value(seconds);
+  if (!milliseconds.empty())
+  {
+    // Multiplier because "4" = 400 ms, "04" = 40 ms, and "004" = 4 ms
+    static const uint64_t kScale[] = {0, 100, 10, 1};
+    _milliseconds = value(milliseconds) * kScale[milliseconds.size()];
+  }
+  return true;
+}
+
+/// \brief Convert a time string to a duration
+/// \param[in] _time The time string
+/// \param[out] _duration The duration, only set if _time is valid
+/// \return True if _time is a valid time string
+bool parseDuration(std::string_view _time,
+                   std::chrono::steady_clock::duration &_duration)
+{
+  uint64_t numberDays = 0;
+  uint64_t numberHours = 0;
+  uint64_t numberMinutes = 0;
+  uint64_t numberSeconds = 0;
+  uint64_t numberMilliseconds = 0;
+  if (!parseTimeString(_time, numberDays, numberHours, numberMinutes,
+                       numberSeconds, numberMilliseconds))
+  {
+    return false;
+  }
+
+  // TODO(anyone): Replace below day conversion with std::chrono::days.
+  /// This will exist in C++-20
+  _duration = std::chrono::milliseconds(numberMilliseconds) +
+    std::chrono::seconds(numberSeconds) +
+    std::chrono::minutes(numberMinutes) +
+    std::chrono::hours(numberHours) +
+    std::chrono::hours(24 * numberDays);
+  return true;
+}
+
+/// \brief Call a function with each line of a buffer, without the end of
+/// line characters. A carriage return before a newline is ignored, and so is
+/// an empty last line.
+/// \param[in] _buffer The buffer
+/// \param[in] _func Function called with each line
+template<typename Func>
+void forEachLine(std::string_view _buffer, Func _func)
+{
+  while (!_buffer.empty())
+  {
+    std::size_t end = _buffer.find('\n');
+    std::string_view line = _buffer.substr(0, end);
+    _buffer.remove_prefix(
+        end == std::string_view::npos ? _buffer.size() : end + 1);
+    if (!line.empty() && line.back() == '\r')
+      line.remove_suffix(1);
+    _func(line);
+  }
+}
+/// \brief Number of values whose statistics are computed at once, which
+/// fit in the cache
+constexpr std::size_t kStatsBlockSize = 1024;
+
+/// \brief Number of independent sums of the statistics of a block
+constexpr std::size_t kStatsLanes = 8;
+
+/// \brief Smallest number of values whose statistics are computed by each
+/// thread
+constexpr std::size_t kMinStatsChunkSize = 65536;
+
+/// \brief Count, mean and sum of squared deviations of values
+struct Moments
+{
+  double count = 0;
+  double mean = 0;
+  double m2 = 0;
+};
+
+/// \brief Merge the moments of two sets of values, with the formula of
+/// Chan et al.
+/// \param[in,out] _a Moments of the first set, then of both sets
+/// \param[in] _b Moments of the second set
+void mergeMoments(Moments &_a, const Moments &_b)
+{
+  if (!(_b.count > 0))
+    return;
+  const double count = _a.count + _b.count;
+  const double delta = _b.mean - _a.mean;
+  _a.mean += delta * (_b.count / count);
+  _a.m2 += _b.m2 + delta * delta * (_a.count * _b.count / count);
+  _a.count = count;
+}
+
+/// \brief Sum values in kStatsLanes independent sums, which the compiler
+/// can vectorize
+/// \param[in] _values The values
+/// \param[in] _count Number of values
+/// \param[in] _fn Function of a value returning the term to sum
+/// \return The sum
+template<typename T, typename F>
+double laneSum(const T *_values, const std::size_t _count, F _fn)
+{
+  double lanes[kStatsLanes] = {};
+  std::size_t i = 0;
+  for (; i + kStatsLanes <= _count; i += kStatsLanes)
+  {
+    for (std::size_t k = 0; k < kStatsLanes; ++k)
+      lanes[k] += _fn(static_cast<double>(_values[i + k]));
+  }
+  for (; i < _count; ++i)
+    lanes[0] += _fn(static_cast<double>(_values[i]));
+
+  double sum = 0;
+  for (double lane : lanes)
+    sum += lane;
+  return sum;
+}
+
+/// \brief Compute the moments of values by blocks. The two passes over
+/// each block read the cache, not the memory.
+/// \param[in] _values The values
+/// \param[in] _count Number of values
+/// \return The moments
+template<typename T>
+Moments blockMoments(const T *_values, const std::size_t _count)
+{
+  Moments result;
+  for (std::size_t begin = 0; begin < _count; begin += kStatsBlockSize)
+  {
+    const std::size_t size = std::min(kStatsBlockSize, _count - begin);
+    const T *block = _values + begin;
+    Moments moments;
+    moments.count = static_cast<double>(size);
+    moments.mean = laneSum(block, size, [](double _v) {return _v;}) /
+      moments.count;
+    const double mean = moments.mean;
+    moments.m2 = laneSum(block, size, [mean](double _v)
+        {
+          return (_v - mean) * (_v - mean);
+        });
+    mergeMoments(result, moments);
+  }
+  return result;
+}
+
+/// \brief Compute the moments of values, splitting them in contiguous
+/// chunks whose moments are computed in parallel
+/// \param[in] _values The values
+/// \param[in] _count Number of values
+/// \param[in] _threads Largest number of threads, zero for
+/// std::thread::hardware_concurrency
+/// \return The moments
+template<typename T>
+Moments moments(const T *_values, const std::size_t _count,
+                const unsigned int _threads)
+{
+  const std::size_t chunks = gz::math::detail::ChunkCount(
+      _count, _threads, kMinStatsChunkSize);
+  if (chunks == 1)
+    return blockMoments(_values, _count);
+
+  // Chunks are made of whole blocks, so the result doesn't depend much on
+  // the number of threads
+  const std::size_t blocks = (_count + kStatsBlockSize - 1) / kStatsBlockSize;
+  std::vector<Moments> chunkMoments(chunks);
+  gz::math::detail::ParallelFor(blocks, chunks,
+      [&](const std::size_t _chunk, const std::size_t _begin,
+          const std::size_t _end)
+  {
+    const std::size_t first = _begin * kStatsBlockSize;
+    chunkMoments[_chunk] = blockMoments(_values + first,
+        std::min(_count, _end * kStatsBlockSize) - first);
+  });
+
+  Moments result;
+  for (const Moments &chunk : chunkMoments)
+    mergeMoments(result, chunk);
+  return result;
+}
+/// \brief Check whether a value is NaN, without calling std::isnan, so that
+/// loops can be vectorized. Only NaN is not equal to itself.
+/// \param[in] _v The value
+/// \return True if _v is NaN
+template<typename T>
+bool isNaNValue(const T _v)
+{
+  GZ_UTILS_WARN_IGNORE__FLOAT_EQUAL
+  return _v != _v;
+  GZ_UTILS_WARN_RESUME__FLOAT_EQUAL
+}
+
+/// \brief Clamp the values of an array, see gz::math::clamp
+/// \param[in] _in Values to clamp
+/// \param[out] _out Clamped values
+/// \param[in] _count Number of values
+/// \param[in] _min Minimum allowed value
+/// \param[in] _max Maximum allowed value
+template<typename T>
+void clampValues(const T *_in, T *_out, const std::size_t _count,
+                 const T _min, const T _max)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    // As std::max(std::min(v, max), min), NaN values are unchanged
+    T v = _max < _in[i] ? _max : _in[i];
+    _out[i] = v < _min ? _min : v;
+  }
+}
+
+/// \brief Replace the NaN and infinite values of an array with 0
+/// \param[in] _in Values to fix
+/// \param[out] _out Fixed values
+/// \param[in] _count Number of values
+template<typename T>
+void fixNaNValues(const T *_in, T *_out, const std::size_t _count)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    // False for NaN and infinite values
+    const bool finite = std::abs(_in[i]) <= std::numeric_limits<T>::max();
+    _out[i] = finite ? _in[i] : T(0);
+  }
+}
+
+/// \brief Clamp the values of an array and replace its NaN values
+/// \param[in] _in Values to sanitize
+/// \param[out] _out Sanitized values
+/// \param[in] _count Number of values
+/// \param[in] _min Minimum allowed value
+/// \param[in] _max Maximum allowed value
+/// \param[in] _nanValue Value replacing NaN values
+template<typename T>
+void sanitizeValues(const T *_in, T *_out, const std::size_t _count,
+                    const T _min, const T _max, const T _nanValue)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    T v = _max < _in[i] ? _max : _in[i];
+    v = v < _min ? _min : v;
+    _out[i] = isNaNValue(_in[i]) ? _nanValue : v;
+  }
+}
+
+/// \brief Round values to a number of decimals, as gz::math::precision,
+/// which rounds halfway cases away from zero like std::round. The rounding
+/// adds and subtracts 2^52 instead of calling std::round, which is a
+/// library call on targets without a rounding instruction, such as x86-64
+/// without SSE4.1.
+/// \param[in] _in Values to round
+/// \param[out] _out Rounded values
+/// \param[in] _count Number of values
+/// \param[in] _precision Number of decimals
+template<typename T>
+void roundValues(const T *_in, T *_out, const std::size_t _count,
+                 const unsigned int _precision)
+{
+  // Doubles from 2^52 are integers
+  constexpr double kIntegral = 4503599627370496.0;
+  const double p = std::pow(10, _precision);
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const double scaled = static_cast<double>(_in[i]) * p;
+    const double magnitude = std::abs(scaled);
+    // Round to nearest, halfway cases to even, then round these away from
+    // zero. Halfway cases are exactly one half from the rounded value.
+    double rounded = (magnitude + kIntegral) - kIntegral;
+    GZ_UTILS_WARN_IGNORE__FLOAT_EQUAL
+    rounded += magnitude - rounded == 0.5 ? 1.0 : 0.0;
+    GZ_UTILS_WARN_RESUME__FLOAT_EQUAL
+    rounded = magnitude < kIntegral ? rounded : magnitude;
+    _out[i] = static_cast<T>(std::copysign(rounded, scaled) / p);
+  }
+}
+
+/// \brief Compare two arrays of values, see gz::math::equal
+/// \param[in] _a The first values
+/// \param[in] _b The second values
+/// \param[out] _equal Result of each comparison, or null
+/// \param[in] _count Number of values of each array
+/// \param[in] _epsilon The tolerance
+/// \return Number of pairs of values within the tolerance
+template<typename T>
+std::size_t equalValues(const T *_a, const T *_b, bool *_equal,
+                        const std::size_t _count, const T _epsilon)
+{
+  std::size_t result = 0;
+  if (_equal)
+  {
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+      _equal[i] = std::abs(_a[i] - _b[i]) <= _epsilon;
+      result += _equal[i];
+    }
+  }
+  else
+  {
+    for (std::size_t i = 0; i < _count; ++i)
+      result += std::abs(_a[i] - _b[i]) <= _epsilon;
+  }
+  return result;
+}
+
+/// \brief Find the NaN values of an array
+/// \param[in] _values The values
+/// \param[out] _isnan Whether each value is NaN, or null
+/// \param[in] _count Number of values
+/// \return Number of NaN values
+template<typename T>
+std::size_t findNaNValues(const T *_values, bool *_isnan,
+                          const std::size_t _count)
+{
+  std::size_t result = 0;
+  if (_isnan)
+  {
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+      _isnan[i] = isNaNValue(_values[i]);
+      result += _isnan[i];
+    }
+  }
+  else
+  {
+    for (std::size_t i = 0; i < _count; ++i)
+      result += isNaNValue(_values[i]);
+  }
+  return result;
+}
+}  // namespace
 
 namespace gz
 {
@@ -29,55 +715,204 @@ namespace gz
     inline namespace GZ_MATH_VERSION_NAMESPACE
     {
     /////////////////////////////////////////////
-    int parseInt(const std::string &_input)
+    void clamp(const float *_in, float *_out, const std::size_t _count,
+               const float _min, const float _max)
     {
-      // Return NAN_I if it is empty
-      if (_input.empty())
-      {
-        return NAN_I;
-      }
-      // Return 0 if it is all spaces
-      else if (_input.find_first_not_of(' ') == std::string::npos)
-      {
-        return 0;
-      }
+      clampValues(_in, _out, _count, _min, _max);
+    }
+
+    /////////////////////////////////////////////
+    void clamp(const double *_in, double *_out, const std::size_t _count,
+               const double _min, const double _max)
+    {
+      clampValues(_in, _out, _count, _min, _max);
+    }
+
+    /////////////////////////////////////////////
+    void fixnan(const float *_in, float *_out, const std::size_t _count)
+    {
+      fixNaNValues(_in, _out, _count);
+    }
+
+    /////////////////////////////////////////////
+    void fixnan(const double *_in, double *_out, const std::size_t _count)
+    {
+      fixNaNValues(_in, _out, _count);
+    }
+
+    /////////////////////////////////////////////
+    void sanitize(const float *_in, float *_out, const std::size_t _count,
+                  const float _min, const float _max, const float _nanValue)
+    {
+      sanitizeValues(_in, _out, _count, _min, _max, _nanValue);
+    }
+
+    /////////////////////////////////////////////
+    void sanitize(const double *_in, double *_out, const std::size_t _count,
+                  const double _min, const double _max,
+                  const double _nanValue)
+    {
+      sanitizeValues(_in, _out, _count, _min, _max, _nanValue);
+    }
+
+    /////////////////////////////////////////////
+    void precision(const float *_in, float *_out, const std::size_t _count,
+                   const unsigned int _precision)
+    {
+      roundValues(_in, _out, _count, _precision);
+    }
+
+    /////////////////////////////////////////////
+    void precision(const double *_in, double *_out, const std::size_t _count,
+                   const unsigned int _precision)
+    {
+      roundValues(_in, _out, _count, _precision);
+    }
+
+    /////////////////////////////////////////////
+    std::size_t equal(const float *_a, const float *_b, bool *_equal,
+                      const std::size_t _count, const float _epsilon)
+    {
+      return equalValues(_a, _b, _equal, _count, _epsilon);
+    }
+
+    /////////////////////////////////////////////
+    std::size_t equal(const double *_a, const double *_b, bool *_equal,
+                      const std::size_t _count, const double _epsilon)
+    {
+      return equalValues(_a, _b, _equal, _count, _epsilon);
+    }
+
+    /////////////////////////////////////////////
+    std::size_t isnan(const float *_values, bool *_isnan,
+                      const std::size_t _count)
+    {
+      return findNaNValues(_values, _isnan, _count);
+    }
+
+    /////////////////////////////////////////////
+    std::size_t isnan(const double *_values, bool *_isnan,
+                      const std::size_t _count)
+    {
+      return findNaNValues(_values, _isnan, _count);
+    }
+
+    /////////////////////////////////////////////
+    double mean(const double *_values, const std::size_t _count,
+                const unsigned int _threads)
+    {
+      return _count == 0 ? NAN_D : moments(_values, _count, _threads).mean;
+    }
+
+    /////////////////////////////////////////////
+    float mean(const float *_values, const std::size_t _count,
+               const unsigned int _threads)
+    {
+      return _count == 0 ? NAN_F :
+        static_cast<float>(moments(_values, _count, _threads).mean);
+    }
 
-      // Otherwise try standard library
-      try
+    /////////////////////////////////////////////
+    double variance(const double *_values, const std::size_t _count,
+                    const unsigned int _threads)
+    {
+      if (_count == 0)
+        return NAN_D;
+      const Moments result = moments(_values, _count, _threads);
+      return result.m2 / result.count;
+    }
+
+    /////////////////////////////////////////////
+    float variance(const float *_values, const std::size_t _count,
+                   const unsigned int _threads)
+    {
+      if (_count == 0)
+        return NAN_F;
+      const Moments result = moments(_values, _count, _threads);
+      return static_cast<float>(result.m2 / result.count);
+    }
+
+    /////////////////////////////////////////////
+    void meanAndVariance(const double *_values, const std::size_t _count,
+                         double &_mean, double &_variance,
+                         const unsigned int _threads)
+    {
+      if (_count == 0)
       {
-        return std::stoi(_input);
+        _mean = _variance = NAN_D;
+        return;
       }
-      // if that fails, return NAN_I
-      catch(...)
+      const Moments result = moments(_values, _count, _threads);
+      _mean = result.mean;
+      _variance = result.m2 / result.count;
+    }
+
+    /////////////////////////////////////////////
+    void meanAndVariance(const float *_values, const std::size_t _count,
+                         float &_mean, float &_variance,
+                         const unsigned int _threads)
+    {
+      if (_count == 0)
       {
-        return NAN_I;
+        _mean = _variance = NAN_F;
+        return;
       }
+      const Moments result = moments(_values, _count, _threads);
+      _mean = static_cast<float>(result.mean);
+      _variance = static_cast<float>(result.m2 / result.count);
+    }
+
+    /////////////////////////////////////////////
+    int parseInt(const std::string &_input)
+    {
+      return parseString(std::string_view(_input), NAN_I);
+    }
+
+    /////////////////////////////////////////////
+    int parseInt(std::string_view _input)
+    {
+      return parseString(_input, NAN_I);
     }
 
     /////////////////////////////////////////////
     double parseFloat(const std::string &_input)
     {
-      // Return NAN_D if it is empty
-      if (_input.empty())
-      {
-        return NAN_D;
-      }
-      // Return 0 if it is all spaces
-      else if (_input.find_first_not_of(' ') == std::string::npos)
-      {
-        return 0;
-      }
+      return parseString(std::string_view(_input), NAN_D);
+    }
 
-      // Otherwise try standard library
-      try
+    /////////////////////////////////////////////
+    double parseFloat(std::string_view _input)
+    {
+      return parseString(_input, NAN_D);
+    }
+
+    /////////////////////////////////////////////
+    bool parseFloats(std::string_view _input, std::vector<double> &_values)
+    {
+      _values.clear();
+      return parseTokens(_input, [&](double _value)
       {
-        return std::stod(_input);
-      }
-      // if that fails, return NAN_D
-      catch(...)
+        _values.push_back(_value);
+      });
+    }
+
+    /////////////////////////////////////////////
+    bool parseVector3s(std::string_view _input,
+                       std::vector<Vector3<double>> &_vectors)
+    {
+      _vectors.clear();
+      Vector3<double> vector;
+      std::size_t axis = 0;
+      const bool valid = parseTokens(_input, [&](double _value)
       {
-        return NAN_D;
-      }
+        vector[axis] = _value;
+        if (++axis == 3)
+        {
+          _vectors.push_back(vector);
+          axis = 0;
+        }
+      });
+      return valid && axis == 0;
     }
 
     /////////////////////////////////////////////
@@ -127,30 +962,49 @@ namespace gz
     std::string timePointToString(
         const std::chrono::steady_clock::time_point &_point)
     {
-      auto duration = _point - secNsecToTimePoint(0, 0);
-      auto cleanDuration = breakDownDurations<days,
-                                              std::chrono::hours,
-                                              std::chrono::minutes,
-                                              std::chrono::seconds,
-                                              std::chrono::milliseconds>(
-                                                duration);
-      std::ostringstream output_string;
-      output_string << std::setw(2) << std::setfill('0')
-                    << std::get<0>(cleanDuration).count() << " "
-                    << std::setw(2) << std::setfill('0')
-                    << std::get<1>(cleanDuration).count() << ":"
-                    << std::setw(2) << std::setfill('0')
-                    << std::get<2>(cleanDuration).count() << ":"
-                    << std::setfill('0') << std::setw(6)
-                    << std::fixed << std::setprecision(3)
-                    << std::get<3>(cleanDuration).count() +
-                       std::get<4>(cleanDuration).count()/1000.0;
-      return output_string.str();
+      return durationToString(_point - secNsecToTimePoint(0, 0));
     }
 
     /////////////////////////////////////////////
     std::string durationToString(
         const std::chrono::steady_clock::duration &_duration)
+    {
+      std::string result;
+      appendToString(result, _duration);
+      return result;
+    }
+
+    /////////////////////////////////////////////
+    std::size_t toChars(char *_buffer, std::size_t _capacity,
+                        double _number, int _precision)
+    {
+      char *end = writeNumber(_buffer, _buffer + _capacity, _number,
+                              _precision);
+      return end ? static_cast<std::size_t>(end - _buffer) : 0u;
+    }
+
+    /////////////////////////////////////////////
+    std::size_t toChars(char *_buffer, std::size_t _capacity,
+                        float _number, int _precision)
+    {
+      char *end = writeNumber(_buffer, _buffer + _capacity, _number,
+                              _precision);
+      return end ? static_cast<std::size_t>(end - _buffer) : 0u;
+    }
+
+    /////////////////////////////////////////////
+    std::size_t toChars(char *_buffer, std::size_t _capacity,
+                        int _number, int)
+    {
+      const std::to_chars_result result =
+          std::to_chars(_buffer, _buffer + _capacity, _number);
+      return result.ec == std::errc() ?
+          static_cast<std::size_t>(result.ptr - _buffer) : 0u;
+    }
+
+    /////////////////////////////////////////////
+    std::size_t toChars(char *_buffer, std::size_t _capacity,
+        const std::chrono::steady_clock::duration &_duration)
     {
       auto cleanDuration = breakDownDurations<days,
                                               std::chrono::hours,
@@ -158,157 +1012,92 @@ namespace gz
                                               std::chrono::seconds,
                                               std::chrono::milliseconds>(
                                                 _duration);
-      std::ostringstream outputString;
-      outputString << std::setw(2) << std::setfill('0')
-                    << std::get<0>(cleanDuration).count() << " "
-                    << std::setw(2) << std::setfill('0')
-                    << std::get<1>(cleanDuration).count() << ":"
-                    << std::setw(2) << std::setfill('0')
-                    << std::get<2>(cleanDuration).count() << ":"
-                    << std::setfill('0') << std::setw(6)
-                    << std::fixed << std::setprecision(3)
-                    << std::get<3>(cleanDuration).count() +
-                       std::get<4>(cleanDuration).count()/1000.0;
-      return outputString.str();
+      // Same format as "%02d %02d:%02d:%06.3f"
+      char *last = _buffer + _capacity;
+      char *ptr = writeTwoDigits(_buffer, last,
+                                 std::get<0>(cleanDuration).count());
+      for (const auto &[separator, value] : {
+             std::make_pair(' ', std::get<1>(cleanDuration).count()),
+             std::make_pair(':', std::get<2>(cleanDuration).count())})
+      {
+        if (!ptr || ptr == last)
+          return 0u;
+        *ptr++ = separator;
+        ptr = writeTwoDigits(ptr, last, value);
+      }
+      if (!ptr || ptr == last)
+        return 0u;
+      *ptr++ = ':';
+
+      const double seconds = std::get<3>(cleanDuration).count() +
+        std::get<4>(cleanDuration).count()/1000.0;
+      char number[32];
+      char *end = writeNumber(number, number + sizeof(number), seconds, 3);
+      const std::size_t size = static_cast<std::size_t>(end - number);
+      const std::size_t padding = size < 6 ? 6 - size : 0;
+      if (static_cast<std::size_t>(last - ptr) < padding + size)
+        return 0u;
+      ptr = std::fill_n(ptr, padding, '0');
+      ptr = std::copy(number, end, ptr);
+      return static_cast<std::size_t>(ptr - _buffer);
     }
 
     /////////////////////////////////////////////
-    bool splitTimeBasedOnTimeRegex(
-        const std::string &_timeString,
-        uint64_t & numberDays, uint64_t & numberHours,
-        uint64_t & numberMinutes, uint64_t & numberSeconds,
-        uint64_t & numberMilliseconds)
+    void appendToString(std::string &_out, double _number, int _precision)
     {
-      // The following regex takes a time string in the general format of
-      // "dd hh:mm:ss.nnn" where n is milliseconds, if just one number is
-      // provided, it is assumed to be seconds.
-      static const gz::utils::NeverDestroyed<std::regex> timeRegex {
-          "^([0-9]+ ){0,1}"                       // day:
-                                                  // Any positive integer
-
-          "(?:([1-9]:|[0-1][0-9]:|2[0-3]:){0,1}"  // hour:
-                                                  // 1 - 9:
-                                                  // 01 - 19:
-                                                  // 20 - 23:
-
-          "([0-9]:|[0-5][0-9]:)){0,1}"            // minute:
-                                                  // 0 - 9:
-                                                  // 00 - 59:
-
-          "(?:([0-9]|[0-5][0-9]){0,1}"            // second:
-                                                  // 0 - 9
-                                                  // 00 - 59
-
-          "(\\.[0-9]{1,3}){0,1})$"};              // millisecond:
-                                                  // .0 - .9
-                                                  // .00 - .99
-                                                  // .000 - 0.999
-
-      std::smatch matches;
-
-      // `matches` should always be a size of 6 as there are 6 matching
-      // groups in the regex.
-      // 1. The whole regex
-      // 2. The days
-      // 3. The hours
-      // 4. The minutes
-      // 5. The seconds
-      // 6. The milliseconds
-      // We can also index them as such below.
-      // Note that the space will remain in the day match, the colon
-      // will remain in the hour and minute matches, and the period will
-      // remain in the millisecond match
-      if (!std::regex_search(_timeString, matches, timeRegex.Access()) ||
-          matches.size() != 6)
-        return false;
-
-      std::string dayString = matches[1];
-      std::string hourString = matches[2];
-      std::string minuteString = matches[3];
-      std::string secondString = matches[4];
-      std::string millisecondString = matches[5];
-
-      // Days are the only unbounded number, so check first to see if stoi
-      // runs successfully
-      if (!dayString.empty())
+      appendWith(_out, 32, [&](char *_buffer, std::size_t _capacity)
       {
-        // Erase the space
-        dayString.erase(dayString.length() - 1);
-        try
-        {
-          numberDays = std::stoi(dayString);
-        }
-        catch (const std::out_of_range &)
-        {
-          return false;
-        }
-      }
-
-      if (!hourString.empty())
-      {
-        // Erase the colon
-        hourString.erase(hourString.length() - 1);
-        numberHours = std::stoi(hourString);
-      }
+        return toChars(_buffer, _capacity, _number, _precision);
+      });
+    }
 
-      if (!minuteString.empty())
+    /////////////////////////////////////////////
+    void appendToString(std::string &_out, float _number, int _precision)
+    {
+      appendWith(_out, 32, [&](char *_buffer, std::size_t _capacity)
       {
-        // Erase the colon
-        minuteString.erase(minuteString.length() - 1);
-        numberMinutes = std::stoi(minuteString);
-      }
+        return toChars(_buffer, _capacity, _number, _precision);
+      });
+    }
 
-      if (!secondString.empty())
+    /////////////////////////////////////////////
+    void appendToString(std::string &_out, int _number, int)
+    {
+      appendWith(_out, 16, [&](char *_buffer, std::size_t _capacity)
       {
-        numberSeconds = std::stoi(secondString);
-      }
+        return toChars(_buffer, _capacity, _number);
+      });
+    }
 
-      if (!millisecondString.empty())
+    /////////////////////////////////////////////
+    void appendToString(std::string &_out,
+        const std::chrono::steady_clock::duration &_duration)
+    {
+      appendWith(_out, 32, [&](char *_buffer, std::size_t _capacity)
       {
-        // Erase the period
-        millisecondString.erase(0, 1);
+        return toChars(_buffer, _capacity, _duration);
+      });
+    }
 
-        // Multiplier because "4" = 400 ms, "04" = 40 ms, and "004" = 4 ms
-        numberMilliseconds = std::stoi(millisecondString) *
-          static_cast<uint64_t>(1000 / pow(10, millisecondString.length()));
-      }
-      return true;
+    /////////////////////////////////////////////
+    bool splitTimeBasedOnTimeRegex(
+        const std::string &_timeString,
+        uint64_t & numberDays, uint64_t & numberHours,
+        uint64_t & numberMinutes, uint64_t & numberSeconds,
+        uint64_t & numberMilliseconds)
+    {
+      return parseTimeString(_timeString, numberDays, numberHours,
+                             numberMinutes, numberSeconds,
+                             numberMilliseconds);
     }
 
     /////////////////////////////////////////////
     std::chrono::steady_clock::duration stringToDuration(
         const std::string &_timeString)
     {
-      using namespace std::chrono_literals;
       std::chrono::steady_clock::duration duration{
         std::chrono::steady_clock::duration::zero()};
-
-      if (_timeString.empty())
-        return duration;
-
-      uint64_t numberDays = 0;
-      uint64_t numberHours = 0;
-      uint64_t numberMinutes = 0;
-      uint64_t numberSeconds = 0;
-      uint64_t numberMilliseconds = 0;
-
-      if (!splitTimeBasedOnTimeRegex(_timeString, numberDays, numberHours,
-                                     numberMinutes, numberSeconds,
-                                     numberMilliseconds))
-      {
-        return duration;
-      }
-
-      // TODO(anyone): Replace below day conversion with std::chrono::days.
-      /// This will exist in C++-20
-      duration = std::chrono::steady_clock::duration::zero();
-      auto delta = std::chrono::milliseconds(numberMilliseconds) +
-        std::chrono::seconds(numberSeconds) +
-        std::chrono::minutes(numberMinutes) +
-        std::chrono::hours(numberHours) +
-        std::chrono::hours(24 * numberDays);
-      duration += delta;
-
+      parseDuration(_timeString, duration);
       return duration;
     }
 
@@ -319,33 +1108,50 @@ namespace gz
       using namespace std::chrono_literals;
       std::chrono::steady_clock::time_point timePoint{-1s};
 
-      if (_timeString.empty())
-        return timePoint;
+      std::chrono::steady_clock::duration duration;
+      if (!_timeString.empty() && parseDuration(_timeString, duration))
+        timePoint = math::secNsecToTimePoint(0, 0) + duration;
 
-      uint64_t numberDays = 0;
-      uint64_t numberHours = 0;
-      uint64_t numberMinutes = 0;
-      uint64_t numberSeconds = 0;
-      uint64_t numberMilliseconds = 0;
+      return timePoint;
+    }
 
-      if (!splitTimeBasedOnTimeRegex(_timeString, numberDays, numberHours,
-                                     numberMinutes, numberSeconds,
-                                     numberMilliseconds))
+    /////////////////////////////////////////////
+    std::size_t stringsToDurations(std::string_view _buffer,
+        std::vector<std::chrono::steady_clock::duration> &_durations)
+    {
+      _durations.clear();
+      std::size_t valid = 0;
+      forEachLine(_buffer, [&](std::string_view _line)
       {
-        return timePoint;
-      }
-
-      // TODO(anyone): Replace below day conversion with std::chrono::days.
-      /// This will exist in C++-20
-      timePoint = math::secNsecToTimePoint(0, 0);
-      auto duration = std::chrono::milliseconds(numberMilliseconds) +
-        std::chrono::seconds(numberSeconds) +
-        std::chrono::minutes(numberMinutes) +
-        std::chrono::hours(numberHours) +
-        std::chrono::hours(24 * numberDays);
-      timePoint += duration;
+        std::chrono::steady_clock::duration duration{
+          std::chrono::steady_clock::duration::zero()};
+        if (parseDuration(_line, duration))
+          ++valid;
+        _durations.push_back(duration);
+      });
+      return valid;
+    }
 
-      return timePoint;
+    /////////////////////////////////////////////
+    std::size_t stringsToTimePoints(std::string_view _buffer,
+        std::vector<std::chrono::steady_clock::time_point> &_timePoints)
+    {
+      using namespace std::chrono_literals;
+      _timePoints.clear();
+      std::size_t valid = 0;
+      const auto zero = math::secNsecToTimePoint(0, 0);
+      forEachLine(_buffer, [&](std::string_view _line)
+      {
+        std::chrono::steady_clock::time_point timePoint{-1s};
+        std::chrono::steady_clock::duration duration;
+        if (!_line.empty() && parseDuration(_line, duration))
+        {
+          timePoint = zero + duration;
+          ++valid;
+        }
+        _timePoints.push_back(timePoint);
+      });
+      return valid;
     }
 
     /////////////////////////////////////////////
@@ -389,6 +1195,101 @@ namespace gz
         std::make_tuple(static_cast<PairInput>(_key - sq),
                         static_cast<PairInput>(sqrt));
     }
+
+    /////////////////////////////////////////////
+    uint64_t Pair64(const uint32_t _a, const uint32_t _b)
+    {
+      const uint64_t a = _a;
+      const uint64_t b = _b;
+
+      // Szudzik's function. The largest key, for two UINT32_MAX values, is
+      // UINT64_MAX.
+      return a >= b ? a * a + a + b : a + b * b;
+    }
+
+    /////////////////////////////////////////////
+    void Pair64(const uint32_t *_a, const uint32_t *_b, uint64_t *_keys,
+                const std::size_t _count)
+    {
+      for (std::size_t i = 0; i < _count; ++i)
+        _keys[i] = Pair64(_a[i], _b[i]);
+    }
+
+    /////////////////////////////////////////////
+    std::tuple<uint32_t, uint32_t> Unpair64(const uint64_t _key)
+    {
+      // Integer square root, from a floating point estimate that is off by
+      // at most one for 64 bit values
+      uint64_t sqrt = std::min<uint64_t>(
+          static_cast<uint64_t>(std::sqrt(static_cast<double>(_key))),
+          0xffffffffu);
+      if (sqrt * sqrt > _key)
+        --sqrt;
+      else if (sqrt < 0xffffffffu && (sqrt + 1) * (sqrt + 1) <= _key)
+        ++sqrt;
+
+      const uint64_t rest = _key - sqrt * sqrt;
+      return rest >= sqrt ?
+        std::make_tuple(static_cast<uint32_t>(sqrt),
+                        static_cast<uint32_t>(rest - sqrt)) :
+        std::make_tuple(static_cast<uint32_t>(rest),
+                        static_cast<uint32_t>(sqrt));
+    }
+
+    /////////////////////////////////////////////
+    void Unpair64(const uint64_t *_keys, uint32_t *_a, uint32_t *_b,
+                  const std::size_t _count)
+    {
+      for (std::size_t i = 0; i < _count; ++i)
+        std::tie(_a[i], _b[i]) = Unpair64(_keys[i]);
+    }
+
+    /////////////////////////////////////////////
+    uint64_t MortonEncode(const uint32_t _x, const uint32_t _y,
+                          const uint32_t _z)
+    {
+      return spreadBits(_x) | spreadBits(_y) << 1 | spreadBits(_z) << 2;
+    }
+
+    /////////////////////////////////////////////
+    void MortonEncode(const uint32_t *_x, const uint32_t *_y,
+        const uint32_t *_z, uint64_t *_keys, const std::size_t _count)
+    {
+      for (std::size_t i = 0; i < _count; ++i)
+        _keys[i] = MortonEncode(_x[i], _y[i], _z[i]);
+    }
+
+    /////////////////////////////////////////////
+    std::tuple<uint32_t, uint32_t, uint32_t> MortonDecode(
+        const uint64_t _key)
+    {
+      return std::make_tuple(gatherBits(_key), gatherBits(_key >> 1),
+                             gatherBits(_key >> 2));
+    }
+
+    /////////////////////////////////////////////
+    uint64_t MortonEncode(const Vector3<int> &_cell)
+    {
+      return MortonEncode(static_cast<uint32_t>(_cell.X() + kMortonOffset),
+                          static_cast<uint32_t>(_cell.Y() + kMortonOffset),
+                          static_cast<uint32_t>(_cell.Z() + kMortonOffset));
+    }
+
+    /////////////////////////////////////////////
+    void MortonEncode(const Vector3<int> *_cells, uint64_t *_keys,
+                      const std::size_t _count)
+    {
+      for (std::size_t i = 0; i < _count; ++i)
+        _keys[i] = MortonEncode(_cells[i]);
+    }
+
+    /////////////////////////////////////////////
+    void MortonDecode(const uint64_t _key, Vector3<int> &_cell)
+    {
+      _cell.Set(static_cast<int>(gatherBits(_key)) - kMortonOffset,
+                static_cast<int>(gatherBits(_key >> 1)) - kMortonOffset,
+                static_cast<int>(gatherBits(_key >> 2)) - kMortonOffset);
+    }
     }
   }
 }
@@ -20,6 +20,9 @@
 #include <iomanip>
 #include <cmath>
 #include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include "gz/math/Rand.hh"
 #include "gz/math/Vector3.hh"
@@ -338,6 +341,174 @@ TEST(HelpersTest, Stats)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(HelpersTest, ArrayStats)
+{
+  // Empty arrays
+  EXPECT_TRUE(std::isnan(math::mean(static_cast<const double *>(nullptr),
+                                    0)));
+  EXPECT_TRUE(std::isnan(math::variance(static_cast<const float *>(nullptr),
+                                        0)));
+  const std::pair<double, double> emptyRange =
+    math::minmax(static_cast<const double *>(nullptr), 0);
+  EXPECT_EQ(math::INF_D, emptyRange.first);
+  EXPECT_EQ(-math::INF_D, emptyRange.second);
+  EXPECT_EQ(std::make_pair(math::MAX_I32, math::LOW_I32),
+            math::minmax(std::vector<int>()));
+
+  const std::vector<int> ints{3, -7, 12, 0};
+  EXPECT_EQ(std::make_pair(-7, 12), math::minmax(ints));
+  EXPECT_EQ(-7, math::min(ints.data(), ints.size()));
+  EXPECT_EQ(12, math::max(ints.data(), ints.size()));
+
+  // NaN values are ignored
+  const double nan = math::NAN_D;
+  const std::vector<double> withNaN{nan, 2, -1, nan, 5};
+  EXPECT_EQ(std::make_pair(-1.0, 5.0), math::minmax(withNaN));
+
+  // Values with a large offset and a small spread, whose variance the
+  // textbook formula, mean of squares minus squared mean, loses entirely,
+  // across several blocks and thread chunks
+  const std::size_t count = 300001;
+  std::vector<double> values(count);
+  std::vector<float> floats(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    values[i] = 1e9 + static_cast<double>(i % 7) - 3;
+    floats[i] = 1e4f + static_cast<float>(i % 7) - 3;
+  }
+  // Statistics of the values without the offset, which are exact enough
+  double exactMean = 0;
+  double exactVariance = 0;
+  for (std::size_t i = 0; i < count; ++i)
+    exactMean += static_cast<double>(i % 7) - 3;
+  exactMean /= count;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const double d = static_cast<double>(i % 7) - 3 - exactMean;
+    exactVariance += d * d;
+  }
+  exactVariance /= count;
+
+  for (const unsigned int threads : {1u, 3u, 0u})
+  {
+    double m = 0;
+    double v = 0;
+    math::meanAndVariance(values.data(), count, m, v, threads);
+    EXPECT_NEAR(1e9 + exactMean, m, 1e-6);
+    EXPECT_NEAR(exactVariance, v, 1e-9);
+    EXPECT_DOUBLE_EQ(m, math::mean(values.data(), count, threads));
+    EXPECT_DOUBLE_EQ(v, math::variance(values.data(), count, threads));
+
+    float mf = 0;
+    float vf = 0;
+    math::meanAndVariance(floats.data(), count, mf, vf, threads);
+    EXPECT_NEAR(1e4 + exactMean, mf, 1e-3);
+    EXPECT_NEAR(exactVariance, vf, 1e-5);
+    EXPECT_FLOAT_EQ(mf, math::mean(floats.data(), count, threads));
+    EXPECT_FLOAT_EQ(vf, math::variance(floats.data(), count, threads));
+  }
+
+  // The vector functions of floating point values use the same algorithm
+  EXPECT_NEAR(exactVariance, math::variance(values), 1e-9);
+  EXPECT_NEAR(1e9 + exactMean, math::mean(values), 1e-6);
+
+  const auto range = math::minmax(values);
+  EXPECT_DOUBLE_EQ(1e9 - 3, range.first);
+  EXPECT_DOUBLE_EQ(1e9 + 3, range.second);
+  EXPECT_DOUBLE_EQ(1e9 - 3, math::min(values.data(), count));
+  EXPECT_DOUBLE_EQ(1e9 + 3, math::max(values.data(), count));
+}
+
+/////////////////////////////////////////////////
+TEST(HelpersTest, ArrayKernels)
+{
+  // Check the array kernels against the scalar functions
+  auto check = [](auto _zero)
+  {
+    using T = decltype(_zero);
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+    const T inf = std::numeric_limits<T>::infinity();
+    std::vector<T> in = {0, T(-0.0), nan, -nan, inf, -inf, T(0.5), T(-0.5),
+      T(1.5), T(2.5), T(-2.5), T(0.125), T(1.005), T(-1.005), T(1e15),
+      T(-4503599627370497.0), std::numeric_limits<T>::max(),
+      std::numeric_limits<T>::denorm_min()};
+    math::Rand::Seed(3);
+    for (int i = 0; i < 10000; ++i)
+    {
+      // Halfway cases of the rounding, and random values
+      in.push_back(static_cast<T>(math::Rand::IntUniform(-100000, 100000)) /
+                   T(200));
+      in.push_back(static_cast<T>(math::Rand::DblUniform(-1e6, 1e6)));
+    }
+    const std::size_t count = in.size();
+    std::vector<T> out(count);
+
+    // Same values, NaN equal to NaN
+    auto same = [](const T _a, const T _b)
+    {
+      GZ_UTILS_WARN_IGNORE__FLOAT_EQUAL
+      return (std::isnan(_a) && std::isnan(_b)) ||
+        (_a == _b && std::signbit(_a) == std::signbit(_b));
+      GZ_UTILS_WARN_RESUME__FLOAT_EQUAL
+    };
+
+    math::clamp(in.data(), out.data(), count, T(-3), T(1000));
+    for (std::size_t i = 0; i < count; ++i)
+      EXPECT_TRUE(same(math::clamp(in[i], T(-3), T(1000)), out[i])) << i;
+
+    math::fixnan(in.data(), out.data(), count);
+    for (std::size_t i = 0; i < count; ++i)
+      EXPECT_TRUE(same(math::fixnan(in[i]), out[i])) << i;
+
+    math::sanitize(in.data(), out.data(), count, T(0.1), T(30), T(-1));
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const T expected = std::isnan(in[i]) ? T(-1) :
+        math::clamp(in[i], T(0.1), T(30));
+      EXPECT_TRUE(same(expected, out[i])) << i;
+    }
+
+    for (const unsigned int precision : {0u, 1u, 2u, 3u, 6u})
+    {
+      math::precision(in.data(), out.data(), count, precision);
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        EXPECT_TRUE(same(math::precision(in[i], precision), out[i]))
+          << i << " " << in[i] << " " << precision;
+      }
+    }
+
+    // In place
+    std::vector<T> values = in;
+    math::clamp(values.data(), values.data(), count, T(-3), T(1000));
+    math::clamp(in.data(), out.data(), count, T(-3), T(1000));
+    for (std::size_t i = 0; i < count; ++i)
+      EXPECT_TRUE(same(out[i], values[i])) << i;
+
+    std::vector<T> shifted(count);
+    for (std::size_t i = 0; i < count; ++i)
+      shifted[i] = in[i] + T(i % 3) * T(1e-3);
+    std::unique_ptr<bool[]> mask(new bool[count]);
+    std::size_t equalCount = 0;
+    for (std::size_t i = 0; i < count; ++i)
+      equalCount += math::equal(in[i], shifted[i], T(1e-4));
+    EXPECT_EQ(equalCount, math::equal(in.data(), shifted.data(), mask.get(),
+                                      count, T(1e-4)));
+    EXPECT_EQ(equalCount, math::equal(in.data(), shifted.data(), nullptr,
+                                      count, T(1e-4)));
+    for (std::size_t i = 0; i < count; ++i)
+      EXPECT_EQ(math::equal(in[i], shifted[i], T(1e-4)), mask[i]) << i;
+
+    EXPECT_EQ(2u, math::isnan(in.data(), mask.get(), count));
+    EXPECT_EQ(2u, math::isnan(in.data(), nullptr, count));
+    for (std::size_t i = 0; i < count; ++i)
+      EXPECT_EQ(math::isnan(in[i]), mask[i]) << i;
+  };
+  check(0.0f);
+  check(0.0);
+}
+
 /////////////////////////////////////////////////
 TEST(HelpersTest, Sort)
 {
@@ -547,6 +718,92 @@ TEST(HelpersTest, Pair)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(HelpersTest, Pair64)
+{
+  // The largest values make the largest key, on every platform
+  EXPECT_EQ(math::MAX_UI64, math::Pair64(math::MAX_UI32, math::MAX_UI32));
+  EXPECT_EQ(std::make_tuple(math::MAX_UI32, math::MAX_UI32),
+            math::Unpair64(math::MAX_UI64));
+  EXPECT_EQ(0u, math::Pair64(0, 0));
+
+  // Pair64 matches Pair where Pair has 32 bit inputs
+  EXPECT_EQ(math::Pair(10, 3), math::Pair64(10, 3));
+  EXPECT_EQ(math::Pair(3, 10), math::Pair64(3, 10));
+
+  std::vector<uint32_t> a, b;
+  for (uint32_t i = 0; i < 1000; ++i)
+  {
+    a.push_back(i * 4294967u);
+    b.push_back(math::MAX_UI32 - i * i * 17u);
+  }
+  // Values around perfect squares, where a floating point square root is
+  // the least accurate
+  a.push_back(math::MAX_UI32 - 1);
+  b.push_back(math::MAX_UI32);
+  a.push_back(math::MAX_UI32);
+  b.push_back(math::MAX_UI32 - 1);
+  a.push_back(94906265u);
+  b.push_back(94906266u);
+
+  std::vector<uint64_t> keys(a.size());
+  math::Pair64(a.data(), b.data(), keys.data(), a.size());
+  std::vector<uint32_t> c(a.size()), d(a.size());
+  math::Unpair64(keys.data(), c.data(), d.data(), keys.size());
+  for (std::size_t i = 0; i < a.size(); ++i)
+  {
+    EXPECT_EQ(math::Pair64(a[i], b[i]), keys[i]);
+    EXPECT_EQ(a[i], c[i]);
+    EXPECT_EQ(b[i], d[i]);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(HelpersTest, Morton)
+{
+  EXPECT_EQ(0u, math::MortonEncode(0u, 0u, 0u));
+  EXPECT_EQ(1u, math::MortonEncode(1u, 0u, 0u));
+  EXPECT_EQ(2u, math::MortonEncode(0u, 1u, 0u));
+  EXPECT_EQ(4u, math::MortonEncode(0u, 0u, 1u));
+  EXPECT_EQ(7u << 3, math::MortonEncode(2u, 2u, 2u));
+  EXPECT_EQ(0x7fffffffffffffffu,
+            math::MortonEncode(0x1fffffu, 0x1fffffu, 0x1fffffu));
+
+  // Only the lower 21 bits are used
+  EXPECT_EQ(math::MortonEncode(5u, 6u, 7u),
+            math::MortonEncode(5u | 1u << 21, 6u, 7u));
+
+  std::vector<uint32_t> x, y, z;
+  for (uint32_t i = 0; i < 500; ++i)
+  {
+    x.push_back(i * 4099u & 0x1fffffu);
+    y.push_back(0x1fffffu - i);
+    z.push_back(i * i);
+  }
+  std::vector<uint64_t> keys(x.size());
+  math::MortonEncode(x.data(), y.data(), z.data(), keys.data(), x.size());
+  for (std::size_t i = 0; i < x.size(); ++i)
+  {
+    EXPECT_EQ(math::MortonEncode(x[i], y[i], z[i]), keys[i]);
+    EXPECT_EQ(std::make_tuple(x[i], y[i], z[i]),
+              math::MortonDecode(keys[i]));
+  }
+
+  // Signed cell coordinates
+  const std::vector<math::Vector3i> cells = {
+    {0, 0, 0}, {-1, 0, 0}, {-(1 << 20), (1 << 20) - 1, 5}, {7, -8, 9}};
+  std::vector<uint64_t> cellKeys(cells.size());
+  math::MortonEncode(cells.data(), cellKeys.data(), cells.size());
+  for (std::size_t i = 0; i < cells.size(); ++i)
+  {
+    EXPECT_EQ(math::MortonEncode(cells[i]), cellKeys[i]);
+    math::Vector3i cell;
+    math::MortonDecode(cellKeys[i], cell);
+    EXPECT_EQ(cells[i], cell);
+  }
+  EXPECT_NE(cellKeys[0], cellKeys[1]);
+}
+
 /////////////////////////////////////////////////
 TEST(HelpersTest, timePointToSecNsec)
 {
@@ -639,6 +896,50 @@ TEST(HelpersTest, durationToString)
   EXPECT_STREQ(s.c_str(), std::string("00 00:01:23.125").c_str());
 }
 
+/////////////////////////////////////////////////
+TEST(HelpersTest, toChars)
+{
+  using namespace std::chrono_literals;
+
+  char buffer[32];
+  std::size_t size = math::toChars(buffer, sizeof(buffer), 0.1);
+  EXPECT_EQ("0.1", std::string(buffer, size));
+  size = math::toChars(buffer, sizeof(buffer), -0.0);
+  EXPECT_EQ("0", std::string(buffer, size));
+  size = math::toChars(buffer, sizeof(buffer), 2.0 / 3, 4);
+  EXPECT_EQ("0.6667", std::string(buffer, size));
+  size = math::toChars(buffer, sizeof(buffer), 0.1f);
+  EXPECT_EQ("0.1", std::string(buffer, size));
+  size = math::toChars(buffer, sizeof(buffer), -42);
+  EXPECT_EQ("-42", std::string(buffer, size));
+
+  // Too small buffers
+  EXPECT_EQ(0u, math::toChars(buffer, 3, 1.0 / 3));
+  EXPECT_EQ(0u, math::toChars(buffer, 10, 1.0 / 3, 10));
+
+  const std::chrono::steady_clock::duration duration =
+    24h * 3 + 4h + 5min + 6s + 7ms;
+  size = math::toChars(buffer, sizeof(buffer), duration);
+  EXPECT_EQ(math::durationToString(duration), std::string(buffer, size));
+  EXPECT_EQ("03 04:05:06.007", std::string(buffer, size));
+  EXPECT_EQ(0u, math::toChars(buffer, 14, duration));
+
+  // Append to a string reused across records
+  std::string out;
+  for (int i = 0; i < 3; ++i)
+  {
+    out.clear();
+    math::appendToString(out, duration);
+    out += ',';
+    math::appendToString(out, i);
+    out += ',';
+    math::appendToString(out, 1e300, 1);
+  }
+  // The fixed notation of 1e300 has 301 digits
+  EXPECT_EQ(0u, out.find("03 04:05:06.007,2,1000000000000000052"));
+  EXPECT_EQ(18u + 301u + 2u, out.size());
+}
+
 /////////////////////////////////////////////////
 TEST(HelpersTest, stringToDuration)
 {
@@ -921,6 +1222,108 @@ TEST(HelpersTest, stringToTimePoint)
   EXPECT_EQ(resultTime, negTime);
 }
 
+/////////////////////////////////////////////////
+TEST(HelpersTest, parseStringView)
+{
+  const std::string_view text = "12 -3.5e2 0x1p3 junk";
+  EXPECT_EQ(12, math::parseInt(text.substr(0, 2)));
+  EXPECT_EQ(-3, math::parseInt(text.substr(2, 4)));
+  EXPECT_EQ(math::NAN_I, math::parseInt(text.substr(16)));
+  EXPECT_EQ(0, math::parseInt(std::string_view("   ")));
+  EXPECT_EQ(math::NAN_I, math::parseInt(std::string_view()));
+  EXPECT_EQ(math::NAN_I, math::parseInt("2147483648"));
+  EXPECT_EQ(7, math::parseInt("+7"));
+  EXPECT_EQ(math::NAN_I, math::parseInt("+-7"));
+
+  EXPECT_DOUBLE_EQ(12.0, math::parseFloat(text.substr(0, 2)));
+  EXPECT_DOUBLE_EQ(-350.0, math::parseFloat(text.substr(2, 7)));
+  EXPECT_DOUBLE_EQ(8.0, math::parseFloat(text.substr(10, 5)));
+  EXPECT_TRUE(math::isnan(math::parseFloat(text.substr(16))));
+  EXPECT_DOUBLE_EQ(0.5, math::parseFloat(std::string("\t+.5")));
+  EXPECT_TRUE(std::isinf(math::parseFloat("-inf")));
+  EXPECT_TRUE(math::isnan(math::parseFloat("nan")));
+  EXPECT_TRUE(math::isnan(math::parseFloat("1e400")));
+  EXPECT_DOUBLE_EQ(0.0, math::parseFloat("0xg"));
+}
+
+/////////////////////////////////////////////////
+TEST(HelpersTest, parseFloats)
+{
+  std::vector<double> values = {1.0};
+  EXPECT_TRUE(math::parseFloats(" 1 -2.5\n3e2\t0x10  ", values));
+  EXPECT_EQ(std::vector<double>({1, -2.5, 300, 16}), values);
+
+  EXPECT_TRUE(math::parseFloats("", values));
+  EXPECT_TRUE(values.empty());
+
+  // Parsing stops at the first token that isn't a number
+  EXPECT_FALSE(math::parseFloats("1 2 3,4 5", values));
+  EXPECT_EQ(std::vector<double>({1, 2}), values);
+  EXPECT_FALSE(math::parseFloats("1 abc", values));
+  EXPECT_EQ(std::vector<double>({1}), values);
+
+  std::vector<math::Vector3d> vectors;
+  EXPECT_TRUE(math::parseVector3s("1 2 3\n4 5 6\n", vectors));
+  ASSERT_EQ(2u, vectors.size());
+  EXPECT_EQ(math::Vector3d(1, 2, 3), vectors[0]);
+  EXPECT_EQ(math::Vector3d(4, 5, 6), vectors[1]);
+
+  // An incomplete vector is an error
+  EXPECT_FALSE(math::parseVector3s("1 2 3 4", vectors));
+  ASSERT_EQ(1u, vectors.size());
+  EXPECT_FALSE(math::parseVector3s("1 2 x", vectors));
+  EXPECT_TRUE(vectors.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(HelpersTest, stringsToDurations)
+{
+  using namespace std::chrono_literals;
+
+  const std::string buffer =
+    "0 00:00:00.000\n"
+    "1 23:59:59.999\r\n"
+    "\n"
+    "24:00:00\n"
+    "12:30\n"
+    ".5\n";
+  std::vector<std::chrono::steady_clock::duration> durations = {1s};
+  EXPECT_EQ(5u, math::stringsToDurations(buffer, durations));
+  ASSERT_EQ(6u, durations.size());
+  EXPECT_EQ(0s, durations[0]);
+  EXPECT_EQ(math::stringToDuration("1 23:59:59.999"), durations[1]);
+  EXPECT_EQ(0s, durations[2]);
+  EXPECT_EQ(0s, durations[3]);
+  EXPECT_EQ(12min + 30s, durations[4]);
+  EXPECT_EQ(500ms, durations[5]);
+
+  // The last line doesn't need a newline
+  EXPECT_EQ(2u, math::stringsToDurations("1\n2", durations));
+  ASSERT_EQ(2u, durations.size());
+  EXPECT_EQ(2s, durations[1]);
+
+  EXPECT_EQ(0u, math::stringsToDurations("", durations));
+  EXPECT_TRUE(durations.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(HelpersTest, stringsToTimePoints)
+{
+  using namespace std::chrono_literals;
+
+  std::chrono::steady_clock::time_point zeroTime{0s};
+  std::chrono::steady_clock::time_point negTime{-1s};
+
+  std::vector<std::chrono::steady_clock::time_point> points;
+  EXPECT_EQ(2u, math::stringsToTimePoints("00:01:00\n\n5 :00\n1.25\n",
+      points));
+  ASSERT_EQ(4u, points.size());
+  EXPECT_EQ(zeroTime + 1min, points[0]);
+  EXPECT_EQ(negTime, points[1]);
+  EXPECT_EQ(negTime, points[2]);
+  EXPECT_EQ(zeroTime + 1s + 250ms, points[3]);
+}
+
 /////////////////////////////////////////////////
 TEST(HelpersTest, durationToSecNsec)
 {
@@ -980,6 +1383,39 @@ TEST(HelpersTest, roundUpMultiple)
   EXPECT_EQ(-2, math::roundUpMultiple(-2, -2));
 }
 
+/////////////////////////////////////////////////
+TEST(HelpersTest, fastInverseSqrt)
+{
+  // Relative errors over the whole range of normal values
+  double maxError = 0;
+  double maxErrorFloat = 0;
+  for (double e = -1000; e <= 1000; e += 0.37)
+  {
+    const double v = std::exp2(e);
+    maxError = std::max(maxError,
+        std::abs(math::fastInverseSqrt(v) * std::sqrt(v) - 1.0));
+    if (std::abs(e) < 120)
+    {
+      const float f = static_cast<float>(v);
+      maxErrorFloat = std::max(maxErrorFloat, std::abs(
+          math::fastInverseSqrt(f) * std::sqrt(static_cast<double>(f)) -
+          1.0));
+    }
+  }
+  EXPECT_LT(maxError, 4e-11);
+  EXPECT_LT(maxErrorFloat, 5e-6);
+  EXPECT_GT(maxErrorFloat, 0.0);
+
+  EXPECT_NEAR(0.5, math::fastInverseSqrt(4.0), 2e-11);
+  EXPECT_NEAR(0.1f, math::fastInverseSqrt(100.0f), 1e-6f);
+
+  // Zero gives a finite value, and NaN stays NaN
+  EXPECT_TRUE(std::isfinite(math::fastInverseSqrt(0.0)));
+  EXPECT_TRUE(std::isfinite(math::fastInverseSqrt(0.0f)));
+  EXPECT_DOUBLE_EQ(0.0, 0.0 * math::fastInverseSqrt(0.0));
+  EXPECT_TRUE(std::isnan(math::fastInverseSqrt(math::NAN_D)));
+}
+
 /////////////////////////////////////////////////
 TEST(HelpersTest, AppendToStream)
 {
@@ -17,6 +17,7 @@
 
 #include <gtest/gtest.h>
 #include <cmath>
+#include <vector>
 
 #include "gz/math/Inertial.hh"
 
@@ -741,6 +742,98 @@ TEST(Inertiald_Test, SubtractionInvalid)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(Inertiald_Test, Sum)
+{
+  // Two half-cubes make a cube
+  {
+    math::MassMatrix3d cubeMM3;
+    EXPECT_TRUE(cubeMM3.SetFromBox(12.0, math::Vector3d(1, 1, 1)));
+    const math::Inertiald cube(cubeMM3, math::Pose3d(10, 20, 30, 0, 0, 0));
+    math::MassMatrix3d half;
+    EXPECT_TRUE(half.SetFromBox(6.0, math::Vector3d(0.5, 1, 1)));
+    const math::Inertiald halves[] = {
+        math::Inertiald(half, math::Pose3d(9.75, 20, 30, 0, 0, 0)),
+        math::Inertiald(half, math::Pose3d(10.25, 20, 30, 0, 0, 0))};
+    EXPECT_EQ(cube, math::Inertiald::Sum(halves, 2));
+  }
+
+  // Same as adding one at a time
+  std::vector<math::Inertiald> links;
+  for (int i = 0; i < 20; ++i)
+  {
+    math::MassMatrix3d m;
+    EXPECT_TRUE(m.SetFromBox(1.0 + 0.5 * i,
+        math::Vector3d(0.2 + 0.1 * i, 0.5, 1.0 - 0.02 * i)));
+    links.push_back(math::Inertiald(m, math::Pose3d(
+        0.3 * i, -0.1 * i, 0.05 * i * i, 0.1 * i, -0.2, 0.3 * i)));
+  }
+  math::Inertiald expected = links[0];
+  for (std::size_t i = 1; i < links.size(); ++i)
+    expected += links[i];
+  const math::Inertiald sum =
+      math::Inertiald::Sum(links.data(), links.size());
+  EXPECT_NEAR(expected.MassMatrix().Mass(), sum.MassMatrix().Mass(), 1e-9);
+  EXPECT_EQ(expected.Pose(), sum.Pose());
+  for (int i = 0; i < 3; ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      EXPECT_NEAR(expected.Moi()(i, j), sum.Moi()(i, j), 1e-9);
+    }
+  }
+
+  EXPECT_EQ(links[3], math::Inertiald::Sum(&links[3], 1));
+
+  // No inertials or no mass
+  EXPECT_EQ(math::Inertiald(), math::Inertiald::Sum(nullptr, 0));
+  EXPECT_EQ(math::Inertiald(), math::Inertiald::Sum(links.data(), 0));
+  const math::Inertiald massless[] = {math::Inertiald(), math::Inertiald()};
+  EXPECT_EQ(massless[0], math::Inertiald::Sum(massless, 2));
+}
+
+/////////////////////////////////////////////////
+TEST(Inertiald_Test, ToWorld)
+{
+  std::vector<math::Inertiald> links;
+  std::vector<math::Pose3d> poses;
+  for (int i = 0; i < 20; ++i)
+  {
+    math::MassMatrix3d m(1.0 + 0.5 * i,
+        math::Vector3d(2.0 + 0.1 * i, 3.0, 4.0 - 0.05 * i),
+        math::Vector3d(0.1, -0.2 + 0.01 * i, 0.3));
+    links.push_back(math::Inertiald(m, math::Pose3d(
+        0.3 * i, -0.1 * i, 0.05 * i * i, 0.1 * i, -0.2, 0.3 * i)));
+    poses.push_back(math::Pose3d(
+        -1.0 + i, 2.0, 0.5 * i, -0.7 + 0.2 * i, 0.4, 0.15 * i));
+  }
+
+  std::vector<math::Matrix3d> moi(links.size());
+  std::vector<math::Vector3d> com(links.size());
+  math::Inertiald::ToWorld(links.data(), poses.data(), moi.data(),
+      com.data(), links.size());
+  for (std::size_t i = 0; i < links.size(); ++i)
+  {
+    const math::Matrix3d r(poses[i].Rot());
+    const math::Matrix3d expected = r * links[i].Moi() * r.Transposed();
+    for (int j = 0; j < 3; ++j)
+    {
+      for (int k = 0; k < 3; ++k)
+      {
+        EXPECT_NEAR(expected(j, k), moi[i](j, k), 1e-9) << i;
+      }
+    }
+    EXPECT_EQ(moi[i], moi[i].Transposed());
+    EXPECT_EQ((poses[i] * links[i].Pose()).Pos(), com[i]) << i;
+  }
+
+  // The center of mass is optional
+  std::vector<math::Matrix3d> moiOnly(links.size());
+  math::Inertiald::ToWorld(links.data(), poses.data(), moiOnly.data(),
+      nullptr, links.size());
+  EXPECT_EQ(moi, moiOnly);
+}
+
 /////////////////////////////////////////////////
 TEST(Inertiald_Test, BodyMatrix)
 {
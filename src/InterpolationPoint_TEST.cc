@@ -109,3 +109,55 @@ TEST(Interpolation, TrilinearInterpolate)
   auto v3 = TrilinearInterpolate(vec, values, Vector3d{1, 1, 1});
   EXPECT_NEAR(v3, 1, 1e-3);
 }
+
+TEST(Interpolation, InterpolationWeights)
+{
+  InterpolationPoints3D<double> points;
+  const Vector3d positions[8] = {
+    {0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0},
+    {0, 0, 1}, {1, 0, 1}, {0, 1, 1}, {1, 1, 1}};
+  for (std::size_t i = 0; i < 8; ++i)
+    points.points[i] = InterpolationPoint3D<double>{positions[i], i};
+  points.count = 8;
+
+  std::vector<double> values {3, -1, 0.5, 2, 7, 1, -4, 0};
+  std::array<double, 8> weights;
+  for (const auto &pos : {Vector3d{0.5, 0.5, 0.5}, Vector3d{0.1, 0.7, 0.3},
+                          Vector3d{1, 1, 1}, Vector3d{0, 0.2, 1}})
+  {
+    ASSERT_TRUE(InterpolationWeights(points, pos, weights));
+    double sum = 0;
+    double value = 0;
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      sum += weights[i];
+      value += weights[i] * values[i];
+    }
+    EXPECT_NEAR(1.0, sum, 1e-12);
+    EXPECT_NEAR(TrilinearInterpolate(points.points.data(), values, pos),
+      value, 1e-12);
+
+    // Two channels, the second one scaled
+    std::vector<double> interleaved;
+    for (double v : values)
+    {
+      interleaved.push_back(v);
+      interleaved.push_back(10 * v);
+    }
+    double out[2] = {0, 0};
+    AccumulateInterpolatedChannels(points, weights, interleaved.data(), 2,
+      0.0, out);
+    EXPECT_NEAR(value, out[0], 1e-12);
+    EXPECT_NEAR(10 * value, out[1], 1e-12);
+  }
+
+  // Bilinear on the first face
+  points.count = 4;
+  ASSERT_TRUE(InterpolationWeights(points, Vector3d{0.25, 0.5, 0}, weights));
+  EXPECT_NEAR(BiLinearInterpolate(points.points.data(), values,
+      Vector3d{0.25, 0.5, 0}),
+    weights[0] * 3 - weights[1] + weights[2] * 0.5 + weights[3] * 2, 1e-12);
+
+  points.count = 0;
+  EXPECT_FALSE(InterpolationWeights(points, Vector3d::Zero, weights));
+}
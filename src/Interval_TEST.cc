@@ -15,7 +15,11 @@
  *
 */
 #include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <memory>
 #include <ostream>
+#include <vector>
 
 #include "gz/math/Interval.hh"
 
@@ -130,6 +134,62 @@ TEST(IntervalTest, IntervalMembership)
   EXPECT_TRUE(degenerateInterval.Contains(0.));
 }
 
+/////////////////////////////////////////////////
+TEST(IntervalTest, ClosedBounds)
+{
+  const double inf = std::numeric_limits<double>::infinity();
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const std::vector<math::Intervald> intervals = {
+      math::Intervald::Open(0., 1.), math::Intervald::LeftClosed(0., 1.),
+      math::Intervald::RightClosed(0., 1.), math::Intervald::Closed(0., 1.),
+      math::Intervald::Open(0., 0.), math::Intervald::Closed(0., 0.),
+      math::Intervald::Closed(1., 0.), math::Intervald::Unbounded,
+      math::Intervald::Closed(-inf, inf), math::Intervald::Open(nan, 1.),
+      math::Intervald()};
+  const std::vector<double> values = {
+      -inf, -1., 0., std::nextafter(0., 1.), 0.5, std::nextafter(1., 0.),
+      1., 2., inf, nan};
+
+  for (const math::Intervald &interval : intervals)
+  {
+    std::unique_ptr<bool[]> contained(new bool[values.size()]);
+    interval.Contains(values.data(), contained.get(), values.size());
+    const auto [min, max] = interval.ClosedBounds();
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+      EXPECT_EQ(interval.Contains(values[i]), contained[i])
+        << interval << " " << values[i];
+      EXPECT_EQ(interval.Contains(values[i]),
+                min <= values[i] && values[i] <= max)
+        << interval << " " << values[i];
+    }
+  }
+
+  const auto [min, max] = math::Intervald::Open(0., 1.).ClosedBounds();
+  EXPECT_DOUBLE_EQ(std::nextafter(0., 1.), min);
+  EXPECT_DOUBLE_EQ(std::nextafter(1., 0.), max);
+
+  const auto [minf, maxf] = math::Intervalf::LeftClosed(0.f, 1.f)
+      .ClosedBounds();
+  EXPECT_FLOAT_EQ(0.f, minf);
+  EXPECT_FLOAT_EQ(std::nextafter(1.f, 0.f), maxf);
+
+  // Integer intervals
+  using Intervali = math::Interval<int>;
+  EXPECT_EQ(std::make_pair(1, 4), Intervali::Open(0, 5).ClosedBounds());
+  EXPECT_EQ(std::make_pair(0, 5), Intervali::Closed(0, 5).ClosedBounds());
+  const int intMax = std::numeric_limits<int>::max();
+  const auto [imin, imax] = Intervali::Open(intMax, intMax).ClosedBounds();
+  EXPECT_GT(imin, imax);
+  const int values3[] = {-1, 0, 1, 5};
+  bool contained3[4];
+  Intervali::RightClosed(0, 5).Contains(values3, contained3, 4);
+  EXPECT_FALSE(contained3[0]);
+  EXPECT_FALSE(contained3[1]);
+  EXPECT_TRUE(contained3[2]);
+  EXPECT_TRUE(contained3[3]);
+}
+
 /////////////////////////////////////////////////
 TEST(IntervalTest, IntervalSubset)
 {
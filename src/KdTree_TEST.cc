@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "gz/math/KdTree.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/Vector3.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+/// \brief Random points in a cube, with some repeated points and points
+/// sharing coordinates to exercise the ties.
+std::vector<Vector3d> RandomPoints(const std::size_t _count)
+{
+  std::vector<Vector3d> points;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    if (i % 10 == 9)
+      points.push_back(points[i / 2]);
+    else if (i % 10 == 8)
+      points.emplace_back(points[i - 1].X(), Rand::DblUniform(-10, 10), 0.5);
+    else
+      points.emplace_back(Rand::DblUniform(-10, 10),
+                          Rand::DblUniform(-10, 10),
+                          Rand::DblUniform(-1, 1));
+  }
+  return points;
+}
+
+/// \brief Nearest points by a linear scan, ties ordered by index.
+std::vector<std::pair<double, std::size_t>> BruteNearest(
+    const std::vector<Vector3d> &_points, const Vector3d &_p,
+    const std::size_t _k)
+{
+  std::vector<std::pair<double, std::size_t>> all;
+  for (std::size_t i = 0; i < _points.size(); ++i)
+    all.emplace_back((_p - _points[i]).SquaredLength(), i);
+  std::sort(all.begin(), all.end());
+  all.resize(std::min(_k, all.size()));
+  return all;
+}
+}
+
+/////////////////////////////////////////////////
+TEST(KdTreeTest, Empty)
+{
+  KdTreed tree;
+  EXPECT_TRUE(tree.Empty());
+  EXPECT_EQ(0u, tree.Size());
+
+  std::size_t id = 5;
+  double distance = 1;
+  EXPECT_FALSE(tree.Nearest(Vector3d::Zero, id, distance));
+
+  std::vector<std::size_t> ids{1, 2};
+  std::vector<double> distances{1, 2};
+  tree.Nearest(Vector3d::Zero, 3, ids, distances);
+  EXPECT_TRUE(ids.empty());
+  EXPECT_TRUE(distances.empty());
+
+  tree.WithinDistance(Vector3d::Zero, 10, ids);
+  EXPECT_TRUE(ids.empty());
+
+  EXPECT_TRUE(tree.NearestBatch(nullptr, 0, 0, nullptr, nullptr));
+  Vector3d position;
+  EXPECT_FALSE(tree.NearestBatch(&position, 1, 1, &id, &distance));
+}
+
+/////////////////////////////////////////////////
+TEST(KdTreeTest, Small)
+{
+  const std::vector<Vector3d> points{
+    {0, 0, 0}, {1, 0, 0}, {0, 2, 0}, {0, 0, 3}, {1, 0, 0}};
+  KdTreed tree(points);
+  EXPECT_EQ(5u, tree.Size());
+
+  std::size_t id;
+  double distance;
+  ASSERT_TRUE(tree.Nearest(Vector3d(0.9, 0.1, 0), id, distance));
+  EXPECT_EQ(1u, id);
+  EXPECT_NEAR(std::sqrt(0.02), distance, 1e-12);
+
+  std::vector<std::size_t> ids;
+  std::vector<double> distances;
+  tree.Nearest(Vector3d(2, 0, 0), 10, ids, distances);
+  EXPECT_EQ((std::vector<std::size_t>{1, 4, 0, 2, 3}), ids);
+  EXPECT_DOUBLE_EQ(1.0, distances[0]);
+  EXPECT_DOUBLE_EQ(1.0, distances[1]);
+  EXPECT_DOUBLE_EQ(2.0, distances[2]);
+
+  tree.WithinDistance(Vector3d(0, 0, 0), 2, ids);
+  std::sort(ids.begin(), ids.end());
+  EXPECT_EQ((std::vector<std::size_t>{0, 1, 2, 4}), ids);
+
+  tree.WithinDistance(Vector3d(0, 0, 0), -1, ids);
+  EXPECT_TRUE(ids.empty());
+
+  tree.Clear();
+  EXPECT_TRUE(tree.Empty());
+}
+
+/////////////////////////////////////////////////
+TEST(KdTreeTest, MatchesLinearScan)
+{
+  Rand::Seed(7);
+  const std::vector<Vector3d> points = RandomPoints(3000);
+  KdTreed tree(points);
+
+  std::vector<std::size_t> ids;
+  std::vector<double> distances;
+  for (int q = 0; q < 200; ++q)
+  {
+    const Vector3d p = q % 4 == 0 ? points[q * 7] :
+        Vector3d(Rand::DblUniform(-12, 12), Rand::DblUniform(-12, 12),
+                 Rand::DblUniform(-2, 2));
+
+    const auto expected = BruteNearest(points, p, 7);
+    tree.Nearest(p, 7, ids, distances);
+    ASSERT_EQ(expected.size(), ids.size());
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+      EXPECT_EQ(expected[i].second, ids[i]) << q << " " << i;
+      EXPECT_DOUBLE_EQ(std::sqrt(expected[i].first), distances[i]);
+    }
+
+    const double radius = Rand::DblUniform(0, 3);
+    std::vector<std::size_t> within;
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+      if ((p - points[i]).SquaredLength() <= radius * radius)
+        within.push_back(i);
+    }
+    tree.WithinDistance(p, radius, ids);
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(within, ids) << q;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(KdTreeTest, ThreadsAndBatch)
+{
+  Rand::Seed(11);
+  const std::vector<Vector3d> points = RandomPoints(40000);
+  KdTreed serial;
+  serial.Build(points);
+  KdTreed parallel;
+  parallel.Build(points.data(), points.size(), 4);
+
+  std::vector<Vector3d> queries;
+  for (int i = 0; i < 3000; ++i)
+  {
+    queries.emplace_back(Rand::DblUniform(-10, 10),
+                         Rand::DblUniform(-10, 10),
+                         Rand::DblUniform(-1, 1));
+  }
+
+  const std::size_t k = 3;
+  std::vector<std::size_t> ids(queries.size() * k);
+  std::vector<double> distances(queries.size() * k);
+  ASSERT_TRUE(parallel.NearestBatch(queries.data(), queries.size(), k,
+                                    ids.data(), distances.data(), 3));
+
+  std::vector<std::size_t> expectedIds;
+  std::vector<double> expectedDistances;
+  for (std::size_t q = 0; q < queries.size(); ++q)
+  {
+    serial.Nearest(queries[q], k, expectedIds, expectedDistances);
+    for (std::size_t i = 0; i < k; ++i)
+    {
+      EXPECT_EQ(expectedIds[i], ids[q * k + i]);
+      EXPECT_DOUBLE_EQ(expectedDistances[i], distances[q * k + i]);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(KdTreeTest, Float)
+{
+  const std::vector<Vector3f> points{
+    {0, 0, 0}, {1, 1, 1}, {2, 2, 2}, {3, 3, 3}, {4, 4, 4}, {5, 5, 5},
+    {6, 6, 6}, {7, 7, 7}, {8, 8, 8}, {9, 9, 9}, {10, 10, 10}};
+  KdTreef tree(points);
+
+  std::size_t id;
+  float distance;
+  ASSERT_TRUE(tree.Nearest(Vector3f(6.2f, 6, 5.9f), id, distance));
+  EXPECT_EQ(6u, id);
+
+  std::vector<std::size_t> ids;
+  tree.WithinDistance(Vector3f(5, 5, 5), 1.8f, ids);
+  std::sort(ids.begin(), ids.end());
+  EXPECT_EQ((std::vector<std::size_t>{4, 5, 6}), ids);
+}
@@ -17,14 +17,175 @@
 
 #include <gz/math/Kmeans.hh>
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <utility>
 
+#include <gz/math/KdTree.hh>
+#include <gz/math/Profiler.hh>
 #include <gz/math/Rand.hh>
+#include <gz/math/detail/ParallelFor.hh>
 #include "KmeansPrivate.hh"
 
 using namespace gz;
 using namespace math;
 
+namespace
+{
+  /// \brief Minimum number of observations per thread in Cluster().
+  constexpr size_t kMinChunkSize = 1 << 14;
+
+  /// \brief Smallest number of centroids searched with a KD-tree rather
+  /// than by comparing a point with every centroid.
+  constexpr size_t kTreeMinCentroids = 32;
+
+  /// \brief Find the closest centroid to a point.
+  /// \param[in] _p Point to check.
+  /// \param[in] _centroids Centroids, at least one.
+  /// \param[in] _tree Tree of the centroids, or an empty tree to compare
+  /// the point with every centroid.
+  /// \param[out] _best Distance to the closest centroid.
+  /// \param[out] _second Distance to the second closest centroid,
+  /// HUGE_VAL if there is a single centroid.
+  /// \return The index of the closest centroid. The first one wins ties.
+  unsigned int Closest(const Vector3d &_p,
+                       const std::vector<Vector3d> &_centroids,
+                       const KdTreed &_tree,
+                       double &_best, double &_second)
+  {
+    if (!_tree.Empty())
+    {
+      // The tree orders ties by index and computes the same squared
+      // distances, so the result is the one of the linear scan.
+      std::size_t ids[2];
+      double distances[2];
+      _tree.Nearest(_p, 2, ids, distances);
+      _best = distances[0];
+      _second = distances[1];
+      return static_cast<unsigned int>(ids[0]);
+    }
+
+    _best = HUGE_VAL;
+    _second = HUGE_VAL;
+    unsigned int minIdx = 0;
+    for (auto i = 0u; i < _centroids.size(); ++i)
+    {
+      const double d = (_p - _centroids[i]).SquaredLength();
+      if (d < _best)
+      {
+        _second = _best;
+        _best = d;
+        minIdx = i;
+      }
+      else if (d < _second)
+      {
+        _second = d;
+      }
+    }
+    _best = std::sqrt(_best);
+    _second = std::sqrt(_second);
+    return minIdx;
+  }
+
+  /// \brief Build the tree of the centroids if there are enough of them
+  /// for it to be faster than a linear scan, otherwise clear it.
+  /// \param[in] _centroids Centroids.
+  /// \param[out] _tree Tree of the centroids.
+  void BuildCentroidTree(const std::vector<Vector3d> &_centroids,
+                         KdTreed &_tree)
+  {
+    if (_centroids.size() >= kTreeMinCentroids)
+      _tree.Build(_centroids);
+    else
+      _tree.Clear();
+  }
+
+  /// \brief Choose an observation with a probability proportional to its
+  /// squared distance to the closest centroid, as in k-means++.
+  /// \param[in] _dist Squared distance from each observation to the
+  /// closest centroid.
+  /// \param[in] _count Number of observations.
+  /// \param[in] _total Sum of the squared distances.
+  /// \return Index of the chosen observation. Observations that are
+  /// already centroids are never chosen, unless all of them are.
+  size_t SampleObservation(const double *_dist, const size_t _count,
+                           const double _total)
+  {
+    if (!(_total > 0))
+    {
+      // All the observations coincide with a centroid.
+      return std::min(_count - 1,
+          static_cast<size_t>(Rand::DblUniform(0, 1) * _count));
+    }
+
+    // Walk the cumulative distribution, skipping observations that are
+    // already centroids.
+    const double r = Rand::DblUniform(0, _total);
+    double sum = 0;
+    size_t chosen = 0;
+    for (size_t i = 0; i < _count; ++i)
+    {
+      if (_dist[i] <= 0)
+        continue;
+      chosen = i;
+      sum += _dist[i];
+      if (sum > r)
+        break;
+    }
+    return chosen;
+  }
+
+  /// \brief Choose the initial centroids with k-means++: the first one is a
+  /// random observation, and each of the next ones is an observation chosen
+  /// with a probability proportional to its squared distance to the closest
+  /// centroid already chosen.
+  /// \param[in] _obs Observations.
+  /// \param[in] _count Number of observations.
+  /// \param[in] _k Number of centroids, at most the number of observations.
+  /// \param[out] _centroids The chosen centroids.
+  /// \param[out] _dist Squared distance from each observation to the
+  /// closest centroid. Its storage is reused across calls.
+  void SeedCentroids(const Vector3d *_obs, const size_t _count,
+                     const size_t _k, std::vector<Vector3d> &_centroids,
+                     std::vector<double> &_dist)
+  {
+    const size_t n = _count;
+    _centroids.clear();
+    _centroids.reserve(_k);
+    _centroids.push_back(_obs[std::min(n - 1,
+        static_cast<size_t>(Rand::DblUniform(0, 1) * n))]);
+
+    std::vector<double> &dist = _dist;
+    dist.resize(n);
+    double total = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+      dist[i] = (_obs[i] - _centroids[0]).SquaredLength();
+      total += dist[i];
+    }
+
+    while (_centroids.size() < _k)
+    {
+      const Vector3d &centroid = _obs[SampleObservation(dist.data(), n,
+                                                        total)];
+      _centroids.push_back(centroid);
+      total = 0;
+      for (size_t i = 0; i < n; ++i)
+      {
+        dist[i] = std::min(dist[i], (_obs[i] - centroid).SquaredLength());
+        total += dist[i];
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+Kmeans::Kmeans()
+: dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+}
+
 //////////////////////////////////////////////////
 Kmeans::Kmeans(const std::vector<Vector3d> &_obs)
 : dataPtr(gz::utils::MakeImpl<Implementation>())
@@ -32,12 +193,25 @@ Kmeans::Kmeans(const std::vector<Vector3d> &_obs)
   this->Observations(_obs);
 }
 
+//////////////////////////////////////////////////
+Kmeans::Kmeans(std::vector<Vector3d> &&_obs)
+: dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+  this->Observations(std::move(_obs));
+}
+
 //////////////////////////////////////////////////
 std::vector<Vector3d> Kmeans::Observations() const
 {
   return this->dataPtr->obs;
 }
 
+//////////////////////////////////////////////////
+const std::vector<Vector3d> &Kmeans::ObservationsRef() const
+{
+  return this->dataPtr->obs;
+}
+
 //////////////////////////////////////////////////
 bool Kmeans::Observations(const std::vector<Vector3d> &_obs)
 {
@@ -51,6 +225,19 @@ bool Kmeans::Observations(const std::vector<Vector3d> &_obs)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Kmeans::Observations(std::vector<Vector3d> &&_obs)
+{
+  if (_obs.empty())
+  {
+    std::cerr << "Kmeans::SetObservations() error: Observations vector is empty"
+              << std::endl;
+    return false;
+  }
+  this->dataPtr->obs = std::move(_obs);
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool Kmeans::AppendObservations(const std::vector<Vector3d> &_obs)
 {
@@ -64,18 +251,71 @@ bool Kmeans::AppendObservations(const std::vector<Vector3d> &_obs)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Kmeans::AppendObservations(const Vector3d *_obs, const size_t _count)
+{
+  if (_count == 0)
+  {
+    std::cerr << "Kmeans::AppendObservations() error: input array is empty"
+              << std::endl;
+    return false;
+  }
+  this->dataPtr->obs.insert(this->dataPtr->obs.end(), _obs, _obs + _count);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void Kmeans::Reserve(const size_t _count)
+{
+  this->dataPtr->obs.reserve(_count);
+}
+
+//////////////////////////////////////////////////
+void Kmeans::Threads(const unsigned int _threads)
+{
+  this->dataPtr->threads = _threads;
+}
+
+//////////////////////////////////////////////////
+unsigned int Kmeans::Threads() const
+{
+  return this->dataPtr->threads;
+}
+
 //////////////////////////////////////////////////
 bool Kmeans::Cluster(int _k,
                      std::vector<Vector3d> &_centroids,
                      std::vector<unsigned int> &_labels)
 {
+  _labels.resize(this->dataPtr->obs.size());
+  if (!this->Cluster(_k, this->dataPtr->obs.data(),
+                     this->dataPtr->obs.size(), _labels.data()))
+  {
+    return false;
+  }
+  _centroids = this->dataPtr->centroids;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Kmeans::Cluster(int _k, const Vector3d *_obs, const size_t _count,
+                     unsigned int *_labels)
+{
+  GZ_MATH_PROFILE_ZONE("Kmeans::Cluster");
+
   // Sanity check.
-  if (this->dataPtr->obs.empty())
+  if (!_obs || _count == 0)
   {
     std::cerr << "Kmeans error: The set of observations is empty" << std::endl;
     return false;
   }
 
+  if (!_labels)
+  {
+    std::cerr << "Kmeans error: The labels buffer is null" << std::endl;
+    return false;
+  }
+
   if (_k <= 0)
   {
     std::cerr << "Kmeans error: The number of clusters has to"
@@ -84,84 +324,368 @@ bool Kmeans::Cluster(int _k,
     return false;
   }
 
-  if (_k > static_cast<int>(this->dataPtr->obs.size()))
+  if (static_cast<size_t>(_k) > _count)
   {
     std::cerr << "Kmeans error: The number of clusters [" << _k << "] has to be"
               << " lower or equal to the number of observations ["
-              << this->dataPtr->obs.size() << "]" << std::endl;
+              << _count << "]" << std::endl;
     return false;
   }
 
-  size_t changed = 0;
+  auto &d = *this->dataPtr;
+  SeedCentroids(_obs, _count, static_cast<size_t>(_k), d.centroids,
+                d.seedDistances);
+  d.Iterate(_obs, _count, _labels);
+  return true;
+}
 
-  // Initialize the size of the vectors;
-  this->dataPtr->centroids.clear();
-  this->dataPtr->labels.resize(this->dataPtr->obs.size());
-  this->dataPtr->sums.resize(_k);
-  this->dataPtr->counters.resize(_k);
+//////////////////////////////////////////////////
+void Kmeans::Implementation::Iterate(const Vector3d *_obs,
+                                     const size_t _count,
+                                     unsigned int *_labels)
+{
+  auto &d = *this;
+  const size_t n = _count;
+  const size_t k = d.centroids.size();
+
+  // Split the observations in contiguous chunks, one per thread.
+  const size_t chunks = detail::ChunkCount(n, d.threads, kMinChunkSize);
 
-  for (auto i = 0; i < _k; ++i)
+  // Initialize the size of the vectors;
+  d.upper.resize(n);
+  d.lower.resize(n);
+  d.sums.resize(k);
+  d.counters.resize(k);
+  d.shifts.resize(k);
+  d.halfGaps.resize(k);
+  d.reductions.resize(chunks);
+  for (auto &reduction : d.reductions)
   {
-    // Choose a random observation and make sure it has not been chosen before.
-    // Note: This is not really random but it's faster than choosing a random
-    // one and verifying that it was not taken before.
-    this->dataPtr->centroids.push_back(this->dataPtr->obs[i]);
+    reduction.sums.resize(k);
+    reduction.counters.resize(k);
   }
 
-  // Initialize labels.
-  for (auto i = 0u; i < this->dataPtr->obs.size(); ++i)
-    this->dataPtr->labels[i] = 0;
+  BuildCentroidTree(d.centroids, d.centroidTree);
 
-  do
+  // Run a function over the observations of each chunk, in parallel, and
+  // merge the partition sums and counters of all the chunks. The chunks are
+  // always merged in the same order, so results don't depend on timing.
+  auto forEachChunk = [&](const auto &_fn)
   {
-    // Reset sums and counters.
-    for (auto i = 0u; i < this->dataPtr->centroids.size(); ++i)
+    detail::ParallelFor(n, chunks, [&](const size_t _chunk,
+        const size_t _begin, const size_t _end)
     {
-      this->dataPtr->sums[i] = Vector3d::Zero;
-      this->dataPtr->counters[i] = 0;
+      auto &reduction = d.reductions[_chunk];
+      std::fill(reduction.sums.begin(), reduction.sums.end(), Vector3d::Zero);
+      std::fill(reduction.counters.begin(), reduction.counters.end(), 0u);
+      reduction.changed = 0;
+      _fn(reduction, _begin, _end);
+    });
+
+    size_t changed = 0;
+    for (size_t j = 0; j < k; ++j)
+    {
+      d.sums[j] = Vector3d::Zero;
+      d.counters[j] = 0;
+    }
+    for (const auto &reduction : d.reductions)
+    {
+      for (size_t j = 0; j < k; ++j)
+      {
+        d.sums[j] += reduction.sums[j];
+        d.counters[j] += reduction.counters[j];
+      }
+      changed += reduction.changed;
+    }
+    return changed;
+  };
+
+  // Assign every observation to its closest centroid, keeping the distance
+  // to it and to the second closest as bounds.
+  forEachChunk([&](Reduction &_reduction,
+                   const size_t _begin, const size_t _end)
+  {
+    for (size_t i = _begin; i < _end; ++i)
+    {
+      _labels[i] = Closest(_obs[i], d.centroids, d.centroidTree,
+                           d.upper[i], d.lower[i]);
+      _reduction.sums[_labels[i]] += _obs[i];
+      _reduction.counters[_labels[i]]++;
     }
-    changed = 0;
+  });
 
-    for (auto i = 0u; i < this->dataPtr->obs.size(); ++i)
+  // Lloyd iterations with Hamerly's bounds: an observation is only compared
+  // against all the centroids when the triangle inequality can't prove that
+  // its label is unchanged. The bound tests are strict, so the labels are
+  // the ones a full search would give, ties included.
+  size_t changed = 0;
+  do
+  {
+    // Update the centroids and how far each one moved.
+    double maxShift = 0;
+    double secondMaxShift = 0;
+    size_t maxShiftIdx = 0;
+    for (size_t j = 0; j < k; ++j)
     {
-      // Update the labels containing the closest centroid for each point.
-      auto label = this->ClosestCentroid(this->dataPtr->obs[i]);
-      if (this->dataPtr->labels[i] != label)
+      // An empty partition keeps its centroid.
+      Vector3d centroid = d.centroids[j];
+      if (d.counters[j] > 0)
+        centroid = d.sums[j] / d.counters[j];
+      d.shifts[j] = centroid.Distance(d.centroids[j]);
+      d.centroids[j] = centroid;
+      if (d.shifts[j] > maxShift)
+      {
+        secondMaxShift = maxShift;
+        maxShift = d.shifts[j];
+        maxShiftIdx = j;
+      }
+      else if (d.shifts[j] > secondMaxShift)
       {
-        this->dataPtr->labels[i] = label;
-        changed++;
+        secondMaxShift = d.shifts[j];
       }
-      this->dataPtr->sums[label] += this->dataPtr->obs[i];
-      this->dataPtr->counters[label]++;
     }
 
-    // Update the centroids.
-    for (auto i = 0u; i < this->dataPtr->centroids.size(); ++i)
+    BuildCentroidTree(d.centroids, d.centroidTree);
+    for (size_t j = 0; j < k; ++j)
     {
-      this->dataPtr->centroids[i] =
-        this->dataPtr->sums[i] / this->dataPtr->counters[i];
+      if (!d.centroidTree.Empty())
+      {
+        // The two centroids closest to a centroid are itself and the
+        // closest other one, in either order when they coincide.
+        std::size_t ids[2];
+        double distances[2];
+        d.centroidTree.Nearest(d.centroids[j], 2, ids, distances);
+        d.halfGaps[j] = 0.5 * (ids[0] == j ? distances[1] : distances[0]);
+        continue;
+      }
+
+      double gap = HUGE_VAL;
+      for (size_t m = 0; m < k; ++m)
+      {
+        if (m != j)
+        {
+          gap = std::min(gap,
+            (d.centroids[j] - d.centroids[m]).SquaredLength());
+        }
+      }
+      d.halfGaps[j] = 0.5 * std::sqrt(gap);
     }
+
+    changed = forEachChunk([&](Reduction &_reduction,
+                               const size_t _begin, const size_t _end)
+    {
+      for (size_t i = _begin; i < _end; ++i)
+      {
+        const unsigned int label = _labels[i];
+        d.upper[i] += d.shifts[label];
+        d.lower[i] -= label == maxShiftIdx ? secondMaxShift : maxShift;
+
+        const double bound = std::max(d.halfGaps[label], d.lower[i]);
+        if (d.upper[i] >= bound)
+        {
+          // Tighten the upper bound, then search all the centroids.
+          d.upper[i] = _obs[i].Distance(d.centroids[label]);
+          if (d.upper[i] >= bound)
+          {
+            const unsigned int closest = Closest(_obs[i], d.centroids,
+                d.centroidTree, d.upper[i], d.lower[i]);
+            if (closest != label)
+            {
+              _labels[i] = closest;
+              _reduction.changed++;
+            }
+          }
+        }
+        _reduction.sums[_labels[i]] += _obs[i];
+        _reduction.counters[_labels[i]]++;
+      }
+    });
   }
-  while (changed > (this->dataPtr->obs.size() >> 10)); // NOLINT
+  while (changed > (n >> 10)); // NOLINT
 
-  _centroids = this->dataPtr->centroids;
-  _labels = this->dataPtr->labels;
+  // Update the centroids with the final labels.
+  for (size_t j = 0; j < k; ++j)
+  {
+    if (d.counters[j] > 0)
+      d.centroids[j] = d.sums[j] / d.counters[j];
+  }
+
+  // Continue from these partitions in ClusterBatch().
+  d.weights.assign(d.counters.begin(), d.counters.end());
+}
+
+//////////////////////////////////////////////////
+bool Kmeans::Sweep(int _minK, int _maxK, std::vector<double> &_inertias)
+{
+  _inertias.assign(_maxK >= _minK ? _maxK - _minK + 1 : 0, 0.0);
+  return this->Sweep(_minK, _maxK, this->dataPtr->obs.data(),
+                     this->dataPtr->obs.size(), _inertias.data());
+}
+
+//////////////////////////////////////////////////
+bool Kmeans::Sweep(int _minK, int _maxK, const Vector3d *_obs,
+                   const size_t _count, double *_inertias)
+{
+  GZ_MATH_PROFILE_ZONE("Kmeans::Sweep");
+
+  if (!_obs || _count == 0)
+  {
+    std::cerr << "Kmeans error: The set of observations is empty" << std::endl;
+    return false;
+  }
+
+  if (!_inertias)
+  {
+    std::cerr << "Kmeans error: The inertias buffer is null" << std::endl;
+    return false;
+  }
+
+  if (_minK <= 0 || _maxK < _minK)
+  {
+    std::cerr << "Kmeans error: The range of clusters [" << _minK << ", "
+              << _maxK << "] has to be positive and not empty" << std::endl;
+    return false;
+  }
+
+  if (static_cast<size_t>(_maxK) > _count)
+  {
+    std::cerr << "Kmeans error: The number of clusters [" << _maxK
+              << "] has to be lower or equal to the number of observations ["
+              << _count << "]" << std::endl;
+    return false;
+  }
+
+  auto &d = *this->dataPtr;
+  const size_t n = _count;
+  const size_t maxK = static_cast<size_t>(_maxK);
+
+  // Reserve for the largest k, so that the buffers grow only once.
+  d.centroids.reserve(maxK);
+  d.sums.reserve(maxK);
+  d.counters.reserve(maxK);
+  d.shifts.reserve(maxK);
+  d.halfGaps.reserve(maxK);
+  d.sweepLabels.resize(n);
+  unsigned int *labels = d.sweepLabels.data();
+
+  SeedCentroids(_obs, n, static_cast<size_t>(_minK), d.centroids,
+                d.seedDistances);
+  for (size_t k = static_cast<size_t>(_minK); ; ++k)
+  {
+    d.Iterate(_obs, n, labels);
+
+    // The squared distance of each observation to its centroid gives the
+    // inertia, and the probabilities of the centroid added for k + 1.
+    double total = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+      d.seedDistances[i] = (_obs[i] - d.centroids[labels[i]]).SquaredLength();
+      total += d.seedDistances[i];
+    }
+    _inertias[k - static_cast<size_t>(_minK)] = total;
+    if (k == maxK)
+      break;
+
+    // Start k + 1 from the solution for k and one more centroid.
+    d.centroids.push_back(
+        _obs[SampleObservation(d.seedDistances.data(), n, total)]);
+  }
   return true;
 }
 
 //////////////////////////////////////////////////
-unsigned int Kmeans::ClosestCentroid(const Vector3d &_p) const
+bool Kmeans::ClusterBatch(int _k, const std::vector<Vector3d> &_batch,
+                          std::vector<unsigned int> &_labels)
 {
-  double min = HUGE_VAL;
-  unsigned int minIdx = 0;
-  for (auto i = 0u; i < this->dataPtr->centroids.size(); ++i)
+  GZ_MATH_PROFILE_ZONE("Kmeans::ClusterBatch");
+
+  if (_batch.empty())
   {
-    double d = _p.Distance(this->dataPtr->centroids[i]);
-    if (d < min)
+    std::cerr << "Kmeans error: The batch of observations is empty"
+              << std::endl;
+    return false;
+  }
+
+  if (_k <= 0)
+  {
+    std::cerr << "Kmeans error: The number of clusters has to"
+              << " be positive but its value is [" << _k << "]"
+              << std::endl;
+    return false;
+  }
+
+  auto &d = *this->dataPtr;
+  const size_t k = static_cast<size_t>(_k);
+  if (d.centroids.size() != k)
+  {
+    if (k > _batch.size())
     {
-      min = d;
-      minIdx = i;
+      std::cerr << "Kmeans error: The number of clusters [" << _k
+                << "] has to be lower or equal to the number of observations"
+                << " of the first batch [" << _batch.size() << "]"
+                << std::endl;
+      return false;
     }
+    SeedCentroids(_batch.data(), _batch.size(), k, d.centroids,
+      d.seedDistances);
+    d.weights.assign(k, 0.0);
+  }
+
+  // Assign the whole batch before moving any centroid.
+  BuildCentroidTree(d.centroids, d.centroidTree);
+  _labels.resize(_batch.size());
+  for (size_t i = 0; i < _batch.size(); ++i)
+    _labels[i] = this->ClosestCentroid(_batch[i]);
+
+  for (auto &weight : d.weights)
+    weight *= d.decay;
+
+  for (size_t i = 0; i < _batch.size(); ++i)
+  {
+    const unsigned int label = _labels[i];
+    d.weights[label] += 1.0;
+    d.centroids[label] +=
+      (_batch[i] - d.centroids[label]) / d.weights[label];
   }
-  return minIdx;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Kmeans::ClusterBatch(int _k, const std::vector<Vector3d> &_batch)
+{
+  std::vector<unsigned int> labels;
+  return this->ClusterBatch(_k, _batch, labels);
+}
+
+//////////////////////////////////////////////////
+const std::vector<Vector3d> &Kmeans::Centroids() const
+{
+  return this->dataPtr->centroids;
+}
+
+//////////////////////////////////////////////////
+bool Kmeans::Decay(const double _decay)
+{
+  if (!(_decay >= 0.0 && _decay <= 1.0))
+  {
+    std::cerr << "Kmeans error: The decay [" << _decay << "] has to be in"
+              << " [0, 1]" << std::endl;
+    return false;
+  }
+  this->dataPtr->decay = _decay;
+  return true;
+}
+
+//////////////////////////////////////////////////
+double Kmeans::Decay() const
+{
+  return this->dataPtr->decay;
+}
+
+//////////////////////////////////////////////////
+unsigned int Kmeans::ClosestCentroid(const Vector3d &_p) const
+{
+  double best, second;
+  return Closest(_p, this->dataPtr->centroids, this->dataPtr->centroidTree,
+                 best, second);
 }
@@ -18,6 +18,7 @@
 #define GZ_MATH_KMEANSPRIVATE_HH_
 
 #include <vector>
+#include <gz/math/KdTree.hh>
 #include <gz/math/Vector3.hh>
 #include <gz/math/Helpers.hh>
 #include <gz/math/config.hh>
@@ -32,20 +33,82 @@ namespace gz
     /// \brief Private data for Kmeans class
     class Kmeans::Implementation
     {
+      /// \brief Partition sums and counters accumulated by one thread in an
+      /// iteration, merged once all the threads are done.
+      public: struct Reduction
+      {
+        /// \brief Sum of the observations in each partition.
+        std::vector<Vector3d> sums;
+
+        /// \brief Number of observations in each partition.
+        std::vector<unsigned int> counters;
+
+        /// \brief Number of observations that changed partition.
+        size_t changed = 0;
+      };
+
+      /// \brief Run Lloyd iterations from the current centroids until few
+      /// labels change, then update the centroids with the final labels.
+      /// \param[in] _obs Pointer to the first observation.
+      /// \param[in] _count Number of observations, at least the number of
+      /// centroids.
+      /// \param[out] _labels Pointer to the first of _count labels.
+      public: void Iterate(const Vector3d *_obs, size_t _count,
+                           unsigned int *_labels);
+
+      /// \brief Maximum number of threads used by Cluster(), zero for
+      /// std::thread::hardware_concurrency.
+      public: unsigned int threads = 1;
+
       /// \brief Observations.
       public: std::vector<Vector3d> obs;
 
       /// \brief Centroids.
       public: std::vector<Vector3d> centroids;
 
-      /// \brief Each element stores the cluster to which observation i belongs.
-      public: std::vector<unsigned int> labels;
-
       /// \brief Used to calculate the centroid of each partition.
       public: std::vector<Vector3d> sums;
 
       /// \brief Counts the number of observations contained in each partition.
       public: std::vector<unsigned int> counters;
+
+      /// \brief Weight of each centroid in ClusterBatch(): the number of
+      /// observations it represents, reduced by the decay before each batch.
+      public: std::vector<double> weights;
+
+      /// \brief Decay factor of the weights in ClusterBatch().
+      public: double decay = 1.0;
+
+      /// \brief Upper bound of the distance from each observation to the
+      /// centroid of its partition.
+      public: std::vector<double> upper;
+
+      /// \brief Lower bound of the distance from each observation to the
+      /// centroids of all the other partitions.
+      public: std::vector<double> lower;
+
+      /// \brief Distance moved by each centroid in the last update.
+      public: std::vector<double> shifts;
+
+      /// \brief Half the distance from each centroid to the closest other
+      /// centroid. An observation closer than this to its centroid can't be
+      /// closer to any other centroid.
+      public: std::vector<double> halfGaps;
+
+      /// \brief One reduction per thread.
+      public: std::vector<Reduction> reductions;
+
+      /// \brief Squared distance from each observation to the closest
+      /// centroid while seeding, kept to reuse its storage.
+      public: std::vector<double> seedDistances;
+
+      /// \brief Labels of the observations in Sweep(), kept to reuse their
+      /// storage.
+      public: std::vector<unsigned int> sweepLabels;
+
+      /// \brief Tree of the centroids used to find the closest one when
+      /// there are many centroids, empty otherwise.
+      public: KdTreed centroidTree;
     };
     }
   }
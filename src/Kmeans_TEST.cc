@@ -16,8 +16,12 @@
 */
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <utility>
 #include <vector>
 #include "gz/math/Kmeans.hh"
+#include "gz/math/Rand.hh"
 
 using namespace gz;
 
@@ -143,3 +147,421 @@ TEST(KmeansTest, Append)
   std::vector<math::Vector3d> emptyVector;
   EXPECT_FALSE(kmeans.AppendObservations(emptyVector));
 }
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, MoveAndReserve)
+{
+  std::vector<math::Vector3d> obs;
+  for (int i = 0; i < 100; ++i)
+    obs.push_back(math::Vector3d(i % 2 * 10.0, 0.01 * i, 0));
+  const std::vector<math::Vector3d> expected = obs;
+
+  // The observations are moved, not copied
+  const math::Vector3d *data = obs.data();
+  math::Kmeans kmeans(std::move(obs));
+  EXPECT_EQ(data, kmeans.ObservationsRef().data());
+  EXPECT_EQ(expected, kmeans.Observations());
+
+  std::vector<math::Vector3d> other = expected;
+  data = other.data();
+  EXPECT_TRUE(kmeans.Observations(std::move(other)));
+  EXPECT_EQ(data, kmeans.ObservationsRef().data());
+
+  // An empty vector is rejected and the observations are kept
+  EXPECT_FALSE(kmeans.Observations(std::vector<math::Vector3d>()));
+  EXPECT_EQ(expected, kmeans.Observations());
+
+  // Appending reserved arrays doesn't reallocate
+  kmeans.Reserve(3 * expected.size());
+  data = kmeans.ObservationsRef().data();
+  EXPECT_TRUE(kmeans.AppendObservations(expected.data(), expected.size()));
+  EXPECT_TRUE(kmeans.AppendObservations(expected.data(), expected.size()));
+  EXPECT_FALSE(kmeans.AppendObservations(expected.data(), 0));
+  EXPECT_EQ(data, kmeans.ObservationsRef().data());
+  ASSERT_EQ(3 * expected.size(), kmeans.ObservationsRef().size());
+  EXPECT_EQ(expected.back(), kmeans.ObservationsRef().back());
+
+  std::vector<math::Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  EXPECT_TRUE(kmeans.Cluster(2, centroids, labels));
+  EXPECT_EQ(2u, centroids.size());
+}
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, Seeding)
+{
+  // Four well separated blobs. The first observations all belong to the
+  // same blob, so seeding with them would split that blob.
+  const std::vector<math::Vector3d> centers =
+  {
+    {0, 0, 0}, {100, 0, 0}, {0, 100, 0}, {0, 0, 100}
+  };
+  std::vector<math::Vector3d> obs;
+  for (const auto &center : centers)
+  {
+    for (int i = 0; i < 25; ++i)
+      obs.push_back(center + math::Vector3d(i % 5, i / 5, 0) * 0.1);
+  }
+
+  math::Rand::Seed(7);
+  math::Kmeans kmeans(obs);
+  std::vector<math::Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  ASSERT_TRUE(kmeans.Cluster(4, centroids, labels));
+  ASSERT_EQ(4u, centroids.size());
+  ASSERT_EQ(obs.size(), labels.size());
+
+  // Every blob is a cluster of its own.
+  for (size_t blob = 0; blob < centers.size(); ++blob)
+  {
+    for (size_t i = 1; i < 25; ++i)
+      EXPECT_EQ(labels[blob * 25], labels[blob * 25 + i]);
+    for (size_t other = 0; other < blob; ++other)
+      EXPECT_NE(labels[blob * 25], labels[other * 25]);
+    EXPECT_EQ(centers[blob] + math::Vector3d(0.2, 0.2, 0),
+              centroids[labels[blob * 25]]);
+  }
+
+  // All the observations are the same point.
+  math::Kmeans same(std::vector<math::Vector3d>(10, math::Vector3d::One));
+  ASSERT_TRUE(same.Cluster(3, centroids, labels));
+  for (const auto &centroid : centroids)
+    EXPECT_EQ(math::Vector3d::One, centroid);
+}
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, SameLabels)
+{
+  // With fewer than 1024 observations, clustering stops when no label
+  // changes, so every label must be the closest centroid found by a full
+  // search, and every centroid the mean of its observations.
+  math::Rand::Seed(42);
+  std::vector<math::Vector3d> obs;
+  for (int i = 0; i < 1000; ++i)
+  {
+    obs.emplace_back(math::Rand::DblUniform(-10, 10),
+                     math::Rand::DblUniform(-10, 10),
+                     math::Rand::DblUniform(-10, 10));
+  }
+
+  math::Kmeans kmeans(obs);
+  std::vector<math::Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  ASSERT_TRUE(kmeans.Cluster(16, centroids, labels));
+  ASSERT_EQ(16u, centroids.size());
+  ASSERT_EQ(obs.size(), labels.size());
+
+  std::vector<math::Vector3d> sums(centroids.size(), math::Vector3d::Zero);
+  std::vector<unsigned int> counters(centroids.size(), 0);
+  for (size_t i = 0; i < obs.size(); ++i)
+  {
+    unsigned int closest = 0;
+    for (unsigned int j = 1; j < centroids.size(); ++j)
+    {
+      if ((obs[i] - centroids[j]).SquaredLength() <
+          (obs[i] - centroids[closest]).SquaredLength())
+      {
+        closest = j;
+      }
+    }
+    EXPECT_EQ(closest, labels[i]) << i;
+    sums[labels[i]] += obs[i];
+    counters[labels[i]]++;
+  }
+
+  for (size_t j = 0; j < centroids.size(); ++j)
+  {
+    ASSERT_GT(counters[j], 0u);
+    EXPECT_EQ(sums[j] / counters[j], centroids[j]);
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, Threads)
+{
+  // Enough observations for several threads, in 8 well separated blobs.
+  math::Rand::Seed(3);
+  std::vector<math::Vector3d> obs;
+  for (int i = 0; i < 80000; ++i)
+  {
+    const int blob = i % 8;
+    obs.emplace_back(math::Vector3d(blob & 1, (blob >> 1) & 1, blob >> 2) * 50 +
+      math::Vector3d(math::Rand::DblNormal(0, 1),
+                     math::Rand::DblNormal(0, 1),
+                     math::Rand::DblNormal(0, 1)));
+  }
+
+  math::Kmeans kmeans(obs);
+  EXPECT_EQ(1u, kmeans.Threads());
+
+  std::vector<math::Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  math::Rand::Seed(11);
+  ASSERT_TRUE(kmeans.Cluster(8, centroids, labels));
+
+  for (unsigned int threads : {0u, 2u, 4u})
+  {
+    kmeans.Threads(threads);
+    EXPECT_EQ(threads, kmeans.Threads());
+
+    std::vector<math::Vector3d> parallelCentroids;
+    std::vector<unsigned int> parallelLabels;
+    math::Rand::Seed(11);
+    ASSERT_TRUE(kmeans.Cluster(8, parallelCentroids, parallelLabels));
+    EXPECT_EQ(labels, parallelLabels);
+    ASSERT_EQ(centroids.size(), parallelCentroids.size());
+    for (size_t j = 0; j < centroids.size(); ++j)
+      EXPECT_TRUE(centroids[j].Equal(parallelCentroids[j], 1e-9));
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, ClusterBatch)
+{
+  math::Kmeans kmeans;
+  EXPECT_TRUE(kmeans.Centroids().empty());
+  EXPECT_DOUBLE_EQ(1.0, kmeans.Decay());
+  EXPECT_FALSE(kmeans.Decay(-0.1));
+  EXPECT_FALSE(kmeans.Decay(1.1));
+  EXPECT_DOUBLE_EQ(1.0, kmeans.Decay());
+
+  std::vector<math::Vector3d> batch;
+  EXPECT_FALSE(kmeans.ClusterBatch(2, batch));
+  batch.push_back(math::Vector3d::Zero);
+  EXPECT_FALSE(kmeans.ClusterBatch(0, batch));
+  // Not enough observations to choose the centroids.
+  EXPECT_FALSE(kmeans.ClusterBatch(2, batch));
+
+  // Stream batches from two blobs.
+  const math::Vector3d center1(-10, 0, 0);
+  const math::Vector3d center2(10, 5, 0);
+  auto makeBatch = [](const math::Vector3d &_a, const math::Vector3d &_b)
+  {
+    std::vector<math::Vector3d> result;
+    for (int i = 0; i < 100; ++i)
+    {
+      const math::Vector3d noise(math::Rand::DblNormal(0, 0.5),
+                                 math::Rand::DblNormal(0, 0.5),
+                                 math::Rand::DblNormal(0, 0.5));
+      result.push_back((i % 2 ? _a : _b) + noise);
+    }
+    return result;
+  };
+
+  math::Rand::Seed(5);
+  std::vector<unsigned int> labels;
+  for (int b = 0; b < 50; ++b)
+  {
+    ASSERT_TRUE(kmeans.ClusterBatch(2, makeBatch(center1, center2), labels));
+    ASSERT_EQ(100u, labels.size());
+    EXPECT_NE(labels[0], labels[1]);
+  }
+  // Observations are not stored.
+  EXPECT_TRUE(kmeans.ObservationsRef().empty());
+
+  auto centroids = kmeans.Centroids();
+  ASSERT_EQ(2u, centroids.size());
+  if (centroids[0].X() > centroids[1].X())
+    std::swap(centroids[0], centroids[1]);
+  EXPECT_TRUE(centroids[0].Equal(center1, 0.1));
+  EXPECT_TRUE(centroids[1].Equal(center2, 0.1));
+
+  // With a decay, the centroids follow blobs that move.
+  EXPECT_TRUE(kmeans.Decay(0.5));
+  EXPECT_DOUBLE_EQ(0.5, kmeans.Decay());
+  const math::Vector3d offset(0, 0, 20);
+  for (int b = 0; b < 20; ++b)
+  {
+    ASSERT_TRUE(kmeans.ClusterBatch(2,
+      makeBatch(center1 + offset, center2 + offset)));
+  }
+  centroids = kmeans.Centroids();
+  if (centroids[0].X() > centroids[1].X())
+    std::swap(centroids[0], centroids[1]);
+  EXPECT_TRUE(centroids[0].Equal(center1 + offset, 0.5));
+  EXPECT_TRUE(centroids[1].Equal(center2 + offset, 0.5));
+
+  // Batches continue from the partitions found by Cluster().
+  std::vector<math::Vector3d> obs = makeBatch(center1, center2);
+  math::Kmeans warm(obs);
+  std::vector<math::Vector3d> clustered;
+  ASSERT_TRUE(warm.Cluster(2, clustered, labels));
+  EXPECT_EQ(clustered, warm.Centroids());
+  ASSERT_TRUE(warm.ClusterBatch(2, obs));
+  for (size_t j = 0; j < clustered.size(); ++j)
+    EXPECT_TRUE(clustered[j].Equal(warm.Centroids()[j], 0.5));
+}
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, ClusterBuffer)
+{
+  std::vector<math::Vector3d> obs;
+  for (int i = 0; i < 5; ++i)
+  {
+    obs.push_back(math::Vector3d(1.0 + i * 0.1, 1.0, 0.0));
+    obs.push_back(math::Vector3d(5.0 + i * 0.1, 1.0, 0.0));
+  }
+
+  // The observations stored in the object are ignored.
+  math::Kmeans kmeans;
+  std::vector<unsigned int> labels(obs.size(), 99u);
+  math::Rand::Seed(1);
+  ASSERT_TRUE(kmeans.Cluster(2, obs.data(), obs.size(), labels.data()));
+  EXPECT_TRUE(kmeans.ObservationsRef().empty());
+  for (size_t i = 0; i < obs.size(); ++i)
+    EXPECT_EQ(labels[i % 2], labels[i]);
+  EXPECT_NE(labels[0], labels[1]);
+  ASSERT_EQ(2u, kmeans.Centroids().size());
+  EXPECT_EQ(math::Vector3d(1.2, 1.0, 0.0), kmeans.Centroids()[labels[0]]);
+  EXPECT_EQ(math::Vector3d(5.2, 1.0, 0.0), kmeans.Centroids()[labels[1]]);
+
+  // Same result as the vector overload.
+  math::Kmeans copy(obs);
+  std::vector<math::Vector3d> centroids;
+  std::vector<unsigned int> copyLabels;
+  math::Rand::Seed(1);
+  ASSERT_TRUE(copy.Cluster(2, centroids, copyLabels));
+  EXPECT_EQ(labels, copyLabels);
+  EXPECT_EQ(kmeans.Centroids(), centroids);
+
+  // Invalid arguments.
+  EXPECT_FALSE(kmeans.Cluster(2, nullptr, obs.size(), labels.data()));
+  EXPECT_FALSE(kmeans.Cluster(2, obs.data(), 0, labels.data()));
+  EXPECT_FALSE(kmeans.Cluster(2, obs.data(), obs.size(), nullptr));
+  EXPECT_FALSE(kmeans.Cluster(0, obs.data(), obs.size(), labels.data()));
+  EXPECT_FALSE(kmeans.Cluster(11, obs.data(), obs.size(), labels.data()));
+}
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, ManyCentroids)
+{
+  // Enough centroids for the closest ones to be searched in a tree, with
+  // repeated observations so that some centroids coincide.
+  math::Rand::Seed(9);
+  std::vector<math::Vector3d> batch;
+  for (int i = 0; i < 2000; ++i)
+  {
+    if (i % 5 == 4)
+    {
+      batch.push_back(batch[i / 3]);
+      continue;
+    }
+    batch.emplace_back(math::Rand::DblUniform(-10, 10),
+                       math::Rand::DblUniform(-10, 10),
+                       math::Rand::DblUniform(-10, 10));
+  }
+
+  const int k = 100;
+  math::Kmeans kmeans;
+  std::vector<unsigned int> labels;
+  ASSERT_TRUE(kmeans.ClusterBatch(k, batch, labels));
+
+  // The labels of the next batch are the closest centroids before the
+  // batch, the first one in case of a tie.
+  const std::vector<math::Vector3d> centroids = kmeans.Centroids();
+  ASSERT_TRUE(kmeans.ClusterBatch(k, batch, labels));
+  for (size_t i = 0; i < batch.size(); ++i)
+  {
+    unsigned int expected = 0;
+    for (unsigned int j = 1; j < centroids.size(); ++j)
+    {
+      if ((batch[i] - centroids[j]).SquaredLength() <
+          (batch[i] - centroids[expected]).SquaredLength())
+      {
+        expected = j;
+      }
+    }
+    EXPECT_EQ(expected, labels[i]) << i;
+  }
+
+  // Every observation of Cluster is labeled with a centroid, and the
+  // centroids are the means of their partitions.
+  std::vector<math::Vector3d> result;
+  ASSERT_TRUE(kmeans.Observations(batch));
+  ASSERT_TRUE(kmeans.Cluster(k, result, labels));
+  ASSERT_EQ(static_cast<size_t>(k), result.size());
+  std::vector<math::Vector3d> sums(k, math::Vector3d::Zero);
+  std::vector<int> counts(k, 0);
+  for (size_t i = 0; i < batch.size(); ++i)
+  {
+    ASSERT_LT(labels[i], static_cast<unsigned int>(k));
+    sums[labels[i]] += batch[i];
+    counts[labels[i]]++;
+  }
+  for (int j = 0; j < k; ++j)
+  {
+    if (counts[j] > 0)
+    {
+      EXPECT_TRUE((sums[j] / counts[j]).Equal(result[j], 1e-9)) << j;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, Sweep)
+{
+  // Eight well separated blobs, so the inertia drops sharply up to k = 8
+  // and barely after it.
+  math::Rand::Seed(5);
+  std::vector<math::Vector3d> obs;
+  for (int i = 0; i < 800; ++i)
+  {
+    const int blob = i % 8;
+    obs.emplace_back(math::Vector3d(blob & 1, (blob >> 1) & 1, blob >> 2) * 50 +
+      math::Vector3d(math::Rand::DblNormal(0, 1),
+                     math::Rand::DblNormal(0, 1),
+                     math::Rand::DblNormal(0, 1)));
+  }
+
+  math::Kmeans kmeans(obs);
+  std::vector<double> inertias;
+  ASSERT_TRUE(kmeans.Sweep(1, 40, inertias));
+  ASSERT_EQ(40u, inertias.size());
+
+  // A single partition is centered on the mean of the observations.
+  math::Vector3d mean = math::Vector3d::Zero;
+  for (const auto &p : obs)
+    mean += p;
+  mean /= static_cast<double>(obs.size());
+  double expected = 0;
+  for (const auto &p : obs)
+    expected += (p - mean).SquaredLength();
+  EXPECT_NEAR(expected, inertias[0], 1e-9 * expected);
+
+  // Each k starts from the solution of k - 1, so the inertia never grows.
+  for (size_t i = 1; i < inertias.size(); ++i)
+    EXPECT_LE(inertias[i], inertias[i - 1] * (1 + 1e-12)) << i;
+  EXPECT_GT(inertias[6], 10 * inertias[7]);
+  EXPECT_LT(inertias[7], 1.3 * inertias[8]);
+
+  // The centroids are the ones of the largest k, and with fewer than 1024
+  // observations every label is the closest centroid.
+  const std::vector<math::Vector3d> &centroids = kmeans.Centroids();
+  ASSERT_EQ(40u, centroids.size());
+  double inertia = 0;
+  for (const auto &p : obs)
+  {
+    double best = HUGE_VAL;
+    for (const auto &c : centroids)
+      best = std::min(best, (p - c).SquaredLength());
+    inertia += best;
+  }
+  EXPECT_NEAR(inertia, inertias.back(), 1e-9 * inertia);
+
+  // A range that does not start at one, on a buffer of the caller.
+  std::vector<double> range(5, -1.0);
+  math::Kmeans other;
+  ASSERT_TRUE(other.Sweep(6, 10, obs.data(), obs.size(), range.data()));
+  for (double value : range)
+    EXPECT_GT(value, 0.0);
+  EXPECT_GT(range[1], 10 * range[2]);
+  EXPECT_EQ(10u, other.Centroids().size());
+
+  // Invalid ranges and buffers.
+  EXPECT_FALSE(kmeans.Sweep(0, 4, inertias));
+  EXPECT_FALSE(kmeans.Sweep(5, 4, inertias));
+  EXPECT_FALSE(kmeans.Sweep(1, 801, inertias));
+  EXPECT_FALSE(other.Sweep(1, 4, inertias));
+  EXPECT_FALSE(other.Sweep(1, 4, obs.data(), obs.size(), nullptr));
+  EXPECT_FALSE(other.Sweep(1, 4, nullptr, 0, range.data()));
+}
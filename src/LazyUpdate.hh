@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_LAZYUPDATE_HH_
+#define GZ_MATH_LAZYUPDATE_HH_
+
+#include <atomic>
+#include <mutex>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    inline namespace GZ_MATH_VERSION_NAMESPACE
+    {
+    /// \internal
+    /// \brief Flag and mutex guarding state that is computed on first use
+    /// by const member functions, so they can be called concurrently.
+    /// Copies start dirty, so that they compute their own state.
+    class LazyUpdate
+    {
+      /// \brief Constructor
+      public: LazyUpdate() = default;
+
+      /// \brief Copy constructor
+      public: LazyUpdate(const LazyUpdate &)
+      {
+      }
+
+      /// \brief Copy assignment
+      /// \return Reference to this
+      public: LazyUpdate &operator=(const LazyUpdate &)
+      {
+        this->dirty.store(true, std::memory_order_relaxed);
+        return *this;
+      }
+
+      /// \brief Run an update if the state is dirty. Once the state is
+      /// computed, this is a single atomic load.
+      /// \param[in] _update Function computing the state. Only one thread
+      /// runs it, the others wait for it to finish.
+      public: template<typename F>
+      void Refresh(const F &_update)
+      {
+        if (!this->dirty.load(std::memory_order_acquire))
+          return;
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->dirty.load(std::memory_order_relaxed))
+        {
+          _update();
+          this->dirty.store(false, std::memory_order_release);
+        }
+      }
+
+      /// \brief True if the state must be computed again.
+      public: std::atomic<bool> dirty{true};
+
+      /// \brief Serializes the computation of the state.
+      public: std::mutex mutex;
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "gz/math/Helpers.hh"
+#include "gz/math/Line2.hh"
+#include "gz/math/Line2Array.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/Vector2.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+/// \brief Pairs of intersecting segments found by testing every pair.
+std::vector<std::pair<std::size_t, std::size_t>> BruteForce(
+    const std::vector<Line2d> &_lines, const std::size_t _gap)
+{
+  std::vector<std::pair<std::size_t, std::size_t>> pairs;
+  Vector2d point;
+  for (std::size_t i = 0; i < _lines.size(); ++i)
+  {
+    for (std::size_t j = i + _gap; j < _lines.size(); ++j)
+    {
+      if (_lines[i].Intersect(_lines[j], point))
+        pairs.emplace_back(i, j);
+    }
+  }
+  return pairs;
+}
+
+/////////////////////////////////////////////////
+/// \brief Indices of the pairs found by Line2Array.
+std::vector<std::pair<std::size_t, std::size_t>> Indices(
+    const std::vector<Line2Arrayd::Pair> &_pairs)
+{
+  std::vector<std::pair<std::size_t, std::size_t>> indices;
+  for (const auto &pair : _pairs)
+    indices.emplace_back(pair.first, pair.second);
+  return indices;
+}
+
+/////////////////////////////////////////////////
+TEST(Line2ArrayTest, Empty)
+{
+  Line2Arrayd lines;
+  EXPECT_TRUE(lines.Empty());
+  EXPECT_EQ(0u, lines.Size());
+
+  std::vector<Line2Arrayd::Pair> pairs(3);
+  lines.Intersections(pairs);
+  EXPECT_TRUE(pairs.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(Line2ArrayTest, Pentagram)
+{
+  // Closed star polygon, each edge crosses the two edges that are not
+  // next to it
+  std::vector<Vector2d> vertices;
+  for (int i = 0; i < 5; ++i)
+  {
+    const double angle = 4 * GZ_PI * i / 5;
+    vertices.emplace_back(std::cos(angle), std::sin(angle));
+  }
+  std::vector<Line2d> edges;
+  for (int i = 0; i < 5; ++i)
+    edges.emplace_back(vertices[i], vertices[(i + 1) % 5]);
+
+  Line2Arrayd lines(edges);
+  ASSERT_EQ(5u, lines.Size());
+  EXPECT_FALSE(lines.Empty());
+  EXPECT_EQ(edges[2], lines.Line(2));
+
+  std::vector<Line2Arrayd::Pair> pairs;
+  lines.Intersections(pairs, 2);
+  // The first and last edges share a vertex
+  const std::vector<std::pair<std::size_t, std::size_t>> expected = {
+    {0, 2}, {0, 3}, {0, 4}, {1, 3}, {1, 4}, {2, 4}};
+  EXPECT_EQ(expected, Indices(pairs));
+  EXPECT_EQ(BruteForce(edges, 2), Indices(pairs));
+
+  // Crossings are on the inner pentagon, shared vertices on the unit
+  // circle
+  for (const auto &pair : pairs)
+  {
+    Vector2d point;
+    ASSERT_TRUE(edges[pair.first].Intersect(edges[pair.second], point));
+    EXPECT_EQ(point, pair.point);
+    if (pair.first == 0 && pair.second == 4)
+    {
+      EXPECT_NEAR(1.0, pair.point.Length(), 1e-9);
+    }
+    else
+    {
+      EXPECT_LT(pair.point.Length(), 0.5);
+    }
+  }
+
+  // All pairs, including consecutive edges
+  lines.Intersections(pairs, 1);
+  EXPECT_EQ(BruteForce(edges, 1), Indices(pairs));
+  EXPECT_GE(pairs.size(), 6u);
+}
+
+/////////////////////////////////////////////////
+TEST(Line2ArrayTest, Degenerate)
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double inf = std::numeric_limits<double>::infinity();
+  const std::vector<Line2d> edges = {
+    // Overlapping collinear segments
+    Line2d(0, 0, 2, 0),
+    Line2d(1, 0, 3, 0),
+    // Points
+    Line2d(5, 5, 5, 5),
+    Line2d(5, 5, 5, 5),
+    // Not finite
+    Line2d(nan, 0, 1, 1),
+    Line2d(-inf, 0, inf, 0),
+    // Touching at an end point
+    Line2d(3, 0, 3, 4)};
+
+  Line2Arrayd lines(edges);
+  std::vector<Line2Arrayd::Pair> pairs;
+  lines.Intersections(pairs);
+  const std::vector<std::pair<std::size_t, std::size_t>> expected = {
+    {0, 1}, {1, 6}, {2, 3}};
+  EXPECT_EQ(expected, Indices(pairs));
+
+  // Only segments that are not finite
+  Line2Arrayd invalid({Line2d(nan, nan, nan, nan)});
+  invalid.Intersections(pairs);
+  EXPECT_TRUE(pairs.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(Line2ArrayTest, RandomSegments)
+{
+  Rand::Seed(5);
+  std::vector<Line2d> edges;
+  for (int i = 0; i < 3000; ++i)
+  {
+    const Vector2d start(Rand::DblUniform(-100, 100),
+                         Rand::DblUniform(-100, 100));
+    // Mostly short segments and a few long ones
+    const double length = (i % 100 == 0) ? 80 : Rand::DblUniform(0, 4);
+    const double angle = Rand::DblUniform(-GZ_PI, GZ_PI);
+    // Some horizontal and vertical segments
+    const double snapped = (i % 7 == 0) ? std::round(angle / GZ_PI * 2) *
+        GZ_PI / 2 : angle;
+    edges.emplace_back(start,
+        start + Vector2d(std::cos(snapped), std::sin(snapped)) * length);
+  }
+
+  Line2Arrayd lines(edges);
+  std::vector<Line2Arrayd::Pair> pairs;
+  for (const std::size_t gap : {1u, 3u})
+  {
+    const auto expected = BruteForce(edges, gap);
+    EXPECT_GT(expected.size(), 100u);
+
+    lines.Intersections(pairs, gap);
+    EXPECT_EQ(expected, Indices(pairs));
+
+    // The same pairs with several threads
+    for (const unsigned int threads : {0u, 2u, 3u})
+    {
+      std::vector<Line2Arrayd::Pair> parallel;
+      lines.Intersections(parallel, gap, threads);
+      EXPECT_EQ(expected, Indices(parallel)) << threads;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(Line2ArrayTest, Float)
+{
+  const std::vector<Line2f> edges = {
+    Line2f(0, 0, 1, 1),
+    Line2f(0, 1, 1, 0),
+    Line2f(2, 0, 2, 1)};
+  Line2Arrayf lines(edges);
+  std::vector<Line2Arrayf::Pair> pairs;
+  lines.Intersections(pairs);
+  ASSERT_EQ(1u, pairs.size());
+  EXPECT_EQ(0u, pairs[0].first);
+  EXPECT_EQ(1u, pairs[0].second);
+  EXPECT_FLOAT_EQ(0.5f, pairs[0].point.X());
+  EXPECT_FLOAT_EQ(0.5f, pairs[0].point.Y());
+}
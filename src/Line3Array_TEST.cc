@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+#include "gz/math/Line3.hh"
+#include "gz/math/Line3Array.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/Vector3.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+/// \brief Random segments in a cube of side 10 centered at the origin,
+/// some of them of zero length, and some parallel to each other.
+std::vector<Line3d> RandomSegments(const std::size_t _count)
+{
+  std::vector<Line3d> lines;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const Vector3d start(Rand::DblUniform(-5, 5), Rand::DblUniform(-5, 5),
+                         Rand::DblUniform(-5, 5));
+    Vector3d dir(Rand::DblUniform(-2, 2), Rand::DblUniform(-2, 2),
+                 Rand::DblUniform(-2, 2));
+    if (i % 17 == 0)
+      dir = Vector3d::Zero;
+    else if (i % 5 == 0)
+      dir = Vector3d(1, 2, -1) * Rand::DblUniform(-1, 1);
+    lines.push_back(Line3d(start, start + dir));
+  }
+  return lines;
+}
+
+/////////////////////////////////////////////////
+/// \brief Distance between two segments, as the smallest of the distances
+/// from each end point to the other segment and of the distance between
+/// the interior points where both lines are closest.
+double ReferenceDistance(Line3d _a, Line3d _b)
+{
+  double best = std::min({_b.Distance(_a[0]), _b.Distance(_a[1]),
+                          _a.Distance(_b[0]), _a.Distance(_b[1])});
+  const Vector3d d1 = _a.Direction() * _a.Length();
+  const Vector3d d2 = _b.Direction() * _b.Length();
+  const Vector3d r = _a[0] - _b[0];
+  const double a = d1.Dot(d1);
+  const double b = d1.Dot(d2);
+  const double e = d2.Dot(d2);
+  const double denom = a * e - b * b;
+  if (denom > 1e-9 * a * e)
+  {
+    const double s = (b * d2.Dot(r) - e * d1.Dot(r)) / denom;
+    const double t = (a * d2.Dot(r) - b * d1.Dot(r)) / denom;
+    if (s > 0 && s < 1 && t > 0 && t < 1)
+      best = std::min(best, (r + d1 * s - d2 * t).Length());
+  }
+  return best;
+}
+
+/////////////////////////////////////////////////
+TEST(Line3ArrayTest, Construction)
+{
+  Line3Arrayd empty;
+  EXPECT_TRUE(empty.Empty());
+  EXPECT_EQ(0u, empty.Size());
+  std::size_t index = 3;
+  Line3d result;
+  EXPECT_FALSE(empty.Closest(Line3d(0, 0, 0, 1, 1, 1), index, result));
+  std::vector<double> distances = {1.0};
+  empty.Distances(Line3d(0, 0, 0, 1, 1, 1), distances);
+  EXPECT_TRUE(distances.empty());
+  std::vector<Line3Arrayd::Pair> pairs = {{1, 2, 3.0}};
+  empty.ClosestPairs(empty, 5, pairs);
+  EXPECT_TRUE(pairs.empty());
+  empty.ClosestPairs(5, 1, pairs);
+  EXPECT_TRUE(pairs.empty());
+
+  const std::vector<Line3d> lines = RandomSegments(11);
+  const Line3Arrayd array(lines);
+  ASSERT_EQ(11u, array.Size());
+  for (std::size_t i = 0; i < lines.size(); ++i)
+    EXPECT_EQ(lines[i], array.Line(i));
+}
+
+/////////////////////////////////////////////////
+TEST(Line3ArrayTest, Distances)
+{
+  // Crossing, parallel, collinear and point segments, measured from the
+  // unit segment along x
+  const std::vector<Line3f> lines = {
+      Line3f(0.5f, -1, 2, 0.5f, 1, 2),
+      Line3f(-1, 1, 0, 3, 1, 0),
+      Line3f(2, 0, 0, 4, 0, 0),
+      Line3f(-3, 0, 0, -2, 0, 0),
+      Line3f(0.25f, 0, 3, 0.25f, 0, 3),
+      Line3f(3, 4, 0, 3, 4, 0),
+      Line3f(2, 1, 0, 3, 1, 1)};
+  const std::vector<float> expected = {2, 1, 1, 2, 3, std::sqrt(16.0f + 4),
+                                       std::sqrt(2.0f)};
+  const Line3Arrayf array(lines);
+  std::vector<float> distances;
+  array.Distances(Line3f(0, 0, 0, 1, 0, 0), distances);
+  ASSERT_EQ(expected.size(), distances.size());
+  for (std::size_t i = 0; i < expected.size(); ++i)
+    EXPECT_NEAR(expected[i], distances[i], 1e-5) << i;
+
+  // A query of zero length
+  array.Distances(Line3f(0.5f, 0, 2, 0.5f, 0, 2), distances);
+  EXPECT_NEAR(0, distances[0], 1e-6);
+  EXPECT_NEAR(std::sqrt(5.0f), distances[1], 1e-5);
+
+  std::size_t index = 10;
+  Line3f result;
+  ASSERT_TRUE(array.Closest(Line3f(3.5f, 0.2f, 0, 5, 0.2f, 0), index,
+                            result));
+  EXPECT_EQ(2u, index);
+  EXPECT_EQ(Vector3f(3.5f, 0, 0), result[0]);
+  EXPECT_EQ(Vector3f(3.5f, 0.2f, 0), result[1]);
+}
+
+/////////////////////////////////////////////////
+TEST(Line3ArrayTest, RandomSegments)
+{
+  Rand::Seed(123);
+  const std::vector<Line3d> lines = RandomSegments(101);
+  const std::vector<Line3d> queries = RandomSegments(60);
+  const Line3Arrayd array(lines);
+
+  std::vector<double> distances;
+  for (const Line3d &query : queries)
+  {
+    array.Distances(query, distances);
+    ASSERT_EQ(lines.size(), distances.size());
+    double best = 1e9;
+    for (std::size_t i = 0; i < lines.size(); ++i)
+    {
+      EXPECT_NEAR(ReferenceDistance(lines[i], query), distances[i], 1e-9)
+          << i << " " << lines[i] << " | " << query;
+      best = std::min(best, distances[i]);
+    }
+
+    // The closest segment and the shortest segment to it
+    std::size_t index;
+    Line3d result;
+    ASSERT_TRUE(array.Closest(query, index, result));
+    EXPECT_DOUBLE_EQ(best, distances[index]);
+    EXPECT_NEAR(best, result.Length(), 1e-9);
+    Line3d closest = array.Line(index);
+    Line3d queryCopy = query;
+    EXPECT_NEAR(0, closest.Distance(result[0]), 1e-9);
+    EXPECT_NEAR(0, queryCopy.Distance(result[1]), 1e-9);
+  }
+
+  // The k closest pairs between two arrays
+  const Line3Arrayd other(queries);
+  std::vector<std::tuple<double, std::size_t, std::size_t>> all;
+  for (std::size_t i = 0; i < lines.size(); ++i)
+  {
+    for (std::size_t j = 0; j < queries.size(); ++j)
+      all.emplace_back(ReferenceDistance(lines[i], queries[j]), i, j);
+  }
+  std::sort(all.begin(), all.end());
+  std::vector<Line3Arrayd::Pair> pairs;
+  array.ClosestPairs(other, 25, pairs);
+  ASSERT_EQ(25u, pairs.size());
+  for (std::size_t k = 0; k < pairs.size(); ++k)
+  {
+    EXPECT_NEAR(std::get<0>(all[k]), pairs[k].distance, 1e-9) << k;
+    EXPECT_EQ(std::get<1>(all[k]), pairs[k].first) << k;
+    EXPECT_EQ(std::get<2>(all[k]), pairs[k].second) << k;
+  }
+  array.ClosestPairs(other, 100000, pairs);
+  EXPECT_EQ(all.size(), pairs.size());
+  array.ClosestPairs(other, 0, pairs);
+  EXPECT_TRUE(pairs.empty());
+
+  // The k closest pairs within an array, skipping neighbours
+  for (std::size_t gap : {1u, 2u, 5u})
+  {
+    all.clear();
+    for (std::size_t j = 0; j < lines.size(); ++j)
+    {
+      for (std::size_t i = 0; i + gap <= j; ++i)
+        all.emplace_back(ReferenceDistance(lines[i], lines[j]), i, j);
+    }
+    std::sort(all.begin(), all.end());
+    array.ClosestPairs(40, gap, pairs);
+    ASSERT_EQ(40u, pairs.size());
+    for (std::size_t k = 0; k < pairs.size(); ++k)
+    {
+      EXPECT_NEAR(std::get<0>(all[k]), pairs[k].distance, 1e-9) << k;
+      EXPECT_GE(pairs[k].second, pairs[k].first + gap);
+    }
+  }
+}
@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "gz/math/LoopTimer.hh"
+#include "gz/math/SignalStats.hh"
+
+using namespace gz;
+using namespace math;
+
+/// \brief Statistics of one half of the rolling window.
+struct LoopTimerWindow
+{
+  /// \brief Forget the iterations of the window.
+  void Reset()
+  {
+    this->jitter.Reset();
+    this->executionTime.Reset();
+    this->jitterMax = 0.0;
+    this->executionTimeMax = 0.0;
+    this->periodSum = 0.0;
+    this->iterations = 0;
+  }
+
+  /// \brief Digest of the jitters in seconds.
+  SignalQuantile jitter{0.99};
+
+  /// \brief Digest of the execution times in seconds.
+  SignalQuantile executionTime{0.99};
+
+  /// \brief Largest jitter in seconds.
+  double jitterMax = 0.0;
+
+  /// \brief Largest execution time in seconds.
+  double executionTimeMax = 0.0;
+
+  /// \brief Sum of the periods in seconds.
+  double periodSum = 0.0;
+
+  /// \brief Number of iterations started in the window.
+  std::size_t iterations = 0;
+};
+
+/// \brief Private data for the LoopTimer class
+class gz::math::LoopTimer::Implementation
+{
+  /// \brief Estimate a quantile over both halves of the window.
+  /// \param[in] _member Digest of the windows to combine.
+  /// \param[in] _quantile The quantile.
+  /// \return The estimate, 0 if there are no samples.
+  public: double Quantile(SignalQuantile LoopTimerWindow::*_member,
+                          double _quantile) const
+  {
+    const SignalQuantile &latest = this->windows[this->current].*_member;
+    const SignalQuantile &previous =
+      this->windows[1 - this->current].*_member;
+    if (previous.Count() == 0)
+      return latest.Quantile(_quantile);
+
+    SignalQuantile combined(previous);
+    combined.Merge(latest);
+    return combined.Quantile(_quantile);
+  }
+
+  /// \brief Nominal period.
+  public: clock::duration period;
+
+  /// \brief Deadline of the iterations.
+  public: clock::duration deadline;
+
+  /// \brief Number of iterations in each half of the window.
+  public: std::size_t windowSize;
+
+  /// \brief Start time of the current, or last, iteration.
+  public: clock::time_point beginTime;
+
+  /// \brief Period of the last iteration.
+  public: clock::duration lastPeriod{0};
+
+  /// \brief True between Begin() and End().
+  public: bool running = false;
+
+  /// \brief Number of iterations started.
+  public: uint64_t iterations = 0;
+
+  /// \brief Number of iterations that overran the deadline.
+  public: uint64_t deadlineMisses = 0;
+
+  /// \brief Both halves of the rolling window.
+  public: LoopTimerWindow windows[2];
+
+  /// \brief Index of the half of the window being filled.
+  public: int current = 0;
+};
+
+//////////////////////////////////////////////////
+LoopTimer::LoopTimer(const clock::duration &_period, std::size_t _windowSize)
+  : dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
+{
+  this->dataPtr->period = _period;
+  this->dataPtr->deadline = _period;
+  this->dataPtr->windowSize = std::max<std::size_t>(_windowSize, 1);
+}
+
+//////////////////////////////////////////////////
+clock::duration LoopTimer::Period() const
+{
+  return this->dataPtr->period;
+}
+
+//////////////////////////////////////////////////
+void LoopTimer::SetDeadline(const clock::duration &_deadline)
+{
+  this->dataPtr->deadline = _deadline;
+}
+
+//////////////////////////////////////////////////
+clock::duration LoopTimer::Deadline() const
+{
+  return this->dataPtr->deadline;
+}
+
+//////////////////////////////////////////////////
+std::size_t LoopTimer::WindowSize() const
+{
+  return this->dataPtr->windowSize;
+}
+
+//////////////////////////////////////////////////
+void LoopTimer::Begin()
+{
+  this->Begin(clock::now());
+}
+
+//////////////////////////////////////////////////
+void LoopTimer::Begin(const clock::time_point &_time)
+{
+  auto &d = *this->dataPtr;
+  if (d.windows[d.current].iterations == d.windowSize)
+  {
+    d.current = 1 - d.current;
+    d.windows[d.current].Reset();
+  }
+
+  LoopTimerWindow &window = d.windows[d.current];
+  if (d.iterations > 0)
+  {
+    d.lastPeriod = _time - d.beginTime;
+    const double period =
+      std::chrono::duration<double>(d.lastPeriod).count();
+    const double jitter = std::abs(
+      std::chrono::duration<double>(d.lastPeriod - d.period).count());
+    window.jitter.InsertData(jitter);
+    window.jitterMax = std::max(window.jitterMax, jitter);
+    window.periodSum += period;
+  }
+
+  ++window.iterations;
+  ++d.iterations;
+  d.beginTime = _time;
+  d.running = true;
+}
+
+//////////////////////////////////////////////////
+clock::duration LoopTimer::End()
+{
+  return this->End(clock::now());
+}
+
+//////////////////////////////////////////////////
+clock::duration LoopTimer::End(const clock::time_point &_time)
+{
+  auto &d = *this->dataPtr;
+  if (!d.running)
+    return clock::duration::zero();
+  d.running = false;
+
+  const clock::duration elapsed = _time - d.beginTime;
+  if (elapsed > d.deadline)
+    ++d.deadlineMisses;
+
+  LoopTimerWindow &window = d.windows[d.current];
+  const double executionTime =
+    std::chrono::duration<double>(elapsed).count();
+  window.executionTime.InsertData(executionTime);
+  window.executionTimeMax = std::max(window.executionTimeMax, executionTime);
+  return elapsed;
+}
+
+//////////////////////////////////////////////////
+void LoopTimer::Reset()
+{
+  auto &d = *this->dataPtr;
+  d.windows[0].Reset();
+  d.windows[1].Reset();
+  d.current = 0;
+  d.lastPeriod = clock::duration::zero();
+  d.running = false;
+  d.iterations = 0;
+  d.deadlineMisses = 0;
+}
+
+//////////////////////////////////////////////////
+uint64_t LoopTimer::Iterations() const
+{
+  return this->dataPtr->iterations;
+}
+
+//////////////////////////////////////////////////
+uint64_t LoopTimer::DeadlineMisses() const
+{
+  return this->dataPtr->deadlineMisses;
+}
+
+//////////////////////////////////////////////////
+clock::duration LoopTimer::LastPeriod() const
+{
+  return this->dataPtr->lastPeriod;
+}
+
+//////////////////////////////////////////////////
+double LoopTimer::PeriodMean() const
+{
+  const auto &w = this->dataPtr->windows;
+  const std::size_t periods = w[0].jitter.Count() + w[1].jitter.Count();
+  if (periods == 0)
+    return 0.0;
+  return (w[0].periodSum + w[1].periodSum) / static_cast<double>(periods);
+}
+
+//////////////////////////////////////////////////
+double LoopTimer::JitterMax() const
+{
+  const auto &w = this->dataPtr->windows;
+  return std::max(w[0].jitterMax, w[1].jitterMax);
+}
+
+//////////////////////////////////////////////////
+double LoopTimer::JitterQuantile(double _quantile) const
+{
+  return this->dataPtr->Quantile(&LoopTimerWindow::jitter, _quantile);
+}
+
+//////////////////////////////////////////////////
+double LoopTimer::ExecutionTimeMax() const
+{
+  const auto &w = this->dataPtr->windows;
+  return std::max(w[0].executionTimeMax, w[1].executionTimeMax);
+}
+
+//////////////////////////////////////////////////
+double LoopTimer::ExecutionTimeQuantile(double _quantile) const
+{
+  return this->dataPtr->Quantile(&LoopTimerWindow::executionTime,
+                                 _quantile);
+}
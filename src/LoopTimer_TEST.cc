@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "gz/math/LoopTimer.hh"
+
+using namespace gz;
+using namespace math;
+using std::chrono::microseconds;
+
+/////////////////////////////////////////////////
+TEST(LoopTimerTest, Constructor)
+{
+  LoopTimer timer(std::chrono::milliseconds(2), 0);
+  EXPECT_EQ(std::chrono::milliseconds(2), timer.Period());
+  EXPECT_EQ(std::chrono::milliseconds(2), timer.Deadline());
+  EXPECT_EQ(1u, timer.WindowSize());
+  EXPECT_EQ(0u, timer.Iterations());
+  EXPECT_EQ(0u, timer.DeadlineMisses());
+  EXPECT_EQ(clock::duration::zero(), timer.LastPeriod());
+  EXPECT_DOUBLE_EQ(0.0, timer.PeriodMean());
+  EXPECT_DOUBLE_EQ(0.0, timer.JitterMax());
+  EXPECT_DOUBLE_EQ(0.0, timer.JitterQuantile(0.99));
+  EXPECT_DOUBLE_EQ(0.0, timer.ExecutionTimeMax());
+  EXPECT_DOUBLE_EQ(0.0, timer.ExecutionTimeQuantile(0.99));
+
+  // End without Begin is ignored
+  EXPECT_EQ(clock::duration::zero(), timer.End());
+
+  timer.SetDeadline(microseconds(1500));
+  EXPECT_EQ(microseconds(1500), timer.Deadline());
+}
+
+/////////////////////////////////////////////////
+TEST(LoopTimerTest, Iterations)
+{
+  LoopTimer timer(microseconds(1000));
+  timer.SetDeadline(microseconds(500));
+
+  // Periods alternate between 990 and 1010 us, except for one of 1100 us,
+  // and execution times grow from 100 us to 599 us.
+  clock::time_point time;
+  for (int i = 0; i < 500; ++i)
+  {
+    timer.Begin(time);
+    EXPECT_EQ(microseconds(100 + i), timer.End(time + microseconds(100 + i)));
+    time += microseconds(i == 250 ? 1100 : (i % 2 ? 990 : 1010));
+  }
+
+  EXPECT_EQ(500u, timer.Iterations());
+  EXPECT_EQ(99u, timer.DeadlineMisses());
+  EXPECT_EQ(microseconds(1010), timer.LastPeriod());
+  EXPECT_NEAR(1e-3, timer.PeriodMean(), 1e-6);
+  EXPECT_NEAR(100e-6, timer.JitterMax(), 1e-12);
+  EXPECT_NEAR(10e-6, timer.JitterQuantile(0.5), 1e-12);
+  EXPECT_NEAR(10e-6, timer.JitterQuantile(0.99), 1e-12);
+  EXPECT_NEAR(100e-6, timer.JitterQuantile(1.0), 1e-12);
+  EXPECT_NEAR(599e-6, timer.ExecutionTimeMax(), 1e-12);
+  EXPECT_NEAR(100e-6, timer.ExecutionTimeQuantile(0.0), 1e-12);
+  EXPECT_NEAR(350e-6, timer.ExecutionTimeQuantile(0.5), 2e-6);
+  EXPECT_NEAR(594e-6, timer.ExecutionTimeQuantile(0.99), 2e-6);
+
+  timer.Reset();
+  EXPECT_EQ(0u, timer.Iterations());
+  EXPECT_EQ(0u, timer.DeadlineMisses());
+  EXPECT_DOUBLE_EQ(0.0, timer.JitterMax());
+  EXPECT_DOUBLE_EQ(0.0, timer.ExecutionTimeMax());
+
+  // The first period is measured from the first Begin after Reset
+  timer.Begin(time + microseconds(5000));
+  timer.Begin(time + microseconds(6000));
+  EXPECT_EQ(2u, timer.Iterations());
+  EXPECT_EQ(microseconds(1000), timer.LastPeriod());
+  EXPECT_DOUBLE_EQ(0.0, timer.JitterMax());
+}
+
+/////////////////////////////////////////////////
+TEST(LoopTimerTest, RollingWindow)
+{
+  LoopTimer timer(microseconds(1000), 10);
+
+  // A late iteration, then regular ones
+  clock::time_point time;
+  timer.Begin(time);
+  time += microseconds(1400);
+  for (int i = 0; i < 10; ++i)
+  {
+    timer.Begin(time);
+    timer.End(time + microseconds(i == 0 ? 900 : 100));
+    time += microseconds(1000);
+  }
+  EXPECT_NEAR(400e-6, timer.JitterMax(), 1e-12);
+  EXPECT_NEAR(900e-6, timer.ExecutionTimeMax(), 1e-12);
+
+  // Still in the previous half of the window
+  for (int i = 0; i < 9; ++i)
+  {
+    timer.Begin(time);
+    timer.End(time + microseconds(100));
+    time += microseconds(1000);
+  }
+  EXPECT_NEAR(400e-6, timer.JitterMax(), 1e-12);
+  EXPECT_NEAR(900e-6, timer.ExecutionTimeMax(), 1e-12);
+
+  // Dropped once the current half fills up
+  for (int i = 0; i < 10; ++i)
+  {
+    timer.Begin(time);
+    timer.End(time + microseconds(100));
+    time += microseconds(1000);
+  }
+  EXPECT_NEAR(0.0, timer.JitterMax(), 1e-12);
+  EXPECT_NEAR(100e-6, timer.ExecutionTimeMax(), 1e-12);
+  EXPECT_NEAR(100e-6, timer.ExecutionTimeQuantile(0.99), 1e-12);
+  EXPECT_NEAR(1e-3, timer.PeriodMean(), 1e-12);
+  EXPECT_EQ(30u, timer.Iterations());
+}
+
+/////////////////////////////////////////////////
+TEST(LoopTimerTest, Clock)
+{
+  LoopTimer timer(microseconds(100));
+  timer.Begin();
+  const clock::duration elapsed = timer.End();
+  EXPECT_GE(elapsed, clock::duration::zero());
+  EXPECT_EQ(1u, timer.Iterations());
+  EXPECT_GE(timer.ExecutionTimeMax(), 0.0);
+}
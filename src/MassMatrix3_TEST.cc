@@ -17,10 +17,14 @@
 
 #include <gtest/gtest.h>
 #include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 #include "gz/math/Helpers.hh"
 #include "gz/math/MassMatrix3.hh"
 #include "gz/math/Material.hh"
+#include "gz/math/Pose3.hh"
 
 using namespace gz;
 
@@ -681,6 +685,45 @@ TEST(MassMatrix3dTest, PrincipalAxesOffsetNoRepeat)
     math::Vector3d(2, 2, 2));
 }
 
+/////////////////////////////////////////////////
+TEST(MassMatrix3dTest, PrincipalAxes)
+{
+  // box 9x4x1 rotated by 45 degrees around Z
+  math::MassMatrix3d m(12.0, math::Vector3d(49.5, 49.5, 97),
+                       math::Vector3d(-32.5, 0.0, 0.0));
+  math::Vector3d moments;
+  math::Quaterniond offset;
+  EXPECT_TRUE(m.PrincipalAxes(moments, offset));
+  EXPECT_EQ(m.PrincipalMoments(), moments);
+  EXPECT_EQ(m.PrincipalAxesOffset(), offset);
+  VerifyPrincipalMomentsAndAxes(m);
+
+  // Nearly repeated moments still reconstruct the matrix
+  for (const double eps : {1e-3, 1e-5, 1e-7})
+  {
+    math::MassMatrix3d m2;
+    EXPECT_TRUE(m2.SetFromBox(1.0, math::Vector3d(1, 1 + eps, 2),
+                              math::Quaterniond(0.3, -0.4, 1.2)));
+    EXPECT_TRUE(m2.PrincipalAxes(moments, offset));
+    const math::Matrix3d R(offset);
+    const math::Matrix3d L(moments[0], 0, 0,
+                           0, moments[1], 0,
+                           0, 0, moments[2]);
+    EXPECT_EQ(m2.Moi(), R * L * R.Transposed()) << eps;
+  }
+
+  math::Vector3d size;
+  math::Quaterniond rot;
+  EXPECT_TRUE(m.EquivalentBox(size, rot));
+  EXPECT_EQ(math::Vector3d(9, 4, 1), size);
+
+  // Diagonal matrices keep their order with identity axes
+  EXPECT_TRUE(m.SetIxy(0.0));
+  EXPECT_TRUE(m.PrincipalAxes(moments, offset));
+  EXPECT_EQ(math::Vector3d(49.5, 49.5, 97), moments);
+  EXPECT_EQ(math::Quaterniond::Identity, offset);
+}
+
 /////////////////////////////////////////////////
 TEST(MassMatrix3dTest, EquivalentBox)
 {
@@ -926,6 +969,224 @@ TEST(MassMatrix3dTest, SetFromSphere)
   }
 }
 
+/////////////////////////////////////////////////
+/// \brief Orient the triangles of a mesh that is star-shaped around a
+/// center so that they face outwards.
+void OrientOutwards(const std::vector<math::Vector3d> &_vertices,
+                    std::vector<unsigned int> &_indices,
+                    const math::Vector3d &_center)
+{
+  for (std::size_t i = 0; i < _indices.size(); i += 3)
+  {
+    const math::Vector3d &a = _vertices[_indices[i]];
+    const math::Vector3d &b = _vertices[_indices[i + 1]];
+    const math::Vector3d &c = _vertices[_indices[i + 2]];
+    if ((b - a).Cross(c - a).Dot(a + b + c - 3 * _center) < 0)
+      std::swap(_indices[i + 1], _indices[i + 2]);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Triangle mesh of a box.
+void BoxMesh(const math::Vector3d &_size, const math::Pose3d &_pose,
+             std::vector<math::Vector3d> &_vertices,
+             std::vector<unsigned int> &_indices)
+{
+  _vertices.clear();
+  for (int i = 0; i < 8; ++i)
+  {
+    const math::Vector3d corner(
+        (i & 1) ? 0.5 : -0.5, (i & 2) ? 0.5 : -0.5, (i & 4) ? 0.5 : -0.5);
+    _vertices.push_back(_pose.CoordPositionAdd(corner * _size));
+  }
+  const unsigned int quads[6][4] = {
+      {0, 2, 6, 4}, {1, 3, 7, 5}, {0, 1, 5, 4},
+      {2, 3, 7, 6}, {0, 1, 3, 2}, {4, 5, 7, 6}};
+  _indices.clear();
+  for (const auto &quad : quads)
+  {
+    _indices.insert(_indices.end(), {quad[0], quad[1], quad[2]});
+    _indices.insert(_indices.end(), {quad[0], quad[2], quad[3]});
+  }
+  OrientOutwards(_vertices, _indices, _pose.Pos());
+}
+
+/////////////////////////////////////////////////
+/// \brief Triangle mesh of a sphere with rings of latitude.
+void SphereMesh(const double _radius, const unsigned int _rings,
+                const unsigned int _segments,
+                std::vector<math::Vector3d> &_vertices,
+                std::vector<unsigned int> &_indices)
+{
+  _vertices.assign({math::Vector3d(0, 0, -_radius),
+                    math::Vector3d(0, 0, _radius)});
+  for (unsigned int i = 1; i < _rings; ++i)
+  {
+    const double theta = GZ_PI * i / _rings;
+    for (unsigned int j = 0; j < _segments; ++j)
+    {
+      const double phi = 2 * GZ_PI * j / _segments;
+      _vertices.push_back(_radius * math::Vector3d(
+          std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi),
+          -std::cos(theta)));
+    }
+  }
+  auto vertex = [&](unsigned int _ring, unsigned int _segment)
+  {
+    return 2 + (_ring - 1) * _segments + _segment % _segments;
+  };
+  _indices.clear();
+  for (unsigned int j = 0; j < _segments; ++j)
+  {
+    _indices.insert(_indices.end(), {0, vertex(1, j), vertex(1, j + 1)});
+    _indices.insert(_indices.end(),
+        {1, vertex(_rings - 1, j), vertex(_rings - 1, j + 1)});
+    for (unsigned int i = 1; i + 1 < _rings; ++i)
+    {
+      _indices.insert(_indices.end(),
+          {vertex(i, j), vertex(i + 1, j), vertex(i + 1, j + 1)});
+      _indices.insert(_indices.end(),
+          {vertex(i, j), vertex(i + 1, j + 1), vertex(i, j + 1)});
+    }
+  }
+  OrientOutwards(_vertices, _indices, math::Vector3d::Zero);
+}
+
+/////////////////////////////////////////////////
+TEST(MassMatrix3dTest, SetFromTriangleMesh)
+{
+  const math::Vector3d size(2, 3, 4);
+  std::vector<math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+
+  // Box away from the origin
+  {
+    BoxMesh(size, math::Pose3d(10, -5, 3, 0, 0, 0), vertices, indices);
+    double volume;
+    math::Vector3d center;
+    math::Matrix3d unitMoi;
+    EXPECT_TRUE(math::MassMatrix3d::TriangleMeshMoments(vertices.data(),
+        vertices.size(), indices.data(), indices.size() / 3, volume, center,
+        unitMoi));
+    EXPECT_NEAR(24.0, volume, 1e-12);
+    EXPECT_EQ(math::Vector3d(10, -5, 3), center);
+
+    math::MassMatrix3d expected;
+    EXPECT_TRUE(expected.SetFromBox(6.0, size));
+    math::MassMatrix3d m;
+    center = math::Vector3d::Zero;
+    EXPECT_TRUE(m.SetFromTriangleMesh(6.0, vertices.data(), vertices.size(),
+        indices.data(), indices.size() / 3, center));
+    EXPECT_EQ(expected, m);
+    EXPECT_EQ(math::Vector3d(10, -5, 3), center);
+
+    // Material
+    EXPECT_TRUE(expected.SetFromBox(math::Material(0.5), size));
+    EXPECT_TRUE(m.SetFromTriangleMesh(math::Material(0.5), vertices.data(),
+        vertices.size(), indices.data(), indices.size() / 3, center));
+    EXPECT_DOUBLE_EQ(12.0, m.Mass());
+    EXPECT_EQ(expected, m);
+
+    // Triangles facing inwards
+    for (std::size_t i = 0; i < indices.size(); i += 3)
+      std::swap(indices[i + 1], indices[i + 2]);
+    math::MassMatrix3d inwards;
+    EXPECT_TRUE(inwards.SetFromTriangleMesh(math::Material(0.5),
+        vertices.data(), vertices.size(), indices.data(), indices.size() / 3,
+        center));
+    EXPECT_EQ(m, inwards);
+    EXPECT_EQ(math::Vector3d(10, -5, 3), center);
+  }
+
+  // Rotated box
+  {
+    const math::Quaterniond rot(0.3, -0.4, 1.2);
+    BoxMesh(size, math::Pose3d(math::Vector3d(1, 2, 3), rot), vertices,
+            indices);
+    math::MassMatrix3d expected;
+    EXPECT_TRUE(expected.SetFromBox(6.0, size, rot));
+    math::MassMatrix3d m;
+    math::Vector3d center;
+    EXPECT_TRUE(m.SetFromTriangleMesh(6.0, vertices.data(), vertices.size(),
+        indices.data(), indices.size() / 3, center));
+    EXPECT_EQ(expected, m);
+    EXPECT_EQ(math::Vector3d(1, 2, 3), center);
+  }
+
+  // Invalid input
+  {
+    BoxMesh(size, math::Pose3d::Zero, vertices, indices);
+    math::MassMatrix3d m;
+    math::Vector3d center;
+    EXPECT_FALSE(m.SetFromTriangleMesh(0.0, vertices.data(),
+        vertices.size(), indices.data(), indices.size() / 3, center));
+    EXPECT_FALSE(m.SetFromTriangleMesh(math::Material(0), vertices.data(),
+        vertices.size(), indices.data(), indices.size() / 3, center));
+    EXPECT_FALSE(m.SetFromTriangleMesh(1.0, nullptr, 0, nullptr, 0,
+        center));
+    EXPECT_FALSE(m.SetFromTriangleMesh(1.0, vertices.data(),
+        vertices.size(), indices.data(), 0, center));
+    // Index out of range
+    EXPECT_FALSE(m.SetFromTriangleMesh(1.0, vertices.data(),
+        vertices.size() - 1, indices.data(), indices.size() / 3, center));
+    // No enclosed volume
+    EXPECT_FALSE(m.SetFromTriangleMesh(1.0, vertices.data(),
+        vertices.size(), indices.data(), 2, center));
+    EXPECT_DOUBLE_EQ(0.0, m.Mass());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(MassMatrix3dTest, SetFromTriangleMeshThreads)
+{
+  // Enough triangles for several chunks
+  const double radius = 2.0;
+  std::vector<math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  SphereMesh(radius, 200, 400, vertices, indices);
+  ASSERT_GT(indices.size() / 3, 100000u);
+
+  double volume;
+  math::Vector3d center;
+  math::Matrix3d unitMoi;
+  EXPECT_TRUE(math::MassMatrix3d::TriangleMeshMoments(vertices.data(),
+      vertices.size(), indices.data(), indices.size() / 3, volume, center,
+      unitMoi));
+  const double sphereVolume = 4.0 / 3.0 * GZ_PI * std::pow(radius, 3);
+  EXPECT_NEAR(sphereVolume, volume, 1e-3 * sphereVolume);
+  EXPECT_NEAR(0.0, center.Length(), 1e-12);
+  const double sphereMoi = 0.4 * sphereVolume * radius * radius;
+  for (int i = 0; i < 3; ++i)
+  {
+    EXPECT_NEAR(sphereMoi, unitMoi(i, i), 2e-3 * sphereMoi);
+    EXPECT_NEAR(0.0, unitMoi(i, (i + 1) % 3), 1e-9);
+  }
+
+  // The result does not depend on the number of threads
+  for (const unsigned int threads : {0u, 2u, 3u, 16u})
+  {
+    double volume2;
+    math::Vector3d center2;
+    math::Matrix3d unitMoi2;
+    EXPECT_TRUE(math::MassMatrix3d::TriangleMeshMoments(vertices.data(),
+        vertices.size(), indices.data(), indices.size() / 3, volume2,
+        center2, unitMoi2, threads));
+    EXPECT_EQ(volume, volume2) << threads;
+    for (int i = 0; i < 3; ++i)
+    {
+      EXPECT_EQ(center[i], center2[i]) << threads;
+      for (int j = 0; j < 3; ++j)
+        EXPECT_EQ(unitMoi(i, j), unitMoi2(i, j)) << threads;
+    }
+  }
+
+  // An invalid index in a chunk handled by another thread
+  indices.back() = static_cast<unsigned int>(vertices.size());
+  EXPECT_FALSE(math::MassMatrix3d::TriangleMeshMoments(vertices.data(),
+      vertices.size(), indices.data(), indices.size() / 3, volume, center,
+      unitMoi, 4));
+}
+
 /////////////////////////////////////////////////
 TEST(MassMatrix3dTest, ValidMomentsTolerance)
 {
@@ -972,3 +1233,90 @@ TEST(MassMatrix3dTest, ValidMomentsTolerance)
   EXPECT_FALSE(massMatrix.IsNearPositive(-1));
   EXPECT_FALSE(massMatrix.IsPositive(-1));
 }
+
+/////////////////////////////////////////////////
+template<typename T>
+void CheckValidate()
+{
+  using M = math::MassMatrix3<T>;
+  std::vector<M> matrices;
+  // Valid, diagonal, rotated, degenerate, triangle inequality violated,
+  // indefinite and negative mass
+  M box;
+  EXPECT_TRUE(box.SetFromBox(T(2), math::Vector3<T>(1, 2, 3)));
+  matrices.push_back(box);
+  matrices.push_back(M(1, math::Vector3<T>(2, 3, 4),
+    math::Vector3<T>(0.1, 0.2, 0.3)));
+  matrices.push_back(M(1, math::Vector3<T>(2, 2, 2),
+    math::Vector3<T>(0, 0, 0)));
+  matrices.push_back(M(0, math::Vector3<T>(0, 0, 0),
+    math::Vector3<T>(0, 0, 0)));
+  matrices.push_back(M(1, math::Vector3<T>(1, 1, 3),
+    math::Vector3<T>(0, 0, 0)));
+  matrices.push_back(M(1, math::Vector3<T>(1, 1, 1),
+    math::Vector3<T>(2, 0, 0)));
+  matrices.push_back(M(-1, math::Vector3<T>(2, 3, 4),
+    math::Vector3<T>(0, 0, 0)));
+  matrices.push_back(M(1, math::Vector3<T>(2, 2, 4),
+    math::Vector3<T>(T(1e-9), 0, 0)));
+  for (int i = 0; i < 200; ++i)
+  {
+    const T a = static_cast<T>(i % 7) * T(0.5);
+    const T b = static_cast<T>(i % 11) * T(0.3);
+    matrices.push_back(M(static_cast<T>(i % 3),
+      math::Vector3<T>(1 + a, 2 - b, T(0.5) + a * b),
+      math::Vector3<T>(T(0.1) * a, -T(0.2) * b, T(0.05) * (a - b))));
+  }
+
+  std::vector<T> mass, ixx, iyy, izz, ixy, ixz, iyz;
+  for (const M &m : matrices)
+  {
+    mass.push_back(m.Mass());
+    ixx.push_back(m.Ixx());
+    iyy.push_back(m.Iyy());
+    izz.push_back(m.Izz());
+    ixy.push_back(m.Ixy());
+    ixz.push_back(m.Ixz());
+    iyz.push_back(m.Iyz());
+  }
+
+  for (const T tolerance : {T(10), T(0), T(1e8)})
+  {
+    std::vector<std::uint8_t> flags(matrices.size());
+    const std::size_t valid = M::Validate(mass.data(), ixx.data(),
+      iyy.data(), izz.data(), ixy.data(), ixz.data(), iyz.data(),
+      flags.data(), matrices.size(), tolerance);
+
+    std::size_t expectedValid = 0;
+    std::size_t invalid = 0;
+    for (std::size_t i = 0; i < matrices.size(); ++i)
+    {
+      const M &m = matrices[i];
+      EXPECT_EQ(m.IsNearPositive(tolerance),
+        (flags[i] & M::kNearPositive) != 0) << i;
+      EXPECT_EQ(m.IsPositive(tolerance), (flags[i] & M::kPositive) != 0)
+        << i;
+      EXPECT_EQ(M::ValidMoments(m.PrincipalMoments(), tolerance),
+        (flags[i] & M::kValidMoments) != 0) << i;
+      EXPECT_EQ(m.IsValid(tolerance), (flags[i] & M::kValid) == M::kValid)
+        << i;
+      expectedValid += m.IsValid(tolerance);
+      invalid += !m.IsValid(tolerance);
+    }
+    EXPECT_EQ(expectedValid, valid);
+    EXPECT_GT(invalid, 0u);
+    EXPECT_GT(valid, 0u);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(MassMatrix3dTest, Validate)
+{
+  CheckValidate<double>();
+  CheckValidate<float>();
+
+  std::uint8_t flags = 0xff;
+  EXPECT_EQ(0u, math::MassMatrix3d::Validate(nullptr, nullptr, nullptr,
+    nullptr, nullptr, nullptr, nullptr, &flags, 0));
+  EXPECT_EQ(0xff, flags);
+}
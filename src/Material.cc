@@ -18,6 +18,7 @@
 #include "gz/math/Material.hh"
 
 #include <algorithm>
+#include <array>
 #include <memory>
 
 #include "gz/math/Helpers.hh"
@@ -60,32 +61,21 @@ Material::Material()
 Material::Material(const MaterialType _type)
 : Material()
 {
-  auto iter = std::find_if(std::begin(kMaterialData), std::end(kMaterialData),
-                           [_type](const auto& item) {
-                             return item.first == _type;
-                           });
-  if (iter != std::end(kMaterialData))
-  {
-    this->dataPtr->SetFrom(*iter);
-  }
+  // kMaterialData is in enum order
+  const auto index = static_cast<std::size_t>(_type);
+  if (index < kMaterialData.size())
+    this->dataPtr->SetFrom(kMaterialData[index]);
 }
 
 ///////////////////////////////
 Material::Material(const std::string &_typename)
 : Material()
 {
-  // Convert to lowercase.
-  std::string material = _typename;
-  std::transform(material.begin(), material.end(), material.begin(), ::tolower);
-
-  auto iter = std::find_if(std::begin(kMaterialData), std::end(kMaterialData),
-                           [&material](const auto& item) {
-                             return item.second.name == material;
-                           });
-  if (iter != std::end(kMaterialData))
-  {
-    this->dataPtr->SetFrom(*iter);
-  }
+  // Case insensitive perfect hash lookup, without a lowercase copy.
+  const std::size_t index =
+      MaterialNameIndex(_typename.data(), _typename.size());
+  if (index < kMaterialData.size())
+    this->dataPtr->SetFrom(kMaterialData[index]);
 }
 
 ///////////////////////////////
@@ -100,24 +90,42 @@ const std::map<MaterialType, Material> &Material::Predefined()
 {
   using Map = std::map<MaterialType, Material>;
 
-  // Initialize the static map of Material objects based on the kMaterialData.
+  // Initialize the static map of Material objects from the table of
+  // Predefined(MaterialType), the only one built from kMaterialData.
   // We construct upon first use and never destroy it, in order to avoid the
   // [Static Initialization Order Fiasco](https://en.cppreference.com/w/cpp/language/siof).
+  // Nothing is done at load time: kMaterialData is a constexpr array.
   static const Map * const kMaterials = []()
   {
     auto temporary = std::make_unique<Map>();
     for (const auto &item : kMaterialData)
-    {
-      MaterialType type = item.first;
-      Material& material = (*temporary)[type];
-      material.dataPtr->SetFrom(item);
-    }
+      temporary->emplace_hint(temporary->end(), item.first,
+                              Material::Predefined(item.first));
     return temporary.release();
   }();
 
   return *kMaterials;
 }
 
+///////////////////////////////
+const Material &Material::Predefined(const MaterialType _type)
+{
+  using Array = std::array<Material, kMaterialData.size() + 1>;
+
+  // Indexed by type, with an unknown material last. Never destroyed for
+  // the same reason as the map above.
+  static const Array * const kMaterials = []()
+  {
+    auto temporary = std::make_unique<Array>();
+    for (std::size_t i = 0; i < kMaterialData.size(); ++i)
+      (*temporary)[i].dataPtr->SetFrom(kMaterialData[i]);
+    return temporary.release();
+  }();
+
+  const auto index = static_cast<std::size_t>(_type);
+  return (*kMaterials)[std::min(index, kMaterialData.size())];
+}
+
 ///////////////////////////////
 bool Material::operator==(const Material &_material) const
 {
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <type_traits>
+
+#include "gz/math/Material.hh"
+#include "gz/math/MaterialT.hh"
+#include "gz/math/MaterialType.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(MaterialTTest, Constructor)
+{
+  constexpr Materiald unknown;
+  static_assert(unknown.Type() == MaterialType::UNKNOWN_MATERIAL,
+                "Default material is unknown");
+  constexpr double unknownDensity = unknown.Density();
+  EXPECT_DOUBLE_EQ(-1, unknownDensity);
+  static_assert(std::is_trivially_copyable_v<Materialf>,
+                "Materialf should be trivially copyable");
+  EXPECT_EQ("", unknown.Name());
+
+  constexpr Materialf custom(12.5f);
+  constexpr float customDensity = custom.Density();
+  EXPECT_FLOAT_EQ(12.5f, customDensity);
+  EXPECT_EQ(MaterialType::UNKNOWN_MATERIAL, custom.Type());
+}
+
+/////////////////////////////////////////////////
+TEST(MaterialTTest, SameAsMaterial)
+{
+  for (int i = 0; i <= static_cast<int>(MaterialType::UNKNOWN_MATERIAL); ++i)
+  {
+    const auto type = static_cast<MaterialType>(i);
+    const Material expected(type);
+    const Materiald material(type);
+    EXPECT_EQ(expected.Type(), material.Type());
+    EXPECT_EQ(expected.Name(), material.Name());
+    EXPECT_DOUBLE_EQ(expected.Density(), material.Density());
+    EXPECT_EQ(expected, material.ToMaterial());
+    EXPECT_EQ(expected.Name(), material.ToMaterial().Name());
+    EXPECT_EQ(material, Materiald(expected));
+
+    const Materiald byName(expected.Name());
+    EXPECT_EQ(Materiald(Material(expected.Name())), byName);
+  }
+
+  EXPECT_EQ(MaterialType::STEEL_STAINLESS,
+            Materialf(std::string("Steel_Stainless")).Type());
+  EXPECT_EQ(MaterialType::UNKNOWN_MATERIAL,
+            Materialf(std::string("unobtainium")).Type());
+}
+
+/////////////////////////////////////////////////
+TEST(MaterialTTest, Set)
+{
+  Materialf material(MaterialType::WOOD);
+  EXPECT_NE(Materialf(MaterialType::PINE), material);
+
+  material.SetDensity(100);
+  EXPECT_EQ(MaterialType::WOOD, material.Type());
+  EXPECT_FLOAT_EQ(100, material.Density());
+  material.SetType(MaterialType::STEEL_ALLOY);
+  EXPECT_EQ("steel_alloy", material.Name());
+
+  Material expected;
+  expected.SetToNearestDensity(19300);
+  material.SetToNearestDensity(19300);
+  EXPECT_EQ(expected.Type(), material.Type());
+  EXPECT_FLOAT_EQ(static_cast<float>(expected.Density()),
+                  material.Density());
+
+  // Too far from any built-in density
+  material.SetToNearestDensity(1e6f, 1);
+  EXPECT_EQ(expected.Type(), material.Type());
+}
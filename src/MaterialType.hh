@@ -18,6 +18,8 @@
 #define GZ_MATH_SRC_MATERIAL_TYPE_HH_
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <utility>
 
 using namespace gz;
@@ -55,4 +57,125 @@ constexpr std::array<std::pair<MaterialType, MaterialData>, 13> kMaterialData =
   {MaterialType::COPPER, {"copper", 8940.0}},
   {MaterialType::TUNGSTEN, {"tungsten", 19300.0}}
 }};
+
+// Check that kMaterialData is in the order of the MaterialType enum, so
+// that the data of a type is found by indexing.
+constexpr bool MaterialDataInEnumOrder()
+{
+  for (std::size_t i = 0; i < kMaterialData.size(); ++i)
+  {
+    if (static_cast<std::size_t>(kMaterialData[i].first) != i)
+      return false;
+  }
+  return kMaterialData.size() ==
+      static_cast<std::size_t>(MaterialType::UNKNOWN_MATERIAL);
+}
+static_assert(MaterialDataInEnumOrder(),
+    "kMaterialData must list every MaterialType in enum order");
+
+// Lowercase an ASCII character.
+constexpr char MaterialNameLower(const char _c)
+{
+  return (_c >= 'A' && _c <= 'Z') ? static_cast<char>(_c - 'A' + 'a') : _c;
+}
+
+// Length of a null-terminated material name.
+constexpr std::size_t MaterialNameLength(const char *_name)
+{
+  std::size_t length = 0;
+  while (_name[length] != '\0')
+    ++length;
+  return length;
+}
+
+// FNV-1a hash of a lowercased material name.
+constexpr std::uint32_t MaterialNameHash(const char *_name,
+    const std::size_t _length)
+{
+  std::uint32_t hash = 2166136261u;
+  for (std::size_t i = 0; i < _length; ++i)
+  {
+    hash ^= static_cast<unsigned char>(MaterialNameLower(_name[i]));
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// Number of slots in the material name hash table, a power of two.
+constexpr std::size_t kMaterialNameSlots = 32;
+
+// Slot of a material name hash for a seed, taken from the high bits of a
+// multiplicative hash.
+constexpr std::size_t MaterialNameSlot(const std::uint32_t _hash,
+    const std::uint32_t _seed)
+{
+  return static_cast<std::uint32_t>((_hash ^ _seed) * 2654435761u) >> 27;
+}
+static_assert(kMaterialNameSlots == 1u << (32 - 27),
+    "MaterialNameSlot must span the hash table");
+
+// Check that a seed maps every material name to a different slot.
+constexpr bool MaterialNameSeedIsPerfect(const std::uint32_t _seed)
+{
+  std::array<bool, kMaterialNameSlots> used{};
+  for (const auto &item : kMaterialData)
+  {
+    const std::size_t slot = MaterialNameSlot(MaterialNameHash(
+        item.second.name, MaterialNameLength(item.second.name)), _seed);
+    if (used[slot])
+      return false;
+    used[slot] = true;
+  }
+  return true;
+}
+
+// Smallest seed that gives a perfect hash of the material names.
+constexpr std::uint32_t MaterialNameSeed()
+{
+  std::uint32_t seed = 0;
+  while (seed < 1000 && !MaterialNameSeedIsPerfect(seed))
+    ++seed;
+  return seed;
+}
+constexpr std::uint32_t kMaterialNameSeed = MaterialNameSeed();
+static_assert(MaterialNameSeedIsPerfect(kMaterialNameSeed),
+    "No perfect hash seed found for the material names");
+
+// Slots of the material name hash table, holding an index in kMaterialData
+// plus one, or zero for an empty slot.
+constexpr std::array<std::uint8_t, kMaterialNameSlots> MaterialNameTable()
+{
+  std::array<std::uint8_t, kMaterialNameSlots> table{};
+  for (std::size_t i = 0; i < kMaterialData.size(); ++i)
+  {
+    const char *name = kMaterialData[i].second.name;
+    table[MaterialNameSlot(MaterialNameHash(name, MaterialNameLength(name)),
+        kMaterialNameSeed)] =
+        static_cast<std::uint8_t>(i + 1);
+  }
+  return table;
+}
+constexpr std::array<std::uint8_t, kMaterialNameSlots> kMaterialNameTable =
+    MaterialNameTable();
+
+// Find the index in kMaterialData of a material name, ignoring case.
+// Returns kMaterialData.size() if the name is unknown.
+constexpr std::size_t MaterialNameIndex(const char *_name,
+    const std::size_t _length)
+{
+  const std::uint8_t entry = kMaterialNameTable[MaterialNameSlot(
+      MaterialNameHash(_name, _length), kMaterialNameSeed)];
+  if (entry == 0)
+    return kMaterialData.size();
+  const char *name = kMaterialData[entry - 1].second.name;
+  for (std::size_t i = 0; i < _length; ++i)
+  {
+    if (name[i] == '\0' || name[i] != MaterialNameLower(_name[i]))
+      return kMaterialData.size();
+  }
+  return name[_length] == '\0' ? entry - 1u : kMaterialData.size();
+}
+static_assert(MaterialNameIndex("Steel_Alloy", 11) ==
+    static_cast<std::size_t>(MaterialType::STEEL_ALLOY),
+    "Material name lookup is broken");
 #endif
@@ -16,6 +16,10 @@
 */
 
 #include <gtest/gtest.h>
+
+#include <cctype>
+#include <string>
+
 #include "gz/math/Material.hh"
 #include "gz/math/MaterialType.hh"
 #include "gz/math/Helpers.hh"
@@ -141,3 +145,39 @@ TEST(MaterialTest, Accessors)
     EXPECT_DOUBLE_EQ(19300, material.Density());
   }
 }
+
+/////////////////////////////////////////////////
+TEST(MaterialTest, Lookup)
+{
+  for (const auto &item : Material::Predefined())
+  {
+    const Material &material = Material::Predefined(item.first);
+    EXPECT_EQ(item.second, material);
+    EXPECT_EQ(item.second.Name(), material.Name());
+    EXPECT_EQ(&material, &Material::Predefined(item.first));
+
+    // Names are matched ignoring case
+    std::string upper = material.Name();
+    for (char &c : upper)
+      c = static_cast<char>(std::toupper(c));
+    EXPECT_EQ(material, Material(upper));
+    EXPECT_EQ(material, Material(material.Name()));
+
+    // Prefixes and extensions of a name are not matched
+    EXPECT_EQ(MaterialType::UNKNOWN_MATERIAL,
+              Material(material.Name() + "s").Type());
+    EXPECT_EQ(MaterialType::UNKNOWN_MATERIAL,
+              Material(material.Name().substr(0, 2)).Type());
+  }
+
+  EXPECT_EQ(MaterialType::UNKNOWN_MATERIAL, Material("").Type());
+  EXPECT_EQ(MaterialType::UNKNOWN_MATERIAL, Material("gold").Type());
+  EXPECT_EQ(MaterialType::UNKNOWN_MATERIAL,
+            Material(std::string("iron\0x", 6)).Type());
+
+  const Material &unknown = Material::Predefined(
+      MaterialType::UNKNOWN_MATERIAL);
+  EXPECT_EQ(MaterialType::UNKNOWN_MATERIAL, unknown.Type());
+  EXPECT_DOUBLE_EQ(-1.0, unknown.Density());
+  EXPECT_EQ(&unknown, &Material::Predefined(static_cast<MaterialType>(42)));
+}
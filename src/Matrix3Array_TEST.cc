@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "gz/math/Matrix3.hh"
+#include "gz/math/Matrix3Array.hh"
+#include "gz/math/Quaternion.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+std::vector<math::Matrix3d> TestMatrices()
+{
+  return {
+    math::Matrix3d::Identity,
+    math::Matrix3d(1, 2, 3, 0, 1, 4, 5, 6, 0),
+    math::Matrix3d(-2, 0.5, 1, 3, -1, 2, 0.25, 4, -3),
+    math::Matrix3d(math::Quaterniond(0.1, 0.2, 0.3)),
+    math::Matrix3d(math::Quaterniond(-1.2, 0.5, 2.9)) * 2.0,
+    math::Matrix3d(1e-3, 0, 0, 0, 1e3, 0, 0, 0, 1)};
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix3ArrayTest, Construction)
+{
+  math::Matrix3Arrayd identities(3);
+  ASSERT_EQ(3u, identities.Size());
+  for (std::size_t i = 0; i < identities.Size(); ++i)
+    EXPECT_EQ(math::Matrix3d::Identity, identities[i]);
+
+  const auto matrices = TestMatrices();
+  math::Matrix3Arrayd array(matrices);
+  ASSERT_EQ(matrices.size(), array.Size());
+  for (std::size_t i = 0; i < matrices.size(); ++i)
+  {
+    EXPECT_EQ(matrices[i], array[i]);
+    for (std::size_t r = 0; r < 3; ++r)
+    {
+      for (std::size_t c = 0; c < 3; ++c)
+        EXPECT_DOUBLE_EQ(matrices[i](r, c), array.Element(r, c)[i]);
+    }
+  }
+  EXPECT_EQ(matrices, array.ToVector());
+
+  array.Set(1, math::Matrix3d::Zero);
+  EXPECT_EQ(math::Matrix3d::Zero, array[1]);
+  array.PushBack(math::Matrix3d(1, 2, 3, 4, 5, 6, 7, 8, 9));
+  ASSERT_EQ(matrices.size() + 1, array.Size());
+  EXPECT_EQ(math::Matrix3d(1, 2, 3, 4, 5, 6, 7, 8, 9),
+            array[matrices.size()]);
+  array.Resize(1);
+  EXPECT_EQ(1u, array.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix3ArrayTest, DeterminantInverse)
+{
+  auto matrices = TestMatrices();
+  matrices.push_back(math::Matrix3d(1, 2, 3, 4, 5, 6, 7, 8, 9));
+  math::Matrix3Arrayd array(matrices);
+
+  std::vector<double> determinants;
+  array.Determinant(determinants);
+  ASSERT_EQ(matrices.size(), determinants.size());
+  for (std::size_t i = 0; i < matrices.size(); ++i)
+    EXPECT_DOUBLE_EQ(matrices[i].Determinant(), determinants[i]) << i;
+
+  array.Invert();
+  for (std::size_t i = 0; i + 1 < matrices.size(); ++i)
+  {
+    const math::Matrix3d expected = matrices[i].Inverse();
+    for (std::size_t r = 0; r < 3; ++r)
+    {
+      for (std::size_t c = 0; c < 3; ++c)
+        EXPECT_DOUBLE_EQ(expected(r, c), array[i](r, c)) << i;
+    }
+    EXPECT_TRUE((matrices[i] * array[i]).Equal(math::Matrix3d::Identity,
+        1e-12)) << i;
+  }
+
+  // The last matrix is singular
+  const math::Matrix3d singular = array[matrices.size() - 1];
+  EXPECT_FALSE(std::isfinite(singular(0, 0)));
+
+  math::Matrix3Arrayf floats(
+      {math::Matrix3f(2, 0, 1, 1, 3, 0, 0, 1, 4)});
+  floats.Invert();
+  EXPECT_EQ(math::Matrix3f(2, 0, 1, 1, 3, 0, 0, 1, 4).Inverse(), floats[0]);
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix3ArrayTest, Orthonormalize)
+{
+  std::vector<math::Matrix3d> matrices;
+  for (int i = 0; i < 100; ++i)
+  {
+    const math::Matrix3d rotation(
+        math::Quaterniond(0.1 * i, -0.05 * i, 0.2 - 0.03 * i));
+    const double drift = 1e-5 * (i % 10);
+    matrices.push_back(rotation + math::Matrix3d(
+        drift, -drift, 0, 2 * drift, 0, drift, 0, -drift, -3 * drift));
+  }
+  math::Matrix3Arrayd array(matrices);
+  array.Orthonormalize();
+  for (std::size_t i = 0; i < matrices.size(); ++i)
+  {
+    EXPECT_EQ(matrices[i].Orthonormalized(), array[i]) << i;
+    EXPECT_TRUE((array[i].Transposed() * array[i]).Equal(
+        math::Matrix3d::Identity, 1e-13)) << i;
+  }
+
+  math::Matrix3Arrayd once(matrices);
+  once.Orthonormalize(1);
+  math::Matrix3Arrayd none(matrices);
+  none.Orthonormalize(0);
+  for (std::size_t i = 0; i < matrices.size(); ++i)
+  {
+    EXPECT_EQ(matrices[i].Orthonormalized(1), once[i]) << i;
+    EXPECT_EQ(matrices[i], none[i]) << i;
+  }
+}
@@ -254,6 +254,18 @@ TEST(Matrix3dTest, Vector3Multiplication)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(Matrix3dTest, MultiplyAdd)
+{
+  const math::Matrix3d matrix(1, -2, 3, 4, 5.5, 6, -7, 8, 9);
+  const math::Vector3d vec(0.5, -1, 2);
+  const math::Vector3d add(10, -20, 0.25);
+
+  EXPECT_EQ(matrix * vec + add, matrix.MultiplyAdd(vec, add));
+  EXPECT_EQ(add, matrix.MultiplyAdd(math::Vector3d::Zero, add));
+  EXPECT_EQ(vec + add, math::Matrix3d::Identity.MultiplyAdd(vec, add));
+}
+
 /////////////////////////////////////////////////
 TEST(Matrix3dTest, NotEqual)
 {
@@ -417,3 +429,80 @@ TEST(Matrix3dTest, From2Axes)
   m1.SetFrom2Axes(v1, v2);
   EXPECT_EQ(math::Matrix3d::Zero - math::Matrix3d::Identity, m1);
 }
+
+/////////////////////////////////////////////////
+constexpr math::Matrix3d ConstexprMatrix3()
+{
+  math::Matrix3d m;
+  m.Set(1, 2, 3, 4, 5, 6, 7, 8, 10);
+  m.Transpose();
+  m(2, 2) = 11;
+  return m;
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix3dTest, Orthonormalize)
+{
+  // A rotation with a drift of about 1e-4
+  const math::Matrix3d rotation(math::Quaterniond(0.3, -1.2, 2.5));
+  math::Matrix3d drifted = rotation + math::Matrix3d(
+      1e-4, -2e-5, 3e-5, 5e-5, -8e-5, 1e-5, -4e-5, 2e-5, 6e-5);
+  EXPECT_FALSE((drifted.Transposed() * drifted).Equal(
+      math::Matrix3d::Identity, 1e-6));
+
+  const math::Matrix3d orthonormal = drifted.Orthonormalized();
+  EXPECT_TRUE((orthonormal.Transposed() * orthonormal).Equal(
+      math::Matrix3d::Identity, 1e-15)) << orthonormal;
+  EXPECT_NEAR(1.0, orthonormal.Determinant(), 1e-15);
+  EXPECT_TRUE(orthonormal.Equal(rotation, 2e-4));
+
+  // One iteration leaves an error of the order of the square of the drift
+  const math::Matrix3d once = drifted.Orthonormalized(1);
+  EXPECT_TRUE((once.Transposed() * once).Equal(
+      math::Matrix3d::Identity, 1e-7));
+  EXPECT_FALSE((once.Transposed() * once).Equal(
+      math::Matrix3d::Identity, 1e-15));
+
+  drifted.Orthonormalize();
+  EXPECT_EQ(orthonormal, drifted);
+
+  // Orthonormal matrices don't change
+  math::Matrix3d identity = math::Matrix3d::Identity;
+  identity.Orthonormalize(3);
+  EXPECT_EQ(math::Matrix3d::Identity, identity);
+  EXPECT_TRUE(rotation.Orthonormalized().Equal(rotation, 1e-15));
+
+  // A larger drift takes more iterations
+  math::Matrix3f scaled = math::Matrix3f(math::Quaternionf(0.1f, 0.2f, 0.3f)) *
+      1.2f;
+  scaled.Orthonormalize(5);
+  EXPECT_TRUE((scaled.Transposed() * scaled).Equal(
+      math::Matrix3f::Identity, 1e-6f));
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix3dTest, Constexpr)
+{
+  constexpr math::Matrix3d a(1, 2, 3, 4, 5, 6, 7, 8, 10);
+  constexpr math::Matrix3d b(2, 0, 0, 0, 3, 0, 0, 0, 4);
+  constexpr double det = a.Determinant();
+  EXPECT_DOUBLE_EQ(-3, det);
+
+  constexpr math::Matrix3d product = a * b;
+  EXPECT_EQ(math::Matrix3d(2, 6, 12, 8, 15, 24, 14, 24, 40), product);
+
+  constexpr math::Matrix3d transposed = a.Transposed();
+  EXPECT_EQ(math::Matrix3d(1, 4, 7, 2, 5, 8, 3, 6, 10), transposed);
+
+  constexpr math::Matrix3d sum = a + b - 2.0 * b;
+  EXPECT_EQ(math::Matrix3d(-1, 2, 3, 4, 2, 6, 7, 8, 6), sum);
+
+  constexpr math::Vector3d v = a * math::Vector3d(1, 0, -1);
+  EXPECT_EQ(math::Vector3d(-2, -2, -3), v);
+
+  constexpr math::Matrix3d zero;
+  EXPECT_EQ(math::Matrix3d::Zero, zero);
+
+  constexpr math::Matrix3d c = ConstexprMatrix3();
+  EXPECT_EQ(math::Matrix3d(1, 4, 7, 2, 5, 8, 3, 6, 11), c);
+}
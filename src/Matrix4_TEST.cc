@@ -17,6 +17,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "gz/math/Matrix4.hh"
 #include "gz/math/Pose3.hh"
 #include "gz/math/Quaternion.hh"
@@ -287,6 +289,55 @@ TEST(Matrix4dTest, Inverse)
                                  -12, 24, 19, -1));
 }
 
+/////////////////////////////////////////////////
+TEST(Matrix4dTest, InverseAffine)
+{
+  const math::Matrix4d pose(math::Pose3d(1, -2, 3, 0.4, -1.1, 2.7));
+  math::Matrix4d scaled = pose;
+  scaled.Scale(2, 0.5, -3);
+  scaled.SetTranslation(4, 5, -6);
+
+  for (const math::Matrix4d &mat : {pose, scaled, pose * scaled * pose})
+  {
+    const math::Matrix4d inverse = mat.InverseAffine();
+    EXPECT_TRUE((mat * inverse).Equal(math::Matrix4d::Identity, 1e-12));
+    EXPECT_TRUE((inverse * mat).Equal(math::Matrix4d::Identity, 1e-12));
+    EXPECT_EQ(0.0, inverse(3, 0));
+    EXPECT_EQ(0.0, inverse(3, 1));
+    EXPECT_EQ(0.0, inverse(3, 2));
+    EXPECT_EQ(1.0, inverse(3, 3));
+
+    // Products keep the last row exactly, so Inverse takes the same path
+    EXPECT_EQ(0.0, mat(3, 0));
+    EXPECT_EQ(1.0, mat(3, 3));
+    const math::Matrix4d general = mat.Inverse();
+    for (int i = 0; i < 4; ++i)
+    {
+      for (int j = 0; j < 4; ++j)
+        EXPECT_DOUBLE_EQ(inverse(i, j), general(i, j));
+    }
+  }
+
+  // A rigid transform is inverted by transposing the rotation
+  const math::Matrix4d rigid = pose.InverseRigid();
+  EXPECT_TRUE(rigid.Equal(pose.InverseAffine(), 1e-12));
+  EXPECT_TRUE(math::Matrix4d(pose.Pose().Inverse()).Equal(rigid, 1e-12));
+  EXPECT_EQ(math::Matrix4d::Identity, math::Matrix4d::Identity.InverseRigid());
+
+  // Almost affine matrices still get the general inverse
+  math::Matrix4d projective = scaled;
+  projective(3, 2) = 0.25;
+  EXPECT_TRUE((projective * projective.Inverse()).Equal(
+      math::Matrix4d::Identity, 1e-12));
+
+  // Float
+  const math::Matrix4f posef(math::Pose3f(1, -2, 3, 0.4f, -1.1f, 2.7f));
+  EXPECT_TRUE((posef * posef.InverseRigid()).Equal(
+      math::Matrix4f::Identity, 1e-6f));
+  EXPECT_TRUE((posef * posef.Inverse()).Equal(
+      math::Matrix4f::Identity, 1e-6f));
+}
+
 /////////////////////////////////////////////////
 TEST(Matrix4dTest, GetAsPose3d)
 {
@@ -741,3 +792,82 @@ TEST(Matrix4dTest, LookAt)
                 .Pose(),
             math::Pose3d(1, 1, 1, GZ_PI_4, 0, GZ_PI));
 }
+
+/////////////////////////////////////////////////
+TEST(Matrix4dTest, MultiplyMatchesReference)
+{
+  const math::Matrix4d a(
+      1.5, -2.0, 0.25, 4.0,
+      3.0, 0.5, -1.0, 2.0,
+      -0.75, 6.0, 2.5, -3.0,
+      0.1, 0.2, 0.3, 1.0);
+  const math::Matrix4d b(math::Pose3d(1, -2, 3, 0.4, -1.1, 2.7));
+
+  const math::Matrix4d result = a * b;
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    for (std::size_t j = 0; j < 4; ++j)
+    {
+      double expected = 0;
+      for (std::size_t k = 0; k < 4; ++k)
+        expected += a(i, k) * b(k, j);
+      EXPECT_NEAR(expected, result(i, j), 1e-12);
+    }
+  }
+
+  // Multiplying by identity is exact
+  EXPECT_EQ(a, a * math::Matrix4d::Identity);
+  EXPECT_EQ(a, math::Matrix4d::Identity * a);
+
+  // Self assignment
+  math::Matrix4d c = a;
+  c *= c;
+  EXPECT_TRUE(c.Equal(a * a, 1e-12));
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix4dTest, TransformAffineBatch)
+{
+  const math::Matrix4d mat(math::Pose3d(1, -2, 3, 0.4, -1.1, 2.7));
+
+  std::vector<math::Vector3d> points;
+  for (int i = 0; i < 25; ++i)
+    points.emplace_back(i * 0.5, -i * 1.5, 10.0 - i);
+
+  std::vector<math::Vector3d> out(points.size());
+  EXPECT_TRUE(mat.TransformAffine(points.data(), out.data(), points.size()));
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    math::Vector3d expected;
+    EXPECT_TRUE(mat.TransformAffine(points[i], expected));
+    EXPECT_DOUBLE_EQ(expected.X(), out[i].X());
+    EXPECT_DOUBLE_EQ(expected.Y(), out[i].Y());
+    EXPECT_DOUBLE_EQ(expected.Z(), out[i].Z());
+  }
+
+  // In place
+  std::vector<math::Vector3d> inPlace = points;
+  EXPECT_TRUE(mat.TransformAffine(inPlace));
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_EQ(out[i], inPlace[i]);
+
+  // Non affine matrices leave the output untouched
+  math::Matrix4d projective = mat;
+  projective(3, 2) = 0.5;
+  std::vector<math::Vector3d> unchanged = points;
+  EXPECT_FALSE(projective.TransformAffine(unchanged));
+  EXPECT_EQ(points, unchanged);
+
+  // Float
+  const math::Matrix4f matf(math::Pose3f(1, -2, 3, 0.4f, -1.1f, 2.7f));
+  std::vector<math::Vector3f> pointsf = {{1, 2, 3}, {-4, 5, -6}};
+  std::vector<math::Vector3f> outf(pointsf.size());
+  EXPECT_TRUE(matf.TransformAffine(pointsf.data(), outf.data(),
+      pointsf.size()));
+  for (std::size_t i = 0; i < pointsf.size(); ++i)
+  {
+    math::Vector3f expected;
+    EXPECT_TRUE(matf.TransformAffine(pointsf[i], expected));
+    EXPECT_EQ(expected, outf[i]);
+  }
+}
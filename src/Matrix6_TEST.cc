@@ -17,7 +17,12 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <cmath>
+#include <limits>
+
 #include "gz/math/Matrix6.hh"
+#include "gz/math/Quaternion.hh"
 
 using namespace gz;
 using namespace math;
@@ -393,3 +398,163 @@ TEST(Matrix6dTest, SetValue)
       4, 3, 2, 1, 0, -1,
       5, 4, 3, 2, 1, 0));
 }
+
+/////////////////////////////////////////////////
+/// \brief Spatial inertia of a body whose center of mass is at _com, with
+/// some added mass so that it is a full symmetric matrix.
+Matrix6d spatialInertia(double _mass, const Vector3d &_com)
+{
+  const Matrix3d skew(0, -_com.Z(), _com.Y(),
+                      _com.Z(), 0, -_com.X(),
+                      -_com.Y(), _com.X(), 0);
+  const Matrix3d moi(2, 0.1, -0.2, 0.1, 3, 0.3, -0.2, 0.3, 4);
+  Matrix6d inertia(Matrix3d::Identity * _mass, skew.Transposed() * _mass,
+                   skew * _mass, moi + skew * skew.Transposed() * _mass);
+  for (int i = 0; i < 6; ++i)
+  {
+    for (int j = 0; j < 6; ++j)
+      inertia(i, j) += 0.01 * (i + j);
+  }
+  return inertia;
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix6dTest, ConstructFromSubmatrices)
+{
+  const Matrix3d topLeft(1, 2, 3, 4, 5, 6, 7, 8, 9);
+  const Matrix3d topRight = topLeft * 10;
+  const Matrix3d bottomLeft = topLeft * 100;
+  const Matrix3d bottomRight = topLeft * 1000;
+  const Matrix6d mat(topLeft, topRight, bottomLeft, bottomRight);
+  EXPECT_EQ(topLeft, mat.Submatrix(Matrix6d::TOP_LEFT));
+  EXPECT_EQ(topRight, mat.Submatrix(Matrix6d::TOP_RIGHT));
+  EXPECT_EQ(bottomLeft, mat.Submatrix(Matrix6d::BOTTOM_LEFT));
+  EXPECT_EQ(bottomRight, mat.Submatrix(Matrix6d::BOTTOM_RIGHT));
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix6dTest, MultiplyVector)
+{
+  Matrix6d mat;
+  for (int i = 0; i < 6; ++i)
+  {
+    for (int j = 0; j < 6; ++j)
+      mat(i, j) = i - 2 * j;
+  }
+  const std::array<double, 6> v = {1, 2, 3, -4, 5, -6};
+  const std::array<double, 6> expected = {28, 29, 30, 31, 32, 33};
+  EXPECT_EQ(expected, mat * v);
+  EXPECT_EQ(expected, Matrix6d::Identity * (mat * v));
+
+  Vector3d top(1, 2, 3);
+  Vector3d bottom(-4, 5, -6);
+  Vector3d resultTop, resultBottom;
+  mat.Multiply(top, bottom, resultTop, resultBottom);
+  EXPECT_EQ(Vector3d(28, 29, 30), resultTop);
+  EXPECT_EQ(Vector3d(31, 32, 33), resultBottom);
+
+  // In place
+  mat.Multiply(top, bottom, top, bottom);
+  EXPECT_EQ(resultTop, top);
+  EXPECT_EQ(resultBottom, bottom);
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix6dTest, MultiplyBlockDiagonal)
+{
+  const Matrix6d inertia = spatialInertia(2.0, Vector3d(0.1, -0.2, 0.3));
+  const Matrix3d rot(Quaterniond(0.1, 0.2, 0.3));
+  const Matrix3d other(1, 2, 3, 4, 5, 6, 7, 8, 10);
+  const Matrix6d blocks(rot, Matrix3d::Zero, Matrix3d::Zero, other);
+  EXPECT_TRUE((inertia * blocks).Equal(
+      inertia.MultiplyBlockDiagonal(rot, other), 1e-12));
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix6dTest, Inverse)
+{
+  EXPECT_EQ(Matrix6d::Identity, Matrix6d::Identity.Inverse());
+
+  // Needs pivoting, since its first value is zero
+  Matrix6d mat;
+  for (int i = 0; i < 6; ++i)
+  {
+    for (int j = 0; j < 6; ++j)
+      mat(i, j) = (i * 7 + j * 3) % 11 - 5.0 + (i == j ? 0.5 : 0.0);
+  }
+  mat(0, 0) = 0;
+  const Matrix6d inverse = mat.Inverse();
+  EXPECT_TRUE((mat * inverse).Equal(Matrix6d::Identity, 1e-12));
+  EXPECT_TRUE((inverse * mat).Equal(Matrix6d::Identity, 1e-12));
+
+  // Singular
+  EXPECT_FALSE(std::isfinite(Matrix6d::Zero.Inverse()(0, 0)));
+}
+
+/////////////////////////////////////////////////
+TEST(Matrix6dTest, Solve)
+{
+  const Matrix6d inertia = spatialInertia(3.0, Vector3d(0.5, -0.2, 0.1));
+  const std::array<double, 6> x = {0.1, -0.2, 0.3, 1, 2, -3};
+  const std::array<double, 6> b = inertia * x;
+
+  std::array<double, 6> solution;
+  ASSERT_TRUE(inertia.Solve(b, solution));
+  for (int i = 0; i < 6; ++i)
+    EXPECT_NEAR(x[i], solution[i], 1e-12);
+
+  // In place
+  std::array<double, 6> inPlace = b;
+  ASSERT_TRUE(inertia.Solve(inPlace, inPlace));
+  EXPECT_EQ(solution, inPlace);
+
+  // Several right-hand sides, and the inverse
+  Matrix6d inverse;
+  ASSERT_TRUE(inertia.Solve(Matrix6d::Identity, inverse));
+  EXPECT_TRUE((inertia * inverse).Equal(Matrix6d::Identity, 1e-12));
+  EXPECT_TRUE(inverse.Equal(inertia.Inverse(), 1e-12));
+
+  // Only the lower triangle is read
+  Matrix6d lower = inertia;
+  for (int i = 0; i < 6; ++i)
+  {
+    for (int j = i + 1; j < 6; ++j)
+      lower(i, j) = 100;
+  }
+  ASSERT_TRUE(lower.Solve(b, solution));
+  for (int i = 0; i < 6; ++i)
+    EXPECT_NEAR(x[i], solution[i], 1e-12);
+
+  // Symmetric indefinite
+  Matrix6d indefinite = Matrix6d::Identity;
+  indefinite(2, 2) = -4;
+  indefinite(3, 1) = indefinite(1, 3) = 0.5;
+  ASSERT_TRUE(indefinite.Solve(Matrix6d::Identity, inverse));
+  EXPECT_TRUE((indefinite * inverse).Equal(Matrix6d::Identity, 1e-12));
+
+  // Singular matrices, and not finite values, are rejected
+  std::array<double, 6> unchanged = {1, 2, 3, 4, 5, 6};
+  Matrix6d singular = inertia;
+  for (int i = 0; i < 6; ++i)
+    singular(5, i) = singular(i, 5) = singular(4, i);
+  EXPECT_FALSE(singular.Solve(b, unchanged));
+  EXPECT_FALSE(Matrix6d::Zero.Solve(b, unchanged));
+  Matrix6d nan = inertia;
+  nan(3, 3) = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_FALSE(nan.Solve(b, unchanged));
+  EXPECT_EQ(6.0, unchanged[5]);
+
+  // Float
+  const Matrix6f inertiaf(
+      2, 0, 0, 0, 0.1f, 0,
+      0, 2, 0, -0.1f, 0, 0,
+      0, 0, 2, 0, 0, 0,
+      0, -0.1f, 0, 1, 0, 0,
+      0.1f, 0, 0, 0, 1, 0,
+      0, 0, 0, 0, 0, 1);
+  std::array<float, 6> xf;
+  ASSERT_TRUE(inertiaf.Solve(std::array<float, 6>{1, 1, 1, 1, 1, 1}, xf));
+  const std::array<float, 6> bf = inertiaf * xf;
+  for (float value : bf)
+    EXPECT_NEAR(1.0f, value, 1e-6f);
+}
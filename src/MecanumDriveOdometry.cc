@@ -14,9 +14,14 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
 #include <cmath>
+#include <utility>
+#include <vector>
+
 #include "gz/math/MecanumDriveOdometry.hh"
 #include "gz/math/RollingMean.hh"
+#include "gz/math/detail/ParallelFor.hh"
 
 using namespace gz;
 using namespace math;
@@ -26,6 +31,53 @@ using namespace math;
 // https://robohub.org/drive-kinematics-skid-steer-and-mecanum-ros-twist-included
 // https://research.ijcaonline.org/volume113/number3/pxc3901586.pdf
 
+/// \brief Integrates a pose using second order Runge-Kutta approximation.
+/// \param[in, out] _x X position.
+/// \param[in, out] _y Y position.
+/// \param[in, out] _heading Heading.
+/// \param[in] _linear Linear displacement.
+/// \param[in] _lateral Lateral displacement.
+/// \param[in] _angular Angular displacement.
+static void IntegrateRungeKutta2(double &_x, double &_y, double &_heading,
+    double _linear, double _lateral, double _angular)
+{
+  const double direction = _heading + _angular * 0.5;
+
+  // Runge-Kutta 2nd order integration:
+  _x += (_linear * std::cos(direction)) - (_lateral * std::sin(direction));
+  _y += _linear * std::sin(direction) + (_lateral * std::cos(direction));
+  _heading += _angular;
+}
+
+/// \brief Integrates a pose along an arc, or with IntegrateRungeKutta2
+/// when the angular displacement is close to zero.
+/// \param[in, out] _x X position.
+/// \param[in, out] _y Y position.
+/// \param[in, out] _heading Heading.
+/// \param[in] _linear Linear displacement.
+/// \param[in] _lateral Lateral displacement.
+/// \param[in] _angular Angular displacement.
+static void IntegrateExact(double &_x, double &_y, double &_heading,
+    double _linear, double _lateral, double _angular)
+{
+  if (std::fabs(_angular) < 1e-6)
+  {
+    IntegrateRungeKutta2(_x, _y, _heading, _linear, _lateral, _angular);
+  }
+  else
+  {
+    // Exact integration (should solve problems when angular is zero):
+    const double headingOld = _heading;
+    const double ratio = _linear / _angular;
+    const double ratio2 = _lateral / _angular;
+    _heading += _angular;
+    _x += (ratio * (std::sin(_heading) - std::sin(headingOld)))
+      - (-ratio2 * (std::cos(_heading) - std::cos(headingOld)));
+    _y += (-ratio * (std::cos(_heading) - std::cos(headingOld)))
+      + (ratio2 * (std::sin(_heading) - std::sin(headingOld)));
+  }
+}
+
 class gz::math::MecanumDriveOdometryPrivate
 {
   /// \brief Integrates the pose.
@@ -34,12 +86,31 @@ class gz::math::MecanumDriveOdometryPrivate
   /// \param[in] _angular Angular velocity.
   public: void IntegrateExact(double _linear, double _lateral, double _angular);
 
-  /// \brief Integrates the pose using second order Runge-Kuffa aproximation.
-  /// \param[in] _linear Linear velocity.
-  /// \param[in] _lateral Lateral velocity.
-  /// \param[in] _angular Angular velocity.
-  public: void IntegrateRungeKutta2(double _linear, double _lateral,
-    double _angular);
+  /// \brief Computes the displacement of the vehicle at a sample of a log
+  /// of wheel positions, from the sample before it or, for the first one,
+  /// from the old wheel positions.
+  /// \param[in] _wheels Front left, front right, back left and back right
+  /// wheel positions of the log, in radians.
+  /// \param[in] _index Index of the sample.
+  /// \param[out] _linear Linear displacement.
+  /// \param[out] _lateral Lateral displacement.
+  /// \param[out] _angular Angular displacement.
+  public: void Displacement(const double *const _wheels[4], size_t _index,
+    double &_linear, double &_lateral, double &_angular) const;
+
+  /// \brief Integrates a segment of a log of wheel positions, writing the
+  /// pose after each sample.
+  /// \param[in] _wheels Front left, front right, back left and back right
+  /// wheel positions of the log, in radians.
+  /// \param[in] _begin First sample of the segment.
+  /// \param[in] _end Sample after the last one of the segment.
+  /// \param[in] _x X position before the segment.
+  /// \param[in] _y Y position before the segment.
+  /// \param[in] _heading Heading before the segment.
+  /// \param[out] _poses X positions, Y positions and headings of the log.
+  public: void IntegrateSegment(const double *const _wheels[4],
+    size_t _begin, size_t _end, double _x, double _y, double _heading,
+    double *const _poses[3]) const;
 
   /// \brief Current timestamp.
   public: MecanumDriveOdometry::clock::time_point lastUpdateTime;
@@ -213,6 +284,126 @@ bool MecanumDriveOdometry::Update(const Angle &_frontLeftPos,
   return true;
 }
 
+//////////////////////////////////////////////////
+size_t MecanumDriveOdometry::UpdateBatch(const clock::time_point *_times,
+  const double *_frontLeftPos, const double *_frontRightPos,
+  const double *_backLeftPos, const double *_backRightPos, size_t _count,
+  double *_x, double *_y, double *_heading, unsigned int _threads)
+{
+  if (_count == 0)
+    return 0;
+
+  auto &d = *this->dataPtr;
+  const double *const wheels[4] = {_frontLeftPos, _frontRightPos,
+                                   _backLeftPos, _backRightPos};
+  double *const poses[3] = {_x, _y, _heading};
+
+  // Split the log in contiguous segments, one per thread.
+  constexpr size_t kMinSegmentSize = 4096;
+  const size_t segments =
+    detail::ChunkCount(_count, _threads, kMinSegmentSize);
+  const size_t segment = (_count + segments - 1) / segments;
+
+  // The first segment starts from the current pose, the others from the
+  // origin.
+  detail::ParallelFor(_count, segments, [&](const size_t _segment,
+      const size_t _begin, const size_t _end)
+  {
+    if (_segment == 0)
+      d.IntegrateSegment(wheels, _begin, _end, d.x, d.y, *d.heading, poses);
+    else
+      d.IntegrateSegment(wheels, _begin, _end, 0.0, 0.0, 0.0, poses);
+  });
+
+  // Move each segment after the first to the end pose of the one before
+  // it, in parallel once the start poses are known.
+  std::vector<double> startPoses;
+  for (size_t s = 1; s < segments; ++s)
+  {
+    const size_t last = s * segment - 1;
+    startPoses.push_back(_x[last]);
+    startPoses.push_back(_y[last]);
+    startPoses.push_back(_heading[last]);
+    if (s + 1 < segments)
+    {
+      // End pose of this segment, needed by the next one.
+      const size_t end = std::min(_count, (s + 1) * segment) - 1;
+      const double c = std::cos(_heading[last]);
+      const double sn = std::sin(_heading[last]);
+      const double x = _x[end];
+      const double y = _y[end];
+      _x[end] = _x[last] + c * x - sn * y;
+      _y[end] = _y[last] + sn * x + c * y;
+      _heading[end] += _heading[last];
+    }
+  }
+  detail::ParallelFor(_count, segments, [&](const size_t _segment,
+      const size_t _begin, const size_t _end)
+  {
+    // The first segment is in place already.
+    if (_segment == 0)
+      return;
+    // The end pose of all but the last segment was moved already.
+    const size_t end = _segment + 1 < segments ? _end - 1 : _end;
+    const double *start = startPoses.data() + 3 * (_segment - 1);
+    const double c = std::cos(start[2]);
+    const double sn = std::sin(start[2]);
+    for (size_t i = _begin; i < end; ++i)
+    {
+      const double x = _x[i];
+      const double y = _y[i];
+      _x[i] = start[0] + c * x - sn * y;
+      _y[i] = start[1] + sn * x + c * y;
+      _heading[i] += start[2];
+    }
+  });
+
+  // Find the samples that update the velocities, as in Update, keeping
+  // those that are still in the rolling windows at the end of the log.
+  const size_t windowSize = std::max<size_t>(1, d.linearMean.WindowSize());
+  std::vector<std::pair<size_t, double>> updates(windowSize);
+  size_t updateCount = 0;
+  clock::time_point lastUpdateTime = d.lastUpdateTime;
+  for (size_t i = 0; i < _count; ++i)
+  {
+    const std::chrono::duration<double> dt = _times[i] - lastUpdateTime;
+    if (equal(0.0, dt.count()))
+      continue;
+    updates[updateCount % windowSize] = {i, dt.count()};
+    ++updateCount;
+    lastUpdateTime = _times[i];
+  }
+
+  const size_t kept = std::min(updateCount, windowSize);
+  for (size_t k = updateCount - kept; k < updateCount; ++k)
+  {
+    const auto &update = updates[k % windowSize];
+    double linear, lateral, angular;
+    d.Displacement(wheels, update.first, linear, lateral, angular);
+    d.linearMean.Push(linear / update.second);
+    d.lateralMean.Push(lateral / update.second);
+    d.angularMean.Push(angular / update.second);
+  }
+  if (kept > 0)
+  {
+    d.linearVel = d.linearMean.Mean();
+    d.lateralVel = d.lateralMean.Mean();
+    d.angularVel = d.angularMean.Mean();
+  }
+
+  // Leave the state as after the last sample.
+  const size_t last = _count - 1;
+  d.frontLeftWheelOldPos = _frontLeftPos[last] * d.leftWheelRadius;
+  d.frontRightWheelOldPos = _frontRightPos[last] * d.rightWheelRadius;
+  d.backLeftWheelOldPos = _backLeftPos[last] * d.leftWheelRadius;
+  d.backRightWheelOldPos = _backRightPos[last] * d.rightWheelRadius;
+  d.x = _x[last];
+  d.y = _y[last];
+  d.heading = _heading[last];
+  d.lastUpdateTime = lastUpdateTime;
+  return updateCount;
+}
+
 //////////////////////////////////////////////////
 void MecanumDriveOdometry::SetWheelParams(double _wheelSeparation,
   double _wheelBase, double _leftWheelRadius, double _rightWheelRadius)
@@ -231,6 +422,14 @@ void MecanumDriveOdometry::SetVelocityRollingWindowSize(size_t _size)
   this->dataPtr->angularMean.SetWindowSize(_size);
 }
 
+//////////////////////////////////////////////////
+void MecanumDriveOdometry::ReserveVelocityRollingWindow(size_t _capacity)
+{
+  this->dataPtr->linearMean.Reserve(_capacity);
+  this->dataPtr->lateralMean.Reserve(_capacity);
+  this->dataPtr->angularMean.Reserve(_capacity);
+}
+
 //////////////////////////////////////////////////
 const Angle &MecanumDriveOdometry::Heading() const
 {
@@ -292,35 +491,52 @@ double MecanumDriveOdometry::RightWheelRadius() const
 }
 
 //////////////////////////////////////////////////
-void MecanumDriveOdometryPrivate::IntegrateRungeKutta2(
-    double _linear, double _lateral, double _angular)
+void MecanumDriveOdometryPrivate::IntegrateExact(double _linear,
+  double _lateral, double _angular)
 {
-  const double direction = *this->heading + _angular * 0.5;
-
-  // Runge-Kutta 2nd order integration:
-  this->x += (_linear * std::cos(direction)) - (_lateral * std::sin(direction));
-  this->y += _linear * std::sin(direction) + (_lateral * std::cos(direction));
-  this->heading += _angular;
+  double yaw = *this->heading;
+  ::IntegrateExact(this->x, this->y, yaw, _linear, _lateral, _angular);
+  this->heading = yaw;
 }
 
 //////////////////////////////////////////////////
-void MecanumDriveOdometryPrivate::IntegrateExact(double _linear,
-  double _lateral, double _angular)
+void MecanumDriveOdometryPrivate::Displacement(const double *const _wheels[4],
+  size_t _index, double &_linear, double &_lateral, double &_angular) const
 {
-  if (std::fabs(_angular) < 1e-6)
+  const double radius[4] = {this->leftWheelRadius, this->rightWheelRadius,
+                            this->leftWheelRadius, this->rightWheelRadius};
+  const double oldPos[4] = {this->frontLeftWheelOldPos,
+                            this->frontRightWheelOldPos,
+                            this->backLeftWheelOldPos,
+                            this->backRightWheelOldPos};
+  double vel[4];
+  for (int w = 0; w < 4; ++w)
   {
-    this->IntegrateRungeKutta2(_linear, _lateral, _angular);
+    const double old =
+      _index == 0 ? oldPos[w] : _wheels[w][_index - 1] * radius[w];
+    vel[w] = _wheels[w][_index] * radius[w] - old;
   }
-  else
+
+  // Same as in MecanumDriveOdometry::Update
+  const double angularConst =
+    (1/(4*(0.5*(this->wheelSeparation + this->wheelBase))));
+  _linear = (vel[0] + vel[1] + vel[2] + vel[3]) * 0.25;
+  _lateral = (-vel[0] + vel[1] + vel[2] - vel[3]) * 0.25;
+  _angular = (-vel[0] + vel[1] - vel[2] + vel[3]) * angularConst;
+}
+
+//////////////////////////////////////////////////
+void MecanumDriveOdometryPrivate::IntegrateSegment(
+  const double *const _wheels[4], size_t _begin, size_t _end, double _x,
+  double _y, double _heading, double *const _poses[3]) const
+{
+  for (size_t i = _begin; i < _end; ++i)
   {
-    // Exact integration (should solve problems when angular is zero):
-    const double headingOld = *this->heading;
-    const double ratio = _linear / _angular;
-    const double ratio2 = _lateral / _angular;
-    this->heading += _angular;
-    this->x += (ratio * (std::sin(*this->heading) - std::sin(headingOld)))
-      - (-ratio2 * (std::cos(*this->heading) - std::cos(headingOld)));
-    this->y += (-ratio * (std::cos(*this->heading) - std::cos(headingOld)))
-      + (ratio2 * (std::sin(*this->heading) - std::sin(headingOld)));
+    double linear, lateral, angular;
+    this->Displacement(_wheels, i, linear, lateral, angular);
+    ::IntegrateExact(_x, _y, _heading, linear, lateral, angular);
+    _poses[0][i] = _x;
+    _poses[1][i] = _y;
+    _poses[2][i] = _heading;
   }
 }
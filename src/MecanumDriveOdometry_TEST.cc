@@ -16,12 +16,18 @@
 */
 
 #include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <memory>
 #include <thread>
 
 #include "gz/math/Angle.hh"
 #include "gz/math/Helpers.hh"
 #include "gz/math/MecanumDriveOdometry.hh"
 
+#include "test/performance/AllocationCounter.hh"
+
 using namespace gz;
 
 /////////////////////////////////////////////////
@@ -106,3 +112,136 @@ TEST(MecanumDriveOdometryTest, MecanumDriveOdometry)
   // straight line.
   EXPECT_NEAR(0.0, *odom.AngularVelocity(), 1e-3);
 }
+
+/////////////////////////////////////////////////
+TEST(MecanumDriveOdometryTest, NoAllocation)
+{
+  math::MecanumDriveOdometry odom(4);
+  odom.SetWheelParams(2.0, 1.0, 0.5, 0.5);
+  odom.ReserveVelocityRollingWindow(100);
+  auto time = std::chrono::steady_clock::now();
+  odom.Init(time);
+
+  const benchmark::AllocationCounter counter;
+  for (int i = 1; i <= 1000; ++i)
+  {
+    time += std::chrono::milliseconds(1);
+    EXPECT_TRUE(odom.Update(GZ_DTOR(i), GZ_DTOR(2 * i), GZ_DTOR(i),
+                            GZ_DTOR(2 * i), time));
+    if (i % 100 == 0)
+      odom.SetVelocityRollingWindowSize(i / 10);
+  }
+  odom.Init(time);
+  EXPECT_EQ(0u, counter.Count());
+
+  // Windows larger than the capacity are allocated
+  odom.SetVelocityRollingWindowSize(101);
+  EXPECT_LT(0u, counter.Count());
+}
+
+/////////////////////////////////////////////////
+TEST(MecanumDriveOdometryTest, UpdateBatch)
+{
+  // A log of wheel positions turning, going straight and strafing, in
+  // which every 97th time stamp repeats the one before it
+  const size_t count = 20000;
+  const size_t last = count - 1;
+  const auto start = std::chrono::steady_clock::now();
+
+  // Arrays rather than vectors, whose inlined deallocation GCC mistakes for
+  // a mismatch with the operator new of AllocationCounter.hh.
+  using Array = std::unique_ptr<double[]>;
+  std::unique_ptr<std::chrono::steady_clock::time_point[]> times(
+      new std::chrono::steady_clock::time_point[count]);
+  Array frontLeft(new double[count]), frontRight(new double[count]);
+  Array backLeft(new double[count]), backRight(new double[count]);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const int ms = static_cast<int>(i % 97 == 5 ? i : i + 1);
+    times[i] = start + std::chrono::milliseconds(ms);
+    const double t = 0.001 * static_cast<double>(i + 1);
+    frontLeft[i] = 2.0 * t + std::sin(t);
+    frontRight[i] = 2.0 * t - (i > 8000 ? std::sin(3 * t) : 0.0);
+    backLeft[i] = 2.0 * t + std::cos(t) - 1.0;
+    backRight[i] = 2.0 * t + (i < 12000 ? 0.0 : 0.5 * t);
+  }
+
+  // Poses after each call to Update
+  math::MecanumDriveOdometry reference(15);
+  reference.SetWheelParams(2.0, 1.5, 0.5, 0.4);
+  reference.Init(start);
+  size_t updates = 0;
+  Array x(new double[count]), y(new double[count]);
+  Array heading(new double[count]);
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (reference.Update(frontLeft[i], frontRight[i], backLeft[i],
+                         backRight[i], times[i]))
+    {
+      ++updates;
+    }
+    x[i] = reference.X();
+    y[i] = reference.Y();
+    heading[i] = *reference.Heading();
+  }
+  EXPECT_LT(updates, count);
+  const double linearVel = reference.LinearVelocity();
+  const double lateralVel = reference.LateralVelocity();
+  const double angularVel = *reference.AngularVelocity();
+
+  // One more update, after the end of the log
+  const auto later = times[last] + std::chrono::milliseconds(1);
+  EXPECT_TRUE(reference.Update(frontLeft[last] + 0.1, frontRight[last],
+                               backLeft[last], backRight[last] + 0.1,
+                               later));
+
+  for (unsigned int threads : {1u, 4u})
+  {
+    math::MecanumDriveOdometry odom(15);
+    odom.SetWheelParams(2.0, 1.5, 0.5, 0.4);
+    odom.Init(start);
+
+    // The log in two parts, the second continuing from the first
+    Array batchX(new double[count]), batchY(new double[count]);
+    Array batchHeading(new double[count]);
+    const size_t half = 9000;
+    size_t batchUpdates = odom.UpdateBatch(times.get(), frontLeft.get(),
+        frontRight.get(), backLeft.get(), backRight.get(), half,
+        batchX.get(), batchY.get(), batchHeading.get(), threads);
+    batchUpdates += odom.UpdateBatch(times.get() + half,
+        frontLeft.get() + half, frontRight.get() + half,
+        backLeft.get() + half, backRight.get() + half, count - half,
+        batchX.get() + half, batchY.get() + half,
+        batchHeading.get() + half, threads);
+    EXPECT_EQ(updates, batchUpdates);
+
+    // The same poses with one thread, up to rounding with more
+    const double tol = threads == 1 ? 0.0 : 1e-9;
+    for (size_t i = 0; i < count; ++i)
+    {
+      ASSERT_NEAR(x[i], batchX[i], tol) << i;
+      ASSERT_NEAR(y[i], batchY[i], tol) << i;
+      ASSERT_NEAR(heading[i], batchHeading[i], tol) << i;
+    }
+    EXPECT_NEAR(x[last], odom.X(), tol);
+    EXPECT_NEAR(y[last], odom.Y(), tol);
+    EXPECT_NEAR(heading[last], *odom.Heading(), tol);
+    EXPECT_NEAR(linearVel, odom.LinearVelocity(), 1e-9);
+    EXPECT_NEAR(lateralVel, odom.LateralVelocity(), 1e-9);
+    EXPECT_NEAR(angularVel, *odom.AngularVelocity(), 1e-9);
+
+    // Updates continue from the end of the log
+    EXPECT_TRUE(odom.Update(frontLeft[last] + 0.1, frontRight[last],
+                            backLeft[last], backRight[last] + 0.1, later));
+    EXPECT_NEAR(reference.X(), odom.X(), 1e-9);
+    EXPECT_NEAR(reference.Y(), odom.Y(), 1e-9);
+    EXPECT_NEAR(reference.LinearVelocity(), odom.LinearVelocity(), 1e-9);
+  }
+
+  // Empty logs do nothing
+  math::MecanumDriveOdometry odom;
+  odom.Init(start);
+  EXPECT_EQ(0u, odom.UpdateBatch(nullptr, nullptr, nullptr, nullptr, nullptr,
+                                 0, nullptr, nullptr, nullptr));
+  EXPECT_DOUBLE_EQ(0.0, odom.X());
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "gz/math/MemoryMappedFile.hh"
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+using namespace gz;
+using namespace math;
+
+/// \brief Private data for the MemoryMappedFile class
+class gz::math::MemoryMappedFile::Implementation
+{
+  /// \brief Destructor, releases the mapping.
+  public: ~Implementation()
+  {
+    this->Unmap();
+  }
+
+  /// \brief Release the mapping if any.
+  public: void Unmap()
+  {
+    if (!this->data)
+      return;
+#ifdef _WIN32
+    UnmapViewOfFile(this->data);
+#else
+    munmap(this->data, this->size);
+#endif
+    this->data = nullptr;
+    this->size = 0;
+  }
+
+  /// \brief Start of the mapping.
+  public: void *data = nullptr;
+
+  /// \brief Size of the mapping in bytes.
+  public: std::size_t size = 0;
+};
+
+//////////////////////////////////////////////////
+MemoryMappedFile::MemoryMappedFile()
+: dataPtr(gz::utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+bool MemoryMappedFile::Open(const std::string &_path)
+{
+  this->Close();
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA(_path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+      nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0)
+  {
+    CloseHandle(file);
+    return false;
+  }
+
+  // The view keeps the mapping alive, so both handles can be closed
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0,
+      nullptr);
+  CloseHandle(file);
+  if (!mapping)
+    return false;
+
+  void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!data)
+    return false;
+
+  this->dataPtr->data = data;
+  this->dataPtr->size = static_cast<std::size_t>(size.QuadPart);
+#else
+  const int fd = open(_path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0)
+  {
+    close(fd);
+    return false;
+  }
+
+  // The mapping stays valid after the descriptor is closed
+  const std::size_t size = static_cast<std::size_t>(st.st_size);
+  void *data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+    return false;
+
+  this->dataPtr->data = data;
+  this->dataPtr->size = size;
+#endif
+  return true;
+}
+
+//////////////////////////////////////////////////
+void MemoryMappedFile::Close()
+{
+  this->dataPtr->Unmap();
+}
+
+//////////////////////////////////////////////////
+bool MemoryMappedFile::IsOpen() const
+{
+  return this->dataPtr->data != nullptr;
+}
+
+//////////////////////////////////////////////////
+const void *MemoryMappedFile::Data() const
+{
+  return this->dataPtr->data;
+}
+
+//////////////////////////////////////////////////
+std::size_t MemoryMappedFile::Size() const
+{
+  return this->dataPtr->size;
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "gz/math/MemoryMappedFile.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(MemoryMappedFileTest, Open)
+{
+  MemoryMappedFile file;
+  EXPECT_FALSE(file.IsOpen());
+  EXPECT_EQ(nullptr, file.Data());
+  EXPECT_EQ(0u, file.Size());
+
+  const std::string path = "MemoryMappedFile_TEST.bin";
+  const std::string contents("mapped\0contents", 15);
+  {
+    std::ofstream out(path, std::ios::binary);
+    out.write(contents.data(), contents.size());
+  }
+
+  ASSERT_TRUE(file.Open(path));
+  EXPECT_TRUE(file.IsOpen());
+  ASSERT_EQ(contents.size(), file.Size());
+  EXPECT_EQ(0, std::memcmp(contents.data(), file.Data(), contents.size()));
+
+  file.Close();
+  EXPECT_FALSE(file.IsOpen());
+  EXPECT_EQ(nullptr, file.Data());
+  EXPECT_EQ(0u, file.Size());
+
+  // Reopening replaces the mapping
+  ASSERT_TRUE(file.Open(path));
+  ASSERT_TRUE(file.Open(path));
+  EXPECT_EQ(contents.size(), file.Size());
+
+  std::remove(path.c_str());
+}
+
+/////////////////////////////////////////////////
+TEST(MemoryMappedFileTest, OpenFailure)
+{
+  MemoryMappedFile file;
+  EXPECT_FALSE(file.Open("MemoryMappedFile_TEST_missing.bin"));
+  EXPECT_FALSE(file.IsOpen());
+
+  const std::string path = "MemoryMappedFile_TEST_empty.bin";
+  {
+    std::ofstream out(path, std::ios::binary);
+  }
+  EXPECT_FALSE(file.Open(path));
+  EXPECT_FALSE(file.IsOpen());
+  EXPECT_EQ(nullptr, file.Data());
+  std::remove(path.c_str());
+}
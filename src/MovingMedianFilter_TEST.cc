@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "gz/math/MovingMedianFilter.hh"
+#include "gz/math/Rand.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+TEST(MovingMedianFilterTest, SetWindowSize)
+{
+  math::MovingMedianFilterd filter;
+  EXPECT_EQ(filter.WindowSize(), 5u);
+  EXPECT_FALSE(filter.WindowFilled());
+  EXPECT_DOUBLE_EQ(filter.Value(), 0.0);
+
+  filter.SetWindowSize(3);
+  EXPECT_EQ(filter.WindowSize(), 3u);
+  filter.Update(1.0);
+  filter.Update(2.0);
+  EXPECT_FALSE(filter.WindowFilled());
+  filter.Update(3.0);
+  EXPECT_TRUE(filter.WindowFilled());
+
+  // Changing the window forgets the values.
+  filter.SetWindowSize(0);
+  EXPECT_EQ(filter.WindowSize(), 1u);
+  EXPECT_FALSE(filter.WindowFilled());
+  EXPECT_DOUBLE_EQ(filter.Value(), 0.0);
+}
+
+/////////////////////////////////////////////////
+TEST(MovingMedianFilterTest, Spikes)
+{
+  math::MovingMedianFilterd filter(5);
+  for (int i = 0; i < 20; ++i)
+  {
+    filter.Update(i % 7 == 3 ? 1000.0 : 1.0);
+    EXPECT_DOUBLE_EQ(filter.Value(), 1.0) << i;
+  }
+
+  // Even number of values.
+  math::MovingMedianFilteri intFilter(4);
+  for (const int value : {1, 2, 10, 20})
+    intFilter.Update(value);
+  EXPECT_EQ(intFilter.Value(), 6);
+  intFilter.Update(-5);
+  EXPECT_EQ(intFilter.Value(), 6);
+  intFilter.Update(-5);
+  EXPECT_EQ(intFilter.Value(), 2);
+}
+
+/////////////////////////////////////////////////
+TEST(MovingMedianFilterTest, SameAsSorting)
+{
+  math::Rand::Seed(6);
+  for (unsigned int window = 1; window <= 8; ++window)
+  {
+    math::MovingMedianFilterd filter(window);
+    std::vector<double> values;
+    for (int i = 0; i < 500; ++i)
+    {
+      // Few distinct values, to have many duplicates.
+      const double value = math::Rand::IntUniform(0, 5);
+      values.push_back(value);
+      filter.Update(value);
+
+      const size_t count = std::min<size_t>(values.size(), window);
+      std::vector<double> last(values.end() - count, values.end());
+      std::sort(last.begin(), last.end());
+      const double median = count % 2 ? last[count / 2] :
+        (last[count / 2 - 1] + last[count / 2]) / 2;
+      ASSERT_DOUBLE_EQ(filter.Value(), median) << window << " " << i;
+    }
+  }
+}
@@ -15,7 +15,10 @@
  *
  */
 
+#include <numeric>
+
 #include "gz/math/MovingWindowFilter.hh"
+#include "gz/math/Quaternion.hh"
 #include "gz/math/Vector3.hh"
 
 namespace gz
@@ -23,6 +26,44 @@ namespace gz
 namespace math
 {
 inline namespace GZ_MATH_VERSION_NAMESPACE {
+namespace
+{
+/// \brief Get the value of an empty sum.
+/// \return T(), or the zero quaternion, since Quaternion() is the identity.
+template<typename T>
+T Zero()
+{
+  return T();
+}
+
+template<>
+Quaternionf Zero<Quaternionf>()
+{
+  return Quaternionf(0, 0, 0, 0);
+}
+
+template<>
+Quaterniond Zero<Quaterniond>()
+{
+  return Quaterniond(0, 0, 0, 0);
+}
+
+/// \brief Get a value to add to a running sum.
+/// \param[in] _val The new value.
+/// \return _val, or for a quaternion, _val or -_val, the same rotation, in
+/// the same hemisphere as the sum.
+template<typename T>
+T Aligned(const T &, const T &_val)
+{
+  return _val;
+}
+
+template<typename T>
+Quaternion<T> Aligned(const Quaternion<T> &_sum, const Quaternion<T> &_val)
+{
+  return _sum.Dot(_val) < 0 ? -_val : _val;
+}
+}
 
 //////////////////////////////////////////////////
 template<typename T>
@@ -35,10 +76,12 @@ MovingWindowFilter<T>::MovingWindowFilter(unsigned int _windowSize)
 template<typename T>
 void MovingWindowFilter<T>::Update(const T _val)
 {
-  // update sum and sample size with incoming _val
+  const T val = Aligned(this->sum, _val);
+
+  // update sum and sample size with incoming val
 
   // keep running sum
-  this->sum += _val;
+  this->sum += val;
 
   // shift pointer, wrap around if end has been reached.
   ++this->valIter;
@@ -56,14 +99,23 @@ void MovingWindowFilter<T>::Update(const T _val)
     // subtract old value if buffer already filled
     this->sum -= (*this->valIter);
     // put new value into queue
-    (*this->valIter) = _val;
+    (*this->valIter) = val;
     // reduce sample size
     --this->samples;
   }
   else
   {
     // put new value into queue
-    (*this->valIter) = _val;
+    (*this->valIter) = val;
+  }
+
+  // Recompute the sum from the history once per window, so the rounding
+  // errors of the running sum of floating point values don't accumulate.
+  // This costs O(1) per update on average.
+  if (this->valIter == this->valHistory.begin())
+  {
+    this->sum = std::accumulate(this->valHistory.begin(),
+                                this->valHistory.end(), Zero<T>());
   }
 }
 
@@ -72,9 +124,9 @@ template<typename T>
 void MovingWindowFilter<T>::SetWindowSize(const unsigned int _n)
 {
   this->valWindowSize = _n;
-  this->valHistory = std::vector<T>(_n, T());
+  this->valHistory = std::vector<T>(_n, Zero<T>());
   this->valIter = this->valHistory.begin();
-  this->sum = T();
+  this->sum = Zero<T>();
   this->samples = 0;
 }
 
@@ -137,12 +189,34 @@ MovingWindowFilter<gz::math::Vector3d>::Value() const
   return value;
 }
 
+//////////////////////////////////////////////////
+template<>
+gz::math::Quaternionf
+MovingWindowFilter<gz::math::Quaternionf>::Value() const
+{
+  gz::math::Quaternionf value = this->sum;
+  value.Normalize();
+  return value;
+}
+
+//////////////////////////////////////////////////
+template<>
+gz::math::Quaterniond
+MovingWindowFilter<gz::math::Quaterniond>::Value() const
+{
+  gz::math::Quaterniond value = this->sum;
+  value.Normalize();
+  return value;
+}
+
 template class MovingWindowFilter<int>;
 template class MovingWindowFilter<float>;
 template class MovingWindowFilter<double>;
 template class MovingWindowFilter<gz::math::Vector3i>;
 template class MovingWindowFilter<gz::math::Vector3f>;
 template class MovingWindowFilter<gz::math::Vector3d>;
+template class MovingWindowFilter<gz::math::Quaternionf>;
+template class MovingWindowFilter<gz::math::Quaterniond>;
 
 }
 }  // namespace math
@@ -16,6 +16,10 @@
 */
 
 #include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "gz/math/Quaternion.hh"
 #include "gz/math/Vector3.hh"
 #include "gz/math/MovingWindowFilter.hh"
 
@@ -115,3 +119,68 @@ TEST(MovingWindowFilterTest, FilterSomething)
         3.0*static_cast<double>(i));
   EXPECT_EQ(vectorMWF.Value(), vsum / 20.0);
 }
+
+/////////////////////////////////////////////////
+TEST(MovingWindowFilterTest, RoundingDrift)
+{
+  // A huge value absorbs the small ones added to the running sum while it
+  // is in the window. Once it leaves, the sum is recomputed.
+  math::MovingWindowFilter<double> filter(4);
+  filter.Update(1e16);
+  for (int i = 0; i < 11; ++i)
+    filter.Update(1.0);
+  EXPECT_DOUBLE_EQ(filter.Value(), 1.0);
+
+  // Many updates with values that are not exact in binary.
+  math::MovingWindowFilter<float> floatFilter(10);
+  for (int i = 0; i < 1000000; ++i)
+    floatFilter.Update(0.1f * static_cast<float>(i % 7));
+  float expected = 0;
+  for (int i = 1000000 - 10; i < 1000000; ++i)
+    expected += 0.1f * static_cast<float>(i % 7);
+  EXPECT_NEAR(floatFilter.Value(), expected / 10, 1e-6);
+}
+
+/////////////////////////////////////////////////
+TEST(MovingWindowFilterTest, FilterQuaternion)
+{
+  math::MovingWindowFilterQuaterniond filter(4);
+  EXPECT_EQ(math::Quaterniond::Identity, filter.Value());
+
+  // q and -q are the same rotation, the signs don't change the average
+  const math::Quaterniond a(0, 0, 0.1);
+  const math::Quaterniond b(0, 0, 0.3);
+  filter.Update(a);
+  filter.Update(-b);
+  filter.Update(a);
+  filter.Update(-b);
+  math::Quaterniond value = filter.Value();
+  EXPECT_NEAR(1.0, std::abs(value.Dot(math::Quaterniond(0, 0, 0.2))),
+      1e-12);
+  EXPECT_NEAR(0.2, std::abs(value.Euler().Z()), 1e-12);
+
+  // Rotations around a mean, which it converges to once the window slides
+  const math::Quaterniond mean(0.4, -0.2, 2.9);
+  math::MovingWindowFilterQuaterniond noisy(10);
+  for (int i = 0; i < 1000; ++i)
+  {
+    const double angle = 0.05 * std::sin(0.7 * i);
+    math::Quaterniond q =
+        mean * math::Quaterniond(angle, -angle, 0.5 * angle);
+    noisy.Update(i % 3 == 0 ? -q : q);
+  }
+  value = noisy.Value();
+  EXPECT_NEAR(1.0, value.Dot(value), 1e-12);
+  EXPECT_GT(std::abs(value.Dot(mean)), std::cos(0.02));
+  EXPECT_TRUE(noisy.WindowFilled());
+
+  // A constant rotation after the window slides
+  for (int i = 0; i < 10; ++i)
+    noisy.Update(i % 2 == 0 ? mean : -mean);
+  EXPECT_NEAR(1.0, std::abs(noisy.Value().Dot(mean)), 1e-12);
+
+  math::MovingWindowFilterQuaternionf floatFilter(2);
+  floatFilter.Update(math::Quaternionf(0, 0.2f, 0));
+  floatFilter.Update(math::Quaternionf(0, 0.4f, 0));
+  EXPECT_NEAR(0.3f, floatFilter.Value().Euler().Y(), 1e-5f);
+}
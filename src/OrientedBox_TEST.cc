@@ -16,7 +16,11 @@
 */
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <vector>
+
 #include "gz/math/Angle.hh"
+#include "gz/math/AxisAlignedBox.hh"
 #include "gz/math/OrientedBox.hh"
 
 using namespace gz;
@@ -374,3 +378,96 @@ TEST(OrientedBoxTest, Mass)
   EXPECT_EQ(expectedMassMat, massMat);
   EXPECT_DOUBLE_EQ(expectedMassMat.Mass(), massMat.Mass());
 }
+
+/////////////////////////////////////////////////
+TEST(OrientedBoxTest, Intersects)
+{
+  const OrientedBoxd box(Vector3d(2, 2, 2));
+  EXPECT_TRUE(box.Intersects(box));
+  EXPECT_TRUE(box.Intersects(OrientedBoxd(Vector3d(1, 1, 1),
+      Pose3d(1.4, 0, 0, 0, 0, 0))));
+  EXPECT_FALSE(box.Intersects(OrientedBoxd(Vector3d(1, 1, 1),
+      Pose3d(1.6, 0, 0, 0, 0, 0))));
+  // Touching
+  EXPECT_TRUE(box.Intersects(OrientedBoxd(Vector3d(2, 2, 2),
+      Pose3d(2, 2, 0, 0, 0, 0))));
+  // Small box inside
+  EXPECT_TRUE(box.Intersects(OrientedBoxd(Vector3d(0.1, 0.1, 0.1),
+      Pose3d(0.2, -0.3, 0.1, 0.4, 0.5, 0.6))));
+
+  // A corner of a rotated box reaches into the box
+  EXPECT_TRUE(box.Intersects(OrientedBoxd(Vector3d(2, 2, 2),
+      Pose3d(2.3, 0, 0, 0, 0, GZ_PI / 4))));
+  EXPECT_FALSE(box.Intersects(OrientedBoxd(Vector3d(2, 2, 2),
+      Pose3d(2.5, 0, 0, 0, 0, GZ_PI / 4))));
+  EXPECT_FALSE(OrientedBoxd(Vector3d(2, 2, 2),
+      Pose3d(2.5, 0, 0, 0, 0, GZ_PI / 4)).Intersects(box));
+
+  // An edge of a box passes by an edge of the other, which only the cross
+  // product of the edges separates.
+  const double s = std::sqrt(0.5);
+  const Vector3d n(s, s, 0);
+  const Vector3d b0(s, -s, 0);
+  const Vector3d b1 = (n + Vector3d::UnitZ) * s;
+  const Vector3d b2 = (Vector3d::UnitZ - n) * s;
+  const Quaterniond rot(Matrix3d(b0[0], b1[0], b2[0],
+                                 b0[1], b1[1], b2[1],
+                                 b0[2], b1[2], b2[2]));
+  const OrientedBoxd apart(Vector3d(2, 2, 2), Pose3d(n * 3.0, rot));
+  const OrientedBoxd close(Vector3d(2, 2, 2), Pose3d(n * 2.7, rot));
+  EXPECT_FALSE(box.Intersects(apart));
+  EXPECT_FALSE(apart.Intersects(box));
+  EXPECT_TRUE(box.Intersects(close));
+  EXPECT_TRUE(close.Intersects(box));
+
+  // Axis aligned boxes
+  const AxisAlignedBox aabb(Vector3d(-1, -1, -1), Vector3d(1, 1, 1));
+  EXPECT_FALSE(apart.Intersects(aabb));
+  EXPECT_TRUE(close.Intersects(aabb));
+  EXPECT_TRUE(OrientedBoxf(Vector3f(1, 1, 1),
+      Pose3f(1.4f, 0, 0, 0, 0, 0)).Intersects(aabb));
+  EXPECT_FALSE(close.Intersects(AxisAlignedBox()));
+}
+
+/////////////////////////////////////////////////
+TEST(OrientedBoxTest, IntersectsBatch)
+{
+  std::vector<OrientedBoxd> boxes;
+  for (int i = 0; i < 500; ++i)
+  {
+    boxes.push_back(OrientedBoxd(
+        Vector3d(0.5 + 0.01 * (i % 50), 1.0, 0.2 + 0.003 * i),
+        Pose3d(std::sin(0.3 * i) * 3, std::cos(0.7 * i) * 3,
+               std::sin(1.1 * i) * 3, 0.1 * i, -0.03 * i, 0.7 * i)));
+  }
+  const OrientedBoxd box(Vector3d(1.5, 2.5, 0.7),
+      Pose3d(0.3, -0.2, 0.5, 0.4, 1.2, -0.8));
+
+  std::vector<std::size_t> indices = {1000};
+  box.Intersects(boxes.data(), boxes.size(), indices);
+  std::vector<std::size_t> expected;
+  for (std::size_t i = 0; i < boxes.size(); ++i)
+  {
+    EXPECT_EQ(box.Intersects(boxes[i]), boxes[i].Intersects(box)) << i;
+    if (box.Intersects(boxes[i]))
+      expected.push_back(i);
+
+    // A point inside both boxes proves they intersect
+    for (int k = 0; k < 20; ++k)
+    {
+      const Vector3d p = boxes[i].Pose().CoordPositionAdd(Vector3d(
+          std::sin(1.3 * k) - 0.05, std::cos(2.1 * k), std::sin(0.7 * k)) *
+          boxes[i].Size() / 2);
+      if (box.Contains(p))
+      {
+        EXPECT_TRUE(box.Intersects(boxes[i])) << i;
+      }
+    }
+  }
+  EXPECT_EQ(expected, indices);
+  EXPECT_GT(indices.size(), 0u);
+  EXPECT_LT(indices.size(), boxes.size());
+
+  box.Intersects(boxes.data(), 0, indices);
+  EXPECT_TRUE(indices.empty());
+}
@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "gz/math/PIDBank.hh"
+#include "gz/math/PIDT.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+class PIDBank::Implementation
+{
+  /// \brief Number of channels updated together in a loop with a fixed
+  /// trip count, which the compiler vectorizes.
+  public: static constexpr size_t kBlockSize = 8;
+
+  /// \brief Largest finite double.
+  public: static constexpr double kFiniteMax =
+      std::numeric_limits<double>::max();
+
+  /// \brief Update a block of kBlockSize channels.
+  /// \param[in] _begin Index of the first channel of the block, a multiple
+  /// of kBlockSize.
+  /// \param[in] _error Errors of the channels of the block.
+  /// \param[in] _errorRate Error rates of the channels of the block, or
+  /// null to estimate them by finite differences.
+  /// \param[in] _dt Time step in seconds, not zero.
+  public: void UpdateBlock(size_t _begin, const double *_error,
+                           const double *_errorRate, double _dt)
+  {
+    const double *pGains = this->pGain.data() + _begin;
+    const double *iGains = this->iGain.data() + _begin;
+    const double *dGains = this->dGain.data() + _begin;
+    const double *iMaxes = this->iMax.data() + _begin;
+    const double *iMins = this->iMin.data() + _begin;
+    const double *cmdMaxes = this->cmdMax.data() + _begin;
+    const double *cmdMins = this->cmdMin.data() + _begin;
+    const double *cmdOffsets = this->cmdOffset.data() + _begin;
+    double *pErrs = this->pErr.data() + _begin;
+    double *iErrs = this->iErr.data() + _begin;
+    double *dErrs = this->dErr.data() + _begin;
+
+    // The results are written to local arrays first, since the compiler
+    // doesn't know they don't overlap the inputs.
+    double pErrNew[kBlockSize];
+    double iErrNew[kBlockSize];
+    double dErrNew[kBlockSize];
+    double cmdNew[kBlockSize];
+    double rates[kBlockSize];
+    if (_errorRate)
+    {
+      std::copy(_errorRate, _errorRate + kBlockSize, rates);
+    }
+    else
+    {
+      const double invDt = 1.0 / _dt;
+      for (size_t i = 0; i < kBlockSize; ++i)
+        rates[i] = (_error[i] - pErrs[i]) * invDt;
+    }
+
+    // The errors are read to local arrays too, so that reading them can't
+    // fail and the compiler can keep the loop below free of branches.
+    double pErrOld[kBlockSize];
+    double iErrOld[kBlockSize];
+    double dErrOld[kBlockSize];
+    std::copy(pErrs, pErrs + kBlockSize, pErrOld);
+    std::copy(iErrs, iErrs + kBlockSize, iErrOld);
+    std::copy(dErrs, dErrs + kBlockSize, dErrOld);
+
+    for (size_t i = 0; i < kBlockSize; ++i)
+    {
+      const double error = _error[i];
+      const double rate = rates[i];
+
+      // Same as std::isfinite, written so that the loop stays vectorized.
+      const bool valid = (std::abs(error) <= kFiniteMax) &
+                         (std::abs(rate) <= kFiniteMax);
+
+      const double integral = detail::PIDIntegral(iErrOld[i], error, _dt,
+          iGains[i], iMaxes[i], iMins[i]);
+      const double command = detail::PIDCommand(error, rate, integral,
+          pGains[i], dGains[i], cmdMaxes[i], cmdMins[i], cmdOffsets[i]);
+
+      pErrNew[i] = valid ? error : pErrOld[i];
+      iErrNew[i] = valid ? integral : iErrOld[i];
+      dErrNew[i] = valid ? rate : dErrOld[i];
+      cmdNew[i] = valid ? command : 0.0;
+    }
+    std::copy(pErrNew, pErrNew + kBlockSize, pErrs);
+    std::copy(iErrNew, iErrNew + kBlockSize, iErrs);
+    std::copy(dErrNew, dErrNew + kBlockSize, dErrs);
+    std::copy(cmdNew, cmdNew + std::min(kBlockSize, this->cmd.size() -
+              _begin), this->cmd.begin() + _begin);
+  }
+
+  /// \brief Update all the channels.
+  /// \param[in] _error Errors of the channels.
+  /// \param[in] _errorRate Error rates of the channels, or null to
+  /// estimate them by finite differences.
+  /// \param[in] _dt Time step in seconds, not zero.
+  public: void Update(const double *_error, const double *_errorRate,
+                      double _dt)
+  {
+    const size_t count = this->cmd.size();
+    size_t begin = 0;
+    for (; begin + kBlockSize <= count; begin += kBlockSize)
+    {
+      this->UpdateBlock(begin, _error + begin,
+                        _errorRate ? _errorRate + begin : nullptr, _dt);
+    }
+
+    // The last channels are copied to a full block.
+    if (begin < count)
+    {
+      double error[kBlockSize] = {};
+      double rate[kBlockSize] = {};
+      std::copy(_error + begin, _error + count, error);
+      if (_errorRate)
+        std::copy(_errorRate + begin, _errorRate + count, rate);
+      this->UpdateBlock(begin, error, _errorRate ? rate : nullptr, _dt);
+    }
+  }
+
+  /// \brief Number of channels rounded up to a multiple of kBlockSize,
+  /// which is the size of the arrays other than the commands.
+  /// \return The padded number of channels.
+  public: size_t Padded() const
+  {
+    return (this->cmd.size() + kBlockSize - 1) / kBlockSize * kBlockSize;
+  }
+
+  /// \brief Gains for proportional control.
+  public: std::vector<double> pGain;
+
+  /// \brief Gains for integral control.
+  public: std::vector<double> iGain;
+
+  /// \brief Gains for derivative control.
+  public: std::vector<double> dGain;
+
+  /// \brief Maximum clamping values for the integral terms.
+  public: std::vector<double> iMax;
+
+  /// \brief Minimum clamping values for the integral terms.
+  public: std::vector<double> iMin;
+
+  /// \brief Max command clamping values.
+  public: std::vector<double> cmdMax;
+
+  /// \brief Min command clamping values.
+  public: std::vector<double> cmdMin;
+
+  /// \brief Command offsets.
+  public: std::vector<double> cmdOffset;
+
+  /// \brief Errors at the last step.
+  public: std::vector<double> pErr;
+
+  /// \brief Integrals of gain times error.
+  public: std::vector<double> iErr;
+
+  /// \brief Derivative errors.
+  public: std::vector<double> dErr;
+
+  /// \brief Command values, one per channel.
+  public: std::vector<double> cmd;
+};
+
+/////////////////////////////////////////////////
+PIDBank::PIDBank()
+: dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+}
+
+/////////////////////////////////////////////////
+size_t PIDBank::Add(const PID &_pid)
+{
+  auto &d = *this->dataPtr;
+  d.cmd.push_back(0.0);
+  for (std::vector<double> *values : {&d.pGain, &d.iGain, &d.dGain,
+       &d.iMax, &d.iMin, &d.cmdMax, &d.cmdMin, &d.cmdOffset, &d.pErr,
+       &d.iErr, &d.dErr})
+  {
+    values->resize(d.Padded(), 0.0);
+  }
+  const size_t index = d.cmd.size() - 1;
+  this->Set(index, _pid);
+  return index;
+}
+
+/////////////////////////////////////////////////
+bool PIDBank::Set(size_t _index, const PID &_pid)
+{
+  auto &d = *this->dataPtr;
+  if (_index >= d.cmd.size())
+    return false;
+
+  d.pGain[_index] = _pid.PGain();
+  d.iGain[_index] = _pid.IGain();
+  d.dGain[_index] = _pid.DGain();
+  d.iMax[_index] = _pid.IMax();
+  d.iMin[_index] = _pid.IMin();
+  d.cmdMax[_index] = _pid.CmdMax();
+  d.cmdMin[_index] = _pid.CmdMin();
+  d.cmdOffset[_index] = _pid.CmdOffset();
+  d.pErr[_index] = 0.0;
+  d.iErr[_index] = 0.0;
+  d.dErr[_index] = 0.0;
+  d.cmd[_index] = _pid.Cmd();
+  return true;
+}
+
+/////////////////////////////////////////////////
+PID PIDBank::Controller(size_t _index) const
+{
+  const auto &d = *this->dataPtr;
+  if (_index >= d.cmd.size())
+    return PID();
+
+  PID pid(d.pGain[_index], d.iGain[_index], d.dGain[_index],
+          d.iMax[_index], d.iMin[_index], d.cmdMax[_index],
+          d.cmdMin[_index], d.cmdOffset[_index]);
+  pid.SetCmd(d.cmd[_index]);
+  return pid;
+}
+
+/////////////////////////////////////////////////
+size_t PIDBank::Size() const
+{
+  return this->dataPtr->cmd.size();
+}
+
+/////////////////////////////////////////////////
+void PIDBank::Clear()
+{
+  *this->dataPtr = Implementation();
+}
+
+/////////////////////////////////////////////////
+void PIDBank::Reset()
+{
+  auto &d = *this->dataPtr;
+  for (std::vector<double> *values : {&d.pErr, &d.iErr, &d.dErr, &d.cmd})
+    std::fill(values->begin(), values->end(), 0.0);
+}
+
+/////////////////////////////////////////////////
+const std::vector<double> &PIDBank::Update(const double *_error,
+    const std::chrono::duration<double> &_dt)
+{
+  auto &d = *this->dataPtr;
+  if (_dt == std::chrono::duration<double>(0))
+  {
+    std::fill(d.cmd.begin(), d.cmd.end(), 0.0);
+    return d.cmd;
+  }
+
+  d.Update(_error, nullptr, _dt.count());
+  return d.cmd;
+}
+
+/////////////////////////////////////////////////
+const std::vector<double> &PIDBank::Update(const double *_error,
+    const double *_errorRate, const std::chrono::duration<double> &_dt)
+{
+  auto &d = *this->dataPtr;
+  if (_dt == std::chrono::duration<double>(0))
+  {
+    std::fill(d.cmd.begin(), d.cmd.end(), 0.0);
+    return d.cmd;
+  }
+
+  d.Update(_error, _errorRate, _dt.count());
+  return d.cmd;
+}
+
+/////////////////////////////////////////////////
+const std::vector<double> &PIDBank::Cmd() const
+{
+  return this->dataPtr->cmd;
+}
+
+/////////////////////////////////////////////////
+bool PIDBank::Errors(size_t _index, double &_pe, double &_ie,
+                     double &_de) const
+{
+  const auto &d = *this->dataPtr;
+  if (_index >= d.cmd.size())
+    return false;
+
+  _pe = d.pErr[_index];
+  _ie = d.iErr[_index];
+  _de = d.dErr[_index];
+  return true;
+}
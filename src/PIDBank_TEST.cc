@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+#include "gz/math/Helpers.hh"
+#include "gz/math/PID.hh"
+#include "gz/math/PIDBank.hh"
+#include "gz/math/Rand.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(PIDBankTest, Channels)
+{
+  PIDBank bank;
+  EXPECT_EQ(0u, bank.Size());
+  EXPECT_TRUE(bank.Cmd().empty());
+
+  const PID pid(1.0, 2.1, -4.5, 10.5, 1.4, 45, -35, 1.3);
+  EXPECT_EQ(0u, bank.Add(PID()));
+  EXPECT_EQ(1u, bank.Add(pid));
+  EXPECT_EQ(2u, bank.Size());
+  ASSERT_EQ(2u, bank.Cmd().size());
+
+  const PID copy = bank.Controller(1);
+  EXPECT_DOUBLE_EQ(1.0, copy.PGain());
+  EXPECT_DOUBLE_EQ(2.1, copy.IGain());
+  EXPECT_DOUBLE_EQ(-4.5, copy.DGain());
+  EXPECT_DOUBLE_EQ(10.5, copy.IMax());
+  EXPECT_DOUBLE_EQ(1.4, copy.IMin());
+  EXPECT_DOUBLE_EQ(45, copy.CmdMax());
+  EXPECT_DOUBLE_EQ(-35, copy.CmdMin());
+  EXPECT_DOUBLE_EQ(1.3, copy.CmdOffset());
+  EXPECT_DOUBLE_EQ(0.0, bank.Controller(2).PGain());
+
+  EXPECT_TRUE(bank.Set(0, pid));
+  EXPECT_FALSE(bank.Set(2, pid));
+  EXPECT_DOUBLE_EQ(2.1, bank.Controller(0).IGain());
+
+  const std::vector<double> errors = {1.0, -2.0};
+  bank.Update(errors.data(), std::chrono::milliseconds(100));
+  double pe, ie, de;
+  EXPECT_TRUE(bank.Errors(1, pe, ie, de));
+  EXPECT_DOUBLE_EQ(-2.0, pe);
+  EXPECT_DOUBLE_EQ(1.4, ie);
+  EXPECT_DOUBLE_EQ(-20.0, de);
+  EXPECT_FALSE(bank.Errors(2, pe, ie, de));
+
+  // No time step
+  const std::vector<double> rates = {1.0, 1.0};
+  const std::vector<double> &cmd =
+    bank.Update(errors.data(), rates.data(), std::chrono::seconds(0));
+  EXPECT_DOUBLE_EQ(0.0, cmd[0]);
+  EXPECT_DOUBLE_EQ(0.0, cmd[1]);
+  EXPECT_TRUE(bank.Errors(1, pe, ie, de));
+  EXPECT_DOUBLE_EQ(-20.0, de);
+
+  bank.Reset();
+  EXPECT_TRUE(bank.Errors(1, pe, ie, de));
+  EXPECT_DOUBLE_EQ(0.0, pe);
+  EXPECT_DOUBLE_EQ(0.0, ie);
+  EXPECT_DOUBLE_EQ(0.0, de);
+  EXPECT_DOUBLE_EQ(2.1, bank.Controller(1).IGain());
+
+  bank.Clear();
+  EXPECT_EQ(0u, bank.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(PIDBankTest, MatchesPID)
+{
+  // Channels with and without limits, and a number of channels that is
+  // not a multiple of the block size
+  Rand::Seed(11);
+  const size_t count = 43;
+  PIDBank bank;
+  std::vector<PID> pids;
+  for (size_t i = 0; i < count; ++i)
+  {
+    const double iLimit = Rand::DblUniform(0.1, 2.0);
+    const double cmdLimit = Rand::DblUniform(1.0, 10.0);
+    PID pid(Rand::DblUniform(0, 10), Rand::DblUniform(0, 5),
+            Rand::DblUniform(0, 1),
+            i % 3 == 0 ? -1.0 : iLimit, i % 3 == 0 ? 0.0 : -iLimit,
+            i % 4 == 0 ? -1.0 : cmdLimit, i % 4 == 0 ? 0.0 : -cmdLimit,
+            Rand::DblUniform(-1, 1));
+    bank.Add(pid);
+    pids.push_back(pid);
+  }
+
+  std::vector<double> errors(count);
+  std::vector<double> rates(count);
+  for (int step = 0; step < 200; ++step)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      errors[i] = Rand::DblUniform(-2, 2);
+      rates[i] = Rand::DblUniform(-5, 5);
+    }
+
+    // Some errors are not finite
+    if (step % 10 == 3)
+    {
+      errors[step % count] = NAN_D;
+      rates[(step + 1) % count] = INF_D;
+      errors[(step + 2) % count] = -INF_D;
+    }
+
+    const std::chrono::duration<double> dt(
+        step % 50 == 7 ? 0.0 : 0.001 * (1 + step % 3));
+    const bool useRates = step % 2 == 0;
+    const std::vector<double> &cmd = useRates ?
+      bank.Update(errors.data(), rates.data(), dt) :
+      bank.Update(errors.data(), dt);
+    ASSERT_EQ(count, cmd.size());
+    for (size_t i = 0; i < count; ++i)
+    {
+      const double expected = useRates ?
+        pids[i].Update(errors[i], rates[i], dt) :
+        pids[i].Update(errors[i], dt);
+      EXPECT_NEAR(expected, cmd[i], 1e-12) << step << " " << i;
+
+      double pe, ie, de, bankPe, bankIe, bankDe;
+      pids[i].Errors(pe, ie, de);
+      ASSERT_TRUE(bank.Errors(i, bankPe, bankIe, bankDe));
+      EXPECT_DOUBLE_EQ(pe, bankPe);
+      EXPECT_NEAR(ie, bankIe, 1e-12);
+      EXPECT_NEAR(de, bankDe, 1e-9);
+    }
+  }
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <type_traits>
+
+#include "gz/math/Helpers.hh"
+#include "gz/math/PID.hh"
+#include "gz/math/PIDT.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(PIDTTest, Constructor)
+{
+  constexpr PIDd defaultPid;
+  // Default gains are zero and default limits are disabled
+  constexpr double defaultPGain = defaultPid.PGain();
+  constexpr double defaultIMax = defaultPid.IMax();
+  EXPECT_DOUBLE_EQ(0, defaultPGain);
+  EXPECT_DOUBLE_EQ(-1, defaultIMax);
+  static_assert(std::is_trivially_copyable_v<PIDf>,
+                "PIDf should be trivially copyable");
+  static_assert(sizeof(PIDf) == 13 * sizeof(float),
+                "PIDf should only store its gains, limits and state");
+
+  PIDf pid(1, 2, 3, 4, -4, 10, -10, 0.5f);
+  EXPECT_FLOAT_EQ(1, pid.PGain());
+  EXPECT_FLOAT_EQ(2, pid.IGain());
+  EXPECT_FLOAT_EQ(3, pid.DGain());
+  EXPECT_FLOAT_EQ(4, pid.IMax());
+  EXPECT_FLOAT_EQ(-4, pid.IMin());
+  EXPECT_FLOAT_EQ(10, pid.CmdMax());
+  EXPECT_FLOAT_EQ(-10, pid.CmdMin());
+  EXPECT_FLOAT_EQ(0.5f, pid.CmdOffset());
+
+  pid.SetPGain(5);
+  pid.SetIGain(6);
+  pid.SetDGain(7);
+  pid.SetIMax(8);
+  pid.SetIMin(-8);
+  pid.SetCmdMax(9);
+  pid.SetCmdMin(-9);
+  pid.SetCmdOffset(1);
+  pid.SetCmd(2);
+  EXPECT_FLOAT_EQ(5, pid.PGain());
+  EXPECT_FLOAT_EQ(6, pid.IGain());
+  EXPECT_FLOAT_EQ(7, pid.DGain());
+  EXPECT_FLOAT_EQ(8, pid.IMax());
+  EXPECT_FLOAT_EQ(-8, pid.IMin());
+  EXPECT_FLOAT_EQ(9, pid.CmdMax());
+  EXPECT_FLOAT_EQ(-9, pid.CmdMin());
+  EXPECT_FLOAT_EQ(1, pid.CmdOffset());
+  EXPECT_FLOAT_EQ(2, pid.Cmd());
+
+  pid.Init(1);
+  EXPECT_FLOAT_EQ(1, pid.PGain());
+  EXPECT_FLOAT_EQ(0, pid.IGain());
+  EXPECT_FLOAT_EQ(-1, pid.CmdMax());
+  EXPECT_FLOAT_EQ(0, pid.Cmd());
+}
+
+/////////////////////////////////////////////////
+TEST(PIDTTest, SameAsPID)
+{
+  const std::chrono::duration<double> dt(0.01);
+  PID expected(2.0, 5.0, 0.1, 0.4, -0.3, 1.5, -2.0, 0.2);
+  PIDd pid(expected);
+  for (int i = 0; i < 200; ++i)
+  {
+    const double error = std::sin(i * 0.1) * 3;
+    if (i % 3 == 0)
+    {
+      EXPECT_DOUBLE_EQ(expected.Update(error, error * 0.5, dt),
+                       pid.Update(error, error * 0.5, dt));
+    }
+    else
+    {
+      EXPECT_DOUBLE_EQ(expected.Update(error, dt), pid.Update(error, dt));
+    }
+    double pe, ie, de, peT, ieT, deT;
+    expected.Errors(pe, ie, de);
+    pid.Errors(peT, ieT, deT);
+    EXPECT_DOUBLE_EQ(pe, peT);
+    EXPECT_DOUBLE_EQ(ie, ieT);
+    EXPECT_DOUBLE_EQ(de, deT);
+  }
+
+  // Invalid inputs keep the state
+  const double cmd = pid.Cmd();
+  EXPECT_DOUBLE_EQ(0, pid.Update(NAN_D, dt));
+  EXPECT_DOUBLE_EQ(0, pid.Update(1, INF_D, dt));
+  EXPECT_DOUBLE_EQ(0, pid.Update(1, std::chrono::duration<double>(0)));
+  EXPECT_DOUBLE_EQ(cmd, pid.Cmd());
+
+  pid.Reset();
+  EXPECT_DOUBLE_EQ(0, pid.Cmd());
+  double pe, ie, de;
+  pid.Errors(pe, ie, de);
+  EXPECT_DOUBLE_EQ(0, ie);
+
+  // Float controllers follow closely
+  PIDf pidf(expected);
+  pidf.Reset();
+  expected.Reset();
+  for (int i = 0; i < 50; ++i)
+  {
+    const double error = std::cos(i * 0.2);
+    EXPECT_NEAR(expected.Update(error, dt),
+                pidf.Update(static_cast<float>(error), dt), 1e-4);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PIDTTest, Conversion)
+{
+  PID pid(1, 2, 3, 4, -4, 10, -10, 0.5);
+  pid.SetCmd(3);
+  const PIDd pidd(pid);
+  EXPECT_DOUBLE_EQ(3, pidd.Cmd());
+
+  const PID back = pidd.ToPID();
+  EXPECT_DOUBLE_EQ(pid.PGain(), back.PGain());
+  EXPECT_DOUBLE_EQ(pid.IGain(), back.IGain());
+  EXPECT_DOUBLE_EQ(pid.DGain(), back.DGain());
+  EXPECT_DOUBLE_EQ(pid.IMax(), back.IMax());
+  EXPECT_DOUBLE_EQ(pid.IMin(), back.IMin());
+  EXPECT_DOUBLE_EQ(pid.CmdMax(), back.CmdMax());
+  EXPECT_DOUBLE_EQ(pid.CmdMin(), back.CmdMin());
+  EXPECT_DOUBLE_EQ(pid.CmdOffset(), back.CmdOffset());
+  EXPECT_DOUBLE_EQ(pid.Cmd(), back.Cmd());
+}
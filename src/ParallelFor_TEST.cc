@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <gz/math/detail/ParallelFor.hh>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <vector>
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(ParallelFor, ChunkCount)
+{
+  EXPECT_EQ(3u, detail::ThreadCount(3));
+  EXPECT_LE(1u, detail::ThreadCount(0));
+
+  EXPECT_EQ(1u, detail::ChunkCount(0, 4));
+  EXPECT_EQ(1u, detail::ChunkCount(1, 4));
+  EXPECT_EQ(4u, detail::ChunkCount(100, 4));
+  // Chunks of 3 items cover 9 items in 3 chunks
+  EXPECT_EQ(3u, detail::ChunkCount(9, 4));
+  // Limited by the smallest chunk
+  EXPECT_EQ(2u, detail::ChunkCount(100, 8, 40));
+  EXPECT_EQ(1u, detail::ChunkCount(100, 8, 1000));
+}
+
+/////////////////////////////////////////////////
+TEST(ParallelFor, Chunks)
+{
+  for (const std::size_t count : {0u, 1u, 9u, 100u, 1001u})
+  {
+    for (const unsigned int threads : {1u, 3u, 4u, 0u})
+    {
+      const std::size_t chunks = detail::ChunkCount(count, threads);
+      std::vector<int> visits(count, 0);
+      std::vector<int> chunkVisits(chunks, 0);
+      detail::ParallelFor(count, chunks,
+          [&](const std::size_t _chunk, const std::size_t _begin,
+              const std::size_t _end)
+      {
+        ASSERT_LT(_chunk, chunks);
+        chunkVisits[_chunk]++;
+        for (std::size_t i = _begin; i < _end; ++i)
+          visits[i]++;
+      });
+
+      for (std::size_t i = 0; i < count; ++i)
+        EXPECT_EQ(1, visits[i]) << count << " " << threads << " " << i;
+      for (std::size_t c = 0; c < chunks; ++c)
+        EXPECT_EQ(1, chunkVisits[c]) << count << " " << threads << " " << c;
+    }
+  }
+}
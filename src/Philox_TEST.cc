@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "gz/math/Rand.hh"
+
+using namespace gz;
+
+//////////////////////////////////////////////////
+TEST(PhiloxTest, KnownAnswers)
+{
+  // Known answer tests of the Random123 library.
+  using Block = math::Philox4x32::Block;
+  EXPECT_EQ(math::Philox4x32::Compute(0, Block{0, 0, 0, 0}),
+      (Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+  EXPECT_EQ(math::Philox4x32::Compute(UINT64_MAX,
+      Block{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}),
+      (Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+  EXPECT_EQ(math::Philox4x32::Compute(0x299f31d0a4093822,
+      Block{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}),
+      (Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+//////////////////////////////////////////////////
+TEST(PhiloxTest, Generator)
+{
+  math::Philox4x32 gen(42, 7);
+  EXPECT_EQ(42u, gen.Seed());
+  EXPECT_EQ(7u, gen.Stream());
+  std::vector<uint32_t> values;
+  for (int i = 0; i < 20; ++i)
+    values.push_back(gen());
+  EXPECT_EQ(20u, gen.Position());
+
+  // Outputs are the words of consecutive blocks.
+  for (uint64_t i = 0; i < 20; ++i)
+  {
+    EXPECT_EQ(values[i], math::Philox4x32::Compute(42,
+        math::Philox4x32::Counter(i / 4, 7))[i % 4]);
+  }
+
+  // Skip ahead, including within a block.
+  for (uint64_t skip : {0u, 1u, 3u, 4u, 5u, 13u})
+  {
+    math::Philox4x32 other(42, 7);
+    other.Discard(skip);
+    EXPECT_EQ(values[skip], other());
+  }
+
+  // Other streams draw other numbers.
+  math::Philox4x32 other(42, 8);
+  EXPECT_NE(values[0], other());
+
+  // Usable with the distributions of <random>.
+  std::uniform_int_distribution<int> dist(1, 6);
+  for (int i = 0; i < 100; ++i)
+  {
+    const int value = dist(gen);
+    EXPECT_GE(value, 1);
+    EXPECT_LE(value, 6);
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(PhiloxTest, Stateless)
+{
+  // Same arguments, same numbers.
+  EXPECT_EQ(math::Philox4x32::Uniform(1, 2, 3),
+            math::Philox4x32::Uniform(1, 2, 3));
+  EXPECT_NE(math::Philox4x32::Uniform(1, 2, 3),
+            math::Philox4x32::Uniform(1, 3, 3));
+  EXPECT_NE(math::Philox4x32::Uniform(1, 2, 3),
+            math::Philox4x32::Uniform(1, 2, 4));
+  EXPECT_EQ(math::Philox4x32::Normal(1, 2, 3),
+            math::Philox4x32::Normal(1, 2, 3));
+
+  // The arrays hold the numbers of each counter, bit for bit.
+  const size_t count = 1003;
+  std::vector<double> uniform(count);
+  std::vector<double> normal(count);
+  math::Philox4x32::Uniform(5, 100, 9, uniform.data(), count);
+  math::Philox4x32::Normal(5, 100, 9, normal.data(), count);
+  double sum = 0;
+  double sumSquares = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    EXPECT_EQ(math::Philox4x32::Uniform(5, 100 + i, 9), uniform[i]);
+    EXPECT_EQ(math::Philox4x32::Normal(5, 100 + i, 9), normal[i]);
+    EXPECT_GE(uniform[i], 0.0);
+    EXPECT_LT(uniform[i], 1.0);
+    sum += normal[i];
+    sumSquares += normal[i] * normal[i];
+  }
+
+  // Loose moments of the distributions.
+  EXPECT_NEAR(0.0, sum / count, 0.15);
+  EXPECT_NEAR(1.0, sumSquares / count, 0.15);
+}
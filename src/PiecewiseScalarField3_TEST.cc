@@ -16,8 +16,11 @@
 */
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cmath>
 #include <functional>
+#include <limits>
+#include <vector>
 
 #include "gz/math/AdditivelySeparableScalarField3.hh"
 #include "gz/math/PiecewiseScalarField3.hh"
@@ -82,6 +85,93 @@ TEST(PiecewiseScalarField3Test, Evaluate)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(PiecewiseScalarField3Test, EvaluateManyPieces)
+{
+  using ScalarField3dT = std::function<double(const math::Vector3d&)>;
+  using PiecewiseScalarField3dT = math::PiecewiseScalarField3d<ScalarField3dT>;
+
+  // A grid of half-open cells, with cells left out, a region that overlaps
+  // some cells and, last, an unbounded region behind everything.
+  std::vector<PiecewiseScalarField3dT::Piece> pieces;
+  for (int i = 0; i < 12; ++i)
+  {
+    for (int j = 0; j < 12; ++j)
+    {
+      for (int k = 0; k < 12; ++k)
+      {
+        if ((i + 2 * j + 3 * k) % 7 == 0)
+        {
+          continue;
+        }
+        const double value = static_cast<double>(pieces.size());
+        pieces.push_back({math::Region3d(
+            math::Intervald::LeftClosed(i, i + 1.),
+            math::Intervald::LeftClosed(j, j + 1.),
+            math::Intervald::LeftClosed(k, k + 1.)),
+            [value](const math::Vector3d&) { return value; }});
+      }
+    }
+  }
+  const PiecewiseScalarField3dT grid(pieces);
+
+  pieces.insert(pieces.begin() + 100, {
+      math::Region3d::Closed(2.5, 2.5, 0., 3.5, 6.5, 12.),
+      [](const math::Vector3d&) { return -1.; }});
+  pieces.push_back({math::Region3d(
+      math::Intervald::Unbounded, math::Intervald::Unbounded,
+      math::Intervald::Open(-1., 0.)),
+      [](const math::Vector3d&) { return -2.; }});
+  const PiecewiseScalarField3dT overlapping(pieces);
+
+  // Points in order, so that consecutive points often share a region
+  std::vector<math::Vector3d> points;
+  for (double x = -0.75; x < 13.; x += 0.5)
+  {
+    for (double y = -0.75; y < 13.; y += 0.5)
+    {
+      for (double z = -0.75; z < 13.; z += 0.25)
+      {
+        points.push_back(math::Vector3d(x, y, z));
+      }
+    }
+  }
+  points.push_back(math::Vector3d(3., 3., 3.));
+  points.push_back(math::Vector3d(3., 3., -0.5));
+  points.push_back(math::Vector3d::NaN);
+
+  for (const PiecewiseScalarField3dT *field : {&grid, &overlapping})
+  {
+    const size_t count = field == &grid ? pieces.size() - 2 : pieces.size();
+    std::vector<double> values(points.size());
+    field->Evaluate(points.data(), values.data(), points.size());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      // The first region that contains the point takes precedence
+      double expected = math::NAN_D;
+      for (size_t j = 0; j < count; ++j)
+      {
+        const size_t piece = field == &grid && j >= 100 ? j + 1 : j;
+        if (pieces[piece].region.Contains(points[i]))
+        {
+          expected = pieces[piece].field(points[i]);
+          break;
+        }
+      }
+      if (std::isnan(expected))
+      {
+        EXPECT_TRUE(std::isnan((*field)(points[i]))) << points[i];
+        EXPECT_TRUE(std::isnan(values[i])) << points[i];
+      }
+      else
+      {
+        EXPECT_DOUBLE_EQ(expected, (*field)(points[i])) << points[i];
+        EXPECT_DOUBLE_EQ(expected, values[i]) << points[i];
+      }
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 TEST(PiecewiseScalarField3Test, Minimum)
 {
@@ -140,6 +230,93 @@ TEST(PiecewiseScalarField3Test, Minimum)
 }
 
 
+/////////////////////////////////////////////////
+TEST(PiecewiseScalarField3Test, MinimumCachedAndInRegion)
+{
+  using AdditivelySeparableScalarField3dT =
+      math::AdditivelySeparableScalarField3d<math::Polynomial3d>;
+  using PiecewiseScalarField3dT =
+      math::PiecewiseScalarField3d<AdditivelySeparableScalarField3dT>;
+
+  // Paraboloids centered in different places of each cell of a grid
+  std::vector<PiecewiseScalarField3dT::Piece> pieces;
+  for (int i = 0; i < 6; ++i)
+  {
+    for (int j = 0; j < 6; ++j)
+    {
+      for (int k = 0; k < 6; ++k)
+      {
+        const double cx = 0.3 * i + 0.1 * k;
+        const double cy = 0.5 * j - 0.2 * i;
+        const double cz = 0.4 * k;
+        pieces.push_back({math::Region3d::Closed(i, j, k,
+            i + 1.0, j + 1.0, k + 1.0),
+            AdditivelySeparableScalarField3dT(1.0,
+                math::Polynomial3d(math::Vector4d(0, 1, -2 * cx, cx * cx)),
+                math::Polynomial3d(math::Vector4d(0, 1, -2 * cy, cy * cy)),
+                math::Polynomial3d(math::Vector4d(0, 0.5, -cz, i - j)))});
+      }
+    }
+  }
+  const PiecewiseScalarField3dT uncached(pieces);
+  PiecewiseScalarField3dT field(pieces);
+  EXPECT_FALSE(field.MinimaCached());
+  field.CacheMinima(3);
+  EXPECT_TRUE(field.MinimaCached());
+
+  math::Vector3d pExpected;
+  math::Vector3d pMin;
+  const double expected = uncached.Minimum(pExpected);
+  EXPECT_DOUBLE_EQ(expected, field.Minimum(pMin));
+  EXPECT_EQ(pExpected, pMin);
+
+  // Brute force minimum within closed query regions
+  const math::Region3d queries[] = {
+    math::Region3d::Closed(0.5, 0.5, 0.5, 2.5, 3.5, 1.5),
+    math::Region3d::Closed(3.2, 1.1, 4.4, 5.9, 5.9, 5.9),
+    math::Region3d::Closed(-3, -3, -3, 10, 10, 10),
+    math::Region3d::Closed(2.2, 2.2, 2.2, 2.3, 2.3, 2.3)};
+  for (const auto &query : queries)
+  {
+    double bruteForce = std::numeric_limits<double>::infinity();
+    for (const auto &piece : pieces)
+    {
+      const math::Region3d intersection = math::Region3d::Closed(
+          std::max(piece.region.Ix().LeftValue(), query.Ix().LeftValue()),
+          std::max(piece.region.Iy().LeftValue(), query.Iy().LeftValue()),
+          std::max(piece.region.Iz().LeftValue(), query.Iz().LeftValue()),
+          std::min(piece.region.Ix().RightValue(), query.Ix().RightValue()),
+          std::min(piece.region.Iy().RightValue(), query.Iy().RightValue()),
+          std::min(piece.region.Iz().RightValue(), query.Iz().RightValue()));
+      if (!intersection.Empty())
+      {
+        bruteForce = std::min(bruteForce,
+            piece.field.Minimum(intersection));
+      }
+    }
+    for (const PiecewiseScalarField3dT *f :
+         {&uncached, static_cast<const PiecewiseScalarField3dT *>(&field)})
+    {
+      EXPECT_NEAR(bruteForce, f->Minimum(query, pMin), 1e-12);
+      EXPECT_TRUE(query.Contains(pMin));
+    }
+  }
+
+  // Regions where the field is not defined
+  EXPECT_TRUE(std::isnan(field.Minimum(
+      math::Region3d::Closed(7, 7, 7, 8, 8, 8), pMin)));
+  EXPECT_TRUE(std::isnan(pMin.X()));
+  EXPECT_TRUE(std::isnan(field.Minimum(
+      math::Region3d::Closed(2, 2, 2, 1, 1, 1))));
+  const PiecewiseScalarField3dT empty;
+  EXPECT_TRUE(std::isnan(empty.Minimum(queries[0])));
+
+  // Copies keep the cache
+  const PiecewiseScalarField3dT copy = field;
+  EXPECT_TRUE(copy.MinimaCached());
+  EXPECT_DOUBLE_EQ(expected, copy.Minimum());
+}
+
 /////////////////////////////////////////////////
 TEST(PiecewiseScalarField3Test, Stream)
 {
@@ -17,8 +17,13 @@
 
 #include <gtest/gtest.h>
 
+#include <cstddef>
+#include <vector>
+
 #include "gz/math/Helpers.hh"
 #include "gz/math/Plane.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/Vector3Array.hh"
 
 using namespace gz;
 using namespace math;
@@ -211,3 +216,90 @@ TEST(PlaneTest, Intersection)
     EXPECT_FALSE(intersect2.has_value());
   }
 }
+
+/////////////////////////////////////////////////
+TEST(PlaneTest, DistanceSideArray)
+{
+  const Planed plane(Vector3d(0.6, 0, 0.8), 1.5);
+  std::vector<Vector3d> points;
+  for (int i = 0; i < 600; ++i)
+  {
+    points.emplace_back(Rand::DblUniform(-5, 5), Rand::DblUniform(-5, 5),
+                        Rand::DblUniform(-5, 5));
+  }
+  points.emplace_back(2.5, 1, 0);
+  points.emplace_back(NAN_D, 0, 0);
+  const Vector3Arrayd array(points);
+
+  std::vector<double> dist(points.size());
+  std::vector<double> distSoa(points.size());
+  plane.Distance(points.data(), dist.data(), points.size());
+  plane.Distance(array.X(), array.Y(), array.Z(), distSoa.data(),
+                 array.Size());
+
+  std::vector<Planed::PlaneSide> side(points.size());
+  std::vector<Planed::PlaneSide> sideSoa(points.size());
+  plane.Side(points.data(), side.data(), points.size());
+  plane.Side(array.X(), array.Y(), array.Z(), sideSoa.data(), array.Size());
+
+  for (std::size_t i = 0; i + 1 < points.size(); ++i)
+  {
+    EXPECT_NEAR(plane.Distance(points[i]), dist[i], 1e-12);
+    EXPECT_DOUBLE_EQ(dist[i], distSoa[i]);
+  }
+  EXPECT_TRUE(std::isnan(dist.back()));
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    EXPECT_EQ(plane.Side(points[i]), side[i]) << i;
+    EXPECT_EQ(side[i], sideSoa[i]) << i;
+  }
+  EXPECT_EQ(Planed::NO_SIDE, side[points.size() - 2]);
+  EXPECT_EQ(Planed::NO_SIDE, side.back());
+}
+
+/////////////////////////////////////////////////
+TEST(PlaneTest, CountInliers)
+{
+  // Points near the ground plane plus outliers
+  std::vector<Vector3f> points;
+  for (int i = 0; i < 1000; ++i)
+  {
+    const float z = i % 4 == 0 ? static_cast<float>(Rand::DblUniform(1, 3)) :
+        static_cast<float>(Rand::DblUniform(-0.04, 0.04));
+    points.emplace_back(static_cast<float>(Rand::DblUniform(-10, 10)),
+                        static_cast<float>(Rand::DblUniform(-10, 10)), z);
+  }
+  const Vector3Arrayf array(points);
+
+  std::vector<Planef> planes;
+  planes.emplace_back(Vector3f(0, 0, 1), 0.0f);
+  planes.emplace_back(Vector3f(0, 0, 1), 2.0f);
+  planes.emplace_back(Vector3f(0.6f, 0, 0.8f), 0.5f);
+  planes.emplace_back(Vector3f(1, 0, 0), 100.0f);
+
+  const float threshold = 0.05f;
+  std::vector<std::size_t> counts(planes.size(), 7);
+  std::vector<std::size_t> countsSoa(planes.size(), 7);
+  Planef::CountInliers(planes.data(), planes.size(), points.data(),
+                       points.size(), threshold, counts.data());
+  Planef::CountInliers(planes.data(), planes.size(), array.X(), array.Y(),
+                       array.Z(), array.Size(), threshold, countsSoa.data());
+
+  for (std::size_t p = 0; p < planes.size(); ++p)
+  {
+    std::size_t expected = 0;
+    for (const Vector3f &point : points)
+    {
+      if (std::abs(planes[p].Distance(point)) <= threshold)
+        ++expected;
+    }
+    EXPECT_EQ(expected, counts[p]) << p;
+    EXPECT_EQ(expected, countsSoa[p]) << p;
+  }
+  EXPECT_EQ(750u, counts[0]);
+  EXPECT_EQ(0u, counts[3]);
+
+  Planef::CountInliers(planes.data(), planes.size(), points.data(), 0,
+                       threshold, counts.data());
+  EXPECT_EQ(0u, counts[0]);
+}
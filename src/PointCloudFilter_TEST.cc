@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "gz/math/PointCloudFilter.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/SparseOctree.hh"
+#include "gz/math/Vector3.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+/// \brief Random points in a cube.
+std::vector<Vector3d> RandomPoints(const std::size_t _count,
+                                   const double _size)
+{
+  std::vector<Vector3d> points;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    points.emplace_back(Rand::DblUniform(-_size, _size),
+                        Rand::DblUniform(-_size, _size),
+                        Rand::DblUniform(-_size, _size));
+  }
+  return points;
+}
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudFilterTest, VoxelDownsampleEmpty)
+{
+  std::vector<Vector3d> output(1);
+  EXPECT_EQ(0u, voxelDownsample<double>(nullptr, 0, 1.0, output.data()));
+
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const std::vector<Vector3d> invalid = {
+    Vector3d(nan, 0, 0), Vector3d(0, 1e100, 0)};
+  EXPECT_EQ(0u, voxelDownsample(invalid.data(), invalid.size(), 1.0,
+                                output.data()));
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudFilterTest, VoxelDownsample)
+{
+  const std::vector<Vector3f> points = {
+    Vector3f(0.5f, 0.5f, 0.5f),
+    Vector3f(-0.5f, 0.5f, 0.5f),
+    Vector3f(0.25f, 0.75f, 0.5f),
+    Vector3f(-0.25f, 0.25f, 0.5f),
+    Vector3f(3.5f, 0.5f, 0.5f)};
+  std::vector<Vector3f> output(points.size());
+  ASSERT_EQ(3u, voxelDownsample(points.data(), points.size(), 1.0f,
+                                output.data()));
+  output.resize(3);
+
+  std::vector<Vector3f> expected = {
+    Vector3f(0.375f, 0.625f, 0.5f),
+    Vector3f(-0.375f, 0.375f, 0.5f),
+    Vector3f(3.5f, 0.5f, 0.5f)};
+  auto less = [](const Vector3f &_a, const Vector3f &_b)
+  {
+    return _a.X() < _b.X();
+  };
+  std::sort(output.begin(), output.end(), less);
+  std::sort(expected.begin(), expected.end(), less);
+  for (std::size_t i = 0; i < expected.size(); ++i)
+    EXPECT_EQ(expected[i], output[i]);
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudFilterTest, VoxelDownsampleMatchesSparseOctree)
+{
+  Rand::Seed(7);
+  const std::vector<Vector3d> points = RandomPoints(30000, 4);
+  const double voxelSize = 0.5;
+
+  SparseOctree<double> octree(voxelSize);
+  octree.Insert(points.data(), points.size());
+  // The octree voxels, in key order
+  std::vector<std::pair<std::uint64_t, Vector3d>> expected;
+  for (std::size_t i = 0; i < octree.VoxelCount(); ++i)
+    expected.emplace_back(octree.Key(i), octree.Centroid(i));
+  std::sort(expected.begin(), expected.end(),
+      [](const auto &_a, const auto &_b) {return _a.first < _b.first;});
+
+  for (unsigned int threads : {1u, 3u, 4u})
+  {
+    std::vector<Vector3d> output(points.size());
+    ASSERT_EQ(expected.size(), voxelDownsample(points.data(),
+        points.size(), voxelSize, output.data(), threads)) << threads;
+    for (std::size_t i = 0; i < expected.size(); ++i)
+      EXPECT_EQ(expected[i].second, output[i]) << threads << " " << i;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudFilterTest, RadiusOutlierFilter)
+{
+  // A dense cluster and isolated points
+  Rand::Seed(3);
+  std::vector<Vector3d> points = RandomPoints(200, 1);
+  const std::vector<Vector3d> outliers = {
+    Vector3d(10, 0, 0), Vector3d(0, -10, 0), Vector3d(10.1, 0, 0)};
+  points.insert(points.begin() + 50, outliers.begin(), outliers.end());
+
+  std::vector<Vector3d> output(points.size());
+  ASSERT_EQ(200u, radiusOutlierFilter(points.data(), points.size(), 1.0, 2,
+                                      output.data()));
+  output.resize(200);
+  std::vector<Vector3d> expected = points;
+  expected.erase(expected.begin() + 50, expected.begin() + 53);
+  EXPECT_EQ(expected, output);
+
+  // The pair of outliers has one neighbor each
+  EXPECT_EQ(202u, radiusOutlierFilter(points.data(), points.size(), 1.0, 1,
+                                      points.data()));
+  EXPECT_EQ(Vector3d(10, 0, 0), points[50]);
+  EXPECT_EQ(Vector3d(10.1, 0, 0), points[51]);
+
+  // Too few points
+  EXPECT_EQ(0u, radiusOutlierFilter(outliers.data(), outliers.size(), 100.0,
+                                    3, output.data()));
+  EXPECT_EQ(3u, radiusOutlierFilter(outliers.data(), outliers.size(), 100.0,
+                                    2, output.data()));
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudFilterTest, RadiusOutlierFilterBruteForce)
+{
+  Rand::Seed(5);
+  const std::vector<Vector3d> points = RandomPoints(10000, 5);
+  const double radius = 0.4;
+  const std::size_t minNeighbors = 3;
+
+  std::vector<Vector3d> expected;
+  for (const Vector3d &point : points)
+  {
+    std::size_t neighbors = 0;
+    for (const Vector3d &other : points)
+      neighbors += point.Distance(other) <= radius;
+    if (neighbors > minNeighbors)
+      expected.push_back(point);
+  }
+  EXPECT_GT(expected.size(), 1000u);
+  EXPECT_LT(expected.size(), 9000u);
+
+  for (unsigned int threads : {1u, 2u})
+  {
+    std::vector<Vector3d> output(points.size());
+    output.resize(radiusOutlierFilter(points.data(), points.size(), radius,
+                                      minNeighbors, output.data(), threads));
+    EXPECT_EQ(expected, output);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PointCloudFilterTest, StatisticalOutlierFilter)
+{
+  // A grid with a few far points
+  std::vector<Vector3f> points;
+  for (int x = 0; x < 10; ++x)
+  {
+    for (int y = 0; y < 10; ++y)
+      points.emplace_back(static_cast<float>(x), static_cast<float>(y), 0);
+  }
+  points.emplace_back(50.0f, 0.0f, 0.0f);
+  points.emplace_back(0.0f, 50.0f, 20.0f);
+
+  std::vector<Vector3f> output(points.size());
+  ASSERT_EQ(100u, statisticalOutlierFilter(points.data(), points.size(), 4,
+                                           1.0f, output.data()));
+  output.resize(100);
+  EXPECT_EQ(std::vector<Vector3f>(points.begin(), points.begin() + 100),
+            output);
+
+  // The same with threads
+  std::vector<Vector3f> threaded(points.size());
+  EXPECT_EQ(100u, statisticalOutlierFilter(points.data(), points.size(), 4,
+                                           1.0f, threaded.data(), 2));
+
+  // Too few points or neighbors keeps all the points
+  EXPECT_EQ(points.size(), statisticalOutlierFilter(points.data(),
+      points.size(), 0, 1.0f, output.data()));
+  EXPECT_EQ(3u, statisticalOutlierFilter(points.data(), 3, 3, 1.0f,
+                                         output.data()));
+
+  // In place
+  EXPECT_EQ(100u, statisticalOutlierFilter(points.data(), points.size(), 4,
+                                           1.0f, points.data()));
+  EXPECT_EQ(Vector3f(9, 9, 0), points[99]);
+}
@@ -64,6 +64,33 @@ TEST(Polynomial3Test, Evaluate)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(Polynomial3Test, EvaluateBatch)
+{
+  const math::Polynomial3d p(math::Vector4d(0.5, -2., 1., 3.));
+  const double x[] = {-3., -1., 0., 0.25, 1., 2.5, 1e3,
+                      math::INF_D, -math::INF_D, math::NAN_D};
+  constexpr size_t count = sizeof(x) / sizeof(x[0]);
+  double y[count];
+  p.Evaluate(x, y, count);
+  for (size_t i = 0; i + 1 < count; ++i)
+  {
+    EXPECT_EQ(p(x[i]), y[i]) << x[i];
+  }
+  EXPECT_TRUE(std::isnan(y[count - 1]));
+
+  const math::Polynomial3f q =
+      math::Polynomial3f::Constant(2.f);
+  const float xf[] = {-1.f, math::INF_F};
+  float yf[] = {0.f, 0.f};
+  q.Evaluate(xf, yf, 2);
+  EXPECT_FLOAT_EQ(2.f, yf[0]);
+  EXPECT_FLOAT_EQ(2.f, yf[1]);
+
+  // Nothing to evaluate
+  p.Evaluate(nullptr, nullptr, 0);
+}
+
 /////////////////////////////////////////////////
 TEST(Polynomial3Test, Minimum)
 {
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <vector>
+
+#include "gz/math/Pose3.hh"
+#include "gz/math/Pose3A.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+TEST(Pose3ATest, Layout)
+{
+  EXPECT_EQ(32u, sizeof(math::Pose3Af));
+  EXPECT_EQ(16u, alignof(math::Pose3Af));
+  EXPECT_EQ(64u, sizeof(math::Pose3Ad));
+  EXPECT_EQ(32u, alignof(math::Pose3Ad));
+}
+
+/////////////////////////////////////////////////
+TEST(Pose3ATest, Conversion)
+{
+  math::Pose3A<double> identity;
+  EXPECT_EQ(math::Pose3d::Zero, identity.ToPose3());
+
+  math::Pose3d pose(1, 2, 3, 0.1, -0.2, 0.3);
+  math::Pose3Ad aligned(pose);
+  EXPECT_EQ(pose.Pos(), aligned.Pos().ToVector3());
+  EXPECT_EQ(pose.Rot(), aligned.Rot());
+
+  math::Pose3d back = aligned;
+  EXPECT_EQ(pose, back);
+
+  std::ostringstream stream;
+  stream << aligned;
+  std::ostringstream expected;
+  expected << pose;
+  EXPECT_EQ(expected.str(), stream.str());
+
+  math::Pose3Ad other;
+  other.Set(math::Vector3Ad(4, 5, 6), math::Quaterniond(0, 0, 1.0));
+  EXPECT_NE(aligned, other);
+  other = aligned;
+  EXPECT_EQ(aligned, other);
+  EXPECT_TRUE(other.IsFinite());
+}
+
+/////////////////////////////////////////////////
+TEST(Pose3ATest, MatchesPose3)
+{
+  const std::vector<math::Pose3d> poses = {
+    {0, 0, 0, 0, 0, 0},
+    {1, 2, 3, 0.1, -0.2, 0.3},
+    {-4, 0.5, 2, 1.5, 0.2, -2.7},
+    {0, 0, 1, 0, 0, 3.14159},
+    // Non-unit rotation
+    {1, -1, 0.5, 2.0, 0.2, -0.4, 0.3}};
+  const std::vector<math::Vector3d> points = {
+    {1, 0, 0}, {0, -2, 0.5}, {3, 4, 5}, {0, 0, 0}};
+
+  for (const auto &pose : poses)
+  {
+    const math::Pose3Ad aligned(pose);
+    for (const auto &point : points)
+    {
+      EXPECT_TRUE(pose.CoordPositionAdd(point).Equal(
+          aligned.CoordPositionAdd(point).ToVector3(), 1e-12));
+    }
+
+    std::vector<math::Vector3Ad> batch(points.begin(), points.end());
+    aligned.CoordPositionAdd(batch.data(), batch.data(), batch.size());
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+      EXPECT_TRUE(pose.CoordPositionAdd(points[i]).Equal(
+          batch[i].ToVector3(), 1e-12));
+    }
+
+    for (const auto &other : poses)
+    {
+      EXPECT_EQ(pose * other,
+          (aligned * math::Pose3Ad(other)).ToPose3());
+    }
+
+    math::Pose3Ad composed(aligned);
+    composed *= aligned;
+    EXPECT_EQ(pose * pose, composed.ToPose3());
+  }
+
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    const math::Pose3Ad aligned(poses[i]);
+    EXPECT_EQ(poses[i].Inverse(), aligned.Inverse().ToPose3());
+    EXPECT_TRUE((aligned * aligned.Inverse()).ToPose3().Equal(
+        math::Pose3d::Zero, 1e-9));
+  }
+}
@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "gz/math/Helpers.hh"
+#include "gz/math/Pose3.hh"
+#include "gz/math/Pose3Trajectory.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+// A trajectory with slerp and linear segments, a rotation by more than Pi
+// between two poses, and two poses at the same time
+math::Pose3Trajectoryd TestTrajectory()
+{
+  math::Pose3Trajectoryd trajectory;
+  EXPECT_TRUE(trajectory.Append(1.0, math::Pose3d(0, 0, 0, 0, 0, 0)));
+  EXPECT_TRUE(trajectory.Append(1.5, math::Pose3d(1, -1, 2, 0.3, -0.2, 0.9)));
+  EXPECT_TRUE(trajectory.Append(2.0,
+      math::Pose3d(1.5, -1, 2, 0.3, -0.2, 0.9 + 1e-4)));
+  EXPECT_TRUE(trajectory.Append(3.0, math::Pose3d(0, 2, 1, -2.5, 1.0, -2.8)));
+  EXPECT_TRUE(trajectory.Append(3.0, math::Pose3d(0, 2, 3, -2.5, 1.0, -2.8)));
+  EXPECT_TRUE(trajectory.Append(4.0, math::Pose3d(4, 2, 3, 2.5, 0.1, 1.2)));
+  return trajectory;
+}
+
+/////////////////////////////////////////////////
+// Interpolate with Quaternion::Slerp, one time at a time
+math::Pose3d Expected(const math::Pose3Trajectoryd &_trajectory,
+                      const double _time, const bool _extrapolate)
+{
+  const std::size_t size = _trajectory.Size();
+  std::size_t k = 0;
+  while (k + 2 < size && _trajectory.Time(k + 1) <= _time)
+    ++k;
+  const double duration = _trajectory.Time(k + 1) - _trajectory.Time(k);
+  double t = duration > 0 ? (_time - _trajectory.Time(k)) / duration : 0;
+  if (!_extrapolate)
+    t = math::clamp(t, 0.0, 1.0);
+  const math::Pose3d &p0 = _trajectory.Pose(k);
+  const math::Pose3d &p1 = _trajectory.Pose(k + 1);
+  return math::Pose3d(p0.Pos() + (p1.Pos() - p0.Pos()) * t,
+      math::Quaterniond::Slerp(t, p0.Rot(), p1.Rot(), true));
+}
+
+/////////////////////////////////////////////////
+TEST(Pose3TrajectoryTest, Empty)
+{
+  math::Pose3Trajectoryd trajectory;
+  EXPECT_EQ(0u, trajectory.Size());
+  math::Pose3d pose(1, 2, 3, 0, 0, 0);
+  EXPECT_FALSE(trajectory.Interpolate(0.5, pose));
+  EXPECT_EQ(math::Pose3d(1, 2, 3, 0, 0, 0), pose);
+  math::Vector3d point(1, 2, 3);
+  const double time = 0;
+  EXPECT_FALSE(trajectory.TransformPoints(&time, &point, &point, 1));
+
+  // A single pose is used for all the times
+  const math::Pose3d only(1, 2, 3, 0.1, 0.2, 0.3);
+  EXPECT_TRUE(trajectory.Append(2.0, only));
+  EXPECT_EQ(1u, trajectory.Size());
+  for (double t : {-1.0, 2.0, 5.0})
+  {
+    EXPECT_TRUE(trajectory.Interpolate(t, pose, true));
+    EXPECT_EQ(only, pose);
+  }
+
+  // Times must not decrease
+  EXPECT_FALSE(trajectory.Append(1.0, only));
+  EXPECT_FALSE(trajectory.Append(math::NAN_D, only));
+  EXPECT_EQ(1u, trajectory.Size());
+
+  trajectory.Clear();
+  EXPECT_EQ(0u, trajectory.Size());
+  EXPECT_TRUE(trajectory.Append(1.0, only));
+}
+
+/////////////////////////////////////////////////
+TEST(Pose3TrajectoryTest, Interpolate)
+{
+  const auto trajectory = TestTrajectory();
+  ASSERT_EQ(6u, trajectory.Size());
+
+  // Sorted times, more than a block of them, and before, at and after
+  // the poses
+  std::vector<double> times;
+  for (double t = 0.5; t <= 4.5; t += 0.0125)
+    times.push_back(t);
+  for (std::size_t i = 0; i < trajectory.Size(); ++i)
+    times.push_back(trajectory.Time(i));
+  std::sort(times.begin(), times.end());
+
+  for (bool extrapolate : {false, true})
+  {
+    std::vector<math::Pose3d> poses(times.size());
+    EXPECT_TRUE(trajectory.Interpolate(times.data(), poses.data(),
+        times.size(), extrapolate));
+    for (std::size_t i = 0; i < times.size(); ++i)
+    {
+      const math::Pose3d expected = Expected(trajectory, times[i],
+          extrapolate);
+      EXPECT_TRUE(expected.Pos().Equal(poses[i].Pos(), 1e-12))
+        << times[i] << ": " << expected << " vs " << poses[i];
+      EXPECT_TRUE(expected.Rot().Equal(poses[i].Rot(), 1e-12))
+        << times[i] << ": " << expected << " vs " << poses[i];
+
+      math::Pose3d single;
+      EXPECT_TRUE(trajectory.Interpolate(times[i], single, extrapolate));
+      EXPECT_EQ(poses[i], single);
+    }
+  }
+
+  // The poses themselves, at their times
+  for (std::size_t i : {0u, 1u, 2u, 5u})
+  {
+    math::Pose3d pose;
+    EXPECT_TRUE(trajectory.Interpolate(trajectory.Time(i), pose));
+    EXPECT_EQ(trajectory.Pose(i), pose) << i;
+  }
+
+  // Without extrapolation, the ends are held
+  math::Pose3d pose;
+  EXPECT_TRUE(trajectory.Interpolate(-10.0, pose));
+  EXPECT_EQ(trajectory.Pose(0), pose);
+  EXPECT_TRUE(trajectory.Interpolate(10.0, pose));
+  EXPECT_EQ(trajectory.Pose(5), pose);
+
+  // Extrapolation continues the first and last segments
+  EXPECT_TRUE(trajectory.Interpolate(0.5, pose, true));
+  EXPECT_EQ(math::Vector3d(-1, 1, -2), pose.Pos());
+  EXPECT_TRUE(trajectory.Interpolate(5.0, pose, true));
+  EXPECT_EQ(math::Vector3d(8, 2, 3), pose.Pos());
+}
+
+/////////////////////////////////////////////////
+TEST(Pose3TrajectoryTest, UnsortedTimes)
+{
+  const auto trajectory = TestTrajectory();
+  const std::vector<double> times = {3.5, 1.2, 2.7, 0.0, 3.9, 1.7, 1.7, 5.0};
+  std::vector<math::Pose3d> poses(times.size());
+  EXPECT_TRUE(trajectory.Interpolate(times.data(), poses.data(),
+      times.size()));
+  for (std::size_t i = 0; i < times.size(); ++i)
+  {
+    const math::Pose3d expected = Expected(trajectory, times[i], false);
+    EXPECT_TRUE(expected.Pos().Equal(poses[i].Pos(), 1e-12)) << times[i];
+    EXPECT_TRUE(expected.Rot().Equal(poses[i].Rot(), 1e-12)) << times[i];
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(Pose3TrajectoryTest, TransformPoints)
+{
+  const auto trajectory = TestTrajectory();
+  std::vector<double> times;
+  std::vector<math::Vector3d> points;
+  for (int i = 0; i < 500; ++i)
+  {
+    times.push_back(0.9 + i * 0.007);
+    points.emplace_back(std::cos(i * 0.1) * 10, std::sin(i * 0.1) * 10,
+                        i * 0.01 - 2);
+  }
+
+  std::vector<math::Vector3d> out(points.size());
+  EXPECT_TRUE(trajectory.TransformPoints(times.data(), points.data(),
+      out.data(), points.size(), true));
+  std::vector<math::Pose3d> poses(times.size());
+  EXPECT_TRUE(trajectory.Interpolate(times.data(), poses.data(),
+      times.size(), true));
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    EXPECT_TRUE(poses[i].CoordPositionAdd(points[i]).Equal(out[i], 1e-12))
+      << i << ": " << poses[i].CoordPositionAdd(points[i]) << " vs "
+      << out[i];
+  }
+
+  // In place
+  EXPECT_TRUE(trajectory.TransformPoints(times.data(), points.data(),
+      points.data(), points.size(), true));
+  EXPECT_EQ(out, points);
+}
+
+/////////////////////////////////////////////////
+TEST(Pose3TrajectoryTest, Float)
+{
+  math::Pose3Trajectoryf trajectory;
+  EXPECT_TRUE(trajectory.Append(0.0, math::Pose3f(0, 0, 0, 0, 0, 0)));
+  EXPECT_TRUE(trajectory.Append(1.0, math::Pose3f(2, 0, 0, 0, 0, 1.2f)));
+  math::Pose3f pose;
+  EXPECT_TRUE(trajectory.Interpolate(0.25, pose));
+  EXPECT_TRUE(math::Vector3f(0.5f, 0, 0).Equal(pose.Pos(), 1e-6f));
+  EXPECT_TRUE(math::Quaternionf(0, 0, 0.3f).Equal(pose.Rot(), 1e-6f));
+}
+
+/////////////////////////////////////////////////
+// Check that a simplified trajectory interpolates every pose of the
+// original one within tolerances
+void ExpectWithin(const math::Pose3Trajectoryd &_original,
+                  const math::Pose3Trajectoryd &_simplified,
+                  const double _positionTolerance,
+                  const double _angleTolerance)
+{
+  for (std::size_t i = 0; i < _original.Size(); ++i)
+  {
+    math::Pose3d pose;
+    ASSERT_TRUE(_simplified.Interpolate(_original.Time(i), pose));
+    const math::Pose3d &expected = _original.Pose(i);
+    EXPECT_LE(pose.Pos().Distance(expected.Pos()), _positionTolerance + 1e-9)
+      << i;
+    const double dot = std::min(1.0, std::abs(pose.Rot().Dot(expected.Rot())));
+    EXPECT_LE(2 * std::acos(dot), _angleTolerance + 1e-6) << i;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(Pose3TrajectoryTest, Simplify)
+{
+  // A vehicle logged at 200 Hz, driving straight, then turning, then
+  // shaking
+  math::Pose3Trajectoryd trajectory;
+  for (int i = 0; i < 3000; ++i)
+  {
+    const double time = i / 200.0;
+    double x = time;
+    double y = 0;
+    double yaw = 0;
+    if (time > 5)
+    {
+      yaw = 0.5 * (time - 5);
+      x = 5 + 2 * std::sin(yaw);
+      y = 2 - 2 * std::cos(yaw);
+    }
+    const double roll = time > 10 ? 0.05 * std::sin(40 * time) : 0.0;
+    EXPECT_TRUE(trajectory.Append(time, math::Pose3d(x, y, 0, roll, 0, yaw)));
+  }
+
+  math::Pose3Trajectoryd simplified;
+  trajectory.Simplify(0.01, 0.01, simplified);
+  EXPECT_GT(simplified.Size(), 2u);
+  EXPECT_LT(simplified.Size(), trajectory.Size() / 4);
+  EXPECT_DOUBLE_EQ(trajectory.Time(0), simplified.Time(0));
+  EXPECT_DOUBLE_EQ(trajectory.Time(2999),
+      simplified.Time(simplified.Size() - 1));
+  ExpectWithin(trajectory, simplified, 0.01, 0.01);
+
+  // Tighter tolerances keep more poses
+  math::Pose3Trajectoryd tight;
+  trajectory.Simplify(0.001, 0.001, tight);
+  EXPECT_GT(tight.Size(), simplified.Size());
+  ExpectWithin(trajectory, tight, 0.001, 0.001);
+
+  // Negative tolerances keep every pose
+  trajectory.Simplify(-1, -1, tight);
+  EXPECT_EQ(trajectory.Size(), tight.Size());
+
+  // The straight part is a single segment
+  std::vector<std::size_t> indices;
+  std::vector<double> times;
+  std::vector<math::Pose3d> poses;
+  for (std::size_t i = 0; i <= 1000; ++i)
+  {
+    times.push_back(trajectory.Time(i));
+    poses.push_back(trajectory.Pose(i));
+  }
+  math::Pose3Trajectoryd::Simplify(times.data(), poses.data(), poses.size(),
+      1e-6, 1e-6, indices);
+  EXPECT_EQ((std::vector<std::size_t>{0, 1000}), indices);
+
+  math::Pose3Trajectoryd::Simplify(times.data(), poses.data(), 1,
+      1e-6, 1e-6, indices);
+  EXPECT_EQ(std::vector<std::size_t>{0}, indices);
+  math::Pose3Trajectoryd::Simplify(times.data(), poses.data(), 0,
+      1e-6, 1e-6, indices);
+  EXPECT_TRUE(indices.empty());
+
+  // In place
+  math::Pose3Trajectoryd copy = trajectory;
+  copy.Simplify(0.01, 0.01, copy);
+  EXPECT_EQ(simplified.Size(), copy.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(Pose3TrajectoryTest, SimplifyThreads)
+{
+  // A helix with a slowly varying speed
+  math::Pose3Trajectoryd trajectory;
+  for (int i = 0; i < 20000; ++i)
+  {
+    const double time = i / 200.0;
+    const double angle = 0.2 * time + 0.01 * std::sin(time);
+    EXPECT_TRUE(trajectory.Append(time, math::Pose3d(
+        10 * std::cos(angle), 10 * std::sin(angle), 0.1 * time,
+        0, 0.1, angle + GZ_PI / 2)));
+  }
+
+  math::Pose3Trajectoryd single;
+  trajectory.Simplify(0.005, 0.002, single);
+  math::Pose3Trajectoryd parallel;
+  trajectory.Simplify(0.005, 0.002, parallel, 4);
+  EXPECT_LT(single.Size(), trajectory.Size() / 10);
+  EXPECT_GE(parallel.Size(), single.Size());
+  EXPECT_LE(parallel.Size(), single.Size() + 4);
+  ExpectWithin(trajectory, single, 0.005, 0.002);
+  ExpectWithin(trajectory, parallel, 0.005, 0.002);
+}
@@ -17,6 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
 #include <gz/math/Helpers.hh>
 #include <gz/math/Pose3.hh>
 #include <gz/utils/SuppressWarning.hh>
@@ -269,3 +274,169 @@ TEST(PoseTest, SetPoseElements)
   EXPECT_DOUBLE_EQ(pose.Y(), 12);
   EXPECT_DOUBLE_EQ(pose.Z(), 13);
 }
+
+/////////////////////////////////////////////////
+TEST(PoseTest, CoordPositionAddBatch)
+{
+  const math::Pose3d pose(1, -2, 3, 0.4, -1.1, 2.7);
+
+  std::vector<math::Vector3d> points;
+  for (int i = 0; i < 25; ++i)
+    points.emplace_back(i * 0.5, -i * 1.5, 10.0 - i);
+
+  std::vector<math::Vector3d> out(points.size());
+  pose.CoordPositionAdd(points.data(), out.data(), points.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_TRUE(pose.CoordPositionAdd(points[i]).Equal(out[i], 1e-12));
+
+  // In place
+  std::vector<math::Vector3d> inPlace = points;
+  pose.CoordPositionAdd(inPlace);
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_TRUE(out[i].Equal(inPlace[i], 1e-15));
+
+  // Zero count does not touch the output
+  math::Vector3d untouched(7, 8, 9);
+  pose.CoordPositionAdd(points.data(), &untouched, 0u);
+  EXPECT_EQ(math::Vector3d(7, 8, 9), untouched);
+
+  // Single precision
+  const math::Pose3f posef(1, -2, 3, 0.4f, -1.1f, 2.7f);
+  std::vector<math::Vector3f> pointsf = {{1, 2, 3}, {-4, 5, -6}};
+  std::vector<math::Vector3f> outf(pointsf.size());
+  posef.CoordPositionAdd(pointsf.data(), outf.data(), pointsf.size());
+  for (std::size_t i = 0; i < pointsf.size(); ++i)
+    EXPECT_TRUE(posef.CoordPositionAdd(pointsf[i]).Equal(outf[i], 1e-5f));
+}
+
+/////////////////////////////////////////////////
+TEST(PoseTest, AppendToString)
+{
+  const math::Pose3d pose(1, 2.5, -3, 0.5, 0.1, 0.25);
+  std::string out;
+  appendToString(out, pose);
+  EXPECT_EQ(0u, out.find("1 2.5 -3 0."));
+
+  out.clear();
+  appendToString(out, pose, 3);
+  EXPECT_EQ("1.000 2.500 -3.000 0.500 0.100 0.250", out);
+}
+
+/////////////////////////////////////////////////
+TEST(PoseTest, MultiplyBatch)
+{
+  std::vector<math::Pose3d> a, b;
+  for (int i = 0; i < 20; ++i)
+  {
+    a.emplace_back(i, -0.5 * i, 2, 0.1 * i, -0.2, 0.3 * i);
+    b.emplace_back(-1, i * 0.25, 3 - i, 0.5, 0.05 * i, -0.1 * i);
+  }
+  // A quaternion that isn't normalized
+  a[3].Rot().Set(2, 0, 0, 2);
+
+  std::vector<math::Pose3d> out(a.size());
+  math::Pose3d::Multiply(a.data(), b.data(), out.data(), a.size());
+  for (std::size_t i = 0; i < a.size(); ++i)
+  {
+    const math::Pose3d expected = a[i] * b[i];
+    EXPECT_TRUE(expected.Pos().Equal(out[i].Pos(), 1e-12)) << i;
+    EXPECT_TRUE(expected.Rot().Equal(out[i].Rot(), 1e-12)) << i;
+  }
+
+  // In place, on either side
+  std::vector<math::Pose3d> left = a;
+  math::Pose3d::Multiply(left.data(), b.data(), left.data(), a.size());
+  std::vector<math::Pose3d> right = b;
+  math::Pose3d::Multiply(a.data(), right.data(), right.data(), a.size());
+  for (std::size_t i = 0; i < a.size(); ++i)
+  {
+    EXPECT_TRUE(out[i].Pos().Equal(left[i].Pos(), 1e-15));
+    EXPECT_TRUE(out[i].Pos().Equal(right[i].Pos(), 1e-15));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PoseTest, ComposeChainAndTree)
+{
+  std::vector<math::Pose3d> local;
+  for (int i = 0; i < 10; ++i)
+    local.emplace_back(1, 0.1 * i, 0, 0, 0.2, -0.1 * i);
+
+  std::vector<math::Pose3d> chain(local.size());
+  math::Pose3d::ComposeChain(local.data(), chain.data(), local.size());
+  math::Pose3d expected = local[0];
+  for (std::size_t i = 0; i < local.size(); ++i)
+  {
+    if (i > 0)
+      expected = expected * local[i];
+    EXPECT_TRUE(expected.Pos().Equal(chain[i].Pos(), 1e-12)) << i;
+    EXPECT_TRUE(expected.Rot().Equal(chain[i].Rot(), 1e-12)) << i;
+  }
+
+  // A tree with two roots, where frames 2 and 3 share parent 1
+  const std::vector<int> parents = {-1, 0, 1, 1, -1, 4, 3, 2, 5, 8};
+  std::vector<math::Pose3d> tree(local.size());
+  EXPECT_TRUE(math::Pose3d::ComposeTree(local.data(), parents.data(),
+      tree.data(), local.size()));
+  for (std::size_t i = 0; i < local.size(); ++i)
+  {
+    expected = parents[i] < 0 ? local[i] : tree[parents[i]] * local[i];
+    EXPECT_TRUE(expected.Pos().Equal(tree[i].Pos(), 1e-12)) << i;
+    EXPECT_TRUE(expected.Rot().Equal(tree[i].Rot(), 1e-12)) << i;
+  }
+
+  // In place
+  std::vector<math::Pose3d> inPlace = local;
+  EXPECT_TRUE(math::Pose3d::ComposeTree(inPlace.data(), parents.data(),
+      inPlace.data(), inPlace.size()));
+  for (std::size_t i = 0; i < local.size(); ++i)
+    EXPECT_TRUE(tree[i].Pos().Equal(inPlace[i].Pos(), 1e-15));
+
+  // A parent that comes after its child
+  const std::vector<int> invalid = {-1, 0, 3, 1};
+  std::vector<math::Pose3d> partial(4, math::Pose3d(9, 9, 9, 0, 0, 0));
+  EXPECT_FALSE(math::Pose3d::ComposeTree(local.data(), invalid.data(),
+      partial.data(), partial.size()));
+  EXPECT_EQ(local[0], partial[0]);
+  EXPECT_EQ(math::Pose3d(9, 9, 9, 0, 0, 0), partial[2]);
+
+  // Nothing to compose
+  math::Pose3d::ComposeChain(local.data(), partial.data(), 0u);
+  EXPECT_EQ(local[0], partial[0]);
+}
+
+/////////////////////////////////////////////////
+TEST(PoseTest, Pack)
+{
+  const math::Vector3d min(-10, 0, 5);
+  const math::Vector3d max(10, 100, 5);
+  std::vector<math::Pose3d> poses;
+  for (int i = 0; i < 100; ++i)
+  {
+    poses.emplace_back(-10 + 0.2 * i, 1.01 * i, 5,
+        0.06 * i - 3, 0.03 * i - 1.5, -0.05 * i);
+  }
+  // Clamped to the box
+  poses.emplace_back(-20, 120, 6, 0, 0, 0);
+
+  static_assert(sizeof(math::PackedPose3) == 12, "PackedPose3 size");
+  std::vector<math::PackedPose3> packed(poses.size());
+  math::Pose3d::Pack(poses.data(), packed.data(), poses.size(), min, max);
+  std::vector<math::Pose3d> unpacked(poses.size());
+  math::Pose3d::Unpack(packed.data(), unpacked.data(), packed.size(),
+      min, max);
+
+  for (std::size_t i = 0; i + 1 < poses.size(); ++i)
+  {
+    const math::PackedPose3 single = poses[i].Pack(min, max);
+    EXPECT_EQ(0, std::memcmp(&single, &packed[i], sizeof(single)));
+    EXPECT_NEAR(poses[i].X(), unpacked[i].X(), 20.0 / 65535 / 2 + 1e-12);
+    EXPECT_NEAR(poses[i].Y(), unpacked[i].Y(), 100.0 / 65535 / 2 + 1e-12);
+    EXPECT_DOUBLE_EQ(5, unpacked[i].Z());
+    EXPECT_GT(std::abs(poses[i].Rot().Dot(unpacked[i].Rot())),
+        std::cos(1.5e-4 / 2));
+  }
+  EXPECT_EQ(math::Pose3d(-10, 100, 5, 0, 0, 0), unpacked.back());
+  EXPECT_EQ(math::Pose3d(-10, 100, 5, 0, 0, 0),
+      math::Pose3d::Unpack(poses.back().Pack(min, max), min, max));
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "gz/math/PreparedTriangle3.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/Triangle3.hh"
+#include "gz/math/Vector3.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(PreparedTriangle3Test, Default)
+{
+  PreparedTriangle3d tri;
+  EXPECT_FALSE(tri.Valid());
+  EXPECT_FALSE(tri.Contains(Vector3d::Zero, 1));
+  EXPECT_TRUE(std::isnan(tri.Barycentric(Vector3d::Zero).X()));
+
+  // Collinear vertices
+  tri.Set(Triangle3d(Vector3d(0, 0, 0), Vector3d(1, 1, 1),
+                     Vector3d(2, 2, 2)));
+  EXPECT_FALSE(tri.Valid());
+  EXPECT_FALSE(tri.Contains(Vector3d(1, 1, 1), 1));
+}
+
+/////////////////////////////////////////////////
+TEST(PreparedTriangle3Test, Barycentric)
+{
+  const Triangle3d triangle(Vector3d(0, 0, 0), Vector3d(4, 0, 0),
+                            Vector3d(0, 2, 0));
+  const PreparedTriangle3d tri(triangle);
+  EXPECT_TRUE(tri.Valid());
+  EXPECT_EQ(Vector3d::UnitZ, tri.Normal());
+  EXPECT_DOUBLE_EQ(-1.5, tri.Distance(Vector3d(7, 7, -1.5)));
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    Vector3d expected;
+    expected[i] = 1;
+    EXPECT_EQ(expected, tri.Barycentric(triangle[i]));
+    EXPECT_TRUE(tri.Contains(triangle[i]));
+  }
+
+  EXPECT_EQ(Vector3d(0.5, 0.25, 0.25), tri.Barycentric(Vector3d(1, 0.5, 0)));
+  EXPECT_TRUE(tri.Contains(Vector3d(1, 0.5, 0)));
+
+  // Points off the plane use their projection
+  EXPECT_EQ(Vector3d(0.5, 0.25, 0.25), tri.Barycentric(Vector3d(1, 0.5, 3)));
+  EXPECT_FALSE(tri.Contains(Vector3d(1, 0.5, 0.1)));
+  EXPECT_TRUE(tri.Contains(Vector3d(1, 0.5, 0.1), 0.2));
+  EXPECT_TRUE(tri.Contains(Vector3d(1, 0.5, -0.1), 0.2));
+  EXPECT_FALSE(tri.Contains(Vector3d(3, 2, 0), 0.2));
+  EXPECT_FALSE(tri.Contains(Vector3d(-0.1, 0.5, 0), 0.2));
+
+  // Matches Triangle3::Contains for a triangle in a plane through the
+  // origin
+  EXPECT_EQ(triangle.Contains(Vector3d(1, 0.5, 0)),
+            tri.Contains(Vector3d(1, 0.5, 0)));
+  EXPECT_EQ(triangle.Contains(Vector3d(1, 0.5, 0.1)),
+            tri.Contains(Vector3d(1, 0.5, 0.1)));
+}
+
+/////////////////////////////////////////////////
+TEST(PreparedTriangle3Test, Batch)
+{
+  Rand::Seed(23);
+  const Triangle3d triangle(Vector3d(1, -1, 2), Vector3d(3, 2, 0),
+                            Vector3d(-2, 1, 1));
+  const PreparedTriangle3d tri(triangle);
+
+  const Vector3d e1 = triangle[1] - triangle[0];
+  const Vector3d e2 = triangle[2] - triangle[0];
+  const Vector3d normal = e1.Cross(e2).Normalize();
+  EXPECT_EQ(normal, tri.Normal());
+
+  // Points near the plane of the triangle
+  const std::size_t count = 2000;
+  std::vector<Vector3d> points;
+  std::vector<Vector3d> expectedWeights;
+  std::vector<double> offsets;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const double u = Rand::DblUniform(-0.5, 1.5);
+    const double v = Rand::DblUniform(-0.5, 1.5);
+    offsets.push_back(Rand::DblUniform(-0.2, 0.2));
+    expectedWeights.emplace_back(1 - u - v, u, v);
+    points.push_back(triangle[0] + e1 * u + e2 * v + normal * offsets.back());
+  }
+
+  const double tolerance = 0.1;
+  std::vector<std::uint8_t> results(count);
+  const std::size_t inside = tri.Contains(points.data(), results.data(),
+                                          count, tolerance);
+  std::vector<Vector3d> weights(count);
+  tri.Barycentric(points.data(), weights.data(), count);
+
+  std::size_t expectedInside = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    EXPECT_EQ(tri.Contains(points[i], tolerance), results[i] != 0) << i;
+    EXPECT_EQ(tri.Barycentric(points[i]), weights[i]);
+    EXPECT_NEAR(offsets[i], tri.Distance(points[i]), 1e-12);
+    for (int j = 0; j < 3; ++j)
+      EXPECT_NEAR(expectedWeights[i][j], weights[i][j], 1e-12);
+
+    // Skip points too close to an edge or the tolerance
+    const Vector3d &w = expectedWeights[i];
+    const double margin = std::min(std::abs(tolerance - std::abs(offsets[i])),
+        std::min(std::abs(w.X()), std::min(std::abs(w.Y()), std::abs(w.Z()))));
+    if (margin > 1e-9)
+    {
+      const bool expected = w.Min() >= 0 &&
+        std::abs(offsets[i]) <= tolerance;
+      EXPECT_EQ(expected, results[i] != 0) << i;
+    }
+    expectedInside += results[i];
+  }
+  EXPECT_EQ(expectedInside, inside);
+  EXPECT_GT(inside, 50u);
+  EXPECT_LT(inside, 1000u);
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "gz/math/PreparedTriangle.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/Triangle.hh"
+#include "gz/math/Vector2.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(PreparedTriangleTest, Default)
+{
+  PreparedTriangled tri;
+  EXPECT_FALSE(tri.Valid());
+  EXPECT_FALSE(tri.Contains(Vector2d::Zero));
+  EXPECT_TRUE(std::isnan(tri.Barycentric(Vector2d::Zero).X()));
+
+  // Collinear vertices
+  tri.Set(Triangled(Vector2d(0, 0), Vector2d(1, 1), Vector2d(2, 2)));
+  EXPECT_FALSE(tri.Valid());
+  EXPECT_FALSE(tri.Contains(Vector2d(1, 1)));
+}
+
+/////////////////////////////////////////////////
+TEST(PreparedTriangleTest, Barycentric)
+{
+  const Triangled triangle(Vector2d(1, 1), Vector2d(5, 1), Vector2d(1, 3));
+  const PreparedTriangled tri(triangle);
+  EXPECT_TRUE(tri.Valid());
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    Vector3d expected;
+    expected[i] = 1;
+    EXPECT_EQ(expected, tri.Barycentric(triangle[i]));
+    EXPECT_TRUE(tri.Contains(triangle[i]));
+  }
+
+  EXPECT_EQ(Vector3d(0.5, 0.25, 0.25), tri.Barycentric(Vector2d(2, 1.5)));
+  EXPECT_EQ(Vector3d(0, 0.5, 0.5), tri.Barycentric(Vector2d(3, 2)));
+  EXPECT_TRUE(tri.Contains(Vector2d(3, 2)));
+  EXPECT_EQ(Vector3d(-1, 1, 1), tri.Barycentric(Vector2d(5, 3)));
+  EXPECT_FALSE(tri.Contains(Vector2d(5, 3)));
+  EXPECT_FALSE(tri.Contains(Vector2d(0, 2)));
+
+  // The vertex order does not change containment
+  const PreparedTrianglef flipped(
+      Trianglef(Vector2f(1, 1), Vector2f(1, 3), Vector2f(5, 1)));
+  EXPECT_TRUE(flipped.Contains(Vector2f(2, 1.5f)));
+  EXPECT_FALSE(flipped.Contains(Vector2f(5, 3)));
+  EXPECT_EQ(Vector3f(0.5f, 0.25f, 0.25f),
+            flipped.Barycentric(Vector2f(2, 1.5f)));
+}
+
+/////////////////////////////////////////////////
+TEST(PreparedTriangleTest, Batch)
+{
+  Rand::Seed(17);
+  const Triangled triangle(Vector2d(-2, -1), Vector2d(3, 0.5),
+                           Vector2d(0.5, 4));
+  const PreparedTriangled tri(triangle);
+
+  const std::size_t count = 2000;
+  std::vector<Vector2d> points;
+  std::vector<double> x, y;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    points.emplace_back(Rand::DblUniform(-3, 4), Rand::DblUniform(-2, 5));
+    x.push_back(points.back().X());
+    y.push_back(points.back().Y());
+  }
+
+  std::vector<std::uint8_t> results(count);
+  std::vector<std::uint8_t> soaResults(count);
+  const std::size_t inside = tri.Contains(points.data(), results.data(),
+                                          count);
+  EXPECT_EQ(inside, tri.Contains(x.data(), y.data(), soaResults.data(),
+                                 count));
+  EXPECT_EQ(results, soaResults);
+
+  std::vector<Vector3d> weights(count);
+  std::vector<double> w0(count), w1(count), w2(count);
+  tri.Barycentric(points.data(), weights.data(), count);
+  tri.Barycentric(x.data(), y.data(), w0.data(), w1.data(), w2.data(),
+                  count);
+
+  std::size_t expectedInside = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    EXPECT_EQ(triangle.Contains(points[i]), results[i] != 0) << i;
+    EXPECT_EQ(tri.Contains(points[i]), results[i] != 0) << i;
+    expectedInside += results[i];
+
+    EXPECT_EQ(tri.Barycentric(points[i]), weights[i]);
+    EXPECT_DOUBLE_EQ(weights[i].X(), w0[i]);
+    EXPECT_DOUBLE_EQ(weights[i].Y(), w1[i]);
+    EXPECT_DOUBLE_EQ(weights[i].Z(), w2[i]);
+    EXPECT_NEAR(1.0, weights[i].Sum(), 1e-12);
+
+    // The weights interpolate the vertices to the point
+    const Vector2d interpolated = triangle[0] * weights[i].X() +
+      triangle[1] * weights[i].Y() + triangle[2] * weights[i].Z();
+    EXPECT_NEAR(points[i].X(), interpolated.X(), 1e-12);
+    EXPECT_NEAR(points[i].Y(), interpolated.Y(), 1e-12);
+  }
+  EXPECT_EQ(expectedInside, inside);
+  EXPECT_GT(inside, 200u);
+  EXPECT_LT(inside, 1800u);
+}
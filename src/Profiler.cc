@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "gz/math/Profiler.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <gz/utils/NeverDestroyed.hh>
+
+using namespace gz::math;
+
+namespace
+{
+  /// \brief Samples of one zone recorded by one thread. Only the owning
+  /// thread writes to it, other threads read it when combining statistics,
+  /// so relaxed loads and stores are enough and no read-modify-write is
+  /// needed.
+  struct ZoneCounters
+  {
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::uint64_t> total{0};
+    std::atomic<std::uint64_t> min{std::numeric_limits<std::uint64_t>::max()};
+    std::atomic<std::uint64_t> max{0};
+    std::atomic<std::uint64_t> histogram[ProfileStatistics::kBuckets] = {};
+  };
+
+  /// \brief Increment a counter that only the calling thread writes.
+  /// \param[in, out] _counter The counter.
+  /// \param[in] _value Value to add.
+  void Add(std::atomic<std::uint64_t> &_counter, const std::uint64_t _value)
+  {
+    _counter.store(_counter.load(std::memory_order_relaxed) + _value,
+                   std::memory_order_relaxed);
+  }
+
+  /// \brief The zones recorded by one thread. Counters are allocated the
+  /// first time the thread records a zone and live as long as the process,
+  /// so a thread can exit without losing its samples.
+  struct ThreadBuffer
+  {
+    std::atomic<ZoneCounters *> zones[Profiler::kMaxZones] = {};
+    std::unique_ptr<ZoneCounters> storage[Profiler::kMaxZones];
+  };
+
+  /// \brief Zone names and the buffers of all threads.
+  struct Registry
+  {
+    std::mutex mutex;
+    std::vector<std::string> names;
+    std::unordered_map<std::string, std::size_t> ids;
+    std::vector<std::unique_ptr<ThreadBuffer>> threads;
+  };
+
+  /// \brief Get the process wide registry.
+  /// \return The registry.
+  Registry &GetRegistry()
+  {
+    static gz::utils::NeverDestroyed<Registry> registry;
+    return registry.Access();
+  }
+
+  /// \brief Get the buffer of the calling thread, creating it if needed.
+  /// \return The buffer.
+  ThreadBuffer &GetThreadBuffer()
+  {
+    thread_local ThreadBuffer *buffer = nullptr;
+    if (!buffer)
+    {
+      Registry &registry = GetRegistry();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      registry.threads.push_back(std::make_unique<ThreadBuffer>());
+      buffer = registry.threads.back().get();
+    }
+    return *buffer;
+  }
+}
+
+//////////////////////////////////////////////////
+std::size_t Profiler::RegisterZone(const std::string &_name)
+{
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto iter = registry.ids.find(_name);
+  if (iter != registry.ids.end())
+    return iter->second;
+
+  if (registry.names.size() >= kMaxZones)
+    return kInvalidZone;
+
+  const std::size_t id = registry.names.size();
+  registry.names.push_back(_name);
+  registry.ids[_name] = id;
+  return id;
+}
+
+//////////////////////////////////////////////////
+void Profiler::Record(const std::size_t _zone,
+                      const clock::duration &_duration)
+{
+  if (_zone >= kMaxZones)
+    return;
+
+  ThreadBuffer &buffer = GetThreadBuffer();
+  ZoneCounters *counters = buffer.zones[_zone].load(std::memory_order_relaxed);
+  if (!counters)
+  {
+    buffer.storage[_zone] = std::make_unique<ZoneCounters>();
+    counters = buffer.storage[_zone].get();
+    buffer.zones[_zone].store(counters, std::memory_order_release);
+  }
+
+  const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      _duration).count();
+  const std::uint64_t value = ns > 0 ? static_cast<std::uint64_t>(ns) : 0u;
+
+  Add(counters->count, 1u);
+  Add(counters->total, value);
+  Add(counters->histogram[ProfileStatistics::Bucket(value)], 1u);
+  if (value < counters->min.load(std::memory_order_relaxed))
+    counters->min.store(value, std::memory_order_relaxed);
+  if (value > counters->max.load(std::memory_order_relaxed))
+    counters->max.store(value, std::memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////
+std::vector<std::string> Profiler::Zones()
+{
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return registry.names;
+}
+
+//////////////////////////////////////////////////
+bool Profiler::Statistics(const std::string &_name,
+                          ProfileStatistics &_stats)
+{
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto iter = registry.ids.find(_name);
+  if (iter == registry.ids.end())
+    return false;
+
+  _stats = ProfileStatistics();
+  std::uint64_t min = std::numeric_limits<std::uint64_t>::max();
+  for (const auto &thread : registry.threads)
+  {
+    const ZoneCounters *counters =
+      thread->zones[iter->second].load(std::memory_order_acquire);
+    if (!counters)
+      continue;
+
+    _stats.count += counters->count.load(std::memory_order_relaxed);
+    _stats.total += counters->total.load(std::memory_order_relaxed);
+    min = std::min(min, counters->min.load(std::memory_order_relaxed));
+    _stats.max = std::max(_stats.max,
+        counters->max.load(std::memory_order_relaxed));
+    for (std::size_t i = 0; i < ProfileStatistics::kBuckets; ++i)
+    {
+      _stats.histogram[i] +=
+        counters->histogram[i].load(std::memory_order_relaxed);
+    }
+  }
+  _stats.min = _stats.count > 0 ? min : 0u;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void Profiler::Reset()
+{
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (const auto &thread : registry.threads)
+  {
+    for (auto &zone : thread->zones)
+    {
+      ZoneCounters *counters = zone.load(std::memory_order_acquire);
+      if (!counters)
+        continue;
+
+      counters->count.store(0, std::memory_order_relaxed);
+      counters->total.store(0, std::memory_order_relaxed);
+      counters->min.store(std::numeric_limits<std::uint64_t>::max(),
+                          std::memory_order_relaxed);
+      counters->max.store(0, std::memory_order_relaxed);
+      for (auto &bucket : counters->histogram)
+        bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void Profiler::Dump(std::ostream &_out)
+{
+  const std::ios_base::fmtflags flags = _out.flags();
+  const std::streamsize precision = _out.precision();
+
+  _out << std::left << std::setw(40) << "zone" << std::right
+       << std::setw(12) << "count"
+       << std::setw(14) << "mean_ns"
+       << std::setw(14) << "min_ns"
+       << std::setw(14) << "p50_ns"
+       << std::setw(14) << "p99_ns"
+       << std::setw(14) << "max_ns" << "\n";
+
+  _out << std::fixed << std::setprecision(0);
+  for (const auto &name : Zones())
+  {
+    ProfileStatistics stats;
+    if (!Statistics(name, stats) || stats.count == 0)
+      continue;
+
+    _out << std::left << std::setw(40) << name << std::right
+         << std::setw(12) << stats.count
+         << std::setw(14) << stats.Mean()
+         << std::setw(14) << stats.min
+         << std::setw(14) << stats.Percentile(50)
+         << std::setw(14) << stats.Percentile(99)
+         << std::setw(14) << stats.max << "\n";
+  }
+
+  _out.flags(flags);
+  _out.precision(precision);
+}
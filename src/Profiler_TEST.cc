@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Enable the zone macro for this test
+#ifndef GZ_MATH_PROFILING
+#define GZ_MATH_PROFILING
+#endif
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "gz/math/Profiler.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+TEST(ProfilerTest, RegisterZone)
+{
+  const std::size_t a = math::Profiler::RegisterZone("ProfilerTest::A");
+  const std::size_t b = math::Profiler::RegisterZone("ProfilerTest::B");
+  EXPECT_NE(a, b);
+  EXPECT_EQ(a, math::Profiler::RegisterZone("ProfilerTest::A"));
+  EXPECT_NE(math::Profiler::kInvalidZone, a);
+
+  bool found = false;
+  for (const auto &name : math::Profiler::Zones())
+    found = found || name == "ProfilerTest::B";
+  EXPECT_TRUE(found);
+
+  math::ProfileStatistics stats;
+  EXPECT_FALSE(math::Profiler::Statistics("ProfilerTest::Missing", stats));
+  EXPECT_TRUE(math::Profiler::Statistics("ProfilerTest::B", stats));
+  EXPECT_EQ(0u, stats.count);
+  EXPECT_DOUBLE_EQ(0.0, stats.Mean());
+  EXPECT_DOUBLE_EQ(0.0, stats.Percentile(50));
+
+  // Samples of invalid zones are dropped
+  math::Profiler::Record(math::Profiler::kInvalidZone,
+      std::chrono::nanoseconds(1));
+}
+
+/////////////////////////////////////////////////
+TEST(ProfilerTest, Statistics)
+{
+  const std::size_t zone = math::Profiler::RegisterZone("ProfilerTest::Stats");
+  for (int i = 1; i <= 100; ++i)
+    math::Profiler::Record(zone, std::chrono::microseconds(i));
+
+  math::ProfileStatistics stats;
+  ASSERT_TRUE(math::Profiler::Statistics("ProfilerTest::Stats", stats));
+  EXPECT_EQ(100u, stats.count);
+  EXPECT_EQ(5050000u, stats.total);
+  EXPECT_EQ(1000u, stats.min);
+  EXPECT_EQ(100000u, stats.max);
+  EXPECT_DOUBLE_EQ(50500.0, stats.Mean());
+
+  // Percentiles are estimated within a bucket, 12.5% relative error
+  EXPECT_NEAR(50000.0, stats.Percentile(50), 50000.0 * 0.125);
+  EXPECT_NEAR(90000.0, stats.Percentile(90), 90000.0 * 0.125);
+  EXPECT_DOUBLE_EQ(1000.0, stats.Percentile(0));
+  EXPECT_DOUBLE_EQ(100000.0, stats.Percentile(100));
+
+  math::Profiler::Reset();
+  ASSERT_TRUE(math::Profiler::Statistics("ProfilerTest::Stats", stats));
+  EXPECT_EQ(0u, stats.count);
+  EXPECT_EQ(0u, stats.min);
+  EXPECT_EQ(0u, stats.max);
+}
+
+/////////////////////////////////////////////////
+TEST(ProfilerTest, Buckets)
+{
+  for (std::uint64_t ns : {0ull, 1ull, 3ull, 4ull, 7ull, 8ull, 1000ull,
+                           123456789ull, 1ull << 40})
+  {
+    const std::size_t bucket = math::ProfileStatistics::Bucket(ns);
+    ASSERT_LT(bucket, math::ProfileStatistics::kBuckets);
+    EXPECT_LE(math::ProfileStatistics::BucketLowerBound(bucket), ns);
+    EXPECT_GT(math::ProfileStatistics::BucketLowerBound(bucket + 1), ns);
+  }
+  EXPECT_EQ(math::ProfileStatistics::kBuckets - 1,
+      math::ProfileStatistics::Bucket(~0ull));
+}
+
+/////////////////////////////////////////////////
+TEST(ProfilerTest, Threads)
+{
+  const std::size_t zone =
+    math::Profiler::RegisterZone("ProfilerTest::Threads");
+
+  const int threadCount = 4;
+  const int samples = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t)
+  {
+    threads.emplace_back([zone, t]()
+    {
+      for (int i = 0; i < samples; ++i)
+        math::Profiler::Record(zone, std::chrono::nanoseconds(100 * (t + 1)));
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  // Samples of threads that have exited are kept
+  math::ProfileStatistics stats;
+  ASSERT_TRUE(math::Profiler::Statistics("ProfilerTest::Threads", stats));
+  EXPECT_EQ(static_cast<std::uint64_t>(threadCount * samples), stats.count);
+  EXPECT_EQ(100u, stats.min);
+  EXPECT_EQ(400u, stats.max);
+  EXPECT_DOUBLE_EQ(250.0, stats.Mean());
+}
+
+/////////////////////////////////////////////////
+void ProfiledFunction()
+{
+  GZ_MATH_PROFILE_ZONE("ProfilerTest::Macro");
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+/////////////////////////////////////////////////
+TEST(ProfilerTest, Zone)
+{
+  {
+    math::ProfileZone zone(
+        math::Profiler::RegisterZone("ProfilerTest::Scoped"));
+  }
+  ProfiledFunction();
+  ProfiledFunction();
+
+  math::ProfileStatistics stats;
+  ASSERT_TRUE(math::Profiler::Statistics("ProfilerTest::Scoped", stats));
+  EXPECT_EQ(1u, stats.count);
+
+  ASSERT_TRUE(math::Profiler::Statistics("ProfilerTest::Macro", stats));
+  EXPECT_EQ(2u, stats.count);
+  EXPECT_GE(stats.min, 1000000u);
+
+  std::ostringstream out;
+  math::Profiler::Dump(out);
+  EXPECT_NE(std::string::npos, out.str().find("ProfilerTest::Macro"));
+  EXPECT_NE(std::string::npos, out.str().find("p99_ns"));
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "gz/math/QuantizedValues.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(QuantizedValuesTest, Empty)
+{
+  QuantizedValues<> values;
+  EXPECT_EQ(0u, values.Size());
+  EXPECT_DOUBLE_EQ(0.0, values.MaxError());
+
+  QuantizedValues<> fromEmpty{std::vector<double>()};
+  EXPECT_EQ(0u, fromEmpty.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(QuantizedValuesTest, RoundTrip)
+{
+  std::vector<double> original;
+  for (int i = 0; i < 1000; ++i)
+    original.push_back(std::sin(i * 0.1) * 250.0 + 40.0);
+
+  QuantizedValues<std::int16_t, double> values(original);
+  ASSERT_EQ(original.size(), values.Size());
+  EXPECT_GT(values.MaxError(), 0.0);
+  EXPECT_NEAR(values.MaxError(), 500.0 / 65534 / 2, 1e-3);
+  for (std::size_t i = 0; i < original.size(); ++i)
+    EXPECT_NEAR(original[i], values[i], values.MaxError() + 1e-12) << i;
+
+  // The smallest and largest values are exact up to rounding
+  const auto [minIt, maxIt] =
+    std::minmax_element(original.begin(), original.end());
+  EXPECT_NEAR(*minIt, values[minIt - original.begin()], 1e-9);
+  EXPECT_NEAR(*maxIt, values[maxIt - original.begin()], 1e-9);
+  EXPECT_DOUBLE_EQ(values.Offset() + values.Data()[3] * values.Scale(),
+    values[3]);
+}
+
+/////////////////////////////////////////////////
+TEST(QuantizedValuesTest, Types)
+{
+  const std::vector<float> original{-2.0f, -0.5f, 0.0f, 1.25f, 2.0f};
+
+  // Symmetric values keep zero exact with signed storage
+  QuantizedValues<std::int8_t, float> signed8(original);
+  EXPECT_FLOAT_EQ(0.0f, signed8[2]);
+  for (std::size_t i = 0; i < original.size(); ++i)
+    EXPECT_NEAR(original[i], signed8[i], signed8.MaxError() + 1e-6f);
+
+  QuantizedValues<std::uint16_t, float> unsigned16(original);
+  EXPECT_LT(unsigned16.MaxError(), signed8.MaxError());
+  for (std::size_t i = 0; i < original.size(); ++i)
+    EXPECT_NEAR(original[i], unsigned16[i], unsigned16.MaxError() + 1e-6f);
+}
+
+/////////////////////////////////////////////////
+TEST(QuantizedValuesTest, Degenerate)
+{
+  QuantizedValues<> constant(std::vector<double>(10, 3.5));
+  EXPECT_DOUBLE_EQ(0.0, constant.MaxError());
+  for (std::size_t i = 0; i < constant.Size(); ++i)
+    EXPECT_DOUBLE_EQ(3.5, constant[i]);
+
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  QuantizedValues<> withNan(std::vector<double>{1.0, nan, 3.0});
+  EXPECT_NEAR(1.0, withNan[0], 1e-9);
+  EXPECT_NEAR(1.0, withNan[1], 1e-9);
+  EXPECT_NEAR(3.0, withNan[2], 1e-9);
+}
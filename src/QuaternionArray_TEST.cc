@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "gz/math/Helpers.hh"
+#include "gz/math/Matrix3.hh"
+#include "gz/math/Quaternion.hh"
+#include "gz/math/QuaternionArray.hh"
+#include "gz/math/Vector3Array.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+std::vector<math::Quaterniond> TestQuaternions()
+{
+  return {
+    math::Quaterniond(0.1, 0.2, 0.3),
+    math::Quaterniond(-1.2, 0.5, 2.9),
+    math::Quaterniond::Identity,
+    math::Quaterniond(2, 0, 0, 0),
+    math::Quaterniond(0.3, -0.2, 1.1, 4.0),
+    math::Quaterniond(0, 0, 0, 0),
+    math::Quaterniond(0.0, 1.5707, 0.0),
+    math::Quaterniond(-0.5, -0.5, 0.5, -0.5)};
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionArrayTest, Construction)
+{
+  math::QuaternionArrayd identities(3);
+  ASSERT_EQ(3u, identities.Size());
+  for (std::size_t i = 0; i < identities.Size(); ++i)
+    EXPECT_EQ(math::Quaterniond::Identity, identities[i]);
+
+  const auto quaternions = TestQuaternions();
+  math::QuaternionArrayd array(quaternions);
+  ASSERT_EQ(quaternions.size(), array.Size());
+  for (std::size_t i = 0; i < quaternions.size(); ++i)
+    EXPECT_EQ(quaternions[i], array[i]);
+  EXPECT_EQ(quaternions, array.ToVector());
+
+  array.Set(1, math::Quaterniond::Identity);
+  EXPECT_EQ(math::Quaterniond::Identity, array[1]);
+  array.PushBack(math::Quaterniond(0.5, 0.5, 0.5, 0.5));
+  EXPECT_EQ(quaternions.size() + 1, array.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionArrayTest, Normalize)
+{
+  const auto quaternions = TestQuaternions();
+  math::QuaternionArrayd array(quaternions);
+  array.Normalize();
+  for (std::size_t i = 0; i < quaternions.size(); ++i)
+  {
+    math::Quaterniond expected = quaternions[i];
+    expected.Normalize();
+    EXPECT_TRUE(expected.Equal(array[i], 1e-12)) << i;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionArrayTest, NormalizeFast)
+{
+  const auto quaternions = TestQuaternions();
+  math::QuaternionArrayd array(quaternions);
+  array.NormalizeFast();
+  for (std::size_t i = 0; i < quaternions.size(); ++i)
+  {
+    math::Quaterniond expected = quaternions[i];
+    expected.NormalizeFast();
+    EXPECT_EQ(expected, array[i]) << i;
+    EXPECT_TRUE(quaternions[i].Normalized().Equal(array[i], 1e-10)) << i;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionArrayTest, Multiply)
+{
+  const auto a = TestQuaternions();
+  std::vector<math::Quaterniond> b;
+  for (const auto &q : a)
+    b.push_back(q.Inverse() * math::Quaterniond(0.4, -0.3, 0.2));
+
+  math::QuaternionArrayd array(a);
+  EXPECT_TRUE(array.Multiply(math::QuaternionArrayd(b)));
+  for (std::size_t i = 0; i < a.size(); ++i)
+    EXPECT_TRUE((a[i] * b[i]).Equal(array[i], 1e-12)) << i;
+
+  EXPECT_FALSE(array.Multiply(math::QuaternionArrayd(2)));
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionArrayTest, Slerp)
+{
+  std::vector<math::Quaterniond> from = {
+    math::Quaterniond(0.1, 0.2, 0.3),
+    math::Quaterniond(0, 0, 0),
+    math::Quaterniond(1.0, -0.5, 2.5),
+    math::Quaterniond(0.3, 0.3, 0.3)};
+  std::vector<math::Quaterniond> to = {
+    math::Quaterniond(-0.4, 1.2, 2.3),
+    math::Quaterniond(0, 0, 1.5707),
+    math::Quaterniond(-1.0, 0.5, -2.5),
+    math::Quaterniond(0.3, 0.3, 0.3001)};
+  const std::vector<double> t = {0.0, 0.25, 0.5, 0.9};
+
+  math::QuaternionArrayd a(from);
+  math::QuaternionArrayd b(to);
+  math::QuaternionArrayd out;
+
+  for (bool shortest : {false, true})
+  {
+    EXPECT_TRUE(a.Slerp(t, b, out, shortest));
+    ASSERT_EQ(from.size(), out.Size());
+    for (std::size_t i = 0; i < from.size(); ++i)
+    {
+      const auto expected =
+        math::Quaterniond::Slerp(t[i], from[i], to[i], shortest);
+      EXPECT_TRUE(expected.Equal(out[i], 1e-12))
+        << i << " " << expected << " vs " << out[i];
+    }
+  }
+
+  EXPECT_FALSE(a.Slerp({0.5}, b, out));
+  EXPECT_FALSE(a.Slerp(t, math::QuaternionArrayd(1), out));
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionArrayTest, RotateVector)
+{
+  const auto quaternions = TestQuaternions();
+  std::vector<math::Vector3d> vectors;
+  for (std::size_t i = 0; i < quaternions.size(); ++i)
+    vectors.emplace_back(1.0 + i, -2.0 * i, 0.5);
+
+  math::QuaternionArrayd array(quaternions);
+  math::Vector3Arrayd in(vectors);
+  math::Vector3Arrayd out;
+  EXPECT_TRUE(array.RotateVector(in, out));
+  ASSERT_EQ(vectors.size(), out.Size());
+  for (std::size_t i = 0; i < quaternions.size(); ++i)
+  {
+    const auto expected = quaternions[i].RotateVector(vectors[i]);
+    EXPECT_TRUE(expected.Equal(out[i], 1e-12))
+      << i << " " << expected << " vs " << out[i];
+  }
+
+  // In place
+  EXPECT_TRUE(array.RotateVector(in, in));
+  EXPECT_EQ(out, in);
+
+  EXPECT_FALSE(array.RotateVector(math::Vector3Arrayd(1), out));
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionArrayTest, Euler)
+{
+  // More than one block of angles, including gimbal lock
+  std::vector<math::Vector3d> angles;
+  for (int i = 0; i < 300; ++i)
+  {
+    angles.emplace_back(0.05 * i - 7, 0.013 * i - 2, 3 - 0.021 * i);
+  }
+  angles.emplace_back(0.3, GZ_PI_2, -0.4);
+  angles.emplace_back(0.3, -GZ_PI_2, 0.4);
+  angles.emplace_back(0, 0, 0);
+  angles.emplace_back(1e5, -1e5, 2e5);
+
+  math::QuaternionArrayd array;
+  array.SetFromEuler(math::Vector3Arrayd(angles));
+  ASSERT_EQ(angles.size(), array.Size());
+  for (std::size_t i = 0; i < angles.size(); ++i)
+  {
+    const math::Quaterniond expected(angles[i]);
+    EXPECT_TRUE(expected.Equal(array[i], 1e-14))
+      << i << " " << expected << " vs " << array[i];
+  }
+
+  // Back to Euler angles, also from non-normalized and zero quaternions
+  for (const auto &q : TestQuaternions())
+    array.PushBack(q);
+  math::Vector3Arrayd euler;
+  array.Euler(euler);
+  ASSERT_EQ(array.Size(), euler.Size());
+  for (std::size_t i = 0; i < array.Size(); ++i)
+  {
+    const math::Vector3d expected = array[i].Euler();
+    EXPECT_TRUE(expected.Equal(euler[i], 1e-12))
+      << i << " " << expected << " vs " << euler[i];
+  }
+
+  // At gimbal lock the yaw is 0
+  math::QuaternionArrayd locked;
+  locked.PushBack(math::Quaterniond(
+      0.70710678118654757, 0, 0.70710678118654757, 0));
+  locked.PushBack(math::Quaterniond(0.5, 0.5, -0.5, 0.5));
+  locked.Euler(euler);
+  for (std::size_t i = 0; i < locked.Size(); ++i)
+  {
+    EXPECT_EQ(locked[i].Euler(), euler[i]);
+    EXPECT_DOUBLE_EQ(0.0, euler[i].Z());
+  }
+
+  // Float
+  math::QuaternionArrayf arrayf;
+  arrayf.SetFromEuler(math::Vector3Arrayf(
+      std::vector<math::Vector3f>{{0.1f, 0.2f, 0.3f}, {-2, 1, 3}}));
+  EXPECT_TRUE(math::Quaternionf(0.1f, 0.2f, 0.3f).Equal(arrayf[0], 1e-6f));
+  EXPECT_TRUE(math::Quaternionf(-2, 1, 3).Equal(arrayf[1], 1e-6f));
+  math::Vector3Arrayf eulerf;
+  arrayf.Euler(eulerf);
+  EXPECT_TRUE(eulerf[0].Equal(math::Vector3f(0.1f, 0.2f, 0.3f), 1e-5f));
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionArrayTest, Matrix)
+{
+  std::vector<math::Matrix3d> matrices;
+  for (const auto &q : TestQuaternions())
+    matrices.emplace_back(q);
+  // One rotation for each of the four formulas
+  matrices.emplace_back(math::Quaterniond(0.1, 0.9, 0.3, 0.2));
+  matrices.emplace_back(math::Quaterniond(0.1, 0.2, 0.9, 0.3));
+  matrices.emplace_back(math::Quaterniond(0.1, 0.3, 0.2, 0.9));
+  matrices.emplace_back(math::Matrix3d(-1, 0, 0, 0, -1, 0, 0, 0, 1));
+
+  math::QuaternionArrayd array;
+  array.SetFromMatrix(matrices.data(), matrices.size());
+  ASSERT_EQ(matrices.size(), array.Size());
+  for (std::size_t i = 0; i < matrices.size(); ++i)
+  {
+    math::Quaterniond expected;
+    expected.SetFromMatrix(matrices[i]);
+    EXPECT_DOUBLE_EQ(expected.W(), array[i].W()) << i;
+    EXPECT_DOUBLE_EQ(expected.X(), array[i].X()) << i;
+    EXPECT_DOUBLE_EQ(expected.Y(), array[i].Y()) << i;
+    EXPECT_DOUBLE_EQ(expected.Z(), array[i].Z()) << i;
+  }
+
+  // Back to matrices, also from non-normalized and zero quaternions
+  for (const auto &q : TestQuaternions())
+    array.PushBack(q);
+  std::vector<math::Matrix3d> out(array.Size());
+  array.ToMatrix(out.data());
+  for (std::size_t i = 0; i < array.Size(); ++i)
+    EXPECT_EQ(math::Matrix3d(array[i]), out[i]) << i;
+}
@@ -17,7 +17,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <vector>
 
 #include "gz/math/Helpers.hh"
 #include "gz/math/Quaternion.hh"
@@ -372,6 +375,23 @@ TEST(QuaternionTest, MathNormalize)
   EXPECT_EQ(q, math::Quaterniond(0.182574, 0.365148, 0.547723, 0.730297));
 }
 
+/////////////////////////////////////////////////
+TEST(QuaternionTest, MathNormalizeFast)
+{
+  math::Quaterniond q(1, 2, 3, 4);
+  q.NormalizeFast();
+  EXPECT_TRUE(math::Quaterniond(1, 2, 3, 4).Normalized().Equal(q, 1e-10));
+
+  math::Quaterniond zero(0, 0, 0, 0);
+  zero.NormalizeFast();
+  EXPECT_EQ(math::Quaterniond::Identity, zero);
+
+  math::Quaternionf f(0.9f, 0.1f, -0.2f, 0.3f);
+  f.NormalizeFast();
+  EXPECT_TRUE(math::Quaternionf(0.9f, 0.1f, -0.2f, 0.3f).Normalized().Equal(
+      f, 1e-5f));
+}
+
 /////////////////////////////////////////////////
 TEST(QuaternionTest, Math)
 {
@@ -715,3 +735,125 @@ TEST(QuaternionTest, From2Axes)
   EXPECT_TRUE(math::equal(q2.Z(), 0.0));
 }
 
+
+/////////////////////////////////////////////////
+TEST(QuaternionTest, RotateVectorBatch)
+{
+  const math::Quaterniond q(0.3, -0.2, 1.9);
+
+  std::vector<math::Vector3d> vectors;
+  for (int i = 0; i < 25; ++i)
+    vectors.emplace_back(i * 0.5, -i * 1.5, 10.0 - i);
+
+  std::vector<math::Vector3d> out(vectors.size());
+  q.RotateVector(vectors.data(), out.data(), vectors.size());
+  for (std::size_t i = 0; i < vectors.size(); ++i)
+    EXPECT_TRUE(q.RotateVector(vectors[i]).Equal(out[i], 1e-12));
+
+  // In place
+  q.RotateVector(vectors.data(), vectors.data(), vectors.size());
+  for (std::size_t i = 0; i < vectors.size(); ++i)
+    EXPECT_TRUE(out[i].Equal(vectors[i], 1e-15));
+
+  // A non-unit quaternion represents the same rotation
+  const math::Quaterniond scaled(q.W() * 3, q.X() * 3, q.Y() * 3, q.Z() * 3);
+  math::Vector3d v(1, 2, 3);
+  math::Vector3d rotated;
+  scaled.RotateVector(&v, &rotated, 1u);
+  EXPECT_TRUE(q.RotateVector(v).Equal(rotated, 1e-12));
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionTest, Constexpr)
+{
+  // Unit quaternions with exactly representable components, so that the
+  // results below are exact.
+  constexpr double h = 0.5;
+  constexpr math::Quaterniond a(h, h, h, h);
+  constexpr math::Quaterniond b(h, -h, h, -h);
+  constexpr double dot = a.Dot(b);
+  EXPECT_DOUBLE_EQ(0, dot);
+
+  constexpr math::Quaterniond product = a * b;
+  EXPECT_DOUBLE_EQ(0.5, product.W());
+  EXPECT_DOUBLE_EQ(-0.5, product.X());
+  EXPECT_DOUBLE_EQ(0.5, product.Y());
+  EXPECT_DOUBLE_EQ(0.5, product.Z());
+
+  constexpr math::Quaterniond sum = a + b - a * 2.0;
+  EXPECT_DOUBLE_EQ(0, sum.W());
+  EXPECT_DOUBLE_EQ(-1, sum.X());
+  EXPECT_DOUBLE_EQ(0, sum.Y());
+  EXPECT_DOUBLE_EQ(-1, sum.Z());
+  constexpr math::Quaterniond negated = -a;
+  EXPECT_DOUBLE_EQ(-0.5, negated.W());
+
+  // a is a 120 degree rotation about (1, 1, 1), which maps x onto y
+  constexpr math::Vector3d v = a * math::Vector3d(1, 0, 0);
+  EXPECT_EQ(math::Vector3d::UnitY, v);
+  EXPECT_EQ(a.RotateVector(math::Vector3d::UnitX), v);
+}
+
+/////////////////////////////////////////////////
+TEST(QuaternionTest, PackSmallestThree)
+{
+  // The identity and the rotations by 180 degrees about an axis are exact
+  const math::Quaterniond exact[] = {
+    math::Quaterniond::Identity, math::Quaterniond(0, 1, 0, 0),
+    math::Quaterniond(0, 0, 1, 0), math::Quaterniond(0, 0, 0, -1)};
+  for (const auto &q : exact)
+  {
+    const auto q32 =
+        math::Quaterniond::UnpackSmallestThree32(q.PackSmallestThree32());
+    const auto q48 =
+        math::Quaterniond::UnpackSmallestThree48(q.PackSmallestThree48());
+    EXPECT_EQ(1.0, std::abs(q32.Dot(q)));
+    EXPECT_EQ(1.0, std::abs(q48.Dot(q)));
+  }
+  EXPECT_EQ(math::Quaterniond::Identity,
+      math::Quaterniond::UnpackSmallestThree32(
+          math::Quaterniond(0, 0, 0, 0).PackSmallestThree32()));
+  EXPECT_GT(1u << 30, math::Quaterniond::Identity.PackSmallestThree32());
+  EXPECT_GT(std::uint64_t(1) << 47,
+      math::Quaterniond::Identity.PackSmallestThree48());
+
+  // Largest angle between the rotations and their decoded codes. The
+  // sign of the quaternion and its norm are not kept.
+  std::vector<math::Quaterniond> rotations;
+  for (double roll = -3.1; roll < 3.2; roll += 0.29)
+    for (double pitch = -1.5; pitch < 1.6; pitch += 0.23)
+      for (double yaw = -3.1; yaw < 3.2; yaw += 0.31)
+        rotations.emplace_back(roll, pitch, yaw);
+  rotations.back() = rotations.back() * -2.5;
+
+  std::vector<std::uint32_t> codes32(rotations.size());
+  std::vector<std::uint64_t> codes48(rotations.size());
+  math::Quaterniond::PackSmallestThree32(rotations.data(), codes32.data(),
+      rotations.size());
+  math::Quaterniond::PackSmallestThree48(rotations.data(), codes48.data(),
+      rotations.size());
+  std::vector<math::Quaterniond> out32(rotations.size());
+  std::vector<math::Quaterniond> out48(rotations.size());
+  math::Quaterniond::UnpackSmallestThree32(codes32.data(), out32.data(),
+      codes32.size());
+  math::Quaterniond::UnpackSmallestThree48(codes48.data(), out48.data(),
+      codes48.size());
+
+  double error32 = 0;
+  double error48 = 0;
+  for (std::size_t i = 0; i < rotations.size(); ++i)
+  {
+    math::Quaterniond q = rotations[i];
+    q.Normalize();
+    EXPECT_EQ(codes32[i], q.PackSmallestThree32());
+    EXPECT_EQ(0u, codes48[i] >> 48);
+    EXPECT_NEAR(1.0, out32[i].Dot(out32[i]), 1e-12);
+    error32 = std::max(error32,
+        2 * std::acos(std::min(1.0, std::abs(q.Dot(out32[i])))));
+    error48 = std::max(error48,
+        2 * std::acos(std::min(1.0, std::abs(q.Dot(out48[i])))));
+  }
+  EXPECT_LT(error32, 5e-3);
+  EXPECT_LT(error48, 1.5e-4);
+  EXPECT_LT(error48, error32 / 16);
+}
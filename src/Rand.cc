@@ -25,23 +25,108 @@
   #include <unistd.h>
 #endif
 
+#include <atomic>
+#include <cstdint>
+
 #include "gz/math/Rand.hh"
+#include "RandPrivate.hh"
 
 using namespace gz;
 using namespace math;
 
+namespace
+{
+/// \brief Get the global seed.
+/// \return The global seed.
+std::atomic<uint32_t> &GlobalSeed()
+{
+  // We don't seed with time for the cases when two processes are started the
+  // same time (this mostly happens with launch scripts that start a server
+  // and gui simultaneously).
+  static std::atomic<uint32_t> seed{std::random_device {}()};
+  return seed;
+}
+
+/// \brief Get the number of times the global seed was set, so threads
+/// know when to reseed their generator.
+/// \return The number of times the global seed was set.
+std::atomic<uint64_t> &SeedGeneration()
+{
+  static std::atomic<uint64_t> generation{0};
+  return generation;
+}
+
+/// \brief Random generator of a thread.
+struct ThreadGenerator
+{
+  /// \brief Constructor, takes the next stream id. Stream 0 is kept for
+  /// the thread that calls Rand::Seed.
+  ThreadGenerator()
+  {
+    static std::atomic<unsigned int> nextStream{1};
+    this->stream = nextStream++;
+  }
+
+  /// \brief Seed the generator with the global seed.
+  void Reseed()
+  {
+    // Read the generation first, the seed is set before it is incremented.
+    this->generation = SeedGeneration().load();
+    SeedStream(this->generator, GlobalSeed().load(), this->stream);
+  }
+
+  /// \brief The generator.
+  GeneratorType generator;
+
+  /// \brief Stream id of the thread.
+  unsigned int stream;
+
+  /// \brief True if the stream id was set with Rand::Stream.
+  bool chosen = false;
+
+  /// \brief Seed generation of the generator, none before it is seeded.
+  uint64_t generation = UINT64_MAX;
+};
+
+/// \brief Get the random generator of the calling thread.
+/// \return The random generator of the calling thread.
+ThreadGenerator &LocalGenerator()
+{
+  thread_local ThreadGenerator local;
+  return local;
+}
+}
+
 //////////////////////////////////////////////////
 void Rand::Seed(unsigned int _seed)
 {
-  std::seed_seq seq{_seed};
-  SeedMutable() = _seed;
-  RandGenerator().seed(seq);
+  GlobalSeed() = _seed;
+  ++SeedGeneration();
+  auto &local = LocalGenerator();
+  if (!local.chosen)
+    local.stream = 0;
+  local.Reseed();
 }
 
 //////////////////////////////////////////////////
 unsigned int Rand::Seed()
 {
-  return SeedMutable();
+  return GlobalSeed();
+}
+
+//////////////////////////////////////////////////
+void Rand::Stream(unsigned int _stream)
+{
+  auto &local = LocalGenerator();
+  local.stream = _stream;
+  local.chosen = true;
+  local.Reseed();
+}
+
+//////////////////////////////////////////////////
+unsigned int Rand::Stream()
+{
+  return LocalGenerator().stream;
 }
 
 //////////////////////////////////////////////////
@@ -74,19 +159,69 @@ int32_t Rand::IntNormal(int _mean, int _sigma)
   return static_cast<int32_t>(d(RandGenerator()));
 }
 
+//////////////////////////////////////////////////
+void Rand::FillUniform(double *_out, size_t _count, double _min, double _max)
+{
+  math::FillUniform(RandGenerator(), _out, _count, _min, _max);
+}
+
+//////////////////////////////////////////////////
+void Rand::FillUniform(float *_out, size_t _count, float _min, float _max)
+{
+  math::FillUniform(RandGenerator(), _out, _count, _min, _max);
+}
+
+//////////////////////////////////////////////////
+void Rand::FillNormal(double *_out, size_t _count, double _mean,
+    double _sigma)
+{
+  math::FillNormal(RandGenerator(), _out, _count, _mean, _sigma);
+}
+
+//////////////////////////////////////////////////
+void Rand::FillNormal(float *_out, size_t _count, float _mean, float _sigma)
+{
+  math::FillNormal(RandGenerator(), _out, _count, _mean, _sigma);
+}
+
+//////////////////////////////////////////////////
+uint32_t Rand::Bounded(uint32_t _range)
+{
+  return math::Bounded(RandGenerator(), _range);
+}
+
+//////////////////////////////////////////////////
+void Rand::FillIntUniform(int32_t *_out, size_t _count, int32_t _min,
+    int32_t _max)
+{
+  math::FillIntUniform(RandGenerator(), _out, _count, _min, _max);
+}
+
+//////////////////////////////////////////////////
+void Rand::Sample(uint32_t _n, uint32_t *_out, size_t _k)
+{
+  math::Sample(RandGenerator(), _n, _out, _k);
+}
+
+//////////////////////////////////////////////////
+void Rand::ShuffleSwaps(size_t _size, uint32_t *_swaps, size_t _count)
+{
+  math::ShuffleSwaps(RandGenerator(), _size, _swaps, _count);
+}
+
 //////////////////////////////////////////////////
 uint32_t &Rand::SeedMutable()
 {
-  // We don't seed with time for the cases when two processes are started the
-  // same time (this mostly happens with launch scripts that start a server
-  // and gui simultaneously).
-  static uint32_t seed = std::random_device {}();
+  thread_local uint32_t seed;
+  seed = GlobalSeed();
   return seed;
 }
 
 //////////////////////////////////////////////////
 GeneratorType &Rand::RandGenerator()
 {
-  static GeneratorType randGenerator(Seed());
-  return randGenerator;
+  auto &local = LocalGenerator();
+  if (local.generation != SeedGeneration().load(std::memory_order_relaxed))
+    local.Reseed();
+  return local.generator;
 }
@@ -0,0 +1,381 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_MATH_RANDPRIVATE_HH_
+#define GZ_MATH_RANDPRIVATE_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <unordered_set>
+#include <gz/math/Rand.hh>
+#include <gz/math/config.hh>
+
+namespace gz
+{
+  namespace math
+  {
+    inline namespace GZ_MATH_VERSION_NAMESPACE
+    {
+    /// \brief Seed a generator for a stream of random numbers. Stream 0 is
+    /// seeded with the seed alone, as Rand was before it had streams, the
+    /// other streams with the seed and the stream id, so every stream of a
+    /// seed is distinct and repeatable.
+    /// \param[in] _generator Generator to seed.
+    /// \param[in] _seed The seed.
+    /// \param[in] _stream The stream id.
+    inline void SeedStream(GeneratorType &_generator, const unsigned int _seed,
+                           const unsigned int _stream)
+    {
+      if (_stream == 0)
+      {
+        std::seed_seq seq{_seed};
+        _generator.seed(seq);
+      }
+      else
+      {
+        std::seed_seq seq{_seed, _stream};
+        _generator.seed(seq);
+      }
+    }
+
+    /// \brief Number of random words drawn at once by the fill functions,
+    /// so the conversion loops run over arrays the compiler can vectorize.
+    constexpr size_t kFillChunk = 256;
+
+    /// \brief Convert two random words to a double in [0, 1) with 53 bits.
+    /// \param[in] _a First word.
+    /// \param[in] _b Second word.
+    /// \return The double.
+    inline double UnitDouble(const uint32_t _a, const uint32_t _b)
+    {
+      return ((_a >> 5) * 67108864.0 + (_b >> 6)) * (1.0 / 9007199254740992.0);
+    }
+
+    /// \brief Fill an array with doubles from a uniform distribution.
+    /// \param[in] _generator Generator to draw from.
+    /// \param[out] _out Pointer to the first number.
+    /// \param[in] _count Number of numbers.
+    /// \param[in] _min Minimum bound.
+    /// \param[in] _max Maximum bound.
+    inline void FillUniform(GeneratorType &_generator, double *_out,
+                            const size_t _count, const double _min,
+                            const double _max)
+    {
+      uint32_t words[2 * kFillChunk];
+      const double range = _max - _min;
+      for (size_t start = 0; start < _count; start += kFillChunk)
+      {
+        const size_t n = std::min(kFillChunk, _count - start);
+        for (size_t i = 0; i < 2 * n; ++i)
+          words[i] = static_cast<uint32_t>(_generator());
+        for (size_t i = 0; i < n; ++i)
+          _out[start + i] = _min + range * UnitDouble(words[2 * i],
+                                                      words[2 * i + 1]);
+      }
+    }
+
+    /// \brief Fill an array with floats from a uniform distribution.
+    /// \param[in] _generator Generator to draw from.
+    /// \param[out] _out Pointer to the first number.
+    /// \param[in] _count Number of numbers.
+    /// \param[in] _min Minimum bound.
+    /// \param[in] _max Maximum bound.
+    inline void FillUniform(GeneratorType &_generator, float *_out,
+                            const size_t _count, const float _min,
+                            const float _max)
+    {
+      uint32_t words[kFillChunk];
+      const float range = _max - _min;
+      for (size_t start = 0; start < _count; start += kFillChunk)
+      {
+        const size_t n = std::min(kFillChunk, _count - start);
+        for (size_t i = 0; i < n; ++i)
+          words[i] = static_cast<uint32_t>(_generator());
+        for (size_t i = 0; i < n; ++i)
+        {
+          _out[start + i] = _min + range *
+            (static_cast<float>(words[i] >> 8) * (1.0f / 16777216.0f));
+        }
+      }
+    }
+
+    /// \brief Map a random word to an integer in [0, _range) with Lemire's
+    /// nearly divisionless method, "Fast Random Integer Generation in an
+    /// Interval" (2019). The word is multiplied by the range and the high
+    /// half kept. The low half tells whether the word falls in the few
+    /// values that would bias the result, which takes a division to find
+    /// and is rarely needed, so new words are only drawn then.
+    /// \param[in] _generator Generator to draw new words from.
+    /// \param[in] _word Random word.
+    /// \param[in] _range Number of possible integers, not zero.
+    /// \return The integer.
+    inline uint32_t BoundedWord(GeneratorType &_generator, uint32_t _word,
+                                const uint32_t _range)
+    {
+      uint64_t product = static_cast<uint64_t>(_word) * _range;
+      uint32_t low = static_cast<uint32_t>(product);
+      if (low < _range)
+      {
+        // 2^32 mod _range words are rejected
+        const uint32_t threshold = (0u - _range) % _range;
+        while (low < threshold)
+        {
+          _word = static_cast<uint32_t>(_generator());
+          product = static_cast<uint64_t>(_word) * _range;
+          low = static_cast<uint32_t>(product);
+        }
+      }
+      return static_cast<uint32_t>(product >> 32);
+    }
+
+    /// \brief Draw an integer in [0, _range).
+    /// \param[in] _generator Generator to draw from.
+    /// \param[in] _range Number of possible integers, 0 for all the 2^32
+    /// values.
+    /// \return The integer.
+    inline uint32_t Bounded(GeneratorType &_generator, const uint32_t _range)
+    {
+      const uint32_t word = static_cast<uint32_t>(_generator());
+      return _range == 0 ? word : BoundedWord(_generator, word, _range);
+    }
+
+    /// \brief Fill an array with integers from a uniform distribution.
+    /// \param[in] _generator Generator to draw from.
+    /// \param[out] _out Pointer to the first number.
+    /// \param[in] _count Number of numbers.
+    /// \param[in] _min Minimum bound, included.
+    /// \param[in] _max Maximum bound, included.
+    inline void FillIntUniform(GeneratorType &_generator, int32_t *_out,
+                               const size_t _count, const int32_t _min,
+                               const int32_t _max)
+    {
+      // Modular arithmetic, the range of the full interval wraps to 0
+      const uint32_t base = static_cast<uint32_t>(_min);
+      const uint32_t range = static_cast<uint32_t>(_max) - base + 1u;
+      uint32_t words[kFillChunk];
+      for (size_t start = 0; start < _count; start += kFillChunk)
+      {
+        const size_t n = std::min(kFillChunk, _count - start);
+        for (size_t i = 0; i < n; ++i)
+          words[i] = static_cast<uint32_t>(_generator());
+        if (range != 0)
+        {
+          for (size_t i = 0; i < n; ++i)
+            words[i] = BoundedWord(_generator, words[i], range);
+        }
+        for (size_t i = 0; i < n; ++i)
+          _out[start + i] = static_cast<int32_t>(base + words[i]);
+      }
+    }
+
+    /// \brief Draw the swap positions of a chunk of the Fisher-Yates
+    /// shuffle, from the end of the array. When the product of two
+    /// consecutive ranges fits in a word, both positions are drawn from a
+    /// single word, as libstdc++'s std::shuffle does, which halves the
+    /// number of words drawn for arrays of up to 2^16 elements.
+    /// \param[in] _generator Generator to draw from.
+    /// \param[in] _size Number of elements not shuffled yet.
+    /// \param[out] _swaps Position in [0, _size - i) to swap with the
+    /// element at _size - i - 1, for each i.
+    /// \param[in] _count Number of positions, less than _size.
+    inline void ShuffleSwaps(GeneratorType &_generator, const size_t _size,
+                             uint32_t *_swaps, const size_t _count)
+    {
+      size_t i = 0;
+      for (; i + 1 < _count; i += 2)
+      {
+        const uint64_t a = _size - i;
+        const uint64_t b = a - 1;
+        if (a * b > UINT32_MAX)
+        {
+          _swaps[i] = Bounded(_generator, static_cast<uint32_t>(a));
+          _swaps[i + 1] = Bounded(_generator, static_cast<uint32_t>(b));
+          continue;
+        }
+        const uint32_t pair = Bounded(_generator, static_cast<uint32_t>(a * b));
+        _swaps[i] = pair / static_cast<uint32_t>(b);
+        _swaps[i + 1] = pair % static_cast<uint32_t>(b);
+      }
+      if (i < _count)
+        _swaps[i] = Bounded(_generator, static_cast<uint32_t>(_size - i));
+    }
+
+    /// \brief Pick distinct integers in [0, _n), sorted in increasing
+    /// order. Each subset of _k integers is equally likely.
+    /// \param[in] _generator Generator to draw from.
+    /// \param[in] _n Number of integers to pick from.
+    /// \param[out] _out Pointer to the first picked integer.
+    /// \param[in] _k Number of integers to pick, at most _n.
+    inline void Sample(GeneratorType &_generator, const uint32_t _n,
+                       uint32_t *_out, const size_t _k)
+    {
+      if (_k == 0)
+        return;
+
+      if (_k >= _n / 16)
+      {
+        // Selection sampling, Knuth's algorithm S: a scan of all the
+        // integers, each kept with the probability that the number still
+        // needed among the ones left.
+        size_t picked = 0;
+        for (uint32_t i = 0; picked < _k; ++i)
+        {
+          if (Bounded(_generator, _n - i) < _k - picked)
+            _out[picked++] = i;
+        }
+        return;
+      }
+
+      // Floyd's algorithm: for each of the last _k integers j, pick one of
+      // [0, j], or j itself if it was already picked.
+      std::unordered_set<uint32_t> picked;
+      picked.reserve(_k);
+      size_t count = 0;
+      for (uint32_t j = _n - static_cast<uint32_t>(_k); j < _n; ++j)
+      {
+        const uint32_t t = Bounded(_generator, j + 1);
+        const uint32_t value = picked.insert(t).second ? t : j;
+        if (value == j)
+          picked.insert(j);
+        _out[count++] = value;
+      }
+      std::sort(_out, _out + _k);
+    }
+
+    /// \brief Ziggurat method of Marsaglia and Tsang, "The ziggurat method
+    /// for generating random variables" (2000), with 128 layers. The layer
+    /// is taken from a separate word than the value, which avoids the
+    /// correlation Doornik found in the original version.
+    class Ziggurat
+    {
+      /// \brief Get the tables, computed on first use.
+      /// \return The tables.
+      public: static const Ziggurat &Instance()
+      {
+        static const Ziggurat ziggurat;
+        return ziggurat;
+      }
+
+      /// \brief Draw a number from a standard normal distribution.
+      /// \param[in] _generator Generator to draw from.
+      /// \return The number.
+      public: double Normal(GeneratorType &_generator) const
+      {
+        while (true)
+        {
+          const int32_t value = static_cast<int32_t>(
+              static_cast<uint32_t>(_generator()));
+          const uint32_t layer = static_cast<uint32_t>(_generator()) & 127u;
+          const double x = value * this->w[layer];
+
+          // Inside the rectangle of the layer, the common case.
+          if (static_cast<uint32_t>(std::abs(static_cast<int64_t>(value))) <
+              this->k[layer])
+          {
+            return x;
+          }
+
+          if (layer == 0)
+          {
+            // Tail beyond r.
+            double tx;
+            double ty;
+            do
+            {
+              tx = -std::log(1.0 - UnitDouble(
+                    static_cast<uint32_t>(_generator()),
+                    static_cast<uint32_t>(_generator()))) / kR;
+              ty = -std::log(1.0 - UnitDouble(
+                    static_cast<uint32_t>(_generator()),
+                    static_cast<uint32_t>(_generator())));
+            }
+            while (ty + ty < tx * tx);
+            return value > 0 ? kR + tx : -kR - tx;
+          }
+
+          // Wedge between the rectangle and the curve.
+          const double u = UnitDouble(static_cast<uint32_t>(_generator()),
+                                      static_cast<uint32_t>(_generator()));
+          if (this->f[layer] + u * (this->f[layer - 1] - this->f[layer]) <
+              std::exp(-0.5 * x * x))
+          {
+            return x;
+          }
+        }
+      }
+
+      /// \brief Constructor, computes the tables.
+      private: Ziggurat()
+      {
+        const double m = 2147483648.0;
+        double dn = kR;
+        double tn = dn;
+        const double q = kV / std::exp(-0.5 * dn * dn);
+        this->k[0] = static_cast<uint32_t>((dn / q) * m);
+        this->k[1] = 0;
+        this->w[0] = q / m;
+        this->w[127] = dn / m;
+        this->f[0] = 1.0;
+        this->f[127] = std::exp(-0.5 * dn * dn);
+        for (int i = 126; i >= 1; --i)
+        {
+          dn = std::sqrt(-2.0 * std::log(kV / dn + std::exp(-0.5 * dn * dn)));
+          this->k[i + 1] = static_cast<uint32_t>((dn / tn) * m);
+          tn = dn;
+          this->f[i] = std::exp(-0.5 * dn * dn);
+          this->w[i] = dn / m;
+        }
+      }
+
+      /// \brief Start of the tail.
+      private: static constexpr double kR = 3.442619855899;
+
+      /// \brief Area of each layer.
+      private: static constexpr double kV = 9.91256303526217e-3;
+
+      /// \brief Limits of the rectangles, scaled to 2^31.
+      private: uint32_t k[128];
+
+      /// \brief Widths of the layers, scaled by 2^-31.
+      private: double w[128];
+
+      /// \brief Density at the top of the layers.
+      private: double f[128];
+    };
+
+    /// \brief Fill an array with numbers from a normal distribution.
+    /// \param[in] _generator Generator to draw from.
+    /// \param[out] _out Pointer to the first number.
+    /// \param[in] _count Number of numbers.
+    /// \param[in] _mean Mean of the distribution.
+    /// \param[in] _sigma Standard deviation of the distribution.
+    template<typename T>
+    void FillNormal(GeneratorType &_generator, T *_out, const size_t _count,
+                    const T _mean, const T _sigma)
+    {
+      const Ziggurat &ziggurat = Ziggurat::Instance();
+      for (size_t i = 0; i < _count; ++i)
+      {
+        _out[i] = _mean + _sigma * static_cast<T>(ziggurat.Normal(_generator));
+      }
+    }
+    }
+  }
+}
+#endif
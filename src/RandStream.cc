@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "gz/math/RandStream.hh"
+#include "RandPrivate.hh"
+
+using namespace gz;
+using namespace math;
+
+/// \brief Private data
+class gz::math::RandStream::Implementation
+{
+  /// \brief The generator.
+  public: GeneratorType generator;
+
+  /// \brief The seed.
+  public: unsigned int seed{0};
+
+  /// \brief The stream id.
+  public: unsigned int stream{0};
+};
+
+//////////////////////////////////////////////////
+RandStream::RandStream(unsigned int _stream)
+  : RandStream(Rand::Seed(), _stream)
+{
+}
+
+//////////////////////////////////////////////////
+RandStream::RandStream(unsigned int _seed, unsigned int _stream)
+  : dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+  this->dataPtr->stream = _stream;
+  this->Seed(_seed);
+}
+
+//////////////////////////////////////////////////
+void RandStream::Seed(unsigned int _seed)
+{
+  this->dataPtr->seed = _seed;
+  SeedStream(this->dataPtr->generator, _seed, this->dataPtr->stream);
+}
+
+//////////////////////////////////////////////////
+unsigned int RandStream::Seed() const
+{
+  return this->dataPtr->seed;
+}
+
+//////////////////////////////////////////////////
+unsigned int RandStream::Stream() const
+{
+  return this->dataPtr->stream;
+}
+
+//////////////////////////////////////////////////
+double RandStream::DblUniform(double _min, double _max)
+{
+  UniformRealDist d(_min, _max);
+  return d(this->dataPtr->generator);
+}
+
+//////////////////////////////////////////////////
+double RandStream::DblNormal(double _mean, double _sigma)
+{
+  NormalRealDist d(_mean, _sigma);
+  return d(this->dataPtr->generator);
+}
+
+//////////////////////////////////////////////////
+int32_t RandStream::IntUniform(int _min, int _max)
+{
+  UniformIntDist d(_min, _max);
+  return d(this->dataPtr->generator);
+}
+
+//////////////////////////////////////////////////
+int32_t RandStream::IntNormal(int _mean, int _sigma)
+{
+  NormalRealDist d(_mean, _sigma);
+  return static_cast<int32_t>(d(this->dataPtr->generator));
+}
+
+//////////////////////////////////////////////////
+void RandStream::FillUniform(double *_out, size_t _count, double _min,
+    double _max)
+{
+  math::FillUniform(this->dataPtr->generator, _out, _count, _min, _max);
+}
+
+//////////////////////////////////////////////////
+void RandStream::FillUniform(float *_out, size_t _count, float _min, float _max)
+{
+  math::FillUniform(this->dataPtr->generator, _out, _count, _min, _max);
+}
+
+//////////////////////////////////////////////////
+void RandStream::FillNormal(double *_out, size_t _count, double _mean,
+    double _sigma)
+{
+  math::FillNormal(this->dataPtr->generator, _out, _count, _mean, _sigma);
+}
+
+//////////////////////////////////////////////////
+void RandStream::FillNormal(float *_out, size_t _count, float _mean,
+    float _sigma)
+{
+  math::FillNormal(this->dataPtr->generator, _out, _count, _mean, _sigma);
+}
+
+//////////////////////////////////////////////////
+uint32_t RandStream::Bounded(uint32_t _range)
+{
+  return math::Bounded(this->dataPtr->generator, _range);
+}
+
+//////////////////////////////////////////////////
+void RandStream::FillIntUniform(int32_t *_out, size_t _count, int32_t _min,
+    int32_t _max)
+{
+  math::FillIntUniform(this->dataPtr->generator, _out, _count, _min, _max);
+}
+
+//////////////////////////////////////////////////
+void RandStream::Sample(uint32_t _n, uint32_t *_out, size_t _k)
+{
+  math::Sample(this->dataPtr->generator, _n, _out, _k);
+}
+
+//////////////////////////////////////////////////
+void RandStream::ShuffleSwaps(size_t _size, uint32_t *_swaps, size_t _count)
+{
+  math::ShuffleSwaps(this->dataPtr->generator, _size, _swaps, _count);
+}
+
+//////////////////////////////////////////////////
+GeneratorType &RandStream::Generator()
+{
+  return this->dataPtr->generator;
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "gz/math/Rand.hh"
+#include "gz/math/RandStream.hh"
+
+using namespace gz;
+
+//////////////////////////////////////////////////
+TEST(RandStreamTest, RandStream)
+{
+  math::RandStream stream(1001, 3);
+  EXPECT_EQ(1001u, stream.Seed());
+  EXPECT_EQ(3u, stream.Stream());
+
+  double d = stream.DblUniform(1, 2);
+  EXPECT_GE(d, 1);
+  EXPECT_LE(d, 2);
+  int i = stream.IntUniform(1, 2);
+  EXPECT_GE(i, 1);
+  EXPECT_LE(i, 2);
+
+  // Same seed and stream, same numbers.
+  std::vector<double> first;
+  stream.Seed(7);
+  for (int n = 0; n < 10; ++n)
+    first.push_back(stream.DblNormal(2, 3));
+  math::RandStream same(7, 3);
+  for (int n = 0; n < 10; ++n)
+    EXPECT_DOUBLE_EQ(first[n], same.DblNormal(2, 3));
+
+  // Other stream, other numbers.
+  math::RandStream other(7, 4);
+  std::vector<double> second;
+  for (int n = 0; n < 10; ++n)
+    second.push_back(other.DblNormal(2, 3));
+  EXPECT_NE(first, second);
+
+  // Global seed.
+  math::Rand::Seed(7);
+  math::RandStream global(3);
+  EXPECT_EQ(7u, global.Seed());
+  EXPECT_DOUBLE_EQ(first[0], global.DblNormal(2, 3));
+}
+
+//////////////////////////////////////////////////
+TEST(RandStreamTest, Fill)
+{
+  math::RandStream stream(5, 1);
+  std::vector<double> uniform(1000);
+  std::vector<float> normal(1000);
+  stream.FillUniform(uniform.data(), uniform.size(), 1.0, 2.0);
+  stream.FillNormal(normal.data(), normal.size(), 10.0f, 0.1f);
+  for (size_t i = 0; i < uniform.size(); ++i)
+  {
+    EXPECT_GE(uniform[i], 1.0);
+    EXPECT_LT(uniform[i], 2.0);
+    EXPECT_NEAR(10.0f, normal[i], 1.0f);
+  }
+
+  // Same seed and stream, same numbers.
+  math::RandStream same(5, 1);
+  std::vector<double> uniformAgain(uniform.size());
+  std::vector<float> normalAgain(normal.size());
+  same.FillUniform(uniformAgain.data(), uniformAgain.size(), 1.0, 2.0);
+  same.FillNormal(normalAgain.data(), normalAgain.size(), 10.0f, 0.1f);
+  EXPECT_EQ(uniform, uniformAgain);
+  EXPECT_EQ(normal, normalAgain);
+}
+
+//////////////////////////////////////////////////
+TEST(RandStreamTest, Integers)
+{
+  // A thread of Rand draws the numbers of the stream with its id.
+  math::Rand::Seed(1002);
+  math::RandStream stream(1002, math::Rand::Stream());
+  for (int n = 0; n < 10; ++n)
+    EXPECT_EQ(stream.Bounded(1000), math::Rand::Bounded(1000));
+
+  std::vector<int32_t> ints(1000);
+  std::vector<int32_t> expected(ints.size());
+  stream.FillIntUniform(ints.data(), ints.size(), -50, 50);
+  math::Rand::FillIntUniform(expected.data(), expected.size(), -50, 50);
+  EXPECT_EQ(expected, ints);
+
+  std::vector<uint32_t> picked(20);
+  std::vector<uint32_t> expectedPicked(picked.size());
+  stream.Sample(1000000, picked.data(), picked.size());
+  math::Rand::Sample(1000000, expectedPicked.data(), expectedPicked.size());
+  EXPECT_EQ(expectedPicked, picked);
+
+  stream.Shuffle(ints.data(), ints.size());
+  math::Rand::Shuffle(expected.data(), expected.size());
+  EXPECT_EQ(expected, ints);
+}
+
+//////////////////////////////////////////////////
+TEST(RandStreamTest, Rand)
+{
+  // A thread of Rand draws the numbers of the stream with its id.
+  math::Rand::Seed(1001);
+  math::RandStream stream(1001, math::Rand::Stream());
+  for (int n = 0; n < 10; ++n)
+    EXPECT_EQ(stream.IntUniform(-100, 100), math::Rand::IntUniform(-100, 100));
+
+  // Threads draw concurrently, repeatable per stream id.
+  const unsigned int threads = 4;
+  std::vector<std::vector<double>> values(threads);
+  std::vector<std::thread> workers;
+  for (unsigned int t = 0; t < threads; ++t)
+  {
+    workers.emplace_back([&values, t]()
+    {
+      math::Rand::Stream(t + 10);
+      for (int n = 0; n < 1000; ++n)
+        values[t].push_back(math::Rand::DblUniform());
+    });
+  }
+  for (auto &worker : workers)
+    worker.join();
+
+  for (unsigned int t = 0; t < threads; ++t)
+  {
+    math::RandStream expected(1001, t + 10);
+    ASSERT_EQ(1000u, values[t].size());
+    for (const double value : values[t])
+      EXPECT_DOUBLE_EQ(expected.DblUniform(), value);
+  }
+  EXPECT_NE(values[0], values[1]);
+}
@@ -17,6 +17,15 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "gz/math/Helpers.hh"
 #include "gz/math/Rand.hh"
 
@@ -77,3 +86,249 @@ TEST(RandTest, SetSeed)
     EXPECT_EQ(second[i], math::Rand::IntUniform(-10, 10));
   }
 }
+
+//////////////////////////////////////////////////
+TEST(RandTest, Threads)
+{
+  // The thread that seeds Rand gets stream 0, even if other threads used
+  // Rand first.
+  std::thread first([]()
+  {
+    EXPECT_NE(0u, math::Rand::Stream());
+  });
+  first.join();
+  math::Rand::Seed(42);
+  const unsigned int mainStream = math::Rand::Stream();
+  EXPECT_EQ(0u, mainStream);
+
+  // Each thread gets its own stream, reseeded when the seed changes.
+  unsigned int otherStream = mainStream;
+  double before = 0;
+  double after = 0;
+  std::thread worker([&]()
+  {
+    otherStream = math::Rand::Stream();
+    before = math::Rand::DblUniform();
+    math::Rand::Stream(5);
+    EXPECT_EQ(5u, math::Rand::Stream());
+    after = math::Rand::DblUniform();
+  });
+  worker.join();
+  EXPECT_NE(mainStream, otherStream);
+  EXPECT_NE(before, after);
+
+  // Another thread with the same stream id draws the same numbers.
+  std::thread again([&]()
+  {
+    math::Rand::Stream(5);
+    EXPECT_DOUBLE_EQ(after, math::Rand::DblUniform());
+  });
+  again.join();
+}
+
+//////////////////////////////////////////////////
+TEST(RandTest, FillUniform)
+{
+  math::Rand::Seed(11);
+  std::vector<double> values(100001);
+  math::Rand::FillUniform(values.data(), values.size(), -2.0, 3.0);
+  double sum = 0;
+  for (const double value : values)
+  {
+    EXPECT_GE(value, -2.0);
+    EXPECT_LT(value, 3.0);
+    sum += value;
+  }
+  EXPECT_NEAR(0.5, sum / values.size(), 0.02);
+
+  std::vector<float> floats(1001);
+  math::Rand::FillUniform(floats.data(), floats.size());
+  for (const float value : floats)
+  {
+    EXPECT_GE(value, 0.0f);
+    EXPECT_LT(value, 1.0f);
+  }
+
+  // Same seed, same numbers.
+  math::Rand::Seed(11);
+  std::vector<double> again(values.size());
+  math::Rand::FillUniform(again.data(), again.size(), -2.0, 3.0);
+  EXPECT_EQ(values, again);
+}
+
+//////////////////////////////////////////////////
+TEST(RandTest, FillNormal)
+{
+  math::Rand::Seed(12);
+  const size_t count = 1000000;
+  std::vector<double> values(count);
+  math::Rand::FillNormal(values.data(), count, 2.0, 3.0);
+
+  // Moments and the fractions of samples within 1, 2 and 3 sigmas.
+  double sum = 0;
+  double sumSquares = 0;
+  size_t within[3] = {0, 0, 0};
+  size_t tail = 0;
+  for (const double value : values)
+  {
+    const double z = (value - 2.0) / 3.0;
+    sum += z;
+    sumSquares += z * z;
+    for (int k = 0; k < 3; ++k)
+      within[k] += std::abs(z) < k + 1;
+    tail += std::abs(z) > 3.5;
+  }
+  EXPECT_NEAR(0.0, sum / count, 0.005);
+  EXPECT_NEAR(1.0, sumSquares / count, 0.005);
+  EXPECT_NEAR(0.682689, static_cast<double>(within[0]) / count, 0.002);
+  EXPECT_NEAR(0.954500, static_cast<double>(within[1]) / count, 0.001);
+  EXPECT_NEAR(0.997300, static_cast<double>(within[2]) / count, 0.0003);
+  EXPECT_NEAR(4.65e-4, static_cast<double>(tail) / count, 1e-4);
+
+  std::vector<float> floats(100000);
+  math::Rand::FillNormal(floats.data(), floats.size(), -1.0f, 0.5f);
+  double floatSum = 0;
+  for (const float value : floats)
+    floatSum += value;
+  EXPECT_NEAR(-1.0, floatSum / floats.size(), 0.01);
+}
+
+//////////////////////////////////////////////////
+TEST(RandTest, Bounded)
+{
+  math::Rand::Seed(13);
+  const size_t count = 600000;
+  size_t counts[6] = {0, 0, 0, 0, 0, 0};
+  for (size_t i = 0; i < count; ++i)
+  {
+    const uint32_t value = math::Rand::Bounded(6);
+    ASSERT_LT(value, 6u);
+    ++counts[value];
+  }
+  for (const size_t n : counts)
+    EXPECT_NEAR(count / 6.0, static_cast<double>(n), 1500.0);
+
+  EXPECT_EQ(0u, math::Rand::Bounded(1));
+  // A range of 0 draws any value
+  bool high = false;
+  for (int i = 0; i < 100; ++i)
+    high = high || math::Rand::Bounded(0) > 0x80000000u;
+  EXPECT_TRUE(high);
+
+  // Almost the full range, where about half of the words are rejected
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_LT(math::Rand::Bounded(0x80000001u), 0x80000001u);
+}
+
+//////////////////////////////////////////////////
+TEST(RandTest, FillIntUniform)
+{
+  math::Rand::Seed(14);
+  std::vector<int32_t> values(100001);
+  math::Rand::FillIntUniform(values.data(), values.size(), -3, 4);
+  size_t counts[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  for (const int32_t value : values)
+  {
+    ASSERT_GE(value, -3);
+    ASSERT_LE(value, 4);
+    ++counts[value + 3];
+  }
+  for (const size_t n : counts)
+    EXPECT_NEAR(values.size() / 8.0, static_cast<double>(n), 600.0);
+
+  // Same seed, same numbers.
+  math::Rand::Seed(14);
+  std::vector<int32_t> again(values.size());
+  math::Rand::FillIntUniform(again.data(), again.size(), -3, 4);
+  EXPECT_EQ(values, again);
+
+  // Single value and full range
+  math::Rand::FillIntUniform(values.data(), 1000, 7, 7);
+  for (size_t i = 0; i < 1000; ++i)
+    EXPECT_EQ(7, values[i]);
+  math::Rand::FillIntUniform(values.data(), 1000, INT32_MIN, INT32_MAX);
+  bool negative = false;
+  bool positive = false;
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    negative = negative || values[i] < -1000000;
+    positive = positive || values[i] > 1000000;
+  }
+  EXPECT_TRUE(negative);
+  EXPECT_TRUE(positive);
+}
+
+//////////////////////////////////////////////////
+TEST(RandTest, Shuffle)
+{
+  math::Rand::Seed(15);
+
+  // Each of the 6 permutations of 3 elements is equally likely
+  std::map<std::vector<int>, size_t> permutations;
+  const size_t count = 60000;
+  for (size_t i = 0; i < count; ++i)
+  {
+    std::vector<int> values = {0, 1, 2};
+    math::Rand::Shuffle(values.data(), values.size());
+    ++permutations[values];
+  }
+  EXPECT_EQ(6u, permutations.size());
+  for (const auto &permutation : permutations)
+    EXPECT_NEAR(count / 6.0, static_cast<double>(permutation.second), 500.0);
+
+  std::vector<std::string> words = {"a", "b", "c", "d", "e"};
+  math::Rand::Shuffle(words.data(), words.size());
+  std::sort(words.begin(), words.end());
+  EXPECT_EQ(std::vector<std::string>({"a", "b", "c", "d", "e"}), words);
+
+  // Nothing to shuffle
+  math::Rand::Shuffle(words.data(), 1);
+  math::Rand::Shuffle(static_cast<int *>(nullptr), 0);
+}
+
+//////////////////////////////////////////////////
+TEST(RandTest, Sample)
+{
+  math::Rand::Seed(16);
+
+  // Both the scan and Floyd's algorithm
+  for (const uint32_t n : {10u, 1000u, 100000u})
+  {
+    std::vector<size_t> counts(n, 0);
+    const size_t k = 5;
+    const size_t rounds = 20000;
+    std::vector<uint32_t> picked(k);
+    for (size_t r = 0; r < rounds; ++r)
+    {
+      math::Rand::Sample(n, picked.data(), k);
+      for (size_t i = 0; i < k; ++i)
+      {
+        ASSERT_LT(picked[i], n);
+        if (i > 0)
+        {
+          ASSERT_LT(picked[i - 1], picked[i]);
+        }
+        ++counts[picked[i]];
+      }
+    }
+    if (n == 10u)
+    {
+      for (const size_t c : counts)
+        EXPECT_NEAR(rounds * k / 10.0, static_cast<double>(c), 500.0);
+    }
+    else
+    {
+      // Each integer is picked with probability k / n, check the halves
+      const size_t low = std::accumulate(counts.begin(),
+          counts.begin() + n / 2, size_t(0));
+      EXPECT_NEAR(rounds * k / 2.0, static_cast<double>(low), 500.0);
+    }
+  }
+
+  // All of them
+  std::vector<uint32_t> all(100);
+  math::Rand::Sample(100, all.data(), all.size());
+  for (uint32_t i = 0; i < 100; ++i)
+    EXPECT_EQ(i, all[i]);
+  math::Rand::Sample(0, all.data(), 0);
+}
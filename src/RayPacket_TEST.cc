@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "gz/math/AxisAlignedBox.hh"
+#include "gz/math/AxisAlignedBoxT.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/RayPacket.hh"
+#include "gz/math/Vector3.hh"
+
+#include "test/helpers/RandomVector.hh"
+
+using namespace gz;
+using namespace math;
+using test::RandomVector;
+
+/////////////////////////////////////////////////
+TEST(RayPacketTest, Empty)
+{
+  RayPacketd rays;
+  EXPECT_TRUE(rays.Empty());
+  EXPECT_EQ(0u, rays.Size());
+
+  const AxisAlignedBoxd box(Vector3d(-1, -1, -1), Vector3d(1, 1, 1));
+  EXPECT_EQ(0u, rays.Intersect(box, nullptr));
+}
+
+/////////////////////////////////////////////////
+TEST(RayPacketTest, Rays)
+{
+  RayPacketd rays;
+  rays.Add(Vector3d(1, 2, 3), Vector3d(0, -2, 0), 0.5, 10);
+  rays.Add(Vector3d::Zero, Vector3d(-1, 1, -1), 0, 1);
+  ASSERT_EQ(2u, rays.Size());
+  EXPECT_FALSE(rays.Empty());
+
+  EXPECT_EQ(Vector3d(1, 2, 3), rays.Origin(0));
+  EXPECT_DOUBLE_EQ(0.5, rays.Min(0));
+  EXPECT_DOUBLE_EQ(10, rays.Max(0));
+  EXPECT_EQ(RayPacketd::kNegativeY, rays.Signs(0));
+  EXPECT_DOUBLE_EQ(-1, rays.InverseDirection(0).Y());
+  EXPECT_TRUE(std::isinf(rays.InverseDirection(0).X()));
+  EXPECT_GT(rays.InverseDirection(0).X(), 0);
+  EXPECT_EQ(RayPacketd::kNegativeX | RayPacketd::kNegativeZ, rays.Signs(1));
+
+  // Negative zero gives the same inverse direction as zero
+  rays.SetRay(1, Vector3d::Zero, Vector3d(-0.0, 1, -0.0), 0, 1);
+  EXPECT_EQ(0, rays.Signs(1));
+  EXPECT_GT(rays.InverseDirection(1).X(), 0);
+  EXPECT_GT(rays.InverseDirection(1).Z(), 0);
+
+  rays.Clear();
+  EXPECT_TRUE(rays.Empty());
+}
+
+/////////////////////////////////////////////////
+TEST(RayPacketTest, IntersectBox)
+{
+  const AxisAlignedBoxd box(Vector3d(-1, -1, -1), Vector3d(1, 1, 1));
+  const std::vector<Vector3d> origins = {
+    Vector3d(-5, 0, 0),
+    Vector3d(5, 0, 0),
+    Vector3d(0, 0, 0),
+    Vector3d(-5, 2, 0),
+    Vector3d(-5, 1, 0),
+    Vector3d(-5, 0, 0),
+    Vector3d(-5, 0, 0)};
+  const std::vector<Vector3d> dirs = {
+    Vector3d(1, 0, 0),
+    Vector3d(-2, 0, 0),
+    Vector3d(0, 0, 1),
+    Vector3d(1, 0, 0),
+    Vector3d(1, 0, 0),
+    Vector3d(-1, 0, 0),
+    Vector3d(1, 0, 0)};
+
+  RayPacketd rays;
+  rays.Assign(origins.data(), dirs.data(), origins.size(), 0, 10);
+  // Stops before the box
+  rays.SetRay(6, origins[6], dirs[6], 0, 3);
+
+  std::vector<std::uint8_t> hits(rays.Size());
+  std::vector<double> distances(rays.Size(), -1);
+  EXPECT_EQ(4u, rays.Intersect(box, hits.data(), distances.data()));
+
+  const std::vector<std::uint8_t> expectedHits = {1, 1, 1, 0, 1, 0, 0};
+  const std::vector<double> expectedDistances = {4, 4, 0, 0, 4, 0, 0};
+  for (std::size_t i = 0; i < rays.Size(); ++i)
+  {
+    EXPECT_EQ(expectedHits[i], hits[i]) << i;
+    EXPECT_DOUBLE_EQ(expectedDistances[i], distances[i]) << i;
+  }
+
+  // Without distances
+  std::vector<std::uint8_t> hitsOnly(rays.Size());
+  EXPECT_EQ(4u, rays.Intersect(box, hitsOnly.data()));
+  EXPECT_EQ(hits, hitsOnly);
+
+  // The entry distance is the minimum distance when the ray starts inside
+  rays.SetRay(0, Vector3d(-5, 0, 0), Vector3d(1, 0, 0), 4.5, 10);
+  EXPECT_EQ(4u, rays.Intersect(box, hits.data(), distances.data()));
+  EXPECT_DOUBLE_EQ(4.5, distances[0]);
+
+  // An empty box is never hit
+  EXPECT_EQ(0u, rays.Intersect(AxisAlignedBoxd(), hits.data(),
+                               distances.data()));
+  for (std::size_t i = 0; i < rays.Size(); ++i)
+  {
+    EXPECT_EQ(0, hits[i]);
+    EXPECT_DOUBLE_EQ(0, distances[i]);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(RayPacketTest, IntersectBoxes)
+{
+  const std::vector<AxisAlignedBoxf> boxes = {
+    AxisAlignedBoxf(Vector3f(1, -1, -1), Vector3f(2, 1, 1)),
+    AxisAlignedBoxf(Vector3f(4, -1, -1), Vector3f(5, 1, 1)),
+    AxisAlignedBoxf(Vector3f(-2, -1, -1), Vector3f(-1, 1, 1)),
+    AxisAlignedBoxf(Vector3f(4, 2, -1), Vector3f(5, 3, 1)),
+    AxisAlignedBoxf()};
+
+  RayPacketf rays;
+  rays.Add(Vector3f::Zero, Vector3f(3, 0, 0), 0, 4.5f);
+
+  std::vector<std::uint8_t> hits(boxes.size());
+  std::vector<float> distances(boxes.size());
+  EXPECT_EQ(2u, rays.Intersect(0, boxes.data(), boxes.size(), hits.data(),
+                               distances.data()));
+  EXPECT_EQ(std::vector<std::uint8_t>({1, 1, 0, 0, 0}), hits);
+  EXPECT_FLOAT_EQ(1, distances[0]);
+  EXPECT_FLOAT_EQ(4, distances[1]);
+  EXPECT_FLOAT_EQ(0, distances[2]);
+
+  std::vector<std::uint8_t> hitsOnly(boxes.size());
+  EXPECT_EQ(2u, rays.Intersect(0, boxes.data(), boxes.size(),
+                               hitsOnly.data()));
+  EXPECT_EQ(hits, hitsOnly);
+}
+
+/////////////////////////////////////////////////
+TEST(RayPacketTest, Boundary)
+{
+  const AxisAlignedBoxd box(Vector3d(-1, -1, -1), Vector3d(1, 1, 1));
+
+  // Rays parallel to a face and lying in its plane hit the box
+  RayPacketd rays;
+  rays.Add(Vector3d(-5, 1, 0), Vector3d(1, 0, 0), 0, 10);
+  rays.Add(Vector3d(-5, -1, -1), Vector3d(1, 0, 0), 0, 10);
+  rays.Add(Vector3d(5, 1, 0), Vector3d(-1, 0, 0), 0, 10);
+  // Touches the box at its maximum distance
+  rays.Add(Vector3d(-5, 0, 0), Vector3d(1, 0, 0), 0, 4);
+  // A zero direction hits if the origin is inside
+  rays.Add(Vector3d(0.5, 0, 0), Vector3d::Zero, 0, 10);
+  rays.Add(Vector3d(1.5, 0, 0), Vector3d::Zero, 0, 10);
+
+  std::vector<std::uint8_t> hits(rays.Size());
+  std::vector<double> distances(rays.Size());
+  EXPECT_EQ(5u, rays.Intersect(box, hits.data(), distances.data()));
+  EXPECT_EQ(std::vector<std::uint8_t>({1, 1, 1, 1, 1, 0}), hits);
+  EXPECT_DOUBLE_EQ(4, distances[0]);
+  EXPECT_DOUBLE_EQ(4, distances[3]);
+  EXPECT_DOUBLE_EQ(0, distances[4]);
+}
+
+/////////////////////////////////////////////////
+TEST(RayPacketTest, MatchesAxisAlignedBox)
+{
+  Rand::Seed(11);
+  const std::size_t count = 500;
+  std::vector<Vector3d> origins;
+  std::vector<Vector3d> dirs;
+  std::vector<double> mins;
+  RayPacketd rays;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    origins.push_back(RandomVector(-5, 5));
+    dirs.push_back(RandomVector(-2, 2) - origins.back());
+    mins.push_back(Rand::DblUniform(0, 2));
+    rays.Add(origins.back(), dirs.back(), mins.back(), 12);
+  }
+
+  std::vector<AxisAlignedBoxd> boxes;
+  std::vector<std::uint8_t> hits(count);
+  std::vector<double> distances(count);
+  std::size_t total = 0;
+  for (int b = 0; b < 20; ++b)
+  {
+    const AxisAlignedBox expected(RandomVector(-3, 3), RandomVector(-3, 3));
+    const AxisAlignedBoxd box(expected.Min(), expected.Max());
+    boxes.push_back(box);
+
+    const std::size_t hitCount =
+      rays.Intersect(box, hits.data(), distances.data());
+    std::size_t expectedCount = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      bool hit;
+      double dist;
+      std::tie(hit, dist) =
+        expected.IntersectDist(origins[i], dirs[i], mins[i], 12);
+      EXPECT_EQ(hit, hits[i] != 0) << b << " " << i;
+      if (hit)
+      {
+        EXPECT_NEAR(dist + mins[i], distances[i], 1e-9) << b << " " << i;
+      }
+      expectedCount += hit;
+    }
+    EXPECT_EQ(expectedCount, hitCount);
+    total += hitCount;
+  }
+  // Both hits and misses are covered
+  EXPECT_GT(total, 1000u);
+  EXPECT_LT(total, 9000u);
+
+  // One ray against all boxes matches all rays against one box
+  std::vector<std::uint8_t> rayHits(boxes.size());
+  std::vector<double> rayDistances(boxes.size());
+  for (std::size_t i = 0; i < count; i += 7)
+  {
+    rays.Intersect(i, boxes.data(), boxes.size(), rayHits.data(),
+                   rayDistances.data());
+    for (std::size_t b = 0; b < boxes.size(); ++b)
+    {
+      rays.Intersect(boxes[b], hits.data(), distances.data());
+      EXPECT_EQ(hits[i], rayHits[b]);
+      EXPECT_DOUBLE_EQ(distances[i], rayDistances[b]);
+    }
+  }
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "gz/math/Rand.hh"
+#include "gz/math/Region3Array.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(Region3ArrayTest, Empty)
+{
+  Region3Arrayd regions;
+  EXPECT_TRUE(regions.Empty());
+  EXPECT_EQ(0u, regions.Size());
+  EXPECT_EQ(1u, regions.MaskWords());
+
+  const std::vector<Vector3d> points = {Vector3d(1, 2, 3)};
+  std::uint64_t mask = 7;
+  regions.Contains(points.data(), points.size(), &mask);
+  EXPECT_EQ(0u, mask);
+}
+
+/////////////////////////////////////////////////
+TEST(Region3ArrayTest, Bounds)
+{
+  const std::vector<Region3d> input = {
+      Region3d::Open(0, 0, 0, 1, 1, 1),
+      Region3d::Closed(0, 0, 0, 1, 1, 1),
+      Region3d(Intervald::LeftClosed(0, 1), Intervald::RightClosed(0, 1),
+               Intervald::Open(0, 0)),
+      Region3d::Unbounded};
+  Region3Arrayd regions(input);
+  EXPECT_FALSE(regions.Empty());
+  EXPECT_EQ(4u, regions.Size());
+
+  const std::vector<Vector3d> points = {
+      Vector3d(0, 0, 0), Vector3d(0.5, 0.5, 0.5), Vector3d(1, 1, 1),
+      Vector3d(0, 1, 0), Vector3d(-1, 0.5, 0.5), Vector3d::NaN};
+  std::vector<std::uint64_t> masks(points.size());
+  regions.Contains(points.data(), points.size(), masks.data());
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    for (std::size_t r = 0; r < input.size(); ++r)
+    {
+      const bool expected = input[r].Contains(points[i]);
+      EXPECT_EQ(expected, ((masks[i] >> r) & 1u) != 0) << r << points[i];
+      EXPECT_EQ(expected, regions.Contains(r, points[i]));
+      EXPECT_EQ(expected, regions.Region(r).Contains(points[i]));
+    }
+  }
+  EXPECT_EQ(0b1010u, masks[0]);
+  EXPECT_EQ(0b1011u, masks[1]);
+  EXPECT_EQ(0b0000u, masks[5]);
+
+  std::unique_ptr<bool[]> any(new bool[points.size()]);
+  regions.ContainsAny(points.data(), points.size(), any.get());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_EQ(masks[i] != 0, any[i]);
+}
+
+/////////////////////////////////////////////////
+TEST(Region3ArrayTest, ManyRegions)
+{
+  // More than 64 regions, whose masks take several words
+  Rand::Seed(13);
+  std::vector<Region3f> input;
+  for (int i = 0; i < 150; ++i)
+  {
+    const Vector3f min(static_cast<float>(Rand::DblUniform(-10, 5)),
+                       static_cast<float>(Rand::DblUniform(-10, 5)),
+                       static_cast<float>(Rand::DblUniform(-10, 5)));
+    const float size = static_cast<float>(Rand::DblUniform(0, 8));
+    if (i % 2 == 0)
+    {
+      input.push_back(Region3f::Closed(min.X(), min.Y(), min.Z(),
+          min.X() + size, min.Y() + size, min.Z() + size));
+    }
+    else
+    {
+      input.push_back(Region3f::Open(min.X(), min.Y(), min.Z(),
+          min.X() + size, min.Y() + size, min.Z() + size));
+    }
+  }
+  std::vector<Vector3f> points;
+  for (int i = 0; i < 1000; ++i)
+  {
+    points.push_back(Vector3f(static_cast<float>(Rand::DblUniform(-10, 10)),
+                              static_cast<float>(Rand::DblUniform(-10, 10)),
+                              static_cast<float>(Rand::DblUniform(-10, 10))));
+  }
+  // Points on the bounds
+  points.push_back(Vector3f(input[0].Ix().LeftValue(),
+                            input[0].Iy().LeftValue(),
+                            input[0].Iz().RightValue()));
+  points.push_back(Vector3f(input[1].Ix().LeftValue(),
+                            input[1].Iy().LeftValue(),
+                            input[1].Iz().RightValue()));
+
+  Region3Arrayf regions(input);
+  ASSERT_EQ(3u, regions.MaskWords());
+  std::vector<std::uint64_t> masks(points.size() * regions.MaskWords());
+  regions.Contains(points.data(), points.size(), masks.data());
+  std::unique_ptr<bool[]> any(new bool[points.size()]);
+  regions.ContainsAny(points.data(), points.size(), any.get());
+
+  std::size_t total = 0;
+  for (std::size_t r = 0; r < input.size(); ++r)
+  {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+      const bool expected = input[r].Contains(points[i]);
+      const std::uint64_t word = masks[i * regions.MaskWords() + r / 64];
+      EXPECT_EQ(expected, ((word >> (r % 64)) & 1u) != 0);
+      count += expected;
+    }
+    total += count;
+  }
+  EXPECT_GT(total, 0u);
+
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    bool expected = false;
+    for (const Region3f &region : input)
+      expected = expected || region.Contains(points[i]);
+    EXPECT_EQ(expected, any[i]);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(Region3ArrayTest, Edges)
+{
+  // Shared, touching and infinite bounds, and integer coordinates
+  const double inf = std::numeric_limits<double>::infinity();
+  const std::vector<Region3d> input = {
+      Region3d(Intervald::LeftClosed(0, 1), Intervald::Closed(-inf, inf),
+               Intervald::Closed(-inf, inf)),
+      Region3d(Intervald::LeftClosed(1, 2), Intervald::Closed(-inf, inf),
+               Intervald::Closed(-inf, inf)),
+      Region3d(Intervald::Closed(1, inf), Intervald::Open(-inf, 0),
+               Intervald::Closed(-inf, inf))};
+  Region3Arrayd regions(input);
+  const std::vector<Vector3d> points = {
+      Vector3d(0, 0, 0), Vector3d(1, 0, 0), Vector3d(1, -1, 0),
+      Vector3d(2, -1, 0), Vector3d(inf, -1, 0), Vector3d(inf, -inf, 0),
+      Vector3d(-inf, 0, inf), Vector3d(0.5, 0, inf),
+      Vector3d(std::nextafter(1.0, 0.0), -1, 0)};
+  std::vector<std::uint64_t> masks(points.size());
+  regions.Contains(points.data(), points.size(), masks.data());
+  const std::vector<std::uint64_t> expected = {
+      0b001, 0b010, 0b110, 0b100, 0b100, 0b000, 0b000, 0b001, 0b001};
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    EXPECT_EQ(expected[i], masks[i]) << points[i];
+    for (std::size_t r = 0; r < input.size(); ++r)
+      EXPECT_EQ(input[r].Contains(points[i]), ((masks[i] >> r) & 1u) != 0);
+  }
+
+  using Region3i = Region3<int>;
+  using Intervali = Interval<int>;
+  const int intMax = std::numeric_limits<int>::max();
+  Region3Array<int> integers({
+      Region3i(Intervali::Open(0, 3), Intervali::Closed(0, intMax),
+               Intervali::Closed(0, 0)),
+      Region3i(Intervali::Open(intMax, intMax), Intervali::Closed(0, 1),
+               Intervali::Closed(0, 0))});
+  const std::vector<Vector3i> ipoints = {
+      Vector3i(0, 0, 0), Vector3i(1, 0, 0), Vector3i(2, intMax, 0),
+      Vector3i(3, 0, 0), Vector3i(intMax, 0, 0)};
+  std::vector<std::uint64_t> imasks(ipoints.size());
+  integers.Contains(ipoints.data(), ipoints.size(), imasks.data());
+  EXPECT_EQ(0u, imasks[0]);
+  EXPECT_EQ(1u, imasks[1]);
+  EXPECT_EQ(1u, imasks[2]);
+  EXPECT_EQ(0u, imasks[3]);
+  EXPECT_EQ(0u, imasks[4]);
+}
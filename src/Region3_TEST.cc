@@ -15,7 +15,10 @@
  *
 */
 #include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
 #include <ostream>
+#include <vector>
 
 #include "gz/math/Region3.hh"
 
@@ -94,6 +97,40 @@ TEST(Region3Test, RegionMembership)
   EXPECT_TRUE(closedRegion.Contains(math::Vector3d(1., 1., 1.)));
 }
 
+/////////////////////////////////////////////////
+TEST(Region3Test, BatchMembership)
+{
+  const math::Region3d region(
+      math::Intervald::Open(0., 1.),
+      math::Intervald::LeftClosed(0., 1.),
+      math::Intervald::RightClosed(0., 1.));
+  const auto [min, max] = region.ClosedBounds();
+  EXPECT_DOUBLE_EQ(std::nextafter(0., 1.), min.X());
+  EXPECT_DOUBLE_EQ(0., min.Y());
+  EXPECT_DOUBLE_EQ(std::nextafter(0., 1.), min.Z());
+  EXPECT_DOUBLE_EQ(std::nextafter(1., 0.), max.X());
+  EXPECT_DOUBLE_EQ(std::nextafter(1., 0.), max.Y());
+  EXPECT_DOUBLE_EQ(1., max.Z());
+
+  std::vector<math::Vector3d> points;
+  for (double x : {-0.5, 0., 0.5, 1.})
+    for (double y : {0., 0.5, 1.})
+      for (double z : {0., 0.5, 1., 1.5})
+        points.push_back(math::Vector3d(x, y, z));
+  points.push_back(math::Vector3d::NaN);
+
+  std::unique_ptr<bool[]> contained(new bool[points.size()]);
+  region.Contains(points.data(), contained.get(), points.size());
+  std::size_t inside = 0;
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    EXPECT_EQ(region.Contains(points[i]), contained[i]) << points[i];
+    inside += contained[i];
+  }
+  // x = 0.5, y = 0 or 0.5, z = 0.5 or 1
+  EXPECT_EQ(4u, inside);
+}
+
 /////////////////////////////////////////////////
 TEST(Region3Test, RegionSubset)
 {
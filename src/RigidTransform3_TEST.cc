@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <vector>
+
+#include "gz/math/Pose3.hh"
+#include "gz/math/RigidTransform3.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(RigidTransform3Test, Construct)
+{
+  const RigidTransform3d identity;
+  EXPECT_EQ(Matrix3d::Identity, identity.Rotation());
+  EXPECT_EQ(Vector3d::Zero, identity.Translation());
+  EXPECT_EQ(Pose3d::Zero, identity.Pose());
+
+  const Pose3d pose(1, 2, 3, 0.1, -0.2, 0.3);
+  const RigidTransform3d transform(pose);
+  EXPECT_EQ(Matrix3d(pose.Rot()), transform.Rotation());
+  EXPECT_EQ(pose.Pos(), transform.Translation());
+  EXPECT_EQ(pose, transform.Pose());
+  EXPECT_EQ(transform, RigidTransform3d(Matrix3d(pose.Rot()), pose.Pos()));
+  EXPECT_NE(transform, identity);
+  EXPECT_TRUE(transform.Equal(RigidTransform3d(transform.Pose()), 1e-12));
+
+  std::ostringstream stream;
+  stream << transform;
+  std::ostringstream expected;
+  expected << pose;
+  EXPECT_EQ(expected.str(), stream.str());
+}
+
+/////////////////////////////////////////////////
+TEST(RigidTransform3Test, MatchesPose3)
+{
+  const std::vector<Pose3d> poses = {
+    {0, 0, 0, 0, 0, 0},
+    {1, 2, 3, 0.1, -0.2, 0.3},
+    {-4, 0.5, 2, 1.5, 0.2, -2.7},
+    {0, 0, 1, 0, 0, 3.14159},
+    // Non-unit rotation
+    {1, -1, 0.5, 2.0, 0.2, -0.4, 0.3}};
+  const std::vector<Vector3d> points = {
+    {1, 0, 0}, {0, -2, 0.5}, {3, 4, 5}, {0, 0, 0}};
+
+  for (const Pose3d &a : poses)
+  {
+    const RigidTransform3d ta(a);
+    const RigidTransform3d inverse = ta.Inverse();
+    // Pose3::Inverse only matches for a unit rotation
+    Pose3d unit = a;
+    unit.Rot().Normalize();
+    EXPECT_TRUE(inverse.Equal(RigidTransform3d(unit.Inverse()), 1e-12));
+    EXPECT_TRUE((ta * inverse).Equal(RigidTransform3d(), 1e-12));
+
+    for (const Vector3d &point : points)
+    {
+      EXPECT_TRUE(ta.TransformPoint(point).Equal(
+          a.CoordPositionAdd(point), 1e-12));
+      EXPECT_TRUE(ta.TransformDirection(point).Equal(
+          a.Rot().RotateVector(point), 1e-12));
+      EXPECT_TRUE(ta.InverseTransformPoint(point).Equal(
+          inverse.TransformPoint(point), 1e-12));
+      EXPECT_TRUE(ta.InverseTransformPoint(ta.TransformPoint(point)).Equal(
+          point, 1e-12));
+      EXPECT_TRUE(ta.InverseTransformDirection(point).Equal(
+          a.Rot().RotateVectorReverse(point), 1e-12));
+    }
+
+    for (const Pose3d &b : poses)
+    {
+      const RigidTransform3d product = ta * RigidTransform3d(b);
+      EXPECT_TRUE(product.Equal(RigidTransform3d(a * b), 1e-12));
+
+      RigidTransform3d assigned = ta;
+      assigned *= RigidTransform3d(b);
+      EXPECT_EQ(product, assigned);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(RigidTransform3Test, Buffers)
+{
+  const Pose3d pose(-4, 0.5, 2, 1.5, 0.2, -2.7);
+  const RigidTransform3d transform(pose);
+
+  std::vector<Vector3d> points;
+  for (int i = 0; i < 25; ++i)
+    points.emplace_back(i * 0.5, -i * 1.5, 10.0 - i);
+
+  std::vector<Vector3d> out(points.size());
+  transform.TransformPoints(points.data(), out.data(), points.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_EQ(transform.TransformPoint(points[i]), out[i]);
+
+  transform.TransformDirections(points.data(), out.data(), points.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_EQ(transform.TransformDirection(points[i]), out[i]);
+
+  // In place
+  std::vector<Vector3d> inPlace = points;
+  transform.TransformPoints(inPlace.data(), inPlace.data(), inPlace.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    EXPECT_EQ(transform.TransformPoint(points[i]), inPlace[i]);
+
+  // Float
+  const RigidTransform3f transformf(Pose3f(1, -2, 3, 0.4f, -1.1f, 2.7f));
+  const Vector3f pointf(1, 2, 3);
+  EXPECT_TRUE(transformf.TransformPoint(pointf).Equal(
+      transformf.Pose().CoordPositionAdd(pointf), 1e-5f));
+}
@@ -15,9 +15,9 @@
  *
 */
 
-#include <numeric>
+#include <cmath>
 #include <limits>
-#include <deque>
+#include <vector>
 #include "gz/math/RollingMean.hh"
 
 using namespace gz::math;
@@ -25,11 +25,56 @@ using namespace gz::math;
 /// \brief Private data
 class gz::math::RollingMean::Implementation
 {
-  /// \brief The window size
-  public: size_t windowSize{10};
+  /// \brief Set the window size, allocating the ring buffer if it is
+  /// larger than its capacity, and clear the values.
+  /// \param[in] _windowSize The window size, greater than zero.
+  public: void Resize(size_t _windowSize)
+  {
+    this->values.assign(_windowSize, 0.0);
+    this->Clear();
+  }
+
+  /// \brief Remove all the values.
+  public: void Clear()
+  {
+    this->head = 0;
+    this->count = 0;
+    this->sum = 0;
+    this->compensation = 0;
+    this->nonFinite = 0;
+  }
+
+  /// \brief Add a finite value to the sum, with Neumaier's variant of
+  /// Kahan summation, so rounding errors don't accumulate as values are
+  /// added and removed.
+  /// \param[in] _value The value, negative to remove a value.
+  public: void Add(double _value)
+  {
+    const double total = this->sum + _value;
+    if (std::abs(this->sum) >= std::abs(_value))
+      this->compensation += (this->sum - total) + _value;
+    else
+      this->compensation += (_value - total) + this->sum;
+    this->sum = total;
+  }
+
+  /// \brief The values, a ring buffer of the size of the window.
+  public: std::vector<double> values = std::vector<double>(10, 0.0);
+
+  /// \brief Index of the oldest value.
+  public: size_t head{0};
+
+  /// \brief Number of values.
+  public: size_t count{0};
 
-  /// \brief The values.
-  public: std::deque<double> values;
+  /// \brief Sum of the finite values.
+  public: double sum{0};
+
+  /// \brief Rounding error of sum.
+  public: double compensation{0};
+
+  /// \brief Number of NaN or infinite values, which are not in sum.
+  public: size_t nonFinite{0};
 };
 
 //////////////////////////////////////////////////
@@ -37,57 +82,91 @@ RollingMean::RollingMean(size_t _windowSize)
   : dataPtr(gz::utils::MakeImpl<Implementation>())
 {
   if (_windowSize > 0)
-    this->dataPtr->windowSize = _windowSize;
+    this->dataPtr->Resize(_windowSize);
 }
 
 //////////////////////////////////////////////////
 double RollingMean::Mean() const
 {
-  if (!this->dataPtr->values.empty())
+  const auto &d = *this->dataPtr;
+  if (d.count == 0)
+    return std::numeric_limits<double>::quiet_NaN();
+
+  // Non-finite values are rare, sum them with the others to get the same
+  // NaN or infinity as a plain sum.
+  if (d.nonFinite > 0)
   {
-    return std::accumulate(
-        this->dataPtr->values.begin(), this->dataPtr->values.end(), 0.0) /
-      this->dataPtr->values.size();
+    double total = 0;
+    for (size_t i = 0; i < d.count; ++i)
+      total += d.values[(d.head + i) % d.values.size()];
+    return total / d.count;
   }
 
-  return std::numeric_limits<double>::quiet_NaN();
+  return (d.sum + d.compensation) / d.count;
 }
 
 //////////////////////////////////////////////////
 size_t RollingMean::Count() const
 {
-  return this->dataPtr->values.size();
+  return this->dataPtr->count;
 }
 
 //////////////////////////////////////////////////
 void RollingMean::Push(double _value)
 {
-  this->dataPtr->values.push_back(_value);
-  while (this->dataPtr->values.size() > this->dataPtr->windowSize &&
-         !this->dataPtr->values.empty())
+  auto &d = *this->dataPtr;
+  const size_t windowSize = d.values.size();
+  size_t index = d.head + d.count;
+  if (d.count == windowSize)
   {
-    this->dataPtr->values.pop_front();
+    // Replace the oldest value.
+    const double oldest = d.values[d.head];
+    if (std::isfinite(oldest))
+      d.Add(-oldest);
+    else
+      --d.nonFinite;
+    index = d.head;
+    d.head = (d.head + 1) % windowSize;
   }
+  else
+  {
+    ++d.count;
+  }
+
+  d.values[index % windowSize] = _value;
+  if (std::isfinite(_value))
+    d.Add(_value);
+  else
+    ++d.nonFinite;
 }
 
 //////////////////////////////////////////////////
 void RollingMean::Clear()
 {
-  this->dataPtr->values.clear();
+  this->dataPtr->Clear();
 }
 
 //////////////////////////////////////////////////
 void RollingMean::SetWindowSize(size_t _windowSize)
 {
   if (_windowSize > 0)
-  {
-    this->dataPtr->windowSize = _windowSize;
-    this->Clear();
-  }
+    this->dataPtr->Resize(_windowSize);
 }
 
 //////////////////////////////////////////////////
 size_t RollingMean::WindowSize() const
 {
-  return this->dataPtr->windowSize;
+  return this->dataPtr->values.size();
+}
+
+//////////////////////////////////////////////////
+void RollingMean::Reserve(size_t _capacity)
+{
+  this->dataPtr->values.reserve(_capacity);
+}
+
+//////////////////////////////////////////////////
+size_t RollingMean::Capacity() const
+{
+  return this->dataPtr->values.capacity();
 }
@@ -17,6 +17,8 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+
 #include "gz/math/Helpers.hh"
 #include "gz/math/RollingMean.hh"
 
@@ -54,4 +56,59 @@ TEST(RollingMeanTest, RollingMean)
   EXPECT_EQ(3u, mean.Count());
   mean.SetWindowSize(2);
   EXPECT_EQ(0u, mean.Count());
+
+  mean.Push(1.0);
+  mean.Reserve(8);
+  EXPECT_EQ(2u, mean.WindowSize());
+  EXPECT_LE(8u, mean.Capacity());
+  EXPECT_DOUBLE_EQ(1.0, mean.Mean());
+  mean.SetWindowSize(8);
+  EXPECT_EQ(8u, mean.WindowSize());
+  EXPECT_EQ(0u, mean.Count());
+}
+
+/////////////////////////////////////////////////
+TEST(RollingMeanTest, Precision)
+{
+  // Large values pass through the window, the mean of the small ones must
+  // not keep their rounding errors.
+  math::RollingMean mean(3);
+  for (int i = 0; i < 1000; ++i)
+  {
+    mean.Push(1e16);
+    mean.Push(0.1);
+    mean.Push(-1e16);
+  }
+  for (int i = 0; i < 3; ++i)
+    mean.Push(0.1);
+  EXPECT_DOUBLE_EQ(0.1, mean.Mean());
+
+  math::RollingMean longMean(100);
+  for (int i = 0; i < 1000000; ++i)
+    longMean.Push(0.1 * (i % 7));
+  double expected = 0;
+  for (int i = 1000000 - 100; i < 1000000; ++i)
+    expected += 0.1 * (i % 7);
+  EXPECT_DOUBLE_EQ(expected / 100, longMean.Mean());
+}
+
+/////////////////////////////////////////////////
+TEST(RollingMeanTest, NonFinite)
+{
+  math::RollingMean mean(2);
+  mean.Push(1.0);
+  mean.Push(math::NAN_D);
+  EXPECT_TRUE(math::isnan(mean.Mean()));
+  mean.Push(math::INF_D);
+  EXPECT_TRUE(math::isnan(mean.Mean()));
+  mean.Push(3.0);
+  EXPECT_TRUE(std::isinf(mean.Mean()));
+  mean.Push(-math::INF_D);
+  mean.Push(math::INF_D);
+  EXPECT_TRUE(math::isnan(mean.Mean()));
+
+  // Once the non-finite values leave the window, the mean is finite again.
+  mean.Push(2.0);
+  mean.Push(4.0);
+  EXPECT_DOUBLE_EQ(3.0, mean.Mean());
 }
@@ -14,12 +14,96 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include "gz/math/Quaternion.hh"
 #include "gz/math/RotationSpline.hh"
 
 using namespace gz;
 using namespace math;
 
+/// \internal
+/// \brief The parts of a spherical linear interpolation between two
+/// quaternions that do not depend on the interpolation parameter, computed
+/// as Quaterniond::Slerp does.
+class SlerpConstants
+{
+  /// \brief Computes the constants.
+  /// \param[in] _p The beginning quaternion.
+  /// \param[in] _q The end quaternion.
+  /// \param[in] _shortestPath When true, the rotation may be inverted to
+  /// get to minimize rotation.
+  public: void Set(const Quaterniond &_p, const Quaterniond &_q,
+                   const bool _shortestPath)
+  {
+    double fCos = _p.Dot(_q);
+    if (fCos < 0.0 && _shortestPath)
+    {
+      fCos = -fCos;
+      this->end = -_q;
+    }
+    else
+    {
+      this->end = _q;
+    }
+
+    this->linear = !(std::abs(fCos) < 1 - 1e-03);
+    if (!this->linear)
+    {
+      const double fSin = sqrt(1 - (fCos*fCos));
+      this->angle = atan2(fSin, fCos);
+      this->invSin = 1.0 / fSin;
+    }
+  }
+
+  /// \brief Interpolates, as Quaterniond::Slerp does.
+  /// \param[in] _t The interpolation parameter.
+  /// \param[in] _p The beginning quaternion passed to Set.
+  /// \return The result of the interpolation.
+  public: Quaterniond Interpolate(const double _t, const Quaterniond &_p) const
+  {
+    if (!this->linear)
+    {
+      const double fCoeff0 = sin((1.0 - _t) * this->angle) * this->invSin;
+      const double fCoeff1 = sin(_t * this->angle) * this->invSin;
+      return _p * fCoeff0 + this->end * fCoeff1;
+    }
+
+    Quaterniond t = _p * (1.0 - _t) + this->end * _t;
+    t.Normalize();
+    return t;
+  }
+
+  /// \brief The end quaternion, inverted for the shortest path.
+  private: Quaterniond end;
+
+  /// \brief Angle between the quaternions.
+  private: double angle = 0.0;
+
+  /// \brief Inverse of the sine of the angle.
+  private: double invSin = 0.0;
+
+  /// \brief Whether the quaternions are too close, or almost opposite, so
+  /// the interpolation is linear.
+  private: bool linear = true;
+};
+
+/// \internal
+/// \brief Cached parts of the squad interpolation of a segment.
+struct SquadSegment
+{
+  /// \brief From the start to the end point, along the shortest path.
+  SlerpConstants shortestPath;
+
+  /// \brief From the start to the end point.
+  SlerpConstants directPath;
+
+  /// \brief From the start to the end tangent.
+  SlerpConstants tangents;
+};
+
 /// \internal
 /// \brief Private data for RotationSpline
 class RotationSpline::Implementation
@@ -33,6 +117,144 @@ class RotationSpline::Implementation
 
   /// \brief the tangents
   public: std::vector<Quaterniond> tangents;
+
+  /// \brief the cached interpolation constants of each segment
+  public: std::vector<SquadSegment> segments;
+
+  /// \brief Checks whether the spline is closed.
+  /// \return True if the first and last control points are equal.
+  public: bool IsClosed() const
+  {
+    return this->points.size() > 1 &&
+        this->points.front() == this->points.back();
+  }
+
+  /// \brief Recalculates the tangent of a control point.
+  /// \param[in] _index control point index, less than the number of
+  /// control points, which is at least 2.
+  /// \param[in] _closed whether the spline is closed.
+  public: void RecalcTangent(const size_t _index, const bool _closed)
+  {
+    const size_t numPoints = this->points.size();
+    const Quaterniond &p = this->points[_index];
+    const Quaterniond invp = p.Inverse();
+    Quaterniond part1, part2;
+    if (_index == 0)
+    {
+      // special case start
+      part1 = (invp * this->points[_index+1]).Log();
+      if (_closed)
+      {
+        // Use numPoints-2 since numPoints-1 == end == start == this one
+        part2 = (invp * this->points[numPoints-2]).Log();
+      }
+      else
+      {
+        part2 = (invp * p).Log();
+      }
+    }
+    else if (_index == numPoints-1)
+    {
+      // special case end
+      if (_closed)
+      {
+        // Wrap to [1] (not [0], this is the same as end == this one)
+        part1 = (invp * this->points[1]).Log();
+      }
+      else
+      {
+        part1 = (invp * p).Log();
+      }
+      part2 = (invp * this->points[_index-1]).Log();
+    }
+    else
+    {
+      part1 = (invp * this->points[_index+1]).Log();
+      part2 = (invp * this->points[_index-1]).Log();
+    }
+
+    const Quaterniond preExp = (part1 + part2) * -0.25;
+    this->tangents[_index] = p * preExp.Exp();
+  }
+
+  /// \brief Updates the cached interpolation constants of a segment.
+  /// \param[in] _index segment index.
+  public: void UpdateSegment(const size_t _index)
+  {
+    SquadSegment &segment = this->segments[_index];
+    const Quaterniond &p = this->points[_index];
+    const Quaterniond &q = this->points[_index + 1];
+    segment.shortestPath.Set(p, q, true);
+    segment.directPath.Set(p, q, false);
+    segment.tangents.Set(this->tangents[_index], this->tangents[_index + 1],
+                         false);
+  }
+
+  /// \brief Updates the tangents and segments that depend on a control
+  /// point that was just changed or added.
+  /// \param[in] _index index of the control point.
+  /// \param[in] _wasClosed whether the spline was closed before.
+  public: void UpdateAround(const size_t _index, const bool _wasClosed)
+  {
+    const size_t numPoints = this->points.size();
+    this->segments.resize(numPoints > 0 ? numPoints - 1 : 0);
+    if (numPoints < 2)
+      return;
+
+    // The tangent of a point depends on its neighbours, and the tangents
+    // of the ends of a closed spline on the second and second to last
+    // points.
+    std::vector<size_t> changed;
+    if (this->autoCalc)
+    {
+      const bool closed = this->IsClosed();
+      for (size_t i = _index > 0 ? _index - 1 : 0;
+           i <= std::min(_index + 1, numPoints - 1); ++i)
+      {
+        changed.push_back(i);
+      }
+      if (closed || _wasClosed)
+      {
+        changed.push_back(0);
+        changed.push_back(numPoints - 1);
+      }
+      for (const size_t i : changed)
+        this->RecalcTangent(i, closed);
+    }
+    else
+    {
+      changed.push_back(_index);
+    }
+
+    // The segments on both sides of the changed points and tangents
+    for (const size_t i : changed)
+    {
+      if (i > 0)
+        this->UpdateSegment(i - 1);
+      if (i + 1 < numPoints)
+        this->UpdateSegment(i);
+    }
+  }
+
+  /// \brief Interpolates a segment with the cached constants, as
+  /// Quaterniond::Squad does.
+  /// \param[in] _index segment index.
+  /// \param[in] _t parametric value in the segment.
+  /// \param[in] _useShortestPath Defines if rotation should take the
+  /// shortest possible path
+  /// \return the rotation.
+  public: Quaterniond Squad(const size_t _index, const double _t,
+                            const bool _useShortestPath) const
+  {
+    const SquadSegment &segment = this->segments[_index];
+    const double fSlerpT = 2.0*_t*(1.0-_t);
+    const Quaterniond kSlerpP = (_useShortestPath ?
+        segment.shortestPath : segment.directPath).Interpolate(
+            _t, this->points[_index]);
+    const Quaterniond kSlerpQ =
+        segment.tangents.Interpolate(_t, this->tangents[_index]);
+    return Quaterniond::Slerp(fSlerpT, kSlerpP, kSlerpQ);
+  }
 };
 
 /////////////////////////////////////////////////
@@ -44,9 +266,48 @@ RotationSpline::RotationSpline()
 /////////////////////////////////////////////////
 void RotationSpline::AddPoint(const Quaterniond &_p)
 {
+  const bool wasClosed = this->dataPtr->IsClosed();
   this->dataPtr->points.push_back(_p);
+  this->dataPtr->tangents.push_back(_p);
+  this->dataPtr->UpdateAround(this->dataPtr->points.size() - 1, wasClosed);
+}
+
+/////////////////////////////////////////////////
+void RotationSpline::AddPoints(const Quaterniond *_points,
+                               const size_t _count)
+{
+  if (_count == 0)
+    return;
+
+  // Grow geometrically, so that adding many small batches stays linear
+  const size_t first = this->dataPtr->points.size();
+  const size_t total = first + _count;
+  const size_t capacity = this->dataPtr->points.capacity();
+  if (total > capacity)
+    this->Reserve(std::max(total, 2 * capacity));
+
+  this->dataPtr->points.insert(this->dataPtr->points.end(), _points,
+                               _points + _count);
+  this->dataPtr->tangents.insert(this->dataPtr->tangents.end(), _points,
+                                 _points + _count);
+  this->dataPtr->segments.resize(total - 1);
   if (this->dataPtr->autoCalc)
+  {
     this->RecalcTangents();
+  }
+  else
+  {
+    for (size_t i = first > 0 ? first - 1 : 0; i + 1 < total; ++i)
+      this->dataPtr->UpdateSegment(i);
+  }
+}
+
+/////////////////////////////////////////////////
+void RotationSpline::Reserve(const size_t _count)
+{
+  this->dataPtr->points.reserve(_count);
+  this->dataPtr->tangents.reserve(_count);
+  this->dataPtr->segments.reserve(_count);
 }
 
 /////////////////////////////////////////////////
@@ -86,13 +347,41 @@ Quaterniond RotationSpline::Interpolate(const unsigned int _fromIndex,
 
   // double interpolation
   // Use squad using tangents we've already set up
-  Quaterniond &p = this->dataPtr->points[_fromIndex];
-  Quaterniond &q = this->dataPtr->points[_fromIndex+1];
-  Quaterniond &a = this->dataPtr->tangents[_fromIndex];
-  Quaterniond &b = this->dataPtr->tangents[_fromIndex+1];
-
   // NB interpolate to nearest rotation
-  return Quaterniond::Squad(_t, p, a, b, q, _useShortestPath);
+  return this->dataPtr->Squad(_fromIndex, _t, _useShortestPath);
+}
+
+/////////////////////////////////////////////////
+void RotationSpline::Interpolate(const double *_t, Quaterniond *_out,
+                                 const size_t _count,
+                                 const bool _useShortestPath) const
+{
+  const auto &points = this->dataPtr->points;
+  const Quaterniond inf(INF_D, INF_D, INF_D, INF_D);
+  for (size_t i = 0; i < _count; ++i)
+  {
+    // Same as Interpolate(_t[i], _useShortestPath). The segments are
+    // evenly spaced, so the segment of a value is found directly.
+    if (points.empty() || !(_t[i] >= 0.0))
+    {
+      _out[i] = inf;
+      continue;
+    }
+    const double fSeg = _t[i] * (points.size() - 1);
+    if (!(fSeg < points.size()))
+    {
+      _out[i] = inf;
+      continue;
+    }
+    const size_t segIdx = static_cast<size_t>(fSeg);
+    const double t = fSeg - segIdx;
+    if (segIdx + 1 == points.size() || equal(t, 0.0))
+      _out[i] = points[segIdx];
+    else if (equal(t, 1.0))
+      _out[i] = points[segIdx + 1];
+    else
+      _out[i] = this->dataPtr->Squad(segIdx, t, _useShortestPath);
+  }
 }
 
 /////////////////////////////////////////////////
@@ -108,9 +397,6 @@ void RotationSpline::RecalcTangents()
   //
   // Assume endpoint tangents are parallel with line with neighbour
 
-  unsigned int i;
-  bool isClosed;
-
   size_t numPoints = this->dataPtr->points.size();
 
   if (numPoints < 2)
@@ -119,56 +405,11 @@ void RotationSpline::RecalcTangents()
     return;
   }
 
-  this->dataPtr->tangents.resize(numPoints);
-
-  if (this->dataPtr->points[0] == this->dataPtr->points[numPoints-1])
-    isClosed = true;
-  else
-    isClosed = false;
-
-  Quaterniond invp, part1, part2, preExp;
-  for (i = 0; i < numPoints; ++i)
-  {
-    Quaterniond &p = this->dataPtr->points[i];
-    invp = p.Inverse();
-
-    if (i == 0)
-    {
-      // special case start
-      part1 = (invp * this->dataPtr->points[i+1]).Log();
-      if (isClosed)
-      {
-        // Use numPoints-2 since numPoints-1 == end == start == this one
-        part2 = (invp * this->dataPtr->points[numPoints-2]).Log();
-      }
-      else
-      {
-        part2 = (invp * p).Log();
-      }
-    }
-    else if (i == numPoints-1)
-    {
-      // special case end
-      if (isClosed)
-      {
-        // Wrap to [1] (not [0], this is the same as end == this one)
-        part1 = (invp * this->dataPtr->points[1]).Log();
-      }
-      else
-      {
-        part1 = (invp * p).Log();
-      }
-      part2 = (invp * this->dataPtr->points[i-1]).Log();
-    }
-    else
-    {
-      part1 = (invp * this->dataPtr->points[i+1]).Log();
-      part2 = (invp * this->dataPtr->points[i-1]).Log();
-    }
-
-    preExp = (part1 + part2) * -0.25;
-    this->dataPtr->tangents[i] = p * preExp.Exp();
-  }
+  const bool isClosed = this->dataPtr->IsClosed();
+  for (size_t i = 0; i < numPoints; ++i)
+    this->dataPtr->RecalcTangent(i, isClosed);
+  for (size_t i = 0; i + 1 < numPoints; ++i)
+    this->dataPtr->UpdateSegment(i);
 }
 
 /////////////////////////////////////////////////
@@ -195,6 +436,7 @@ void RotationSpline::Clear()
 {
   this->dataPtr->points.clear();
   this->dataPtr->tangents.clear();
+  this->dataPtr->segments.clear();
 }
 
 /////////////////////////////////////////////////
@@ -204,9 +446,9 @@ bool RotationSpline::UpdatePoint(const unsigned int _index,
   if (_index >= this->dataPtr->points.size())
     return false;
 
+  const bool wasClosed = this->dataPtr->IsClosed();
   this->dataPtr->points[_index] = _value;
-  if (this->dataPtr->autoCalc)
-    this->RecalcTangents();
+  this->dataPtr->UpdateAround(_index, wasClosed);
 
   return true;
 }
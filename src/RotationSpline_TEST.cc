@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <vector>
+
 #include "gz/math/Helpers.hh"
 #include "gz/math/Vector3.hh"
 #include "gz/math/Quaternion.hh"
@@ -97,3 +100,129 @@ TEST(RotationSplineTest, RecalcTangents)
   EXPECT_EQ(s.Interpolate(1, 0.5),
       math::Quaterniond(0.987225, 0.077057, 0.11624, 0.077057));
 }
+
+/////////////////////////////////////////////////
+/// \brief Check that two splines interpolate to exactly the same rotations.
+void ExpectSameRotations(math::RotationSpline &_a, math::RotationSpline &_b)
+{
+  for (int i = 0; i <= 1000; ++i)
+  {
+    for (const bool shortestPath : {true, false})
+    {
+      const math::Quaterniond a = _a.Interpolate(i / 1000.0, shortestPath);
+      const math::Quaterniond b = _b.Interpolate(i / 1000.0, shortestPath);
+      EXPECT_TRUE(a.Equal(b, 0.0)) << i << " " << a << " " << b;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(RotationSplineTest, IncrementalUpdates)
+{
+  // Points added one by one update the tangents around them, which gives
+  // the same spline as recalculating all of them.
+  std::vector<math::Quaterniond> points;
+  for (int i = 0; i < 40; ++i)
+    points.push_back(math::Quaterniond(0.3 * i, std::sin(i), 0.1 * i * i));
+  points.push_back(points.front());
+
+  math::RotationSpline s;
+  math::RotationSpline expected;
+  expected.AutoCalculate(false);
+  for (const auto &p : points)
+  {
+    s.AddPoint(p);
+    expected.AddPoint(p);
+  }
+  expected.RecalcTangents();
+  ExpectSameRotations(s, expected);
+
+  // Updates of inner points, of the neighbours of the ends of the closed
+  // spline, and of the ends, which opens and closes the spline.
+  for (const unsigned int i : {20u, 1u, 39u, 0u, 40u})
+  {
+    const math::Quaterniond p(0.1 * i, 0.2, -0.3);
+    EXPECT_TRUE(s.UpdatePoint(i, p));
+    EXPECT_TRUE(expected.UpdatePoint(i, p));
+    expected.RecalcTangents();
+    ExpectSameRotations(s, expected);
+  }
+  EXPECT_TRUE(s.UpdatePoint(40, s.Point(0)));
+  EXPECT_TRUE(expected.UpdatePoint(40, expected.Point(0)));
+  expected.RecalcTangents();
+  ExpectSameRotations(s, expected);
+}
+
+/////////////////////////////////////////////////
+TEST(RotationSplineTest, AddPoints)
+{
+  std::vector<math::Quaterniond> points;
+  for (int i = 0; i < 30; ++i)
+    points.push_back(math::Quaterniond(0.2 * i, std::cos(i), 0.05 * i));
+  points.push_back(points.front());
+
+  for (const bool autoCalc : {true, false})
+  {
+    math::RotationSpline one;
+    math::RotationSpline bulk;
+    one.AutoCalculate(autoCalc);
+    bulk.AutoCalculate(autoCalc);
+    for (const auto &p : points)
+      one.AddPoint(p);
+
+    // In several batches, the first one a single point
+    bulk.Reserve(points.size());
+    bulk.AddPoints(points.data(), 1);
+    bulk.AddPoints(points.data() + 1, 12);
+    bulk.AddPoints(points.data() + 13, 0);
+    bulk.AddPoints(points.data() + 13, points.size() - 13);
+    ASSERT_EQ(points.size(), bulk.PointCount());
+    ExpectSameRotations(one, bulk);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(RotationSplineTest, BatchInterpolate)
+{
+  math::RotationSpline s;
+  std::vector<double> t{0.0, 0.5, 1.0};
+  std::vector<math::Quaterniond> out(t.size());
+
+  // Empty spline
+  s.Interpolate(t.data(), out.data(), t.size());
+  for (const auto &q : out)
+    EXPECT_FALSE(q.IsFinite());
+
+  // Single point
+  s.AddPoint(math::Quaterniond(0.1, 0.2, 0.3));
+  s.Interpolate(t.data(), out.data(), t.size());
+  for (const auto &q : out)
+    EXPECT_EQ(math::Quaterniond(0.1, 0.2, 0.3), q);
+
+  for (int i = 1; i < 30; ++i)
+    s.AddPoint(math::Quaterniond(0.3 * i, std::sin(i), 0.1 * i * i));
+
+  t = {-0.1, std::nan(""), 0.0, 1e-9, 0.02, 0.5, 0.77, 1 - 1e-9, 1.0,
+       1.0 + 1e-3, 1.2};
+  for (int i = 0; i <= 1000; ++i)
+    t.push_back(i / 1000.0);
+  out.resize(t.size());
+  for (const bool shortestPath : {true, false})
+  {
+    s.Interpolate(t.data(), out.data(), t.size(), shortestPath);
+    for (size_t i = 0; i < t.size(); ++i)
+    {
+      // Values a little over 1 give the last point, as Interpolate does.
+      if (!(t[i] >= 0.0) || t[i] > 1.1)
+      {
+        EXPECT_FALSE(out[i].IsFinite()) << t[i];
+        continue;
+      }
+      const math::Quaterniond expected = s.Interpolate(t[i], shortestPath);
+      EXPECT_TRUE(expected.Equal(out[i], 0.0)) << t[i];
+    }
+  }
+
+  // Nothing to do
+  s.Interpolate(t.data(), out.data(), 0);
+}
@@ -15,13 +15,100 @@
  *
 */
 
-#include <sstream>
+#include <algorithm>
+#include <charconv>
 
 #include "gz/math/SemanticVersion.hh"
 
 using namespace gz;
 using namespace math;
 
+namespace
+{
+/// \brief The parts of a version string
+struct VersionParts
+{
+  /// \brief Major, minor and patch numbers
+  unsigned int numbers[3] = {0, 0, 0};
+
+  /// \brief Prerelease string, after "-"
+  std::string_view prerelease;
+
+  /// \brief Build metadata, after "+"
+  std::string_view build;
+};
+
+/// \brief Split a version string into its parts
+/// \param[in] _str The version string
+/// \param[out] _parts The parts of the version
+/// \return True if the string is a valid version
+bool parseVersion(std::string_view _str, VersionParts &_parts)
+{
+  if (_str.empty())
+    return false;
+
+  const std::size_t prereleaseStart = _str.find('-');
+  const std::size_t buildStart = _str.find('+');
+
+  // Build meta data, if present, must be after prerelease string, if
+  // present
+  if (buildStart != std::string_view::npos &&
+      prereleaseStart != std::string_view::npos &&
+      buildStart < prereleaseStart)
+  {
+    return false;
+  }
+
+  if (buildStart != std::string_view::npos)
+  {
+    _parts.build = _str.substr(buildStart + 1);
+    _str = _str.substr(0, buildStart);
+  }
+  if (prereleaseStart != std::string_view::npos)
+  {
+    _parts.prerelease = _str.substr(prereleaseStart + 1);
+    _str = _str.substr(0, prereleaseStart);
+  }
+
+  // One to three dot separated numbers
+  const char *ptr = _str.data();
+  const char *end = _str.data() + _str.size();
+  for (int i = 0; i < 3; ++i)
+  {
+    // from_chars would accept a sign
+    if (ptr == end || *ptr < '0' || *ptr > '9')
+      return false;
+    const auto result = std::from_chars(ptr, end, _parts.numbers[i]);
+    if (result.ec != std::errc())
+      return false;
+    ptr = result.ptr;
+    if (ptr == end)
+      return true;
+    if (*ptr != '.')
+      return false;
+    ++ptr;
+  }
+  return false;
+}
+
+/// \brief Get the key of a version, see SemanticVersion::Key
+/// \param[in] _major Major number
+/// \param[in] _minor Minor number
+/// \param[in] _patch Patch number
+/// \param[in] _prerelease True if there is a prerelease string
+/// \return The key
+std::uint64_t versionKey(const unsigned int _major, const unsigned int _minor,
+                         const unsigned int _patch, const bool _prerelease)
+{
+  auto clamp = [](const unsigned int _n) -> std::uint64_t
+  {
+    return std::min(_n, SemanticVersion::kMaxKeyNumber);
+  };
+  return (clamp(_major) << 43) | (clamp(_minor) << 22) |
+    (clamp(_patch) << 1) | (_prerelease ? 0u : 1u);
+}
+}  // namespace
+
 namespace gz
 {
   namespace math
@@ -206,73 +293,40 @@ std::string SemanticVersion::Build() const
 /////////////////////////////////////////////////
 bool SemanticVersion::Parse(const std::string &_versionStr)
 {
-  if (_versionStr.empty())
-    return false;
-
-  size_t numericEnd = _versionStr.size();
-  size_t prereleaseStart = _versionStr.find("-");
-  size_t buildStart = _versionStr.find("+");
+  return this->Parse(std::string_view(_versionStr));
+}
 
-  // Build meta data, if present, must be after prerelease string, if
-  // present
-  if (buildStart != std::string::npos &&
-      prereleaseStart != std::string::npos &&
-      buildStart < prereleaseStart)
-  {
+/////////////////////////////////////////////////
+bool SemanticVersion::Parse(std::string_view _versionStr)
+{
+  VersionParts parts;
+  if (!parseVersion(_versionStr, parts))
     return false;
-  }
 
-  // Check if a prerelease version is present
-  if (prereleaseStart != std::string::npos)
-  {
-    // Set the end of the numeric (major.minor.patch) portion to the
-    // start of the prerelease
-    numericEnd = prereleaseStart;
+  this->dataPtr->maj = parts.numbers[0];
+  this->dataPtr->min = parts.numbers[1];
+  this->dataPtr->patch = parts.numbers[2];
+  this->dataPtr->prerelease = parts.prerelease;
+  this->dataPtr->build = parts.build;
+  return true;
+}
 
-    // Check if build metadata is present
-    if (buildStart != std::string::npos)
-    {
-      // Set prerelease to the portion between "-" and "+"
-      this->dataPtr->prerelease = _versionStr.substr(numericEnd + 1,
-           buildStart - numericEnd - 1);
+/////////////////////////////////////////////////
+std::uint64_t SemanticVersion::Key() const
+{
+  return versionKey(this->dataPtr->maj, this->dataPtr->min,
+                    this->dataPtr->patch, !this->dataPtr->prerelease.empty());
+}
 
-      // Get the build metadata.
-      this->dataPtr->build = _versionStr.substr(buildStart + 1);
-    }
-    else
-    {
-      // Set prerelease to the portion between "-" and the string's end
-      this->dataPtr->prerelease = _versionStr.substr(numericEnd + 1);
-    }
-  }
-  // Check if build metadata is present
-  else if (buildStart != std::string::npos)
-  {
-    // Set the end of the numeric (major.minor.patch) portion to the
-    // start of the build metadata
-    numericEnd = buildStart;
-    // Pre-release info can't follow the build metadata.
-    this->dataPtr->build = _versionStr.substr(numericEnd + 1);
-  }
+/////////////////////////////////////////////////
+bool SemanticVersion::ParseKey(std::string_view _versionStr,
+                               std::uint64_t &_key)
+{
+  VersionParts parts;
+  if (!parseVersion(_versionStr, parts))
+    return false;
 
-  std::string numeric = _versionStr.substr(0, numericEnd);
-  std::istringstream is(numeric);
-  std::string token;
-  for (int i = 0; std::getline(is, token, '.'); ++i)
-  {
-    switch (i)
-    {
-      default:
-      case 0:
-        this->dataPtr->maj = std::stoi(token);
-        break;
-      case 1:
-        this->dataPtr->min = std::stoi(token);
-        break;
-      case 2:
-        this->dataPtr->patch = std::stoi(token);
-        break;
-    };
-  }
+  _key = versionKey(parts.numbers[0], parts.numbers[1], parts.numbers[2],
+                    !parts.prerelease.empty());
   return true;
 }
@@ -17,6 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include "gz/math/SemanticVersion.hh"
 
 using namespace gz;
@@ -194,6 +199,74 @@ TEST(SemVerTest, Parse)
   SemanticVersion a;
   EXPECT_FALSE(a.Parse(""));
   EXPECT_FALSE(a.Parse("0.1.2+1-1"));
+
+  EXPECT_TRUE(a.Parse("1.22.333-pr.1+build-5"));
+  EXPECT_EQ(1u, a.Major());
+  EXPECT_EQ(22u, a.Minor());
+  EXPECT_EQ(333u, a.Patch());
+  EXPECT_EQ("pr.1", a.Prerelease());
+  EXPECT_EQ("build-5", a.Build());
+
+  // Invalid numbers leave the version unchanged
+  for (const char *str : {"a.b.c", "1..2", "1.2.", ".1", "1.2.3.4", "1.-2",
+                          "+1.2", " 1.2", "1.2x", "1.4294967296", "-pr"})
+  {
+    EXPECT_FALSE(a.Parse(str)) << str;
+    EXPECT_EQ("1.22.333-pr.1+build-5", a.Version()) << str;
+  }
+
+  // Missing numbers are 0, and so are the strings
+  EXPECT_TRUE(a.Parse(std::string_view("4.5")));
+  EXPECT_EQ("4.5.0", a.Version());
+  EXPECT_TRUE(a.Parse(std::string("7+b")));
+  EXPECT_EQ("7.0.0+b", a.Version());
+  EXPECT_TRUE(a.Parse("4294967295.0.1"));
+  EXPECT_EQ(4294967295u, a.Major());
+
+  // The string_view doesn't need to be null terminated
+  const std::string buffer = "2.3.4-rc1 2.3.5";
+  EXPECT_TRUE(a.Parse(std::string_view(buffer).substr(0, 9)));
+  EXPECT_EQ("2.3.4-rc1", a.Version());
+}
+
+/////////////////////////////////////////////////
+TEST(SemVerTest, Key)
+{
+  const std::vector<std::string> sorted = {
+    "0.0.1", "0.1.0-pr2", "0.1.0", "0.1.1", "0.2.0", "0.10.0",
+    "1.0.0-alpha", "1.0.0", "1.0.2", "2.0.0", "10.0.0"};
+  for (std::size_t i = 0; i < sorted.size(); ++i)
+  {
+    for (std::size_t j = 0; j < sorted.size(); ++j)
+    {
+      const SemanticVersion a(sorted[i]);
+      const SemanticVersion b(sorted[j]);
+      EXPECT_EQ(a < b, a.Key() < b.Key()) << sorted[i] << " " << sorted[j];
+      EXPECT_EQ(i < j, a.Key() < b.Key()) << sorted[i] << " " << sorted[j];
+
+      std::uint64_t key = 0;
+      EXPECT_TRUE(SemanticVersion::ParseKey(sorted[i], key));
+      EXPECT_EQ(a.Key(), key);
+    }
+  }
+
+  // Build metadata doesn't change the order
+  EXPECT_EQ(SemanticVersion("1.2.3").Key(),
+            SemanticVersion("1.2.3+abc").Key());
+  EXPECT_EQ(SemanticVersion(1, 2, 3, "pr").Key(),
+            SemanticVersion("1.2.3-pr+abc").Key());
+
+  // Large numbers are clamped
+  EXPECT_EQ(SemanticVersion(SemanticVersion::kMaxKeyNumber).Key(),
+            SemanticVersion(SemanticVersion::kMaxKeyNumber + 1).Key());
+  EXPECT_LT(SemanticVersion(SemanticVersion::kMaxKeyNumber - 1,
+                            SemanticVersion::kMaxKeyNumber,
+                            SemanticVersion::kMaxKeyNumber).Key(),
+            SemanticVersion(SemanticVersion::kMaxKeyNumber).Key());
+
+  std::uint64_t key = 42;
+  EXPECT_FALSE(SemanticVersion::ParseKey("1.x", key));
+  EXPECT_EQ(42u, key);
 }
 
 /////////////////////////////////////////////////
@@ -0,0 +1,302 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "gz/math/SignalPyramid.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+/// \brief Number of independent accumulators of the block insertions, as
+/// in SignalStats.cc.
+constexpr std::size_t kLanes = 4;
+
+/// \brief Samples of a bucket that is being filled.
+struct SignalAccumulator
+{
+  /// \brief Add a sample.
+  /// \param[in] _data The sample.
+  void Add(const double _data)
+  {
+    this->min = _data < this->min ? _data : this->min;
+    this->max = _data > this->max ? _data : this->max;
+    this->sum += _data;
+    ++this->count;
+  }
+
+  /// \brief Add a block of samples.
+  /// \param[in] _data Pointer to the first sample.
+  /// \param[in] _count Number of samples.
+  void Add(const double *_data, const std::size_t _count)
+  {
+    double mins[kLanes] = {this->min, this->min, this->min, this->min};
+    double maxs[kLanes] = {this->max, this->max, this->max, this->max};
+    double sums[kLanes] = {0.0, 0.0, 0.0, 0.0};
+    std::size_t i = 0;
+    for (; i + kLanes <= _count; i += kLanes)
+    {
+      for (std::size_t lane = 0; lane < kLanes; ++lane)
+      {
+        const double value = _data[i + lane];
+        mins[lane] = value < mins[lane] ? value : mins[lane];
+        maxs[lane] = value > maxs[lane] ? value : maxs[lane];
+        sums[lane] += value;
+      }
+    }
+    for (std::size_t lane = 1; lane < kLanes; ++lane)
+    {
+      mins[0] = mins[lane] < mins[0] ? mins[lane] : mins[0];
+      maxs[0] = maxs[lane] > maxs[0] ? maxs[lane] : maxs[0];
+    }
+    this->min = mins[0];
+    this->max = maxs[0];
+    this->sum += (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    this->count += i;
+    for (; i < _count; ++i)
+      this->Add(_data[i]);
+  }
+
+  /// \brief Add the samples of another accumulator.
+  /// \param[in] _other The accumulator.
+  void Merge(const SignalAccumulator &_other)
+  {
+    this->min = std::min(this->min, _other.min);
+    this->max = std::max(this->max, _other.max);
+    this->sum += _other.sum;
+    this->count += _other.count;
+  }
+
+  /// \brief Summarize the samples.
+  /// \return The bucket, zero if there are no samples.
+  SignalBucket Bucket() const
+  {
+    if (this->count == 0)
+      return SignalBucket{0.0, 0.0, 0.0, 0};
+    return SignalBucket{this->min, this->max,
+      this->sum / static_cast<double>(this->count), this->count};
+  }
+
+  /// \brief Smallest sample.
+  double min = std::numeric_limits<double>::infinity();
+
+  /// \brief Largest sample.
+  double max = -std::numeric_limits<double>::infinity();
+
+  /// \brief Sum of the samples.
+  double sum = 0.0;
+
+  /// \brief Number of samples.
+  uint64_t count = 0;
+};
+
+/// \brief One level of the pyramid.
+struct SignalLevel
+{
+  /// \brief Number of samples in each bucket.
+  uint64_t width = 1;
+
+  /// \brief Ring buffer of the complete buckets.
+  std::vector<SignalBucket> buckets;
+
+  /// \brief Index of the next bucket to write in the ring buffer.
+  std::size_t next = 0;
+
+  /// \brief Number of complete buckets in the ring buffer.
+  std::size_t size = 0;
+
+  /// \brief Bucket that is being filled.
+  SignalAccumulator current;
+};
+}
+
+/// \brief Private data for the SignalPyramid class
+class gz::math::SignalPyramid::Implementation
+{
+  /// \brief Complete the current bucket of a level, and add it to the next
+  /// levels.
+  /// \param[in] _level The level.
+  public: void Complete(const std::size_t _level)
+  {
+    for (std::size_t l = _level; l < this->levels.size(); ++l)
+    {
+      SignalLevel &level = this->levels[l];
+      level.buckets[level.next] = level.current.Bucket();
+      level.next = level.next + 1 == this->capacity ? 0 : level.next + 1;
+      level.size = std::min(level.size + 1, this->capacity);
+
+      const SignalAccumulator complete = level.current;
+      level.current = SignalAccumulator();
+      if (l + 1 == this->levels.size())
+        break;
+      SignalLevel &parent = this->levels[l + 1];
+      parent.current.Merge(complete);
+      if (parent.current.count < parent.width)
+        break;
+    }
+  }
+
+  /// \brief Levels, from the finest.
+  public: std::vector<SignalLevel> levels;
+
+  /// \brief Number of complete buckets kept for each level.
+  public: std::size_t capacity = 1;
+
+  /// \brief Number of samples inserted.
+  public: uint64_t count = 0;
+};
+
+//////////////////////////////////////////////////
+SignalPyramid::SignalPyramid(const std::size_t _bucketSize,
+    const std::size_t _factor, const std::size_t _levels,
+    const std::size_t _capacity)
+  : dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+  this->dataPtr->capacity = std::max<std::size_t>(_capacity, 1);
+  this->dataPtr->levels.resize(std::max<std::size_t>(_levels, 1));
+
+  uint64_t width = std::max<std::size_t>(_bucketSize, 1);
+  const uint64_t factor = std::max<std::size_t>(_factor, 1);
+  for (SignalLevel &level : this->dataPtr->levels)
+  {
+    level.width = width;
+    level.buckets.resize(this->dataPtr->capacity);
+    width *= factor;
+  }
+}
+
+//////////////////////////////////////////////////
+std::size_t SignalPyramid::Levels() const
+{
+  return this->dataPtr->levels.size();
+}
+
+//////////////////////////////////////////////////
+std::size_t SignalPyramid::Capacity() const
+{
+  return this->dataPtr->capacity;
+}
+
+//////////////////////////////////////////////////
+uint64_t SignalPyramid::BucketSize(const std::size_t _level) const
+{
+  if (_level >= this->dataPtr->levels.size())
+    return 0;
+  return this->dataPtr->levels[_level].width;
+}
+
+//////////////////////////////////////////////////
+uint64_t SignalPyramid::Count() const
+{
+  return this->dataPtr->count;
+}
+
+//////////////////////////////////////////////////
+void SignalPyramid::InsertData(const double _data)
+{
+  SignalLevel &level = this->dataPtr->levels[0];
+  level.current.Add(_data);
+  ++this->dataPtr->count;
+  if (level.current.count == level.width)
+    this->dataPtr->Complete(0);
+}
+
+//////////////////////////////////////////////////
+void SignalPyramid::InsertData(const double *_data, const std::size_t _count)
+{
+  SignalLevel &level = this->dataPtr->levels[0];
+  std::size_t i = 0;
+  while (i < _count)
+  {
+    const std::size_t n = static_cast<std::size_t>(std::min<uint64_t>(
+        level.width - level.current.count, _count - i));
+    level.current.Add(_data + i, n);
+    i += n;
+    if (level.current.count == level.width)
+      this->dataPtr->Complete(0);
+  }
+  this->dataPtr->count += _count;
+}
+
+//////////////////////////////////////////////////
+void SignalPyramid::Reset()
+{
+  for (SignalLevel &level : this->dataPtr->levels)
+  {
+    level.next = 0;
+    level.size = 0;
+    level.current = SignalAccumulator();
+  }
+  this->dataPtr->count = 0;
+}
+
+//////////////////////////////////////////////////
+std::size_t SignalPyramid::Size(const std::size_t _level) const
+{
+  if (_level >= this->dataPtr->levels.size())
+    return 0;
+  return this->dataPtr->levels[_level].size;
+}
+
+//////////////////////////////////////////////////
+SignalBucket SignalPyramid::Bucket(const std::size_t _level,
+    const std::size_t _index) const
+{
+  if (_level >= this->dataPtr->levels.size() ||
+      _index >= this->dataPtr->levels[_level].size)
+  {
+    return SignalBucket{0.0, 0.0, 0.0, 0};
+  }
+
+  const SignalLevel &level = this->dataPtr->levels[_level];
+  const std::size_t capacity = this->dataPtr->capacity;
+  return level.buckets[(level.next + capacity - level.size + _index) %
+    capacity];
+}
+
+//////////////////////////////////////////////////
+SignalBucket SignalPyramid::Current(const std::size_t _level) const
+{
+  if (_level >= this->dataPtr->levels.size())
+    return SignalBucket{0.0, 0.0, 0.0, 0};
+  return this->dataPtr->levels[_level].current.Bucket();
+}
+
+//////////////////////////////////////////////////
+std::size_t SignalPyramid::Export(const std::size_t _level,
+    SignalBucket *_buckets) const
+{
+  if (_level >= this->dataPtr->levels.size())
+    return 0;
+
+  // The oldest buckets are after the next one to write, the newest before
+  const SignalLevel &level = this->dataPtr->levels[_level];
+  const auto begin = level.buckets.begin();
+  if (level.size < this->dataPtr->capacity)
+  {
+    std::copy(begin, begin + level.size, _buckets);
+  }
+  else
+  {
+    const auto next = begin + level.next;
+    std::copy(begin, next, std::copy(next, level.buckets.end(), _buckets));
+  }
+  return level.size;
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "gz/math/Rand.hh"
+#include "gz/math/SignalPyramid.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(SignalPyramidTest, Constructor)
+{
+  SignalPyramid pyramid(10, 100, 3, 1000);
+  EXPECT_EQ(3u, pyramid.Levels());
+  EXPECT_EQ(1000u, pyramid.Capacity());
+  EXPECT_EQ(10u, pyramid.BucketSize(0));
+  EXPECT_EQ(1000u, pyramid.BucketSize(1));
+  EXPECT_EQ(100000u, pyramid.BucketSize(2));
+  EXPECT_EQ(0u, pyramid.BucketSize(3));
+  EXPECT_EQ(0u, pyramid.Count());
+  for (std::size_t l = 0; l < 4; ++l)
+  {
+    EXPECT_EQ(0u, pyramid.Size(l));
+    EXPECT_EQ(0u, pyramid.Current(l).count);
+    EXPECT_EQ(0u, pyramid.Bucket(l, 0).count);
+  }
+
+  // Zero arguments are treated as one
+  SignalPyramid ones(0, 0, 0, 0);
+  EXPECT_EQ(1u, ones.Levels());
+  EXPECT_EQ(1u, ones.Capacity());
+  EXPECT_EQ(1u, ones.BucketSize(0));
+}
+
+/////////////////////////////////////////////////
+TEST(SignalPyramidTest, Buckets)
+{
+  // Buckets of 2 and 6 samples, 3 of each kept
+  SignalPyramid pyramid(2, 3, 2, 3);
+  for (int i = 0; i < 5; ++i)
+    pyramid.InsertData(i);
+
+  EXPECT_EQ(5u, pyramid.Count());
+  ASSERT_EQ(2u, pyramid.Size(0));
+  EXPECT_EQ(0u, pyramid.Size(1));
+
+  SignalBucket bucket = pyramid.Bucket(0, 0);
+  EXPECT_DOUBLE_EQ(0, bucket.min);
+  EXPECT_DOUBLE_EQ(1, bucket.max);
+  EXPECT_DOUBLE_EQ(0.5, bucket.mean);
+  EXPECT_EQ(2u, bucket.count);
+  bucket = pyramid.Bucket(0, 1);
+  EXPECT_DOUBLE_EQ(2, bucket.min);
+  EXPECT_DOUBLE_EQ(3, bucket.max);
+  EXPECT_EQ(0u, pyramid.Bucket(0, 2).count);
+
+  bucket = pyramid.Current(0);
+  EXPECT_DOUBLE_EQ(4, bucket.min);
+  EXPECT_DOUBLE_EQ(4, bucket.max);
+  EXPECT_EQ(1u, bucket.count);
+  bucket = pyramid.Current(1);
+  EXPECT_DOUBLE_EQ(0, bucket.min);
+  EXPECT_DOUBLE_EQ(3, bucket.max);
+  EXPECT_DOUBLE_EQ(1.5, bucket.mean);
+  EXPECT_EQ(4u, bucket.count);
+
+  // 20 samples: 10 buckets of the first level, the last 3 kept, and 3 of
+  // the second level
+  for (int i = 5; i < 20; ++i)
+    pyramid.InsertData(i);
+  ASSERT_EQ(3u, pyramid.Size(0));
+  ASSERT_EQ(3u, pyramid.Size(1));
+
+  std::vector<SignalBucket> buckets(3);
+  EXPECT_EQ(3u, pyramid.Export(0, buckets.data()));
+  for (std::size_t i = 0; i < 3; ++i)
+  {
+    EXPECT_DOUBLE_EQ(14.0 + 2 * i, buckets[i].min);
+    EXPECT_DOUBLE_EQ(15.0 + 2 * i, buckets[i].max);
+    EXPECT_DOUBLE_EQ(pyramid.Bucket(0, i).mean, buckets[i].mean);
+  }
+
+  EXPECT_EQ(3u, pyramid.Export(1, buckets.data()));
+  for (std::size_t i = 0; i < 3; ++i)
+  {
+    EXPECT_DOUBLE_EQ(6.0 * i, buckets[i].min);
+    EXPECT_DOUBLE_EQ(6.0 * i + 5, buckets[i].max);
+    EXPECT_DOUBLE_EQ(6.0 * i + 2.5, buckets[i].mean);
+    EXPECT_EQ(6u, buckets[i].count);
+  }
+  EXPECT_EQ(2u, pyramid.Current(1).count);
+  EXPECT_EQ(0u, pyramid.Export(2, buckets.data()));
+
+  pyramid.Reset();
+  EXPECT_EQ(0u, pyramid.Count());
+  EXPECT_EQ(0u, pyramid.Size(0));
+  EXPECT_EQ(0u, pyramid.Size(1));
+  EXPECT_EQ(0u, pyramid.Current(1).count);
+  pyramid.InsertData(-1.0);
+  EXPECT_DOUBLE_EQ(-1, pyramid.Current(0).min);
+}
+
+/////////////////////////////////////////////////
+TEST(SignalPyramidTest, NaN)
+{
+  SignalPyramid pyramid(8, 2, 1, 4);
+  std::vector<double> data = {1, NAN, 3, -2, NAN, 5, 0, 1};
+  pyramid.InsertData(data.data(), data.size());
+  ASSERT_EQ(1u, pyramid.Size(0));
+  const SignalBucket bucket = pyramid.Bucket(0, 0);
+  EXPECT_DOUBLE_EQ(-2, bucket.min);
+  EXPECT_DOUBLE_EQ(5, bucket.max);
+  EXPECT_TRUE(std::isnan(bucket.mean));
+}
+
+/////////////////////////////////////////////////
+TEST(SignalPyramidTest, Batch)
+{
+  Rand::Seed(7);
+  std::vector<double> data;
+  for (int i = 0; i < 10000; ++i)
+    data.push_back(Rand::DblNormal(0, 1));
+
+  SignalPyramid single(7, 4, 4, 50);
+  SignalPyramid batch(7, 4, 4, 50);
+  for (const double value : data)
+    single.InsertData(value);
+
+  // Blocks of varying sizes, across bucket boundaries
+  std::size_t start = 0;
+  for (std::size_t n = 0; start < data.size(); n = (n * 7 + 3) % 101)
+  {
+    const std::size_t count = std::min(n, data.size() - start);
+    batch.InsertData(data.data() + start, count);
+    start += count;
+  }
+  EXPECT_EQ(single.Count(), batch.Count());
+
+  std::vector<SignalBucket> expected(single.Capacity());
+  std::vector<SignalBucket> actual(batch.Capacity());
+  for (std::size_t l = 0; l < single.Levels(); ++l)
+  {
+    const std::size_t size = single.Export(l, expected.data());
+    ASSERT_EQ(size, batch.Export(l, actual.data()));
+    EXPECT_GT(size, 0u);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      EXPECT_DOUBLE_EQ(expected[i].min, actual[i].min);
+      EXPECT_DOUBLE_EQ(expected[i].max, actual[i].max);
+      EXPECT_NEAR(expected[i].mean, actual[i].mean, 1e-12);
+      EXPECT_EQ(single.BucketSize(l), actual[i].count);
+    }
+    EXPECT_EQ(single.Current(l).count, batch.Current(l).count);
+  }
+
+  // The newest bucket of the first level matches the samples
+  const std::size_t width = 7;
+  const std::size_t last = data.size() / width * width;
+  const SignalBucket bucket = batch.Bucket(0, batch.Size(0) - 1);
+  EXPECT_DOUBLE_EQ(*std::min_element(data.begin() + last - width,
+      data.begin() + last), bucket.min);
+  EXPECT_DOUBLE_EQ(*std::max_element(data.begin() + last - width,
+      data.begin() + last), bucket.max);
+}
@@ -14,14 +14,554 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <atomic>
+#include <cctype>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <mutex>
+#include <sstream>
+#include <typeinfo>
 #include <gz/math/SignalStats.hh>
+#include <gz/math/detail/ParallelFor.hh>
 #include "SignalStatsPrivate.hh"
 
 using namespace gz;
 using namespace math;
 
+namespace
+{
+/// \brief Number of independent accumulators of the block insertions. They
+/// break the dependency between consecutive samples so the loops can be
+/// vectorized without reassociating floating point math.
+constexpr size_t kLanes = 4;
+
+/// \brief Sum a function of a block of samples.
+/// \param[in] _data Pointer to the first sample.
+/// \param[in] _count Number of samples.
+/// \param[in] _f Function of a sample to sum.
+/// \return Sum of _f over the samples.
+template<typename F>
+double SumLanes(const double *_data, const size_t _count, F _f)
+{
+  double lanes[kLanes] = {0.0, 0.0, 0.0, 0.0};
+  size_t i = 0;
+  for (; i + kLanes <= _count; i += kLanes)
+  {
+    for (size_t lane = 0; lane < kLanes; ++lane)
+      lanes[lane] += _f(_data[i + lane]);
+  }
+  double sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+  for (; i < _count; ++i)
+    sum += _f(_data[i]);
+  return sum;
+}
+
+/// \brief Select the best value of a function of a block of samples, as
+/// a sequence of `value = better(f(x), value) ? f(x) : value` would. NaN
+/// values of f(x) are never selected.
+/// \param[in] _data Pointer to the first sample.
+/// \param[in] _count Number of samples.
+/// \param[in] _init Value before the block.
+/// \param[in] _f Function of a sample to select.
+/// \param[in] _better Whether its first argument is better than the second.
+/// \return Best value of _f over the samples, or _init.
+template<typename F, typename Better>
+double SelectLanes(const double *_data, const size_t _count,
+    const double _init, F _f, Better _better)
+{
+  double lanes[kLanes] = {_init, _init, _init, _init};
+  size_t i = 0;
+  for (; i + kLanes <= _count; i += kLanes)
+  {
+    for (size_t lane = 0; lane < kLanes; ++lane)
+    {
+      const double value = _f(_data[i + lane]);
+      lanes[lane] = _better(value, lanes[lane]) ? value : lanes[lane];
+    }
+  }
+  double best = _init;
+  for (const double lane : lanes)
+    best = _better(lane, best) ? lane : best;
+  for (; i < _count; ++i)
+  {
+    const double value = _f(_data[i]);
+    best = _better(value, best) ? value : best;
+  }
+  return best;
+}
+
+/// \brief Identity function of a sample.
+struct Identity
+{
+  double operator()(const double _x) const { return _x; }
+};
+
+/// \brief First bytes of a SignalStats snapshot, "GZSS" in little endian.
+constexpr uint32_t kSnapshotMagic = 0x53535a47;
+
+/// \brief Version of the snapshot layout.
+constexpr uint32_t kSnapshotVersion = 1;
+
+/// \brief Append the bytes of a value to a snapshot.
+/// \param[in,out] _buffer The snapshot.
+/// \param[in] _value The value.
+template<typename V>
+void Append(std::vector<uint8_t> &_buffer, const V &_value)
+{
+  const auto *bytes = reinterpret_cast<const uint8_t *>(&_value);
+  _buffer.insert(_buffer.end(), bytes, bytes + sizeof(V));
+}
+
+/// \brief Read the values of a snapshot in order, checking its size.
+class SnapshotReader
+{
+  /// \brief Constructor.
+  /// \param[in] _data Pointer to the snapshot.
+  /// \param[in] _size Number of bytes of the snapshot.
+  public: SnapshotReader(const uint8_t *_data, const size_t _size)
+    : data(_data), size(_size)
+  {
+  }
+
+  /// \brief Read a value.
+  /// \param[out] _value The value.
+  /// \return False if there are not enough bytes left.
+  public: template<typename V> bool Read(V &_value)
+  {
+    if (this->size < sizeof(V))
+      return false;
+    std::memcpy(&_value, this->data, sizeof(V));
+    this->Skip(sizeof(V));
+    return true;
+  }
+
+  /// \brief Read a block of bytes without copying it.
+  /// \param[in] _size Number of bytes.
+  /// \param[out] _block Pointer to the block.
+  /// \return False if there are not enough bytes left.
+  public: bool Block(const uint64_t _size, const uint8_t *&_block)
+  {
+    if (this->size < _size)
+      return false;
+    _block = this->data;
+    this->Skip(static_cast<size_t>(_size));
+    return true;
+  }
+
+  /// \brief Number of bytes left.
+  /// \return The number of bytes.
+  public: size_t Left() const
+  {
+    return this->size;
+  }
+
+  /// \brief Skip bytes.
+  /// \param[in] _size Number of bytes, at most Left().
+  private: void Skip(const size_t _size)
+  {
+    this->data += _size;
+    this->size -= _size;
+  }
+
+  /// \brief Next byte to read.
+  private: const uint8_t *data;
+
+  /// \brief Number of bytes left.
+  private: size_t size;
+};
+
+/// \brief Read the state saved by SignalStatistic::AppendSnapshot.
+/// \param[in,out] _reader Reader of the snapshot.
+/// \param[out] _state The state.
+/// \return False if the snapshot is too short.
+bool ReadState(SnapshotReader &_reader, SignalStatisticPrivate &_state)
+{
+  uint64_t count = 0;
+  if (!_reader.Read(_state.data) || !_reader.Read(_state.extraData) ||
+      !_reader.Read(count))
+  {
+    return false;
+  }
+  _state.count = static_cast<unsigned int>(count);
+  return true;
+}
+
+/// \brief A statistic in a SignalStats snapshot.
+struct SnapshotRecord
+{
+  /// \brief Short name of the statistic.
+  std::string name;
+
+  /// \brief State saved by SignalStatistic::AppendSnapshot.
+  const uint8_t *data;
+
+  /// \brief Number of bytes of the state.
+  size_t size;
+};
+
+/// \brief Split a SignalStats snapshot into its statistics.
+/// \param[in] _data Pointer to the snapshot.
+/// \param[in] _size Number of bytes of the snapshot.
+/// \param[out] _records The statistics.
+/// \return False if the snapshot is malformed.
+bool ReadRecords(const uint8_t *_data, const size_t _size,
+    std::vector<SnapshotRecord> &_records)
+{
+  SnapshotReader reader(_data, _size);
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  uint32_t count = 0;
+  if (!reader.Read(magic) || magic != kSnapshotMagic ||
+      !reader.Read(version) || version != kSnapshotVersion ||
+      !reader.Read(count) || count > reader.Left())
+  {
+    return false;
+  }
+
+  _records.resize(count);
+  for (auto &record : _records)
+  {
+    uint32_t nameSize = 0;
+    const uint8_t *name = nullptr;
+    uint64_t size = 0;
+    if (!reader.Read(nameSize) || !reader.Block(nameSize, name) ||
+        !reader.Read(size) || !reader.Block(size, record.data))
+    {
+      return false;
+    }
+    record.name.assign(reinterpret_cast<const char *>(name), nameSize);
+    record.size = static_cast<size_t>(size);
+  }
+  return reader.Left() == 0;
+}
+
+/// \brief Statistics of SignalStats.hh that can be merged and whose
+/// blocks of samples SignalStats inserts with vectorized loops.
+enum class StatisticType
+{
+  /// \brief Any other statistic, including subclasses of the ones below,
+  /// which may override InsertData.
+  OTHER,
+  MAXIMUM,
+  MAX_ABSOLUTE_VALUE,
+  MEAN,
+  MINIMUM,
+  ROOT_MEAN_SQUARE,
+  VARIANCE,
+  QUANTILE,
+  HISTOGRAM
+};
+
+/// \brief Get the type of a statistic.
+/// \param[in] _stat The statistic.
+/// \return The type, OTHER unless its class is exactly one of the
+/// StatisticType.
+StatisticType TypeOf(const SignalStatistic &_stat)
+{
+  const std::type_info &type = typeid(_stat);
+  if (type == typeid(SignalMaximum))
+    return StatisticType::MAXIMUM;
+  if (type == typeid(SignalMaxAbsoluteValue))
+    return StatisticType::MAX_ABSOLUTE_VALUE;
+  if (type == typeid(SignalMean))
+    return StatisticType::MEAN;
+  if (type == typeid(SignalMinimum))
+    return StatisticType::MINIMUM;
+  if (type == typeid(SignalRootMeanSquare))
+    return StatisticType::ROOT_MEAN_SQUARE;
+  if (type == typeid(SignalVariance))
+    return StatisticType::VARIANCE;
+  if (type == typeid(SignalQuantile))
+    return StatisticType::QUANTILE;
+  if (type == typeid(SignalHistogram))
+    return StatisticType::HISTOGRAM;
+  return StatisticType::OTHER;
+}
+
+/// \brief Insert a block of samples in a statistic with loops the compiler
+/// can vectorize, for the types whose whole state is a
+/// SignalStatisticPrivate. The result may differ from single insertions by
+/// rounding.
+/// \param[in] _type Type of the statistic.
+/// \param[in,out] _state State of the statistic.
+/// \param[in] _data Pointer to the first sample.
+/// \param[in] _count Number of samples.
+/// \return False if the type has more state, in which case nothing is
+/// inserted.
+bool InsertBlock(const StatisticType _type, SignalStatisticPrivate &_state,
+    const double *_data, const size_t _count)
+{
+  switch (_type)
+  {
+    case StatisticType::MAXIMUM:
+      if (_count == 0)
+        return true;
+      _state.data = SelectLanes(_data, _count,
+          _state.count == 0 ? _data[0] : _state.data, Identity(),
+          [](const double _a, const double _b) { return _a > _b; });
+      break;
+    case StatisticType::MINIMUM:
+      if (_count == 0)
+        return true;
+      _state.data = SelectLanes(_data, _count,
+          _state.count == 0 ? _data[0] : _state.data, Identity(),
+          [](const double _a, const double _b) { return _a < _b; });
+      break;
+    case StatisticType::MAX_ABSOLUTE_VALUE:
+      _state.data = SelectLanes(_data, _count, _state.data,
+          [](const double _x) { return std::abs(_x); },
+          [](const double _a, const double _b) { return _a > _b; });
+      break;
+    case StatisticType::MEAN:
+      _state.data += SumLanes(_data, _count, Identity());
+      break;
+    case StatisticType::ROOT_MEAN_SQUARE:
+      _state.data += SumLanes(_data, _count,
+          [](const double _x) { return _x * _x; });
+      break;
+    case StatisticType::VARIANCE:
+    {
+      if (_count == 0)
+        return true;
+
+      // Mean and M2 of the block in two passes, merged as in MergeState.
+      const double countB = static_cast<double>(_count);
+      const double meanB = SumLanes(_data, _count, Identity()) / countB;
+      const double m2B = SumLanes(_data, _count, [meanB](const double _x)
+      {
+        return (_x - meanB) * (_x - meanB);
+      });
+
+      const double countA = static_cast<double>(_state.count);
+      const double delta = meanB - _state.extraData;
+      const double count = countA + countB;
+      _state.extraData += delta * countB / count;
+      _state.data += m2B + delta * delta * countA * countB / count;
+      break;
+    }
+    default:
+      return false;
+  }
+  _state.count += static_cast<unsigned int>(_count);
+  return true;
+}
+
+/// \brief Merge the state of a statistic into another of the same type,
+/// for the types whose whole state is a SignalStatisticPrivate. Variances
+/// are merged with the parallel algorithm of Chan et al.
+/// wikipedia.org/wiki/Algorithms_for_calculating_variance#Parallel_algorithm
+/// \param[in] _type Type of both statistics.
+/// \param[in,out] _state State to merge into.
+/// \param[in] _other State to merge, which may be _state.
+/// \return False if the type has more state, in which case nothing is
+/// merged.
+bool MergeState(const StatisticType _type, SignalStatisticPrivate &_state,
+    const SignalStatisticPrivate &_other)
+{
+  switch (_type)
+  {
+    case StatisticType::MAXIMUM:
+      if (_other.count > 0 && (_state.count == 0 || _other.data > _state.data))
+        _state.data = _other.data;
+      break;
+    case StatisticType::MAX_ABSOLUTE_VALUE:
+      if (_other.data > _state.data)
+        _state.data = _other.data;
+      break;
+    case StatisticType::MEAN:
+    case StatisticType::ROOT_MEAN_SQUARE:
+      _state.data += _other.data;
+      break;
+    case StatisticType::MINIMUM:
+      if (_other.count > 0 && (_state.count == 0 || _other.data < _state.data))
+        _state.data = _other.data;
+      break;
+    case StatisticType::VARIANCE:
+    {
+      if (_other.count == 0)
+        return true;
+      const double countA = _state.count;
+      const double countB = _other.count;
+
+      // delta = mean_b - mean_a
+      const double delta = _other.extraData - _state.extraData;
+      const double count = countA + countB;
+
+      // mean = mean_a + delta * n_b / n
+      _state.extraData += delta * countB / count;
+
+      // M2 = M2_a + M2_b + delta^2 * n_a * n_b / n
+      _state.data += _other.data + delta * delta * countA * countB / count;
+      break;
+    }
+    default:
+      return false;
+  }
+  _state.count += _other.count;
+  return true;
+}
+
+/// \brief Merge a SignalQuantile into another.
+/// \param[in,out] _state Count of the statistic to merge into.
+/// \param[in,out] _digest Digest to merge into.
+/// \param[in] _otherState Count of the statistic to merge.
+/// \param[in] _other Digest to merge, which may be _digest.
+void MergeDigest(SignalStatisticPrivate &_state,
+    SignalQuantilePrivate &_digest, const SignalStatisticPrivate &_otherState,
+    const SignalQuantilePrivate &_other)
+{
+  if (_otherState.count == 0)
+    return;
+
+  // Copy the centroids first, _other may be _digest.
+  std::vector<SignalQuantilePrivate::Centroid> centroids = _other.centroids;
+  centroids.insert(centroids.end(), _other.buffer.begin(),
+                   _other.buffer.end());
+
+  if (_state.count == 0 || _other.min < _digest.min)
+    _digest.min = _other.min;
+  if (_state.count == 0 || _other.max > _digest.max)
+    _digest.max = _other.max;
+  for (const auto &centroid : centroids)
+    _digest.Add(centroid.mean, centroid.weight);
+  _state.count += _otherState.count;
+}
+
+/// \brief Merge a SignalHistogram into another with the same bins.
+/// \param[in,out] _state Count of the statistic to merge into.
+/// \param[in,out] _hist Histogram to merge into.
+/// \param[in] _otherState Count of the statistic to merge.
+/// \param[in] _other Histogram to merge, which may be _hist.
+/// \return False if the bins differ, in which case nothing is merged.
+bool MergeHistogram(SignalStatisticPrivate &_state,
+    SignalHistogramPrivate &_hist, const SignalStatisticPrivate &_otherState,
+    const SignalHistogramPrivate &_other)
+{
+  if (!_hist.SameRange(_other) || _hist.bins.size() != _other.bins.size())
+    return false;
+
+  for (size_t i = 0; i < _hist.bins.size(); ++i)
+    _hist.bins[i] += _other.bins[i];
+  _hist.underflow += _other.underflow;
+  _hist.overflow += _other.overflow;
+  _state.count += _otherState.count;
+  return true;
+}
+
+/// \brief Append a SignalQuantile digest to a snapshot, after the state
+/// of the statistic.
+/// \param[in,out] _buffer The snapshot.
+/// \param[in] _digest The digest.
+void AppendDigest(std::vector<uint8_t> &_buffer,
+    const SignalQuantilePrivate &_digest)
+{
+  Append(_buffer, _digest.min);
+  Append(_buffer, _digest.max);
+  Append(_buffer,
+      static_cast<uint64_t>(_digest.centroids.size() + _digest.buffer.size()));
+  for (const auto *centroids : {&_digest.centroids, &_digest.buffer})
+  {
+    for (const auto &centroid : *centroids)
+    {
+      Append(_buffer, centroid.mean);
+      Append(_buffer, centroid.weight);
+    }
+  }
+}
+
+/// \brief Merge a SignalQuantile digest saved by AppendDigest.
+/// \param[in,out] _state Count of the statistic to merge into.
+/// \param[in,out] _digest Digest to merge into.
+/// \param[in,out] _reader Reader of the snapshot, after the state.
+/// \param[in] _otherState Saved state of the statistic.
+/// \return False if the snapshot is malformed, in which case nothing is
+/// merged.
+bool MergeDigestSnapshot(SignalStatisticPrivate &_state,
+    SignalQuantilePrivate &_digest, SnapshotReader &_reader,
+    const SignalStatisticPrivate &_otherState)
+{
+  SignalQuantilePrivate other;
+  uint64_t count = 0;
+  if (!_reader.Read(other.min) || !_reader.Read(other.max) ||
+      !_reader.Read(count) ||
+      _reader.Left() != count * 2 * sizeof(double))
+  {
+    return false;
+  }
+  if (_otherState.count == 0)
+    return true;
+
+  if (_state.count == 0 || other.min < _digest.min)
+    _digest.min = other.min;
+  if (_state.count == 0 || other.max > _digest.max)
+    _digest.max = other.max;
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    SignalQuantilePrivate::Centroid centroid = {0, 0};
+    _reader.Read(centroid.mean);
+    _reader.Read(centroid.weight);
+    _digest.Add(centroid.mean, centroid.weight);
+  }
+  _state.count += _otherState.count;
+  return true;
+}
+
+/// \brief Append a SignalHistogram to a snapshot, after the state of the
+/// statistic.
+/// \param[in,out] _buffer The snapshot.
+/// \param[in] _hist The histogram.
+void AppendHistogram(std::vector<uint8_t> &_buffer,
+    const SignalHistogramPrivate &_hist)
+{
+  Append(_buffer, _hist.min);
+  Append(_buffer, _hist.max);
+  Append(_buffer, _hist.underflow);
+  Append(_buffer, _hist.overflow);
+  Append(_buffer, static_cast<uint64_t>(_hist.bins.size()));
+  const auto *bins = reinterpret_cast<const uint8_t *>(_hist.bins.data());
+  _buffer.insert(_buffer.end(), bins,
+      bins + _hist.bins.size() * sizeof(uint64_t));
+}
+
+/// \brief Merge a SignalHistogram saved by AppendHistogram into one with
+/// the same bins.
+/// \param[in,out] _state Count of the statistic to merge into.
+/// \param[in,out] _hist Histogram to merge into.
+/// \param[in,out] _reader Reader of the snapshot, after the state.
+/// \param[in] _otherState Saved state of the statistic.
+/// \return False if the snapshot is malformed or the bins differ, in
+/// which case nothing is merged.
+bool MergeHistogramSnapshot(SignalStatisticPrivate &_state,
+    SignalHistogramPrivate &_hist, SnapshotReader &_reader,
+    const SignalStatisticPrivate &_otherState)
+{
+  SignalHistogramPrivate other;
+  uint64_t bins = 0;
+  if (!_reader.Read(other.min) || !_reader.Read(other.max) ||
+      !_reader.Read(other.underflow) || !_reader.Read(other.overflow) ||
+      !_reader.Read(bins) || !_hist.SameRange(other) ||
+      bins != _hist.bins.size() ||
+      _reader.Left() != bins * sizeof(uint64_t))
+  {
+    return false;
+  }
+
+  for (auto &bin : _hist.bins)
+  {
+    uint64_t count = 0;
+    _reader.Read(count);
+    bin += count;
+  }
+  _hist.underflow += other.underflow;
+  _hist.overflow += other.overflow;
+  _state.count += _otherState.count;
+  return true;
+}
+}
+
 //////////////////////////////////////////////////
 SignalStatistic::SignalStatistic()
   : dataPtr(new SignalStatisticPrivate)
@@ -55,6 +595,80 @@ void SignalStatistic::Reset()
   this->dataPtr->count = 0;
 }
 
+//////////////////////////////////////////////////
+void SignalStatistic::InsertData(const double *_data, const size_t _count)
+{
+  for (size_t i = 0; i < _count; ++i)
+    this->InsertData(_data[i]);
+}
+
+//////////////////////////////////////////////////
+bool SignalStatistic::Merge(const SignalStatistic &_other)
+{
+  const StatisticType type = TypeOf(*this);
+  if (type != TypeOf(_other))
+    return false;
+
+  switch (type)
+  {
+    case StatisticType::QUANTILE:
+      MergeDigest(*this->dataPtr,
+          *static_cast<SignalQuantile *>(this)->quantilePtr, *_other.dataPtr,
+          *static_cast<const SignalQuantile &>(_other).quantilePtr);
+      return true;
+    case StatisticType::HISTOGRAM:
+      return MergeHistogram(*this->dataPtr,
+          *static_cast<SignalHistogram *>(this)->histogramPtr,
+          *_other.dataPtr,
+          *static_cast<const SignalHistogram &>(_other).histogramPtr);
+    default:
+      return MergeState(type, *this->dataPtr, *_other.dataPtr);
+  }
+}
+
+//////////////////////////////////////////////////
+void SignalStatistic::AppendSnapshot(std::vector<uint8_t> &_buffer) const
+{
+  Append(_buffer, this->dataPtr->data);
+  Append(_buffer, this->dataPtr->extraData);
+  Append(_buffer, static_cast<uint64_t>(this->dataPtr->count));
+  switch (TypeOf(*this))
+  {
+    case StatisticType::QUANTILE:
+      AppendDigest(_buffer,
+          *static_cast<const SignalQuantile *>(this)->quantilePtr);
+      break;
+    case StatisticType::HISTOGRAM:
+      AppendHistogram(_buffer,
+          *static_cast<const SignalHistogram *>(this)->histogramPtr);
+      break;
+    default:
+      break;
+  }
+}
+
+//////////////////////////////////////////////////
+bool SignalStatistic::MergeSnapshot(const uint8_t *_data, const size_t _size)
+{
+  SignalStatisticPrivate other;
+  SnapshotReader reader(_data, _size);
+  if (!ReadState(reader, other))
+    return false;
+
+  const StatisticType type = TypeOf(*this);
+  switch (type)
+  {
+    case StatisticType::QUANTILE:
+      return MergeDigestSnapshot(*this->dataPtr,
+          *static_cast<SignalQuantile *>(this)->quantilePtr, reader, other);
+    case StatisticType::HISTOGRAM:
+      return MergeHistogramSnapshot(*this->dataPtr,
+          *static_cast<SignalHistogram *>(this)->histogramPtr, reader, other);
+    default:
+      return reader.Left() == 0 && MergeState(type, *this->dataPtr, other);
+  }
+}
+
 //////////////////////////////////////////////////
 double SignalMaximum::Value() const
 {
@@ -204,6 +818,288 @@ void SignalVariance::InsertData(const double _data)
   this->dataPtr->data += delta * (_data - this->dataPtr->extraData);
 }
 
+//////////////////////////////////////////////////
+// The merging t-digest of Dunning and Ertl, with the k1 scale function
+// k(q) = compression / (2 pi) * asin(2q - 1). Neighboring samples are merged
+// into one centroid as long as its span of quantiles covers at most one unit
+// of k, which keeps centroids small near q = 0 and q = 1.
+void SignalQuantilePrivate::Add(const double _mean, const double _weight)
+{
+  this->buffer.push_back({_mean, _weight});
+  if (this->buffer.size() >=
+      static_cast<size_t>(5 * this->compression) + 10)
+  {
+    this->Compress();
+  }
+}
+
+//////////////////////////////////////////////////
+void SignalQuantilePrivate::Compress()
+{
+  if (this->buffer.empty())
+    return;
+
+  for (const auto &centroid : this->centroids)
+    this->buffer.push_back(centroid);
+  std::sort(this->buffer.begin(), this->buffer.end(),
+      [](const Centroid &_a, const Centroid &_b)
+      {
+        return _a.mean < _b.mean;
+      });
+
+  double total = 0;
+  for (const auto &centroid : this->buffer)
+    total += centroid.weight;
+
+  // Largest cumulative weight the current centroid may reach.
+  const double scale = this->compression / (2 * GZ_PI);
+  auto limit = [&](const double _weightSoFar)
+  {
+    const double q = _weightSoFar / total;
+    const double k = scale * std::asin(2 * q - 1) + 1;
+    if (k >= scale * GZ_PI / 2)
+      return total;
+    return total * (std::sin(k / scale) + 1) / 2;
+  };
+
+  this->centroids.clear();
+  Centroid current = this->buffer.front();
+  double weightSoFar = 0;
+  double weightLimit = limit(weightSoFar);
+  for (size_t i = 1; i < this->buffer.size(); ++i)
+  {
+    const Centroid &next = this->buffer[i];
+    if (weightSoFar + current.weight + next.weight <= weightLimit)
+    {
+      current.weight += next.weight;
+      current.mean += (next.mean - current.mean) * next.weight /
+        current.weight;
+    }
+    else
+    {
+      weightSoFar += current.weight;
+      this->centroids.push_back(current);
+      weightLimit = limit(weightSoFar);
+      current = next;
+    }
+  }
+  this->centroids.push_back(current);
+  this->buffer.clear();
+}
+
+//////////////////////////////////////////////////
+double SignalQuantilePrivate::Quantile(const double _quantile)
+{
+  this->Compress();
+  if (this->centroids.empty())
+    return 0;
+
+  double total = 0;
+  for (const auto &centroid : this->centroids)
+    total += centroid.weight;
+
+  // Interpolate linearly between the minimum at cumulative weight 0, the
+  // mean of each centroid at the middle of its weight, and the maximum at
+  // the total weight.
+  const double index = std::clamp(_quantile, 0.0, 1.0) * total;
+  double prevPosition = 0;
+  double prevValue = this->min;
+  double cumulative = 0;
+  for (const auto &centroid : this->centroids)
+  {
+    const double position = cumulative + centroid.weight / 2;
+    if (index <= position)
+    {
+      if (position <= prevPosition)
+        return centroid.mean;
+      return prevValue + (centroid.mean - prevValue) *
+        (index - prevPosition) / (position - prevPosition);
+    }
+    prevPosition = position;
+    prevValue = centroid.mean;
+    cumulative += centroid.weight;
+  }
+  if (total <= prevPosition)
+    return this->max;
+  return prevValue + (this->max - prevValue) *
+    (index - prevPosition) / (total - prevPosition);
+}
+
+//////////////////////////////////////////////////
+void SignalQuantilePrivate::Reset()
+{
+  this->centroids.clear();
+  this->buffer.clear();
+  this->min = 0;
+  this->max = 0;
+}
+
+//////////////////////////////////////////////////
+SignalQuantile::SignalQuantile(const double _quantile,
+                               const double _compression)
+  : quantilePtr(new SignalQuantilePrivate)
+{
+  this->quantilePtr->quantile = std::clamp(_quantile, 0.0, 1.0);
+  this->quantilePtr->compression = std::max(_compression, 1.0);
+}
+
+//////////////////////////////////////////////////
+SignalQuantile::SignalQuantile(const SignalQuantile &_sq)
+  : SignalStatistic(_sq), quantilePtr(_sq.quantilePtr->Clone())
+{
+}
+
+//////////////////////////////////////////////////
+SignalQuantile::~SignalQuantile()
+{
+}
+
+//////////////////////////////////////////////////
+double SignalQuantile::Value() const
+{
+  return this->Quantile(this->quantilePtr->quantile);
+}
+
+//////////////////////////////////////////////////
+std::string SignalQuantile::ShortName() const
+{
+  std::ostringstream name;
+  name << "p" << this->quantilePtr->quantile * 100;
+  return name.str();
+}
+
+//////////////////////////////////////////////////
+void SignalQuantile::InsertData(const double _data)
+{
+  if (this->dataPtr->count == 0 || _data < this->quantilePtr->min)
+    this->quantilePtr->min = _data;
+  if (this->dataPtr->count == 0 || _data > this->quantilePtr->max)
+    this->quantilePtr->max = _data;
+  this->quantilePtr->Add(_data, 1);
+  this->dataPtr->count++;
+}
+
+//////////////////////////////////////////////////
+void SignalQuantile::Reset()
+{
+  SignalStatistic::Reset();
+  this->quantilePtr->Reset();
+}
+
+//////////////////////////////////////////////////
+double SignalQuantile::Quantile(const double _quantile) const
+{
+  return this->quantilePtr->Quantile(_quantile);
+}
+
+//////////////////////////////////////////////////
+SignalHistogram::SignalHistogram(const double _min, const double _max,
+                                 const size_t _bins)
+  : histogramPtr(new SignalHistogramPrivate)
+{
+  this->histogramPtr->min = _min;
+  this->histogramPtr->max = _max > _min ? _max : _min + 1;
+  this->histogramPtr->bins.resize(std::max<size_t>(_bins, 1), 0);
+}
+
+//////////////////////////////////////////////////
+SignalHistogram::SignalHistogram(const SignalHistogram &_sh)
+  : SignalStatistic(_sh), histogramPtr(_sh.histogramPtr->Clone())
+{
+}
+
+//////////////////////////////////////////////////
+SignalHistogram::~SignalHistogram()
+{
+}
+
+//////////////////////////////////////////////////
+double SignalHistogram::Value() const
+{
+  return this->Quantile(0.5);
+}
+
+//////////////////////////////////////////////////
+std::string SignalHistogram::ShortName() const
+{
+  return "hist";
+}
+
+//////////////////////////////////////////////////
+void SignalHistogram::InsertData(const double _data)
+{
+  auto &hist = *this->histogramPtr;
+  if (_data < hist.min)
+  {
+    hist.underflow++;
+  }
+  else if (_data <= hist.max)
+  {
+    const size_t bin = static_cast<size_t>(
+      (_data - hist.min) / (hist.max - hist.min) * hist.bins.size());
+    hist.bins[std::min(bin, hist.bins.size() - 1)]++;
+  }
+  else
+  {
+    // Above the range, or NaN.
+    hist.overflow++;
+  }
+  this->dataPtr->count++;
+}
+
+//////////////////////////////////////////////////
+void SignalHistogram::Reset()
+{
+  SignalStatistic::Reset();
+  std::fill(this->histogramPtr->bins.begin(),
+            this->histogramPtr->bins.end(), 0);
+  this->histogramPtr->underflow = 0;
+  this->histogramPtr->overflow = 0;
+}
+
+//////////////////////////////////////////////////
+const std::vector<uint64_t> &SignalHistogram::Bins() const
+{
+  return this->histogramPtr->bins;
+}
+
+//////////////////////////////////////////////////
+uint64_t SignalHistogram::Underflow() const
+{
+  return this->histogramPtr->underflow;
+}
+
+//////////////////////////////////////////////////
+uint64_t SignalHistogram::Overflow() const
+{
+  return this->histogramPtr->overflow;
+}
+
+//////////////////////////////////////////////////
+double SignalHistogram::Quantile(const double _quantile) const
+{
+  const auto &hist = *this->histogramPtr;
+  if (this->dataPtr->count == 0)
+    return 0;
+
+  const double index =
+    std::clamp(_quantile, 0.0, 1.0) * this->dataPtr->count;
+  double cumulative = static_cast<double>(hist.underflow);
+  if (index <= cumulative)
+    return hist.min;
+
+  // Samples are assumed evenly spread within each bin.
+  const double width = (hist.max - hist.min) / hist.bins.size();
+  for (size_t i = 0; i < hist.bins.size(); ++i)
+  {
+    const double count = static_cast<double>(hist.bins[i]);
+    if (count > 0 && index <= cumulative + count)
+      return hist.min + width * (i + (index - cumulative) / count);
+    cumulative += count;
+  }
+  return hist.max;
+}
+
 //////////////////////////////////////////////////
 SignalStats::SignalStats()
   : dataPtr(new SignalStatsPrivate)
@@ -250,6 +1146,16 @@ void SignalStats::InsertData(const double _data)
   }
 }
 
+//////////////////////////////////////////////////
+void SignalStats::InsertData(const double *_data, const size_t _count)
+{
+  for (auto &statistic : this->dataPtr->stats)
+  {
+    if (!InsertBlock(TypeOf(*statistic), *statistic->dataPtr, _data, _count))
+      statistic->InsertData(_data, _count);
+  }
+}
+
 //////////////////////////////////////////////////
 bool SignalStats::InsertStatistic(const std::string &_name)
 {
@@ -291,6 +1197,23 @@ bool SignalStats::InsertStatistic(const std::string &_name)
   {
     stat.reset(new SignalVariance());
   }
+  else if (_name.size() > 1 && _name[0] == 'p' &&
+           (std::isdigit(static_cast<unsigned char>(_name[1])) ||
+            _name[1] == '.'))
+  {
+    // Percentile, such as "p50" or "p99.9".
+    char *end = nullptr;
+    const double percent = std::strtod(_name.c_str() + 1, &end);
+    if (*end != '\0' || !(percent > 0 && percent <= 100))
+    {
+      std::cerr << "Unable to InsertStatistic ["
+                << _name
+                << "] since the percentile is not in (0, 100]."
+                << std::endl;
+      return false;
+    }
+    stat.reset(new SignalQuantile(percent / 100));
+  }
   else
   {
     // Unrecognized name string
@@ -351,6 +1274,225 @@ void SignalStats::Reset()
   }
 }
 
+//////////////////////////////////////////////////
+bool SignalStats::Merge(const SignalStats &_other)
+{
+  // Match the statistics by name before merging any.
+  const auto &stats = this->dataPtr->stats;
+  const auto &otherStats = _other.dataPtr->stats;
+  if (stats.size() != otherStats.size())
+    return false;
+
+  std::vector<SignalStatisticPtr> matches;
+  for (const auto &statistic : stats)
+  {
+    const std::string name = statistic->ShortName();
+    auto match = std::find_if(otherStats.begin(), otherStats.end(),
+        [&name](const SignalStatisticPtr &_candidate)
+        {
+          return _candidate->ShortName() == name;
+        });
+    if (match == otherStats.end())
+      return false;
+    matches.push_back(*match);
+  }
+
+  bool result = true;
+  for (size_t i = 0; i < stats.size(); ++i)
+    result = stats[i]->Merge(*matches[i]) && result;
+  return result;
+}
+
+//////////////////////////////////////////////////
+size_t SignalStats::Snapshot(std::vector<uint8_t> &_buffer) const
+{
+  const size_t start = _buffer.size();
+  Append(_buffer, kSnapshotMagic);
+  Append(_buffer, kSnapshotVersion);
+  Append(_buffer, static_cast<uint32_t>(this->dataPtr->stats.size()));
+  for (const auto &statistic : this->dataPtr->stats)
+  {
+    const std::string name = statistic->ShortName();
+    Append(_buffer, static_cast<uint32_t>(name.size()));
+    _buffer.insert(_buffer.end(), name.begin(), name.end());
+
+    // The size of the state is known once it is written.
+    const size_t sizeOffset = _buffer.size();
+    Append(_buffer, uint64_t(0));
+    statistic->AppendSnapshot(_buffer);
+    const uint64_t size = _buffer.size() - sizeOffset - sizeof(uint64_t);
+    std::memcpy(_buffer.data() + sizeOffset, &size, sizeof(size));
+  }
+  return _buffer.size() - start;
+}
+
+//////////////////////////////////////////////////
+bool SignalStats::MergeSnapshot(const uint8_t *_data, const size_t _size)
+{
+  std::vector<SnapshotRecord> records;
+  const auto &stats = this->dataPtr->stats;
+  if (!ReadRecords(_data, _size, records) || records.size() != stats.size())
+    return false;
+
+  // Match the statistics by name before merging any, the snapshot of a
+  // collection with the same statistics usually has them in the same order.
+  std::vector<const SnapshotRecord *> matches;
+  for (size_t i = 0; i < stats.size(); ++i)
+  {
+    const std::string name = stats[i]->ShortName();
+    const SnapshotRecord *match = &records[i];
+    if (match->name != name)
+    {
+      auto it = std::find_if(records.begin(), records.end(),
+          [&name](const SnapshotRecord &_record)
+          {
+            return _record.name == name;
+          });
+      if (it == records.end())
+        return false;
+      match = &*it;
+    }
+    matches.push_back(match);
+  }
+
+  bool result = true;
+  for (size_t i = 0; i < stats.size(); ++i)
+  {
+    result = stats[i]->MergeSnapshot(matches[i]->data, matches[i]->size) &&
+      result;
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool SignalStats::RestoreSnapshot(const uint8_t *_data, const size_t _size)
+{
+  std::vector<SnapshotRecord> records;
+  if (!ReadRecords(_data, _size, records))
+    return false;
+
+  SignalStats restored;
+  for (const auto &record : records)
+  {
+    if (!restored.InsertStatistic(record.name) ||
+        !restored.dataPtr->stats.back()->MergeSnapshot(
+            record.data, record.size))
+    {
+      return false;
+    }
+  }
+  std::swap(this->dataPtr, restored.dataPtr);
+  return true;
+}
+
+//////////////////////////////////////////////////
+ShardedSignalStats::ShardedSignalStats(const size_t _shards)
+  : dataPtr(new ShardedSignalStatsPrivate)
+{
+  const size_t shards = _shards > 0 ? _shards : detail::ThreadCount(0);
+  for (size_t i = 0; i < shards; ++i)
+  {
+    this->dataPtr->shards.emplace_back(
+        new ShardedSignalStatsPrivate::Shard);
+  }
+}
+
+//////////////////////////////////////////////////
+ShardedSignalStats::~ShardedSignalStats()
+{
+}
+
+//////////////////////////////////////////////////
+bool ShardedSignalStats::InsertStatistic(const std::string &_name)
+{
+  std::lock_guard<std::mutex> namesLock(this->dataPtr->namesMutex);
+  bool result = true;
+  for (auto &shard : this->dataPtr->shards)
+  {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    result = shard->stats.InsertStatistic(_name) && result;
+  }
+  if (result)
+    this->dataPtr->names.push_back(_name);
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool ShardedSignalStats::InsertStatistics(const std::string &_names)
+{
+  std::lock_guard<std::mutex> namesLock(this->dataPtr->namesMutex);
+  bool result = true;
+  for (auto &shard : this->dataPtr->shards)
+  {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    result = shard->stats.InsertStatistics(_names) && result;
+  }
+
+  // Keep the names actually inserted, in order.
+  this->dataPtr->names.clear();
+  for (const auto &entry : this->dataPtr->shards.front()->stats.Map())
+    this->dataPtr->names.push_back(entry.first);
+  return result;
+}
+
+//////////////////////////////////////////////////
+void ShardedSignalStats::InsertData(const double _data)
+{
+  // Each thread gets an index the first time it inserts data, and always
+  // uses the same shard afterwards.
+  static std::atomic<size_t> nextThread{0};
+  thread_local const size_t thread = nextThread++;
+
+  auto &shard = *this->dataPtr->shards[thread % this->dataPtr->shards.size()];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  shard.stats.InsertData(_data);
+}
+
+//////////////////////////////////////////////////
+SignalStats ShardedSignalStats::Merged() const
+{
+  SignalStats merged;
+  {
+    std::lock_guard<std::mutex> namesLock(this->dataPtr->namesMutex);
+    for (const auto &name : this->dataPtr->names)
+      merged.InsertStatistic(name);
+  }
+  for (auto &shard : this->dataPtr->shards)
+  {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    merged.Merge(shard->stats);
+  }
+  return merged;
+}
+
+//////////////////////////////////////////////////
+size_t ShardedSignalStats::Count() const
+{
+  size_t count = 0;
+  for (auto &shard : this->dataPtr->shards)
+  {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    count += shard->stats.Count();
+  }
+  return count;
+}
+
+//////////////////////////////////////////////////
+std::map<std::string, double> ShardedSignalStats::Map() const
+{
+  return this->Merged().Map();
+}
+
+//////////////////////////////////////////////////
+void ShardedSignalStats::Reset()
+{
+  for (auto &shard : this->dataPtr->shards)
+  {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    shard->stats.Reset();
+  }
+}
+
 //////////////////////////////////////////////////
 SignalStats &SignalStats::operator=(const SignalStats &_s)
 {
@@ -17,10 +17,16 @@
 #ifndef GZ_MATH_SIGNALSTATSPRIVATE_HH_
 #define GZ_MATH_SIGNALSTATSPRIVATE_HH_
 
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
+#include <gz/math/SignalStats.hh>
 #include <gz/math/config.hh>
 
+#include <gz/utils/SuppressWarning.hh>
+
 namespace gz
 {
   namespace math
@@ -50,6 +56,104 @@ namespace gz
       }
     };
 
+    /// \brief Private data class for the SignalQuantile class: a merging
+    /// t-digest.
+    class SignalQuantilePrivate
+    {
+      /// \brief A cluster of samples.
+      public: struct Centroid
+      {
+        /// \brief Mean of the samples.
+        double mean;
+
+        /// \brief Number of samples.
+        double weight;
+      };
+
+      /// \brief Add samples to the buffer, compressing it when full.
+      /// \param[in] _mean Mean of the samples.
+      /// \param[in] _weight Number of samples.
+      public: void Add(const double _mean, const double _weight);
+
+      /// \brief Merge the buffered samples into the centroids.
+      public: void Compress();
+
+      /// \brief Estimate a quantile.
+      /// \param[in] _quantile Quantile in [0, 1].
+      /// \return The estimate, 0 if there are no samples.
+      public: double Quantile(const double _quantile);
+
+      /// \brief Forget all the samples.
+      public: void Reset();
+
+      /// \brief Quantile reported by SignalQuantile::Value.
+      public: double quantile = 0.5;
+
+      /// \brief Compression parameter of the digest.
+      public: double compression = 100;
+
+      /// \brief Centroids sorted by mean.
+      public: std::vector<Centroid> centroids;
+
+      /// \brief Samples not merged into the centroids yet.
+      public: std::vector<Centroid> buffer;
+
+      /// \brief Smallest sample.
+      public: double min = 0;
+
+      /// \brief Largest sample.
+      public: double max = 0;
+
+      /// \brief Clone the SignalQuantilePrivate object. Used for implementing
+      /// copy semantics.
+      public: std::unique_ptr<SignalQuantilePrivate> Clone() const
+      {
+        std::unique_ptr<SignalQuantilePrivate> dataPtr(
+            new SignalQuantilePrivate(*this));
+        return dataPtr;
+      }
+    };
+
+    /// \brief Private data class for the SignalHistogram class.
+    class SignalHistogramPrivate
+    {
+      /// \brief Lower bound of the first bin.
+      public: double min = 0;
+
+      /// \brief Upper bound of the last bin.
+      public: double max = 1;
+
+      /// \brief Number of samples in each bin.
+      public: std::vector<uint64_t> bins;
+
+      /// \brief Number of samples below min.
+      public: uint64_t underflow = 0;
+
+      /// \brief Number of samples above max, or NaN.
+      public: uint64_t overflow = 0;
+
+      /// \brief Check whether another histogram has the same range, so
+      /// that its bins cover the same values. The bounds are compared
+      /// exactly, since they are only equal when set to the same values.
+      /// \param[in] _other The other histogram.
+      /// \return True if both ranges are the same.
+      public: bool SameRange(const SignalHistogramPrivate &_other) const
+      {
+        GZ_UTILS_WARN_IGNORE__FLOAT_EQUAL
+        return this->min == _other.min && this->max == _other.max;
+        GZ_UTILS_WARN_RESUME__FLOAT_EQUAL
+      }
+
+      /// \brief Clone the SignalHistogramPrivate object. Used for
+      /// implementing copy semantics.
+      public: std::unique_ptr<SignalHistogramPrivate> Clone() const
+      {
+        std::unique_ptr<SignalHistogramPrivate> dataPtr(
+            new SignalHistogramPrivate(*this));
+        return dataPtr;
+      }
+    };
+
     class SignalStatistic;
 
     /// \def SignalStatisticPtr
@@ -75,6 +179,30 @@ namespace gz
         return dataPtr;
       }
     };
+
+    /// \brief Private data class for the ShardedSignalStats class.
+    class ShardedSignalStatsPrivate
+    {
+      /// \brief Statistics of the samples inserted by some threads, on
+      /// their own cache line.
+      public: struct alignas(64) Shard
+      {
+        /// \brief Taken by the producers of the shard and by readers.
+        std::mutex mutex;
+
+        /// \brief The statistics.
+        SignalStats stats;
+      };
+
+      /// \brief The shards.
+      public: std::vector<std::unique_ptr<Shard>> shards;
+
+      /// \brief Names of the statistics inserted in every shard.
+      public: std::vector<std::string> names;
+
+      /// \brief Protects names.
+      public: std::mutex namesMutex;
+    };
     }
   }
 }
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <gz/math/Rand.hh>
+#include <gz/math/SignalStats.hh>
+#include <gz/math/SignalStatsT.hh>
+
+using namespace gz;
+
+using AllStats = math::SignalStatsT<math::stats::Max, math::stats::MaxAbs,
+  math::stats::Mean, math::stats::Min, math::stats::Rms, math::stats::Var>;
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTTest, Empty)
+{
+  AllStats stats;
+  EXPECT_EQ(0u, stats.Count());
+  const auto map = stats.Map();
+  EXPECT_EQ(6u, map.size());
+  for (const auto &[name, value] : map)
+    EXPECT_DOUBLE_EQ(0.0, value) << name;
+
+  // A single sample.
+  stats.InsertData(-2.0);
+  EXPECT_EQ(1u, stats.Count());
+  EXPECT_DOUBLE_EQ(-2.0, stats.Value<math::stats::Max>());
+  EXPECT_DOUBLE_EQ(2.0, stats.Value<math::stats::MaxAbs>());
+  EXPECT_DOUBLE_EQ(-2.0, stats.Value<math::stats::Mean>());
+  EXPECT_DOUBLE_EQ(-2.0, stats.Value<math::stats::Min>());
+  EXPECT_DOUBLE_EQ(2.0, stats.Value<math::stats::Rms>());
+  EXPECT_DOUBLE_EQ(0.0, stats.Value<math::stats::Var>());
+
+  stats.Reset();
+  EXPECT_EQ(0u, stats.Count());
+  EXPECT_DOUBLE_EQ(0.0, stats.Value<math::stats::Max>());
+  EXPECT_DOUBLE_EQ(0.0, stats.Value<math::stats::Mean>());
+}
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTTest, SameAsSignalStats)
+{
+  math::Rand::Seed(4);
+  std::vector<double> data;
+  for (int i = 0; i < 1003; ++i)
+    data.push_back(math::Rand::DblNormal(3.0, 2.0));
+
+  math::SignalStats runtime;
+  EXPECT_TRUE(runtime.InsertStatistics("max,maxAbs,mean,min,rms,var"));
+
+  // Mix single and batch insertions, starting batches at every lane.
+  AllStats single;
+  AllStats batch;
+  for (size_t i = 0; i < data.size(); ++i)
+  {
+    runtime.InsertData(data[i]);
+    single.InsertData(data[i]);
+  }
+  size_t begin = 0;
+  for (size_t size = 1; begin < data.size(); ++size)
+  {
+    const size_t count = std::min(size, data.size() - begin);
+    batch.InsertData(data.data() + begin, count);
+    begin += count;
+  }
+
+  EXPECT_EQ(data.size(), single.Count());
+  EXPECT_EQ(data.size(), batch.Count());
+
+  const auto expected = runtime.Map();
+  const auto singleMap = single.Map();
+  const auto batchMap = batch.Map();
+  ASSERT_EQ(expected.size(), singleMap.size());
+  for (const auto &[name, value] : expected)
+  {
+    EXPECT_NEAR(value, singleMap.at(name), 1e-12) << name;
+    EXPECT_NEAR(value, batchMap.at(name), 1e-12) << name;
+  }
+  EXPECT_DOUBLE_EQ(expected.at("var"), batch.Value<math::stats::Var>());
+
+  // A vector of samples, after a reset.
+  batch.Reset();
+  batch.InsertData(data);
+  EXPECT_EQ(data.size(), batch.Count());
+  EXPECT_NEAR(expected.at("rms"), batch.Value<math::stats::Rms>(), 1e-12);
+}
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTTest, Subset)
+{
+  math::SignalStatsT<math::stats::Mean, math::stats::Var> stats;
+  const std::vector<double> data = {1, 2, 3, 4, 5, 6, 7};
+  stats.InsertData(data);
+  EXPECT_DOUBLE_EQ(4.0, stats.Value<math::stats::Mean>());
+  EXPECT_DOUBLE_EQ(28.0 / 6.0, stats.Value<math::stats::Var>());
+
+  const auto map = stats.Map();
+  EXPECT_EQ(2u, map.size());
+  EXPECT_DOUBLE_EQ(4.0, map.at("mean"));
+}
@@ -17,6 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <gz/math/Rand.hh>
 #include <gz/math/SignalStats.hh>
 
@@ -472,6 +477,134 @@ TEST(SignalStatsTest, SignalVarianceRandomValues)
   EXPECT_EQ(var.Count(), 0u);
 }
 
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, SignalQuantile)
+{
+  {
+    // Constructor
+    math::SignalQuantile median;
+    EXPECT_DOUBLE_EQ(median.Value(), 0.0);
+    EXPECT_EQ(median.Count(), 0u);
+    EXPECT_EQ(median.ShortName(), std::string("p50"));
+    EXPECT_EQ(math::SignalQuantile(0.95).ShortName(), std::string("p95"));
+    EXPECT_EQ(math::SignalQuantile(0.999).ShortName(), std::string("p99.9"));
+    EXPECT_EQ(math::SignalQuantile(2.0).ShortName(), std::string("p100"));
+  }
+
+  {
+    // Few samples are exact
+    math::SignalQuantile median;
+    for (const double value : {5.0, 1.0, 4.0, 2.0, 3.0})
+      median.InsertData(value);
+    EXPECT_EQ(median.Count(), 5u);
+    EXPECT_DOUBLE_EQ(median.Value(), 3.0);
+    EXPECT_DOUBLE_EQ(median.Quantile(0.0), 1.0);
+    EXPECT_DOUBLE_EQ(median.Quantile(1.0), 5.0);
+    EXPECT_DOUBLE_EQ(median.Quantile(0.3), 2.0);
+
+    // Copy
+    math::SignalQuantile copy(median);
+    EXPECT_EQ(copy.Count(), 5u);
+    EXPECT_DOUBLE_EQ(copy.Value(), 3.0);
+    copy.InsertData(10.0);
+    EXPECT_EQ(median.Count(), 5u);
+
+    // Reset
+    median.Reset();
+    EXPECT_EQ(median.Count(), 0u);
+    EXPECT_DOUBLE_EQ(median.Value(), 0.0);
+  }
+
+  {
+    // Many uniform samples, in random order
+    math::Rand::Seed(3);
+    math::SignalQuantile p99(0.99);
+    math::SignalQuantile first(0.99);
+    math::SignalQuantile second(0.99);
+    const int count = 100000;
+    for (int i = 0; i < count; ++i)
+    {
+      const double value = math::Rand::DblUniform(0, 1000);
+      p99.InsertData(value);
+      if (i % 2)
+        first.InsertData(value);
+      else
+        second.InsertData(value);
+    }
+    EXPECT_EQ(p99.Count(), static_cast<size_t>(count));
+    EXPECT_NEAR(p99.Value(), 990.0, 2.0);
+    EXPECT_NEAR(p99.Quantile(0.5), 500.0, 5.0);
+    EXPECT_NEAR(p99.Quantile(0.95), 950.0, 3.0);
+    EXPECT_NEAR(p99.Quantile(0.001), 1.0, 1.0);
+
+    // Merge two halves
+    first.Merge(second);
+    EXPECT_EQ(first.Count(), static_cast<size_t>(count));
+    EXPECT_NEAR(first.Value(), 990.0, 2.0);
+    EXPECT_NEAR(first.Quantile(0.5), 500.0, 5.0);
+    EXPECT_DOUBLE_EQ(first.Quantile(0.0), p99.Quantile(0.0));
+    EXPECT_DOUBLE_EQ(first.Quantile(1.0), p99.Quantile(1.0));
+
+    // Merge into an empty digest
+    math::SignalQuantile empty(0.99);
+    empty.Merge(first);
+    EXPECT_EQ(empty.Count(), static_cast<size_t>(count));
+    EXPECT_NEAR(empty.Value(), 990.0, 2.0);
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, SignalHistogram)
+{
+  math::SignalHistogram hist(0.0, 10.0, 10);
+  EXPECT_EQ(hist.ShortName(), std::string("hist"));
+  EXPECT_EQ(hist.Count(), 0u);
+  EXPECT_DOUBLE_EQ(hist.Value(), 0.0);
+  ASSERT_EQ(hist.Bins().size(), 10u);
+
+  for (int i = 0; i < 100; ++i)
+    hist.InsertData(i * 0.1);
+  hist.InsertData(10.0);
+  hist.InsertData(-1.0);
+  hist.InsertData(11.0);
+  hist.InsertData(std::nan(""));
+  EXPECT_EQ(hist.Count(), 104u);
+  for (size_t i = 0; i < 9; ++i)
+    EXPECT_EQ(hist.Bins()[i], 10u) << i;
+  // The upper bound is in the last bin.
+  EXPECT_EQ(hist.Bins()[9], 11u);
+  EXPECT_EQ(hist.Underflow(), 1u);
+  EXPECT_EQ(hist.Overflow(), 2u);
+  EXPECT_NEAR(hist.Value(), 5.0, 0.1);
+  EXPECT_DOUBLE_EQ(hist.Quantile(0.0), 0.0);
+  EXPECT_DOUBLE_EQ(hist.Quantile(1.0), 10.0);
+
+  // Merge
+  math::SignalHistogram copy(hist);
+  EXPECT_TRUE(copy.Merge(hist));
+  EXPECT_EQ(copy.Count(), 208u);
+  EXPECT_EQ(copy.Bins()[0], 20u);
+  EXPECT_EQ(copy.Underflow(), 2u);
+  EXPECT_EQ(hist.Bins()[0], 10u);
+  EXPECT_FALSE(copy.Merge(math::SignalHistogram(0.0, 10.0, 5)));
+  EXPECT_FALSE(copy.Merge(math::SignalHistogram(0.0, 5.0, 10)));
+  EXPECT_EQ(copy.Count(), 208u);
+
+  // Reset
+  hist.Reset();
+  EXPECT_EQ(hist.Count(), 0u);
+  EXPECT_EQ(hist.Bins()[9], 0u);
+  EXPECT_EQ(hist.Underflow(), 0u);
+  EXPECT_EQ(hist.Overflow(), 0u);
+  EXPECT_EQ(hist.Bins().size(), 10u);
+
+  // Invalid range and bins
+  math::SignalHistogram invalid(1.0, 1.0, 0);
+  EXPECT_EQ(invalid.Bins().size(), 1u);
+  invalid.InsertData(1.5);
+  EXPECT_EQ(invalid.Bins()[0], 1u);
+}
+
 //////////////////////////////////////////////////
 TEST(SignalStatsTest, SignalStats)
 {
@@ -520,6 +653,11 @@ TEST(SignalStatsTest, SignalStats)
     EXPECT_FALSE(stats.Map().empty());
 
     EXPECT_FALSE(stats.InsertStatistic("FakeStatistic"));
+    EXPECT_FALSE(stats.InsertStatistic("p"));
+    EXPECT_FALSE(stats.InsertStatistic("p0"));
+    EXPECT_FALSE(stats.InsertStatistic("p101"));
+    EXPECT_FALSE(stats.InsertStatistic("p50x"));
+    EXPECT_FALSE(stats.InsertStatistic("pfoo"));
 
     // Map with no data
     std::map<std::string, double> map = stats.Map();
@@ -639,3 +777,285 @@ TEST(SignalStatsTest, SignalStats)
   }
 }
 
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, SignalStatsPercentiles)
+{
+  math::SignalStats stats;
+  EXPECT_TRUE(stats.InsertStatistics("p50,p95,p99"));
+  EXPECT_FALSE(stats.InsertStatistic("p95"));
+
+  for (int i = 1; i <= 1000; ++i)
+    stats.InsertData(i);
+
+  auto map = stats.Map();
+  EXPECT_EQ(map.size(), 3u);
+  EXPECT_NEAR(map["p50"], 500.0, 1.0);
+  EXPECT_NEAR(map["p95"], 950.0, 1.0);
+  EXPECT_NEAR(map["p99"], 990.0, 1.0);
+
+  EXPECT_TRUE(stats.InsertStatistic("p99.9"));
+  EXPECT_EQ(stats.Map().count("p99.9"), 1u);
+}
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, Merge)
+{
+  math::Rand::Seed(8);
+  std::vector<double> data;
+  for (int i = 0; i < 1000; ++i)
+    data.push_back(math::Rand::DblNormal(-1.0, 3.0));
+
+  const std::string names = "max,maxAbs,mean,min,rms,var,p90";
+  math::SignalStats all;
+  math::SignalStats first;
+  math::SignalStats second;
+  math::SignalStats empty;
+  EXPECT_TRUE(all.InsertStatistics(names));
+  EXPECT_TRUE(first.InsertStatistics(names));
+  EXPECT_TRUE(second.InsertStatistics(names));
+  EXPECT_TRUE(empty.InsertStatistics(names));
+  for (size_t i = 0; i < data.size(); ++i)
+  {
+    all.InsertData(data[i]);
+    (i < 300 ? first : second).InsertData(data[i]);
+  }
+
+  EXPECT_TRUE(first.Merge(second));
+  EXPECT_TRUE(first.Merge(empty));
+  EXPECT_TRUE(empty.Merge(first));
+  EXPECT_EQ(all.Count(), first.Count());
+  EXPECT_EQ(all.Count(), empty.Count());
+  const auto expected = all.Map();
+  for (const auto &merged : {first.Map(), empty.Map()})
+  {
+    ASSERT_EQ(expected.size(), merged.size());
+    for (const auto &[name, value] : expected)
+    {
+      const double tolerance = name == "p90" ? 0.05 : 1e-9;
+      EXPECT_NEAR(value, merged.at(name), tolerance) << name;
+    }
+  }
+
+  // Different statistics
+  math::SignalStats other;
+  EXPECT_TRUE(other.InsertStatistics("max,mean"));
+  other.InsertData(1.0);
+  EXPECT_FALSE(first.Merge(other));
+  EXPECT_EQ(all.Count(), first.Count());
+
+  // Different types of statistic
+  math::SignalMean mean;
+  math::SignalMaximum max;
+  mean.InsertData(2.0);
+  EXPECT_FALSE(max.Merge(mean));
+  EXPECT_EQ(max.Count(), 0u);
+
+  // Merge with itself
+  math::SignalVariance var;
+  for (const double value : {1.0, 2.0, 3.0, 4.0})
+    var.InsertData(value);
+  EXPECT_TRUE(var.Merge(var));
+  EXPECT_EQ(var.Count(), 8u);
+  EXPECT_DOUBLE_EQ(var.Value(), 10.0 / 7.0);
+
+  math::SignalQuantile median;
+  for (const double value : {1.0, 2.0, 3.0})
+    median.InsertData(value);
+  EXPECT_TRUE(median.Merge(median));
+  EXPECT_EQ(median.Count(), 6u);
+  EXPECT_DOUBLE_EQ(median.Value(), 2.0);
+}
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, InsertBlock)
+{
+  math::Rand::Seed(7);
+  std::vector<double> data;
+  for (int i = 0; i < 1003; ++i)
+    data.push_back(math::Rand::DblNormal(2.0, 3.0));
+
+  // Blocks of every length up to a few lanes, then a long one, after some
+  // samples inserted one by one.
+  const std::string names = "max,maxAbs,mean,min,rms,var,p50";
+  math::SignalStats single;
+  math::SignalStats block;
+  EXPECT_TRUE(single.InsertStatistics(names));
+  EXPECT_TRUE(block.InsertStatistics(names));
+  size_t start = 0;
+  for (size_t count = 0; count < 10; ++count)
+  {
+    block.InsertData(data.data() + start, count);
+    start += count;
+  }
+  block.InsertData(data.data() + start, data.size() - start);
+  for (const double value : data)
+    single.InsertData(value);
+
+  EXPECT_EQ(block.Count(), data.size());
+  auto expected = single.Map();
+  auto map = block.Map();
+  ASSERT_EQ(map.size(), expected.size());
+  for (const auto &[name, value] : expected)
+    EXPECT_NEAR(map[name], value, 1e-12 * std::abs(value)) << name;
+
+  // A block of one statistic, starting empty.
+  math::SignalMinimum min;
+  min.InsertData(data.data(), 0);
+  EXPECT_EQ(min.Count(), 0u);
+  const double values[] = {4.0, -1.0, 3.0, -2.0, 5.0};
+  min.InsertData(values, 5);
+  EXPECT_EQ(min.Count(), 5u);
+  EXPECT_DOUBLE_EQ(min.Value(), -2.0);
+
+  // NaN values are skipped by max and min, except as first sample.
+  const double nanValues[] = {1.0, math::NAN_D, 3.0, math::NAN_D, 2.0};
+  math::SignalMaximum max;
+  max.InsertData(nanValues, 5);
+  EXPECT_DOUBLE_EQ(max.Value(), 3.0);
+  math::SignalStats extrema;
+  EXPECT_TRUE(extrema.InsertStatistics("max,min"));
+  extrema.InsertData(nanValues, 5);
+  EXPECT_DOUBLE_EQ(extrema.Map()["max"], 3.0);
+  EXPECT_DOUBLE_EQ(extrema.Map()["min"], 1.0);
+
+  // The statistics without a block insertion insert samples one by one.
+  math::SignalHistogram hist(0.0, 10.0, 10);
+  hist.InsertData(values, 5);
+  EXPECT_EQ(hist.Count(), 5u);
+  EXPECT_EQ(hist.Underflow(), 2u);
+}
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, ShardedSignalStats)
+{
+  math::ShardedSignalStats stats(3);
+  EXPECT_EQ(stats.Count(), 0u);
+  EXPECT_TRUE(stats.Map().empty());
+  EXPECT_TRUE(stats.InsertStatistics("max,mean,min"));
+  EXPECT_TRUE(stats.InsertStatistic("var"));
+  EXPECT_FALSE(stats.InsertStatistic("mean"));
+  EXPECT_FALSE(stats.InsertStatistic("FakeStatistic"));
+  EXPECT_EQ(stats.Map().size(), 4u);
+
+  // Producers on more threads than shards.
+  const int threads = 5;
+  const int samples = 10000;
+  std::vector<std::thread> producers;
+  for (int t = 0; t < threads; ++t)
+  {
+    producers.emplace_back([&stats, t]()
+    {
+      for (int i = 0; i < samples; ++i)
+        stats.InsertData(t * samples + i);
+    });
+  }
+  for (auto &producer : producers)
+    producer.join();
+
+  const double count = threads * samples;
+  EXPECT_EQ(stats.Count(), static_cast<size_t>(count));
+  auto map = stats.Map();
+  EXPECT_EQ(map.size(), 4u);
+  EXPECT_DOUBLE_EQ(map["min"], 0.0);
+  EXPECT_DOUBLE_EQ(map["max"], count - 1);
+  EXPECT_DOUBLE_EQ(map["mean"], (count - 1) / 2);
+  EXPECT_NEAR(map["var"], count * (count + 1) / 12, 1e-6 * count * count);
+
+  math::SignalStats merged = stats.Merged();
+  EXPECT_EQ(merged.Count(), static_cast<size_t>(count));
+
+  stats.Reset();
+  EXPECT_EQ(stats.Count(), 0u);
+  EXPECT_EQ(stats.Map().size(), 4u);
+
+  // Default number of shards
+  math::ShardedSignalStats defaultStats;
+  EXPECT_TRUE(defaultStats.InsertStatistic("mean"));
+  defaultStats.InsertData(4.0);
+  EXPECT_DOUBLE_EQ(defaultStats.Map()["mean"], 4.0);
+}
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, Snapshot)
+{
+  math::Rand::Seed(9);
+  std::vector<double> data;
+  for (int i = 0; i < 1000; ++i)
+    data.push_back(math::Rand::DblNormal(2.0, 0.5));
+
+  const std::string names = "max,maxAbs,mean,min,rms,var,p90";
+  math::SignalStats all;
+  math::SignalStats first;
+  math::SignalStats second;
+  EXPECT_TRUE(all.InsertStatistics(names));
+  EXPECT_TRUE(first.InsertStatistics(names));
+  // The statistics may be in another order
+  EXPECT_TRUE(second.InsertStatistics("p90,var,rms,min,mean,maxAbs,max"));
+  all.InsertData(data.data(), data.size());
+  first.InsertData(data.data(), 400);
+  second.InsertData(data.data() + 400, data.size() - 400);
+
+  std::vector<uint8_t> buffer;
+  const size_t size = second.Snapshot(buffer);
+  EXPECT_EQ(buffer.size(), size);
+  EXPECT_TRUE(first.MergeSnapshot(buffer.data(), buffer.size()));
+  EXPECT_EQ(all.Count(), first.Count());
+
+  math::SignalStats restored;
+  EXPECT_TRUE(restored.InsertStatistic("mean"));
+  const size_t offset = buffer.size();
+  const size_t firstSize = first.Snapshot(buffer);
+  EXPECT_EQ(offset + firstSize, buffer.size());
+  EXPECT_TRUE(restored.RestoreSnapshot(buffer.data() + offset,
+      buffer.size() - offset));
+  EXPECT_EQ(all.Count(), restored.Count());
+
+  const auto expected = all.Map();
+  for (const auto &merged : {first.Map(), restored.Map()})
+  {
+    ASSERT_EQ(expected.size(), merged.size());
+    for (const auto &[name, value] : expected)
+    {
+      const double tolerance = name == "p90" ? 0.05 : 1e-9;
+      EXPECT_NEAR(value, merged.at(name), tolerance) << name;
+    }
+  }
+
+  // Malformed snapshots and different statistics leave the data unchanged
+  EXPECT_FALSE(first.MergeSnapshot(buffer.data(), offset - 1));
+  EXPECT_FALSE(first.MergeSnapshot(buffer.data(), offset + 1));
+  EXPECT_FALSE(first.MergeSnapshot(nullptr, 0));
+  EXPECT_FALSE(restored.RestoreSnapshot(buffer.data() + 1, offset - 1));
+  math::SignalStats other;
+  EXPECT_TRUE(other.InsertStatistics("max,mean"));
+  other.InsertData(1.0);
+  std::vector<uint8_t> otherBuffer;
+  other.Snapshot(otherBuffer);
+  EXPECT_FALSE(first.MergeSnapshot(otherBuffer.data(), otherBuffer.size()));
+  EXPECT_EQ(all.Count(), first.Count());
+  EXPECT_EQ(all.Count(), restored.Count());
+
+  // Statistics
+  math::SignalHistogram hist(0.0, 4.0, 8);
+  math::SignalHistogram histCopy(0.0, 4.0, 8);
+  hist.InsertData(data.data(), data.size());
+  std::vector<uint8_t> histBuffer;
+  hist.AppendSnapshot(histBuffer);
+  EXPECT_TRUE(histCopy.MergeSnapshot(histBuffer.data(), histBuffer.size()));
+  EXPECT_EQ(hist.Bins(), histCopy.Bins());
+  EXPECT_EQ(hist.Count(), histCopy.Count());
+  math::SignalHistogram histOther(0.0, 4.0, 9);
+  EXPECT_FALSE(histOther.MergeSnapshot(histBuffer.data(),
+      histBuffer.size()));
+  EXPECT_EQ(0u, histOther.Count());
+
+  math::SignalMean mean;
+  EXPECT_FALSE(mean.MergeSnapshot(histBuffer.data(), histBuffer.size()));
+  mean.InsertData(3.0);
+  std::vector<uint8_t> meanBuffer;
+  mean.AppendSnapshot(meanBuffer);
+  EXPECT_EQ(24u, meanBuffer.size());
+  EXPECT_TRUE(mean.MergeSnapshot(meanBuffer.data(), meanBuffer.size()));
+  EXPECT_EQ(2u, mean.Count());
+  EXPECT_DOUBLE_EQ(3.0, mean.Value());
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "gz/math/AxisAlignedBox.hh"
+#include "gz/math/Helpers.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/SparseOctree.hh"
+#include "gz/math/Vector3.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(SparseOctreeTest, MortonKey)
+{
+  using Octree = SparseOctree<double>;
+  const Vector3i voxels[] = {
+    {0, 0, 0}, {1, 2, 3}, {-1, -1, -1}, {-5, 7, -100000},
+    {Octree::kMaxVoxel, -Octree::kMaxVoxel, 12345}};
+  for (const Vector3i &v : voxels)
+    EXPECT_EQ(v, Octree::MortonVoxel(Octree::MortonKey(v)));
+
+  // The bits of x, y and z are interleaved from the least significant bit.
+  const std::uint64_t origin = Octree::MortonKey(Vector3i::Zero);
+  EXPECT_EQ(origin | 1u, Octree::MortonKey(Vector3i(1, 0, 0)));
+  EXPECT_EQ(origin | 2u, Octree::MortonKey(Vector3i(0, 1, 0)));
+  EXPECT_EQ(origin | 4u, Octree::MortonKey(Vector3i(0, 0, 1)));
+  EXPECT_LT(Octree::MortonKey(Vector3i(-1, -1, -1)), origin);
+}
+
+/////////////////////////////////////////////////
+TEST(SparseOctreeTest, Insert)
+{
+  SparseOctree<double> octree(0.5);
+  EXPECT_DOUBLE_EQ(0.5, octree.VoxelSize());
+  EXPECT_EQ(0u, octree.VoxelCount());
+  EXPECT_EQ(1u, octree.NodeCount());
+  EXPECT_FALSE(octree.Occupied(Vector3d::Zero));
+
+  EXPECT_TRUE(octree.Insert(Vector3d(0.1, 0.2, 0.3)));
+  EXPECT_TRUE(octree.Insert(Vector3d(0.3, 0.4, 0.1)));
+  EXPECT_TRUE(octree.Insert(Vector3d(-0.1, 0.2, 0.3)));
+  EXPECT_FALSE(octree.Insert(Vector3d(NAN_D, 0, 0)));
+  EXPECT_FALSE(octree.Insert(Vector3d(0, 1e9, 0)));
+  EXPECT_EQ(2u, octree.VoxelCount());
+
+  std::size_t voxel;
+  ASSERT_TRUE(octree.Find(Vector3d(0.25, 0.25, 0.25), voxel));
+  EXPECT_EQ(0u, voxel);
+  EXPECT_EQ(Vector3i::Zero, octree.VoxelCoordinates(voxel));
+  EXPECT_EQ(2u, octree.PointCount(voxel));
+  EXPECT_EQ(Vector3d(0.2, 0.3, 0.2), octree.Centroid(voxel));
+  EXPECT_EQ(AxisAlignedBox(0, 0, 0, 0.5, 0.5, 0.5), octree.VoxelBox(voxel));
+
+  ASSERT_TRUE(octree.Find(Vector3d(-0.4, 0.1, 0.1), voxel));
+  EXPECT_EQ(1u, voxel);
+  EXPECT_EQ(Vector3i(-1, 0, 0), octree.VoxelCoordinates(voxel));
+  EXPECT_EQ(1u, octree.PointCount(voxel));
+  EXPECT_FALSE(octree.Occupied(Vector3d(0.6, 0, 0)));
+
+  octree.Clear();
+  EXPECT_EQ(0u, octree.VoxelCount());
+  EXPECT_EQ(1u, octree.NodeCount());
+  EXPECT_FALSE(octree.Occupied(Vector3d(0.1, 0.2, 0.3)));
+}
+
+/////////////////////////////////////////////////
+TEST(SparseOctreeTest, BulkInsert)
+{
+  Rand::Seed(5);
+  std::vector<Vector3f> points;
+  for (int i = 0; i < 20000; ++i)
+  {
+    points.emplace_back(static_cast<float>(Rand::DblUniform(-20, 20)),
+                        static_cast<float>(Rand::DblUniform(-20, 20)),
+                        static_cast<float>(Rand::DblUniform(-2, 2)));
+  }
+  points.emplace_back(NAN_F, 0.0f, 0.0f);
+
+  SparseOctree<float> bulk(1.0f);
+  EXPECT_EQ(points.size() - 1, bulk.Insert(points.data(), points.size()));
+  SparseOctree<float> single(1.0f);
+  for (const Vector3f &p : points)
+    single.Insert(p);
+  ASSERT_EQ(single.VoxelCount(), bulk.VoxelCount());
+  EXPECT_EQ(single.NodeCount(), bulk.NodeCount());
+
+  // Reference reduction with a map
+  std::map<std::uint64_t, std::pair<Vector3d, std::size_t>> expected;
+  for (std::size_t i = 0; i + 1 < points.size(); ++i)
+  {
+    Vector3i voxel;
+    ASSERT_TRUE(bulk.VoxelCoordinates(points[i], voxel));
+    auto &entry = expected[SparseOctree<float>::MortonKey(voxel)];
+    entry.first += Vector3d(points[i].X(), points[i].Y(), points[i].Z());
+    entry.second++;
+  }
+  ASSERT_EQ(expected.size(), bulk.VoxelCount());
+
+  std::vector<Vector3f> centroids;
+  bulk.Centroids(centroids);
+  ASSERT_EQ(bulk.VoxelCount(), centroids.size());
+  for (std::size_t v = 0; v < bulk.VoxelCount(); ++v)
+  {
+    const auto &entry = expected.at(bulk.Key(v));
+    EXPECT_EQ(entry.second, bulk.PointCount(v));
+    const Vector3d mean = entry.first / static_cast<double>(entry.second);
+    EXPECT_NEAR(mean.X(), centroids[v].X(), 1e-5);
+    EXPECT_NEAR(mean.Y(), centroids[v].Y(), 1e-5);
+    EXPECT_NEAR(mean.Z(), centroids[v].Z(), 1e-5);
+
+    std::size_t found;
+    ASSERT_TRUE(single.Find(centroids[v], found));
+    EXPECT_EQ(bulk.Key(v), single.Key(found));
+    EXPECT_EQ(bulk.PointCount(v), single.PointCount(found));
+  }
+
+  // Inserting again adds to the same voxels
+  EXPECT_EQ(points.size() - 1, bulk.Insert(points.data(), points.size()));
+  EXPECT_EQ(expected.size(), bulk.VoxelCount());
+  for (std::size_t v = 0; v < bulk.VoxelCount(); ++v)
+    EXPECT_EQ(2 * expected.at(bulk.Key(v)).second, bulk.PointCount(v));
+}
+
+/////////////////////////////////////////////////
+TEST(SparseOctreeTest, Intersects)
+{
+  Rand::Seed(8);
+  SparseOctree<double> octree(0.25);
+  for (int i = 0; i < 5000; ++i)
+  {
+    octree.Insert(Vector3d(Rand::DblUniform(-10, 10),
+                           Rand::DblUniform(-10, 10),
+                           Rand::DblUniform(-10, 10)));
+  }
+
+  std::vector<std::size_t> voxels;
+  for (int q = 0; q < 50; ++q)
+  {
+    const AxisAlignedBox box(
+        Vector3d(Rand::DblUniform(-12, 12), Rand::DblUniform(-12, 12),
+                 Rand::DblUniform(-12, 12)),
+        Vector3d(Rand::DblUniform(-12, 12), Rand::DblUniform(-12, 12),
+                 Rand::DblUniform(-12, 12)));
+    std::vector<std::size_t> expected;
+    for (std::size_t v = 0; v < octree.VoxelCount(); ++v)
+    {
+      if (octree.VoxelBox(v).Intersects(box))
+        expected.push_back(v);
+    }
+
+    octree.Intersects(box, voxels);
+    for (std::size_t i = 1; i < voxels.size(); ++i)
+      EXPECT_LT(octree.Key(voxels[i - 1]), octree.Key(voxels[i]));
+    std::sort(voxels.begin(), voxels.end());
+    EXPECT_EQ(expected, voxels) << q;
+  }
+
+  octree.Intersects(AxisAlignedBox(), voxels);
+  EXPECT_TRUE(voxels.empty());
+  octree.Intersects(AxisAlignedBox(-1e300, -1e300, -1e300,
+                                   1e300, 1e300, 1e300), voxels);
+  EXPECT_EQ(octree.VoxelCount(), voxels.size());
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "gz/math/Rand.hh"
+#include "gz/math/SpatialHashGrid.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+/// \brief Indices of the points within a distance of a position, sorted,
+/// computed by brute force.
+std::vector<std::size_t> BruteForce(const std::vector<Vector3d> &_points,
+    const std::vector<bool> &_used, const Vector3d &_position,
+    const double _distance)
+{
+  std::vector<std::size_t> ids;
+  for (std::size_t i = 0; i < _points.size(); ++i)
+  {
+    if (_used[i] && _points[i].Distance(_position) <= _distance)
+      ids.push_back(i);
+  }
+  return ids;
+}
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialHashGridTest, Empty)
+{
+  SpatialHashGridd grid(0.5);
+  EXPECT_DOUBLE_EQ(0.5, grid.CellSize());
+  EXPECT_EQ(0u, grid.Size());
+  EXPECT_EQ(0u, grid.CellCount());
+
+  std::vector<std::size_t> ids{1, 2};
+  grid.WithinDistance(Vector3d::Zero, 10, ids);
+  EXPECT_TRUE(ids.empty());
+
+  std::vector<std::pair<std::size_t, std::size_t>> pairs{{1, 2}};
+  grid.Pairs(10, pairs);
+  EXPECT_TRUE(pairs.empty());
+
+  Vector3d position;
+  EXPECT_FALSE(grid.Position(0, position));
+  EXPECT_FALSE(grid.Remove(0));
+  EXPECT_FALSE(grid.Update(0, Vector3d::One));
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialHashGridTest, Cell)
+{
+  SpatialHashGridd grid(0.5);
+  EXPECT_EQ(Vector3i(0, 0, 0), grid.Cell(Vector3d(0.1, 0.2, 0.49)));
+  EXPECT_EQ(Vector3i(-1, 1, 2), grid.Cell(Vector3d(-0.1, 0.5, 1.2)));
+  EXPECT_EQ(Vector3i(std::numeric_limits<int>::max(),
+                     std::numeric_limits<int>::min(), 0),
+            grid.Cell(Vector3d(1e300, -1e300, 0)));
+
+  // Queries and pairs at the clamped cells
+  grid.Insert(Vector3d(1e300, -1e300, 0));
+  grid.Insert(Vector3d(1e300, -1e300, 0));
+  std::vector<std::size_t> ids;
+  grid.WithinDistance(Vector3d(1e300, -1e300, 0), 1, ids);
+  EXPECT_EQ(2u, ids.size());
+  std::vector<std::pair<std::size_t, std::size_t>> pairs;
+  grid.Pairs(0.1, pairs);
+  EXPECT_EQ(1u, pairs.size());
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialHashGridTest, InsertUpdateRemove)
+{
+  SpatialHashGridd grid(1);
+  const std::size_t a = grid.Insert(Vector3d(0.5, 0.5, 0.5));
+  const std::size_t b = grid.Insert(Vector3d(0.6, 0.5, 0.5));
+  const std::size_t c = grid.Insert(Vector3d(5.5, 0.5, 0.5));
+  EXPECT_EQ(0u, a);
+  EXPECT_EQ(1u, b);
+  EXPECT_EQ(2u, c);
+  EXPECT_EQ(3u, grid.Size());
+  EXPECT_EQ(2u, grid.CellCount());
+
+  std::vector<std::size_t> ids;
+  grid.WithinDistance(Vector3d(0.5, 0.5, 0.5), 0.2, ids);
+  std::sort(ids.begin(), ids.end());
+  EXPECT_EQ((std::vector<std::size_t>{a, b}), ids);
+
+  // Moving within a cell, then to another cell
+  EXPECT_TRUE(grid.Update(a, Vector3d(0.9, 0.5, 0.5)));
+  EXPECT_EQ(2u, grid.CellCount());
+  EXPECT_TRUE(grid.Update(a, Vector3d(5.4, 0.5, 0.5)));
+  EXPECT_EQ(2u, grid.CellCount());
+  Vector3d position;
+  EXPECT_TRUE(grid.Position(a, position));
+  EXPECT_EQ(Vector3d(5.4, 0.5, 0.5), position);
+  grid.WithinDistance(Vector3d(5.5, 0.5, 0.5), 0.2, ids);
+  std::sort(ids.begin(), ids.end());
+  EXPECT_EQ((std::vector<std::size_t>{a, c}), ids);
+
+  std::vector<std::pair<std::size_t, std::size_t>> pairs;
+  grid.Pairs(0.2, pairs);
+  ASSERT_EQ(1u, pairs.size());
+  EXPECT_EQ(std::make_pair(a, c), pairs[0]);
+
+  // Removed indices are reused
+  EXPECT_TRUE(grid.Remove(b));
+  EXPECT_FALSE(grid.Remove(b));
+  EXPECT_FALSE(grid.Position(b, position));
+  EXPECT_EQ(2u, grid.Size());
+  EXPECT_EQ(1u, grid.CellCount());
+  EXPECT_EQ(b, grid.Insert(Vector3d(-3, -3, -3)));
+  EXPECT_EQ(3u, grid.Size());
+
+  grid.Clear();
+  EXPECT_EQ(0u, grid.Size());
+  EXPECT_EQ(0u, grid.CellCount());
+  EXPECT_EQ(0u, grid.Insert(Vector3d::Zero));
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialHashGridTest, MatchesBruteForce)
+{
+  Rand::Seed(7);
+  SpatialHashGridd grid(0.25);
+  std::vector<Vector3d> points;
+  std::vector<bool> used;
+  for (int i = 0; i < 2000; ++i)
+  {
+    points.emplace_back(Rand::DblUniform(-2, 2), Rand::DblUniform(-2, 2),
+                        Rand::DblUniform(-1, 1));
+    used.push_back(true);
+    EXPECT_EQ(points.size() - 1, grid.Insert(points.back()));
+  }
+
+  // Move and remove some points
+  for (std::size_t i = 0; i < points.size(); i += 7)
+  {
+    points[i] += Vector3d(Rand::DblUniform(-0.5, 0.5), 0.3, -0.1);
+    EXPECT_TRUE(grid.Update(i, points[i]));
+  }
+  for (std::size_t i = 3; i < points.size(); i += 11)
+  {
+    EXPECT_TRUE(grid.Remove(i));
+    used[i] = false;
+  }
+
+  std::vector<std::size_t> ids;
+  for (const double distance : {0.0, 0.1, 0.25, 0.6, 100.0})
+  {
+    for (int q = 0; q < 50; ++q)
+    {
+      const Vector3d position(Rand::DblUniform(-2, 2),
+          Rand::DblUniform(-2, 2), Rand::DblUniform(-1, 1));
+      grid.WithinDistance(position, distance, ids);
+      std::sort(ids.begin(), ids.end());
+      EXPECT_EQ(BruteForce(points, used, position, distance), ids);
+    }
+  }
+
+  std::vector<std::pair<std::size_t, std::size_t>> pairs;
+  grid.Pairs(0.1, pairs);
+  std::sort(pairs.begin(), pairs.end());
+  std::vector<std::pair<std::size_t, std::size_t>> expected;
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    for (std::size_t j = i + 1; j < points.size(); ++j)
+    {
+      if (used[i] && used[j] && points[i].Distance(points[j]) <= 0.1)
+        expected.emplace_back(i, j);
+    }
+  }
+  EXPECT_FALSE(expected.empty());
+  EXPECT_EQ(expected, pairs);
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialHashGridTest, Float)
+{
+  SpatialHashGridf grid(0.5f);
+  grid.Insert(Vector3f(0, 0, 0));
+  grid.Insert(Vector3f(0.3f, 0, 0));
+  grid.Insert(Vector3f(0, 0.7f, 0));
+  std::vector<std::size_t> ids;
+  grid.WithinDistance(Vector3f(0.1f, 0, 0), 0.5f, ids);
+  EXPECT_EQ(2u, ids.size());
+}
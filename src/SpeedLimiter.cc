@@ -15,6 +15,9 @@
  *
 */
 
+#include <algorithm>
+#include <cstdint>
+
 #include "gz/math/Helpers.hh"
 #include "gz/math/SpeedLimiter.hh"
 
@@ -41,6 +44,90 @@ class gz::math::SpeedLimiterPrivate
 
   /// \brief Maximum jerk limit.
   public: double maxJerk{std::numeric_limits<double>::infinity()};
+
+  /// \brief Number of elements limited together by LimitBatch, in loops
+  /// with a fixed trip count which the compiler vectorizes.
+  public: static constexpr size_t kBlockSize = 8;
+
+  /// \brief Check whether clamping a value to a range changes it.
+  /// \param[in] _value The value.
+  /// \param[in] _min Lower bound of the range.
+  /// \param[in] _max Upper bound of the range.
+  /// \return True if _value is outside the range or NaN.
+  public: static bool Clamped(double _value, double _min, double _max)
+  {
+    return !(_value >= _min && _value <= _max);
+  }
+
+  /// \brief Limit a block of kBlockSize elements, as Limit does.
+  /// \param[in] _vel Velocities to limit.
+  /// \param[in] _prevVel Previous velocities.
+  /// \param[in] _prevPrevVel Velocities before the previous ones.
+  /// \param[in] _dt Time step in seconds.
+  /// \param[in] _limitRates False if the time step is zero, in which case
+  /// only the velocity is limited.
+  /// \param[out] _out Limited velocities.
+  /// \param[out] _limited Flags of the limits that were engaged.
+  public: void LimitBlock(const double *_vel, const double *_prevVel,
+                          const double *_prevPrevVel, double _dt,
+                          bool _limitRates, double *_out,
+                          uint8_t *_limited) const
+  {
+    // The results are written to local arrays first, since the compiler
+    // doesn't know they don't overlap the inputs. The flags are summed as
+    // doubles, which vectorizes along with the velocities.
+    constexpr double velocityFlag = SpeedLimiter::kVelocityLimited;
+    constexpr double accelerationFlag = SpeedLimiter::kAccelerationLimited;
+    constexpr double jerkFlag = SpeedLimiter::kJerkLimited;
+    double vel[kBlockSize];
+    double limited[kBlockSize];
+    if (_limitRates)
+    {
+      for (size_t i = 0; i < kBlockSize; ++i)
+      {
+        const double prevVel = _prevVel[i];
+
+        // Same steps as LimitJerk then LimitAcceleration
+        const double accUnclamped = (_vel[i] - prevVel) / _dt;
+        const double accPrev = (prevVel - _prevPrevVel[i]) / _dt;
+        const double jerkUnclamped = (accUnclamped - accPrev) / _dt;
+        const double jerkClamped =
+          clamp(jerkUnclamped, this->minJerk, this->maxJerk);
+        const double jerkVel = prevVel + (accPrev + jerkClamped * _dt) * _dt;
+
+        const double acc = (jerkVel - prevVel) / _dt;
+        const double accClamped =
+          clamp(acc, this->minAcceleration, this->maxAcceleration);
+        vel[i] = prevVel + accClamped * _dt;
+
+        limited[i] =
+          (Clamped(jerkUnclamped, this->minJerk, this->maxJerk) ?
+           jerkFlag : 0.0) +
+          (Clamped(acc, this->minAcceleration, this->maxAcceleration) ?
+           accelerationFlag : 0.0);
+      }
+    }
+    else
+    {
+      for (size_t i = 0; i < kBlockSize; ++i)
+      {
+        vel[i] = _vel[i];
+        limited[i] = 0.0;
+      }
+    }
+
+    double out[kBlockSize];
+    for (size_t i = 0; i < kBlockSize; ++i)
+    {
+      out[i] = clamp(vel[i], this->minVelocity, this->maxVelocity);
+      limited[i] += Clamped(vel[i], this->minVelocity, this->maxVelocity) ?
+        velocityFlag : 0.0;
+    }
+
+    std::copy(out, out + kBlockSize, _out);
+    for (size_t i = 0; i < kBlockSize; ++i)
+      _limited[i] = static_cast<uint8_t>(limited[i]);
+  }
 };
 
 //////////////////////////////////////////////////
@@ -193,3 +280,41 @@ double SpeedLimiter::LimitJerk(double &_vel, double _prevVel,
 
   return _vel - vUnclamped;
 }
+
+//////////////////////////////////////////////////
+void SpeedLimiter::LimitBatch(double *_vel, const double *_prevVel,
+    const double *_prevPrevVel, size_t _count,
+    std::chrono::steady_clock::duration _dt, uint8_t *_limited) const
+{
+  constexpr size_t kBlockSize = SpeedLimiterPrivate::kBlockSize;
+  const double dtSec = std::chrono::duration<double>(_dt).count();
+  const bool limitRates = !equal(dtSec, 0.0);
+
+  double out[kBlockSize];
+  uint8_t limited[kBlockSize];
+  size_t begin = 0;
+  for (; begin + kBlockSize <= _count; begin += kBlockSize)
+  {
+    this->dataPtr->LimitBlock(_vel + begin, _prevVel + begin,
+        _prevPrevVel + begin, dtSec, limitRates, out, limited);
+    std::copy(out, out + kBlockSize, _vel + begin);
+    if (_limited)
+      std::copy(limited, limited + kBlockSize, _limited + begin);
+  }
+
+  // The last elements are copied to a full block.
+  if (begin < _count)
+  {
+    double vel[kBlockSize] = {};
+    double prevVel[kBlockSize] = {};
+    double prevPrevVel[kBlockSize] = {};
+    std::copy(_vel + begin, _vel + _count, vel);
+    std::copy(_prevVel + begin, _prevVel + _count, prevVel);
+    std::copy(_prevPrevVel + begin, _prevPrevVel + _count, prevPrevVel);
+    this->dataPtr->LimitBlock(vel, prevVel, prevPrevVel, dtSec, limitRates,
+        out, limited);
+    std::copy(out, out + (_count - begin), _vel + begin);
+    if (_limited)
+      std::copy(limited, limited + (_count - begin), _limited + begin);
+  }
+}
@@ -17,7 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <vector>
+
 #include "gz/math/Helpers.hh"
+#include "gz/math/Rand.hh"
 #include "gz/math/SpeedLimiter.hh"
 
 using namespace gz;
@@ -256,3 +260,77 @@ TEST(SpeedLimiterTest, LimitAll)
   EXPECT_DOUBLE_EQ(0.0, limiter.Limit(vel, velPrev, velPrevPrev, dt));
   EXPECT_DOUBLE_EQ(2.1, vel);
 }
+
+/////////////////////////////////////////////////
+TEST(SpeedLimiterTest, LimitBatch)
+{
+  SpeedLimiter limiter;
+  limiter.SetMinVelocity(-4.0);
+  limiter.SetMaxVelocity(4.0);
+  limiter.SetMinAcceleration(-2.0);
+  limiter.SetMaxAcceleration(2.0);
+  limiter.SetMinJerk(-1.0);
+  limiter.SetMaxJerk(1.0);
+
+  // Within bounds, above the jerk, acceleration and velocity bounds, and
+  // below the jerk bound
+  std::vector<double> vel = {2.0, 5.0, 4.5, 4.5, -0.5};
+  const std::vector<double> velPrev = {1.0, 2.0, 2.0, 4.0, 3.5};
+  const std::vector<double> velPrevPrev = {0.5, 1.0, 0.0, 3.0, 4.0};
+  std::vector<uint8_t> limited(vel.size(), 255);
+  limiter.LimitBatch(vel.data(), velPrev.data(), velPrevPrev.data(),
+                     vel.size(), 1s, limited.data());
+  EXPECT_DOUBLE_EQ(2.0, vel[0]);
+  EXPECT_DOUBLE_EQ(4.0, vel[1]);
+  EXPECT_DOUBLE_EQ(4.0, vel[2]);
+  EXPECT_DOUBLE_EQ(4.0, vel[3]);
+  EXPECT_DOUBLE_EQ(2.0, vel[4]);
+  EXPECT_EQ(0, limited[0]);
+  EXPECT_EQ(SpeedLimiter::kJerkLimited, limited[1]);
+  EXPECT_EQ(SpeedLimiter::kAccelerationLimited, limited[2]);
+  EXPECT_EQ(SpeedLimiter::kVelocityLimited, limited[3]);
+  EXPECT_EQ(SpeedLimiter::kJerkLimited, limited[4]);
+
+  // Only the velocity is limited in zero time
+  vel = {2.1, 5.0, -4.5, 4.5, -0.5};
+  limiter.LimitBatch(vel.data(), velPrev.data(), velPrevPrev.data(),
+                     vel.size(), 0s, limited.data());
+  EXPECT_DOUBLE_EQ(2.1, vel[0]);
+  EXPECT_DOUBLE_EQ(4.0, vel[1]);
+  EXPECT_DOUBLE_EQ(-4.0, vel[2]);
+  EXPECT_EQ(0, limited[0]);
+  EXPECT_EQ(SpeedLimiter::kVelocityLimited, limited[1]);
+  EXPECT_EQ(SpeedLimiter::kVelocityLimited, limited[2]);
+
+  // Same velocities as Limit, with and without flags, for a number of
+  // elements that is not a multiple of the block size
+  Rand::Seed(5);
+  const size_t count = 203;
+  std::vector<double> expected(count);
+  std::vector<double> prev(count);
+  std::vector<double> prevPrev(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    expected[i] = Rand::DblUniform(-6, 6);
+    prev[i] = Rand::DblUniform(-6, 6);
+    prevPrev[i] = Rand::DblUniform(-6, 6);
+  }
+  vel = expected;
+  std::vector<double> velNoFlags = expected;
+  for (size_t i = 0; i < count; ++i)
+    limiter.Limit(expected[i], prev[i], prevPrev[i], 10ms);
+  limited.resize(count);
+  limiter.LimitBatch(vel.data(), prev.data(), prevPrev.data(), count, 10ms,
+                     limited.data());
+  limiter.LimitBatch(velNoFlags.data(), prev.data(), prevPrev.data(), count,
+                     10ms);
+  for (size_t i = 0; i < count; ++i)
+  {
+    EXPECT_DOUBLE_EQ(expected[i], vel[i]) << i;
+    EXPECT_DOUBLE_EQ(expected[i], velNoFlags[i]) << i;
+    EXPECT_GE(7, limited[i]);
+  }
+
+  // No elements
+  limiter.LimitBatch(nullptr, nullptr, nullptr, 0, 10ms);
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "gz/math/SphereArray.hh"
+#include "gz/math/Vector3.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(SphereArrayTest, Empty)
+{
+  SphereArrayd spheres;
+  EXPECT_TRUE(spheres.Empty());
+  EXPECT_EQ(0u, spheres.Size());
+  spheres.Distances(Vector3d::Zero, 1, nullptr);
+  spheres.Distances(nullptr, nullptr, 0, nullptr);
+}
+
+/////////////////////////////////////////////////
+TEST(SphereArrayTest, Spheres)
+{
+  const std::vector<Vector3d> centers = {
+    Vector3d(0, 0, 0), Vector3d(3, 0, 0), Vector3d(0, 1, 0)};
+  const std::vector<double> radii = {1, 0.5, 2};
+  SphereArrayd spheres;
+  spheres.Assign(centers.data(), radii.data(), centers.size());
+  ASSERT_EQ(3u, spheres.Size());
+  EXPECT_FALSE(spheres.Empty());
+  EXPECT_EQ(Vector3d(3, 0, 0), spheres.Center(1));
+  EXPECT_DOUBLE_EQ(0.5, spheres.Radius(1));
+
+  spheres.SetSphere(1, Vector3d(0, 0, 4), 1.5);
+  EXPECT_EQ(Vector3d(0, 0, 4), spheres.Center(1));
+  EXPECT_DOUBLE_EQ(1.5, spheres.Radius(1));
+
+  spheres.Add(Vector3d(1, 1, 1), 0);
+  EXPECT_EQ(4u, spheres.Size());
+  spheres.Clear();
+  EXPECT_TRUE(spheres.Empty());
+}
+
+/////////////////////////////////////////////////
+TEST(SphereArrayTest, Distances)
+{
+  EXPECT_DOUBLE_EQ(1.5, SphereArrayd::Distance(Vector3d(0, 0, 0), 1,
+                                               Vector3d(3, 0, 0), 0.5));
+  EXPECT_DOUBLE_EQ(-2, SphereArrayd::Distance(Vector3d(0, 0, 0), 1,
+                                              Vector3d(0, 1, 0), 2));
+
+  SphereArrayf spheres;
+  spheres.Add(Vector3f(0, 0, 0), 1);
+  spheres.Add(Vector3f(3, 0, 0), 0.5f);
+  spheres.Add(Vector3f(0, 1, 0), 2);
+  spheres.Add(Vector3f(0, 1, 0), 1);
+
+  std::vector<float> distances(spheres.Size());
+  spheres.Distances(Vector3f(0, -4, 0), 1, distances.data());
+  EXPECT_FLOAT_EQ(2, distances[0]);
+  EXPECT_FLOAT_EQ(5 - 1.5f, distances[1]);
+  EXPECT_FLOAT_EQ(2, distances[2]);
+  EXPECT_FLOAT_EQ(3, distances[3]);
+
+  const std::vector<std::size_t> first = {0, 1, 0, 2};
+  const std::vector<std::size_t> second = {1, 0, 2, 3};
+  std::vector<Vector3f> normals(first.size());
+  spheres.Distances(first.data(), second.data(), first.size(),
+                    distances.data(), normals.data());
+  EXPECT_FLOAT_EQ(1.5f, distances[0]);
+  EXPECT_FLOAT_EQ(1.5f, distances[1]);
+  EXPECT_FLOAT_EQ(-2, distances[2]);
+  EXPECT_FLOAT_EQ(-3, distances[3]);
+  EXPECT_EQ(Vector3f(1, 0, 0), normals[0]);
+  EXPECT_EQ(Vector3f(-1, 0, 0), normals[1]);
+  EXPECT_EQ(Vector3f(0, 1, 0), normals[2]);
+  // Same centers
+  EXPECT_EQ(Vector3f::Zero, normals[3]);
+
+  // Without normals
+  std::vector<float> distancesOnly(first.size());
+  spheres.Distances(first.data(), second.data(), first.size(),
+                    distancesOnly.data());
+  EXPECT_EQ(distances, distancesOnly);
+}
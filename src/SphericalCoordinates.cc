@@ -14,12 +14,16 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <string>
 
 #include "gz/math/Matrix3.hh"
 #include "gz/math/SphericalCoordinates.hh"
 
+#include "LazyUpdate.hh"
+
 using namespace gz;
 using namespace math;
 
@@ -92,21 +96,779 @@ class gz::math::SphericalCoordinates::Implementation
   public: double ellP;
 
   /// \brief Rotation matrix that moves ECEF to GLOBAL
-  public: Matrix3d rotECEFToGlobal;
+  public: mutable Matrix3d rotECEFToGlobal;
 
   /// \brief Rotation matrix that moves GLOBAL to ECEF
-  public: Matrix3d rotGlobalToECEF;
+  public: mutable Matrix3d rotGlobalToECEF;
 
   /// \brief Cache the ECEF position of the the origin
-  public: Vector3d origin;
+  public: mutable Vector3d origin;
 
   /// \brief Cache cosine head transform
-  public: double cosHea;
+  public: mutable double cosHea;
 
   /// \brief Cache sine head transform
-  public: double sinHea;
+  public: mutable double sinHea;
+
+  /// \brief Distance from the reference within which the tangent plane
+  /// approximation is used, 0 to always use the exact conversions.
+  public: double tangentRadius = 0;
+
+  /// \brief Largest distance at which the tangent plane is used anyway,
+  /// small near the poles where the approximation does not hold.
+  public: mutable double tangentPoleDistance = 0;
+
+  /// \brief Meters per degree of latitude at the reference.
+  public: mutable double tangentNorth = 0;
+
+  /// \brief Meters per degree of longitude at the reference.
+  public: mutable double tangentEast = 0;
+
+  /// \brief Drop of the surface below the tangent plane per squared meter
+  /// north of the reference, 1 / (2 M), with M the meridional radius.
+  public: mutable double tangentDropNorth = 0;
+
+  /// \brief Drop of the surface below the tangent plane per squared meter
+  /// east of the reference, 1 / (2 N), with N the prime vertical radius.
+  public: mutable double tangentDropEast = 0;
+
+  /// \brief Absolute value of the tangent of the reference latitude.
+  public: mutable double tangentTanLat = 0;
+
+  /// \brief Whether the cached state above, derived from the reference,
+  /// heading and surface, must be computed again.
+  public: mutable LazyUpdate lazy;
+
+  /// \brief Compute the cached state from the reference, heading and
+  /// surface.
+  public: void Update() const;
+
+  /// \brief Compute the cached state if a setter changed what it derives
+  /// from. Once it is computed, this is a single atomic load, so const
+  /// conversions can run concurrently without locking.
+  public: void Refresh() const;
+
+  /// \brief Approximate a geodetic position with the tangent plane at the
+  /// reference.
+  /// \param[in] _latLonEle Latitude (deg), longitude (deg) and elevation.
+  /// \param[out] _enu Position in the GLOBAL (East, North, Up) frame.
+  /// \return False if the position is too far from the reference, in which
+  /// case _enu is not set.
+  public: bool TangentFromSpherical(const Vector3d &_latLonEle,
+                                    Vector3d &_enu) const;
+
+  /// \brief Approximate a position in the tangent plane at the reference
+  /// with a geodetic position.
+  /// \param[in] _enu Position in the GLOBAL (East, North, Up) frame.
+  /// \param[out] _latLonEle Latitude (deg), longitude (deg) and elevation.
+  /// \return False if the position is too far from the reference, in which
+  /// case _latLonEle is not set.
+  public: bool SphericalFromTangent(const Vector3d &_enu,
+                                    Vector3d &_latLonEle) const;
+
+  /// \brief Convert positions to ECEF.
+  /// \param[in] _in Pointer to the first position.
+  /// \param[out] _out Pointer to the first ECEF position, may be _in.
+  /// \param[in] _count Number of positions.
+  /// \param[in] _type CoordinateType of the positions.
+  /// \return False if _type is not valid.
+  public: bool ToECEF(const Vector3d *_in, Vector3d *_out, size_t _count,
+                      SphericalCoordinates::CoordinateType _type) const;
+
+  /// \brief Convert ECEF positions.
+  /// \param[in] _in Pointer to the first ECEF position.
+  /// \param[out] _out Pointer to the first position, may be _in.
+  /// \param[in] _count Number of positions.
+  /// \param[in] _type CoordinateType of the output positions.
+  /// \return False if _type is not valid.
+  public: bool FromECEF(const Vector3d *_in, Vector3d *_out, size_t _count,
+                        SphericalCoordinates::CoordinateType _type) const;
+
+  /// \brief Get the rotation that converts velocities.
+  /// \param[in] _in CoordinateType of the input velocities.
+  /// \param[in] _out CoordinateType of the output velocities.
+  /// \param[out] _rotation The rotation.
+  /// \return False if a type is not valid or is SPHERICAL.
+  public: bool VelocityRotation(SphericalCoordinates::CoordinateType _in,
+                                SphericalCoordinates::CoordinateType _out,
+                                Matrix3d &_rotation) const;
 };
 
+/// \brief Number of positions converted at once by the batch transforms,
+/// small enough for the ECEF positions to stay in cache.
+constexpr size_t kTransformChunk = 256;
+
+namespace
+{
+/// \brief Distances between pairs of points on a sphere, with the same
+/// haversine formula as the single pair versions. Each sine is computed
+/// once, which the compiler does not do on its own since sin may set errno.
+/// \sa SphericalCoordinates::DistanceWGS84
+void HaversineDistance(const double *_latA, const double *_lonA,
+                       const double *_latB, const double *_lonB,
+                       double *_distance, const size_t _count,
+                       const double _radius)
+{
+  for (size_t i = 0; i < _count; ++i)
+  {
+    const double sinLat = sin((_latB[i] - _latA[i]) / 2);
+    const double sinLon = sin((_lonB[i] - _lonA[i]) / 2);
+    const double a = sinLat * sinLat +
+      sinLon * sinLon * cos(_latA[i]) * cos(_latB[i]);
+    _distance[i] = _radius * (2 * atan2(sqrt(a), sqrt(1 - a)));
+  }
+}
+
+/// \brief Distances from one point to many on a sphere, with the cosine
+/// of the latitude of the first point computed once.
+/// \sa SphericalCoordinates::DistanceWGS84
+void HaversineDistance(const double _latA, const double _lonA,
+                       const double *_latB, const double *_lonB,
+                       double *_distance, const size_t _count,
+                       const double _radius)
+{
+  const double cosLatA = cos(_latA);
+  for (size_t i = 0; i < _count; ++i)
+  {
+    const double sinLat = sin((_latB[i] - _latA) / 2);
+    const double sinLon = sin((_lonB[i] - _lonA) / 2);
+    const double a = sinLat * sinLat +
+      sinLon * sinLon * cosLatA * cos(_latB[i]);
+    _distance[i] = _radius * (2 * atan2(sqrt(a), sqrt(1 - a)));
+  }
+}
+
+/// \brief Maximum number of iterations of Vincenty's methods.
+constexpr int kGeodesicIterations = 100;
+
+/// \brief Convergence threshold of Vincenty's methods, in radians on the
+/// auxiliary sphere. On Earth, this is about 0.006 mm.
+constexpr double kGeodesicTolerance = 1e-12;
+
+/// \brief Reduced latitude of a geodetic latitude.
+/// \param[in] _lat Geodetic latitude in radians.
+/// \param[in] _oneMinusF One minus the flattening.
+/// \param[out] _sinU Sine of the reduced latitude.
+/// \param[out] _cosU Cosine of the reduced latitude.
+inline void ReducedLatitude(const double _lat, const double _oneMinusF,
+                            double &_sinU, double &_cosU)
+{
+  const double tanU = _oneMinusF * tan(_lat);
+  _cosU = 1.0 / sqrt(1.0 + tanU * tanU);
+  _sinU = tanU * _cosU;
+}
+
+/// \brief Coefficients A and B of Vincenty's series, for the square of the
+/// cosine of the azimuth at the equator.
+inline void VincentyCoefficients(const double _cosSqAlpha,
+                                 const double _ePrime2,
+                                 double &_coefA, double &_coefB)
+{
+  const double uSq = _cosSqAlpha * _ePrime2;
+  _coefA = 1 + uSq / 16384 * (4096 + uSq * (-768 + uSq * (320 - 175 * uSq)));
+  _coefB = uSq / 1024 * (256 + uSq * (-128 + uSq * (74 - 47 * uSq)));
+}
+
+/// \brief Difference between the arc length on the auxiliary sphere and
+/// the geodesic distance divided by b A, in Vincenty's method.
+inline double VincentyDeltaSigma(const double _coefB, const double _sinSigma,
+                                 const double _cosSigma,
+                                 const double _cos2SigmaM)
+{
+  const double cos2SigmaMSq = _cos2SigmaM * _cos2SigmaM;
+  return _coefB * _sinSigma * (_cos2SigmaM + _coefB / 4 *
+      (_cosSigma * (-1 + 2 * cos2SigmaMSq) - _coefB / 6 * _cos2SigmaM *
+       (-3 + 4 * _sinSigma * _sinSigma) * (-3 + 4 * cos2SigmaMSq)));
+}
+
+/// \brief Solve the inverse geodesic problem by bisection on the azimuth
+/// at the start, for nearly antipodal points where Vincenty's iteration
+/// does not converge. With the points arranged as in Karney, "Algorithms
+/// for geodesics" (2013), the longitude difference reached at the latitude
+/// of the end is an increasing function of the azimuth.
+/// \param[in] _a Equatorial axis.
+/// \param[in] _b Polar axis.
+/// \param[in] _lat1 Latitude of the start, in [-pi/2, -0].
+/// \param[in] _lat2 Latitude of the end, |_lat2| <= |_lat1|.
+/// \param[in] _lonDiff Longitude difference in [0, pi].
+/// \param[out] _azimuth1 Azimuth of the geodesic at the start.
+/// \param[out] _azimuth2 Azimuth of the geodesic at the end.
+/// \return Length of the geodesic.
+double GeodesicBisection(const double _a, const double _b,
+                         const double _lat1, const double _lat2,
+                         const double _lonDiff,
+                         double &_azimuth1, double &_azimuth2)
+{
+  const double f = (_a - _b) / _a;
+  const double ePrime2 = (_a * _a - _b * _b) / (_b * _b);
+
+  double sinB1, cosB1, sinB2, cosB2;
+  ReducedLatitude(_lat1, 1 - f, sinB1, cosB1);
+  ReducedLatitude(_lat2, 1 - f, sinB2, cosB2);
+
+  // Everything the solution needs for one azimuth at the start.
+  double sinAlpha0 = 0, cosSqAlpha0 = 0, sigma12 = 0, cos2SigmaM = 0;
+  double cosAlpha2CosB2 = 0;
+  const auto lonDiffAt = [&](const double _alpha1)
+  {
+    const double sinAlpha1 = sin(_alpha1);
+    const double cosAlpha1 = cos(_alpha1);
+    sinAlpha0 = sinAlpha1 * cosB1;
+    cosSqAlpha0 = 1 - sinAlpha0 * sinAlpha0;
+    cosAlpha2CosB2 = sqrt(cosAlpha1 * cosAlpha1 * cosB1 * cosB1 +
+        (cosB2 - cosB1) * (cosB2 + cosB1));
+
+    // Arc lengths and longitudes on the auxiliary sphere from the node
+    const double sigma1 = atan2(sinB1, cosAlpha1 * cosB1);
+    const double sigma2 = atan2(sinB2, cosAlpha2CosB2);
+    const double omega1 = atan2(sinAlpha0 * sinB1, cosAlpha1 * cosB1);
+    const double omega2 = atan2(sinAlpha0 * sinB2, cosAlpha2CosB2);
+    sigma12 = sigma2 - sigma1;
+    cos2SigmaM = cos(sigma1 + sigma2);
+
+    const double c = f / 16 * cosSqAlpha0 * (4 + f * (4 - 3 * cosSqAlpha0));
+    return omega2 - omega1 - (1 - c) * f * sinAlpha0 * (sigma12 + c *
+        sin(sigma12) * (cos2SigmaM + c * cos(sigma12) *
+        (-1 + 2 * cos2SigmaM * cos2SigmaM)));
+  };
+
+  double low = 0;
+  double high = GZ_PI;
+  double alpha1 = GZ_PI_2;
+  while (high - low > kGeodesicTolerance)
+  {
+    alpha1 = 0.5 * (low + high);
+    if (lonDiffAt(alpha1) < _lonDiff)
+      low = alpha1;
+    else
+      high = alpha1;
+  }
+  lonDiffAt(alpha1);
+
+  double coefA, coefB;
+  VincentyCoefficients(cosSqAlpha0, ePrime2, coefA, coefB);
+  _azimuth1 = alpha1;
+  _azimuth2 = atan2(sinAlpha0, cosAlpha2CosB2);
+  return _b * coefA * (sigma12 -
+      VincentyDeltaSigma(coefB, sin(sigma12), cos(sigma12), cos2SigmaM));
+}
+
+/// \brief Solve the inverse geodesic problem on an ellipsoid of
+/// revolution with Vincenty's method.
+/// \param[in] _a Equatorial axis.
+/// \param[in] _b Polar axis.
+/// \param[in] _latA Latitude of point A in radians.
+/// \param[in] _lonA Longitude of point A in radians.
+/// \param[in] _latB Latitude of point B in radians.
+/// \param[in] _lonB Longitude of point B in radians.
+/// \param[out] _azimuthA Azimuth of the geodesic at A, may be null.
+/// \param[out] _azimuthB Azimuth of the geodesic at B, may be null.
+/// \return Length of the geodesic.
+double VincentyInverse(const double _a, const double _b,
+                       const double _latA, const double _lonA,
+                       const double _latB, const double _lonB,
+                       double *_azimuthA, double *_azimuthB)
+{
+  const double f = (_a - _b) / _a;
+  const double ePrime2 = (_a * _a - _b * _b) / (_b * _b);
+
+  double sinU1, cosU1, sinU2, cosU2;
+  ReducedLatitude(_latA, 1 - f, sinU1, cosU1);
+  ReducedLatitude(_latB, 1 - f, sinU2, cosU2);
+  const double sinU1sinU2 = sinU1 * sinU2;
+  const double cosU1cosU2 = cosU1 * cosU2;
+
+  const double lonDiff = _lonB - _lonA;
+  double lambda = lonDiff;
+  double sinLambda = 0, cosLambda = 0;
+  double sinSigma = 0, cosSigma = 0, sigma = 0;
+  double cosSqAlpha = 0, cos2SigmaM = 0;
+  bool converged = false;
+  for (int i = 0; i < kGeodesicIterations && !converged; ++i)
+  {
+    sinLambda = sin(lambda);
+    cosLambda = cos(lambda);
+    const double t = cosU1 * sinU2 - sinU1 * cosU2 * cosLambda;
+    sinSigma = sqrt(cosU2 * sinLambda * cosU2 * sinLambda + t * t);
+    cosSigma = sinU1sinU2 + cosU1cosU2 * cosLambda;
+    sigma = atan2(sinSigma, cosSigma);
+
+    // Coincident points, or antipodal along a meridian.
+    const double sinAlpha =
+      sinSigma > 0 ? cosU1cosU2 * sinLambda / sinSigma : 0.0;
+    cosSqAlpha = 1 - sinAlpha * sinAlpha;
+
+    // Zero along the equator
+    cos2SigmaM =
+      cosSqAlpha > 0 ? cosSigma - 2 * sinU1sinU2 / cosSqAlpha : 0.0;
+
+    const double c = f / 16 * cosSqAlpha * (4 + f * (4 - 3 * cosSqAlpha));
+    const double previous = lambda;
+    lambda = lonDiff + (1 - c) * f * sinAlpha * (sigma + c * sinSigma *
+        (cos2SigmaM + c * cosSigma * (-1 + 2 * cos2SigmaM * cos2SigmaM)));
+    converged = std::abs(lambda - previous) < kGeodesicTolerance;
+  }
+
+  if (!converged || std::abs(lambda) > GZ_PI)
+  {
+    // Nearly antipodal points. Arrange them so that the start is the
+    // farthest from the equator, in the southern hemisphere, and the end
+    // is east of it, solve, then undo the arrangement on the azimuths.
+    double lat1 = _latA;
+    double lat2 = _latB;
+    double lonDiffAbs = std::remainder(lonDiff, 2 * GZ_PI);
+    const bool swapped = std::abs(lat1) < std::abs(lat2);
+    if (swapped)
+    {
+      std::swap(lat1, lat2);
+      lonDiffAbs = -lonDiffAbs;
+    }
+    const bool flipLat = lat1 > 0;
+    if (flipLat)
+    {
+      lat1 = -lat1;
+      lat2 = -lat2;
+    }
+    // -0 on the equator, so that the bisection sees a continuous function
+    lat1 = -std::abs(lat1);
+    const bool flipLon = lonDiffAbs < 0;
+    if (flipLon)
+      lonDiffAbs = -lonDiffAbs;
+
+    double azimuth1, azimuth2;
+    const double distance = GeodesicBisection(_a, _b, lat1, lat2,
+        lonDiffAbs, azimuth1, azimuth2);
+    if (flipLon)
+    {
+      azimuth1 = -azimuth1;
+      azimuth2 = -azimuth2;
+    }
+    if (flipLat)
+    {
+      azimuth1 = GZ_PI - azimuth1;
+      azimuth2 = GZ_PI - azimuth2;
+    }
+    if (swapped)
+    {
+      std::swap(azimuth1, azimuth2);
+      azimuth1 += GZ_PI;
+      azimuth2 += GZ_PI;
+    }
+    if (_azimuthA)
+      *_azimuthA = std::remainder(azimuth1, 2 * GZ_PI);
+    if (_azimuthB)
+      *_azimuthB = std::remainder(azimuth2, 2 * GZ_PI);
+    return distance;
+  }
+
+  double coefA, coefB;
+  VincentyCoefficients(cosSqAlpha, ePrime2, coefA, coefB);
+  const double deltaSigma =
+    VincentyDeltaSigma(coefB, sinSigma, cosSigma, cos2SigmaM);
+
+  if (_azimuthA)
+  {
+    *_azimuthA = atan2(cosU2 * sinLambda,
+        cosU1 * sinU2 - sinU1 * cosU2 * cosLambda);
+  }
+  if (_azimuthB)
+  {
+    *_azimuthB = atan2(cosU1 * sinLambda,
+        -sinU1 * cosU2 + cosU1 * sinU2 * cosLambda);
+  }
+  return _b * coefA * (sigma - deltaSigma);
+}
+
+/// \brief Solve the direct geodesic problem on an ellipsoid of
+/// revolution with Vincenty's method.
+/// \param[in] _a Equatorial axis.
+/// \param[in] _b Polar axis.
+/// \param[in] _lat Latitude of the start in radians.
+/// \param[in] _lon Longitude of the start in radians.
+/// \param[in] _azimuth Azimuth of the geodesic at the start.
+/// \param[in] _distance Length of the geodesic.
+/// \param[out] _latB Latitude of the end in radians.
+/// \param[out] _lonB Longitude of the end in radians, in [-pi, pi].
+/// \param[out] _azimuthB Azimuth of the geodesic at the end, may be null.
+void VincentyDirect(const double _a, const double _b,
+                    const double _lat, const double _lon,
+                    const double _azimuth, const double _distance,
+                    double &_latB, double &_lonB, double *_azimuthB)
+{
+  const double f = (_a - _b) / _a;
+  const double ePrime2 = (_a * _a - _b * _b) / (_b * _b);
+
+  double sinU1, cosU1;
+  ReducedLatitude(_lat, 1 - f, sinU1, cosU1);
+  const double sinAlpha1 = sin(_azimuth);
+  const double cosAlpha1 = cos(_azimuth);
+
+  // Angular distance on the sphere from the equator to the start
+  const double sigma1 = atan2(sinU1, cosU1 * cosAlpha1);
+  const double sinAlpha = cosU1 * sinAlpha1;
+  const double cosSqAlpha = 1 - sinAlpha * sinAlpha;
+
+  double coefA, coefB;
+  VincentyCoefficients(cosSqAlpha, ePrime2, coefA, coefB);
+
+  const double sigma0 = _distance / (_b * coefA);
+  double sigma = sigma0;
+  double sinSigma = 0, cosSigma = 0, cos2SigmaM = 0;
+  for (int i = 0; i < kGeodesicIterations; ++i)
+  {
+    cos2SigmaM = cos(2 * sigma1 + sigma);
+    sinSigma = sin(sigma);
+    cosSigma = cos(sigma);
+    const double previous = sigma;
+    sigma = sigma0 +
+      VincentyDeltaSigma(coefB, sinSigma, cosSigma, cos2SigmaM);
+    if (std::abs(sigma - previous) < kGeodesicTolerance)
+      break;
+  }
+  sinSigma = sin(sigma);
+  cosSigma = cos(sigma);
+  cos2SigmaM = cos(2 * sigma1 + sigma);
+
+  const double x = sinU1 * sinSigma - cosU1 * cosSigma * cosAlpha1;
+  _latB = atan2(sinU1 * cosSigma + cosU1 * sinSigma * cosAlpha1,
+      (1 - f) * sqrt(sinAlpha * sinAlpha + x * x));
+  const double lambda = atan2(sinSigma * sinAlpha1,
+      cosU1 * cosSigma - sinU1 * sinSigma * cosAlpha1);
+  const double c = f / 16 * cosSqAlpha * (4 + f * (4 - 3 * cosSqAlpha));
+  const double lonDiff = lambda - (1 - c) * f * sinAlpha * (sigma + c *
+      sinSigma * (cos2SigmaM + c * cosSigma *
+      (-1 + 2 * cos2SigmaM * cos2SigmaM)));
+  _lonB = std::remainder(_lon + lonDiff, 2 * GZ_PI);
+  if (_azimuthB)
+    *_azimuthB = atan2(sinAlpha, -x);
+}
+}  // namespace
+
+//////////////////////////////////////////////////
+bool SphericalCoordinates::Implementation::ToECEF(const Vector3d *_in,
+    Vector3d *_out, size_t _count,
+    SphericalCoordinates::CoordinateType _type) const
+{
+  switch (_type)
+  {
+    // East, North, Up (ENU)
+    case LOCAL:
+      for (size_t i = 0; i < _count; ++i)
+      {
+        const Vector3d &pos = _in[i];
+        const Vector3d tmp(
+            -pos.X() * this->cosHea + pos.Y() * this->sinHea,
+            -pos.X() * this->sinHea - pos.Y() * this->cosHea,
+            pos.Z());
+        _out[i] = this->origin + this->rotGlobalToECEF * tmp;
+      }
+      return true;
+
+    case LOCAL2:
+      for (size_t i = 0; i < _count; ++i)
+      {
+        const Vector3d &pos = _in[i];
+        const Vector3d tmp(
+            pos.X() * this->cosHea + pos.Y() * this->sinHea,
+            -pos.X() * this->sinHea + pos.Y() * this->cosHea,
+            pos.Z());
+        _out[i] = this->origin + this->rotGlobalToECEF * tmp;
+      }
+      return true;
+
+    case GLOBAL:
+      for (size_t i = 0; i < _count; ++i)
+        _out[i] = this->origin + this->rotGlobalToECEF * _in[i];
+      return true;
+
+    case SPHERICAL:
+    {
+      const double e2 = this->ellE * this->ellE;
+      const double b2OverA2 = (this->ellB * this->ellB) /
+        (this->ellA * this->ellA);
+      for (size_t i = 0; i < _count; ++i)
+      {
+        const Vector3d &pos = _in[i];
+        const double cosLat = cos(pos.X());
+        const double sinLat = sin(pos.X());
+        const double cosLon = cos(pos.Y());
+        const double sinLon = sin(pos.Y());
+
+        // Radius of planet curvature (meters)
+        const double curvature =
+          this->ellA / sqrt(1.0 - e2 * sinLat * sinLat);
+
+        _out[i].Set((pos.Z() + curvature) * cosLat * cosLon,
+                    (pos.Z() + curvature) * cosLat * sinLon,
+                    (b2OverA2 * curvature + pos.Z()) * sinLat);
+      }
+      return true;
+    }
+
+    // Do nothing
+    case ECEF:
+      if (_out != _in)
+        std::copy(_in, _in + _count, _out);
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+//////////////////////////////////////////////////
+bool SphericalCoordinates::Implementation::FromECEF(const Vector3d *_in,
+    Vector3d *_out, size_t _count,
+    SphericalCoordinates::CoordinateType _type) const
+{
+  switch (_type)
+  {
+    case SPHERICAL:
+    {
+      // Bowring's method. With t = tan(theta) and u = tan(lat), the sines
+      // and cosines of theta and lat follow from t and u without calling
+      // trigonometric functions.
+      const double p2b = this->ellP * this->ellP * this->ellB;
+      const double e2a = this->ellE * this->ellE * this->ellA;
+      const double e2 = this->ellE * this->ellE;
+      for (size_t i = 0; i < _count; ++i)
+      {
+        const Vector3d &ecef = _in[i];
+        const double p = sqrt(ecef.X() * ecef.X() + ecef.Y() * ecef.Y());
+
+        // tan(theta) = z a / (p b)
+        const double zA = ecef.Z() * this->ellA;
+        const double pB = p * this->ellB;
+        const double hypot = sqrt(zA * zA + pB * pB);
+        const double sinTheta = zA / hypot;
+        const double cosTheta = pB / hypot;
+
+        // Calculate latitude and longitude
+        const double num = ecef.Z() + p2b * sinTheta * sinTheta * sinTheta;
+        const double den = p - e2a * cosTheta * cosTheta * cosTheta;
+        const double lat = atan(num / den);
+        const double lon = atan2(ecef.Y(), ecef.X());
+
+        // cos(lat) and sin(lat) from tan(lat) = num / den, den > 0 except
+        // at the poles.
+        const double latHypot = sqrt(num * num + den * den);
+        const double sinLat = num / latHypot;
+        const double cosLat = den / latHypot;
+
+        // Recalculate radius of planet curvature at the current latitude.
+        const double nCurvature =
+          this->ellA / sqrt(1.0 - e2 * sinLat * sinLat);
+
+        _out[i].Set(lat, lon, p / cosLat - nCurvature);
+      }
+      return true;
+    }
+
+    // Convert from ECEF TO GLOBAL
+    case GLOBAL:
+      for (size_t i = 0; i < _count; ++i)
+        _out[i] = this->rotECEFToGlobal * (_in[i] - this->origin);
+      return true;
+
+    // Convert from ECEF TO LOCAL
+    case LOCAL:
+    case LOCAL2:
+      for (size_t i = 0; i < _count; ++i)
+      {
+        const Vector3d tmp = this->rotECEFToGlobal * (_in[i] - this->origin);
+        _out[i].Set(
+            tmp.X() * this->cosHea - tmp.Y() * this->sinHea,
+            tmp.X() * this->sinHea + tmp.Y() * this->cosHea,
+            tmp.Z());
+      }
+      return true;
+
+    // Return ECEF (do nothing)
+    case ECEF:
+      if (_out != _in)
+        std::copy(_in, _in + _count, _out);
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+//////////////////////////////////////////////////
+bool SphericalCoordinates::Implementation::TangentFromSpherical(
+    const Vector3d &_latLonEle, Vector3d &_enu) const
+{
+  if (this->tangentRadius <= 0)
+    return false;
+
+  // Longitude difference in [-180, 180]
+  double dLon = _latLonEle.Y() - this->longitudeReference.Degree();
+  if (dLon > 180)
+    dLon -= 360;
+  else if (dLon < -180)
+    dLon += 360;
+  const double east = dLon * this->tangentEast;
+  const double north =
+    (_latLonEle.X() - this->latitudeReference.Degree()) * this->tangentNorth;
+  const double up = _latLonEle.Z() - this->elevationReference -
+    east * east * this->tangentDropEast -
+    north * north * this->tangentDropNorth;
+
+  const double limit =
+    std::min(this->tangentRadius, this->tangentPoleDistance);
+  if (east * east + north * north + up * up > limit * limit)
+    return false;
+
+  _enu.Set(east, north, up);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SphericalCoordinates::Implementation::SphericalFromTangent(
+    const Vector3d &_enu, Vector3d &_latLonEle) const
+{
+  const double limit =
+    std::min(this->tangentRadius, this->tangentPoleDistance);
+  if (this->tangentRadius <= 0 || _enu.SquaredLength() > limit * limit)
+    return false;
+
+  double lon =
+    this->longitudeReference.Degree() + _enu.X() / this->tangentEast;
+  if (lon > 180)
+    lon -= 360;
+  else if (lon <= -180)
+    lon += 360;
+
+  _latLonEle.Set(
+      this->latitudeReference.Degree() + _enu.Y() / this->tangentNorth,
+      lon,
+      this->elevationReference + _enu.Z() +
+      _enu.X() * _enu.X() * this->tangentDropEast +
+      _enu.Y() * _enu.Y() * this->tangentDropNorth);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SphericalCoordinates::Implementation::VelocityRotation(
+    SphericalCoordinates::CoordinateType _in,
+    SphericalCoordinates::CoordinateType _out, Matrix3d &_rotation) const
+{
+  // Heading rotations of the LOCAL frames.
+  const Matrix3d fromLocal(
+      -this->cosHea, this->sinHea, 0,
+      -this->sinHea, -this->cosHea, 0,
+      0, 0, 1);
+  const Matrix3d fromLocal2(
+      this->cosHea, this->sinHea, 0,
+      -this->sinHea, this->cosHea, 0,
+      0, 0, 1);
+  const Matrix3d toLocal(
+      this->cosHea, -this->sinHea, 0,
+      this->sinHea, this->cosHea, 0,
+      0, 0, 1);
+
+  // First, to ECEF
+  Matrix3d toECEF;
+  switch (_in)
+  {
+    case LOCAL:
+      toECEF = this->rotGlobalToECEF * fromLocal;
+      break;
+    case LOCAL2:
+      toECEF = this->rotGlobalToECEF * fromLocal2;
+      break;
+    case GLOBAL:
+      toECEF = this->rotGlobalToECEF;
+      break;
+    case ECEF:
+      toECEF = Matrix3d::Identity;
+      break;
+    default:
+      return false;
+  }
+
+  // Then, to the requested coordinate type
+  switch (_out)
+  {
+    case ECEF:
+      _rotation = toECEF;
+      return true;
+    case GLOBAL:
+      _rotation = this->rotECEFToGlobal * toECEF;
+      return true;
+    case LOCAL:
+    case LOCAL2:
+      _rotation = toLocal * this->rotECEFToGlobal * toECEF;
+      return true;
+    default:
+      return false;
+  }
+}
+
+//////////////////////////////////////////////////
+void SphericalCoordinates::Implementation::Update() const
+{
+  // Cache trig results
+  double cosLat = cos(this->latitudeReference.Radian());
+  double sinLat = sin(this->latitudeReference.Radian());
+  double cosLon = cos(this->longitudeReference.Radian());
+  double sinLon = sin(this->longitudeReference.Radian());
+
+  // Create a rotation matrix that moves ECEF to GLOBAL
+  // http://www.navipedia.net/index.php/
+  // Transformations_between_ECEF_and_ENU_coordinates
+  this->rotECEFToGlobal = Matrix3d(
+                      -sinLon,           cosLon,          0.0,
+                      -cosLon * sinLat, -sinLon * sinLat, cosLat,
+                       cosLon * cosLat,  sinLon * cosLat, sinLat);
+
+  // Create a rotation matrix that moves GLOBAL to ECEF
+  // http://www.navipedia.net/index.php/
+  // Transformations_between_ECEF_and_ENU_coordinates
+  this->rotGlobalToECEF = Matrix3d(
+                      -sinLon, -cosLon * sinLat, cosLon * cosLat,
+                       cosLon, -sinLon * sinLat, sinLon * cosLat,
+                       0,      cosLat,           sinLat);
+
+  // Cache heading transforms -- note that we have to negate the heading in
+  // order to preserve backward compatibility. ie. Gazebo has traditionally
+  // expressed positive angle as a CLOCKWISE rotation that takes the GLOBAL
+  // frame to the LOCAL frame. However, right hand coordinate systems require
+  // this to be expressed as an ANTI-CLOCKWISE rotation. So, we negate it.
+  this->cosHea = cos(-this->headingOffset.Radian());
+  this->sinHea = sin(-this->headingOffset.Radian());
+
+  // Cache the ECEF coordinate of the origin
+  this->origin = Vector3d(
+    this->latitudeReference.Radian(),
+    this->longitudeReference.Radian(),
+    this->elevationReference);
+  this->ToECEF(&this->origin, &this->origin, 1, SPHERICAL);
+
+  // Cache the tangent plane approximation, from the meridional (M) and
+  // prime vertical (N) radii of curvature at the reference.
+  const double e2 = this->ellE * this->ellE;
+  const double w2 = 1.0 - e2 * sinLat * sinLat;
+  const double radiusN = this->ellA / sqrt(w2) + this->elevationReference;
+  const double radiusM = this->ellA * (1.0 - e2) / (w2 * sqrt(w2)) +
+    this->elevationReference;
+  this->tangentNorth = GZ_DTOR(radiusM);
+  this->tangentEast = GZ_DTOR(radiusN * cosLat);
+  this->tangentDropNorth = 0.5 / radiusM;
+  this->tangentDropEast = 0.5 / radiusN;
+  this->tangentTanLat = std::abs(sinLat / cosLat);
+  this->tangentPoleDistance = 0.01 * radiusN * std::abs(cosLat);
+}
+
+//////////////////////////////////////////////////
+void SphericalCoordinates::Implementation::Refresh() const
+{
+  this->lazy.Refresh([this]()
+  {
+    this->Update();
+  });
+}
+
 //////////////////////////////////////////////////
 SphericalCoordinates::SurfaceType SphericalCoordinates::Convert(
   const std::string &_str)
@@ -294,6 +1056,8 @@ void SphericalCoordinates::SetSurface(const SurfaceType &_type)
       break;
       }
   }
+
+  this->dataPtr->lazy.dirty = true;
 }
 
 //////////////////////////////////////////////////
@@ -341,6 +1105,8 @@ void SphericalCoordinates::SetSurface(
   this->dataPtr->ellP = sqrt(
       std::pow(this->dataPtr->ellA, 2) / std::pow(this->dataPtr->ellB, 2) -
       1.0);
+
+  this->dataPtr->lazy.dirty = true;
 }
 
 //////////////////////////////////////////////////
@@ -348,7 +1114,7 @@ void SphericalCoordinates::SetLatitudeReference(
     const Angle &_angle)
 {
   this->dataPtr->latitudeReference = _angle;
-  this->UpdateTransformationMatrix();
+  this->dataPtr->lazy.dirty = true;
 }
 
 //////////////////////////////////////////////////
@@ -356,28 +1122,39 @@ void SphericalCoordinates::SetLongitudeReference(
     const Angle &_angle)
 {
   this->dataPtr->longitudeReference = _angle;
-  this->UpdateTransformationMatrix();
+  this->dataPtr->lazy.dirty = true;
 }
 
 //////////////////////////////////////////////////
 void SphericalCoordinates::SetElevationReference(const double _elevation)
 {
   this->dataPtr->elevationReference = _elevation;
-  this->UpdateTransformationMatrix();
+  this->dataPtr->lazy.dirty = true;
 }
 
 //////////////////////////////////////////////////
 void SphericalCoordinates::SetHeadingOffset(const Angle &_angle)
 {
   this->dataPtr->headingOffset.SetRadian(_angle.Radian());
-  this->UpdateTransformationMatrix();
+  this->dataPtr->lazy.dirty = true;
 }
 
 //////////////////////////////////////////////////
 Vector3d SphericalCoordinates::SphericalFromLocalPosition(
     const Vector3d &_xyz) const
 {
-  Vector3d result =
+  this->dataPtr->Refresh();
+
+  // Same rotation as the exact LOCAL conversion, including its known bug.
+  const Vector3d enu(
+      -_xyz.X() * this->dataPtr->cosHea + _xyz.Y() * this->dataPtr->sinHea,
+      -_xyz.X() * this->dataPtr->sinHea - _xyz.Y() * this->dataPtr->cosHea,
+      _xyz.Z());
+  Vector3d result;
+  if (this->dataPtr->SphericalFromTangent(enu, result))
+    return result;
+
+  result =
     this->PositionTransform(_xyz, LOCAL, SPHERICAL);
   result.X(GZ_RTOD(result.X()));
   result.Y(GZ_RTOD(result.Y()));
@@ -388,6 +1165,17 @@ Vector3d SphericalCoordinates::SphericalFromLocalPosition(
 Vector3d SphericalCoordinates::LocalFromSphericalPosition(
     const Vector3d &_xyz) const
 {
+  this->dataPtr->Refresh();
+
+  Vector3d enu;
+  if (this->dataPtr->TangentFromSpherical(_xyz, enu))
+  {
+    return Vector3d(
+        enu.X() * this->dataPtr->cosHea - enu.Y() * this->dataPtr->sinHea,
+        enu.X() * this->dataPtr->sinHea + enu.Y() * this->dataPtr->cosHea,
+        enu.Z());
+  }
+
   Vector3d result = _xyz;
   result.X(GZ_DTOR(result.X()));
   result.Y(GZ_DTOR(result.Y()));
@@ -461,6 +1249,117 @@ double SphericalCoordinates::DistanceBetweenPoints(
   return d;
 }
 
+//////////////////////////////////////////////////
+void SphericalCoordinates::DistanceWGS84(
+    const double *_latA, const double *_lonA,
+    const double *_latB, const double *_lonB,
+    double *_distance, const size_t _count)
+{
+  HaversineDistance(_latA, _lonA, _latB, _lonB, _distance, _count,
+      g_EarthRadius);
+}
+
+//////////////////////////////////////////////////
+void SphericalCoordinates::DistanceWGS84(
+    const double _latA, const double _lonA,
+    const double *_latB, const double *_lonB,
+    double *_distance, const size_t _count)
+{
+  HaversineDistance(_latA, _lonA, _latB, _lonB, _distance, _count,
+      g_EarthRadius);
+}
+
+//////////////////////////////////////////////////
+void SphericalCoordinates::DistanceBetweenPoints(
+    const double *_latA, const double *_lonA,
+    const double *_latB, const double *_lonB,
+    double *_distance, const size_t _count) const
+{
+  HaversineDistance(_latA, _lonA, _latB, _lonB, _distance, _count,
+      this->dataPtr->surfaceRadius);
+}
+
+//////////////////////////////////////////////////
+void SphericalCoordinates::DistanceBetweenPoints(
+    const double _latA, const double _lonA,
+    const double *_latB, const double *_lonB,
+    double *_distance, const size_t _count) const
+{
+  HaversineDistance(_latA, _lonA, _latB, _lonB, _distance, _count,
+      this->dataPtr->surfaceRadius);
+}
+
+//////////////////////////////////////////////////
+double SphericalCoordinates::GeodesicDistance(
+    const Angle &_latA, const Angle &_lonA,
+    const Angle &_latB, const Angle &_lonB) const
+{
+  return VincentyInverse(this->dataPtr->ellA, this->dataPtr->ellB,
+      _latA.Radian(), _lonA.Radian(), _latB.Radian(), _lonB.Radian(),
+      nullptr, nullptr);
+}
+
+//////////////////////////////////////////////////
+double SphericalCoordinates::GeodesicInverse(
+    const Angle &_latA, const Angle &_lonA,
+    const Angle &_latB, const Angle &_lonB,
+    Angle &_azimuthA, Angle &_azimuthB) const
+{
+  double azimuthA, azimuthB;
+  const double distance = VincentyInverse(
+      this->dataPtr->ellA, this->dataPtr->ellB,
+      _latA.Radian(), _lonA.Radian(), _latB.Radian(), _lonB.Radian(),
+      &azimuthA, &azimuthB);
+  _azimuthA.SetRadian(azimuthA);
+  _azimuthB.SetRadian(azimuthB);
+  return distance;
+}
+
+//////////////////////////////////////////////////
+void SphericalCoordinates::GeodesicDirect(
+    const Angle &_lat, const Angle &_lon,
+    const Angle &_azimuth, const double _distance,
+    Angle &_latB, Angle &_lonB, Angle &_azimuthB) const
+{
+  double latB, lonB, azimuthB;
+  VincentyDirect(this->dataPtr->ellA, this->dataPtr->ellB,
+      _lat.Radian(), _lon.Radian(), _azimuth.Radian(), _distance,
+      latB, lonB, &azimuthB);
+  _latB.SetRadian(latB);
+  _lonB.SetRadian(lonB);
+  _azimuthB.SetRadian(azimuthB);
+}
+
+//////////////////////////////////////////////////
+void SphericalCoordinates::GeodesicDistance(
+    const double *_latA, const double *_lonA,
+    const double *_latB, const double *_lonB,
+    double *_distance, const size_t _count) const
+{
+  const double a = this->dataPtr->ellA;
+  const double b = this->dataPtr->ellB;
+  for (size_t i = 0; i < _count; ++i)
+  {
+    _distance[i] = VincentyInverse(a, b, _latA[i], _lonA[i],
+        _latB[i], _lonB[i], nullptr, nullptr);
+  }
+}
+
+//////////////////////////////////////////////////
+void SphericalCoordinates::GeodesicDirect(
+    const double *_lat, const double *_lon,
+    const double *_azimuth, const double *_distance,
+    double *_latB, double *_lonB, const size_t _count) const
+{
+  const double a = this->dataPtr->ellA;
+  const double b = this->dataPtr->ellB;
+  for (size_t i = 0; i < _count; ++i)
+  {
+    VincentyDirect(a, b, _lat[i], _lon[i], _azimuth[i], _distance[i],
+        _latB[i], _lonB[i], nullptr);
+  }
+}
+
 //////////////////////////////////////////////////
 double SphericalCoordinates::SurfaceRadius() const
 {
@@ -488,43 +1387,31 @@ double SphericalCoordinates::SurfaceFlattening() const
 //////////////////////////////////////////////////
 void SphericalCoordinates::UpdateTransformationMatrix()
 {
-  // Cache trig results
-  double cosLat = cos(this->dataPtr->latitudeReference.Radian());
-  double sinLat = sin(this->dataPtr->latitudeReference.Radian());
-  double cosLon = cos(this->dataPtr->longitudeReference.Radian());
-  double sinLon = sin(this->dataPtr->longitudeReference.Radian());
+  this->dataPtr->Update();
+  this->dataPtr->lazy.dirty.store(false, std::memory_order_release);
+}
 
-  // Create a rotation matrix that moves ECEF to GLOBAL
-  // http://www.navipedia.net/index.php/
-  // Transformations_between_ECEF_and_ENU_coordinates
-  this->dataPtr->rotECEFToGlobal = Matrix3d(
-                      -sinLon,           cosLon,          0.0,
-                      -cosLon * sinLat, -sinLon * sinLat, cosLat,
-                       cosLon * cosLat,  sinLon * cosLat, sinLat);
+//////////////////////////////////////////////////
+void SphericalCoordinates::SetTangentPlaneRadius(const double _radius)
+{
+  this->dataPtr->tangentRadius = std::max(_radius, 0.0);
+}
 
-  // Create a rotation matrix that moves GLOBAL to ECEF
-  // http://www.navipedia.net/index.php/
-  // Transformations_between_ECEF_and_ENU_coordinates
-  this->dataPtr->rotGlobalToECEF = Matrix3d(
-                      -sinLon, -cosLon * sinLat, cosLon * cosLat,
-                       cosLon, -sinLon * sinLat, sinLon * cosLat,
-                       0,      cosLat,           sinLat);
+//////////////////////////////////////////////////
+double SphericalCoordinates::TangentPlaneRadius() const
+{
+  return this->dataPtr->tangentRadius;
+}
 
-  // Cache heading transforms -- note that we have to negate the heading in
-  // order to preserve backward compatibility. ie. Gazebo has traditionally
-  // expressed positive angle as a CLOCKWISE rotation that takes the GLOBAL
-  // frame to the LOCAL frame. However, right hand coordinate systems require
-  // this to be expressed as an ANTI-CLOCKWISE rotation. So, we negate it.
-  this->dataPtr->cosHea = cos(-this->dataPtr->headingOffset.Radian());
-  this->dataPtr->sinHea = sin(-this->dataPtr->headingOffset.Radian());
+//////////////////////////////////////////////////
+double SphericalCoordinates::TangentPlaneError(const double _distance) const
+{
+  this->dataPtr->Refresh();
 
-  // Cache the ECEF coordinate of the origin
-  this->dataPtr->origin = Vector3d(
-    this->dataPtr->latitudeReference.Radian(),
-    this->dataPtr->longitudeReference.Radian(),
-    this->dataPtr->elevationReference);
-  this->dataPtr->origin =
-    this->PositionTransform(this->dataPtr->origin, SPHERICAL, ECEF);
+  // The neglected terms are of order d^2 / M, and grow with the
+  // convergence of the meridians at high latitudes.
+  return _distance * _distance * (1.0 + this->dataPtr->tangentTanLat) *
+    2.0 * this->dataPtr->tangentDropNorth;
 }
 
 /////////////////////////////////////////////////
@@ -532,127 +1419,55 @@ Vector3d SphericalCoordinates::PositionTransform(
     const Vector3d &_pos,
     const CoordinateType &_in, const CoordinateType &_out) const
 {
-  Vector3d tmp = _pos;
-
-  // Cache trig results
-  double cosLat = cos(_pos.X());
-  double sinLat = sin(_pos.X());
-  double cosLon = cos(_pos.Y());
-  double sinLon = sin(_pos.Y());
-
-  // Radius of planet curvature (meters)
-  double curvature = 1.0 -
-    this->dataPtr->ellE * this->dataPtr->ellE * sinLat * sinLat;
-  curvature = this->dataPtr->ellA / sqrt(curvature);
+  this->dataPtr->Refresh();
 
   // Convert whatever arrives to a more flexible ECEF coordinate
-  switch (_in)
+  Vector3d tmp;
+  if (!this->dataPtr->ToECEF(&_pos, &tmp, 1, _in))
   {
-    // East, North, Up (ENU), note no break at end of case
-    case LOCAL:
-      {
-        tmp.X(-_pos.X() * this->dataPtr->cosHea + _pos.Y() *
-            this->dataPtr->sinHea);
-        tmp.Y(-_pos.X() * this->dataPtr->sinHea - _pos.Y() *
-            this->dataPtr->cosHea);
-        tmp = this->dataPtr->origin + this->dataPtr->rotGlobalToECEF * tmp;
-        break;
-      }
-
-    case LOCAL2:
-      {
-        tmp.X(_pos.X() * this->dataPtr->cosHea + _pos.Y() *
-            this->dataPtr->sinHea);
-        tmp.Y(-_pos.X() * this->dataPtr->sinHea + _pos.Y() *
-            this->dataPtr->cosHea);
-        tmp = this->dataPtr->origin + this->dataPtr->rotGlobalToECEF * tmp;
-        break;
-      }
-
-    case GLOBAL:
-      {
-        tmp = this->dataPtr->origin + this->dataPtr->rotGlobalToECEF * tmp;
-        break;
-      }
-
-    case SPHERICAL:
-      {
-        tmp.X((_pos.Z() + curvature) * cosLat * cosLon);
-        tmp.Y((_pos.Z() + curvature) * cosLat * sinLon);
-        tmp.Z(((this->dataPtr->ellB * this->dataPtr->ellB)/
-              (this->dataPtr->ellA * this->dataPtr->ellA) *
-              curvature + _pos.Z()) * sinLat);
-        break;
-      }
-
-    // Do nothing
-    case ECEF:
-      break;
-    default:
-      {
-        std::cerr << "Invalid coordinate type[" << _in << "]\n";
-        return _pos;
-      }
+    std::cerr << "Invalid coordinate type[" << _in << "]\n";
+    return _pos;
   }
 
   // Convert ECEF to the requested output coordinate system
-  switch (_out)
+  if (!this->dataPtr->FromECEF(&tmp, &tmp, 1, _out))
   {
-    case SPHERICAL:
-      {
-        // Convert from ECEF to SPHERICAL
-        double p = sqrt(tmp.X() * tmp.X() + tmp.Y() * tmp.Y());
-        double theta = atan((tmp.Z() * this->dataPtr->ellA) /
-            (p * this->dataPtr->ellB));
-
-        // Calculate latitude and longitude
-        double lat = atan(
-            (tmp.Z() + std::pow(this->dataPtr->ellP, 2) * this->dataPtr->ellB *
-             std::pow(sin(theta), 3)) /
-            (p - std::pow(this->dataPtr->ellE, 2) *
-             this->dataPtr->ellA * std::pow(cos(theta), 3)));
-
-        double lon = atan2(tmp.Y(), tmp.X());
-
-        // Recalculate radius of planet curvature at the current latitude.
-        double nCurvature = 1.0 - std::pow(this->dataPtr->ellE, 2) *
-          std::pow(sin(lat), 2);
-        nCurvature = this->dataPtr->ellA / sqrt(nCurvature);
-
-        tmp.X(lat);
-        tmp.Y(lon);
-
-        // Now calculate Z
-        tmp.Z(p/cos(lat) - nCurvature);
-        break;
-      }
-
-    // Convert from ECEF TO GLOBAL
-    case GLOBAL:
-      tmp = this->dataPtr->rotECEFToGlobal * (tmp - this->dataPtr->origin);
-      break;
-
-    // Convert from ECEF TO LOCAL
-    case LOCAL:
-    case LOCAL2:
-      tmp = this->dataPtr->rotECEFToGlobal * (tmp - this->dataPtr->origin);
+    std::cerr << "Unknown coordinate type[" << _out << "]\n";
+    return _pos;
+  }
 
-      tmp = Vector3d(
-          tmp.X() * this->dataPtr->cosHea - tmp.Y() * this->dataPtr->sinHea,
-          tmp.X() * this->dataPtr->sinHea + tmp.Y() * this->dataPtr->cosHea,
-          tmp.Z());
-      break;
+  return tmp;
+}
 
-    // Return ECEF (do nothing)
-    case ECEF:
-      break;
+/////////////////////////////////////////////////
+void SphericalCoordinates::PositionTransform(
+    const Vector3d *_pos, Vector3d *_result, size_t _count,
+    const CoordinateType &_in, const CoordinateType &_out) const
+{
+  this->dataPtr->Refresh();
 
-    default:
-      std::cerr << "Unknown coordinate type[" << _out << "]\n";
-      return _pos;
+  // Check the types once, so no position is half converted.
+  Vector3d check;
+  if (!this->dataPtr->ToECEF(&check, &check, 0, _in))
+  {
+    std::cerr << "Invalid coordinate type[" << _in << "]\n";
+    std::copy(_pos, _pos + _count, _result);
+    return;
+  }
+  if (!this->dataPtr->FromECEF(&check, &check, 0, _out))
+  {
+    std::cerr << "Unknown coordinate type[" << _out << "]\n";
+    std::copy(_pos, _pos + _count, _result);
+    return;
   }
 
-  return tmp;
+  Vector3d ecef[kTransformChunk];
+  for (size_t start = 0; start < _count; start += kTransformChunk)
+  {
+    const size_t n = std::min(kTransformChunk, _count - start);
+    this->dataPtr->ToECEF(_pos + start, ecef, n, _in);
+    this->dataPtr->FromECEF(ecef, _result + start, n, _out);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -660,6 +1475,8 @@ Vector3d SphericalCoordinates::VelocityTransform(
     const Vector3d &_vel,
     const CoordinateType &_in, const CoordinateType &_out) const
 {
+  this->dataPtr->Refresh();
+
   // Sanity check -- velocity should not be expressed in spherical coordinates
   if (_in == SPHERICAL || _out == SPHERICAL)
   {
@@ -730,6 +1547,28 @@ Vector3d SphericalCoordinates::VelocityTransform(
   return tmp;
 }
 
+//////////////////////////////////////////////////
+void SphericalCoordinates::VelocityTransform(
+    const Vector3d *_vel, Vector3d *_result, size_t _count,
+    const CoordinateType &_in, const CoordinateType &_out) const
+{
+  this->dataPtr->Refresh();
+
+  // Sanity check -- velocity should not be expressed in spherical coordinates
+  Matrix3d rotation;
+  if (_in == SPHERICAL || _out == SPHERICAL ||
+      !this->dataPtr->VelocityRotation(_in, _out, rotation))
+  {
+    if (_in != SPHERICAL && _out != SPHERICAL)
+      std::cerr << "Unknown coordinate type[" << _in << ", " << _out << "]\n";
+    std::copy(_vel, _vel + _count, _result);
+    return;
+  }
+
+  for (size_t i = 0; i < _count; ++i)
+    _result[i] = rotation * _vel[i];
+}
+
 //////////////////////////////////////////////////
 bool SphericalCoordinates::operator==(const SphericalCoordinates &_sc) const
 {
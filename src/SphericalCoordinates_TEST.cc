@@ -16,6 +16,10 @@
 */
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <thread>
+#include <vector>
+
 #include "gz/math/SphericalCoordinates.hh"
 
 using namespace gz;
@@ -435,6 +439,67 @@ TEST(SphericalCoordinatesTest, Distance)
       d1, 0.1);
 }
 
+//////////////////////////////////////////////////
+TEST(SphericalCoordinatesTest, BatchDistance)
+{
+  // Points all over the sphere, including the poles, the antimeridian and
+  // longitudes beyond +/- pi.
+  std::vector<double> latA, lonA, latB, lonB;
+  for (int i = 0; i < 1000; ++i)
+  {
+    latA.push_back(GZ_PI_2 * std::sin(0.37 * i));
+    lonA.push_back(4.0 * std::cos(0.11 * i));
+    latB.push_back(GZ_PI_2 * std::cos(1.3 * i));
+    lonB.push_back(-3.2 * std::sin(0.7 * i));
+  }
+  latA[1] = GZ_PI_2;
+  latB[2] = -GZ_PI_2;
+  lonA[3] = GZ_PI;
+  lonB[3] = -GZ_PI;
+  latB[4] = latA[4];
+  lonB[4] = lonA[4];
+
+  std::vector<double> distance(latA.size());
+  math::SphericalCoordinates::DistanceWGS84(latA.data(), lonA.data(),
+      latB.data(), lonB.data(), distance.data(), distance.size());
+  for (size_t i = 0; i < distance.size(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(math::SphericalCoordinates::DistanceWGS84(
+        latA[i], lonA[i], latB[i], lonB[i]), distance[i]) << i;
+  }
+  EXPECT_DOUBLE_EQ(0.0, distance[4]);
+
+  // One to many.
+  math::SphericalCoordinates::DistanceWGS84(latA[0], lonA[0],
+      latB.data(), lonB.data(), distance.data(), distance.size());
+  for (size_t i = 0; i < distance.size(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(math::SphericalCoordinates::DistanceWGS84(
+        latA[0], lonA[0], latB[i], lonB[i]), distance[i]) << i;
+  }
+
+  // On the surface of the moon.
+  math::SphericalCoordinates moon(math::SphericalCoordinates::MOON_SCS);
+  moon.DistanceBetweenPoints(latA.data(), lonA.data(),
+      latB.data(), lonB.data(), distance.data(), distance.size());
+  for (size_t i = 0; i < distance.size(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(moon.DistanceBetweenPoints(
+        latA[i], lonA[i], latB[i], lonB[i]), distance[i]) << i;
+  }
+  moon.DistanceBetweenPoints(latA[5], lonA[5],
+      latB.data(), lonB.data(), distance.data(), distance.size());
+  for (size_t i = 0; i < distance.size(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(moon.DistanceBetweenPoints(
+        latA[5], lonA[5], latB[i], lonB[i]), distance[i]) << i;
+  }
+
+  // Nothing to do.
+  math::SphericalCoordinates::DistanceWGS84(nullptr, nullptr, nullptr,
+      nullptr, nullptr, 0);
+}
+
 //////////////////////////////////////////////////
 TEST(SphericalCoordinatesTest, BadSetSurface)
 {
@@ -786,3 +851,340 @@ TEST(SphericalCoordinatesTest, Inverse)
     EXPECT_EQ(in, reverse);
   }
 }
+
+//////////////////////////////////////////////////
+TEST(SphericalCoordinatesTest, BatchTransforms)
+{
+  math::SphericalCoordinates sc(math::SphericalCoordinates::EARTH_WGS84,
+      GZ_DTOR(47.3667), GZ_DTOR(8.5500), 500.0, GZ_DTOR(30.0));
+
+  std::vector<math::Vector3d> local;
+  for (int i = 0; i < 600; ++i)
+    local.emplace_back(10.0 * i, -5.0 * i, 0.5 * i);
+
+  const math::SphericalCoordinates::CoordinateType types[] = {
+    math::SphericalCoordinates::SPHERICAL,
+    math::SphericalCoordinates::ECEF,
+    math::SphericalCoordinates::GLOBAL,
+    math::SphericalCoordinates::LOCAL,
+    math::SphericalCoordinates::LOCAL2};
+
+  // Same positions as the single position version, for every pair of
+  // coordinate types.
+  std::vector<math::Vector3d> input(local.size());
+  std::vector<math::Vector3d> output(local.size());
+  for (const auto in : types)
+  {
+    sc.PositionTransform(local.data(), input.data(), local.size(),
+        math::SphericalCoordinates::LOCAL2, in);
+    for (const auto out : types)
+    {
+      sc.PositionTransform(input.data(), output.data(), input.size(),
+          in, out);
+      for (size_t i = 0; i < input.size(); ++i)
+        EXPECT_EQ(sc.PositionTransform(input[i], in, out), output[i]);
+
+      // Velocities, except in spherical coordinates.
+      if (in == math::SphericalCoordinates::SPHERICAL ||
+          out == math::SphericalCoordinates::SPHERICAL)
+      {
+        continue;
+      }
+      sc.VelocityTransform(local.data(), output.data(), local.size(),
+          in, out);
+      for (size_t i = 0; i < local.size(); ++i)
+      {
+        const auto expected = sc.VelocityTransform(local[i], in, out);
+        EXPECT_NEAR(expected.X(), output[i].X(), 1e-9);
+        EXPECT_NEAR(expected.Y(), output[i].Y(), 1e-9);
+        EXPECT_NEAR(expected.Z(), output[i].Z(), 1e-9);
+      }
+    }
+  }
+
+  // In place.
+  output = local;
+  sc.PositionTransform(output.data(), output.data(), output.size(),
+      math::SphericalCoordinates::LOCAL2,
+      math::SphericalCoordinates::SPHERICAL);
+  sc.PositionTransform(output.data(), output.data(), output.size(),
+      math::SphericalCoordinates::SPHERICAL,
+      math::SphericalCoordinates::LOCAL2);
+  for (size_t i = 0; i < local.size(); ++i)
+  {
+    EXPECT_NEAR(local[i].X(), output[i].X(), 1e-6);
+    EXPECT_NEAR(local[i].Y(), output[i].Y(), 1e-6);
+    EXPECT_NEAR(local[i].Z(), output[i].Z(), 1e-6);
+  }
+
+  // Invalid types copy the input, spherical velocities too.
+  const auto invalid =
+    static_cast<math::SphericalCoordinates::CoordinateType>(17);
+  sc.PositionTransform(local.data(), output.data(), local.size(),
+      invalid, math::SphericalCoordinates::ECEF);
+  EXPECT_EQ(local, output);
+  sc.PositionTransform(local.data(), output.data(), local.size(),
+      math::SphericalCoordinates::ECEF, invalid);
+  EXPECT_EQ(local, output);
+  sc.VelocityTransform(local.data(), output.data(), local.size(),
+      math::SphericalCoordinates::SPHERICAL,
+      math::SphericalCoordinates::ECEF);
+  EXPECT_EQ(local, output);
+  sc.VelocityTransform(local.data(), output.data(), local.size(),
+      math::SphericalCoordinates::ECEF, invalid);
+  EXPECT_EQ(local, output);
+}
+
+//////////////////////////////////////////////////
+TEST(SphericalCoordinatesTest, TangentPlane)
+{
+  const math::Angle lat(GZ_DTOR(47.3667));
+  const math::Angle lon(GZ_DTOR(8.5500));
+  const math::Angle heading(GZ_DTOR(30.0));
+  math::SphericalCoordinates exact(math::SphericalCoordinates::EARTH_WGS84,
+      lat, lon, 500.0, heading);
+  math::SphericalCoordinates sc(math::SphericalCoordinates::EARTH_WGS84,
+      lat, lon, 500.0, heading);
+
+  // Disabled by default.
+  EXPECT_DOUBLE_EQ(0.0, sc.TangentPlaneRadius());
+  const math::Vector3d near(300.0, -400.0, 20.0);
+  EXPECT_EQ(exact.SphericalFromLocalPosition(near),
+      sc.SphericalFromLocalPosition(near));
+
+  sc.SetTangentPlaneRadius(-1.0);
+  EXPECT_DOUBLE_EQ(0.0, sc.TangentPlaneRadius());
+  sc.SetTangentPlaneRadius(2000.0);
+  EXPECT_DOUBLE_EQ(2000.0, sc.TangentPlaneRadius());
+
+  // The bound grows with the square of the distance.
+  EXPECT_DOUBLE_EQ(0.0, sc.TangentPlaneError(0.0));
+  EXPECT_DOUBLE_EQ(4 * sc.TangentPlaneError(500.0),
+      sc.TangentPlaneError(1000.0));
+  EXPECT_LT(sc.TangentPlaneError(1000.0), 0.5);
+
+  // Close to the reference, within the error bound of the exact results.
+  for (int i = -5; i <= 5; ++i)
+  {
+    for (int j = -5; j <= 5; ++j)
+    {
+      const math::Vector3d local(190.0 * i, 170.0 * j, 3.0 * (i - j));
+      const double bound = sc.TangentPlaneError(local.Length()) + 1e-6;
+
+      const math::Vector3d latLonEle = exact.SphericalFromLocalPosition(local);
+      const math::Vector3d approx = sc.LocalFromSphericalPosition(latLonEle);
+      EXPECT_LE(
+          approx.Distance(exact.LocalFromSphericalPosition(latLonEle)),
+          bound);
+
+      math::Vector3d s1 = sc.SphericalFromLocalPosition(local);
+      math::Vector3d s2 = latLonEle;
+      s1.X(GZ_DTOR(s1.X()));
+      s1.Y(GZ_DTOR(s1.Y()));
+      s2.X(GZ_DTOR(s2.X()));
+      s2.Y(GZ_DTOR(s2.Y()));
+      EXPECT_LE(
+          exact.PositionTransform(s1, math::SphericalCoordinates::SPHERICAL,
+              math::SphericalCoordinates::ECEF).Distance(
+          exact.PositionTransform(s2, math::SphericalCoordinates::SPHERICAL,
+              math::SphericalCoordinates::ECEF)),
+          bound);
+    }
+  }
+
+  // Beyond the radius, the exact conversions.
+  const math::Vector3d far(1500.0, 1500.0, 0.0);
+  EXPECT_EQ(exact.SphericalFromLocalPosition(far),
+      sc.SphericalFromLocalPosition(far));
+  const math::Vector3d farLatLonEle(47.40, 8.55, 500.0);
+  EXPECT_EQ(exact.LocalFromSphericalPosition(farLatLonEle),
+      sc.LocalFromSphericalPosition(farLatLonEle));
+
+  // Across the antimeridian.
+  math::SphericalCoordinates date(math::SphericalCoordinates::EARTH_WGS84,
+      math::Angle(0.0), math::Angle(GZ_DTOR(179.9995)), 0.0, math::Angle());
+  date.SetTangentPlaneRadius(1000.0);
+  const math::Vector3d east = date.LocalFromSphericalPosition(
+      math::Vector3d(0.0, -179.9995, 0.0));
+  EXPECT_NEAR(111.3, east.X(), 0.1);
+  EXPECT_NEAR(0.0, east.Y(), 1e-6);
+  const math::Vector3d back = date.SphericalFromLocalPosition(
+      math::Vector3d(-east.X(), 0.0, east.Z()));
+  EXPECT_NEAR(-179.9995, back.Y(), 1e-9);
+  EXPECT_NEAR(0.0, back.Z(), 1e-6);
+
+  // Never at the poles.
+  math::SphericalCoordinates pole(math::SphericalCoordinates::EARTH_WGS84,
+      math::Angle(GZ_DTOR(90.0)), math::Angle(), 0.0, math::Angle());
+  math::SphericalCoordinates poleExact(
+      math::SphericalCoordinates::EARTH_WGS84,
+      math::Angle(GZ_DTOR(90.0)), math::Angle(), 0.0, math::Angle());
+  pole.SetTangentPlaneRadius(1000.0);
+  EXPECT_EQ(poleExact.SphericalFromLocalPosition(near),
+      pole.SphericalFromLocalPosition(near));
+}
+
+//////////////////////////////////////////////////
+TEST(SphericalCoordinatesTest, LazyUpdate)
+{
+  const math::Angle lat(GZ_DTOR(-22.9068));
+  const math::Angle lon(GZ_DTOR(-43.1729));
+  const math::Angle heading(GZ_DTOR(-15.0));
+  const math::SphericalCoordinates expected(
+      math::SphericalCoordinates::EARTH_WGS84, lat, lon, 12.0, heading);
+
+  // Several setters, then conversions.
+  math::SphericalCoordinates sc;
+  sc.SetLatitudeReference(lat);
+  sc.SetLongitudeReference(lon);
+  sc.SetElevationReference(12.0);
+  sc.SetHeadingOffset(heading);
+
+  const math::Vector3d local(150.0, -20.0, 3.0);
+  const auto toSpherical = [&](const math::SphericalCoordinates &_sc)
+  {
+    return _sc.PositionTransform(local, math::SphericalCoordinates::LOCAL2,
+        math::SphericalCoordinates::SPHERICAL);
+  };
+  EXPECT_EQ(toSpherical(expected), toSpherical(sc));
+  EXPECT_EQ(expected.VelocityTransform(local,
+        math::SphericalCoordinates::LOCAL2,
+        math::SphericalCoordinates::GLOBAL),
+      sc.VelocityTransform(local, math::SphericalCoordinates::LOCAL2,
+        math::SphericalCoordinates::GLOBAL));
+
+  // An explicit update gives the same result.
+  sc.SetHeadingOffset(math::Angle(GZ_DTOR(40.0)));
+  sc.SetHeadingOffset(heading);
+  sc.UpdateTransformationMatrix();
+  EXPECT_EQ(toSpherical(expected), toSpherical(sc));
+
+  // Changing the surface updates the origin too.
+  const math::SphericalCoordinates moon(
+      math::SphericalCoordinates::MOON_SCS, lat, lon, 12.0, heading);
+  sc.SetSurface(math::SphericalCoordinates::MOON_SCS);
+  EXPECT_EQ(toSpherical(moon), toSpherical(sc));
+  sc.SetSurface(math::SphericalCoordinates::EARTH_WGS84);
+  EXPECT_EQ(toSpherical(expected), toSpherical(sc));
+
+  // Concurrent conversions, the first of which computes the state.
+  sc.SetLatitudeReference(math::Angle(GZ_DTOR(10.0)));
+  sc.SetLatitudeReference(lat);
+  const math::SphericalCoordinates &shared = sc;
+  std::vector<std::thread> threads;
+  std::vector<math::Vector3d> results(8);
+  for (size_t t = 0; t < results.size(); ++t)
+  {
+    threads.emplace_back([&shared, &results, &toSpherical, t]()
+    {
+      for (int i = 0; i < 100; ++i)
+        results[t] = toSpherical(shared);
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  for (const auto &result : results)
+    EXPECT_EQ(toSpherical(expected), result);
+}
+
+//////////////////////////////////////////////////
+TEST(SphericalCoordinatesTest, GeodesicDistance)
+{
+  using Angle = math::Angle;
+  auto deg = [](const double _deg) { return Angle(GZ_DTOR(_deg)); };
+  math::SphericalCoordinates sc;
+  Angle azimuthA, azimuthB;
+
+  // Vincenty's example: Flinders Peak to Buninyong, on the Australian
+  // National Spheroid, which is very close to WGS84.
+  const Angle flindersLat = deg(-(37 + 57 / 60.0 + 3.72030 / 3600));
+  const Angle flindersLon = deg(144 + 25 / 60.0 + 29.52440 / 3600);
+  const Angle buninyongLat = deg(-(37 + 39 / 60.0 + 10.15610 / 3600));
+  const Angle buninyongLon = deg(143 + 55 / 60.0 + 35.38390 / 3600);
+  EXPECT_NEAR(54972.271, sc.GeodesicInverse(flindersLat, flindersLon,
+      buninyongLat, buninyongLon, azimuthA, azimuthB), 1e-2);
+  EXPECT_NEAR(306 + 52 / 60.0 + 5.37 / 3600 - 360, azimuthA.Degree(), 1e-4);
+  EXPECT_NEAR(127 + 10 / 60.0 + 25.07 / 3600 - 180, azimuthB.Degree(), 1e-4);
+
+  // Quarter meridian of WGS84.
+  EXPECT_NEAR(10001965.729, sc.GeodesicDistance(
+      deg(0), deg(0), deg(90), deg(0)), 1e-3);
+  EXPECT_NEAR(2 * 10001965.729, sc.GeodesicDistance(
+      deg(90), deg(0), deg(-90), deg(0)), 2e-3);
+
+  // Along the equator, the distance is the arc of the equatorial circle.
+  EXPECT_NEAR(sc.SurfaceAxisEquatorial() * GZ_DTOR(10), sc.GeodesicDistance(
+      deg(0), deg(-5), deg(0), deg(5)), 1e-6);
+  EXPECT_DOUBLE_EQ(0.0, sc.GeodesicDistance(
+      deg(12), deg(34), deg(12), deg(34)));
+
+  // Nearly antipodal points, where Vincenty's iteration does not converge.
+  // Wellington to Salamanca, and Karney's example (Algorithms for
+  // geodesics, 2013).
+  EXPECT_NEAR(19959679.267, sc.GeodesicDistance(
+      deg(-41.32), deg(174.81), deg(40.96), deg(-5.50)), 1e-2);
+  EXPECT_NEAR(19989832.82761, sc.GeodesicInverse(
+      deg(-30), deg(0), deg(29.9), deg(179.8), azimuthA, azimuthB), 1e-4);
+  EXPECT_NEAR(161.890524736, azimuthA.Degree(), 1e-6);
+  EXPECT_NEAR(18.090737246, azimuthB.Degree(), 1e-6);
+
+  // The direct problem goes back to the other point, including around the
+  // antipodes.
+  for (const double lat2 : {-60.0, -0.5, 0.0, 0.3, 45.0})
+  {
+    for (const double dLon : {1.0, 90.0, 179.0, 179.4, 179.9})
+    {
+      const Angle lat1 = deg(-0.3);
+      const Angle lon1 = deg(20);
+      const double distance = sc.GeodesicInverse(
+          lat1, lon1, deg(lat2), deg(20 + dLon), azimuthA, azimuthB);
+      Angle latB, lonB, azimuthEnd;
+      sc.GeodesicDirect(lat1, lon1, azimuthA, distance,
+          latB, lonB, azimuthEnd);
+      // About 1e-5 m on the surface.
+      EXPECT_NEAR(GZ_DTOR(lat2), latB.Radian(), 2e-12)
+          << lat2 << " " << dLon;
+      EXPECT_NEAR(GZ_DTOR(std::remainder(20 + dLon, 360)), lonB.Radian(),
+          2e-12) << lat2 << " " << dLon;
+      EXPECT_NEAR(azimuthB.Radian(), azimuthEnd.Radian(), 1e-9)
+          << lat2 << " " << dLon;
+    }
+  }
+
+  // The batch versions give the same results as the scalar ones.
+  std::vector<double> latA, lonA, latB, lonB, azimuth;
+  for (int i = 0; i < 100; ++i)
+  {
+    latA.push_back(GZ_DTOR(-89.0 + 1.78 * i));
+    lonA.push_back(GZ_DTOR(-180.0 + 3.6 * i));
+    latB.push_back(GZ_DTOR(60.0 - 1.5 * i));
+    lonB.push_back(GZ_DTOR(10.0 + 1.9 * i));
+    azimuth.push_back(GZ_DTOR(-170.0 + 3.4 * i));
+  }
+  std::vector<double> distance(latA.size()), latEnd(latA.size()),
+      lonEnd(latA.size());
+  sc.GeodesicDistance(latA.data(), lonA.data(), latB.data(), lonB.data(),
+      distance.data(), distance.size());
+  sc.GeodesicDirect(latA.data(), lonA.data(), azimuth.data(),
+      distance.data(), latEnd.data(), lonEnd.data(), distance.size());
+  for (size_t i = 0; i < latA.size(); ++i)
+  {
+    EXPECT_EQ(sc.GeodesicDistance(Angle(latA[i]), Angle(lonA[i]),
+        Angle(latB[i]), Angle(lonB[i])), distance[i]);
+    Angle latExpected, lonExpected, azimuthExpected;
+    sc.GeodesicDirect(Angle(latA[i]), Angle(lonA[i]), Angle(azimuth[i]),
+        distance[i], latExpected, lonExpected, azimuthExpected);
+    EXPECT_EQ(latExpected.Radian(), latEnd[i]);
+    EXPECT_EQ(lonExpected.Radian(), lonEnd[i]);
+  }
+
+  // Other surfaces use their own axes.
+  math::SphericalCoordinates moon(
+      math::SphericalCoordinates::MOON_SCS);
+  EXPECT_NEAR(moon.SurfaceAxisEquatorial() * GZ_PI_2,
+      moon.GeodesicDistance(deg(0), deg(0), deg(0), deg(90)), 1e-6);
+  const double quarterMeridian =
+      moon.GeodesicDistance(deg(0), deg(0), deg(90), deg(0));
+  EXPECT_LT(moon.SurfaceAxisPolar() * GZ_PI_2, quarterMeridian);
+  EXPECT_GT(moon.SurfaceAxisEquatorial() * GZ_PI_2, quarterMeridian);
+}
@@ -0,0 +1,589 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "gz/math/SphericalPointIndex.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <utility>
+
+#include "gz/math/Helpers.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+/// \brief Number of points above which a tile is split.
+constexpr std::size_t kTileCapacity = 32;
+
+/// \brief Deepest level of the tiles. Tiles of this level are about 1 m
+/// high on Earth, and are not split even if they hold more points.
+constexpr unsigned int kMaxLevel = 24;
+
+/// \brief No tile, or no children.
+constexpr std::size_t kNone = static_cast<std::size_t>(-1);
+
+/// \brief A point stored in a tile.
+struct Entry
+{
+  /// \brief Latitude in radians.
+  double lat;
+
+  /// \brief Longitude in radians, in [-pi, pi].
+  double lon;
+
+  /// \brief Cosine of the latitude.
+  double cosLat;
+
+  /// \brief Index of the point.
+  std::size_t id;
+};
+
+/// \brief A tile of the quadtree.
+struct Tile
+{
+  /// \brief Southern bound in radians.
+  double latMin;
+
+  /// \brief Northern bound in radians.
+  double latMax;
+
+  /// \brief Western bound in radians.
+  double lonMin;
+
+  /// \brief Eastern bound in radians.
+  double lonMax;
+
+  /// \brief Level of the tile, 0 for the root.
+  unsigned int level;
+
+  /// \brief Index of the first of the four children, kNone for a leaf.
+  /// The children are ordered as the pairs of bits of a tile key.
+  std::size_t children{kNone};
+
+  /// \brief Points of a leaf.
+  std::vector<Entry> entries;
+};
+
+/// \brief Get the quadrant of a tile that contains a position.
+/// \param[in] _tile The tile.
+/// \param[in] _lat Latitude in radians.
+/// \param[in] _lon Longitude in radians, in [-pi, pi].
+/// \return Quadrant, as the pair of bits of a tile key.
+unsigned int Quadrant(const Tile &_tile, const double _lat, const double _lon)
+{
+  const bool north = _lat >= (_tile.latMin + _tile.latMax) / 2;
+  const bool east = _lon >= (_tile.lonMin + _tile.lonMax) / 2;
+  return (north ? 2u : 0u) | (east ? 1u : 0u);
+}
+
+/// \brief Wrap a longitude into [-pi, pi].
+double WrapLongitude(const double _lon)
+{
+  if (_lon >= -GZ_PI && _lon <= GZ_PI)
+    return _lon;
+  return std::remainder(_lon, 2 * GZ_PI);
+}
+
+/// \brief Haversine of the central angle between two points, which grows
+/// with their distance. Comparing it avoids an atan2 per point.
+double Haversine(const double _latA, const double _cosLatA,
+                 const double _latB, const double _cosLatB,
+                 const double _lonDiff)
+{
+  const double sinLat = std::sin((_latB - _latA) / 2);
+  const double sinLon = std::sin(_lonDiff / 2);
+  return sinLat * sinLat + sinLon * sinLon * _cosLatA * _cosLatB;
+}
+
+/// \brief Convert a haversine to a distance, as
+/// SphericalCoordinates::DistanceBetweenPoints does.
+double HaversineToDistance(const double _a, const double _radius)
+{
+  return _radius * (2 * std::atan2(std::sqrt(_a), std::sqrt(1 - _a)));
+}
+
+/// \brief A query position.
+struct Query
+{
+  /// \brief Latitude in radians.
+  double lat;
+
+  /// \brief Longitude in radians, in [-pi, pi].
+  double lon;
+
+  /// \brief Sine of the latitude.
+  double sinLat;
+
+  /// \brief Cosine of the latitude.
+  double cosLat;
+};
+
+/// \brief Haversine of the distance from a query position to the closest
+/// point of a tile.
+/// \param[in] _q The query position.
+/// \param[in] _tile The tile.
+/// \return Lower bound of the haversines of the points of the tile.
+double TileHaversine(const Query &_q, const Tile &_tile)
+{
+  // Points on the edges of the tile must not be pruned because of rounding.
+  constexpr double margin = 1 - 1e-12;
+
+  // If the tile spans the longitude of the position, its closest point is
+  // on that meridian.
+  if (_q.lon >= _tile.lonMin && _q.lon <= _tile.lonMax)
+  {
+    const double lat = std::clamp(_q.lat, _tile.latMin, _tile.latMax);
+    const double sinLat = std::sin((lat - _q.lat) / 2);
+    return sinLat * sinLat * margin;
+  }
+
+  // Otherwise, for any latitude, the closest point is on the edge with the
+  // smallest difference of longitude.
+  auto lonDistance = [&](const double _lon)
+  {
+    const double diff = std::abs(_q.lon - _lon);
+    return diff > GZ_PI ? 2 * GZ_PI - diff : diff;
+  };
+  const double west = lonDistance(_tile.lonMin);
+  const double east = lonDistance(_tile.lonMax);
+  const double lonDiff = std::min(west, east);
+
+  // The distance to the points of the meridian of the edge grows with the
+  // distance along the meridian from the foot of the perpendicular, so the
+  // closest point of the edge is the foot, or one of the ends of the edge.
+  const double foot = std::atan2(_q.sinLat, _q.cosLat * std::cos(lonDiff));
+  auto haversine = [&](const double _lat)
+  {
+    return Haversine(_q.lat, _q.cosLat, _lat, std::cos(_lat), lonDiff);
+  };
+  if (foot >= _tile.latMin && foot <= _tile.latMax)
+    return haversine(foot) * margin;
+  return std::min(haversine(_tile.latMin), haversine(_tile.latMax)) * margin;
+}
+}
+
+//////////////////////////////////////////////////
+class gz::math::SphericalPointIndex::Implementation
+{
+  /// \brief Remove all the points and tiles.
+  public: void Reset()
+  {
+    this->tiles.clear();
+    this->tiles.push_back(
+        Tile{-GZ_PI_2, GZ_PI_2, -GZ_PI, GZ_PI, 0, kNone, {}});
+    this->freeTiles.clear();
+    this->lat.clear();
+    this->lon.clear();
+    this->used.clear();
+    this->freeIds.clear();
+    this->size = 0;
+  }
+
+  /// \brief Split a leaf into four tiles, and move its points to them.
+  /// \param[in] _tile Index of the tile.
+  public: void Split(const std::size_t _tile)
+  {
+    std::size_t first;
+    if (!this->freeTiles.empty())
+    {
+      first = this->freeTiles.back();
+      this->freeTiles.pop_back();
+    }
+    else
+    {
+      first = this->tiles.size();
+      this->tiles.resize(first + 4);
+    }
+
+    const Tile &parent = this->tiles[_tile];
+    const double latMid = (parent.latMin + parent.latMax) / 2;
+    const double lonMid = (parent.lonMin + parent.lonMax) / 2;
+    for (unsigned int q = 0; q < 4; ++q)
+    {
+      Tile &child = this->tiles[first + q];
+      child.latMin = (q & 2u) ? latMid : parent.latMin;
+      child.latMax = (q & 2u) ? parent.latMax : latMid;
+      child.lonMin = (q & 1u) ? lonMid : parent.lonMin;
+      child.lonMax = (q & 1u) ? parent.lonMax : lonMid;
+      child.level = parent.level + 1;
+      child.children = kNone;
+      child.entries.clear();
+    }
+
+    std::vector<Entry> entries = std::move(this->tiles[_tile].entries);
+    this->tiles[_tile].entries.clear();
+    this->tiles[_tile].children = first;
+    for (const Entry &entry : entries)
+    {
+      const unsigned int q = Quadrant(this->tiles[_tile], entry.lat,
+          entry.lon);
+      this->tiles[first + q].entries.push_back(entry);
+    }
+  }
+
+  /// \brief Build the tiles below a leaf for a set of points.
+  /// \param[in] _tile Index of the tile.
+  /// \param[in] _entries The points of the tile.
+  public: void BuildTile(const std::size_t _tile, std::vector<Entry> _entries)
+  {
+    if (_entries.size() <= kTileCapacity ||
+        this->tiles[_tile].level >= kMaxLevel)
+    {
+      this->tiles[_tile].entries = std::move(_entries);
+      return;
+    }
+
+    this->Split(_tile);
+    const std::size_t first = this->tiles[_tile].children;
+    std::vector<Entry> quadrants[4];
+    for (const Entry &entry : _entries)
+    {
+      quadrants[Quadrant(this->tiles[_tile], entry.lat, entry.lon)]
+          .push_back(entry);
+    }
+    _entries.clear();
+    _entries.shrink_to_fit();
+    for (unsigned int q = 0; q < 4; ++q)
+      this->BuildTile(first + q, std::move(quadrants[q]));
+  }
+
+  /// \brief Prepare a query.
+  /// \param[in] _lat Latitude of the position.
+  /// \param[in] _lon Longitude of the position.
+  /// \return The query.
+  public: static Query MakeQuery(const Angle &_lat, const Angle &_lon)
+  {
+    const double lat = _lat.Radian();
+    return Query{lat, WrapLongitude(_lon.Radian()), std::sin(lat),
+        std::cos(lat)};
+  }
+
+  /// \brief Radius of the sphere of the distances.
+  public: double radius = 0;
+
+  /// \brief Tiles, the root first.
+  public: std::vector<Tile> tiles;
+
+  /// \brief Indices of the first of four unused tiles.
+  public: std::vector<std::size_t> freeTiles;
+
+  /// \brief Latitude of each point.
+  public: std::vector<double> lat;
+
+  /// \brief Longitude of each point, in [-pi, pi].
+  public: std::vector<double> lon;
+
+  /// \brief Whether each index holds a point.
+  public: std::vector<bool> used;
+
+  /// \brief Indices of removed points, to be reused.
+  public: std::vector<std::size_t> freeIds;
+
+  /// \brief Number of points.
+  public: std::size_t size = 0;
+};
+
+//////////////////////////////////////////////////
+SphericalPointIndex::SphericalPointIndex()
+  : SphericalPointIndex(SphericalCoordinates())
+{
+}
+
+//////////////////////////////////////////////////
+SphericalPointIndex::SphericalPointIndex(const SphericalCoordinates &_sc)
+  : dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+  this->dataPtr->radius = _sc.SurfaceRadius();
+  this->dataPtr->Reset();
+}
+
+//////////////////////////////////////////////////
+double SphericalPointIndex::SurfaceRadius() const
+{
+  return this->dataPtr->radius;
+}
+
+//////////////////////////////////////////////////
+void SphericalPointIndex::Build(const double *_lat, const double *_lon,
+                                const std::size_t _count)
+{
+  this->dataPtr->Reset();
+  this->dataPtr->lat.resize(_count);
+  this->dataPtr->lon.resize(_count);
+  this->dataPtr->used.assign(_count, true);
+  this->dataPtr->size = _count;
+
+  std::vector<Entry> entries(_count);
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const double lon = WrapLongitude(_lon[i]);
+    this->dataPtr->lat[i] = _lat[i];
+    this->dataPtr->lon[i] = lon;
+    entries[i] = Entry{_lat[i], lon, std::cos(_lat[i]), i};
+  }
+  this->dataPtr->BuildTile(0, std::move(entries));
+}
+
+//////////////////////////////////////////////////
+std::size_t SphericalPointIndex::Insert(const Angle &_lat, const Angle &_lon)
+{
+  const double lat = _lat.Radian();
+  const double lon = WrapLongitude(_lon.Radian());
+
+  std::size_t id;
+  if (!this->dataPtr->freeIds.empty())
+  {
+    id = this->dataPtr->freeIds.back();
+    this->dataPtr->freeIds.pop_back();
+    this->dataPtr->lat[id] = lat;
+    this->dataPtr->lon[id] = lon;
+    this->dataPtr->used[id] = true;
+  }
+  else
+  {
+    id = this->dataPtr->lat.size();
+    this->dataPtr->lat.push_back(lat);
+    this->dataPtr->lon.push_back(lon);
+    this->dataPtr->used.push_back(true);
+  }
+  ++this->dataPtr->size;
+
+  std::size_t tile = 0;
+  while (this->dataPtr->tiles[tile].children != kNone)
+  {
+    tile = this->dataPtr->tiles[tile].children +
+        Quadrant(this->dataPtr->tiles[tile], lat, lon);
+  }
+  this->dataPtr->tiles[tile].entries.push_back(
+      Entry{lat, lon, std::cos(lat), id});
+  // All the points may fall in the same quadrant, so split until the leaf
+  // holding the new point is small enough.
+  while (this->dataPtr->tiles[tile].entries.size() > kTileCapacity &&
+         this->dataPtr->tiles[tile].level < kMaxLevel)
+  {
+    this->dataPtr->Split(tile);
+    tile = this->dataPtr->tiles[tile].children +
+        Quadrant(this->dataPtr->tiles[tile], lat, lon);
+  }
+  return id;
+}
+
+//////////////////////////////////////////////////
+bool SphericalPointIndex::Remove(const std::size_t _id)
+{
+  if (_id >= this->dataPtr->used.size() || !this->dataPtr->used[_id])
+    return false;
+
+  const double lat = this->dataPtr->lat[_id];
+  const double lon = this->dataPtr->lon[_id];
+  std::vector<std::size_t> path{0};
+  while (this->dataPtr->tiles[path.back()].children != kNone)
+  {
+    const Tile &tile = this->dataPtr->tiles[path.back()];
+    path.push_back(tile.children + Quadrant(tile, lat, lon));
+  }
+
+  std::vector<Entry> &entries = this->dataPtr->tiles[path.back()].entries;
+  auto entry = std::find_if(entries.begin(), entries.end(),
+      [&](const Entry &_entry) { return _entry.id == _id; });
+  *entry = entries.back();
+  entries.pop_back();
+
+  this->dataPtr->used[_id] = false;
+  this->dataPtr->freeIds.push_back(_id);
+  --this->dataPtr->size;
+
+  // Merge the children of the tiles above into them while they are leaves
+  // with few enough points, so removals do not leave empty tiles behind.
+  path.pop_back();
+  while (!path.empty())
+  {
+    Tile &parent = this->dataPtr->tiles[path.back()];
+    std::size_t count = 0;
+    for (unsigned int q = 0; q < 4; ++q)
+    {
+      const Tile &child = this->dataPtr->tiles[parent.children + q];
+      if (child.children != kNone)
+        return true;
+      count += child.entries.size();
+    }
+    if (count > kTileCapacity / 2)
+      return true;
+
+    for (unsigned int q = 0; q < 4; ++q)
+    {
+      Tile &child = this->dataPtr->tiles[parent.children + q];
+      parent.entries.insert(parent.entries.end(), child.entries.begin(),
+          child.entries.end());
+      child.entries.clear();
+      child.entries.shrink_to_fit();
+    }
+    this->dataPtr->freeTiles.push_back(parent.children);
+    parent.children = kNone;
+    path.pop_back();
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void SphericalPointIndex::Clear()
+{
+  this->dataPtr->Reset();
+}
+
+//////////////////////////////////////////////////
+std::size_t SphericalPointIndex::Size() const
+{
+  return this->dataPtr->size;
+}
+
+//////////////////////////////////////////////////
+bool SphericalPointIndex::Point(const std::size_t _id, Angle &_lat,
+                                Angle &_lon) const
+{
+  if (_id >= this->dataPtr->used.size() || !this->dataPtr->used[_id])
+    return false;
+  _lat.SetRadian(this->dataPtr->lat[_id]);
+  _lon.SetRadian(this->dataPtr->lon[_id]);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void SphericalPointIndex::WithinDistance(const Angle &_lat, const Angle &_lon,
+    const double _distance, std::vector<std::size_t> &_ids) const
+{
+  _ids.clear();
+  if (_distance < 0 || this->dataPtr->size == 0)
+    return;
+
+  // Compare haversines instead of distances. Half the central angle is at
+  // most pi / 2, beyond which every point is within the distance.
+  const double halfAngle = _distance / (2 * this->dataPtr->radius);
+  const double sinHalf = std::sin(std::min(halfAngle, GZ_PI_2));
+  const double maxHaversine = halfAngle >= GZ_PI_2 ? 1.0 : sinHalf * sinHalf;
+
+  const Query q = Implementation::MakeQuery(_lat, _lon);
+  std::vector<std::size_t> stack{0};
+  while (!stack.empty())
+  {
+    const Tile &tile = this->dataPtr->tiles[stack.back()];
+    stack.pop_back();
+    if (TileHaversine(q, tile) > maxHaversine)
+      continue;
+
+    if (tile.children != kNone)
+    {
+      for (unsigned int i = 0; i < 4; ++i)
+        stack.push_back(tile.children + i);
+      continue;
+    }
+    for (const Entry &entry : tile.entries)
+    {
+      if (Haversine(q.lat, q.cosLat, entry.lat, entry.cosLat,
+            entry.lon - q.lon) <= maxHaversine)
+      {
+        _ids.push_back(entry.id);
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void SphericalPointIndex::Nearest(const Angle &_lat, const Angle &_lon,
+    const std::size_t _k, std::vector<std::size_t> &_ids,
+    std::vector<double> &_distances) const
+{
+  _ids.clear();
+  _distances.clear();
+  if (_k == 0 || this->dataPtr->size == 0)
+    return;
+
+  const Query q = Implementation::MakeQuery(_lat, _lon);
+
+  // Visit the tiles from the closest, until the closest remaining tile is
+  // farther than the farthest of the k closest points found so far.
+  using Candidate = std::pair<double, std::size_t>;
+  std::priority_queue<Candidate, std::vector<Candidate>,
+      std::greater<Candidate>> tiles;
+  std::priority_queue<Candidate> best;
+  tiles.push({0.0, 0});
+  while (!tiles.empty())
+  {
+    const auto [bound, index] = tiles.top();
+    if (best.size() == _k && bound > best.top().first)
+      break;
+    tiles.pop();
+
+    const Tile &tile = this->dataPtr->tiles[index];
+    if (tile.children != kNone)
+    {
+      for (unsigned int i = 0; i < 4; ++i)
+      {
+        const std::size_t child = tile.children + i;
+        tiles.push({TileHaversine(q, this->dataPtr->tiles[child]), child});
+      }
+      continue;
+    }
+    for (const Entry &entry : tile.entries)
+    {
+      const Candidate candidate{Haversine(q.lat, q.cosLat, entry.lat,
+          entry.cosLat, entry.lon - q.lon), entry.id};
+      if (best.size() < _k)
+      {
+        best.push(candidate);
+      }
+      else if (candidate < best.top())
+      {
+        best.pop();
+        best.push(candidate);
+      }
+    }
+  }
+
+  _ids.resize(best.size());
+  _distances.resize(best.size());
+  for (std::size_t i = best.size(); i-- > 0;)
+  {
+    _ids[i] = best.top().second;
+    _distances[i] = HaversineToDistance(best.top().first,
+        this->dataPtr->radius);
+    best.pop();
+  }
+}
+
+//////////////////////////////////////////////////
+std::uint64_t SphericalPointIndex::TileKey(const Angle &_lat,
+    const Angle &_lon, const unsigned int _level)
+{
+  const double lat = _lat.Radian();
+  const double lon = WrapLongitude(_lon.Radian());
+  Tile tile{-GZ_PI_2, GZ_PI_2, -GZ_PI, GZ_PI, 0, kNone, {}};
+  std::uint64_t key = 0;
+  for (unsigned int level = 0; level < std::min(_level, 32u); ++level)
+  {
+    const unsigned int q = Quadrant(tile, lat, lon);
+    const double latMid = (tile.latMin + tile.latMax) / 2;
+    const double lonMid = (tile.lonMin + tile.lonMax) / 2;
+    (q & 2u ? tile.latMin : tile.latMax) = latMid;
+    (q & 1u ? tile.lonMin : tile.lonMax) = lonMid;
+    key = (key << 2) | q;
+  }
+  return key;
+}
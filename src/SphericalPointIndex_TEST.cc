@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "gz/math/Helpers.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/SphericalPointIndex.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+/// \brief Points spread over the whole surface, with clusters, points on
+/// the poles and the antimeridian, and duplicates.
+void TestPoints(std::vector<double> &_lat, std::vector<double> &_lon)
+{
+  Rand::Seed(42);
+  for (int i = 0; i < 2000; ++i)
+  {
+    _lat.push_back(std::asin(Rand::DblUniform(-1, 1)));
+    _lon.push_back(Rand::DblUniform(-GZ_PI, GZ_PI));
+  }
+  for (int i = 0; i < 2000; ++i)
+  {
+    _lat.push_back(GZ_DTOR(47.4) + Rand::DblNormal(0, 1e-4));
+    _lon.push_back(GZ_DTOR(8.5) + Rand::DblNormal(0, 1e-4));
+  }
+  for (int i = 0; i < 50; ++i)
+  {
+    _lat.push_back(GZ_PI_2);
+    _lon.push_back(0.1 * i);
+    _lat.push_back(-0.01 * i);
+    _lon.push_back(i % 2 ? GZ_PI : -GZ_PI);
+    _lat.push_back(0.3);
+    _lon.push_back(0.3);
+  }
+}
+
+/// \brief Distances from a position to every point, sorted.
+std::vector<std::pair<double, std::size_t>> BruteForce(
+    const std::vector<double> &_lat, const std::vector<double> &_lon,
+    const std::vector<bool> &_used, const Angle &_queryLat,
+    const Angle &_queryLon)
+{
+  SphericalCoordinates sc;
+  std::vector<std::pair<double, std::size_t>> result;
+  for (std::size_t i = 0; i < _lat.size(); ++i)
+  {
+    if (!_used[i])
+      continue;
+    result.push_back({sc.DistanceBetweenPoints(_queryLat, _queryLon,
+        Angle(_lat[i]), Angle(_lon[i])), i});
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+/// \brief Check the queries of an index against a brute force search.
+void CheckQueries(const SphericalPointIndex &_index,
+                  const std::vector<double> &_lat,
+                  const std::vector<double> &_lon,
+                  const std::vector<bool> &_used)
+{
+  const std::vector<std::pair<double, double>> queries{
+      {GZ_DTOR(47.4), GZ_DTOR(8.5)}, {GZ_PI_2, 0}, {-GZ_PI_2, 1},
+      {0, GZ_PI}, {0.2, -3.1}, {-0.7, 3 * GZ_PI}, {0.3, 0.3}};
+  for (const auto &[qLat, qLon] : queries)
+  {
+    const auto expected = BruteForce(_lat, _lon, _used, Angle(qLat),
+        Angle(qLon));
+
+    for (const double distance : {0.0, 50.0, 2e4, 1e6, 1e7, 3e7})
+    {
+      std::vector<std::size_t> ids;
+      _index.WithinDistance(Angle(qLat), Angle(qLon), distance, ids);
+      std::sort(ids.begin(), ids.end());
+      std::vector<std::size_t> expectedIds;
+      for (const auto &[d, id] : expected)
+      {
+        if (d <= distance)
+          expectedIds.push_back(id);
+      }
+      std::sort(expectedIds.begin(), expectedIds.end());
+      EXPECT_EQ(expectedIds, ids) << qLat << " " << qLon << " " << distance;
+    }
+
+    for (const std::size_t k : {1u, 7u, 100u})
+    {
+      std::vector<std::size_t> ids;
+      std::vector<double> distances;
+      _index.Nearest(Angle(qLat), Angle(qLon), k, ids, distances);
+      ASSERT_EQ(std::min(k, expected.size()), ids.size());
+      ASSERT_EQ(ids.size(), distances.size());
+      for (std::size_t i = 0; i < ids.size(); ++i)
+      {
+        // Points at the same distance may be swapped by rounding.
+        EXPECT_NEAR(expected[i].first, distances[i], 1e-6)
+            << qLat << " " << qLon << " " << k << " " << i;
+        if (i > 0)
+        {
+          EXPECT_LE(distances[i - 1], distances[i]);
+        }
+      }
+    }
+  }
+}
+}
+
+/////////////////////////////////////////////////
+TEST(SphericalPointIndexTest, Empty)
+{
+  SphericalPointIndex index;
+  EXPECT_EQ(0u, index.Size());
+  EXPECT_DOUBLE_EQ(SphericalCoordinates().SurfaceRadius(),
+      index.SurfaceRadius());
+
+  std::vector<std::size_t> ids{1, 2};
+  std::vector<double> distances{1.0};
+  index.WithinDistance(Angle(0), Angle(0), 1e9, ids);
+  EXPECT_TRUE(ids.empty());
+  index.Nearest(Angle(0), Angle(0), 3, ids, distances);
+  EXPECT_TRUE(ids.empty());
+  EXPECT_TRUE(distances.empty());
+
+  Angle lat, lon;
+  EXPECT_FALSE(index.Point(0, lat, lon));
+  EXPECT_FALSE(index.Remove(0));
+
+  SphericalPointIndex moon(
+      SphericalCoordinates(SphericalCoordinates::MOON_SCS));
+  EXPECT_DOUBLE_EQ(
+      SphericalCoordinates(SphericalCoordinates::MOON_SCS).SurfaceRadius(),
+      moon.SurfaceRadius());
+}
+
+/////////////////////////////////////////////////
+TEST(SphericalPointIndexTest, Build)
+{
+  std::vector<double> lat, lon;
+  TestPoints(lat, lon);
+  SphericalPointIndex index;
+  index.Build(lat.data(), lon.data(), lat.size());
+  EXPECT_EQ(lat.size(), index.Size());
+
+  Angle pointLat, pointLon;
+  EXPECT_TRUE(index.Point(5, pointLat, pointLon));
+  EXPECT_DOUBLE_EQ(lat[5], pointLat.Radian());
+  EXPECT_DOUBLE_EQ(lon[5], pointLon.Radian());
+  EXPECT_FALSE(index.Point(lat.size(), pointLat, pointLon));
+
+  CheckQueries(index, lat, lon, std::vector<bool>(lat.size(), true));
+
+  index.Clear();
+  EXPECT_EQ(0u, index.Size());
+  EXPECT_FALSE(index.Point(5, pointLat, pointLon));
+}
+
+/////////////////////////////////////////////////
+TEST(SphericalPointIndexTest, InsertRemove)
+{
+  std::vector<double> lat, lon;
+  TestPoints(lat, lon);
+  SphericalPointIndex index;
+  for (std::size_t i = 0; i < lat.size(); ++i)
+    EXPECT_EQ(i, index.Insert(Angle(lat[i]), Angle(lon[i])));
+  EXPECT_EQ(lat.size(), index.Size());
+  std::vector<bool> used(lat.size(), true);
+  CheckQueries(index, lat, lon, used);
+
+  // Remove most points, which merges tiles, then reuse their indices.
+  for (std::size_t i = 0; i < lat.size(); ++i)
+  {
+    if (i % 5 != 0)
+    {
+      EXPECT_TRUE(index.Remove(i));
+      used[i] = false;
+    }
+  }
+  EXPECT_FALSE(index.Remove(1));
+  EXPECT_EQ(lat.size() - lat.size() * 4 / 5, index.Size());
+  Angle pointLat, pointLon;
+  EXPECT_FALSE(index.Point(1, pointLat, pointLon));
+  CheckQueries(index, lat, lon, used);
+
+  const std::size_t id = index.Insert(Angle(0.5), Angle(4.0));
+  EXPECT_FALSE(used[id]);
+  lat[id] = 0.5;
+  lon[id] = 4.0 - 2 * GZ_PI;
+  used[id] = true;
+  EXPECT_TRUE(index.Point(id, pointLat, pointLon));
+  EXPECT_DOUBLE_EQ(4.0 - 2 * GZ_PI, pointLon.Radian());
+  CheckQueries(index, lat, lon, used);
+}
+
+/////////////////////////////////////////////////
+TEST(SphericalPointIndexTest, TileKey)
+{
+  EXPECT_EQ(0u, SphericalPointIndex::TileKey(Angle(0.3), Angle(0.2), 0));
+
+  // North-east, south-west, north-west and south-east quadrants.
+  EXPECT_EQ(3u, SphericalPointIndex::TileKey(Angle(0.3), Angle(0.2), 1));
+  EXPECT_EQ(0u, SphericalPointIndex::TileKey(Angle(-0.3), Angle(-0.2), 1));
+  EXPECT_EQ(2u, SphericalPointIndex::TileKey(Angle(0.3), Angle(-0.2), 1));
+  EXPECT_EQ(1u, SphericalPointIndex::TileKey(Angle(-0.3), Angle(0.2), 1));
+
+  // Longitudes are wrapped.
+  EXPECT_EQ(SphericalPointIndex::TileKey(Angle(0.3), Angle(-0.2), 20),
+      SphericalPointIndex::TileKey(Angle(0.3), Angle(2 * GZ_PI - 0.2), 20));
+
+  // The key of the parent is the key without its last level.
+  for (unsigned int level = 1; level <= 32; ++level)
+  {
+    EXPECT_EQ(SphericalPointIndex::TileKey(Angle(0.81), Angle(0.15),
+                                            level - 1),
+        SphericalPointIndex::TileKey(Angle(0.81), Angle(0.15), level) >> 2);
+  }
+  EXPECT_EQ(0xFFFFFFFFFFFFFFFFu,
+      SphericalPointIndex::TileKey(Angle(GZ_PI_2), Angle(GZ_PI), 32));
+
+  // Nearby positions share the leading bits.
+  const std::uint64_t a =
+      SphericalPointIndex::TileKey(Angle(0.81), Angle(0.15), 20);
+  const std::uint64_t b =
+      SphericalPointIndex::TileKey(Angle(0.81 + 1e-6), Angle(0.15), 20);
+  EXPECT_EQ(a >> 10, b >> 10);
+}
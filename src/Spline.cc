@@ -38,6 +38,8 @@ void Spline::Tension(double _t)
   this->dataPtr->tension = _t;
   if (this->dataPtr->autoCalc)
     this->RecalcTangents();
+  else
+    this->dataPtr->tangentsStale = true;
 }
 
 ///////////////////////////////////////////////////////////
@@ -85,15 +87,53 @@ void Spline::AddPoint(const Vector3d &_p, const Vector3d &_t)
       ControlPoint({_p, _t}), true);
 }
 
+///////////////////////////////////////////////////////////
+void Spline::AddPoints(const std::vector<Vector3d> &_points)
+{
+  this->AddPoints(_points.data(), _points.size());
+}
+
+///////////////////////////////////////////////////////////
+void Spline::AddPoints(const Vector3d *_points, const size_t _count)
+{
+  if (_count == 0)
+    return;
+
+  // Grow geometrically, so that adding many small batches stays linear
+  const size_t first = this->dataPtr->points.size();
+  const size_t total = first + _count;
+  const size_t capacity = this->dataPtr->points.capacity();
+  if (total > capacity)
+    this->Reserve(std::max(total, 2 * capacity));
+
+  const bool wasClosed = this->dataPtr->IsClosed();
+  for (size_t i = 0; i < _count; ++i)
+  {
+    this->dataPtr->points.push_back(
+        ControlPoint({_points[i], Vector3d(INF_D, INF_D, INF_D)}));
+    this->dataPtr->fixings.push_back(false);
+  }
+  // Only the segments next to the new points change
+  this->UpdateAround(first, total - 1, wasClosed);
+}
+
+///////////////////////////////////////////////////////////
+void Spline::Reserve(const size_t _count)
+{
+  this->dataPtr->points.reserve(_count);
+  this->dataPtr->fixings.reserve(_count);
+  this->dataPtr->segments.reserve(_count);
+  this->dataPtr->cumulativeArcLengths.reserve(_count);
+}
+
 ///////////////////////////////////////////////////////////
 void Spline::AddPoint(const ControlPoint &_cp, const bool _fixed)
 {
+  const bool wasClosed = this->dataPtr->IsClosed();
   this->dataPtr->points.push_back(_cp);
   this->dataPtr->fixings.push_back(_fixed);
-  if (this->dataPtr->autoCalc)
-    this->RecalcTangents();
-  else
-    this->Rebuild();
+  const size_t last = this->dataPtr->points.size() - 1;
+  this->UpdateAround(last, last, wasClosed);
 }
 
 ///////////////////////////////////////////////////////////
@@ -152,82 +192,251 @@ Vector3d Spline::InterpolateTangent(const unsigned int _fromIndex,
 }
 
 ///////////////////////////////////////////////////////////
-void Spline::RecalcTangents()
+void Spline::Interpolate(const double *_t, Vector3d *_out,
+                         const size_t _count) const
 {
-  // Catmull-Rom approach
-  //
-  // tangent[i] = 0.5 * (point[i+1] - point[i-1])
-  //
-  // Assume endpoint tangents are parallel with line with neighbour
+  this->InterpolateMthDerivative(0, _t, _out, _count);
+}
 
-  size_t i, numPoints;
-  bool isClosed;
+///////////////////////////////////////////////////////////
+void Spline::InterpolateTangent(const double *_t, Vector3d *_out,
+                                const size_t _count) const
+{
+  this->InterpolateMthDerivative(1, _t, _out, _count);
+}
 
-  numPoints = this->dataPtr->points.size();
-  if (numPoints < 2)
+///////////////////////////////////////////////////////////
+void Spline::InterpolateMthDerivative(const unsigned int _mth,
+                                      const double *_t,
+                                      Vector3d *_out,
+                                      const size_t _count) const
+{
+  const auto &segments = this->dataPtr->segments;
+  if (segments.empty())
   {
-    // Can't do anything yet
+    // Same as InterpolateMthDerivative(0, _mth, 0.0)
+    const Vector3d value = this->InterpolateMthDerivative(0u, _mth, 0.0);
+    std::fill(_out, _out + _count, value);
     return;
   }
 
-  // Closed or open?
-  if (this->dataPtr->points[0].MthDerivative(0) ==
-      this->dataPtr->points[numPoints-1].MthDerivative(0))
-    isClosed = true;
-  else
-    isClosed = false;
-
-  double t = 1.0 - this->dataPtr->tension;
+  this->dataPtr->ForEachSegmentRun(_t, _count,
+      [&](const size_t _index, const double *_fractions,
+          const size_t _start, const size_t _n)
+      {
+        segments[_index].InterpolateMthDerivative(_mth, _fractions,
+            _out + _start, _n);
+      });
+}
 
-  for (i = 0; i < numPoints; ++i)
+///////////////////////////////////////////////////////////
+void Spline::InterpolateFrames(const double *_t, SplineFrame *_out,
+                               const size_t _count) const
+{
+  const auto &segments = this->dataPtr->segments;
+  if (segments.empty())
   {
-    if (!this->dataPtr->fixings[i])
+    // A single control point, or none, as InterpolateMthDerivative
+    const Vector3d inf(INF_D, INF_D, INF_D);
+    SplineFrame frame{inf, inf, inf, INF_D, inf, inf, inf};
+    if (!this->dataPtr->points.empty())
     {
-      if (i == 0)
-      {
-        // Special case start
-        if (isClosed)
-        {
-          // Use this->dataPtr->points-2 since this->dataPtr->points-1
-          // is the last point and == [0]
-          this->dataPtr->points[i].MthDerivative(1) =
-              ((this->dataPtr->points[1].MthDerivative(0) -
-                this->dataPtr->points[numPoints-2].MthDerivative(0)) * 0.5) * t;
-        }
-        else
-        {
-          this->dataPtr->points[i].MthDerivative(1) =
-              ((this->dataPtr->points[1].MthDerivative(0) -
-                this->dataPtr->points[0].MthDerivative(0)) * 0.5) * t;
-        }
-      }
-      else if (i == numPoints-1)
+      const ControlPoint &point = this->dataPtr->points.front();
+      frame.position = point.MthDerivative(0);
+      frame.firstDerivative = point.MthDerivative(1);
+      frame.secondDerivative = point.MthDerivative(2);
+      SetFrameGeometry(frame);
+    }
+    std::fill(_out, _out + _count, frame);
+    return;
+  }
+
+  this->dataPtr->ForEachSegmentRun(_t, _count,
+      [&](const size_t _index, const double *_fractions,
+          const size_t _start, const size_t _n)
       {
-        // Special case end
-        if (isClosed)
-        {
-          // Use same tangent as already calculated for [0]
-          this->dataPtr->points[i].MthDerivative(1) =
-              this->dataPtr->points[0].MthDerivative(1);
-        }
-        else
-        {
-          this->dataPtr->points[i].MthDerivative(1) =
-              ((this->dataPtr->points[i].MthDerivative(0) -
-                this->dataPtr->points[i-1].MthDerivative(0)) * 0.5) * t;
-        }
-      }
-      else
+        segments[_index].InterpolateFrames(_fractions, _out + _start, _n);
+      });
+}
+
+///////////////////////////////////////////////////////////
+Vector3d Spline::InterpolateAtDistance(const double _distance) const
+{
+  return this->InterpolateMthDerivativeAtDistance(0, _distance);
+}
+
+///////////////////////////////////////////////////////////
+Vector3d Spline::InterpolateTangentAtDistance(const double _distance) const
+{
+  return this->InterpolateMthDerivativeAtDistance(1, _distance);
+}
+
+///////////////////////////////////////////////////////////
+Vector3d Spline::InterpolateMthDerivativeAtDistance(
+    const unsigned int _mth, const double _distance) const
+{
+  const auto &segments = this->dataPtr->segments;
+  if (segments.empty())
+    return this->InterpolateMthDerivative(0u, _mth, 0.0);
+  if (!(_distance >= 0.0 && _distance <= this->dataPtr->arcLength))
+    return Vector3d(INF_D, INF_D, INF_D);
+
+  // The segment is the last one starting at or before the distance.
+  const auto &cumulative = this->dataPtr->cumulativeArcLengths;
+  const size_t index = static_cast<size_t>(std::upper_bound(
+      cumulative.begin() + 1, cumulative.end(), _distance) -
+      cumulative.begin()) - 1;
+  const double t = segments[index].ParameterAtArcLength(
+      _distance - cumulative[index]);
+  return segments[index].InterpolateMthDerivative(_mth, t);
+}
+
+///////////////////////////////////////////////////////////
+void Spline::ArcLengthTableSamples(const unsigned int _samples)
+{
+  this->dataPtr->arcLengthTableSamples = _samples;
+  for (auto &segment : this->dataPtr->segments)
+    segment.BuildArcLengthTable(_samples);
+}
+
+///////////////////////////////////////////////////////////
+unsigned int Spline::ArcLengthTableSamples() const
+{
+  return this->dataPtr->arcLengthTableSamples;
+}
+
+///////////////////////////////////////////////////////////
+double Spline::ClosestParameter(const Vector3d &_point,
+                                const double _hint) const
+{
+  const auto &segments = this->dataPtr->segments;
+  if (segments.empty())
+    return this->dataPtr->points.empty() ? INF_D : 0.0;
+  this->dataPtr->RefreshBounds();
+
+  // Start from the segment of the hint, so that most of the tree is
+  // skipped when the hint is close.
+  size_t bestIndex = 0;
+  double bestFraction = 0.0;
+  double bestDistance = INF_D;
+  size_t hintIndex = segments.size();
+  unsigned int index;
+  double fraction;
+  if (_hint >= 0.0 && _hint <= 1.0 &&
+      this->MapToSegment(_hint, index, fraction))
+  {
+    hintIndex = index;
+    bestIndex = index;
+    bestFraction = segments[index].ClosestParameter(
+        _point, fraction, bestDistance);
+  }
+
+  // Depth first search of the bounds tree, nearest child first, skipping
+  // the nodes whose bounds are not closer than the closest point so far.
+  const size_t leaves = this->dataPtr->boundsLeaves;
+  size_t stack[2 * sizeof(size_t) * 8];
+  size_t stackSize = 0;
+  stack[stackSize++] = 1;
+  while (stackSize > 0)
+  {
+    const size_t node = stack[--stackSize];
+    if (this->dataPtr->BoundsDistanceSquared(node, _point) >= bestDistance)
+      continue;
+
+    if (node >= leaves)
+    {
+      const size_t segment = node - leaves;
+      if (segment == hintIndex)
+        continue;
+      double distance;
+      const double t = segments[segment].ClosestParameter(
+          _point, -1.0, distance);
+      if (distance < bestDistance)
       {
-        this->dataPtr->points[i].MthDerivative(1) =
-            ((this->dataPtr->points[i+1].MthDerivative(0) -
-              this->dataPtr->points[i-1].MthDerivative(0)) * 0.5) * t;
+        bestIndex = segment;
+        bestFraction = t;
+        bestDistance = distance;
       }
+      continue;
+    }
+
+    const size_t left = 2 * node;
+    const size_t right = left + 1;
+    if (this->dataPtr->BoundsDistanceSquared(left, _point) <
+        this->dataPtr->BoundsDistanceSquared(right, _point))
+    {
+      stack[stackSize++] = right;
+      stack[stackSize++] = left;
     }
+    else
+    {
+      stack[stackSize++] = left;
+      stack[stackSize++] = right;
+    }
+  }
+
+  // Map back to the parameter over the whole spline, as MapToSegment
+  // does.
+  if (!(this->dataPtr->arcLength > 0.0))
+    return 0.0;
+  return std::clamp((this->dataPtr->cumulativeArcLengths[bestIndex] +
+                     bestFraction * segments[bestIndex].ArcLength()) /
+                    this->dataPtr->arcLength, 0.0, 1.0);
+}
+
+///////////////////////////////////////////////////////////
+bool Spline::Tessellate(const double _maxChordError,
+                        std::vector<Vector3d> &_points) const
+{
+  _points.clear();
+  if (!(_maxChordError > 0.0))
+    return false;
+  if (this->dataPtr->points.empty())
+    return true;
+
+  _points.push_back(this->dataPtr->points.front().MthDerivative(0));
+  for (const auto &segment : this->dataPtr->segments)
+    segment.Tessellate(_maxChordError, _points);
+  return true;
+}
+
+///////////////////////////////////////////////////////////
+void Spline::RecalcTangents()
+{
+  this->dataPtr->tangentsStale = false;
+
+  size_t numPoints = this->dataPtr->points.size();
+  if (numPoints < 2)
+  {
+    // Can't do anything yet
+    return;
   }
+
+  const bool isClosed = this->dataPtr->IsClosed();
+  for (size_t i = 0; i < numPoints; ++i)
+    this->dataPtr->RecalcTangent(i, isClosed);
   this->Rebuild();
 }
 
+///////////////////////////////////////////////////////////
+void Spline::UpdateAround(const size_t _first, const size_t _last,
+                          const bool _wasClosed)
+{
+  if (!this->dataPtr->autoCalc)
+  {
+    this->dataPtr->tangentsStale = true;
+    this->dataPtr->UpdateAround(_first, _last, _wasClosed, false);
+  }
+  else if (this->dataPtr->tangentsStale)
+  {
+    this->RecalcTangents();
+  }
+  else
+  {
+    this->dataPtr->UpdateAround(_first, _last, _wasClosed, true);
+  }
+}
+
 ///////////////////////////////////////////////////////////
 bool Spline::MapToSegment(const double _t,
                           unsigned int &_index,
@@ -283,21 +492,9 @@ void Spline::Rebuild()
   this->dataPtr->cumulativeArcLengths.resize(numSegments);
   for (size_t i = 0 ; i < numSegments ; ++i)
   {
-    this->dataPtr->segments[i].SetPoints(this->dataPtr->points[i],
-                                         this->dataPtr->points[i+1]);
-
-    if (i > 0) {
-      this->dataPtr->cumulativeArcLengths[i] =
-          (this->dataPtr->segments[i-1].ArcLength()
-           + this->dataPtr->cumulativeArcLengths[i-1]);
-    }
-    else
-    {
-      this->dataPtr->cumulativeArcLengths[i] = 0.0;
-    }
+    this->dataPtr->SetSegment(i);
   }
-  this->dataPtr->arcLength = (this->dataPtr->cumulativeArcLengths.back()
-                              + this->dataPtr->segments.back().ArcLength());
+  this->dataPtr->UpdateArcLengths(0);
 }
 
 ///////////////////////////////////////////////////////////
@@ -333,6 +530,7 @@ void Spline::Clear()
   this->dataPtr->points.clear();
   this->dataPtr->segments.clear();
   this->dataPtr->fixings.clear();
+  this->dataPtr->tangentsStale = false;
 }
 
 ///////////////////////////////////////////////////////////
@@ -358,13 +556,10 @@ bool Spline::UpdatePoint(const unsigned int _index,
   if (_index >= this->dataPtr->points.size())
     return false;
 
+  const bool wasClosed = this->dataPtr->IsClosed();
   this->dataPtr->points[_index].Match(_point);
   this->dataPtr->fixings[_index] = _fixed;
-
-  if (this->dataPtr->autoCalc)
-    this->RecalcTangents();
-  else
-    this->Rebuild();
+  this->UpdateAround(_index, _index, wasClosed);
   return true;
 }
 
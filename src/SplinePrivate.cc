@@ -15,6 +15,9 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
+
 #include "gz/math/Matrix4.hh"
 
 #include "SplinePrivate.hh"
@@ -25,6 +28,21 @@ namespace math
 {
 inline namespace GZ_MATH_VERSION_NAMESPACE
 {
+/// \brief Weights of the 5 point Gauss-Legendre quadrature rule on [0, 1].
+static constexpr double kGaussWeights[5] = {
+    0.28444444444444444, 0.23931433524968326, 0.23931433524968326,
+    0.11846344252809456, 0.11846344252809456};
+
+/// \brief Nodes of the 5 point Gauss-Legendre quadrature rule on [0, 1],
+/// in the same order as kGaussWeights.
+static constexpr double kGaussNodes[5] = {
+    0.5, 0.23076534494715845, 0.7692346550528415,
+    0.0469100770306680, 0.9530899229693319};
+
+/// \brief Least number of cells over which the path length of a segment is
+/// integrated to map arc lengths to parameter values.
+static constexpr unsigned int kMinArcLengthCells = 16;
+
 ///////////////////////////////////////////////////////////
 Vector4d PolynomialPowers(const unsigned int _order,
                           const double _t)
@@ -89,6 +107,8 @@ void IntervalCubicSpline::SetPoints(const ControlPoint &_startPoint,
   this->endPoint.MthDerivative(2) = this->DoInterpolateMthDerivative(2, 1.0);
   this->endPoint.MthDerivative(3) = this->DoInterpolateMthDerivative(3, 1.0);
   this->arcLength = this->ArcLength(1.0);
+  this->tableParameters.clear();
+  this->tableSlopes.clear();
 }
 
 ///////////////////////////////////////////////////////////
@@ -117,6 +137,296 @@ double IntervalCubicSpline::ArcLength(const double _t) const
   return arc_length;
 }
 
+///////////////////////////////////////////////////////////
+void IntervalCubicSpline::Bounds(Vector3d &_min, Vector3d &_max) const
+{
+  // Bezier control points of the Hermite curve
+  const Vector3d &point0 = this->startPoint.MthDerivative(0);
+  const Vector3d &point1 = this->endPoint.MthDerivative(0);
+  const Vector3d control0 = point0 + this->startPoint.MthDerivative(1) / 3.0;
+  const Vector3d control1 = point1 - this->endPoint.MthDerivative(1) / 3.0;
+  _min = point0;
+  _min.Min(point1);
+  _min.Min(control0);
+  _min.Min(control1);
+  _max = point0;
+  _max.Max(point1);
+  _max.Max(control0);
+  _max.Max(control1);
+}
+
+///////////////////////////////////////////////////////////
+double IntervalCubicSpline::ClosestParameter(const Vector3d &_point,
+                                             const double _hint,
+                                             double &_distanceSquared) const
+{
+  // The squared distance may have two local minima on a cubic, so start
+  // from the closest sample.
+  constexpr int kSamples = 8;
+  double start = 0.0;
+  _distanceSquared = INF_D;
+  for (int i = 0; i <= kSamples; ++i)
+  {
+    const double t = static_cast<double>(i) / kSamples;
+    const double distance =
+        (this->DoInterpolateMthDerivative(0, t) - _point).SquaredLength();
+    if (distance < _distanceSquared)
+    {
+      start = t;
+      _distanceSquared = distance;
+    }
+  }
+  if (_hint >= 0.0 && _hint <= 1.0)
+  {
+    const double distance =
+        (this->DoInterpolateMthDerivative(0, _hint) - _point).SquaredLength();
+    if (distance < _distanceSquared)
+    {
+      start = _hint;
+      _distanceSquared = distance;
+    }
+  }
+
+  // Newton's method on (P(t) - point).P'(t), whose derivative is
+  // |P'(t)|^2 + (P(t) - point).P''(t), clamped to the curve.
+  double t = start;
+  for (int i = 0; i < 16; ++i)
+  {
+    const Vector3d offset = this->DoInterpolateMthDerivative(0, t) - _point;
+    const Vector3d first = this->DoInterpolateMthDerivative(1, t);
+    const double slope = offset.Dot(first);
+    const double curvature = first.SquaredLength() +
+        offset.Dot(this->DoInterpolateMthDerivative(2, t));
+    if (!(curvature > 0.0))
+      break;
+    const double next = std::clamp(t - slope / curvature, 0.0, 1.0);
+    const bool converged = std::abs(next - t) <= 1e-12;
+    t = next;
+    if (converged)
+      break;
+  }
+
+  const double distance =
+      (this->DoInterpolateMthDerivative(0, t) - _point).SquaredLength();
+  if (!(distance <= _distanceSquared))
+    return start;
+  _distanceSquared = distance;
+  return t;
+}
+
+///////////////////////////////////////////////////////////
+void IntervalCubicSpline::Tessellate(const double _maxChordError,
+                                     std::vector<Vector3d> &_points) const
+{
+  // Ends of the intervals left to subdivide, with the position and the
+  // derivative there, and the subdivision depth of the interval that ends
+  // there. The top of the stack ends the interval that starts at start.
+  struct Vertex
+  {
+    double t;
+    Vector3d position;
+    Vector3d derivative;
+    int depth;
+  };
+  constexpr int kMaxDepth = 16;
+  Vertex stack[kMaxDepth + 1];
+  int stackSize = 0;
+  Vertex start{0.0, this->startPoint.MthDerivative(0),
+               this->startPoint.MthDerivative(1), 0};
+  stack[stackSize++] = {1.0, this->endPoint.MthDerivative(0),
+                        this->endPoint.MthDerivative(1), 0};
+  const double maxErrorSquared = _maxChordError * _maxChordError;
+  while (stackSize > 0)
+  {
+    Vertex &end = stack[stackSize - 1];
+    const double third = (end.t - start.t) / 3.0;
+    const Vector3d chord = end.position - start.position;
+    const double chordLengthSquared = chord.SquaredLength();
+    double errorSquared = 0.0;
+    for (const Vector3d &control : {start.position + start.derivative * third,
+                                    end.position - end.derivative * third})
+    {
+      // Squared distance from the control point to the chord
+      const Vector3d offset = control - start.position;
+      const double s = chordLengthSquared > 0.0 ? std::clamp(
+          offset.Dot(chord) / chordLengthSquared, 0.0, 1.0) : 0.0;
+      errorSquared = std::max(errorSquared,
+                              (offset - chord * s).SquaredLength());
+    }
+
+    if (errorSquared <= maxErrorSquared || end.depth == kMaxDepth)
+    {
+      _points.push_back(end.position);
+      start = end;
+      --stackSize;
+      continue;
+    }
+
+    const double t = (start.t + end.t) / 2;
+    ++end.depth;
+    stack[stackSize++] = {t, this->DoInterpolateMthDerivative(0, t),
+                          this->DoInterpolateMthDerivative(1, t), end.depth};
+  }
+}
+
+///////////////////////////////////////////////////////////
+double IntervalCubicSpline::PathLength(const double _t0,
+                                       const double _t1) const
+{
+  // 5 Point Gauss-Legendre quadrature rule on [_t0, _t1]
+  const double width = _t1 - _t0;
+  double length = 0.0;
+  for (int i = 0; i < 5; ++i)
+  {
+    length += kGaussWeights[i] * this->DoInterpolateMthDerivative(
+        1, _t0 + kGaussNodes[i] * width).Length();
+  }
+  return length * width;
+}
+
+///////////////////////////////////////////////////////////
+void IntervalCubicSpline::CellPathLengths(
+    const unsigned int _cells, std::vector<double> &_lengths) const
+{
+  _lengths.resize(_cells + 1);
+  _lengths[0] = 0.0;
+  for (unsigned int i = 0; i < _cells; ++i)
+  {
+    _lengths[i + 1] = _lengths[i] + this->PathLength(
+        static_cast<double>(i) / _cells, static_cast<double>(i + 1) / _cells);
+  }
+}
+
+///////////////////////////////////////////////////////////
+void IntervalCubicSpline::BuildArcLengthTable(const unsigned int _samples)
+{
+  this->tableParameters.clear();
+  this->tableSlopes.clear();
+  if (_samples == 0 || !(this->arcLength > 0.0))
+    return;
+
+  // The 5 point rule of ArcLength(double) is not accurate enough to be
+  // inverted near a cusp, where it may even decrease, so the table follows
+  // the length of the path integrated over small cells, scaled to the arc
+  // length of the segment.
+  std::vector<double> lengths;
+  this->CellPathLengths(std::max(2 * _samples, kMinArcLengthCells), lengths);
+  const double scale = this->arcLength / lengths.back();
+
+  // Parameter values at evenly spaced arc lengths, and their derivatives
+  // with respect to arc length.
+  const double step = this->arcLength / _samples;
+  this->tableParameters.resize(_samples + 1);
+  this->tableSlopes.resize(_samples + 1);
+  for (unsigned int i = 0; i <= _samples; ++i)
+  {
+    const double t = i == 0 ? 0.0 : i == _samples ? 1.0 :
+        this->SolveParameterAtPathLength(lengths, i * step / scale);
+    const double speed = this->DoInterpolateMthDerivative(1, t).Length();
+    this->tableParameters[i] = t;
+    this->tableSlopes[i] = speed > 0.0 ? 1.0 / (speed * scale) : INF_D;
+  }
+
+  // Limit the slopes so that the cubic Hermite interpolation of each
+  // interval is monotone (Fritsch and Carlson, 1980).
+  for (unsigned int i = 0; i < _samples; ++i)
+  {
+    const double secant =
+        (this->tableParameters[i + 1] - this->tableParameters[i]) / step;
+    double &m0 = this->tableSlopes[i];
+    double &m1 = this->tableSlopes[i + 1];
+    if (!(secant > 0.0))
+    {
+      m0 = 0.0;
+      m1 = 0.0;
+      continue;
+    }
+    m0 = std::min(m0, 3.0 * secant);
+    m1 = std::min(m1, 3.0 * secant);
+    const double alpha = m0 / secant;
+    const double beta = m1 / secant;
+    const double norm = alpha * alpha + beta * beta;
+    if (norm > 9.0)
+    {
+      const double tau = 3.0 / std::sqrt(norm);
+      m0 = tau * alpha * secant;
+      m1 = tau * beta * secant;
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////
+double IntervalCubicSpline::ParameterAtArcLength(const double _s) const
+{
+  if (!(_s > 0.0) || !(this->arcLength > 0.0))
+    return 0.0;
+  if (_s >= this->arcLength)
+    return 1.0;
+
+  if (this->tableParameters.empty())
+  {
+    std::vector<double> lengths;
+    this->CellPathLengths(kMinArcLengthCells, lengths);
+    return this->SolveParameterAtPathLength(
+        lengths, _s * lengths.back() / this->arcLength);
+  }
+
+  // Cubic Hermite interpolation in the interval of the table
+  const size_t intervals = this->tableParameters.size() - 1;
+  const double step = this->arcLength / intervals;
+  const double x = _s / step;
+  const size_t i = std::min(static_cast<size_t>(x), intervals - 1);
+  const double u = x - i;
+  const double u2 = u * u;
+  const double u3 = u2 * u;
+  const double t = (2 * u3 - 3 * u2 + 1) * this->tableParameters[i] +
+      (u3 - 2 * u2 + u) * step * this->tableSlopes[i] +
+      (-2 * u3 + 3 * u2) * this->tableParameters[i + 1] +
+      (u3 - u2) * step * this->tableSlopes[i + 1];
+  return std::clamp(t, 0.0, 1.0);
+}
+
+///////////////////////////////////////////////////////////
+double IntervalCubicSpline::SolveParameterAtPathLength(
+    const std::vector<double> &_lengths, const double _length) const
+{
+  // Find the cell, then use Newton's method on its path length, whose
+  // derivative is the speed, falling back to bisection when a step leaves
+  // the cell.
+  const size_t cells = _lengths.size() - 1;
+  const size_t cell = std::min(static_cast<size_t>(std::upper_bound(
+      _lengths.begin() + 1, _lengths.end(), _length) - _lengths.begin()) - 1,
+      cells - 1);
+  double lower = static_cast<double>(cell) / cells;
+  double upper = static_cast<double>(cell + 1) / cells;
+  const double start = lower;
+  const double target = _length - _lengths[cell];
+  const double cellLength = _lengths[cell + 1] - _lengths[cell];
+  double t = cellLength > 0.0 ?
+      std::clamp(lower + (upper - lower) * target / cellLength, lower, upper) :
+      lower;
+  for (int i = 0; i < 64; ++i)
+  {
+    const double error = this->PathLength(start, t) - target;
+    if (std::abs(error) <= 1e-12 * _lengths.back())
+      break;
+    if (error > 0.0)
+      upper = t;
+    else
+      lower = t;
+
+    const double speed = this->DoInterpolateMthDerivative(1, t).Length();
+    double next = speed > 0.0 ? t - error / speed : lower;
+    if (!(next > lower && next < upper))
+      next = (lower + upper) / 2;
+    // t is one of the bounds, so there is nothing left between them
+    if (!(next > lower && next < upper))
+      break;
+    t = next;
+  }
+  return t;
+}
+
 ///////////////////////////////////////////////////////////
 Vector3d IntervalCubicSpline::DoInterpolateMthDerivative(
     const unsigned int _mth, const double _t) const
@@ -141,6 +451,131 @@ Vector3d IntervalCubicSpline::InterpolateMthDerivative(
 
   return this->DoInterpolateMthDerivative(_mth, _t);
 }
+
+///////////////////////////////////////////////////////////
+void IntervalCubicSpline::InterpolateMthDerivative(
+    const unsigned int _mth, const double *_t, Vector3d *_out,
+    const size_t _count) const
+{
+  if (_mth > 1)
+  {
+    for (size_t i = 0; i < _count; ++i)
+      _out[i] = this->InterpolateMthDerivative(_mth, _t[i]);
+    return;
+  }
+
+  // Same powers and sums as PolynomialPowers and
+  // DoInterpolateMthDerivative, in the same order so that the results are
+  // the same, but with the coefficients read once.
+  double c[4][3];
+  for (int row = 0; row < 4; ++row)
+  {
+    for (int col = 0; col < 3; ++col)
+      c[row][col] = this->coeffs(row, col);
+  }
+  for (size_t i = 0; i < _count; ++i)
+  {
+    const double t = _t[i];
+    const double t2 = t * t;
+    const double p0 = _mth == 0 ? t2 * t : 3 * t2;
+    const double p1 = _mth == 0 ? t2 : 2 * t;
+    const double p2 = _mth == 0 ? t : 1.0;
+    const double p3 = _mth == 0 ? 1.0 : 0.0;
+    _out[i].Set(p0 * c[0][0] + p1 * c[1][0] + p2 * c[2][0] + p3 * c[3][0],
+                p0 * c[0][1] + p1 * c[1][1] + p2 * c[2][1] + p3 * c[3][1],
+                p0 * c[0][2] + p1 * c[1][2] + p2 * c[2][2] + p3 * c[3][2]);
+  }
+
+  // Bounds and ends, as in InterpolateMthDerivative(unsigned int, double)
+  for (size_t i = 0; i < _count; ++i)
+  {
+    if (_t[i] < 0.0 || _t[i] > 1.0)
+      _out[i].Set(INF_D, INF_D, INF_D);
+    else if (equal(_t[i], 0.0))
+      _out[i] = this->startPoint.MthDerivative(_mth);
+    else if (equal(_t[i], 1.0))
+      _out[i] = this->endPoint.MthDerivative(_mth);
+  }
+}
+
+///////////////////////////////////////////////////////////
+void SetFrameGeometry(SplineFrame &_frame)
+{
+  const Vector3d &d1 = _frame.firstDerivative;
+  const Vector3d &d2 = _frame.secondDerivative;
+  const double speed = d1.Length();
+  const Vector3d cross = d1.Cross(d2);
+  const double crossLength = cross.Length();
+
+  _frame.tangent = speed > 0.0 ? d1 / speed : Vector3d::Zero;
+  if (speed > 0.0 && crossLength > 1e-12 * speed * d2.Length())
+  {
+    _frame.curvature = crossLength / (speed * speed * speed);
+    _frame.binormal = cross / crossLength;
+    _frame.normal = _frame.binormal.Cross(_frame.tangent);
+  }
+  else
+  {
+    _frame.curvature = 0.0;
+    _frame.normal = Vector3d::Zero;
+    _frame.binormal = Vector3d::Zero;
+  }
+}
+
+///////////////////////////////////////////////////////////
+void IntervalCubicSpline::InterpolateFrames(const double *_t,
+    SplineFrame *_out, const size_t _count) const
+{
+  // The powers of PolynomialPowers for the first three orders, with the
+  // coefficients read once
+  double c[4][3];
+  for (int row = 0; row < 4; ++row)
+  {
+    for (int col = 0; col < 3; ++col)
+      c[row][col] = this->coeffs(row, col);
+  }
+  for (size_t i = 0; i < _count; ++i)
+  {
+    const double t = _t[i];
+    const double t2 = t * t;
+    const double t3 = t2 * t;
+    double p[3];
+    double d1[3];
+    double d2[3];
+    for (int col = 0; col < 3; ++col)
+    {
+      p[col] = t3 * c[0][col] + t2 * c[1][col] + t * c[2][col] + c[3][col];
+      d1[col] = 3 * t2 * c[0][col] + 2 * t * c[1][col] + c[2][col];
+      d2[col] = 6 * t * c[0][col] + 2.0 * c[1][col];
+    }
+    _out[i].position.Set(p[0], p[1], p[2]);
+    _out[i].firstDerivative.Set(d1[0], d1[1], d1[2]);
+    _out[i].secondDerivative.Set(d2[0], d2[1], d2[2]);
+  }
+
+  // Bounds and ends, as in InterpolateMthDerivative(unsigned int, double)
+  for (size_t i = 0; i < _count; ++i)
+  {
+    SplineFrame &frame = _out[i];
+    if (_t[i] < 0.0 || _t[i] > 1.0)
+    {
+      const Vector3d inf(INF_D, INF_D, INF_D);
+      frame = SplineFrame{inf, inf, inf, INF_D, inf, inf, inf};
+      continue;
+    }
+    if (equal(_t[i], 0.0))
+    {
+      frame.position = this->startPoint.MthDerivative(0);
+      frame.firstDerivative = this->startPoint.MthDerivative(1);
+    }
+    else if (equal(_t[i], 1.0))
+    {
+      frame.position = this->endPoint.MthDerivative(0);
+      frame.firstDerivative = this->endPoint.MthDerivative(1);
+    }
+    SetFrameGeometry(frame);
+  }
+}
 }
 }
 }
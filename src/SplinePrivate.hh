@@ -25,6 +25,8 @@
 #include <gz/math/Vector4.hh>
 #include <gz/math/config.hh>
 
+#include "LazyUpdate.hh"
+
 namespace gz
 {
   namespace math
@@ -107,6 +109,13 @@ namespace gz
       private: std::vector<Vector3d> derivatives;
     };
 
+    /// \brief Sets the curvature and Frenet frame of a spline frame from
+    /// its first two derivatives. Where the derivatives are parallel, up
+    /// to rounding, the curvature, normal and binormal are zero, and where
+    /// the first derivative is zero the tangent is too.
+    /// \param[in,out] _frame the frame.
+    void SetFrameGeometry(SplineFrame &_frame);
+
     /// \brief Cubic interpolator for splines defined
     /// between each pair of control points.
     class IntervalCubicSpline
@@ -140,6 +149,27 @@ namespace gz
       public: Vector3d InterpolateMthDerivative(
           const unsigned int _mth, const double _t) const;
 
+      /// \brief Interpolates the curve mth derivative at many
+      /// parameter values, as InterpolateMthDerivative(unsigned int, double).
+      /// \param[in] _mth order of curve derivative to interpolate.
+      /// \param[in] _t pointer to the first parameter value (range 0 to 1).
+      /// \param[out] _out pointer to the first interpolated mth derivative,
+      /// or [INF, INF, INF] on error.
+      /// \param[in] _count number of parameter values.
+      public: void InterpolateMthDerivative(
+          const unsigned int _mth, const double *_t, Vector3d *_out,
+          const size_t _count) const;
+
+      /// \brief Interpolates the position, first two derivatives,
+      /// curvature and Frenet frame of the curve at many parameter values,
+      /// as Spline::InterpolateFrames.
+      /// \param[in] _t pointer to the first parameter value (range 0 to 1).
+      /// \param[out] _out pointer to the first frame, or INF in all its
+      /// fields on error.
+      /// \param[in] _count number of parameter values.
+      public: void InterpolateFrames(const double *_t, SplineFrame *_out,
+                                     const size_t _count) const;
+
       /// \brief Gets curve arc length
       /// \return the arc length
       public: inline double ArcLength() const { return this->arcLength; }
@@ -149,6 +179,76 @@ namespace gz
       /// \return the arc length up to \p _t or INF on error.
       public: double ArcLength(const double _t) const;
 
+      /// \brief Builds a table of the parameter values at evenly spaced
+      /// arc lengths, used by ParameterAtArcLength.
+      /// \param[in] _samples number of intervals of the table, or 0 to
+      /// remove the table.
+      public: void BuildArcLengthTable(const unsigned int _samples);
+
+      /// \brief Gets the parameter value at which the arc length from the
+      /// start of the curve is \p _s. The arc length is integrated over
+      /// small cells of the parameter range, then scaled to ArcLength().
+      /// This interpolates the table built by BuildArcLengthTable if there
+      /// is one, and solves for it otherwise.
+      /// \param[in] _s arc length, clamped to the curve arc length.
+      /// \return the parameter value (range 0 to 1).
+      public: double ParameterAtArcLength(const double _s) const;
+
+      /// \brief Gets bounds of the curve, the bounds of the control points
+      /// of its Bezier form, which contain the curve.
+      /// \param[out] _min minimum corner of the bounds.
+      /// \param[out] _max maximum corner of the bounds.
+      public: void Bounds(Vector3d &_min, Vector3d &_max) const;
+
+      /// \brief Finds the parameter value of the point of the curve
+      /// closest to a point. This starts from the closest of evenly spaced
+      /// samples, or from \p _hint if it is closer, and refines it with
+      /// Newton's method on the derivative of the squared distance.
+      /// \param[in] _point point to project on the curve.
+      /// \param[in] _hint parameter value to start from, ignored if it is
+      /// not in the range 0 to 1.
+      /// \param[out] _distanceSquared squared distance from \p _point to
+      /// the curve at the returned parameter value.
+      /// \return the parameter value (range 0 to 1).
+      public: double ClosestParameter(const Vector3d &_point,
+                                      const double _hint,
+                                      double &_distanceSquared) const;
+
+      /// \brief Appends a polyline approximation of the curve, subdividing
+      /// each interval until the control points of its Bezier form, which
+      /// bound the curve, are within \p _maxChordError of its chord.
+      /// \param[in] _maxChordError maximum distance from the curve to the
+      /// polyline, positive.
+      /// \param[out] _points the vertices of the polyline are appended,
+      /// without the start point of the curve.
+      public: void Tessellate(const double _maxChordError,
+                              std::vector<Vector3d> &_points) const;
+
+      /// \internal
+      /// \brief Gets the length of the path between two parameter values
+      /// with a 5 point quadrature rule, without bound checks.
+      /// \param[in] _t0 start parameter value.
+      /// \param[in] _t1 end parameter value.
+      /// \return the length of the path from \p _t0 to \p _t1.
+      private: double PathLength(const double _t0, const double _t1) const;
+
+      /// \internal
+      /// \brief Gets the path lengths from the start of the curve to the
+      /// ends of evenly spaced cells of the parameter range.
+      /// \param[in] _cells number of cells.
+      /// \param[out] _lengths the _cells + 1 path lengths, from 0.
+      private: void CellPathLengths(const unsigned int _cells,
+                                    std::vector<double> &_lengths) const;
+
+      /// \internal
+      /// \brief Solves for the parameter value at a path length.
+      /// \param[in] _lengths path lengths from CellPathLengths.
+      /// \param[in] _length path length, between 0 and _lengths.back().
+      /// \return the parameter value.
+      private: double SolveParameterAtPathLength(
+                   const std::vector<double> &_lengths,
+                   const double _length) const;
+
       /// \internal
       /// \brief Interpolates the curve mth derivative at parameter
       /// value \p _t.
@@ -170,6 +270,15 @@ namespace gz
 
       /// \brief curve arc length.
       private: double arcLength {0.0};
+
+      /// \brief parameter values at evenly spaced arc lengths, from 0 to
+      /// arcLength, or empty without a table.
+      private: std::vector<double> tableParameters;
+
+      /// \brief derivatives of the parameter values in tableParameters
+      /// with respect to arc length, limited so that the interpolation
+      /// is monotone.
+      private: std::vector<double> tableSlopes;
     };
 
     /// \brief Private data for Spline class.
@@ -196,6 +305,301 @@ namespace gz
 
       // \brief spline arc length.
       public: double arcLength {INF_D};
+
+      /// \brief number of intervals of the arc length tables of the
+      /// segments, 0 for no tables.
+      public: unsigned int arcLengthTableSamples {0};
+
+      /// \brief Bounds of the segments and of ranges of them, as a
+      /// complete binary tree: node 1 is the root, the children of node i
+      /// are nodes 2i and 2i + 1, and the leaves, from node boundsLeaves,
+      /// are the segments in order, then empty bounds.
+      public: mutable std::vector<Vector3d> boundsMin;
+
+      /// \brief Maximum corners of the bounds in boundsMin.
+      public: mutable std::vector<Vector3d> boundsMax;
+
+      /// \brief Index of the first leaf of the bounds tree.
+      public: mutable size_t boundsLeaves {0};
+
+      /// \brief Whether the segments changed since the bounds tree was
+      /// built, so that concurrent const queries build it once.
+      public: mutable LazyUpdate boundsUpdate;
+
+      /// \brief Builds the bounds tree of the segments if they changed.
+      /// This may be called from several threads at once.
+      public: void RefreshBounds() const
+      {
+        this->boundsUpdate.Refresh([this]()
+        {
+          this->UpdateBounds();
+        });
+      }
+
+      /// \brief Builds the bounds tree of the segments.
+      private: void UpdateBounds() const
+      {
+        this->boundsLeaves = 1;
+        while (this->boundsLeaves < this->segments.size())
+          this->boundsLeaves *= 2;
+        this->boundsMin.assign(2 * this->boundsLeaves,
+                               Vector3d(INF_D, INF_D, INF_D));
+        this->boundsMax.assign(2 * this->boundsLeaves,
+                               Vector3d(-INF_D, -INF_D, -INF_D));
+        for (size_t i = 0; i < this->segments.size(); ++i)
+        {
+          this->segments[i].Bounds(this->boundsMin[this->boundsLeaves + i],
+                                   this->boundsMax[this->boundsLeaves + i]);
+        }
+        for (size_t i = this->boundsLeaves - 1; i > 0; --i)
+        {
+          this->boundsMin[i] = this->boundsMin[2 * i];
+          this->boundsMin[i].Min(this->boundsMin[2 * i + 1]);
+          this->boundsMax[i] = this->boundsMax[2 * i];
+          this->boundsMax[i].Max(this->boundsMax[2 * i + 1]);
+        }
+      }
+
+      /// \brief Gets the squared distance from a point to the bounds of a
+      /// node of the bounds tree.
+      /// \param[in] _node node index.
+      /// \param[in] _point point.
+      /// \return the squared distance, 0 inside the bounds.
+      public: double BoundsDistanceSquared(const size_t _node,
+                                           const Vector3d &_point) const
+      {
+        const Vector3d &min = this->boundsMin[_node];
+        const Vector3d &max = this->boundsMax[_node];
+        double distance = 0.0;
+        for (int i = 0; i < 3; ++i)
+        {
+          const double offset = std::max(
+              {min[i] - _point[i], 0.0, _point[i] - max[i]});
+          distance += offset * offset;
+        }
+        return distance;
+      }
+
+      /// \brief Maps parameter values to segments and fractions as
+      /// MapToSegment does, and calls a function for each run of
+      /// consecutive values on the same segment. The segment index is one
+      /// less than the number of cumulative arc lengths below the arc
+      /// length of the value, which only grows while the values increase,
+      /// so sorted values walk along the segments.
+      /// \param[in] _t pointer to the first parameter value.
+      /// \param[in] _count number of parameter values, there must be at
+      /// least one segment.
+      /// \param[in] _f function called with the segment index, the
+      /// fractions of a run, the index of its first value and its size.
+      public: template<typename F>
+      void ForEachSegmentRun(const double *_t, const size_t _count,
+                             F _f) const
+      {
+        constexpr size_t kRun = 64;
+        double fractions[kRun];
+        size_t runStart = 0;
+        size_t runIndex = 0;
+        size_t below = 0;
+        double previousArc = -INF_D;
+        for (size_t i = 0; i < _count; ++i)
+        {
+          size_t index;
+          double fraction;
+          if (equal(_t[i], 0.0))
+          {
+            index = 0;
+            fraction = 0.0;
+          }
+          else if (equal(_t[i], 1.0))
+          {
+            index = this->segments.size() - 1;
+            fraction = 1.0;
+          }
+          else
+          {
+            const auto &cumulative = this->cumulativeArcLengths;
+            const double tArc = _t[i] * this->arcLength;
+            if (tArc < previousArc)
+            {
+              below = static_cast<size_t>(std::lower_bound(
+                  cumulative.begin(), cumulative.end(), tArc) -
+                  cumulative.begin());
+            }
+            while (below < cumulative.size() && cumulative[below] < tArc)
+              ++below;
+            previousArc = tArc;
+
+            index = below > 0 ? below - 1 : 0;
+            fraction = (tArc - cumulative[index]) /
+                this->segments[index].ArcLength();
+          }
+
+          if (i > runStart && (index != runIndex || i - runStart == kRun))
+          {
+            _f(runIndex, fractions, runStart, i - runStart);
+            runStart = i;
+          }
+          runIndex = index;
+          fractions[i - runStart] = fraction;
+        }
+        if (_count > runStart)
+          _f(runIndex, fractions, runStart, _count - runStart);
+      }
+
+      /// \brief Sets the control points of a segment from the spline
+      /// control points, and builds its arc length table.
+      /// \param[in] _index segment index.
+      public: void SetSegment(const size_t _index)
+      {
+        this->segments[_index].SetPoints(this->points[_index],
+                                         this->points[_index + 1]);
+        this->boundsUpdate.dirty = true;
+        if (this->arcLengthTableSamples > 0)
+        {
+          this->segments[_index].BuildArcLengthTable(
+              this->arcLengthTableSamples);
+        }
+      }
+
+      /// \brief Whether the tangents may not match the control points,
+      /// because they changed while autoCalc was false.
+      public: bool tangentsStale {false};
+
+      /// \brief Checks whether the spline is closed.
+      /// \return True if the first and last control points are equal.
+      public: bool IsClosed() const
+      {
+        return this->points.size() > 1 &&
+            this->points.front().MthDerivative(0) ==
+            this->points.back().MthDerivative(0);
+      }
+
+      /// \brief Recalculates the tangent of a control point that is not
+      /// fixed, with the Catmull-Rom approach:
+      ///
+      /// tangent[i] = 0.5 * (point[i+1] - point[i-1])
+      ///
+      /// Endpoint tangents are parallel with the line with their neighbour,
+      /// and the last tangent of a closed spline is the first one.
+      /// \param[in] _index control point index, less than the number of
+      /// control points, which is at least 2.
+      /// \param[in] _closed whether the spline is closed.
+      public: void RecalcTangent(const size_t _index, const bool _closed)
+      {
+        if (this->fixings[_index])
+          return;
+
+        const size_t numPoints = this->points.size();
+        const double t = 1.0 - this->tension;
+        if (_index == 0)
+        {
+          // Special case start. When closed, use the point before the
+          // last one, since the last point is the first one.
+          const size_t previous = _closed ? numPoints - 2 : 0;
+          this->points[_index].MthDerivative(1) =
+              ((this->points[1].MthDerivative(0) -
+                this->points[previous].MthDerivative(0)) * 0.5) * t;
+        }
+        else if (_index == numPoints - 1)
+        {
+          // Special case end
+          if (_closed)
+          {
+            this->points[_index].MthDerivative(1) =
+                this->points[0].MthDerivative(1);
+          }
+          else
+          {
+            this->points[_index].MthDerivative(1) =
+                ((this->points[_index].MthDerivative(0) -
+                  this->points[_index - 1].MthDerivative(0)) * 0.5) * t;
+          }
+        }
+        else
+        {
+          this->points[_index].MthDerivative(1) =
+              ((this->points[_index + 1].MthDerivative(0) -
+                this->points[_index - 1].MthDerivative(0)) * 0.5) * t;
+        }
+      }
+
+      /// \brief Recomputes the cumulative arc lengths and the spline arc
+      /// length, from a segment on.
+      /// \param[in] _first index of the first segment whose arc length
+      /// changed.
+      public: void UpdateArcLengths(const size_t _first)
+      {
+        for (size_t i = _first; i < this->segments.size(); ++i)
+        {
+          if (i > 0)
+          {
+            this->cumulativeArcLengths[i] =
+                (this->segments[i-1].ArcLength()
+                 + this->cumulativeArcLengths[i-1]);
+          }
+          else
+          {
+            this->cumulativeArcLengths[i] = 0.0;
+          }
+        }
+        this->arcLength = (this->cumulativeArcLengths.back()
+                           + this->segments.back().ArcLength());
+      }
+
+      /// \brief Updates the tangents and segments that depend on a range of
+      /// control points that were just changed or added, instead of all of
+      /// them.
+      /// \param[in] _first index of the first changed control point.
+      /// \param[in] _last index of the last changed control point.
+      /// \param[in] _wasClosed whether the spline was closed before the
+      /// change.
+      /// \param[in] _recalcTangents whether to recalculate the tangents.
+      public: void UpdateAround(const size_t _first, const size_t _last,
+                                const bool _wasClosed,
+                                const bool _recalcTangents)
+      {
+        const size_t numPoints = this->points.size();
+        if (numPoints < 2)
+          return;
+
+        // The tangents of the points and their neighbours depend on them.
+        // The tangents of the endpoints also depend on whether the spline is
+        // closed. Each changed point changes the segments on both sides.
+        std::vector<size_t> changed;
+        const bool closed = this->IsClosed();
+        if (closed || _wasClosed)
+          changed.push_back(0);
+        for (size_t i = _first > 0 ? _first - 1 : 0;
+             i <= _last + 1 && i < numPoints; ++i)
+        {
+          changed.push_back(i);
+        }
+        if (closed || _wasClosed)
+          changed.push_back(numPoints - 1);
+        changed.erase(std::unique(changed.begin(), changed.end()),
+                      changed.end());
+
+        if (_recalcTangents)
+        {
+          for (const size_t i : changed)
+            this->RecalcTangent(i, closed);
+        }
+
+        this->segments.resize(numPoints - 1);
+        this->cumulativeArcLengths.resize(numPoints - 1);
+        size_t lastSegment = numPoints;
+        for (const size_t i : changed)
+        {
+          for (size_t s = i > 0 ? i - 1 : 0; s <= i && s < numPoints - 1; ++s)
+          {
+            if (s == lastSegment)
+              continue;
+            this->SetSegment(s);
+            lastSegment = s;
+          }
+        }
+        this->UpdateArcLengths(changed.front() > 0 ? changed.front() - 1 : 0);
+      }
     };
     }
   }
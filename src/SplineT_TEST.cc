@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "gz/math/Spline.hh"
+#include "gz/math/SplineT.hh"
+#include "gz/math/Vector3.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+/// \brief Check that a SplineT is the same curve as a Spline.
+template<typename T>
+void ExpectSameCurve(const Spline &_expected, const SplineT<T> &_spline,
+                     const double _tol)
+{
+  ASSERT_EQ(_expected.PointCount(), _spline.PointCount());
+  for (unsigned int i = 0; i < _expected.PointCount(); ++i)
+  {
+    const Vector3d tangent(_spline.Tangent(i).X(), _spline.Tangent(i).Y(),
+                           _spline.Tangent(i).Z());
+    EXPECT_LT((_expected.Tangent(i) - tangent).Length(), _tol) << i;
+  }
+  EXPECT_NEAR(_expected.ArcLength(), _spline.ArcLength(),
+              _tol * _expected.ArcLength());
+
+  for (int i = 0; i <= 100; ++i)
+  {
+    const double t = i / 100.0;
+    const Vector3<T> p = _spline.Interpolate(static_cast<T>(t));
+    EXPECT_LT((_expected.Interpolate(t) - Vector3d(p.X(), p.Y(), p.Z()))
+        .Length(), _tol * _expected.ArcLength()) << t;
+    const Vector3<T> d = _spline.InterpolateTangent(static_cast<T>(t));
+    const Vector3d tangent = _expected.InterpolateTangent(t);
+    EXPECT_LT((tangent - Vector3d(d.X(), d.Y(), d.Z())).Length(),
+              _tol * (1 + tangent.Length())) << t;
+  }
+}
+}
+
+/////////////////////////////////////////////////
+TEST(SplineTTest, Empty)
+{
+  Splinef s;
+  EXPECT_EQ(0u, s.PointCount());
+  EXPECT_EQ(0u, s.SegmentCount());
+  EXPECT_EQ(nullptr, s.CumulativeArcLengths());
+  EXPECT_TRUE(std::isinf(s.ArcLength()));
+  EXPECT_TRUE(std::isinf(s.Interpolate(0.5f).X()));
+  EXPECT_TRUE(std::isinf(s.Point(0).X()));
+  EXPECT_FALSE(s.UpdatePoint(0, Vector3f::Zero));
+
+  s.AddPoint(Vector3f(1, 2, 3));
+  EXPECT_EQ(0u, s.SegmentCount());
+  EXPECT_EQ(Vector3f(1, 2, 3), s.Interpolate(0.0f));
+  EXPECT_EQ(Vector3f(1, 2, 3), s.Interpolate(0u, 0.0f));
+}
+
+/////////////////////////////////////////////////
+TEST(SplineTTest, SameAsSpline)
+{
+  const Vector3d points[] = {
+      Vector3d(0, 0, 0), Vector3d(1, 2, 0), Vector3d(3, 2, 1),
+      Vector3d(4, -1, 2), Vector3d(6, 0, 0), Vector3d(7, 3, -1)};
+
+  Spline expected;
+  Splined splined;
+  Splinef splinef;
+  expected.Tension(0.3);
+  splined.Tension(0.3);
+  splinef.Tension(0.3f);
+  for (const Vector3d &p : points)
+  {
+    expected.AddPoint(p);
+    splined.AddPoint(p);
+    splinef.AddPoint(Vector3f(p.X(), p.Y(), p.Z()));
+  }
+  EXPECT_EQ(5u, splined.SegmentCount());
+  ExpectSameCurve(expected, splined, 1e-9);
+  ExpectSameCurve(expected, splinef, 1e-5);
+
+  // Moving a point only updates the segments around it.
+  expected.UpdatePoint(2, Vector3d(2, 5, 1));
+  splined.UpdatePoint(2, Vector3d(2, 5, 1));
+  ExpectSameCurve(expected, splined, 1e-9);
+
+  // Fixed tangents.
+  expected.UpdatePoint(4, Vector3d(6, 1, 0), Vector3d(0, 3, 0));
+  splined.UpdatePoint(4, Vector3d(6, 1, 0), Vector3d(0, 3, 0));
+  expected.AddPoint(Vector3d(8, 1, 1), Vector3d(1, 0, 0));
+  splined.AddPoint(Vector3d(8, 1, 1), Vector3d(1, 0, 0));
+  ExpectSameCurve(expected, splined, 1e-9);
+
+  expected.Tension(0.0);
+  splined.Tension(0.0);
+  ExpectSameCurve(expected, splined, 1e-9);
+
+  // Out of range.
+  EXPECT_TRUE(std::isinf(splined.Interpolate(-0.5).X()));
+  EXPECT_TRUE(std::isinf(splined.Interpolate(1.5).X()));
+  EXPECT_TRUE(std::isinf(splined.Interpolate(1u, 1.5).X()));
+  EXPECT_TRUE(std::isinf(splined.Interpolate(9u, 0.5).X()));
+
+  splined.Clear();
+  EXPECT_EQ(0u, splined.PointCount());
+  EXPECT_EQ(0u, splined.SegmentCount());
+}
+
+/////////////////////////////////////////////////
+TEST(SplineTTest, Closed)
+{
+  Spline expected;
+  Splined spline;
+  for (const Vector3d &p : {Vector3d(0, 0, 0), Vector3d(2, 0, 0),
+                            Vector3d(2, 2, 1), Vector3d(0, 2, 0)})
+  {
+    expected.AddPoint(p);
+    spline.AddPoint(p);
+  }
+
+  // Closing the spline changes the tangents at both ends.
+  expected.AddPoint(Vector3d(0, 0, 0));
+  spline.AddPoint(Vector3d(0, 0, 0));
+  ExpectSameCurve(expected, spline, 1e-9);
+  EXPECT_EQ(spline.Tangent(0), spline.Tangent(4));
+
+  // And opening it again too.
+  expected.UpdatePoint(4, Vector3d(0, 1, 0));
+  spline.UpdatePoint(4, Vector3d(0, 1, 0));
+  ExpectSameCurve(expected, spline, 1e-9);
+}
+
+/////////////////////////////////////////////////
+TEST(SplineTTest, Coefficients)
+{
+  Splinef spline;
+  spline.AddPoint(Vector3f(0, 0, 0));
+  spline.AddPoint(Vector3f(1, 2, 0));
+  spline.AddPoint(Vector3f(3, 2, 1));
+  spline.AddPoint(Vector3f(4, -1, 2));
+
+  const float *coeffs = spline.Coefficients();
+  const float *lengths = spline.CumulativeArcLengths();
+  ASSERT_NE(nullptr, lengths);
+  EXPECT_FLOAT_EQ(0.0f, lengths[0]);
+  EXPECT_FLOAT_EQ(spline.ArcLength(), lengths[spline.SegmentCount()]);
+
+  for (std::size_t i = 0; i < spline.SegmentCount(); ++i)
+  {
+    EXPECT_LT(lengths[i], lengths[i + 1]);
+    const float *c = coeffs + i * Splinef::kCoefficientsPerSegment;
+    for (const float u : {0.0f, 0.25f, 0.5f, 1.0f})
+    {
+      Vector3f p;
+      for (int k = 0; k < 3; ++k)
+        p[k] = ((c[k] * u + c[3 + k]) * u + c[6 + k]) * u + c[9 + k];
+      EXPECT_EQ(spline.Interpolate(static_cast<unsigned int>(i), u), p);
+    }
+
+    // Same mapping from a parameter over the whole spline to a segment.
+    const float mid = (lengths[i] + lengths[i + 1]) / 2;
+    const float u = (mid - lengths[i]) / (lengths[i + 1] - lengths[i]);
+    EXPECT_EQ(spline.Interpolate(static_cast<unsigned int>(i), u),
+              spline.Interpolate(mid / spline.ArcLength()));
+  }
+}
@@ -17,6 +17,10 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <vector>
+
+#include "gz/math/Rand.hh"
 #include "gz/math/Vector3.hh"
 #include "gz/math/Spline.hh"
 
@@ -177,3 +181,544 @@ TEST(SplineTest, RecalcTangents)
   EXPECT_EQ(s.Interpolate(0, 0.5), math::Vector3d(0.2, 0.2, 0.2));
   EXPECT_EQ(s.Interpolate(1, 0.5), math::Vector3d(0.2, 0.2, 0.2));
 }
+
+/////////////////////////////////////////////////
+TEST(SplineTest, IncrementalUpdates)
+{
+  // Points added and updated one by one, which only updates the affected
+  // segments, must give the same spline as a full recalculation.
+  math::Spline s;
+  std::vector<math::Vector3d> points;
+  std::vector<math::Vector3d> tangents;
+  auto check = [&]()
+  {
+    math::Spline full;
+    full.AutoCalculate(false);
+    full.Tension(s.Tension());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      if (tangents[i].IsFinite())
+        full.AddPoint(points[i], tangents[i]);
+      else
+        full.AddPoint(points[i]);
+    }
+    full.RecalcTangents();
+
+    ASSERT_EQ(full.PointCount(), s.PointCount());
+    // With a single point, there are no tangents yet.
+    if (points.size() > 1)
+    {
+      for (unsigned int i = 0; i < points.size(); ++i)
+      {
+        EXPECT_EQ(full.Point(i), s.Point(i)) << i;
+        EXPECT_EQ(full.Tangent(i), s.Tangent(i)) << i;
+      }
+      EXPECT_DOUBLE_EQ(full.ArcLength(), s.ArcLength());
+      for (double t = 0.0; t <= 1.0; t += 0.05)
+      {
+        EXPECT_EQ(full.Interpolate(t), s.Interpolate(t)) << t;
+        EXPECT_DOUBLE_EQ(full.ArcLength(t), s.ArcLength(t)) << t;
+      }
+    }
+  };
+  auto add = [&](const math::Vector3d &_p)
+  {
+    s.AddPoint(_p);
+    points.push_back(_p);
+    tangents.push_back(math::Vector3d(math::INF_D, math::INF_D, math::INF_D));
+    check();
+  };
+  auto update = [&](const unsigned int _i, const math::Vector3d &_p)
+  {
+    EXPECT_TRUE(s.UpdatePoint(_i, _p));
+    points[_i] = _p;
+    tangents[_i] = math::Vector3d(math::INF_D, math::INF_D, math::INF_D);
+    check();
+  };
+
+  add(math::Vector3d(0, 0, 0));
+  add(math::Vector3d(1, 0, 0));
+  add(math::Vector3d(2, 1, 0));
+  for (int i = 3; i < 12; ++i)
+    add(math::Vector3d(i, std::sin(i), 0.1 * i * i));
+  update(0, math::Vector3d(-1, 2, 0));
+  update(5, math::Vector3d(4, 2, 1));
+  update(11, math::Vector3d(12, 3, 4));
+
+  // A fixed tangent.
+  EXPECT_TRUE(s.UpdatePoint(6, math::Vector3d(5, 0, 0),
+      math::Vector3d(1, 1, 1)));
+  points[6] = math::Vector3d(5, 0, 0);
+  tangents[6] = math::Vector3d(1, 1, 1);
+  check();
+  update(6, math::Vector3d(5, 1, 0));
+
+  // Closing the spline changes the tangents of the endpoints, and so does
+  // opening it.
+  add(points[0]);
+  update(1, math::Vector3d(0, 1, 1));
+  update(11, math::Vector3d(11, 0, 0));
+  update(12, math::Vector3d(3, 3, 3));
+  update(12, points[0]);
+  update(0, math::Vector3d(-2, 0, 0));
+
+  // Changes made without automatic calculation are caught up with on the
+  // next change with it.
+  s.AutoCalculate(false);
+  s.UpdatePoint(3, math::Vector3d(0, 9, 0));
+  points[3] = math::Vector3d(0, 9, 0);
+  s.Tension(0.5);
+  s.AutoCalculate(true);
+  update(8, math::Vector3d(7, 7, 7));
+  EXPECT_DOUBLE_EQ(0.5, s.Tension());
+}
+
+/////////////////////////////////////////////////
+TEST(SplineTest, AddPoints)
+{
+  std::vector<math::Vector3d> points;
+  for (int i = 0; i < 20; ++i)
+    points.push_back(math::Vector3d(i, std::cos(i), 0.5 * i));
+
+  math::Spline one;
+  for (const auto &p : points)
+    one.AddPoint(p);
+  math::Spline bulk;
+  bulk.AddPoint(points[0]);
+  bulk.AddPoints({points.begin() + 1, points.end()});
+
+  ASSERT_EQ(points.size(), bulk.PointCount());
+  EXPECT_DOUBLE_EQ(one.ArcLength(), bulk.ArcLength());
+  for (unsigned int i = 0; i < points.size(); ++i)
+    EXPECT_EQ(one.Tangent(i), bulk.Tangent(i));
+  for (double t = 0.0; t <= 1.0; t += 0.1)
+    EXPECT_EQ(one.Interpolate(t), bulk.Interpolate(t));
+
+  bulk.AddPoints({});
+  EXPECT_EQ(points.size(), bulk.PointCount());
+}
+
+/////////////////////////////////////////////////
+TEST(SplineTest, AddPointsArray)
+{
+  std::vector<math::Vector3d> points;
+  for (int i = 0; i < 50; ++i)
+    points.push_back(math::Vector3d(std::sin(i), i, 0.1 * i * i));
+
+  math::Spline one;
+  one.AddPoints(points);
+
+  // Reserved, then in several batches
+  math::Spline bulk;
+  bulk.Reserve(points.size());
+  bulk.AddPoints(points.data(), 20);
+  bulk.AddPoints(points.data() + 20, 0);
+  bulk.AddPoints(points.data() + 20, points.size() - 20);
+
+  ASSERT_EQ(points.size(), bulk.PointCount());
+  EXPECT_DOUBLE_EQ(one.ArcLength(), bulk.ArcLength());
+  for (unsigned int i = 0; i < points.size(); ++i)
+    EXPECT_EQ(one.Tangent(i), bulk.Tangent(i));
+  for (double t = 0.0; t <= 1.0; t += 0.05)
+    EXPECT_EQ(one.Interpolate(t), bulk.Interpolate(t));
+
+  // Batches only update the segments next to them, which matches
+  // recalculating everything, also when the last batch closes the spline
+  points.push_back(points.front());
+  for (const bool autoCalc : {true, false})
+  {
+    math::Spline batches;
+    batches.AutoCalculate(autoCalc);
+    for (size_t i = 0; i < points.size(); i += 7)
+    {
+      batches.AddPoints(points.data() + i,
+                        std::min<size_t>(7, points.size() - i));
+    }
+    math::Spline full;
+    full.AutoCalculate(false);
+    full.AddPoints(points);
+    full.RecalcTangents();
+    if (!autoCalc)
+      batches.RecalcTangents();
+    ASSERT_EQ(points.size(), batches.PointCount());
+    EXPECT_DOUBLE_EQ(full.ArcLength(), batches.ArcLength());
+    for (unsigned int i = 0; i < points.size(); ++i)
+      EXPECT_EQ(full.Tangent(i), batches.Tangent(i)) << autoCalc << i;
+    for (double t = 0.0; t <= 1.0; t += 0.05)
+      EXPECT_EQ(full.Interpolate(t), batches.Interpolate(t)) << autoCalc;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SplineTest, BatchInterpolate)
+{
+  math::Spline s;
+  std::vector<double> t{0.0, 0.5, 1.0};
+  std::vector<math::Vector3d> out(t.size());
+
+  // Empty spline
+  s.Interpolate(t.data(), out.data(), t.size());
+  for (const auto &v : out)
+    EXPECT_FALSE(v.IsFinite());
+
+  // Single point
+  s.AddPoint(math::Vector3d(1, 2, 3));
+  s.Interpolate(t.data(), out.data(), t.size());
+  for (const auto &v : out)
+    EXPECT_EQ(math::Vector3d(1, 2, 3), v);
+
+  for (int i = 1; i < 50; ++i)
+    s.AddPoint(math::Vector3d(i, std::sin(i), 0.01 * i * i));
+
+  // Sorted values, with repeats, values near the ends and out of range,
+  // then values in any order.
+  t = {-0.1, -1e-7, 0.0, 1e-9, 0.001, 0.02, 0.02, 0.3, 0.3000001, 0.5,
+       0.77, 0.999999, 1.0, 1.0 + 1e-7, 1.2};
+  for (int i = 0; i <= 1000; ++i)
+    t.push_back(i / 1000.0);
+  for (int i = 0; i < 100; ++i)
+    t.push_back(std::fmod(i * 0.618034, 1.0));
+  t.push_back(std::nan(""));
+  t.push_back(0.4);
+
+  out.resize(t.size());
+  std::vector<math::Vector3d> tangents(t.size());
+  std::vector<math::Vector3d> second(t.size());
+  s.Interpolate(t.data(), out.data(), t.size());
+  s.InterpolateTangent(t.data(), tangents.data(), t.size());
+  s.InterpolateMthDerivative(2, t.data(), second.data(), t.size());
+  for (size_t i = 0; i < t.size(); ++i)
+  {
+    const math::Vector3d point = s.Interpolate(t[i]);
+    const math::Vector3d tangent = s.InterpolateTangent(t[i]);
+    const math::Vector3d acceleration = s.InterpolateMthDerivative(2, t[i]);
+    if (!point.IsFinite())
+    {
+      EXPECT_FALSE(out[i].IsFinite()) << t[i];
+      EXPECT_FALSE(tangents[i].IsFinite()) << t[i];
+      EXPECT_FALSE(second[i].IsFinite()) << t[i];
+      continue;
+    }
+    EXPECT_TRUE(point.Equal(out[i], 0.0)) << t[i];
+    EXPECT_TRUE(tangent.Equal(tangents[i], 0.0)) << t[i];
+    EXPECT_TRUE(acceleration.Equal(second[i], 0.0)) << t[i];
+  }
+
+  // Nothing to do
+  s.Interpolate(t.data(), out.data(), 0);
+}
+
+/////////////////////////////////////////////////
+TEST(SplineTest, InterpolateFrames)
+{
+  math::Spline s;
+  std::vector<double> t{0.0, 0.5, 1.0};
+  std::vector<math::SplineFrame> frames(t.size());
+
+  // Empty spline
+  s.InterpolateFrames(t.data(), frames.data(), t.size());
+  for (const auto &frame : frames)
+  {
+    EXPECT_FALSE(frame.position.IsFinite());
+    EXPECT_FALSE(frame.tangent.IsFinite());
+    EXPECT_FALSE(std::isfinite(frame.curvature));
+  }
+
+  // Single point
+  s.AddPoint(math::Vector3d(1, 2, 3));
+  s.InterpolateFrames(t.data(), frames.data(), t.size());
+  for (const auto &frame : frames)
+  {
+    EXPECT_EQ(math::Vector3d(1, 2, 3), frame.position);
+    EXPECT_DOUBLE_EQ(0.0, frame.curvature);
+  }
+
+  // A circle of radius 2 in the XY plane, counterclockwise
+  s.Clear();
+  const int n = 64;
+  for (int i = 0; i <= n; ++i)
+  {
+    const double angle = 2 * GZ_PI * i / n;
+    s.AddPoint(math::Vector3d(2 * std::cos(angle), 2 * std::sin(angle), 1));
+  }
+  t.clear();
+  for (int i = 0; i <= 200; ++i)
+    t.push_back(i / 200.0);
+  frames.resize(t.size());
+  s.InterpolateFrames(t.data(), frames.data(), t.size());
+  for (size_t i = 0; i < t.size(); ++i)
+  {
+    const math::SplineFrame &frame = frames[i];
+    EXPECT_NEAR(0.5, frame.curvature, 0.02) << t[i];
+    EXPECT_NEAR(1.0, frame.tangent.Length(), 1e-12);
+    // The normal points to the center, the binormal up
+    math::Vector3d center = -frame.position;
+    center.Z(0);
+    EXPECT_TRUE(frame.normal.Equal(center.Normalized(), 0.02)) << t[i];
+    EXPECT_TRUE(frame.binormal.Equal(math::Vector3d::UnitZ, 1e-6)) << t[i];
+    EXPECT_NEAR(0.0, frame.tangent.Dot(frame.normal), 1e-12);
+    EXPECT_TRUE(frame.tangent.Cross(frame.normal).Equal(frame.binormal,
+        1e-12));
+  }
+
+  // A straight line has no curvature nor normal
+  s.Clear();
+  s.AddPoint(math::Vector3d(0, 0, 0));
+  s.AddPoint(math::Vector3d(1, 1, 0));
+  s.AddPoint(math::Vector3d(2, 2, 0));
+  s.InterpolateFrames(t.data(), frames.data(), t.size());
+  for (const auto &frame : frames)
+  {
+    EXPECT_DOUBLE_EQ(0.0, frame.curvature);
+    EXPECT_EQ(math::Vector3d::Zero, frame.normal);
+    EXPECT_EQ(math::Vector3d::Zero, frame.binormal);
+    EXPECT_TRUE(frame.tangent.Equal(
+        math::Vector3d(1, 1, 0).Normalized(), 1e-12));
+  }
+
+  // Same positions and derivatives as the single value functions, in any
+  // order and out of range
+  s.Clear();
+  for (int i = 0; i < 50; ++i)
+    s.AddPoint(math::Vector3d(i, std::sin(i), 0.01 * i * i));
+  t = {-0.1, 0.0, 1e-9, 0.02, 0.3, 0.5, 0.999999, 1.0, 1.2};
+  for (int i = 0; i < 100; ++i)
+    t.push_back(std::fmod(i * 0.618034, 1.0));
+  frames.resize(t.size());
+  s.InterpolateFrames(t.data(), frames.data(), t.size());
+  for (size_t i = 0; i < t.size(); ++i)
+  {
+    const math::Vector3d point = s.Interpolate(t[i]);
+    const math::SplineFrame &frame = frames[i];
+    if (!point.IsFinite())
+    {
+      EXPECT_FALSE(frame.position.IsFinite()) << t[i];
+      EXPECT_FALSE(std::isfinite(frame.curvature)) << t[i];
+      continue;
+    }
+    EXPECT_TRUE(point.Equal(frame.position, 0.0)) << t[i];
+    const math::Vector3d d1 = s.InterpolateTangent(t[i]);
+    EXPECT_TRUE(d1.Equal(frame.firstDerivative, 0.0)) << t[i];
+    if (t[i] > 0.0 && t[i] < 1.0)
+    {
+      const math::Vector3d d2 = s.InterpolateMthDerivative(2, t[i]);
+      EXPECT_TRUE(d2.Equal(frame.secondDerivative, 1e-12)) << t[i];
+      EXPECT_NEAR(d1.Cross(d2).Length() / std::pow(d1.Length(), 3),
+                  frame.curvature, 1e-12) << t[i];
+    }
+  }
+
+  // Nothing to do
+  s.InterpolateFrames(t.data(), frames.data(), 0);
+}
+
+/////////////////////////////////////////////////
+TEST(SplineTest, InterpolateAtDistance)
+{
+  math::Spline s;
+  EXPECT_EQ(0u, s.ArcLengthTableSamples());
+  EXPECT_FALSE(s.InterpolateAtDistance(0.0).IsFinite());
+
+  // Single point
+  s.AddPoint(math::Vector3d(1, 2, 3));
+  EXPECT_EQ(math::Vector3d(1, 2, 3), s.InterpolateAtDistance(0.0));
+
+  // Helix, whose segments have uneven speeds
+  for (int i = 1; i < 50; ++i)
+  {
+    s.AddPoint(math::Vector3d(10 * std::cos(0.3 * i), 10 * std::sin(0.3 * i),
+                              0.5 * i + std::sin(i)));
+  }
+  const double length = s.ArcLength();
+  EXPECT_EQ(s.Interpolate(0.0), s.InterpolateAtDistance(0.0));
+  EXPECT_EQ(s.Interpolate(1.0), s.InterpolateAtDistance(length));
+  EXPECT_FALSE(s.InterpolateAtDistance(-0.1).IsFinite());
+  EXPECT_FALSE(s.InterpolateAtDistance(length + 0.1).IsFinite());
+  EXPECT_FALSE(s.InterpolateAtDistance(std::nan("")).IsFinite());
+  EXPECT_FALSE(s.InterpolateTangentAtDistance(-0.1).IsFinite());
+
+  // Evenly spaced distances give evenly spaced points, up to the error of
+  // the arc lengths of the segments.
+  const int count = 1000;
+  const double step = length / count;
+  std::vector<math::Vector3d> points(count + 1);
+  std::vector<math::Vector3d> tangents(count + 1);
+  for (int i = 0; i <= count; ++i)
+  {
+    points[i] = s.InterpolateAtDistance(i * step);
+    tangents[i] = s.InterpolateTangentAtDistance(i * step);
+  }
+  for (int i = 1; i <= count; ++i)
+    EXPECT_NEAR(step, points[i].Distance(points[i - 1]), 1e-2 * step) << i;
+
+  // The tables give about the same points, and are rebuilt with the
+  // segments.
+  s.ArcLengthTableSamples(16);
+  EXPECT_EQ(16u, s.ArcLengthTableSamples());
+  const double segmentLength = length / 49;
+  for (int i = 0; i <= count; ++i)
+  {
+    EXPECT_NEAR(0.0, s.InterpolateAtDistance(i * step).Distance(points[i]),
+                1e-3 * segmentLength);
+    EXPECT_NEAR(0.0,
+        s.InterpolateTangentAtDistance(i * step).Distance(tangents[i]),
+        1e-2 * tangents[i].Length());
+  }
+
+  EXPECT_TRUE(s.UpdatePoint(20, math::Vector3d(3, 4, 12)));
+  s.AddPoint(math::Vector3d(0, 0, 30));
+  math::Spline rebuilt;
+  rebuilt.ArcLengthTableSamples(16);
+  for (size_t i = 0; i < s.PointCount(); ++i)
+    rebuilt.AddPoint(s.Point(i));
+  ASSERT_DOUBLE_EQ(rebuilt.ArcLength(), s.ArcLength());
+  for (int i = 0; i <= count; ++i)
+  {
+    const double distance = s.ArcLength() * i / count;
+    EXPECT_TRUE(rebuilt.InterpolateAtDistance(distance).Equal(
+        s.InterpolateAtDistance(distance), 0.0)) << i;
+  }
+
+  // Without tables, the parameter values are solved for again.
+  const math::Vector3d tabulated = s.InterpolateAtDistance(0.37 * length);
+  s.ArcLengthTableSamples(0);
+  EXPECT_EQ(0u, s.ArcLengthTableSamples());
+  rebuilt.ArcLengthTableSamples(0);
+  EXPECT_NEAR(0.0, s.InterpolateAtDistance(0.37 * length).Distance(
+      tabulated), 1e-3 * segmentLength);
+  EXPECT_TRUE(rebuilt.InterpolateAtDistance(0.37 * length).Equal(
+      s.InterpolateAtDistance(0.37 * length), 0.0));
+}
+
+/////////////////////////////////////////////////
+TEST(SplineTest, ClosestParameter)
+{
+  math::Spline s;
+  EXPECT_EQ(math::INF_D, s.ClosestParameter(math::Vector3d::Zero));
+
+  s.AddPoint(math::Vector3d(1, 2, 3));
+  EXPECT_DOUBLE_EQ(0.0, s.ClosestParameter(math::Vector3d::Zero));
+
+  for (int i = 1; i < 60; ++i)
+  {
+    s.AddPoint(math::Vector3d(10 * std::cos(0.3 * i), 10 * std::sin(0.3 * i),
+                              0.5 * i + std::sin(i)));
+  }
+
+  // Closest sample of the spline, to compare with.
+  std::vector<math::Vector3d> samples(20001);
+  for (size_t i = 0; i < samples.size(); ++i)
+    samples[i] = s.Interpolate(static_cast<double>(i) / (samples.size() - 1));
+  auto closestSample = [&](const math::Vector3d &_p)
+  {
+    double distance = math::INF_D;
+    for (const auto &sample : samples)
+      distance = std::min(distance, sample.Distance(_p));
+    return distance;
+  };
+
+  math::Rand::Seed(7);
+  for (int i = 0; i < 200; ++i)
+  {
+    const math::Vector3d p(math::Rand::DblUniform(-15, 15),
+                           math::Rand::DblUniform(-15, 15),
+                           math::Rand::DblUniform(-5, 35));
+    const double t = s.ClosestParameter(p);
+    ASSERT_GE(t, 0.0);
+    ASSERT_LE(t, 1.0);
+    const math::Vector3d closest = s.Interpolate(t);
+    EXPECT_LE(closest.Distance(p), closestSample(p) + 1e-9) << p;
+
+    // Interior closest points are where the spline is perpendicular to the
+    // offset.
+    if (t > 1e-6 && t < 1 - 1e-6)
+    {
+      EXPECT_NEAR(0.0, (closest - p).Dot(s.InterpolateTangent(t).Normalized()),
+                  1e-6);
+    }
+
+    // Out of range hints are ignored.
+    EXPECT_DOUBLE_EQ(t, s.ClosestParameter(p, -0.5));
+    EXPECT_DOUBLE_EQ(t, s.ClosestParameter(p, 2.0));
+  }
+
+  // Tracking a point that follows the spline, starting from the previous
+  // result, finds the same points.
+  double hint = -1.0;
+  for (int i = 0; i <= 500; ++i)
+  {
+    const math::Vector3d p = s.Interpolate(i / 500.0) +
+        math::Vector3d(0.3 * std::sin(0.1 * i), 0.2, -0.1);
+    const double t = s.ClosestParameter(p, hint);
+    EXPECT_NEAR(s.Interpolate(s.ClosestParameter(p)).Distance(p),
+                s.Interpolate(t).Distance(p), 1e-9) << i;
+    hint = t;
+  }
+
+  // Moved points are found.
+  ASSERT_TRUE(s.UpdatePoint(30, math::Vector3d(50, 50, 50)));
+  const double t = s.ClosestParameter(math::Vector3d(51, 50, 50), hint);
+  EXPECT_NEAR(0.0, s.Interpolate(t).Distance(math::Vector3d(50, 50, 50)),
+              1.0);
+}
+
+/////////////////////////////////////////////////
+TEST(SplineTest, Tessellate)
+{
+  math::Spline s;
+  std::vector<math::Vector3d> points{math::Vector3d::One};
+  EXPECT_TRUE(s.Tessellate(0.1, points));
+  EXPECT_TRUE(points.empty());
+
+  s.AddPoint(math::Vector3d(1, 2, 3));
+  EXPECT_TRUE(s.Tessellate(0.1, points));
+  ASSERT_EQ(1u, points.size());
+  EXPECT_EQ(math::Vector3d(1, 2, 3), points[0]);
+
+  // Straight segments need no subdivision.
+  s.AddPoint(math::Vector3d(2, 2, 3));
+  s.AddPoint(math::Vector3d(3, 2, 3));
+  EXPECT_TRUE(s.Tessellate(1e-9, points));
+  EXPECT_EQ(3u, points.size());
+
+  EXPECT_FALSE(s.Tessellate(0.0, points));
+  EXPECT_TRUE(points.empty());
+  EXPECT_FALSE(s.Tessellate(-1.0, points));
+  EXPECT_FALSE(s.Tessellate(std::nan(""), points));
+
+  // A helix, then a straight line.
+  s.Clear();
+  for (int i = 0; i < 30; ++i)
+  {
+    s.AddPoint(math::Vector3d(10 * std::cos(0.3 * i), 10 * std::sin(0.3 * i),
+                              0.5 * i + std::sin(i)));
+  }
+  for (int i = 1; i < 10; ++i)
+    s.AddPoint(s.Point(29) + math::Vector3d(0, 0, i));
+
+  size_t previousSize = 0;
+  for (const double maxError : {1.0, 0.1, 0.01, 0.001})
+  {
+    EXPECT_TRUE(s.Tessellate(maxError, points));
+    EXPECT_GT(points.size(), previousSize);
+    previousSize = points.size();
+    EXPECT_EQ(s.Point(0), points.front());
+    EXPECT_EQ(s.Point(s.PointCount() - 1), points.back());
+
+    // Every point of the spline is close to the polyline.
+    for (int i = 0; i <= 5000; ++i)
+    {
+      const math::Vector3d p = s.Interpolate(i / 5000.0);
+      double distance = math::INF_D;
+      for (size_t j = 1; j < points.size(); ++j)
+      {
+        const math::Vector3d chord = points[j] - points[j - 1];
+        const double along = std::clamp(
+            (p - points[j - 1]).Dot(chord) / chord.SquaredLength(), 0.0, 1.0);
+        distance = std::min(distance,
+                            p.Distance(points[j - 1] + chord * along));
+      }
+      EXPECT_LE(distance, maxError * (1 + 1e-9)) << maxError << " " << i;
+    }
+  }
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "gz/math/Filter.hh"
+#include "gz/math/MovingWindowFilter.hh"
+#include "gz/math/SignalStats.hh"
+#include "gz/math/SpscRingBuffer.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(SpscRingBufferTest, PushPop)
+{
+  SpscRingBuffer<int> ring(5);
+  EXPECT_EQ(8u, ring.Capacity());
+  EXPECT_TRUE(ring.Empty());
+
+  int value = -1;
+  EXPECT_FALSE(ring.Pop(value));
+  EXPECT_EQ(-1, value);
+
+  EXPECT_TRUE(ring.Push(1));
+  EXPECT_TRUE(ring.Push(2));
+  EXPECT_EQ(2u, ring.Size());
+  EXPECT_TRUE(ring.Pop(value));
+  EXPECT_EQ(1, value);
+
+  // Bulk pushes and pops wrapping around the end of the storage
+  const std::vector<int> values = {3, 4, 5, 6, 7, 8, 9, 10, 11};
+  EXPECT_EQ(7u, ring.Push(values.data(), values.size()));
+  EXPECT_EQ(8u, ring.Size());
+  EXPECT_FALSE(ring.Push(12));
+
+  std::vector<int> out(10, 0);
+  EXPECT_EQ(3u, ring.Pop(out.data(), 3));
+  EXPECT_EQ(2, out[0]);
+  EXPECT_EQ(3, out[1]);
+  EXPECT_EQ(4, out[2]);
+  EXPECT_EQ(2u, ring.Push(values.data() + 7, 2));
+  EXPECT_EQ(7u, ring.Pop(out.data(), out.size()));
+  for (int i = 0; i < 7; ++i)
+    EXPECT_EQ(5 + i, out[i]);
+  EXPECT_TRUE(ring.Empty());
+  EXPECT_EQ(0u, ring.Pop(out.data(), out.size()));
+
+  // The samples are passed in at most two pieces
+  EXPECT_EQ(7u, ring.Push(values.data(), 7));
+  std::vector<size_t> pieces;
+  std::vector<int> consumed;
+  EXPECT_EQ(6u, ring.Consume([&](const int *_data, size_t _n)
+  {
+    pieces.push_back(_n);
+    consumed.insert(consumed.end(), _data, _data + _n);
+  }, 6));
+  ASSERT_EQ(2u, pieces.size());
+  EXPECT_EQ(5u, pieces[0]);
+  EXPECT_EQ(1u, pieces[1]);
+  EXPECT_EQ(std::vector<int>({3, 4, 5, 6, 7, 8}), consumed);
+  EXPECT_EQ(1u, ring.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(SpscRingBufferTest, Drain)
+{
+  SpscRingBuffer<double> ring(16);
+  std::vector<double> samples(12);
+  for (size_t i = 0; i < samples.size(); ++i)
+    samples[i] = 0.5 * i - 1.0;
+
+  // Start near the end of the storage so the samples wrap around
+  std::vector<double> skip(10);
+  ring.Push(skip.data(), skip.size());
+  ring.Pop(skip.data(), skip.size());
+
+  SignalStats stats;
+  EXPECT_TRUE(stats.InsertStatistics("mean,max,min"));
+  SignalStats expectedStats;
+  EXPECT_TRUE(expectedStats.InsertStatistics("mean,max,min"));
+  expectedStats.InsertData(samples.data(), samples.size());
+  ASSERT_EQ(samples.size(), ring.Push(samples.data(), samples.size()));
+  EXPECT_EQ(samples.size(), ring.Drain(stats));
+  EXPECT_EQ(samples.size(), stats.Count());
+  for (const auto &[name, value] : expectedStats.Map())
+    EXPECT_NEAR(value, stats.Map()[name], 1e-12) << name;
+
+  SignalVariance variance;
+  ring.Push(samples.data(), samples.size());
+  EXPECT_EQ(4u, ring.Drain(variance, 4));
+  EXPECT_EQ(4u, variance.Count());
+
+  MovingWindowFilterd window(3);
+  EXPECT_EQ(8u, ring.Drain(window));
+  EXPECT_DOUBLE_EQ((samples[9] + samples[10] + samples[11]) / 3,
+                   window.Value());
+
+  OnePole<double> onePole(0.1, 1.0);
+  OnePole<double> expectedOnePole(0.1, 1.0);
+  BiQuad<double> biQuad(0.1, 1.0);
+  BiQuad<double> expectedBiQuad(0.1, 1.0);
+  for (double sample : samples)
+  {
+    expectedOnePole.Process(sample);
+    expectedBiQuad.Process(sample);
+  }
+  ring.Push(samples.data(), samples.size());
+  EXPECT_EQ(samples.size(), ring.Drain(onePole));
+  ring.Push(samples.data(), samples.size());
+  EXPECT_EQ(samples.size(), ring.Drain(biQuad));
+  EXPECT_DOUBLE_EQ(expectedOnePole.Value(), onePole.Value());
+  EXPECT_DOUBLE_EQ(expectedBiQuad.Value(), biQuad.Value());
+  EXPECT_TRUE(ring.Empty());
+}
+
+/////////////////////////////////////////////////
+TEST(SpscRingBufferTest, Threads)
+{
+  // The consumer receives every sample once, in order
+  const uint64_t count = 200000;
+  SpscRingBuffer<uint64_t> ring(64);
+  std::thread producer([&]()
+  {
+    std::vector<uint64_t> block(7);
+    uint64_t next = 0;
+    while (next < count)
+    {
+      const uint64_t n = std::min<uint64_t>(block.size(), count - next);
+      std::iota(block.begin(), block.begin() + n, next);
+      next += ring.Push(block.data(), n);
+      if (next < count)
+        std::this_thread::yield();
+    }
+  });
+
+  uint64_t expected = 0;
+  bool ordered = true;
+  std::vector<uint64_t> block(11);
+  while (expected < count)
+  {
+    const size_t n = ring.Pop(block.data(), block.size());
+    for (size_t i = 0; i < n; ++i)
+      ordered = ordered && block[i] == expected++;
+    if (n == 0)
+      std::this_thread::yield();
+  }
+  producer.join();
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(count, expected);
+  EXPECT_TRUE(ring.Empty());
+}
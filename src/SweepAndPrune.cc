@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "gz/math/SweepAndPrune.hh"
+
+#include <algorithm>
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+  /// \brief Factor by which the variance of the box centers along another
+  /// axis must exceed the one along the current axis to switch to it, so
+  /// that boxes spread evenly don't make the axis flip every step.
+  constexpr double kAxisHysteresis = 1.2;
+
+  /// \brief A box in the sorted order.
+  struct Entry
+  {
+    /// \brief Minimum corner.
+    Vector3d min;
+
+    /// \brief Maximum corner.
+    Vector3d max;
+
+    /// \brief Index of the box.
+    std::size_t index;
+  };
+}
+
+// Private data for SweepAndPrune class
+class gz::math::SweepAndPrune::Implementation
+{
+  /// \brief Resize the boxes, keeping the sorted order of the remaining
+  /// ones and adding the new ones at the end.
+  /// \param[in] _count New number of boxes.
+  public: void Resize(const std::size_t _count)
+  {
+    const std::size_t old = this->mins.size();
+    this->mins.resize(_count);
+    this->maxs.resize(_count);
+    if (_count < old)
+    {
+      this->entries.erase(std::remove_if(this->entries.begin(),
+          this->entries.end(), [_count](const Entry &_e)
+          {
+            return _e.index >= _count;
+          }), this->entries.end());
+    }
+    for (std::size_t i = old; i < _count; ++i)
+      this->entries.push_back(Entry{Vector3d::Zero, Vector3d::Zero, i});
+  }
+
+  /// \brief Choose the axis with the largest variance of the box centers.
+  /// \return True if the axis changed.
+  public: bool ChooseAxis()
+  {
+    const std::size_t n = this->mins.size();
+    if (n < 2)
+      return false;
+    Vector3d sum, sum2;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      const Vector3d c = this->mins[i] + this->maxs[i];
+      sum += c;
+      sum2 += c * c;
+    }
+    const Vector3d variance = sum2 - sum * sum / static_cast<double>(n);
+    int best = this->axis;
+    for (int a = 0; a < 3; ++a)
+    {
+      if (variance[a] > kAxisHysteresis * variance[best])
+        best = a;
+    }
+    const bool changed = best != this->axis;
+    this->axis = best;
+    return changed;
+  }
+
+  /// \brief Minimum corner of each box.
+  public: std::vector<Vector3d> mins;
+
+  /// \brief Maximum corner of each box.
+  public: std::vector<Vector3d> maxs;
+
+  /// \brief Boxes sorted by their minimum along the axis.
+  public: std::vector<Entry> entries;
+
+  /// \brief Axis the boxes are sorted on.
+  public: int axis = 0;
+};
+
+//////////////////////////////////////////////////
+SweepAndPrune::SweepAndPrune()
+: dataPtr(gz::utils::MakeImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+SweepAndPrune::SweepAndPrune(const std::vector<AxisAlignedBox> &_boxes)
+: SweepAndPrune()
+{
+  this->Update(_boxes);
+}
+
+//////////////////////////////////////////////////
+void SweepAndPrune::Update(const std::vector<AxisAlignedBox> &_boxes)
+{
+  this->Update(_boxes.data(), _boxes.size());
+}
+
+//////////////////////////////////////////////////
+void SweepAndPrune::Update(const AxisAlignedBox *_boxes,
+    const std::size_t _count)
+{
+  this->dataPtr->Resize(_count);
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    this->dataPtr->mins[i] = _boxes[i].Min();
+    this->dataPtr->maxs[i] = _boxes[i].Max();
+  }
+}
+
+//////////////////////////////////////////////////
+void SweepAndPrune::Update(const Vector3d *_min, const Vector3d *_max,
+    const std::size_t _count)
+{
+  this->dataPtr->Resize(_count);
+  std::copy(_min, _min + _count, this->dataPtr->mins.begin());
+  std::copy(_max, _max + _count, this->dataPtr->maxs.begin());
+}
+
+//////////////////////////////////////////////////
+bool SweepAndPrune::SetBox(const std::size_t _index,
+    const AxisAlignedBox &_box)
+{
+  if (_index >= this->Size())
+    return false;
+  this->dataPtr->mins[_index] = _box.Min();
+  this->dataPtr->maxs[_index] = _box.Max();
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::size_t SweepAndPrune::Size() const
+{
+  return this->dataPtr->mins.size();
+}
+
+//////////////////////////////////////////////////
+AxisAlignedBox SweepAndPrune::Box(const std::size_t _index) const
+{
+  // Set the corners directly, the constructor would reorder the corners of
+  // an empty box.
+  AxisAlignedBox box;
+  box.Min() = this->dataPtr->mins[_index];
+  box.Max() = this->dataPtr->maxs[_index];
+  return box;
+}
+
+//////////////////////////////////////////////////
+int SweepAndPrune::Axis() const
+{
+  return this->dataPtr->axis;
+}
+
+//////////////////////////////////////////////////
+void SweepAndPrune::Pairs(
+    std::vector<std::pair<std::size_t, std::size_t>> &_pairs)
+{
+  _pairs.clear();
+  auto &d = *this->dataPtr;
+  auto &entries = d.entries;
+  const std::size_t n = entries.size();
+
+  for (Entry &e : entries)
+  {
+    e.min = d.mins[e.index];
+    e.max = d.maxs[e.index];
+  }
+
+  const int axis = d.axis;
+  if (d.ChooseAxis())
+  {
+    const int a = d.axis;
+    std::sort(entries.begin(), entries.end(),
+        [a](const Entry &_l, const Entry &_r)
+        {
+          return _l.min[a] < _r.min[a];
+        });
+  }
+  else
+  {
+    // Insertion sort, close to linear when the boxes moved little since
+    // the previous step.
+    for (std::size_t i = 1; i < n; ++i)
+    {
+      if (!(entries[i].min[axis] < entries[i - 1].min[axis]))
+        continue;
+      const Entry e = entries[i];
+      std::size_t j = i;
+      for (; j > 0 && e.min[axis] < entries[j - 1].min[axis]; --j)
+        entries[j] = entries[j - 1];
+      entries[j] = e;
+    }
+  }
+
+  const int a0 = d.axis;
+  const int a1 = (a0 + 1) % 3;
+  const int a2 = (a0 + 2) % 3;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    const Entry &e = entries[i];
+    const double end = e.max[a0];
+    for (std::size_t j = i + 1; j < n && entries[j].min[a0] <= end; ++j)
+    {
+      const Entry &o = entries[j];
+      if (e.max[a1] < o.min[a1] || e.min[a1] > o.max[a1] ||
+          e.max[a2] < o.min[a2] || e.min[a2] > o.max[a2])
+      {
+        continue;
+      }
+      if (e.index < o.index)
+        _pairs.emplace_back(e.index, o.index);
+      else
+        _pairs.emplace_back(o.index, e.index);
+    }
+  }
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "gz/math/AxisAlignedBox.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/SweepAndPrune.hh"
+#include "gz/math/Vector3.hh"
+
+using namespace gz;
+using namespace math;
+
+namespace
+{
+using Pairs = std::vector<std::pair<std::size_t, std::size_t>>;
+
+/// \brief Overlapping pairs by testing every pair.
+Pairs BrutePairs(const std::vector<Vector3d> &_min,
+                 const std::vector<Vector3d> &_max)
+{
+  Pairs pairs;
+  for (std::size_t i = 0; i < _min.size(); ++i)
+  {
+    AxisAlignedBox a;
+    a.Min() = _min[i];
+    a.Max() = _max[i];
+    for (std::size_t j = i + 1; j < _min.size(); ++j)
+    {
+      AxisAlignedBox b;
+      b.Min() = _min[j];
+      b.Max() = _max[j];
+      if (a.Intersects(b))
+        pairs.emplace_back(i, j);
+    }
+  }
+  return pairs;
+}
+
+/// \brief Get the pairs of a broadphase, sorted.
+Pairs SortedPairs(SweepAndPrune &_broadphase)
+{
+  Pairs pairs;
+  _broadphase.Pairs(pairs);
+  std::sort(pairs.begin(), pairs.end());
+  return pairs;
+}
+}
+
+/////////////////////////////////////////////////
+TEST(SweepAndPruneTest, Empty)
+{
+  SweepAndPrune broadphase;
+  EXPECT_EQ(0u, broadphase.Size());
+  EXPECT_FALSE(broadphase.SetBox(0, AxisAlignedBox(0, 0, 0, 1, 1, 1)));
+  Pairs pairs{{1, 2}};
+  broadphase.Pairs(pairs);
+  EXPECT_TRUE(pairs.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(SweepAndPruneTest, Boxes)
+{
+  std::vector<AxisAlignedBox> boxes{
+    AxisAlignedBox(0, 0, 0, 1, 1, 1),
+    AxisAlignedBox(0.5, 0.5, 0.5, 2, 2, 2),
+    AxisAlignedBox(2, 0, 0, 3, 1, 1),
+    AxisAlignedBox(5, 5, 5, 6, 6, 6),
+    AxisAlignedBox()};
+  SweepAndPrune broadphase(boxes);
+  EXPECT_EQ(5u, broadphase.Size());
+  EXPECT_EQ(boxes[1], broadphase.Box(1));
+  EXPECT_EQ(boxes[4], broadphase.Box(4));
+
+  // Touching boxes intersect, as in AxisAlignedBox::Intersects
+  EXPECT_EQ((Pairs{{0, 1}, {1, 2}}), SortedPairs(broadphase));
+
+  EXPECT_TRUE(broadphase.SetBox(3, AxisAlignedBox(0.9, 0.9, 0.9, 4, 4, 4)));
+  EXPECT_EQ((Pairs{{0, 1}, {0, 3}, {1, 2}, {1, 3}, {2, 3}}),
+            SortedPairs(broadphase));
+
+  // Removing and adding boxes
+  boxes.resize(2);
+  broadphase.Update(boxes);
+  EXPECT_EQ(2u, broadphase.Size());
+  EXPECT_EQ((Pairs{{0, 1}}), SortedPairs(broadphase));
+
+  boxes.push_back(AxisAlignedBox(-1, -1, -1, 0, 0, 0));
+  broadphase.Update(boxes.data(), boxes.size());
+  EXPECT_EQ((Pairs{{0, 1}, {0, 2}}), SortedPairs(broadphase));
+}
+
+/////////////////////////////////////////////////
+TEST(SweepAndPruneTest, MovingBoxes)
+{
+  Rand::Seed(4);
+  const std::size_t count = 400;
+  std::vector<Vector3d> positions;
+  std::vector<Vector3d> velocities;
+  std::vector<Vector3d> sizes;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    positions.emplace_back(Rand::DblUniform(-5, 5), Rand::DblUniform(-20, 20),
+                           Rand::DblUniform(-5, 5));
+    velocities.emplace_back(Rand::DblUniform(-1, 1), Rand::DblUniform(-1, 1),
+                            Rand::DblUniform(-1, 1));
+    sizes.emplace_back(Rand::DblUniform(0.1, 1), Rand::DblUniform(0.1, 1),
+                       Rand::DblUniform(0.1, 1));
+  }
+
+  SweepAndPrune broadphase;
+  std::vector<Vector3d> mins(count);
+  std::vector<Vector3d> maxs(count);
+  for (int step = 0; step < 60; ++step)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      positions[i] += velocities[i] * 0.1;
+      // Squash the scene along y over time so the sort axis changes
+      if (step > 30)
+        positions[i].Y(positions[i].Y() * 0.8);
+      mins[i] = positions[i] - sizes[i];
+      maxs[i] = positions[i] + sizes[i];
+    }
+    broadphase.Update(mins.data(), maxs.data(), count);
+    EXPECT_EQ(BrutePairs(mins, maxs), SortedPairs(broadphase)) << step;
+    if (step == 0)
+    {
+      EXPECT_EQ(1, broadphase.Axis());
+    }
+  }
+  EXPECT_NE(1, broadphase.Axis());
+}
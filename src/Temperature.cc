@@ -16,20 +16,51 @@
 */
 
 #include "gz/math/Temperature.hh"
+#include "gz/math/TemperatureT.hh"
 
+#include <algorithm>
 #include <istream>
 #include <ostream>
 
 /// \brief Private data for the Temperature class.
 class gz::math::Temperature::Implementation
 {
-  /// \brief Temperature value in Kelvin.
-  public: double kelvin{0.0};
+  /// \brief Temperature, which implements the arithmetic.
+  public: Temperatured temp;
 };
 
 using namespace gz;
 using namespace math;
 
+namespace
+{
+/// \brief Number of values the array conversions process at once.
+constexpr size_t kBlockSize = 256;
+
+/// \brief Apply a function to an array of values by blocks. Each block is
+/// copied to and from a local array, which the compiler knows doesn't
+/// overlap the arrays of the caller, so that the loop over the block, of
+/// constant length, can be vectorized.
+/// \param[in] _in Input values.
+/// \param[out] _out Output values, can be _in.
+/// \param[in] _count Number of values.
+/// \param[in] _fn Function of a value.
+template <typename F>
+void Transform(const double *_in, double *_out, const size_t _count,
+               const F &_fn)
+{
+  double block[kBlockSize] = {};
+  for (size_t i = 0; i < _count; i += kBlockSize)
+  {
+    const size_t n = std::min(kBlockSize, _count - i);
+    std::copy_n(_in + i, n, block);
+    for (size_t k = 0; k < kBlockSize; ++k)
+      block[k] = _fn(block[k]);
+    std::copy_n(block, n, _out + i);
+  }
+}
+}  // namespace
+
 /////////////////////////////////////////////////
 Temperature::Temperature()
 : dataPtr(gz::utils::MakeImpl<Implementation>())
@@ -40,85 +71,165 @@ Temperature::Temperature()
 Temperature::Temperature(double _temp)
 : Temperature()
 {
-  this->dataPtr->kelvin = _temp;
+  this->dataPtr->temp.SetKelvin(_temp);
 }
 
 /////////////////////////////////////////////////
 double Temperature::KelvinToCelsius(double _temp)
 {
-  return _temp - 273.15;
+  return Temperatured::KelvinToCelsius(_temp);
 }
 
 /////////////////////////////////////////////////
 double Temperature::KelvinToFahrenheit(double _temp)
 {
-  return _temp * 1.8 - 459.67;
+  return Temperatured::KelvinToFahrenheit(_temp);
 }
 
 /////////////////////////////////////////////////
 double Temperature::CelsiusToFahrenheit(double _temp)
 {
-  return _temp * 1.8 + 32.0;
+  return Temperatured::CelsiusToFahrenheit(_temp);
 }
 
 /////////////////////////////////////////////////
 double Temperature::CelsiusToKelvin(double _temp)
 {
-  return _temp + 273.15;
+  return Temperatured::CelsiusToKelvin(_temp);
 }
 
 /////////////////////////////////////////////////
 double Temperature::FahrenheitToCelsius(double _temp)
 {
-  return (_temp - 32.0) / 1.8;
+  return Temperatured::FahrenheitToCelsius(_temp);
 }
 
 /////////////////////////////////////////////////
 double Temperature::FahrenheitToKelvin(double _temp)
 {
-  return (_temp + 459.67) / 1.8;
+  return Temperatured::FahrenheitToKelvin(_temp);
+}
+
+/////////////////////////////////////////////////
+void Temperature::KelvinToCelsius(const double *_in, double *_out,
+    size_t _count)
+{
+  Transform(_in, _out, _count, [](double _temp)
+  {
+    return KelvinToCelsius(_temp);
+  });
+}
+
+/////////////////////////////////////////////////
+void Temperature::KelvinToFahrenheit(const double *_in, double *_out,
+    size_t _count)
+{
+  Transform(_in, _out, _count, [](double _temp)
+  {
+    return KelvinToFahrenheit(_temp);
+  });
+}
+
+/////////////////////////////////////////////////
+void Temperature::CelsiusToFahrenheit(const double *_in, double *_out,
+    size_t _count)
+{
+  Transform(_in, _out, _count, [](double _temp)
+  {
+    return CelsiusToFahrenheit(_temp);
+  });
+}
+
+/////////////////////////////////////////////////
+void Temperature::CelsiusToKelvin(const double *_in, double *_out,
+    size_t _count)
+{
+  Transform(_in, _out, _count, [](double _temp)
+  {
+    return CelsiusToKelvin(_temp);
+  });
+}
+
+/////////////////////////////////////////////////
+void Temperature::FahrenheitToCelsius(const double *_in, double *_out,
+    size_t _count)
+{
+  Transform(_in, _out, _count, [](double _temp)
+  {
+    return FahrenheitToCelsius(_temp);
+  });
+}
+
+/////////////////////////////////////////////////
+void Temperature::FahrenheitToKelvin(const double *_in, double *_out,
+    size_t _count)
+{
+  Transform(_in, _out, _count, [](double _temp)
+  {
+    return FahrenheitToKelvin(_temp);
+  });
+}
+
+/////////////////////////////////////////////////
+void Temperature::ScaleOffset(const double *_in, double *_out,
+    size_t _count, double _scale, double _offset)
+{
+  Transform(_in, _out, _count, [_scale, _offset](double _value)
+  {
+    return _value * _scale + _offset;
+  });
+}
+
+/////////////////////////////////////////////////
+void Temperature::Clamp(double *_temps, size_t _count, double _min,
+    double _max)
+{
+  Transform(_temps, _temps, _count, [_min, _max](double _temp)
+  {
+    return std::min(std::max(_temp, _min), _max);
+  });
 }
 
 /////////////////////////////////////////////////
 void Temperature::SetKelvin(double _temp)
 {
-  this->dataPtr->kelvin = _temp;
+  this->dataPtr->temp.SetKelvin(_temp);
 }
 
 /////////////////////////////////////////////////
 void Temperature::SetCelsius(double _temp)
 {
-  this->SetKelvin(CelsiusToKelvin(_temp));
+  this->dataPtr->temp.SetCelsius(_temp);
 }
 
 /////////////////////////////////////////////////
 void Temperature::SetFahrenheit(double _temp)
 {
-  this->SetKelvin(FahrenheitToKelvin(_temp));
+  this->dataPtr->temp.SetFahrenheit(_temp);
 }
 
 /////////////////////////////////////////////////
 double Temperature::Kelvin() const
 {
-  return this->dataPtr->kelvin;
+  return this->dataPtr->temp.Kelvin();
 }
 
 /////////////////////////////////////////////////
 double Temperature::Celsius() const
 {
-  return KelvinToCelsius(this->dataPtr->kelvin);
+  return this->dataPtr->temp.Celsius();
 }
 
 /////////////////////////////////////////////////
 double Temperature::Fahrenheit() const
 {
-  return KelvinToFahrenheit(this->dataPtr->kelvin);
+  return this->dataPtr->temp.Fahrenheit();
 }
 
 /////////////////////////////////////////////////
 double Temperature::operator()() const
 {
-  return this->dataPtr->kelvin;
+  return this->dataPtr->temp();
 }
 
 /////////////////////////////////////////////////
@@ -131,117 +242,117 @@ Temperature &Temperature::operator=(double _temp)
 /////////////////////////////////////////////////
 Temperature Temperature::operator+(double _temp) const
 {
-  return this->dataPtr->kelvin + _temp;
+  return (this->dataPtr->temp + _temp).Kelvin();
 }
 
 /////////////////////////////////////////////////
 Temperature Temperature::operator+(const Temperature &_temp) const
 {
-  return this->dataPtr->kelvin + _temp;
+  return (this->dataPtr->temp + _temp.Kelvin()).Kelvin();
 }
 
 /////////////////////////////////////////////////
 const Temperature &Temperature::operator+=(double _temp)
 {
-  this->dataPtr->kelvin += _temp;
+  this->dataPtr->temp += _temp;
   return *this;
 }
 
 /////////////////////////////////////////////////
 const Temperature &Temperature::operator+=(const Temperature &_temp)
 {
-  this->dataPtr->kelvin += _temp.Kelvin();
+  this->dataPtr->temp += _temp.Kelvin();
   return *this;
 }
 
 /////////////////////////////////////////////////
 Temperature Temperature::operator-(double _temp) const
 {
-  return this->dataPtr->kelvin - _temp;
+  return (this->dataPtr->temp - _temp).Kelvin();
 }
 
 /////////////////////////////////////////////////
 Temperature Temperature::operator-(const Temperature &_temp) const
 {
-  return this->dataPtr->kelvin - _temp.Kelvin();
+  return (this->dataPtr->temp - _temp.Kelvin()).Kelvin();
 }
 
 /////////////////////////////////////////////////
 const Temperature &Temperature::operator-=(double _temp)
 {
-  this->dataPtr->kelvin -= _temp;
+  this->dataPtr->temp -= _temp;
   return *this;
 }
 
 /////////////////////////////////////////////////
 const Temperature &Temperature::operator-=(const Temperature &_temp)
 {
-  this->dataPtr->kelvin -= _temp.Kelvin();
+  this->dataPtr->temp -= _temp.Kelvin();
   return *this;
 }
 
 /////////////////////////////////////////////////
 Temperature Temperature::operator*(double _temp) const
 {
-  return Temperature(this->dataPtr->kelvin * _temp);
+  return (this->dataPtr->temp * _temp).Kelvin();
 }
 
 /////////////////////////////////////////////////
 Temperature Temperature::operator*(const Temperature &_temp) const
 {
-  return Temperature(this->dataPtr->kelvin * _temp.Kelvin());
+  return (this->dataPtr->temp * _temp.Kelvin()).Kelvin();
 }
 
 /////////////////////////////////////////////////
 const Temperature &Temperature::operator*=(double _temp)
 {
-  this->dataPtr->kelvin *= _temp;
+  this->dataPtr->temp *= _temp;
   return *this;
 }
 
 /////////////////////////////////////////////////
 const Temperature &Temperature::operator*=(const Temperature &_temp)
 {
-  this->dataPtr->kelvin *= _temp.Kelvin();
+  this->dataPtr->temp *= _temp.Kelvin();
   return *this;
 }
 
 /////////////////////////////////////////////////
 Temperature Temperature::operator/(double _temp) const
 {
-  return Temperature(this->dataPtr->kelvin / _temp);
+  return (this->dataPtr->temp / _temp).Kelvin();
 }
 
 /////////////////////////////////////////////////
 Temperature Temperature::operator/(const Temperature &_temp) const
 {
-  return Temperature(this->dataPtr->kelvin / _temp.Kelvin());
+  return (this->dataPtr->temp / _temp.Kelvin()).Kelvin();
 }
 
 /////////////////////////////////////////////////
 const Temperature &Temperature::operator/=(double _temp)
 {
-  this->dataPtr->kelvin /= _temp;
+  this->dataPtr->temp /= _temp;
   return *this;
 }
 
 /////////////////////////////////////////////////
 const Temperature &Temperature::operator/=(const Temperature &_temp)
 {
-  this->dataPtr->kelvin /= _temp.Kelvin();
+  this->dataPtr->temp /= _temp.Kelvin();
   return *this;
 }
 
 /////////////////////////////////////////////////
 bool Temperature::operator==(const Temperature &_temp) const
 {
-  return equal(this->dataPtr->kelvin, _temp.Kelvin());
+  return this->dataPtr->temp == Temperatured(_temp.Kelvin());
 }
 
 /////////////////////////////////////////////////
 bool Temperature::operator==(double _temp) const
 {
-  return equal(this->dataPtr->kelvin, _temp);
+  return this->dataPtr->temp == Temperatured(_temp);
 }
 
 /////////////////////////////////////////////////
@@ -259,47 +370,47 @@ bool Temperature::operator!=(double _temp) const
 /////////////////////////////////////////////////
 bool Temperature::operator<(const Temperature &_temp) const
 {
-  return this->dataPtr->kelvin < _temp.Kelvin();
+  return this->dataPtr->temp < Temperatured(_temp.Kelvin());
 }
 
 /////////////////////////////////////////////////
 bool Temperature::operator<(double _temp) const
 {
-  return this->dataPtr->kelvin < _temp;
+  return this->dataPtr->temp < Temperatured(_temp);
 }
 
 /////////////////////////////////////////////////
 bool Temperature::operator<=(const Temperature &_temp) const
 {
-  return this->dataPtr->kelvin <= _temp.Kelvin();
+  return this->dataPtr->temp <= Temperatured(_temp.Kelvin());
 }
 
 /////////////////////////////////////////////////
 bool Temperature::operator<=(double _temp) const
 {
-  return this->dataPtr->kelvin <= _temp;
+  return this->dataPtr->temp <= Temperatured(_temp);
 }
 
 /////////////////////////////////////////////////
 bool Temperature::operator>(const Temperature &_temp) const
 {
-  return this->dataPtr->kelvin > _temp.Kelvin();
+  return this->dataPtr->temp > Temperatured(_temp.Kelvin());
 }
 
 /////////////////////////////////////////////////
 bool Temperature::operator>(double _temp) const
 {
-  return this->dataPtr->kelvin > _temp;
+  return this->dataPtr->temp > Temperatured(_temp);
 }
 
 /////////////////////////////////////////////////
 bool Temperature::operator>=(const Temperature &_temp) const
 {
-  return this->dataPtr->kelvin >= _temp.Kelvin();
+  return this->dataPtr->temp >= Temperatured(_temp.Kelvin());
 }
 
 /////////////////////////////////////////////////
 bool Temperature::operator>=(double _temp) const
 {
-  return this->dataPtr->kelvin >= _temp;
+  return this->dataPtr->temp >= Temperatured(_temp);
 }
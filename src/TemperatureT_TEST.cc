@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <type_traits>
+
+#include "gz/math/Temperature.hh"
+#include "gz/math/TemperatureT.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(TemperatureTTest, Constexpr)
+{
+  constexpr Temperatured zero;
+  constexpr double zeroKelvin = zero.Kelvin();
+  EXPECT_DOUBLE_EQ(0, zeroKelvin);
+  constexpr Temperatured temp(100);
+  constexpr double tempKelvin = temp.Kelvin();
+  constexpr double sumKelvin = (temp + 10.0).Kelvin();
+  EXPECT_DOUBLE_EQ(100, tempKelvin);
+  EXPECT_DOUBLE_EQ(110, sumKelvin);
+  static_assert(temp > zero, "Comparisons should be constexpr");
+  constexpr double converted = Temperatured::CelsiusToKelvin(10);
+  EXPECT_DOUBLE_EQ(283.15, converted);
+
+  static_assert(std::is_trivially_copyable_v<Temperaturef>,
+                "Temperaturef should be trivially copyable");
+  static_assert(sizeof(Temperaturef) == sizeof(float),
+                "Temperaturef should only store its value");
+}
+
+/////////////////////////////////////////////////
+TEST(TemperatureTTest, SameAsTemperature)
+{
+  for (const double kelvin : {0.0, 1.5, 273.15, 300.0, 1234.5})
+  {
+    const Temperature expected(kelvin);
+    const Temperatured temp(kelvin);
+    EXPECT_DOUBLE_EQ(expected.Kelvin(), temp.Kelvin());
+    EXPECT_DOUBLE_EQ(expected.Celsius(), temp.Celsius());
+    EXPECT_DOUBLE_EQ(expected.Fahrenheit(), temp.Fahrenheit());
+    EXPECT_DOUBLE_EQ(expected(), temp());
+
+    EXPECT_DOUBLE_EQ((expected + 2.5).Kelvin(), (temp + 2.5).Kelvin());
+    EXPECT_DOUBLE_EQ((expected - temp.Kelvin()).Kelvin(),
+                     (temp - temp).Kelvin());
+    EXPECT_DOUBLE_EQ((expected * 3.0).Kelvin(), (temp * 3.0).Kelvin());
+    EXPECT_DOUBLE_EQ((expected / 4.0).Kelvin(), (temp / 4.0).Kelvin());
+
+    const Temperaturef tempf(static_cast<float>(kelvin));
+    EXPECT_NEAR(expected.Celsius(), tempf.Celsius(), 1e-4);
+    EXPECT_NEAR(expected.Fahrenheit(), tempf.Fahrenheit(), 1e-3);
+  }
+
+  Temperatured temp;
+  temp.SetCelsius(25);
+  Temperature expected;
+  expected.SetCelsius(25);
+  EXPECT_DOUBLE_EQ(expected.Kelvin(), temp.Kelvin());
+  temp.SetFahrenheit(70);
+  expected.SetFahrenheit(70);
+  EXPECT_DOUBLE_EQ(expected.Kelvin(), temp.Kelvin());
+
+  EXPECT_DOUBLE_EQ(Temperature::CelsiusToFahrenheit(25),
+                   Temperatured::CelsiusToFahrenheit(25));
+  EXPECT_DOUBLE_EQ(Temperature::FahrenheitToCelsius(70),
+                   Temperatured::FahrenheitToCelsius(70));
+}
+
+/////////////////////////////////////////////////
+TEST(TemperatureTTest, Operators)
+{
+  Temperaturef temp(10);
+  temp += 5.0f;
+  EXPECT_FLOAT_EQ(15, temp.Kelvin());
+  temp -= Temperaturef(3);
+  EXPECT_FLOAT_EQ(12, temp.Kelvin());
+  temp *= 2.0f;
+  temp /= 4.0f;
+  EXPECT_FLOAT_EQ(6, temp.Kelvin());
+  temp += Temperaturef(1);
+  temp -= 1.0f;
+  EXPECT_EQ(Temperaturef(6), temp);
+  EXPECT_NE(Temperaturef(6.1f), temp);
+  EXPECT_LT(temp, Temperaturef(7));
+  EXPECT_LE(temp, Temperaturef(6));
+  EXPECT_GT(temp, Temperaturef(5));
+  EXPECT_GE(temp, Temperaturef(6));
+
+  std::stringstream stream;
+  stream << temp;
+  EXPECT_EQ("6", stream.str());
+  Temperaturef read;
+  stream >> read;
+  EXPECT_EQ(temp, read);
+
+  std::stringstream bad("hot");
+  bad >> read;
+  EXPECT_TRUE(bad.fail());
+  EXPECT_EQ(temp, read);
+}
+
+/////////////////////////////////////////////////
+TEST(TemperatureTTest, Conversion)
+{
+  const Temperature temp(321.5);
+  const Temperatured tempd(temp);
+  EXPECT_DOUBLE_EQ(321.5, tempd.Kelvin());
+  EXPECT_EQ(temp, tempd.ToTemperature());
+  EXPECT_EQ(temp, Temperaturef(temp).ToTemperature());
+}
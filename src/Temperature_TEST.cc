@@ -16,6 +16,11 @@
 */
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
 #include "gz/math/Temperature.hh"
 
 using namespace gz;
@@ -70,6 +75,60 @@ TEST(TemperatureTest, Conversions)
   EXPECT_NEAR(Temperature::FahrenheitToKelvin(60.0), 288.7055, 1e-3);
 }
 
+/////////////////////////////////////////////////
+TEST(TemperatureTest, ArrayConversions)
+{
+  // Longer than a block, and not a multiple of its size
+  std::vector<double> in(1000);
+  for (size_t i = 0; i < in.size(); ++i)
+    in[i] = -50.0 + 0.75 * static_cast<double>(i);
+
+  using Conversion = double (*)(double);
+  using ArrayConversion = void (*)(const double *, double *, size_t);
+  const std::vector<std::pair<Conversion, ArrayConversion>> conversions =
+  {
+    {&Temperature::KelvinToCelsius, &Temperature::KelvinToCelsius},
+    {&Temperature::KelvinToFahrenheit, &Temperature::KelvinToFahrenheit},
+    {&Temperature::CelsiusToFahrenheit, &Temperature::CelsiusToFahrenheit},
+    {&Temperature::CelsiusToKelvin, &Temperature::CelsiusToKelvin},
+    {&Temperature::FahrenheitToCelsius, &Temperature::FahrenheitToCelsius},
+    {&Temperature::FahrenheitToKelvin, &Temperature::FahrenheitToKelvin}
+  };
+  for (const auto &[conversion, arrayConversion] : conversions)
+  {
+    std::vector<double> out(in.size());
+    arrayConversion(in.data(), out.data(), in.size());
+    for (size_t i = 0; i < in.size(); ++i)
+      EXPECT_DOUBLE_EQ(conversion(in[i]), out[i]);
+
+    // In place
+    std::vector<double> values(in);
+    arrayConversion(values.data(), values.data(), values.size());
+    EXPECT_EQ(out, values);
+  }
+
+  // Nothing to convert
+  Temperature::KelvinToCelsius(nullptr, nullptr, 0);
+
+  // Raw counts to Celsius, with 0.04 K per count
+  std::vector<double> out(in.size());
+  Temperature::ScaleOffset(in.data(), out.data(), 5, 0.04, -273.15);
+  for (size_t i = 0; i < 5; ++i)
+    EXPECT_DOUBLE_EQ(in[i] * 0.04 - 273.15, out[i]);
+  EXPECT_DOUBLE_EQ(0.0, out[5]);
+
+  std::vector<double> values(in);
+  values[3] = std::nan("");
+  Temperature::Clamp(values.data(), values.size(), 0.0, 500.0);
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    if (i == 3)
+      EXPECT_TRUE(std::isnan(values[i]));
+    else
+      EXPECT_DOUBLE_EQ(std::min(std::max(in[i], 0.0), 500.0), values[i]);
+  }
+}
+
 /////////////////////////////////////////////////
 TEST(TemperatureTest, MutatorsAccessors)
 {
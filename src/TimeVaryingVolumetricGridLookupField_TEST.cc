@@ -16,6 +16,10 @@
  */
 #include <gz/math/TimeVaryingVolumetricGridLookupField.hh>
 #include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
 using namespace gz;
 using namespace math;
 /////////////////////////////////////////////////
@@ -199,3 +203,330 @@ TEST(TimeVaryingVolumetricLookupFieldTest, TestConstruction)
     ASSERT_EQ(res, 0.5);
   }
 }
+
+/////////////////////////////////////////////////
+TEST(TimeVaryingVolumetricLookupFieldTest, EstimateWithoutLookUp)
+{
+  std::vector<Vector3d> cloud;
+  for (double x = 0; x < 3; x += 1)
+    for (double y = 0; y < 3; y += 1)
+      for (double z = 0; z < 3; z += 1)
+        cloud.emplace_back(x, y, z);
+
+  std::vector<double> values1(cloud.size());
+  std::vector<double> values2(cloud.size());
+  for (std::size_t i = 0; i < cloud.size(); ++i)
+  {
+    values1[i] = cloud[i].X() + 2 * cloud[i].Y() + 3 * cloud[i].Z();
+    values2[i] = 10 - values1[i];
+  }
+
+  VolumetricGridLookupField<double> scalarIndex(cloud);
+  TimeVaryingVolumetricGridLookupField<
+    double, double, InMemorySession<double, double>> timeVaryingField;
+  timeVaryingField.AddVolumetricGridField(0, scalarIndex);
+  timeVaryingField.AddVolumetricGridField(2, scalarIndex);
+
+  const std::vector<Vector3d> queries{
+    {0.5, 0.5, 0.5}, {1.25, 0.75, 1.5}, {2, 2, 2}, {0, 1.5, 0}, {3, 3, 3}};
+
+  // Cursors are kept across time steps by the caller
+  std::array<VolumetricGridCursor, 2> cursors;
+  auto session = timeVaryingField.CreateSession();
+  for (double time : {0.0, 0.5, 1.5, 2.0})
+  {
+    auto stepped = timeVaryingField.StepTo(session, time);
+    ASSERT_TRUE(stepped.has_value());
+    for (const auto &q : queries)
+    {
+      auto hinted = timeVaryingField.EstimateQuadrilinear<double>(
+        stepped.value(), q, values1, values2, cursors,
+        Vector3d{1e-6, 1e-6, 1e-6}, -1);
+      auto points = timeVaryingField.LookUp(stepped.value(), q);
+      auto expected = timeVaryingField.EstimateQuadrilinear<double>(
+        stepped.value(), points, values1, values2, q, -1);
+      auto res = timeVaryingField.EstimateQuadrilinear<double>(
+        stepped.value(), q, values1, values2, Vector3d{1e-6, 1e-6, 1e-6},
+        -1);
+      ASSERT_EQ(expected.has_value(), res.has_value()) << time << " " << q;
+      ASSERT_EQ(expected.has_value(), hinted.has_value()) << time << " " << q;
+      if (expected.has_value())
+      {
+        EXPECT_NEAR(expected.value(), res.value(), 1e-9)
+          << time << " " << q;
+        EXPECT_DOUBLE_EQ(res.value(), hinted.value()) << time << " " << q;
+      }
+    }
+  }
+
+  auto invalid = timeVaryingField.CreateSession(500);
+  EXPECT_FALSE(timeVaryingField.EstimateQuadrilinear<double>(
+    invalid, queries[0], values1, values2).has_value());
+}
+
+/////////////////////////////////////////////////
+TEST(TimeVaryingVolumetricLookupFieldTest, QuantizedValues)
+{
+  std::vector<Vector3d> cloud;
+  for (double x = 0; x < 3; x += 1)
+    for (double y = 0; y < 3; y += 1)
+      for (double z = 0; z < 3; z += 1)
+        cloud.emplace_back(x, y, z);
+
+  std::vector<double> values1(cloud.size());
+  std::vector<double> values2(cloud.size());
+  for (std::size_t i = 0; i < cloud.size(); ++i)
+  {
+    values1[i] = 0.1 * cloud[i].X() + 2.7 * cloud[i].Y() * cloud[i].Z();
+    values2[i] = 10 - 3.3 * values1[i];
+  }
+  QuantizedValues<std::int16_t, double> quantized1(values1);
+  QuantizedValues<std::int16_t, double> quantized2(values2);
+  const double maxError =
+    std::max(quantized1.MaxError(), quantized2.MaxError());
+
+  VolumetricGridLookupField<double> scalarIndex(cloud);
+  TimeVaryingVolumetricGridLookupField<
+    double, double, InMemorySession<double, double>> timeVaryingField;
+  timeVaryingField.AddVolumetricGridField(0, scalarIndex);
+  timeVaryingField.AddVolumetricGridField(2, scalarIndex);
+
+  auto session = timeVaryingField.CreateSession();
+  for (double time : {0.0, 0.7, 2.0})
+  {
+    auto stepped = timeVaryingField.StepTo(session, time);
+    ASSERT_TRUE(stepped.has_value());
+    for (const auto &q : {Vector3d{0.5, 0.5, 0.5}, Vector3d{1.25, 1.75, 2},
+                          Vector3d{5, 0, 0}})
+    {
+      auto expected = timeVaryingField.EstimateQuadrilinear(
+        stepped.value(), q, values1, values2);
+      auto res = timeVaryingField.EstimateQuadrilinear(
+        stepped.value(), q, quantized1, quantized2);
+      ASSERT_EQ(expected.has_value(), res.has_value()) << time << " " << q;
+      if (expected.has_value())
+      {
+        EXPECT_NEAR(expected.value(), res.value(), maxError + 1e-12)
+          << time << " " << q;
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(TimeVaryingVolumetricLookupFieldTest, EstimateChannels)
+{
+  std::vector<Vector3d> cloud;
+  for (double x = 0; x < 3; x += 1)
+    for (double y = 0; y < 3; y += 1)
+      for (double z = 0; z < 3; z += 1)
+        cloud.emplace_back(x, y, z);
+
+  std::vector<double> u1, v1, u2, v2, interleaved1, interleaved2;
+  for (const auto &pt : cloud)
+  {
+    u1.push_back(pt.X() + pt.Y() * pt.Z());
+    v1.push_back(-pt.Z());
+    u2.push_back(2 * pt.X());
+    v2.push_back(pt.Y() - pt.X());
+    interleaved1.insert(interleaved1.end(), {u1.back(), v1.back()});
+    interleaved2.insert(interleaved2.end(), {u2.back(), v2.back()});
+  }
+
+  VolumetricGridLookupField<double> scalarIndex(cloud);
+  TimeVaryingVolumetricGridLookupField<
+    double, double, InMemorySession<double, double>> timeVaryingField;
+  timeVaryingField.AddVolumetricGridField(0, scalarIndex);
+  timeVaryingField.AddVolumetricGridField(2, scalarIndex);
+
+  auto session = timeVaryingField.CreateSession();
+  for (double time : {0.0, 0.5, 1.5, 2.0})
+  {
+    auto stepped = timeVaryingField.StepTo(session, time);
+    ASSERT_TRUE(stepped.has_value());
+    for (const auto &q : {Vector3d{0.5, 0.5, 0.5}, Vector3d{1.25, 1.75, 2},
+                          Vector3d{2, 0, 1}, Vector3d{5, 0, 0}})
+    {
+      auto expectedU = timeVaryingField.EstimateQuadrilinear(
+        stepped.value(), q, u1, u2);
+      auto expectedV = timeVaryingField.EstimateQuadrilinear(
+        stepped.value(), q, v1, v2);
+      double out[2];
+      const bool found = timeVaryingField.EstimateQuadrilinearChannels(
+        stepped.value(), q, interleaved1.data(), interleaved2.data(), 2,
+        out);
+      ASSERT_EQ(expectedU.has_value(), found) << time << " " << q;
+      if (found)
+      {
+        EXPECT_NEAR(expectedU.value(), out[0], 1e-9) << time << " " << q;
+        EXPECT_NEAR(expectedV.value(), out[1], 1e-9) << time << " " << q;
+      }
+    }
+  }
+
+  std::vector<double> xyz1, xyz2;
+  for (const auto &pt : cloud)
+  {
+    xyz1.insert(xyz1.end(), {pt.X(), pt.Y(), pt.Z()});
+    xyz2.insert(xyz2.end(), {3 * pt.X(), 3 * pt.Y(), 3 * pt.Z()});
+  }
+  auto stepped = timeVaryingField.StepTo(session, 1.0);
+  ASSERT_TRUE(stepped.has_value());
+  auto vec = timeVaryingField.EstimateQuadrilinearVector3(
+    stepped.value(), Vector3d{1, 0.5, 2}, xyz1, xyz2);
+  ASSERT_TRUE(vec.has_value());
+  EXPECT_NEAR(2.0, vec->X(), 1e-9);
+  EXPECT_NEAR(1.0, vec->Y(), 1e-9);
+  EXPECT_NEAR(4.0, vec->Z(), 1e-9);
+}
+
+/////////////////////////////////////////////////
+TEST(TimeVaryingVolumetricLookupFieldTest, StepSeveralSessions)
+{
+  std::vector<Vector3d> cloud;
+  for (double x = 0; x < 3; x += 1)
+    for (double y = 0; y < 3; y += 1)
+      for (double z = 0; z < 3; z += 1)
+        cloud.emplace_back(x, y, z);
+
+  VolumetricGridLookupField<double> scalarIndex(cloud);
+  TimeVaryingVolumetricGridLookupField<
+    double, double, InMemorySession<double, double>> timeVaryingField;
+  for (double time = 0; time < 5; time += 1)
+    timeVaryingField.AddVolumetricGridField(time, scalarIndex);
+
+  // The values change with time so that the slice of a session matters
+  std::vector<double> values1(cloud.size());
+  std::vector<double> values2(cloud.size());
+  for (std::size_t i = 0; i < cloud.size(); ++i)
+  {
+    values1[i] = cloud[i].X();
+    values2[i] = 10 + cloud[i].Y();
+  }
+  const Vector3d query{0.5, 1.5, 1};
+
+  for (double time : {-1.0, 0.5, 2.0, 3.5, 4.0, 10.0})
+  {
+    // Before the first slice, between slices, at the last slice and out of
+    // range
+    std::vector<InMemorySession<double, double>> sessions{
+      timeVaryingField.CreateSession(),
+      timeVaryingField.CreateSession(1.5),
+      timeVaryingField.CreateSession(3),
+      timeVaryingField.CreateSession(4),
+      timeVaryingField.CreateSession(500)};
+    std::vector<std::optional<InMemorySession<double, double>>> expected;
+    std::size_t expectedCount = 0;
+    for (const auto &sess : sessions)
+    {
+      expected.push_back(timeVaryingField.StepTo(sess, time));
+      expectedCount += expected.back().has_value();
+    }
+
+    const auto original = sessions;
+    EXPECT_EQ(expectedCount, timeVaryingField.StepTo(
+      sessions.data(), sessions.size(), time)) << time;
+    for (std::size_t i = 0; i < sessions.size(); ++i)
+    {
+      const auto &sess = expected[i].has_value() ?
+        expected[i].value() : original[i];
+      EXPECT_DOUBLE_EQ(sess.time, sessions[i].time) << time << " " << i;
+      auto expectedValue = timeVaryingField.EstimateQuadrilinear<double>(
+        sess, query, values1, values2);
+      auto value = timeVaryingField.EstimateQuadrilinear<double>(
+        sessions[i], query, values1, values2);
+      ASSERT_EQ(expectedValue.has_value(), value.has_value());
+      if (value.has_value())
+      {
+        EXPECT_DOUBLE_EQ(expectedValue.value(), value.value());
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(TimeVaryingVolumetricLookupFieldTest, BlendCache)
+{
+  std::vector<Vector3d> cloud;
+  for (int x = 0; x < 3; ++x)
+    for (int y = 0; y < 3; ++y)
+      for (int z = 0; z < 3; ++z)
+        if (x + y + z != 4)
+          cloud.emplace_back(x, y, z);
+
+  std::vector<double> values1(cloud.size());
+  std::vector<double> values2(cloud.size());
+  for (std::size_t i = 0; i < cloud.size(); ++i)
+  {
+    values1[i] = cloud[i].X() + 2 * cloud[i].Y() + 3 * cloud[i].Z();
+    values2[i] = 10 - values1[i] * values1[i];
+  }
+
+  // The same indices at times 0 to 2, other indices at time 3
+  VolumetricGridLookupField<double> scalarIndex(cloud);
+  std::vector<std::size_t> reversed(cloud.size());
+  for (std::size_t i = 0; i < cloud.size(); ++i)
+    reversed[i] = cloud.size() - 1 - i;
+  VolumetricGridLookupField<double> reversedIndex(cloud, reversed);
+  EXPECT_TRUE(scalarIndex.SameIndices(
+    VolumetricGridLookupField<double>(cloud)));
+  EXPECT_FALSE(scalarIndex.SameIndices(reversedIndex));
+
+  TimeVaryingVolumetricGridLookupField<
+    double, double, InMemorySession<double, double>> timeVaryingField;
+  timeVaryingField.AddVolumetricGridField(0, scalarIndex);
+  timeVaryingField.AddVolumetricGridField(1, scalarIndex);
+  timeVaryingField.AddVolumetricGridField(2, scalarIndex);
+  timeVaryingField.AddVolumetricGridField(3, reversedIndex);
+
+  const std::vector<Vector3d> queries{
+    {0.5, 0.5, 0.5}, {1.25, 0.75, 1.5}, {2, 2, 2}, {0, 1.5, 0}, {3, 3, 3},
+    {1.5, 1.5, 1.5}, {0.5, 0.5, 0.5}, {2, 0, 2}};
+
+  InMemoryBlendCache<double, double, double> cache;
+  auto check = [&](const InMemorySession<double, double> &_session)
+  {
+    for (const auto &q : queries)
+    {
+      auto expected = timeVaryingField.EstimateQuadrilinear<double>(
+        _session, q, values1, values2, Vector3d{1e-6, 1e-6, 1e-6}, -1);
+      auto res = timeVaryingField.EstimateQuadrilinear<double>(
+        _session, q, values1, values2, cache, Vector3d{1e-6, 1e-6, 1e-6},
+        -1);
+      ASSERT_EQ(expected.has_value(), res.has_value())
+        << _session.time << " " << q;
+      if (expected.has_value())
+      {
+        EXPECT_NEAR(expected.value(), res.value(), 1e-9)
+          << _session.time << " " << q;
+      }
+    }
+  };
+
+  // Stepping within a slice, to the next slice, to slices with other
+  // indices and to the last slice invalidates the blended values
+  auto session = timeVaryingField.CreateSession();
+  for (double time : {0.0, 0.25, 0.25, 0.5, 1.0, 1.75, 2.0, 2.5, 3.0})
+  {
+    session = timeVaryingField.StepTo(session, time).value();
+    check(session);
+  }
+
+  // Changing the values needs an explicit invalidation
+  auto early = timeVaryingField.StepTo(
+    timeVaryingField.CreateSession(), 0.5).value();
+  check(early);
+  for (auto &v : values1)
+    v += 100;
+  cache.Invalidate();
+  check(early);
+
+  // Values at other addresses invalidate it
+  const std::vector<double> other(values1.size(), 7.0);
+  for (const auto &q : queries)
+  {
+    timeVaryingField.EstimateQuadrilinear<double>(
+      early, q, other, values2, cache);
+  }
+  check(early);
+}
@@ -16,6 +16,15 @@
  */
 #include <gz/math/TimeVaryingVolumetricGrid.hh>
 #include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
 using namespace gz;
 using namespace math;
 /////////////////////////////////////////////////
@@ -122,3 +131,565 @@ TEST(TimeVaryingVolumetricGridTest, TestEmptyGrid)
   // Check validity
   ASSERT_FALSE(grid.IsValid(invalid_session));
 }
+
+/////////////////////////////////////////////////
+TEST(TimeVaryingVolumetricGridTest, AddSlices)
+{
+  InMemoryTimeVaryingVolumetricGridFactory<double, double> pointFactory;
+  InMemoryTimeVaryingVolumetricGridFactory<double, double> sliceFactory;
+
+  for (int t = 0; t < 6; ++t)
+  {
+    // The grid moves at t = 3, and the points of the last slice are in
+    // another order so it cannot share the grid of the previous one
+    const double shift = t < 3 ? 0 : 0.25;
+    std::vector<Vector3d> cloud;
+    std::vector<double> values;
+    for (double x = 0; x <= 2; x += 1)
+    {
+      for (double y = 0; y <= 2; y += 1)
+      {
+        for (double z = 0; z <= 2; z += 1)
+        {
+          cloud.emplace_back(x + shift, y, z);
+          values.push_back(100 * t + x + 10 * y + z);
+        }
+      }
+    }
+    if (t == 5)
+    {
+      std::reverse(cloud.begin(), cloud.end());
+      std::reverse(values.begin(), values.end());
+    }
+    for (std::size_t i = 0; i < cloud.size(); ++i)
+      pointFactory.AddPoint(t, cloud[i], values[i]);
+    sliceFactory.AddSlice(t, cloud.data(), values.data(), cloud.size());
+  }
+
+  const auto expected = pointFactory.Build();
+  for (unsigned int threads : {1u, 4u, 0u})
+  {
+    const auto grid = sliceFactory.Build(threads);
+    for (double t = 0; t <= 5; t += 0.5)
+    {
+      auto session = grid.CreateSession();
+      auto expectedSession = expected.CreateSession();
+      auto stepped = grid.StepTo(session, t);
+      auto expectedStepped = expected.StepTo(expectedSession, t);
+      ASSERT_EQ(expectedStepped.has_value(), stepped.has_value()) << t;
+      if (!stepped)
+        continue;
+      for (double x = -0.5; x <= 2.5; x += 0.25)
+      {
+        const Vector3d pos(x, 1.5, 0.5);
+        const auto value = grid.LookUp(*stepped, pos);
+        const auto expectedValue = expected.LookUp(*expectedStepped, pos);
+        ASSERT_EQ(expectedValue.has_value(), value.has_value())
+          << t << " " << x;
+        if (value)
+        {
+          EXPECT_DOUBLE_EQ(*expectedValue, *value) << t << " " << x;
+        }
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// Fill a time slice on a 3x3x3 grid whose value is _time + x
+bool LoadSlice(double _time, StreamingTimeSlice<double, double> &_slice)
+{
+  std::vector<Vector3d> cloud;
+  for (double x = 0; x <= 1; x += 0.5)
+  {
+    for (double y = 0; y <= 1; y += 0.5)
+    {
+      for (double z = 0; z <= 1; z += 0.5)
+      {
+        cloud.emplace_back(x, y, z);
+        _slice.values.push_back(_time + x);
+      }
+    }
+  }
+  _slice.field = VolumetricGridLookupField<double>(cloud);
+  return true;
+}
+
+/////////////////////////////////////////////////
+TEST(TimeVaryingVolumetricGridTest, StreamingMatchesInMemory)
+{
+  InMemoryTimeVaryingVolumetricGridFactory<double, double> memoryFactory;
+  StreamingTimeVaryingVolumetricGridFactory<double, double> streamFactory;
+  for (double t = 0; t <= 1; t += 0.25)
+  {
+    StreamingTimeSlice<double, double> slice;
+    LoadSlice(t, slice);
+    std::size_t i = 0;
+    for (double x = 0; x <= 1; x += 0.5)
+      for (double y = 0; y <= 1; y += 0.5)
+        for (double z = 0; z <= 1; z += 0.5)
+          memoryFactory.AddPoint(t, Vector3d{x, y, z}, slice.values[i++]);
+    streamFactory.AddTimeSlice(t, [t](StreamingTimeSlice<double, double> &_s)
+    {
+      return LoadSlice(t, _s);
+    });
+  }
+  auto memoryGrid = memoryFactory.Build();
+  auto streamGrid = streamFactory.Build();
+  EXPECT_EQ(0u, streamGrid.MemoryUsage());
+
+  auto memorySess = memoryGrid.CreateSession();
+  auto streamSess = streamGrid.CreateSession();
+  ASSERT_TRUE(streamGrid.IsValid(streamSess));
+  EXPECT_EQ(memoryGrid.Bounds(memorySess), streamGrid.Bounds(streamSess));
+
+  std::array<VolumetricGridCursor, 2> memoryCursors;
+  std::array<VolumetricGridCursor, 2> streamCursors;
+  for (double t = 0; t <= 1; t += 0.1)
+  {
+    auto nextMemory = memoryGrid.StepTo(memorySess, t);
+    auto nextStream = streamGrid.StepTo(streamSess, t);
+    ASSERT_EQ(nextMemory.has_value(), nextStream.has_value()) << t;
+    if (!nextMemory.has_value())
+      break;
+    memorySess = nextMemory.value();
+    streamSess = nextStream.value();
+
+    for (auto pos : {Vector3d{0.25, 0.5, 0.75}, Vector3d{1, 1, 1},
+                     Vector3d{2, 0, 0}})
+    {
+      auto expected = memoryGrid.LookUp(memorySess, pos);
+      auto actual = streamGrid.LookUp(streamSess, pos);
+      ASSERT_EQ(expected.has_value(), actual.has_value()) << t << " " << pos;
+      if (expected.has_value())
+      {
+        EXPECT_NEAR(expected.value(), actual.value(), 1e-9);
+        EXPECT_NEAR(t + pos.X(), actual.value(), 1e-9);
+      }
+
+      // Cursors only speed up the search
+      auto memoryHinted = memoryGrid.LookUp(memorySess, pos, memoryCursors);
+      auto streamHinted = streamGrid.LookUp(streamSess, pos, streamCursors);
+      EXPECT_EQ(expected, memoryHinted) << t << " " << pos;
+      EXPECT_EQ(actual, streamHinted) << t << " " << pos;
+    }
+  }
+  EXPECT_GT(streamGrid.MemoryUsage(), 0u);
+
+  auto late = streamGrid.CreateSession(10);
+  EXPECT_FALSE(streamGrid.IsValid(late));
+  EXPECT_FALSE(streamGrid.LookUp(late, Vector3d{0, 0, 0}).has_value());
+}
+
+/////////////////////////////////////////////////
+TEST(TimeVaryingVolumetricGridTest, StreamingEviction)
+{
+  auto loads = std::make_shared<std::atomic<int>>(0);
+  auto build = [&](std::size_t _budget)
+  {
+    StreamingTimeVaryingVolumetricGridFactory<double, double> factory;
+    for (int i = 0; i < 10; ++i)
+    {
+      const double t = i;
+      factory.AddTimeSlice(t,
+        [t, loads](StreamingTimeSlice<double, double> &_s)
+      {
+        ++(*loads);
+        _s.bytes = 100;
+        return LoadSlice(t, _s);
+      });
+    }
+    factory.SetMemoryBudget(_budget);
+    return factory.Build();
+  };
+
+  // Every slice stays cached without a budget
+  {
+    auto grid = build(std::numeric_limits<std::size_t>::max());
+    auto sess = grid.CreateSession();
+    for (double t = 1; t < 9; t += 1)
+      sess = grid.StepTo(sess, t).value();
+    EXPECT_EQ(1000u, grid.MemoryUsage());
+    auto first = grid.CreateSession();
+    EXPECT_NEAR(0.5, grid.LookUp(first, Vector3d{0.5, 0, 0}).value(), 1e-9);
+  }
+  EXPECT_EQ(10, loads->exchange(0));
+
+  // With room for three slices only the ones in use stay cached, plus the
+  // prefetched one
+  {
+    auto grid = build(300);
+    auto sess = grid.CreateSession();
+    for (double t = 1; t < 9; t += 1)
+    {
+      sess = grid.StepTo(sess, t).value();
+      EXPECT_LE(grid.MemoryUsage(), 300u);
+      EXPECT_NEAR(t + 0.5, grid.LookUp(sess, Vector3d{0.5, 0, 0}).value(),
+        1e-9);
+    }
+    auto first = grid.CreateSession();
+    EXPECT_NEAR(0.5, grid.LookUp(first, Vector3d{0.5, 0, 0}).value(), 1e-9);
+  }
+  // The new session reloads its two slices and prefetches a third
+  EXPECT_EQ(13, loads->load());
+}
+
+/////////////////////////////////////////////////
+TEST(TimeVaryingVolumetricGridTest, StreamingPrefetchBudget)
+{
+  StreamingTimeVaryingVolumetricGridFactory<double, double> factory;
+  for (int i = 0; i < 60; ++i)
+  {
+    const double t = i;
+    factory.AddTimeSlice(t, [t](StreamingTimeSlice<double, double> &_s)
+    {
+      _s.bytes = 1000;
+      return LoadSlice(t, _s);
+    });
+  }
+  factory.SetMemoryBudget(3000);
+  auto grid = factory.Build();
+
+  // Stepping over the prefetched slices leaves them unused, and they
+  // are evicted like the others
+  auto sess = grid.CreateSession();
+  for (double t = 3; t < 57; t += 3)
+  {
+    sess = grid.StepTo(sess, t).value();
+    EXPECT_LE(grid.MemoryUsage(), 3000u) << t;
+    EXPECT_NEAR(t + 0.5, grid.LookUp(sess, Vector3d{0.5, 0, 0}).value(),
+      1e-9);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(TimeVaryingVolumetricGridTest, StreamingRetriesFailedLoads)
+{
+  auto loads = std::make_shared<std::atomic<int>>(0);
+  StreamingTimeVaryingVolumetricGridFactory<double, double> factory;
+  factory.AddTimeSlice(0.0, [loads](StreamingTimeSlice<double, double> &_s)
+  {
+    return ++(*loads) > 1 && LoadSlice(0.0, _s);
+  });
+  auto grid = factory.Build();
+
+  EXPECT_FALSE(grid.LookUp(grid.CreateSession(), Vector3d::Zero));
+  EXPECT_EQ(0u, grid.MemoryUsage());
+  EXPECT_NEAR(0.0, grid.LookUp(grid.CreateSession(), Vector3d::Zero).value(),
+    1e-9);
+  EXPECT_EQ(2, loads->load());
+}
+
+/////////////////////////////////////////////////
+TEST(TimeVaryingVolumetricGridTest, StreamingFromFiles)
+{
+  StreamingTimeVaryingVolumetricGridFactory<double, double> factory;
+  std::vector<std::string> paths;
+  for (int i = 0; i < 3; ++i)
+  {
+    StreamingTimeSlice<double, double> slice;
+    LoadSlice(i, slice);
+    paths.push_back(
+      "TimeVaryingVolumetricGrid_TEST_" + std::to_string(i) + ".bin");
+    std::ofstream out(paths.back(), std::ios::binary);
+    ASSERT_TRUE(slice.field.Save(out, slice.values));
+    factory.AddTimeSliceFile(i, paths.back());
+  }
+  factory.AddTimeSliceFile(3, "TimeVaryingVolumetricGrid_TEST_missing.bin");
+
+  {
+    auto grid = factory.Build();
+    auto sess = grid.CreateSession(0);
+    ASSERT_TRUE(grid.IsValid(sess));
+    sess = grid.StepTo(sess, 1.5).value();
+    EXPECT_NEAR(2.0, grid.LookUp(sess, Vector3d{0.5, 1, 0}).value(), 1e-9);
+
+    // A slice that fails to load gives an invalid session
+    auto sess2 = grid.StepTo(sess, 2).value();
+    EXPECT_NEAR(2.5, grid.LookUp(sess2, Vector3d{0.5, 1, 0}).value(), 1e-9);
+    EXPECT_FALSE(grid.IsValid(grid.CreateSession(3)));
+  }
+
+  for (const auto &path : paths)
+    std::remove(path.c_str());
+}
+
+/////////////////////////////////////////////////
+/// Grid positions along each axis of the tiled tests
+const std::vector<double> kTiledAxis{0, 0.25, 0.5, 0.75, 1};
+
+/////////////////////////////////////////////////
+/// Fill the grid points of a brick of a 5x5x5 grid whose value is
+/// _time + x + 2y + 3z, or of the whole grid if _tiling has a single brick
+bool LoadBrick(double _time, const VolumetricGridTiling<double> &_tiling,
+  std::size_t _brick, StreamingTimeSlice<double, double> &_slice)
+{
+  std::vector<Vector3d> cloud;
+  for (double x : kTiledAxis)
+  {
+    for (double y : kTiledAxis)
+    {
+      for (double z : kTiledAxis)
+      {
+        if (!_tiling.BrickContains(_brick, Vector3d{x, y, z}))
+          continue;
+        cloud.emplace_back(x, y, z);
+        _slice.values.push_back(_time + x + 2 * y + 3 * z);
+      }
+    }
+  }
+  _slice.field = VolumetricGridLookupField<double>(cloud);
+  return true;
+}
+
+/////////////////////////////////////////////////
+TEST(TimeVaryingVolumetricGridTest, Tiling)
+{
+  VolumetricGridTiling<double> single;
+  EXPECT_EQ(1u, single.BrickCount());
+  EXPECT_EQ(0u, single.Brick(Vector3d{5, -5, 5}));
+  EXPECT_TRUE(single.BrickContains(0, Vector3d{5, -5, 5}));
+
+  auto tiling = VolumetricGridTiling<double>::Uniform(
+    kTiledAxis, kTiledAxis, {0, 1}, 2);
+  EXPECT_EQ(4u, tiling.BrickCount());
+  EXPECT_EQ(std::make_pair(Vector3d{0, 0, 0}, Vector3d{1, 1, 1}),
+            tiling.Bounds());
+
+  // x varies the fastest, and points on a split belong to the next brick
+  EXPECT_EQ(0u, tiling.Brick(Vector3d{0.1, 0.1, 0.5}));
+  EXPECT_EQ(1u, tiling.Brick(Vector3d{0.5, 0.1, 0.5}));
+  EXPECT_EQ(2u, tiling.Brick(Vector3d{0.1, 0.9, 0.5}));
+  EXPECT_EQ(3u, tiling.Brick(Vector3d{2, 2, 2}));
+  EXPECT_EQ(0u, tiling.Brick(Vector3d{-2, -2, -2}));
+
+  // Grid points on a split are in the bricks on both sides
+  EXPECT_TRUE(tiling.BrickContains(0, Vector3d{0.5, 0.5, 0}));
+  EXPECT_TRUE(tiling.BrickContains(3, Vector3d{0.5, 0.5, 1}));
+  EXPECT_FALSE(tiling.BrickContains(0, Vector3d{0.75, 0.5, 0}));
+  EXPECT_FALSE(tiling.BrickContains(3, Vector3d{0.25, 0.5, 0}));
+}
+
+/////////////////////////////////////////////////
+TEST(TimeVaryingVolumetricGridTest, TiledMatchesUntiled)
+{
+  const auto tiling = VolumetricGridTiling<double>::Uniform(
+    kTiledAxis, kTiledAxis, kTiledAxis, 2);
+  ASSERT_EQ(8u, tiling.BrickCount());
+
+  auto loads = std::make_shared<std::atomic<int>>(0);
+  StreamingTimeVaryingVolumetricGridFactory<double, double> wholeFactory;
+  StreamingTimeVaryingVolumetricGridFactory<double, double> tiledFactory;
+  for (double t = 0; t <= 2; t += 1)
+  {
+    wholeFactory.AddTimeSlice(t, [t](StreamingTimeSlice<double, double> &_s)
+    {
+      return LoadBrick(t, VolumetricGridTiling<double>(), 0, _s);
+    });
+    tiledFactory.AddTiledTimeSlice(t, tiling,
+      [t, tiling, loads](std::size_t _brick,
+                         StreamingTimeSlice<double, double> &_s)
+      {
+        ++(*loads);
+        return LoadBrick(t, tiling, _brick, _s);
+      });
+  }
+  auto whole = wholeFactory.Build();
+  auto tiled = tiledFactory.Build();
+
+  // No brick is loaded until it is queried
+  auto wholeSess = whole.CreateSession();
+  auto tiledSess = tiled.CreateSession();
+  ASSERT_TRUE(tiled.IsValid(tiledSess));
+  EXPECT_EQ(0, loads->load());
+  EXPECT_EQ(0u, tiled.MemoryUsage());
+  EXPECT_EQ(whole.Bounds(wholeSess), tiled.Bounds(tiledSess));
+
+  const std::vector<Vector3d> positions{
+    {0.1, 0.2, 0.3}, {0.5, 0.5, 0.5}, {0.6, 0.1, 0.9}, {0.49, 0.51, 0.7},
+    {1, 1, 1}, {0, 0, 0}, {0.9, 0.9, 0.2}, {2, 0, 0}, {-1, 0.5, 0.5}};
+  for (double t = 0; t <= 2; t += 0.25)
+  {
+    wholeSess = whole.StepTo(wholeSess, t).value();
+    tiledSess = tiled.StepTo(tiledSess, t).value();
+    for (const auto &pos : positions)
+    {
+      auto expected = whole.LookUp(wholeSess, pos);
+      auto actual = tiled.LookUp(tiledSess, pos);
+      ASSERT_EQ(expected.has_value(), actual.has_value()) << t << " " << pos;
+      if (expected.has_value())
+      {
+        EXPECT_NEAR(expected.value(), actual.value(), 1e-9);
+      }
+    }
+  }
+  // The positions fall in six of the eight bricks, each loaded once per
+  // slice
+  EXPECT_EQ(18, loads->load());
+  EXPECT_FALSE(tiled.StepTo(tiledSess, 3).has_value());
+}
+
+/////////////////////////////////////////////////
+TEST(TimeVaryingVolumetricGridTest, TiledEviction)
+{
+  const auto tiling = VolumetricGridTiling<double>::Uniform(
+    kTiledAxis, kTiledAxis, kTiledAxis, 2);
+  auto loads = std::make_shared<std::atomic<int>>(0);
+  StreamingTimeVaryingVolumetricGridFactory<double, double> factory;
+  for (int i = 0; i < 10; ++i)
+  {
+    const double t = i;
+    factory.AddTiledTimeSlice(t, tiling,
+      [t, tiling, loads](std::size_t _brick,
+                         StreamingTimeSlice<double, double> &_s)
+      {
+        ++(*loads);
+        _s.bytes = 100;
+        return LoadBrick(t, tiling, _brick, _s);
+      });
+  }
+  // Room for four bricks, one slice is 800 bytes
+  factory.SetMemoryBudget(400);
+  auto grid = factory.Build();
+
+  // A session following a point only loads the brick containing it, and
+  // prefetches it in the slice after the next one
+  auto sess = grid.CreateSession();
+  const Vector3d pos{0.25, 0.75, 0};
+  EXPECT_NEAR(1.75, grid.LookUp(sess, pos).value(), 1e-9);
+  EXPECT_EQ(2, loads->load());
+  for (double t = 1; t < 9; t += 1)
+  {
+    sess = grid.StepTo(sess, t).value();
+    EXPECT_LE(grid.MemoryUsage(), 400u);
+    EXPECT_NEAR(t + 1.75, grid.LookUp(sess, pos).value(), 1e-9);
+  }
+  EXPECT_EQ(10, loads->load());
+
+  // Moving to another brick loads it in both slices of the session
+  const Vector3d far{0.75, 0.75, 1};
+  EXPECT_NEAR(8 + 0.75 + 1.5 + 3, grid.LookUp(sess, far).value(), 1e-9);
+  EXPECT_EQ(12, loads->load());
+  EXPECT_LE(grid.MemoryUsage(), 400u);
+
+  // A brick that fails to load gives no value, but the session stays valid
+  StreamingTimeVaryingVolumetricGridFactory<double, double> failing;
+  failing.AddTiledTimeSlice(0, tiling,
+    [tiling](std::size_t _brick, StreamingTimeSlice<double, double> &_s)
+    {
+      return _brick != 7 && LoadBrick(0, tiling, _brick, _s);
+    });
+  auto failingGrid = failing.Build();
+  auto failingSess = failingGrid.CreateSession();
+  EXPECT_TRUE(failingGrid.IsValid(failingSess));
+  EXPECT_FALSE(failingGrid.LookUp(failingSess, far).has_value());
+  EXPECT_NEAR(1.75, failingGrid.LookUp(failingSess, pos).value(), 1e-9);
+}
+
+/////////////////////////////////////////////////
+TEST(TimeVaryingVolumetricGridTest, TiledFromFiles)
+{
+  const auto tiling = VolumetricGridTiling<double>::Uniform(
+    kTiledAxis, kTiledAxis, kTiledAxis, 3);
+  ASSERT_EQ(8u, tiling.BrickCount());
+
+  StreamingTimeVaryingVolumetricGridFactory<double, double> factory;
+  std::vector<std::string> allPaths;
+  for (int i = 0; i < 2; ++i)
+  {
+    std::vector<std::string> paths;
+    for (std::size_t b = 0; b < tiling.BrickCount(); ++b)
+    {
+      StreamingTimeSlice<double, double> brick;
+      LoadBrick(i, tiling, b, brick);
+      paths.push_back("TimeVaryingVolumetricGrid_TEST_" + std::to_string(i) +
+        "_" + std::to_string(b) + ".bin");
+      std::ofstream out(paths.back(), std::ios::binary);
+      ASSERT_TRUE(brick.field.Save(out, brick.values));
+    }
+    allPaths.insert(allPaths.end(), paths.begin(), paths.end());
+    factory.AddTiledTimeSliceFiles(i, tiling, paths);
+  }
+
+  {
+    auto grid = factory.Build();
+    auto sess = grid.StepTo(grid.CreateSession(), 0.5).value();
+    for (const auto &pos : {Vector3d{0, 0.25, 0.5}, Vector3d{1, 0.75, 0.5},
+                            Vector3d{0.75, 0.75, 0.75}})
+    {
+      EXPECT_NEAR(0.5 + pos.X() + 2 * pos.Y() + 3 * pos.Z(),
+        grid.LookUp(sess, pos).value(), 1e-9) << pos;
+    }
+    EXPECT_GT(grid.MemoryUsage(), 0u);
+  }
+
+  for (const auto &path : allPaths)
+    std::remove(path.c_str());
+}
+
+/////////////////////////////////////////////////
+TEST(TimeVaryingVolumetricGridTest, StepSeveralSessions)
+{
+  InMemoryTimeVaryingVolumetricGridFactory<double, double> memoryFactory;
+  StreamingTimeVaryingVolumetricGridFactory<double, double> streamFactory;
+  auto loads = std::make_shared<std::atomic<int>>(0);
+  for (double t = 0; t < 6; t += 1)
+  {
+    StreamingTimeSlice<double, double> slice;
+    LoadSlice(t, slice);
+    std::size_t i = 0;
+    for (double x = 0; x <= 1; x += 0.5)
+      for (double y = 0; y <= 1; y += 0.5)
+        for (double z = 0; z <= 1; z += 0.5)
+          memoryFactory.AddPoint(t, Vector3d{x, y, z}, slice.values[i++]);
+    streamFactory.AddTimeSlice(t,
+      [t, loads](StreamingTimeSlice<double, double> &_s)
+    {
+      ++(*loads);
+      return LoadSlice(t, _s);
+    });
+  }
+  // Nothing is kept unless a session holds it
+  streamFactory.SetMemoryBudget(0);
+  auto memoryGrid = memoryFactory.Build();
+  auto streamGrid = streamFactory.Build();
+
+  std::vector<InMemorySession<double, double>> memorySessions;
+  std::vector<StreamingSession<double, double, double>> streamSessions;
+  for (double t : {0.0, 0.0, 1.5, 3.0, 5.0})
+  {
+    memorySessions.push_back(memoryGrid.CreateSession(t));
+    streamSessions.push_back(streamGrid.CreateSession(t));
+  }
+  streamSessions.push_back(streamGrid.CreateSession(10));
+
+  const Vector3d pos{0.25, 0.5, 0.75};
+  // Number of sessions stepped at each time. A session created at 1.5 is
+  // at the slice at time 2, and a session at the last slice or ahead of
+  // the time is not stepped.
+  const std::vector<std::pair<double, std::size_t>> steps{
+    {0.5, 2}, {2.5, 3}, {2.75, 3}, {4.0, 4}, {1.0, 0}};
+  for (const auto &[t, expected] : steps)
+  {
+    EXPECT_EQ(expected,
+      memoryGrid.StepTo(memorySessions.data(), memorySessions.size(), t));
+    EXPECT_EQ(expected,
+      streamGrid.StepTo(streamSessions.data(), streamSessions.size(), t));
+    for (std::size_t i = 0; i < memorySessions.size(); ++i)
+    {
+      EXPECT_DOUBLE_EQ(memorySessions[i].time, streamSessions[i].time);
+      EXPECT_NEAR(memoryGrid.LookUp(memorySessions[i], pos).value(),
+        streamGrid.LookUp(streamSessions[i], pos).value(), 1e-9) << t << i;
+      EXPECT_NEAR(streamSessions[i].time + pos.X(),
+        streamGrid.LookUp(streamSessions[i], pos).value(), 1e-9) << t << i;
+    }
+    EXPECT_FALSE(streamGrid.IsValid(streamSessions.back()));
+  }
+
+  // The slices the sessions hold stay loaded with no memory budget, so each
+  // slice was only loaded once
+  EXPECT_EQ(6, loads->load());
+  EXPECT_EQ(0u, streamGrid.StepTo(streamSessions.data(), 0, 2));
+  EXPECT_EQ(0u, streamGrid.StepTo(streamSessions.data(),
+    streamSessions.size(), -1));
+}
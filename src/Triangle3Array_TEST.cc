@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "gz/math/AxisAlignedBoxTree.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/Triangle3.hh"
+#include "gz/math/Triangle3Array.hh"
+#include "gz/math/Vector3.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+/// \brief Random triangles scattered in a cube of side 20 centered at the
+/// origin.
+std::vector<Triangle3d> RandomTriangles(const std::size_t _count)
+{
+  Rand::Seed(4321);
+  std::vector<Triangle3d> triangles;
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const Vector3d center(Rand::DblUniform(-10, 10),
+        Rand::DblUniform(-10, 10), Rand::DblUniform(-10, 10));
+    Vector3d pts[3];
+    for (Vector3d &pt : pts)
+    {
+      pt = center + Vector3d(Rand::DblUniform(-1, 1),
+          Rand::DblUniform(-1, 1), Rand::DblUniform(-1, 1));
+    }
+    triangles.push_back(Triangle3d(pts[0], pts[1], pts[2]));
+  }
+  return triangles;
+}
+
+/////////////////////////////////////////////////
+/// \brief Closest hit found by intersecting the plane of every triangle
+/// and checking on which side of each edge the intersection is.
+bool BruteClosestHit(const std::vector<Triangle3d> &_triangles,
+    const Vector3d &_origin, const Vector3d &_dir, const double _min,
+    const double _max, std::size_t &_index, double &_distance)
+{
+  const Vector3d dir = _dir.Normalized();
+  bool hit = false;
+  for (std::size_t i = 0; i < _triangles.size(); ++i)
+  {
+    const Triangle3d &tri = _triangles[i];
+    const Vector3d normal = (tri[1] - tri[0]).Cross(tri[2] - tri[0]);
+    const double dist = normal.Dot(tri[0] - _origin) / normal.Dot(dir);
+    if (!(dist >= _min && dist <= _max))
+      continue;
+    const Vector3d pt = _origin + dir * dist;
+    bool inside = true;
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      const Vector3d edge = tri[(k + 1) % 3] - tri[k];
+      inside = inside && edge.Cross(pt - tri[k]).Dot(normal) >= 0;
+    }
+    if (inside && (!hit || dist < _distance))
+    {
+      hit = true;
+      _distance = dist;
+      _index = i;
+    }
+  }
+  return hit;
+}
+
+/////////////////////////////////////////////////
+TEST(Triangle3ArrayTest, Construction)
+{
+  Triangle3Arrayd empty;
+  EXPECT_TRUE(empty.Empty());
+  EXPECT_EQ(0u, empty.Size());
+  std::size_t index;
+  double distance;
+  EXPECT_FALSE(empty.RayClosestHit(Vector3d::Zero, Vector3d::UnitX, 0, 100,
+      index, distance));
+  EXPECT_FALSE(empty.RayAnyHit(Vector3d::Zero, Vector3d::UnitX, 0, 100));
+  std::vector<AxisAlignedBox> bounds;
+  empty.BlockBounds(bounds);
+  EXPECT_TRUE(bounds.empty());
+
+  const std::vector<Triangle3d> triangles = RandomTriangles(20);
+  Triangle3Arrayd array(triangles);
+  ASSERT_EQ(20u, array.Size());
+  for (std::size_t i = 0; i < triangles.size(); ++i)
+  {
+    for (unsigned int k = 0; k < 3; ++k)
+      EXPECT_EQ(triangles[i][k], array.Triangle(i)[k]);
+  }
+
+  // Three blocks, the last one partial
+  array.BlockBounds(bounds);
+  ASSERT_EQ(3u, bounds.size());
+  for (std::size_t i = 0; i < triangles.size(); ++i)
+  {
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      EXPECT_TRUE(bounds[i / Triangle3Arrayd::kBlockSize].Contains(
+          triangles[i][k]));
+    }
+  }
+
+  // Indexed mesh
+  const std::vector<Vector3d> vertices = {
+      {0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+  const std::vector<unsigned int> indices = {0, 1, 2, 0, 1, 3, 1, 2, 3};
+  Triangle3Arrayd mesh(vertices.data(), vertices.size(), indices.data(), 3);
+  ASSERT_EQ(3u, mesh.Size());
+  EXPECT_EQ(Vector3d(0, 0, 1), mesh.Triangle(1)[2]);
+  EXPECT_EQ(Vector3d(1, 0, 0), mesh.Triangle(2)[0]);
+  EXPECT_FALSE(mesh.Assign(vertices.data(), 3, indices.data(), 3));
+  EXPECT_TRUE(mesh.Empty());
+}
+
+/////////////////////////////////////////////////
+TEST(Triangle3ArrayTest, SingleTriangle)
+{
+  const std::vector<Triangle3f> triangles = {
+      Triangle3f(Vector3f(0, 0, 0), Vector3f(1, 0, 0), Vector3f(0, 1, 0))};
+  Triangle3Arrayf array(triangles);
+  std::size_t index = 1;
+  float distance = 0;
+
+  // From both sides, with a direction that is not normalized
+  EXPECT_TRUE(array.RayClosestHit(Vector3f(0.25f, 0.25f, 1),
+      Vector3f(0, 0, -2), 0, 10, index, distance));
+  EXPECT_EQ(0u, index);
+  EXPECT_FLOAT_EQ(1.0f, distance);
+  EXPECT_TRUE(array.RayClosestHit(Vector3f(0.25f, 0.25f, -2),
+      Vector3f(0, 0, 1), 0, 10, index, distance));
+  EXPECT_FLOAT_EQ(2.0f, distance);
+  EXPECT_TRUE(array.RayAnyHit(Vector3f(0.25f, 0.25f, -2),
+      Vector3f(0, 0, 1), 0, 10));
+
+  // Out of the distance range
+  EXPECT_FALSE(array.RayClosestHit(Vector3f(0.25f, 0.25f, 1),
+      Vector3f(0, 0, -1), 1.5f, 10, index, distance));
+  EXPECT_FALSE(array.RayClosestHit(Vector3f(0.25f, 0.25f, 1),
+      Vector3f(0, 0, -1), 0, 0.5f, index, distance));
+  EXPECT_FALSE(array.RayAnyHit(Vector3f(0.25f, 0.25f, 1),
+      Vector3f(0, 0, -1), 0, 0.5f));
+
+  // Beside the triangle, parallel to it, or without a direction
+  EXPECT_FALSE(array.RayClosestHit(Vector3f(0.75f, 0.75f, 1),
+      Vector3f(0, 0, -1), 0, 10, index, distance));
+  EXPECT_FALSE(array.RayClosestHit(Vector3f(-1, 0.25f, 0),
+      Vector3f(1, 0, 0), 0, 10, index, distance));
+  EXPECT_FALSE(array.RayClosestHit(Vector3f(0.25f, 0.25f, 1),
+      Vector3f::Zero, 0, 10, index, distance));
+
+  // A degenerate triangle is never hit
+  array = Triangle3Arrayf({Triangle3f(Vector3f(0, 0, 0), Vector3f(1, 0, 0),
+                                      Vector3f(2, 0, 0))});
+  EXPECT_FALSE(array.RayClosestHit(Vector3f(0.5f, 0, 1),
+      Vector3f(0, 0, -1), 0, 10, index, distance));
+  EXPECT_FALSE(array.RayAnyHit(Vector3f(0.5f, 0, 1), Vector3f(0, 0, -1), 0,
+      10));
+}
+
+/////////////////////////////////////////////////
+TEST(Triangle3ArrayTest, Rays)
+{
+  const std::vector<Triangle3d> triangles = RandomTriangles(1000);
+  const Triangle3Arrayd array(triangles);
+  std::vector<AxisAlignedBox> bounds;
+  array.BlockBounds(bounds);
+  const AxisAlignedBoxTree tree(bounds);
+
+  int hits = 0;
+  for (int i = 0; i < 300; ++i)
+  {
+    const Vector3d origin(Rand::DblUniform(-12, 12),
+        Rand::DblUniform(-12, 12), Rand::DblUniform(-12, 12));
+    const Vector3d dir(Rand::DblUniform(-1, 1), Rand::DblUniform(-1, 1),
+        Rand::DblUniform(-1, 1));
+    const double min = (i % 3 == 0) ? 0.5 : 0.0;
+    const double max = (i % 4 == 0) ? 5.0 : 50.0;
+
+    std::size_t expectedIndex = 0;
+    double expectedDistance = 0;
+    const bool expected = BruteClosestHit(triangles, origin, dir, min, max,
+        expectedIndex, expectedDistance);
+
+    std::size_t index = 0;
+    double distance = 0;
+    ASSERT_EQ(expected,
+        array.RayClosestHit(origin, dir, min, max, index, distance)) << i;
+    EXPECT_EQ(expected, array.RayAnyHit(origin, dir, min, max)) << i;
+    if (expected)
+    {
+      ++hits;
+      EXPECT_EQ(expectedIndex, index) << i;
+      EXPECT_NEAR(expectedDistance, distance, 1e-9) << i;
+    }
+
+    // Through the tree of blocks
+    std::size_t block = 0;
+    std::size_t treeIndex = 0;
+    double treeDistance = 0;
+    ASSERT_EQ(expected, tree.RayClosestHit(origin, dir, min, max,
+        [&](const std::size_t _block, const double _max, double &_distance)
+        {
+          return array.RayClosestHit(origin, dir, min, _max,
+              _block * Triangle3Arrayd::kBlockSize,
+              (_block + 1) * Triangle3Arrayd::kBlockSize, treeIndex,
+              _distance);
+        }, block, treeDistance)) << i;
+    if (expected)
+    {
+      EXPECT_EQ(index, treeIndex) << i;
+      EXPECT_EQ(index / Triangle3Arrayd::kBlockSize, block) << i;
+      EXPECT_DOUBLE_EQ(distance, treeDistance) << i;
+    }
+  }
+  // Make sure both outcomes are exercised
+  EXPECT_GT(hits, 0);
+  EXPECT_LT(hits, 300);
+}
@@ -476,3 +476,47 @@ TEST(Vector2Test, NaN)
   EXPECT_EQ(math::Vector2f::Zero, nanVecF);
   EXPECT_TRUE(nanVecF.IsFinite());
 }
+
+/////////////////////////////////////////////////
+constexpr math::Vector2d ConstexprVector2()
+{
+  math::Vector2d v(1, 2);
+  v += math::Vector2d(3, 4);
+  v *= 2.0;
+  v -= 1.0;
+  v.Max(math::Vector2d(8, 0));
+  return v;
+}
+
+/////////////////////////////////////////////////
+TEST(Vector2Test, Constexpr)
+{
+  constexpr math::Vector2d a(1, 2);
+  constexpr math::Vector2d b(3, -4);
+  constexpr double dot = a.Dot(b);
+  constexpr double squaredLength = a.SquaredLength();
+  constexpr double sum = a.Sum();
+  EXPECT_DOUBLE_EQ(-5, dot);
+  EXPECT_DOUBLE_EQ(5, squaredLength);
+  EXPECT_DOUBLE_EQ(3, sum);
+
+  constexpr math::Vector2d added = a + b;
+  constexpr math::Vector2d subtracted = a - b;
+  constexpr math::Vector2d multiplied = 2.0 * a * b;
+  constexpr math::Vector2d divided = b / 2.0;
+  constexpr math::Vector2d negated = -a;
+  EXPECT_EQ(math::Vector2d(4, -2), added);
+  EXPECT_EQ(math::Vector2d(-2, 6), subtracted);
+  EXPECT_EQ(math::Vector2d(6, -16), multiplied);
+  EXPECT_EQ(math::Vector2d(1.5, -2), divided);
+  EXPECT_EQ(math::Vector2d(-1, -2), negated);
+
+  constexpr double max = b.Max();
+  constexpr double min = b.Min();
+  EXPECT_DOUBLE_EQ(3, max);
+  EXPECT_DOUBLE_EQ(-4, min);
+  static_assert(a < b, "Less than");
+
+  constexpr math::Vector2d c = ConstexprVector2();
+  EXPECT_EQ(math::Vector2d(8, 11), c);
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <sstream>
+#include <vector>
+
+#include "gz/math/Vector3.hh"
+#include "gz/math/Vector3A.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+TEST(Vector3ATest, Layout)
+{
+  EXPECT_EQ(16u, sizeof(math::Vector3Af));
+  EXPECT_EQ(16u, alignof(math::Vector3Af));
+  EXPECT_EQ(32u, sizeof(math::Vector3Ad));
+  EXPECT_EQ(32u, alignof(math::Vector3Ad));
+
+  std::vector<math::Vector3Ad> vectors(7);
+  for (const auto &v : vectors)
+  {
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(v.Data()) % 32u);
+    EXPECT_DOUBLE_EQ(0.0, v.Data()[3]);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(Vector3ATest, Conversion)
+{
+  math::Vector3d v(1, -2, 3.5);
+  math::Vector3Ad a(v);
+  EXPECT_DOUBLE_EQ(1, a.X());
+  EXPECT_DOUBLE_EQ(-2, a.Y());
+  EXPECT_DOUBLE_EQ(3.5, a.Z());
+
+  math::Vector3d back = a;
+  EXPECT_EQ(v, back);
+  EXPECT_EQ(v, a.ToVector3());
+
+  // Implicit conversion in both directions
+  math::Vector3Ad sum = a + v;
+  EXPECT_EQ(v * 2.0, sum.ToVector3());
+  EXPECT_DOUBLE_EQ(v.Dot(v), math::Vector3d(a).Dot(v));
+
+  std::ostringstream stream;
+  stream << a;
+  EXPECT_EQ("1 -2 3.5", stream.str());
+
+  std::istringstream input("4 5 6");
+  input >> a;
+  EXPECT_EQ(math::Vector3Ad(4, 5, 6), a);
+  EXPECT_DOUBLE_EQ(0.0, a.Data()[3]);
+}
+
+/////////////////////////////////////////////////
+TEST(Vector3ATest, MatchesVector3)
+{
+  const std::vector<math::Vector3d> values = {
+    {1, 2, 3}, {-4, 5.5, 0}, {0, 0, 0}, {0.1, -0.2, 0.3}, {10, 0, -10}};
+
+  for (const auto &v1 : values)
+  {
+    for (const auto &v2 : values)
+    {
+      const math::Vector3Ad a1(v1);
+      const math::Vector3Ad a2(v2);
+      EXPECT_EQ(v1 + v2, (a1 + a2).ToVector3());
+      EXPECT_EQ(v1 - v2, (a1 - a2).ToVector3());
+      EXPECT_EQ(v1 * v2, (a1 * a2).ToVector3());
+      EXPECT_EQ(v1 * 2.5, (a1 * 2.5).ToVector3());
+      EXPECT_EQ(2.5 * v1, (2.5 * a1).ToVector3());
+      EXPECT_EQ(v1 / 4.0, (a1 / 4.0).ToVector3());
+      EXPECT_EQ(-v1, (-a1).ToVector3());
+      EXPECT_DOUBLE_EQ(v1.Dot(v2), a1.Dot(a2));
+      EXPECT_EQ(v1.Cross(v2), a1.Cross(a2).ToVector3());
+      EXPECT_DOUBLE_EQ(v1.Length(), a1.Length());
+      EXPECT_DOUBLE_EQ(v1.SquaredLength(), a1.SquaredLength());
+      EXPECT_DOUBLE_EQ(v1.Distance(v2), a1.Distance(a2));
+      EXPECT_DOUBLE_EQ(v1.Sum(), a1.Sum());
+      EXPECT_EQ(v1.Normalized(), a1.Normalized().ToVector3());
+      EXPECT_EQ(v1.Abs(), a1.Abs().ToVector3());
+      EXPECT_DOUBLE_EQ(v1.Max(), a1.Max());
+      EXPECT_DOUBLE_EQ(v1.Min(), a1.Min());
+      EXPECT_EQ(v1 == v2, a1 == a2);
+      EXPECT_EQ(v1 != v2, a1 != a2);
+
+      math::Vector3d vMax(v1);
+      math::Vector3Ad aMax(a1);
+      vMax.Max(v2);
+      aMax.Max(a2);
+      EXPECT_EQ(vMax, aMax.ToVector3());
+
+      math::Vector3d vMin(v1);
+      math::Vector3Ad aMin(a1);
+      vMin.Min(v2);
+      aMin.Min(a2);
+      EXPECT_EQ(vMin, aMin.ToVector3());
+
+      // The padding element stays zero
+      EXPECT_DOUBLE_EQ(0.0, (a1 * a2 + a1 - a2 * 3.0).Data()[3]);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(Vector3ATest, Accessors)
+{
+  math::Vector3Af a;
+  EXPECT_EQ(math::Vector3Af(0, 0, 0), a);
+
+  a.Set(1, 2, 3);
+  a.X(4);
+  a.Y() += 1;
+  a[2] = 7;
+  EXPECT_FLOAT_EQ(4, a[0]);
+  EXPECT_FLOAT_EQ(3, a[1]);
+  EXPECT_FLOAT_EQ(7, a.Z());
+  EXPECT_FLOAT_EQ(7, a[5]);
+  EXPECT_TRUE(a.IsFinite());
+
+  a /= 2.0f;
+  EXPECT_EQ(math::Vector3Af(2, 1.5, 3.5), a);
+
+  constexpr math::Vector3Ad c =
+    math::Vector3Ad(1, 2, 3).Cross(math::Vector3Ad(4, 5, 6));
+  EXPECT_EQ(math::Vector3Ad(-3, 6, -3), c);
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "gz/math/Vector3.hh"
+#include "gz/math/Vector3Array.hh"
+
+using namespace gz;
+
+/////////////////////////////////////////////////
+std::vector<math::Vector3d> TestVectors()
+{
+  return {
+    {1, 2, 3}, {-4, 5.5, 0}, {0, 0, 0}, {0.1, -0.2, 0.3}, {10, 0, -10},
+    {7, 8, 9}, {-1, -1, -1}, {3, 4, 0}, {0, 0, 1e-9}};
+}
+
+/////////////////////////////////////////////////
+TEST(Vector3ArrayTest, Construction)
+{
+  math::Vector3Arrayd empty;
+  EXPECT_TRUE(empty.Empty());
+  EXPECT_EQ(0u, empty.Size());
+
+  math::Vector3Arrayd zeros(4);
+  EXPECT_EQ(4u, zeros.Size());
+  for (std::size_t i = 0; i < zeros.Size(); ++i)
+    EXPECT_EQ(math::Vector3d::Zero, zeros[i]);
+
+  const auto vectors = TestVectors();
+  math::Vector3Arrayd array(vectors);
+  ASSERT_EQ(vectors.size(), array.Size());
+  for (std::size_t i = 0; i < vectors.size(); ++i)
+  {
+    EXPECT_EQ(vectors[i], array[i]);
+    EXPECT_DOUBLE_EQ(vectors[i].X(), array.X()[i]);
+    EXPECT_DOUBLE_EQ(vectors[i].Y(), array.Y()[i]);
+    EXPECT_DOUBLE_EQ(vectors[i].Z(), array.Z()[i]);
+  }
+
+  EXPECT_EQ(vectors, array.ToVector());
+
+  math::Vector3Arrayd copy(array);
+  EXPECT_EQ(array, copy);
+  copy.Set(0, math::Vector3d(9, 9, 9));
+  EXPECT_NE(array, copy);
+  EXPECT_EQ(math::Vector3d(9, 9, 9), copy[0]);
+
+  copy.PushBack(math::Vector3d(1, 1, 1));
+  EXPECT_EQ(vectors.size() + 1, copy.Size());
+  EXPECT_EQ(math::Vector3d::One, copy[vectors.size()]);
+
+  copy.Clear();
+  EXPECT_TRUE(copy.Empty());
+
+  std::vector<math::Vector3d> out(3);
+  array.CopyTo(out);
+  EXPECT_EQ(vectors, out);
+}
+
+/////////////////////////////////////////////////
+TEST(Vector3ArrayTest, AddSubtractScale)
+{
+  const auto vectors = TestVectors();
+  math::Vector3Arrayd a(vectors);
+  math::Vector3Arrayd b(vectors);
+
+  EXPECT_TRUE(a.Add(b));
+  for (std::size_t i = 0; i < vectors.size(); ++i)
+    EXPECT_EQ(vectors[i] + vectors[i], a[i]);
+
+  EXPECT_TRUE(a.Subtract(b));
+  EXPECT_EQ(b, a);
+
+  a.Add(math::Vector3d(1, -2, 3));
+  for (std::size_t i = 0; i < vectors.size(); ++i)
+    EXPECT_EQ(vectors[i] + math::Vector3d(1, -2, 3), a[i]);
+
+  b.Scale(-2.5);
+  for (std::size_t i = 0; i < vectors.size(); ++i)
+    EXPECT_EQ(vectors[i] * -2.5, b[i]);
+
+  math::Vector3Arrayd c(vectors);
+  EXPECT_TRUE(c.MultiplyAdd(b, 0.125));
+  for (std::size_t i = 0; i < vectors.size(); ++i)
+  {
+    EXPECT_EQ(math::Vector3d::MultiplyAdd(b[i], 0.125, vectors[i]), c[i]);
+    EXPECT_EQ(vectors[i] + b[i] * 0.125, c[i]);
+  }
+
+  math::Vector3Arrayd shorter(2);
+  EXPECT_FALSE(a.Add(shorter));
+  EXPECT_FALSE(a.Subtract(shorter));
+  EXPECT_FALSE(a.MultiplyAdd(shorter, 1.0));
+}
+
+/////////////////////////////////////////////////
+TEST(Vector3ArrayTest, DotCross)
+{
+  const auto vectors = TestVectors();
+  std::vector<math::Vector3d> others;
+  for (const auto &v : vectors)
+    others.push_back(v.Perpendicular() + math::Vector3d(0.5, 0.25, -1));
+
+  math::Vector3Arrayd a(vectors);
+  math::Vector3Arrayd b(others);
+
+  std::vector<double> dot;
+  EXPECT_TRUE(a.Dot(b, dot));
+  ASSERT_EQ(vectors.size(), dot.size());
+  for (std::size_t i = 0; i < vectors.size(); ++i)
+    EXPECT_DOUBLE_EQ(vectors[i].Dot(others[i]), dot[i]);
+
+  math::Vector3Arrayd cross;
+  EXPECT_TRUE(a.Cross(b, cross));
+  ASSERT_EQ(vectors.size(), cross.Size());
+  for (std::size_t i = 0; i < vectors.size(); ++i)
+    EXPECT_EQ(vectors[i].Cross(others[i]), cross[i]);
+
+  // Aliased output is rejected
+  EXPECT_FALSE(a.Cross(b, a));
+  EXPECT_FALSE(a.Cross(b, b));
+
+  math::Vector3Arrayd shorter(2);
+  EXPECT_FALSE(a.Dot(shorter, dot));
+  EXPECT_FALSE(a.Cross(shorter, cross));
+}
+
+/////////////////////////////////////////////////
+TEST(Vector3ArrayTest, LengthNormalizeDistance)
+{
+  const auto vectors = TestVectors();
+  math::Vector3Arrayd a(vectors);
+
+  std::vector<double> length;
+  a.Length(length);
+  std::vector<double> squared;
+  a.SquaredLength(squared);
+  ASSERT_EQ(vectors.size(), length.size());
+  ASSERT_EQ(vectors.size(), squared.size());
+  for (std::size_t i = 0; i < vectors.size(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(vectors[i].Length(), length[i]);
+    EXPECT_DOUBLE_EQ(vectors[i].SquaredLength(), squared[i]);
+  }
+
+  std::vector<double> distance;
+  a.Distance(math::Vector3d(1, 1, 1), distance);
+  ASSERT_EQ(vectors.size(), distance.size());
+  for (std::size_t i = 0; i < vectors.size(); ++i)
+    EXPECT_DOUBLE_EQ(vectors[i].Distance(math::Vector3d(1, 1, 1)),
+        distance[i]);
+
+  math::Vector3Arrayd b(a);
+  b.Scale(0.5);
+  EXPECT_TRUE(a.Distance(b, distance));
+  for (std::size_t i = 0; i < vectors.size(); ++i)
+    EXPECT_DOUBLE_EQ(vectors[i].Distance(vectors[i] * 0.5), distance[i]);
+  EXPECT_FALSE(a.Distance(math::Vector3Arrayd(1), distance));
+
+  a.Normalize();
+  for (std::size_t i = 0; i < vectors.size(); ++i)
+  {
+    EXPECT_TRUE(vectors[i].Normalized().Equal(a[i], 1e-12))
+      << i << ": " << vectors[i].Normalized() << " vs " << a[i];
+  }
+
+  math::Vector3Arrayd fast(vectors);
+  fast.NormalizeFast();
+  for (std::size_t i = 0; i < vectors.size(); ++i)
+  {
+    math::Vector3d expected = vectors[i];
+    EXPECT_EQ(expected.NormalizeFast(), fast[i]) << i;
+    EXPECT_TRUE(vectors[i].Normalized().Equal(fast[i], 1e-10)) << i;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(Vector3ArrayTest, Float)
+{
+  std::vector<math::Vector3f> vectors;
+  for (int i = 0; i < 37; ++i)
+    vectors.emplace_back(i * 0.5f, -i * 0.25f, 1.0f);
+
+  math::Vector3Arrayf a(vectors);
+  std::vector<float> length;
+  a.Length(length);
+  ASSERT_EQ(vectors.size(), length.size());
+  for (std::size_t i = 0; i < vectors.size(); ++i)
+    EXPECT_FLOAT_EQ(vectors[i].Length(), length[i]);
+}
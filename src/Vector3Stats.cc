@@ -14,11 +14,45 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <gz/math/Vector3Stats.hh>
 
 using namespace gz;
 using namespace math;
 
+namespace
+{
+/// \brief Split a Vector3Stats snapshot into the snapshots of the x, y, z
+/// and magnitude statistics, each one preceded by its size.
+/// \param[in] _data Pointer to the snapshot.
+/// \param[in] _size Number of bytes of the snapshot.
+/// \param[out] _parts Pointers to the snapshots of the statistics.
+/// \param[out] _sizes Number of bytes of the snapshots of the statistics.
+/// \return False if the snapshot is malformed.
+bool SplitSnapshot(const uint8_t *_data, size_t _size,
+    const uint8_t *_parts[4], size_t _sizes[4])
+{
+  for (int i = 0; i < 4; ++i)
+  {
+    uint64_t size = 0;
+    if (_size < sizeof(size))
+      return false;
+    std::memcpy(&size, _data, sizeof(size));
+    _data += sizeof(size);
+    _size -= sizeof(size);
+    if (_size < size)
+      return false;
+    _parts[i] = _data;
+    _sizes[i] = static_cast<size_t>(size);
+    _data += size;
+    _size -= static_cast<size_t>(size);
+  }
+  return _size == 0;
+}
+}
+
 /// \brief Private data class for the Vector3Stats class.
 class Vector3Stats::Implementation
 {
@@ -50,6 +84,36 @@ void Vector3Stats::InsertData(const Vector3d &_data)
   this->dataPtr->mag.InsertData(_data.Length());
 }
 
+//////////////////////////////////////////////////
+void Vector3Stats::InsertData(const Vector3d *_data, const size_t _count)
+{
+  // Number of samples split into components at once.
+  constexpr size_t kChunkSize = 256;
+  double x[kChunkSize];
+  double y[kChunkSize];
+  double z[kChunkSize];
+  double mag[kChunkSize];
+
+  for (size_t start = 0; start < _count; start += kChunkSize)
+  {
+    const size_t n = std::min(kChunkSize, _count - start);
+    const Vector3d *chunk = _data + start;
+    for (size_t i = 0; i < n; ++i)
+    {
+      x[i] = chunk[i].X();
+      y[i] = chunk[i].Y();
+      z[i] = chunk[i].Z();
+    }
+    for (size_t i = 0; i < n; ++i)
+      mag[i] = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+
+    this->dataPtr->x.InsertData(x, n);
+    this->dataPtr->y.InsertData(y, n);
+    this->dataPtr->z.InsertData(z, n);
+    this->dataPtr->mag.InsertData(mag, n);
+  }
+}
+
 //////////////////////////////////////////////////
 bool Vector3Stats::InsertStatistic(const std::string &_name)
 {
@@ -79,6 +143,57 @@ void Vector3Stats::Reset()
   this->dataPtr->mag.Reset();
 }
 
+//////////////////////////////////////////////////
+size_t Vector3Stats::Snapshot(std::vector<uint8_t> &_buffer) const
+{
+  const size_t start = _buffer.size();
+  for (const SignalStats *stats : {&this->dataPtr->x, &this->dataPtr->y,
+                                   &this->dataPtr->z, &this->dataPtr->mag})
+  {
+    const size_t sizeOffset = _buffer.size();
+    _buffer.resize(sizeOffset + sizeof(uint64_t));
+    const uint64_t size = stats->Snapshot(_buffer);
+    std::memcpy(_buffer.data() + sizeOffset, &size, sizeof(size));
+  }
+  return _buffer.size() - start;
+}
+
+//////////////////////////////////////////////////
+bool Vector3Stats::MergeSnapshot(const uint8_t *_data, const size_t _size)
+{
+  const uint8_t *parts[4];
+  size_t sizes[4];
+  if (!SplitSnapshot(_data, _size, parts, sizes))
+    return false;
+
+  bool x = this->dataPtr->x.MergeSnapshot(parts[0], sizes[0]);
+  bool y = this->dataPtr->y.MergeSnapshot(parts[1], sizes[1]);
+  bool z = this->dataPtr->z.MergeSnapshot(parts[2], sizes[2]);
+  bool mag = this->dataPtr->mag.MergeSnapshot(parts[3], sizes[3]);
+  return x && y && z && mag;
+}
+
+//////////////////////////////////////////////////
+bool Vector3Stats::RestoreSnapshot(const uint8_t *_data, const size_t _size)
+{
+  const uint8_t *parts[4];
+  size_t sizes[4];
+  if (!SplitSnapshot(_data, _size, parts, sizes))
+    return false;
+
+  SignalStats restored[4];
+  for (int i = 0; i < 4; ++i)
+  {
+    if (!restored[i].RestoreSnapshot(parts[i], sizes[i]))
+      return false;
+  }
+  this->dataPtr->x = restored[0];
+  this->dataPtr->y = restored[1];
+  this->dataPtr->z = restored[2];
+  this->dataPtr->mag = restored[3];
+  return true;
+}
+
 //////////////////////////////////////////////////
 const SignalStats &Vector3Stats::X() const
 {
@@ -17,6 +17,10 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <string>
+#include <vector>
+
 #include <gz/math/Vector3Stats.hh>
 
 using namespace gz;
@@ -187,3 +191,71 @@ TEST_F(Vector3StatsTest, Vector3Stats)
     EXPECT_NEAR(this->Mag(name), 1.0, 1e-10);
   }
 }
+
+//////////////////////////////////////////////////
+TEST_F(Vector3StatsTest, InsertBlock)
+{
+  std::vector<math::Vector3d> data;
+  for (int i = 0; i < 700; ++i)
+    data.emplace_back(0.01 * i, -0.02 * i + 3, std::sin(0.1 * i));
+
+  math::Vector3Stats single;
+  EXPECT_TRUE(single.InsertStatistics("maxAbs,mean,rms"));
+  EXPECT_TRUE(this->stats.InsertStatistics("maxAbs,mean,rms"));
+  for (const auto &value : data)
+    single.InsertData(value);
+  this->stats.InsertData(data.data(), 1);
+  this->stats.InsertData(data.data() + 1, data.size() - 1);
+
+  EXPECT_EQ(this->stats.X().Count(), data.size());
+  EXPECT_EQ(this->stats.Mag().Count(), data.size());
+  for (const std::string name : {"maxAbs", "mean", "rms"})
+  {
+    EXPECT_NEAR(this->X(name), single.X().Map()[name], 1e-12) << name;
+    EXPECT_NEAR(this->Y(name), single.Y().Map()[name], 1e-12) << name;
+    EXPECT_NEAR(this->Z(name), single.Z().Map()[name], 1e-12) << name;
+    EXPECT_NEAR(this->Mag(name), single.Mag().Map()[name], 1e-12) << name;
+  }
+}
+
+//////////////////////////////////////////////////
+TEST_F(Vector3StatsTest, Snapshot)
+{
+  std::vector<math::Vector3d> data;
+  for (int i = 0; i < 500; ++i)
+    data.emplace_back(0.01 * i, -0.02 * i + 3, std::sin(0.1 * i));
+
+  math::Vector3Stats first;
+  math::Vector3Stats second;
+  EXPECT_TRUE(this->stats.InsertStatistics("maxAbs,mean,rms"));
+  EXPECT_TRUE(first.InsertStatistics("maxAbs,mean,rms"));
+  EXPECT_TRUE(second.InsertStatistics("maxAbs,mean,rms"));
+  this->stats.InsertData(data.data(), data.size());
+  first.InsertData(data.data(), 200);
+  second.InsertData(data.data() + 200, data.size() - 200);
+
+  std::vector<uint8_t> buffer;
+  const size_t size = second.Snapshot(buffer);
+  EXPECT_EQ(size, buffer.size());
+  EXPECT_TRUE(first.MergeSnapshot(buffer.data(), buffer.size()));
+  EXPECT_FALSE(first.MergeSnapshot(buffer.data(), buffer.size() - 1));
+
+  buffer.clear();
+  first.Snapshot(buffer);
+  math::Vector3Stats restored;
+  EXPECT_TRUE(restored.RestoreSnapshot(buffer.data(), buffer.size()));
+  EXPECT_FALSE(restored.RestoreSnapshot(buffer.data() + 8,
+      buffer.size() - 8));
+
+  for (const auto *merged : {&first, &restored})
+  {
+    EXPECT_EQ(data.size(), merged->Mag().Count());
+    for (const std::string name : {"maxAbs", "mean", "rms"})
+    {
+      EXPECT_NEAR(this->X(name), merged->X().Map().at(name), 1e-12);
+      EXPECT_NEAR(this->Y(name), merged->Y().Map().at(name), 1e-12);
+      EXPECT_NEAR(this->Z(name), merged->Z().Map().at(name), 1e-12);
+      EXPECT_NEAR(this->Mag(name), merged->Mag().Map().at(name), 1e-12);
+    }
+  }
+}
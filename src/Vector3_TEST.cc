@@ -240,6 +240,29 @@ TEST(Vector3dTest, Normalize)
   EXPECT_EQ(vecConst, math::Vector3d(1, 2, 3));
 }
 
+/////////////////////////////////////////////////
+TEST(Vector3dTest, NormalizeFast)
+{
+  math::Vector3d zero(0, 0, 0);
+  EXPECT_EQ(math::Vector3d::Zero, zero.NormalizeFast());
+  math::Vector3d tiny(0, 1e-7, 0);
+  EXPECT_EQ(math::Vector3d(0, 1e-7, 0), tiny.NormalizeFast());
+
+  for (const math::Vector3d &v : {math::Vector3d(1, 2, 3),
+       math::Vector3d(-1e-5, 4e-5, 2e-6), math::Vector3d(1e100, 0, -3e100)})
+  {
+    math::Vector3d fast = v;
+    EXPECT_EQ(fast, fast.NormalizeFast());
+    EXPECT_TRUE(v.Normalized().Equal(fast, 1e-10)) << v;
+    EXPECT_NEAR(1.0, fast.Length(), 4e-11);
+  }
+
+  math::Vector3f f(3, -4, 12);
+  f.NormalizeFast();
+  EXPECT_NEAR(1.0f, f.Length(), 1e-5f);
+  EXPECT_TRUE(math::Vector3f(3, -4, 12).Normalized().Equal(f, 1e-5f));
+}
+
 /////////////////////////////////////////////////
 TEST(Vector3dTest, GetNormal)
 {
@@ -456,6 +479,27 @@ TEST(Vector3dTest, Multiply)
   EXPECT_EQ(v*v, math::Vector3d(0.01, 0.04, 0.09));
 }
 
+/////////////////////////////////////////////////
+TEST(Vector3dTest, MultiplyAdd)
+{
+  const math::Vector3d a(0.1, -0.2, 0.3);
+  const math::Vector3d b(4, 5, -6);
+  const math::Vector3d c(-7, 8.5, 9);
+
+  EXPECT_EQ(a * 2.5 + b, math::Vector3d::MultiplyAdd(a, 2.5, b));
+  EXPECT_EQ(a * b + c, math::Vector3d::MultiplyAdd(a, b, c));
+  EXPECT_EQ(a.Cross(b) + c, math::Vector3d::CrossAdd(a, b, c));
+  EXPECT_EQ(b, math::Vector3d::MultiplyAdd(a, 0.0, b));
+  EXPECT_EQ(c, math::Vector3d::CrossAdd(a, a, c));
+
+  constexpr math::Vector3d x(1, 2, 3);
+  constexpr math::Vector3d y(4, 5, 6);
+  constexpr math::Vector3d scaled = math::Vector3d::MultiplyAdd(x, 2.0, y);
+  EXPECT_EQ(math::Vector3d(6, 9, 12), scaled);
+  constexpr math::Vector3d crossed = math::Vector3d::CrossAdd(x, y, y);
+  EXPECT_EQ(math::Vector3d(1, 11, 3), crossed);
+}
+
 /////////////////////////////////////////////////
 TEST(Vector3dTest, NotEqual)
 {
@@ -576,3 +620,74 @@ TEST(Vector3dTest, OperatorStreamOut)
   stream << std::setprecision(1) << std::fixed << v;
   EXPECT_EQ(stream.str(), "0.1 1.2 2.3");
 }
+
+/////////////////////////////////////////////////
+TEST(Vector3dTest, AppendToString)
+{
+  std::string out = "v: ";
+  appendToString(out, math::Vector3d(0.1234, -0.0, 1e20));
+  EXPECT_EQ("v: 0.1234 0 1e+20", out);
+
+  out.clear();
+  appendToString(out, math::Vector3d(0.1234, 1.234, 2.3456), 2);
+  EXPECT_EQ("0.12 1.23 2.35", out);
+
+  // The shortest representation reads back as the same value
+  out.clear();
+  const math::Vector3d third(1.0 / 3, 2.0 / 3, -1.0 / 7);
+  appendToString(out, third);
+  std::istringstream stream(out);
+  math::Vector3d read;
+  stream >> read;
+  EXPECT_EQ(third.X(), read.X());
+  EXPECT_EQ(third.Y(), read.Y());
+  EXPECT_EQ(third.Z(), read.Z());
+
+  out.clear();
+  appendToString(out, math::Vector3f(0.1f, 2.5f, -3));
+  appendToString(out, math::Vector3i(1, -2, 3));
+  EXPECT_EQ("0.1 2.5 -31 -2 3", out);
+}
+
+/////////////////////////////////////////////////
+constexpr math::Vector3d ConstexprVector3()
+{
+  math::Vector3d v(1, 2, 3);
+  v += math::Vector3d(1, 1, 1);
+  v *= 2.0;
+  v /= math::Vector3d(2, 4, 8);
+  v.Set(v.X(), v.Y(), v.Z() + 1);
+  return v;
+}
+
+/////////////////////////////////////////////////
+TEST(Vector3dTest, Constexpr)
+{
+  constexpr math::Vector3d a(1, 2, 3);
+  constexpr math::Vector3d b(4, 5, 6);
+  constexpr double dot = a.Dot(b);
+  constexpr double squaredLength = a.SquaredLength();
+  constexpr double total = a.Sum();
+  EXPECT_DOUBLE_EQ(32, dot);
+  EXPECT_DOUBLE_EQ(14, squaredLength);
+  EXPECT_DOUBLE_EQ(6, total);
+
+  constexpr math::Vector3d cross = a.Cross(b);
+  EXPECT_EQ(math::Vector3d(-3, 6, -3), cross);
+
+  constexpr math::Vector3d sum = a + b * 2.0 - 1.0;
+  constexpr math::Vector3d divided = b / 2.0;
+  constexpr math::Vector3d negated = -a;
+  EXPECT_EQ(math::Vector3d(8, 11, 14), sum);
+  EXPECT_EQ(math::Vector3d(2, 2.5, 3), divided);
+  EXPECT_EQ(math::Vector3d(-1, -2, -3), negated);
+
+  constexpr double max = b.Max();
+  constexpr double min = b.Min();
+  EXPECT_DOUBLE_EQ(6, max);
+  EXPECT_DOUBLE_EQ(4, min);
+  static_assert(a < b, "Less than");
+
+  constexpr math::Vector3d c = ConstexprVector3();
+  EXPECT_EQ(math::Vector3d(2, 1.5, 2), c);
+}
@@ -480,3 +480,42 @@ TEST(Vector4Test, NaN)
   EXPECT_EQ(math::Vector4f::Zero, nanVecF);
   EXPECT_TRUE(nanVecF.IsFinite());
 }
+
+/////////////////////////////////////////////////
+constexpr math::Vector4d ConstexprVector4()
+{
+  math::Vector4d v(1, 2, 3, 4);
+  v -= math::Vector4d(1, 1, 1, 1);
+  v *= math::Vector4d(2, 2, 2, 2);
+  v.W(-v.W());
+  return v;
+}
+
+/////////////////////////////////////////////////
+TEST(Vector4dTest, Constexpr)
+{
+  constexpr math::Vector4d a(1, 2, 3, 4);
+  constexpr math::Vector4d b(5, 6, 7, 8);
+  constexpr double dot = a.Dot(b);
+  constexpr double squaredLength = a.SquaredLength();
+  constexpr double total = a.Sum();
+  EXPECT_DOUBLE_EQ(70, dot);
+  EXPECT_DOUBLE_EQ(30, squaredLength);
+  EXPECT_DOUBLE_EQ(10, total);
+
+  constexpr math::Vector4d sum = a + b * 2.0 - 1.0;
+  constexpr math::Vector4d divided = b / 2.0;
+  constexpr math::Vector4d negated = -a;
+  EXPECT_EQ(math::Vector4d(10, 13, 16, 19), sum);
+  EXPECT_EQ(math::Vector4d(2.5, 3, 3.5, 4), divided);
+  EXPECT_EQ(math::Vector4d(-1, -2, -3, -4), negated);
+
+  constexpr double max = b.Max();
+  constexpr double min = b.Min();
+  EXPECT_DOUBLE_EQ(8, max);
+  EXPECT_DOUBLE_EQ(5, min);
+  static_assert(a < b, "Less than");
+
+  constexpr math::Vector4d c = ConstexprVector4();
+  EXPECT_EQ(math::Vector4d(0, 2, 4, -6), c);
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "gz/math/VectorHash.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(VectorHashTest, StdHash)
+{
+  std::unordered_set<Vector3i> set;
+  for (int x = -10; x < 10; ++x)
+    for (int y = -10; y < 10; ++y)
+      for (int z = -10; z < 10; ++z)
+        set.insert(Vector3i(x, y, z));
+  EXPECT_EQ(8000u, set.size());
+  EXPECT_EQ(1u, set.count(Vector3i(-10, 9, 0)));
+  EXPECT_EQ(0u, set.count(Vector3i(10, 0, 0)));
+
+  // The cells of a grid spread over the buckets
+  std::size_t longest = 0;
+  for (std::size_t b = 0; b < set.bucket_count(); ++b)
+    longest = std::max(longest, set.bucket_size(b));
+  EXPECT_LE(longest, 8u);
+
+  // The order of the components matters
+  std::hash<Vector3i> hash3;
+  EXPECT_NE(hash3(Vector3i(1, 2, 3)), hash3(Vector3i(3, 2, 1)));
+  EXPECT_NE(hash3(Vector3i(0, 0, 1)), hash3(Vector3i(0, 1, 0)));
+
+  std::unordered_map<Vector2i, int> map2;
+  map2[Vector2i(1, 2)] = 3;
+  map2[Vector2i(2, 1)] = 4;
+  EXPECT_EQ(2u, map2.size());
+  EXPECT_EQ(3, map2[Vector2i(1, 2)]);
+
+  std::unordered_set<Vector4i> set4;
+  set4.insert(Vector4i(1, 2, 3, 4));
+  set4.insert(Vector4i(1, 2, 3, 4));
+  set4.insert(Vector4i(4, 3, 2, 1));
+  EXPECT_EQ(2u, set4.size());
+}
+
+/////////////////////////////////////////////////
+TEST(VectorHashTest, Exact)
+{
+  VectorHash<Vector3d> hash;
+  VectorEqual<Vector3d> equal;
+
+  EXPECT_EQ(hash(Vector3d(1, 2, 3)), hash(Vector3d(1, 2, 3)));
+  EXPECT_NE(hash(Vector3d(1, 2, 3)), hash(Vector3d(1, 2, 3.0001)));
+  EXPECT_TRUE(equal(Vector3d(1, 2, 3), Vector3d(1, 2, 3)));
+  // Unlike operator==, there is no tolerance
+  EXPECT_TRUE(Vector3d(1, 2, 3) == Vector3d(1, 2, 3.0001));
+  EXPECT_FALSE(equal(Vector3d(1, 2, 3), Vector3d(1, 2, 3.0001)));
+
+  // -0 and 0, and all the NaNs, are the same
+  EXPECT_EQ(hash(Vector3d(0, 0, 0)), hash(Vector3d(-0.0, 0, -0.0)));
+  EXPECT_TRUE(equal(Vector3d(0, 0, 0), Vector3d(-0.0, 0, -0.0)));
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_EQ(hash(Vector3d(nan, 1, 2)), hash(Vector3d(-nan, 1, 2)));
+  EXPECT_TRUE(equal(Vector3d(nan, 1, 2), Vector3d(-nan, 1, 2)));
+
+  std::unordered_map<Vector3d, int, VectorHash<Vector3d>,
+                     VectorEqual<Vector3d>> map;
+  map[Vector3d(0.1, 0.2, 0.3)] = 1;
+  map[Vector3d(0.1, 0.2, 0.3 + 1e-9)] = 2;
+  map[Vector3d::NaN] = 3;
+  EXPECT_EQ(3u, map.size());
+  EXPECT_EQ(1, map[Vector3d(0.1, 0.2, 0.3)]);
+  EXPECT_EQ(3, map[Vector3d::NaN]);
+
+  // float and double vectors of the same values have the same hash
+  EXPECT_EQ(VectorHash<Vector2f>()(Vector2f(0.5f, -2)),
+            VectorHash<Vector2d>()(Vector2d(0.5, -2)));
+  EXPECT_NE(VectorHash<Vector4d>()(Vector4d(1, 2, 3, 4)),
+            VectorHash<Vector4d>()(Vector4d(4, 3, 2, 1)));
+  EXPECT_TRUE(VectorEqual<Vector4f>()(Vector4f(1, 2, 3, 4),
+                                      Vector4f(1, 2, 3, 4)));
+  EXPECT_FALSE(VectorEqual<Vector4f>()(Vector4f(1, 2, 3, 4),
+                                       Vector4f(1, 2, 3, 5)));
+}
+
+/////////////////////////////////////////////////
+TEST(VectorHashTest, Cell)
+{
+  VectorCellHash<Vector3d> hash(0.5);
+  VectorCellEqual<Vector3d> equal(0.5);
+  EXPECT_DOUBLE_EQ(0.5, hash.CellSize());
+  EXPECT_DOUBLE_EQ(0.5, equal.CellSize());
+
+  EXPECT_TRUE(equal(Vector3d(0.1, 0.2, 0.3), Vector3d(0.4, 0.0, 0.49)));
+  EXPECT_EQ(hash(Vector3d(0.1, 0.2, 0.3)), hash(Vector3d(0.4, 0.0, 0.49)));
+  EXPECT_FALSE(equal(Vector3d(0.1, 0.2, 0.3), Vector3d(0.1, 0.2, 0.5)));
+
+  // Cells are floor(x / size), so -0.1 isn't in the cell of 0.1
+  EXPECT_FALSE(equal(Vector3d(0.1, 0, 0), Vector3d(-0.1, 0, 0)));
+  EXPECT_TRUE(equal(Vector3d(-0.1, 0, 0), Vector3d(-0.4, 0, 0)));
+
+  // Huge values and NaN are clamped to a cell
+  const double inf = std::numeric_limits<double>::infinity();
+  EXPECT_TRUE(equal(Vector3d(inf, 0, 0), Vector3d(1e300, 0, 0)));
+  EXPECT_TRUE(equal(Vector3d(-inf, 0, 0), Vector3d(-1e300, 0, 0)));
+  EXPECT_TRUE(equal(Vector3d::NaN, Vector3d(0.1, 0.2, 0.3)));
+
+  std::unordered_map<Vector3d, int, VectorCellHash<Vector3d>,
+                     VectorCellEqual<Vector3d>> map(16,
+      VectorCellHash<Vector3d>(0.5), VectorCellEqual<Vector3d>(0.5));
+  for (int i = 0; i < 100; ++i)
+    map[Vector3d(i * 0.01, 1.2, -3.4)] += 1;
+  EXPECT_EQ(2u, map.size());
+  EXPECT_EQ(50, map[Vector3d(0.25, 1.0, -3.1)]);
+  EXPECT_EQ(50, map[Vector3d(0.75, 1.4, -3.3)]);
+
+  VectorCellHash<Vector2f> hash2(2);
+  VectorCellEqual<Vector2f> equal2(2);
+  EXPECT_EQ(hash2(Vector2f(1, 3)), hash2(Vector2f(0.5f, 2.5f)));
+  EXPECT_TRUE(equal2(Vector2f(1, 3), Vector2f(0.5f, 2.5f)));
+  EXPECT_FALSE(equal2(Vector2f(1, 3), Vector2f(2, 3)));
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#include <gz/math/detail/VectorN.hh>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+
+#include "gz/math/Vector2.hh"
+#include "gz/math/Vector3.hh"
+#include "gz/math/Vector4.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(VectorNTest, Reductions)
+{
+  using Kernels = detail::VectorN<double, 3>;
+  const double a[3] = {1.5, -2.0, 4.0};
+  const double b[3] = {-0.5, 3.0, 0.25};
+
+  EXPECT_DOUBLE_EQ(3.5, Kernels::Sum(a));
+  EXPECT_DOUBLE_EQ(-0.75 - 6.0 + 1.0, Kernels::Dot(a, b));
+  EXPECT_DOUBLE_EQ(0.75 + 6.0 + 1.0, Kernels::AbsDot(a, b));
+  EXPECT_DOUBLE_EQ(4.0 + 25.0 + 14.0625, Kernels::SquaredDistance(a, b));
+  EXPECT_DOUBLE_EQ(4.0, Kernels::MaxElement(a));
+  EXPECT_DOUBLE_EQ(-2.0, Kernels::MinElement(a));
+  EXPECT_DOUBLE_EQ(4.0, Kernels::MaxAbs(a));
+  EXPECT_DOUBLE_EQ(1.5, Kernels::MinAbs(a));
+
+  // The sum is accumulated from the first component, as in Vector3
+  const double c[3] = {1e16, 1.0, -1e16};
+  EXPECT_DOUBLE_EQ(c[0] + c[1] + c[2], Kernels::Sum(c));
+}
+
+/////////////////////////////////////////////////
+TEST(VectorNTest, Arithmetic)
+{
+  using Kernels = detail::VectorN<int, 2>;
+  int a[2] = {3, -4};
+  const int b[2] = {2, 5};
+  int out[2] = {0, 0};
+
+  Kernels::Add(out, a, b);
+  EXPECT_EQ(5, out[0]);
+  EXPECT_EQ(1, out[1]);
+  Kernels::Sub(out, a, b);
+  EXPECT_EQ(1, out[0]);
+  EXPECT_EQ(-9, out[1]);
+  Kernels::Mul(out, a, b);
+  EXPECT_EQ(6, out[0]);
+  EXPECT_EQ(-20, out[1]);
+  Kernels::ScalarSub(out, 10, a);
+  EXPECT_EQ(7, out[0]);
+  EXPECT_EQ(14, out[1]);
+  Kernels::MultiplyAdd(out, a, 2, b);
+  EXPECT_EQ(8, out[0]);
+  EXPECT_EQ(-3, out[1]);
+
+  // The output may alias an input
+  Kernels::Add(a, a, b);
+  EXPECT_EQ(5, a[0]);
+  EXPECT_EQ(1, a[1]);
+  Kernels::Max(a, b);
+  EXPECT_EQ(5, a[0]);
+  EXPECT_EQ(5, a[1]);
+  Kernels::Min(a, b);
+  EXPECT_EQ(2, a[0]);
+  EXPECT_EQ(5, a[1]);
+}
+
+/////////////////////////////////////////////////
+TEST(VectorNTest, Finite)
+{
+  using Kernels = detail::VectorN<double, 4>;
+  double a[4] = {1.0, std::numeric_limits<double>::quiet_NaN(),
+    -std::numeric_limits<double>::infinity(), 2.0};
+  EXPECT_FALSE(Kernels::IsFinite(a));
+  Kernels::Correct(a);
+  EXPECT_TRUE(Kernels::IsFinite(a));
+  const double expected[4] = {1.0, 0.0, 0.0, 2.0};
+  EXPECT_TRUE(Kernels::Equal(a, expected, 0.0));
+
+  const double close[4] = {1.0005, 0.0, 0.0, 2.0};
+  EXPECT_TRUE(Kernels::Equal(a, close, 1e-3));
+  EXPECT_FALSE(Kernels::Equal(a, close, 1e-4));
+}
+
+/////////////////////////////////////////////////
+TEST(VectorNTest, Constexpr)
+{
+  // The vector operators that delegate to the kernels are still constexpr
+  constexpr Vector2d v2 = (Vector2d(1, 2) + Vector2d(3, 4)) * 2.0;
+  constexpr double dot2 = Vector2d(1, 2).Dot(Vector2d(3, 4));
+
+  constexpr Vector3d v3 = 1.0 - Vector3d(1, 2, 3) / 2.0;
+  constexpr double squared3 = Vector3d(1, 2, 3).SquaredLength();
+  constexpr double max3 = Vector3d(1, -2, 3).Max();
+
+  constexpr Vector4d v4 = -Vector4d(1, 2, 3, 4) + 1.0;
+  constexpr double sum4 = Vector4d(1, 2, 3, 4).Sum();
+
+  EXPECT_DOUBLE_EQ(11.0, dot2);
+  EXPECT_DOUBLE_EQ(14.0, squared3);
+  EXPECT_DOUBLE_EQ(3.0, max3);
+  EXPECT_DOUBLE_EQ(10.0, sum4);
+
+  EXPECT_EQ(Vector2d(8, 12), v2);
+  EXPECT_EQ(Vector3d(0.5, 0, -0.5), v3);
+  EXPECT_EQ(Vector4d(0, -1, -2, -3), v4);
+}
@@ -17,7 +17,14 @@
 
 
 #include <gz/math/VolumetricGridLookupField.hh>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
 #include <unordered_set>
+#include <gz/math/MemoryMappedFile.hh>
 #include <gtest/gtest.h>
 using namespace gz;
 using namespace math;
@@ -182,6 +189,48 @@ TEST(VolumetricGridLookupField, CheckTrilinearInterpolationBoxEightPoints)
   }
 }
 
+TEST(VolumetricGridLookupField, SparseGrid)
+{
+  // A 3x2x2 grid with two points missing and points given out of order
+  std::vector<Vector3d> cloud;
+  for (int z : {1, 0})
+  {
+    for (int y : {0, 1})
+    {
+      for (int x : {2, 0, 1})
+      {
+        if ((x == 1 && y == 1 && z == 1) || (x == 2 && y == 0 && z == 0))
+          continue;
+        cloud.emplace_back(x, y, z);
+      }
+    }
+  }
+  ASSERT_EQ(cloud.size(), 10UL);
+
+  VolumetricGridLookupField<double> scalarIndex(cloud);
+  for (std::size_t i = 0; i < cloud.size(); ++i)
+  {
+    auto val = scalarIndex.GetInterpolators(cloud[i]);
+    ASSERT_EQ(val.size(), 1UL);
+    EXPECT_EQ(val[0].index, i);
+    EXPECT_EQ(val[0].position, cloud[i]);
+  }
+
+  auto missing = scalarIndex.GetInterpolators(Vector3d(1, 1, 1));
+  ASSERT_EQ(missing.size(), 1UL);
+  EXPECT_FALSE(missing[0].index.has_value());
+
+  auto cell = scalarIndex.GetInterpolators(Vector3d(1.5, 0.5, 0.5));
+  ASSERT_EQ(cell.size(), 8UL);
+  std::size_t holes = 0;
+  for (const auto &pt : cell)
+    holes += pt.index.has_value() ? 0 : 1;
+  EXPECT_EQ(holes, 2UL);
+
+  EXPECT_EQ(scalarIndex.Bounds().first, Vector3d(0, 0, 0));
+  EXPECT_EQ(scalarIndex.Bounds().second, Vector3d(2, 1, 1));
+}
+
 TEST(VolumetricGridLookupField, AxisIndexTest)
 {
   AxisIndex<double> axis;
@@ -195,3 +244,655 @@ TEST(VolumetricGridLookupField, AxisIndexTest)
   EXPECT_EQ(axis.GetIndex(300).value(), 0UL);
   EXPECT_EQ(axis.GetIndex(200).has_value(), false);
 }
+
+TEST(VolumetricGridLookupField, AxisIndexUniform)
+{
+  // Keys accumulated with rounding error and registered out of order
+  AxisIndex<double> axis;
+  std::vector<double> keys;
+  double key = -1.0;
+  for (int i = 0; i < 50; ++i)
+  {
+    keys.push_back(key);
+    key += 0.1;
+  }
+  for (int i = 49; i >= 0; i -= 2)
+    axis.AddIndexIfNotFound(keys[i]);
+  for (int i = 0; i < 50; i += 2)
+    axis.AddIndexIfNotFound(keys[i]);
+  EXPECT_TRUE(axis.IsUniform());
+  EXPECT_EQ(axis.GetNumUniqueIndices(), 50UL);
+  EXPECT_DOUBLE_EQ(axis.MinKey(), keys.front());
+  EXPECT_DOUBLE_EQ(axis.MaxKey(), keys.back());
+
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    ASSERT_TRUE(axis.GetIndex(keys[i]).has_value());
+    auto exact = axis.GetInterpolators(keys[i]);
+    ASSERT_EQ(exact.size(), 1UL);
+    EXPECT_EQ(exact[0].position, keys[i]);
+    EXPECT_EQ(exact[0].index, axis.GetIndex(keys[i]).value());
+
+    if (i + 1 < keys.size())
+    {
+      auto between = axis.GetInterpolators(keys[i] + 0.03);
+      ASSERT_EQ(between.size(), 2UL);
+      EXPECT_EQ(between[0].position, keys[i]);
+      EXPECT_EQ(between[1].position, keys[i + 1]);
+    }
+  }
+  EXPECT_TRUE(axis.GetInterpolators(keys.front() - 0.01).empty());
+  EXPECT_TRUE(axis.GetInterpolators(keys.back() + 0.01).empty());
+  EXPECT_FALSE(axis.GetIndex(0.05).has_value());
+
+  // Adding an irregular key falls back to a search
+  axis.AddIndexIfNotFound(100);
+  EXPECT_FALSE(axis.IsUniform());
+  auto last = axis.GetInterpolators(50);
+  ASSERT_EQ(last.size(), 2UL);
+  EXPECT_EQ(last[0].position, keys.back());
+  EXPECT_EQ(last[1].position, 100.0);
+}
+
+TEST(VolumetricGridLookupField, AxisIndexNonUniform)
+{
+  AxisIndex<double> axis;
+  const std::vector<double> keys{0, 1, 3, 7, 15, 31};
+  for (std::size_t i = keys.size(); i-- > 0;)
+    axis.AddIndexIfNotFound(keys[i]);
+  EXPECT_FALSE(axis.IsUniform());
+
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    // Indices follow registration order
+    EXPECT_EQ(axis.GetIndex(keys[i]).value(), keys.size() - 1 - i);
+    if (i + 1 < keys.size())
+    {
+      auto between = axis.GetInterpolators((keys[i] + keys[i + 1]) / 2);
+      ASSERT_EQ(between.size(), 2UL);
+      EXPECT_EQ(between[0].position, keys[i]);
+      EXPECT_EQ(between[1].position, keys[i + 1]);
+    }
+  }
+  EXPECT_TRUE(axis.GetInterpolators(-1).empty());
+  EXPECT_TRUE(axis.GetInterpolators(32).empty());
+}
+
+TEST(VolumetricGridLookupField, AxisIndexHint)
+{
+  AxisIndex<double> axis;
+  for (double v : {0.0, 1.0, 3.0, 3.5, 7.0, 12.0, 20.0})
+    axis.AddIndexIfNotFound(v);
+
+  // Walk back and forth, jump and go out of range. The hint only affects
+  // the cost of the search.
+  std::size_t hint = 0;
+  for (double v : {-1.0, 0.0, 0.5, 1.0, 2.0, 3.2, 3.5, 5.0, 3.1, 15.0, 19.0,
+                   20.0, 25.0, 0.2, 11.0, 2.5})
+  {
+    std::array<InterpolationPoint1D<double>, 2> expected;
+    std::array<InterpolationPoint1D<double>, 2> actual;
+    const std::size_t count = axis.GetInterpolators(v, expected);
+    ASSERT_EQ(count, axis.GetInterpolators(v, actual, hint)) << v;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      EXPECT_EQ(expected[i].index, actual[i].index) << v;
+      EXPECT_DOUBLE_EQ(expected[i].position, actual[i].position) << v;
+    }
+  }
+
+  // Hints past the end are valid
+  std::array<InterpolationPoint1D<double>, 2> points;
+  hint = 1000;
+  ASSERT_EQ(2u, axis.GetInterpolators(4.0, points, hint));
+  EXPECT_DOUBLE_EQ(3.5, points[0].position);
+  EXPECT_DOUBLE_EQ(7.0, points[1].position);
+  EXPECT_EQ(4u, hint);
+
+  AxisIndex<double> empty;
+  hint = 3;
+  EXPECT_EQ(0u, empty.GetInterpolators(1.0, points, hint));
+}
+
+TEST(VolumetricGridLookupField, Cursor)
+{
+  // Non uniform and sparse
+  std::vector<Vector3d> cloud;
+  for (double x = 0; x < 12; x += 1)
+    for (double y = 0; y < 8; y += 1)
+      for (double z = 0; z < 5; z += 1)
+        cloud.emplace_back(x * x, y * y * 0.5, z * z * z);
+  cloud.erase(cloud.begin() + 200);
+  VolumetricGridLookupField<double> scalarIndex(cloud);
+
+  // Slow trajectory with some jumps and points outside the field
+  std::vector<Vector3d> trajectory;
+  for (int i = 0; i < 400; ++i)
+  {
+    const double s = i / 400.0;
+    trajectory.emplace_back(s * 125 - 2, s * s * 26, (1 - s) * 70);
+    if (i % 97 == 0)
+      trajectory.emplace_back(s * 50, 30 - s * 20, 64);
+  }
+
+  VolumetricGridCursor cursor;
+  for (const auto &pt : trajectory)
+  {
+    InterpolationPoints3D<double> expected;
+    InterpolationPoints3D<double> actual;
+    scalarIndex.GetInterpolators(pt, expected);
+    scalarIndex.GetInterpolators(pt, actual, cursor);
+    ASSERT_EQ(expected.count, actual.count) << pt;
+    for (std::size_t i = 0; i < expected.count; ++i)
+    {
+      EXPECT_EQ(expected.points[i].index, actual.points[i].index) << pt;
+      EXPECT_EQ(expected.points[i].position, actual.points[i].position)
+        << pt;
+    }
+  }
+}
+
+TEST(VolumetricGridLookupField, FixedSizeInterpolators)
+{
+  std::vector<Vector3d> cloud;
+  for (double x = 0; x < 4; x += 1)
+    for (double y = 0; y < 3; y += 0.5)
+      for (double z = 0; z < 2; z += 0.25)
+        cloud.emplace_back(x, y, z);
+  // Leave a hole in the data
+  cloud.erase(cloud.begin() + 17);
+
+  std::vector<double> values(cloud.size());
+  for (std::size_t i = 0; i < cloud.size(); ++i)
+    values[i] = cloud[i].X() - cloud[i].Y() + 4 * cloud[i].Z();
+
+  VolumetricGridLookupField<double> scalarIndex(cloud);
+
+  const std::vector<Vector3d> queries{
+    {0.5, 0.25, 0.1}, {1, 1, 1}, {2.5, 1, 0.75}, {3, 2.5, 1.75},
+    {0, 0.3, 0}, {1.5, 1.2, 0.3}, {-1, 0, 0}, {5, 1, 1}};
+
+  InterpolationPoints3D<double> fixed;
+  for (const auto &q : queries)
+  {
+    auto expected = scalarIndex.GetInterpolators(q);
+    scalarIndex.GetInterpolators(q, fixed);
+    ASSERT_EQ(expected.size(), fixed.count) << q;
+    for (std::size_t i = 0; i < fixed.count; ++i)
+    {
+      EXPECT_EQ(expected[i].position, fixed.points[i].position) << q;
+      EXPECT_EQ(expected[i].index, fixed.points[i].index) << q;
+    }
+
+    auto value = scalarIndex.EstimateValueUsingTrilinear(
+      expected, q, values, -100.0);
+    auto fixedValue = scalarIndex.EstimateValueUsingTrilinear(
+      fixed, q, values, -100.0);
+    ASSERT_EQ(value.has_value(), fixedValue.has_value()) << q;
+    if (value.has_value())
+    {
+      EXPECT_DOUBLE_EQ(value.value(), fixedValue.value()) << q;
+    }
+  }
+
+  // The field is linear, so bilinear interpolation on a grid plane away
+  // from the hole is exact
+  auto value = scalarIndex.EstimateValueUsingTrilinear(
+    Vector3d(2.5, 1.75, 1.0), values);
+  ASSERT_TRUE(value.has_value());
+  EXPECT_NEAR(value.value(), 2.5 - 1.75 + 4 * 1.0, 1e-9);
+}
+
+TEST(VolumetricGridLookupField, BatchEstimate)
+{
+  // Large enough for batches to be reordered by cell
+  std::vector<Vector3d> cloud;
+  for (double x = 0; x < 80; x += 1)
+    for (double y = 0; y < 80; y += 2)
+      for (double z = 0; z < 24; z += 0.25)
+        cloud.emplace_back(x, y, z);
+  cloud.erase(cloud.begin() + 123);
+
+  std::vector<double> values(cloud.size());
+  for (std::size_t i = 0; i < values.size(); ++i)
+    values[i] = static_cast<double>(i % 17);
+
+  VolumetricGridLookupField<double> scalarIndex(cloud);
+
+  // Enough points to be sorted and split across threads, some outside
+  std::vector<Vector3d> queries;
+  for (int i = 0; i < 5000; ++i)
+  {
+    queries.emplace_back((i * 37 % 8100) / 100.0 - 0.5,
+      (i * 53 % 7900) / 100.0, (i * 71 % 2370) / 100.0);
+  }
+
+  std::vector<std::optional<double>> expected;
+  for (const auto &q : queries)
+  {
+    expected.push_back(
+      scalarIndex.EstimateValueUsingTrilinear(q, values, -1.0));
+  }
+
+  for (unsigned int threads : {1u, 3u, 0u})
+  {
+    std::vector<std::optional<double>> results;
+    scalarIndex.EstimateValuesUsingTrilinear(
+      queries, results, values, -1.0, threads);
+    ASSERT_EQ(results.size(), queries.size());
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+      ASSERT_EQ(expected[i].has_value(), results[i].has_value()) << i;
+      if (expected[i].has_value())
+      {
+        EXPECT_EQ(expected[i].value(), results[i].value()) << i;
+      }
+    }
+  }
+
+  // Small batch through the pointer interface
+  std::vector<std::optional<double>> partial(3);
+  scalarIndex.EstimateValuesUsingTrilinear(
+    queries.data() + 10, partial.data(), partial.size(), values.data(),
+    -1.0);
+  for (std::size_t i = 0; i < partial.size(); ++i)
+    EXPECT_EQ(expected[10 + i], partial[i]);
+
+  std::vector<std::optional<double>> empty{1.0};
+  scalarIndex.EstimateValuesUsingTrilinear(
+    std::vector<Vector3d>(), empty, values);
+  EXPECT_TRUE(empty.empty());
+}
+
+TEST(VolumetricGridLookupField, SaveLoad)
+{
+  // Sparse, non uniform grid
+  std::vector<Vector3d> cloud;
+  for (double x : {0.0, 1.0, 3.0, 4.0})
+    for (double y : {-2.0, 0.0, 1.5})
+      for (double z : {0.0, 0.5, 1.0, 2.0})
+        cloud.emplace_back(x, y, z);
+  cloud.erase(cloud.begin() + 7);
+
+  std::vector<double> values(cloud.size());
+  for (std::size_t i = 0; i < values.size(); ++i)
+    values[i] = static_cast<double>(i % 5) + 0.25 * static_cast<double>(i);
+
+  VolumetricGridLookupField<double> field(cloud);
+
+  std::ostringstream stream;
+  ASSERT_TRUE(field.Save(stream, values));
+  const std::string saved = stream.str();
+
+  VolumetricGridLookupField<double> loaded;
+  ASSERT_TRUE(loaded.Load(saved.data(), saved.size()));
+  EXPECT_EQ(field.Bounds(), loaded.Bounds());
+  ASSERT_EQ(values.size(), loaded.NumValues());
+  const double *loadedValues = loaded.Values<double>();
+  ASSERT_NE(nullptr, loadedValues);
+  EXPECT_EQ(nullptr, loaded.Values<float>());
+
+  for (double x = -0.5; x < 4.5; x += 0.3)
+  {
+    for (double y = -2.5; y < 2.0; y += 0.4)
+    {
+      for (double z = -0.2; z < 2.2; z += 0.35)
+      {
+        const Vector3d pt(x, y, z);
+        const auto expected =
+          field.EstimateValueUsingTrilinear(pt, values, -1.0);
+        const auto actual =
+          loaded.EstimateValueUsingTrilinear(pt, loadedValues, -1.0);
+        ASSERT_EQ(expected.has_value(), actual.has_value()) << pt;
+        if (expected.has_value())
+        {
+          EXPECT_EQ(expected.value(), actual.value()) << pt;
+        }
+      }
+    }
+  }
+
+  // Saving a loaded field gives the same bytes
+  std::ostringstream again;
+  ASSERT_TRUE(loaded.Save(again,
+    std::vector<double>(loadedValues, loadedValues + loaded.NumValues())));
+  EXPECT_EQ(saved, again.str());
+
+  // Without values
+  std::ostringstream indexOnly;
+  ASSERT_TRUE(field.Save(indexOnly));
+  // The field is used in place, so it must outlive the loaded field
+  const std::string indexOnlySaved = indexOnly.str();
+  VolumetricGridLookupField<double> noValues;
+  ASSERT_TRUE(noValues.Load(indexOnlySaved.data(), indexOnlySaved.size()));
+  EXPECT_EQ(0u, noValues.NumValues());
+  EXPECT_EQ(nullptr, noValues.Values<double>());
+  EXPECT_EQ(field.GetInterpolators(Vector3d(3.5, 0.5, 0.25)).size(),
+    noValues.GetInterpolators(Vector3d(3.5, 0.5, 0.25)).size());
+
+  // Mismatched types, truncated and corrupt data are rejected
+  VolumetricGridLookupField<float> wrongType;
+  EXPECT_FALSE(wrongType.Load(saved.data(), saved.size()));
+  VolumetricGridLookupField<double, std::uint32_t> wrongIndex;
+  EXPECT_FALSE(wrongIndex.Load(saved.data(), saved.size()));
+  EXPECT_FALSE(loaded.Load(saved.data(), saved.size() - 16));
+  EXPECT_TRUE(loaded.GetInterpolators(Vector3d(1, 0, 0)).empty());
+  std::string corrupt = saved;
+  corrupt[0] = 'X';
+  EXPECT_FALSE(loaded.Load(corrupt.data(), corrupt.size()));
+  EXPECT_FALSE(loaded.Load(nullptr, 0));
+
+  // Indices out of the saved values are rejected
+  std::vector<std::size_t> indices(cloud.size());
+  for (std::size_t i = 0; i < indices.size(); ++i)
+    indices[i] = i;
+  indices.back() = values.size();
+  std::ostringstream outOfRange;
+  ASSERT_TRUE(VolumetricGridLookupField<double>(cloud, indices).Save(
+    outOfRange, values));
+  const std::string outOfRangeSaved = outOfRange.str();
+  EXPECT_FALSE(loaded.Load(outOfRangeSaved.data(), outOfRangeSaved.size()));
+  EXPECT_TRUE(loaded.GetInterpolators(Vector3d(1, 0, 0)).empty());
+}
+
+TEST(VolumetricGridLookupField, IndicesFitIndexType)
+{
+  std::vector<Vector3d> cloud;
+  for (double x = 0; x < 16; ++x)
+    for (double y = 0; y < 16; ++y)
+      cloud.emplace_back(x, y, 0);
+
+  // 256 points need index 255, which marks missing points in 8 bits
+  VolumetricGridLookupField<double, std::uint8_t> tooMany(cloud);
+  EXPECT_TRUE(tooMany.GetInterpolators(Vector3d(1, 1, 0)).empty());
+  cloud.pop_back();
+  VolumetricGridLookupField<double, std::uint8_t> fits(cloud);
+  ASSERT_EQ(1u, fits.GetInterpolators(Vector3d(1, 1, 0)).size());
+  EXPECT_EQ(17u, fits.GetInterpolators(Vector3d(1, 1, 0))[0].index);
+
+  std::vector<std::uint8_t> indices(cloud.size(), 3);
+  indices[7] = 255;
+  VolumetricGridLookupField<double, std::uint8_t> reserved(cloud, indices);
+  EXPECT_TRUE(reserved.GetInterpolators(Vector3d(1, 1, 0)).empty());
+}
+
+TEST(VolumetricGridLookupField, LoadMemoryMapped)
+{
+  std::vector<Vector3d> cloud;
+  for (double x = 0; x < 10; x += 1)
+    for (double y = 0; y < 5; y += 1)
+      for (double z = 0; z < 3; z += 1)
+        cloud.emplace_back(x, y, z);
+  std::vector<float> values(cloud.size());
+  for (std::size_t i = 0; i < values.size(); ++i)
+    values[i] = static_cast<float>(i);
+
+  VolumetricGridLookupField<double> field(cloud);
+  const std::string path = "VolumetricGridLookupField_TEST.bin";
+  {
+    std::ofstream out(path, std::ios::binary);
+    ASSERT_TRUE(field.Save(out, values));
+  }
+
+  {
+    MemoryMappedFile file;
+    ASSERT_TRUE(file.Open(path));
+    VolumetricGridLookupField<double> loaded;
+    ASSERT_TRUE(loaded.Load(file.Data(), file.Size()));
+    const float *loadedValues = loaded.Values<float>();
+    ASSERT_NE(nullptr, loadedValues);
+
+    const Vector3d pt(4.5, 2.25, 1.0);
+    const auto expected = field.EstimateValueUsingTrilinear(pt, values);
+    const auto actual = loaded.EstimateValueUsingTrilinear(pt, loadedValues);
+    ASSERT_TRUE(actual.has_value());
+    EXPECT_FLOAT_EQ(expected.value(), actual.value());
+
+    std::vector<Vector3d> queries{pt, Vector3d(20, 0, 0)};
+    std::vector<std::optional<float>> results(queries.size());
+    loaded.EstimateValuesUsingTrilinear(queries.data(), results.data(),
+      queries.size(), loadedValues);
+    EXPECT_EQ(actual, results[0]);
+    EXPECT_FALSE(results[1].has_value());
+  }
+  std::remove(path.c_str());
+}
+
+TEST(VolumetricGridLookupField, ParallelBuild)
+{
+  // Large enough to be built with three threads. Non uniform along x,
+  // shuffled, with missing points and duplicates.
+  std::vector<Vector3d> cloud;
+  for (double x = 0; x < 80; x += 1)
+    for (double y = -25; y < 25; y += 1)
+      for (double z = 0; z < 12.5; z += 0.25)
+        cloud.emplace_back(x * x * 0.1, y, z);
+  cloud.erase(cloud.begin() + 5000, cloud.begin() + 5100);
+  std::mt19937 gen(7);
+  std::shuffle(cloud.begin(), cloud.end(), gen);
+  for (std::size_t i = 0; i < 1000; ++i)
+    cloud.push_back(cloud[i * 150]);
+  cloud.push_back(Vector3d(-0.0, 0, 0));
+
+  std::vector<std::size_t> indices(cloud.size());
+  for (std::size_t i = 0; i < indices.size(); ++i)
+    indices[i] = (i * 7) % indices.size();
+
+  VolumetricGridLookupField<double> serial(cloud, indices);
+  std::ostringstream expected;
+  ASSERT_TRUE(serial.Save(expected));
+
+  for (unsigned int threads : {2u, 3u, 0u})
+  {
+    VolumetricGridLookupField<double> parallel(cloud, indices, threads);
+    std::ostringstream actual;
+    ASSERT_TRUE(parallel.Save(actual));
+    EXPECT_EQ(expected.str(), actual.str()) << threads;
+
+    for (const auto &pt : {Vector3d(10.3, 0.5, 3.1), Vector3d(0, -25, 0),
+                           Vector3d(600, 24, 12.25)})
+    {
+      InterpolationPoints3D<double> a;
+      InterpolationPoints3D<double> b;
+      serial.GetInterpolators(pt, a);
+      parallel.GetInterpolators(pt, b);
+      ASSERT_EQ(a.count, b.count);
+      for (std::size_t i = 0; i < a.count; ++i)
+        EXPECT_EQ(a.points[i].index, b.points[i].index);
+    }
+  }
+
+  // Small clouds fall back to the serial build
+  std::vector<Vector3d> small{Vector3d(0, 0, 0), Vector3d(1, 0, 0)};
+  std::vector<std::size_t> smallIndices{4, 2};
+  VolumetricGridLookupField<double> smallField(small, smallIndices, 4);
+  auto pts = smallField.GetInterpolators(Vector3d(1, 0, 0));
+  ASSERT_EQ(1u, pts.size());
+  EXPECT_EQ(2u, pts[0].index.value());
+}
+
+TEST(VolumetricGridLookupField, WithIndexOffset)
+{
+  std::vector<Vector3d> cloud;
+  for (double x = 0; x < 4; x += 1)
+    for (double y = 0; y < 3; y += 1)
+      for (double z = 0; z < 2; z += 1)
+        cloud.emplace_back(x, y, z);
+  cloud.pop_back();
+
+  // Two time steps stored one after the other
+  std::vector<double> values(2 * cloud.size());
+  for (std::size_t i = 0; i < values.size(); ++i)
+    values[i] = static_cast<double>(i);
+
+  VolumetricGridLookupField<double> field(cloud);
+  const auto shifted = field.WithIndexOffset(cloud.size());
+  EXPECT_FALSE(field.SameIndices(shifted));
+  EXPECT_TRUE(shifted.SameIndices(shifted));
+
+  for (const auto &pt : {Vector3d(0.5, 1.5, 0.5), Vector3d(3, 2, 0),
+                         Vector3d(3, 2, 1), Vector3d(9, 0, 0)})
+  {
+    const auto a = field.GetInterpolators(pt);
+    const auto b = shifted.GetInterpolators(pt);
+    ASSERT_EQ(a.size(), b.size()) << pt;
+    bool complete = true;
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+      ASSERT_EQ(a[i].index.has_value(), b[i].index.has_value()) << pt;
+      if (a[i].index)
+      {
+        EXPECT_EQ(*a[i].index + cloud.size(), *b[i].index) << pt;
+      }
+      complete = complete && a[i].index.has_value();
+    }
+
+    // Missing points use the default value, which is not offset
+    if (!complete)
+      continue;
+    const auto expected = field.EstimateValueUsingTrilinear(pt, values);
+    const auto actual = shifted.EstimateValueUsingTrilinear(pt, values);
+    ASSERT_EQ(expected.has_value(), actual.has_value()) << pt;
+    if (expected)
+    {
+      EXPECT_DOUBLE_EQ(*expected + static_cast<double>(cloud.size()),
+        *actual) << pt;
+    }
+  }
+
+  // The offset is saved with the table, missing points stay missing
+  std::ostringstream stream;
+  ASSERT_TRUE(shifted.Save(stream));
+  const std::string saved = stream.str();
+  VolumetricGridLookupField<double> loaded;
+  ASSERT_TRUE(loaded.Load(saved.data(), saved.size()));
+  EXPECT_FALSE(loaded.SameIndices(field));
+  for (const auto &pt : {Vector3d(3, 2, 0.5), Vector3d(1.5, 0.5, 0.5)})
+  {
+    EXPECT_EQ(shifted.EstimateValueUsingTrilinear(pt, values),
+      loaded.EstimateValueUsingTrilinear(pt, values)) << pt;
+  }
+
+  // Offsets add up
+  const auto back = field.WithIndexOffset(2).WithIndexOffset(
+    cloud.size() - 2);
+  EXPECT_TRUE(back.SameIndices(shifted));
+}
+
+TEST(VolumetricGridLookupField, QuantizedValues)
+{
+  std::vector<Vector3d> cloud;
+  for (double x = 0; x < 5; x += 1)
+    for (double y = 0; y < 4; y += 0.5)
+      for (double z = 0; z < 3; z += 1)
+        cloud.emplace_back(x, y, z);
+  cloud.erase(cloud.begin() + 17);
+
+  std::vector<double> values(cloud.size());
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    const auto &pt = cloud[i];
+    values[i] = 1000 + 3.5 * pt.X() - pt.Y() * pt.Y() + 12 * pt.Z();
+  }
+  VolumetricGridLookupField<double> scalarIndex(cloud);
+
+  QuantizedValues<std::int16_t, double> quantized16(values);
+  QuantizedValues<std::uint8_t, double> quantized8(values);
+  EXPECT_LT(quantized16.MaxError(), quantized8.MaxError());
+
+  for (double x = -0.5; x < 5; x += 0.35)
+  {
+    for (double y = 0; y < 4; y += 0.3)
+    {
+      for (double z = 0; z < 3; z += 0.45)
+      {
+        const Vector3d pt(x, y, z);
+        const auto expected =
+          scalarIndex.EstimateValueUsingTrilinear(pt, values, -5.0);
+        const auto actual16 =
+          scalarIndex.EstimateValueUsingTrilinear(pt, quantized16, -5.0);
+        InterpolationPoints3D<double> interpolators;
+        scalarIndex.GetInterpolators(pt, interpolators);
+        const auto actual8 = scalarIndex.EstimateValueUsingTrilinear(
+          interpolators, pt, quantized8, -5.0);
+        ASSERT_EQ(expected.has_value(), actual16.has_value()) << pt;
+        ASSERT_EQ(expected.has_value(), actual8.has_value()) << pt;
+        if (expected.has_value())
+        {
+          EXPECT_NEAR(expected.value(), actual16.value(),
+            quantized16.MaxError() + 1e-9) << pt;
+          EXPECT_NEAR(expected.value(), actual8.value(),
+            quantized8.MaxError() + 1e-9) << pt;
+        }
+      }
+    }
+  }
+}
+
+TEST(VolumetricGridLookupField, EstimateChannels)
+{
+  std::vector<Vector3d> cloud;
+  for (double x = 0; x < 4; x += 1)
+    for (double y = 0; y < 3; y += 0.5)
+      for (double z = 0; z < 3; z += 1)
+        cloud.emplace_back(x, y, z);
+  // A hole in the data
+  cloud.erase(cloud.begin() + 20);
+  VolumetricGridLookupField<double> scalarIndex(cloud);
+
+  // Four channels stored interleaved
+  const std::size_t channels = 4;
+  std::vector<std::vector<double>> separate(channels,
+    std::vector<double>(cloud.size()));
+  std::vector<double> interleaved(cloud.size() * channels);
+  for (std::size_t i = 0; i < cloud.size(); ++i)
+  {
+    const auto &pt = cloud[i];
+    const double channelValues[channels] = {pt.X() * pt.Y(), -pt.Z(),
+      std::sin(pt.X() + pt.Z()), 4.0};
+    for (std::size_t c = 0; c < channels; ++c)
+    {
+      separate[c][i] = channelValues[c];
+      interleaved[i * channels + c] = channelValues[c];
+    }
+  }
+
+  for (double x = -0.5; x < 4; x += 0.4)
+  {
+    for (double y = 0; y < 3; y += 0.35)
+    {
+      for (double z = 0; z < 3; z += 0.6)
+      {
+        const Vector3d pt(x, y, z);
+        double out[channels];
+        const bool found = scalarIndex.EstimateChannelsUsingTrilinear(
+          pt, interleaved.data(), channels, out, -1.0);
+        for (std::size_t c = 0; c < channels; ++c)
+        {
+          const auto expected = scalarIndex.EstimateValueUsingTrilinear(
+            pt, separate[c], -1.0);
+          ASSERT_EQ(expected.has_value(), found) << pt;
+          if (found)
+          {
+            EXPECT_NEAR(expected.value(), out[c], 1e-9) << pt << " " << c;
+          }
+        }
+      }
+    }
+  }
+
+  // Vector field
+  std::vector<double> components;
+  for (const auto &pt : cloud)
+  {
+    components.push_back(pt.X());
+    components.push_back(2 * pt.Y());
+    components.push_back(pt.Z() - 1);
+  }
+  const auto vec = scalarIndex.EstimateVector3UsingTrilinear(
+    Vector3d{1.5, 1.25, 0}, components);
+  ASSERT_TRUE(vec.has_value());
+  EXPECT_EQ(Vector3d(1.5, 2.5, -1), vec.value());
+  EXPECT_FALSE(scalarIndex.EstimateVector3UsingTrilinear(
+    Vector3d{10, 0, 0}, components).has_value());
+}
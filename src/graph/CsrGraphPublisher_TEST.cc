@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "gz/math/graph/CsrGraphPublisher.hh"
+#include "gz/math/graph/Graph.hh"
+#include "gz/math/graph/GraphAlgorithms.hh"
+
+#include <gz/utils/SuppressWarning.hh>
+
+using namespace gz;
+using namespace math;
+using namespace graph;
+
+/////////////////////////////////////////////////
+TEST(CsrGraphPublisherTest, Publish)
+{
+  CsrGraphPublisher empty;
+  EXPECT_EQ(0u, empty.Snapshot()->VertexCount());
+  EXPECT_EQ(0u, empty.Epoch());
+
+  UndirectedGraph<int, double> graph(
+  {
+    {{"A", 0, 0}, {"B", 1, 1}, {"C", 2, 2}},
+    {{{0, 1}, 0, 2.0}, {{1, 2}, 0, 3.0}}
+  });
+  CsrGraphPublisher publisher(graph);
+  EXPECT_EQ(0u, publisher.Epoch());
+  const auto first = publisher.Snapshot();
+  EXPECT_DOUBLE_EQ(5.0, Dijkstra(*first, 0).at(2).first);
+
+  // A held snapshot doesn't change when a new one is published
+  graph.AddEdge({0, 2}, 0, 1.0);
+  EXPECT_EQ(1u, publisher.Publish(graph));
+  EXPECT_EQ(1u, publisher.Epoch());
+  EXPECT_DOUBLE_EQ(5.0, Dijkstra(*first, 0).at(2).first);
+  EXPECT_DOUBLE_EQ(1.0, Dijkstra(*publisher.Snapshot(), 0).at(2).first);
+  EXPECT_NE(first, publisher.Snapshot());
+
+  EXPECT_EQ(2u, publisher.Publish(CsrGraph()));
+  EXPECT_EQ(0u, publisher.Snapshot()->VertexCount());
+  EXPECT_EQ(3u, first->VertexCount());
+}
+
+/////////////////////////////////////////////////
+TEST(CsrGraphPublisherTest, ConcurrentReaders)
+{
+  // A ring whose edges all have the weight of the current batch, so a
+  // reader sees a torn graph if two weights differ
+  const int count = 200;
+  UndirectedGraph<int, double> graph;
+  for (int i = 0; i < count; ++i)
+    graph.AddVertex("", 0, i);
+  for (int i = 0; i < count; ++i)
+    graph.AddEdge({i, (i + 1) % count}, 0, 1.0);
+  CsrGraphPublisher publisher(graph);
+
+  std::atomic<bool> done{false};
+  std::atomic<int> inconsistent{0};
+  std::atomic<int> queries{0};
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 4; ++r)
+  {
+    readers.emplace_back([&]()
+    {
+      do
+      {
+        const auto snapshot = publisher.Snapshot();
+        const auto &weights = snapshot->Weights();
+        // The weights are whole numbers, so the sums below are exact
+        GZ_UTILS_WARN_IGNORE__FLOAT_EQUAL
+        for (const double w : weights)
+        {
+          if (w != weights.front())
+            ++inconsistent;
+        }
+        const auto costs = Dijkstra(*snapshot, 0);
+        if (costs.at(count / 2).first != weights.front() * (count / 2))
+          ++inconsistent;
+        GZ_UTILS_WARN_RESUME__FLOAT_EQUAL
+        ++queries;
+      }
+      while (!done);
+    });
+  }
+
+  for (int batch = 2; batch <= 20; ++batch)
+  {
+    for (const auto &edge : graph.Edges())
+    {
+      const auto vertices = edge.second.get().Vertices();
+      graph.RemoveEdge(edge.first);
+      graph.AddEdge(vertices, 0, batch);
+    }
+    EXPECT_EQ(static_cast<std::uint64_t>(batch - 1),
+      publisher.Publish(graph));
+  }
+  done = true;
+  for (auto &reader : readers)
+    reader.join();
+
+  EXPECT_EQ(0, inconsistent);
+  EXPECT_GE(queries, 4);
+  EXPECT_DOUBLE_EQ(20.0, publisher.Snapshot()->Weights().front());
+}
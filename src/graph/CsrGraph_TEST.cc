@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "gz/math/graph/CsrGraph.hh"
+#include "gz/math/graph/Graph.hh"
+
+using namespace gz;
+using namespace math;
+using namespace graph;
+
+/////////////////////////////////////////////////
+TEST(CsrGraphTest, Empty)
+{
+  CsrGraph empty;
+  EXPECT_EQ(0u, empty.VertexCount());
+  EXPECT_EQ(0u, empty.EdgeCount());
+  EXPECT_EQ(std::vector<std::size_t>{0}, empty.Offsets());
+  EXPECT_EQ(CsrGraph::kNullIndex, empty.Index(0));
+
+  CsrGraph frozen = Freeze(DirectedGraph<int, double>());
+  EXPECT_EQ(0u, frozen.VertexCount());
+  EXPECT_EQ(std::vector<std::size_t>{0}, frozen.Offsets());
+}
+
+/////////////////////////////////////////////////
+TEST(CsrGraphTest, Directed)
+{
+  DirectedGraph<int, double> graph(
+  {
+    // Vertices.
+    {{"A", 0, 10}, {"B", 1, 3}, {"C", 2, 7}},
+    // Edges.
+    {{{10, 7}, 0.0, 1.5}, {{10, 3}, 0.0, 2.5}, {{3, 7}, 0.0, 4.0}}
+  });
+
+  CsrGraph frozen = Freeze(graph);
+  EXPECT_EQ(3u, frozen.VertexCount());
+  EXPECT_EQ(3u, frozen.EdgeCount());
+
+  // Indices follow the Ids.
+  EXPECT_EQ((std::vector<VertexId>{3, 7, 10}), frozen.Ids());
+  EXPECT_EQ(0u, frozen.Index(3));
+  EXPECT_EQ(1u, frozen.Index(7));
+  EXPECT_EQ(2u, frozen.Index(10));
+  EXPECT_EQ(CsrGraph::kNullIndex, frozen.Index(4));
+  EXPECT_EQ(10u, frozen.Id(2));
+
+  EXPECT_EQ((std::vector<std::size_t>{0, 1, 1, 3}), frozen.Offsets());
+  EXPECT_EQ((std::vector<std::size_t>{1, 0, 1}), frozen.Neighbors());
+  EXPECT_EQ((std::vector<double>{4.0, 2.5, 1.5}), frozen.Weights());
+  EXPECT_EQ(1u, frozen.OutDegree(0));
+  EXPECT_EQ(0u, frozen.OutDegree(1));
+  EXPECT_EQ(2u, frozen.OutDegree(2));
+
+  // Incoming edges, grouped by destination.
+  EXPECT_EQ((std::vector<std::size_t>{0, 1, 3, 3}), frozen.InOffsets());
+  EXPECT_EQ((std::vector<std::size_t>{2, 0, 2}), frozen.InNeighbors());
+  EXPECT_EQ((std::vector<double>{2.5, 4.0, 1.5}), frozen.InWeights());
+
+  // The snapshot does not change with the graph.
+  graph.RemoveVertex(10);
+  EXPECT_EQ(3u, frozen.VertexCount());
+}
+
+/////////////////////////////////////////////////
+TEST(CsrGraphTest, Undirected)
+{
+  UndirectedGraph<int, double> graph(
+  {
+    // Vertices.
+    {{"A", 0, 0}, {"B", 1, 1}, {"C", 2, 2}},
+    // Edges.
+    {{{0, 1}, 0.0, 1.0}, {{2, 1}, 0.0, 2.0}}
+  });
+
+  CsrGraph frozen = Freeze(graph);
+  EXPECT_EQ(3u, frozen.VertexCount());
+  EXPECT_EQ(4u, frozen.EdgeCount());
+  EXPECT_EQ((std::vector<std::size_t>{0, 1, 3, 4}), frozen.Offsets());
+  EXPECT_EQ((std::vector<std::size_t>{1, 0, 2, 1}), frozen.Neighbors());
+  EXPECT_EQ((std::vector<double>{1.0, 1.0, 2.0, 2.0}), frozen.Weights());
+}
@@ -15,8 +15,18 @@
  *
 */
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
+#include "gz/math/Rand.hh"
+#include "gz/math/graph/CsrGraph.hh"
 #include "gz/math/graph/Graph.hh"
 #include "gz/math/graph/GraphAlgorithms.hh"
 
@@ -31,8 +41,11 @@ class GraphTestFixture : public testing::Test
 };
 
 // The list of graphs we want to test.
-using GraphTypes = ::testing::Types<DirectedGraph<int, double>,
-                                    UndirectedGraph<int, double>>;
+using GraphTypes = ::testing::Types<
+  DirectedGraph<int, double>,
+  UndirectedGraph<int, double>,
+  DirectedGraph<int, double, SlotMapStorage>,
+  UndirectedGraph<int, double, SlotMapStorage>>;
 TYPED_TEST_SUITE(GraphTestFixture, GraphTypes, );
 
 /////////////////////////////////////////////////
@@ -52,6 +65,10 @@ TYPED_TEST(GraphTestFixture, BreadthFirstSort)
   auto res = BreadthFirstSort(graph, 0);
   std::vector<VertexId> expected = {0, 1, 2, 4, 3, 5, 6};
   EXPECT_EQ(expected, res);
+
+  // Inexistent vertex.
+  EXPECT_TRUE(BreadthFirstSort(graph, 99).empty());
+  EXPECT_TRUE(DepthFirstSort(graph, 99).empty());
 }
 
 /////////////////////////////////////////////////
@@ -368,3 +385,405 @@ TEST(GraphTestFixture, ToUndirectedGraph)
   // std::cerr << directed << std::endl;
   // std::cerr << undirected << std::endl;
 }
+
+/////////////////////////////////////////////////
+TYPED_TEST(GraphTestFixture, Frozen)
+{
+  // Sparse Ids, parallel edges and a self loop
+  Rand::Seed(7);
+  TypeParam graph;
+  for (VertexId id = 0; id < 60; ++id)
+    graph.AddVertex(std::to_string(id), 0, id * 3 + 1);
+  for (int i = 0; i < 200; ++i)
+  {
+    VertexId a = Rand::IntUniform(0, 59) * 3 + 1;
+    VertexId b = Rand::IntUniform(0, 59) * 3 + 1;
+    graph.AddEdge({a, b}, 0.0, Rand::IntUniform(1, 5));
+  }
+  graph.AddEdge({4, 4}, 0.0, 1.0);
+  graph.AddEdge({4, 7}, 0.0, 9.0);
+  graph.AddEdge({4, 7}, 0.0, 0.5);
+
+  const CsrGraph frozen = Freeze(graph);
+  for (VertexId from : {VertexId(1), VertexId(4), VertexId(97)})
+  {
+    EXPECT_EQ(BreadthFirstSort(graph, from), BreadthFirstSort(frozen, from));
+    EXPECT_EQ(DepthFirstSort(graph, from), DepthFirstSort(frozen, from));
+    EXPECT_EQ(Dijkstra(graph, from), Dijkstra(frozen, from));
+    EXPECT_EQ(Dijkstra(graph, from, 178), Dijkstra(frozen, from, 178));
+  }
+
+  // Inexistent vertices.
+  EXPECT_TRUE(BreadthFirstSort(frozen, 2).empty());
+  EXPECT_TRUE(DepthFirstSort(frozen, 2).empty());
+  EXPECT_TRUE(Dijkstra(frozen, 2).empty());
+  EXPECT_TRUE(Dijkstra(frozen, 1, 2).empty());
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(GraphTestFixture, MemoryResource)
+{
+  Rand::Seed(17);
+  TypeParam graph;
+  for (VertexId id = 0; id < 80; ++id)
+    graph.AddVertex(std::to_string(id), 0, id * 2);
+  for (int i = 0; i < 240; ++i)
+  {
+    VertexId a = Rand::IntUniform(0, 79) * 2;
+    VertexId b = Rand::IntUniform(0, 79) * 2;
+    graph.AddEdge({a, b}, 0.0, Rand::DblUniform(1, 5));
+  }
+  const CsrGraph frozen = Freeze(graph);
+
+  // Every allocation comes from the buffer, which is released at once
+  std::array<std::byte, 1 << 16> buffer;
+  for (VertexId from : {VertexId(0), VertexId(42), VertexId(3)})
+  {
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(),
+      std::pmr::null_memory_resource());
+
+    const auto expected = BreadthFirstSort(graph, from);
+    const auto visited = BreadthFirstSort(graph, from, &arena);
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(),
+      visited.begin(), visited.end()));
+    const auto frozenVisited = BreadthFirstSort(frozen, from, 2, &arena);
+    EXPECT_TRUE(std::equal(visited.begin(), visited.end(),
+      frozenVisited.begin(), frozenVisited.end()));
+
+    for (VertexId to : {kNullId, VertexId(158)})
+    {
+      const auto dist = Dijkstra(graph, from, to);
+      const auto pmrDist = Dijkstra(graph, from, to, &arena);
+      EXPECT_TRUE(std::equal(dist.begin(), dist.end(), pmrDist.begin(),
+        pmrDist.end()));
+      const auto frozenDist = Dijkstra(frozen, from, to, &arena);
+      EXPECT_TRUE(std::equal(pmrDist.begin(), pmrDist.end(),
+        frozenDist.begin(), frozenDist.end()));
+    }
+  }
+
+  // Inexistent vertices.
+  std::pmr::monotonic_buffer_resource arena;
+  EXPECT_TRUE(BreadthFirstSort(graph, 3, &arena).empty());
+  EXPECT_TRUE(BreadthFirstSort(frozen, 3, 1, &arena).empty());
+  EXPECT_TRUE(Dijkstra(graph, 3, kNullId, &arena).empty());
+  EXPECT_TRUE(Dijkstra(frozen, 0, 3, &arena).empty());
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(GraphTestFixture, DeltaStepping)
+{
+  // Integer weights give many shortest paths of the same cost
+  Rand::Seed(23);
+  for (const bool integer : {true, false})
+  {
+    TypeParam graph;
+    for (VertexId id = 0; id < 3000; ++id)
+      graph.AddVertex(std::to_string(id), 0, id * 2);
+    for (int i = 0; i < 12000; ++i)
+    {
+      VertexId a = Rand::IntUniform(0, 2999) * 2;
+      VertexId b = Rand::IntUniform(0, 2999) * 2;
+      graph.AddEdge({a, b}, 0.0, integer ?
+        Rand::IntUniform(1, 4) : Rand::DblUniform(0.01, 10));
+    }
+    graph.AddEdge({4, 4}, 0.0, 0.0);
+    const CsrGraph frozen = Freeze(graph);
+
+    for (VertexId from : {VertexId(0), VertexId(4), VertexId(5998)})
+    {
+      const auto expected = Dijkstra(frozen, from);
+      for (double delta : {0.0, 0.5, 3.0, 1e9})
+      {
+        for (unsigned int threads : {1u, 4u})
+        {
+          EXPECT_EQ(expected, DeltaStepping(frozen, from, delta, threads))
+            << from << " " << delta << " " << threads;
+        }
+      }
+    }
+  }
+
+  // Unreachable vertices and inexistent source
+  TypeParam graph;
+  graph.AddVertex("0", 0, 0);
+  graph.AddVertex("1", 0, 1);
+  graph.AddVertex("2", 0, 2);
+  graph.AddEdge({0, 1}, 0.0, 2.0);
+  const CsrGraph frozen = Freeze(graph);
+  EXPECT_EQ(Dijkstra(frozen, 0), DeltaStepping(frozen, 0));
+  EXPECT_EQ(MAX_D, DeltaStepping(frozen, 0).at(2).first);
+  EXPECT_TRUE(DeltaStepping(frozen, 3).empty());
+
+  // Negative weights
+  graph.AddEdge({1, 2}, 0.0, -1.0);
+  EXPECT_TRUE(DeltaStepping(Freeze(graph), 0).empty());
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that the entries of a shortest path map lead from _to back
+/// to _from with consistent costs.
+template<typename G>
+void ExpectPath(const G &_graph, const std::map<VertexId, CostInfo> &_dist,
+                VertexId _from, VertexId _to, double _cost)
+{
+  ASSERT_NE(_dist.end(), _dist.find(_to));
+  EXPECT_DOUBLE_EQ(_cost, _dist.at(_to).first);
+  VertexId v = _to;
+  int steps = 0;
+  while (v != _from && steps++ < 1000)
+  {
+    ASSERT_NE(_dist.end(), _dist.find(v));
+    const VertexId previous = _dist.at(v).second;
+    ASSERT_NE(_dist.end(), _dist.find(previous));
+    const auto &edge = _graph.EdgeFromVertices(previous, v);
+    ASSERT_TRUE(edge.Valid());
+    EXPECT_NEAR(_dist.at(previous).first + edge.Weight(), _dist.at(v).first,
+      1e-9);
+    v = previous;
+  }
+  EXPECT_EQ(_from, v);
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(GraphTestFixture, AStarAndBidirectionalDijkstra)
+{
+  // A grid with random weights, vertex Ids are row * side + col.
+  Rand::Seed(11);
+  const int side = 12;
+  TypeParam graph;
+  for (int i = 0; i < side * side; ++i)
+    graph.AddVertex(std::to_string(i), i, i);
+  for (int row = 0; row < side; ++row)
+  {
+    for (int col = 0; col < side; ++col)
+    {
+      const VertexId id = row * side + col;
+      if (col + 1 < side)
+        graph.AddEdge({id, id + 1}, 0.0, Rand::DblUniform(1, 3));
+      if (row + 1 < side)
+        graph.AddEdge({id, id + side}, 0.0, Rand::DblUniform(1, 3));
+      if (col > 0 && row + 1 < side)
+        graph.AddEdge({id, id + side - 1}, 0.0, Rand::DblUniform(1, 3));
+    }
+  }
+  const CsrGraph frozen = Freeze(graph);
+
+  // The Manhattan distance times the smallest weight is a lower bound.
+  const VertexId to = side * side - 2;
+  auto zero = [](const VertexId &) { return 0.0; };
+  auto manhattan = [&](const VertexId &_v)
+  {
+    const int dr = static_cast<int>(to / side) - static_cast<int>(_v / side);
+    const int dc = static_cast<int>(to % side) - static_cast<int>(_v % side);
+    return 1.0 * (std::abs(dr) + std::abs(dc)) / 2.0;
+  };
+
+  for (VertexId from : {VertexId(0), VertexId(5), VertexId(70)})
+  {
+    const double cost = Dijkstra(graph, from).at(to).first;
+    ExpectPath(graph, AStar(graph, from, to, zero), from, to, cost);
+    ExpectPath(graph, AStar(graph, from, to, manhattan), from, to, cost);
+    ExpectPath(graph, AStar(frozen, from, to, manhattan), from, to, cost);
+
+    auto bidirectional = BidirectionalDijkstra(graph, from, to);
+    ExpectPath(graph, bidirectional, from, to, cost);
+    ExpectPath(graph, BidirectionalDijkstra(frozen, from, to), from, to,
+      cost);
+    EXPECT_EQ(bidirectional, BidirectionalDijkstra(frozen, from, to));
+  }
+
+  // A* with a heuristic visits fewer vertices.
+  EXPECT_LT(AStar(graph, 0, to, manhattan).size(),
+    AStar(graph, 0, to, zero).size());
+
+  // Same vertex.
+  auto res = BidirectionalDijkstra(graph, 3, 3);
+  ASSERT_EQ(1u, res.size());
+  EXPECT_DOUBLE_EQ(0.0, res.at(3).first);
+  EXPECT_DOUBLE_EQ(0.0, AStar(frozen, 3, 3, zero).at(3).first);
+
+  // Inexistent vertices.
+  EXPECT_TRUE(AStar(graph, 0, 9999, zero).empty());
+  EXPECT_TRUE(AStar(frozen, 9999, 0, zero).empty());
+  EXPECT_TRUE(BidirectionalDijkstra(graph, 9999, 0).empty());
+  EXPECT_TRUE(BidirectionalDijkstra(frozen, 0, 9999).empty());
+
+  // Unreachable vertex.
+  graph.AddVertex("isolated", 0, 1000);
+  const CsrGraph frozen2 = Freeze(graph);
+  for (const auto &dist : {AStar(graph, 0, 1000, zero),
+                           AStar(frozen2, 0, 1000, manhattan),
+                           BidirectionalDijkstra(graph, 0, 1000),
+                           BidirectionalDijkstra(frozen2, 0, 1000)})
+  {
+    ASSERT_NE(dist.end(), dist.find(1000));
+    EXPECT_DOUBLE_EQ(MAX_D, dist.at(1000).first);
+    EXPECT_EQ(kNullId, dist.at(1000).second);
+  }
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(GraphTestFixture, MultiSource)
+{
+  // Random graph with unit weights, large enough for levels to be expanded
+  // by several threads.
+  Rand::Seed(13);
+  const int count = 20000;
+  TypeParam graph;
+  for (int i = 0; i < count; ++i)
+    graph.AddVertex(std::to_string(i), i, i);
+  for (int i = 0; i < count * 3; ++i)
+  {
+    const VertexId a = Rand::IntUniform(0, count - 1);
+    const VertexId b = Rand::IntUniform(0, count - 1);
+    graph.AddEdge({a, b}, 0.0, 1.0);
+  }
+  const CsrGraph frozen = Freeze(graph);
+
+  for (VertexId from : {VertexId(0), VertexId(777)})
+  {
+    const auto visited = BreadthFirstSort(graph, from);
+    EXPECT_EQ(visited, BreadthFirstSort(frozen, from, 4));
+    EXPECT_EQ(visited, BreadthFirstSort(frozen, from, 0));
+  }
+
+  // With unit weights, the levels are the costs from the nearest source.
+  const std::vector<VertexId> sources = {5, 100, 100, 9000};
+  const auto dist = MultiSourceDijkstra(graph, sources);
+  EXPECT_EQ(dist, MultiSourceDijkstra(frozen, sources));
+  const auto levels = BreadthFirstLevels(frozen, sources);
+  EXPECT_EQ(levels, BreadthFirstLevels(frozen, sources, 4));
+  ASSERT_EQ(frozen.VertexCount(), levels.size());
+  for (std::size_t i = 0; i < levels.size(); ++i)
+  {
+    const CostInfo &info = dist.at(frozen.Id(i));
+    if (levels[i] == CsrGraph::kNullIndex)
+    {
+      EXPECT_DOUBLE_EQ(MAX_D, info.first);
+      EXPECT_EQ(kNullId, info.second);
+    }
+    else
+    {
+      EXPECT_DOUBLE_EQ(static_cast<double>(levels[i]), info.first);
+    }
+  }
+
+  // Costs are the minimum over single source searches.
+  std::vector<std::map<VertexId, CostInfo>> single;
+  for (const VertexId &s : sources)
+    single.push_back(Dijkstra(frozen, s));
+  for (VertexId v : {VertexId(5), VertexId(6), VertexId(4321)})
+  {
+    double best = MAX_D;
+    for (const auto &d : single)
+      best = std::min(best, d.at(v).first);
+    EXPECT_DOUBLE_EQ(best, dist.at(v).first);
+  }
+  for (const VertexId &s : sources)
+    EXPECT_EQ(CostInfo(0.0, s), dist.at(s));
+
+  // Following the previous vertices leads to a source.
+  VertexId nearest = 4321;
+  for (int steps = 0; dist.at(nearest).second != nearest && steps < count;
+       ++steps)
+  {
+    nearest = dist.at(nearest).second;
+  }
+  EXPECT_NE(sources.end(),
+    std::find(sources.begin(), sources.end(), nearest));
+  ExpectPath(graph, dist, nearest, 4321, dist.at(4321).first);
+
+  // No sources and inexistent vertices.
+  for (auto const &entry : MultiSourceDijkstra(frozen, {}))
+    EXPECT_DOUBLE_EQ(MAX_D, entry.second.first);
+  EXPECT_TRUE(MultiSourceDijkstra(graph, {1, count + 1}).empty());
+  EXPECT_TRUE(MultiSourceDijkstra(frozen, {count + 1}).empty());
+  EXPECT_TRUE(BreadthFirstLevels(frozen, {1, count + 1}).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(GraphTestFixture, TopologicalLevels)
+{
+  ///     0---->1---->3               |
+  ///     |           ^               |
+  ///     v           |               |
+  ///     2-----------+     4         |
+  DirectedGraph<int, double> graph(
+  {
+    // Vertices.
+    {{"0", 0, 0}, {"1", 1, 1}, {"2", 2, 2}, {"3", 3, 3}, {"4", 4, 4}},
+    // Edges, including a parallel one.
+    {{{0, 1}, 1.0}, {{0, 2}, 1.0}, {{1, 3}, 1.0}, {{2, 3}, 1.0},
+     {{2, 3}, 1.0}}
+  });
+
+  auto levels = TopologicalLevels(graph);
+  ASSERT_EQ(3u, levels.size());
+  EXPECT_EQ((std::vector<VertexId>{0, 4}), levels[0]);
+  EXPECT_EQ((std::vector<VertexId>{1, 2}), levels[1]);
+  EXPECT_EQ((std::vector<VertexId>{3}), levels[2]);
+  EXPECT_EQ((std::vector<VertexId>{0, 4, 1, 2, 3}), TopologicalSort(graph));
+  EXPECT_FALSE(HasCycle(graph));
+
+  // Removed edges are not followed.
+  graph.RemoveEdge(0);
+  levels = TopologicalLevels(graph);
+  ASSERT_EQ(3u, levels.size());
+  EXPECT_EQ((std::vector<VertexId>{0, 1, 4}), levels[0]);
+  EXPECT_EQ((std::vector<VertexId>{2}), levels[1]);
+
+  // A cycle.
+  graph.AddEdge({3, 0}, 1.0);
+  EXPECT_TRUE(HasCycle(graph));
+  EXPECT_TRUE(TopologicalLevels(graph).empty());
+  EXPECT_TRUE(TopologicalSort(graph).empty());
+
+  // A self loop.
+  DirectedGraph<int, double, SlotMapStorage> loop(
+    {{{"0", 0, 0}}, {{{0, 0}, 1.0}}});
+  EXPECT_TRUE(HasCycle(loop));
+
+  // An empty graph.
+  DirectedGraph<int, double> empty;
+  EXPECT_FALSE(HasCycle(empty));
+  EXPECT_TRUE(TopologicalLevels(empty).empty());
+}
+
+/////////////////////////////////////////////////
+TEST(GraphTestFixture, StronglyConnectedComponents)
+{
+  ///     0---->1---->3<--->4         |
+  ///     ^     |                     |
+  ///     |     v                     |
+  ///     +-----2     5               |
+  DirectedGraph<int, double> graph(
+  {
+    // Vertices.
+    {{"0", 0, 0}, {"1", 1, 1}, {"2", 2, 2}, {"3", 3, 3}, {"4", 4, 4},
+     {"5", 5, 5}},
+    // Edges.
+    {{{0, 1}, 1.0}, {{1, 2}, 1.0}, {{2, 0}, 1.0}, {{1, 3}, 1.0},
+     {{3, 4}, 1.0}, {{4, 3}, 1.0}}
+  });
+
+  auto components = StronglyConnectedComponents(graph);
+  ASSERT_EQ(3u, components.size());
+  // {3, 4} is reached from {0, 1, 2}, so it comes first.
+  EXPECT_EQ((std::vector<VertexId>{3, 4}), components[0]);
+  EXPECT_EQ((std::vector<VertexId>{0, 1, 2}), components[1]);
+  EXPECT_EQ((std::vector<VertexId>{5}), components[2]);
+
+  // A long chain does not overflow the stack.
+  DirectedGraph<int, double, SlotMapStorage> chain;
+  const VertexId n = 100000;
+  for (VertexId i = 0; i < n; ++i)
+    chain.AddVertex(std::to_string(i), 0, i);
+  for (VertexId i = 1; i < n; ++i)
+    chain.AddEdge({i - 1, i}, 1.0);
+  EXPECT_EQ(n, StronglyConnectedComponents(chain).size());
+  chain.AddEdge({n - 1, 0}, 1.0);
+  components = StronglyConnectedComponents(chain);
+  ASSERT_EQ(1u, components.size());
+  EXPECT_EQ(n, components[0].size());
+}
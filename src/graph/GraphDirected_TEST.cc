@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "gz/math/graph/Graph.hh"
 
@@ -282,6 +283,60 @@ TEST(GraphTest, IncidentsTo)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(GraphTest, Views)
+{
+  // Create a graph with edges [(v0-->v0), (v0-->v1), (v1-->v2), (v2-->v0),
+  // (v0-->v1)]
+  DirectedGraph<int, double> graph(
+  {
+    {{"0", 0, 0}, {"1", 1, 1}, {"2", 2, 2}},
+    {{{0, 0}, 1.0}, {{0, 1}, 2.0}, {{1, 2}, 3.0}, {{2, 0}, 4.0},
+     {{0, 1}, 5.0}}
+  });
+
+  // Inexistent vertex.
+  EXPECT_TRUE(graph.AdjacentsFromView(kNullId).Empty());
+  EXPECT_TRUE(graph.IncidentsToView(99).Empty());
+  EXPECT_EQ(0u, graph.IncidentsFromView(99).Size());
+
+  // Vertices are visited once per edge, in edge order.
+  std::vector<VertexId> ids;
+  for (auto const &adj : graph.AdjacentsFromView(0))
+  {
+    EXPECT_EQ(adj.first, adj.second.get().Id());
+    ids.push_back(adj.first);
+  }
+  EXPECT_EQ((std::vector<VertexId>{0, 1, 1}), ids);
+
+  ids.clear();
+  for (auto const &adj : graph.AdjacentsToView(0))
+    ids.push_back(adj.first);
+  EXPECT_EQ((std::vector<VertexId>{0, 2}), ids);
+
+  std::vector<EdgeId> edgeIds;
+  for (auto const &incident : graph.IncidentsFromView(0))
+  {
+    EXPECT_EQ(incident.first, incident.second.get().Id());
+    edgeIds.push_back(incident.first);
+  }
+  EXPECT_EQ((std::vector<EdgeId>{0, 1, 4}), edgeIds);
+
+  edgeIds.clear();
+  for (auto const &incident : graph.IncidentsToView(1))
+    edgeIds.push_back(incident.first);
+  EXPECT_EQ((std::vector<EdgeId>{1, 4}), edgeIds);
+  EXPECT_EQ(1u, graph.IncidentsToView(2).Size());
+
+  // The views match the maps.
+  for (VertexId v = 0; v < 3; ++v)
+  {
+    EXPECT_EQ(graph.IncidentsFrom(v).size(),
+      graph.IncidentsFromView(v).Size());
+    EXPECT_EQ(graph.IncidentsTo(v).size(), graph.IncidentsToView(v).Size());
+  }
+}
+
 /////////////////////////////////////////////////
 TEST(GraphTest, InDegree)
 {
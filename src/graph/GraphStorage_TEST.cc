@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gz/math/graph/GraphStorage.hh"
+
+using namespace gz;
+using namespace math;
+using namespace graph;
+
+/////////////////////////////////////////////////
+TEST(SlotMapTest, Empty)
+{
+  SlotMap<uint64_t, std::string> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(0u, map.size());
+  EXPECT_TRUE(map.begin() == map.end());
+  EXPECT_TRUE(map.find(3) == map.end());
+  EXPECT_EQ(0u, map.count(3));
+  EXPECT_EQ(0u, map.erase(3));
+}
+
+/////////////////////////////////////////////////
+TEST(SlotMapTest, InsertFindErase)
+{
+  SlotMap<uint64_t, std::string> map;
+  auto ret = map.insert({200, "c"});
+  EXPECT_TRUE(ret.second);
+  EXPECT_EQ("c", ret.first->second);
+  EXPECT_TRUE(map.insert({0, "a"}).second);
+  map[70] = "b";
+
+  // Inserting an used key keeps the element.
+  ret = map.insert({70, "x"});
+  EXPECT_FALSE(ret.second);
+  EXPECT_EQ("b", ret.first->second);
+
+  EXPECT_EQ(3u, map.size());
+  EXPECT_EQ(1u, map.count(70));
+  EXPECT_EQ(0u, map.count(71));
+  ASSERT_TRUE(map.find(200) != map.end());
+  EXPECT_EQ(200u, map.find(200)->first);
+
+  // Iteration is in key order and skips empty slots and pages.
+  std::vector<uint64_t> keys;
+  for (const auto &[key, value] : map)
+    keys.push_back(key);
+  EXPECT_EQ((std::vector<uint64_t>{0, 70, 200}), keys);
+
+  // References survive insertions that add pages.
+  const std::string *b = &map.find(70)->second;
+  map[5000] = "d";
+  EXPECT_EQ(b, &map.find(70)->second);
+
+  EXPECT_EQ(1u, map.erase(70));
+  EXPECT_EQ(0u, map.erase(70));
+  EXPECT_EQ(3u, map.size());
+  EXPECT_TRUE(map.find(70) == map.end());
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.begin() == map.end());
+}
+
+/////////////////////////////////////////////////
+TEST(SlotMapTest, Copy)
+{
+  SlotMap<uint64_t, int> map;
+  map[1] = 10;
+  map[100] = 20;
+
+  SlotMap<uint64_t, int> copy(map);
+  copy[1] = 30;
+  EXPECT_EQ(10, map[1]);
+  EXPECT_EQ(30, copy[1]);
+  EXPECT_EQ(2u, copy.size());
+  EXPECT_EQ(20, copy.find(100)->second);
+
+  SlotMap<uint64_t, int> moved(std::move(copy));
+  EXPECT_EQ(2u, moved.size());
+  EXPECT_EQ(30, moved[1]);
+}
@@ -306,6 +306,31 @@ TEST(UndirectedGraphTest, IncidentsTo)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(UndirectedGraphTest, Views)
+{
+  // Create a graph with edges [(v0-v1), (v1-v2), (v2-v0)]
+  UndirectedGraph<int, double> graph(
+  {
+    {{"0", 0, 0}, {"1", 1, 1}, {"2", 2, 2}},
+    {{{0, 1}, 2.0}, {{1, 2}, 3.0}, {{2, 0}, 4.0}}
+  });
+
+  // Both directions are the same.
+  std::vector<VertexId> from;
+  for (auto const &adj : graph.AdjacentsFromView(2))
+    from.push_back(adj.first);
+  std::vector<VertexId> to;
+  for (auto const &adj : graph.AdjacentsToView(2))
+    to.push_back(adj.first);
+  EXPECT_EQ((std::vector<VertexId>{1, 0}), from);
+  EXPECT_EQ(from, to);
+
+  EXPECT_EQ(2u, graph.IncidentsFromView(0).Size());
+  EXPECT_EQ(2u, graph.IncidentsToView(0).Size());
+  EXPECT_TRUE(graph.IncidentsFromView(3).Empty());
+}
+
 /////////////////////////////////////////////////
 TEST(UndirectedGraphTest, InDegree)
 {
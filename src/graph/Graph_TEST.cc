@@ -16,6 +16,9 @@
 */
 
 #include <gtest/gtest.h>
+#include <cstddef>
+#include <memory_resource>
+#include <sstream>
 #include <string>
 
 #include "gz/math/graph/Graph.hh"
@@ -52,9 +55,45 @@ class MockEdgesFullUndirectedGraph : public UndirectedGraph<V, E>
   }
 };
 
+// A memory resource that counts the bytes in use.
+class CountingResource : public std::pmr::memory_resource
+{
+  // Bytes allocated and not yet deallocated.
+  public: std::size_t bytes = 0;
+
+  // Number of allocations.
+  public: std::size_t allocations = 0;
+
+  private: void *do_allocate(std::size_t _bytes,
+                             std::size_t _alignment) override
+  {
+    this->bytes += _bytes;
+    ++this->allocations;
+    return std::pmr::new_delete_resource()->allocate(_bytes, _alignment);
+  }
+
+  private: void do_deallocate(void *_p, std::size_t _bytes,
+                              std::size_t _alignment) override
+  {
+    this->bytes -= _bytes;
+    std::pmr::new_delete_resource()->deallocate(_p, _bytes, _alignment);
+  }
+
+  private: bool do_is_equal(
+    const std::pmr::memory_resource &_other) const noexcept override
+  {
+    return this == &_other;
+  }
+};
+
 // The list of graphs we want to test.
-using GraphTypes = ::testing::Types<DirectedGraph<int, double>,
-                                    UndirectedGraph<int, double>>;
+using GraphTypes = ::testing::Types<
+  DirectedGraph<int, double>,
+  UndirectedGraph<int, double>,
+  DirectedGraph<int, double, SlotMapStorage>,
+  UndirectedGraph<int, double, SlotMapStorage>,
+  DirectedGraph<int, double, PmrStorage>,
+  UndirectedGraph<int, double, PmrStorage>>;
 TYPED_TEST_SUITE(GraphTestFixture, GraphTypes, );
 
 /////////////////////////////////////////////////
@@ -181,6 +220,167 @@ TYPED_TEST(GraphTestFixture, BadUniformInitialization)
   }
 }
 
+/////////////////////////////////////////////////
+TYPED_TEST(GraphTestFixture, BulkInitialization)
+{
+  // Unsorted Ids, a repeated Id and an invalid edge in the middle.
+  TypeParam bulk(
+  {
+    {{"b", 1, 7}, {"a", 2, 3}, {"b", 3, 5}, {"c", 4, 3}},
+    {{{7, 3}, 1.0, 2.0}, {{3, 9}, 2.0}, {{5, 5}, 3.0}, {{3, 5}, 4.0}}
+  });
+
+  TypeParam incremental;
+  incremental.AddVertex("b", 1, 7);
+  incremental.AddVertex("a", 2, 3);
+  incremental.AddVertex("b", 3, 5);
+  incremental.AddEdge({7, 3}, 1.0, 2.0);
+  incremental.AddEdge({3, 9}, 2.0);
+  incremental.AddEdge({5, 5}, 3.0);
+  incremental.AddEdge({3, 5}, 4.0);
+
+  std::ostringstream bulkOut, incrementalOut;
+  bulkOut << bulk;
+  incrementalOut << incremental;
+  EXPECT_EQ(incrementalOut.str(), bulkOut.str());
+
+  EXPECT_EQ(3u, bulk.Vertices().size());
+  EXPECT_EQ(2, bulk.VertexFromId(3).Data());
+  EXPECT_EQ(2u, bulk.Vertices("b").size());
+  EXPECT_EQ(3u, bulk.Edges().size());
+  for (EdgeId id = 0; id < 3; ++id)
+  {
+    EXPECT_EQ(incremental.EdgeFromId(id).Vertices(),
+              bulk.EdgeFromId(id).Vertices());
+  }
+  EXPECT_EQ(incremental.AdjacentsFrom(3).size(),
+            bulk.AdjacentsFrom(3).size());
+  EXPECT_EQ(incremental.AdjacentsTo(5).size(), bulk.AdjacentsTo(5).size());
+
+  // New edges continue the sequence of Ids.
+  EXPECT_EQ(3u, bulk.AddEdge({7, 5}, 5.0).Id());
+
+  // Names are indexed.
+  EXPECT_EQ(2u, bulk.RemoveVertices("b"));
+  EXPECT_EQ(1u, bulk.Vertices().size());
+  EXPECT_EQ(0u, bulk.Edges().size());
+}
+
+/////////////////////////////////////////////////
+TYPED_TEST(GraphTestFixture, SaveLoad)
+{
+  TypeParam graph(
+  {
+    {{"0", 0, 0}, {"1", 1, 1}, {"", 2, 2}, {"three", 3, 10}},
+    {{{0, 1}, 0.5, 2.0}, {{1, 2}, 1.5}, {{2, 10}, 2.5, 3.0}, {{10, 0}, 3.5}}
+  });
+  graph.RemoveEdge(1);
+  graph.AddVertex("4", 4);
+
+  std::ostringstream stream;
+  ASSERT_TRUE(graph.Save(stream));
+  const std::string bytes = stream.str();
+
+  TypeParam loaded;
+  loaded.AddVertex("old", 9);
+  ASSERT_TRUE(loaded.Load(bytes.data(), bytes.size()));
+
+  std::ostringstream expected, actual;
+  expected << graph;
+  actual << loaded;
+  EXPECT_EQ(expected.str(), actual.str());
+  for (auto const &[id, vertex] : graph.Vertices())
+  {
+    EXPECT_EQ(vertex.get().Name(), loaded.VertexFromId(id).Name());
+    EXPECT_EQ(vertex.get().Data(), loaded.VertexFromId(id).Data());
+  }
+  for (auto const &[id, edge] : graph.Edges())
+  {
+    EXPECT_EQ(edge.get().Vertices(), loaded.EdgeFromId(id).Vertices());
+    EXPECT_DOUBLE_EQ(edge.get().Data(), loaded.EdgeFromId(id).Data());
+    EXPECT_DOUBLE_EQ(edge.get().Weight(), loaded.EdgeFromId(id).Weight());
+  }
+  EXPECT_EQ(1u, loaded.Vertices("three").size());
+  EXPECT_EQ(graph.AdjacentsFrom(0).size(), loaded.AdjacentsFrom(0).size());
+
+  // Ids handed out afterwards are the same.
+  EXPECT_EQ(graph.AddVertex("5", 5).Id(), loaded.AddVertex("5", 5).Id());
+  EXPECT_EQ(graph.AddEdge({0, 2}, 1.0).Id(),
+            loaded.AddEdge({0, 2}, 1.0).Id());
+
+  // A truncated graph is rejected and leaves the graph empty.
+  EXPECT_FALSE(loaded.Load(bytes.data(), bytes.size() / 2));
+  EXPECT_TRUE(loaded.Empty());
+  EXPECT_FALSE(loaded.Load(nullptr, 0));
+
+  // A corrupt header is rejected.
+  std::string corrupt = bytes;
+  corrupt[0] = 'X';
+  EXPECT_FALSE(loaded.Load(corrupt.data(), corrupt.size()));
+}
+
+/////////////////////////////////////////////////
+TEST(GraphTest, SaveLoadTypes)
+{
+  DirectedGraph<int, double> directed({{{"0", 0, 0}}, {}});
+  std::ostringstream stream;
+  ASSERT_TRUE(directed.Save(stream));
+  const std::string bytes = stream.str();
+
+  UndirectedGraph<int, double> undirected;
+  EXPECT_FALSE(undirected.Load(bytes.data(), bytes.size()));
+  DirectedGraph<int, float> otherData;
+  EXPECT_FALSE(otherData.Load(bytes.data(), bytes.size()));
+
+  // The storage is not part of the format.
+  DirectedGraph<int, double, SlotMapStorage> slotMap;
+  EXPECT_TRUE(slotMap.Load(bytes.data(), bytes.size()));
+  EXPECT_EQ(1u, slotMap.Vertices().size());
+}
+
+/////////////////////////////////////////////////
+TEST(GraphTest, MemoryResource)
+{
+  CountingResource resource;
+  {
+    UndirectedGraph<int, double, PmrStorage> graph(
+      {{"0", 0, 0}, {"1", 1, 1}, {"2", 2, 2}},
+      {{{0, 1}, 0.5}, {{1, 2}, 1.5}},
+      &resource);
+    const std::size_t allocations = resource.allocations;
+    EXPECT_LT(0u, allocations);
+
+    // Vertices, edges, adjacency lists and names are all allocated from
+    // the resource.
+    graph.AddVertex("3", 3);
+    graph.AddEdge({2, 3}, 2.5);
+    EXPECT_LE(allocations + 5u, resource.allocations);
+    EXPECT_EQ(4u, graph.Vertices().size());
+    EXPECT_EQ(2u, graph.AdjacentsFrom(2).size());
+
+    // Loading keeps the resource.
+    std::ostringstream stream;
+    ASSERT_TRUE(graph.Save(stream));
+    const std::string bytes = stream.str();
+    graph.RemoveVertex(0);
+    const std::size_t beforeLoad = resource.allocations;
+    ASSERT_TRUE(graph.Load(bytes.data(), bytes.size()));
+    EXPECT_LT(beforeLoad, resource.allocations);
+    EXPECT_EQ(4u, graph.Vertices().size());
+  }
+  EXPECT_EQ(0u, resource.bytes);
+
+  // An arena can back a graph and be released at once.
+  std::pmr::monotonic_buffer_resource arena(&resource);
+  DirectedGraph<int, double, PmrStorage> graph(&arena);
+  for (int i = 0; i < 100; ++i)
+    graph.AddVertex(std::to_string(i), i);
+  for (VertexId i = 1; i < 100; ++i)
+    graph.AddEdge({i - 1, i}, 1.0);
+  EXPECT_EQ(99u, graph.Edges().size());
+  EXPECT_LT(0u, resource.bytes);
+}
+
 /////////////////////////////////////////////////
 TYPED_TEST(GraphTestFixture, VertexFromId)
 {
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "gz/math/Rand.hh"
+#include "gz/math/graph/Graph.hh"
+#include "gz/math/graph/GraphAlgorithms.hh"
+#include "gz/math/graph/IncrementalComponents.hh"
+
+using namespace gz;
+using namespace math;
+using namespace graph;
+
+/////////////////////////////////////////////////
+TEST(IncrementalComponentsTest, Empty)
+{
+  UndirectedGraph<int, double> graph;
+  IncrementalComponents components(graph);
+  EXPECT_EQ(0u, components.ComponentCount());
+  EXPECT_EQ(kNullId, components.Representative(0));
+  EXPECT_EQ(0u, components.ComponentSize(0));
+  EXPECT_FALSE(components.Connected(0, 0));
+  EXPECT_FALSE(components.Stale());
+}
+
+/////////////////////////////////////////////////
+TEST(IncrementalComponentsTest, Undirected)
+{
+  // Two components, built before the tracker.
+  UndirectedGraph<int, double> graph(
+  {
+    // Vertices.
+    {{"A", 0, 0}, {"B", 1, 1}, {"C", 2, 2}, {"D", 3, 3}, {"E", 4, 4}},
+    // Edges.
+    {{{0, 1}, 2.0}, {{1, 2}, 2.0}, {{3, 4}, 2.0}}
+  });
+  IncrementalComponents components(graph);
+  EXPECT_EQ(2u, components.ComponentCount());
+  EXPECT_TRUE(components.Connected(0, 2));
+  EXPECT_FALSE(components.Connected(0, 3));
+  EXPECT_EQ(3u, components.ComponentSize(1));
+  EXPECT_EQ(2u, components.ComponentSize(4));
+
+  // Insertions are merged without rebuilding.
+  EXPECT_TRUE(components.AddVertex("F", 5, 5).Valid());
+  EXPECT_EQ(3u, components.ComponentCount());
+  auto &edge = components.AddEdge({2, 3}, 1.0);
+  EXPECT_TRUE(edge.Valid());
+  EXPECT_FALSE(components.Stale());
+  EXPECT_EQ(2u, components.ComponentCount());
+  EXPECT_TRUE(components.Connected(0, 4));
+  EXPECT_EQ(5u, components.ComponentSize(0));
+  EXPECT_EQ(1u, components.ComponentSize(5));
+
+  // Invalid changes are ignored.
+  EXPECT_FALSE(components.AddVertex("G", 6, 5).Valid());
+  EXPECT_FALSE(components.AddEdge({0, 99}, 1.0).Valid());
+  EXPECT_FALSE(components.RemoveEdge(99));
+  EXPECT_FALSE(components.RemoveVertex(99));
+  EXPECT_FALSE(components.Stale());
+  EXPECT_EQ(2u, components.ComponentCount());
+
+  // Removals are applied in a single rebuild.
+  EXPECT_TRUE(components.RemoveEdge(edge.Id()));
+  EXPECT_TRUE(components.Stale());
+  EXPECT_TRUE(components.RemoveVertex(1));
+  EXPECT_TRUE(components.Stale());
+  EXPECT_EQ(4u, components.ComponentCount());
+  EXPECT_FALSE(components.Stale());
+  EXPECT_FALSE(components.Connected(0, 2));
+  EXPECT_TRUE(components.Connected(3, 4));
+  EXPECT_EQ(kNullId, components.Representative(1));
+
+  // Changes made directly to the graph need a rebuild.
+  graph.AddEdge({0, 2}, 1.0);
+  EXPECT_FALSE(components.Connected(0, 2));
+  components.Rebuild();
+  EXPECT_TRUE(components.Connected(0, 2));
+  EXPECT_EQ(3u, components.ComponentCount());
+}
+
+/////////////////////////////////////////////////
+TEST(IncrementalComponentsTest, Directed)
+{
+  // The direction of the edges is ignored.
+  DirectedGraph<int, double> graph(
+  {
+    // Vertices.
+    {{"A", 0, 0}, {"B", 1, 1}, {"C", 2, 2}},
+    // Edges.
+    {{{0, 1}, 2.0}}
+  });
+  IncrementalComponents components(graph);
+  EXPECT_EQ(2u, components.ComponentCount());
+  components.AddEdge({2, 1}, 1.0);
+  EXPECT_EQ(1u, components.ComponentCount());
+  EXPECT_TRUE(components.Connected(0, 2));
+  EXPECT_TRUE(components.Connected(2, 0));
+}
+
+/////////////////////////////////////////////////
+TEST(IncrementalComponentsTest, Stream)
+{
+  // Random insertions and removals agree with ConnectedComponents.
+  Rand::Seed(17);
+  const int count = 100;
+  UndirectedGraph<int, double> graph;
+  IncrementalComponents components(graph);
+  for (int i = 0; i < count; ++i)
+    components.AddVertex(std::to_string(i), i, i);
+
+  std::vector<EdgeId> edges;
+  for (int step = 0; step < 300; ++step)
+  {
+    if (step % 4 == 3 && !edges.empty())
+    {
+      const auto pos = Rand::IntUniform(0, int(edges.size()) - 1);
+      EXPECT_TRUE(components.RemoveEdge(edges[pos]));
+      edges.erase(edges.begin() + pos);
+    }
+    else
+    {
+      const VertexId a = Rand::IntUniform(0, count - 1);
+      const VertexId b = Rand::IntUniform(0, count - 1);
+      edges.push_back(components.AddEdge({a, b}, 1.0).Id());
+    }
+
+    if (step % 10 != 0)
+      continue;
+
+    const auto expected = ConnectedComponents(graph);
+    ASSERT_EQ(expected.size(), components.ComponentCount());
+    for (auto const &component : expected)
+    {
+      const auto vertices = component.Vertices();
+      const VertexId first = vertices.begin()->first;
+      EXPECT_EQ(vertices.size(), components.ComponentSize(first));
+      for (auto const &vertexPair : vertices)
+        EXPECT_TRUE(components.Connected(first, vertexPair.first));
+    }
+  }
+}
@@ -15,13 +15,16 @@
  *
 */
 
+#include <cstddef>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <gz/math/Angle.hh>
 #include <pybind11/operators.h>
 
 #include "Angle.hh"
+#include "Buffer.hh"
 
 using namespace pybind11::literals;
 
@@ -31,6 +34,17 @@ namespace math
 {
 namespace python
 {
+/// Get a new array of the shape of another one
+/**
+ * \param[in] _array The other array
+ * \return The new array
+ */
+MathArray<double> arrayLike(const MathArray<double> &_array)
+{
+  return MathArray<double>(std::vector<py::ssize_t>(
+      _array.shape(), _array.shape() + _array.ndim()));
+}
+
 void defineMathAngle(py::module &m, const std::string &typestr)
 {
   using Class = gz::math::Angle;
@@ -65,6 +79,59 @@ void defineMathAngle(py::module &m, const std::string &typestr)
     .def("normalized",
          &Class::Normalized,
          "Return a normalized vector")
+    .def_static("wrap",
+         [](const MathArray<double> &_angles)
+         {
+           MathArray<double> out = arrayLike(_angles);
+           const double *in = _angles.data();
+           double *data = out.mutable_data();
+           const auto count = static_cast<std::size_t>(_angles.size());
+           {
+             py::gil_scoped_release release;
+             Class::Wrap(in, data, count);
+           }
+           return out;
+         },
+         py::arg("angles"),
+         "Get a NumPy array of angles in radians wrapped to (-pi, pi]")
+    .def_static("unwrap",
+         [](const MathArray<double> &_angles)
+         {
+           MathArray<double> out = arrayLike(_angles);
+           const double *in = _angles.data();
+           double *data = out.mutable_data();
+           const auto count = static_cast<std::size_t>(_angles.size());
+           {
+             py::gil_scoped_release release;
+             Class::Unwrap(in, data, count);
+           }
+           return out;
+         },
+         py::arg("angles"),
+         "Get a NumPy array of angles in radians, such as a heading over "
+         "time, unwrapped so that no jump is larger than pi")
+    .def_static("sin_cos",
+         [](const MathArray<double> &_angles, bool _fast)
+         {
+           MathArray<double> sin = arrayLike(_angles);
+           MathArray<double> cos = arrayLike(_angles);
+           const double *in = _angles.data();
+           double *sinData = sin.mutable_data();
+           double *cosData = cos.mutable_data();
+           const auto count = static_cast<std::size_t>(_angles.size());
+           {
+             py::gil_scoped_release release;
+             if (_fast)
+               Class::FastSinCos(in, sinData, cosData, count);
+             else
+               Class::SinCos(in, sinData, cosData, count);
+           }
+           return py::make_tuple(sin, cos);
+         },
+         py::arg("angles"), py::arg("fast") = false,
+         "Get NumPy arrays of the sines and cosines of angles in radians. "
+         "With fast, they are computed with polynomials, which differ by "
+         "less than 1e-15 for angles up to 1e6 in magnitude")
     .def(py::self + py::self)
     .def(py::self += py::self)
     .def(py::self * py::self)
@@ -0,0 +1,331 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MATH_PYTHON__BUFFER_HH_
+#define GZ_MATH_PYTHON__BUFFER_HH_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+namespace py = pybind11;
+
+namespace gz
+{
+namespace math
+{
+namespace python
+{
+/// Describe the storage of a math type as a row-major array, for
+/// def_buffer, so that NumPy and memoryview can use it without copying.
+/**
+ * \param[in] _data Pointer to the first value
+ * \param[in] _shape Number of values along each dimension
+ * \return The buffer description
+ */
+template<typename T>
+py::buffer_info mathBufferInfo(T *_data,
+                               const std::vector<py::ssize_t> &_shape)
+{
+  std::vector<py::ssize_t> strides(_shape.size());
+  py::ssize_t stride = sizeof(T);
+  for (std::size_t i = _shape.size(); i-- > 0;)
+  {
+    strides[i] = stride;
+    stride *= _shape[i];
+  }
+  return py::buffer_info(_data, sizeof(T), py::format_descriptor<T>::format(),
+                         static_cast<py::ssize_t>(_shape.size()), _shape,
+                         strides);
+}
+
+/// Read a value of a buffer, converted to T
+/**
+ * \param[in] _ptr Pointer to the value
+ * \param[in] _format Format of the value, as in the struct module
+ * \param[in] _size Size of the value in bytes
+ * \param[out] _value The value
+ * \return True if the format is a supported number format
+ */
+template<typename T>
+bool readBufferValue(const char *_ptr, const std::string &_format,
+                     py::ssize_t _size, T &_value)
+{
+  // Skip the byte order, which is native for the buffers we support
+  std::size_t pos = _format.find_first_not_of("@=<");
+  if (pos == std::string::npos || pos + 1 != _format.size())
+    return false;
+
+  auto read = [&](auto _type) -> bool
+  {
+    using Type = decltype(_type);
+    if (_size != static_cast<py::ssize_t>(sizeof(Type)))
+      return false;
+    std::memcpy(&_type, _ptr, sizeof(Type));
+    _value = static_cast<T>(_type);
+    return true;
+  };
+
+  switch (_format[pos])
+  {
+    case 'f': return read(float());
+    case 'd': return read(double());
+    case 'b': return read(int8_t());
+    case 'B': return read(uint8_t());
+    case 'h': case 'i': case 'l': case 'q':
+      return read(int16_t()) || read(int32_t()) || read(int64_t());
+    case 'H': case 'I': case 'L': case 'Q':
+      return read(uint16_t()) || read(uint32_t()) || read(uint64_t());
+    default: return false;
+  }
+}
+
+/// Copy the values of a buffer, such as a NumPy array, into the storage
+/// of a math type, in row-major order. Any shape with the right number of
+/// values is accepted, and the values can be of any number type.
+/**
+ * \param[in] _buffer Buffer to copy
+ * \param[out] _data Pointer to the first value of the math type
+ * \param[in] _size Number of values of the math type
+ * \throws py::value_error if the buffer doesn't have _size numbers
+ */
+template<typename T>
+void copyFromBuffer(py::buffer _buffer, T *_data, py::ssize_t _size)
+{
+  const py::buffer_info info = _buffer.request();
+  py::ssize_t size = 1;
+  for (py::ssize_t n : info.shape)
+    size *= n;
+  if (size != _size)
+  {
+    throw py::value_error("Expected a buffer of " + std::to_string(_size) +
+                          " values, got " + std::to_string(size));
+  }
+
+  // Walk the buffer in row-major order, whatever its strides
+  std::vector<py::ssize_t> index(info.shape.size(), 0);
+  for (py::ssize_t i = 0; i < _size; ++i)
+  {
+    const char *ptr = static_cast<const char *>(info.ptr);
+    for (std::size_t d = 0; d < index.size(); ++d)
+      ptr += index[d] * info.strides[d];
+    if (!readBufferValue(ptr, info.format, info.itemsize, _data[i]))
+    {
+      throw py::value_error("Unsupported buffer format '" + info.format +
+                            "', expected numbers");
+    }
+
+    for (std::size_t d = index.size(); d-- > 0;)
+    {
+      if (++index[d] < info.shape[d])
+        break;
+      index[d] = 0;
+    }
+  }
+}
+
+/// Get the contiguous bytes of a buffer, such as bytes or a bytearray
+/**
+ * \param[in] _buffer The buffer
+ * \param[in] _unit The size of the buffer must be a multiple of _unit
+ * \return The buffer description, with the size in bytes in info.size
+ * \throws py::value_error if the buffer isn't contiguous or its size isn't a
+ * multiple of _unit
+ */
+inline py::buffer_info contiguousBytes(py::buffer _buffer, std::size_t _unit)
+{
+  py::buffer_info info = _buffer.request();
+  if (info.ndim > 1 || (info.ndim == 1 && info.strides[0] != info.itemsize))
+    throw py::value_error("Expected a contiguous buffer of bytes");
+  info.size *= info.itemsize;
+  if (_unit == 0 || info.size % static_cast<py::ssize_t>(_unit) != 0)
+  {
+    throw py::value_error("Expected a multiple of " + std::to_string(_unit) +
+                          " bytes, got " + std::to_string(info.size));
+  }
+  return info;
+}
+
+/// Pickle support for a math type, whose state is the bytes of its Size
+/// contiguous values in native byte order
+/**
+ * \param[in] _data Called with a math type, returns a pointer to its first
+ * value
+ * \return The argument of py::class_::def
+ */
+template<typename Class, typename T, std::size_t Size, typename Data>
+auto mathPickle(Data _data)
+{
+  return py::pickle(
+      [_data](const Class &_self)
+      {
+        Class copy(_self);
+        return py::bytes(reinterpret_cast<const char *>(_data(copy)),
+                         Size * sizeof(T));
+      },
+      [_data](py::bytes _state)
+      {
+        const std::string state = _state;
+        if (state.size() != Size * sizeof(T))
+          throw py::value_error("Invalid state");
+        Class result;
+        std::memcpy(_data(result), state.data(), Size * sizeof(T));
+        return result;
+      });
+}
+
+/// Pack math types into a single bytes object, made of the Size contiguous
+/// values of each in native byte order
+/**
+ * \param[in] _data Called with a math type, returns a pointer to its first
+ * value
+ * \return A function of an iterable of math types returning bytes
+ */
+template<typename Class, typename T, std::size_t Size, typename Data>
+auto mathPack(Data _data)
+{
+  return [_data](py::iterable _values)
+  {
+    std::string bytes;
+    for (py::handle value : _values)
+    {
+      Class copy(value.cast<const Class &>());
+      bytes.append(reinterpret_cast<const char *>(_data(copy)),
+                   Size * sizeof(T));
+    }
+    return py::bytes(bytes);
+  };
+}
+
+/// Unpack math types packed by mathPack
+/**
+ * \param[in] _data Called with a math type, returns a pointer to its first
+ * value
+ * \return A function of a bytes-like object returning a list of math types
+ */
+template<typename Class, typename T, std::size_t Size, typename Data>
+auto mathUnpack(Data _data)
+{
+  return [_data](py::buffer _buffer)
+  {
+    const py::buffer_info info = contiguousBytes(_buffer, Size * sizeof(T));
+    const char *bytes = static_cast<const char *>(info.ptr);
+    const std::size_t count = info.size / (Size * sizeof(T));
+    py::list result(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      Class value;
+      std::memcpy(_data(value), bytes + i * Size * sizeof(T),
+                  Size * sizeof(T));
+      result[i] = py::cast(value);
+    }
+    return result;
+  };
+}
+
+/// A C-contiguous NumPy array. Other arrays and sequences are converted to
+/// it when passed to a function.
+template<typename T>
+using MathArray = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+/// Get the number of rows of an (N, _columns) NumPy array
+/**
+ * \param[in] _array The array
+ * \param[in] _columns Expected number of columns
+ * \return The number of rows N
+ * \throws py::value_error if the array doesn't have _columns columns
+ */
+template<typename T>
+std::size_t arrayRows(const MathArray<T> &_array, py::ssize_t _columns)
+{
+  if (_array.ndim() != 2 || _array.shape(1) != _columns)
+  {
+    throw py::value_error("Expected an array of shape (N, " +
+                          std::to_string(_columns) + ")");
+  }
+  return static_cast<std::size_t>(_array.shape(0));
+}
+
+/// Get the array a function writes its result to: a new array if _result is
+/// None, or _result itself, which must be a writeable C-contiguous array of
+/// the right type and shape
+/**
+ * \param[in] _result None, or the array provided by the caller
+ * \param[in] _shape Shape of the result
+ * \return The array to write the result to
+ * \throws py::value_error if _result can't hold the result
+ */
+template<typename T>
+MathArray<T> resultArray(const py::object &_result,
+                         const std::vector<py::ssize_t> &_shape)
+{
+  if (_result.is_none())
+    return MathArray<T>(_shape);
+
+  if (!py::isinstance<MathArray<T>>(_result) ||
+      !(py::reinterpret_borrow<py::array>(_result).flags() &
+        py::array::c_style))
+  {
+    throw py::value_error("Expected a C-contiguous result array of " +
+                          py::format_descriptor<T>::format() + " values");
+  }
+  auto result = py::reinterpret_borrow<MathArray<T>>(_result);
+  if (std::vector<py::ssize_t>(result.shape(), result.shape() +
+                               result.ndim()) != _shape)
+  {
+    throw py::value_error("The result array has the wrong shape");
+  }
+  if (!result.writeable())
+    throw py::value_error("The result array is read-only");
+  return result;
+}
+
+/// Run a batch kernel on the rows of an (N, _inColumns) NumPy array and
+/// return its (N, _outColumns) result. The kernel runs with the GIL
+/// released, so it must not touch Python objects.
+/**
+ * \param[in] _in The input array
+ * \param[in] _inColumns Number of columns of the input array
+ * \param[in] _outColumns Number of columns of the result
+ * \param[in] _kernel Called with the input values, the result values and
+ * the number of rows
+ * \return The result array
+ */
+template<typename T, typename Kernel>
+MathArray<T> mapArrayRows(const MathArray<T> &_in, py::ssize_t _inColumns,
+                          py::ssize_t _outColumns, Kernel _kernel)
+{
+  const std::size_t count = arrayRows(_in, _inColumns);
+  MathArray<T> out(std::vector<py::ssize_t>{
+      static_cast<py::ssize_t>(count), _outColumns});
+  const T *in = _in.data();
+  T *result = out.mutable_data();
+  {
+    py::gil_scoped_release release;
+    _kernel(in, result, count);
+  }
+  return out;
+}
+}  // namespace python
+}  // namespace math
+}  // namespace gz
+
+#endif  // GZ_MATH_PYTHON__BUFFER_HH_
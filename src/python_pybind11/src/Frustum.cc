@@ -77,6 +77,14 @@ void defineMathFrustum(py::module &m, const std::string &typestr)
         &Class::SetAspectRatio,
         "Get the aspect ratio, which is the width divided by height "
         "of the near or far planes.")
+   .def("set",
+        py::overload_cast<double, double, const gz::math::Angle&, double,
+                          const gz::math::Pose3d&>(&Class::Set),
+        "Set all properties of the frustum at once.")
+   .def("set",
+        py::overload_cast<const gz::math::Matrix4d&>(&Class::Set),
+        "Set the frustum from the product of a projection matrix and a "
+        "view matrix.")
    .def("pose",
         &Class::Pose,
         "Get the pose of the frustum")
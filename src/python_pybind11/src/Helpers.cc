@@ -153,16 +153,20 @@ void defineMathHelpers(py::module &m)
         &gz::math::variance<float>,
         "Get variance of vector of values")
    .def("max",
-        &gz::math::max<float>,
+        py::overload_cast<const std::vector<float> &>(
+          &gz::math::max<float>),
         "Get the maximum value of vector of values")
    .def("max",
-        &gz::math::max<int>,
+        py::overload_cast<const std::vector<int> &>(
+          &gz::math::max<int>),
         "Get the maximum value of vector of values")
    .def("min",
-        &gz::math::min<float>,
+        py::overload_cast<const std::vector<float> &>(
+          &gz::math::min<float>),
         "Get the minimum value of vector of values")
    .def("min",
-        &gz::math::min<int>,
+        py::overload_cast<const std::vector<int> &>(
+          &gz::math::min<int>),
         "Get the minimum value of vector of values")
    .def("equal",
         &gz::math::equal<float>,
@@ -193,10 +197,10 @@ void defineMathHelpers(py::module &m)
         &gz::math::roundUpMultiple,
         "Round a number up to the nearest multiple")
    .def("parse_int",
-        &gz::math::parseInt,
+        py::overload_cast<const std::string &>(&gz::math::parseInt),
         "parse string into an integer")
    .def("parse_float",
-        &gz::math::parseFloat,
+        py::overload_cast<const std::string &>(&gz::math::parseFloat),
         "parse string into an float")
    .def("is_time_string",
         &gz::math::isTimeString,
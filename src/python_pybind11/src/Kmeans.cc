@@ -44,7 +44,8 @@ void defineMathKmeans(py::module &m, const std::string &typestr)
        py::overload_cast<>(&Class::Observations, py::const_),
        "Get the observations to cluster.")
   .def("append_observations",
-       &Class::AppendObservations,
+       py::overload_cast<const std::vector<gz::math::Vector3d>&>
+        (&Class::AppendObservations),
        "Add observations to the cluster.")
   .def("cluster",
        [](Class &self, int k) {
@@ -26,6 +26,8 @@
 
 #include <gz/math/Matrix3.hh>
 
+#include "Buffer.hh"
+
 namespace py = pybind11;
 using namespace pybind11::literals;
 
@@ -56,6 +58,8 @@ void helpDefineMathMatrix3(py::module &m, const std::string &typestr)
     stream << si;
     return stream.str();
   };
+  // The values of a Class, contiguous in memory
+  auto values = [](Class &_m) { return &_m(0, 0); };
   std::string pyclass_name = typestr;
   py::class_<Class>(m,
                     pyclass_name.c_str(),
@@ -65,6 +69,14 @@ void helpDefineMathMatrix3(py::module &m, const std::string &typestr)
     .def(py::init<Class>())
     .def(py::init<T, T, T, T, T, T, T, T, T>())
     .def(py::init<const gz::math::Quaternion<T>&>())
+    .def(py::init([](py::buffer _buffer)
+         {
+           Class result;
+           copyFromBuffer(_buffer, &result(0, 0), 9);
+           return result;
+         }),
+         "Construct from a buffer, such as a NumPy array, of "
+         "3x3 numbers, in row-major order")
     .def(py::self - py::self)
     .def(py::self + py::self)
     .def(py::self * py::self)
@@ -114,6 +126,18 @@ void helpDefineMathMatrix3(py::module &m, const std::string &typestr)
     .def("transposed",
          &Class::Transposed,
          "Return the transpose of this matrix")
+    .def_buffer([](Class &_m) -> py::buffer_info
+       {
+         return mathBufferInfo(&_m(0, 0), {3, 3});
+       })
+    .def(mathPickle<Class, T, 9>(values))
+    .def_static("pack",
+         mathPack<Class, T, 9>(values),
+         "Pack matrices into a single bytes object, made of the values of "
+         "each in native byte order.")
+    .def_static("unpack",
+         mathUnpack<Class, T, 9>(values),
+         "Unpack a list of matrices from bytes made by pack.")
     .def("__copy__", [](const Class &self) {
       return Class(self);
     })
@@ -26,6 +26,8 @@
 
 #include <gz/math/Matrix4.hh>
 
+#include "Buffer.hh"
+
 namespace py = pybind11;
 using namespace pybind11::literals;
 
@@ -56,6 +58,8 @@ void helpDefineMathMatrix4(py::module &m, const std::string &typestr)
     stream << si;
     return stream.str();
   };
+  // The values of a Class, contiguous in memory
+  auto values = [](Class &_m) { return &_m(0, 0); };
   std::string pyclass_name = typestr;
   py::class_<Class>(m,
                     pyclass_name.c_str(),
@@ -66,6 +70,14 @@ void helpDefineMathMatrix4(py::module &m, const std::string &typestr)
     .def(py::init<T, T, T, T, T, T, T, T, T, T, T, T, T, T, T, T>())
     .def(py::init<const gz::math::Quaternion<T>&>())
     .def(py::init<const gz::math::Pose3<T>&>())
+    .def(py::init([](py::buffer _buffer)
+         {
+           Class result;
+           copyFromBuffer(_buffer, &result(0, 0), 16);
+           return result;
+         }),
+         "Construct from a buffer, such as a NumPy array, of "
+         "4x4 numbers, in row-major order")
     .def(py::self * py::self)
     .def(py::self * gz::math::Vector3<T>())
     .def(py::self == py::self)
@@ -97,7 +109,16 @@ void helpDefineMathMatrix4(py::module &m, const std::string &typestr)
          "Return the determinant of the matrix")
     .def("inverse",
          &Class::Inverse,
-         "Return the inverse matrix")
+         "Return the inverse matrix, which is inverse_affine if the last row "
+         "is exactly [0 0 0 1]")
+    .def("inverse_affine",
+         &Class::InverseAffine,
+         "Return the inverse of an affine matrix, without checking that it "
+         "is affine")
+    .def("inverse_rigid",
+         &Class::InverseRigid,
+         "Return the inverse of a rigid transform, such as a matrix made "
+         "from a Pose3, by transposing its rotation")
     .def("transpose",
          &Class::Transpose,
          "Transpose this matrix.")
@@ -136,6 +157,18 @@ void helpDefineMathMatrix4(py::module &m, const std::string &typestr)
          "Get transform which translates to _eye and rotates the X axis "
          "so it faces the _target. The rotation is such that Z axis is in the"
          "_up direction, if possible. The coordinate system is right-handed")
+    .def_buffer([](Class &_m) -> py::buffer_info
+       {
+         return mathBufferInfo(&_m(0, 0), {4, 4});
+       })
+    .def(mathPickle<Class, T, 16>(values))
+    .def_static("pack",
+         mathPack<Class, T, 16>(values),
+         "Pack matrices into a single bytes object, made of the values of "
+         "each in native byte order.")
+    .def_static("unpack",
+         mathUnpack<Class, T, 16>(values),
+         "Unpack a list of matrices from bytes made by pack.")
     .def("__copy__", [](const Class &self) {
       return Class(self);
     })
@@ -18,14 +18,18 @@
 #ifndef GZ_MATH_PYTHON__MATRIX6_HH_
 #define GZ_MATH_PYTHON__MATRIX6_HH_
 
+#include <array>
 #include <sstream>
 #include <string>
 
 #include <pybind11/pybind11.h>
 #include <pybind11/operators.h>
+#include <pybind11/stl.h>
 
 #include <gz/math/Matrix6.hh>
 
+#include "Buffer.hh"
+
 namespace py = pybind11;
 using namespace pybind11::literals;
 
@@ -56,6 +60,8 @@ void helpDefineMathMatrix6(py::module &_m, const std::string &_typestr)
     stream << _si;
     return stream.str();
   };
+  // The values of a Class, contiguous in memory
+  auto values = [](Class &_mat) { return &_mat(0, 0); };
   py::class_<Class>(_m,
                     _typestr.c_str(),
                     py::buffer_protocol(),
@@ -68,7 +74,20 @@ void helpDefineMathMatrix6(py::module &_m, const std::string &_typestr)
                   T, T, T, T, T, T,
                   T, T, T, T, T, T,
                   T, T, T, T, T, T>())
+    .def(py::init<const Matrix3<T>&, const Matrix3<T>&,
+                  const Matrix3<T>&, const Matrix3<T>&>(),
+         "Construct from the top-left, top-right, bottom-left and "
+         "bottom-right 3x3 submatrices")
+    .def(py::init([](py::buffer _buffer)
+         {
+           Class result;
+           copyFromBuffer(_buffer, &result(0, 0), 36);
+           return result;
+         }),
+         "Construct from a buffer, such as a NumPy array, of "
+         "6x6 numbers, in row-major order")
     .def(py::self * py::self)
+    .def(py::self * std::array<T, 6>())
     .def(py::self + py::self)
     .def(py::self == py::self)
     .def(py::self != py::self)
@@ -90,6 +109,46 @@ void helpDefineMathMatrix6(py::module &_m, const std::string &_typestr)
     .def("set_submatrix",
          &Class::SetSubmatrix,
          "Set one of the four 3x3 submatrices that compose this matrix.")
+    .def("multiply_block_diagonal",
+         &Class::MultiplyBlockDiagonal,
+         "Multiply by a matrix whose off-diagonal 3x3 submatrices are zero, "
+         "given its top-left and bottom-right submatrices.")
+    .def("inverse",
+         &Class::Inverse,
+         "Return the inverse matrix")
+    .def("solve",
+         [](const Class &_self, const std::array<T, 6> &_b) -> py::object
+         {
+           std::array<T, 6> x;
+           if (!_self.Solve(_b, x))
+             return py::none();
+           return py::cast(x);
+         },
+         "Solve this * x = b for a symmetric matrix, with an LDLT "
+         "factorization of its lower triangle. Return None if the matrix "
+         "is singular.")
+    .def("solve",
+         [](const Class &_self, const Class &_b) -> py::object
+         {
+           Class x;
+           if (!_self.Solve(_b, x))
+             return py::none();
+           return py::cast(x);
+         },
+         "Solve this * x = b for each column of b, for a symmetric matrix. "
+         "Return None if the matrix is singular.")
+    .def_buffer([](Class &_mat) -> py::buffer_info
+       {
+         return mathBufferInfo(&_mat(0, 0), {6, 6});
+       })
+    .def(mathPickle<Class, T, 36>(values))
+    .def_static("pack",
+         mathPack<Class, T, 36>(values),
+         "Pack matrices into a single bytes object, made of the values of "
+         "each in native byte order.")
+    .def_static("unpack",
+         mathUnpack<Class, T, 36>(values),
+         "Unpack a list of matrices from bytes made by pack.")
     .def("__copy__", [](const Class &_self) {
       return Class(_self);
     })
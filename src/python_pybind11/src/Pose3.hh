@@ -20,12 +20,15 @@
 
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <pybind11/pybind11.h>
 #include <pybind11/operators.h>
 
 #include <gz/math/Pose3.hh>
 
+#include "Buffer.hh"
+
 namespace py = pybind11;
 using namespace pybind11::literals;
 
@@ -56,6 +59,11 @@ void helpDefineMathPose3(py::module &m, const std::string &typestr)
     stream << si;
     return stream.str();
   };
+  // The values of a Class, the position then the rotation, contiguous
+  // in memory
+  static_assert(sizeof(Class) == 7 * sizeof(T),
+                "The values of a Pose3 must be contiguous");
+  auto values = [](Class &_p) { return &_p.Pos().X(); };
   std::string pyclass_name = typestr;
   py::class_<Class>(m,
                     pyclass_name.c_str(),
@@ -104,6 +112,27 @@ void helpDefineMathPose3(py::module &m, const std::string &typestr)
          py::overload_cast<const Class&>(
            &Class::CoordPositionAdd, py::const_),
          "Add one point to another: result = this + pose")
+    .def("coord_position_add",
+         [](const Class &_pose, const MathArray<T> &_points)
+         {
+           return mapArrayRows(_points, 3, 3,
+               [&_pose](const T *_in, T *_out, std::size_t _count)
+               {
+                 std::vector<gz::math::Vector3<T>> points(_count);
+                 for (std::size_t i = 0; i < _count; ++i)
+                   points[i].Set(_in[3*i], _in[3*i+1], _in[3*i+2]);
+                 _pose.CoordPositionAdd(points);
+                 for (std::size_t i = 0; i < _count; ++i)
+                 {
+                   _out[3*i] = points[i].X();
+                   _out[3*i+1] = points[i].Y();
+                   _out[3*i+2] = points[i].Z();
+                 }
+               });
+         },
+         "points"_a,
+         "Add this pose to each row of an (N, 3) array of points, "
+         "and return the (N, 3) array of results")
     .def("coord_position_sub",
          &Class::CoordPositionSub,
          "Subtract one position from another: result = this - pose")
@@ -141,6 +170,14 @@ void helpDefineMathPose3(py::module &m, const std::string &typestr)
     .def("roll", &Class::Roll, "Get the Roll value of the position")
     .def("pitch", &Class::Pitch, "Get the Pitch value of the position")
     .def("yaw", &Class::Yaw, "Get the Yaw value of the position")
+    .def(mathPickle<Class, T, 7>(values))
+    .def_static("pack",
+         mathPack<Class, T, 7>(values),
+         "Pack poses into a single bytes object, made of the values of "
+         "each in native byte order.")
+    .def_static("unpack",
+         mathUnpack<Class, T, 7>(values),
+         "Unpack a list of poses from bytes made by pack.")
     .def("__copy__", [](const Class &self) {
       return Class(self);
     })
@@ -20,15 +20,20 @@
 
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <pybind11/pybind11.h>
 #include <pybind11/operators.h>
 #include <pybind11/stl.h>
 
 #include <gz/math/Quaternion.hh>
+#include <gz/math/QuaternionArray.hh>
 #include <gz/math/Vector3.hh>
+#include <gz/math/Vector3Array.hh>
 #include <gz/math/Matrix3.hh>
 
+#include "Buffer.hh"
+
 namespace py = pybind11;
 using namespace pybind11::literals;
 
@@ -45,6 +50,83 @@ namespace python
  */
 void defineMathQuaternion(py::module &m, const std::string &typestr);
 
+/// Copy the rows of an (N, 4) array of w, x, y, z values to a
+/// QuaternionArray
+/**
+ * \param[in] _rows The values of the array
+ * \param[in] _count Number of rows
+ * \return The quaternions
+ */
+template<typename T>
+gz::math::QuaternionArray<T> quaternionArrayFromRows(const T *_rows,
+                                                     std::size_t _count)
+{
+  std::vector<gz::math::Quaternion<T>> quaternions;
+  quaternions.reserve(_count);
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    quaternions.emplace_back(_rows[4*i], _rows[4*i+1], _rows[4*i+2],
+                             _rows[4*i+3]);
+  }
+  return gz::math::QuaternionArray<T>(quaternions);
+}
+
+/// Copy a QuaternionArray to the rows of an (N, 4) array of w, x, y, z
+/// values
+/**
+ * \param[in] _quaternions The quaternions
+ * \param[out] _rows The values of the array
+ */
+template<typename T>
+void quaternionArrayToRows(const gz::math::QuaternionArray<T> &_quaternions,
+                           T *_rows)
+{
+  for (std::size_t i = 0; i < _quaternions.Size(); ++i)
+  {
+    const gz::math::Quaternion<T> q = _quaternions[i];
+    _rows[4*i] = q.W();
+    _rows[4*i+1] = q.X();
+    _rows[4*i+2] = q.Y();
+    _rows[4*i+3] = q.Z();
+  }
+}
+
+/// Copy the rows of an (N, 3) array to a Vector3Array
+/**
+ * \param[in] _rows The values of the array
+ * \param[in] _count Number of rows
+ * \return The vectors
+ */
+template<typename T>
+gz::math::Vector3Array<T> vector3ArrayFromRows(const T *_rows,
+                                               std::size_t _count)
+{
+  gz::math::Vector3Array<T> vectors(_count);
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    vectors.X()[i] = _rows[3*i];
+    vectors.Y()[i] = _rows[3*i+1];
+    vectors.Z()[i] = _rows[3*i+2];
+  }
+  return vectors;
+}
+
+/// Copy a Vector3Array to the rows of an (N, 3) array
+/**
+ * \param[in] _vectors The vectors
+ * \param[out] _rows The values of the array
+ */
+template<typename T>
+void vector3ArrayToRows(const gz::math::Vector3Array<T> &_vectors, T *_rows)
+{
+  for (std::size_t i = 0; i < _vectors.Size(); ++i)
+  {
+    _rows[3*i] = _vectors.X()[i];
+    _rows[3*i+1] = _vectors.Y()[i];
+    _rows[3*i+2] = _vectors.Z()[i];
+  }
+}
+
 /// Help define a pybind11 wrapper for a gz::math::Quaternion
 /**
  * \param[in] module a pybind11 module to add the definition to
@@ -59,6 +141,8 @@ void helpDefineMathQuaternion(py::module &m, const std::string &typestr)
     stream << si;
     return stream.str();
   };
+  // The values of a Class, contiguous in memory
+  auto values = [](Class &_q) { return &_q.W(); };
   std::string pyclass_name = typestr;
   py::class_<Class>(m,
                     pyclass_name.c_str(),
@@ -71,6 +155,14 @@ void helpDefineMathQuaternion(py::module &m, const std::string &typestr)
     .def(py::init<const gz::math::Vector3<T>&>())
     .def(py::init<const gz::math::Matrix3<T>&>())
     .def(py::init<const Class&>())
+    .def(py::init([](py::buffer _buffer)
+         {
+           Class result;
+           copyFromBuffer(_buffer, &result.W(), 4);
+           return result;
+         }),
+         "Construct from a buffer, such as a NumPy array, of "
+         "4 numbers, w, x, y and z")
     .def(py::self + py::self)
     .def(py::self += py::self)
     .def(-py::self)
@@ -156,8 +248,83 @@ void helpDefineMathQuaternion(py::module &m, const std::string &typestr)
          &Class::Equal,
          "Equality test with tolerance.")
     .def("rotate_vector",
-         &Class::RotateVector,
+         py::overload_cast<const gz::math::Vector3<T>&>(
+           &Class::RotateVector, py::const_),
          "Rotate a vector using the quaternion")
+    .def("rotate_vector",
+         [](const Class &_q, const MathArray<T> &_vectors)
+         {
+           return mapArrayRows(_vectors, 3, 3,
+               [&_q](const T *_in, T *_out, std::size_t _count)
+               {
+                 std::vector<gz::math::Vector3<T>> vectors(_count);
+                 for (std::size_t i = 0; i < _count; ++i)
+                   vectors[i].Set(_in[3*i], _in[3*i+1], _in[3*i+2]);
+                 _q.RotateVector(vectors.data(), vectors.data(), _count);
+                 for (std::size_t i = 0; i < _count; ++i)
+                 {
+                   _out[3*i] = vectors[i].X();
+                   _out[3*i+1] = vectors[i].Y();
+                   _out[3*i+2] = vectors[i].Z();
+                 }
+               });
+         },
+         "vectors"_a,
+         "Rotate each row of an (N, 3) array of vectors using the "
+         "quaternion, and return the (N, 3) array of results")
+    .def_static("normalize_array",
+         [](const MathArray<T> &_quaternions)
+         {
+           return mapArrayRows(_quaternions, 4, 4,
+               [](const T *_in, T *_out, std::size_t _count)
+               {
+                 auto quaternions = quaternionArrayFromRows(_in, _count);
+                 quaternions.Normalize();
+                 quaternionArrayToRows(quaternions, _out);
+               });
+         },
+         "quaternions"_a,
+         "Normalize each row of an (N, 4) array of w, x, y, z values, "
+         "and return the (N, 4) array of results")
+    .def_static("multiply_array",
+         [](const MathArray<T> &_a, const MathArray<T> &_b)
+         {
+           const T *b = _b.data();
+           if (arrayRows(_b, 4) != arrayRows(_a, 4))
+             throw py::value_error("The arrays must have the same shape");
+           return mapArrayRows(_a, 4, 4,
+               [b](const T *_in, T *_out, std::size_t _count)
+               {
+                 auto quaternions = quaternionArrayFromRows(_in, _count);
+                 quaternions.Multiply(quaternionArrayFromRows(b, _count));
+                 quaternionArrayToRows(quaternions, _out);
+               });
+         },
+         "a"_a, "b"_a,
+         "Multiply the rows of two (N, 4) arrays of w, x, y, z values, "
+         "a[i] * b[i], and return the (N, 4) array of results")
+    .def_static("rotate_vector_array",
+         [](const MathArray<T> &_quaternions, const MathArray<T> &_vectors)
+         {
+           const T *vectors = _vectors.data();
+           if (arrayRows(_vectors, 3) != arrayRows(_quaternions, 4))
+           {
+             throw py::value_error(
+                 "The arrays must have the same number of rows");
+           }
+           return mapArrayRows(_quaternions, 4, 3,
+               [vectors](const T *_in, T *_out, std::size_t _count)
+               {
+                 auto rotated = vector3ArrayFromRows(vectors, _count);
+                 quaternionArrayFromRows(_in, _count).RotateVector(
+                     rotated, rotated);
+                 vector3ArrayToRows(rotated, _out);
+               });
+         },
+         "quaternions"_a, "vectors"_a,
+         "Rotate each row of an (N, 3) array of vectors by the matching "
+         "row of an (N, 4) array of w, x, y, z values, and return the "
+         "(N, 3) array of results")
     .def("rotate_vector_reverse",
          &Class::RotateVectorReverse,
          "Do the reverse rotation of a vector by this quaternion")
@@ -202,6 +369,20 @@ void helpDefineMathQuaternion(py::module &m, const std::string &typestr)
     .def("set_y", py::overload_cast<T>(&Class::SetY), "Set the y value.")
     .def("set_z", py::overload_cast<T>(&Class::SetZ), "Set the z value.")
     .def("set_w", py::overload_cast<T>(&Class::SetW), "Set the w value.")
+    .def_buffer([](Class &_q) -> py::buffer_info
+       {
+         static_assert(sizeof(Class) == 4 * sizeof(T),
+                       "The values of a Quaternion must be contiguous");
+         return mathBufferInfo(&_q.W(), {4});
+       })
+    .def(mathPickle<Class, T, 4>(values))
+    .def_static("pack",
+         mathPack<Class, T, 4>(values),
+         "Pack quaternions into a single bytes object, made of the values of "
+         "each in native byte order.")
+    .def_static("unpack",
+         mathUnpack<Class, T, 4>(values),
+         "Unpack a list of quaternions from bytes made by pack.")
     .def("__copy__", [](const Class &self) {
       return Class(self);
     })
@@ -14,9 +14,11 @@
  * limitations under the License.
  *
 */
+#include <cstddef>
 #include <string>
 
 #include "Rand.hh"
+#include "Buffer.hh"
 #include <gz/math/Rand.hh>
 
 namespace gz
@@ -25,6 +27,37 @@ namespace math
 {
 namespace python
 {
+/// Fill a float64 or float32 NumPy array in place, with the GIL released
+/**
+ * \param[in,out] _out The array, which must be writeable and C-contiguous
+ * \param[in] _fill Called with a pointer to the first number of the array
+ * and the number of numbers
+ * \throws py::value_error if the array isn't a contiguous float64 or
+ * float32 array
+ */
+template<typename Fill>
+void fillArray(py::array _out, Fill _fill)
+{
+  if (!(_out.flags() & py::array::c_style))
+    throw py::value_error("Expected a C-contiguous array");
+  if (py::isinstance<py::array_t<double>>(_out))
+  {
+    double *data = static_cast<double *>(_out.mutable_data());
+    py::gil_scoped_release release;
+    _fill(data, static_cast<std::size_t>(_out.size()));
+  }
+  else if (py::isinstance<py::array_t<float>>(_out))
+  {
+    float *data = static_cast<float *>(_out.mutable_data());
+    py::gil_scoped_release release;
+    _fill(data, static_cast<std::size_t>(_out.size()));
+  }
+  else
+  {
+    throw py::value_error("Expected a float64 or float32 array");
+  }
+}
+
 void defineMathRand(py::module &m, const std::string &typestr)
 {
   using Class = gz::math::Rand;
@@ -40,6 +73,12 @@ void defineMathRand(py::module &m, const std::string &typestr)
    .def("seed",
         py::overload_cast<unsigned int>(&gz::math::Rand::Seed),
         "Set the seed value.")
+   .def("stream",
+        py::overload_cast<>(&gz::math::Rand::Stream),
+        "Get the stream id of the calling thread.")
+   .def("stream",
+        py::overload_cast<unsigned int>(&gz::math::Rand::Stream),
+        "Set the stream id of the calling thread.")
    .def("dbl_uniform",
         gz::math::Rand::DblUniform,
         "Get a double from a uniform distribution")
@@ -51,7 +90,59 @@ void defineMathRand(py::module &m, const std::string &typestr)
         "Get a integer from a uniform distribution")
    .def("int_normal",
         gz::math::Rand::IntNormal,
-        "Get a integer from a normal distribution");
+        "Get a integer from a normal distribution")
+   .def_static("fill_uniform",
+        [](py::array _out, double _min, double _max)
+        {
+          fillArray(_out, [&](auto *_data, std::size_t _count)
+          {
+            Class::FillUniform(_data, _count, _min, _max);
+          });
+        },
+        py::arg("out"), py::arg("min") = 0.0, py::arg("max") = 1.0,
+        "Fill a float64 or float32 NumPy array with numbers from a "
+        "uniform distribution. This is much faster than calling "
+        "dbl_uniform for each number, but draws a different sequence.")
+   .def_static("fill_normal",
+        [](py::array _out, double _mean, double _sigma)
+        {
+          fillArray(_out, [&](auto *_data, std::size_t _count)
+          {
+            Class::FillNormal(_data, _count, _mean, _sigma);
+          });
+        },
+        py::arg("out"), py::arg("mean") = 0.0, py::arg("sigma") = 1.0,
+        "Fill a float64 or float32 NumPy array with numbers from a "
+        "normal distribution. This is much faster than calling "
+        "dbl_normal for each number, but draws a different sequence.")
+   .def_static("dbl_uniform_array",
+        [](std::size_t _count, double _min, double _max)
+        {
+          MathArray<double> out(static_cast<py::ssize_t>(_count));
+          double *data = out.mutable_data();
+          {
+            py::gil_scoped_release release;
+            Class::FillUniform(data, _count, _min, _max);
+          }
+          return out;
+        },
+        py::arg("count"), py::arg("min") = 0.0, py::arg("max") = 1.0,
+        "Get a float64 NumPy array of numbers from a uniform "
+        "distribution, as drawn by fill_uniform.")
+   .def_static("dbl_normal_array",
+        [](std::size_t _count, double _mean, double _sigma)
+        {
+          MathArray<double> out(static_cast<py::ssize_t>(_count));
+          double *data = out.mutable_data();
+          {
+            py::gil_scoped_release release;
+            Class::FillNormal(data, _count, _mean, _sigma);
+          }
+          return out;
+        },
+        py::arg("count"), py::arg("mean") = 0.0, py::arg("sigma") = 1.0,
+        "Get a float64 NumPy array of numbers from a normal "
+        "distribution, as drawn by fill_normal.");
 }
 }  // namespace python
 }  // namespace math
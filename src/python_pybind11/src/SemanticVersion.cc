@@ -59,9 +59,13 @@ void defineMathSemanticVersion(py::module &m, const std::string &typestr)
   .def(py::self > py::self)
   .def(py::self >= py::self)
   .def("parse",
-       &Class::Parse,
+       py::overload_cast<const std::string &>(&Class::Parse),
        "Parse a version string and set the major, minor, patch "
        "numbers, and prerelease and build strings.")
+  .def("key",
+       &Class::Key,
+       "Get a key of the version, whose integer order is the order of "
+       "the comparison operators.")
    .def("version",
         &Class::Version,
         "Returns the version as a string")
@@ -45,7 +45,7 @@ void defineMathSignalStats(py::module &m, const std::string &typestr)
        "Get the current values of each statistical measure, "
        "stored in a map using the short name as the key.")
   .def("insert_data",
-       &Class::InsertData,
+       py::overload_cast<const double>(&Class::InsertData),
        "Add a new sample to the statistical measures.")
   .def("insert_statistic",
        &Class::InsertStatistic,
@@ -137,7 +137,7 @@ void defineMathSignalStatistic(py::module &m, const std::string &typestr)
        &Class::Count,
        "Get number of data points in measurement.")
   .def("insert_data",
-       &Class::InsertData,
+       py::overload_cast<const double>(&Class::InsertData),
        "Add a new sample to the statistical measure.")
   .def("reset",
        &Class::Reset,
@@ -206,7 +206,7 @@ void defineMathSignalVariance(py::module &m, const std::string &typestr)
        &Class::ShortName,
        "Get a short version of the name of this statistical measure.")
   .def("insert_data",
-       &Class::InsertData,
+       py::overload_cast<const double>(&Class::InsertData),
        "Add a new sample to the statistical measure.");
 }
 
@@ -273,7 +273,7 @@ void defineMathSignalMaximum(py::module &m, const std::string &typestr)
        &Class::ShortName,
        "Get a short version of the name of this statistical measure.")
   .def("insert_data",
-       &Class::InsertData,
+       py::overload_cast<const double>(&Class::InsertData),
        "Add a new sample to the statistical measure.");
 }
 
@@ -340,7 +340,7 @@ void defineMathSignalMinimum(py::module &m, const std::string &typestr)
        &Class::ShortName,
        "Get a short version of the name of this statistical measure.")
   .def("insert_data",
-       &Class::InsertData,
+       py::overload_cast<const double>(&Class::InsertData),
        "Add a new sample to the statistical measure.");
 }
 
@@ -407,7 +407,7 @@ void defineMathSignalMean(py::module &m, const std::string &typestr)
        &Class::ShortName,
        "Get a short version of the name of this statistical measure.")
   .def("insert_data",
-       &Class::InsertData,
+       py::overload_cast<const double>(&Class::InsertData),
        "Add a new sample to the statistical measure.");
 }
 
@@ -475,7 +475,7 @@ void defineMathSignalRootMeanSquare(py::module &m, const std::string &typestr)
        &Class::ShortName,
        "Get a short version of the name of this statistical measure.")
   .def("insert_data",
-       &Class::InsertData,
+       py::overload_cast<const double>(&Class::InsertData),
        "Add a new sample to the statistical measure.");
 }
 
@@ -543,7 +543,7 @@ void defineMathSignalMaxAbsoluteValue(py::module &m, const std::string &typestr)
        &Class::ShortName,
        "Get a short version of the name of this statistical measure.")
   .def("insert_data",
-       &Class::InsertData,
+       py::overload_cast<const double>(&Class::InsertData),
        "Add a new sample to the statistical measure.");
 }
 }  // namespace python
@@ -14,8 +14,12 @@
  * limitations under the License.
  *
 */
+#include <string>
+#include <vector>
+
 #include <pybind11/operators.h>
 
+#include "Buffer.hh"
 #include "SphericalCoordinates.hh"
 #include <gz/math/Angle.hh>
 #include <gz/math/SphericalCoordinates.hh>
@@ -26,6 +30,40 @@ namespace math
 {
 namespace python
 {
+/// Convert the rows of an (N, 3) array with a batch conversion of
+/// SphericalCoordinates, with the GIL released
+/**
+ * \param[in] _vectors The vectors to convert
+ * \param[in] _result None, or an (N, 3) array to write the result to
+ * \param[in] _convert Called with the vectors and their number, converts
+ * them in place
+ * \return The converted vectors
+ */
+template<typename Convert>
+MathArray<double> convertRows(const MathArray<double> &_vectors,
+                              const py::object &_result, Convert _convert)
+{
+  const std::size_t count = arrayRows(_vectors, 3);
+  MathArray<double> out = resultArray<double>(_result,
+      {static_cast<py::ssize_t>(count), 3});
+  const double *in = _vectors.data();
+  double *result = out.mutable_data();
+  {
+    py::gil_scoped_release release;
+    std::vector<gz::math::Vector3d> vectors(count);
+    for (std::size_t i = 0; i < count; ++i)
+      vectors[i].Set(in[3*i], in[3*i+1], in[3*i+2]);
+    _convert(vectors.data(), count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      result[3*i] = vectors[i].X();
+      result[3*i+1] = vectors[i].Y();
+      result[3*i+2] = vectors[i].Z();
+    }
+  }
+  return out;
+}
+
 void defineMathSphericalCoordinates(py::module &m, const std::string &typestr)
 {
   using Class = gz::math::SphericalCoordinates;
@@ -48,9 +86,11 @@ void defineMathSphericalCoordinates(py::module &m, const std::string &typestr)
     .def(py::self == py::self)
     .def("spherical_from_local_position",
          &Class::SphericalFromLocalPosition,
+         py::call_guard<py::gil_scoped_release>(),
          "Convert a Cartesian position vector to geodetic coordinates.")
     .def("global_from_local_velocity",
          &Class::GlobalFromLocalVelocity,
+         py::call_guard<py::gil_scoped_release>(),
          "Convert a Cartesian velocity vector in the local frame "
          " to a global Cartesian frame with components East, North, Up")
     .def("convert",
@@ -60,18 +100,31 @@ void defineMathSphericalCoordinates(py::module &m, const std::string &typestr)
          py::overload_cast<Class::SurfaceType>(&Class::Convert),
          "Convert a SurfaceType to a string.")
     .def("distance_WGS84",
-         &Class::DistanceWGS84,
+         py::overload_cast<const gz::math::Angle &, const gz::math::Angle &,
+           const gz::math::Angle &, const gz::math::Angle &>(
+             &Class::DistanceWGS84),
+         py::call_guard<py::gil_scoped_release>(),
          "Get the distance between two points expressed in geographic "
          "latitude and longitude. It assumes that both points are at sea level."
          " Example: _latA = 38.0016667 and _lonA = -123.0016667) represents "
          "the point with latitude 38d 0'6.00\"N and longitude 123d 0'6.00\"W."
          " This function assumes the surface is EARTH_WGS84.")
     .def("distance_between_points",
-         &Class::DistanceBetweenPoints,
+         py::overload_cast<const gz::math::Angle &, const gz::math::Angle &,
+           const gz::math::Angle &, const gz::math::Angle &>(
+             &Class::DistanceBetweenPoints),
+         py::call_guard<py::gil_scoped_release>(),
          "Get the distance between two points expressed in geographic "
          "latitude and longitude. It assumes that both points are at sea level."
          " Example: _latA = 38.0016667 and _lonA = -123.0016667) represents "
          "the point with latitude 38d 0'6.00\"N and longitude 123d 0'6.00\"W.")
+    .def("geodesic_distance",
+         py::overload_cast<const gz::math::Angle &, const gz::math::Angle &,
+           const gz::math::Angle &, const gz::math::Angle &>(
+             &Class::GeodesicDistance, py::const_),
+         py::call_guard<py::gil_scoped_release>(),
+         "Get the length of the shortest path between two points on the "
+         "ellipsoid of the surface.")
     .def("surface",
          &Class::Surface,
          "Get SurfaceType currently in use.")
@@ -123,24 +176,81 @@ void defineMathSphericalCoordinates(py::module &m, const std::string &typestr)
          "Set heading angle offset for the frame.")
     .def("local_from_spherical_position",
          &Class::LocalFromSphericalPosition,
+         py::call_guard<py::gil_scoped_release>(),
          "Convert a geodetic position vector to Cartesian coordinates.")
     .def("local_from_global_velocity",
          &Class::LocalFromGlobalVelocity,
+         py::call_guard<py::gil_scoped_release>(),
          "Convert a Cartesian velocity vector with components East, "
          "North, Up to a local cartesian frame vector XYZ.")
     .def("update_transformation_matrix",
          &Class::UpdateTransformationMatrix,
          "Update coordinate transformation matrix with reference location")
+    .def("set_tangent_plane_radius",
+         &Class::SetTangentPlaneRadius,
+         "Enable a faster, approximate conversion for positions close "
+         "to the reference.")
+    .def("tangent_plane_radius",
+         &Class::TangentPlaneRadius,
+         "Get the distance from the reference within which the "
+         "approximate conversion is used.")
+    .def("tangent_plane_error",
+         &Class::TangentPlaneError,
+         "Get an upper bound of the error of the approximate "
+         "conversion for a position at a given distance from the reference.")
     .def("position_transform",
-         &Class::PositionTransform,
+         py::overload_cast<const gz::math::Vector3d &,
+           const Class::CoordinateType &, const Class::CoordinateType &>(
+             &Class::PositionTransform, py::const_),
+         py::call_guard<py::gil_scoped_release>(),
          "Convert between velocity in SPHERICAL/ECEF/LOCAL/GLOBAL frame "
          "Spherical coordinates use radians, while the other frames use "
          "meters.")
     .def("velocity_transform",
-         &Class::VelocityTransform,
+         py::overload_cast<const gz::math::Vector3d &,
+           const Class::CoordinateType &, const Class::CoordinateType &>(
+             &Class::VelocityTransform, py::const_),
+         py::call_guard<py::gil_scoped_release>(),
          "Convert between velocity in SPHERICAL/ECEF/LOCAL/GLOBAL frame "
          "Spherical coordinates use radians, while the other frames use "
-         "meters.");
+         "meters.")
+    .def("position_transform",
+         [](const Class &_self, const MathArray<double> &_positions,
+            const Class::CoordinateType &_in,
+            const Class::CoordinateType &_out, const py::object &_result)
+         {
+           return convertRows(_positions, _result,
+               [&](gz::math::Vector3d *_vectors, std::size_t _count)
+               {
+                 _self.PositionTransform(_vectors, _vectors, _count,
+                                         _in, _out);
+               });
+         },
+         py::arg("positions"), py::arg("in_type"), py::arg("out_type"),
+         py::arg("result") = py::none(),
+         "Convert each row of an (N, 3) array of positions between "
+         "SPHERICAL/ECEF/LOCAL/GLOBAL frames, with the GIL released. "
+         "The result is written to the (N, 3) float64 array result if it "
+         "is given, which may be the positions, or to a new array, and "
+         "returned.")
+    .def("velocity_transform",
+         [](const Class &_self, const MathArray<double> &_velocities,
+            const Class::CoordinateType &_in,
+            const Class::CoordinateType &_out, const py::object &_result)
+         {
+           return convertRows(_velocities, _result,
+               [&](gz::math::Vector3d *_vectors, std::size_t _count)
+               {
+                 _self.VelocityTransform(_vectors, _vectors, _count,
+                                         _in, _out);
+               });
+         },
+         py::arg("velocities"), py::arg("in_type"), py::arg("out_type"),
+         py::arg("result") = py::none(),
+         "Convert each row of an (N, 3) array of velocities between "
+         "ECEF/LOCAL/GLOBAL frames, with the GIL released. The result is "
+         "written to the (N, 3) float64 array result if it is given, which "
+         "may be the velocities, or to a new array, and returned.");
 
    py::enum_<Class::CoordinateType>(sphericalCoordinates, "CoordinateType")
        .value("SPHERICAL", Class::CoordinateType::SPHERICAL)
@@ -15,8 +15,11 @@
  *
 */
 #include <string>
+#include <vector>
+
 #include "Spline.hh"
 #include <gz/math/Spline.hh>
+#include <pybind11/stl.h>
 
 namespace gz
 {
@@ -41,13 +44,16 @@ void defineMathSpline(py::module &m, const std::string &typestr)
        "Gets the tension value.")
   .def("arc_length",
        py::overload_cast<const double>(&Class::ArcLength, py::const_),
+       py::call_guard<py::gil_scoped_release>(),
        "Sets the tension parameter.")
   .def("arc_length",
        py::overload_cast<>(&Class::ArcLength, py::const_),
+       py::call_guard<py::gil_scoped_release>(),
        "Gets spline arc length up to")
   .def("arc_length",
        py::overload_cast<const unsigned int,
                          const double>(&Class::ArcLength, py::const_),
+       py::call_guard<py::gil_scoped_release>(),
        "Sets the tension parameter.")
   .def("add_point",
        py::overload_cast<const Vector3d&>(&Class::AddPoint),
@@ -57,6 +63,9 @@ void defineMathSpline(py::module &m, const std::string &typestr)
        py::overload_cast<const Vector3d&, const Vector3d&>(&Class::AddPoint),
        "Adds a single control point to the end "
        " of the spline with fixed tangent.")
+  .def("add_points",
+       py::overload_cast<const std::vector<Vector3d>&>(&Class::AddPoints),
+       "Adds control points to the end of the spline.")
   .def("point",
        &Class::Point,
        "Gets the value for one of the control points "
@@ -92,28 +101,33 @@ void defineMathSpline(py::module &m, const std::string &typestr)
        " with its tangent.")
   .def("interpolate",
        py::overload_cast<const double>(&Class::Interpolate, py::const_),
+       py::call_guard<py::gil_scoped_release>(),
        "Interpolates a point on the spline "
        "at parameter value p _t.")
   .def("interpolate",
        py::overload_cast<const unsigned int,
                          const double>(&Class::Interpolate, py::const_),
+       py::call_guard<py::gil_scoped_release>(),
        "Interpolates a point on the spline "
        "at parameter value p _t.")
   .def("interpolate_tangent",
        py::overload_cast<const double>
            (&Class::InterpolateTangent, py::const_),
+       py::call_guard<py::gil_scoped_release>(),
        "Interpolates a tangent on the spline "
        "at parameter value p _t.")
   .def("interpolate_tangent",
        py::overload_cast<const unsigned int,
                          const double>(
            &Class::InterpolateTangent, py::const_),
+       py::call_guard<py::gil_scoped_release>(),
        "Interpolates a tangent on the spline "
        "at parameter value p _t.")
   .def("interpolate_mth_derivative",
        py::overload_cast<const unsigned int,
                          const double>(
            &Class::InterpolateMthDerivative, py::const_),
+       py::call_guard<py::gil_scoped_release>(),
        "Interpolates the mth derivative on the spline "
        "at parameter value p _t.")
   .def("interpolate_mth_derivative",
@@ -121,8 +135,38 @@ void defineMathSpline(py::module &m, const std::string &typestr)
                          const unsigned int,
                          const double>(
            &Class::InterpolateMthDerivative, py::const_),
+       py::call_guard<py::gil_scoped_release>(),
        "Interpolates the mth derivative on the spline "
        "at parameter value p _t.")
+  .def("interpolate_at_distance", &Class::InterpolateAtDistance,
+       py::call_guard<py::gil_scoped_release>(),
+       "Interpolates a point on the spline at a distance along it.")
+  .def("interpolate_tangent_at_distance",
+       &Class::InterpolateTangentAtDistance,
+       py::call_guard<py::gil_scoped_release>(),
+       "Interpolates a tangent on the spline at a distance along it.")
+  .def("closest_parameter", &Class::ClosestParameter,
+       py::arg("_point"), py::arg("_hint") = -1.0,
+       "Finds the parameter value of the point of the spline "
+       "closest to a point.")
+  .def("tessellate",
+       [](const Class &_self, const double _maxChordError)
+       {
+         std::vector<gz::math::Vector3d> points;
+         _self.Tessellate(_maxChordError, points);
+         return points;
+       },
+       py::call_guard<py::gil_scoped_release>(),
+       py::arg("_maxChordError"),
+       "Approximates the spline with a polyline, whose vertices "
+       "are returned.")
+  .def("arc_length_table_samples",
+       py::overload_cast<const unsigned int>(&Class::ArcLengthTableSamples),
+       "Sets the number of samples of the arc length tables "
+       "of the segments.")
+  .def("arc_length_table_samples",
+       py::overload_cast<>(&Class::ArcLengthTableSamples, py::const_),
+       "Gets the number of samples of the arc length tables.")
   .def("auto_calculate", &Class::AutoCalculate,
        "Tells the spline whether it should automatically "
        "calculate tangents on demand as points are added.")
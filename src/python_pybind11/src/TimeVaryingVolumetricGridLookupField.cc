@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "TimeVaryingVolumetricGridLookupField.hh"
+#include "VolumetricGridLookupField.hh"
+#include <gz/math/TimeVaryingVolumetricGridLookupField.hh>
+#include <pybind11/stl.h>
+
+namespace gz
+{
+namespace math
+{
+namespace python
+{
+/// A TimeVaryingVolumetricGridLookupField that also remembers how many
+/// values the indices of its fields refer to.
+class PyTimeVaryingVolumetricGridLookupField
+  : public gz::math::TimeVaryingVolumetricGridLookupField<double, double,
+      gz::math::InMemorySession<double, double>>
+{
+  /// Largest number of values the indices of a field refer to
+  public: std::size_t valueCount = 0;
+};
+
+void defineMathTimeVaryingVolumetricGridLookupField(
+    py::module &m, const std::string &typestr)
+{
+  using Class = PyTimeVaryingVolumetricGridLookupField;
+  using Session = gz::math::InMemorySession<double, double>;
+  std::string pyclass_name = typestr;
+  std::string session_name = typestr + "Session";
+
+  py::class_<Session>(m,
+                      session_name.c_str(),
+                      "A query session of a time-varying field.")
+  .def_readonly("time", &Session::time, "Time of the session.");
+
+  py::class_<Class>(m,
+                    pyclass_name.c_str(),
+                    py::buffer_protocol(),
+                    py::dynamic_attr())
+  .def(py::init<>())
+  .def("add_volumetric_grid_field",
+       [](Class &_self, double _time,
+          const PyVolumetricGridLookupField &_field)
+       {
+         _self.AddVolumetricGridField(_time, _field);
+         _self.valueCount = std::max(_self.valueCount, _field.valueCount);
+       },
+       py::arg("time"), py::arg("field"),
+       "Add the field at a time. The field is copied.")
+  .def_readonly("value_count", &Class::valueCount,
+       "Largest number of values the indices of the fields refer to.")
+  .def("create_session",
+       py::overload_cast<>(&Class::CreateSession, py::const_),
+       py::keep_alive<0, 1>(),
+       "Create a session at the first time of the field.")
+  .def("create_session",
+       py::overload_cast<const double &>(&Class::CreateSession, py::const_),
+       py::arg("time"),
+       py::keep_alive<0, 1>(),
+       "Create a session at a time.")
+  .def("is_valid", &Class::IsValid,
+       "Check that a session is within the times of the field.")
+  .def("step_to",
+       py::overload_cast<const Session &, const double &>(
+           &Class::StepTo, py::const_),
+       py::arg("session"), py::arg("time"),
+       py::keep_alive<0, 1>(),
+       "Step a session forward to a time. Returns None if the time is "
+       "before the session or if the session is at the last time of the "
+       "field.")
+  .def("bounds", &Class::Bounds,
+       "Get the bounds of the field at the time of a session.")
+  .def("estimate",
+       [](const Class &_self, const Session &_session,
+          const MathArray<double> &_points,
+          const MathArray<double> &_values1,
+          const MathArray<double> &_values2, double _default)
+       {
+         const std::size_t count = arrayRows(_points, 3);
+         const std::size_t channels = valueChannels(_values1,
+                                                    _self.valueCount);
+         if (_values2.ndim() != _values1.ndim() ||
+             valueChannels(_values2, _self.valueCount) != channels)
+         {
+           throw py::value_error(
+               "The value arrays must have the same number of channels");
+         }
+         std::vector<py::ssize_t> shape{static_cast<py::ssize_t>(count)};
+         if (_values1.ndim() == 2)
+           shape.push_back(static_cast<py::ssize_t>(channels));
+         MathArray<double> out(shape);
+         const double *data = _points.data();
+         const double *values1 = _values1.data();
+         const double *values2 = _values2.data();
+         double *result = out.mutable_data();
+
+         {
+           py::gil_scoped_release release;
+           // The session remembers the last query, so use a copy that
+           // other threads can't touch
+           const Session session(_session);
+           const double nan = std::numeric_limits<double>::quiet_NaN();
+           for (std::size_t i = 0; i < count; ++i)
+           {
+             double *estimate = result + i * channels;
+             const gz::math::Vector3d point(
+                 data[3*i], data[3*i+1], data[3*i+2]);
+             if (!_self.EstimateQuadrilinearChannels(session, point,
+                   values1, values2, channels, estimate,
+                   gz::math::Vector3d(1e-6, 1e-6, 1e-6), _default))
+             {
+               std::fill(estimate, estimate + channels, nan);
+             }
+           }
+         }
+         return out;
+       },
+       py::arg("session"), py::arg("points"), py::arg("values1"),
+       py::arg("values2"), py::arg("default") = 0.0,
+       "Estimate the values at each row of an (N, 3) array of points at "
+       "the time of a session using quadrilinear interpolation, with the "
+       "GIL released. The values of the fields at and after the time of "
+       "the session are (M,) arrays, or (M, C) arrays of C channels per "
+       "index, and the result is an (N,) or (N, C) array. Points outside "
+       "the field get NaN.");
+}
+}  // namespace python
+}  // namespace math
+}  // namespace gz
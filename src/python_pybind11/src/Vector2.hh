@@ -26,6 +26,8 @@
 
 #include <gz/math/Vector2.hh>
 
+#include "Buffer.hh"
+
 namespace py = pybind11;
 using namespace pybind11::literals;
 
@@ -48,6 +50,8 @@ void helpDefineMathVector2(py::module &m, const std::string &typestr)
     stream << si;
     return stream.str();
   };
+  // The values of a Class, contiguous in memory
+  auto values = [](Class &_v) { return &_v.X(); };
   std::string pyclass_name = typestr;
   py::class_<Class>(m,
                     pyclass_name.c_str(),
@@ -56,6 +60,14 @@ void helpDefineMathVector2(py::module &m, const std::string &typestr)
     .def(py::init<>())
     .def(py::init<const T&, const T&>())
     .def(py::init<const Class>())
+    .def(py::init([](py::buffer _buffer)
+         {
+           Class result;
+           copyFromBuffer(_buffer, &result.X(), 2);
+           return result;
+         }),
+         "Construct from a buffer, such as a NumPy array, of "
+         "2 numbers")
     .def("sum", &Class::Sum, "Return the sum of the values")
     .def("distance", &Class::Distance, "Calc distance to the given point")
     .def("length",
@@ -126,6 +138,18 @@ void helpDefineMathVector2(py::module &m, const std::string &typestr)
         "math::Vector2(1, 1)")
     .def_readonly_static("NAN", &Class::NaN, py::return_value_policy::copy,
         "math::Vector2(NaN, NaN)")
+    .def_buffer([](Class &_v) -> py::buffer_info
+       {
+         return mathBufferInfo(&_v.X(), {2});
+       })
+    .def(mathPickle<Class, T, 2>(values))
+    .def_static("pack",
+         mathPack<Class, T, 2>(values),
+         "Pack vectors into a single bytes object, made of the values of "
+         "each in native byte order.")
+    .def_static("unpack",
+         mathUnpack<Class, T, 2>(values),
+         "Unpack a list of vectors from bytes made by pack.")
     .def("__copy__", [](const Class &self) {
       return Class(self);
     })
@@ -39,7 +39,7 @@ void defineMathVector3Stats(py::module &m, const std::string &typestr)
                     py::dynamic_attr())
     .def(py::init<>())
     .def("insert_data",
-         &Class::InsertData,
+         py::overload_cast<const Vector3d &>(&Class::InsertData),
          "Add a new sample to the statistical measures")
     .def("insert_statistic",
          &Class::InsertStatistic,
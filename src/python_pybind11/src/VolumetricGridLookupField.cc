@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "VolumetricGridLookupField.hh"
+#include <pybind11/stl.h>
+
+namespace gz
+{
+namespace math
+{
+namespace python
+{
+std::size_t valueChannels(const MathArray<double> &_values,
+                          std::size_t _valueCount)
+{
+  if (_values.ndim() != 1 && _values.ndim() != 2)
+    throw py::value_error("Expected an array of shape (M,) or (M, C)");
+  if (static_cast<std::size_t>(_values.shape(0)) < _valueCount)
+  {
+    throw py::value_error("Expected at least " +
+                          std::to_string(_valueCount) + " values, got " +
+                          std::to_string(_values.shape(0)));
+  }
+  return _values.ndim() == 1 ? 1 : static_cast<std::size_t>(_values.shape(1));
+}
+
+void defineMathVolumetricGridLookupField(py::module &m,
+                                         const std::string &typestr)
+{
+  using Class = PyVolumetricGridLookupField;
+  std::string pyclass_name = typestr;
+  py::class_<Class>(m,
+                    pyclass_name.c_str(),
+                    py::buffer_protocol(),
+                    py::dynamic_attr())
+  .def(py::init([](const MathArray<double> &_cloud,
+                   const py::object &_indices,
+                   unsigned int _threads)
+       {
+         const std::size_t count = arrayRows(_cloud, 3);
+         std::vector<gz::math::Vector3d> cloud(count);
+         const double *data = _cloud.data();
+         for (std::size_t i = 0; i < count; ++i)
+           cloud[i].Set(data[3*i], data[3*i+1], data[3*i+2]);
+
+         if (_indices.is_none())
+         {
+           py::gil_scoped_release release;
+           auto field = std::make_unique<Class>(cloud);
+           field->valueCount = count;
+           return field;
+         }
+
+         using IndexArray = py::array_t<std::int64_t,
+             py::array::c_style | py::array::forcecast>;
+         const auto indexArray = _indices.cast<IndexArray>();
+         if (indexArray.ndim() != 1 ||
+             static_cast<std::size_t>(indexArray.shape(0)) != count)
+         {
+           throw py::value_error(
+               "Expected one index for each point of the cloud");
+         }
+         std::vector<std::size_t> indices(count);
+         std::size_t valueCount = 0;
+         const std::int64_t *index = indexArray.data();
+         for (std::size_t i = 0; i < count; ++i)
+         {
+           if (index[i] < 0)
+             throw py::value_error("Indices must not be negative");
+           indices[i] = static_cast<std::size_t>(index[i]);
+           valueCount = std::max(valueCount, indices[i] + 1);
+         }
+
+         py::gil_scoped_release release;
+         auto field = std::make_unique<Class>(cloud, indices, _threads);
+         field->valueCount = valueCount;
+         return field;
+       }),
+       py::arg("cloud"), py::arg("indices") = py::none(),
+       py::arg("threads") = 1,
+       "Construct a field from an (N, 3) array of the points of the grid "
+       "and, optionally, an (N,) array of the index of the value of each "
+       "point. Without indices, point i has the value i.")
+  .def_readonly("value_count", &Class::valueCount,
+       "Number of values the indices of the field refer to.")
+  .def("bounds", &Class::Bounds,
+       "Get the bounds of this grid field.")
+  .def("estimate",
+       [](const Class &_self, const MathArray<double> &_points,
+          const MathArray<double> &_values, double _default,
+          unsigned int _threads)
+       {
+         const std::size_t count = arrayRows(_points, 3);
+         const std::size_t channels = valueChannels(_values,
+                                                    _self.valueCount);
+         const bool scalar = _values.ndim() == 1;
+         std::vector<py::ssize_t> shape{static_cast<py::ssize_t>(count)};
+         if (!scalar)
+           shape.push_back(static_cast<py::ssize_t>(channels));
+         MathArray<double> out(shape);
+         const double *data = _points.data();
+         const double *values = _values.data();
+         double *result = out.mutable_data();
+
+         {
+           py::gil_scoped_release release;
+           std::vector<gz::math::Vector3d> points(count);
+           for (std::size_t i = 0; i < count; ++i)
+             points[i].Set(data[3*i], data[3*i+1], data[3*i+2]);
+
+           const double nan = std::numeric_limits<double>::quiet_NaN();
+           if (scalar)
+           {
+             std::vector<std::optional<double>> estimates(count);
+             _self.EstimateValuesUsingTrilinear(points.data(),
+                 estimates.data(), count, values, _default, _threads);
+             for (std::size_t i = 0; i < count; ++i)
+               result[i] = estimates[i].value_or(nan);
+           }
+           else
+           {
+             gz::math::InterpolationPoints3D<double> interpolators;
+             gz::math::VolumetricGridCursor cursor;
+             for (std::size_t i = 0; i < count; ++i)
+             {
+               double *estimate = result + i * channels;
+               _self.GetInterpolators(points[i], interpolators, cursor);
+               if (!_self.EstimateChannelsUsingTrilinear(interpolators,
+                     points[i], values, channels, estimate, _default))
+               {
+                 std::fill(estimate, estimate + channels, nan);
+               }
+             }
+           }
+         }
+         return out;
+       },
+       py::arg("points"), py::arg("values"), py::arg("default") = 0.0,
+       py::arg("threads") = 1,
+       "Estimate the values at each row of an (N, 3) array of points "
+       "using trilinear interpolation, with the GIL released. The values "
+       "are an (M,) array, or an (M, C) array of C channels per index, and "
+       "the result is an (N,) or (N, C) array. Points outside the field "
+       "get NaN.");
+}
+}  // namespace python
+}  // namespace math
+}  // namespace gz
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_MATH_PYTHON__VOLUMETRICGRIDLOOKUPFIELD_HH_
+#define GZ_MATH_PYTHON__VOLUMETRICGRIDLOOKUPFIELD_HH_
+
+#include <cstddef>
+#include <string>
+
+#include <pybind11/pybind11.h>
+
+#include <gz/math/VolumetricGridLookupField.hh>
+
+#include "Buffer.hh"
+
+namespace py = pybind11;
+
+namespace gz
+{
+namespace math
+{
+namespace python
+{
+/// A VolumetricGridLookupField that also remembers how many values its
+/// indices refer to, so that the value arrays passed from Python can be
+/// checked before they are indexed.
+class PyVolumetricGridLookupField
+  : public gz::math::VolumetricGridLookupField<double>
+{
+  public: using
+    gz::math::VolumetricGridLookupField<double>::VolumetricGridLookupField;
+
+  /// Number of values the indices of the field refer to
+  public: std::size_t valueCount = 0;
+};
+
+/// Get the number of channels of an (M,) or (M, C) array of values, and
+/// check that it has enough values for a field
+/**
+ * \param[in] _values The values
+ * \param[in] _valueCount Number of values the field refers to
+ * \return The number of channels, 1 for an (M,) array
+ * \throws py::value_error if the array has the wrong shape or too few values
+ */
+std::size_t valueChannels(const MathArray<double> &_values,
+                          std::size_t _valueCount);
+
+/// Define a pybind11 wrapper for a gz::math::VolumetricGridLookupField
+/**
+ * \param[in] module a pybind11 module to add the definition to
+ * \param[in] typestr name of the type used by Python
+ */
+void defineMathVolumetricGridLookupField(py::module &m,
+                                         const std::string &typestr);
+}  // namespace python
+}  // namespace math
+}  // namespace gz
+
+#endif  // GZ_MATH_PYTHON__VOLUMETRICGRIDLOOKUPFIELD_HH_
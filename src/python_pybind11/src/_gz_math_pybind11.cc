@@ -54,12 +54,14 @@
 #include "Spline.hh"
 #include "StopWatch.hh"
 #include "Temperature.hh"
+#include "TimeVaryingVolumetricGridLookupField.hh"
 #include "Triangle.hh"
 #include "Triangle3.hh"
 #include "Vector2.hh"
 #include "Vector3.hh"
 #include "Vector3Stats.hh"
 #include "Vector4.hh"
+#include "VolumetricGridLookupField.hh"
 
 namespace py = pybind11;
 
@@ -124,6 +126,12 @@ PYBIND11_MODULE(BINDINGS_MODULE_NAME, m)
 
   gz::math::python::defineMathTemperature(m, "Temperature");
 
+  gz::math::python::defineMathVolumetricGridLookupField(
+    m, "VolumetricGridLookupField");
+
+  gz::math::python::defineMathTimeVaryingVolumetricGridLookupField(
+    m, "TimeVaryingVolumetricGridLookupField");
+
   gz::math::python::defineMathVector2(m, "Vector2");
 
   gz::math::python::defineMathVector3(m, "Vector3");
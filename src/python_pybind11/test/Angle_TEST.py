@@ -16,6 +16,11 @@ import unittest
 import math
 from gz.math7 import Angle
 
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
 
 class TestAngle(unittest.TestCase):
 
@@ -85,6 +90,31 @@ class TestAngle(unittest.TestCase):
         self.assertTrue(angle >= Angle(3))
         self.assertTrue(angle <= Angle(3))
 
+    @unittest.skipIf(numpy is None, 'NumPy is not available')
+    def test_arrays(self):
+        angles = numpy.linspace(-20, 20, 101)
+        wrapped = Angle.wrap(angles)
+        self.assertEqual(angles.shape, wrapped.shape)
+        for angle, value in zip(angles, wrapped):
+            self.assertAlmostEqual(Angle(angle).normalized().radian(), value)
+        self.assertTrue(numpy.all(wrapped > -math.pi))
+        self.assertTrue(numpy.all(wrapped <= math.pi))
+
+        unwrapped = Angle.unwrap(wrapped)
+        self.assertTrue(numpy.allclose(angles - angles[0] + wrapped[0],
+                                       unwrapped))
+
+        for fast in [False, True]:
+            sin, cos = Angle.sin_cos(angles.reshape(101, 1), fast=fast)
+            self.assertEqual((101, 1), sin.shape)
+            self.assertTrue(numpy.allclose(numpy.sin(angles), sin[:, 0]))
+            self.assertTrue(numpy.allclose(numpy.cos(angles), cos[:, 0]))
+
+        # Lists are converted
+        sin, cos = Angle.sin_cos([0.0, math.pi / 2])
+        self.assertAlmostEqual(1.0, sin[1])
+        self.assertAlmostEqual(1.0, cos[0])
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -599,6 +599,21 @@ class TestFrustrum(unittest.TestCase):
         self.assertTrue(frustum.contains(
             AxisAlignedBox(Vector3d(-10, -10, 1.95), Vector3d(10, 10, 2.05))))
 
+    def test_set(self):
+        pose = Pose3d(1, -2, 3, 0.1, -0.4, 2.0)
+        expected = Frustum(0.5, 20, Angle(1.2), 1.6, pose)
+        frustum = Frustum()
+        frustum.set(0.5, 20, Angle(1.2), 1.6, pose)
+
+        self.assertEqual(frustum.near(), 0.5)
+        self.assertEqual(frustum.far(), 20)
+        self.assertEqual(frustum.fov(), Angle(1.2))
+        self.assertEqual(frustum.aspect_ratio(), 1.6)
+        self.assertEqual(frustum.pose(), pose)
+        self.assertEqual(
+            expected.plane(FrustumPlane.FRUSTUM_PLANE_LEFT).normal(),
+            frustum.plane(FrustumPlane.FRUSTUM_PLANE_LEFT).normal())
+
 
 if __name__ == '__main__':
     unittest.main()
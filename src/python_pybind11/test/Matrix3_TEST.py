@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import array
 import math
 import unittest
 from gz.math7 import Matrix3d
@@ -334,6 +335,32 @@ class TestMatrix3(unittest.TestCase):
         q2 = Quaterniond(mat)
         self.assertTrue(q == q2)
 
+    def test_buffer(self):
+        mat = Matrix3d(1, 2, 3,
+                       4, 5, 6,
+                       7, 8, 9)
+        view = memoryview(mat)
+        self.assertEqual('d', view.format)
+        self.assertEqual((3, 3), view.shape)
+        self.assertEqual([[1.0, 2.0, 3.0], [4.0, 5.0, 6.0], [7.0, 8.0, 9.0]],
+                         view.tolist())
+
+        # The view shares the storage of the matrix
+        view[1, 2] = 10.0
+        self.assertEqual(10.0, mat(1, 2))
+
+        # Flat or 3x3 buffers, in row-major order
+        values = array.array('d', range(9))
+        expected = Matrix3d(0, 1, 2,
+                            3, 4, 5,
+                            6, 7, 8)
+        self.assertEqual(expected, Matrix3d(values))
+        self.assertEqual(
+            expected,
+            Matrix3d(memoryview(values).cast('B').cast('d', [3, 3])))
+        with self.assertRaises(ValueError):
+            Matrix3d(array.array('d', range(4)))
+
 
 if __name__ == '__main__':
     unittest.main()
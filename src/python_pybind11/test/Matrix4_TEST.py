@@ -12,7 +12,9 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import array
 import math
+import pickle
 import unittest
 from gz.math7 import Matrix4d
 from gz.math7 import Pose3d
@@ -224,6 +226,17 @@ class TestMatrix4(unittest.TestCase):
                                               -2, 4, 3, 0,
                                               -12, 24, 19, -1))
 
+    def test_inverse_affine(self):
+        mat = Matrix4d(Pose3d(1, -2, 3, 0.4, -1.1, 2.7))
+        identity = Matrix4d.IDENTITY
+        self.assertTrue((mat * mat.inverse_rigid()).equal(identity, 1e-12))
+        self.assertTrue((mat * mat.inverse_affine()).equal(identity, 1e-12))
+        self.assertTrue(mat.inverse().equal(mat.inverse_rigid(), 1e-12))
+
+        mat.scale(2, 0.5, -3)
+        self.assertTrue((mat * mat.inverse_affine()).equal(identity, 1e-12))
+        self.assertFalse((mat * mat.inverse_rigid()).equal(identity, 1e-12))
+
     def test_get_pose3(self):
         mat = Matrix4d(2, 3, 1, 5,
                        1, 0, 3, 1,
@@ -515,6 +528,34 @@ class TestMatrix4(unittest.TestCase):
                                Vector3d(0, 1, 1)).pose(),
                                Pose3d(1, 1, 1, math.pi/4, 0, math.pi))
 
+    def test_buffer(self):
+        mat = Matrix4d(1, 2, 3, 4,
+                       5, 6, 7, 8,
+                       9, 10, 11, 12,
+                       13, 14, 15, 16)
+        view = memoryview(mat)
+        self.assertEqual('d', view.format)
+        self.assertEqual((4, 4), view.shape)
+        self.assertEqual(7.0, view[1, 2])
+
+        # The view shares the storage of the matrix
+        view[2, 3] = 20.0
+        self.assertEqual(20.0, mat(2, 3))
+
+        values = array.array('d', range(16))
+        mat = Matrix4d(values)
+        for i in range(16):
+            self.assertEqual(i, mat(i // 4, i % 4))
+        with self.assertRaises(ValueError):
+            Matrix4d(array.array('d', range(9)))
+
+    def test_pickle(self):
+        mat = Matrix4d(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16)
+        self.assertEqual(mat, pickle.loads(pickle.dumps(mat)))
+        self.assertEqual([mat, Matrix4d.IDENTITY],
+                         Matrix4d.unpack(Matrix4d.pack(
+                             (mat, Matrix4d.IDENTITY))))
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import array
 import math
 import unittest
 from gz.math7 import Matrix3d, Matrix6d, Matrix6dCorner
@@ -254,5 +255,50 @@ class TestMatrix6(unittest.TestCase):
             24, 25, 26, 27, 28, 29,
             30, 31, 32, 33, 34, 35))
 
+    def test_buffer(self):
+        mat = Matrix6d(Matrix6d.IDENTITY)
+        view = memoryview(mat)
+        self.assertEqual('d', view.format)
+        self.assertEqual((6, 6), view.shape)
+        self.assertEqual(1.0, view[5, 5])
+        self.assertEqual(0.0, view[4, 5])
+
+        values = array.array('d', range(36))
+        mat = Matrix6d(values)
+        for i in range(36):
+            self.assertEqual(i, mat(i // 6, i % 6))
+
+        # The view shares the storage of the matrix
+        memoryview(mat)[3, 4] = 50.0
+        self.assertEqual(50.0, mat(3, 4))
+        with self.assertRaises(ValueError):
+            Matrix6d(array.array('d', range(16)))
+
+    def test_solve(self):
+        top_left = Matrix3d(3, 0, 0, 0, 3, 0, 0, 0, 3)
+        skew = Matrix3d(0, -0.3, 0.6, 0.3, 0, -1.5, -0.6, 1.5, 0)
+        inertia = Matrix6d(top_left, skew.transposed(), skew,
+                           Matrix3d(2, 0.1, 0, 0.1, 3, 0, 0, 0, 4) +
+                           skew * skew.transposed() * (1 / 3.0))
+        self.assertEqual(skew, inertia.submatrix(Matrix6dCorner.BOTTOM_LEFT))
+
+        x = [0.1, -0.2, 0.3, 1, 2, -3]
+        b = inertia * x
+        self.assertEqual(6, len(b))
+        solution = inertia.solve(b)
+        for expected, value in zip(x, solution):
+            self.assertAlmostEqual(expected, value)
+
+        inverse = inertia.solve(Matrix6d.IDENTITY)
+        self.assertTrue((inertia * inverse).equal(Matrix6d.IDENTITY, 1e-12))
+        self.assertTrue(inverse.equal(inertia.inverse(), 1e-12))
+        self.assertIsNone(Matrix6d.ZERO.solve(b))
+
+        rot = Matrix3d(0, -1, 0, 1, 0, 0, 0, 0, 1)
+        blocks = Matrix6d(rot, Matrix3d.ZERO, Matrix3d.ZERO, rot)
+        self.assertTrue((inertia * blocks).equal(
+            inertia.multiply_block_diagonal(rot, rot), 1e-12))
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -13,7 +13,14 @@
 # limitations under the License.
 
 import math
+import pickle
 import unittest
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
 from gz.math7 import Pose3d
 from gz.math7 import Quaterniond
 from gz.math7 import Vector3d
@@ -183,6 +190,37 @@ class TestPose3(unittest.TestCase):
         self.assertAlmostEqual(pose.y(), 12)
         self.assertAlmostEqual(pose.z(), 13)
 
+    @unittest.skipIf(numpy is None, 'NumPy is not available')
+    def test_coord_position_add_array(self):
+        pose = Pose3d(1, 2, 3, 0, 0, math.pi / 2)
+        points = numpy.array([[1.0, 0.0, 0.0], [0.0, 1.0, 2.0]])
+        result = pose.coord_position_add(points)
+        self.assertEqual((2, 3), result.shape)
+        for row, point in zip(result, points):
+            expected = pose.coord_position_add(Vector3d(*point))
+            self.assertAlmostEqual(expected.x(), row[0])
+            self.assertAlmostEqual(expected.y(), row[1])
+            self.assertAlmostEqual(expected.z(), row[2])
+
+        # Other number types and sequences are converted
+        result = pose.coord_position_add([[1, 0, 0]])
+        self.assertEqual(numpy.float64, result.dtype)
+        self.assertTrue(numpy.allclose([[1, 3, 3]], result))
+
+        self.assertEqual((0, 3), pose.coord_position_add(
+            numpy.zeros((0, 3))).shape)
+        with self.assertRaises(ValueError):
+            pose.coord_position_add(numpy.zeros((2, 4)))
+
+    def test_pickle(self):
+        pose = Pose3d(1, 2, 3, 0.1, 0.2, 0.3)
+        self.assertEqual(pose, pickle.loads(pickle.dumps(pose)))
+
+        poses = [Pose3d(i, 0, 0, 0, 0, 0.1 * i) for i in range(5)]
+        data = Pose3d.pack(poses)
+        self.assertEqual(5 * 7 * 8, len(data))
+        self.assertEqual(poses, Pose3d.unpack(data))
+
 
 if __name__ == '__main__':
     unittest.main()
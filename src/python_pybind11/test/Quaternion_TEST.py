@@ -12,8 +12,15 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import array
 import math
 import unittest
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
 from gz.math7 import Matrix3d
 from gz.math7 import Matrix4d
 from gz.math7 import Quaterniond
@@ -529,6 +536,57 @@ class TestQuaternion(unittest.TestCase):
         self.assertAlmostEqual(q, qY)
         self.assertAlmostEqual(q, qZ)
 
+    def test_buffer(self):
+        q = Quaterniond(1, 2, 3, 4)
+        view = memoryview(q)
+        self.assertEqual('d', view.format)
+        self.assertEqual((4,), view.shape)
+        self.assertEqual([1.0, 2.0, 3.0, 4.0], view.tolist())
+
+        # The view shares the storage of the quaternion
+        view[0] = 5.0
+        self.assertEqual(5.0, q.w())
+
+        q = Quaterniond(array.array('d', [0, 1, 0, 0]))
+        self.assertEqual(0.0, q.w())
+        self.assertEqual(1.0, q.x())
+        self.assertEqual(Quaternionf(0, 1, 0, 0), Quaternionf(q))
+        with self.assertRaises(ValueError):
+            Quaterniond(array.array('d', [1, 2, 3]))
+
+    @unittest.skipIf(numpy is None, 'NumPy is not available')
+    def test_arrays(self):
+        q = Quaterniond(0, 0, math.pi / 2)
+        vectors = numpy.array([[1.0, 0.0, 0.0], [1.0, 2.0, 3.0]])
+        result = q.rotate_vector(vectors)
+        self.assertEqual((2, 3), result.shape)
+        self.assertTrue(numpy.allclose([[0, 1, 0], [-2, 1, 3]], result))
+        with self.assertRaises(ValueError):
+            q.rotate_vector(numpy.zeros((2, 4)))
+
+        quaternions = numpy.array([[2.0, 0.0, 0.0, 0.0],
+                                   [0.0, 0.0, 0.0, 0.0],
+                                   [1.0, 1.0, 1.0, 1.0]])
+        result = Quaterniond.normalize_array(quaternions)
+        self.assertTrue(numpy.allclose(
+            [[1, 0, 0, 0], [1, 0, 0, 0], [0.5, 0.5, 0.5, 0.5]], result))
+
+        a = numpy.array([[q.w(), q.x(), q.y(), q.z()]] * 3)
+        result = Quaterniond.multiply_array(a, quaternions)
+        for row, b in zip(result, quaternions):
+            expected = q * Quaterniond(*b)
+            self.assertTrue(numpy.allclose(
+                [expected.w(), expected.x(), expected.y(), expected.z()],
+                row))
+        with self.assertRaises(ValueError):
+            Quaterniond.multiply_array(a, quaternions[:2])
+
+        vectors = numpy.array([[1.0, 0.0, 0.0]] * 3)
+        result = Quaterniond.rotate_vector_array(a, vectors)
+        self.assertTrue(numpy.allclose([[0, 1, 0]] * 3, result))
+        with self.assertRaises(ValueError):
+            Quaterniond.rotate_vector_array(a, vectors[:2])
+
 
 if __name__ == '__main__':
     unittest.main()
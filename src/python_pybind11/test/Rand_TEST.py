@@ -13,6 +13,12 @@
 # limitations under the License.
 
 import unittest
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
 from gz.math7 import Rand
 
 
@@ -43,6 +49,33 @@ class TestRand(unittest.TestCase):
             self.assertEqual(first[i], Rand.int_uniform(-10, 10))
             self.assertEqual(second[i], Rand.int_uniform(-10, 10))
 
+    @unittest.skipIf(numpy is None, 'NumPy is not available')
+    def test_arrays(self):
+        Rand.seed(42)
+        uniform = Rand.dbl_uniform_array(1000, 1, 2)
+        self.assertEqual((1000,), uniform.shape)
+        self.assertEqual(numpy.float64, uniform.dtype)
+        self.assertTrue(((uniform >= 1) & (uniform <= 2)).all())
+
+        # Filling an array draws the same numbers
+        Rand.seed(42)
+        out = numpy.zeros(1000)
+        Rand.fill_uniform(out, 1, 2)
+        self.assertTrue((uniform == out).all())
+
+        normal = Rand.dbl_normal_array(10000, 5, 2)
+        self.assertAlmostEqual(5, normal.mean(), delta=0.1)
+        self.assertAlmostEqual(2, normal.std(), delta=0.1)
+
+        out = numpy.zeros((10, 10), dtype=numpy.float32)
+        Rand.fill_normal(out)
+        self.assertTrue((out != 0).any())
+
+        with self.assertRaises(ValueError):
+            Rand.fill_uniform(numpy.zeros(10, dtype=int))
+        with self.assertRaises(ValueError):
+            Rand.fill_uniform(numpy.zeros((10, 10))[:, 0])
+
 
 if __name__ == '__main__':
     unittest.main()
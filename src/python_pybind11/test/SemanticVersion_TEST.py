@@ -152,6 +152,15 @@ class TestSemanticVersion(unittest.TestCase):
         self.assertFalse(a.parse(""))
         self.assertFalse(a.parse("0.1.2+1-1"))
 
+    def test_key(self):
+        versions = [SemanticVersion(v) for v in
+                    ["1.10.0", "1.2.0", "1.2.0-pr", "0.9.9", "1.2.0+b"]]
+        versions.sort(key=lambda v: v.key())
+        self.assertEqual(["0.9.9", "1.2.0-pr", "1.2.0", "1.2.0+b", "1.10.0"],
+                         [v.version() for v in versions])
+        self.assertLess(SemanticVersion("1.2.0-pr").key(),
+                        SemanticVersion("1.2.0").key())
+
     def test_constructor(self):
         a = SemanticVersion()
 
@@ -14,6 +14,11 @@
 
 import unittest
 
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
 import gz
 from gz.math7 import Angle, SphericalCoordinates, Vector3d
 import math
@@ -669,6 +674,56 @@ class TestSphericalCoordinates(unittest.TestCase):
             SphericalCoordinates.LOCAL2)
         self.assertEqual(in_vector, reverse)
 
+    @unittest.skipIf(numpy is None, 'NumPy is not available')
+    def test_transform_arrays(self):
+        sc = SphericalCoordinates(
+            SphericalCoordinates.EARTH_WGS84,
+            Angle(0.3), Angle(-1.2), 354.1, Angle(0.5))
+        positions = numpy.array([[0.3, -1.2, 354.1],
+                                 [0.31, -1.21, 100.0],
+                                 [0.29, -1.19, 0.0]])
+        local = sc.position_transform(positions,
+                                      SphericalCoordinates.SPHERICAL,
+                                      SphericalCoordinates.LOCAL2)
+        self.assertEqual((3, 3), local.shape)
+        for row, position in zip(local, positions):
+            expected = sc.position_transform(
+                Vector3d(*position),
+                SphericalCoordinates.SPHERICAL,
+                SphericalCoordinates.LOCAL2)
+            self.assertAlmostEqual(expected.x(), row[0], delta=1e-6)
+            self.assertAlmostEqual(expected.y(), row[1], delta=1e-6)
+            self.assertAlmostEqual(expected.z(), row[2], delta=1e-6)
+
+        # Write to a preallocated array, here in place
+        result = sc.position_transform(local,
+                                       SphericalCoordinates.LOCAL2,
+                                       SphericalCoordinates.SPHERICAL,
+                                       result=local)
+        self.assertIs(local, result)
+        self.assertTrue(numpy.allclose(positions, local))
+
+        velocities = numpy.array([[1.0, 2.0, 3.0]])
+        result = numpy.zeros((1, 3))
+        sc.velocity_transform(velocities, SphericalCoordinates.LOCAL2,
+                              SphericalCoordinates.GLOBAL, result)
+        expected = sc.velocity_transform(Vector3d(1, 2, 3),
+                                         SphericalCoordinates.LOCAL2,
+                                         SphericalCoordinates.GLOBAL)
+        self.assertTrue(numpy.allclose(
+            [[expected.x(), expected.y(), expected.z()]], result))
+
+        with self.assertRaises(ValueError):
+            sc.position_transform(positions,
+                                  SphericalCoordinates.SPHERICAL,
+                                  SphericalCoordinates.LOCAL2,
+                                  numpy.zeros((2, 3)))
+        with self.assertRaises(ValueError):
+            sc.position_transform(positions,
+                                  SphericalCoordinates.SPHERICAL,
+                                  SphericalCoordinates.LOCAL2,
+                                  numpy.zeros((3, 3), dtype=numpy.float32))
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -0,0 +1,71 @@
+# Copyright (C) 2023 Open Source Robotics Foundation
+#
+# Licensed under the Apache License, Version 2.0 (the "License")
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import math
+import unittest
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+from gz.math7 import TimeVaryingVolumetricGridLookupField
+from gz.math7 import Vector3d
+from gz.math7 import VolumetricGridLookupField
+
+
+@unittest.skipIf(numpy is None, 'NumPy is not available')
+class TestTimeVaryingVolumetricGridLookupField(unittest.TestCase):
+
+    def test_estimate(self):
+        cloud = numpy.array([[x, y, z] for x in range(2) for y in range(2)
+                             for z in range(2)], dtype=float)
+        field = TimeVaryingVolumetricGridLookupField()
+        field.add_volumetric_grid_field(0, VolumetricGridLookupField(cloud))
+        field.add_volumetric_grid_field(10, VolumetricGridLookupField(cloud))
+        self.assertEqual(8, field.value_count)
+
+        session = field.create_session()
+        self.assertTrue(field.is_valid(session))
+        self.assertEqual((Vector3d(0, 0, 0), Vector3d(1, 1, 1)),
+                         field.bounds(session))
+
+        session = field.step_to(session, 5)
+        self.assertIsNotNone(session)
+        self.assertEqual(5, session.time)
+
+        values1 = numpy.zeros(8)
+        values2 = numpy.full(8, 10.0)
+        points = numpy.array([[0.5, 0.5, 0.5], [2, 0, 0]])
+        result = field.estimate(session, points, values1, values2)
+        self.assertEqual((2,), result.shape)
+        self.assertAlmostEqual(5.0, result[0])
+        self.assertTrue(math.isnan(result[1]))
+
+        # Several channels per index
+        result = field.estimate(session, points,
+                                numpy.zeros((8, 3)), numpy.ones((8, 3)))
+        self.assertEqual((2, 3), result.shape)
+        self.assertTrue(numpy.allclose([0.5, 0.5, 0.5], result[0]))
+
+        with self.assertRaises(ValueError):
+            field.estimate(session, points, values1, values2[:7])
+        with self.assertRaises(ValueError):
+            field.estimate(session, points, values1, numpy.ones((8, 3)))
+
+        self.assertIsNone(field.step_to(session, -1))
+
+
+if __name__ == '__main__':
+    unittest.main()
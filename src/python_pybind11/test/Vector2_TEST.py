@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import array
 import copy
 import math
 import unittest
@@ -317,5 +318,23 @@ class TestVector2(unittest.TestCase):
         self.assertEqual(Vector2f.ZERO, nanVecF)
         self.assertTrue(nanVecF.is_finite())
 
+    def test_buffer(self):
+        v = Vector2d(1, 2)
+        view = memoryview(v)
+        self.assertEqual('d', view.format)
+        self.assertEqual((2,), view.shape)
+        self.assertEqual([1.0, 2.0], view.tolist())
+
+        # The view shares the storage of the vector
+        view[1] = 5.0
+        self.assertEqual(5.0, v.y())
+
+        self.assertEqual(Vector2d(3, 4), Vector2d(array.array('d', [3, 4])))
+        self.assertEqual(Vector2d(3, 4), Vector2d(array.array('i', [3, 4])))
+        self.assertEqual(Vector2f(1, 5), Vector2f(v))
+        with self.assertRaises(ValueError):
+            Vector2d(array.array('d', [1, 2, 3]))
+
+
 if __name__ == '__main__':
     unittest.main()
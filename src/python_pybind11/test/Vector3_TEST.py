@@ -12,8 +12,10 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import array
 import copy
 import math
+import pickle
 import unittest
 
 from gz.math7 import Vector3d
@@ -374,5 +376,44 @@ class TestVector3(unittest.TestCase):
         self.assertEqual(Vector3f.ZERO, nanVecF)
         self.assertTrue(nanVecF.is_finite())
 
+    def test_buffer(self):
+        v = Vector3d(1, 2, 3)
+        view = memoryview(v)
+        self.assertEqual('d', view.format)
+        self.assertEqual((3,), view.shape)
+        self.assertEqual([1.0, 2.0, 3.0], view.tolist())
+
+        # The view shares the storage of the vector
+        view[2] = 5.0
+        self.assertEqual(5.0, v.z())
+
+        self.assertEqual(Vector3d(3, 4, 5),
+                         Vector3d(array.array('d', [3, 4, 5])))
+        self.assertEqual(Vector3d(3, 4, 5),
+                         Vector3d(array.array('q', [3, 4, 5])))
+        self.assertEqual(Vector3f(1, 2, 5), Vector3f(v))
+        self.assertEqual('f', memoryview(Vector3f()).format)
+        with self.assertRaises(ValueError):
+            Vector3d(array.array('d', [1, 2]))
+        with self.assertRaises(ValueError):
+            Vector3d(array.array('u', 'abc'))
+
+    def test_pickle(self):
+        v = Vector3d(1.5, -2, 3)
+        self.assertEqual(v, pickle.loads(pickle.dumps(v)))
+        self.assertEqual(24, len(v.__getstate__()))
+
+        vectors = [Vector3d(i, 2 * i, 3 * i) for i in range(10)]
+        data = Vector3d.pack(vectors)
+        self.assertEqual(10 * 24, len(data))
+        self.assertEqual(vectors, Vector3d.unpack(data))
+        self.assertEqual(vectors[:1], Vector3d.unpack(bytearray(data[:24])))
+        self.assertEqual([], Vector3d.unpack(b''))
+        with self.assertRaises(ValueError):
+            Vector3d.unpack(data[:-1])
+        with self.assertRaises(TypeError):
+            Vector3d.pack([Vector3f()])
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import array
 import copy
 import math
 import unittest
@@ -281,5 +282,23 @@ class TestVector4(unittest.TestCase):
         self.assertEqual(Vector4f.ZERO, nanVecF)
         self.assertTrue(nanVecF.is_finite())
 
+    def test_buffer(self):
+        v = Vector4d(1, 2, 3, 4)
+        view = memoryview(v)
+        self.assertEqual('d', view.format)
+        self.assertEqual((4,), view.shape)
+        self.assertEqual([1.0, 2.0, 3.0, 4.0], view.tolist())
+
+        # The view shares the storage of the vector
+        view[3] = 5.0
+        self.assertEqual(5.0, v.w())
+
+        self.assertEqual(Vector4d(3, 4, 5, 6),
+                         Vector4d(array.array('d', [3, 4, 5, 6])))
+        self.assertEqual(Vector4f(1, 2, 3, 5), Vector4f(v))
+        with self.assertRaises(ValueError):
+            Vector4d(array.array('d', [1, 2, 3]))
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -0,0 +1,94 @@
+# Copyright (C) 2023 Open Source Robotics Foundation
+#
+# Licensed under the Apache License, Version 2.0 (the "License")
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import math
+import unittest
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+from gz.math7 import Vector3d
+from gz.math7 import VolumetricGridLookupField
+
+
+def cube():
+    # The corners of a unit cube, point i has the value i
+    return numpy.array([[x, y, z] for x in range(2) for y in range(2)
+                        for z in range(2)], dtype=float)
+
+
+@unittest.skipIf(numpy is None, 'NumPy is not available')
+class TestVolumetricGridLookupField(unittest.TestCase):
+
+    def test_estimate(self):
+        field = VolumetricGridLookupField(cube())
+        self.assertEqual(8, field.value_count)
+        self.assertEqual((Vector3d(0, 0, 0), Vector3d(1, 1, 1)),
+                         field.bounds())
+
+        values = numpy.arange(8, dtype=float)
+        points = numpy.array([[0.5, 0.5, 0.5],
+                              [0, 0, 0],
+                              [0.5, 0, 0],
+                              [2, 0, 0]])
+        result = field.estimate(points, values)
+        self.assertEqual((4,), result.shape)
+        self.assertAlmostEqual(3.5, result[0])
+        self.assertAlmostEqual(0.0, result[1])
+        self.assertAlmostEqual(2.0, result[2])
+        self.assertTrue(math.isnan(result[3]))
+
+        # Several channels per index
+        channels = numpy.stack([values, 2 * values], axis=1)
+        result = field.estimate(points, channels)
+        self.assertEqual((4, 2), result.shape)
+        self.assertAlmostEqual(3.5, result[0, 0])
+        self.assertAlmostEqual(7.0, result[0, 1])
+        self.assertTrue(numpy.isnan(result[3]).all())
+
+        # The same field with several threads
+        result = field.estimate(points, values, threads=2)
+        self.assertAlmostEqual(3.5, result[0])
+
+        with self.assertRaises(ValueError):
+            field.estimate(points, values[:7])
+        with self.assertRaises(ValueError):
+            field.estimate(numpy.zeros((2, 2)), values)
+
+    def test_indices(self):
+        indices = numpy.arange(8)[::-1]
+        field = VolumetricGridLookupField(cube(), indices)
+        self.assertEqual(8, field.value_count)
+        values = numpy.arange(8, dtype=float)
+        result = field.estimate(numpy.array([[0, 0, 0], [1, 1, 1]]), values)
+        self.assertAlmostEqual(7.0, result[0])
+        self.assertAlmostEqual(0.0, result[1])
+
+        # Missing values use the default
+        field = VolumetricGridLookupField(cube()[:7], numpy.arange(7))
+        self.assertEqual(7, field.value_count)
+        result = field.estimate(numpy.array([[1, 1, 1]]), values[:7],
+                                default=-1.0)
+        self.assertAlmostEqual(-1.0, result[0])
+
+        with self.assertRaises(ValueError):
+            VolumetricGridLookupField(cube(), numpy.arange(7))
+        with self.assertRaises(ValueError):
+            VolumetricGridLookupField(cube(), -numpy.arange(8))
+
+
+if __name__ == '__main__':
+    unittest.main()
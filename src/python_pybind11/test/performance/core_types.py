@@ -0,0 +1,170 @@
+# Copyright (C) 2023 Open Source Robotics Foundation
+#
+# Licensed under the Apache License, Version 2.0 (the "License")
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Benchmarks of the Python bindings, mirroring the scenarios of
+# test/performance/core_types.cc. Each benchmark prints its mean time per
+# call and per element, so that loops of per-element calls can be compared
+# with the NumPy entry points doing the same work.
+#
+# As with the C++ performance tests, the iteration counts are multiplied by
+# the GZ_MATH_BENCHMARK_SCALE environment variable, if set. Set
+# GZ_MATH_BENCHMARK_JSON to a file name to also write the results there.
+
+import json
+import os
+import time
+import unittest
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+from gz.math7 import Angle
+from gz.math7 import Kmeans
+from gz.math7 import Pose3d
+from gz.math7 import Quaterniond
+from gz.math7 import SphericalCoordinates
+from gz.math7 import Vector3d
+from gz.math7 import VolumetricGridLookupField
+
+results = {}
+
+
+def scale():
+    # The iteration multiplier, 1 if unset or invalid
+    try:
+        return max(1, int(os.environ.get('GZ_MATH_BENCHMARK_SCALE', '1')))
+    except ValueError:
+        return 1
+
+
+def run(name, iterations, func, elements=1):
+    # Time func, after one warm up call, and report the mean time per call
+    # and per element in nanoseconds
+    iterations = max(1, iterations * scale())
+    func()
+    start = time.perf_counter_ns()
+    for _ in range(iterations):
+        func()
+    ns = (time.perf_counter_ns() - start) / iterations
+
+    results[name] = {'ns': ns, 'ns_per_element': ns / elements,
+                     'iterations': iterations}
+    print('[ BENCHMARK ] {}: {:.1f} ns/iter, {:.1f} ns/element '
+          '({} iterations)'.format(name, ns, ns / elements, iterations))
+    return ns
+
+
+def tearDownModule():
+    path = os.environ.get('GZ_MATH_BENCHMARK_JSON')
+    if path:
+        with open(path, 'w') as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+
+
+class CoreTypesPerformance(unittest.TestCase):
+
+    def test_vector3(self):
+        a = Vector3d(1.1, -2.2, 3.3)
+        b = Vector3d(0.4, 0.5, -0.6)
+
+        run('Vector3d_add_scale', 100000, lambda: (a + b) * 0.5)
+        run('Vector3d_cross_dot', 100000, lambda: a.cross(b).dot(a))
+        run('Vector3d_normalized', 100000, lambda: (a + b).normalized())
+
+    @unittest.skipIf(numpy is None, 'NumPy is not available')
+    def test_vector3_array(self):
+        points = [Vector3d(i * 0.1, -i * 0.2, i * 0.3) for i in range(10000)]
+        array = numpy.array([[p.x(), p.y(), p.z()] for p in points])
+
+        run('Vector3d_length_loop_x10000', 5,
+            lambda: [p.length() for p in points], 10000)
+        run('Vector3d_length_numpy_x10000', 5,
+            lambda: numpy.linalg.norm(array, axis=1), 10000)
+        run('Vector3d_memoryview_x10000', 5,
+            lambda: [numpy.asarray(p) for p in points], 10000)
+
+    @unittest.skipIf(numpy is None, 'NumPy is not available')
+    def test_pose3(self):
+        pose = Pose3d(1, 2, 3, 0.1, 0.2, 0.3)
+        points = [Vector3d(i * 0.1, -i * 0.2, i * 0.3) for i in range(10000)]
+        array = numpy.array([[p.x(), p.y(), p.z()] for p in points])
+
+        run('Pose3d_mul', 100000, lambda: pose * pose)
+        run('Pose3d_coord_position_add_loop_x10000', 5,
+            lambda: [pose.coord_position_add(p) for p in points], 10000)
+        run('Pose3d_coord_position_add_array_x10000', 5,
+            lambda: pose.coord_position_add(array), 10000)
+
+    @unittest.skipIf(numpy is None, 'NumPy is not available')
+    def test_quaternion(self):
+        q = Quaterniond(0.1, 0.2, 0.3)
+        points = [Vector3d(i * 0.1, -i * 0.2, i * 0.3) for i in range(10000)]
+        array = numpy.array([[p.x(), p.y(), p.z()] for p in points])
+
+        run('Quaterniond_mul', 100000, lambda: q * q)
+        run('Quaterniond_rotate_vector_loop_x10000', 5,
+            lambda: [q.rotate_vector(p) for p in points], 10000)
+        run('Quaterniond_rotate_vector_array_x10000', 5,
+            lambda: q.rotate_vector(array), 10000)
+
+    def test_kmeans_cluster(self):
+        observations = [Vector3d((i * 37) % 101, (i * 53) % 97, (i * 71) % 89)
+                        for i in range(5000)]
+        kmeans = Kmeans(observations)
+
+        run('Kmeans_cluster_x5000', 3, lambda: kmeans.cluster(8), 5000)
+
+    @unittest.skipIf(numpy is None, 'NumPy is not available')
+    def test_volumetric_grid_lookup_field(self):
+        n = 20
+        cloud = numpy.array([[x, y, z] for x in range(n) for y in range(n)
+                             for z in range(n)], dtype=float)
+        field = VolumetricGridLookupField(cloud)
+        values = numpy.arange(len(cloud), dtype=float)
+        rng = numpy.random.default_rng(0)
+        points = rng.uniform(0, n - 1, (10000, 3))
+
+        run('VolumetricGridLookupField_estimate_x10000', 5,
+            lambda: field.estimate(points, values), 10000)
+        run('VolumetricGridLookupField_estimate_x10000_4_threads', 5,
+            lambda: field.estimate(points, values, threads=4), 10000)
+
+    @unittest.skipIf(numpy is None, 'NumPy is not available')
+    def test_spherical_coordinates(self):
+        sc = SphericalCoordinates(
+            SphericalCoordinates.EARTH_WGS84,
+            Angle(0.3), Angle(-1.2), 354.1, Angle(0.5))
+        rng = numpy.random.default_rng(0)
+        local = rng.uniform(-1000, 1000, (10000, 3))
+        points = [Vector3d(*p) for p in local]
+        result = numpy.empty_like(local)
+
+        run('SphericalCoordinates_position_transform', 100000,
+            lambda: sc.position_transform(
+                points[0], SphericalCoordinates.LOCAL2,
+                SphericalCoordinates.SPHERICAL))
+        run('SphericalCoordinates_position_transform_loop_x10000', 5,
+            lambda: [sc.position_transform(
+                p, SphericalCoordinates.LOCAL2,
+                SphericalCoordinates.SPHERICAL) for p in points], 10000)
+        run('SphericalCoordinates_position_transform_array_x10000', 5,
+            lambda: sc.position_transform(
+                local, SphericalCoordinates.LOCAL2,
+                SphericalCoordinates.SPHERICAL, result=result), 10000)
+
+
+if __name__ == '__main__':
+    unittest.main()
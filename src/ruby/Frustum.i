@@ -63,6 +63,12 @@ namespace gz
 
       public: Frustum(const Frustum &_p);
 
+      public: void Set(double _near,
+                  double _far,
+                  const gz::math::Angle &_fov,
+                  double _aspectRatio,
+                  const gz::math::Pose3<double> &_pose);
+
       public: double Near() const;
 
       public: void SetNear(double _near);
@@ -20,6 +20,9 @@
 #include <gz/math/Rand.hh>
 %}
 
+%include "std_vector.i"
+%template(VectorDouble) std::vector<double>;
+
 namespace gz
 {
   namespace math
@@ -33,5 +36,24 @@ namespace gz
       public: static int IntUniform(int _min, int _max);
       public: static int IntNormal(int _mean, int _sigma);
     };
+    %extend Rand {
+      static std::vector<double> DblUniformArray(size_t _count,
+                                                 double _min = 0,
+                                                 double _max = 1)
+      {
+        std::vector<double> result(_count);
+        gz::math::Rand::FillUniform(result.data(), _count, _min, _max);
+        return result;
+      }
+
+      static std::vector<double> DblNormalArray(size_t _count,
+                                                double _mean = 0,
+                                                double _sigma = 1)
+      {
+        std::vector<double> result(_count);
+        gz::math::Rand::FillNormal(result.data(), _count, _mean, _sigma);
+        return result;
+      }
+    }
   }
 }
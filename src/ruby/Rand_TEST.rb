@@ -31,6 +31,21 @@ class Rand_TEST < Test::Unit::TestCase
     i = Gz::Math::Rand::IntNormal(10, 5)
     assert(i == 11, "The value should be 11")
   end
+
+  def test_arrays
+    Gz::Math::Rand::Seed(42)
+    uniform = Gz::Math::Rand::DblUniformArray(100, 1, 2)
+    assert(uniform.size == 100, "There should be 100 values")
+    assert(uniform.all? { |d| d >= 1 && d <= 2 },
+           "The values should be 1 <= d <= 2")
+
+    Gz::Math::Rand::Seed(42)
+    assert(Gz::Math::Rand::DblUniformArray(100, 1, 2).to_a == uniform.to_a,
+           "The same seed should give the same values")
+
+    normal = Gz::Math::Rand::DblNormalArray(10, 5, 2)
+    assert(normal.size == 10, "There should be 10 values")
+  end
 end
 
 exit Test::Unit::UI::Console::TestRunner.run(Rand_TEST).passed? ? 0 : -1
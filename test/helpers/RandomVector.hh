@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_MATH_TEST_HELPERS_RANDOMVECTOR_HH_
+#define GZ_MATH_TEST_HELPERS_RANDOMVECTOR_HH_
+
+#include "gz/math/Rand.hh"
+#include "gz/math/Vector3.hh"
+
+namespace test
+{
+/// \brief Random vector with components in a range, drawn with Rand so
+/// that Rand::Seed() makes the tests repeatable.
+/// \param[in] _min Lower bound of the components.
+/// \param[in] _max Upper bound of the components.
+/// \return The random vector.
+inline gz::math::Vector3d RandomVector(const double _min, const double _max)
+{
+  return gz::math::Vector3d(gz::math::Rand::DblUniform(_min, _max),
+                            gz::math::Rand::DblUniform(_min, _max),
+                            gz::math::Rand::DblUniform(_min, _max));
+}
+}
+
+#endif
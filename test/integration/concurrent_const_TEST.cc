@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2024 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "gz/math/Angle.hh"
+#include "gz/math/AxisAlignedBox.hh"
+#include "gz/math/Frustum.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/SphericalCoordinates.hh"
+#include "gz/math/Spline.hh"
+#include "gz/math/Vector3.hh"
+#include "gz/math/VolumetricGridLookupField.hh"
+
+using namespace gz;
+using namespace math;
+
+// Const member functions of objects shared across threads must not race.
+// These tests are meant to be run with -fsanitize=thread as well, which
+// reports the races that don't change the results.
+
+namespace
+{
+/// \brief Number of threads sharing each object.
+constexpr unsigned int kThreads = 8;
+
+/// \brief Run a function on several threads at once.
+/// \param[in] _fn Function called with the index of the thread.
+void RunConcurrently(const std::function<void(unsigned int)> &_fn)
+{
+  std::atomic<bool> start{false};
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < kThreads; ++t)
+  {
+    threads.emplace_back([&start, &_fn, t]()
+    {
+      // Start together, so the first calls overlap.
+      while (!start.load())
+        std::this_thread::yield();
+      _fn(t);
+    });
+  }
+  start = true;
+  for (auto &thread : threads)
+    thread.join();
+}
+
+/// \brief Fill a spline with a helix.
+/// \param[out] _spline The spline.
+/// \param[in] _radius Radius of the helix.
+void Helix(Spline &_spline, const double _radius)
+{
+  _spline.Clear();
+  for (int i = 0; i < 200; ++i)
+  {
+    _spline.AddPoint(Vector3d(_radius * std::cos(i * 0.2),
+                              _radius * std::sin(i * 0.2), i * 0.05));
+  }
+}
+}
+
+/////////////////////////////////////////////////
+TEST(ConcurrentConst, Spline)
+{
+  Spline shared;
+  Spline expected;
+  std::vector<Vector3d> points;
+  for (int i = 0; i < 100; ++i)
+    points.push_back(Vector3d(std::sin(i * 0.37) * 3, i * 0.1, 1.5));
+
+  // Every round starts with stale bounds, built by the first query.
+  for (const double radius : {1.0, 2.0, 0.5})
+  {
+    Helix(shared, radius);
+    Helix(expected, radius);
+    std::vector<double> parameters;
+    for (const auto &p : points)
+      parameters.push_back(expected.ClosestParameter(p));
+
+    std::atomic<int> mismatches{0};
+    RunConcurrently([&](unsigned int _t)
+    {
+      for (std::size_t i = _t; i < points.size() * 4; ++i)
+      {
+        const std::size_t p = i % points.size();
+        if (shared.ClosestParameter(points[p]) != parameters[p])
+          ++mismatches;
+        if (shared.Interpolate(parameters[p]) !=
+            expected.Interpolate(parameters[p]))
+        {
+          ++mismatches;
+        }
+      }
+      if (shared.ArcLength() != expected.ArcLength())
+        ++mismatches;
+    });
+    EXPECT_EQ(0, mismatches.load()) << radius;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ConcurrentConst, SphericalCoordinates)
+{
+  SphericalCoordinates shared(SphericalCoordinates::EARTH_WGS84);
+  SphericalCoordinates expected(SphericalCoordinates::EARTH_WGS84);
+  std::vector<Vector3d> positions;
+  for (int i = 0; i < 100; ++i)
+    positions.push_back(Vector3d(i * 13.0, -i * 7.0, i * 0.5));
+
+  // Every round starts with a setter, so the first conversion updates the
+  // cached rotations.
+  for (const double latitude : {0.1, -0.7, 1.2})
+  {
+    for (auto *sc : {&shared, &expected})
+    {
+      sc->SetLatitudeReference(Angle(latitude));
+      sc->SetLongitudeReference(Angle(latitude / 2));
+      sc->SetHeadingOffset(Angle(latitude / 3));
+    }
+
+    std::vector<Vector3d> spherical;
+    for (const auto &p : positions)
+    {
+      spherical.push_back(expected.SphericalFromLocalPosition(p));
+    }
+
+    std::atomic<int> mismatches{0};
+    RunConcurrently([&](unsigned int _t)
+    {
+      for (std::size_t i = _t; i < positions.size(); ++i)
+      {
+        if (shared.SphericalFromLocalPosition(positions[i]) != spherical[i])
+          ++mismatches;
+        if (shared.LocalFromSphericalPosition(spherical[i]) !=
+            expected.LocalFromSphericalPosition(spherical[i]))
+        {
+          ++mismatches;
+        }
+      }
+    });
+    EXPECT_EQ(0, mismatches.load()) << latitude;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ConcurrentConst, Frustum)
+{
+  const Frustum frustum(0.1, 50, Angle(GZ_PI * 0.5), 1.33,
+                        Pose3d(1, 2, 3, 0, 0.2, 0.4));
+  std::vector<AxisAlignedBox> boxes;
+  std::vector<bool> expected;
+  for (int i = 0; i < 200; ++i)
+  {
+    const Vector3d center(i * 0.3, std::sin(i * 0.1) * 10, 3);
+    boxes.push_back(AxisAlignedBox(center - Vector3d::One,
+                                   center + Vector3d::One));
+    expected.push_back(frustum.Contains(boxes.back()));
+  }
+
+  std::atomic<int> mismatches{0};
+  RunConcurrently([&](unsigned int _t)
+  {
+    for (std::size_t i = _t; i < boxes.size(); ++i)
+    {
+      if (frustum.Contains(boxes[i]) != expected[i])
+        ++mismatches;
+      if (frustum.Contains(boxes[i].Center()) !=
+          Frustum(frustum).Contains(boxes[i].Center()))
+      {
+        ++mismatches;
+      }
+    }
+  });
+  EXPECT_EQ(0, mismatches.load());
+}
+
+/////////////////////////////////////////////////
+TEST(ConcurrentConst, VolumetricGridLookupField)
+{
+  std::vector<Vector3d> cloud;
+  std::vector<double> values;
+  for (int x = 0; x < 10; ++x)
+  {
+    for (int y = 0; y < 10; ++y)
+    {
+      for (int z = 0; z < 10; ++z)
+      {
+        cloud.push_back(Vector3d(x, y * 0.5, z * 2));
+        values.push_back(x + y * 10 + z * 100);
+      }
+    }
+  }
+  const VolumetricGridLookupField<double> field(cloud);
+
+  std::vector<Vector3d> queries;
+  std::vector<std::optional<double>> expected;
+  for (int i = 0; i < 300; ++i)
+  {
+    queries.push_back(Vector3d(std::fmod(i * 0.37, 9.0),
+                               std::fmod(i * 0.11, 4.5),
+                               std::fmod(i * 0.53, 18.0)));
+    expected.push_back(field.EstimateValueUsingTrilinear(queries.back(),
+                                                         values));
+  }
+
+  std::atomic<int> mismatches{0};
+  RunConcurrently([&](unsigned int _t)
+  {
+    for (std::size_t i = _t; i < queries.size(); ++i)
+    {
+      if (field.EstimateValueUsingTrilinear(queries[i], values) !=
+          expected[i])
+      {
+        ++mismatches;
+      }
+    }
+  });
+  EXPECT_EQ(0, mismatches.load());
+}
+
+/////////////////////////////////////////////////
+TEST(ConcurrentConst, Rand)
+{
+  // Each thread has its own generator, so the streams are reproducible
+  // whatever the other threads do.
+  Rand::Seed(42);
+  std::vector<std::vector<double>> draws(kThreads);
+  RunConcurrently([&](unsigned int _t)
+  {
+    Rand::Stream(_t);
+    for (int i = 0; i < 1000; ++i)
+      draws[_t].push_back(Rand::DblUniform(0, 1));
+  });
+
+  std::vector<std::vector<double>> again(kThreads);
+  RunConcurrently([&](unsigned int _t)
+  {
+    Rand::Stream(_t);
+    for (int i = 0; i < 1000; ++i)
+      again[_t].push_back(Rand::DblUniform(0, 1));
+  });
+  EXPECT_EQ(draws, again);
+  EXPECT_NE(draws[0], draws[1]);
+}
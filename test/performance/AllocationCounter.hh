@@ -0,0 +1,315 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_MATH_TEST_PERFORMANCE_ALLOCATIONCOUNTER_HH_
+#define GZ_MATH_TEST_PERFORMANCE_ALLOCATIONCOUNTER_HH_
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+/// \brief Count the heap allocations of the calling thread, to check that
+/// hot paths don't allocate once warmed up, and measure the heap usage of
+/// the whole program.
+///
+/// This header replaces the global operator new and delete of the test
+/// executable, so it must be included by exactly one of its source files.
+/// The replacements forward to malloc and free, and count the calls to
+/// operator new made by each thread. Each allocation is prefixed with its
+/// size, so that the bytes in use can be tracked. Allocations made
+/// directly with malloc are not counted.
+namespace benchmark
+{
+  namespace detail
+  {
+    /// \brief Heap usage of the whole program.
+    struct HeapCounters
+    {
+      /// \brief Number of calls to operator new.
+      std::atomic<std::uint64_t> allocations{0};
+
+      /// \brief Bytes currently allocated with operator new.
+      std::atomic<std::size_t> bytes{0};
+
+      /// \brief Largest value of bytes since the last reset.
+      std::atomic<std::size_t> peak{0};
+    };
+
+    /// \brief Get the heap usage of the whole program.
+    /// \return The counters, alive for the whole program.
+    inline HeapCounters &Heap()
+    {
+      static HeapCounters counters;
+      return counters;
+    }
+
+    /// \brief Get the number of calls to operator new made by the calling
+    /// thread.
+    /// \return The counter of the calling thread.
+    inline std::uint64_t &ThreadAllocations()
+    {
+      thread_local std::uint64_t count = 0;
+      return count;
+    }
+
+    /// \brief Get the size of the prefix of an allocation, which holds
+    /// its size and keeps the alignment of the memory after it.
+    /// \param[in] _alignment Alignment, 0 for the default one.
+    /// \return Number of bytes before the memory returned by Allocate.
+    inline std::size_t HeaderSize(std::size_t _alignment)
+    {
+      return std::max(_alignment, alignof(std::max_align_t));
+    }
+
+    /// \brief Allocate memory and count the allocation.
+    /// \param[in] _size Number of bytes.
+    /// \param[in] _alignment Alignment, 0 for the default one.
+    /// \return The memory, nullptr on failure.
+    inline void *Allocate(std::size_t _size, std::size_t _alignment)
+    {
+      ++ThreadAllocations();
+      if (_size == 0)
+        _size = 1;
+      const std::size_t header = HeaderSize(_alignment);
+      void *block = nullptr;
+      if (_alignment <= alignof(std::max_align_t))
+      {
+        block = std::malloc(header + _size);
+      }
+      else
+      {
+#ifdef _MSC_VER
+        block = _aligned_malloc(header + _size, _alignment);
+#else
+        // aligned_alloc needs a multiple of the alignment
+        block = std::aligned_alloc(_alignment,
+            (header + _size + _alignment - 1) / _alignment * _alignment);
+#endif
+      }
+      if (block == nullptr)
+        return nullptr;
+
+      char *ptr = static_cast<char *>(block) + header;
+      *reinterpret_cast<std::size_t *>(ptr - sizeof(std::size_t)) = _size;
+      auto &heap = Heap();
+      ++heap.allocations;
+      const std::size_t bytes = heap.bytes += _size;
+      std::size_t peak = heap.peak;
+      while (bytes > peak && !heap.peak.compare_exchange_weak(peak, bytes))
+      {
+      }
+      return ptr;
+    }
+
+    /// \brief Free memory from Allocate.
+    /// \param[in] _ptr The memory, may be nullptr.
+    /// \param[in] _alignment Alignment given to Allocate.
+    inline void Free(void *_ptr, std::size_t _alignment) noexcept
+    {
+      if (_ptr == nullptr)
+        return;
+      char *ptr = static_cast<char *>(_ptr);
+      Heap().bytes -= *reinterpret_cast<std::size_t *>(
+          ptr - sizeof(std::size_t));
+      void *block = ptr - HeaderSize(_alignment);
+#ifdef _MSC_VER
+      if (_alignment > alignof(std::max_align_t))
+      {
+        _aligned_free(block);
+        return;
+      }
+#endif
+      std::free(block);
+    }
+
+    /// \brief Allocate memory and count the allocation, or throw.
+    /// \param[in] _size Number of bytes.
+    /// \param[in] _alignment Alignment, 0 for the default one.
+    /// \return The memory.
+    inline void *AllocateOrThrow(std::size_t _size, std::size_t _alignment)
+    {
+      void *ptr = Allocate(_size, _alignment);
+      if (ptr == nullptr)
+        throw std::bad_alloc();
+      return ptr;
+    }
+  }
+
+  /// \brief Counts the heap allocations made by the calling thread since
+  /// its construction, such as the allocations of a function under test.
+  class AllocationCounter
+  {
+    /// \brief Constructor, starts counting.
+    public: AllocationCounter()
+      : start(detail::ThreadAllocations())
+    {
+    }
+
+    /// \brief Get the number of allocations since the construction.
+    /// \return Number of calls to operator new by the calling thread.
+    public: std::uint64_t Count() const
+    {
+      return detail::ThreadAllocations() - this->start;
+    }
+
+    /// \brief Count of the thread at construction.
+    private: std::uint64_t start;
+  };
+
+  /// \brief Measures the heap usage of all the threads of the program
+  /// since its construction, such as a benchmark that starts threads. Its
+  /// construction resets the peak usage, so only one should be alive at a
+  /// time.
+  class HeapUsage
+  {
+    /// \brief Constructor, starts measuring.
+    public: HeapUsage()
+      : allocations(detail::Heap().allocations),
+        bytes(detail::Heap().bytes)
+    {
+      detail::Heap().peak = this->bytes;
+    }
+
+    /// \brief Get the number of allocations since the construction.
+    /// \return Number of calls to operator new by all threads.
+    public: std::uint64_t Allocations() const
+    {
+      return detail::Heap().allocations - this->allocations;
+    }
+
+    /// \brief Get the largest number of bytes allocated at once since the
+    /// construction, on top of the bytes allocated at construction.
+    /// \return Peak number of bytes.
+    public: std::size_t PeakBytes() const
+    {
+      return detail::Heap().peak - this->bytes;
+    }
+
+    /// \brief Number of allocations at construction.
+    private: std::uint64_t allocations;
+
+    /// \brief Bytes allocated at construction.
+    private: std::size_t bytes;
+  };
+
+  /// \brief Check that a callable doesn't allocate once warmed up. The
+  /// callable is run once to fill caches and grow buffers, then the
+  /// allocations of the next runs are counted. The count is recorded as a
+  /// test property named `<name>_allocations`.
+  /// \param[in] _name Name of the check, used as the property key.
+  /// \param[in] _iterations Number of counted runs.
+  /// \param[in] _func Callable to check.
+  /// \return Number of allocations of the counted runs.
+  template<typename F>
+  std::uint64_t ExpectNoAllocations(const std::string &_name,
+      std::size_t _iterations, F &&_func)
+  {
+    _func();
+
+    const AllocationCounter counter;
+    for (std::size_t i = 0; i < _iterations; ++i)
+      _func();
+    const std::uint64_t count = counter.Count();
+
+    ::testing::Test::RecordProperty(_name + "_allocations",
+        std::to_string(count));
+    EXPECT_EQ(0u, count) << _name << " allocated " << count
+                         << " times in " << _iterations << " runs";
+    return count;
+  }
+}
+
+void *operator new(std::size_t _size)
+{
+  return benchmark::detail::AllocateOrThrow(_size, 0);
+}
+
+void *operator new[](std::size_t _size)
+{
+  return benchmark::detail::AllocateOrThrow(_size, 0);
+}
+
+void *operator new(std::size_t _size, const std::nothrow_t &) noexcept
+{
+  return benchmark::detail::Allocate(_size, 0);
+}
+
+void *operator new[](std::size_t _size, const std::nothrow_t &) noexcept
+{
+  return benchmark::detail::Allocate(_size, 0);
+}
+
+void *operator new(std::size_t _size, std::align_val_t _alignment)
+{
+  return benchmark::detail::AllocateOrThrow(_size,
+      static_cast<std::size_t>(_alignment));
+}
+
+void *operator new[](std::size_t _size, std::align_val_t _alignment)
+{
+  return benchmark::detail::AllocateOrThrow(_size,
+      static_cast<std::size_t>(_alignment));
+}
+
+void operator delete(void *_ptr) noexcept
+{
+  benchmark::detail::Free(_ptr, 0);
+}
+
+void operator delete[](void *_ptr) noexcept
+{
+  benchmark::detail::Free(_ptr, 0);
+}
+
+void operator delete(void *_ptr, std::size_t) noexcept
+{
+  benchmark::detail::Free(_ptr, 0);
+}
+
+void operator delete[](void *_ptr, std::size_t) noexcept
+{
+  benchmark::detail::Free(_ptr, 0);
+}
+
+void operator delete(void *_ptr, std::align_val_t _alignment) noexcept
+{
+  benchmark::detail::Free(_ptr, static_cast<std::size_t>(_alignment));
+}
+
+void operator delete[](void *_ptr, std::align_val_t _alignment) noexcept
+{
+  benchmark::detail::Free(_ptr, static_cast<std::size_t>(_alignment));
+}
+
+void operator delete(void *_ptr, std::size_t,
+                     std::align_val_t _alignment) noexcept
+{
+  benchmark::detail::Free(_ptr, static_cast<std::size_t>(_alignment));
+}
+
+void operator delete[](void *_ptr, std::size_t,
+                       std::align_val_t _alignment) noexcept
+{
+  benchmark::detail::Free(_ptr, static_cast<std::size_t>(_alignment));
+}
+
+#endif
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_MATH_TEST_PERFORMANCE_BENCHMARK_HH_
+#define GZ_MATH_TEST_PERFORMANCE_BENCHMARK_HH_
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <string>
+
+#include "gz/math/Stopwatch.hh"
+
+/// \brief Small helpers shared by the performance tests.
+///
+/// Each benchmark is a regular gtest case. The measured time per iteration
+/// is printed and recorded as a test property named `<name>_ns`, so running
+/// a performance test with `--gtest_output=json:<file>` produces a JSON
+/// report that can be compared between gz-math versions.
+///
+/// The iteration counts chosen by the tests are multiplied by the value of
+/// the `GZ_MATH_BENCHMARK_SCALE` environment variable, if set. The default
+/// keeps every performance test short enough to run as part of ctest.
+///
+/// Comparative benchmarks time the same operation in gz-math and in a
+/// reference implementation, and report the ratio of the two times next to
+/// a stored baseline. Ratios depend much less on the machine than absolute
+/// times, but still depend on the compiler and the CPU, so they only fail
+/// when the `GZ_MATH_BENCHMARK_TOLERANCE` environment variable sets the
+/// allowed regression in percent.
+namespace benchmark
+{
+  /// \brief Prevent the compiler from optimizing away a computed value.
+  /// \param[in] _value Value that must be considered used.
+  template<typename T>
+  inline void DoNotOptimize(const T &_value)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&_value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &_value;
+#endif
+  }
+
+  /// \brief Get the iteration multiplier from GZ_MATH_BENCHMARK_SCALE.
+  /// \return The multiplier, 1 if unset or invalid.
+  inline std::size_t Scale()
+  {
+    const char *env = std::getenv("GZ_MATH_BENCHMARK_SCALE");
+    if (env == nullptr)
+      return 1u;
+    const long value = std::strtol(env, nullptr, 10);
+    return value > 0 ? static_cast<std::size_t>(value) : 1u;
+  }
+
+  /// \brief Get the allowed regression of comparative benchmarks from
+  /// GZ_MATH_BENCHMARK_TOLERANCE.
+  /// \return The tolerance in percent, or nullopt if unset or invalid,
+  /// in which case the comparisons are only reported.
+  inline std::optional<double> Tolerance()
+  {
+    const char *env = std::getenv("GZ_MATH_BENCHMARK_TOLERANCE");
+    if (env == nullptr)
+      return std::nullopt;
+    char *end = nullptr;
+    const double value = std::strtod(env, &end);
+    if (end == env || value < 0.0)
+      return std::nullopt;
+    return value;
+  }
+
+  /// \brief Time a callable and record the mean time per iteration.
+  /// The callable is run once before timing to warm up caches.
+  /// \param[in] _name Name of the benchmark, used as the property key.
+  /// \param[in] _iterations Number of timed iterations, before scaling.
+  /// \param[in] _func Callable to benchmark.
+  /// \return Mean time per iteration in nanoseconds.
+  template<typename F>
+  double Run(const std::string &_name, std::size_t _iterations, F &&_func)
+  {
+    const std::size_t iterations = std::max<std::size_t>(1u,
+        _iterations * Scale());
+
+    _func();
+
+    gz::math::Stopwatch watch;
+    watch.Start(true);
+    for (std::size_t i = 0; i < iterations; ++i)
+      _func();
+    watch.Stop();
+
+    const double ns = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          watch.ElapsedRunTime()).count()) / static_cast<double>(iterations);
+
+    ::testing::Test::RecordProperty(_name + "_ns", std::to_string(ns));
+    ::testing::Test::RecordProperty(_name + "_iterations",
+        std::to_string(iterations));
+    std::cout << "[ BENCHMARK ] " << _name << ": " << ns << " ns/iter ("
+              << iterations << " iterations)" << std::endl;
+    return ns;
+  }
+
+  /// \brief Compare the time of a kernel with the time of a reference
+  /// implementation of the same operation. The ratio of the two times is
+  /// printed and recorded as a test property named `<name>_ratio`.
+  /// \param[in] _name Name of the comparison, used as the property key.
+  /// \param[in] _ns Time per iteration of the kernel.
+  /// \param[in] _referenceNs Time per iteration of the reference.
+  /// \param[in] _baseline Stored ratio of the two times.
+  /// \return False if Tolerance() is set and the ratio exceeds _baseline
+  /// by more than Tolerance() percent.
+  inline bool Compare(const std::string &_name, double _ns,
+                      double _referenceNs, double _baseline)
+  {
+    const double ratio = _ns / std::max(_referenceNs, 1e-3);
+    const std::optional<double> tolerance = Tolerance();
+
+    ::testing::Test::RecordProperty(_name + "_ratio", std::to_string(ratio));
+    std::cout << "[ COMPARE   ] " << _name << ": " << ratio
+              << " (baseline " << _baseline;
+    if (!tolerance)
+    {
+      std::cout << ")" << std::endl;
+      return true;
+    }
+
+    const double limit = _baseline * (1.0 + *tolerance / 100.0);
+    const bool pass = ratio <= limit;
+    std::cout << ", limit " << limit << ")"
+              << (pass ? "" : " REGRESSION") << std::endl;
+    return pass;
+  }
+}
+
+#endif
@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "gz/math/AxisAlignedBoxT.hh"
+#include "gz/math/Box.hh"
+#include "gz/math/ColorMap.hh"
+#include "gz/math/DiffDriveOdometry.hh"
+#include "gz/math/GaussMarkovProcess.hh"
+#include "gz/math/MovingWindowFilter.hh"
+#include "gz/math/PID.hh"
+#include "gz/math/PreparedTriangle.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/RayPacket.hh"
+#include "gz/math/SignalPyramid.hh"
+#include "gz/math/SignalStats.hh"
+#include "gz/math/Spline.hh"
+#include "gz/math/VolumetricGridLookupField.hh"
+
+#include "AllocationCounter.hh"
+#include "Benchmark.hh"
+
+using namespace gz;
+using namespace math;
+
+// The hot paths below must not allocate once warmed up, so they can run
+// in real time loops. Each check runs a call once, then counts the heap
+// allocations of the next calls.
+
+/////////////////////////////////////////////////
+TEST(Allocations, Counter)
+{
+  benchmark::AllocationCounter counter;
+  EXPECT_EQ(0u, counter.Count());
+  std::vector<int> values(10);
+  benchmark::DoNotOptimize(values);
+  EXPECT_EQ(1u, counter.Count());
+  values.reserve(100);
+  EXPECT_EQ(2u, counter.Count());
+}
+
+/////////////////////////////////////////////////
+TEST(Allocations, VolumetricGrid)
+{
+  std::vector<Vector3d> cloud;
+  for (double x = 0; x < 10; x += 1)
+    for (double y = 0; y < 10; y += 1)
+      for (double z = 0; z < 5; z += 1)
+        cloud.emplace_back(x, y, z);
+  std::vector<double> values(cloud.size());
+  for (std::size_t i = 0; i < values.size(); ++i)
+    values[i] = static_cast<double>(i);
+  const VolumetricGridLookupField<double> field(cloud);
+
+  Rand::Seed(42);
+  std::vector<Vector3d> queries(100);
+  for (auto &q : queries)
+  {
+    q.Set(Rand::DblUniform(0, 9), Rand::DblUniform(0, 9),
+          Rand::DblUniform(0, 4));
+  }
+
+  InterpolationPoints3D<double> interpolators;
+  VolumetricGridCursor cursor;
+  benchmark::ExpectNoAllocations("VolumetricGrid_interpolators", 10, [&]()
+  {
+    for (const auto &q : queries)
+      field.GetInterpolators(q, interpolators, cursor);
+    benchmark::DoNotOptimize(interpolators);
+  });
+
+  benchmark::ExpectNoAllocations("VolumetricGrid_estimate", 10, [&]()
+  {
+    double sum = 0;
+    for (const auto &q : queries)
+      sum += field.EstimateValueUsingTrilinear(q, values).value_or(0.0);
+    benchmark::DoNotOptimize(sum);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(Allocations, Control)
+{
+  DiffDriveOdometry odom;
+  odom.SetWheelParams(2.0, 0.5, 0.5);
+  auto time = std::chrono::steady_clock::time_point();
+  odom.Init(time);
+  double angle = 0;
+  benchmark::ExpectNoAllocations("DiffDriveOdometry_update", 100, [&]()
+  {
+    angle += 0.01;
+    time += std::chrono::milliseconds(10);
+    odom.Update(Angle(angle), Angle(1.1 * angle), time);
+    benchmark::DoNotOptimize(odom);
+  });
+
+  PID pid(1.0, 0.1, 0.01, 1.0, -1.0, 10.0, -10.0);
+  benchmark::ExpectNoAllocations("PID_update", 100, [&]()
+  {
+    benchmark::DoNotOptimize(
+        pid.Update(0.5, std::chrono::milliseconds(1)));
+  });
+
+  MovingWindowFilter<double> filter(16);
+  benchmark::ExpectNoAllocations("MovingWindowFilter_update", 100, [&]()
+  {
+    filter.Update(angle);
+    benchmark::DoNotOptimize(filter.Value());
+  });
+
+  MovingWindowFilterQuaterniond rotations(16);
+  benchmark::ExpectNoAllocations("MovingWindowFilter_quaternion", 100, [&]()
+  {
+    rotations.Update(Quaterniond(0, 0, angle));
+    benchmark::DoNotOptimize(rotations.Value());
+  });
+
+  GaussMarkovProcess process(0.0, 1.0, 0.0, 0.1);
+  benchmark::ExpectNoAllocations("GaussMarkovProcess_update", 100, [&]()
+  {
+    benchmark::DoNotOptimize(process.Update(0.01));
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(Allocations, Signals)
+{
+  Rand::Seed(42);
+  std::vector<double> data(1000);
+  Rand::FillNormal(data.data(), data.size());
+
+  SignalStats stats;
+  EXPECT_TRUE(stats.InsertStatistics("mean,rms,maxAbs,var"));
+  benchmark::ExpectNoAllocations("SignalStats_insert_batch", 10, [&]()
+  {
+    stats.InsertData(data.data(), data.size());
+    benchmark::DoNotOptimize(stats);
+  });
+
+  SignalPyramid pyramid(10, 10, 3, 100);
+  std::vector<SignalBucket> buckets(pyramid.Capacity());
+  benchmark::ExpectNoAllocations("SignalPyramid_insert_batch", 10, [&]()
+  {
+    pyramid.InsertData(data.data(), data.size());
+    pyramid.Export(0, buckets.data());
+    benchmark::DoNotOptimize(buckets);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(Allocations, Batches)
+{
+  std::vector<double> doubles(1000);
+  std::vector<int32_t> ints(1000);
+  benchmark::ExpectNoAllocations("Rand_fill", 10, [&]()
+  {
+    Rand::FillUniform(doubles.data(), doubles.size());
+    Rand::FillNormal(doubles.data(), doubles.size());
+    Rand::FillIntUniform(ints.data(), ints.size(), 0, 99);
+    benchmark::DoNotOptimize(doubles);
+    benchmark::DoNotOptimize(ints);
+  });
+
+  Spline spline;
+  for (int i = 0; i < 100; ++i)
+    spline.AddPoint(Vector3d(i, std::sin(0.1 * i), 0));
+  std::vector<double> t(1000);
+  for (std::size_t i = 0; i < t.size(); ++i)
+    t[i] = static_cast<double>(i) / t.size();
+  std::vector<Vector3d> points(t.size());
+  std::vector<SplineFrame> frames(t.size());
+  benchmark::ExpectNoAllocations("Spline_interpolate_batch", 10, [&]()
+  {
+    spline.Interpolate(t.data(), points.data(), t.size());
+    spline.InterpolateFrames(t.data(), frames.data(), t.size());
+    benchmark::DoNotOptimize(points);
+    benchmark::DoNotOptimize(frames);
+  });
+
+  const PreparedTriangled triangle(
+      Triangled(Vector2d(0, 0), Vector2d(1, 0), Vector2d(0, 1)));
+  std::vector<Vector2d> points2(1000);
+  for (std::size_t i = 0; i < points2.size(); ++i)
+    points2[i].Set(doubles[i], 1 - doubles[i] * doubles[i]);
+  std::vector<std::uint8_t> inside(points2.size());
+  benchmark::ExpectNoAllocations("PreparedTriangle_contains", 10, [&]()
+  {
+    benchmark::DoNotOptimize(
+        triangle.Contains(points2.data(), inside.data(), points2.size()));
+  });
+
+  const ColorMap colorMap({{0.0, Color::Blue}, {1.0, Color::Red}}, 4096);
+  std::vector<Color::RGBA> colors(doubles.size());
+  benchmark::ExpectNoAllocations("ColorMap_map", 10, [&]()
+  {
+    colorMap.Map(doubles.data(), colors.data(), doubles.size());
+    benchmark::DoNotOptimize(colors);
+  });
+
+  const std::vector<Boxd> boxes(100, Boxd(1.0, 2.0, 0.5));
+  std::vector<Pose3d> poses(boxes.size());
+  for (std::size_t i = 0; i < poses.size(); ++i)
+    poses[i].Set(doubles[i], 0, 0.1, 0.1 * doubles[i], 0.2, 0);
+  std::vector<Vector3d> polygons(boxes.size() * Boxd::kMaxIntersections);
+  std::vector<std::size_t> offsets(boxes.size() + 1);
+  benchmark::ExpectNoAllocations("Box_intersection_polygons", 10, [&]()
+  {
+    benchmark::DoNotOptimize(Boxd::IntersectionPolygons(boxes.data(),
+        poses.data(), boxes.size(), Planed(Vector3d::UnitZ, 0.0),
+        polygons.data(), offsets.data()));
+  });
+
+  RayPacketd rays;
+  for (std::size_t i = 0; i < 256; ++i)
+    rays.Add(Vector3d(-5, doubles[i], 0), Vector3d(1, 0, 0), 0, 10);
+  const AxisAlignedBoxd box(Vector3d(-1, -1, -1), Vector3d(1, 1, 1));
+  std::vector<double> distances(rays.Size());
+  benchmark::ExpectNoAllocations("RayPacket_intersect", 10, [&]()
+  {
+    benchmark::DoNotOptimize(
+        rays.Intersect(box, inside.data(), distances.data()));
+  });
+}
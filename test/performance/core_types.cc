@@ -0,0 +1,4737 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <memory_resource>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "gz/math/AdditivelySeparableScalarField3.hh"
+#include "gz/math/Angle.hh"
+#include "gz/math/AxisAlignedBox.hh"
+#include "gz/math/AxisAlignedBoxT.hh"
+#include "gz/math/AxisAlignedBoxTree.hh"
+#include "gz/math/Box.hh"
+#include "gz/math/Capsule.hh"
+#include "gz/math/CapsuleArray.hh"
+#include "gz/math/Color.hh"
+#include "gz/math/ColorMap.hh"
+#include "gz/math/ConvexHull3.hh"
+#include "gz/math/Cylinder.hh"
+#include "gz/math/DiffDriveOdometry.hh"
+#include "gz/math/DiffDriveOdometryBank.hh"
+#include "gz/math/Ellipsoid.hh"
+#include "gz/math/Filter.hh"
+#include "gz/math/Frustum.hh"
+#include "gz/math/Helpers.hh"
+#include "gz/math/GaussMarkovProcess.hh"
+#include "gz/math/GaussMarkovProcessBank.hh"
+#include "gz/math/Inertial.hh"
+#include "gz/math/KdTree.hh"
+#include "gz/math/Kmeans.hh"
+#include "gz/math/Line2.hh"
+#include "gz/math/Line2Array.hh"
+#include "gz/math/Line3.hh"
+#include "gz/math/Line3Array.hh"
+#include "gz/math/LoopTimer.hh"
+#include "gz/math/MassMatrix3.hh"
+#include "gz/math/Material.hh"
+#include "gz/math/MaterialT.hh"
+#include "gz/math/Matrix3Array.hh"
+#include "gz/math/Matrix4.hh"
+#include "gz/math/Matrix6.hh"
+#include "gz/math/MecanumDriveOdometry.hh"
+#include "gz/math/MovingWindowFilter.hh"
+#include "gz/math/OrientedBox.hh"
+#include "gz/math/PID.hh"
+#include "gz/math/PIDBank.hh"
+#include "gz/math/PIDT.hh"
+#include "gz/math/PiecewiseScalarField3.hh"
+#include "gz/math/PointCloudFilter.hh"
+#include "gz/math/PreparedTriangle.hh"
+#include "gz/math/PreparedTriangle3.hh"
+#include "gz/math/Polynomial3.hh"
+#include "gz/math/Pose3.hh"
+#include "gz/math/Pose3Trajectory.hh"
+#include "gz/math/Quaternion.hh"
+#include "gz/math/QuaternionArray.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/RayPacket.hh"
+#include "gz/math/Region3Array.hh"
+#include "gz/math/RigidTransform3.hh"
+#include "gz/math/RotationSpline.hh"
+#include "gz/math/SemanticVersion.hh"
+#include "gz/math/SignalPyramid.hh"
+#include "gz/math/SignalStats.hh"
+#include "gz/math/SignalStatsT.hh"
+#include "gz/math/SparseOctree.hh"
+#include "gz/math/SpatialHashGrid.hh"
+#include "gz/math/SpeedLimiter.hh"
+#include "gz/math/SphereArray.hh"
+#include "gz/math/SphericalCoordinates.hh"
+#include "gz/math/SphericalPointIndex.hh"
+#include "gz/math/Spline.hh"
+#include "gz/math/SpscRingBuffer.hh"
+#include "gz/math/Stopwatch.hh"
+#include "gz/math/SweepAndPrune.hh"
+#include "gz/math/Temperature.hh"
+#include "gz/math/TemperatureT.hh"
+#include "gz/math/TimeVaryingVolumetricGrid.hh"
+#include "gz/math/Triangle.hh"
+#include "gz/math/Triangle3.hh"
+#include "gz/math/Triangle3Array.hh"
+#include "gz/math/Vector3.hh"
+#include "gz/math/Vector3Array.hh"
+#include "gz/math/Vector3Stats.hh"
+#include "gz/math/VectorHash.hh"
+#include "gz/math/VolumetricGridLookupField.hh"
+#include "gz/math/graph/CsrGraph.hh"
+#include "gz/math/graph/Graph.hh"
+#include "gz/math/graph/GraphAlgorithms.hh"
+
+#include "Benchmark.hh"
+
+using namespace gz;
+using namespace math;
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, Vector3)
+{
+  Vector3d a(1.1, -2.2, 3.3);
+  const Vector3d b(0.4, 0.5, -0.6);
+
+  benchmark::Run("Vector3d_add_scale", 1000000, [&]()
+  {
+    a = (a + b) * 0.5;
+    benchmark::DoNotOptimize(a);
+  });
+
+  benchmark::Run("Vector3d_cross_dot", 1000000, [&]()
+  {
+    double d = a.Cross(b).Dot(a);
+    benchmark::DoNotOptimize(d);
+  });
+
+  benchmark::Run("Vector3d_normalized", 1000000, [&]()
+  {
+    Vector3d n = (a + b).Normalized();
+    benchmark::DoNotOptimize(n);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, VectorN)
+{
+  // Vector2, Vector3 and Vector4 share the kernels of detail::VectorN
+  Vector2d a2(1.1, -2.2);
+  const Vector2d b2(0.4, 0.5);
+  benchmark::Run("Vector2d_add_scale_dot", 1000000, [&]()
+  {
+    a2 = (a2 + b2) * 0.5;
+    benchmark::DoNotOptimize(a2.Dot(b2));
+  });
+
+  Vector3d a3(1.1, -2.2, 3.3);
+  const Vector3d b3(0.4, 0.5, -0.6);
+  benchmark::Run("Vector3d_add_scale_dot", 1000000, [&]()
+  {
+    a3 = (a3 + b3) * 0.5;
+    benchmark::DoNotOptimize(a3.Dot(b3));
+  });
+
+  Vector4d a4(1.1, -2.2, 3.3, -4.4);
+  const Vector4d b4(0.4, 0.5, -0.6, 0.7);
+  benchmark::Run("Vector4d_add_scale_dot", 1000000, [&]()
+  {
+    a4 = (a4 + b4) * 0.5;
+    benchmark::DoNotOptimize(a4.Dot(b4));
+  });
+
+  benchmark::Run("Vector4d_max_abs_finite", 1000000, [&]()
+  {
+    a4.Max(b4);
+    benchmark::DoNotOptimize(a4.Abs().Max());
+    benchmark::DoNotOptimize(a4.IsFinite());
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, Vector3Array)
+{
+  std::vector<Vector3d> points;
+  for (int i = 0; i < 10000; ++i)
+    points.emplace_back(i * 0.1, -i * 0.2, i * 0.3);
+  Vector3Arrayd array(points);
+  std::vector<double> lengths(points.size());
+
+  benchmark::Run("Vector3d_length_loop_x10000", 200, [&]()
+  {
+    for (std::size_t i = 0; i < points.size(); ++i)
+      lengths[i] = points[i].Length();
+    benchmark::DoNotOptimize(lengths);
+  });
+
+  benchmark::Run("Vector3Arrayd_length_x10000", 200, [&]()
+  {
+    array.Length(lengths);
+    benchmark::DoNotOptimize(lengths);
+  });
+
+  benchmark::Run("Vector3Arrayd_normalize_x10000", 200, [&]()
+  {
+    array.Normalize();
+    benchmark::DoNotOptimize(array);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, BoxVolumeBelow)
+{
+  // A hull of boxes rolling in the water
+  std::vector<Boxd> boxes;
+  std::vector<Pose3d> poses;
+  for (int i = 0; i < 100; ++i)
+  {
+    boxes.push_back(Boxd(1.0 + 0.01 * i, 0.5, 0.8));
+    poses.push_back(Pose3d(0.1 * i, 0.05 * i, 0.3 - 0.005 * i,
+                           0.2 + 0.003 * i, -0.1, 0.01 * i));
+  }
+  const Planed water(Vector3d::UnitZ, 0.0);
+  std::vector<double> volumes(boxes.size());
+  std::vector<Vector3d> centers(boxes.size());
+
+  benchmark::Run("Box_volume_below_loop_x100", 200, [&]()
+  {
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+      const Planed plane(poses[i].Rot().RotateVectorReverse(water.Normal()),
+          water.Offset() - water.Normal().Dot(poses[i].Pos()));
+      volumes[i] = boxes[i].VolumeBelow(plane);
+      centers[i] = boxes[i].CenterOfVolumeBelow(plane).value_or(Vector3d());
+    }
+    benchmark::DoNotOptimize(volumes);
+    benchmark::DoNotOptimize(centers);
+  });
+
+  benchmark::Run("Box_volumes_below_batch_x100", 200, [&]()
+  {
+    Boxd::VolumesBelow(boxes.data(), poses.data(), boxes.size(), water,
+        volumes.data(), centers.data());
+    benchmark::DoNotOptimize(volumes);
+    benchmark::DoNotOptimize(centers);
+  });
+
+  std::vector<Vector3d> points(boxes.size() * Boxd::kMaxIntersections);
+  std::vector<size_t> offsets(boxes.size() + 1);
+  benchmark::Run("Box_intersections_set_loop_x100", 200, [&]()
+  {
+    size_t total = 0;
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+      const Planed plane(poses[i].Rot().RotateVectorReverse(water.Normal()),
+          water.Offset() - water.Normal().Dot(poses[i].Pos()));
+      for (const auto &point : boxes[i].Intersections(plane))
+        points[total++] = poses[i].CoordPositionAdd(point);
+    }
+    benchmark::DoNotOptimize(points);
+  });
+
+  benchmark::Run("Box_intersection_polygons_batch_x100", 200, [&]()
+  {
+    Boxd::IntersectionPolygons(boxes.data(), poses.data(), boxes.size(),
+        water, points.data(), offsets.data());
+    benchmark::DoNotOptimize(points);
+    benchmark::DoNotOptimize(offsets);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, VolumesBelow)
+{
+  // Hulls of cylinders, capsules and ellipsoids rolling in the water
+  std::vector<Cylinderd> cylinders;
+  std::vector<Capsuled> capsules;
+  std::vector<Ellipsoidd> ellipsoids;
+  std::vector<Pose3d> poses;
+  for (int i = 0; i < 100; ++i)
+  {
+    cylinders.push_back(Cylinderd(1.0 + 0.01 * i, 0.4));
+    capsules.push_back(Capsuled(1.0 + 0.01 * i, 0.4));
+    ellipsoids.push_back(Ellipsoidd(Vector3d(1.0 + 0.01 * i, 0.5, 0.4)));
+    poses.push_back(Pose3d(0.1 * i, 0.05 * i, 0.3 - 0.005 * i,
+                           0.2 + 0.003 * i, -0.1, 0.01 * i));
+  }
+  const Planed water(Vector3d::UnitZ, 0.0);
+  std::vector<double> volumes(poses.size());
+  std::vector<Vector3d> centers(poses.size());
+
+  benchmark::Run("Cylinder_volumes_below_batch_x100", 200, [&]()
+  {
+    Cylinderd::VolumesBelow(cylinders.data(), poses.data(), poses.size(),
+        water, volumes.data(), centers.data());
+    benchmark::DoNotOptimize(volumes);
+    benchmark::DoNotOptimize(centers);
+  });
+
+  benchmark::Run("Capsule_volumes_below_batch_x100", 200, [&]()
+  {
+    Capsuled::VolumesBelow(capsules.data(), poses.data(), poses.size(),
+        water, volumes.data(), centers.data());
+    benchmark::DoNotOptimize(volumes);
+    benchmark::DoNotOptimize(centers);
+  });
+
+  benchmark::Run("Ellipsoid_volumes_below_batch_x100", 200, [&]()
+  {
+    Ellipsoidd::VolumesBelow(ellipsoids.data(), poses.data(), poses.size(),
+        water, volumes.data(), centers.data());
+    benchmark::DoNotOptimize(volumes);
+    benchmark::DoNotOptimize(centers);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, AdditivelySeparableScalarField3)
+{
+  const AdditivelySeparableScalarField3d<Polynomial3d> field(0.5,
+      Polynomial3d(Vector4d(1.0, -2.0, 0.5, 1.0)),
+      Polynomial3d(Vector4d(0.0, 1.0, -1.0, 0.0)),
+      Polynomial3d(Vector4d(-0.5, 0.0, 2.0, 3.0)));
+
+  std::vector<double> axis(64);
+  for (size_t i = 0; i < axis.size(); ++i)
+    axis[i] = -1.0 + 2.0 * i / axis.size();
+  std::vector<Vector3d> points;
+  for (const double z : axis)
+  {
+    for (const double y : axis)
+    {
+      for (const double x : axis)
+        points.push_back(Vector3d(x, y, z));
+    }
+  }
+  std::vector<double> values(points.size());
+
+  benchmark::Run("AdditivelySeparableScalarField3_evaluate_loop_64^3", 20,
+      [&]()
+  {
+    for (size_t i = 0; i < points.size(); ++i)
+      values[i] = field.Evaluate(points[i]);
+    benchmark::DoNotOptimize(values);
+  });
+
+  benchmark::Run("AdditivelySeparableScalarField3_evaluate_batch_64^3", 20,
+      [&]()
+  {
+    field.Evaluate(points.data(), values.data(), points.size());
+    benchmark::DoNotOptimize(values);
+  });
+
+  benchmark::Run("AdditivelySeparableScalarField3_evaluate_grid_64^3", 20,
+      [&]()
+  {
+    field.EvaluateGrid(axis.data(), axis.size(), axis.data(), axis.size(),
+                       axis.data(), axis.size(), values.data());
+    benchmark::DoNotOptimize(values);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, PiecewiseScalarField3)
+{
+  using Field = std::function<double(const Vector3d &)>;
+  std::vector<PiecewiseScalarField3d<Field>::Piece> pieces;
+  for (int i = 0; i < 22; ++i)
+  {
+    for (int j = 0; j < 22; ++j)
+    {
+      for (int k = 0; k < 22; ++k)
+      {
+        pieces.push_back({Region3d(Intervald::LeftClosed(i, i + 1.0),
+            Intervald::LeftClosed(j, j + 1.0),
+            Intervald::LeftClosed(k, k + 1.0)),
+            [](const Vector3d &_p) { return _p.X(); }});
+      }
+    }
+  }
+
+  std::optional<PiecewiseScalarField3d<Field>> field;
+  benchmark::Run("PiecewiseScalarField3_build_10648_pieces", 5, [&]()
+  {
+    field.emplace(pieces);
+    benchmark::DoNotOptimize(field);
+  });
+
+  Rand::Seed(7);
+  std::vector<Vector3d> points(100000);
+  for (Vector3d &p : points)
+  {
+    p.Set(Rand::DblUniform(0, 22), Rand::DblUniform(0, 22),
+          Rand::DblUniform(0, 22));
+  }
+  std::vector<double> values(points.size());
+  benchmark::Run("PiecewiseScalarField3_evaluate_random_x100000", 10, [&]()
+  {
+    for (size_t i = 0; i < points.size(); ++i)
+      values[i] = (*field)(points[i]);
+    benchmark::DoNotOptimize(values);
+  });
+
+  // Consecutive points along a line mostly stay in the same region.
+  for (size_t i = 0; i < points.size(); ++i)
+    points[i].Set(22.0 * i / points.size(), 10.5, 10.5);
+  benchmark::Run("PiecewiseScalarField3_evaluate_batch_line_x100000", 10, [&]()
+  {
+    field->Evaluate(points.data(), values.data(), points.size());
+    benchmark::DoNotOptimize(values);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, Polynomial3)
+{
+  const Polynomial3d poly(Vector4d(0.5, -2.0, 1.0, 3.0));
+  std::vector<double> x(100000);
+  for (size_t i = 0; i < x.size(); ++i)
+    x[i] = -5.0 + 10.0 * static_cast<double>(i) / x.size();
+  std::vector<double> y(x.size());
+
+  benchmark::Run("Polynomial3_evaluate_loop_x100000", 50, [&]()
+  {
+    for (size_t i = 0; i < x.size(); ++i)
+      y[i] = poly.Evaluate(x[i]);
+    benchmark::DoNotOptimize(y);
+  });
+
+  benchmark::Run("Polynomial3_evaluate_batch_x100000", 50, [&]()
+  {
+    poly.Evaluate(x.data(), y.data(), x.size());
+    benchmark::DoNotOptimize(y);
+  });
+
+  // The local minimum is found once, when the polynomial is built.
+  const Intervald interval = Intervald::Closed(-1.0, 4.0);
+  benchmark::Run("Polynomial3_minimum_x100000", 50, [&]()
+  {
+    double sum = 0.0;
+    for (int i = 0; i < 100000; ++i)
+      sum += poly.Minimum(interval);
+    benchmark::DoNotOptimize(sum);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, MassMatrix3)
+{
+  // Inertials of rotated boxes, as when validating the links of a world
+  std::vector<MassMatrix3d> inertials(100);
+  for (int i = 0; i < 100; ++i)
+  {
+    inertials[i].SetFromBox(1.0 + 0.1 * i,
+        Vector3d(1.0 + 0.01 * i, 0.5, 0.8),
+        Quaterniond(0.2 + 0.003 * i, -0.1, 0.01 * i));
+  }
+  Vector3d size;
+  Quaterniond rot;
+
+  benchmark::Run("MassMatrix3d_equivalent_box_x100", 1000, [&]()
+  {
+    for (const MassMatrix3d &m : inertials)
+    {
+      m.EquivalentBox(size, rot);
+      benchmark::DoNotOptimize(size);
+      benchmark::DoNotOptimize(rot);
+    }
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, MassMatrix3Validate)
+{
+  // Links of a large procedurally generated world, checked on load
+  const std::size_t count = 100000;
+  std::vector<MassMatrix3d> links(count);
+  std::vector<double> mass(count), ixx(count), iyy(count), izz(count);
+  std::vector<double> ixy(count), ixz(count), iyz(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    links[i] = MassMatrix3d(1.0 + 0.001 * (i % 100),
+      Vector3d(2.0 + 0.01 * (i % 13), 3.0, 4.0 - 0.02 * (i % 7)),
+      Vector3d(0.1 * (i % 3), -0.05 * (i % 5), 0.02 * (i % 11)));
+    mass[i] = links[i].Mass();
+    ixx[i] = links[i].Ixx();
+    iyy[i] = links[i].Iyy();
+    izz[i] = links[i].Izz();
+    ixy[i] = links[i].Ixy();
+    ixz[i] = links[i].Ixz();
+    iyz[i] = links[i].Iyz();
+  }
+  std::vector<std::uint8_t> flags(count);
+
+  benchmark::Run("MassMatrix3d_checks_each_x100000", 20, [&]()
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      flags[i] = static_cast<std::uint8_t>(links[i].IsNearPositive() |
+        (links[i].IsPositive() << 1) |
+        (MassMatrix3d::ValidMoments(links[i].PrincipalMoments()) << 2) |
+        (links[i].IsValid() << 3));
+    }
+    benchmark::DoNotOptimize(flags);
+  });
+
+  benchmark::Run("MassMatrix3d_validate_x100000", 20, [&]()
+  {
+    benchmark::DoNotOptimize(MassMatrix3d::Validate(mass.data(),
+      ixx.data(), iyy.data(), izz.data(), ixy.data(), ixz.data(),
+      iyz.data(), flags.data(), count));
+    benchmark::DoNotOptimize(flags);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, MassMatrix3TriangleMesh)
+{
+  // Closed grid of 2 * 500 * 1000 triangles on a torus
+  const unsigned int rings = 500;
+  const unsigned int segments = 1000;
+  std::vector<Vector3d> vertices;
+  for (unsigned int i = 0; i < rings; ++i)
+  {
+    const double theta = 2 * GZ_PI * i / rings;
+    for (unsigned int j = 0; j < segments; ++j)
+    {
+      const double phi = 2 * GZ_PI * j / segments;
+      const double r = 2.0 + 0.5 * std::cos(phi);
+      vertices.push_back(Vector3d(r * std::cos(theta), r * std::sin(theta),
+                                  0.5 * std::sin(phi)));
+    }
+  }
+  std::vector<unsigned int> indices;
+  for (unsigned int i = 0; i < rings; ++i)
+  {
+    for (unsigned int j = 0; j < segments; ++j)
+    {
+      const unsigned int a = i * segments + j;
+      const unsigned int b = i * segments + (j + 1) % segments;
+      const unsigned int c = ((i + 1) % rings) * segments + j;
+      const unsigned int d = ((i + 1) % rings) * segments + (j + 1) % segments;
+      indices.insert(indices.end(), {a, c, d, a, d, b});
+    }
+  }
+  MassMatrix3d m;
+  Vector3d center;
+
+  benchmark::Run("MassMatrix3d_triangle_mesh_1M_1_thread", 10, [&]()
+  {
+    m.SetFromTriangleMesh(1000.0, vertices.data(), vertices.size(),
+        indices.data(), indices.size() / 3, center);
+    benchmark::DoNotOptimize(m);
+  });
+
+  benchmark::Run("MassMatrix3d_triangle_mesh_1M_all_threads", 10, [&]()
+  {
+    m.SetFromTriangleMesh(1000.0, vertices.data(), vertices.size(),
+        indices.data(), indices.size() / 3, center, 0);
+    benchmark::DoNotOptimize(m);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, InertialSum)
+{
+  // Links of a model merged by fixed joint reduction
+  std::vector<Inertiald> links;
+  for (int i = 0; i < 500; ++i)
+  {
+    MassMatrix3d m;
+    m.SetFromBox(1.0 + 0.01 * i, Vector3d(0.2, 0.1 + 0.001 * i, 0.3));
+    links.push_back(Inertiald(m, Pose3d(0.01 * i, 0.02 * i, 0.1,
+                                        0.01 * i, 0.2, -0.003 * i)));
+  }
+  Inertiald total;
+
+  benchmark::Run("Inertiald_add_x500", 1000, [&]()
+  {
+    total = links[0];
+    for (std::size_t i = 1; i < links.size(); ++i)
+      total += links[i];
+    benchmark::DoNotOptimize(total);
+  });
+
+  benchmark::Run("Inertiald_sum_x500", 1000, [&]()
+  {
+    total = Inertiald::Sum(links.data(), links.size());
+    benchmark::DoNotOptimize(total);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, InertialToWorld)
+{
+  // Links of articulated models moved to the world frame every step
+  std::vector<Inertiald> links;
+  std::vector<Pose3d> poses;
+  for (int i = 0; i < 1000; ++i)
+  {
+    MassMatrix3d m;
+    m.SetFromBox(1.0 + 0.01 * i, Vector3d(0.2, 0.1 + 0.001 * i, 0.3));
+    links.push_back(Inertiald(m, Pose3d(0.01 * i, 0.02 * i, 0.1,
+                                        0.01 * i, 0.2, -0.003 * i)));
+    poses.push_back(Pose3d(0.1 * i, -0.2, 0.3 * i, 0.4, -0.001 * i, 0.5));
+  }
+  std::vector<Matrix3d> moi(links.size());
+  std::vector<Vector3d> com(links.size());
+
+  benchmark::Run("Inertiald_world_each_x1000", 1000, [&]()
+  {
+    for (std::size_t i = 0; i < links.size(); ++i)
+    {
+      const Matrix3d r(poses[i].Rot());
+      moi[i] = r * links[i].Moi() * r.Transposed();
+      com[i] = (poses[i] * links[i].Pose()).Pos();
+    }
+    benchmark::DoNotOptimize(moi);
+    benchmark::DoNotOptimize(com);
+  });
+
+  benchmark::Run("Inertiald_world_batch_x1000", 1000, [&]()
+  {
+    Inertiald::ToWorld(links.data(), poses.data(), moi.data(), com.data(),
+                       links.size());
+    benchmark::DoNotOptimize(moi);
+    benchmark::DoNotOptimize(com);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, Material)
+{
+  // Material names as read from scene files
+  const std::vector<std::string> names = {
+      "steel_stainless", "Tungsten", "wood", "PLASTIC", "unobtainium"};
+  double density = 0;
+
+  benchmark::Run("Material_from_name_x100000", 10, [&]()
+  {
+    for (int i = 0; i < 100000; ++i)
+      density += Material(names[i % names.size()]).Density();
+    benchmark::DoNotOptimize(density);
+  });
+
+  benchmark::Run("Material_predefined_x100000", 10, [&]()
+  {
+    for (int i = 0; i < 100000; ++i)
+    {
+      density += Material::Predefined(
+          static_cast<MaterialType>(i % 14)).Density();
+    }
+    benchmark::DoNotOptimize(density);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, Quaternion)
+{
+  Quaterniond q(0.1, 0.2, 0.3);
+  const Quaterniond r(-0.3, 0.05, 0.7);
+  const Vector3d v(1, 2, 3);
+
+  benchmark::Run("Quaterniond_multiply", 1000000, [&]()
+  {
+    q = q * r;
+    q.Normalize();
+    benchmark::DoNotOptimize(q);
+  });
+
+  benchmark::Run("Quaterniond_rotate_vector", 1000000, [&]()
+  {
+    Vector3d out = r.RotateVector(v);
+    benchmark::DoNotOptimize(out);
+  });
+
+  benchmark::Run("Quaterniond_slerp", 1000000, [&]()
+  {
+    Quaterniond s = Quaterniond::Slerp(0.3, q, r, true);
+    benchmark::DoNotOptimize(s);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, Pose3)
+{
+  Pose3d p(1, 2, 3, 0.1, 0.2, 0.3);
+  const Pose3d q(-0.5, 0.25, 4, 0.3, -0.2, 0.1);
+  const Vector3d v(1, 2, 3);
+
+  benchmark::Run("Pose3d_compose", 1000000, [&]()
+  {
+    Pose3d c = p * q;
+    benchmark::DoNotOptimize(c);
+  });
+
+  benchmark::Run("Pose3d_inverse", 1000000, [&]()
+  {
+    Pose3d inv = p.Inverse();
+    benchmark::DoNotOptimize(inv);
+  });
+
+  benchmark::Run("Pose3d_coord_position_add", 1000000, [&]()
+  {
+    Vector3d out = p.CoordPositionAdd(v);
+    benchmark::DoNotOptimize(out);
+  });
+
+  std::vector<Vector3d> points;
+  for (int i = 0; i < 10000; ++i)
+    points.emplace_back(i * 0.1, -i * 0.2, i * 0.3);
+  std::vector<Vector3d> out(points.size());
+
+  benchmark::Run("Pose3d_coord_position_add_loop_x10000", 200, [&]()
+  {
+    for (std::size_t i = 0; i < points.size(); ++i)
+      out[i] = p.CoordPositionAdd(points[i]);
+    benchmark::DoNotOptimize(out);
+  });
+
+  benchmark::Run("Pose3d_coord_position_add_batch_x10000", 200, [&]()
+  {
+    p.CoordPositionAdd(points.data(), out.data(), points.size());
+    benchmark::DoNotOptimize(out);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, Matrix4)
+{
+  Matrix4d m(Pose3d(1, 2, 3, 0.1, 0.2, 0.3));
+  const Matrix4d n(Pose3d(-0.5, 0.25, 4, 0.3, -0.2, 0.1));
+  const Vector3d v(1, 2, 3);
+
+  benchmark::Run("Matrix4d_multiply", 1000000, [&]()
+  {
+    Matrix4d c = m * n;
+    benchmark::DoNotOptimize(c);
+  });
+
+  benchmark::Run("Matrix4d_inverse", 1000000, [&]()
+  {
+    Matrix4d inv = m.Inverse();
+    benchmark::DoNotOptimize(inv);
+  });
+
+  Matrix4d projective = m;
+  projective(3, 2) = 1e-3;
+  benchmark::Run("Matrix4d_inverse_projective", 1000000, [&]()
+  {
+    Matrix4d inv = projective.Inverse();
+    benchmark::DoNotOptimize(inv);
+  });
+
+  benchmark::Run("Matrix4d_inverse_rigid", 1000000, [&]()
+  {
+    Matrix4d inv = m.InverseRigid();
+    benchmark::DoNotOptimize(inv);
+  });
+
+  benchmark::Run("Matrix4d_transform_point", 1000000, [&]()
+  {
+    Vector3d out = m * v;
+    benchmark::DoNotOptimize(out);
+  });
+
+  std::vector<Vector3d> points;
+  for (int i = 0; i < 10000; ++i)
+    points.emplace_back(i * 0.1, -i * 0.2, i * 0.3);
+  std::vector<Vector3d> out(points.size());
+
+  benchmark::Run("Matrix4d_transform_affine_batch_x10000", 200, [&]()
+  {
+    bool result = m.TransformAffine(points.data(), out.data(), points.size());
+    benchmark::DoNotOptimize(result);
+    benchmark::DoNotOptimize(out);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, FrustumContains)
+{
+  Frustum frustum(1, 100, Angle(GZ_DTOR(60)), 4.0 / 3.0,
+      Pose3d(0, 0, 0, 0, 0, 0));
+
+  Rand::Seed(42);
+  std::vector<AxisAlignedBox> boxes;
+  std::vector<Vector3d> points;
+  for (int i = 0; i < 1000; ++i)
+  {
+    Vector3d center(Rand::DblUniform(-10, 110),
+        Rand::DblUniform(-60, 60), Rand::DblUniform(-60, 60));
+    Vector3d half(Rand::DblUniform(0.1, 2), Rand::DblUniform(0.1, 2),
+        Rand::DblUniform(0.1, 2));
+    boxes.push_back(AxisAlignedBox(center - half, center + half));
+    points.push_back(center);
+  }
+
+  benchmark::Run("Frustum_contains_box_x1000", 200, [&]()
+  {
+    int count = 0;
+    for (const auto &box : boxes)
+      count += frustum.Contains(box);
+    benchmark::DoNotOptimize(count);
+  });
+
+  std::vector<std::uint8_t> results;
+  benchmark::Run("Frustum_contains_box_batch_x1000", 200, [&]()
+  {
+    frustum.Contains(boxes, results);
+    benchmark::DoNotOptimize(results.data());
+  });
+
+  benchmark::Run("Frustum_contains_point_x1000", 200, [&]()
+  {
+    int count = 0;
+    for (const auto &point : points)
+      count += frustum.Contains(point);
+    benchmark::DoNotOptimize(count);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, OrientedBoxIntersects)
+{
+  Rand::Seed(42);
+  std::vector<OrientedBoxd> boxes;
+  for (int i = 0; i < 10000; ++i)
+  {
+    boxes.push_back(OrientedBoxd(Vector3d(Rand::DblUniform(0.1, 2),
+        Rand::DblUniform(0.1, 2), Rand::DblUniform(0.1, 2)),
+        Pose3d(Rand::DblUniform(-10, 10), Rand::DblUniform(-10, 10),
+               Rand::DblUniform(-10, 10), Rand::DblUniform(-3, 3),
+               Rand::DblUniform(-3, 3), Rand::DblUniform(-3, 3))));
+  }
+  const OrientedBoxd box(Vector3d(3, 2, 1), Pose3d(1, 2, 3, 0.1, 0.2, 0.3));
+  std::vector<std::size_t> indices;
+
+  benchmark::Run("OrientedBoxd_intersects_loop_x10000", 100, [&]()
+  {
+    std::size_t count = 0;
+    for (const auto &other : boxes)
+      count += box.Intersects(other);
+    benchmark::DoNotOptimize(count);
+  });
+
+  benchmark::Run("OrientedBoxd_intersects_batch_x10000", 100, [&]()
+  {
+    box.Intersects(boxes.data(), boxes.size(), indices);
+    benchmark::DoNotOptimize(indices);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, AxisAlignedBoxTree)
+{
+  Rand::Seed(42);
+  std::vector<AxisAlignedBox> boxes;
+  for (int i = 0; i < 10000; ++i)
+  {
+    Vector3d center(Rand::DblUniform(-50, 50),
+        Rand::DblUniform(-50, 50), Rand::DblUniform(-50, 50));
+    Vector3d half(Rand::DblUniform(0.1, 1), Rand::DblUniform(0.1, 1),
+        Rand::DblUniform(0.1, 1));
+    boxes.push_back(AxisAlignedBox(center - half, center + half));
+  }
+
+  std::vector<Vector3d> dirs;
+  for (int i = 0; i < 100; ++i)
+  {
+    dirs.emplace_back(Rand::DblUniform(-1, 1), Rand::DblUniform(-1, 1),
+        Rand::DblUniform(-1, 1));
+  }
+
+  benchmark::Run("AxisAlignedBoxTree_build_x10000", 20, [&]()
+  {
+    AxisAlignedBoxTree tree(boxes);
+    benchmark::DoNotOptimize(tree);
+  });
+
+  AxisAlignedBoxTree tree(boxes);
+
+  benchmark::Run("AxisAlignedBox_ray_closest_brute_x100", 5, [&]()
+  {
+    double sum = 0;
+    for (const auto &dir : dirs)
+    {
+      double best = 1e9;
+      for (const auto &box : boxes)
+      {
+        bool hit;
+        double dist;
+        std::tie(hit, dist, std::ignore) =
+          box.Intersect(Vector3d::Zero, dir, 0, 100);
+        if (hit && dist < best)
+          best = dist;
+      }
+      sum += best;
+    }
+    benchmark::DoNotOptimize(sum);
+  });
+
+  benchmark::Run("AxisAlignedBoxTree_ray_closest_x100", 200, [&]()
+  {
+    double sum = 0;
+    for (const auto &dir : dirs)
+    {
+      std::size_t index;
+      double dist;
+      if (tree.RayClosestHit(Vector3d::Zero, dir, 0, 100, index, dist))
+        sum += dist;
+    }
+    benchmark::DoNotOptimize(sum);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, AxisAlignedBoxTreeFrustum)
+{
+  // 10^5 boxes seen by a camera turning a little every frame
+  Rand::Seed(42);
+  std::vector<AxisAlignedBox> boxes;
+  for (int i = 0; i < 100000; ++i)
+  {
+    Vector3d center(Rand::DblUniform(-100, 100),
+        Rand::DblUniform(-100, 100), Rand::DblUniform(-10, 10));
+    Vector3d half(Rand::DblUniform(0.1, 1), Rand::DblUniform(0.1, 1),
+        Rand::DblUniform(0.1, 1));
+    boxes.push_back(AxisAlignedBox(center - half, center + half));
+  }
+  const AxisAlignedBoxTree tree(boxes);
+
+  int frame = 0;
+  auto nextFrustum = [&]()
+  {
+    ++frame;
+    return Frustum(0.1, 60, Angle(GZ_DTOR(60)), 16.0 / 9,
+        Pose3d(0, 0, 2, 0, 0.05, 0.01 * frame));
+  };
+
+  std::vector<std::uint8_t> inside(boxes.size());
+  benchmark::Run("Frustum_contains_batch_x100000", 20, [&]()
+  {
+    nextFrustum().Contains(boxes.data(), inside.data(), boxes.size());
+    benchmark::DoNotOptimize(inside);
+  });
+
+  std::vector<std::size_t> indices;
+  benchmark::Run("AxisAlignedBoxTree_frustum_x100000", 100, [&]()
+  {
+    tree.Intersects(nextFrustum(), indices);
+    benchmark::DoNotOptimize(indices);
+  });
+
+  AxisAlignedBoxTreeCullState state;
+  benchmark::Run("AxisAlignedBoxTree_frustum_state_x100000", 100, [&]()
+  {
+    tree.Intersects(nextFrustum(), state, indices);
+    benchmark::DoNotOptimize(indices);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, FrustumVisibility)
+{
+  // 10^5 boxes around a vehicle with a ring of 12 cameras
+  Rand::Seed(42);
+  std::vector<AxisAlignedBox> boxes;
+  for (int i = 0; i < 100000; ++i)
+  {
+    Vector3d center(Rand::DblUniform(-100, 100),
+        Rand::DblUniform(-100, 100), Rand::DblUniform(-10, 10));
+    Vector3d half(Rand::DblUniform(0.1, 1), Rand::DblUniform(0.1, 1),
+        Rand::DblUniform(0.1, 1));
+    boxes.push_back(AxisAlignedBox(center - half, center + half));
+  }
+  const AxisAlignedBoxTree tree(boxes);
+  std::vector<Frustum> cameras;
+  for (int i = 0; i < 12; ++i)
+  {
+    cameras.push_back(Frustum(0.1, 60, Angle(GZ_DTOR(60)), 16.0 / 9,
+        Pose3d(0, 0, 2, 0, 0.05, GZ_DTOR(30 * i))));
+  }
+
+  std::vector<std::size_t> indices;
+  benchmark::Run("Frustum_visibility_tree_per_camera_x100000", 20, [&]()
+  {
+    for (const auto &camera : cameras)
+      tree.Intersects(camera, indices);
+    benchmark::DoNotOptimize(indices);
+  });
+
+  std::vector<std::uint64_t> masks(boxes.size());
+  for (unsigned int threads : {1u, 4u})
+  {
+    const std::string suffix = std::to_string(threads) + "_threads";
+    benchmark::Run("Frustum_visibility_batch_x100000_" + suffix, 20, [&]()
+    {
+      Frustum::Visibility(cameras.data(), cameras.size(), boxes.data(),
+          masks.data(), boxes.size(), threads);
+      benchmark::DoNotOptimize(masks);
+    });
+
+    benchmark::Run("Frustum_visibility_tree_x100000_" + suffix, 20, [&]()
+    {
+      tree.Visibility(cameras.data(), cameras.size(), masks.data(),
+          threads);
+      benchmark::DoNotOptimize(masks);
+    });
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, Line3Array)
+{
+  // A cable of 1000 links coiled on itself
+  std::vector<Line3d> links;
+  Vector3d previous(1, 0, 0);
+  for (int i = 1; i <= 1000; ++i)
+  {
+    const double angle = 0.05 * i;
+    const Vector3d next(std::cos(angle), std::sin(angle), 0.002 * i);
+    links.push_back(Line3d(previous, next));
+    previous = next;
+  }
+  const Line3Arrayd array(links);
+
+  benchmark::Run("Line3d_distance_pairs_x500k", 3, [&]()
+  {
+    double best = MAX_D;
+    Line3d result;
+    for (std::size_t j = 2; j < links.size(); ++j)
+    {
+      for (std::size_t i = 0; i + 2 <= j; ++i)
+      {
+        if (links[i].Distance(links[j], result))
+          best = std::min(best, result.Length());
+      }
+    }
+    benchmark::DoNotOptimize(best);
+  });
+
+  std::vector<Line3Arrayd::Pair> pairs;
+  benchmark::Run("Line3Arrayd_closest_pairs_x500k", 3, [&]()
+  {
+    array.ClosestPairs(16, 2, pairs);
+    benchmark::DoNotOptimize(pairs);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, Triangle3Array)
+{
+  // Height field of 2 * 300 * 300 triangles
+  const unsigned int n = 300;
+  std::vector<Vector3d> vertices;
+  for (unsigned int i = 0; i <= n; ++i)
+  {
+    for (unsigned int j = 0; j <= n; ++j)
+    {
+      vertices.emplace_back(0.1 * i - 15, 0.1 * j - 15,
+          std::sin(0.05 * i) * std::cos(0.07 * j));
+    }
+  }
+  std::vector<unsigned int> indices;
+  std::vector<Triangle3d> triangles;
+  for (unsigned int i = 0; i < n; ++i)
+  {
+    for (unsigned int j = 0; j < n; ++j)
+    {
+      const unsigned int a = i * (n + 1) + j;
+      indices.insert(indices.end(), {a, a + n + 1, a + n + 2,
+                                     a, a + n + 2, a + 1});
+    }
+  }
+  for (std::size_t i = 0; i < indices.size(); i += 3)
+  {
+    triangles.emplace_back(vertices[indices[i]], vertices[indices[i + 1]],
+                           vertices[indices[i + 2]]);
+  }
+  const Triangle3Arrayd array(vertices.data(), vertices.size(),
+                              indices.data(), indices.size() / 3);
+  std::vector<AxisAlignedBox> bounds;
+  array.BlockBounds(bounds);
+  const AxisAlignedBoxTree tree(bounds);
+
+  // Rays of a lidar above the height field
+  Rand::Seed(42);
+  const Vector3d origin(0, 0, 5);
+  std::vector<Vector3d> dirs;
+  for (int i = 0; i < 100; ++i)
+  {
+    dirs.emplace_back(Rand::DblUniform(-1, 1), Rand::DblUniform(-1, 1),
+        Rand::DblUniform(-1, -0.2));
+  }
+
+  benchmark::Run("Triangle3d_intersects_loop_x100", 2, [&]()
+  {
+    double sum = 0;
+    for (const auto &dir : dirs)
+    {
+      double best = 1e9;
+      const Line3d line(origin, origin + dir.Normalized() * 100);
+      for (const auto &tri : triangles)
+      {
+        Vector3d pt;
+        if (tri.Intersects(line, pt))
+          best = std::min(best, pt.Distance(origin));
+      }
+      sum += best;
+    }
+    benchmark::DoNotOptimize(sum);
+  });
+
+  benchmark::Run("Triangle3Arrayd_ray_closest_x100", 10, [&]()
+  {
+    double sum = 0;
+    for (const auto &dir : dirs)
+    {
+      std::size_t index;
+      double dist;
+      if (array.RayClosestHit(origin, dir, 0, 100, index, dist))
+        sum += dist;
+    }
+    benchmark::DoNotOptimize(sum);
+  });
+
+  benchmark::Run("Triangle3Arrayd_tree_ray_closest_x100", 1000, [&]()
+  {
+    double sum = 0;
+    for (const auto &dir : dirs)
+    {
+      std::size_t block, index;
+      double dist;
+      if (tree.RayClosestHit(origin, dir, 0, 100,
+          [&](const std::size_t _block, const double _max, double &_dist)
+          {
+            return array.RayClosestHit(origin, dir, 0, _max,
+                _block * array.kBlockSize, (_block + 1) * array.kBlockSize,
+                index, _dist);
+          }, block, dist))
+      {
+        sum += dist;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, VolumetricGridLookupField)
+{
+  std::vector<Vector3d> cloud;
+  for (double x = 0; x < 60; x += 1)
+    for (double y = 0; y < 60; y += 1)
+      for (double z = 0; z < 20; z += 1)
+        cloud.emplace_back(x, y, z);
+
+  std::vector<double> values(cloud.size());
+  for (std::size_t i = 0; i < values.size(); ++i)
+    values[i] = static_cast<double>(i);
+
+  VolumetricGridLookupField<double> field(cloud);
+
+  Rand::Seed(42);
+  std::vector<Vector3d> queries;
+  for (int i = 0; i < 1000; ++i)
+  {
+    queries.emplace_back(Rand::DblUniform(0, 59), Rand::DblUniform(0, 59),
+        Rand::DblUniform(0, 19));
+  }
+
+  benchmark::Run("VolumetricGrid_get_interpolators_x1000", 50, [&]()
+  {
+    std::size_t count = 0;
+    for (const auto &q : queries)
+      count += field.GetInterpolators(q).size();
+    benchmark::DoNotOptimize(count);
+  });
+
+  benchmark::Run("VolumetricGrid_estimate_trilinear_x1000", 50, [&]()
+  {
+    double sum = 0;
+    for (const auto &q : queries)
+      sum += field.EstimateValueUsingTrilinear(q, values).value_or(0.0);
+    benchmark::DoNotOptimize(sum);
+  });
+
+  std::vector<std::optional<double>> estimates;
+  benchmark::Run("VolumetricGrid_estimate_trilinear_batch_x1000", 50, [&]()
+  {
+    field.EstimateValuesUsingTrilinear(queries, estimates, values);
+    benchmark::DoNotOptimize(estimates.data());
+  });
+
+  // Three components of a vector field, separately and interleaved
+  std::vector<double> interleaved(3 * values.size());
+  for (std::size_t i = 0; i < interleaved.size(); ++i)
+    interleaved[i] = static_cast<double>(i);
+
+  benchmark::Run("VolumetricGrid_estimate_trilinear_3ch_separate_x1000", 50,
+    [&]()
+  {
+    double sum = 0;
+    for (const auto &q : queries)
+    {
+      for (int c = 0; c < 3; ++c)
+        sum += field.EstimateValueUsingTrilinear(q, values).value_or(0.0);
+    }
+    benchmark::DoNotOptimize(sum);
+  });
+
+  benchmark::Run("VolumetricGrid_estimate_trilinear_3ch_x1000", 50, [&]()
+  {
+    double sum = 0;
+    for (const auto &q : queries)
+    {
+      sum += field.EstimateVector3UsingTrilinear(q, interleaved).value_or(
+        Vector3d::Zero).Sum();
+    }
+    benchmark::DoNotOptimize(sum);
+  });
+
+  // A grid whose index table does not fit in cache
+  std::vector<Vector3d> bigCloud;
+  for (double x = 0; x < 200; x += 1)
+    for (double y = 0; y < 200; y += 1)
+      for (double z = 0; z < 50; z += 1)
+        bigCloud.emplace_back(x, y, z);
+  std::vector<double> bigValues(bigCloud.size(), 1.0);
+  VolumetricGridLookupField<double> bigField(bigCloud);
+
+  std::vector<std::size_t> bigIndices(bigCloud.size());
+  for (std::size_t i = 0; i < bigIndices.size(); ++i)
+    bigIndices[i] = i;
+  benchmark::Run("VolumetricGrid_big_build_x2000000", 3, [&]()
+  {
+    VolumetricGridLookupField<double> built(bigCloud, bigIndices);
+    benchmark::DoNotOptimize(&built);
+  });
+
+  benchmark::Run("VolumetricGrid_big_build_mt_x2000000", 3, [&]()
+  {
+    VolumetricGridLookupField<double> built(bigCloud, bigIndices, 0);
+    benchmark::DoNotOptimize(&built);
+  });
+
+  std::vector<Vector3d> manyQueries;
+  for (int i = 0; i < 100000; ++i)
+  {
+    manyQueries.emplace_back(Rand::DblUniform(0, 199),
+        Rand::DblUniform(0, 199), Rand::DblUniform(0, 49));
+  }
+
+  benchmark::Run("VolumetricGrid_big_estimate_trilinear_x100000", 5, [&]()
+  {
+    double sum = 0;
+    for (const auto &q : manyQueries)
+      sum += bigField.EstimateValueUsingTrilinear(q, bigValues).value_or(0.0);
+    benchmark::DoNotOptimize(sum);
+  });
+
+  benchmark::Run("VolumetricGrid_big_estimate_trilinear_batch_x100000", 5,
+      [&]()
+  {
+    bigField.EstimateValuesUsingTrilinear(manyQueries, estimates, bigValues);
+    benchmark::DoNotOptimize(estimates.data());
+  });
+
+  benchmark::Run("VolumetricGrid_big_estimate_trilinear_batch_mt_x100000", 5,
+      [&]()
+  {
+    bigField.EstimateValuesUsingTrilinear(
+        manyQueries, estimates, bigValues, 0.0, 0);
+    benchmark::DoNotOptimize(estimates.data());
+  });
+
+  InterpolationPoints3D<double> interpolators;
+  benchmark::Run("VolumetricGrid_get_interpolators_fixed_x1000", 50, [&]()
+  {
+    std::size_t count = 0;
+    for (const auto &q : queries)
+    {
+      field.GetInterpolators(q, interpolators);
+      count += interpolators.count;
+    }
+    benchmark::DoNotOptimize(count);
+  });
+
+  // A trajectory through a non uniform grid, where axis searches are
+  // binary searches unless a cursor is used
+  std::vector<Vector3d> stretchedCloud;
+  for (double x = 0; x < 100; x += 1)
+    for (double y = 0; y < 100; y += 1)
+      for (double z = 0; z < 20; z += 1)
+        stretchedCloud.emplace_back(x * x, y * y, z * z);
+  VolumetricGridLookupField<double> stretchedField(stretchedCloud);
+
+  std::vector<Vector3d> trajectory;
+  for (int i = 0; i < 1000; ++i)
+  {
+    const double s = i * 0.0099;
+    trajectory.emplace_back(s * s * 100, s * s * 90, s * s * 3.5);
+  }
+
+  benchmark::Run("VolumetricGrid_trajectory_x1000", 50, [&]()
+  {
+    std::size_t count = 0;
+    for (const auto &q : trajectory)
+    {
+      stretchedField.GetInterpolators(q, interpolators);
+      count += interpolators.count;
+    }
+    benchmark::DoNotOptimize(count);
+  });
+
+  benchmark::Run("VolumetricGrid_trajectory_cursor_x1000", 50, [&]()
+  {
+    std::size_t count = 0;
+    VolumetricGridCursor cursor;
+    for (const auto &q : trajectory)
+    {
+      stretchedField.GetInterpolators(q, interpolators, cursor);
+      count += interpolators.count;
+    }
+    benchmark::DoNotOptimize(count);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, KmeansCluster)
+{
+  Rand::Seed(42);
+  std::vector<Vector3d> obs;
+  for (int i = 0; i < 2000; ++i)
+  {
+    obs.emplace_back(Rand::DblUniform(-100, 100), Rand::DblUniform(-100, 100),
+        Rand::DblUniform(-100, 100));
+  }
+
+  Kmeans kmeans(obs);
+  std::vector<Vector3d> centroids;
+  std::vector<unsigned int> labels;
+
+  benchmark::Run("Kmeans_cluster_2000_obs_k8", 5, [&]()
+  {
+    Rand::Seed(42);
+    bool result = kmeans.Cluster(8, centroids, labels);
+    benchmark::DoNotOptimize(result);
+  });
+  EXPECT_EQ(8u, centroids.size());
+  EXPECT_EQ(obs.size(), labels.size());
+
+  // Inertia for k = 2..64, as when choosing k with the elbow method
+  std::vector<Vector3d> sweepObs;
+  for (int i = 0; i < 5000; ++i)
+  {
+    sweepObs.emplace_back(Rand::DblUniform(-100, 100),
+        Rand::DblUniform(-100, 100), Rand::DblUniform(-100, 100));
+  }
+  Kmeans sweep(sweepObs);
+  std::vector<double> inertias(63);
+
+  benchmark::Run("Kmeans_cluster_loop_5000_obs_k2_64", 1, [&]()
+  {
+    Rand::Seed(42);
+    for (int k = 2; k <= 64; ++k)
+    {
+      sweep.Cluster(k, centroids, labels);
+      inertias[k - 2] = 0;
+      for (std::size_t i = 0; i < sweepObs.size(); ++i)
+      {
+        inertias[k - 2] +=
+          (sweepObs[i] - centroids[labels[i]]).SquaredLength();
+      }
+    }
+    benchmark::DoNotOptimize(inertias);
+  });
+
+  benchmark::Run("Kmeans_sweep_5000_obs_k2_64", 1, [&]()
+  {
+    Rand::Seed(42);
+    bool result = sweep.Sweep(2, 64, inertias);
+    benchmark::DoNotOptimize(result);
+  });
+  EXPECT_EQ(63u, inertias.size());
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, SignalStats)
+{
+  Rand::Seed(42);
+  std::vector<double> data;
+  for (int i = 0; i < 10000; ++i)
+    data.push_back(Rand::DblNormal(0, 1));
+
+  SignalStats runtime;
+  EXPECT_TRUE(runtime.InsertStatistics("mean,rms,maxAbs,var"));
+  benchmark::Run("SignalStats_insert_x10000", 200, [&]()
+  {
+    for (const double value : data)
+      runtime.InsertData(value);
+    benchmark::DoNotOptimize(runtime);
+  });
+
+  benchmark::Run("SignalStats_insert_batch_x10000", 200, [&]()
+  {
+    runtime.InsertData(data.data(), data.size());
+    benchmark::DoNotOptimize(runtime);
+  });
+
+  SignalStatsT<stats::Mean, stats::Rms, stats::MaxAbs, stats::Var> fused;
+  benchmark::Run("SignalStatsT_insert_loop_x10000", 200, [&]()
+  {
+    for (const double value : data)
+      fused.InsertData(value);
+    benchmark::DoNotOptimize(fused);
+  });
+
+  benchmark::Run("SignalStatsT_insert_batch_x10000", 200, [&]()
+  {
+    fused.InsertData(data.data(), data.size());
+    benchmark::DoNotOptimize(fused);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, SignalPyramid)
+{
+  Rand::Seed(42);
+  std::vector<double> data;
+  for (int i = 0; i < 10000; ++i)
+    data.push_back(Rand::DblNormal(0, 1));
+
+  // Buckets of 10, 1000 and 100000 samples
+  SignalPyramid pyramid(10, 100, 3, 1000);
+  benchmark::Run("SignalPyramid_insert_x10000", 200, [&]()
+  {
+    for (const double value : data)
+      pyramid.InsertData(value);
+    benchmark::DoNotOptimize(pyramid);
+  });
+
+  benchmark::Run("SignalPyramid_insert_batch_x10000", 200, [&]()
+  {
+    pyramid.InsertData(data.data(), data.size());
+    benchmark::DoNotOptimize(pyramid);
+  });
+
+  std::vector<SignalBucket> buckets(pyramid.Capacity());
+  benchmark::Run("SignalPyramid_export_x1000", 200, [&]()
+  {
+    benchmark::DoNotOptimize(pyramid.Export(0, buckets.data()));
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, Vector3Stats)
+{
+  // One second of a 3-axis accelerometer at 4 kHz.
+  Rand::Seed(42);
+  std::vector<Vector3d> data;
+  for (int i = 0; i < 4000; ++i)
+  {
+    data.emplace_back(Rand::DblNormal(0, 1), Rand::DblNormal(0, 1),
+        Rand::DblNormal(9.8, 1));
+  }
+
+  Vector3Stats single;
+  EXPECT_TRUE(single.InsertStatistics("mean,rms,maxAbs"));
+  benchmark::Run("Vector3Stats_insert_loop_x4000", 200, [&]()
+  {
+    for (const auto &value : data)
+      single.InsertData(value);
+    benchmark::DoNotOptimize(single);
+  });
+
+  Vector3Stats block;
+  EXPECT_TRUE(block.InsertStatistics("mean,rms,maxAbs"));
+  benchmark::Run("Vector3Stats_insert_batch_x4000", 200, [&]()
+  {
+    block.InsertData(data.data(), data.size());
+    benchmark::DoNotOptimize(block);
+  });
+  EXPECT_EQ(single.Mag().Count(), block.Mag().Count());
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, Rand)
+{
+  std::vector<double> values(10000);
+  benchmark::Run("Philox_uniform_batch_x10000", 200, [&]()
+  {
+    Philox4x32::Uniform(42, 0, 7, values.data(), values.size());
+    benchmark::DoNotOptimize(values);
+  });
+
+  benchmark::Run("Philox_normal_batch_x10000", 200, [&]()
+  {
+    Philox4x32::Normal(42, 0, 7, values.data(), values.size());
+    benchmark::DoNotOptimize(values);
+  });
+
+  benchmark::Run("Rand_DblUniform_x10000", 200, [&]()
+  {
+    for (double &value : values)
+      value = Rand::DblUniform();
+    benchmark::DoNotOptimize(values);
+  });
+
+  benchmark::Run("Rand_FillUniform_x10000", 200, [&]()
+  {
+    Rand::FillUniform(values.data(), values.size());
+    benchmark::DoNotOptimize(values);
+  });
+
+  benchmark::Run("Rand_DblNormal_x10000", 200, [&]()
+  {
+    for (double &value : values)
+      value = Rand::DblNormal();
+    benchmark::DoNotOptimize(values);
+  });
+
+  benchmark::Run("Rand_FillNormal_x10000", 200, [&]()
+  {
+    Rand::FillNormal(values.data(), values.size());
+    benchmark::DoNotOptimize(values);
+  });
+
+  std::vector<int32_t> ints(10000);
+  benchmark::Run("Rand_IntUniform_x10000", 200, [&]()
+  {
+    for (int32_t &value : ints)
+      value = Rand::IntUniform(0, 999);
+    benchmark::DoNotOptimize(ints);
+  });
+
+  benchmark::Run("Rand_Bounded_x10000", 200, [&]()
+  {
+    for (int32_t &value : ints)
+      value = static_cast<int32_t>(Rand::Bounded(1000));
+    benchmark::DoNotOptimize(ints);
+  });
+
+  benchmark::Run("Rand_FillIntUniform_x10000", 200, [&]()
+  {
+    Rand::FillIntUniform(ints.data(), ints.size(), 0, 999);
+    benchmark::DoNotOptimize(ints);
+  });
+
+  std::vector<uint32_t> indices(10000);
+  std::iota(indices.begin(), indices.end(), 0u);
+  benchmark::Run("Rand_std_shuffle_x10000", 200, [&]()
+  {
+    std::mt19937 generator(42);
+    std::shuffle(indices.begin(), indices.end(), generator);
+    benchmark::DoNotOptimize(indices);
+  });
+
+  benchmark::Run("Rand_Shuffle_x10000", 200, [&]()
+  {
+    Rand::Shuffle(indices.data(), indices.size());
+    benchmark::DoNotOptimize(indices);
+  });
+
+  benchmark::Run("Rand_Sample_100_of_1000000", 200, [&]()
+  {
+    Rand::Sample(1000000, indices.data(), 100);
+    benchmark::DoNotOptimize(indices);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, GaussMarkovProcessBank)
+{
+  const size_t channels = 4096;
+  std::vector<GaussMarkovProcess> processes;
+  GaussMarkovProcessBank bank;
+  for (size_t i = 0; i < channels; ++i)
+  {
+    processes.emplace_back(0.0, 0.5, 0.0, 0.1);
+    bank.Add(0.0, 0.5, 0.0, 0.1);
+  }
+
+  benchmark::Run("GaussMarkovProcess_update_x4096", 200, [&]()
+  {
+    for (auto &process : processes)
+      benchmark::DoNotOptimize(process.Update(0.01));
+  });
+
+  benchmark::Run("GaussMarkovProcessBank_update_x4096", 200, [&]()
+  {
+    benchmark::DoNotOptimize(bank.Update(0.01));
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, Dijkstra)
+{
+  // Build a 30x30 grid graph.
+  const int side = 30;
+  graph::UndirectedGraph<int, double> g;
+  for (int i = 0; i < side * side; ++i)
+    g.AddVertex(std::to_string(i), i, i);
+  for (int row = 0; row < side; ++row)
+  {
+    for (int col = 0; col < side; ++col)
+    {
+      const graph::VertexId id = row * side + col;
+      if (col + 1 < side)
+        g.AddEdge({id, id + 1}, 0.0, 1.0 + (id % 3));
+      if (row + 1 < side)
+        g.AddEdge({id, id + side}, 0.0, 1.0 + (id % 5));
+    }
+  }
+
+  benchmark::Run("Dijkstra_grid_30x30", 20, [&]()
+  {
+    auto result = graph::Dijkstra(g, 0);
+    benchmark::DoNotOptimize(result);
+  });
+
+  const graph::CsrGraph frozen = graph::Freeze(g);
+  benchmark::Run("Dijkstra_csr_grid_30x30", 20, [&]()
+  {
+    auto result = graph::Dijkstra(frozen, 0);
+    benchmark::DoNotOptimize(result);
+  });
+
+  // Point to point queries from a corner to the middle of the grid
+  const int toRow = side / 2;
+  const int toCol = side / 2;
+  const graph::VertexId to = toRow * side + toCol;
+  benchmark::Run("Dijkstra_csr_to_grid_30x30", 20, [&]()
+  {
+    auto result = graph::Dijkstra(frozen, 0, to);
+    benchmark::DoNotOptimize(result);
+  });
+
+  benchmark::Run("AStar_csr_grid_30x30", 20, [&]()
+  {
+    auto result = graph::AStar(frozen, 0, to, [&](graph::VertexId _v)
+    {
+      const int row = static_cast<int>(_v) / side;
+      const int col = static_cast<int>(_v) % side;
+      return static_cast<double>(
+        std::abs(toRow - row) + std::abs(toCol - col));
+    });
+    benchmark::DoNotOptimize(result);
+  });
+
+  benchmark::Run("BidirectionalDijkstra_csr_grid_30x30", 20, [&]()
+  {
+    auto result = graph::BidirectionalDijkstra(frozen, 0, to);
+    benchmark::DoNotOptimize(result);
+  });
+
+  benchmark::Run("BreadthFirstSort_grid_30x30", 20, [&]()
+  {
+    auto result = graph::BreadthFirstSort(g, 0);
+    benchmark::DoNotOptimize(result);
+  });
+
+  benchmark::Run("BreadthFirstSort_csr_grid_30x30", 20, [&]()
+  {
+    auto result = graph::BreadthFirstSort(frozen, 0);
+    benchmark::DoNotOptimize(result);
+  });
+
+  // Distance fields from the four corners of the grid
+  const std::vector<graph::VertexId> corners = {
+    0, side - 1, side * (side - 1), side * side - 1};
+  benchmark::Run("Dijkstra_csr_4_sources_grid_30x30", 20, [&]()
+  {
+    for (const graph::VertexId &corner : corners)
+    {
+      auto result = graph::Dijkstra(frozen, corner);
+      benchmark::DoNotOptimize(result);
+    }
+  });
+
+  benchmark::Run("MultiSourceDijkstra_csr_4_sources_grid_30x30", 20, [&]()
+  {
+    auto result = graph::MultiSourceDijkstra(frozen, corners);
+    benchmark::DoNotOptimize(result);
+  });
+
+  benchmark::Run("BreadthFirstLevels_csr_4_sources_grid_30x30", 20, [&]()
+  {
+    auto result = graph::BreadthFirstLevels(frozen, corners);
+    benchmark::DoNotOptimize(result);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, SphericalCoordinates)
+{
+  SphericalCoordinates sc(SphericalCoordinates::EARTH_WGS84,
+      GZ_DTOR(47.3667), GZ_DTOR(8.5500), 500.0, GZ_DTOR(0.0));
+  const Vector3d local(120.0, -45.0, 10.0);
+  const Vector3d spherical(GZ_DTOR(47.37), GZ_DTOR(8.56), 510.0);
+
+  benchmark::Run("SphericalCoordinates_local_to_spherical", 200000, [&]()
+  {
+    Vector3d out = sc.PositionTransform(local,
+        SphericalCoordinates::LOCAL2, SphericalCoordinates::SPHERICAL);
+    benchmark::DoNotOptimize(out);
+  });
+
+  benchmark::Run("SphericalCoordinates_spherical_to_local", 200000, [&]()
+  {
+    Vector3d out = sc.PositionTransform(spherical,
+        SphericalCoordinates::SPHERICAL, SphericalCoordinates::LOCAL2);
+    benchmark::DoNotOptimize(out);
+  });
+
+  benchmark::Run("SphericalCoordinates_local_to_global_velocity", 200000,
+      [&]()
+  {
+    Vector3d out = sc.VelocityTransform(local,
+        SphericalCoordinates::LOCAL2, SphericalCoordinates::GLOBAL);
+    benchmark::DoNotOptimize(out);
+  });
+
+  // Moving the reference, then converting one position. Updating after
+  // each setter is what the setters did before.
+  benchmark::Run("SphericalCoordinates_set_reference_eager", 100000, [&]()
+  {
+    sc.SetLatitudeReference(GZ_DTOR(47.3667));
+    sc.UpdateTransformationMatrix();
+    sc.SetLongitudeReference(GZ_DTOR(8.5500));
+    sc.UpdateTransformationMatrix();
+    sc.SetElevationReference(500.0);
+    sc.UpdateTransformationMatrix();
+    sc.SetHeadingOffset(GZ_DTOR(0.0));
+    sc.UpdateTransformationMatrix();
+    Vector3d out = sc.PositionTransform(local,
+        SphericalCoordinates::LOCAL2, SphericalCoordinates::SPHERICAL);
+    benchmark::DoNotOptimize(out);
+  });
+
+  benchmark::Run("SphericalCoordinates_set_reference_lazy", 100000, [&]()
+  {
+    sc.SetLatitudeReference(GZ_DTOR(47.3667));
+    sc.SetLongitudeReference(GZ_DTOR(8.5500));
+    sc.SetElevationReference(500.0);
+    sc.SetHeadingOffset(GZ_DTOR(0.0));
+    Vector3d out = sc.PositionTransform(local,
+        SphericalCoordinates::LOCAL2, SphericalCoordinates::SPHERICAL);
+    benchmark::DoNotOptimize(out);
+  });
+
+  // A track of 10000 points around the reference.
+  std::vector<Vector3d> track;
+  for (int i = 0; i < 10000; ++i)
+    track.emplace_back(0.1 * i, 200.0 * std::sin(0.001 * i), 0.01 * i);
+  std::vector<Vector3d> result(track.size());
+
+  benchmark::Run("SphericalCoordinates_local_to_spherical_loop_x10000", 50,
+      [&]()
+  {
+    for (size_t i = 0; i < track.size(); ++i)
+    {
+      result[i] = sc.PositionTransform(track[i],
+          SphericalCoordinates::LOCAL2, SphericalCoordinates::SPHERICAL);
+    }
+    benchmark::DoNotOptimize(result);
+  });
+
+  benchmark::Run("SphericalCoordinates_local_to_spherical_batch_x10000", 50,
+      [&]()
+  {
+    sc.PositionTransform(track.data(), result.data(), track.size(),
+        SphericalCoordinates::LOCAL2, SphericalCoordinates::SPHERICAL);
+    benchmark::DoNotOptimize(result);
+  });
+
+  benchmark::Run("SphericalCoordinates_local_to_global_velocity_x10000", 50,
+      [&]()
+  {
+    sc.VelocityTransform(track.data(), result.data(), track.size(),
+        SphericalCoordinates::LOCAL2, SphericalCoordinates::GLOBAL);
+    benchmark::DoNotOptimize(result);
+  });
+
+  const Vector3d sphericalDeg(47.37, 8.56, 510.0);
+  benchmark::Run("SphericalCoordinates_local_from_spherical_exact", 200000,
+      [&]()
+  {
+    Vector3d out = sc.LocalFromSphericalPosition(sphericalDeg);
+    benchmark::DoNotOptimize(out);
+  });
+
+  benchmark::Run("SphericalCoordinates_spherical_from_local_exact", 200000,
+      [&]()
+  {
+    Vector3d out = sc.SphericalFromLocalPosition(local);
+    benchmark::DoNotOptimize(out);
+  });
+
+  // Distances between 10000 pairs of points, and from one point to them.
+  std::vector<double> latA, lonA, latB, lonB;
+  for (int i = 0; i < 10000; ++i)
+  {
+    latA.push_back(GZ_DTOR(47.0 + 0.001 * (i % 97)));
+    lonA.push_back(GZ_DTOR(8.0 + 0.002 * (i % 89)));
+    latB.push_back(GZ_DTOR(46.5 + 0.003 * (i % 83)));
+    lonB.push_back(GZ_DTOR(8.5 - 0.001 * (i % 79)));
+  }
+  std::vector<double> distance(latA.size());
+
+  benchmark::Run("SphericalCoordinates_distance_loop_x10000", 50, [&]()
+  {
+    for (size_t i = 0; i < distance.size(); ++i)
+    {
+      distance[i] = SphericalCoordinates::DistanceWGS84(
+          latA[i], lonA[i], latB[i], lonB[i]);
+    }
+    benchmark::DoNotOptimize(distance);
+  });
+
+  benchmark::Run("SphericalCoordinates_distance_batch_x10000", 50, [&]()
+  {
+    SphericalCoordinates::DistanceWGS84(latA.data(), lonA.data(),
+        latB.data(), lonB.data(), distance.data(), distance.size());
+    benchmark::DoNotOptimize(distance);
+  });
+
+  benchmark::Run("SphericalCoordinates_distance_one_to_many_x10000", 50,
+      [&]()
+  {
+    SphericalCoordinates::DistanceWGS84(latA[0], lonA[0],
+        latB.data(), lonB.data(), distance.data(), distance.size());
+    benchmark::DoNotOptimize(distance);
+  });
+
+  benchmark::Run("SphericalCoordinates_geodesic_distance_batch_x10000", 20,
+      [&]()
+  {
+    sc.GeodesicDistance(latA.data(), lonA.data(),
+        latB.data(), lonB.data(), distance.data(), distance.size());
+    benchmark::DoNotOptimize(distance);
+  });
+
+  sc.SetTangentPlaneRadius(2000.0);
+  benchmark::Run("SphericalCoordinates_local_from_spherical_tangent", 200000,
+      [&]()
+  {
+    Vector3d out = sc.LocalFromSphericalPosition(sphericalDeg);
+    benchmark::DoNotOptimize(out);
+  });
+
+  benchmark::Run("SphericalCoordinates_spherical_from_local_tangent", 200000,
+      [&]()
+  {
+    Vector3d out = sc.SphericalFromLocalPosition(local);
+    benchmark::DoNotOptimize(out);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, SphericalPointIndex)
+{
+  // 100000 points over the whole surface, and as many around a city.
+  Rand::Seed(7);
+  std::vector<double> lat, lon;
+  for (int i = 0; i < 100000; ++i)
+  {
+    lat.push_back(std::asin(Rand::DblUniform(-1, 1)));
+    lon.push_back(Rand::DblUniform(-GZ_PI, GZ_PI));
+    lat.push_back(GZ_DTOR(47.4) + Rand::DblNormal(0, 0.002));
+    lon.push_back(GZ_DTOR(8.5) + Rand::DblNormal(0, 0.003));
+  }
+  const Angle queryLat(GZ_DTOR(47.41));
+  const Angle queryLon(GZ_DTOR(8.52));
+
+  SphericalPointIndex index;
+  benchmark::Run("SphericalPointIndex_build_x200000", 5, [&]()
+  {
+    index.Build(lat.data(), lon.data(), lat.size());
+  });
+
+  benchmark::Run("SphericalPointIndex_insert_x200000", 5, [&]()
+  {
+    SphericalPointIndex inserted;
+    for (size_t i = 0; i < lat.size(); ++i)
+      inserted.Insert(Angle(lat[i]), Angle(lon[i]));
+    benchmark::DoNotOptimize(inserted);
+  });
+
+  // Brute force search with the batch distances.
+  std::vector<double> distance(lat.size());
+  std::vector<size_t> ids;
+  benchmark::Run("SphericalPointIndex_within_1km_brute_force", 20, [&]()
+  {
+    SphericalCoordinates::DistanceWGS84(queryLat.Radian(),
+        queryLon.Radian(), lat.data(), lon.data(), distance.data(),
+        distance.size());
+    ids.clear();
+    for (size_t i = 0; i < distance.size(); ++i)
+    {
+      if (distance[i] <= 1000)
+        ids.push_back(i);
+    }
+    benchmark::DoNotOptimize(ids);
+  });
+
+  benchmark::Run("SphericalPointIndex_within_1km", 2000, [&]()
+  {
+    index.WithinDistance(queryLat, queryLon, 1000, ids);
+    benchmark::DoNotOptimize(ids);
+  });
+
+  std::vector<double> distances;
+  benchmark::Run("SphericalPointIndex_nearest_10", 20000, [&]()
+  {
+    index.Nearest(queryLat, queryLon, 10, ids, distances);
+    benchmark::DoNotOptimize(ids);
+  });
+
+  benchmark::Run("SphericalPointIndex_nearest_10_sparse", 20000, [&]()
+  {
+    index.Nearest(Angle(-0.5), Angle(2.0), 10, ids, distances);
+    benchmark::DoNotOptimize(ids);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, Spline)
+{
+  std::vector<Vector3d> points;
+  for (int i = 0; i < 10000; ++i)
+    points.push_back(Vector3d(i, std::sin(0.1 * i), std::cos(0.05 * i)));
+
+  // Each point added updates the tangents and segments around it.
+  Spline spline;
+  benchmark::Run("Spline_add_point_x10000", 5, [&]()
+  {
+    spline.Clear();
+    for (const Vector3d &p : points)
+      spline.AddPoint(p);
+    benchmark::DoNotOptimize(spline);
+  });
+
+  benchmark::Run("Spline_add_points_x10000", 5, [&]()
+  {
+    spline.Clear();
+    spline.AddPoints(points);
+    benchmark::DoNotOptimize(spline);
+  });
+
+  unsigned int index = 0;
+  benchmark::Run("Spline_update_point_of_10000", 10000, [&]()
+  {
+    index = (index + 7919) % 10000;
+    spline.UpdatePoint(index, points[index] + Vector3d(0, 0, 0.1));
+    benchmark::DoNotOptimize(spline);
+  });
+
+  // Sampling the whole spline at sorted parameter values.
+  std::vector<double> t(100000);
+  for (size_t i = 0; i < t.size(); ++i)
+    t[i] = static_cast<double>(i) / t.size();
+  std::vector<Vector3d> samples(t.size());
+  benchmark::Run("Spline_interpolate_loop_x100000", 20, [&]()
+  {
+    for (size_t i = 0; i < t.size(); ++i)
+      samples[i] = spline.Interpolate(t[i]);
+    benchmark::DoNotOptimize(samples);
+  });
+
+  benchmark::Run("Spline_interpolate_batch_x100000", 20, [&]()
+  {
+    spline.Interpolate(t.data(), samples.data(), t.size());
+    benchmark::DoNotOptimize(samples);
+  });
+
+  benchmark::Run("Spline_interpolate_tangent_batch_x100000", 20, [&]()
+  {
+    spline.InterpolateTangent(t.data(), samples.data(), t.size());
+    benchmark::DoNotOptimize(samples);
+  });
+
+  // Curvature and Frenet frame from three calls per sample, or fused.
+  std::vector<SplineFrame> frames(t.size());
+  benchmark::Run("Spline_frames_loop_x100000", 20, [&]()
+  {
+    for (size_t i = 0; i < t.size(); ++i)
+    {
+      SplineFrame &frame = frames[i];
+      frame.position = spline.Interpolate(t[i]);
+      frame.firstDerivative = spline.InterpolateMthDerivative(1, t[i]);
+      frame.secondDerivative = spline.InterpolateMthDerivative(2, t[i]);
+      const Vector3d cross =
+        frame.firstDerivative.Cross(frame.secondDerivative);
+      const double speed = frame.firstDerivative.Length();
+      frame.curvature = cross.Length() / (speed * speed * speed);
+      frame.tangent = frame.firstDerivative / speed;
+      frame.binormal = cross.Normalized();
+      frame.normal = frame.binormal.Cross(frame.tangent);
+    }
+    benchmark::DoNotOptimize(frames);
+  });
+
+  benchmark::Run("Spline_frames_batch_x100000", 20, [&]()
+  {
+    spline.InterpolateFrames(t.data(), frames.data(), t.size());
+    benchmark::DoNotOptimize(frames);
+  });
+
+  // Sampling at evenly spaced distances, solving for each parameter value
+  // or interpolating the arc length tables.
+  const double length = spline.ArcLength();
+  benchmark::Run("Spline_interpolate_at_distance_x10000", 5, [&]()
+  {
+    for (size_t i = 0; i < 10000; ++i)
+      samples[i] = spline.InterpolateAtDistance(length * i / 10000);
+    benchmark::DoNotOptimize(samples);
+  });
+
+  benchmark::Run("Spline_arc_length_tables_16_of_10000", 5, [&]()
+  {
+    spline.ArcLengthTableSamples(0);
+    spline.ArcLengthTableSamples(16);
+    benchmark::DoNotOptimize(spline);
+  });
+
+  benchmark::Run("Spline_interpolate_at_distance_table_x10000", 20, [&]()
+  {
+    for (size_t i = 0; i < 10000; ++i)
+      samples[i] = spline.InterpolateAtDistance(length * i / 10000);
+    benchmark::DoNotOptimize(samples);
+  });
+
+  // Projecting a position that moves along the spline, from scratch or
+  // starting from the previous result.
+  double closest = 0.0;
+  benchmark::Run("Spline_closest_parameter_x1000", 5, [&]()
+  {
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      closest = spline.ClosestParameter(
+          points[10 * i] + Vector3d(0.1, 0.2, 0.3));
+    }
+    benchmark::DoNotOptimize(closest);
+  });
+
+  benchmark::Run("Spline_closest_parameter_hint_x1000", 5, [&]()
+  {
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      closest = spline.ClosestParameter(
+          points[10 * i] + Vector3d(0.1, 0.2, 0.3), closest);
+    }
+    benchmark::DoNotOptimize(closest);
+  });
+
+  std::vector<Vector3d> polyline;
+  benchmark::Run("Spline_tessellate_1mm_of_10000", 20, [&]()
+  {
+    spline.Tessellate(0.001, polyline);
+    benchmark::DoNotOptimize(polyline);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, RotationSpline)
+{
+  std::vector<Quaterniond> keyframes;
+  for (int i = 0; i < 5000; ++i)
+    keyframes.push_back(Quaterniond(0.01 * i, 0.02 * i, 0.03 * i));
+
+  // Each keyframe added updates the tangents and segments around it.
+  RotationSpline spline;
+  benchmark::Run("RotationSpline_add_point_x5000", 5, [&]()
+  {
+    spline.Clear();
+    for (const Quaterniond &q : keyframes)
+      spline.AddPoint(q);
+    benchmark::DoNotOptimize(spline);
+  });
+
+  std::vector<double> t(100000);
+  for (size_t i = 0; i < t.size(); ++i)
+    t[i] = static_cast<double>(i) / t.size();
+  std::vector<Quaterniond> samples(t.size());
+  benchmark::Run("RotationSpline_interpolate_loop_x100000", 20, [&]()
+  {
+    for (size_t i = 0; i < t.size(); ++i)
+      samples[i] = spline.Interpolate(t[i]);
+    benchmark::DoNotOptimize(samples);
+  });
+
+  benchmark::Run("RotationSpline_interpolate_batch_x100000", 20, [&]()
+  {
+    spline.Interpolate(t.data(), samples.data(), t.size());
+    benchmark::DoNotOptimize(samples);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, DiffDriveOdometryBank)
+{
+  const size_t robots = 2000;
+  std::vector<DiffDriveOdometry> odoms(robots);
+  DiffDriveOdometryBank bank;
+  auto time = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < robots; ++i)
+  {
+    const double separation = 1.0 + 0.001 * i;
+    odoms[i].SetWheelParams(separation, 0.2, 0.21);
+    odoms[i].Init(time);
+    bank.Add(separation, 0.2, 0.21);
+  }
+  bank.Init(time);
+
+  std::vector<double> left(robots);
+  std::vector<double> right(robots);
+  auto step = [&]()
+  {
+    time += std::chrono::milliseconds(10);
+    for (size_t i = 0; i < robots; ++i)
+    {
+      left[i] += 0.01 * static_cast<double>(i % 7);
+      right[i] += 0.01 * static_cast<double>(i % 5);
+    }
+  };
+
+  benchmark::Run("DiffDriveOdometry_update_x2000", 200, [&]()
+  {
+    step();
+    for (size_t i = 0; i < robots; ++i)
+      odoms[i].Update(left[i], right[i], time);
+    benchmark::DoNotOptimize(odoms);
+  });
+
+  benchmark::Run("DiffDriveOdometryBank_update_x2000", 200, [&]()
+  {
+    step();
+    bank.Update(left.data(), right.data(), time);
+    benchmark::DoNotOptimize(bank);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, PIDBank)
+{
+  // The joints of a humanoid, some with limits
+  const size_t joints = 40;
+  std::vector<PID> pids;
+  PIDBank bank;
+  for (size_t i = 0; i < joints; ++i)
+  {
+    const PID pid(100.0 + i, 1.0, 10.0, i % 2 ? 5.0 : -1.0, -5.0,
+                  i % 3 ? 50.0 : -1.0, -50.0);
+    pids.push_back(pid);
+    bank.Add(pid);
+  }
+
+  std::vector<double> errors(joints);
+  for (size_t i = 0; i < joints; ++i)
+    errors[i] = 0.01 * static_cast<double>(i % 11) - 0.05;
+  std::vector<double> cmd(joints);
+  const std::chrono::duration<double> dt(0.001);
+
+  benchmark::Run("PID_update_40_joints_x1000", 100, [&]()
+  {
+    for (int step = 0; step < 1000; ++step)
+    {
+      for (size_t i = 0; i < joints; ++i)
+        cmd[i] = pids[i].Update(errors[i], dt);
+    }
+    benchmark::DoNotOptimize(cmd);
+  });
+
+  benchmark::Run("PIDBank_update_40_joints_x1000", 100, [&]()
+  {
+    for (int step = 0; step < 1000; ++step)
+      benchmark::DoNotOptimize(bank.Update(errors.data(), dt));
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, SpeedLimiter)
+{
+  // Two axes of 4000 vehicles
+  SpeedLimiter limiter;
+  limiter.SetMinVelocity(-2.0);
+  limiter.SetMaxVelocity(2.0);
+  limiter.SetMinAcceleration(-1.0);
+  limiter.SetMaxAcceleration(1.0);
+  limiter.SetMinJerk(-0.5);
+  limiter.SetMaxJerk(0.5);
+  const size_t count = 8000;
+  std::vector<double> commands(count);
+  std::vector<double> prev(count);
+  std::vector<double> prevPrev(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    commands[i] = 0.001 * static_cast<double>(i % 5000) - 2.5;
+    prev[i] = 0.001 * static_cast<double>(i % 3000) - 1.5;
+    prevPrev[i] = prev[i] - 0.01;
+  }
+  const auto dt = std::chrono::milliseconds(10);
+
+  std::vector<double> vel(count);
+  benchmark::Run("SpeedLimiter_limit_loop_x8000", 200, [&]()
+  {
+    vel = commands;
+    for (size_t i = 0; i < count; ++i)
+      limiter.Limit(vel[i], prev[i], prevPrev[i], dt);
+    benchmark::DoNotOptimize(vel);
+  });
+
+  std::vector<uint8_t> limited(count);
+  benchmark::Run("SpeedLimiter_limit_batch_x8000", 200, [&]()
+  {
+    vel = commands;
+    limiter.LimitBatch(vel.data(), prev.data(), prevPrev.data(), count, dt,
+                       limited.data());
+    benchmark::DoNotOptimize(vel);
+    benchmark::DoNotOptimize(limited);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, FilterBank)
+{
+  // 256 channels with two bi-quad sections each
+  const size_t channels = 256;
+  const size_t frames = 256;
+  std::vector<double> in(channels * frames);
+  for (size_t i = 0; i < in.size(); ++i)
+    in[i] = std::sin(0.01 * static_cast<double>(i));
+  std::vector<double> out(in.size());
+
+  std::vector<BiQuad<double>> first(channels, BiQuad<double>(10, 1000));
+  std::vector<BiQuad<double>> second(channels, BiQuad<double>(10, 1000));
+  benchmark::Run("BiQuad_process_256_channels_x256", 50, [&]()
+  {
+    for (size_t f = 0; f < frames; ++f)
+    {
+      for (size_t c = 0; c < channels; ++c)
+      {
+        out[f * channels + c] =
+          second[c].Process(first[c].Process(in[f * channels + c]));
+      }
+    }
+    benchmark::DoNotOptimize(out);
+  });
+
+  BiQuadBank<double> bank(channels, 2);
+  bank.Fc(10, 1000);
+  benchmark::Run("BiQuadBank_process_256_channels_x256", 50, [&]()
+  {
+    bank.Process(in.data(), out.data(), frames);
+    benchmark::DoNotOptimize(out);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, SpscRingBuffer)
+{
+  // Blocks of 16 samples handed from a producer to a consumer, which
+  // computes their statistics
+  std::vector<double> block(16);
+  for (size_t i = 0; i < block.size(); ++i)
+    block[i] = 0.1 * static_cast<double>(i);
+
+  SignalStats stats;
+  stats.InsertStatistics("mean,rms");
+  std::mutex mutex;
+  std::vector<double> shared;
+  std::vector<double> received;
+  benchmark::Run("Mutex_vector_handoff_16_samples_x1000", 200, [&]()
+  {
+    for (int i = 0; i < 1000; ++i)
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        shared.insert(shared.end(), block.begin(), block.end());
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.swap(shared);
+        shared.clear();
+      }
+      stats.InsertData(received.data(), received.size());
+    }
+    benchmark::DoNotOptimize(stats);
+  });
+
+  SpscRingBuffer<double> ring(1024);
+  benchmark::Run("SpscRingBuffer_handoff_16_samples_x1000", 200, [&]()
+  {
+    for (int i = 0; i < 1000; ++i)
+    {
+      ring.Push(block.data(), block.size());
+      ring.Drain(stats);
+    }
+    benchmark::DoNotOptimize(stats);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, LoopTimer)
+{
+  // Cost of timing an iteration of a control loop, with a Stopwatch alone
+  // and with the statistics of LoopTimer
+  Stopwatch watch;
+  benchmark::Run("Stopwatch_start_stop_x1000", 200, [&]()
+  {
+    for (int i = 0; i < 1000; ++i)
+    {
+      watch.Start(true);
+      watch.Stop();
+    }
+    benchmark::DoNotOptimize(watch);
+  });
+
+  LoopTimer timer(std::chrono::microseconds(1));
+  benchmark::Run("LoopTimer_begin_end_x1000", 200, [&]()
+  {
+    for (int i = 0; i < 1000; ++i)
+    {
+      timer.Begin();
+      timer.End();
+    }
+    benchmark::DoNotOptimize(timer);
+  });
+
+  benchmark::Run("LoopTimer_jitter_p99", 200, [&]()
+  {
+    benchmark::DoNotOptimize(timer.JitterQuantile(0.99));
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, MecanumDriveOdometryBatch)
+{
+  // Replay of a recorded log of 100000 samples
+  const size_t count = 100000;
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::chrono::steady_clock::time_point> times(count);
+  std::vector<double> frontLeft(count), frontRight(count);
+  std::vector<double> backLeft(count), backRight(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    const double t = 0.001 * static_cast<double>(i + 1);
+    times[i] = start + std::chrono::milliseconds(i + 1);
+    frontLeft[i] = 2.0 * t + std::sin(t);
+    frontRight[i] = 2.0 * t - std::sin(3 * t);
+    backLeft[i] = 2.0 * t + std::cos(t);
+    backRight[i] = 2.5 * t;
+  }
+  std::vector<double> x(count), y(count), heading(count);
+
+  MecanumDriveOdometry odom;
+  odom.SetWheelParams(2.0, 1.5, 0.5, 0.5);
+  benchmark::Run("MecanumDriveOdometry_Update_100000_samples", 10, [&]()
+  {
+    odom.Init(start);
+    for (size_t i = 0; i < count; ++i)
+    {
+      odom.Update(frontLeft[i], frontRight[i], backLeft[i], backRight[i],
+                  times[i]);
+      x[i] = odom.X();
+      y[i] = odom.Y();
+      heading[i] = *odom.Heading();
+    }
+    benchmark::DoNotOptimize(x);
+  });
+
+  for (unsigned int threads : {1u, 4u})
+  {
+    benchmark::Run("MecanumDriveOdometry_UpdateBatch_100000_samples_" +
+        std::to_string(threads) + "_threads", 10, [&]()
+    {
+      odom.Init(start);
+      odom.UpdateBatch(times.data(), frontLeft.data(), frontRight.data(),
+                       backLeft.data(), backRight.data(), count, x.data(),
+                       y.data(), heading.data(), threads);
+      benchmark::DoNotOptimize(x);
+    });
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, ColorConversions)
+{
+  // A 640x480 image
+  const size_t count = 640 * 480;
+  std::vector<float> hsv(3 * count), rgb(3 * count), out(3 * count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    hsv[3 * i] = static_cast<float>(i % 360);
+    hsv[3 * i + 1] = static_cast<float>(i % 101) / 100.0f;
+    hsv[3 * i + 2] = static_cast<float>(i % 53) / 52.0f;
+  }
+
+  benchmark::Run("Color_SetFromHSV_HSV_640x480", 20, [&]()
+  {
+    Color clr;
+    for (size_t i = 0; i < count; ++i)
+    {
+      clr.SetFromHSV(hsv[3 * i], hsv[3 * i + 1], hsv[3 * i + 2]);
+      const Vector3f v = clr.HSV();
+      out[3 * i] = v.X();
+      out[3 * i + 1] = v.Y();
+      out[3 * i + 2] = v.Z();
+    }
+    benchmark::DoNotOptimize(out);
+  });
+
+  for (unsigned int threads : {1u, 4u})
+  {
+    benchmark::Run("Color_HSVToRGB_RGBToHSV_640x480_" +
+        std::to_string(threads) + "_threads", 20, [&]()
+    {
+      Color::HSVToRGB(hsv.data(), rgb.data(), count, threads);
+      Color::RGBToHSV(rgb.data(), out.data(), count, threads);
+      benchmark::DoNotOptimize(out);
+    });
+  }
+
+  benchmark::Run("Color_SetFromYUV_YUV_640x480", 20, [&]()
+  {
+    Color clr;
+    for (size_t i = 0; i < count; ++i)
+    {
+      clr.SetFromYUV(hsv[3 * i], hsv[3 * i + 1], hsv[3 * i + 2]);
+      const Vector3f v = clr.YUV();
+      out[3 * i] = v.X();
+      out[3 * i + 1] = v.Y();
+      out[3 * i + 2] = v.Z();
+    }
+    benchmark::DoNotOptimize(out);
+  });
+
+  benchmark::Run("Color_YUVToRGB_RGBToYUV_640x480_1_threads", 20, [&]()
+  {
+    Color::YUVToRGB(hsv.data(), rgb.data(), count);
+    Color::RGBToYUV(rgb.data(), out.data(), count);
+    benchmark::DoNotOptimize(out);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, ColorMap)
+{
+  // A 512x512 slice of a grid field
+  const size_t count = 512 * 512;
+  std::vector<float> values(count);
+  for (size_t i = 0; i < count; ++i)
+    values[i] = std::sin(0.001f * static_cast<float>(i)) * 1.2f;
+  std::vector<Color::RGBA> pixels(count);
+
+  const std::vector<std::pair<double, Color>> points = {
+    {-1.0, Color::Blue}, {0.0, Color::White}, {1.0, Color::Red}};
+
+  benchmark::Run("ColorMap_ColorArithmetic_512x512", 20, [&]()
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      const double v = clamp(static_cast<double>(values[i]), -1.0, 1.0);
+      const size_t k = v < 0.0 ? 0 : 1;
+      const float t = static_cast<float>(v - points[k].first);
+      const Color c = points[k].second * (1 - t) +
+        points[k + 1].second * t;
+      pixels[i] = c.AsRGBA();
+    }
+    benchmark::DoNotOptimize(pixels);
+  });
+
+  for (size_t size : {256u, 4096u})
+  {
+    const ColorMap map(points, size);
+    benchmark::Run("ColorMap_Map_512x512_" + std::to_string(size), 20,
+        [&]()
+    {
+      map.Map(values.data(), pixels.data(), count);
+      benchmark::DoNotOptimize(pixels);
+    });
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, TemperatureArrays)
+{
+  // A 640x512 thermal camera frame of raw counts, 0.04 K per count
+  const size_t count = 640 * 512;
+  std::vector<double> raw(count), frame(count);
+  for (size_t i = 0; i < count; ++i)
+    raw[i] = 7000.0 + static_cast<double>(i % 1000);
+
+  benchmark::Run("Temperature_PerPixel_640x512", 50, [&]()
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      Temperature temp(raw[i] * 0.04);
+      frame[i] = temp.Celsius();
+    }
+    benchmark::DoNotOptimize(frame);
+  });
+
+  benchmark::Run("Temperature_ScaleThenKelvinToCelsius_640x512", 50, [&]()
+  {
+    Temperature::ScaleOffset(raw.data(), frame.data(), count, 0.04, 0.0);
+    Temperature::KelvinToCelsius(frame.data(), frame.data(), count);
+    benchmark::DoNotOptimize(frame);
+  });
+
+  benchmark::Run("Temperature_ScaleOffset_640x512", 50, [&]()
+  {
+    Temperature::ScaleOffset(raw.data(), frame.data(), count, 0.04,
+                             -273.15);
+    Temperature::Clamp(frame.data(), count, -40.0, 150.0);
+    benchmark::DoNotOptimize(frame);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, TimeStrings)
+{
+  std::vector<std::string> lines;
+  std::string buffer;
+  for (int i = 0; i < 10000; ++i)
+  {
+    lines.push_back(durationToString(std::chrono::milliseconds(i * 7919)));
+    buffer += lines.back() + "\n";
+  }
+  std::vector<std::chrono::steady_clock::duration> durations(lines.size());
+
+  benchmark::Run("stringToDuration_x10000", 20, [&]()
+  {
+    for (std::size_t i = 0; i < lines.size(); ++i)
+      durations[i] = stringToDuration(lines[i]);
+    benchmark::DoNotOptimize(durations);
+  });
+
+  benchmark::Run("stringsToDurations_x10000", 20, [&]()
+  {
+    stringsToDurations(buffer, durations);
+    benchmark::DoNotOptimize(durations);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, ParseNumbers)
+{
+  std::vector<std::string> tokens;
+  std::string text;
+  for (int i = 0; i < 30000; ++i)
+  {
+    tokens.push_back(std::to_string(i * 0.37 - 5000.0));
+    text += tokens.back() + (i % 3 == 2 ? "\n" : " ");
+  }
+  std::vector<double> values(tokens.size());
+  std::vector<Vector3d> vectors;
+
+  benchmark::Run("parseFloat_x30000", 20, [&]()
+  {
+    for (std::size_t i = 0; i < tokens.size(); ++i)
+      values[i] = parseFloat(tokens[i]);
+    benchmark::DoNotOptimize(values);
+  });
+
+  benchmark::Run("parseFloats_x30000", 20, [&]()
+  {
+    parseFloats(text, values);
+    benchmark::DoNotOptimize(values);
+  });
+
+  benchmark::Run("parseVector3s_x10000", 20, [&]()
+  {
+    parseVector3s(text, vectors);
+    benchmark::DoNotOptimize(vectors);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, FormatRecords)
+{
+  const Pose3d pose(1.25, -2.5, 3.75, 0.1, 0.2, 0.3);
+  const std::chrono::steady_clock::duration time =
+    std::chrono::milliseconds(123456789);
+  std::string record;
+
+  benchmark::Run("FormatRecord_ostringstream", 100000, [&]()
+  {
+    std::ostringstream stream;
+    stream << durationToString(time) << " " << pose;
+    record = stream.str();
+    benchmark::DoNotOptimize(record);
+  });
+
+  benchmark::Run("FormatRecord_appendToString", 100000, [&]()
+  {
+    record.clear();
+    appendToString(record, time);
+    record += ' ';
+    appendToString(record, pose);
+    benchmark::DoNotOptimize(record);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, SpatialHashGrid)
+{
+  Rand::Seed(7);
+  std::vector<Vector3d> particles(10000);
+  for (auto &p : particles)
+  {
+    p.Set(Rand::DblUniform(0, 10), Rand::DblUniform(0, 10),
+          Rand::DblUniform(0, 1));
+  }
+  const double radius = 0.1;
+  std::vector<std::pair<std::size_t, std::size_t>> pairs;
+
+  benchmark::Run("Pairs_brute_force_10000_particles", 2, [&]()
+  {
+    pairs.clear();
+    for (std::size_t i = 0; i < particles.size(); ++i)
+    {
+      for (std::size_t j = i + 1; j < particles.size(); ++j)
+      {
+        if ((particles[i] - particles[j]).SquaredLength() <= radius * radius)
+          pairs.emplace_back(i, j);
+      }
+    }
+    benchmark::DoNotOptimize(pairs);
+  });
+
+  SpatialHashGridd grid(radius);
+  benchmark::Run("SpatialHashGrid_build_10000_particles", 20, [&]()
+  {
+    grid.Clear();
+    for (const auto &p : particles)
+      grid.Insert(p);
+    benchmark::DoNotOptimize(grid);
+  });
+
+  benchmark::Run("SpatialHashGrid_Pairs_10000_particles", 20, [&]()
+  {
+    grid.Pairs(radius, pairs);
+    benchmark::DoNotOptimize(pairs);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, ArrayStats)
+{
+  Rand::Seed(7);
+  std::vector<double> values(1000000);
+  for (auto &v : values)
+    v = Rand::DblNormal(100, 2);
+
+  benchmark::Run("mean_variance_two_passes_1000000", 20, [&]()
+  {
+    double m = 0;
+    for (const double v : values)
+      m += v;
+    m /= static_cast<double>(values.size());
+    double s = 0;
+    for (const double v : values)
+      s += (v - m) * (v - m);
+    benchmark::DoNotOptimize(s);
+  });
+
+  for (const unsigned int threads : {1u, 4u})
+  {
+    benchmark::Run("meanAndVariance_1000000_" + std::to_string(threads) +
+                   "_threads", 20, [&]()
+    {
+      double m = 0;
+      double v = 0;
+      meanAndVariance(values.data(), values.size(), m, v, threads);
+      benchmark::DoNotOptimize(v);
+    });
+  }
+
+  benchmark::Run("min_max_two_passes_1000000", 20, [&]()
+  {
+    double lo = math::min(values);
+    double hi = math::max(values);
+    benchmark::DoNotOptimize(lo);
+    benchmark::DoNotOptimize(hi);
+  });
+
+  benchmark::Run("minmax_1000000", 20, [&]()
+  {
+    auto range = minmax(values.data(), values.size());
+    benchmark::DoNotOptimize(range);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, SemanticVersion)
+{
+  std::vector<std::string> strings;
+  for (int i = 0; i < 10000; ++i)
+  {
+    strings.push_back(std::to_string(i % 7) + "." + std::to_string(i % 31) +
+                      "." + std::to_string(i % 101) +
+                      (i % 3 == 0 ? "-pre" : "") + "+build" +
+                      std::to_string(i));
+  }
+
+  benchmark::Run("SemanticVersion_parse_sort_x10000", 20, [&]()
+  {
+    std::vector<SemanticVersion> versions;
+    versions.reserve(strings.size());
+    for (const auto &str : strings)
+      versions.emplace_back(str);
+    std::sort(versions.begin(), versions.end());
+    benchmark::DoNotOptimize(versions);
+  });
+
+  benchmark::Run("SemanticVersion_ParseKey_sort_x10000", 20, [&]()
+  {
+    std::vector<std::uint64_t> keys(strings.size());
+    for (std::size_t i = 0; i < strings.size(); ++i)
+      SemanticVersion::ParseKey(strings[i], keys[i]);
+    std::sort(keys.begin(), keys.end());
+    benchmark::DoNotOptimize(keys);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, SensorBufferKernels)
+{
+  Rand::Seed(7);
+  std::vector<float> ranges(640 * 480);
+  for (std::size_t i = 0; i < ranges.size(); ++i)
+  {
+    ranges[i] = i % 97 == 0 ? NAN_F : (i % 89 == 0 ? INF_F :
+      static_cast<float>(Rand::DblUniform(0, 40)));
+  }
+  std::vector<float> out(ranges.size());
+
+  benchmark::Run("Sanitize_per_element_640x480", 100, [&]()
+  {
+    for (std::size_t i = 0; i < ranges.size(); ++i)
+    {
+      out[i] = math::isnan(ranges[i]) ? 0.0f :
+        math::clamp(ranges[i], 0.1f, 30.0f);
+    }
+    benchmark::DoNotOptimize(out);
+  });
+
+  benchmark::Run("sanitize_640x480", 100, [&]()
+  {
+    sanitize(ranges.data(), out.data(), ranges.size(), 0.1f, 30.0f, 0.0f);
+    benchmark::DoNotOptimize(out);
+  });
+
+  benchmark::Run("Precision_per_element_640x480", 100, [&]()
+  {
+    for (std::size_t i = 0; i < ranges.size(); ++i)
+      out[i] = math::precision(ranges[i], 3);
+    benchmark::DoNotOptimize(out);
+  });
+
+  benchmark::Run("precision_640x480", 100, [&]()
+  {
+    precision(ranges.data(), out.data(), ranges.size(), 3);
+    benchmark::DoNotOptimize(out);
+  });
+
+  benchmark::Run("Fixnan_per_element_640x480", 100, [&]()
+  {
+    for (std::size_t i = 0; i < ranges.size(); ++i)
+      out[i] = math::fixnan(ranges[i]);
+    benchmark::DoNotOptimize(out);
+  });
+
+  benchmark::Run("fixnan_640x480", 100, [&]()
+  {
+    fixnan(ranges.data(), out.data(), ranges.size());
+    benchmark::DoNotOptimize(out);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, AngleArrays)
+{
+  Rand::Seed(8);
+  std::vector<double> headings(100000);
+  for (double &heading : headings)
+    heading = Rand::DblUniform(-50, 50);
+  std::vector<double> out(headings.size());
+  std::vector<double> cos(headings.size());
+
+  benchmark::Run("Normalized_per_element_x100000", 20, [&]()
+  {
+    for (std::size_t i = 0; i < headings.size(); ++i)
+      out[i] = Angle(headings[i]).Normalized().Radian();
+    benchmark::DoNotOptimize(out);
+  });
+
+  benchmark::Run("Wrap_x100000", 20, [&]()
+  {
+    Angle::Wrap(headings.data(), out.data(), headings.size());
+    benchmark::DoNotOptimize(out);
+  });
+
+  benchmark::Run("Unwrap_x100000", 20, [&]()
+  {
+    Angle::Unwrap(headings.data(), out.data(), headings.size());
+    benchmark::DoNotOptimize(out);
+  });
+
+  benchmark::Run("SinCos_x100000", 20, [&]()
+  {
+    Angle::SinCos(headings.data(), out.data(), cos.data(), headings.size());
+    benchmark::DoNotOptimize(out);
+    benchmark::DoNotOptimize(cos);
+  });
+
+  benchmark::Run("FastSinCos_x100000", 20, [&]()
+  {
+    Angle::FastSinCos(headings.data(), out.data(), cos.data(),
+                      headings.size());
+    benchmark::DoNotOptimize(out);
+    benchmark::DoNotOptimize(cos);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, Region3Array)
+{
+  Rand::Seed(9);
+  std::vector<Region3d> fences;
+  for (int i = 0; i < 32; ++i)
+  {
+    const double x = Rand::DblUniform(-50, 40);
+    const double y = Rand::DblUniform(-50, 40);
+    fences.push_back(Region3d(Intervald::LeftClosed(x, x + 10),
+                              Intervald::LeftClosed(y, y + 10),
+                              Intervald::Closed(0, 20)));
+  }
+  std::vector<Vector3d> points(100000);
+  for (Vector3d &point : points)
+  {
+    point.Set(Rand::DblUniform(-50, 50), Rand::DblUniform(-50, 50),
+              Rand::DblUniform(-5, 25));
+  }
+  std::vector<std::uint64_t> masks(points.size());
+
+  benchmark::Run("Region3_Contains_32_regions_x100000", 10, [&]()
+  {
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+      std::uint64_t mask = 0;
+      for (std::size_t r = 0; r < fences.size(); ++r)
+        mask |= static_cast<std::uint64_t>(fences[r].Contains(points[i])) << r;
+      masks[i] = mask;
+    }
+    benchmark::DoNotOptimize(masks);
+  });
+
+  const Region3Arrayd array(fences);
+  benchmark::Run("Region3Array_Contains_32_regions_x100000", 10, [&]()
+  {
+    array.Contains(points.data(), points.size(), masks.data());
+    benchmark::DoNotOptimize(masks);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, Matrix6)
+{
+  // Spatial inertia of a body with fluid added mass
+  Inertiald inertial(MassMatrix3d(3.0, Vector3d(2, 3, 4), Vector3d(0.1, 0, 0)),
+                     Pose3d(0.5, -0.2, 0.1, 0, 0, 0));
+  Matrix6d addedMass;
+  for (std::size_t i = 0; i < 6; ++i)
+    addedMass(i, i) = 0.1 * static_cast<double>(i + 1);
+  inertial.SetFluidAddedMass(addedMass);
+  const Matrix6d inertia = inertial.SpatialMatrix();
+  const Matrix3d rot(Quaterniond(0.1, 0.2, 0.3));
+  const Matrix6d transform(rot, Matrix3d::Zero, Matrix3d::Zero, rot);
+  const std::array<double, 6> v = {0.1, -0.2, 0.3, 1, 2, -3};
+  std::array<double, 6> out;
+  Matrix6d result;
+
+  benchmark::Run("Multiply_x100000", 20, [&]()
+  {
+    for (int i = 0; i < 100000; ++i)
+    {
+      result = inertia * transform;
+      benchmark::DoNotOptimize(result);
+    }
+  });
+
+  benchmark::Run("MultiplyBlockDiagonal_x100000", 20, [&]()
+  {
+    for (int i = 0; i < 100000; ++i)
+    {
+      result = inertia.MultiplyBlockDiagonal(rot, rot);
+      benchmark::DoNotOptimize(result);
+    }
+  });
+
+  benchmark::Run("MultiplyVector_x100000", 20, [&]()
+  {
+    for (int i = 0; i < 100000; ++i)
+    {
+      out = inertia * v;
+      benchmark::DoNotOptimize(out);
+    }
+  });
+
+  benchmark::Run("Inverse_x100000", 20, [&]()
+  {
+    for (int i = 0; i < 100000; ++i)
+    {
+      result = inertia.Inverse();
+      benchmark::DoNotOptimize(result);
+    }
+  });
+
+  benchmark::Run("SolveSymmetricInverse_x100000", 20, [&]()
+  {
+    for (int i = 0; i < 100000; ++i)
+    {
+      inertia.Solve(Matrix6d::Identity, result);
+      benchmark::DoNotOptimize(result);
+    }
+  });
+
+  benchmark::Run("Solve_x100000", 20, [&]()
+  {
+    for (int i = 0; i < 100000; ++i)
+    {
+      inertia.Solve(v, out);
+      benchmark::DoNotOptimize(out);
+    }
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, RigidTransform3)
+{
+  const Pose3d pose(1, -2, 3, 0.4, -1.1, 2.7);
+  const Pose3d other(-0.5, 0.25, 4, 0.3, -0.2, 0.1);
+  const RigidTransform3d transform(pose);
+  const RigidTransform3d otherTransform(other);
+
+  std::vector<Vector3d> points;
+  for (int i = 0; i < 10000; ++i)
+    points.emplace_back(i * 0.1, -i * 0.2, i * 0.3);
+  std::vector<Vector3d> out(points.size());
+
+  benchmark::Run("Pose3d_CoordPositionAdd_x10000", 200, [&]()
+  {
+    for (std::size_t i = 0; i < points.size(); ++i)
+      out[i] = pose.CoordPositionAdd(points[i]);
+    benchmark::DoNotOptimize(out);
+  });
+
+  benchmark::Run("TransformPoint_x10000", 200, [&]()
+  {
+    for (std::size_t i = 0; i < points.size(); ++i)
+      out[i] = transform.TransformPoint(points[i]);
+    benchmark::DoNotOptimize(out);
+  });
+
+  benchmark::Run("TransformPoints_x10000", 200, [&]()
+  {
+    transform.TransformPoints(points.data(), out.data(), points.size());
+    benchmark::DoNotOptimize(out);
+  });
+
+  benchmark::Run("Pose3d_multiply_inverse", 1000000, [&]()
+  {
+    Pose3d result = pose * other.Inverse();
+    benchmark::DoNotOptimize(result);
+  });
+
+  benchmark::Run("RigidTransform3d_multiply_inverse", 1000000, [&]()
+  {
+    RigidTransform3d result = transform * otherTransform.Inverse();
+    benchmark::DoNotOptimize(result);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, EulerConversions)
+{
+  Rand::Seed(11);
+  std::vector<Vector3d> angles(100000);
+  for (Vector3d &angle : angles)
+  {
+    angle.Set(Rand::DblUniform(-3, 3), Rand::DblUniform(-1.5, 1.5),
+              Rand::DblUniform(-3, 3));
+  }
+  const Vector3Arrayd anglesArray(angles);
+  std::vector<Quaterniond> quaternions(angles.size());
+  std::vector<Matrix3d> matrices(angles.size());
+  QuaternionArrayd array;
+  Vector3Arrayd euler;
+
+  benchmark::Run("SetFromEuler_per_element_x100000", 20, [&]()
+  {
+    for (std::size_t i = 0; i < angles.size(); ++i)
+      quaternions[i].SetFromEuler(angles[i]);
+    benchmark::DoNotOptimize(quaternions);
+  });
+
+  benchmark::Run("SetFromEuler_array_x100000", 20, [&]()
+  {
+    array.SetFromEuler(anglesArray);
+    benchmark::DoNotOptimize(array);
+  });
+
+  benchmark::Run("Euler_per_element_x100000", 20, [&]()
+  {
+    for (std::size_t i = 0; i < angles.size(); ++i)
+      angles[i] = quaternions[i].Euler();
+    benchmark::DoNotOptimize(angles);
+  });
+
+  benchmark::Run("Euler_array_x100000", 20, [&]()
+  {
+    array.Euler(euler);
+    benchmark::DoNotOptimize(euler);
+  });
+
+  benchmark::Run("ToMatrix_per_element_x100000", 20, [&]()
+  {
+    for (std::size_t i = 0; i < angles.size(); ++i)
+      matrices[i] = Matrix3d(quaternions[i]);
+    benchmark::DoNotOptimize(matrices);
+  });
+
+  benchmark::Run("ToMatrix_array_x100000", 20, [&]()
+  {
+    array.ToMatrix(matrices.data());
+    benchmark::DoNotOptimize(matrices);
+  });
+
+  benchmark::Run("SetFromMatrix_per_element_x100000", 20, [&]()
+  {
+    for (std::size_t i = 0; i < angles.size(); ++i)
+      quaternions[i].SetFromMatrix(matrices[i]);
+    benchmark::DoNotOptimize(quaternions);
+  });
+
+  benchmark::Run("SetFromMatrix_array_x100000", 20, [&]()
+  {
+    array.SetFromMatrix(matrices.data(), matrices.size());
+    benchmark::DoNotOptimize(array);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, Vector3MultiplyAdd)
+{
+  // One step of a particle integrator, with operators and with the
+  // MultiplyAdd and CrossAdd helpers
+  const double dt = 0.001;
+  const Vector3d omega(0.1, -0.2, 0.3);
+  const Matrix3d rotation(0, -1, 0, 1, 0, 0, 0, 0, 1);
+  std::vector<Vector3d> positions;
+  std::vector<Vector3d> velocities;
+  for (int i = 0; i < 10000; ++i)
+  {
+    positions.emplace_back(i * 0.1, -i * 0.2, i * 0.3);
+    velocities.emplace_back(-i * 0.01, i * 0.02, 1.0);
+  }
+  Vector3Arrayd positionsArray(positions);
+  const Vector3Arrayd velocitiesArray(velocities);
+
+  benchmark::Run("operators_x10000", 1000, [&]()
+  {
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+      const Vector3d v = rotation * velocities[i] + omega.Cross(positions[i]);
+      positions[i] = positions[i] + v * dt;
+    }
+    benchmark::DoNotOptimize(positions);
+  });
+
+  benchmark::Run("MultiplyAdd_x10000", 1000, [&]()
+  {
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+      const Vector3d v = rotation.MultiplyAdd(velocities[i],
+          Vector3d::CrossAdd(omega, positions[i], Vector3d::Zero));
+      positions[i] = Vector3d::MultiplyAdd(v, dt, positions[i]);
+    }
+    benchmark::DoNotOptimize(positions);
+  });
+
+  benchmark::Run("positions_plus_velocities_dt_x10000", 1000, [&]()
+  {
+    for (std::size_t i = 0; i < positions.size(); ++i)
+      positions[i] += velocities[i] * dt;
+    benchmark::DoNotOptimize(positions);
+  });
+
+  benchmark::Run("Vector3Array_MultiplyAdd_x10000", 1000, [&]()
+  {
+    positionsArray.MultiplyAdd(velocitiesArray, dt);
+    benchmark::DoNotOptimize(positionsArray);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, NormalizeFast)
+{
+  std::vector<Vector3d> vectors;
+  std::vector<Quaterniond> quaternions;
+  for (int i = 0; i < 10000; ++i)
+  {
+    vectors.emplace_back(1 + i * 0.1, -i * 0.2, 0.3);
+    quaternions.emplace_back(1, i * 0.01, -i * 0.02, 0.3);
+  }
+  const Vector3Arrayd vectorsArray(vectors);
+  const QuaternionArrayd quaternionsArray(quaternions);
+  std::vector<Vector3d> outVectors(vectors.size());
+  std::vector<Quaterniond> outQuaternions(quaternions.size());
+  Vector3Arrayd outVectorsArray;
+  QuaternionArrayd outQuaternionsArray;
+
+  benchmark::Run("Vector3d_Normalize_x10000", 1000, [&]()
+  {
+    for (std::size_t i = 0; i < vectors.size(); ++i)
+      outVectors[i] = vectors[i].Normalized();
+    benchmark::DoNotOptimize(outVectors);
+  });
+
+  benchmark::Run("Vector3d_NormalizeFast_x10000", 1000, [&]()
+  {
+    for (std::size_t i = 0; i < vectors.size(); ++i)
+      outVectors[i] = Vector3d(vectors[i]).NormalizeFast();
+    benchmark::DoNotOptimize(outVectors);
+  });
+
+  benchmark::Run("Vector3Array_Normalize_x10000", 1000, [&]()
+  {
+    outVectorsArray = vectorsArray;
+    outVectorsArray.Normalize();
+    benchmark::DoNotOptimize(outVectorsArray);
+  });
+
+  benchmark::Run("Vector3Array_NormalizeFast_x10000", 1000, [&]()
+  {
+    outVectorsArray = vectorsArray;
+    outVectorsArray.NormalizeFast();
+    benchmark::DoNotOptimize(outVectorsArray);
+  });
+
+  benchmark::Run("Quaterniond_Normalize_x10000", 1000, [&]()
+  {
+    for (std::size_t i = 0; i < quaternions.size(); ++i)
+    {
+      outQuaternions[i] = quaternions[i];
+      outQuaternions[i].Normalize();
+    }
+    benchmark::DoNotOptimize(outQuaternions);
+  });
+
+  benchmark::Run("Quaterniond_NormalizeFast_x10000", 1000, [&]()
+  {
+    for (std::size_t i = 0; i < quaternions.size(); ++i)
+    {
+      outQuaternions[i] = quaternions[i];
+      outQuaternions[i].NormalizeFast();
+    }
+    benchmark::DoNotOptimize(outQuaternions);
+  });
+
+  benchmark::Run("QuaternionArray_Normalize_x10000", 1000, [&]()
+  {
+    outQuaternionsArray = quaternionsArray;
+    outQuaternionsArray.Normalize();
+    benchmark::DoNotOptimize(outQuaternionsArray);
+  });
+
+  benchmark::Run("QuaternionArray_NormalizeFast_x10000", 1000, [&]()
+  {
+    outQuaternionsArray = quaternionsArray;
+    outQuaternionsArray.NormalizeFast();
+    benchmark::DoNotOptimize(outQuaternionsArray);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, Matrix3Array)
+{
+  std::vector<Matrix3d> matrices;
+  for (int i = 0; i < 10000; ++i)
+  {
+    matrices.push_back(Matrix3d(Quaterniond(i * 0.001, 0.2, -i * 0.003)) +
+        Matrix3d(1e-5, 0, -2e-5, 0, 3e-5, 0, 1e-5, 0, -1e-5));
+  }
+  const Matrix3Arrayd array(matrices);
+  std::vector<Matrix3d> out(matrices.size());
+  std::vector<double> determinants(matrices.size());
+  Matrix3Arrayd outArray;
+
+  benchmark::Run("Matrix3d_Determinant_x10000", 1000, [&]()
+  {
+    for (std::size_t i = 0; i < matrices.size(); ++i)
+      determinants[i] = matrices[i].Determinant();
+    benchmark::DoNotOptimize(determinants);
+  });
+
+  benchmark::Run("Matrix3Array_Determinant_x10000", 1000, [&]()
+  {
+    array.Determinant(determinants);
+    benchmark::DoNotOptimize(determinants);
+  });
+
+  benchmark::Run("Matrix3d_Inverse_x10000", 1000, [&]()
+  {
+    for (std::size_t i = 0; i < matrices.size(); ++i)
+      out[i] = matrices[i].Inverse();
+    benchmark::DoNotOptimize(out);
+  });
+
+  benchmark::Run("Matrix3Array_Invert_x10000", 1000, [&]()
+  {
+    outArray = array;
+    outArray.Invert();
+    benchmark::DoNotOptimize(outArray);
+  });
+
+  benchmark::Run("Matrix3d_Orthonormalize_x10000", 1000, [&]()
+  {
+    for (std::size_t i = 0; i < matrices.size(); ++i)
+      out[i] = matrices[i].Orthonormalized();
+    benchmark::DoNotOptimize(out);
+  });
+
+  benchmark::Run("Matrix3Array_Orthonormalize_x10000", 1000, [&]()
+  {
+    outArray = array;
+    outArray.Orthonormalize();
+    benchmark::DoNotOptimize(outArray);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, Pose3Trajectory)
+{
+  // A pose history at 100 Hz and the times of the points of a sweep
+  Pose3Trajectoryd trajectory;
+  for (int i = 0; i <= 10; ++i)
+  {
+    trajectory.Append(i * 0.01,
+        Pose3d(i * 0.1, -i * 0.02, 0.5, 0.01 * i, -0.02 * i, 0.3 * i));
+  }
+  std::vector<double> times;
+  std::vector<Vector3d> points;
+  for (int i = 0; i < 100000; ++i)
+  {
+    times.push_back(i * 1e-6);
+    points.emplace_back(std::cos(i * 0.001) * 10, std::sin(i * 0.001) * 10,
+                        0.1);
+  }
+  std::vector<Pose3d> poses(times.size());
+  std::vector<Vector3d> out(points.size());
+
+  benchmark::Run("Quaternion_Slerp_x100000", 20, [&]()
+  {
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < times.size(); ++i)
+    {
+      while (k + 2 < trajectory.Size() && trajectory.Time(k + 1) <= times[i])
+        ++k;
+      const Pose3d &p0 = trajectory.Pose(k);
+      const Pose3d &p1 = trajectory.Pose(k + 1);
+      const double t = (times[i] - trajectory.Time(k)) /
+          (trajectory.Time(k + 1) - trajectory.Time(k));
+      poses[i] = Pose3d(p0.Pos() + (p1.Pos() - p0.Pos()) * t,
+          Quaterniond::Slerp(t, p0.Rot(), p1.Rot(), true));
+    }
+    benchmark::DoNotOptimize(poses);
+  });
+
+  benchmark::Run("Interpolate_x100000", 20, [&]()
+  {
+    trajectory.Interpolate(times.data(), poses.data(), times.size());
+    benchmark::DoNotOptimize(poses);
+  });
+
+  benchmark::Run("TransformPoints_x100000", 20, [&]()
+  {
+    trajectory.TransformPoints(times.data(), points.data(), out.data(),
+                               points.size());
+    benchmark::DoNotOptimize(out);
+  });
+
+  // Ten minutes of a vehicle driving and turning, logged at 200 Hz
+  Pose3Trajectoryd log;
+  Vector3d position;
+  double yaw = 0;
+  for (int i = 0; i < 120000; ++i)
+  {
+    const double time = i / 200.0;
+    yaw += 0.005 * std::sin(0.05 * time);
+    position += Vector3d(std::cos(yaw), std::sin(yaw), 0) * 0.05;
+    log.Append(time, Pose3d(position,
+        Quaterniond(0.01 * std::sin(30 * time), 0, yaw)));
+  }
+
+  Pose3Trajectoryd simplified;
+  benchmark::Run("Pose3Trajectory_simplify_x120000", 5, [&]()
+  {
+    log.Simplify(0.01, 0.005, simplified);
+    benchmark::DoNotOptimize(simplified);
+  });
+  EXPECT_LT(simplified.Size(), log.Size() / 4);
+  ::testing::Test::RecordProperty("Pose3Trajectory_simplify_kept",
+      std::to_string(simplified.Size()));
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, AxisAlignedBoxT)
+{
+  // Bounds of small boxes around the points of a cloud, merged and tested
+  // against a query box
+  std::vector<Vector3d> points;
+  std::vector<Vector3f> pointsf;
+  for (int i = 0; i < 10000; ++i)
+  {
+    points.emplace_back(std::cos(i * 0.01) * 10, std::sin(i * 0.013) * 10,
+                        (i % 100) * 0.1);
+    pointsf.emplace_back(static_cast<float>(points.back().X()),
+                         static_cast<float>(points.back().Y()),
+                         static_cast<float>(points.back().Z()));
+  }
+  const Vector3d half(0.05, 0.05, 0.05);
+  const Vector3f halff(0.05f, 0.05f, 0.05f);
+  std::vector<AxisAlignedBox> boxes;
+  std::vector<AxisAlignedBoxf> boxesf;
+  std::vector<std::uint8_t> inside(points.size());
+
+  benchmark::Run("AxisAlignedBox_BuildMerge_x10000", 100, [&]()
+  {
+    boxes.clear();
+    AxisAlignedBox bounds;
+    for (const Vector3d &p : points)
+    {
+      boxes.emplace_back(p - half, p + half);
+      bounds.Merge(boxes.back());
+    }
+    benchmark::DoNotOptimize(bounds);
+  });
+
+  benchmark::Run("AxisAlignedBoxf_BuildMerge_x10000", 100, [&]()
+  {
+    boxesf.clear();
+    AxisAlignedBoxf bounds;
+    for (const Vector3f &p : pointsf)
+    {
+      boxesf.emplace_back(p - halff, p + halff);
+      bounds.Merge(boxesf.back());
+    }
+    benchmark::DoNotOptimize(bounds);
+  });
+
+  // Same precision as AxisAlignedBox, without its allocation per box
+  std::vector<AxisAlignedBoxd> boxesd;
+  benchmark::Run("AxisAlignedBoxd_BuildMerge_x10000", 100, [&]()
+  {
+    boxesd.clear();
+    AxisAlignedBoxd bounds;
+    for (const Vector3d &p : points)
+    {
+      boxesd.emplace_back(p - half, p + half);
+      bounds.Merge(boxesd.back());
+    }
+    benchmark::DoNotOptimize(bounds);
+  });
+
+  const AxisAlignedBox query(-2, -2, 0, 2, 2, 5);
+  const AxisAlignedBoxf queryf(-2, -2, 0, 2, 2, 5);
+  benchmark::Run("AxisAlignedBox_Intersects_x10000", 100, [&]()
+  {
+    for (std::size_t i = 0; i < boxes.size(); ++i)
+      inside[i] = query.Intersects(boxes[i]);
+    benchmark::DoNotOptimize(inside);
+  });
+
+  benchmark::Run("AxisAlignedBoxf_Intersects_x10000", 100, [&]()
+  {
+    for (std::size_t i = 0; i < boxesf.size(); ++i)
+      inside[i] = queryf.Intersects(boxesf[i]);
+    benchmark::DoNotOptimize(inside);
+  });
+
+  benchmark::Run("AxisAlignedBoxf_ContainsArray_x10000", 100, [&]()
+  {
+    queryf.Contains(pointsf.data(), inside.data(), pointsf.size());
+    benchmark::DoNotOptimize(inside);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, PlaneArray)
+{
+  // A lidar scan scored against RANSAC candidate ground planes
+  std::vector<Vector3f> points;
+  for (int i = 0; i < 100000; ++i)
+  {
+    const float r = 2.0f + (i % 1000) * 0.05f;
+    const float a = (i / 1000) * 0.0628f;
+    points.emplace_back(r * std::cos(a), r * std::sin(a),
+                        (i % 7 == 0) ? 1.5f : 0.01f * (i % 5) - 0.02f);
+  }
+  const Vector3Arrayf array(points);
+  std::vector<Planef> planes;
+  for (int i = 0; i < 16; ++i)
+  {
+    Vector3f normal(0.01f * i, -0.005f * i, 1.0f);
+    normal.Normalize();
+    planes.emplace_back(normal, 0.002f * i);
+  }
+  std::vector<std::size_t> counts(planes.size());
+  std::vector<float> dist(points.size());
+
+  benchmark::Run("Plane_Distance_x100000", 50, [&]()
+  {
+    for (std::size_t i = 0; i < points.size(); ++i)
+      dist[i] = planes[0].Distance(points[i]);
+    benchmark::DoNotOptimize(dist);
+  });
+
+  benchmark::Run("Plane_DistanceArray_x100000", 50, [&]()
+  {
+    planes[0].Distance(points.data(), dist.data(), points.size());
+    benchmark::DoNotOptimize(dist);
+  });
+
+  benchmark::Run("Plane_DistanceSoa_x100000", 50, [&]()
+  {
+    planes[0].Distance(array.X(), array.Y(), array.Z(), dist.data(),
+                       array.Size());
+    benchmark::DoNotOptimize(dist);
+  });
+
+  benchmark::Run("Plane_Inliers_16x100000", 10, [&]()
+  {
+    for (std::size_t p = 0; p < planes.size(); ++p)
+    {
+      counts[p] = 0;
+      for (const Vector3f &point : points)
+      {
+        if (std::abs(planes[p].Distance(point)) <= 0.05f)
+          ++counts[p];
+      }
+    }
+    benchmark::DoNotOptimize(counts);
+  });
+
+  benchmark::Run("Plane_CountInliers_16x100000", 10, [&]()
+  {
+    Planef::CountInliers(planes.data(), planes.size(), points.data(),
+                         points.size(), 0.05f, counts.data());
+    benchmark::DoNotOptimize(counts);
+  });
+
+  benchmark::Run("Plane_CountInliersSoa_16x100000", 10, [&]()
+  {
+    Planef::CountInliers(planes.data(), planes.size(), array.X(), array.Y(),
+                         array.Z(), array.Size(), 0.05f, counts.data());
+    benchmark::DoNotOptimize(counts);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, KdTree)
+{
+  Rand::Seed(1);
+  std::vector<Vector3d> points;
+  for (int i = 0; i < 100000; ++i)
+  {
+    points.emplace_back(Rand::DblUniform(-50, 50), Rand::DblUniform(-50, 50),
+                        Rand::DblUniform(-5, 5));
+  }
+  std::vector<Vector3d> queries;
+  for (int i = 0; i < 10000; ++i)
+  {
+    queries.emplace_back(Rand::DblUniform(-50, 50),
+                         Rand::DblUniform(-50, 50), Rand::DblUniform(-5, 5));
+  }
+
+  KdTreed tree;
+  benchmark::Run("KdTree_Build_x100000", 10, [&]()
+  {
+    tree.Build(points);
+    benchmark::DoNotOptimize(tree);
+  });
+
+  std::vector<std::size_t> ids(queries.size() * 8);
+  std::vector<double> distances(queries.size() * 8);
+  benchmark::Run("LinearScan_Nearest_1000", 5, [&]()
+  {
+    for (std::size_t q = 0; q < 1000; ++q)
+    {
+      double best = HUGE_VAL;
+      for (std::size_t i = 0; i < points.size(); ++i)
+      {
+        const double d = (queries[q] - points[i]).SquaredLength();
+        if (d < best)
+        {
+          best = d;
+          ids[q] = i;
+        }
+      }
+    }
+    benchmark::DoNotOptimize(ids);
+  });
+
+  benchmark::Run("KdTree_Nearest_x10000", 20, [&]()
+  {
+    tree.NearestBatch(queries.data(), queries.size(), 1, ids.data(),
+                      distances.data());
+    benchmark::DoNotOptimize(ids);
+  });
+
+  benchmark::Run("KdTree_Nearest8_x10000", 20, [&]()
+  {
+    tree.NearestBatch(queries.data(), queries.size(), 8, ids.data(),
+                      distances.data());
+    benchmark::DoNotOptimize(ids);
+  });
+
+  std::vector<std::size_t> within;
+  benchmark::Run("KdTree_WithinDistance_x10000", 20, [&]()
+  {
+    std::size_t total = 0;
+    for (const Vector3d &q : queries)
+    {
+      tree.WithinDistance(q, 2.0, within);
+      total += within.size();
+    }
+    benchmark::DoNotOptimize(total);
+  });
+
+  std::vector<Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  benchmark::Run("Kmeans_Cluster_k256_x100000", 2, [&]()
+  {
+    Rand::Seed(2);
+    Kmeans kmeans(points);
+    kmeans.Cluster(256, centroids, labels);
+    benchmark::DoNotOptimize(centroids);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, SparseOctree)
+{
+  // Voxel grid downsampling of a scan of a room, hand rolled with a hash
+  // map and with the octree
+  Rand::Seed(3);
+  std::vector<Vector3f> scan;
+  for (int i = 0; i < 200000; ++i)
+  {
+    const float a = static_cast<float>(Rand::DblUniform(0, 2 * GZ_PI));
+    const float z = static_cast<float>(Rand::DblUniform(0, 3));
+    const float r = 5.0f + static_cast<float>(Rand::DblNormal(0, 0.01));
+    scan.emplace_back(r * std::cos(a), r * std::sin(a), z);
+  }
+  const float size = 0.05f;
+  std::vector<Vector3f> centroids;
+
+  benchmark::Run("HashMap_Downsample_x200000", 10, [&]()
+  {
+    std::unordered_map<Vector3i, std::pair<Vector3f, int>> cells;
+    for (const Vector3f &p : scan)
+    {
+      auto &cell = cells[Vector3i(static_cast<int>(std::floor(p.X() / size)),
+          static_cast<int>(std::floor(p.Y() / size)),
+          static_cast<int>(std::floor(p.Z() / size)))];
+      cell.first += p;
+      cell.second++;
+    }
+    centroids.clear();
+    for (const auto &[cell, sum] : cells)
+      centroids.push_back(sum.first / static_cast<float>(sum.second));
+    benchmark::DoNotOptimize(centroids);
+  });
+
+  SparseOctree<float> octree(size);
+  benchmark::Run("SparseOctree_Downsample_x200000", 10, [&]()
+  {
+    octree.Clear();
+    octree.Insert(scan.data(), scan.size());
+    octree.Centroids(centroids);
+    benchmark::DoNotOptimize(centroids);
+  });
+
+  benchmark::Run("SparseOctree_InsertEach_x200000", 10, [&]()
+  {
+    octree.Clear();
+    for (const Vector3f &p : scan)
+      octree.Insert(p);
+    benchmark::DoNotOptimize(octree);
+  });
+
+  std::size_t occupied = 0;
+  benchmark::Run("SparseOctree_Occupied_x200000", 10, [&]()
+  {
+    for (const Vector3f &p : scan)
+      occupied += octree.Occupied(p + Vector3f(0.02f, 0, 0));
+    benchmark::DoNotOptimize(occupied);
+  });
+
+  std::vector<std::size_t> voxels;
+  benchmark::Run("SparseOctree_Intersects_x1000", 10, [&]()
+  {
+    std::size_t total = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+      const double a = i * 0.00628;
+      const Vector3d c(5 * std::cos(a), 5 * std::sin(a), 1.5);
+      octree.Intersects(AxisAlignedBox(c - Vector3d(0.3, 0.3, 0.3),
+                                       c + Vector3d(0.3, 0.3, 0.3)), voxels);
+      total += voxels.size();
+    }
+    benchmark::DoNotOptimize(total);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, SweepAndPrune)
+{
+  // Boxes that all move a little every step
+  Rand::Seed(6);
+  const std::size_t count = 5000;
+  std::vector<Vector3d> positions;
+  std::vector<Vector3d> velocities;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    positions.emplace_back(Rand::DblUniform(-50, 50),
+                           Rand::DblUniform(-50, 50), Rand::DblUniform(0, 5));
+    velocities.emplace_back(Rand::DblUniform(-0.1, 0.1),
+                            Rand::DblUniform(-0.1, 0.1), 0);
+  }
+  const Vector3d half(0.5, 0.5, 0.5);
+  std::vector<Vector3d> mins(count);
+  std::vector<Vector3d> maxs(count);
+  std::vector<AxisAlignedBox> boxes(count);
+  auto step = [&]()
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      positions[i] += velocities[i];
+      mins[i] = positions[i] - half;
+      maxs[i] = positions[i] + half;
+    }
+  };
+  std::vector<std::pair<std::size_t, std::size_t>> pairs;
+
+  benchmark::Run("AllPairs_Intersects_x5000", 5, [&]()
+  {
+    step();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      boxes[i].Min() = mins[i];
+      boxes[i].Max() = maxs[i];
+    }
+    pairs.clear();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      for (std::size_t j = i + 1; j < count; ++j)
+      {
+        if (boxes[i].Intersects(boxes[j]))
+          pairs.emplace_back(i, j);
+      }
+    }
+    benchmark::DoNotOptimize(pairs);
+  });
+
+  AxisAlignedBoxTree tree;
+  std::vector<std::size_t> hits;
+  benchmark::Run("AxisAlignedBoxTree_Rebuild_x5000", 20, [&]()
+  {
+    step();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      boxes[i].Min() = mins[i];
+      boxes[i].Max() = maxs[i];
+    }
+    tree.Build(boxes);
+    pairs.clear();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      tree.Intersects(boxes[i], hits);
+      for (const std::size_t j : hits)
+      {
+        if (i < j)
+          pairs.emplace_back(i, j);
+      }
+    }
+    benchmark::DoNotOptimize(pairs);
+  });
+
+  SweepAndPrune broadphase;
+  benchmark::Run("SweepAndPrune_x5000", 100, [&]()
+  {
+    step();
+    broadphase.Update(mins.data(), maxs.data(), count);
+    broadphase.Pairs(pairs);
+    benchmark::DoNotOptimize(pairs);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, RayPacket)
+{
+  // Lidar like scan from one origin against a box
+  const std::size_t count = 100000;
+  const Vector3d origin(0, 0, 1);
+  std::vector<Vector3d> origins(count, origin);
+  std::vector<Vector3d> dirs;
+  std::vector<Vector3f> originsf(count, Vector3f(0, 0, 1));
+  std::vector<Vector3f> dirsf;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const double yaw = 2 * GZ_PI * i / count;
+    const double pitch = 0.5 * std::sin(0.37 * i);
+    dirs.emplace_back(std::cos(yaw) * std::cos(pitch),
+                      std::sin(yaw) * std::cos(pitch), std::sin(pitch));
+    dirsf.emplace_back(static_cast<float>(dirs.back().X()),
+                       static_cast<float>(dirs.back().Y()),
+                       static_cast<float>(dirs.back().Z()));
+  }
+  const AxisAlignedBox box(Vector3d(2, -1, 0), Vector3d(4, 1, 2));
+  const AxisAlignedBoxd boxd(box.Min(), box.Max());
+  const AxisAlignedBoxf boxf(Vector3f(2, -1, 0), Vector3f(4, 1, 2));
+  std::vector<std::uint8_t> hits(count);
+  std::vector<double> distances(count);
+  std::vector<float> distancesf(count);
+
+  benchmark::Run("AxisAlignedBox_IntersectDist_x100000", 20, [&]()
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      bool hit;
+      std::tie(hit, distances[i]) =
+        box.IntersectDist(origins[i], dirs[i], 0.1, 100);
+      hits[i] = hit;
+    }
+    benchmark::DoNotOptimize(hits);
+    benchmark::DoNotOptimize(distances);
+  });
+
+  RayPacketd rays;
+  benchmark::Run("RayPacketd_Assign_x100000", 50, [&]()
+  {
+    rays.Assign(origins.data(), dirs.data(), count, 0.1, 100);
+    benchmark::DoNotOptimize(rays);
+  });
+
+  benchmark::Run("RayPacketd_Intersect_x100000", 200, [&]()
+  {
+    benchmark::DoNotOptimize(
+        rays.Intersect(boxd, hits.data(), distances.data()));
+  });
+
+  RayPacketf raysf;
+  raysf.Assign(originsf.data(), dirsf.data(), count, 0.1f, 100);
+  benchmark::Run("RayPacketf_Intersect_x100000", 200, [&]()
+  {
+    benchmark::DoNotOptimize(
+        raysf.Intersect(boxf, hits.data(), distancesf.data()));
+  });
+
+  // One ray against many boxes, as in a leaf of a bounding volume hierarchy
+  Rand::Seed(7);
+  std::vector<AxisAlignedBoxd> boxes;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const Vector3d center(Rand::DblUniform(-50, 50),
+                          Rand::DblUniform(-50, 50), Rand::DblUniform(0, 5));
+    boxes.emplace_back(center - Vector3d::One, center + Vector3d::One);
+  }
+  benchmark::Run("RayPacketd_IntersectBoxes_x100000", 200, [&]()
+  {
+    benchmark::DoNotOptimize(rays.Intersect(0, boxes.data(), boxes.size(),
+                                            hits.data(), distances.data()));
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, FrustumUpdate)
+{
+  // A sensor that moves every frame
+  std::vector<Pose3d> poses;
+  for (int i = 0; i < 1000; ++i)
+    poses.emplace_back(0.01 * i, 0.02 * i, 1, 0, 0.001 * i, 0.003 * i);
+  Frustum frustum(0.1, 50, Angle(GZ_DTOR(60)), 4.0 / 3.0);
+
+  benchmark::Run("Frustum_SetPose_x1000", 500, [&]()
+  {
+    for (const Pose3d &pose : poses)
+      frustum.SetPose(pose);
+    benchmark::DoNotOptimize(frustum);
+  });
+
+  benchmark::Run("Frustum_setters_x1000", 200, [&]()
+  {
+    for (const Pose3d &pose : poses)
+    {
+      frustum.SetNear(0.1);
+      frustum.SetFar(50);
+      frustum.SetFOV(Angle(GZ_DTOR(60)));
+      frustum.SetAspectRatio(4.0 / 3.0);
+      frustum.SetPose(pose);
+    }
+    benchmark::DoNotOptimize(frustum);
+  });
+
+  benchmark::Run("Frustum_Set_x1000", 500, [&]()
+  {
+    for (const Pose3d &pose : poses)
+      frustum.Set(0.1, 50, Angle(GZ_DTOR(60)), 4.0 / 3.0, pose);
+    benchmark::DoNotOptimize(frustum);
+  });
+
+  const Matrix4d projection(
+      1.3, 0, 0, 0,
+      0, 1.7, 0, 0,
+      0, 0, -1.004, -0.2004,
+      0, 0, -1, 0);
+  benchmark::Run("Frustum_Set_projection_view_x1000", 200, [&]()
+  {
+    for (const Pose3d &pose : poses)
+      frustum.Set(projection * Matrix4d(pose).Inverse());
+    benchmark::DoNotOptimize(frustum);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, Line2Array)
+{
+  // Lane boundaries: short segments along random polylines
+  Rand::Seed(4);
+  std::vector<Line2d> edges;
+  for (int lane = 0; lane < 200; ++lane)
+  {
+    Vector2d point(Rand::DblUniform(-500, 500), Rand::DblUniform(-500, 500));
+    double heading = Rand::DblUniform(-GZ_PI, GZ_PI);
+    for (int i = 0; i < 100; ++i)
+    {
+      heading += Rand::DblUniform(-0.1, 0.1);
+      const Vector2d next =
+        point + Vector2d(std::cos(heading), std::sin(heading)) * 2.0;
+      edges.emplace_back(point, next);
+      point = next;
+    }
+  }
+  const std::size_t count = edges.size();
+  std::vector<std::pair<std::size_t, std::size_t>> bruteForce;
+
+  benchmark::Run("Line2_Intersect_all_pairs_x20000", 1, [&]()
+  {
+    bruteForce.clear();
+    Vector2d point;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      for (std::size_t j = i + 2; j < count; ++j)
+      {
+        if (edges[i].Intersect(edges[j], point))
+          bruteForce.emplace_back(i, j);
+      }
+    }
+    benchmark::DoNotOptimize(bruteForce);
+  });
+
+  Line2Arrayd lines(edges);
+  std::vector<Line2Arrayd::Pair> pairs;
+  benchmark::Run("Line2Array_Intersections_x20000", 50, [&]()
+  {
+    lines.Intersections(pairs, 2);
+    benchmark::DoNotOptimize(pairs);
+  });
+
+  benchmark::Run("Line2Array_Intersections_4_threads_x20000", 50, [&]()
+  {
+    lines.Intersections(pairs, 2, 4);
+    benchmark::DoNotOptimize(pairs);
+  });
+  EXPECT_EQ(bruteForce.size(), pairs.size());
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, PreparedTriangle)
+{
+  // Locate query points in a navigation mesh triangle
+  Rand::Seed(5);
+  const std::size_t count = 100000;
+  std::vector<Vector2d> points;
+  std::vector<Vector3d> points3;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    points.emplace_back(Rand::DblUniform(-1, 5), Rand::DblUniform(-1, 5));
+    points3.emplace_back(points.back().X(), points.back().Y(), 0);
+  }
+  const Triangled triangle(Vector2d(0, 0), Vector2d(4, 1), Vector2d(1, 4));
+  const Triangle3d triangle3(Vector3d(0, 0, 0), Vector3d(4, 1, 0),
+                             Vector3d(1, 4, 0));
+
+  std::size_t expected = 0;
+  benchmark::Run("Triangle_Contains_x100000", 20, [&]()
+  {
+    expected = 0;
+    for (const Vector2d &point : points)
+      expected += triangle.Contains(point);
+    benchmark::DoNotOptimize(expected);
+  });
+
+  const PreparedTriangled prepared(triangle);
+  std::vector<std::uint8_t> results(count);
+  std::size_t inside = 0;
+  benchmark::Run("PreparedTriangle_Contains_x100000", 20, [&]()
+  {
+    inside = prepared.Contains(points.data(), results.data(), count);
+    benchmark::DoNotOptimize(results);
+  });
+  EXPECT_EQ(expected, inside);
+
+  std::vector<Vector3d> weights(count);
+  benchmark::Run("PreparedTriangle_Barycentric_x100000", 20, [&]()
+  {
+    prepared.Barycentric(points.data(), weights.data(), count);
+    benchmark::DoNotOptimize(weights);
+  });
+
+  std::size_t expected3 = 0;
+  benchmark::Run("Triangle3_Contains_x100000", 20, [&]()
+  {
+    expected3 = 0;
+    for (const Vector3d &point : points3)
+      expected3 += triangle3.Contains(point);
+    benchmark::DoNotOptimize(expected3);
+  });
+
+  const PreparedTriangle3d prepared3(triangle3);
+  benchmark::Run("PreparedTriangle3_Contains_x100000", 20, [&]()
+  {
+    inside = prepared3.Contains(points3.data(), results.data(), count);
+    benchmark::DoNotOptimize(results);
+  });
+  EXPECT_EQ(expected3, inside);
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, PointCloudFilter)
+{
+  // A noisy scan of a room
+  Rand::Seed(6);
+  const std::size_t count = 1000000;
+  std::vector<Vector3f> cloud;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    Vector3f point(static_cast<float>(Rand::DblUniform(-10, 10)),
+                   static_cast<float>(Rand::DblUniform(-10, 10)),
+                   static_cast<float>(Rand::DblUniform(0, 3)));
+    point[i % 3] = i % 3 == 2 ? 0.0f : 10.0f;
+    point += Vector3f(static_cast<float>(Rand::DblNormal(0, 0.01)),
+                      static_cast<float>(Rand::DblNormal(0, 0.01)),
+                      static_cast<float>(Rand::DblNormal(0, 0.01)));
+    cloud.push_back(point);
+  }
+
+  std::vector<Vector3f> centroids;
+  benchmark::Run("SparseOctree_Centroids_x1000000", 5, [&]()
+  {
+    SparseOctree<float> octree(0.05f);
+    octree.Insert(cloud.data(), cloud.size());
+    octree.Centroids(centroids);
+    benchmark::DoNotOptimize(centroids);
+  });
+
+  std::vector<Vector3f> output(count);
+  std::size_t voxels = 0;
+  benchmark::Run("voxelDownsample_x1000000", 5, [&]()
+  {
+    voxels = voxelDownsample(cloud.data(), count, 0.05f, output.data());
+    benchmark::DoNotOptimize(output);
+  });
+  EXPECT_EQ(centroids.size(), voxels);
+
+  benchmark::Run("voxelDownsample_4_threads_x1000000", 5, [&]()
+  {
+    voxels = voxelDownsample(cloud.data(), count, 0.05f, output.data(), 4);
+    benchmark::DoNotOptimize(output);
+  });
+
+  const std::vector<Vector3f> downsampled(output.begin(),
+                                          output.begin() + voxels);
+  std::vector<Vector3f> filtered(voxels);
+  benchmark::Run("radiusOutlierFilter_downsampled", 5, [&]()
+  {
+    benchmark::DoNotOptimize(radiusOutlierFilter(downsampled.data(),
+        voxels, 0.1f, 4, filtered.data()));
+  });
+
+  benchmark::Run("statisticalOutlierFilter_downsampled", 5, [&]()
+  {
+    benchmark::DoNotOptimize(statisticalOutlierFilter(downsampled.data(),
+        voxels, 8, 1.0f, filtered.data()));
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, CapsuleArray)
+{
+  // Pairs of rope links and crowd agents found by a broadphase
+  Rand::Seed(8);
+  const std::size_t count = 2000;
+  CapsuleArrayd capsules;
+  SphereArrayd spheres;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const Vector3d center(Rand::DblUniform(-10, 10),
+                          Rand::DblUniform(-10, 10),
+                          Rand::DblUniform(-10, 10));
+    capsules.Add(center, Vector3d(Rand::DblUniform(-1, 1),
+                                  Rand::DblUniform(-1, 1),
+                                  Rand::DblUniform(-1, 1)), 0.2);
+    spheres.Add(center, 0.2);
+  }
+  std::vector<std::size_t> first;
+  std::vector<std::size_t> second;
+  for (std::size_t k = 0; k < 10000; ++k)
+  {
+    first.push_back(static_cast<std::size_t>(Rand::IntUniform(0, count - 1)));
+    second.push_back(static_cast<std::size_t>(Rand::IntUniform(0, count - 1)));
+  }
+  const std::size_t pairs = first.size();
+  std::vector<double> expected(pairs);
+  std::vector<double> distances(pairs);
+  std::vector<Vector3d> normals(pairs);
+
+  benchmark::Run("CapsuleArray_Distance_scalar_x10000", 200, [&]()
+  {
+    for (std::size_t k = 0; k < pairs; ++k)
+    {
+      const std::size_t i = first[k];
+      const std::size_t j = second[k];
+      expected[k] = CapsuleArrayd::Distance(
+          capsules.Center(i), capsules.Axis(i), capsules.Radius(i),
+          capsules.Center(j), capsules.Axis(j), capsules.Radius(j));
+    }
+    benchmark::DoNotOptimize(expected);
+  });
+
+  benchmark::Run("CapsuleArray_Distances_x10000", 200, [&]()
+  {
+    capsules.Distances(first.data(), second.data(), pairs, distances.data());
+    benchmark::DoNotOptimize(distances);
+  });
+  for (std::size_t k = 0; k < pairs; ++k)
+    EXPECT_NEAR(expected[k], distances[k], 1e-9);
+
+  benchmark::Run("CapsuleArray_Distances_normals_x10000", 200, [&]()
+  {
+    capsules.Distances(first.data(), second.data(), pairs, distances.data(),
+                       normals.data());
+    benchmark::DoNotOptimize(normals);
+  });
+
+  benchmark::Run("CapsuleArray_point_Distances_x2000", 2000, [&]()
+  {
+    capsules.Distances(Vector3d(1, 2, 3), distances.data());
+    benchmark::DoNotOptimize(distances);
+  });
+
+  benchmark::Run("SphereArray_Distances_normals_x10000", 200, [&]()
+  {
+    spheres.Distances(first.data(), second.data(), pairs, distances.data(),
+                      normals.data());
+    benchmark::DoNotOptimize(normals);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, ConvexHull3)
+{
+  // A scanned part: points in a rotated box, and a dense sphere mesh whose
+  // points are nearly all hull vertices
+  Rand::Seed(5);
+  const Quaterniond rot(0.3, -0.5, 0.9);
+  std::vector<Vector3d> part;
+  for (int i = 0; i < 1000000; ++i)
+  {
+    part.push_back(rot.RotateVector(Vector3d(Rand::DblUniform(-2, 2),
+                                             Rand::DblUniform(-0.5, 0.5),
+                                             Rand::DblUniform(-0.3, 0.3))));
+  }
+  std::vector<Vector3d> sphere;
+  for (int i = 0; i < 20000; ++i)
+  {
+    sphere.push_back(Vector3d(Rand::DblNormal(0, 1), Rand::DblNormal(0, 1),
+                              Rand::DblNormal(0, 1)).Normalized());
+  }
+
+  ConvexHull3d hull;
+  benchmark::Run("ConvexHull3_Build_1M_points", 5, [&]()
+  {
+    hull.Build(part.data(), part.size());
+    benchmark::DoNotOptimize(hull);
+  });
+  benchmark::Run("ConvexHull3_Build_1M_points_threads", 5, [&]()
+  {
+    hull.Build(part.data(), part.size(), 0);
+    benchmark::DoNotOptimize(hull);
+  });
+
+  Vector3d min = part[0];
+  Vector3d max = part[0];
+  for (const Vector3d &p : part)
+  {
+    min.Min(p);
+    max.Max(p);
+  }
+  const Vector3d extent = max - min;
+  OrientedBoxd box;
+  benchmark::Run("ConvexHull3_MinimumVolumeBox", 5, [&]()
+  {
+    box = hull.MinimumVolumeBox();
+    benchmark::DoNotOptimize(box);
+  });
+  benchmark::Run("ConvexHull3_MinimumVolumeBox_64", 5, [&]()
+  {
+    box = hull.MinimumVolumeBox(64);
+    benchmark::DoNotOptimize(box);
+  });
+  // The points fill 2.4 of a 28.5 axis aligned box
+  EXPECT_LT(box.Volume(), 2.5);
+  EXPECT_GT(extent.X() * extent.Y() * extent.Z(), 10 * box.Volume());
+
+  benchmark::Run("ConvexHull3_Build_sphere_20k", 5, [&]()
+  {
+    hull.Build(sphere.data(), sphere.size());
+    benchmark::DoNotOptimize(hull);
+  });
+  EXPECT_EQ(sphere.size(), hull.Vertices().size());
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, InlineValueTypes)
+{
+  // Per-pixel temperatures of a thermal image, copied each frame
+  const std::size_t pixels = 100000;
+  std::vector<Temperature> image(pixels, Temperature(300));
+  std::vector<Temperaturef> imagef(pixels, Temperaturef(300));
+  benchmark::Run("Temperature_copy_x100000", 50, [&]()
+  {
+    std::vector<Temperature> copy(image);
+    benchmark::DoNotOptimize(copy);
+  });
+  benchmark::Run("Temperaturef_copy_x100000", 50, [&]()
+  {
+    std::vector<Temperaturef> copy(imagef);
+    benchmark::DoNotOptimize(copy);
+  });
+
+  // Per-joint controllers, copied and updated
+  const std::size_t joints = 1000;
+  const std::chrono::duration<double> dt(0.001);
+  std::vector<PID> pids(joints, PID(100, 1, 10, 5, -5, 50, -50));
+  std::vector<PIDd> pidsd(joints, PIDd(100, 1, 10, 5, -5, 50, -50));
+  double sum = 0;
+  benchmark::Run("PID_copy_update_x1000", 500, [&]()
+  {
+    std::vector<PID> copy(pids);
+    for (std::size_t j = 0; j < joints; ++j)
+      sum += copy[j].Update(0.01 * static_cast<double>(j % 7), dt);
+    benchmark::DoNotOptimize(sum);
+  });
+  benchmark::Run("PIDd_copy_update_x1000", 500, [&]()
+  {
+    std::vector<PIDd> copy(pidsd);
+    for (std::size_t j = 0; j < joints; ++j)
+      sum += copy[j].Update(0.01 * static_cast<double>(j % 7), dt);
+    benchmark::DoNotOptimize(sum);
+  });
+
+  // Per-voxel materials
+  std::vector<Material> materials(pixels, Material(MaterialType::WOOD));
+  std::vector<Materialf> materialsf(pixels, Materialf(MaterialType::WOOD));
+  benchmark::Run("Material_copy_x100000", 20, [&]()
+  {
+    std::vector<Material> copy(materials);
+    benchmark::DoNotOptimize(copy);
+  });
+  benchmark::Run("Materialf_copy_x100000", 20, [&]()
+  {
+    std::vector<Materialf> copy(materialsf);
+    benchmark::DoNotOptimize(copy);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, MemoryResourceQueries)
+{
+  // Build a 30x30 grid graph.
+  const int side = 30;
+  graph::UndirectedGraph<int, double> g;
+  for (int i = 0; i < side * side; ++i)
+    g.AddVertex(std::to_string(i), i, i);
+  for (int row = 0; row < side; ++row)
+  {
+    for (int col = 0; col < side; ++col)
+    {
+      const graph::VertexId id = row * side + col;
+      if (col + 1 < side)
+        g.AddEdge({id, id + 1}, 0.0, 1.0 + (id % 3));
+      if (row + 1 < side)
+        g.AddEdge({id, id + side}, 0.0, 1.0 + (id % 5));
+    }
+  }
+  const graph::CsrGraph frozen = graph::Freeze(g);
+
+  // A per-frame arena, released after each query
+  std::vector<std::byte> buffer(1 << 20);
+  std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+
+  benchmark::Run("Dijkstra_grid_30x30", 20, [&]()
+  {
+    auto result = graph::Dijkstra(g, 0);
+    benchmark::DoNotOptimize(result);
+  });
+  benchmark::Run("Dijkstra_arena_grid_30x30", 20, [&]()
+  {
+    {
+      auto result = graph::Dijkstra(g, 0, graph::kNullId, &arena);
+      benchmark::DoNotOptimize(result);
+    }
+    arena.release();
+  });
+
+  benchmark::Run("Dijkstra_csr_grid_30x30", 200, [&]()
+  {
+    auto result = graph::Dijkstra(frozen, 0);
+    benchmark::DoNotOptimize(result);
+  });
+  benchmark::Run("Dijkstra_csr_arena_grid_30x30", 200, [&]()
+  {
+    {
+      auto result = graph::Dijkstra(frozen, 0, graph::kNullId, &arena);
+      benchmark::DoNotOptimize(result);
+    }
+    arena.release();
+  });
+
+  benchmark::Run("BreadthFirstSort_grid_30x30", 20, [&]()
+  {
+    auto result = graph::BreadthFirstSort(g, 0);
+    benchmark::DoNotOptimize(result);
+  });
+  benchmark::Run("BreadthFirstSort_arena_grid_30x30", 20, [&]()
+  {
+    {
+      auto result = graph::BreadthFirstSort(g, 0, &arena);
+      benchmark::DoNotOptimize(result);
+    }
+    arena.release();
+  });
+
+  benchmark::Run("BreadthFirstSort_csr_grid_30x30", 200, [&]()
+  {
+    auto result = graph::BreadthFirstSort(frozen, 0);
+    benchmark::DoNotOptimize(result);
+  });
+  benchmark::Run("BreadthFirstSort_csr_arena_grid_30x30", 200, [&]()
+  {
+    {
+      auto result = graph::BreadthFirstSort(frozen, 0, 1, &arena);
+      benchmark::DoNotOptimize(result);
+    }
+    arena.release();
+  });
+
+  // Plane cuts of a box, as done for buoyancy every step
+  const Boxd box(2, 3, 4);
+  std::vector<Planed> planes;
+  for (int i = 0; i < 1000; ++i)
+  {
+    planes.emplace_back(Vector3d(std::sin(i * 0.1), std::cos(i * 0.3), 1),
+                        std::sin(i * 0.7));
+  }
+  benchmark::Run("Box_Intersections_set_x1000", 100, [&]()
+  {
+    std::size_t count = 0;
+    for (const auto &plane : planes)
+      count += box.Intersections(plane).size();
+    benchmark::DoNotOptimize(count);
+  });
+  benchmark::Run("Box_Intersections_array_x1000", 100, [&]()
+  {
+    Vector3d points[Boxd::kMaxIntersections];
+    std::size_t count = 0;
+    for (const auto &plane : planes)
+      count += box.Intersections(plane, points);
+    benchmark::DoNotOptimize(count);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, BulkLoading)
+{
+  // A trajectory loaded in batches of 100 points
+  const std::size_t count = 20000;
+  const std::size_t batch = 100;
+  std::vector<Vector3d> points;
+  std::vector<Quaterniond> rotations;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const double t = static_cast<double>(i) * 0.01;
+    points.push_back(Vector3d(std::cos(t), std::sin(t), t));
+    rotations.push_back(Quaterniond(0, 0, t));
+  }
+
+  benchmark::Run("Spline_AddPoint_x20000", 5, [&]()
+  {
+    Spline spline;
+    for (const auto &p : points)
+      spline.AddPoint(p);
+    benchmark::DoNotOptimize(spline);
+  });
+  benchmark::Run("Spline_AddPoints_batches_x20000", 5, [&]()
+  {
+    Spline spline;
+    spline.AutoCalculate(false);
+    spline.Reserve(count);
+    for (std::size_t i = 0; i < count; i += batch)
+      spline.AddPoints(points.data() + i, batch);
+    spline.RecalcTangents();
+    benchmark::DoNotOptimize(spline);
+  });
+
+  benchmark::Run("RotationSpline_AddPoint_x20000", 5, [&]()
+  {
+    RotationSpline spline;
+    for (const auto &q : rotations)
+      spline.AddPoint(q);
+    benchmark::DoNotOptimize(spline);
+  });
+  benchmark::Run("RotationSpline_AddPoints_batches_x20000", 5, [&]()
+  {
+    RotationSpline spline;
+    spline.AutoCalculate(false);
+    spline.Reserve(count);
+    for (std::size_t i = 0; i < count; i += batch)
+      spline.AddPoints(rotations.data() + i, batch);
+    spline.RecalcTangents();
+    benchmark::DoNotOptimize(spline);
+  });
+
+  // Observations handed over to Kmeans
+  const std::vector<Vector3d> cloud(1000000, Vector3d(1, 2, 3));
+  benchmark::Run("Kmeans_Observations_copy_x1000000", 20, [&]()
+  {
+    std::vector<Vector3d> obs(cloud);
+    Kmeans kmeans;
+    kmeans.Observations(obs);
+    benchmark::DoNotOptimize(kmeans);
+  });
+  benchmark::Run("Kmeans_Observations_move_x1000000", 20, [&]()
+  {
+    std::vector<Vector3d> obs(cloud);
+    Kmeans kmeans;
+    kmeans.Observations(std::move(obs));
+    benchmark::DoNotOptimize(kmeans);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, StepSeveralSessions)
+{
+  // 1000 vehicles on one clock, over a field with 1000 time slices
+  InMemoryTimeVaryingVolumetricGridFactory<double, double> factory;
+  for (int t = 0; t < 1000; ++t)
+  {
+    for (double x = 0; x <= 1; x += 1)
+      for (double y = 0; y <= 1; y += 1)
+        for (double z = 0; z <= 1; z += 1)
+          factory.AddPoint(t, Vector3d(x, y, z), t + x);
+  }
+  const auto grid = factory.Build();
+  const std::size_t count = 1000;
+
+  std::vector<InMemorySession<double, double>> sessions(
+    count, grid.CreateSession());
+  double time = 0;
+  benchmark::Run("StepTo_each_x1000", 2000, [&]()
+  {
+    time = std::fmod(time + 0.25, 998.0);
+    if (time < 0.25)
+      std::fill(sessions.begin(), sessions.end(), grid.CreateSession());
+    for (auto &sess : sessions)
+    {
+      auto stepped = grid.StepTo(sess, time);
+      if (stepped)
+        sess = stepped.value();
+    }
+    benchmark::DoNotOptimize(sessions);
+  });
+
+  std::fill(sessions.begin(), sessions.end(), grid.CreateSession());
+  time = 0;
+  benchmark::Run("StepTo_grouped_x1000", 2000, [&]()
+  {
+    time = std::fmod(time + 0.25, 998.0);
+    if (time < 0.25)
+      std::fill(sessions.begin(), sessions.end(), grid.CreateSession());
+    benchmark::DoNotOptimize(grid.StepTo(sessions.data(), count, time));
+    benchmark::DoNotOptimize(sessions);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, BlendCache)
+{
+  // A 32^3 field whose values are given per time slice, queried by a
+  // swarm of points in a few cells many times per time step
+  std::vector<Vector3d> cloud;
+  for (int x = 0; x < 32; ++x)
+    for (int y = 0; y < 32; ++y)
+      for (int z = 0; z < 32; ++z)
+        cloud.emplace_back(x, y, z);
+  const VolumetricGridLookupField<double> index(cloud);
+  TimeVaryingVolumetricGridLookupField<
+    double, double, InMemorySession<double, double>> field;
+  std::vector<std::vector<double>> values;
+  for (int t = 0; t < 4; ++t)
+  {
+    field.AddVolumetricGridField(t, index);
+    values.emplace_back(cloud.size());
+    for (std::size_t i = 0; i < cloud.size(); ++i)
+      values.back()[i] = t + cloud[i].X() * cloud[i].Y();
+  }
+
+  std::vector<Vector3d> queries;
+  for (int i = 0; i < 1000; ++i)
+  {
+    queries.emplace_back(Rand::DblUniform(10, 12), Rand::DblUniform(10, 12),
+                         Rand::DblUniform(10, 12));
+  }
+
+  auto session = field.CreateSession();
+  double time = 0;
+  benchmark::Run("EstimateQuadrilinear_x1000", 200, [&]()
+  {
+    time = std::fmod(time + 0.1, 2.0);
+    if (time < 0.1)
+      session = field.CreateSession();
+    session = field.StepTo(session, time).value();
+    double sum = 0;
+    for (const auto &q : queries)
+      sum += field.EstimateQuadrilinear(session, q, values[0], values[1])
+        .value_or(0);
+    benchmark::DoNotOptimize(sum);
+  });
+
+  InMemoryBlendCache<double, double, double> cache;
+  session = field.CreateSession();
+  time = 0;
+  benchmark::Run("EstimateQuadrilinear_cached_x1000", 200, [&]()
+  {
+    time = std::fmod(time + 0.1, 2.0);
+    if (time < 0.1)
+      session = field.CreateSession();
+    session = field.StepTo(session, time).value();
+    double sum = 0;
+    for (const auto &q : queries)
+      sum += field.EstimateQuadrilinear(session, q, values[0], values[1],
+        cache).value_or(0);
+    benchmark::DoNotOptimize(sum);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, BuildTimeSlices)
+{
+  // 32 time slices of a 32^3 grid, either fixed or moving every slice
+  std::vector<Vector3d> cloud;
+  for (int x = 0; x < 32; ++x)
+    for (int y = 0; y < 32; ++y)
+      for (int z = 0; z < 32; ++z)
+        cloud.emplace_back(x, y, z);
+  std::vector<double> values(cloud.size());
+  for (std::size_t i = 0; i < values.size(); ++i)
+    values[i] = static_cast<double>(i);
+
+  for (const bool moving : {false, true})
+  {
+    InMemoryTimeVaryingVolumetricGridFactory<double, double> factory;
+    for (int t = 0; t < 32; ++t)
+    {
+      if (moving)
+      {
+        for (auto &pt : cloud)
+          pt.X() += 0.5;
+      }
+      factory.AddSlice(t, cloud.data(), values.data(), cloud.size());
+    }
+
+    const std::string name = moving ? "moving" : "fixed";
+    for (const unsigned int threads : {1u, 0u})
+    {
+      benchmark::Run("Build_" + name + "_grid_threads" +
+        std::to_string(threads), 5, [&]()
+      {
+        benchmark::DoNotOptimize(factory.Build(threads));
+      });
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, PackPoses)
+{
+  Rand::Seed(42);
+  std::vector<Pose3d> poses(10000);
+  for (auto &pose : poses)
+  {
+    pose.Set(Vector3d(Rand::DblUniform(-50, 50), Rand::DblUniform(-50, 50),
+                      Rand::DblUniform(0, 10)),
+             Vector3d(Rand::DblUniform(-3, 3), Rand::DblUniform(-1.5, 1.5),
+                      Rand::DblUniform(-3, 3)));
+  }
+  const Vector3d min(-50, -50, 0);
+  const Vector3d max(50, 50, 10);
+
+  std::vector<Quaterniond> rotations(poses.size());
+  for (std::size_t i = 0; i < poses.size(); ++i)
+    rotations[i] = poses[i].Rot();
+  std::vector<std::uint32_t> codes(rotations.size());
+  benchmark::Run("Quaternion_pack_32_10k", 100, [&]()
+  {
+    Quaterniond::PackSmallestThree32(rotations.data(), codes.data(),
+        rotations.size());
+    benchmark::DoNotOptimize(codes);
+  });
+  benchmark::Run("Quaternion_unpack_32_10k", 100, [&]()
+  {
+    Quaterniond::UnpackSmallestThree32(codes.data(), rotations.data(),
+        codes.size());
+    benchmark::DoNotOptimize(rotations);
+  });
+
+  std::vector<PackedPose3> packed(poses.size());
+  std::vector<Pose3d> unpacked(poses.size());
+  benchmark::Run("Pose3_pack_10k", 100, [&]()
+  {
+    Pose3d::Pack(poses.data(), packed.data(), poses.size(), min, max);
+    benchmark::DoNotOptimize(packed);
+  });
+  benchmark::Run("Pose3_unpack_10k", 100, [&]()
+  {
+    Pose3d::Unpack(packed.data(), unpacked.data(), packed.size(), min, max);
+    benchmark::DoNotOptimize(unpacked);
+  });
+
+  double positionError = 0;
+  double angleError = 0;
+  for (std::size_t i = 0; i < poses.size(); ++i)
+  {
+    positionError = std::max(positionError,
+        poses[i].Pos().Distance(unpacked[i].Pos()));
+    angleError = std::max(angleError, 2 * std::acos(std::min(1.0,
+        std::abs(poses[i].Rot().Dot(unpacked[i].Rot())))));
+  }
+  ::testing::Test::RecordProperty("Pose3_packed_bytes",
+      static_cast<int>(sizeof(PackedPose3)));
+  ::testing::Test::RecordProperty("Pose3_bytes",
+      static_cast<int>(sizeof(Pose3d)));
+  ::testing::Test::RecordProperty("Pose3_max_position_error",
+      std::to_string(positionError));
+  ::testing::Test::RecordProperty("Pose3_max_angle_error",
+      std::to_string(angleError));
+  EXPECT_LT(positionError, 1.5e-3);
+  EXPECT_LT(angleError, 1.5e-4);
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, StatsSnapshot)
+{
+  // Statistics of 100 workers merged by an aggregator
+  Rand::Seed(42);
+  std::vector<double> data(1000);
+  Rand::FillNormal(data.data(), data.size());
+  const std::string names = "max,maxAbs,mean,min,rms,var";
+  std::vector<SignalStats> workers(100);
+  for (auto &worker : workers)
+  {
+    EXPECT_TRUE(worker.InsertStatistics(names));
+    worker.InsertData(data.data(), data.size());
+  }
+
+  benchmark::Run("SignalStats_map_text_100", 100, [&]()
+  {
+    std::ostringstream text;
+    for (const auto &worker : workers)
+    {
+      for (const auto &[name, value] : worker.Map())
+        text << name << ' ' << value << '\n';
+    }
+    benchmark::DoNotOptimize(text.str());
+  });
+
+  std::vector<uint8_t> buffer;
+  std::vector<std::size_t> offsets;
+  benchmark::Run("SignalStats_snapshot_100", 100, [&]()
+  {
+    buffer.clear();
+    offsets.clear();
+    for (const auto &worker : workers)
+    {
+      offsets.push_back(buffer.size());
+      worker.Snapshot(buffer);
+    }
+    benchmark::DoNotOptimize(buffer);
+  });
+  offsets.push_back(buffer.size());
+
+  SignalStats aggregate;
+  EXPECT_TRUE(aggregate.InsertStatistics(names));
+  benchmark::Run("SignalStats_merge_snapshot_100", 100, [&]()
+  {
+    aggregate.Reset();
+    for (std::size_t i = 0; i + 1 < offsets.size(); ++i)
+    {
+      aggregate.MergeSnapshot(buffer.data() + offsets[i],
+          offsets[i + 1] - offsets[i]);
+    }
+    benchmark::DoNotOptimize(aggregate);
+  });
+  EXPECT_EQ(data.size() * workers.size(), aggregate.Count());
+  ::testing::Test::RecordProperty("SignalStats_snapshot_bytes",
+      static_cast<int>(offsets[1]));
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, PiecewiseScalarField3Minimum)
+{
+  // A planner querying a cost lower bound of a field of paraboloids
+  using Field = AdditivelySeparableScalarField3d<Polynomial3d>;
+  std::vector<PiecewiseScalarField3d<Field>::Piece> pieces;
+  for (int i = 0; i < 22; ++i)
+  {
+    for (int j = 0; j < 22; ++j)
+    {
+      for (int k = 0; k < 22; ++k)
+      {
+        const double c = 0.05 * ((i * 7 + j * 3 + k) % 20);
+        pieces.push_back({Region3d(Intervald::LeftClosed(i, i + 1.0),
+            Intervald::LeftClosed(j, j + 1.0),
+            Intervald::LeftClosed(k, k + 1.0)),
+            Field(1.0, Polynomial3d(Vector4d(0, 1, -2 * (i + c), 0)),
+                  Polynomial3d(Vector4d(0, 1, -2 * (j + c), 0)),
+                  Polynomial3d(Vector4d(0, 1, -2 * (k + c), c)))});
+      }
+    }
+  }
+  PiecewiseScalarField3d<Field> field(pieces);
+
+  double uncached = 0;
+  benchmark::Run("PiecewiseScalarField3_minimum_10648_pieces", 20, [&]()
+  {
+    uncached = field.Minimum();
+    benchmark::DoNotOptimize(uncached);
+  });
+  const Region3d region(Intervald::Closed(3.5, 9.5),
+      Intervald::Closed(2.5, 6.5), Intervald::Closed(10.5, 12.5));
+  double uncachedRegion = 0;
+  benchmark::Run("PiecewiseScalarField3_minimum_region", 1000, [&]()
+  {
+    uncachedRegion = field.Minimum(region);
+    benchmark::DoNotOptimize(uncachedRegion);
+  });
+
+  benchmark::Run("PiecewiseScalarField3_cache_minima", 20, [&]()
+  {
+    field.CacheMinima();
+  });
+  benchmark::Run("PiecewiseScalarField3_minimum_cached", 1000, [&]()
+  {
+    benchmark::DoNotOptimize(field.Minimum());
+  });
+  benchmark::Run("PiecewiseScalarField3_minimum_region_cached", 1000, [&]()
+  {
+    benchmark::DoNotOptimize(field.Minimum(region));
+  });
+  EXPECT_DOUBLE_EQ(uncached, field.Minimum());
+  EXPECT_DOUBLE_EQ(uncachedRegion, field.Minimum(region));
+}
+
+/////////////////////////////////////////////////
+TEST(CoreTypesPerformance, MovingWindowFilter)
+{
+  // IMU and pose smoothing, one update and one value per sample
+  Rand::Seed(42);
+  std::vector<Vector3d> accelerations(1024);
+  std::vector<Quaterniond> rotations(accelerations.size());
+  for (std::size_t i = 0; i < accelerations.size(); ++i)
+  {
+    accelerations[i].Set(Rand::DblNormal(0, 0.1), Rand::DblNormal(0, 0.1),
+                         Rand::DblNormal(9.8, 0.1));
+    rotations[i] = Quaterniond(Rand::DblNormal(0, 0.01),
+        Rand::DblNormal(0, 0.01), 0.001 * static_cast<double>(i));
+  }
+
+  MovingWindowFilterVector3d vectorFilter(32);
+  std::size_t i = 0;
+  benchmark::Run("MovingWindowFilter_Vector3d_32", 1000000, [&]()
+  {
+    vectorFilter.Update(accelerations[i++ & 1023]);
+    benchmark::DoNotOptimize(vectorFilter.Value());
+  });
+
+  MovingWindowFilterQuaterniond rotationFilter(32);
+  i = 0;
+  benchmark::Run("MovingWindowFilter_Quaterniond_32", 1000000, [&]()
+  {
+    rotationFilter.Update(rotations[i++ & 1023]);
+    benchmark::DoNotOptimize(rotationFilter.Value());
+  });
+}
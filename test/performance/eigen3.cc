@@ -0,0 +1,390 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <Eigen/Geometry>
+#include <Eigen/StdVector>
+
+#include "gz/math/Matrix3.hh"
+#include "gz/math/Matrix4.hh"
+#include "gz/math/Pose3.hh"
+#include "gz/math/Quaternion.hh"
+#include "gz/math/Rand.hh"
+#include "gz/math/Vector3.hh"
+#include "gz/math/eigen3/Conversions.hh"
+
+#include "Benchmark.hh"
+
+using namespace gz;
+using namespace math;
+
+// Each test times an operation in gz-math and the same operation on the
+// Eigen types of gz/math/eigen3/Conversions.hh, over buffers of kCount
+// elements. "Scalar" kernels call the single element operators in a loop,
+// "batch" kernels use the buffer functions of gz-math and the matrix
+// expressions of Eigen.
+namespace
+{
+  /// \brief Number of elements of the buffers of each kernel.
+  constexpr std::size_t kCount = 1024;
+
+  /// \brief Number of timed iterations of each kernel.
+  constexpr std::size_t kIterations = 2000;
+
+  /// \brief Stored ratio of the gz-math time to the Eigen time of a
+  /// kernel, below 1 when gz-math is faster.
+  struct Baseline
+  {
+    const char *name;
+    double ratio;
+  };
+
+  /// \brief Baselines measured with GCC -O2 on x86-64, without -march.
+  /// Other compilers and CPUs give other ratios, so a kernel only fails
+  /// when GZ_MATH_BENCHMARK_TOLERANCE is set and its ratio exceeds the
+  /// baseline by more than that many percent. To update a baseline, run
+  /// this test with a large GZ_MATH_BENCHMARK_SCALE and copy the printed
+  /// ratios.
+  constexpr Baseline kBaselines[] =
+  {
+    {"Matrix3_multiply", 0.9},
+    {"Matrix3_vector", 0.85},
+    {"Matrix4_multiply", 1.8},
+    {"Matrix4_inverse", 1.8},
+    {"Quaternion_multiply", 1.2},
+    {"Quaternion_rotate_vector", 2.7},
+    {"Quaternion_rotate_vector_batch", 0.7},
+    {"Pose3_multiply", 0.65},
+    {"Pose3_multiply_batch", 0.5},
+    {"Pose3_transform", 3.6},
+    {"Pose3_transform_batch", 0.9},
+  };
+
+  /// \brief Time a kernel in gz-math and Eigen and report the ratio of
+  /// the times with its baseline.
+  /// \param[in] _name Name of the kernel in kBaselines.
+  /// \param[in] _gz The gz-math kernel.
+  /// \param[in] _eigen The Eigen kernel.
+  template<typename G, typename E>
+  void Compare(const std::string &_name, G &&_gz, E &&_eigen)
+  {
+    const Baseline *baseline = nullptr;
+    for (const Baseline &b : kBaselines)
+    {
+      if (_name == b.name)
+        baseline = &b;
+    }
+    ASSERT_NE(nullptr, baseline) << "No baseline for " << _name;
+
+    const double gzNs = benchmark::Run(_name + "_gz", kIterations, _gz);
+    const double eigenNs =
+      benchmark::Run(_name + "_eigen", kIterations, _eigen);
+    EXPECT_TRUE(benchmark::Compare(_name, gzNs, eigenNs, baseline->ratio))
+      << _name << " regressed against Eigen by more than "
+      << benchmark::Tolerance().value_or(0.0) << "%";
+  }
+
+  /// \brief Get random unit quaternions.
+  /// \return kCount quaternions.
+  std::vector<Quaterniond> RandomQuaternions()
+  {
+    std::vector<Quaterniond> result;
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+      result.emplace_back(Rand::DblUniform(-3, 3), Rand::DblUniform(-3, 3),
+                          Rand::DblUniform(-3, 3));
+    }
+    return result;
+  }
+
+  /// \brief Get random vectors.
+  /// \return kCount vectors.
+  std::vector<Vector3d> RandomVectors()
+  {
+    std::vector<Vector3d> result;
+    for (std::size_t i = 0; i < kCount; ++i)
+    {
+      result.emplace_back(Rand::DblUniform(-10, 10),
+                          Rand::DblUniform(-10, 10),
+                          Rand::DblUniform(-10, 10));
+    }
+    return result;
+  }
+
+  /// \brief Get random poses.
+  /// \return kCount poses.
+  std::vector<Pose3d> RandomPoses()
+  {
+    const std::vector<Vector3d> positions = RandomVectors();
+    const std::vector<Quaterniond> rotations = RandomQuaternions();
+    std::vector<Pose3d> result;
+    for (std::size_t i = 0; i < kCount; ++i)
+      result.emplace_back(positions[i], rotations[i]);
+    return result;
+  }
+
+  /// \brief Convert vectors to the columns of an Eigen matrix.
+  /// \param[in] _v Vectors to convert.
+  /// \return Matrix with one column per vector.
+  Eigen::Matrix3Xd Columns(const std::vector<Vector3d> &_v)
+  {
+    Eigen::Matrix3Xd result(3, _v.size());
+    for (std::size_t i = 0; i < _v.size(); ++i)
+      result.col(i) = eigen3::convert(_v[i]);
+    return result;
+  }
+
+  /// \brief Convert a Matrix4d to Eigen.
+  /// \param[in] _m Matrix to convert.
+  /// \return The equivalent Eigen matrix.
+  Eigen::Matrix4d Convert(const Matrix4d &_m)
+  {
+    Eigen::Matrix4d result;
+    for (int i = 0; i < 4; ++i)
+    {
+      for (int j = 0; j < 4; ++j)
+        result(i, j) = _m(i, j);
+    }
+    return result;
+  }
+
+  template<typename T>
+  using EigenVector = std::vector<T, Eigen::aligned_allocator<T>>;
+}
+
+/////////////////////////////////////////////////
+TEST(Eigen3Performance, Matrix3)
+{
+  Rand::Seed(42);
+  const std::vector<Quaterniond> q1 = RandomQuaternions();
+  const std::vector<Quaterniond> q2 = RandomQuaternions();
+  const std::vector<Vector3d> v = RandomVectors();
+  std::vector<Matrix3d> a, b;
+  EigenVector<Eigen::Matrix3d> ea, eb;
+  for (std::size_t i = 0; i < kCount; ++i)
+  {
+    a.emplace_back(q1[i]);
+    b.emplace_back(q2[i]);
+    ea.push_back(eigen3::convert(a.back()));
+    eb.push_back(eigen3::convert(b.back()));
+  }
+  const Eigen::Matrix3Xd ev = Columns(v);
+
+  std::vector<Matrix3d> out(kCount);
+  EigenVector<Eigen::Matrix3d> eout(kCount);
+  Compare("Matrix3_multiply", [&]()
+  {
+    for (std::size_t i = 0; i < kCount; ++i)
+      out[i] = a[i] * b[i];
+    benchmark::DoNotOptimize(out);
+  }, [&]()
+  {
+    for (std::size_t i = 0; i < kCount; ++i)
+      eout[i].noalias() = ea[i] * eb[i];
+    benchmark::DoNotOptimize(eout);
+  });
+
+  std::vector<Vector3d> vout(kCount);
+  Eigen::Matrix3Xd evout(3, kCount);
+  Compare("Matrix3_vector", [&]()
+  {
+    for (std::size_t i = 0; i < kCount; ++i)
+      vout[i] = a[i] * v[i];
+    benchmark::DoNotOptimize(vout);
+  }, [&]()
+  {
+    for (std::size_t i = 0; i < kCount; ++i)
+      evout.col(i).noalias() = ea[i] * ev.col(i);
+    benchmark::DoNotOptimize(evout);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(Eigen3Performance, Matrix4)
+{
+  Rand::Seed(42);
+  const std::vector<Pose3d> p1 = RandomPoses();
+  const std::vector<Pose3d> p2 = RandomPoses();
+  std::vector<Matrix4d> a, b;
+  EigenVector<Eigen::Matrix4d> ea, eb;
+  for (std::size_t i = 0; i < kCount; ++i)
+  {
+    a.emplace_back(p1[i]);
+    b.emplace_back(p2[i]);
+    // A perspective row so that the inverse is a general one
+    a.back()(3, 2) = 0.1;
+    ea.push_back(Convert(a.back()));
+    eb.push_back(Convert(b.back()));
+  }
+
+  std::vector<Matrix4d> out(kCount);
+  EigenVector<Eigen::Matrix4d> eout(kCount);
+  Compare("Matrix4_multiply", [&]()
+  {
+    for (std::size_t i = 0; i < kCount; ++i)
+      out[i] = a[i] * b[i];
+    benchmark::DoNotOptimize(out);
+  }, [&]()
+  {
+    for (std::size_t i = 0; i < kCount; ++i)
+      eout[i].noalias() = ea[i] * eb[i];
+    benchmark::DoNotOptimize(eout);
+  });
+
+  Compare("Matrix4_inverse", [&]()
+  {
+    for (std::size_t i = 0; i < kCount; ++i)
+      out[i] = a[i].Inverse();
+    benchmark::DoNotOptimize(out);
+  }, [&]()
+  {
+    for (std::size_t i = 0; i < kCount; ++i)
+      eout[i] = ea[i].inverse();
+    benchmark::DoNotOptimize(eout);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(Eigen3Performance, Quaternion)
+{
+  Rand::Seed(42);
+  const std::vector<Quaterniond> a = RandomQuaternions();
+  const std::vector<Quaterniond> b = RandomQuaternions();
+  const std::vector<Vector3d> v = RandomVectors();
+  std::vector<Eigen::Quaterniond> ea, eb;
+  for (std::size_t i = 0; i < kCount; ++i)
+  {
+    ea.push_back(eigen3::convert(a[i]));
+    eb.push_back(eigen3::convert(b[i]));
+  }
+  const Eigen::Matrix3Xd ev = Columns(v);
+
+  std::vector<Quaterniond> out(kCount);
+  std::vector<Eigen::Quaterniond> eout(kCount);
+  Compare("Quaternion_multiply", [&]()
+  {
+    for (std::size_t i = 0; i < kCount; ++i)
+      out[i] = a[i] * b[i];
+    benchmark::DoNotOptimize(out);
+  }, [&]()
+  {
+    for (std::size_t i = 0; i < kCount; ++i)
+      eout[i] = ea[i] * eb[i];
+    benchmark::DoNotOptimize(eout);
+  });
+
+  std::vector<Vector3d> vout(kCount);
+  Eigen::Matrix3Xd evout(3, kCount);
+  Compare("Quaternion_rotate_vector", [&]()
+  {
+    for (std::size_t i = 0; i < kCount; ++i)
+      vout[i] = a[i].RotateVector(v[i]);
+    benchmark::DoNotOptimize(vout);
+  }, [&]()
+  {
+    for (std::size_t i = 0; i < kCount; ++i)
+      evout.col(i) = ea[i] * ev.col(i);
+    benchmark::DoNotOptimize(evout);
+  });
+
+  // One rotation applied to a whole buffer
+  Compare("Quaternion_rotate_vector_batch", [&]()
+  {
+    a[0].RotateVector(v.data(), vout.data(), kCount);
+    benchmark::DoNotOptimize(vout);
+  }, [&]()
+  {
+    evout.noalias() = ea[0].toRotationMatrix() * ev;
+    benchmark::DoNotOptimize(evout);
+  });
+}
+
+/////////////////////////////////////////////////
+TEST(Eigen3Performance, Pose3)
+{
+  Rand::Seed(42);
+  const std::vector<Pose3d> a = RandomPoses();
+  const std::vector<Pose3d> b = RandomPoses();
+  const std::vector<Vector3d> v = RandomVectors();
+  EigenVector<Eigen::Isometry3d> ea(kCount), eb(kCount);
+  eigen3::convert(a.data(), ea.data(), kCount);
+  eigen3::convert(b.data(), eb.data(), kCount);
+  const Eigen::Matrix3Xd ev = Columns(v);
+
+  std::vector<Pose3d> out(kCount);
+  EigenVector<Eigen::Isometry3d> eout(kCount);
+  Compare("Pose3_multiply", [&]()
+  {
+    for (std::size_t i = 0; i < kCount; ++i)
+      out[i] = a[i] * b[i];
+    benchmark::DoNotOptimize(out);
+  }, [&]()
+  {
+    for (std::size_t i = 0; i < kCount; ++i)
+      eout[i] = ea[i] * eb[i];
+    benchmark::DoNotOptimize(eout);
+  });
+
+  Compare("Pose3_multiply_batch", [&]()
+  {
+    Pose3d::Multiply(a.data(), b.data(), out.data(), kCount);
+    benchmark::DoNotOptimize(out);
+  }, [&]()
+  {
+    for (std::size_t i = 0; i < kCount; ++i)
+      eout[i] = ea[i] * eb[i];
+    benchmark::DoNotOptimize(eout);
+  });
+
+  std::vector<Vector3d> vout(kCount);
+  Eigen::Matrix3Xd evout(3, kCount);
+  Compare("Pose3_transform", [&]()
+  {
+    for (std::size_t i = 0; i < kCount; ++i)
+      vout[i] = a[i].CoordPositionAdd(v[i]);
+    benchmark::DoNotOptimize(vout);
+  }, [&]()
+  {
+    for (std::size_t i = 0; i < kCount; ++i)
+      evout.col(i) = ea[i] * ev.col(i);
+    benchmark::DoNotOptimize(evout);
+  });
+
+  // One pose applied to a whole buffer
+  Compare("Pose3_transform_batch", [&]()
+  {
+    a[0].CoordPositionAdd(v.data(), vout.data(), kCount);
+    benchmark::DoNotOptimize(vout);
+  }, [&]()
+  {
+    evout.noalias() = ea[0].linear() * ev;
+    evout.colwise() += ea[0].translation();
+    benchmark::DoNotOptimize(evout);
+  });
+
+  // The cost of converting at a module boundary, for reference
+  benchmark::Run("Pose3_convert_to_eigen_x1024", kIterations, [&]()
+  {
+    eigen3::convert(a.data(), eout.data(), kCount);
+    benchmark::DoNotOptimize(eout);
+  });
+}
@@ -0,0 +1,334 @@
+/*
+ * Copyright (C) 2023 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gz/math/Rand.hh"
+#include "gz/math/graph/CsrGraph.hh"
+#include "gz/math/graph/Graph.hh"
+#include "gz/math/graph/GraphAlgorithms.hh"
+
+#include "AllocationCounter.hh"
+#include "Benchmark.hh"
+
+using namespace gz;
+using namespace math;
+
+// Graph benchmarks on synthetic graphs of increasing size. Besides the time
+// per iteration, each benchmark records the number of heap allocations and
+// the peak heap usage of one run, as the properties `<name>_allocations`
+// and `<name>_peak_bytes`.
+//
+// Graphs have 10^3 and 10^4 edges by default. Set the
+// GZ_MATH_BENCHMARK_GRAPH_EDGES environment variable to the largest number
+// of edges to test, up to 10^7, to run the larger sizes too.
+
+namespace
+{
+  /// \brief Get the largest number of edges to benchmark.
+  /// \return The value of GZ_MATH_BENCHMARK_GRAPH_EDGES, 10^4 if unset or
+  /// invalid.
+  std::size_t MaxEdges()
+  {
+    const char *env = std::getenv("GZ_MATH_BENCHMARK_GRAPH_EDGES");
+    const long long value = env ? std::strtoll(env, nullptr, 10) : 0;
+    return value > 0 ? static_cast<std::size_t>(value) : 10000u;
+  }
+
+  /// \brief The graph sizes to benchmark, powers of ten from 10^3 to
+  /// MaxEdges(), at most 10^7.
+  /// \return Target numbers of edges.
+  std::vector<std::size_t> EdgeCounts()
+  {
+    std::vector<std::size_t> counts;
+    const std::size_t maxEdges = std::min<std::size_t>(MaxEdges(), 10000000u);
+    for (std::size_t m = 1000; m <= maxEdges; m *= 10)
+      counts.push_back(m);
+    return counts;
+  }
+
+  /// \brief Vertices and edges of a synthetic graph.
+  struct GraphData
+  {
+    /// \brief Vertices, with Ids from 0.
+    std::vector<graph::Vertex<int>> vertices;
+
+    /// \brief Edges, with positive weights.
+    std::vector<graph::EdgeInitializer<double>> edges;
+  };
+
+  /// \brief Create a 2D grid with 4-connectivity.
+  /// \param[in] _edges Approximate number of edges.
+  /// \return The graph.
+  GraphData Grid(const std::size_t _edges)
+  {
+    const std::size_t side = std::max<std::size_t>(2,
+      static_cast<std::size_t>(std::sqrt(_edges / 2.0)));
+    GraphData data;
+    data.vertices.reserve(side * side);
+    for (std::size_t i = 0; i < side * side; ++i)
+      data.vertices.emplace_back("", 0, i);
+    data.edges.reserve(2 * side * side);
+    for (std::size_t row = 0; row < side; ++row)
+    {
+      for (std::size_t col = 0; col < side; ++col)
+      {
+        const graph::VertexId id = row * side + col;
+        if (col + 1 < side)
+          data.edges.push_back({{id, id + 1}, 0.0, 1.0 + (id % 3)});
+        if (row + 1 < side)
+          data.edges.push_back({{id, id + side}, 0.0, 1.0 + (id % 5)});
+      }
+    }
+    return data;
+  }
+
+  /// \brief Create a random geometric graph: points uniformly distributed
+  /// in the unit square, connected when closer than a radius chosen for an
+  /// average degree of 8. Edge weights are the distances.
+  /// \param[in] _edges Approximate number of edges.
+  /// \return The graph.
+  GraphData RandomGeometric(const std::size_t _edges)
+  {
+    constexpr double kDegree = 8.0;
+    const std::size_t n = std::max<std::size_t>(2,
+      static_cast<std::size_t>(2.0 * _edges / kDegree));
+    const double radius = std::sqrt(kDegree / (GZ_PI * n));
+
+    Rand::Seed(42);
+    std::vector<double> x(n), y(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      x[i] = Rand::DblUniform(0, 1);
+      y[i] = Rand::DblUniform(0, 1);
+    }
+
+    // Bucket the points in cells of the size of the radius, so only the
+    // neighboring cells are searched.
+    const std::size_t cells = std::max<std::size_t>(1,
+      static_cast<std::size_t>(1.0 / radius));
+    auto cellOf = [&](const double _v)
+    {
+      return std::min(cells - 1, static_cast<std::size_t>(_v * cells));
+    };
+    std::vector<std::vector<std::size_t>> buckets(cells * cells);
+    for (std::size_t i = 0; i < n; ++i)
+      buckets[cellOf(y[i]) * cells + cellOf(x[i])].push_back(i);
+
+    GraphData data;
+    data.vertices.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+      data.vertices.emplace_back("", 0, i);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      const std::size_t cx = cellOf(x[i]);
+      const std::size_t cy = cellOf(y[i]);
+      for (std::size_t by = cy > 0 ? cy - 1 : 0;
+           by <= std::min(cells - 1, cy + 1); ++by)
+      {
+        for (std::size_t bx = cx > 0 ? cx - 1 : 0;
+             bx <= std::min(cells - 1, cx + 1); ++bx)
+        {
+          for (const std::size_t j : buckets[by * cells + bx])
+          {
+            const double d = std::hypot(x[i] - x[j], y[i] - y[j]);
+            if (j > i && d < radius)
+              data.edges.push_back({{i, j}, 0.0, d});
+          }
+        }
+      }
+    }
+    return data;
+  }
+
+  /// \brief Create a scale-free graph with the Barabasi-Albert model: each
+  /// new vertex is connected to 4 existing vertices chosen with a
+  /// probability proportional to their degree.
+  /// \param[in] _edges Approximate number of edges.
+  /// \return The graph.
+  GraphData ScaleFree(const std::size_t _edges)
+  {
+    constexpr std::size_t kLinks = 4;
+    const std::size_t n = std::max<std::size_t>(kLinks + 1,
+      _edges / kLinks);
+
+    Rand::Seed(42);
+    GraphData data;
+    data.vertices.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+      data.vertices.emplace_back("", 0, i);
+    data.edges.reserve(n * kLinks);
+
+    // Every edge adds both of its vertices, so picking a uniform entry
+    // picks a vertex proportionally to its degree.
+    std::vector<graph::VertexId> ends;
+    ends.reserve(2 * n * kLinks);
+    for (graph::VertexId i = 0; i <= kLinks; ++i)
+    {
+      for (graph::VertexId j = 0; j < i; ++j)
+      {
+        data.edges.push_back({{j, i}, 0.0, 1.0});
+        ends.push_back(i);
+        ends.push_back(j);
+      }
+    }
+    for (graph::VertexId i = kLinks + 1; i < n; ++i)
+    {
+      const std::size_t existing = ends.size();
+      for (std::size_t k = 0; k < kLinks; ++k)
+      {
+        const graph::VertexId j = ends[static_cast<std::size_t>(
+          Rand::IntUniform(0, static_cast<int>(existing - 1)))];
+        data.edges.push_back({{j, i}, 0.0, 1.0 + (i + j) % 7});
+        ends.push_back(i);
+        ends.push_back(j);
+      }
+    }
+    return data;
+  }
+
+  /// \brief Benchmark a callable: record the heap allocations and the peak
+  /// heap usage of one run, then time it with benchmark::Run.
+  /// \param[in] _name Name of the benchmark.
+  /// \param[in] _iterations Number of timed iterations, before scaling.
+  /// \param[in] _func Callable to benchmark.
+  template<typename F>
+  void Measure(const std::string &_name, const std::size_t _iterations,
+               F &&_func)
+  {
+    const benchmark::HeapUsage usage;
+    _func();
+    const std::uint64_t count = usage.Allocations();
+    const std::size_t peak = usage.PeakBytes();
+
+    ::testing::Test::RecordProperty(_name + "_allocations",
+      std::to_string(count));
+    ::testing::Test::RecordProperty(_name + "_peak_bytes",
+      std::to_string(peak));
+    std::cout << "[ BENCHMARK ] " << _name << ": " << count
+              << " allocations, " << peak << " peak bytes" << std::endl;
+
+    benchmark::Run(_name, _iterations, _func);
+  }
+
+  /// \brief Run the graph benchmarks on one graph.
+  /// \param[in] _name Name of the kind of graph.
+  /// \param[in] _data The graph.
+  void RunGraphBenchmarks(const std::string &_name, const GraphData &_data)
+  {
+    const std::string suffix = "_" + _name + "_" +
+      std::to_string(_data.edges.size());
+
+    // Fewer iterations for larger graphs, at least one.
+    const std::size_t iterations = std::max<std::size_t>(1,
+      20000 / std::max<std::size_t>(1, _data.edges.size()));
+
+    Measure("AddEdge" + suffix, iterations, [&]()
+    {
+      graph::UndirectedGraph<int, double> g;
+      for (auto const &v : _data.vertices)
+        g.AddVertex(v.Name(), v.Data(), v.Id());
+      for (auto const &e : _data.edges)
+        g.AddEdge(e.vertices, e.data, e.weight);
+      benchmark::DoNotOptimize(g);
+    });
+
+    Measure("BulkConstruction" + suffix, iterations, [&]()
+    {
+      graph::UndirectedGraph<int, double> g(_data.vertices, _data.edges);
+      benchmark::DoNotOptimize(g);
+    });
+
+    const graph::UndirectedGraph<int, double> g(_data.vertices, _data.edges);
+    Measure("Dijkstra" + suffix, iterations, [&]()
+    {
+      auto result = graph::Dijkstra(g, 0);
+      benchmark::DoNotOptimize(result);
+    });
+
+    Measure("BreadthFirstSort" + suffix, iterations, [&]()
+    {
+      auto result = graph::BreadthFirstSort(g, 0);
+      benchmark::DoNotOptimize(result);
+    });
+
+    Measure("ConnectedComponents" + suffix, iterations, [&]()
+    {
+      auto result = graph::ConnectedComponents(g);
+      benchmark::DoNotOptimize(result);
+    });
+
+    Measure("Freeze" + suffix, iterations, [&]()
+    {
+      auto result = graph::Freeze(g);
+      benchmark::DoNotOptimize(result);
+    });
+
+    const graph::CsrGraph frozen = graph::Freeze(g);
+    Measure("Dijkstra_csr" + suffix, iterations, [&]()
+    {
+      auto result = graph::Dijkstra(frozen, 0);
+      benchmark::DoNotOptimize(result);
+    });
+
+    for (const unsigned int threads : {1u, 0u})
+    {
+      Measure("DeltaStepping_csr_threads" + std::to_string(threads) + suffix,
+        iterations, [&]()
+        {
+          auto result = graph::DeltaStepping(frozen, 0, 0, threads);
+          benchmark::DoNotOptimize(result);
+        });
+    }
+
+    Measure("BreadthFirstSort_csr" + suffix, iterations, [&]()
+    {
+      auto result = graph::BreadthFirstSort(frozen, 0);
+      benchmark::DoNotOptimize(result);
+    });
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(GraphPerformance, Grid)
+{
+  for (const std::size_t edges : EdgeCounts())
+    RunGraphBenchmarks("grid", Grid(edges));
+}
+
+/////////////////////////////////////////////////
+TEST(GraphPerformance, RandomGeometric)
+{
+  for (const std::size_t edges : EdgeCounts())
+    RunGraphBenchmarks("geometric", RandomGeometric(edges));
+}
+
+/////////////////////////////////////////////////
+TEST(GraphPerformance, ScaleFree)
+{
+  for (const std::size_t edges : EdgeCounts())
+    RunGraphBenchmarks("scalefree", ScaleFree(edges));
+}